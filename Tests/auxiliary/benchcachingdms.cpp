@@ -0,0 +1,169 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "benchcachingdms.h"
+
+#include "auxiliary/cachingdms.h"
+#include "ksnumbers.h"
+#include "Options.h"
+#include "skyobjects/skypoint.h"
+#include "time/kstarsdatetime.h"
+
+#include <QTest>
+
+#include <cmath>
+
+namespace
+{
+// Angles, and points, handled by each benchmark iteration
+constexpr int COUNT = 1000;
+}
+
+BenchCachingDms::BenchCachingDms() : QObject()
+{
+}
+
+void BenchCachingDms::initTestCase()
+{
+    Options::setUseRelativistic(false);
+
+    // Spread over the whole circle, so the trigonometric functions take their usual paths
+    for (int i = 0; i < COUNT; i++)
+        m_Angles.append(i * 360.0 / COUNT + 0.123);
+}
+
+void BenchCachingDms::benchSeparateSinCos()
+{
+    double sum = 0;
+    QBENCHMARK
+    {
+        for (double angle : m_Angles)
+            sum += std::sin(angle * dms::DegToRad) + std::cos(angle * dms::DegToRad);
+    }
+    QVERIFY(std::isfinite(sum));
+}
+
+void BenchCachingDms::benchFusedSinCos()
+{
+    double sum = 0;
+    QBENCHMARK
+    {
+        for (double angle : m_Angles)
+        {
+            double s, c;
+            dms::SinCos(angle * dms::DegToRad, s, c);
+            sum += s + c;
+        }
+    }
+    QVERIFY(std::isfinite(sum));
+}
+
+void BenchCachingDms::benchSetD()
+{
+    CachingDms angle;
+    double sum = 0;
+    QBENCHMARK
+    {
+        for (double degrees : m_Angles)
+        {
+            angle.setD(degrees);
+            sum += angle.sin();
+        }
+    }
+    QVERIFY(std::isfinite(sum));
+}
+
+void BenchCachingDms::benchSetH()
+{
+    CachingDms angle;
+    double sum = 0;
+    QBENCHMARK
+    {
+        for (double degrees : m_Angles)
+        {
+            angle.setH(degrees / 15.0);
+            sum += angle.sin();
+        }
+    }
+    QVERIFY(std::isfinite(sum));
+}
+
+void BenchCachingDms::benchSetRadians()
+{
+    CachingDms angle;
+    double sum = 0;
+    QBENCHMARK
+    {
+        for (double degrees : m_Angles)
+        {
+            angle.setRadians(degrees * dms::DegToRad);
+            sum += angle.sin();
+        }
+    }
+    QVERIFY(std::isfinite(sum));
+}
+
+void BenchCachingDms::benchCachingRadiansSum()
+{
+    const CachingRadians step(2.0 * dms::PI / COUNT);
+    CachingRadians angle;
+    QBENCHMARK
+    {
+        for (int i = 0; i < COUNT; i++)
+            angle = angle + step;
+    }
+    QVERIFY(std::fabs(angle.sin() * angle.sin() + angle.cos() * angle.cos() - 1) < 1e-6);
+}
+
+void BenchCachingDms::benchUpdateCoords()
+{
+    QVector<SkyPoint> points;
+    for (int i = 0; i < COUNT; i++)
+        points.append(SkyPoint(dms(m_Angles[i]), dms(std::fmod(m_Angles[i] * 7, 180.0) - 90.0)));
+
+    const KStarsDateTime dt = KStarsDateTime::fromString("2026-01-24T00:00");
+    KSNumbers num(dt.djd());
+    QBENCHMARK
+    {
+        for (auto &p : points)
+            p.updateCoordsNow(&num);
+    }
+    QVERIFY(std::fabs(points.first().dec().Degrees()) <= 90.0);
+}
+
+void BenchCachingDms::benchEquatorialToHorizontal()
+{
+    QVector<SkyPoint> points;
+    for (int i = 0; i < COUNT; i++)
+        points.append(SkyPoint(dms(m_Angles[i]), dms(std::fmod(m_Angles[i] * 7, 180.0) - 90.0)));
+
+    const CachingDms lst(117.3), lat(52.1);
+    QBENCHMARK
+    {
+        for (auto &p : points)
+            p.EquatorialToHorizontal(&lst, &lat);
+    }
+    QVERIFY(std::fabs(points.first().alt().Degrees()) <= 90.0);
+}
+
+void BenchCachingDms::benchEquatorialToHorizontalBatch()
+{
+    QVector<SkyPoint> points;
+    for (int i = 0; i < COUNT; i++)
+        points.append(SkyPoint(dms(m_Angles[i]), dms(std::fmod(m_Angles[i] * 7, 180.0) - 90.0)));
+    QVector<SkyPoint *> pointers;
+    for (auto &p : points)
+        pointers.append(&p);
+
+    const CachingDms lst(117.3), lat(52.1);
+    QBENCHMARK
+    {
+        SkyPoint::EquatorialToHorizontal(pointers.constData(), pointers.size(), &lst, &lat);
+    }
+    QVERIFY(std::fabs(points.first().alt().Degrees()) <= 90.0);
+}
+
+QTEST_GUILESS_MAIN(BenchCachingDms)
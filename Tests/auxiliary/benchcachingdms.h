@@ -0,0 +1,41 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QVector>
+
+/**
+ * @class BenchCachingDms
+ * @short Micro-benchmarks of CachingDms and of the coordinate updates built on it
+ *
+ * Run with -iterations or -callgrind to compare the cost per angle and per object over time.
+ */
+class BenchCachingDms : public QObject
+{
+    Q_OBJECT
+
+  public:
+    BenchCachingDms();
+    ~BenchCachingDms() override = default;
+
+  private slots:
+    void initTestCase();
+
+    void benchSeparateSinCos();
+    void benchFusedSinCos();
+    void benchSetD();
+    void benchSetH();
+    void benchSetRadians();
+    void benchCachingRadiansSum();
+    void benchUpdateCoords();
+    void benchEquatorialToHorizontal();
+    void benchEquatorialToHorizontalBatch();
+
+  private:
+    QVector<double> m_Angles;
+};
@@ -0,0 +1,132 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "benchrobuststatistics.h"
+
+#include "auxiliary/robuststatistics.h"
+
+#include <QTest>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace Mathematics::RobustStatistics;
+
+Q_DECLARE_METATYPE(LocationCalculation)
+Q_DECLARE_METATYPE(ScaleCalculation)
+
+namespace
+{
+// Star measurements in each sample
+constexpr int COUNT = 50000;
+}
+
+BenchRobustStatistics::BenchRobustStatistics() : QObject()
+{
+}
+
+void BenchRobustStatistics::initTestCase()
+{
+    std::mt19937 generator(42);
+    std::normal_distribution<double> normal(2.5, 0.3);
+    m_Sample.resize(COUNT);
+    std::generate(m_Sample.begin(), m_Sample.end(), [&]()
+    {
+        return normal(generator);
+    });
+}
+
+void BenchRobustStatistics::benchLocation_data()
+{
+    QTest::addColumn<LocationCalculation>("method");
+    QTest::addColumn<bool>("inPlace");
+
+    QTest::addRow("median sorted") << LOCATION_MEDIAN << false;
+    QTest::addRow("median in place") << LOCATION_MEDIAN << true;
+    QTest::addRow("trimmed mean sorted") << LOCATION_TRIMMEDMEAN << false;
+    QTest::addRow("trimmed mean in place") << LOCATION_TRIMMEDMEAN << true;
+    QTest::addRow("sigma clipping sorted") << LOCATION_SIGMACLIPPING << false;
+    QTest::addRow("sigma clipping in place") << LOCATION_SIGMACLIPPING << true;
+}
+
+void BenchRobustStatistics::benchLocation()
+{
+    QFETCH(LocationCalculation, method);
+    QFETCH(bool, inPlace);
+
+    double location = 0;
+    QBENCHMARK
+    {
+        // Both start from an unsorted copy, as the callers have
+        auto data = m_Sample;
+        if (inPlace)
+            location = ComputeLocationInPlace(method, data);
+        else
+        {
+            std::sort(data.begin(), data.end());
+            location = ComputeLocationFromSortedData(method, data);
+        }
+    }
+    QVERIFY(std::isfinite(location));
+}
+
+void BenchRobustStatistics::benchScale_data()
+{
+    QTest::addColumn<ScaleCalculation>("method");
+    QTest::addColumn<bool>("inPlace");
+
+    QTest::addRow("MAD sorted") << SCALE_MAD << false;
+    QTest::addRow("MAD in place") << SCALE_MAD << true;
+    QTest::addRow("BWMV sorted") << SCALE_BWMV << false;
+    QTest::addRow("BWMV in place") << SCALE_BWMV << true;
+    QTest::addRow("Sn") << SCALE_SESTIMATOR << true;
+    QTest::addRow("Qn") << SCALE_QESTIMATOR << true;
+}
+
+void BenchRobustStatistics::benchScale()
+{
+    QFETCH(ScaleCalculation, method);
+    QFETCH(bool, inPlace);
+
+    double scale = 0;
+    QBENCHMARK
+    {
+        auto data = m_Sample;
+        if (inPlace)
+            scale = ComputeScaleInPlace(method, data);
+        else
+        {
+            std::sort(data.begin(), data.end());
+            scale = ComputeScaleFromSortedData(method, data);
+        }
+    }
+    QVERIFY(std::isfinite(scale));
+}
+
+void BenchRobustStatistics::benchApproximateScale_data()
+{
+    QTest::addColumn<ScaleCalculation>("method");
+
+    QTest::addRow("Sn") << SCALE_SESTIMATOR;
+    QTest::addRow("Qn") << SCALE_QESTIMATOR;
+    QTest::addRow("Pn") << SCALE_PESTIMATOR;
+}
+
+void BenchRobustStatistics::benchApproximateScale()
+{
+    QFETCH(ScaleCalculation, method);
+
+    double scale = 0;
+    QBENCHMARK
+    {
+        auto data = m_Sample;
+        scale = ComputeApproximateScale(method, data);
+    }
+    QVERIFY(std::isfinite(scale));
+}
+
+QTEST_GUILESS_MAIN(BenchRobustStatistics)
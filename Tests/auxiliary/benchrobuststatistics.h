@@ -0,0 +1,40 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+
+#include <vector>
+
+/**
+ * @class BenchRobustStatistics
+ * @short Benchmarks of the robust statistics over as many samples as the stars of a large frame
+ *
+ * Each estimator is timed the way it was computed before, sorting a copy of the sample, and
+ * selecting what it needs in place.
+ */
+class BenchRobustStatistics : public QObject
+{
+    Q_OBJECT
+
+  public:
+    BenchRobustStatistics();
+    ~BenchRobustStatistics() override = default;
+
+  private slots:
+    void initTestCase();
+
+    void benchLocation_data();
+    void benchLocation();
+    void benchScale_data();
+    void benchScale();
+    void benchApproximateScale_data();
+    void benchApproximateScale();
+
+  private:
+    std::vector<double> m_Sample;
+};
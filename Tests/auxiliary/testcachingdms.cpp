@@ -294,4 +294,30 @@ void TestCachingDms::testFailsafeUseOfBaseClassPtr()
     }
 }
 
+void TestCachingDms::cachingRadians()
+{
+    // Built at compile time from known values
+    constexpr CachingRadians zero;
+    constexpr CachingRadians quarter(dms::PI / 2, 1, 0);
+    static_assert((quarter + quarter).cos() == -1, "addition formula");
+    static_assert((quarter - quarter).sin() == 0, "subtraction formula");
+    QCOMPARE(zero.cos(), 1.0);
+
+    const CachingRadians a(2.159), b(-0.606);
+    QVERIFY(fabs((a + b).sin() - std::sin(2.159 - 0.606)) < 1e-9);
+    QVERIFY(fabs((a - b).cos() - std::cos(2.159 + 0.606)) < 1e-9);
+    QVERIFY(qFuzzyCompare((-a).sin(), -a.sin()));
+
+    const CachingDms d(123.7);
+    const CachingRadians r(d);
+    QVERIFY(qFuzzyCompare(r.radians(), d.radians()));
+    QCOMPARE(r.sin(), d.sin());
+    QCOMPARE(r.cos(), d.cos());
+
+    CachingDms e;
+    e.setRadians(r.radians());
+    QVERIFY(fabs(e.sin() - r.sin()) < 1e-12);
+    QVERIFY(fabs(e.cos() - r.cos()) < 1e-12);
+}
+
 QTEST_GUILESS_MAIN(TestCachingDms)
@@ -0,0 +1,100 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for imagemask.cpp
+*/
+
+#include "testimagemask.h"
+#include "auxiliary/imagemask.h"
+
+#include <QTest>
+
+#include <cmath>
+
+TestImageMask::TestImageMask(QObject * parent): QObject(parent)
+{
+}
+
+void TestImageMask::testRingMask_data()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<float>("innerRadius");
+    QTest::addColumn<float>("outerRadius");
+
+    QTest::newRow("full") << 640 << 480 << 0.0f << 1.0f;
+    QTest::newRow("ring") << 640 << 480 << 0.2f << 0.8f;
+    QTest::newRow("odd size") << 641 << 479 << 0.2f << 0.8f;
+    QTest::newRow("thin ring") << 300 << 200 << 0.5f << 0.51f;
+    QTest::newRow("centre") << 301 << 301 << 0.0f << 0.3f;
+}
+
+// The row lookup has to give the same answer as the distance from the centre
+void TestImageMask::testRingMask()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(float, innerRadius);
+    QFETCH(float, outerRadius);
+
+    ImageRingMask mask(innerRadius, outerRadius);
+    mask.setImageGeometry(width, height);
+
+    const long sqDiagonal = width * width / 4 + height * height / 4;
+    const long innerSquare = std::lround(sqDiagonal * innerRadius * innerRadius);
+    const long outerSquare = std::lround(sqDiagonal * outerRadius * outerRadius);
+    for (int y = 0; y < height + 2; y++)
+        for (int x = 0; x < width + 2; x++)
+        {
+            bool expected = x < width && y < height;
+            if (expected)
+            {
+                const long dx = x - width / 2, dy = y - height / 2;
+                expected = dx * dx + dy * dy >= innerSquare && dx * dx + dy * dy < outerSquare;
+            }
+            if (mask.isVisible(x, y) != expected)
+                QFAIL(qPrintable(QString("Wrong visibility at %1,%2").arg(x).arg(y)));
+        }
+}
+
+void TestImageMask::testMosaicMask_data()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<int>("tileWidth");
+
+    QTest::newRow("small tiles") << 640 << 480 << 10;
+    QTest::newRow("odd size") << 641 << 479 << 20;
+    QTest::newRow("overlapping tiles") << 400 << 300 << 40;
+    QTest::newRow("no tiles") << 400 << 300 << 0;
+}
+
+// The tile lookup has to find the first tile of the raster containing a position
+void TestImageMask::testMosaicMask()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(int, tileWidth);
+
+    ImageMosaicMask mask(tileWidth, 0);
+    mask.setImageGeometry(width, height);
+
+    const QVector<QRect> tiles = mask.tiles();
+    QCOMPARE(tiles.size(), 9);
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+        {
+            int expected = -1;
+            for (int i = 0; i < tiles.size() && expected < 0; i++)
+                if (tiles[i].contains(x, y))
+                    expected = i;
+            if (mask.tileIndex(x, y) != expected || mask.isVisible(x, y) != (expected >= 0))
+                QFAIL(qPrintable(QString("Wrong tile at %1,%2").arg(x).arg(y)));
+        }
+    QCOMPARE(mask.tileIndex(-1, 0), -1);
+    QCOMPARE(mask.tileIndex(width, 0), -1);
+}
+
+QTEST_GUILESS_MAIN(TestImageMask)
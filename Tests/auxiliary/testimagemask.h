@@ -0,0 +1,24 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for imagemask.cpp
+*/
+
+#pragma once
+
+#include <QObject>
+
+class TestImageMask: public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestImageMask(QObject * parent = nullptr);
+
+private slots:
+    void testRingMask_data();
+    void testRingMask();
+    void testMosaicMask_data();
+    void testMosaicMask();
+};
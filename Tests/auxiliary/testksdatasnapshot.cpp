@@ -0,0 +1,95 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "testksdatasnapshot.h"
+
+#include "../testhelpers.h"
+#include "auxiliary/ksdatasnapshot.h"
+
+TestKSDataSnapshot::TestKSDataSnapshot(QObject *parent) : QObject(parent)
+{
+}
+
+void TestKSDataSnapshot::init()
+{
+    KTEST_BEGIN();
+}
+
+void TestKSDataSnapshot::cleanup()
+{
+    KTEST_END();
+}
+
+void TestKSDataSnapshot::writeSource(const QByteArray &contents)
+{
+    QFile file(QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("snapshot.dat"));
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(contents);
+}
+
+QByteArray TestKSDataSnapshot::payload() const
+{
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    KSDataSnapshot::setupStream(out);
+    out << QString("Andromeda") << 1.5 << qint32(42);
+    return payload;
+}
+
+void TestKSDataSnapshot::testRoundTrip()
+{
+    writeSource("0.0 1.0\n");
+    {
+        KSDataSnapshot snapshot("snapshot", { "snapshot.dat" }, 1);
+        QVERIFY(!snapshot.load());
+        QVERIFY(snapshot.save(payload()));
+    }
+
+    KSDataSnapshot snapshot("snapshot", { "snapshot.dat" }, 1);
+    QVERIFY(snapshot.load());
+    QCOMPARE(snapshot.payload(), payload());
+
+    QDataStream in(snapshot.payload());
+    KSDataSnapshot::setupStream(in);
+    QString name;
+    double value = 0;
+    qint32 count = 0;
+    in >> name >> value >> count;
+    QCOMPARE(name, QString("Andromeda"));
+    QCOMPARE(value, 1.5);
+    QCOMPARE(count, 42);
+    QVERIFY(in.atEnd());
+}
+
+void TestKSDataSnapshot::testChangedSource()
+{
+    writeSource("0.0 1.0\n");
+    QVERIFY(KSDataSnapshot("snapshot", { "snapshot.dat" }, 1).save(payload()));
+
+    // Same size, different contents
+    writeSource("0.0 2.0\n");
+    KSDataSnapshot snapshot("snapshot", { "snapshot.dat" }, 1);
+    QVERIFY(!snapshot.load());
+    QVERIFY(snapshot.payload().isEmpty());
+}
+
+void TestKSDataSnapshot::testVersion()
+{
+    writeSource("0.0 1.0\n");
+    QVERIFY(KSDataSnapshot("snapshot", { "snapshot.dat" }, 1).save(payload()));
+    QVERIFY(!KSDataSnapshot("snapshot", { "snapshot.dat" }, 2).load());
+    QVERIFY(KSDataSnapshot("snapshot", { "snapshot.dat" }, 1).load());
+}
+
+void TestKSDataSnapshot::testMissingSource()
+{
+    writeSource("0.0 1.0\n");
+    KSDataSnapshot snapshot("snapshot", { "snapshot.dat", "missing.dat" }, 1);
+    QVERIFY(!snapshot.save(payload()));
+    QVERIFY(!snapshot.load());
+}
+
+QTEST_GUILESS_MAIN(TestKSDataSnapshot)
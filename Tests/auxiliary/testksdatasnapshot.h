@@ -0,0 +1,30 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QTest>
+
+class TestKSDataSnapshot : public QObject
+{
+        Q_OBJECT
+    public:
+        explicit TestKSDataSnapshot(QObject *parent = nullptr);
+
+    private slots:
+        void init();
+        void cleanup();
+
+        void testRoundTrip();
+        void testChangedSource();
+        void testVersion();
+        void testMissingSource();
+
+    private:
+        void writeSource(const QByteArray &contents);
+        QByteArray payload() const;
+};
@@ -0,0 +1,68 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "testksnetworkcache.h"
+
+#include "../testhelpers.h"
+#include "auxiliary/ksnetworkcache.h"
+
+#include <QDateTime>
+
+TestKSNetworkCache::TestKSNetworkCache(QObject *parent) : QObject(parent)
+{
+}
+
+void TestKSNetworkCache::init()
+{
+    KTEST_BEGIN();
+}
+
+void TestKSNetworkCache::cleanup()
+{
+    KTEST_END();
+}
+
+void TestKSNetworkCache::testRoundTrip()
+{
+    const QString key("http://example.org/resolve?M31");
+    QVERIFY(KSNetworkCache::find(key, 30).isNull());
+
+    QVERIFY(KSNetworkCache::insert(key, "<Sesame/>"));
+    QCOMPARE(KSNetworkCache::find(key, 30), QByteArray("<Sesame/>"));
+    QVERIFY(KSNetworkCache::find("http://example.org/resolve?M32", 30).isNull());
+}
+
+void TestKSNetworkCache::testReplace()
+{
+    const QString key("http://example.org/resolve?M31");
+    QVERIFY(KSNetworkCache::insert(key, "a longer first answer"));
+    QVERIFY(KSNetworkCache::insert(key, "second"));
+    QCOMPARE(KSNetworkCache::find(key, 30), QByteArray("second"));
+}
+
+void TestKSNetworkCache::testExpired()
+{
+    const QString key("http://example.org/resolve?M31");
+    QVERIFY(KSNetworkCache::insert(key, "<Sesame/>"));
+
+    QFile file(KSNetworkCache::path(key));
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.setFileTime(QDateTime::currentDateTime().addDays(-10), QFileDevice::FileModificationTime));
+    file.close();
+
+    QVERIFY(KSNetworkCache::find(key, 5).isNull());
+    QCOMPARE(KSNetworkCache::find(key, 30), QByteArray("<Sesame/>"));
+}
+
+void TestKSNetworkCache::testRemove()
+{
+    const QString key("http://example.org/resolve?M31");
+    QVERIFY(KSNetworkCache::insert(key, "<Sesame/>"));
+    KSNetworkCache::remove(key);
+    QVERIFY(KSNetworkCache::find(key, 30).isNull());
+}
+
+QTEST_GUILESS_MAIN(TestKSNetworkCache)
@@ -0,0 +1,26 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QTest>
+
+class TestKSNetworkCache : public QObject
+{
+        Q_OBJECT
+    public:
+        explicit TestKSNetworkCache(QObject *parent = nullptr);
+
+    private slots:
+        void init();
+        void cleanup();
+
+        void testRoundTrip();
+        void testReplace();
+        void testExpired();
+        void testRemove();
+};
@@ -0,0 +1,101 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for kstrace.cpp
+*/
+
+#include "testkstrace.h"
+#include "auxiliary/kstrace.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+
+namespace
+{
+QJsonArray traceEvents()
+{
+    return QJsonDocument::fromJson(KSTrace::Instance()->toJson()).object()["traceEvents"].toArray();
+}
+}
+
+TestKSTrace::TestKSTrace(QObject * parent): QObject(parent)
+{
+}
+
+void TestKSTrace::init()
+{
+    KSTrace::Instance()->setEnabled(false);
+    KSTrace::Instance()->clear();
+}
+
+void TestKSTrace::testDisabled()
+{
+    {
+        KSTRACE_SCOPE("test", "scope");
+    }
+    KSTrace::Instance()->asyncBegin("test", "async");
+    KSTrace::Instance()->instant("test", "instant");
+    QCOMPARE(traceEvents().size(), 0);
+}
+
+void TestKSTrace::testEvents()
+{
+    KSTrace::Instance()->setEnabled(true);
+    {
+        KSTRACE_SCOPE("test", "scope");
+        QTest::qSleep(2);
+    }
+    KSTrace::Instance()->asyncBegin("test", "async");
+    KSTrace::Instance()->asyncEnd("test", "async");
+    KSTrace::Instance()->instant("test", "instant");
+
+    const QJsonArray events = traceEvents();
+    QCOMPARE(events.size(), 4);
+
+    const QJsonObject scope = events[0].toObject();
+    QCOMPARE(scope["ph"].toString(), QString("X"));
+    QCOMPARE(scope["cat"].toString(), QString("test"));
+    QCOMPARE(scope["name"].toString(), QString("scope"));
+    QVERIFY(scope["dur"].toDouble() >= 2000);
+
+    QCOMPARE(events[1].toObject()["ph"].toString(), QString("b"));
+    QCOMPARE(events[2].toObject()["ph"].toString(), QString("e"));
+    QCOMPARE(events[1].toObject()["id"], events[2].toObject()["id"]);
+    QCOMPARE(events[3].toObject()["ph"].toString(), QString("i"));
+
+    // events are in time order
+    for (int i = 1; i < events.size(); i++)
+        QVERIFY(events[i].toObject()["ts"].toDouble() >= events[i - 1].toObject()["ts"].toDouble());
+}
+
+// Only the latest CAPACITY events are kept
+void TestKSTrace::testRingBuffer()
+{
+    KSTrace::Instance()->setEnabled(true);
+    KSTrace::Instance()->instant("test", "first");
+    for (int i = 0; i < KSTrace::CAPACITY; i++)
+        KSTrace::Instance()->instant("test", "next");
+
+    const QJsonArray events = traceEvents();
+    QCOMPARE(events.size(), KSTrace::CAPACITY);
+    for (const auto &event : events)
+        QCOMPARE(event.toObject()["name"].toString(), QString("next"));
+}
+
+void TestKSTrace::testClear()
+{
+    KSTrace::Instance()->setEnabled(true);
+    KSTrace::Instance()->instant("test", "before");
+    KSTrace::Instance()->clear();
+    KSTrace::Instance()->instant("test", "after");
+
+    const QJsonArray events = traceEvents();
+    QCOMPARE(events.size(), 1);
+    QCOMPARE(events[0].toObject()["name"].toString(), QString("after"));
+}
+
+QTEST_GUILESS_MAIN(TestKSTrace)
@@ -0,0 +1,25 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for kstrace.cpp
+*/
+
+#pragma once
+
+#include <QObject>
+
+class TestKSTrace: public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestKSTrace(QObject * parent = nullptr);
+
+private slots:
+    void init();
+    void testDisabled();
+    void testEvents();
+    void testRingBuffer();
+    void testClear();
+};
@@ -8,6 +8,10 @@
 #include "../testhelpers.h"
 #include "ksuserdb.h"
 
+#include <QDateTime>
+
+#include <algorithm>
+
 TestKSUserDB::TestKSUserDB(QObject *parent) : QObject(parent)
 {
 }
@@ -133,4 +137,135 @@ void TestKSUserDB::testCoordinates()
     QSKIP("Not implemented yet.");
 }
 
+void TestKSUserDB::testDarkFrames()
+{
+    QVERIFY(QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).mkpath("."));
+    QScopedPointer<KSUserDB> testDB(new KSUserDB());
+    QVERIFY(testDB->Initialize());
+
+    QVariantMap frame;
+    frame["ccd"] = "Test CCD";
+    frame["chip"] = 0;
+    frame["binX"] = 2;
+    frame["binY"] = 2;
+    frame["temperature"] = -10.0;
+    frame["gain"] = 100;
+    frame["duration"] = 60.0;
+    frame["filename"] = "/tmp/darkframe_test.fits";
+    frame["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    // Not a column of the dark frames table
+    frame["unknown"] = 1;
+    QVERIFY(testDB->AddDarkFrame(frame));
+
+    // Find the new frame back
+    auto find = [&testDB](const QString & filename)
+    {
+        QList<QVariantMap> frames;
+        testDB->GetAllDarkFrames(frames);
+        for (const auto &oneFrame : frames)
+        {
+            if (oneFrame["filename"].toString() == filename)
+                return oneFrame;
+        }
+        return QVariantMap();
+    };
+
+    QVariantMap stored = find("/tmp/darkframe_test.fits");
+    QVERIFY(!stored.isEmpty());
+    QCOMPARE(stored["ccd"].toString(), QString("Test CCD"));
+    QCOMPARE(stored["binX"].toInt(), 2);
+    QCOMPARE(stored["gain"].toInt(), 100);
+    QCOMPARE(stored["duration"].toDouble(), 60.0);
+    QVERIFY(stored["defectmap"].toString().isEmpty());
+
+    stored["defectmap"] = "/tmp/defectmap_test.json";
+    QVERIFY(testDB->UpdateDarkFrame(stored));
+    QCOMPARE(find("/tmp/darkframe_test.fits")["defectmap"].toString(), QString("/tmp/defectmap_test.json"));
+
+    QVERIFY(testDB->DeleteDarkFrame("/tmp/darkframe_test.fits"));
+    QVERIFY(find("/tmp/darkframe_test.fits").isEmpty());
+}
+
+void TestKSUserDB::testPostedWrites()
+{
+    QVERIFY(QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).mkpath("."));
+    QScopedPointer<KSUserDB> testDB(new KSUserDB());
+    QVERIFY(testDB->Initialize());
+
+    QVariantMap frame;
+    frame["ccd"] = "Posted CCD";
+    frame["chip"] = 0;
+    frame["binX"] = 1;
+    frame["binY"] = 1;
+    frame["duration"] = 5.0;
+    frame["filename"] = "/tmp/darkframe_posted.fits";
+    frame["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+
+    // The completion future holds the result of the write
+    QFuture<bool> added = testDB->post([frame](KSUserDB & db)
+    {
+        return db.AddDarkFrame(frame);
+    });
+    added.waitForFinished();
+    QVERIFY(added.result());
+
+    // Reads wait for the writes posted before them, without waiting on the futures
+    frame["defectmap"] = "/tmp/defectmap_posted.json";
+    testDB->post([frame](KSUserDB & db)
+    {
+        return db.UpdateDarkFrame(frame);
+    });
+
+    QList<QVariantMap> frames;
+    QVERIFY(testDB->GetAllDarkFrames(frames));
+    auto stored = std::find_if(frames.cbegin(), frames.cend(), [](const QVariantMap & oneFrame)
+    {
+        return oneFrame["filename"].toString() == "/tmp/darkframe_posted.fits";
+    });
+    QVERIFY(stored != frames.cend());
+    QCOMPARE((*stored)["defectmap"].toString(), QString("/tmp/defectmap_posted.json"));
+
+    testDB->post([](KSUserDB & db)
+    {
+        return db.DeleteDarkFrame("/tmp/darkframe_posted.fits");
+    });
+    testDB->flush();
+    frames.clear();
+    QVERIFY(testDB->GetAllDarkFrames(frames));
+    QVERIFY(std::none_of(frames.cbegin(), frames.cend(), [](const QVariantMap & oneFrame)
+    {
+        return oneFrame["filename"].toString() == "/tmp/darkframe_posted.fits";
+    }));
+}
+
+void TestKSUserDB::testDarkFramesBenchmark()
+{
+    QVERIFY(QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).mkpath("."));
+    QScopedPointer<KSUserDB> testDB(new KSUserDB());
+    QVERIFY(testDB->Initialize());
+
+    QVariantMap frame;
+    frame["ccd"] = "Benchmark CCD";
+    frame["chip"] = 0;
+    frame["binX"] = 1;
+    frame["binY"] = 1;
+    frame["temperature"] = -10.0;
+    frame["duration"] = 1.0;
+    frame["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+
+    // What the dark library does for each new master: add it, then reload all of them.
+    int count = 0;
+    QList<QVariantMap> frames;
+    QBENCHMARK
+    {
+        frame["filename"] = QString("/tmp/darkframe_benchmark_%1.fits").arg(count++);
+        QVERIFY(testDB->AddDarkFrame(frame));
+        QVERIFY(testDB->GetAllDarkFrames(frames));
+    }
+    QVERIFY(frames.size() >= count);
+
+    for (int i = 0; i < count; i++)
+        QVERIFY(testDB->DeleteDarkFrame(QString("/tmp/darkframe_benchmark_%1.fits").arg(i)));
+}
+
 QTEST_GUILESS_MAIN(TestKSUserDB)
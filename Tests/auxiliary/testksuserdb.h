@@ -37,6 +37,9 @@ private slots:
     void testCreateProfilees();
     void testCreateDatabase();
     void testCoordinates();
+    void testDarkFrames();
+    void testPostedWrites();
+    void testDarkFramesBenchmark();
 };
 
 #endif // TESTKSUSERDB_H
@@ -0,0 +1,95 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for processinglanes.cpp
+*/
+
+#include "testprocessinglanes.h"
+#include "auxiliary/processinglanes.h"
+
+#include <QTest>
+#include <QVector>
+
+#include <atomic>
+
+TestProcessingLanes::TestProcessingLanes(QObject * parent): QObject(parent)
+{
+}
+
+void TestProcessingLanes::testPools()
+{
+    QCOMPARE(ProcessingLanes::pool(ProcessingLanes::NONE), QThreadPool::globalInstance());
+
+    const QList<ProcessingLanes::Lane> lanes {ProcessingLanes::GUIDE, ProcessingLanes::FOCUS,
+                                              ProcessingLanes::CAPTURE, ProcessingLanes::DISPLAY};
+    for (const auto lane : lanes)
+    {
+        QThreadPool *pool = ProcessingLanes::pool(lane);
+        QVERIFY(pool != QThreadPool::globalInstance());
+        QVERIFY(pool->maxThreadCount() >= 1);
+        QCOMPARE(ProcessingLanes::pool(lane), pool);
+        for (const auto other : lanes)
+            if (other != lane)
+                QVERIFY(ProcessingLanes::pool(other) != pool);
+    }
+}
+
+void TestProcessingLanes::testRun()
+{
+    QCOMPARE(ProcessingLanes::current(), ProcessingLanes::NONE);
+    QCOMPARE(ProcessingLanes::current(ProcessingLanes::DISPLAY), ProcessingLanes::DISPLAY);
+
+    // A task knows its lane, and the tasks it starts stay in it
+    QFuture<int> future = ProcessingLanes::run(ProcessingLanes::GUIDE, []()
+    {
+        QFuture<int> nested = ProcessingLanes::run(ProcessingLanes::current(), []()
+        {
+            return static_cast<int>(ProcessingLanes::current());
+        });
+        return ProcessingLanes::current() == ProcessingLanes::GUIDE ? nested.result() : -1;
+    });
+    QCOMPARE(future.result(), static_cast<int>(ProcessingLanes::GUIDE));
+
+    QFuture<void> done = ProcessingLanes::run(ProcessingLanes::FOCUS, []() {});
+    done.waitForFinished();
+    QCOMPARE(ProcessingLanes::current(), ProcessingLanes::NONE);
+}
+
+void TestProcessingLanes::testScope()
+{
+    {
+        ProcessingLanes::Scope guide(ProcessingLanes::GUIDE);
+        QCOMPARE(ProcessingLanes::current(), ProcessingLanes::GUIDE);
+        {
+            ProcessingLanes::Scope display(ProcessingLanes::DISPLAY);
+            QCOMPARE(ProcessingLanes::current(), ProcessingLanes::DISPLAY);
+        }
+        QCOMPARE(ProcessingLanes::current(), ProcessingLanes::GUIDE);
+    }
+    QCOMPARE(ProcessingLanes::current(), ProcessingLanes::NONE);
+}
+
+void TestProcessingLanes::testBlockingMap()
+{
+    for (const int size : {0, 1, 7, 1000})
+    {
+        QVector<int> items(size);
+        for (int i = 0; i < size; i++)
+            items[i] = i;
+
+        std::atomic<int> outside { 0 };
+        ProcessingLanes::blockingMap(ProcessingLanes::CAPTURE, items, [&outside](int &item)
+        {
+            if (ProcessingLanes::current() != ProcessingLanes::CAPTURE)
+                outside++;
+            item *= 2;
+        });
+        QCOMPARE(outside.load(), 0);
+        for (int i = 0; i < size; i++)
+            QCOMPARE(items[i], 2 * i);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestProcessingLanes)
@@ -0,0 +1,24 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for processinglanes.cpp
+*/
+
+#pragma once
+
+#include <QObject>
+
+class TestProcessingLanes: public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestProcessingLanes(QObject * parent = nullptr);
+
+private slots:
+    void testPools();
+    void testRun();
+    void testScope();
+    void testBlockingMap();
+};
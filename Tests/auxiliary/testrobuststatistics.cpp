@@ -0,0 +1,136 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "testrobuststatistics.h"
+
+#include "auxiliary/robuststatistics.h"
+
+#include <QTest>
+
+#include <algorithm>
+#include <random>
+
+using namespace Mathematics::RobustStatistics;
+
+Q_DECLARE_METATYPE(LocationCalculation)
+Q_DECLARE_METATYPE(ScaleCalculation)
+
+TestRobustStatistics::TestRobustStatistics() : QObject()
+{
+}
+
+void TestRobustStatistics::initTestCase()
+{
+    // Star HFRs around 2.5 pixels, with a few hot pixels and saturated stars thrown in
+    std::mt19937 generator(42);
+    std::normal_distribution<double> normal(2.5, 0.3);
+    for (int i = 0; i < 20001; i++)
+        m_Sample.push_back(i % 97 == 0 ? 0.4 + i % 7 : normal(generator));
+}
+
+void TestRobustStatistics::testLocationInPlace_data()
+{
+    QTest::addColumn<LocationCalculation>("method");
+    QTest::addColumn<double>("trimAmount");
+    QTest::addColumn<int>("size");
+
+    for (int size : { 1, 2, 3, 4, 5, 20000, 20001 })
+    {
+        QTest::addRow("mean %d", size) << LOCATION_MEAN << 0.25 << size;
+        QTest::addRow("median %d", size) << LOCATION_MEDIAN << 0.25 << size;
+        QTest::addRow("trimmed mean %d", size) << LOCATION_TRIMMEDMEAN << 0.25 << size;
+        QTest::addRow("trimmed mean 10%% %d", size) << LOCATION_TRIMMEDMEAN << 0.1 << size;
+        QTest::addRow("sigma clipping %d", size) << LOCATION_SIGMACLIPPING << 2.0 << size;
+    }
+}
+
+void TestRobustStatistics::testLocationInPlace()
+{
+    QFETCH(LocationCalculation, method);
+    QFETCH(double, trimAmount);
+    QFETCH(int, size);
+
+    std::vector<double> sorted(m_Sample.begin(), m_Sample.begin() + size);
+    std::vector<double> data = sorted;
+    std::sort(sorted.begin(), sorted.end());
+
+    const double expected = ComputeLocationFromSortedData(method, sorted, trimAmount);
+    const double actual = ComputeLocationInPlace(method, data, trimAmount);
+    QVERIFY(std::fabs(actual - expected) < 1e-12);
+
+    // Only the order of the sample may change
+    std::sort(data.begin(), data.end());
+    QVERIFY(data == sorted);
+}
+
+void TestRobustStatistics::testScaleInPlace_data()
+{
+    QTest::addColumn<ScaleCalculation>("method");
+    QTest::addColumn<int>("size");
+
+    for (int size : { 1, 2, 3, 4, 5, 20000, 20001 })
+    {
+        QTest::addRow("variance %d", size) << SCALE_VARIANCE << size;
+        QTest::addRow("MAD %d", size) << SCALE_MAD << size;
+    }
+    for (int size : { 100, 20000, 20001 })
+    {
+        QTest::addRow("BWMV %d", size) << SCALE_BWMV << size;
+        QTest::addRow("Sn %d", size) << SCALE_SESTIMATOR << size;
+        QTest::addRow("Qn %d", size) << SCALE_QESTIMATOR << size;
+    }
+}
+
+void TestRobustStatistics::testScaleInPlace()
+{
+    QFETCH(ScaleCalculation, method);
+    QFETCH(int, size);
+
+    std::vector<double> sorted(m_Sample.begin(), m_Sample.begin() + size);
+    std::vector<double> data = sorted;
+    std::sort(sorted.begin(), sorted.end());
+
+    const double expected = ComputeScaleFromSortedData(method, sorted);
+    const double actual = ComputeScaleInPlace(method, data);
+    QVERIFY(std::fabs(actual - expected) < 1e-12 * std::max(1.0, std::fabs(expected)));
+}
+
+void TestRobustStatistics::testApproximateScale_data()
+{
+    QTest::addColumn<ScaleCalculation>("method");
+
+    QTest::addRow("Sn") << SCALE_SESTIMATOR;
+    QTest::addRow("Qn") << SCALE_QESTIMATOR;
+    QTest::addRow("Pn") << SCALE_PESTIMATOR;
+}
+
+void TestRobustStatistics::testApproximateScale()
+{
+    QFETCH(ScaleCalculation, method);
+
+    const double exact = ComputeScale(method, m_Sample);
+
+    std::vector<double> data = m_Sample;
+    const double approximate = ComputeApproximateScale(method, data);
+    QVERIFY(std::fabs(approximate - exact) < 0.05 * exact);
+
+    // A sample that fits is not subsampled
+    std::vector<double> small(m_Sample.begin(), m_Sample.begin() + 1000);
+    QCOMPARE(ComputeApproximateScale(method, small), ComputeScale(method, small));
+}
+
+void TestRobustStatistics::testSampleStatistics()
+{
+    std::vector<double> sorted = m_Sample;
+    std::sort(sorted.begin(), sorted.end());
+
+    const auto stats = ComputeSampleStatistics(m_Sample, LOCATION_MEDIAN, SCALE_MAD);
+    QCOMPARE(stats.location, ComputeLocationFromSortedData(LOCATION_MEDIAN, sorted));
+    QVERIFY(std::fabs(stats.scale - ComputeScaleFromSortedData(SCALE_MAD, sorted)) < 1e-12);
+    QCOMPARE(stats.weight, ConvertScaleToWeight(SCALE_MAD, stats.scale));
+}
+
+QTEST_GUILESS_MAIN(TestRobustStatistics)
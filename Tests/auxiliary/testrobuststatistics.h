@@ -0,0 +1,38 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+
+#include <vector>
+
+/**
+ * @class TestRobustStatistics
+ * @short Checks the selection based robust statistics against the estimators working on sorted data
+ */
+class TestRobustStatistics : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestRobustStatistics();
+    ~TestRobustStatistics() override = default;
+
+  private slots:
+    void initTestCase();
+
+    void testLocationInPlace_data();
+    void testLocationInPlace();
+    void testScaleInPlace_data();
+    void testScaleInPlace();
+    void testApproximateScale_data();
+    void testApproximateScale();
+    void testSampleStatistics();
+
+  private:
+    std::vector<double> m_Sample;
+};
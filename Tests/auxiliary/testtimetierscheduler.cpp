@@ -0,0 +1,134 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "testtimetierscheduler.h"
+
+#include "auxiliary/timetierscheduler.h"
+
+namespace
+{
+TimeTierScheduler::Resolution every(double days)
+{
+    return [days]()
+    {
+        return days;
+    };
+}
+}
+
+TestTimeTierScheduler::TestTimeTierScheduler(QObject *parent) : QObject(parent)
+{
+}
+
+void TestTimeTierScheduler::testResolution()
+{
+    TimeTierScheduler scheduler;
+    int coarse = 0, fine = 0;
+    scheduler.addTier("coarse", every(1.0), [&](KSNumbers *)
+    {
+        coarse++;
+    });
+    scheduler.addTier("fine", every(0.01), [&](KSNumbers *)
+    {
+        fine++;
+    });
+
+    // Every tier is due at the first run
+    QCOMPARE(scheduler.run(2460000.0, nullptr), 2);
+
+    // Within the resolution of both
+    QCOMPARE(scheduler.run(2460000.005, nullptr), 0);
+
+    for (int i = 1; i <= 200; i++)
+        scheduler.run(2460000.0 + i * 0.011, nullptr);
+    QCOMPARE(fine, 201);
+    QCOMPARE(coarse, 3);
+    QCOMPARE(scheduler.runs(0), quint64(3));
+}
+
+void TestTimeTierScheduler::testBackward()
+{
+    TimeTierScheduler scheduler;
+    int runs = 0;
+    scheduler.addTier("tier", every(0.5), [&](KSNumbers *)
+    {
+        runs++;
+    });
+
+    scheduler.run(2460000.0, nullptr);
+    scheduler.run(2459999.7, nullptr);
+    QCOMPARE(runs, 1);
+    scheduler.run(2459999.4, nullptr);
+    QCOMPARE(runs, 2);
+}
+
+void TestTimeTierScheduler::testTrigger()
+{
+    TimeTierScheduler scheduler;
+    QStringList order;
+    const int coarse = scheduler.addTier("coarse", every(1.0), [&](KSNumbers *)
+    {
+        order << "coarse";
+    });
+    const int fine = scheduler.addTier("fine", every(0.1), [&](KSNumbers *)
+    {
+        order << "fine";
+    });
+    scheduler.addTrigger(coarse, fine);
+
+    scheduler.run(2460000.0, nullptr);
+    QCOMPARE(order, QStringList({ "coarse", "fine" }));
+
+    order.clear();
+    scheduler.run(2460000.05, nullptr);
+    QVERIFY(order.isEmpty());
+    scheduler.run(2460000.95, nullptr);
+    QCOMPARE(order, QStringList({ "fine" }));
+
+    // The fine tier is not due yet, the coarse one brings it along
+    order.clear();
+    scheduler.run(2460001.02, nullptr);
+    QCOMPARE(order, QStringList({ "coarse", "fine" }));
+}
+
+void TestTimeTierScheduler::testAlwaysDue()
+{
+    TimeTierScheduler scheduler;
+    bool manual = false;
+    int runs = 0;
+    scheduler.addTier("sky", [&]()
+    {
+        return manual ? -1.0 : 0.1;
+    }, [&](KSNumbers *)
+    {
+        runs++;
+    });
+
+    scheduler.run(2460000.0, nullptr);
+    scheduler.run(2460000.0, nullptr);
+    QCOMPARE(runs, 1);
+
+    manual = true;
+    scheduler.run(2460000.0, nullptr);
+    scheduler.run(2460000.0, nullptr);
+    QCOMPARE(runs, 3);
+}
+
+void TestTimeTierScheduler::testInvalidate()
+{
+    TimeTierScheduler scheduler;
+    scheduler.addTier("a", every(1.0), [](KSNumbers *) {});
+    scheduler.addTier("b", every(1.0), [](KSNumbers *) {});
+
+    scheduler.run(2460000.0, nullptr);
+    QCOMPARE(scheduler.run(2460000.0, nullptr), 0);
+    scheduler.invalidate();
+    QCOMPARE(scheduler.run(2460000.0, nullptr), 2);
+    QCOMPARE(scheduler.count(), 2);
+    QCOMPARE(scheduler.name(1), QString("b"));
+}
+
+QTEST_GUILESS_MAIN(TestTimeTierScheduler)
@@ -0,0 +1,24 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QTest>
+
+class TestTimeTierScheduler : public QObject
+{
+        Q_OBJECT
+    public:
+        explicit TestTimeTierScheduler(QObject *parent = nullptr);
+
+    private slots:
+        void testResolution();
+        void testBackward();
+        void testTrigger();
+        void testAlwaysDue();
+        void testInvalidate();
+};
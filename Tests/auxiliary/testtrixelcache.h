@@ -83,6 +83,48 @@ class TestTrixelCache : public QObject
         QVERIFY2(m_cache[0].is_set(), "Index 0 should be set.");
     };
 
+    void lru_order()
+    {
+        for (size_t index = 0; index < 10; index++)
+            m_cache[index] = { int(index) };
+
+        m_cache[2].data();
+        QCOMPARE(m_cache.primed_indices(), (std::list<size_t>{ 2, 9, 8, 7, 6, 5, 4, 3, 1, 0 }));
+
+        m_cache.prune();
+        QCOMPARE(m_cache.current_usage(), 5);
+        QCOMPARE(m_cache.primed_indices(), (std::list<size_t>{ 2, 9, 8, 7, 6 }));
+
+        // the survivors of a prune are still tracked
+        m_cache[0] = { 0 };
+        m_cache.prune();
+        QCOMPARE(m_cache.primed_indices(), (std::list<size_t>{ 0, 2, 9, 8, 7 }));
+        QVERIFY2(!m_cache[6].is_set(), "Index 6 should be cleared.");
+    };
+
+    void benchmark_access_and_prune()
+    {
+        // a level 7 mesh with some 600 trixels on screen
+        const size_t num_trixels = 8 * 16384;
+        TestCache cache{ num_trixels, num_trixels / 10 };
+        size_t frame = 0;
+
+        QBENCHMARK
+        {
+            for (size_t i = 0; i < 600; i++)
+            {
+                auto &element = cache[(frame * 7 + i * 13) % num_trixels];
+                if (!element.is_set())
+                    element = { int(i) };
+            }
+
+            cache.prune(720);
+            frame++;
+        }
+
+        QVERIFY(cache.current_usage() <= cache.size());
+    };
+
     void clear()
     {
         m_cache    = { 2, 1 };
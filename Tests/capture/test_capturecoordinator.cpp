@@ -0,0 +1,93 @@
+/*
+    Tests for the coordination of several capture trains.
+
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "test_capturecoordinator.h"
+
+#include "ekos/capture/capturecoordinator.h"
+
+#include <memory>
+
+using Ekos::CaptureCoordinator;
+
+TestCaptureCoordinator::TestCaptureCoordinator() : QObject() {}
+
+void TestCaptureCoordinator::testSingleTrain()
+{
+    auto coordinator = CaptureCoordinator::Instance();
+    QObject train;
+    coordinator->addTrain(&train, []()
+    {
+        return false;
+    });
+    QCOMPARE(coordinator->trainCount(), 1);
+
+    QVERIFY(coordinator->mayStartExposure(&train));
+    QVERIFY(coordinator->requestDither(&train));
+    // a train is never held by its own dither
+    QVERIFY(coordinator->mayStartExposure(&train));
+    coordinator->ditherFinished(&train);
+
+    coordinator->removeTrain(&train);
+    QCOMPARE(coordinator->trainCount(), 0);
+}
+
+void TestCaptureCoordinator::testDitherBarrier()
+{
+    auto coordinator = CaptureCoordinator::Instance();
+    QObject first, second;
+    bool secondExposing = true;
+    coordinator->addTrain(&first, []()
+    {
+        return false;
+    });
+    coordinator->addTrain(&second, [&secondExposing]()
+    {
+        return secondExposing;
+    });
+
+    // the dither of the first train waits for the exposure of the second one
+    QVERIFY(coordinator->requestDither(&first) == false);
+    QVERIFY(coordinator->mayStartExposure(&first));
+    // which doesn't start its next exposure before the dither is over
+    secondExposing = false;
+    QVERIFY(coordinator->mayStartExposure(&second) == false);
+    QVERIFY(coordinator->requestDither(&first));
+    QVERIFY(coordinator->mayStartExposure(&second) == false);
+
+    coordinator->ditherFinished(&first);
+    QVERIFY(coordinator->mayStartExposure(&second));
+
+    coordinator->removeTrain(&first);
+    coordinator->removeTrain(&second);
+}
+
+void TestCaptureCoordinator::testRemoveTrain()
+{
+    auto coordinator = CaptureCoordinator::Instance();
+    QObject first;
+    auto second = std::make_unique<QObject>();
+    coordinator->addTrain(&first, []()
+    {
+        return false;
+    });
+    coordinator->addTrain(second.get(), []()
+    {
+        return true;
+    });
+    QCOMPARE(coordinator->trainCount(), 2);
+
+    QVERIFY(coordinator->requestDither(&first) == false);
+    second.reset();
+    QCOMPARE(coordinator->trainCount(), 1);
+    QVERIFY(coordinator->requestDither(&first));
+
+    coordinator->removeTrain(&first);
+    QCOMPARE(coordinator->trainCount(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestCaptureCoordinator)
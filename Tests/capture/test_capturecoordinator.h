@@ -0,0 +1,32 @@
+/*
+    Tests for the coordination of several capture trains.
+
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTest>
+
+class TestCaptureCoordinator : public QObject
+{
+        Q_OBJECT
+    public:
+        explicit TestCaptureCoordinator();
+
+    private slots:
+        /**
+         * @brief A single train dithers at once
+         */
+        void testSingleTrain();
+        /**
+         * @brief A dither waits for the exposures of the other trains and holds their next ones
+         */
+        void testDitherBarrier();
+        /**
+         * @brief A destroyed train neither holds nor is waited for
+         */
+        void testRemoveTrain();
+};
@@ -761,6 +761,50 @@ void TestPlaceholderPath::testGetCompletedFileIds()
 #endif
 }
 
+void TestPlaceholderPath::testFileIndex()
+{
+#if QT_VERSION < 0x050900
+    QSKIP("Skipping fixture-based test on old QT version.");
+#else
+    QDir("/tmp/kstars/index").removeRecursively();
+    XMLEle *root = buildXML("1", "Red", "Light", "prefix", "M31", "1", "1", "0", "",
+                            "/tmp/kstars/index/%t_%T_%F_%e", "1");
+
+    Ekos::SequenceJob job(root, "M31");
+    auto placeholderPath = Ekos::PlaceholderPath("/tmp/kstars/index/index.esq");
+    placeholderPath.setGenerateFilenameSettings(job);
+
+    QString filename = placeholderPath.generateOutputFilename(true, true, 1, ".fits", "");
+    QVERIFY(QDir().mkpath(QFileInfo(filename).dir().path()));
+    QVERIFY(QFile(filename).open(QIODevice::WriteOnly));
+    QCOMPARE(placeholderPath.checkSeqBoundary(job), 2);
+
+    // Once the directory has settled, its listing is kept...
+    QTest::qWait(2500);
+    QCOMPARE(placeholderPath.checkSeqBoundary(job), 2);
+
+    // ... and updated with the files capture creates
+    filename = placeholderPath.generateOutputFilename(true, true, 2, ".fits", "");
+    QVERIFY(QFile(filename).open(QIODevice::WriteOnly));
+    Ekos::PlaceholderPath::addToFileIndex(filename);
+    QCOMPARE(placeholderPath.checkSeqBoundary(job), 3);
+    QCOMPARE(placeholderPath.getCompletedFiles(job), 2);
+
+    // Files created by others are found as the directory changes
+    filename = placeholderPath.generateOutputFilename(true, true, 7, ".fits", "");
+    QVERIFY(QFile(filename).open(QIODevice::WriteOnly));
+    QCOMPARE(placeholderPath.checkSeqBoundary(job), 8);
+
+    // The scheduler counts the frames of a signature from the same listing
+    const QString signature = QFileInfo(filename).dir().filePath("M31");
+    QCOMPARE(Ekos::PlaceholderPath::getCompletedFiles(signature), 3);
+    filename = placeholderPath.generateOutputFilename(true, true, 8, ".fits", "");
+    QVERIFY(QFile(filename).open(QIODevice::WriteOnly));
+    Ekos::PlaceholderPath::addToFileIndex(filename);
+    QCOMPARE(Ekos::PlaceholderPath::getCompletedFiles(signature), 4);
+#endif
+}
+
 void TestPlaceholderPath::cleanupTestCase()
 {
     QDir("/tmp/kstars").removeRecursively();
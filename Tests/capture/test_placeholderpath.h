@@ -50,6 +50,8 @@ class TestPlaceholderPath : public QObject
     void testGetCompletedFileIds_data();
     void testGetCompletedFileIds();
 
+    void testFileIndex();
+
     void cleanupTestCase();
 };
 
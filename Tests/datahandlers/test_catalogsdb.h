@@ -10,6 +10,7 @@
 #include <QTemporaryFile>
 #include <qtestcase.h>
 #include "catalogsdb.h"
+#include "catalogtiles.h"
 #include "skymesh.h"
 
 using namespace CatalogsDB;
@@ -85,6 +86,80 @@ class TestCatalogsDB_DBManager : public QObject
         QVERIFY(num_obj > 0);
     }
 
+    void tiles_match_database()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const auto &path = QString("%1/%2").arg(dir.path()).arg("test.tiles");
+
+        const auto &compiled = m_manager.compile_tiles(path);
+        QVERIFY2(compiled.first, qPrintable(compiled.second));
+
+        const auto &stats = m_manager.get_master_statistics();
+        QVERIFY(stats.first);
+
+        TileFile tiles;
+        QVERIFY(!tiles.open(path, m_manager.htmesh_level(), stats.second.total_count + 1,
+                            m_manager.db_file_name())
+                     .first);
+
+        const auto &opened = tiles.open(path, m_manager.htmesh_level(),
+                                        stats.second.total_count,
+                                        m_manager.db_file_name());
+        QVERIFY2(opened.first, qPrintable(opened.second));
+
+        const int num_trixels = SkyMesh::Create(m_manager.htmesh_level())->size();
+        int num_obj           = 0;
+        for (int trixel = 0; trixel < num_trixels; trixel++)
+        {
+            const auto &known = m_manager.get_objects_in_trixel_no_nulls(trixel);
+            const auto &known_tiles = tiles.get_objects_in_trixel_no_nulls(trixel);
+            QCOMPARE(known_tiles.size(), known.size());
+
+            for (size_t i = 0; i < known.size(); i++)
+            {
+                QCOMPARE(known_tiles[i].mag(), known[i].mag());
+                if (i > 0)
+                    QVERIFY(known_tiles[i - 1].mag() <= known_tiles[i].mag());
+            }
+
+            for (const auto &obj : known_tiles)
+            {
+                const auto &found = std::find(known.cbegin(), known.cend(), obj);
+                QVERIFY(found != known.cend());
+                QCOMPARE(obj.name(), found->name());
+                QCOMPARE(obj.longname(), found->longname());
+                QCOMPARE(obj.catalogIdentifier(), found->catalogIdentifier());
+                QCOMPARE(obj.ra0(), found->ra0());
+                QCOMPARE(obj.dec0(), found->dec0());
+                QCOMPARE(obj.a(), found->a());
+                QCOMPARE(obj.b(), found->b());
+                QCOMPARE(obj.pa(), found->pa());
+                QCOMPARE(obj.catalogId(), found->catalogId());
+            }
+
+            const auto &unknown = m_manager.get_objects_in_trixel_null_mag(trixel);
+            const auto &unknown_tiles = tiles.get_objects_in_trixel_null_mag(trixel);
+            QCOMPARE(unknown_tiles.size(), unknown.size());
+
+            for (const auto &obj : unknown_tiles)
+            {
+                QVERIFY(std::isnan(obj.mag()));
+                QVERIFY(std::find(unknown.cbegin(), unknown.cend(), obj) !=
+                        unknown.cend());
+            }
+
+            num_obj += known_tiles.size() + unknown_tiles.size();
+        }
+
+        QVERIFY(num_obj > 0 && num_obj <= stats.second.total_count);
+
+        // recompiling the master catalog invalidates the tiles
+        QFile::copy(path, m_manager.tiles_file_name());
+        QVERIFY(m_manager.compile_master_catalog());
+        QVERIFY(!QFile::exists(m_manager.tiles_file_name()));
+    }
+
     void find_by_name()
     {
         const auto &obj  = some_object();
@@ -93,6 +168,20 @@ class TestCatalogsDB_DBManager : public QObject
         QCOMPARE(obj.name(), objs.front().name());
     }
 
+    void find_by_name_prefix()
+    {
+        for (const auto &name : { "TestNebula 123", "TestNebula 12345", "Other 12" })
+            QVERIFY(m_manager.add_object(0, SkyObject::GASEOUS_NEBULA, dms{ 0 }, dms{ 0 },
+                                         name)
+                        .first);
+
+        const auto &objs = m_manager.find_objects_by_name("TestNebula 12", 10);
+        QCOMPARE(objs.size(), 2);
+        QCOMPARE(objs.front().name(), "TestNebula 123");
+
+        QCOMPARE(m_manager.find_objects_by_name("\"", 10).size(), 0);
+    }
+
     void get_by_id()
     {
         const auto &obj     = some_object();
@@ -0,0 +1,82 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QTest>
+
+#include <QObject>
+#include "ekos/auxiliary/darkcombiner.h"
+
+#include <fitsio.h>
+
+class TestDarkCombiner : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestDarkCombiner();
+        ~TestDarkCombiner() override = default;
+
+    private slots:
+        void combineTest_data();
+        void combineTest();
+};
+
+#include "testdarkcombiner.moc"
+
+Q_DECLARE_METATYPE(Ekos::DarkCombiner::Method);
+
+TestDarkCombiner::TestDarkCombiner() : QObject()
+{
+}
+
+void TestDarkCombiner::combineTest_data()
+{
+    QTest::addColumn<Ekos::DarkCombiner::Method>("METHOD");
+    QTest::addColumn<int>("EXPECTED");
+
+    // Pixel 5 gets a cosmic ray in the frame holding 1002, which only the average keeps.
+    QTest::newRow("average") << Ekos::DarkCombiner::COMBINE_AVERAGE << 9431;
+    QTest::newRow("median") << Ekos::DarkCombiner::COMBINE_MEDIAN << 1004;
+    QTest::newRow("sigma-clip") << Ekos::DarkCombiner::COMBINE_SIGMA_CLIP << 1003;
+}
+
+void TestDarkCombiner::combineTest()
+{
+    QFETCH(Ekos::DarkCombiner::Method, METHOD);
+    QFETCH(int, EXPECTED);
+
+    constexpr uint32_t samples = 100003;
+    constexpr int frames = 7;
+
+    Ekos::DarkCombiner combiner;
+    combiner.reset(METHOD);
+    // Force several chunks for the methods combining from disk.
+    combiner.setChunkMemory(10000);
+
+    // Frame f holds 1000 + f everywhere, so the mean and the median are both 1003.
+    std::vector<uint16_t> frame(samples);
+    for (int f = 0; f < frames; f++)
+    {
+        std::fill(frame.begin(), frame.end(), 1000 + f);
+        if (f == 2)
+            frame[5] = 60000;
+        QVERIFY(combiner.add(reinterpret_cast<const uint8_t *>(frame.data()), TUSHORT, samples));
+    }
+    QCOMPARE(combiner.count(), static_cast<uint32_t>(frames));
+
+    std::vector<uint16_t> master(samples);
+    QVERIFY(combiner.combine(reinterpret_cast<uint8_t *>(master.data())));
+
+    QCOMPARE(static_cast<int>(master[5]), EXPECTED);
+    for (uint32_t i = 0; i < samples; i += 997)
+    {
+        if (i != 5)
+            QCOMPARE(static_cast<int>(master[i]), 1003);
+    }
+    QCOMPARE(static_cast<int>(master[samples - 1]), 1003);
+}
+
+QTEST_GUILESS_MAIN(TestDarkCombiner)
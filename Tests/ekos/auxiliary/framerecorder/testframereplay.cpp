@@ -0,0 +1,323 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+/*
+ * Replays a frame recording through the image processing of the internal guider and of Focus, at
+ * full speed, and reports the throughput of each stage. Set KSTARS_FRAME_RECORDING to a recording
+ * made with the RecordEkosFrames option to benchmark a real night; without it a recording is built
+ * from the FITS fixtures.
+ */
+
+#include "ekos/auxiliary/framerecorder.h"
+#include "ekos/focus/curvefit.h"
+#include "ekos/guide/internalguide/guidestars.h"
+#include "fitsviewer/fitsdata.h"
+#include "Options.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMap>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <QObject>
+
+#include <vector>
+
+class TestFrameReplay : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestFrameReplay();
+
+        /** @short Destructor */
+        ~TestFrameReplay() override = default;
+
+    private slots:
+        void initTestCase();
+        void recordTest();
+        void truncatedTest();
+        void replayTest();
+
+    private:
+        struct Stage
+        {
+            int frames { 0 };
+            qint64 nsecs { 0 };
+            qint64 bytes { 0 };
+        };
+
+        QString makeRecording();
+        void addTime(const QString &stage, const QElapsedTimer &timer, qint64 bytes = 0);
+        void report() const;
+
+        QTemporaryDir m_Dir;
+        QMap<QString, Stage> m_Stages;
+};
+
+#include "testframereplay.moc"
+
+using Ekos::FrameReader;
+using Ekos::FrameRecorder;
+
+namespace
+{
+constexpr int WIDTH = 64;
+constexpr int HEIGHT = 48;
+
+QByteArray makePixels(int seed)
+{
+    std::vector<uint16_t> pixels(WIDTH * HEIGHT);
+    for (int i = 0; i < WIDTH * HEIGHT; i++)
+        pixels[i] = static_cast<uint16_t>((i * 31 + seed * 977) % 65536);
+    return QByteArray(reinterpret_cast<const char *>(pixels.data()), pixels.size() * sizeof(uint16_t));
+}
+
+// Waits for a background load or detection in a GUI-less test
+bool finished(QFuture<bool> future)
+{
+    future.waitForFinished();
+    return future.result();
+}
+}
+
+TestFrameReplay::TestFrameReplay() : QObject()
+{
+}
+
+void TestFrameReplay::initTestCase()
+{
+    QVERIFY(m_Dir.isValid());
+    Options::setStellarSolverPartition(true);
+}
+
+void TestFrameReplay::recordTest()
+{
+    const QString filename = m_Dir.filePath("record.ksframes");
+    FrameRecorder recorder;
+    QVERIFY(recorder.open(filename));
+    for (int i = 0; i < 3; i++)
+    {
+        FrameRecorder::Frame frame;
+        frame.source = i % 2 ? FrameRecorder::FOCUS : FrameRecorder::GUIDE;
+        frame.timestamp = 1000 * i;
+        frame.exposure = 0.5 + i;
+        frame.metadata = {{"position", 100 + i}};
+        frame.fits = FrameRecorder::toFITS(TUSHORT, WIDTH, HEIGHT, 1, makePixels(i));
+        QVERIFY(!frame.fits.isEmpty());
+        QVERIFY(recorder.write(frame));
+    }
+    recorder.close();
+
+    FrameReader reader;
+    QVERIFY2(reader.open(filename), qPrintable(reader.errorString()));
+    FrameRecorder::Frame frame;
+    for (int i = 0; i < 3; i++)
+    {
+        QVERIFY(reader.next(frame));
+        QCOMPARE(frame.source, i % 2 ? FrameRecorder::FOCUS : FrameRecorder::GUIDE);
+        QCOMPARE(frame.timestamp, static_cast<qint64>(1000 * i));
+        QCOMPARE(frame.exposure, 0.5 + i);
+        QCOMPARE(frame.metadata["position"].toInt(), 100 + i);
+
+        FITSData data;
+        QVERIFY(data.loadFromBuffer(frame.fits, "fits"));
+        QCOMPARE(static_cast<int>(data.width()), WIDTH);
+        QCOMPARE(static_cast<int>(data.height()), HEIGHT);
+        QCOMPARE(data.dataType(), static_cast<uint32_t>(TUSHORT));
+        const QByteArray pixels = makePixels(i);
+        QVERIFY(memcmp(data.getImageBuffer(), pixels.constData(), pixels.size()) == 0);
+    }
+    QVERIFY(!reader.next(frame));
+}
+
+// A recording cut short while a frame was written still gives the frames before it
+void TestFrameReplay::truncatedTest()
+{
+    const QString filename = m_Dir.filePath("truncated.ksframes");
+    FrameRecorder recorder;
+    QVERIFY(recorder.open(filename));
+    FrameRecorder::Frame frame;
+    frame.fits = FrameRecorder::toFITS(TUSHORT, WIDTH, HEIGHT, 1, makePixels(1));
+    QVERIFY(recorder.write(frame));
+    QVERIFY(recorder.write(frame));
+    recorder.close();
+
+    QFile file(filename);
+    QVERIFY(file.resize(file.size() - 100));
+
+    FrameReader reader;
+    QVERIFY(reader.open(filename));
+    QVERIFY(reader.next(frame));
+    QVERIFY(!reader.next(frame));
+
+    QFile other(m_Dir.filePath("other.ksframes"));
+    QVERIFY(other.open(QIODevice::WriteOnly));
+    other.write("SIMPLE  =                    T");
+    other.close();
+    QVERIFY(!reader.open(other.fileName()));
+}
+
+void TestFrameReplay::replayTest()
+{
+    QString filename = qEnvironmentVariable("KSTARS_FRAME_RECORDING");
+    if (filename.isEmpty())
+        filename = makeRecording();
+    if (filename.isEmpty())
+        QSKIP("Skipping replay because of missing fixtures");
+
+    FrameReader reader;
+    QVERIFY2(reader.open(filename), qPrintable(reader.errorString()));
+
+    GuideStars guideStars;
+    bool firstGuideFrame = true;
+    int guideFrames = 0, focusFrames = 0, trackedFrames = 0;
+    QVector<int> positions;
+    QVector<double> hfrs;
+
+    QElapsedTimer total;
+    total.start();
+    FrameRecorder::Frame frame;
+    while (reader.next(frame))
+    {
+        const bool guide = frame.source == FrameRecorder::GUIDE;
+        QElapsedTimer timer;
+
+        timer.start();
+        QSharedPointer<FITSData> data(new FITSData(guide ? FITS_GUIDE : FITS_FOCUS));
+        QVERIFY(data->loadFromBuffer(frame.fits, "fits"));
+        addTime("load", timer, frame.fits.size());
+
+        if (guide)
+        {
+            guideFrames++;
+            timer.start();
+            finished(GuideStars::detectStars(data));
+            addTime("guide detect", timer);
+
+            timer.start();
+            if (firstGuideFrame)
+            {
+                const QVector3D star = guideStars.selectGuideStar(data);
+                firstGuideFrame = star.x() < 0;
+                if (!firstGuideFrame)
+                    trackedFrames++;
+            }
+            else
+            {
+                QSharedPointer<GuideView> noView;
+                const GuiderUtils::Vector star = guideStars.findGuideStar(data, QRect(), noView, false);
+                if (star.x >= 0)
+                    trackedFrames++;
+            }
+            addTime("guide track", timer);
+        }
+        else
+        {
+            focusFrames++;
+            timer.start();
+            finished(data->findStars(ALGORITHM_SEP));
+            addTime("focus detect", timer);
+
+            timer.start();
+            const double hfr = data->getHFR(HFR_AVERAGE);
+            addTime("focus measure", timer);
+            if (hfr > 0 && frame.metadata.contains("position"))
+            {
+                positions.append(frame.metadata["position"].toInt());
+                hfrs.append(hfr);
+            }
+        }
+    }
+    const qint64 elapsed = total.nsecsElapsed();
+
+    // The V curve of the focus frames, as autofocus fits it once it has its points
+    if (positions.size() >= 3)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        Ekos::CurveFitting curveFitting;
+        curveFitting.fitCurve(Ekos::CurveFitting::STANDARD, positions, hfrs, QVector<double>(hfrs.size(), 1.0),
+                              QVector<bool>(hfrs.size(), false), Ekos::CurveFitting::FOCUS_PARABOLA, false,
+                              Ekos::CurveFitting::OPTIMISATION_MINIMISE);
+        addTime("focus fit", timer);
+    }
+
+    report();
+    qInfo("Replayed %d guide and %d focus frames in %.1f ms", guideFrames, focusFrames, elapsed / 1e6);
+    QVERIFY(m_Stages["load"].frames > 0);
+    if (guideFrames > 1)
+        QVERIFY(trackedFrames > 0);
+}
+
+// A recording of the fixtures: a few guide frames of the same field and an autofocus run
+QString TestFrameReplay::makeRecording()
+{
+    const QStringList guideFiles {"m47_sim_stars.fits", "m47_sim_stars.fits", "m47_sim_stars.fits", "m47_sim_stars.fits"};
+    const QStringList focusFiles {"ngc4535-autofocus1.fits", "ngc4535-autofocus2.fits", "ngc4535-autofocus3.fits"};
+    for (const auto &file : guideFiles + focusFiles)
+        if (!QFile::exists(file))
+            return QString();
+
+    const QString filename = m_Dir.filePath("replay.ksframes");
+    FrameRecorder recorder;
+    if (!recorder.open(filename))
+        return QString();
+
+    auto add = [&](const QString & file, FrameRecorder::Source source, qint64 timestamp, const QVariantMap & metadata)
+    {
+        FITSData data;
+        if (!finished(data.loadFromFile(file)))
+            return false;
+        const FITSImage::Statistic &stats = data.getStatistics();
+        FrameRecorder::Frame frame;
+        frame.source = source;
+        frame.timestamp = timestamp;
+        frame.exposure = source == FrameRecorder::GUIDE ? 2 : 5;
+        frame.metadata = metadata;
+        frame.fits = FrameRecorder::toFITS(stats.dataType, stats.width, stats.height, stats.channels,
+                                           QByteArray(reinterpret_cast<const char *>(data.getImageBuffer()),
+                                                   static_cast<qint64>(stats.samples_per_channel) * stats.channels * stats.bytesPerPixel));
+        return !frame.fits.isEmpty() && recorder.write(frame);
+    };
+
+    qint64 timestamp = 0;
+    for (const auto &file : guideFiles)
+        if (!add(file, FrameRecorder::GUIDE, timestamp += 2000, {{"state", 0}}))
+            return QString();
+    // In and out of focus, so that the run makes a V
+    const QList<int> focusPositions {1000, 1500, 1250};
+    for (int i = 0; i < focusFiles.size(); i++)
+        if (!add(focusFiles[i], FrameRecorder::FOCUS, timestamp += 5000, {{"position", focusPositions[i]}, {"autofocus", true}}))
+            return QString();
+    recorder.close();
+    return filename;
+}
+
+void TestFrameReplay::addTime(const QString &stage, const QElapsedTimer &timer, qint64 bytes)
+{
+    Stage &s = m_Stages[stage];
+    s.frames++;
+    s.nsecs += timer.nsecsElapsed();
+    s.bytes += bytes;
+}
+
+void TestFrameReplay::report() const
+{
+    qInfo("%-14s %8s %12s %12s %10s", "stage", "frames", "total ms", "frames/s", "MB/s");
+    for (auto it = m_Stages.constBegin(); it != m_Stages.constEnd(); ++it)
+    {
+        const Stage &s = it.value();
+        const double seconds = s.nsecs / 1e9;
+        qInfo("%-14s %8d %12.2f %12.1f %10s", qPrintable(it.key()), s.frames, s.nsecs / 1e6,
+              seconds > 0 ? s.frames / seconds : 0.0,
+              s.bytes > 0 && seconds > 0 ? qPrintable(QString::number(s.bytes / seconds / 1e6, 'f', 1)) : "");
+    }
+}
+
+QTEST_GUILESS_MAIN(TestFrameReplay)
@@ -11,6 +11,7 @@
 #include "ekos/auxiliary/solverutils.h"
 #include "ekos/auxiliary/stellarsolverprofile.h"
 #include <QtGlobal>
+#include <QTemporaryDir>
 
 Q_DECLARE_METATYPE(FITSMode);
 
@@ -410,6 +411,53 @@ void TestFitsData::testSEPAlgorithmBenchmark()
 #endif
 }
 
+void TestFitsData::testSaveImageBenchmark_data()
+{
+#if QT_VERSION < 0x050900
+    QSKIP("Skipping fixture-based test on old QT version.");
+#else
+    initGenericDataFixture();
+#endif
+}
+
+void TestFitsData::testSaveImageBenchmark()
+{
+#if QT_VERSION < 0x050900
+    QSKIP("Skipping fixture-based test on old QT version.");
+#else
+    QFETCH(QString, NAME);
+
+    if(!QFile::exists(NAME))
+        QSKIP("Skipping load test because of missing fixture");
+
+    std::unique_ptr<FITSData> d(new FITSData());
+    QVERIFY(d != nullptr);
+
+    QFuture<bool> worker = d->loadFromFile(NAME);
+    QTRY_VERIFY_WITH_TIMEOUT(worker.isFinished(), 10000);
+    QVERIFY(worker.result());
+
+    // Saving to the current file name is a no-op, so alternate between two files.
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filenames[2] = { dir.filePath("save1.fits"), dir.filePath("save2.fits") };
+    int saved = 0;
+
+    QBENCHMARK { QVERIFY(d->saveImage(filenames[saved++ % 2])); }
+
+    // The saved keywords must survive the round trip.
+    std::unique_ptr<FITSData> reloaded(new FITSData());
+    worker = reloaded->loadFromFile(d->filename());
+    QTRY_VERIFY_WITH_TIMEOUT(worker.isFinished(), 10000);
+    QVERIFY(worker.result());
+    QVariant value;
+    QVERIFY(reloaded->getRecordValue("MIN1", value));
+    QVERIFY(reloaded->getRecordValue("MAX1", value));
+    QCOMPARE(reloaded->width(), d->width());
+    QCOMPARE(reloaded->height(), d->height());
+#endif
+}
+
 QString SolverLoop::status() const
 {
     return QString("%1/%2 %3% %4 %5")
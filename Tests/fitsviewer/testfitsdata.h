@@ -46,6 +46,9 @@ class TestFitsData : public QObject
         void testSEPAlgorithmBenchmark_data();
         void testSEPAlgorithmBenchmark();
 
+        void testSaveImageBenchmark_data();
+        void testSaveImageBenchmark();
+
         void testComputeHFR_data();
         void testComputeHFR();
 
@@ -0,0 +1,81 @@
+/*  KStars tests
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "testlivestacker.h"
+
+#include "fitsviewer/livestacker.h"
+
+#include <QRandomGenerator>
+#include <QtMath>
+#include <QTest>
+
+namespace
+{
+QVector<QPointF> randomStars(int count, quint32 seed)
+{
+    QRandomGenerator generator(seed);
+    QVector<QPointF> stars;
+    for (int i = 0; i < count; i++)
+        stars.append(QPointF(generator.bounded(1000.0), generator.bounded(800.0)));
+    return stars;
+}
+}
+
+TestLiveStacker::TestLiveStacker(QObject *parent) : QObject(parent)
+{
+}
+
+void TestLiveStacker::testMatch_data()
+{
+    QTest::addColumn<double>("dx");
+    QTest::addColumn<double>("dy");
+    QTest::addColumn<double>("rotation");
+    QTest::addColumn<double>("scale");
+    QTest::addColumn<int>("missing");
+
+    QTest::newRow("identity") << 0.0 << 0.0 << 0.0 << 1.0 << 0;
+    QTest::newRow("shift") << 12.5 << -7.25 << 0.0 << 1.0 << 0;
+    QTest::newRow("rotation") << 3.0 << 4.0 << 2.0 << 1.0 << 0;
+    QTest::newRow("field rotation") << -20.0 << 15.0 << 30.0 << 1.0 << 0;
+    QTest::newRow("scale") << 1.0 << 1.0 << 0.5 << 1.03 << 0;
+    QTest::newRow("missing stars") << 5.0 << 5.0 << 1.0 << 1.0 << 4;
+}
+
+void TestLiveStacker::testMatch()
+{
+    QFETCH(double, dx);
+    QFETCH(double, dy);
+    QFETCH(double, rotation);
+    QFETCH(double, scale);
+    QFETCH(int, missing);
+
+    LiveStacker::Transform expected;
+    expected.a = scale * std::cos(rotation * M_PI / 180);
+    expected.b = scale * std::sin(rotation * M_PI / 180);
+    expected.tx = dx;
+    expected.ty = dy;
+
+    const QVector<QPointF> reference = randomStars(20, 42);
+    QVector<QPointF> frame;
+    for (int i = missing; i < reference.size(); i++)
+        frame.append(expected.map(reference[i]));
+
+    LiveStacker::Transform transform;
+    QVERIFY(LiveStacker::match(reference, frame, transform));
+    QVERIFY(std::abs(transform.scale() - scale) < 1e-3);
+    QVERIFY(std::abs(transform.rotation() - rotation) < 1e-2);
+    QVERIFY(std::abs(transform.tx - dx) < 0.1);
+    QVERIFY(std::abs(transform.ty - dy) < 0.1);
+}
+
+void TestLiveStacker::testMatchTooFewStars()
+{
+    const QVector<QPointF> reference = randomStars(2, 7);
+    LiveStacker::Transform transform;
+    QVERIFY(!LiveStacker::match(reference, reference, transform));
+}
+
+QTEST_GUILESS_MAIN(TestLiveStacker)
@@ -0,0 +1,21 @@
+/*  KStars tests
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+
+class TestLiveStacker : public QObject
+{
+        Q_OBJECT
+    public:
+        explicit TestLiveStacker(QObject *parent = nullptr);
+
+    private slots:
+        void testMatch_data();
+        void testMatch();
+        void testMatchTooFewStars();
+};
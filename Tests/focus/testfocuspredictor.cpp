@@ -0,0 +1,112 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/focus/focuspredictor.h"
+#include "ekos/ekos.h"
+
+#include <QTest>
+#include <cmath>
+
+#include <QObject>
+
+class TestFocusPredictor : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestFocusPredictor() : QObject() {}
+        ~TestFocusPredictor() override = default;
+
+    private slots:
+        void tooFewRunsTest();
+        void meanTest();
+        void temperatureTest();
+        void temperatureAndAltitudeTest();
+        void unknownTemperatureTest();
+};
+
+#include "testfocuspredictor.moc"
+
+using Ekos::FocusPredictor;
+
+void TestFocusPredictor::tooFewRunsTest()
+{
+    FocusPredictor predictor;
+    int position = 0;
+    double uncertainty = 0;
+    QVERIFY(!predictor.predict(10, 45, &position, &uncertainty));
+
+    predictor.setRuns({{1000, 10, 45}, {1002, 10, 45}});
+    QVERIFY(!predictor.predict(10, 45, &position, &uncertainty));
+}
+
+// Runs too close in temperature and altitude only give their mean
+void TestFocusPredictor::meanTest()
+{
+    FocusPredictor predictor;
+    predictor.setRuns({{1000, 10.0, 45}, {1010, 10.2, 46}, {1020, 10.4, 47}});
+    int position = 0;
+    double uncertainty = 0;
+    QVERIFY(predictor.predict(0, 80, &position, &uncertainty));
+    QCOMPARE(position, 1010);
+    QVERIFY(uncertainty > 5 && uncertainty < 15);
+}
+
+void TestFocusPredictor::temperatureTest()
+{
+    // Focus moves out 20 ticks per degree as it cools
+    QVector<FocusPredictor::Run> runs;
+    for (int i = 0; i < 6; i++)
+        runs.append({5000 - 20 * i, static_cast<double>(i), 45});
+
+    FocusPredictor predictor;
+    predictor.setRuns(runs);
+    int position = 0;
+    double uncertainty = 0;
+    QVERIFY(predictor.predict(8, 45, &position, &uncertainty));
+    QCOMPARE(position, 4840);
+    QVERIFY(uncertainty < 1e-6);
+}
+
+void TestFocusPredictor::temperatureAndAltitudeTest()
+{
+    QVector<FocusPredictor::Run> runs;
+    for (int i = 0; i < 8; i++)
+    {
+        const double temperature = i % 4;
+        const double altitude = 30 + 5 * i;
+        runs.append({static_cast<int>(std::round(3000 - 15 * temperature + 2 * altitude)), temperature, altitude});
+    }
+
+    FocusPredictor predictor;
+    predictor.setRuns(runs);
+    int position = 0;
+    double uncertainty = 0;
+    QVERIFY(predictor.predict(2, 60, &position, &uncertainty));
+    QCOMPARE(position, 3000 - 30 + 120);
+}
+
+// Runs without a temperature are left out of a temperature fit, and no temperature now means no temperature term
+void TestFocusPredictor::unknownTemperatureTest()
+{
+    QVector<FocusPredictor::Run> runs;
+    for (int i = 0; i < 5; i++)
+        runs.append({2000 - 10 * i, static_cast<double>(i), INVALID_VALUE});
+    runs.append({9999, INVALID_VALUE, INVALID_VALUE});
+
+    FocusPredictor predictor;
+    predictor.setRuns(runs);
+    int position = 0;
+    double uncertainty = 0;
+    QVERIFY(predictor.predict(6, INVALID_VALUE, &position, &uncertainty));
+    QCOMPARE(position, 1940);
+
+    QVERIFY(predictor.predict(INVALID_VALUE, INVALID_VALUE, &position, &uncertainty));
+    // The mean of all six runs
+    QCOMPARE(position, static_cast<int>(std::round((2000 + 1990 + 1980 + 1970 + 1960 + 9999) / 6.0)));
+}
+
+QTEST_GUILESS_MAIN(TestFocusPredictor)
@@ -52,9 +52,11 @@ class TestCalibrationProcess : public QObject
 
     private slots:
         void basicTest();
+        void fastReturnTest();
 
     private:
         void runTest(const CalibrationTest &test);
+        int simulate(Calibration *calibration);
 };
 
 #include "testcalibrationprocess.moc"
@@ -247,6 +249,7 @@ void TestCalibrationProcess::runTest(const CalibrationTest &test)
     Options::setGuideCalibrationBacklash(test.backlash);
     Options::setCalibrationPulseDuration(test.pulse);
     Options::setCalibrationMaxMove(test.maxMove);
+    Options::setCalibrationFastReturn(false);
 
     Calibration calibration;
 
@@ -281,4 +284,70 @@ void TestCalibrationProcess::basicTest()
     runTest(calTest4);
 }
 
+// Calibrates against a mount moving the star 1 pixel per second of RA pulse along y
+// and 1 pixel per 1.2 seconds of DEC pulse along x, returns the number of iterations.
+int TestCalibrationProcess::simulate(Calibration *calibration)
+{
+    double x = 100, y = 100;
+    CalibrationProcess calibrationProcess(x, y, false);
+    calibrationProcess.useCalibration(calibration);
+
+    int iterations = 0;
+    for (; iterations < 100; iterations++)
+    {
+        calibrationProcess.iterate(x, y);
+        if (calibrationProcess.getStatus() != GuideState::GUIDE_CALIBRATING)
+            break;
+
+        GuideDirection dir;
+        int msec;
+        calibrationProcess.getPulse(&dir, &msec);
+        switch (dir)
+        {
+            case RA_INC_DIR:
+                y += msec / 1000.0;
+                break;
+            case RA_DEC_DIR:
+                y -= msec / 1000.0;
+                break;
+            case DEC_INC_DIR:
+                x += msec / 1200.0;
+                break;
+            case DEC_DEC_DIR:
+                x -= msec / 1200.0;
+                break;
+            default:
+                break;
+        }
+    }
+    if (calibrationProcess.getStatus() != GuideState::GUIDE_CALIBRATION_SUCCESS)
+        return -1;
+    return iterations;
+}
+
+void TestCalibrationProcess::fastReturnTest()
+{
+    Options::setAutoModeIterations(5);
+    Options::setGuideCalibrationBacklash(false);
+    Options::setCalibrationPulseDuration(1000);
+    Options::setCalibrationMaxMove(15);
+
+    Options::setCalibrationFastReturn(false);
+    Calibration calibration;
+    const int iterations = simulate(&calibration);
+    QVERIFY(iterations > 0);
+
+    Options::setCalibrationFastReturn(true);
+    Calibration fastCalibration;
+    const int fastIterations = simulate(&fastCalibration);
+    QVERIFY(fastIterations > 0);
+
+    // Each axis comes back in one pulse instead of four
+    QCOMPARE(fastIterations, iterations - 6);
+    QVERIFY(compareDouble(fastCalibration.getRAAngle(), calibration.getRAAngle()));
+    QVERIFY(compareDouble(fastCalibration.getDECAngle(), calibration.getDECAngle()));
+    QVERIFY(compareDouble(fastCalibration.raPulseMillisecondsPerArcsecond(), calibration.raPulseMillisecondsPerArcsecond()));
+    QVERIFY(compareDouble(fastCalibration.decPulseMillisecondsPerArcsecond(), calibration.decPulseMillisecondsPerArcsecond()));
+}
+
 QTEST_GUILESS_MAIN(TestCalibrationProcess)
@@ -0,0 +1,101 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/guide/internalguide/dithersettle.h"
+
+#include <QTest>
+
+#include <QObject>
+
+#include <cmath>
+#include <random>
+
+class TestDitherSettle : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestDitherSettle();
+
+        /** @short Destructor */
+        ~TestDitherSettle() override = default;
+
+    private slots:
+        void shiftTest();
+        void lostStarTest();
+        void edgeTest();
+};
+
+#include "testdithersettle.moc"
+
+namespace
+{
+constexpr int WIDTH = 100;
+constexpr int HEIGHT = 80;
+
+// A noisy frame with a single gaussian star at x, y
+std::vector<float> makeFrame(double x, double y, int seed)
+{
+    std::default_random_engine generator(seed);
+    std::normal_distribution<float> noise(0, 3);
+    std::vector<float> frame(WIDTH * HEIGHT);
+    for (int j = 0; j < HEIGHT; j++)
+        for (int i = 0; i < WIDTH; i++)
+        {
+            const double r2 = (i - x) * (i - x) + (j - y) * (j - y);
+            frame[j * WIDTH + i] = 100 + 1000 * std::exp(-r2 / 8) + noise(generator);
+        }
+    return frame;
+}
+}
+
+TestDitherSettle::TestDitherSettle() : QObject()
+{
+}
+
+void TestDitherSettle::shiftTest()
+{
+    DitherSettle settle;
+    settle.reset(50, 40);
+
+    // Nothing to compare the first frame with
+    QVERIFY(!settle.addFrame(makeFrame(50, 40, 1).data(), WIDTH, HEIGHT));
+
+    QVERIFY(settle.addFrame(makeFrame(52.3, 39.1, 2).data(), WIDTH, HEIGHT));
+    QVERIFY(std::fabs(settle.shift() - std::hypot(2.3, 0.9)) < 0.15);
+
+    QVERIFY(settle.addFrame(makeFrame(52.5, 39.0, 3).data(), WIDTH, HEIGHT));
+    QVERIFY(std::fabs(settle.shift() - std::hypot(0.2, 0.1)) < 0.1);
+
+    QVERIFY(settle.addFrame(makeFrame(52.5, 39.0, 4).data(), WIDTH, HEIGHT));
+    QVERIFY(settle.shift() < 0.1);
+}
+
+void TestDitherSettle::lostStarTest()
+{
+    DitherSettle settle;
+    settle.reset(50, 40);
+    QVERIFY(!settle.addFrame(makeFrame(50, 40, 1).data(), WIDTH, HEIGHT));
+
+    // Moved further than is searched
+    QVERIFY(!settle.addFrame(makeFrame(60, 50, 2).data(), WIDTH, HEIGHT));
+
+    // No star at all
+    const std::vector<float> flat(WIDTH * HEIGHT, 100);
+    QVERIFY(!settle.addFrame(flat.data(), WIDTH, HEIGHT));
+    QVERIFY(!settle.addFrame(flat.data(), WIDTH, HEIGHT));
+}
+
+void TestDitherSettle::edgeTest()
+{
+    DitherSettle settle;
+    settle.reset(5, 40);
+    QVERIFY(!settle.addFrame(makeFrame(5, 40, 1).data(), WIDTH, HEIGHT));
+    QVERIFY(!settle.addFrame(makeFrame(5, 40, 2).data(), WIDTH, HEIGHT));
+}
+
+QTEST_GUILESS_MAIN(TestDitherSettle)
@@ -28,6 +28,7 @@ class TestGuideStars : public QObject
     private slots:
         void basicTest();
         void calibrationTest();
+        void measureStarTest();
 };
 
 #include "testguidestars.moc"
@@ -606,4 +607,38 @@ void TestGuideStars::calibrationTest()
     CompareFloat(cal.raPulseMillisecondsPerArcsecond() * cal.xArcsecondsPerPixel(), raPulseRate);
 }
 
+void TestGuideStars::measureStarTest()
+{
+    // A Gaussian star on a flat background, slightly off the center of the window.
+    constexpr int width = 41, height = 41;
+    constexpr double background = 100, amplitude = 1000, starX = 20.3, starY = 19.6;
+    QVector<float> window(width * height);
+    for (double sigma : {1.0, 1.5, 2.5})
+    {
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+            {
+                const double dx = x - starX, dy = y - starY;
+                window[y * width + x] = background + amplitude * exp(-(dx * dx + dy * dy) / (2 * sigma * sigma));
+            }
+
+        Edge star;
+        QVERIFY(GuideStars::measureStar(window.constData(), width, height, 13, &star));
+        QVERIFY(fabs(star.x - starX) < 0.01);
+        QVERIFY(fabs(star.y - starY) < 0.01);
+        QVERIFY(fabs(star.val - amplitude) < amplitude * 0.1);
+        // The HFR of a Gaussian is sigma * sqrt(2 ln 2), up to the pixel sampling.
+        QVERIFY(fabs(star.HFR - 1.1774 * sigma) < 0.25);
+        QVERIFY(fabs(star.sum - 2 * M_PI * sigma * sigma * amplitude) < 0.01 * star.sum);
+    }
+
+    // Nothing stands out of a flat window.
+    window.fill(background);
+    Edge star;
+    QVERIFY(!GuideStars::measureStar(window.constData(), width, height, 13, &star));
+
+    // Nor out of a window too small for the star.
+    QVERIFY(!GuideStars::measureStar(window.constData(), 20, 20, 13, &star));
+}
+
 QTEST_GUILESS_MAIN(TestGuideStars)
@@ -24,6 +24,7 @@ class TestStarCorrespondence : public QObject
 
     private slots:
         void basicTest();
+        void gridTest();
 };
 
 #include "teststarcorrespondence.moc"
@@ -238,4 +239,53 @@ void TestStarCorrespondence::basicTest()
     runNoCorrespondenceTest();
 }
 
+// Reference for the grid, the linear scan it replaced.
+int closestStar(const QList<Edge> &stars, double x, double y, double maxDistance)
+{
+    int bestIndex = -1;
+    double bestSquaredDistance = maxDistance * maxDistance;
+    for (int i = 0; i < stars.size(); ++i)
+    {
+        const double squaredDistance = (stars[i].x - x) * (stars[i].x - x) + (stars[i].y - y) * (stars[i].y - y);
+        if (squaredDistance <= bestSquaredDistance)
+        {
+            bestIndex = i;
+            bestSquaredDistance = squaredDistance;
+        }
+    }
+    return bestIndex;
+}
+
+void TestStarCorrespondence::gridTest()
+{
+    srand(1);
+    for (int test = 0; test < 50; ++test)
+    {
+        QList<Edge> stars;
+        const int numStars = rand() % 300;
+        for (int i = 0; i < numStars; ++i)
+        {
+            stars.append(makeEdge((rand() % 20000) / 10.0, (rand() % 15000) / 10.0));
+            // Duplicates check that ties are resolved like the linear scan.
+            if (rand() % 10 == 0)
+                stars.append(stars.last());
+        }
+        const double maxDistance = (rand() % 30) / 2.0;
+        const StarGrid grid(stars, maxDistance);
+
+        for (int query = 0; query < 200; ++query)
+        {
+            double x = rand() % 2400 - 200, y = rand() % 1900 - 200;
+            if (query % 2 == 0 && !stars.empty())
+            {
+                const Edge &star = stars[rand() % stars.size()];
+                x = star.x + (rand() % 5 - 2);
+                y = star.y;
+            }
+            double distance;
+            QCOMPARE(grid.findClosest(x, y, maxDistance, &distance), closestStar(stars, x, y, maxDistance));
+        }
+    }
+}
+
 QTEST_GUILESS_MAIN(TestStarCorrespondence)
@@ -0,0 +1,73 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "test_pointingmodel.h"
+
+#include "auxiliary/dms.h"
+#include "skypoint.h"
+
+#include <cmath>
+
+namespace
+{
+// Adds a point with the errors the given terms cause at hour angle ha (hours) and declination dec (degrees)
+void addModelPoint(PointingModel &model, const double terms[PointingModel::TERMS], double ha, double dec)
+{
+    const double h = ha * 15 * dms::DegToRad, d = dec * dms::DegToRad;
+    const double dH = terms[PointingModel::IH] + terms[PointingModel::CH] / std::cos(d) + terms[PointingModel::NP] * std::tan(d)
+                      - terms[PointingModel::MA] * std::cos(h) * std::tan(d) + terms[PointingModel::ME] * std::sin(h) * std::tan(d);
+    const double dD = terms[PointingModel::ID] + terms[PointingModel::MA] * std::sin(h) + terms[PointingModel::ME] * std::cos(h);
+
+    // The sidereal time is 0h, so the right ascension of the mount is -ha.
+    const dms lst(0.0);
+    dms mountRA, solvedRA;
+    mountRA.setH(-ha);
+    solvedRA.setD(mountRA.Degrees() + dH / 3600);
+    const SkyPoint mount(mountRA, dms(dec));
+    const SkyPoint solved(solvedRA, dms(dec - dD / 3600));
+    model.addPoint(mount, solved, lst);
+}
+}
+
+void TestPointingModel::testFit()
+{
+    const double terms[PointingModel::TERMS] = { 120, -60, 30, -20, 90, -45 };
+
+    PointingModel model;
+    for (double dec : {-10.0, 20.0, 50.0, 75.0})
+        for (double ha = -5; ha <= 5; ha += 2)
+            addModelPoint(model, terms, ha, dec);
+
+    QVERIFY(model.fit());
+    for (int i = 0; i < PointingModel::TERMS; i++)
+        QVERIFY2(std::fabs(model.term(static_cast<PointingModel::Term>(i)) - terms[i]) < 0.1,
+                 qPrintable(QString("%1: %2, expected %3").arg(PointingModel::termName(static_cast<PointingModel::Term>(i)))
+                            .arg(model.term(static_cast<PointingModel::Term>(i))).arg(terms[i])));
+    QVERIFY(model.rms() < 0.1);
+}
+
+void TestPointingModel::testTooFewPoints()
+{
+    const double terms[PointingModel::TERMS] = { 10, 10, 10, 10, 10, 10 };
+
+    PointingModel model;
+    for (int i = 0; i < PointingModel::MIN_POINTS - 1; i++)
+        addModelPoint(model, terms, i, 10.0 * i);
+    QVERIFY(!model.fit());
+}
+
+void TestPointingModel::testDegeneratePoints()
+{
+    const double terms[PointingModel::TERMS] = { 10, 10, 10, 10, 10, 10 };
+
+    // On a single declination collimation cannot be told from the index error
+    PointingModel model;
+    for (double ha = -5; ha <= 5; ha += 1)
+        addModelPoint(model, terms, ha, 30.0);
+    QVERIFY(!model.fit());
+}
+
+QTEST_GUILESS_MAIN(TestPointingModel)
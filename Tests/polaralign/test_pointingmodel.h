@@ -0,0 +1,28 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTest>
+
+#include "../../kstars/ekos/align/pointingmodel.h"
+
+/**
+ * @class TestPointingModel
+ * @short Tests the fit of the pointing model terms
+ */
+class TestPointingModel : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestPointingModel() = default;
+
+    private slots:
+        void testFit();
+        void testTooFewPoints();
+        void testDegeneratePoints();
+};
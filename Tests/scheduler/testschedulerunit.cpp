@@ -20,6 +20,7 @@
 #include "geolocation.h"
 #include "Options.h"
 
+#include <QTemporaryDir>
 #include <QTest>
 #include <memory>
 
@@ -46,6 +47,9 @@ class TestSchedulerUnit : public QObject
         void loadSequenceQueueTest();
         void estimateJobTimeTest();
         void evaluateJobsTest();
+        void incrementalScheduleTest();
+        void scheduleBenchmark();
+        void targetAltitudesTest();
 
     private:
         void runSetupJob(Ekos::SchedulerJob &job,
@@ -348,6 +352,26 @@ void TestSchedulerUnit::loadSequenceQueueTest()
     QVERIFY(Ekos::SchedulerUtils::loadSequenceQueue(seqFile9Filters, &schedJob, jobs, hasAutoFocus, nullptr));
     // Makes sure we have the basic details of the capture sequence were read properly.
     compareCaptureSequence(details9Filters, jobs);
+
+    // The parsed file is kept, and replaced once the file changes.
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString copy = dir.filePath("sequence.esq");
+    const QDateTime before = QDateTime::currentDateTime().addSecs(-3600);
+    for (const auto &source : {seqFile9Filters, seqFile9Filters, QString("3x30s_Red.esq")})
+    {
+        QFile::remove(copy);
+        QVERIFY(QFile::copy(source, copy));
+        QFile file(copy);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.setFileTime(before.addSecs(source == seqFile9Filters ? 0 : 60), QFileDevice::FileModificationTime));
+        file.close();
+
+        QList<Ekos::SequenceJob *> copyJobs;
+        QVERIFY(Ekos::SchedulerUtils::loadSequenceQueue(copy, &schedJob, copyJobs, hasAutoFocus, nullptr));
+        QCOMPARE(copyJobs.size(), source == seqFile9Filters ? details9Filters.size() : 1);
+        qDeleteAll(copyJobs);
+    }
 }
 
 namespace
@@ -606,4 +630,135 @@ void TestSchedulerUnit::evaluateJobsTest()
     jobs.clear();
 }
 
+// Test that rescheduling after a change, which replays what the change doesn't affect,
+// gives the same plan as scheduling from scratch.
+void TestSchedulerUnit::incrementalScheduleTest()
+{
+    auto localTime8pm = midNight.addSecs(-4 * 3600);
+    Ekos::SchedulerModuleState::setLocalTime(&localTime8pm);
+    const QMap<QString, uint16_t> capturedFrames;
+
+    Ekos::SchedulerJob job1(nullptr), job2(nullptr), job3(nullptr);
+    runSetupJob(job1, &siliconValley, &localTime8pm, "Job1",
+                midnightRA, testDEC, 0.0,
+                QUrl(QString("file:%1").arg(seqFile9Filters)), QUrl(""),
+                Ekos::START_ASAP, QDateTime(),
+                Ekos::FINISH_REPEAT, QDateTime(), 2,
+                80.0);
+    runSetupJob(job2, &siliconValley, &localTime8pm, "Job2",
+                midnightRA, testDEC, 0.0,
+                QUrl(QString("file:%1").arg(seqFile9Filters)), QUrl(""),
+                Ekos::START_ASAP, QDateTime(),
+                Ekos::FINISH_SEQUENCE, QDateTime(), 1,
+                30.0);
+    runSetupJob(job3, &siliconValley, &localTime8pm, "Job3",
+                midnightRA, testDEC, 0.0,
+                QUrl(QString("file:%1").arg(seqFile9Filters)), QUrl(""),
+                Ekos::START_ASAP, QDateTime(),
+                Ekos::FINISH_SEQUENCE, QDateTime(), 1,
+                60.0);
+    QList<Ekos::SchedulerJob *> jobs = { &job1, &job2, &job3 };
+
+    Ekos::GreedyScheduler incremental;
+    incremental.setParams(true, true, true, 3600, 3600);
+    incremental.scheduleJobs(jobs, localTime8pm, capturedFrames, nullptr);
+    QVERIFY(!incremental.getSchedule().empty());
+
+    // Rescheduling unchanged jobs, and then after lowering the altitude constraint of the last one.
+    for (int change = 0; change < 2; ++change)
+    {
+        if (change == 1)
+            job3.setMinAltitude(40.0);
+        incremental.scheduleJobs(jobs, localTime8pm, capturedFrames, nullptr);
+        const auto replayed = incremental.getSchedule();
+        const auto replayedStart = job3.getStartupTime();
+
+        Ekos::GreedyScheduler fresh;
+        fresh.setParams(true, true, true, 3600, 3600);
+        fresh.scheduleJobs(jobs, localTime8pm, capturedFrames, nullptr);
+        const auto &expected = fresh.getSchedule();
+
+        QCOMPARE(replayed.size(), expected.size());
+        for (int i = 0; i < expected.size(); ++i)
+        {
+            QVERIFY(replayed[i].job == expected[i].job);
+            QCOMPARE(replayed[i].startTime, expected[i].startTime);
+            QCOMPARE(replayed[i].stopTime, expected[i].stopTime);
+            QCOMPARE(replayed[i].stopReason, expected[i].stopReason);
+        }
+        QCOMPARE(replayedStart, job3.getStartupTime());
+    }
+}
+
+// Times scheduling a large queue, which selectNextJob() searches in parallel.
+void TestSchedulerUnit::scheduleBenchmark()
+{
+    auto localTime8pm = midNight.addSecs(-4 * 3600);
+    Ekos::SchedulerModuleState::setLocalTime(&localTime8pm);
+    const QMap<QString, uint16_t> capturedFrames;
+
+    // Targets spread over the sky with a range of altitude constraints, so that the
+    // jobs start and stop at many different times through the night.
+    QList<Ekos::SchedulerJob *> jobs;
+    for (int i = 0; i < 200; ++i)
+    {
+        auto job = new Ekos::SchedulerJob(nullptr);
+        runSetupJob(*job, &siliconValley, &localTime8pm, QString("Job%1").arg(i),
+                    dms(fmod(midnightRA.Degrees() + 37.0 * i, 360.0)), dms(testDEC.Degrees() - (i % 7) * 10.0), 0.0,
+                    QUrl(QString("file:%1").arg(seqFile9Filters)), QUrl(""),
+                    Ekos::START_ASAP, QDateTime(),
+                    Ekos::FINISH_SEQUENCE, QDateTime(), 1,
+                    20.0 + (i % 5) * 10.0);
+        jobs.append(job);
+    }
+
+    QBENCHMARK
+    {
+        // Start from scratch each time, rather than from what the previous run left behind
+        for (auto job : jobs)
+            job->clearCache();
+        Ekos::GreedyScheduler scheduler;
+        scheduler.setParams(true, true, true, 3600, 3600);
+        scheduler.scheduleJobs(jobs, localTime8pm, capturedFrames, nullptr);
+        QVERIFY(!scheduler.getSchedule().empty());
+    }
+
+    qDeleteAll(jobs);
+}
+
+// Test that Ekos::TargetAltitudes agrees with the precomputed altitudes and with SchedulerUtils::findAltitude().
+void TestSchedulerUnit::targetAltitudesTest()
+{
+    Ekos::SchedulerModuleState::setGeo(&siliconValley);
+    Ekos::SchedulerModuleState::setLocalTime(&midNight);
+
+    SkyPoint target;
+    target.setRA0(midnightRA);
+    target.setDec0(testDEC);
+
+    const KStarsDateTime ut = siliconValley.LTtoUT(midNight);
+    const Ekos::TargetAltitudes evaluator(target, ut, &siliconValley);
+
+    QVector<double> altitudes(svAltitudes.size()), azimuths(svAltitudes.size());
+    evaluator.altitudes(-12 * 3600.0, 3600.0, svAltitudes.size(), altitudes.data(), azimuths.data());
+
+    for (int i = 0; i < svAltitudes.size(); ++i)
+    {
+        const double seconds = (i - 12) * 3600.0;
+        double azimuth = 0;
+        bool setting = false, findSetting = false;
+        const double altitude = evaluator.altitude(seconds, &azimuth, &setting);
+
+        QVERIFY(compareFloat(altitude, svAltitudes[i], .01));
+        QVERIFY(compareFloat(altitudes[i], altitude, .0001));
+        QVERIFY(compareFloat(azimuths[i], azimuth, .0001));
+
+        const QDateTime when = midNight.addSecs(seconds);
+        QVERIFY(compareFloat(altitude, Ekos::SchedulerUtils::findAltitude(target, when, &findSetting), .001));
+        // Right at the meridian the two may round to different sides
+        if (i != 12)
+            QVERIFY(setting == findSetting);
+    }
+}
+
 QTEST_GUILESS_MAIN(TestSchedulerUnit)
@@ -0,0 +1,87 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "testnameindex.h"
+
+#include "skycomponents/nameindex.h"
+#include "skyobjects/skyobject.h"
+
+#include <QTest>
+
+TestNameIndex::TestNameIndex() : QObject()
+{
+}
+
+void TestNameIndex::testNormalize_data()
+{
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<QString>("key");
+
+    QTest::newRow("messier") << "M 31" << "m31";
+    QTest::newRow("messier without space") << "M31" << "m31";
+    QTest::newRow("messier long") << "Messier 31" << "m31";
+    QTest::newRow("ngc") << "NGC 224" << "ngc224";
+    QTest::newRow("ngc lower case") << "ngc224" << "ngc224";
+    QTest::newRow("white space") << "  Alpha\tCentauri " << "alphacentauri";
+    QTest::newRow("messier word") << "Messier's Object" << "messier'sobject";
+    QTest::newRow("empty") << "" << "";
+}
+
+void TestNameIndex::testNormalize()
+{
+    QFETCH(QString, name);
+    QFETCH(QString, key);
+
+    QCOMPARE(NameIndex::normalize(name), key);
+}
+
+void TestNameIndex::testFind()
+{
+    SkyObject andromeda(SkyObject::GALAXY, 0.712, 41.27, 3.4, "M 31", "NGC 224", "Andromeda Galaxy");
+    SkyObject other(SkyObject::STAR, 0.0, 0.0, 5.0, "M31");
+
+    NameIndex index;
+    QVERIFY(!index.isValid());
+    QCOMPARE(index.find("M 31"), nullptr);
+
+    index.reset();
+    index.insert(andromeda.name(), &andromeda);
+    index.insert(andromeda.name2(), &andromeda);
+    index.insert(andromeda.longname(), &andromeda);
+    // The first object wins, as findByName() returns the first component's
+    index.insert(other.name(), &other);
+
+    QCOMPARE(index.size(), 3);
+    QCOMPARE(index.find("m31"), &andromeda);
+    QCOMPARE(index.find("Messier 31"), &andromeda);
+    QCOMPARE(index.find("NGC224"), &andromeda);
+    QCOMPARE(index.find("andromeda galaxy"), &andromeda);
+    QCOMPARE(index.find("M 32"), nullptr);
+}
+
+void TestNameIndex::testInvalidate()
+{
+    SkyObject vega(SkyObject::STAR, 18.6, 38.8, 0.0, "Vega");
+
+    NameIndex index;
+    index.reset();
+    index.insert(vega.name(), &vega);
+    QCOMPARE(index.find("vega"), &vega);
+
+    NameIndex::invalidate();
+    QVERIFY(!index.isValid());
+    QCOMPARE(index.size(), 0);
+    QCOMPARE(index.find("vega"), nullptr);
+
+    // Nothing is added until the index is filled again
+    index.insert(vega.name(), &vega);
+    QCOMPARE(index.find("vega"), nullptr);
+    index.reset();
+    QVERIFY(index.isValid());
+    QCOMPARE(index.size(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestNameIndex)
@@ -0,0 +1,28 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+
+/**
+ * @class TestNameIndex
+ * @short Tests of the name normalization and invalidation of NameIndex
+ */
+class TestNameIndex : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestNameIndex();
+    ~TestNameIndex() override = default;
+
+  private slots:
+    void testNormalize_data();
+    void testNormalize();
+    void testFind();
+    void testInvalidate();
+};
@@ -0,0 +1,163 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "benchskymapdraw.h"
+
+#include "kstarsdata.h"
+#include "Options.h"
+#include "skymap.h"
+#include "skyqpainter.h"
+#include "auxiliary/kspaths.h"
+#include "hips/hipsmanager.h"
+#include "projections/projector.h"
+#include "skycomponents/skymapcomposite.h"
+
+#include <QDir>
+#include <QPainterPath>
+#include <QTest>
+
+namespace
+{
+constexpr int WIDTH = 1280;
+constexpr int HEIGHT = 800;
+// Frames drawn before a view is timed
+constexpr int WARMUP_FRAMES = 3;
+}
+
+BenchSkyMapDraw::BenchSkyMapDraw() : QObject()
+{
+}
+
+void BenchSkyMapDraw::initTestCase()
+{
+    m_Data = KStarsData::Create();
+    QVERIFY(m_Data->initialize());
+
+    // Greenwich, at a fixed time with the clock stopped
+    m_Data->setLocation(GeoLocation(dms(0.0), dms(51.48), "Greenwich", "", "United Kingdom"));
+    m_Data->colorScheme()->loadFromConfig();
+    m_Data->clock()->stop();
+    m_Data->clock()->setUTC(KStarsDateTime(QDateTime(QDate(2026, 8, 15), QTime(22, 0, 0), Qt::UTC)));
+
+    Options::setStarDensity(5);
+    Options::setShowStars(true);
+    Options::setShowDeepSky(true);
+    Options::setShowSolarSystem(true);
+    Options::setShowCLines(true);
+    Options::setShowCNames(true);
+    Options::setShowEquatorialGrid(false);
+    Options::setShowHorizontalGrid(false);
+    Options::setUseAntialias(true);
+
+    if (KSPaths::locate(QStandardPaths::AppLocalDataLocation, "USNO-NOMAD-1e8.dat").isEmpty())
+        qInfo() << "USNO NOMAD is not installed, the dense field only has the default star catalogs";
+
+    m_Map = SkyMap::Create();
+    m_Map->resize(WIDTH, HEIGHT);
+    m_Image = QImage(WIDTH, HEIGHT, QImage::Format_ARGB32_Premultiplied);
+}
+
+void BenchSkyMapDraw::cleanupTestCase()
+{
+    delete m_Map;
+    m_Map = nullptr;
+}
+
+void BenchSkyMapDraw::benchDraw_data()
+{
+    QTest::addColumn<double>("ra");
+    QTest::addColumn<double>("dec");
+    QTest::addColumn<double>("fov");
+    QTest::addColumn<bool>("horizontal");
+    QTest::addColumn<bool>("milkyWay");
+    QTest::addColumn<bool>("terrainAndHiPS");
+
+    QTest::newRow("wide field") << 5.5 << 0.0 << 90.0 << false << true << false;
+    QTest::newRow("Milky Way at 5 degrees") << 17.76 << -29.0 << 5.0 << false << true << false;
+    QTest::newRow("dense field at 0.5 degrees") << 20.37 << 40.26 << 0.5 << false << true << false;
+    QTest::newRow("horizontal with terrain and HiPS") << 19.0 << 20.0 << 60.0 << true << true << true;
+}
+
+void BenchSkyMapDraw::benchDraw()
+{
+    QFETCH(double, ra);
+    QFETCH(double, dec);
+    QFETCH(double, fov);
+    QFETCH(bool, horizontal);
+    QFETCH(bool, milkyWay);
+    QFETCH(bool, terrainAndHiPS);
+
+    Options::setUseAltAz(horizontal);
+    Options::setShowGround(horizontal);
+    Options::setShowMilkyWay(milkyWay);
+    Options::setFillMilkyWay(milkyWay);
+
+    // The terrain renderer reports a missing image on the status bar, so it is only enabled with one
+    const QString terrain = qEnvironmentVariable("KSTARS_BENCHMARK_TERRAIN");
+    const bool withTerrain = terrainAndHiPS && !terrain.isEmpty() && QFile::exists(terrain);
+    Options::setTerrainSource(withTerrain ? terrain : QString());
+    Options::setShowTerrain(withTerrain);
+
+    const QString hips = qEnvironmentVariable("KSTARS_BENCHMARK_HIPS");
+    const bool withHiPS = terrainAndHiPS && !hips.isEmpty() && QDir(hips).exists();
+    if (withHiPS)
+    {
+        Options::setHIPSUseOfflineSource(true);
+        Options::setHIPSOfflinePath(hips);
+        HIPSManager::Instance()->setOfflineLevels(QDir(hips).entryList(QDir::AllDirs | QDir::NoDotAndDotDot));
+        HIPSManager::Instance()->setCurrentSource("DSS Colored");
+    }
+    else
+        Options::setShowHIPS(false);
+    if (terrainAndHiPS && !withTerrain)
+        qInfo() << "KSTARS_BENCHMARK_TERRAIN is not set to a terrain image, drawing without terrain";
+    if (terrainAndHiPS && !withHiPS)
+        qInfo() << "KSTARS_BENCHMARK_HIPS is not set to an offline HiPS directory, drawing without HiPS";
+
+    m_Data->setFullTimeUpdate();
+    m_Data->updateTime(m_Data->geo(), false);
+
+    SkyPoint destination(ra, dec);
+    m_Map->setDestination(destination);
+    m_Map->destination()->EquatorialToHorizontal(m_Data->lst(), m_Data->geo()->lat());
+    m_Map->setFocus(m_Map->destination());
+    m_Map->focus()->EquatorialToHorizontal(m_Data->lst(), m_Data->geo()->lat());
+    m_Map->setZoomFactor(WIDTH / (fov * dms::DegToRad));
+    m_Map->setupProjector();
+
+    for (int i = 0; i < WARMUP_FRAMES; i++)
+    {
+        drawFrame();
+        QCoreApplication::processEvents();
+    }
+
+    QBENCHMARK
+    {
+        drawFrame();
+    }
+
+    for (const auto &line : m_Data->skyComposite()->drawTimings().report())
+        qInfo().noquote() << line;
+}
+
+void BenchSkyMapDraw::drawFrame()
+{
+    // As SkyMapQDraw::paintEvent() draws the sky
+    m_Image.fill(Qt::black);
+    SkyQPainter painter(&m_Image, m_Image.size());
+    painter.begin();
+    painter.drawSkyBackground();
+
+    QPainterPath path;
+    path.addPolygon(m_Map->projector()->clipPoly());
+    painter.setClipPath(path);
+    painter.setClipping(true);
+
+    m_Data->skyComposite()->draw(&painter);
+    painter.end();
+}
+
+QTEST_MAIN(BenchSkyMapDraw)
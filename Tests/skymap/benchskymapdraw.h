@@ -0,0 +1,51 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QImage>
+#include <QObject>
+
+class KStarsData;
+class SkyMap;
+
+/**
+ * @class BenchSkyMapDraw
+ * @short Frame times of the sky map draw loop, for scripted views
+ *
+ * KStarsData is set up headless, as for --dump, at a fixed time and location. The sky map is
+ * then drawn with SkyQPainter into an offscreen image, the way SkyMapQDraw paints it, for each
+ * view in benchDraw_data(). Each view is drawn a few times first, so the star blocks and
+ * caches are loaded before it is timed.
+ *
+ * The star catalogs, terrain and HiPS tiles are whatever is installed, so frame times are
+ * only comparable between runs on the same machine. The terrain and HiPS view uses the images
+ * named by KSTARS_BENCHMARK_TERRAIN and KSTARS_BENCHMARK_HIPS, an offline DSS directory, and
+ * draws without them if they are not set. Run with "-o frames.xml,xml" or "-o frames.csv,csv"
+ * to keep the results for trend tracking.
+ */
+class BenchSkyMapDraw : public QObject
+{
+        Q_OBJECT
+
+    public:
+        BenchSkyMapDraw();
+        ~BenchSkyMapDraw() override = default;
+
+    private slots:
+        void initTestCase();
+        void cleanupTestCase();
+
+        void benchDraw_data();
+        void benchDraw();
+
+    private:
+        void drawFrame();
+
+        KStarsData *m_Data { nullptr };
+        SkyMap *m_Map { nullptr };
+        QImage m_Image;
+};
@@ -626,4 +626,45 @@ void TestSkyPoint::testDeltaAngle()
     QVERIFY(diffDE.Degrees() < 1);
 }
 
+void TestSkyPoint::testEquatorialToHorizontalBatch()
+{
+    const CachingDms lst(117.3), lat(52.1);
+
+    // Points all over the sky, including the pole and the meridian
+    QVector<SkyPoint> single, batch;
+    for (double ra = 0; ra < 360; ra += 23.7)
+        for (double dec = -90; dec <= 90; dec += 15)
+        {
+            single.append(SkyPoint(dms(ra), dms(dec)));
+            batch.append(SkyPoint(dms(ra), dms(dec)));
+        }
+    single.append(SkyPoint(lst, dms(30)));
+    batch.append(SkyPoint(lst, dms(30)));
+
+    QVector<SkyPoint *> points;
+    for (auto &p : batch)
+        points.append(&p);
+    SkyPoint::EquatorialToHorizontal(points.constData(), points.size(), &lst, &lat);
+
+    for (int i = 0; i < single.size(); i++)
+    {
+        single[i].EquatorialToHorizontal(&lst, &lat);
+        QVERIFY(fabs(single[i].alt().Degrees() - batch[i].alt().Degrees()) < 1e-9);
+        // The azimuth is undefined at the poles
+        if (fabs(single[i].dec().Degrees()) < 90)
+            QVERIFY(fabs(single[i].az().deltaAngle(batch[i].az()).Degrees()) < 1e-7);
+    }
+}
+
+void TestSkyPoint::testRefractionTable()
+{
+    for (double alt = SkyPoint::altCrit + 0.001; alt <= 90; alt += 0.0137)
+        QVERIFY(fabs(SkyPoint::refract(alt) - alt - SkyPoint::refractionCorr(alt)) < 0.1 / 3600);
+
+    // Below the critical altitude, and unrefracting what was refracted
+    QCOMPARE(SkyPoint::refract(-90.0), -90.0);
+    for (double alt = -10; alt <= 90; alt += 1.3)
+        QVERIFY(fabs(SkyPoint::unrefract(SkyPoint::refract(alt)) - alt) < 1e-3);
+}
+
 QTEST_GUILESS_MAIN(TestSkyPoint)
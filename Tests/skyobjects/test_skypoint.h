@@ -65,6 +65,9 @@ class TestSkyPoint : public QObject
 
         void testDeltaAngle();
 
+        void testEquatorialToHorizontalBatch();
+        void testRefractionTable();
+
     private:
         bool useRelativistic {false};
 };
@@ -292,6 +292,45 @@ void TestStarObject::testUpdateCoords()
 
 }
 
+void TestStarObject::testBatchedUpdateCoords()
+{
+    /*
+     * The batched StarObject::updateCoords() must agree with the one
+     * star version, including near the poles where nutation and
+     * aberration take other code paths, and across several chunks
+     */
+
+    const KSNumbers num(KStarsDateTime::fromString("2021-12-16T14:38").djd());
+
+    QVector<StarObject> stars, reference;
+    for (int i = 0; i < 150; i++)
+    {
+        const dms ra(i * 360.0 / 150.0);
+        const dms dec(-89.5 + i * 179.0 / 149.0);
+        // Every third star without proper motion, the others with up to a few arcseconds per year
+        const double pmRa = (i % 3 == 0) ? 0.0 : 25.0 * (i % 7) - 60.0;
+        const double pmDec = (i % 3 == 0) ? 0.0 : 1500.0 - 40.0 * (i % 11);
+        stars.append(StarObject(ra, dec, 0.0, "", "", "K0", pmRa, pmDec));
+        reference.append(stars.last());
+    }
+
+    QVector<StarObject *> pointers;
+    for (auto &star : stars)
+        pointers.append(&star);
+    // Null entries are skipped
+    pointers.insert(70, nullptr);
+
+    StarObject::updateCoords(pointers.constData(), pointers.size(), &num);
+
+    for (int i = 0; i < stars.size(); i++)
+    {
+        reference[i].updateCoords(&num);
+        compare(QString("Star %1").arg(i), stars[i].ra().Degrees(), stars[i].dec().Degrees(),
+                reference[i].ra().Degrees(), reference[i].dec().Degrees(), 1e-9);
+        QCOMPARE(stars[i].getLastPrecessJD(), reference[i].getLastPrecessJD());
+    }
+}
+
 #ifdef HAVE_LIBERFA
 void TestStarObject::compareProperMotionAgainstErfa_data()
 {
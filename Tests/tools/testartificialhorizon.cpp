@@ -30,6 +30,7 @@ class TestArtificialHorizon : public QObject
     private slots:
         void artificialHorizonTest();
         void artificialCeilingTest();
+        void precomputedVisibilityTest();
 
     private:
 };
@@ -251,4 +252,40 @@ void TestArtificialHorizon::artificialCeilingTest()
     QVERIFY(checkHorizon(horizon, 351, 3, false, polygons));
 }
 
+// isVisible() answers from a table of the lines crossing every .1 degrees of azimuth.
+// Away from the lines, it should agree with the closest constraints above and below.
+void TestArtificialHorizon::precomputedVisibilityTest()
+{
+    ArtificialHorizon horizon;
+    horizon.setTesting();
+
+    horizon.addRegion("horizon", true, setupHorizonEntities({200.0, 260.0, 300.0, 10.0, 60.0}, {10.0, 30.0, 20.0, 40.0, 15.0}),
+                      false);
+    horizon.addRegion("ceiling", true, setupHorizonEntities({250.0, 330.0, 40.0}, {60.0, 70.0, 55.0}), true);
+    horizon.addRegion("above", true, setupHorizonEntities({280.0, 320.0}, {75.0, 80.0}), false);
+
+    for (int enabled = 0; enabled < 2; ++enabled)
+    {
+        // Changing an entity directly must also be seen by the table.
+        horizon.findRegion("ceiling")->setEnabled(enabled == 0);
+        // Keeps clear of the ends of the lines, which the table rounds to .1 degrees.
+        for (double az = 0.7; az < 360.0; az += 1.3)
+        {
+            for (double alt = -89.5; alt < 90.0; alt += 1.0)
+            {
+                const ArtificialHorizonEntity *above = horizon.getConstraintAbove(az, alt);
+                const ArtificialHorizonEntity *below = horizon.getConstraintBelow(az, alt);
+                bool exists = false;
+                if ((above && fabs(above->altitudeConstraint(az, &exists) - alt) < 0.5) ||
+                        (below && fabs(below->altitudeConstraint(az, &exists) - alt) < 0.5))
+                    continue;
+                const bool visible = !(above && !above->ceiling()) && !(below && below->ceiling());
+                QVERIFY2(horizon.isVisible(az, alt) == visible,
+                         qPrintable(QString("az %1 alt %2").arg(az).arg(alt)));
+                QVERIFY(horizon.isVisible(az + 360.0, alt) == visible);
+            }
+        }
+    }
+}
+
 QTEST_GUILESS_MAIN(TestArtificialHorizon)
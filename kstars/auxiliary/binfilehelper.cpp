@@ -9,6 +9,7 @@
 #include "byteorder.h"
 #include "auxiliary/kspaths.h"
 
+#include <QFile>
 #include <QStandardPaths>
 
 class BinFileHelper;
@@ -28,6 +29,7 @@ BinFileHelper::~BinFileHelper()
 
 void BinFileHelper::init()
 {
+    unmapFile();
     if (fileHandle)
         fclose(fileHandle);
 
@@ -73,6 +75,7 @@ FILE *BinFileHelper::openFile(const QString &fileName)
 {
     QString FilePath = KSPaths::locate(QStandardPaths::AppLocalDataLocation, fileName);
     init();
+    filePath = FilePath;
     QByteArray b         = FilePath.toLatin1();
     const char *filepath = b.data();
 
@@ -275,10 +278,44 @@ bool BinFileHelper::readHeader()
 
 void BinFileHelper::closeFile()
 {
+    unmapFile();
     fclose(fileHandle);
     fileHandle = nullptr;
 }
 
+bool BinFileHelper::mapFile()
+{
+    if (mappedData)
+        return true;
+    if (!fileHandle)
+        return false;
+
+    std::unique_ptr<QFile> file(new QFile(filePath));
+    if (!file->open(QIODevice::ReadOnly))
+        return false;
+
+    // The mapping remains valid once the file is closed
+    const qint64 size = file->size();
+    const uchar *data = size > 0 ? file->map(0, size) : nullptr;
+    file->close();
+    if (!data)
+        return false;
+
+    mappedFile = std::move(file);
+    mappedData = data;
+    mappedSize = size;
+    return true;
+}
+
+void BinFileHelper::unmapFile()
+{
+    if (mappedFile && mappedData)
+        mappedFile->unmap(const_cast<uchar *>(mappedData));
+    mappedFile.reset();
+    mappedData = nullptr;
+    mappedSize = 0;
+}
+
 int BinFileHelper::getErrorNumber()
 {
     int err = errnum;
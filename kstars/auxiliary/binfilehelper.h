@@ -10,6 +10,9 @@
 #include <QVector>
 
 #include <cstdio>
+#include <memory>
+
+class QFile;
 
 class QString;
 
@@ -69,6 +72,26 @@ class BinFileHelper
      */
     void closeFile();
 
+    /**
+     * @short  Map the open file into memory, so that its records can be read in place with mappedRecord()
+     * instead of seeking and reading the file handle. The file handle stays usable either way.
+     * @return True if the file is mapped, false if mapping isn't possible, e.g. out of address space.
+     */
+    bool mapFile();
+
+    /** @return True if the file was mapped with mapFile() */
+    inline bool isMapped() const { return mappedData != nullptr; }
+
+    /**
+     * @short  Returns a pointer to size bytes at the given offset of the mapped file
+     * @return Pointer into the mapped file, nullptr if the file isn't mapped or the range is past its end.
+     * @note   Records are not aligned in the file, so they must be copied rather than cast in place.
+     */
+    inline const uchar *mappedRecord(quint64 offset, int size) const
+    {
+        return (mappedData && offset + size <= mappedSize) ? mappedData + offset : nullptr;
+    }
+
     /**
      * @short   Get error number
      * @return  A number corresponding to the error
@@ -227,8 +250,19 @@ class BinFileHelper
      */
     void init();
 
+    /**
+     * @short  Helper function that unmaps the file mapped by mapFile()
+     */
+    void unmapFile();
+
     /// Handle to the file.
     FILE *fileHandle { nullptr};
+    /// Path of the open file
+    QString filePath;
+    /// Mapping of the file by mapFile(), if any
+    std::unique_ptr<QFile> mappedFile;
+    const uchar *mappedData { nullptr };
+    quint64 mappedSize { 0 };
     /// Stores offsets corresponding to each index table entry
     QVector<unsigned long> indexOffset;
     /// Stores number of records under each index table entry
@@ -250,6 +250,26 @@ class dms
          */
     inline void SinCos(double &s, double &c) const;
 
+    /** @short Compute the Sine and Cosine of an angle in radians simultaneously.
+         * This uses the fused sincos() of the C library where there is one, and is what
+         * SinCos() and CachingDms are built on.
+         *
+         * @param rad the angle, in radians
+         * @param s Sine of the angle
+         * @param c Cosine of the angle
+         */
+    static inline void SinCos(const double rad, double &s, double &c)
+    {
+#if defined(HAVE_SINCOS)
+        ::sincos(rad, &s, &c);
+#elif defined(__APPLE__)
+        __sincos(rad, &s, &c);
+#else
+        s = ::sin(rad);
+        c = ::cos(rad);
+#endif
+    }
+
     /** @short Compute the Angle's Sine.
          *
          * @return the Sine of the angle.
@@ -448,12 +468,7 @@ inline void dms::SinCos(double &s, double &c) const
     start = std::clock();
 #endif
 
-#ifdef HAVE_SINCOS
-    sincos(radians(), &s, &c);
-#else
-    s = ::sin(radians());
-    c = ::cos(radians());
-#endif
+    SinCos(radians(), s, c);
 
 #ifdef PROFILE_SINCOS
     stop = std::clock();
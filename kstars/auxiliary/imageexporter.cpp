@@ -18,6 +18,40 @@
 #include <QStatusBar>
 #include <QSvgGenerator>
 #include <QApplication>
+#include <QTimer>
+
+namespace
+{
+const char *rasterFormat(const QString &fileName)
+{
+    //Determine desired image format from filename extension
+    QString ext = fileName.mid(fileName.lastIndexOf(".") + 1);
+
+    if (ext.toLower() == "png")
+    {
+        return "PNG";
+    }
+    else if (ext.toLower() == "jpg" || ext.toLower() == "jpeg")
+    {
+        return "JPG";
+    }
+    else if (ext.toLower() == "gif")
+    {
+        return "GIF";
+    }
+    else if (ext.toLower() == "pnm")
+    {
+        return "PNM";
+    }
+    else if (ext.toLower() == "bmp")
+    {
+        return "BMP";
+    }
+
+    qWarning() << "Could not parse image format of" << fileName << "assuming PNG";
+    return "PNG";
+}
+}
 
 ImageExporter::ImageExporter(QObject *parent) : QObject(parent), m_includeLegend(false), m_Size(nullptr)
 {
@@ -58,36 +92,8 @@ void ImageExporter::exportSvg(const QString &fileName)
 
 bool ImageExporter::exportRasterGraphics(const QString &fileName)
 {
-    //Determine desired image format from filename extension
-    QString ext = fileName.mid(fileName.lastIndexOf(".") + 1);
-
     // export as raster graphics
-    const char *format = "PNG";
-
-    if (ext.toLower() == "png")
-    {
-        format = "PNG";
-    }
-    else if (ext.toLower() == "jpg" || ext.toLower() == "jpeg")
-    {
-        format = "JPG";
-    }
-    else if (ext.toLower() == "gif")
-    {
-        format = "GIF";
-    }
-    else if (ext.toLower() == "pnm")
-    {
-        format = "PNM";
-    }
-    else if (ext.toLower() == "bmp")
-    {
-        format = "BMP";
-    }
-    else
-    {
-        qWarning() << "Could not parse image format of" << fileName << "assuming PNG";
-    }
+    const char *format = rasterFormat(fileName);
 
     SkyMap *map = SkyMap::Instance();
 
@@ -268,6 +274,48 @@ void ImageExporter::setRasterOutputSize(const QSize *size)
         m_Size = nullptr;
 }
 
+void ImageExporter::queueChart(const QString &fileName, const SkyPoint &center, double fov, const QSize &size)
+{
+    m_Charts.enqueue({fileName, center, fov, size});
+    if (m_Charts.size() == 1)
+        QTimer::singleShot(0, this, &ImageExporter::exportNextChart);
+}
+
+void ImageExporter::exportNextChart()
+{
+    if (m_Charts.isEmpty())
+        return;
+
+    const Chart chart = m_Charts.head();
+    bool success = false;
+    if (chart.size.isEmpty() || chart.fov <= 0)
+    {
+        qWarning() << "Invalid chart size" << chart.size << "or field of view" << chart.fov << "for" << chart.fileName;
+    }
+    else
+    {
+        QImage image(chart.size, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::white);
+        SkyMap::Instance()->renderChart(&image, chart.center, chart.fov, [this](SkyQPainter * painter)
+        {
+            if (m_includeLegend)
+                addLegend(painter);
+        });
+
+        success = image.save(chart.fileName, rasterFormat(chart.fileName));
+        if (!success)
+            qWarning() << "Unable to save chart" << chart.fileName;
+    }
+    emit chartExported(chart.fileName, success);
+
+    // One chart per event loop iteration keeps the map responsive during a long batch
+    m_Charts.dequeue();
+    if (m_Charts.isEmpty())
+        emit chartsExported();
+    else
+        QTimer::singleShot(0, this, &ImageExporter::exportNextChart);
+}
+
 void ImageExporter::setLegendAlpha(int alpha)
 {
     Q_ASSERT(alpha >= 0 && alpha <= 255);
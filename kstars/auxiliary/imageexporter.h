@@ -8,11 +8,13 @@
 #define IMAGEEXPORTER_H
 
 #include "../printing/legend.h"
+#include "skyobjects/skypoint.h"
 
 #include <QObject>
+#include <QQueue>
+#include <QSize>
 
 class KStars;
-class QSize;
 
 /**
  * @class ImageExporter
@@ -79,12 +81,49 @@ class ImageExporter : public QObject
          */
     void setRasterOutputSize(const QSize *size);
 
+    /**
+         * @short Queue a chart for export, charts are exported one per event loop iteration
+         * @param fileName local file of the exported raster image
+         * @param center center of the chart, in current equatorial coordinates
+         * @param fov width of the chart in degrees
+         * @param size size of the chart in pixels
+         * @note Unlike exportImage(), the chart is drawn at the requested size and the view of the sky map is not changed.
+         */
+    void queueChart(const QString &fileName, const SkyPoint &center, double fov, const QSize &size);
+
+    /**
+         * @return the number of charts waiting for export
+         */
+    inline int queuedCharts() const { return m_Charts.size(); }
+
     /**
          * @return a pointer to the legend used
          */
     inline Legend *getLegend() { return m_Legend; }
 
+  Q_SIGNALS:
+    /**
+         * @short Emitted once a queued chart was exported, or failed to be
+         */
+    void chartExported(const QString &fileName, bool success);
+
+    /**
+         * @short Emitted once all queued charts were exported
+         */
+    void chartsExported();
+
+  private Q_SLOTS:
+    void exportNextChart();
+
   private:
+    struct Chart
+    {
+        QString fileName;
+        SkyPoint center;
+        double fov;
+        QSize size;
+    };
+
     void exportSvg(const QString &fileName);
     bool exportRasterGraphics(const QString &fileName);
     void addLegend(SkyQPainter *painter);
@@ -94,6 +133,7 @@ class ImageExporter : public QObject
     Legend *m_Legend;
     QSize *m_Size;
     QString m_lastErrorMessage;
+    QQueue<Chart> m_Charts;
 };
 
 #endif
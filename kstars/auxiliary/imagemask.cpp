@@ -7,6 +7,22 @@
 #include "imagemask.h"
 #include "cmath"
 
+namespace
+{
+// smallest n >= 0 with n * n >= value
+int ceilSqrt(long value)
+{
+    if (value <= 0)
+        return 0;
+    long n = std::lround(std::ceil(std::sqrt(static_cast<double>(value))));
+    while (n > 0 && (n - 1) * (n - 1) >= value)
+        n--;
+    while (n * n < value)
+        n++;
+    return static_cast<int>(n);
+}
+}
+
 ImageMask::ImageMask(const uint16_t width, const uint16_t height)
 {
     m_width  = width;
@@ -15,6 +31,10 @@ ImageMask::ImageMask(const uint16_t width, const uint16_t height)
 
 void ImageMask::setImageGeometry(const uint16_t width, const uint16_t height)
 {
+    // the lookup tables only depend on the geometry, keep them for images of the same size
+    if (width == m_width && height == m_height)
+        return;
+
     m_width  = width;
     m_height = height;
     refresh();
@@ -40,6 +60,7 @@ ImageRingMask::ImageRingMask(const float innerRadius, const float outerRadius, c
 {
     m_innerRadius = innerRadius;
     m_outerRadius = outerRadius;
+    refresh();
 }
 
 void ImageRingMask::refresh()
@@ -47,6 +68,15 @@ void ImageRingMask::refresh()
     long const sqDiagonal = (long) (m_width * m_width / 4 + m_height * m_height / 4);
     m_InnerRadiusSquare = std::lround(sqDiagonal * innerRadius() * innerRadius());
     m_OuterRadiusSquare = std::lround(sqDiagonal * outerRadius() * outerRadius());
+
+    m_RowInner.resize(m_height);
+    m_RowOuter.resize(m_height);
+    for (int y = 0; y < m_height; y++)
+    {
+        const long dy = y - m_height / 2;
+        m_RowInner[y] = ceilSqrt(m_InnerRadiusSquare - dy * dy);
+        m_RowOuter[y] = ceilSqrt(m_OuterRadiusSquare - dy * dy);
+    }
 }
 
 bool ImageRingMask::isVisible(uint16_t posX, uint16_t posY)
@@ -56,12 +86,11 @@ bool ImageRingMask::isVisible(uint16_t posX, uint16_t posY)
     if (result == false)
         return false;
 
-    double const x = posX - m_width / 2;
-    double const y = posY - m_height / 2;
-
-    double const sqRadius = x * x + y * y;
+    if (posY >= m_RowInner.size())
+        return false;
 
-    return sqRadius >= m_InnerRadiusSquare && sqRadius < m_OuterRadiusSquare;
+    int const x = std::abs(posX - m_width / 2);
+    return x >= m_RowInner[posY] && x < m_RowOuter[posY];
 }
 
 float ImageRingMask::innerRadius() const
@@ -94,33 +123,39 @@ ImageMosaicMask::ImageMosaicMask(const uint16_t tileWidth, const uint16_t space,
     // initialize the tiles
     for (int i = 0; i < 9; i++)
         m_tiles.append(QRect());
+    if (m_width > 0 && m_height > 0)
+        refresh();
 }
 
 bool ImageMosaicMask::isVisible(uint16_t posX, uint16_t posY)
 {
-    for (auto it = m_tiles.begin(); it != m_tiles.end(); it++)
-        if (it->contains(posX, posY))
-            return true;
-    // no matching tile found
-    return false;
+    return tileIndex(posX, posY) >= 0;
+}
+
+int ImageMosaicMask::tileIndex(int posX, int posY) const
+{
+    if (posX < 0 || posX >= m_TileColumn.size() || posY < 0 || posY >= m_TileRow.size())
+        return -1;
+
+    const int column = m_TileColumn[posX];
+    const int row = m_TileRow[posY];
+    return (column < 0 || row < 0) ? -1 : row * 3 + column;
 }
 
 QPointF ImageMosaicMask::translate(QPointF original)
 {
-    int pos = 0;
     const auto tileWidth = std::lround(m_width * m_tileWidth / 100);
     const float spacex = (m_width - 3 * tileWidth - 2 * m_space) / 2;
     const float spacey = (m_height - 3 * tileWidth - 2 * m_space) / 2;
-    for (QRect tile : m_tiles)
-    {
-        // matrix tile position
-        int posx = pos % 3;
-        int posy = pos++ / 3;
-        if (tile.contains(original.x(), original.y()))
-            return QPointF(original.x() - posx * spacex, original.y() - posy * spacey);
-    }
+    const int pos = tileIndex(static_cast<int>(original.x()), static_cast<int>(original.y()));
     // this should not happen for filtered positions
-    return QPointF(-1, -1);
+    if (pos < 0)
+        return QPointF(-1, -1);
+
+    // matrix tile position
+    const int posx = pos % 3;
+    const int posy = pos / 3;
+    return QPointF(original.x() - posx * spacex, original.y() - posy * spacey);
 }
 
 const QVector<QRect> ImageMosaicMask::tiles()
@@ -171,4 +206,20 @@ void ImageMosaicMask::refresh()
         m_tiles.append(QRect(x1, y2, tileWidth, tileWidth));
         m_tiles.append(QRect(x2, y2, tileWidth, tileWidth));
     }
+
+    // where tiles overlap, the first one in the raster wins, as when searching the tiles in order
+    m_TileColumn.fill(-1, m_tiles.isEmpty() ? 0 : m_width);
+    m_TileRow.fill(-1, m_tiles.isEmpty() ? 0 : m_height);
+    for (int i = 0; i < m_tiles.size(); i++)
+    {
+        const QRect &tile = m_tiles[i];
+        if (i < 3)
+            for (int x = std::max(tile.left(), 0); x <= std::min(tile.right(), m_width - 1); x++)
+                if (m_TileColumn[x] < 0)
+                    m_TileColumn[x] = i;
+        if (i % 3 == 0)
+            for (int y = std::max(tile.top(), 0); y <= std::min(tile.bottom(), m_height - 1); y++)
+                if (m_TileRow[y] < 0)
+                    m_TileRow[y] = i / 3;
+    }
 }
@@ -94,8 +94,11 @@ protected:
     float m_innerRadius {0};
     float m_outerRadius {1.0};
     // cached values for fast visibility calculation
-    long m_InnerRadiusSquare, m_OuterRadiusSquare;
-    // re-calculate the cached squares
+    long m_InnerRadiusSquare {0}, m_OuterRadiusSquare {0};
+    // per image row, the visible pixels are those whose distance |x - width/2| from the
+    // central column lies in [m_RowInner[y], m_RowOuter[y])
+    QVector<int> m_RowInner, m_RowOuter;
+    // re-calculate the cached squares and row bounds
     virtual void refresh() override;
 };
 
@@ -117,6 +120,12 @@ public:
      */
     virtual bool isVisible(uint16_t posX, uint16_t posY) override;
 
+    /**
+     * @brief tileIndex find the tile containing the given position
+     * @return index of the tile in tiles(), -1 if the position is not inside of a tile
+     */
+    int tileIndex(int posX, int posY) const;
+
     /**
      * @brief translate Calculate the new position of a point inside of the mosaic
      * @param original original position
@@ -145,6 +154,9 @@ protected:
     uint16_t m_space;
     // 3x3 mosaic raster, sorted linewise top down
     QVector<QRect> m_tiles;
-    // re-calculate the tiles
+    // tile column of each image column and tile row of each image row, -1 between the tiles,
+    // so that finding the tile of a position takes two lookups
+    QVector<int8_t> m_TileColumn, m_TileRow;
+    // re-calculate the tiles and their lookup tables
     virtual void refresh() override;
 };
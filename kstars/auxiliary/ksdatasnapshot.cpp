@@ -0,0 +1,129 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ksdatasnapshot.h"
+
+#include "auxiliary/kspaths.h"
+#include "kstars_startup_debug.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+
+KSDataSnapshot::KSDataSnapshot(const QString &name, const QStringList &sources, quint32 version)
+    : m_Sources(sources), m_Version(version)
+{
+    m_File.setFileName(QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath(name + ".snap"));
+}
+
+KSDataSnapshot::~KSDataSnapshot()
+{
+    if (m_Data)
+        m_File.unmap(const_cast<uchar *>(m_Data));
+    m_File.close();
+}
+
+void KSDataSnapshot::setupStream(QDataStream &stream)
+{
+    stream.setVersion(STREAM_VERSION);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+}
+
+QByteArray KSDataSnapshot::sourceHash()
+{
+    if (!m_Hash.isEmpty())
+        return m_Hash;
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for (const auto &source : m_Sources)
+    {
+        QFile file(KSPaths::locate(QStandardPaths::AppLocalDataLocation, source));
+        if (file.fileName().isEmpty() || !file.open(QIODevice::ReadOnly) || !hash.addData(&file))
+            return QByteArray();
+    }
+    m_Hash = hash.result();
+    return m_Hash;
+}
+
+bool KSDataSnapshot::load()
+{
+    if (m_Data || !m_File.exists())
+        return m_Data != nullptr;
+
+    if (m_File.open(QIODevice::ReadOnly) && m_File.size() > 0)
+        m_Data = m_File.map(0, m_File.size());
+
+    if (m_Data == nullptr)
+    {
+        m_File.close();
+        return false;
+    }
+
+    bool valid = false;
+    {
+        const QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char *>(m_Data), int(m_File.size()));
+        QDataStream in(raw);
+        setupStream(in);
+
+        quint32 magic = 0, version = 0;
+        QByteArray hash;
+        quint16 checksum = 0;
+        in >> magic >> version >> hash >> checksum;
+
+        m_PayloadOffset = int(in.device()->pos());
+        valid = in.status() == QDataStream::Ok && magic == MAGIC && version == m_Version && !hash.isEmpty() &&
+                hash == sourceHash() &&
+                checksum == qChecksum(raw.constData() + m_PayloadOffset, uint(raw.size() - m_PayloadOffset));
+    }
+
+    if (!valid)
+    {
+        qCDebug(KSTARS_STARTUP) << "Snapshot" << m_File.fileName() << "is outdated, parsing" << m_Sources;
+        m_File.unmap(const_cast<uchar *>(m_Data));
+        m_File.close();
+        m_Data = nullptr;
+        return false;
+    }
+    return true;
+}
+
+QByteArray KSDataSnapshot::payload() const
+{
+    if (m_Data == nullptr)
+        return QByteArray();
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(m_Data) + m_PayloadOffset,
+                                   int(m_File.size()) - m_PayloadOffset);
+}
+
+bool KSDataSnapshot::save(const QByteArray &payload)
+{
+    const QByteArray hash = sourceHash();
+    if (hash.isEmpty())
+        return false;
+
+    if (m_Data)
+    {
+        m_File.unmap(const_cast<uchar *>(m_Data));
+        m_Data = nullptr;
+    }
+    m_File.close();
+
+    if (!m_File.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qCWarning(KSTARS_STARTUP) << "Failed writing snapshot" << m_File.fileName();
+        return false;
+    }
+
+    QDataStream out(&m_File);
+    setupStream(out);
+    out << MAGIC << m_Version << hash << qChecksum(payload.constData(), uint(payload.size()));
+    out.writeRawData(payload.constData(), payload.size());
+    const bool ok = out.status() == QDataStream::Ok;
+    m_File.close();
+
+    if (!ok)
+        m_File.remove();
+    return ok;
+}
@@ -0,0 +1,66 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QStringList>
+
+/**
+ * @class KSDataSnapshot
+ * @short Binary snapshot of what was parsed from some text data files.
+ *
+ * The snapshot is kept in the writable data location. Its header holds a magic number, the
+ * version of the payload, the MD5 hash of the contents of the data files it was made from and
+ * a checksum of the payload. A snapshot is only used if all of these match, so an updated or
+ * edited data file is parsed again. A matching snapshot is memory mapped and its payload read
+ * in place.
+ */
+class KSDataSnapshot
+{
+    public:
+        /**
+         * @param name name of the snapshot file, without extension
+         * @param sources data files the payload is parsed from, located as KSUtils::openDataFile() does
+         * @param version version of the payload, to be raised whenever its layout changes
+         */
+        KSDataSnapshot(const QString &name, const QStringList &sources, quint32 version);
+        ~KSDataSnapshot();
+
+        /**
+         * @brief load Map the snapshot if it was made by this version from the present data files
+         * @return false if there is no such snapshot and the data files have to be parsed
+         */
+        bool load();
+
+        /** @return the payload of the loaded snapshot, valid for as long as the snapshot lives */
+        QByteArray payload() const;
+
+        /**
+         * @brief save Replace the snapshot with @p payload
+         * @return false if a data file is missing or the snapshot could not be written
+         */
+        bool save(const QByteArray &payload);
+
+        /** @brief setupStream Set up @p stream the way payloads are written and read */
+        static void setupStream(QDataStream &stream);
+
+    private:
+        // MD5 of the contents of all data files, empty if one of them is missing
+        QByteArray sourceHash();
+
+        QStringList m_Sources;
+        quint32 m_Version { 0 };
+        QFile m_File;
+        const uchar *m_Data { nullptr };
+        int m_PayloadOffset { 0 };
+        QByteArray m_Hash;
+
+        static constexpr quint32 MAGIC = 0x4B534453; // "KSDS"
+        static constexpr QDataStream::Version STREAM_VERSION = QDataStream::Qt_5_5;
+};
@@ -8,11 +8,18 @@
 
 #include "Options.h"
 #include "auxiliary/filedownloader.h"
+#include "auxiliary/ksnetworkcache.h"
 #include "catalogobject.h"
 
 #include <QImageWriter>
 #include <QMimeDatabase>
+#include <QTimer>
 
+namespace
+{
+// The plates do not change, so the images are kept for long
+constexpr int DSS_CACHE_DAYS = 365;
+}
 
 KSDssDownloader::KSDssDownloader(QObject *parent) : QObject(parent)
 {
@@ -195,6 +202,19 @@ void KSDssDownloader::initiateSingleDownloadAttempt(QUrl srcUrl)
     //m_DownloadJob = KIO::copy( srcUrl, fileUrl, KIO::Overwrite ) ; // FIXME: Can be done with pure Qt
     //connect ( m_DownloadJob, SIGNAL (result(KJob*)), SLOT (downloadAttemptFinished()) );
 
+    m_Url = srcUrl;
+    const QByteArray cached = KSNetworkCache::find(srcUrl.toString(), DSS_CACHE_DAYS);
+    if (!cached.isEmpty())
+    {
+        qDebug() << Q_FUNC_INFO << "Using the cached DSS Image of " << srcUrl;
+        // Still answer from the event loop, as a download would
+        QTimer::singleShot(0, this, [this, cached]()
+        {
+            attemptDataReceived(cached);
+        });
+        return;
+    }
+
     downloadJob = new FileDownloader();
 
     downloadJob->setProgressDialogEnabled(true, i18n("DSS Download"),
@@ -223,6 +243,20 @@ void KSDssDownloader::startSingleDownload(const QUrl srcUrl, const QString &dest
     //m_DownloadJob = KIO::copy( srcUrl, fileUrl, KIO::Overwrite ) ; // FIXME: Can be done with pure Qt
     //connect ( m_DownloadJob, SIGNAL (result(KJob*)), SLOT (singleDownloadFinished()) );
 
+    m_AttemptData = md;
+    m_Url         = srcUrl;
+
+    const QByteArray cached = KSNetworkCache::find(srcUrl.toString(), DSS_CACHE_DAYS);
+    if (!cached.isEmpty())
+    {
+        qDebug() << Q_FUNC_INFO << "Using the cached DSS Image of " << srcUrl;
+        QTimer::singleShot(0, this, [this, cached]()
+        {
+            singleDataReceived(cached);
+        });
+        return;
+    }
+
     downloadJob = new FileDownloader();
 
     downloadJob->setProgressDialogEnabled(true, i18n("DSS Download"),
@@ -231,8 +265,6 @@ void KSDssDownloader::startSingleDownload(const QUrl srcUrl, const QString &dest
     connect(downloadJob, SIGNAL(downloaded()), this, SLOT(singleDownloadFinished()));
     connect(downloadJob, SIGNAL(error(QString)), this, SLOT(downloadError(QString)));
 
-    m_AttemptData = md;
-
     downloadJob->get(srcUrl);
 }
 
@@ -244,16 +276,32 @@ void KSDssDownloader::downloadError(const QString &errorString)
 }
 
 void KSDssDownloader::singleDownloadFinished()
+{
+    const QByteArray data = downloadJob->downloadedData();
+    downloadJob->deleteLater();
+    singleDataReceived(data);
+}
+
+bool KSDssDownloader::writeTempFile(const QByteArray &data)
 {
     m_TempFile.open();
-    m_TempFile.write(downloadJob->downloadedData());
+    m_TempFile.resize(0);
+    m_TempFile.write(data);
     m_TempFile.close();
-    downloadJob->deleteLater();
 
     // Check if we have a proper DSS image or the DSS server failed
     QMimeDatabase mdb;
     QMimeType mt = mdb.mimeTypeForFile(m_TempFile.fileName(), QMimeDatabase::MatchContent);
-    if (mt.name().contains("image", Qt::CaseInsensitive))
+    if (!mt.name().contains("image", Qt::CaseInsensitive))
+        return false;
+
+    KSNetworkCache::insert(m_Url.toString(), data);
+    return true;
+}
+
+void KSDssDownloader::singleDataReceived(const QByteArray &data)
+{
+    if (writeTempFile(data))
     {
         qDebug() << Q_FUNC_INFO << "DSS download was successful";
         emit downloadComplete(writeImageWithMetadata(m_TempFile.fileName(), m_FileName, m_AttemptData));
@@ -275,38 +323,37 @@ void KSDssDownloader::downloadAttemptFinished()
     }
     else
     {
-        m_TempFile.open();
-        m_TempFile.write(downloadJob->downloadedData());
-        m_TempFile.close();
+        const QByteArray data = downloadJob->downloadedData();
         downloadJob->deleteLater();
+        attemptDataReceived(data);
+    }
+}
 
-        // Check if we have a proper DSS image or the DSS server failed
-        QMimeDatabase mdb;
-        QMimeType mt = mdb.mimeTypeForFile(m_TempFile.fileName(), QMimeDatabase::MatchContent);
-        if (mt.name().contains("image", Qt::CaseInsensitive))
-        {
-            qDebug() << Q_FUNC_INFO << "DSS download was successful";
-            emit downloadComplete(writeImageFile());
-            deleteLater();
-            return;
-        }
-
-        // We must have failed, try the next attempt
-        QUrl srcUrl;
-        m_attempt++;
-        if (m_attempt == m_VersionPreference.count())
-        {
-            // Nothing downloaded... very strange. Fail.
-            qDebug() << Q_FUNC_INFO << "Error downloading DSS images: All alternatives failed!";
-            emit downloadComplete(false);
-            deleteLater();
-            return;
-        }
-        srcUrl.setUrl(getDSSURL(m_AttemptData.ra0, m_AttemptData.dec0, m_AttemptData.width, m_AttemptData.height,
-                                ((m_AttemptData.format == KSDssImage::Metadata::FITS) ? "fits" : "gif"),
-                                m_VersionPreference[m_attempt], &m_AttemptData));
-        initiateSingleDownloadAttempt(srcUrl);
+void KSDssDownloader::attemptDataReceived(const QByteArray &data)
+{
+    if (writeTempFile(data))
+    {
+        qDebug() << Q_FUNC_INFO << "DSS download was successful";
+        emit downloadComplete(writeImageFile());
+        deleteLater();
+        return;
+    }
+
+    // We must have failed, try the next attempt
+    QUrl srcUrl;
+    m_attempt++;
+    if (m_attempt == m_VersionPreference.count())
+    {
+        // Nothing downloaded... very strange. Fail.
+        qDebug() << Q_FUNC_INFO << "Error downloading DSS images: All alternatives failed!";
+        emit downloadComplete(false);
+        deleteLater();
+        return;
     }
+    srcUrl.setUrl(getDSSURL(m_AttemptData.ra0, m_AttemptData.dec0, m_AttemptData.width, m_AttemptData.height,
+                            ((m_AttemptData.format == KSDssImage::Metadata::FITS) ? "fits" : "gif"),
+                            m_VersionPreference[m_attempt], &m_AttemptData));
+    initiateSingleDownloadAttempt(srcUrl);
 }
 
 bool KSDssDownloader::writeImageFile()
@@ -25,6 +25,9 @@ class dms;
  * @short Helps download a DSS image
  * @author Akarsh Simha <akarsh.simha@kdemail.net>
  *
+ * Downloaded images are kept in the network cache, so the same DSS
+ * URL is only fetched once.
+ *
  * @note This object is designed to commit suicide (calls
  * QObject::deleteLater() )! Never allocate this using anything but
  * new -- do not allocate it on the stack! This is ideal for its
@@ -112,12 +115,17 @@ class KSDssDownloader : public QObject
   private:
     void startDownload(const SkyPoint *const p, const QString &destFileName);
     void initiateSingleDownloadAttempt(QUrl srcUrl);
+    void attemptDataReceived(const QByteArray &data);
+    void singleDataReceived(const QByteArray &data);
+    /** Write the data into the temporary file, and cache it, if it is an image */
+    bool writeTempFile(const QByteArray &data);
     bool writeImageFile();
 
     QStringList m_VersionPreference;
     int m_attempt { 0 };
     struct KSDssImage::Metadata m_AttemptData;
     QString m_FileName;
+    QUrl m_Url;
     QTemporaryFile m_TempFile;
     FileDownloader *downloadJob { nullptr };
 };
@@ -0,0 +1,54 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ksnetworkcache.h"
+
+#include "auxiliary/kspaths.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+
+QString KSNetworkCache::path(const QString &key)
+{
+    const QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Md5).toHex();
+    return QDir(KSPaths::writableLocation(QStandardPaths::CacheLocation))
+           .filePath(QString("network/%1").arg(QString(hash)));
+}
+
+QByteArray KSNetworkCache::find(const QString &key, int ttlDays)
+{
+    const QString filename = path(key);
+    const QFileInfo info(filename);
+    if (!info.exists() || info.lastModified().addDays(ttlDays) < QDateTime::currentDateTime())
+        return QByteArray();
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+bool KSNetworkCache::insert(const QString &key, const QByteArray &data)
+{
+    const QString filename = path(key);
+    if (!QDir().mkpath(QFileInfo(filename).path()))
+        return false;
+
+    // Written aside and renamed, so a reader never sees half an answer
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(data);
+    return file.commit();
+}
+
+void KSNetworkCache::remove(const QString &key)
+{
+    QFile::remove(path(key));
+}
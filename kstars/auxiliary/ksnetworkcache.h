@@ -0,0 +1,37 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+/**
+ * @namespace KSNetworkCache
+ * @short Answers of online services, kept on disk so they are not fetched again.
+ *
+ * Each answer is a file in the cache location, named after the MD5 hash of its key, which is
+ * usually the URL it was downloaded from. An answer older than the time to live its reader
+ * asks for is treated as missing, and replaced the next time it is fetched.
+ */
+namespace KSNetworkCache
+{
+/**
+ * @brief find Look up the answer stored for @p key
+ * @param ttlDays age in days beyond which the answer is outdated
+ * @return the answer, or a null byte array if there is none or it is outdated
+ */
+QByteArray find(const QString &key, int ttlDays);
+
+/** @brief insert Store @p data as the answer for @p key, replacing the one there was */
+bool insert(const QString &key, const QByteArray &data);
+
+/** @brief remove Forget the answer for @p key */
+void remove(const QString &key);
+
+/** @return the file the answer for @p key is stored in */
+QString path(const QString &key);
+}
@@ -0,0 +1,161 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "kstrace.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+
+#include <kstars_debug.h>
+
+namespace
+{
+
+// Small thread numbers read better in the trace viewers than thread handles
+std::atomic<int> s_ThreadCount { 0 };
+
+int currentThreadNumber()
+{
+    thread_local const int number = ++s_ThreadCount;
+    return number;
+}
+
+}
+
+std::atomic<bool> KSTrace::s_Enabled { false };
+
+KSTrace *KSTrace::Instance()
+{
+    static KSTrace trace;
+    return &trace;
+}
+
+KSTrace::KSTrace() : m_Events(new Event[CAPACITY])
+{
+    m_Clock.start();
+}
+
+void KSTrace::setEnabled(bool enabled)
+{
+    if (enabled == s_Enabled.load())
+        return;
+
+    s_Enabled.store(enabled);
+    qCInfo(KSTARS) << "Performance trace" << (enabled ? "enabled" : "disabled");
+}
+
+void KSTrace::complete(const char *category, const char *name, qint64 start, qint64 duration)
+{
+    if (enabled())
+        record('X', category, name, start, duration);
+}
+
+void KSTrace::asyncBegin(const char *category, const char *name)
+{
+    if (enabled())
+        record('b', category, name, now(), 0);
+}
+
+void KSTrace::asyncEnd(const char *category, const char *name)
+{
+    if (enabled())
+        record('e', category, name, now(), 0);
+}
+
+void KSTrace::instant(const char *category, const char *name)
+{
+    if (enabled())
+        record('i', category, name, now(), 0);
+}
+
+void KSTrace::record(char phase, const char *category, const char *name, qint64 timestamp, qint64 duration)
+{
+    const quint64 index = m_Next.fetch_add(1, std::memory_order_relaxed);
+    Event &event = m_Events[index % CAPACITY];
+
+    // Readers skip the event while it is written
+    event.sequence.store(0, std::memory_order_release);
+    event.phase = phase;
+    event.category = category;
+    event.name = name;
+    event.timestamp = timestamp;
+    event.duration = duration;
+    event.thread = currentThreadNumber();
+    event.sequence.store(index + 1, std::memory_order_release);
+}
+
+QByteArray KSTrace::toJson() const
+{
+    const quint64 next = m_Next.load(std::memory_order_acquire);
+    const quint64 first = std::max(m_First.load(), next > CAPACITY ? next - CAPACITY : 0);
+
+    QJsonArray events;
+    for (quint64 index = first; index < next; index++)
+    {
+        const Event &event = m_Events[index % CAPACITY];
+        if (event.sequence.load(std::memory_order_acquire) != index + 1)
+            continue;
+
+        QJsonObject object
+        {
+            {"ph", QString(QChar(event.phase))},
+            {"cat", QString::fromLatin1(event.category)},
+            {"name", QString::fromLatin1(event.name)},
+            {"ts", static_cast<double>(event.timestamp)},
+            {"pid", static_cast<double>(QCoreApplication::applicationPid())},
+            {"tid", event.thread}
+        };
+        if (event.phase == 'X')
+            object["dur"] = static_cast<double>(event.duration);
+        else if (event.phase == 'b' || event.phase == 'e')
+            object["id"] = QString::fromLatin1(event.name);
+        else if (event.phase == 'i')
+            object["s"] = "t";
+
+        // The event was overwritten while it was read
+        if (event.sequence.load(std::memory_order_acquire) != index + 1)
+            continue;
+        events.append(object);
+    }
+
+    const QDateTime start = QDateTime::currentDateTimeUtc().addMSecs(-now() / 1000);
+    QJsonObject trace
+    {
+        {"traceEvents", events},
+        {"displayTimeUnit", "ms"},
+        {"otherData", QJsonObject{{"application", QCoreApplication::applicationName()}, {"start", start.toString(Qt::ISODate)}}}
+    };
+    return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+}
+
+bool KSTrace::save(const QString &filename) const
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qCWarning(KSTARS) << "Cannot write performance trace to" << filename << file.errorString();
+        return false;
+    }
+
+    const QByteArray json = toJson();
+    if (file.write(json) != json.size())
+    {
+        qCWarning(KSTARS) << "Cannot write performance trace to" << filename << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+void KSTrace::clear()
+{
+    m_First.store(m_Next.load());
+}
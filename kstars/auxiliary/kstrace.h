@@ -0,0 +1,130 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+
+/**
+ * @class KSTrace
+ * @short Performance trace of Ekos and of image processing, saved as Chrome trace events.
+ *
+ * Probes record the steps of the modules into a ring buffer of CAPACITY events, the oldest being
+ * overwritten. Recording takes no lock and allocates nothing, and a probe only reads the clock
+ * when tracing is enabled, so probes can stay in the code for good. The EkosTracing option, set
+ * from the Ekos log options, enables it.
+ *
+ * save() writes the buffer in the Chrome trace event format, which Perfetto and chrome://tracing
+ * open. Steps running within one function are recorded with KSTRACE_SCOPE, steps that span the
+ * event loop, such as an exposure or a plate solve, with asyncBegin() and asyncEnd().
+ *
+ * Category and name of an event must be string literals, the buffer only keeps their pointers.
+ */
+class KSTrace
+{
+    public:
+        static KSTrace *Instance();
+
+        /** Events kept, the oldest are overwritten */
+        static constexpr int CAPACITY = 1 << 16;
+
+        /** @return true if probes record events, cheap enough to call anywhere */
+        static bool enabled()
+        {
+            return s_Enabled.load(std::memory_order_relaxed);
+        }
+        void setEnabled(bool enabled);
+
+        /** @return microseconds since the trace clock started */
+        qint64 now() const
+        {
+            return m_Clock.nsecsElapsed() / 1000;
+        }
+
+        /** @brief complete Record a step that started at @p start and took @p duration microseconds */
+        void complete(const char *category, const char *name, qint64 start, qint64 duration);
+
+        /** @brief asyncBegin Record the start of a step that spans the event loop, matched by name */
+        void asyncBegin(const char *category, const char *name);
+        void asyncEnd(const char *category, const char *name);
+
+        /** @brief instant Record a single point in time, such as a failure or an abort */
+        void instant(const char *category, const char *name);
+
+        /** @return the events recorded so far, in the Chrome trace event format */
+        QByteArray toJson() const;
+
+        /** @brief save Write the events recorded so far to @p filename, @return false on error */
+        bool save(const QString &filename) const;
+
+        /** @brief clear Drop all events recorded so far */
+        void clear();
+
+    private:
+        KSTrace();
+
+        struct Event
+        {
+            // index of the event plus one once it is written, 0 while it is written
+            std::atomic<quint64> sequence { 0 };
+            char phase { 0 };
+            const char *category { nullptr };
+            const char *name { nullptr };
+            qint64 timestamp { 0 };
+            qint64 duration { 0 };
+            int thread { 0 };
+        };
+
+        void record(char phase, const char *category, const char *name, qint64 timestamp, qint64 duration);
+
+        std::unique_ptr<Event[]> m_Events;
+        std::atomic<quint64> m_Next { 0 };
+        // events before this index were cleared
+        std::atomic<quint64> m_First { 0 };
+        QElapsedTimer m_Clock;
+
+        static std::atomic<bool> s_Enabled;
+};
+
+/**
+ * @class KSTraceScope
+ * @short Records the time from its construction to its destruction as a step of the trace.
+ */
+class KSTraceScope
+{
+    public:
+        KSTraceScope(const char *category, const char *name) : m_Category(category), m_Name(name)
+        {
+            if (KSTrace::enabled())
+                m_Start = KSTrace::Instance()->now();
+        }
+        ~KSTraceScope()
+        {
+            if (m_Start >= 0 && KSTrace::enabled())
+            {
+                KSTrace *trace = KSTrace::Instance();
+                trace->complete(m_Category, m_Name, m_Start, trace->now() - m_Start);
+            }
+        }
+
+        KSTraceScope(const KSTraceScope &) = delete;
+        KSTraceScope &operator=(const KSTraceScope &) = delete;
+
+    private:
+        const char *m_Category;
+        const char *m_Name;
+        qint64 m_Start { -1 };
+};
+
+#define KSTRACE_CONCAT_(a, b) a##b
+#define KSTRACE_CONCAT(a, b) KSTRACE_CONCAT_(a, b)
+/** Record the rest of the enclosing scope as a step named @p name of @p category */
+#define KSTRACE_SCOPE(category, name) KSTraceScope KSTRACE_CONCAT(ksTraceScope, __LINE__)(category, name)
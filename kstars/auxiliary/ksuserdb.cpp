@@ -17,6 +17,7 @@
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QSqlTableModel>
+#include <QtConcurrent>
 
 #include <QJsonDocument>
 
@@ -32,6 +33,31 @@
 
 KSUserDB::~KSUserDB()
 {
+    // Complete the queued writes, then close the connection of the database thread from that thread.
+    if (!m_WriterConnectionName.isEmpty())
+    {
+        QtConcurrent::run(&m_WriterPool, [this]()
+        {
+            m_WriterCache = ConnectionCache();
+            QSqlDatabase::database(m_WriterConnectionName, false).close();
+            QSqlDatabase::removeDatabase(m_WriterConnectionName);
+        }).waitForFinished();
+    }
+    m_WriterPool.waitForDone();
+
+    m_MainCache = ConnectionCache();
+
+    // Fold the write-ahead log back into the database file, so the backup has all the data.
+    {
+        auto db = QSqlDatabase::database(m_ConnectionName, false);
+        if (db.isOpen())
+        {
+            QSqlQuery checkpoint(db);
+            if (!checkpoint.exec("PRAGMA wal_checkpoint(TRUNCATE)"))
+                qCWarning(KSTARS) << "Failed to checkpoint user database:" << checkpoint.lastError().text();
+        }
+    }
+
     // Backup
     QString current_dbfile = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("userdb.sqlite");
     QString backup_dbfile = QDir(KSPaths::writableLocation(
@@ -57,6 +83,9 @@ bool KSUserDB::Initialize()
     bool const first_run = !dbfile.exists() && !backup_file.exists();
     m_ConnectionName = dbfile.filePath();
 
+    // Queries belong to the connection about to be replaced.
+    m_MainCache = ConnectionCache();
+
     // Every logged in user has their own db.
     auto db = QSqlDatabase::addDatabase("QSQLITE", m_ConnectionName);
     // This would load the SQLITE file
@@ -94,6 +123,9 @@ bool KSUserDB::Initialize()
 
             qCWarning(KSTARS) << "Detected corrupted database. Attempting to recover from backup...";
             QFile::remove(dbfile.filePath());
+            // A write-ahead log left over by the corrupted database must not be applied to the backup.
+            QFile::remove(dbfile.filePath() + "-wal");
+            QFile::remove(dbfile.filePath() + "-shm");
             QFile::copy(backup_file.filePath(), dbfile.filePath());
             QFile::remove(backup_file.filePath());
             return Initialize();
@@ -107,6 +139,15 @@ bool KSUserDB::Initialize()
 
     qCDebug(KSTARS) << "Opened the User DB. Ready.";
 
+    // With a write-ahead log, commits append to the log instead of rewriting the database and readers do not
+    // block the writer. NORMAL synchronous mode then only syncs at checkpoints, which keeps the database
+    // consistent if power is lost, at worst losing the last commits.
+    {
+        QSqlQuery pragma(db);
+        if (!pragma.exec("PRAGMA journal_mode=WAL") || !pragma.exec("PRAGMA synchronous=NORMAL"))
+            qCWarning(KSTARS) << "Failed to enable write-ahead logging on the user database:" << pragma.lastError().text();
+    }
+
     // Update table if previous version exists
     QSqlTableModel version(nullptr, db);
     version.setTable("Version");
@@ -347,6 +388,213 @@ bool KSUserDB::Initialize()
                         "Thickness INTEGER DEFAULT 1)"))
             qCWarning(KSTARS) << query.lastError();
     }
+
+    // Add focushistory table
+    if (currentDBVersion < 315)
+    {
+        QSqlQuery query(db);
+
+        if (!query.exec("CREATE TABLE focushistory ( "
+                        "id INTEGER DEFAULT NULL PRIMARY KEY AUTOINCREMENT, "
+                        "Train INTEGER NOT NULL, "
+                        "Filter TEXT DEFAULT NULL, "
+                        "Position INTEGER NOT NULL, "
+                        "Temperature REAL DEFAULT NULL, "
+                        "Altitude REAL DEFAULT NULL, "
+                        "Value REAL DEFAULT NULL, "
+                        "Timestamp TEXT DEFAULT NULL)"))
+            qCWarning(KSTARS) << query.lastError();
+    }
+
+    // Open the connection of the database thread, which is then kept until destruction.
+    if (m_WriterConnectionName.isEmpty())
+    {
+        m_WriterConnectionName = m_ConnectionName + "#writer";
+        m_WriterPool.setMaxThreadCount(1);
+        m_WriterPool.setExpiryTimeout(-1);
+        post([this](KSUserDB &)
+        {
+            auto writer = QSqlDatabase::addDatabase("QSQLITE", m_WriterConnectionName);
+            writer.setDatabaseName(m_ConnectionName);
+            if (!writer.open())
+            {
+                qCCritical(KSTARS) << "Failed opening user database writer connection:" << writer.lastError().text();
+                return false;
+            }
+
+            // The journal mode is persistent, but the synchronous mode is per connection.
+            QSqlQuery pragma(writer);
+            if (!pragma.exec("PRAGMA synchronous=NORMAL"))
+                qCWarning(KSTARS) << "Failed to set synchronous mode of the user database writer:" << pragma.lastError().text();
+            return true;
+        });
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+QFuture<bool> KSUserDB::post(const std::function<bool(KSUserDB &)> &write)
+{
+    QMutexLocker locker(&m_WriterMutex);
+    // The pool runs one task at a time in order, so the last write completes after all the others.
+    m_LastWrite = QtConcurrent::run(&m_WriterPool, [this, write]()
+    {
+        m_WriterThread = QThread::currentThread();
+        return write(*this);
+    });
+    return m_LastWrite;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+void KSUserDB::flush()
+{
+    // A write waiting for itself would never complete.
+    if (onWriterThread())
+        return;
+
+    QFuture<bool> lastWrite;
+    {
+        QMutexLocker locker(&m_WriterMutex);
+        lastWrite = m_LastWrite;
+    }
+    lastWrite.waitForFinished();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+QSqlDatabase KSUserDB::database()
+{
+    if (onWriterThread())
+        return QSqlDatabase::database(m_WriterConnectionName);
+
+    flush();
+    return QSqlDatabase::database(m_ConnectionName);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+QSqlQuery &KSUserDB::preparedQuery(const QString &statement)
+{
+    auto &preparedQueries = connectionCache().preparedQueries;
+    auto query = preparedQueries.find(statement);
+    if (query == preparedQueries.end())
+    {
+        query = preparedQueries.insert(statement, QSqlQuery(database()));
+        if (!query->prepare(statement))
+            qCWarning(KSTARS) << "Failed to prepare" << statement << query->lastError().text();
+    }
+    else
+        query->finish();
+
+    return *query;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+QSqlRecord KSUserDB::tableColumns(const QString &table)
+{
+    auto &tableColumns = connectionCache().tableColumns;
+    auto columns = tableColumns.find(table);
+    if (columns == tableColumns.end())
+        columns = tableColumns.insert(table, database().record(table));
+    return *columns;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool KSUserDB::insertRecord(const QString &table, const QVariantMap &values)
+{
+    const QSqlRecord columns = tableColumns(table);
+    QStringList names, placeholders;
+    QVariantList bound;
+    for (auto iter = values.cbegin(); iter != values.cend(); ++iter)
+    {
+        if (!columns.contains(iter.key()))
+            continue;
+        names << iter.key();
+        placeholders << "?";
+        bound << iter.value();
+    }
+
+    // Records of the same shape share the same statement.
+    QSqlQuery &query = preparedQuery(QString("INSERT INTO %1 (%2) VALUES (%3)").arg(table, names.join(','),
+                                     placeholders.join(',')));
+    for (const auto &value : qAsConst(bound))
+        query.addBindValue(value);
+
+    if (!query.exec())
+    {
+        qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool KSUserDB::updateRecords(const QString &table, const QVariantMap &values, const QString &keyColumn,
+                             const QVariant &keyValue)
+{
+    const QSqlRecord columns = tableColumns(table);
+    QStringList assignments;
+    QVariantList bound;
+    for (auto iter = values.cbegin(); iter != values.cend(); ++iter)
+    {
+        if (!columns.contains(iter.key()) || iter.key() == keyColumn)
+            continue;
+        assignments << iter.key() + "=?";
+        bound << iter.value();
+    }
+
+    if (assignments.isEmpty())
+        return true;
+
+    QSqlQuery &query = preparedQuery(QString("UPDATE %1 SET %2 WHERE %3=?").arg(table, assignments.join(','), keyColumn));
+    for (const auto &value : qAsConst(bound))
+        query.addBindValue(value);
+    query.addBindValue(keyValue);
+
+    if (!query.exec())
+    {
+        qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool KSUserDB::selectRecords(QSqlQuery &query, QList<QVariantMap> &records)
+{
+    if (!query.exec())
+    {
+        qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
+        return false;
+    }
+
+    while (query.next())
+    {
+        QVariantMap recordMap;
+        const QSqlRecord record = query.record();
+        for (int j = 0; j < record.count(); j++)
+            recordMap[record.fieldName(j)] = record.value(j);
+        records.append(recordMap);
+    }
+
+    query.finish();
     return true;
 }
 
@@ -365,7 +613,7 @@ bool KSUserDB::FirstRun()
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::RebuildDB()
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     qCInfo(KSTARS) << "Rebuilding User Database";
 
     QVector<QString> tables;
@@ -598,6 +846,16 @@ bool KSUserDB::RebuildDB()
                   "Colour TEXT DEFAULT NULL, "
                   "Thickness INTEGER DEFAULT 1)");
 
+    tables.append("CREATE TABLE IF NOT EXISTS focushistory ( "
+                  "id INTEGER DEFAULT NULL PRIMARY KEY AUTOINCREMENT, "
+                  "Train INTEGER NOT NULL, "
+                  "Filter TEXT DEFAULT NULL, "
+                  "Position INTEGER NOT NULL, "
+                  "Temperature REAL DEFAULT NULL, "
+                  "Altitude REAL DEFAULT NULL, "
+                  "Value REAL DEFAULT NULL, "
+                  "Timestamp TEXT DEFAULT NULL)");
+
     // Need to offset primary key by 100,000 to differential it from scopes and keep it backward compatible.
     tables.append("UPDATE SQLITE_SEQUENCE SET seq = 100000 WHERE name ='dslrlens'");
 
@@ -623,7 +881,7 @@ bool KSUserDB::RebuildDB()
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::AddObserver(const QString &name, const QString &surname, const QString &contact)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -662,7 +920,7 @@ bool KSUserDB::AddObserver(const QString &name, const QString &surname, const QS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::FindObserver(const QString &name, const QString &surname)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -685,7 +943,7 @@ bool KSUserDB::FindObserver(const QString &name, const QString &surname)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::DeleteObserver(const QString &id)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -712,7 +970,7 @@ bool KSUserDB::DeleteObserver(const QString &id)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::GetAllObservers(QList<Observer *> &observer_list)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -748,27 +1006,17 @@ bool KSUserDB::GetAllObservers(QList<Observer *> &observer_list)
  */
 bool KSUserDB::AddDarkFrame(const QVariantMap &oneFrame)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
         return false;
     }
 
-    QSqlTableModel darkframe(nullptr, db);
-    darkframe.setTable("darkframe");
-    darkframe.select();
-
-    QSqlRecord record = darkframe.record();
-    // Remove PK so that it gets auto-incremented later
-    record.remove(0);
-
-    for (QVariantMap::const_iterator iter = oneFrame.begin(); iter != oneFrame.end(); ++iter)
-        record.setValue(iter.key(), iter.value());
-
-    darkframe.insertRecord(-1, record);
-    darkframe.submitAll();
-    return true;
+    // Remove PK so that it gets auto-incremented
+    QVariantMap record = oneFrame;
+    record.remove("id");
+    return insertRecord("darkframe", record);
 }
 
 /**
@@ -777,26 +1025,14 @@ bool KSUserDB::AddDarkFrame(const QVariantMap &oneFrame)
  */
 bool KSUserDB::UpdateDarkFrame(const QVariantMap &oneFrame)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
         return false;
     }
 
-    QSqlTableModel darkframe(nullptr, db);
-    darkframe.setTable("darkframe");
-    darkframe.setFilter(QString("id=%1").arg(oneFrame["id"].toInt()));
-    darkframe.select();
-
-    QSqlRecord record = darkframe.record(0);
-    for (QVariantMap::const_iterator iter = oneFrame.begin(); iter != oneFrame.end(); ++iter)
-        record.setValue(iter.key(), iter.value());
-
-    darkframe.setRecord(0, record);
-    darkframe.submitAll();
-
-    return true;
+    return updateRecords("darkframe", oneFrame, "id", oneFrame["id"].toInt());
 }
 
 /**
@@ -805,21 +1041,17 @@ bool KSUserDB::UpdateDarkFrame(const QVariantMap &oneFrame)
  */
 bool KSUserDB::DeleteDarkFrame(const QString &filename)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
         return false;
     }
 
-    QSqlTableModel darkframe(nullptr, db);
-    darkframe.setTable("darkframe");
-    darkframe.setFilter("filename = \'" + filename + "\'");
-
-    darkframe.select();
-
-    darkframe.removeRows(0, 1);
-    darkframe.submitAll();
+    QSqlQuery &query = preparedQuery("DELETE FROM darkframe WHERE id = (SELECT id FROM darkframe WHERE filename = ? LIMIT 1)");
+    query.addBindValue(filename);
+    if (!query.exec())
+        qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
 
     return true;
 }
@@ -829,7 +1061,7 @@ bool KSUserDB::DeleteDarkFrame(const QString &filename)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::GetAllDarkFrames(QList<QVariantMap> &darkFrames)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -838,21 +1070,7 @@ bool KSUserDB::GetAllDarkFrames(QList<QVariantMap> &darkFrames)
 
     darkFrames.clear();
 
-    QSqlTableModel darkframe(nullptr, db);
-    darkframe.setTable("darkframe");
-    darkframe.select();
-
-    for (int i = 0; i < darkframe.rowCount(); ++i)
-    {
-        QVariantMap recordMap;
-        QSqlRecord record = darkframe.record(i);
-        for (int j = 0; j < record.count(); j++)
-            recordMap[record.fieldName(j)] = record.value(j);
-
-        darkFrames.append(recordMap);
-    }
-
-    return true;
+    return selectRecords(preparedQuery("SELECT * FROM darkframe"), darkFrames);
 }
 
 
@@ -863,7 +1081,7 @@ bool KSUserDB::GetAllDarkFrames(QList<QVariantMap> &darkFrames)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::AddEffectiveFOV(const QVariantMap &oneFOV)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -894,7 +1112,7 @@ bool KSUserDB::AddEffectiveFOV(const QVariantMap &oneFOV)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::DeleteEffectiveFOV(const QString &id)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -917,7 +1135,7 @@ bool KSUserDB::DeleteEffectiveFOV(const QString &id)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::GetAllEffectiveFOVs(QList<QVariantMap> &effectiveFOVs)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -950,34 +1168,17 @@ bool KSUserDB::GetAllEffectiveFOVs(QList<QVariantMap> &effectiveFOVs)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::AddOpticalTrain(const QVariantMap &oneTrain)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
         return false;
     }
 
-    QSqlTableModel opticalTrain(nullptr, db);
-    opticalTrain.setTable("opticaltrains");
-    opticalTrain.select();
-
-    QSqlRecord record = opticalTrain.record();
-
-    // Remove PK so that it gets auto-incremented later
-    record.remove(0);
-
-    for (QVariantMap::const_iterator iter = oneTrain.begin(); iter != oneTrain.end(); ++iter)
-        record.setValue(iter.key(), iter.value());
-
-    opticalTrain.insertRecord(-1, record);
-
-    if (!opticalTrain.submitAll())
-    {
-        qCWarning(KSTARS) << opticalTrain.lastError();
-        return false;
-    }
-
-    return true;
+    // Remove PK so that it gets auto-incremented
+    QVariantMap record = oneTrain;
+    record.remove("id");
+    return insertRecord("opticaltrains", record);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -985,32 +1186,14 @@ bool KSUserDB::AddOpticalTrain(const QVariantMap &oneTrain)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::UpdateOpticalTrain(const QVariantMap &oneTrain, int id)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
         return false;
     }
 
-    QSqlTableModel opticalTrain(nullptr, db);
-    opticalTrain.setTable("opticaltrains");
-    opticalTrain.setFilter(QString("id=%1").arg(id));
-    opticalTrain.select();
-
-    QSqlRecord record = opticalTrain.record(0);
-
-    for (QVariantMap::const_iterator iter = oneTrain.begin(); iter != oneTrain.end(); ++iter)
-        record.setValue(iter.key(), iter.value());
-
-    opticalTrain.setRecord(0, record);
-
-    if (!opticalTrain.submitAll())
-    {
-        qCWarning(KSTARS) << opticalTrain.lastError();
-        return false;
-    }
-
-    return true;
+    return updateRecords("opticaltrains", oneTrain, "id", id);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1018,7 +1201,7 @@ bool KSUserDB::UpdateOpticalTrain(const QVariantMap &oneTrain, int id)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::DeleteOpticalTrain(int id)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1041,7 +1224,7 @@ bool KSUserDB::DeleteOpticalTrain(int id)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::GetOpticalTrains(uint32_t profileID, QList<QVariantMap> &opticalTrains)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1050,22 +1233,9 @@ bool KSUserDB::GetOpticalTrains(uint32_t profileID, QList<QVariantMap> &opticalT
 
     opticalTrains.clear();
 
-    QSqlTableModel opticalTrain(nullptr, db);
-    opticalTrain.setTable("opticaltrains");
-    opticalTrain.setFilter(QString("profile=%1").arg(profileID));
-    opticalTrain.select();
-
-    for (int i = 0; i < opticalTrain.rowCount(); ++i)
-    {
-        QVariantMap recordMap;
-        QSqlRecord record = opticalTrain.record(i);
-        for (int j = 0; j < record.count(); j++)
-            recordMap[record.fieldName(j)] = record.value(j);
-
-        opticalTrains.append(recordMap);
-    }
-
-    return true;
+    QSqlQuery &query = preparedQuery("SELECT * FROM opticaltrains WHERE profile=?");
+    query.addBindValue(profileID);
+    return selectRecords(query, opticalTrains);
 }
 
 /* Driver Alias Section */
@@ -1075,7 +1245,7 @@ bool KSUserDB::GetOpticalTrains(uint32_t profileID, QList<QVariantMap> &opticalT
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::AddCustomDriver(const QVariantMap &oneDriver)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1108,7 +1278,7 @@ bool KSUserDB::AddCustomDriver(const QVariantMap &oneDriver)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::DeleteCustomDriver(const QString &id)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1132,7 +1302,7 @@ bool KSUserDB::DeleteCustomDriver(const QString &id)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::GetAllCustomDrivers(QList<QVariantMap> &CustomDrivers)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1164,7 +1334,7 @@ bool KSUserDB::GetAllCustomDrivers(QList<QVariantMap> &CustomDrivers)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::AddHIPSSource(const QMap<QString, QString> &oneSource)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1191,7 +1361,7 @@ bool KSUserDB::AddHIPSSource(const QMap<QString, QString> &oneSource)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::DeleteHIPSSource(const QString &ID)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1215,7 +1385,7 @@ bool KSUserDB::DeleteHIPSSource(const QString &ID)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::GetAllHIPSSources(QList<QMap<QString, QString>> &HIPSSources)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1248,7 +1418,7 @@ bool KSUserDB::GetAllHIPSSources(QList<QMap<QString, QString>> &HIPSSources)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::AddDSLRInfo(const QMap<QString, QVariant> &oneInfo)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1275,7 +1445,7 @@ bool KSUserDB::AddDSLRInfo(const QMap<QString, QVariant> &oneInfo)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::DeleteAllDSLRInfo()
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1297,7 +1467,7 @@ bool KSUserDB::DeleteAllDSLRInfo()
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::DeleteDSLRInfo(const QString &model)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1321,7 +1491,7 @@ bool KSUserDB::DeleteDSLRInfo(const QString &model)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::GetAllDSLRInfos(QList<QMap<QString, QVariant>> &DSLRInfos)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1356,7 +1526,7 @@ bool KSUserDB::GetAllDSLRInfos(QList<QMap<QString, QVariant>> &DSLRInfos)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::DeleteAllFlags()
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1382,7 +1552,7 @@ bool KSUserDB::DeleteAllFlags()
 bool KSUserDB::AddFlag(const QString &ra, const QString &dec, const QString &epoch, const QString &image_name,
                        const QString &label, const QString &labelColor)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1411,7 +1581,7 @@ bool KSUserDB::AddFlag(const QString &ra, const QString &dec, const QString &epo
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::GetAllFlags(QList<QStringList> &flagList)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1455,7 +1625,7 @@ bool KSUserDB::GetAllFlags(QList<QStringList> &flagList)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::DeleteEquipment(const QString &type, const QString &id)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1479,7 +1649,7 @@ bool KSUserDB::DeleteEquipment(const QString &type, const QString &id)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::DeleteAllEquipment(const QString &type)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1508,7 +1678,7 @@ bool KSUserDB::DeleteAllEquipment(const QString &type)
 bool KSUserDB::AddScope(const QString &model, const QString &vendor, const QString &type, const double &aperture,
                         const double &focalLength)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1541,7 +1711,7 @@ bool KSUserDB::AddScope(const QString &model, const QString &vendor, const QStri
 bool KSUserDB::AddScope(const QString &model, const QString &vendor, const QString &type,
                         const double &aperture, const double &focalLength, const QString &id)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1575,7 +1745,7 @@ bool KSUserDB::AddScope(const QString &model, const QString &vendor, const QStri
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::GetAllScopes(QList<Scope *> &scope_list)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1616,7 +1786,7 @@ bool KSUserDB::GetAllScopes(QList<Scope *> &scope_list)
 bool KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const double &focalLength, const double &fov,
                            const QString &fovunit)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1645,7 +1815,7 @@ bool KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const do
 bool KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const double &focalLength, const double &fov,
                            const QString &fovunit, const QString &id)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1679,7 +1849,7 @@ bool KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const do
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::GetAllEyepieces(QList<OAL::Eyepiece *> &eyepiece_list)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1719,7 +1889,7 @@ bool KSUserDB::GetAllEyepieces(QList<OAL::Eyepiece *> &eyepiece_list)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::AddLens(const QString &vendor, const QString &model, const double &factor)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1745,7 +1915,7 @@ bool KSUserDB::AddLens(const QString &vendor, const QString &model, const double
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::AddLens(const QString &vendor, const QString &model, const double &factor, const QString &id)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1775,7 +1945,7 @@ bool KSUserDB::AddLens(const QString &vendor, const QString &model, const double
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::GetAllLenses(QList<OAL::Lens *> &lens_list)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1813,7 +1983,7 @@ bool KSUserDB::GetAllLenses(QList<OAL::Lens *> &lens_list)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::AddFilter(const filterProperties *fp)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1854,7 +2024,7 @@ bool KSUserDB::AddFilter(const filterProperties *fp)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::AddFilter(const filterProperties *fp, const QString &id)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -1898,7 +2068,7 @@ bool KSUserDB::AddFilter(const filterProperties *fp, const QString &id)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::GetAllFilters(QList<OAL::Filter *> &filter_list)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -2224,7 +2394,7 @@ void KSUserDB::readFilter()
 
 bool KSUserDB::GetAllHorizons(QList<ArtificialHorizonEntity *> &horizonList)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -2284,13 +2454,15 @@ bool KSUserDB::GetAllHorizons(QList<ArtificialHorizonEntity *> &horizonList)
 
 bool KSUserDB::DeleteAllHorizons()
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
         return false;
     }
 
+    db.transaction();
+
     QSqlTableModel regions(nullptr, db);
     regions.setEditStrategy(QSqlTableModel::OnManualSubmit);
     regions.setTable("horizons");
@@ -2310,18 +2482,23 @@ bool KSUserDB::DeleteAllHorizons()
     regions.submitAll();
 
     regions.clear();
+    if (!db.commit())
+        qCWarning(KSTARS) << db.lastError().text();
     return true;
 }
 
 bool KSUserDB::AddHorizon(ArtificialHorizonEntity *horizon)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
         return false;
     }
 
+    // One transaction for the region and all its points rather than one per row.
+    db.transaction();
+
     QSqlTableModel regions(nullptr, db);
     regions.setTable("horizons");
 
@@ -2342,30 +2519,25 @@ bool KSUserDB::AddHorizon(ArtificialHorizonEntity *horizon)
     QSqlQuery query(db);
     query.exec(tableQuery);
 
-    QSqlTableModel points(nullptr, db);
-
-    points.setTable(tableName);
-
     SkyList *skyList = horizon->list()->points();
 
+    query.prepare(QString("INSERT INTO %1 (Az, Alt) VALUES (?, ?)").arg(tableName));
     for (const auto &item : *skyList)
     {
-        points.select();
-        QSqlRecord rec(points.record());
-
-        rec.setValue("Az", item->az().Degrees());
-        rec.setValue("Alt", item->alt().Degrees());
-        points.insertRecord(-1, rec);
+        query.addBindValue(item->az().Degrees());
+        query.addBindValue(item->alt().Degrees());
+        if (!query.exec())
+            qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
     }
 
-    points.submitAll();
-    points.clear();
+    if (!db.commit())
+        qCWarning(KSTARS) << db.lastError().text();
     return true;
 }
 
 void KSUserDB::CreateImageOverlayTableIfNecessary()
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     QString command = "CREATE TABLE IF NOT EXISTS imageOverlays ( "
                       "id INTEGER DEFAULT NULL PRIMARY KEY AUTOINCREMENT, "
                       "filename TEXT NOT NULL,"
@@ -2390,7 +2562,7 @@ void KSUserDB::CreateImageOverlayTableIfNecessary()
 bool KSUserDB::DeleteAllImageOverlays()
 {
     CreateImageOverlayTableIfNecessary();
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -2415,7 +2587,7 @@ bool KSUserDB::DeleteAllImageOverlays()
 bool KSUserDB::AddImageOverlay(const ImageOverlay &overlay)
 {
     CreateImageOverlayTableIfNecessary();
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -2468,7 +2640,7 @@ bool KSUserDB::AddImageOverlay(const ImageOverlay &overlay)
 bool KSUserDB::GetAllImageOverlays(QList<ImageOverlay> *imageOverlayList)
 {
     CreateImageOverlayTableIfNecessary();
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -2507,7 +2679,7 @@ bool KSUserDB::GetAllImageOverlays(QList<ImageOverlay> *imageOverlayList)
 
 int KSUserDB::AddProfile(const QString &name)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -2529,7 +2701,7 @@ int KSUserDB::AddProfile(const QString &name)
 
 bool KSUserDB::DeleteProfile(const QSharedPointer<ProfileInfo> &pi)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -2551,7 +2723,7 @@ bool KSUserDB::DeleteProfile(const QSharedPointer<ProfileInfo> &pi)
 
 bool KSUserDB::PurgeProfile(const QSharedPointer<ProfileInfo> &pi)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -2580,13 +2752,16 @@ bool KSUserDB::PurgeProfile(const QSharedPointer<ProfileInfo> &pi)
 
 bool KSUserDB::SaveProfile(const QSharedPointer<ProfileInfo> &pi)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
         return false;
     }
 
+    // Write the whole profile in a single transaction instead of one per statement.
+    db.transaction();
+
     // Remove all drivers
     DeleteProfileDrivers(pi);
 
@@ -2679,13 +2854,15 @@ bool KSUserDB::SaveProfile(const QSharedPointer<ProfileInfo> &pi)
     /*if (pi->customDrivers.isEmpty() == false && !query.exec(QString("INSERT INTO custom_driver (drivers, profile) VALUES('%1',%2)").arg(pi->customDrivers).arg(pi->id)))
         qDebug()  << query.lastQuery() << query.lastError().text();*/
 
+    if (!db.commit())
+        qCWarning(KSTARS) << db.lastError().text();
 
     return true;
 }
 
 bool KSUserDB::GetAllProfiles(QList<QSharedPointer<ProfileInfo>> &profiles)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -2741,7 +2918,7 @@ bool KSUserDB::GetAllProfiles(QList<QSharedPointer<ProfileInfo>> &profiles)
 
 bool KSUserDB::GetProfileDrivers(const QSharedPointer<ProfileInfo> &pi)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -2785,7 +2962,7 @@ bool KSUserDB::GetProfileDrivers(const QSharedPointer<ProfileInfo> &pi)
 
 bool KSUserDB::DeleteProfileDrivers(const QSharedPointer<ProfileInfo> &pi)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -2808,7 +2985,7 @@ bool KSUserDB::DeleteProfileDrivers(const QSharedPointer<ProfileInfo> &pi)
 */
 bool KSUserDB::AddDSLRLens(const QString &model, const QString &vendor, const double focalLength, const double focalRatio)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -2836,7 +3013,7 @@ bool KSUserDB::AddDSLRLens(const QString &model, const QString &vendor, const do
 bool KSUserDB::AddDSLRLens(const QString &model, const QString &vendor, const double focalLength, const double focalRatio,
                            const QString &id)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -2867,7 +3044,7 @@ bool KSUserDB::GetAllDSLRLenses(QList<OAL::DSLRLens *> &dslrlens_list)
 {
     dslrlens_list.clear();
 
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -2998,7 +3175,7 @@ QStringList KSUserDB::getOpticalElementNames()
 
 void KSUserDB::AddProfileSettings(uint32_t profile, const QByteArray &settings)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
 
@@ -3019,27 +3196,21 @@ void KSUserDB::AddProfileSettings(uint32_t profile, const QByteArray &settings)
 
 void KSUserDB::UpdateProfileSettings(uint32_t profile, const QByteArray &settings)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
 
-    QSqlTableModel profileSettings(nullptr, db);
-    profileSettings.setTable("profilesettings");
-    profileSettings.setFilter(QString("profile=%1").arg(profile));
-    profileSettings.select();
-
-    QSqlRecord record = profileSettings.record(0);
-    record.setValue("settings", settings);
-    profileSettings.setRecord(0, record);
-
-    if (!profileSettings.submitAll())
-        qCWarning(KSTARS) << profileSettings.lastError();
+    QSqlQuery &query = preparedQuery("UPDATE profilesettings SET settings=? WHERE profile=?");
+    query.addBindValue(settings);
+    query.addBindValue(profile);
+    if (!query.exec())
+        qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
 }
 
 
 void KSUserDB::DeleteProfileSettings(uint32_t profile)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
 
@@ -3054,7 +3225,7 @@ void KSUserDB::DeleteProfileSettings(uint32_t profile)
 
 bool KSUserDB::GetProfileSettings(uint32_t profile, QVariantMap &settings)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -3063,23 +3234,21 @@ bool KSUserDB::GetProfileSettings(uint32_t profile, QVariantMap &settings)
 
     settings.clear();
 
-    QSqlTableModel profileSettings(nullptr, db);
-    profileSettings.setTable("profilesettings");
-    profileSettings.setFilter(QString("profile=%1").arg(profile));
-    profileSettings.select();
+    QSqlQuery &query = preparedQuery("SELECT settings FROM profilesettings WHERE profile=? LIMIT 1");
+    query.addBindValue(profile);
 
-    if (profileSettings.rowCount() > 0)
+    QList<QVariantMap> records;
+    if (!selectRecords(query, records) || records.isEmpty())
+        return false;
+
+    auto settingsField = records.first().value("settings").toByteArray();
+    QJsonParseError parserError;
+    auto doc = QJsonDocument::fromJson(settingsField, &parserError);
+    if (parserError.error == QJsonParseError::NoError)
     {
-        QSqlRecord record = profileSettings.record(0);
-        auto settingsField = record.value("settings").toByteArray();
-        QJsonParseError parserError;
-        auto doc = QJsonDocument::fromJson(settingsField, &parserError);
-        if (parserError.error == QJsonParseError::NoError)
-        {
-            settings = doc.object().toVariantMap();
+        settings = doc.object().toVariantMap();
 
-            return true;
-        }
+        return true;
     }
 
     return false;
@@ -3087,7 +3256,7 @@ bool KSUserDB::GetProfileSettings(uint32_t profile, QVariantMap &settings)
 
 bool KSUserDB::AddOpticalTrainSettings(uint32_t train, const QByteArray &settings)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -3114,31 +3283,25 @@ bool KSUserDB::AddOpticalTrainSettings(uint32_t train, const QByteArray &setting
 
 bool KSUserDB::UpdateOpticalTrainSettings(uint32_t train, const QByteArray &settings)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
         return false;
     }
 
-    QSqlTableModel OpticalTrainSettings(nullptr, db);
-    OpticalTrainSettings.setTable("opticaltrainsettings");
-    OpticalTrainSettings.setFilter(QString("opticaltrain=%1").arg(train));
-    OpticalTrainSettings.select();
-
-    QSqlRecord record = OpticalTrainSettings.record(0);
-    record.setValue("settings", settings);
-    OpticalTrainSettings.setRecord(0, record);
-
-    if (!OpticalTrainSettings.submitAll())
-        qCWarning(KSTARS) << OpticalTrainSettings.lastError();
+    QSqlQuery &query = preparedQuery("UPDATE opticaltrainsettings SET settings=? WHERE opticaltrain=?");
+    query.addBindValue(settings);
+    query.addBindValue(train);
+    if (!query.exec())
+        qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
 
     return true;
 }
 
 bool KSUserDB::DeleteOpticalTrainSettings(uint32_t train)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -3151,7 +3314,7 @@ bool KSUserDB::DeleteOpticalTrainSettings(uint32_t train)
 
 bool KSUserDB::GetOpticalTrainSettings(uint32_t train, QVariantMap &settings)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -3160,23 +3323,21 @@ bool KSUserDB::GetOpticalTrainSettings(uint32_t train, QVariantMap &settings)
 
     settings.clear();
 
-    QSqlTableModel OpticalTrainSettings(nullptr, db);
-    OpticalTrainSettings.setTable("OpticalTrainsettings");
-    OpticalTrainSettings.setFilter(QString("opticaltrain=%1").arg(train));
-    OpticalTrainSettings.select();
+    QSqlQuery &query = preparedQuery("SELECT settings FROM opticaltrainsettings WHERE opticaltrain=? LIMIT 1");
+    query.addBindValue(train);
+
+    QList<QVariantMap> records;
+    if (!selectRecords(query, records) || records.isEmpty())
+        return false;
 
-    if (OpticalTrainSettings.rowCount() > 0)
+    auto settingsField = records.first().value("settings").toByteArray();
+    QJsonParseError parserError;
+    auto doc = QJsonDocument::fromJson(settingsField, &parserError);
+    if (parserError.error == QJsonParseError::NoError)
     {
-        QSqlRecord record = OpticalTrainSettings.record(0);
-        auto settingsField = record.value("settings").toByteArray();
-        QJsonParseError parserError;
-        auto doc = QJsonDocument::fromJson(settingsField, &parserError);
-        if (parserError.error == QJsonParseError::NoError)
-        {
-            settings = doc.object().toVariantMap();
+        settings = doc.object().toVariantMap();
 
-            return true;
-        }
+        return true;
     }
 
     return false;
@@ -3189,7 +3350,7 @@ bool KSUserDB::GetOpticalTrainSettings(uint32_t train, QVariantMap &settings)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::AddCollimationOverlayElement(const QVariantMap &oneElement)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -3224,7 +3385,7 @@ bool KSUserDB::AddCollimationOverlayElement(const QVariantMap &oneElement)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::UpdateCollimationOverlayElement(const QVariantMap &oneElement, int id)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -3257,7 +3418,7 @@ bool KSUserDB::UpdateCollimationOverlayElement(const QVariantMap &oneElement, in
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::DeleteCollimationOverlayElement(int id)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -3280,7 +3441,7 @@ bool KSUserDB::DeleteCollimationOverlayElement(int id)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool KSUserDB::GetCollimationOverlayElements(QList<QVariantMap> &collimationOverlayElements)
 {
-    auto db = QSqlDatabase::database(m_ConnectionName);
+    auto db = database();
     if (!db.isValid())
     {
         qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
@@ -3305,3 +3466,39 @@ bool KSUserDB::GetCollimationOverlayElements(QList<QVariantMap> &collimationOver
 
     return true;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool KSUserDB::AddFocusRun(const QVariantMap &oneRun)
+{
+    auto db = database();
+    if (!db.isValid())
+    {
+        qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
+        return false;
+    }
+
+    return insertRecord("focushistory", oneRun);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool KSUserDB::GetFocusRuns(uint32_t train, const QString &filter, int limit, QList<QVariantMap> &runs)
+{
+    auto db = database();
+    if (!db.isValid())
+    {
+        qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
+        return false;
+    }
+
+    runs.clear();
+
+    QSqlQuery &query = preparedQuery("SELECT * FROM focushistory WHERE Train=? AND Filter=? ORDER BY id DESC LIMIT ?");
+    query.addBindValue(train);
+    query.addBindValue(filter);
+    query.addBindValue(limit);
+    return selectRecords(query, runs);
+}
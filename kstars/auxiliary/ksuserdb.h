@@ -13,12 +13,22 @@
 #include <oal/filter.h>
 
 #include <QFile>
+#include <QFuture>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
 #include <QSqlDatabase>
 #include <QSqlError>
+#include <QSqlQuery>
+#include <QSqlRecord>
 #include <QStringList>
+#include <QThread>
+#include <QThreadPool>
 #include <QVariantMap>
 #include <QXmlStreamReader>
 
+#include <atomic>
+#include <functional>
 #include <memory>
 
 class LineList;
@@ -51,6 +61,22 @@ class KSUserDB
             return m_ConnectionName;
         }
 
+        /**
+         * @brief post Queue a write to run on the database thread, so the caller does not wait for the disk.
+         * Writes run one at a time in the order they were posted, on a connection of their own. Reads and
+         * synchronous writes made afterwards first wait for every queued write to complete.
+         * @param write Called on the database thread with this database, typically to call one of its Add or
+         * Update methods.
+         * @return Future holding the result of write, which fire-and-forget callers can ignore.
+         * @note Initialize() must have succeeded before posting writes.
+         */
+        QFuture<bool> post(const std::function<bool(KSUserDB &)> &write);
+
+        /**
+         * @brief flush Block until all the writes posted so far have completed.
+         */
+        void flush();
+
         /************************************************************************
          ********************************* Drivers ******************************
          ************************************************************************/
@@ -460,6 +486,25 @@ class KSUserDB
          **/
         bool GetCollimationOverlayElements(QList<QVariantMap> &collimationOverlayElements);
 
+        /************************************************************************
+         ******************************** Focus History *************************
+         ************************************************************************/
+
+        /**
+         * @brief Add the result of a successful autofocus run
+         * @param oneRun Train, Filter, Position, Temperature, Altitude, Value and Timestamp of the run
+         **/
+        bool AddFocusRun(const QVariantMap &oneRun);
+
+        /**
+         * @brief Populate the reference passed with the latest autofocus runs of a train and filter
+         * @param train ID of the optical train
+         * @param filter filter the runs were made with
+         * @param limit maximum number of runs to return
+         * @param runs Reference to the runs, most recent first
+         **/
+        bool GetFocusRuns(uint32_t train, const QString &filter, int limit, QList<QVariantMap> &runs);
+
     private:
         /**
          * @brief This function initializes a new database in the user's directory.
@@ -514,10 +559,73 @@ class KSUserDB
         bool GetProfileDrivers(const QSharedPointer<ProfileInfo> &pi);
         //void GetProfileCustomDrivers(ProfileInfo *pi);
 
+        /**
+         * @brief database Connection of the calling thread, the database thread having its own. On any other
+         * thread, waits for the queued writes first.
+         */
+        QSqlDatabase database();
+
+        bool onWriterThread() const
+        {
+            return QThread::currentThread() == m_WriterThread.load();
+        }
+
+        /**
+         * @brief preparedQuery Get the query for statement, prepared on first use and kept for the lifetime of the
+         * connection, so frequent statements are not parsed again on every call.
+         * @param statement SQL with positional placeholders.
+         * @return Prepared query, ready to bind values to.
+         */
+        QSqlQuery &preparedQuery(const QString &statement);
+
+        /**
+         * @brief tableColumns Columns of table, looked up once per connection.
+         */
+        QSqlRecord tableColumns(const QString &table);
+
+        /**
+         * @brief insertRecord Insert values in table, ignoring keys that are not columns of table.
+         */
+        bool insertRecord(const QString &table, const QVariantMap &values);
+
+        /**
+         * @brief updateRecords Set values on the rows of table where keyColumn is keyValue, ignoring keys that are not
+         * columns of table.
+         */
+        bool updateRecords(const QString &table, const QVariantMap &values, const QString &keyColumn, const QVariant &keyValue);
+
+        /**
+         * @brief selectRecords Execute a prepared query and append each row it returns to records.
+         */
+        bool selectRecords(QSqlQuery &query, QList<QVariantMap> &records);
+
+        struct ConnectionCache
+        {
+            /** Prepared queries, by statement. A map so references to them stay valid as more are added. */
+            QMap<QString, QSqlQuery> preparedQueries;
+            QHash<QString, QSqlRecord> tableColumns;
+        };
+
+        /** Cache of the connection used by the calling thread. */
+        ConnectionCache &connectionCache()
+        {
+            return onWriterThread() ? m_WriterCache : m_MainCache;
+        }
+
+        ConnectionCache m_MainCache, m_WriterCache;
+
         /** XML reader for importing old formats **/
         QXmlStreamReader *reader_ { nullptr };
 
         QString m_ConnectionName;
 
-        static const uint16_t SCHEMA_VERSION = 314;
+        // Database thread: a pool of a single thread that never expires, so its connection stays on one thread.
+        QString m_WriterConnectionName;
+        QThreadPool m_WriterPool;
+        std::atomic<QThread *> m_WriterThread { nullptr };
+        // Guards the last posted write, which completes after all the others.
+        QMutex m_WriterMutex;
+        QFuture<bool> m_LastWrite;
+
+        static const uint16_t SCHEMA_VERSION = 315;
 };
@@ -1078,6 +1078,7 @@ void Logging::SyncFilterRules()
           << (Options::schedulerLogging() ? "true" : "false");
     rules << "org.kde.kstars.ekos.observatory.debug"
           << (Options::observatoryLogging() ? "true" : "false");
+    rules << "org.kde.kstars.startup.debug" << (Options::verboseLogging() ? "true" : "false");
     rules << "org.kde.kstars.debug" << (Options::verboseLogging() ? "true" : "false");
 
     QString formattedRules;
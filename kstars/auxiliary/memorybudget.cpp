@@ -0,0 +1,151 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "memorybudget.h"
+
+#include "ksutils.h"
+#include "Options.h"
+
+#include <QFile>
+
+#include <algorithm>
+
+#include <kstars_debug.h>
+
+namespace
+{
+
+// Part of the RAM KStars Lite takes on its own, and the least it takes
+constexpr int LITE_RAM_DIVISOR = 4;
+constexpr qint64 MIN_BUDGET = 128LL * 1024 * 1024;
+// RAM assumed on devices where it can't be determined
+constexpr qint64 DEFAULT_RAM = 2048LL * 1024 * 1024;
+// Free memory below this part of the RAM counts as low
+constexpr double LOW_MEMORY_FRACTION = 0.1;
+constexpr int CHECK_INTERVAL = 30000;
+
+// Reads a field of /proc/meminfo in bytes, as on Linux and Android
+qint64 memInfo(const QByteArray &field)
+{
+    QFile file("/proc/meminfo");
+    if (!file.open(QIODevice::ReadOnly))
+        return 0;
+
+    while (!file.atEnd())
+    {
+        const QByteArray line = file.readLine();
+        if (line.startsWith(field + ':'))
+        {
+            const QList<QByteArray> parts = line.mid(field.size() + 1).simplified().split(' ');
+            return parts.first().toLongLong() * 1024;
+        }
+    }
+    return 0;
+}
+
+}
+
+MemoryBudget *MemoryBudget::m_Instance = nullptr;
+
+MemoryBudget *MemoryBudget::Instance()
+{
+    if (m_Instance == nullptr)
+        m_Instance = new MemoryBudget();
+    return m_Instance;
+}
+
+MemoryBudget::MemoryBudget()
+{
+    m_CheckTimer.setInterval(CHECK_INTERVAL);
+    connect(&m_CheckTimer, &QTimer::timeout, this, &MemoryBudget::checkAvailable);
+    update();
+}
+
+void MemoryBudget::update()
+{
+    const qint64 option = static_cast<qint64>(Options::memoryBudget()) * 1024 * 1024;
+    if (option > 0)
+        m_Budget = option;
+    else
+    {
+#ifdef KSTARS_LITE
+        const qint64 ram = totalRAM();
+        m_Budget         = std::max(MIN_BUDGET, (ram > 0 ? ram : DEFAULT_RAM) / LITE_RAM_DIVISOR);
+#else
+        m_Budget = 0;
+#endif
+    }
+
+    if (isLimited())
+    {
+        qCInfo(KSTARS) << "Caches are limited to" << m_Budget / (1024 * 1024) << "MB";
+        m_CheckTimer.start();
+    }
+    else
+        m_CheckTimer.stop();
+}
+
+qint64 MemoryBudget::share(Cache cache) const
+{
+    if (!isLimited())
+        return 0;
+
+    // Stars are what the sky map is made of, the rest is shared by the extras
+    switch (cache)
+    {
+        case STAR_BLOCKS:
+            return m_Budget / 2;
+        case CATALOGS:
+        case HIPS:
+        default:
+            return m_Budget / 4;
+    }
+}
+
+double MemoryBudget::scale() const
+{
+    if (!isLimited())
+        return 1;
+    return std::min(1.0, double(m_Budget) / REFERENCE_BUDGET);
+}
+
+qint64 MemoryBudget::totalRAM()
+{
+    return memInfo("MemTotal");
+}
+
+qint64 MemoryBudget::availableRAM()
+{
+    const qint64 available = memInfo("MemAvailable");
+    if (available > 0)
+        return available;
+#ifdef Q_OS_LINUX
+    return 0;
+#else
+    return static_cast<qint64>(KSUtils::getAvailableRAM());
+#endif
+}
+
+void MemoryBudget::checkAvailable()
+{
+    const qint64 total = totalRAM(), available = availableRAM();
+    if (total <= 0 || available <= 0)
+        return;
+
+    // Only signal once each time the memory runs low
+    const bool low = available < total * LOW_MEMORY_FRACTION;
+    if (low && !m_Low)
+    {
+        qCInfo(KSTARS) << "Low on memory," << available / (1024 * 1024) << "MB free";
+        onLowMemory();
+    }
+    m_Low = low;
+}
+
+void MemoryBudget::onLowMemory()
+{
+    emit lowMemory();
+}
@@ -0,0 +1,88 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+
+/**
+ * @class MemoryBudget
+ * @short The memory the caches of sky data may take, shared out among them.
+ *
+ * The budget is the MemoryBudget option if it is set. Otherwise KStars Lite takes a quarter of the
+ * RAM of the device, and the desktop has no budget. Caches size themselves with share() or scale(),
+ * which leave the capacities the options ask for as they are when there is no budget.
+ *
+ * With a budget, the free memory of the device is checked every so often. When it runs low, and
+ * whenever onLowMemory() is called, lowMemory() is emitted, and the caches drop what is not on
+ * the screen.
+ */
+class MemoryBudget : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** The caches the budget is shared out among */
+        enum Cache
+        {
+            STAR_BLOCKS,
+            CATALOGS,
+            HIPS
+        };
+
+        static MemoryBudget *Instance();
+
+        /** @return the budget in bytes, 0 if there is no budget */
+        qint64 budget() const
+        {
+            return m_Budget;
+        }
+
+        bool isLimited() const
+        {
+            return m_Budget > 0;
+        }
+
+        /** @return the bytes @p cache may take, 0 if there is no budget */
+        qint64 share(Cache cache) const;
+
+        /**
+         * @return the factor, at most 1, to scale capacities that can't be counted in bytes by. A budget
+         * of REFERENCE_BUDGET or more, or none at all, keeps them as they are.
+         */
+        double scale() const;
+
+        /** @brief update Work the budget out again, after the option changed */
+        void update();
+
+        /** @return the RAM of the device in bytes, 0 if it could not be determined */
+        static qint64 totalRAM();
+
+        /** @return the free RAM of the device in bytes, 0 if it could not be determined */
+        static qint64 availableRAM();
+
+        static constexpr qint64 REFERENCE_BUDGET = 1024LL * 1024 * 1024;
+
+    public slots:
+        /** @brief onLowMemory Ask all caches to drop what they don't need now */
+        void onLowMemory();
+
+    signals:
+        void lowMemory();
+
+    private:
+        MemoryBudget();
+
+        // Emits lowMemory() when the free memory falls below LOW_MEMORY_FRACTION of the RAM
+        void checkAvailable();
+
+        qint64 m_Budget { 0 };
+        QTimer m_CheckTimer;
+        bool m_Low { false };
+
+        static MemoryBudget *m_Instance;
+};
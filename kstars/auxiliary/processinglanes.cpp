@@ -0,0 +1,100 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "processinglanes.h"
+
+#include <QThread>
+
+#include <array>
+#include <memory>
+
+namespace
+{
+constexpr int LANES = ProcessingLanes::DISPLAY + 1;
+
+QThread::Priority priorityOf(ProcessingLanes::Lane lane)
+{
+    switch (lane)
+    {
+        case ProcessingLanes::GUIDE:
+            return QThread::HighPriority;
+        case ProcessingLanes::FOCUS:
+            return QThread::NormalPriority;
+        case ProcessingLanes::CAPTURE:
+            return QThread::LowPriority;
+        case ProcessingLanes::DISPLAY:
+            return QThread::LowestPriority;
+        default:
+            return QThread::InheritPriority;
+    }
+}
+
+// The lanes of less priority get fewer threads, so that they can't take all the cores at once
+int threadsOf(ProcessingLanes::Lane lane)
+{
+    const int cores = qMax(1, QThread::idealThreadCount());
+    switch (lane)
+    {
+        case ProcessingLanes::GUIDE:
+        case ProcessingLanes::FOCUS:
+            return cores;
+        default:
+            return qMax(2, cores / 2);
+    }
+}
+}
+
+QThreadPool *ProcessingLanes::pool(Lane lane)
+{
+    if (lane <= NONE || lane >= LANES)
+        return QThreadPool::globalInstance();
+
+    static const std::array<std::unique_ptr<QThreadPool>, LANES> pools = []()
+    {
+        std::array<std::unique_ptr<QThreadPool>, LANES> lanes;
+        for (int i = NONE + 1; i < LANES; i++)
+        {
+            lanes[i].reset(new QThreadPool());
+            lanes[i]->setMaxThreadCount(threadsOf(static_cast<Lane>(i)));
+            // The detectors need the stack the global pool is given at startup
+            lanes[i]->setStackSize(QThreadPool::globalInstance()->stackSize());
+        }
+        return lanes;
+    }();
+    return pools[lane].get();
+}
+
+ProcessingLanes::Lane &ProcessingLanes::currentLane()
+{
+    static thread_local Lane lane = NONE;
+    return lane;
+}
+
+ProcessingLanes::Lane ProcessingLanes::current(Lane fallback)
+{
+    const Lane lane = currentLane();
+    return lane == NONE ? fallback : lane;
+}
+
+void ProcessingLanes::prioritise(Lane lane)
+{
+    // Only once for each thread, a pool thread stays in its lane
+    static thread_local Lane prioritised = NONE;
+    if (lane == NONE || lane == prioritised)
+        return;
+    prioritised = lane;
+    QThread::currentThread()->setPriority(priorityOf(lane));
+}
+
+ProcessingLanes::Scope::Scope(Lane lane) : m_Previous(currentLane())
+{
+    currentLane() = lane;
+}
+
+ProcessingLanes::Scope::~Scope()
+{
+    currentLane() = m_Previous;
+}
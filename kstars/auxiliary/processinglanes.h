@@ -0,0 +1,108 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QFuture>
+#include <QList>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <iterator>
+
+/**
+ * @class ProcessingLanes
+ * @short Thread pools of their own for the image processing of the Ekos modules, by priority.
+ *
+ * Guide frames must not wait in the global thread pool behind the frames capture saves, focus
+ * measures or the viewers and EkosLive display. Each lane has a pool of its own, so the work of one
+ * lane never queues behind that of another, and its threads run at the priority of the lane: guide
+ * first, then focus, capture, and the display last, where the platform schedules threads by
+ * priority. Work of no lane stays in the global pool.
+ *
+ * Tasks started with run() know their lane, so the parallel loops they start in turn with
+ * run(current()) or blockingMap(current()) stay in the same lane as the frame they work on.
+ */
+class ProcessingLanes
+{
+    public:
+        typedef enum
+        {
+            NONE,
+            GUIDE,
+            FOCUS,
+            CAPTURE,
+            DISPLAY
+        } Lane;
+
+        /** @return the pool of @p lane, the global pool for NONE */
+        static QThreadPool *pool(Lane lane);
+
+        /** @return the lane of the task running on this thread, or @p fallback outside of any lane */
+        static Lane current(Lane fallback = NONE);
+
+        /** @brief prioritise Run the calling thread of a pool of its own at the priority of @p lane */
+        static void prioritise(Lane lane);
+
+        /**
+         * @class Scope
+         * @short Makes the thread work for a lane, such as the GUI thread while it processes a frame.
+         */
+        class Scope
+        {
+            public:
+                explicit Scope(Lane lane);
+                ~Scope();
+
+            private:
+                Lane m_Previous;
+        };
+
+        /** @brief run Run @p function in the pool of @p lane */
+        template <typename Function>
+        static auto run(Lane lane, Function function) -> QFuture<decltype(function())>
+        {
+            return QtConcurrent::run(pool(lane), [lane, function]() mutable
+            {
+                prioritise(lane);
+                Scope scope(lane);
+                return function();
+            });
+        }
+
+        /**
+         * @brief blockingMap Call @p function on every item of @p sequence in the pool of @p lane and
+         * wait for it, as QtConcurrent::blockingMap() does in the global pool.
+         */
+        template <typename Sequence, typename Function>
+        static void blockingMap(Lane lane, Sequence &sequence, Function function)
+        {
+            const int size = static_cast<int>(std::distance(std::begin(sequence), std::end(sequence)));
+            if (size == 0)
+                return;
+
+            // A few batches per thread, so that the threads even out items of uneven work
+            const int batches = qMax(1, qMin(size, 4 * pool(lane)->maxThreadCount()));
+            QList<QFuture<void>> futures;
+            auto first = std::begin(sequence);
+            for (int batch = 0; batch < batches; batch++)
+            {
+                auto last = first;
+                std::advance(last, size / batches + (batch < size % batches ? 1 : 0));
+                futures.append(run(lane, [first, last, &function]()
+                {
+                    std::for_each(first, last, function);
+                }));
+                first = last;
+            }
+            for (auto &future : futures)
+                future.waitForFinished();
+        }
+
+    private:
+        static Lane &currentLane();
+};
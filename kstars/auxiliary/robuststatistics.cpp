@@ -5,7 +5,10 @@
 */
 
 #include "robuststatistics.h"
+#include <algorithm>
 #include <cmath>
+#include <numeric>
+#include <type_traits>
 
 namespace Mathematics::RobustStatistics
 {
@@ -25,6 +28,77 @@ double Pn_from_sorted_data(const Base sorted_data[],
                            Base work[],
                            int work_int[]);
 
+namespace
+{
+
+// The consistency constant gsl_stats_mad uses, so the MAD estimates the standard deviation of Gaussians.
+constexpr double MAD_SCALE = 1.482602218505602;
+
+// Whether the estimator needs the whole sample sorted, rather than a few order statistics of it.
+constexpr bool needsSortedData(const ScaleCalculation scaleMethod)
+{
+    return scaleMethod == SCALE_SESTIMATOR || scaleMethod == SCALE_QESTIMATOR || scaleMethod == SCALE_PESTIMATOR;
+}
+
+// The median as gsl_stats_median_from_sorted_data computes it, selected rather than sorted. The data is reordered.
+template<typename Base>
+double medianInPlace(Base data[], const size_t n)
+{
+    if (n == 0)
+        return 0.0;
+
+    auto const middle = data + n / 2;
+    std::nth_element(data, middle, data + n);
+    if (n % 2 == 1)
+        return *middle;
+    // The other middle element is the largest of those below it
+    return (*std::max_element(data, middle) + *middle) / 2.0;
+}
+
+// The MAD about the median as gsl_stats_mad computes it. work may be the data itself when it is of doubles.
+template<typename Base>
+double madAbout(const Base data[], const size_t n, const double median, double work[])
+{
+    for (size_t i = 0; i < n; ++i)
+        work[i] = std::fabs(data[i] - median);
+    return MAD_SCALE * medianInPlace(work, n);
+}
+
+template<typename Base>
+double biweightMidvariance(const Base data[], const size_t stride, const size_t size, const double median,
+                           const double adjustedMad)
+{
+    auto const begin = Mathematics::GSLHelpers::make_strided_iter(data, stride);
+    auto const end = Mathematics::GSLHelpers::make_strided_iter(data + size, stride);
+
+    // The ys and sums are doubles whatever the data, an int would truncate every term
+    auto ys = std::vector<double>(size / stride);
+    std::transform(begin, end, ys.begin(), [ = ](Base x)
+    {
+        return (x - median) / adjustedMad;
+    });
+    auto const indicator = [](double y)
+    {
+        return std::fabs(y) < 1 ? 1 : 0;
+    };
+    auto const top = std::transform_reduce(begin, end, ys.begin(), 0.0, std::plus{},
+                                           [ = ](Base x, double y)
+    {
+        return indicator(y) * pow(x - median, 2) * pow(1 - pow(y, 2), 4);
+    });
+    auto const bottomSum = std::transform_reduce(ys.begin(), ys.end(), 0.0, std::plus{},
+                           [ = ](double y)
+    {
+        return indicator(y) * (1.0 - pow(y, 2)) * (1.0 - 5.0 * pow(y, 2));
+    });
+    // The -1 is for Bessel's correction.
+    auto const bottom = bottomSum * (bottomSum - 1);
+
+    return (size / stride) * (top / bottom);
+}
+
+}
+
 template<typename Base>
 double ComputeScaleFromSortedData(const ScaleCalculation scaleMethod,
                                   const std::vector<Base> &data,
@@ -40,34 +114,7 @@ double ComputeScaleFromSortedData(const ScaleCalculation scaleMethod,
             auto work = std::make_unique<double[]>(size);
             auto const adjustedMad = 9.0 * gslMAD(theData, stride, size, work.get());
             auto const median = gslMedianFromSortedData(theData, stride, size);
-
-            auto const begin = Mathematics::GSLHelpers::make_strided_iter(data.cbegin(), stride);
-            auto const end = Mathematics::GSLHelpers::make_strided_iter(data.cend(), stride);
-
-            auto ys = std::vector<Base>(size / stride);
-            std::transform(begin, end, ys.begin(), [ = ](Base x)
-            {
-                return (x - median) / adjustedMad;
-            });
-            auto const indicator = [](Base y)
-            {
-                return std::fabs(y) < 1 ? 1 : 0;
-            };
-            auto const top = std::transform_reduce(begin, end, ys.begin(), 0, std::plus{},
-                                                   [ = ](Base x, Base y)
-            {
-                return indicator(y) * pow(x - median, 2) * pow(1 - pow(y, 2), 4);
-            });
-            auto const bottomSum = std::transform_reduce(begin, end, 0, std::plus{},
-                                   [ = ](Base y)
-            {
-                return indicator(y) * (1.0 - pow(y, 2)) * (1.0 - 5.0 * pow(y, 2));
-            });
-            // The -1 is for Bessel's correction.
-            auto const bottom = bottomSum * (bottomSum - 1);
-
-            return (size / stride) * (top / bottom);
-
+            return biweightMidvariance(theData, stride, size, median, adjustedMad);
         }
         case SCALE_MAD:
         {
@@ -128,6 +175,81 @@ template double ComputeScaleFromSortedData(const ScaleCalculation scaleMethod,
         const size_t stride);
 #endif
 
+template<typename Base>
+double ComputeScaleInPlace(const ScaleCalculation scaleMethod, std::vector<Base> &data, const size_t stride)
+{
+    auto const size = data.size();
+    auto const theData = data.data();
+
+    if (scaleMethod == SCALE_VARIANCE)
+        return gslVariance(theData, stride, size);
+
+    if (stride != 1 || needsSortedData(scaleMethod))
+    {
+        std::sort(data.begin(), data.end());
+        return ComputeScaleFromSortedData(scaleMethod, data, stride);
+    }
+
+    switch (scaleMethod)
+    {
+        case SCALE_BWMV:
+        {
+            auto work = std::make_unique<double[]>(size);
+            auto const median = medianInPlace(theData, size);
+            auto const adjustedMad = 9.0 * madAbout(theData, size, median, work.get());
+            return biweightMidvariance(theData, 1, size, median, adjustedMad);
+        }
+        case SCALE_MAD:
+        default:
+        {
+            auto const median = medianInPlace(theData, size);
+            // The deviations can take the place of a sample of doubles, which is not needed any more
+            if constexpr (std::is_same_v<Base, double>)
+                return madAbout(theData, size, median, theData);
+            else
+            {
+                auto work = std::make_unique<double[]>(size);
+                return madAbout(theData, size, median, work.get());
+            }
+        }
+    }
+}
+
+template<typename Base>
+double ComputeApproximateScale(const ScaleCalculation scaleMethod, std::vector<Base> &data, const size_t maxSamples)
+{
+    auto const size = data.size();
+    if (!needsSortedData(scaleMethod) || size <= maxSamples || maxSamples == 0)
+        return ComputeScaleInPlace(scaleMethod, data);
+
+    // Every k-th element, so the subsample spreads over the whole sample whatever order it is in
+    auto const step = (size + maxSamples - 1) / maxSamples;
+    std::vector<Base> subsample;
+    subsample.reserve(maxSamples);
+    for (size_t i = 0; i < size; i += step)
+        subsample.push_back(data[i]);
+
+    std::sort(subsample.begin(), subsample.end());
+    return ComputeScaleFromSortedData(scaleMethod, subsample);
+}
+
+#define ROBUSTSTATISTICS_INSTANTIATE_SCALE(Base) \
+    template double ComputeScaleInPlace(const ScaleCalculation scaleMethod, std::vector<Base> &data, \
+                                        const size_t stride); \
+    template double ComputeApproximateScale(const ScaleCalculation scaleMethod, std::vector<Base> &data, \
+                                            const size_t maxSamples);
+
+ROBUSTSTATISTICS_INSTANTIATE_SCALE(double)
+ROBUSTSTATISTICS_INSTANTIATE_SCALE(float)
+ROBUSTSTATISTICS_INSTANTIATE_SCALE(uint8_t)
+ROBUSTSTATISTICS_INSTANTIATE_SCALE(uint16_t)
+ROBUSTSTATISTICS_INSTANTIATE_SCALE(int16_t)
+ROBUSTSTATISTICS_INSTANTIATE_SCALE(uint32_t)
+ROBUSTSTATISTICS_INSTANTIATE_SCALE(int32_t)
+#ifdef GSLHELPERS_INT64
+ROBUSTSTATISTICS_INSTANTIATE_SCALE(int64_t)
+#endif
+
 template<typename Base> double ComputeLocationFromSortedData(
     const LocationCalculation locationMethod,
     const std::vector<Base> &data,
@@ -207,12 +329,96 @@ template double ComputeLocationFromSortedData(const LocationCalculation scaleMet
 #endif
 
 
+template<typename Base>
+double ComputeLocationInPlace(const LocationCalculation locationMethod, std::vector<Base> &data,
+                              const double trimAmount, const size_t stride)
+{
+    auto const size = data.size();
+    auto const theData = data.data();
+
+    if (locationMethod == LOCATION_MEAN)
+        return gslMean(theData, stride, size);
+
+    if (stride != 1 || locationMethod == LOCATION_GASTWIRTH)
+    {
+        std::sort(data.begin(), data.end());
+        return ComputeLocationFromSortedData(locationMethod, data, trimAmount, stride);
+    }
+
+    switch (locationMethod)
+    {
+        case LOCATION_TRIMMEDMEAN:
+        {
+            if (trimAmount >= 0.5 || size == 0)
+                return medianInPlace(theData, size);
+
+            // The elements gsl_stats_trmean_from_sorted_data averages, in no particular order
+            auto const low = static_cast<size_t>(std::floor(trimAmount * size));
+            auto const high = size - low - 1;
+            std::nth_element(theData, theData + low, theData + size);
+            std::nth_element(theData + low, theData + high, theData + size);
+            return gslMean(theData + low, 1, high - low + 1);
+        }
+        case LOCATION_SIGMACLIPPING:
+        {
+            auto const median = medianInPlace(theData, size);
+            if (size > 3)
+            {
+                auto const stddev = gslStandardDeviation(theData, 1, size);
+                auto const lower = median - stddev * trimAmount;
+                auto const upper = median + stddev * trimAmount;
+
+                // The samples the sorted version finds between its lower and upper bounds
+                Base sum = 0;
+                int num_remaining = 0;
+                for (auto const x : data)
+                {
+                    if (!(x < lower) && !(upper < x))
+                    {
+                        sum += x;
+                        ++num_remaining;
+                    }
+                }
+                if (num_remaining > 0) return sum / num_remaining;
+            }
+            return median;
+        }
+        case LOCATION_MEDIAN:
+        default:
+            return medianInPlace(theData, size);
+    }
+}
+
+#define ROBUSTSTATISTICS_INSTANTIATE_LOCATION(Base) \
+    template double ComputeLocationInPlace(const LocationCalculation locationMethod, std::vector<Base> &data, \
+                                           const double trimAmount, const size_t stride);
+
+ROBUSTSTATISTICS_INSTANTIATE_LOCATION(double)
+ROBUSTSTATISTICS_INSTANTIATE_LOCATION(float)
+ROBUSTSTATISTICS_INSTANTIATE_LOCATION(uint8_t)
+ROBUSTSTATISTICS_INSTANTIATE_LOCATION(uint16_t)
+ROBUSTSTATISTICS_INSTANTIATE_LOCATION(int16_t)
+ROBUSTSTATISTICS_INSTANTIATE_LOCATION(uint32_t)
+ROBUSTSTATISTICS_INSTANTIATE_LOCATION(int32_t)
+#ifdef GSLHELPERS_INT64
+ROBUSTSTATISTICS_INSTANTIATE_LOCATION(int64_t)
+#endif
+
 SampleStatistics ComputeSampleStatistics(std::vector<double> data,
         const RobustStatistics::LocationCalculation locationMethod,
         const RobustStatistics::ScaleCalculation scaleMethod,
         double trimAmount,
         const size_t stride)
 {
+    // Location and scale each select what they need, unless one of them has to sort the data anyway
+    if (stride == 1 && locationMethod != LOCATION_GASTWIRTH && !needsSortedData(scaleMethod))
+    {
+        double location = RobustStatistics::ComputeLocationInPlace(locationMethod, data, trimAmount, stride);
+        double scale = RobustStatistics::ComputeScaleInPlace(scaleMethod, data, stride);
+        double weight = RobustStatistics::ConvertScaleToWeight(scaleMethod, scale);
+        return RobustStatistics::SampleStatistics{location, scale, weight};
+    }
+
     std::sort(data.begin(), data.end());
     double location = RobustStatistics::ComputeLocationFromSortedData(locationMethod, data, trimAmount, stride);
     double scale = RobustStatistics::ComputeScaleFromSortedData(scaleMethod, data, stride);
@@ -35,6 +35,9 @@
 //                                    pairwise means. Implemented internally, not provided by GSL.
 //
 // Where necessary data is sorted by the routines and functionality to use a user selected array sride is included.
+// The median, trimmed mean, sigma clipping, MAD and biweight midvariance only need a few order statistics, so
+// the InPlace variants select them in linear time with std::nth_element rather than sorting the whole sample.
+// Sn, Qn and Pn need sorted data; ComputeApproximateScale estimates them from a bounded subsample instead.
 // C++ Templates are used to provide access to the GSL routines based on the datatype of the input data.
 
 #pragma once
@@ -122,18 +125,20 @@ struct ScaleEstimator //: public virtual Estimator<Base>
     virtual double EstimateScaleFromSortedData(const std::vector<Base> &data, const size_t stride = 1) = 0;
 };
 
+template<typename Base = double>
+double ComputeScaleInPlace(const ScaleCalculation scaleMethod, std::vector<Base> &data, const size_t stride = 1);
+
 template <typename Base = double>
 struct MAD : public virtual ScaleEstimator<Base>
 {
     virtual double EstimateScale(const std::vector<Base> &data, const size_t stride = 1) override
     {
-        auto const size = data.size();
-        auto work = std::make_unique<double[]>(size / stride);
-        return Mathematics::GSLHelpers::gslMAD(data.data(), stride, size, work.get());
+        auto copy = data;
+        return ComputeScaleInPlace(SCALE_MAD, copy, stride);
     }
     virtual double EstimateScale(std::vector<Base> data, const size_t stride = 1) override
     {
-        return EstimateScale(data, stride);
+        return ComputeScaleInPlace(SCALE_MAD, data, stride);
     }
     virtual double EstimateScaleFromSortedData(const std::vector<Base> &data, const size_t stride = 1) override
     {
@@ -284,6 +289,34 @@ struct StatisticalCoEstimator : public virtual LocationEstimator<Base>, public v
         }
 };
 
+/**
+ * @short Computes a estimate of the statistical scale of the input sample, reordering it rather than sorting a copy.
+ *
+ * MAD and the biweight midvariance select the medians they need in linear time. Sn, Qn and Pn sort the sample.
+ * With a stride other than 1 the sample is sorted whatever the estimator, as the stride applies AFTER sorting.
+ *
+ * @param scaleMethod The estimator to use.
+ * @param data The sample to estimate the scale of. Its elements are left in an unspecified order.
+ * @param stride The stide of the data.
+ */
+template<typename Base>
+double ComputeScaleInPlace(const ScaleCalculation scaleMethod, std::vector<Base> &data, const size_t stride);
+
+/**
+ * @short Computes a estimate of the statistical scale of a sample too large to sort cheaply.
+ *
+ * Sn, Qn and Pn are estimated from every k-th element of a sample of more than @p maxSamples elements, so that at
+ * most @p maxSamples of them have to be sorted. Their relative error is of order 1 / sqrt(maxSamples), about 2% for
+ * the default. The other estimators are exact, as with ComputeScaleInPlace().
+ *
+ * @param scaleMethod The estimator to use.
+ * @param data The sample to estimate the scale of. Its elements are left in an unspecified order.
+ * @param maxSamples The most elements Sn, Qn and Pn are computed from.
+ */
+template<typename Base = double>
+double ComputeApproximateScale(const ScaleCalculation scaleMethod, std::vector<Base> &data,
+                               const size_t maxSamples = 4096);
+
 /**
  * @short Computes a estimate of the statistical scale of the input sample.
  *
@@ -295,15 +328,29 @@ template<typename Base = double>
 double ComputeScale(const ScaleCalculation scaleMethod, std::vector<Base> data,
                     const size_t stride = 1)
 {
-    if (scaleMethod != SCALE_VARIANCE)
-        std::sort(data.begin(), data.end());
-    return ComputeScaleFromSortedData(scaleMethod, data, stride);
+    return ComputeScaleInPlace(scaleMethod, data, stride);
 }
 //[[using gnu : pure]]
 template<typename Base = double>
 double ComputeScaleFromSortedData(const ScaleCalculation scaleMethod,
                                   const std::vector<Base> &data,
                                   const size_t stride = 1);
+/**
+ * @short Computes a estimate of the statistical location of the input sample, reordering it rather than sorting a
+ * copy.
+ *
+ * The median, trimmed mean and sigma clipping select the order statistics they need in linear time. The Gastwirth
+ * estimator sorts the sample, as does any estimator but the mean with a stride other than 1.
+ *
+ * @param locationMethod The estimator to use.
+ * @param data The sample to estimate the location of. Its elements are left in an unspecified order.
+ * @param trimAmount As for ComputeLocation().
+ * @param stride The stide of the data.
+ */
+template<typename Base = double>
+double ComputeLocationInPlace(const LocationCalculation locationMethod, std::vector<Base> &data,
+                              const double trimAmount = 0.25, const size_t stride = 1);
+
 /**
  * @short Computes a estimate of the statistical location of the input sample.
  *
@@ -320,9 +367,7 @@ template<typename Base = double>
 double ComputeLocation(const LocationCalculation locationMethod, std::vector<Base> data,
                        const double trimAmount = 0.25, const size_t stride = 1)
 {
-    if (locationMethod != LOCATION_MEAN)
-        std::sort(data.begin(), data.end());
-    return ComputeLocationFromSortedData(locationMethod, data, trimAmount, stride);
+    return ComputeLocationInPlace(locationMethod, data, trimAmount, stride);
 }
 
 //[[using gnu : pure]]
@@ -342,9 +387,8 @@ double ComputeLocationFromSortedData(const LocationCalculation locationMethod,
 template<typename Base = double>
 double ComputeWeight(const ScaleCalculation scaleMethod, std::vector<Base> data, const size_t stride = 1)
 {
-    if (scaleMethod != SCALE_VARIANCE)
-        std::sort(data.begin(), data.end());
-    return ComputeWeightFromSortedData(scaleMethod, data, stride);
+    auto const scale = ComputeScaleInPlace(scaleMethod, data, stride);
+    return ConvertScaleToWeight(scaleMethod, scale);
 }
 //[[using gnu : pure]]
 template<typename Base = double>
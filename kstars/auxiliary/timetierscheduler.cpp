@@ -0,0 +1,51 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "timetierscheduler.h"
+
+#include <cmath>
+
+int TimeTierScheduler::addTier(const QString &name, const Resolution &resolution, const Update &update)
+{
+    Tier tier;
+    tier.name = name;
+    tier.resolution = resolution;
+    tier.update = update;
+    m_Tiers.append(tier);
+    return m_Tiers.size() - 1;
+}
+
+void TimeTierScheduler::addTrigger(int tier, int triggered)
+{
+    Q_ASSERT(triggered > tier && triggered < m_Tiers.size());
+    m_Tiers[tier].triggers.append(triggered);
+}
+
+int TimeTierScheduler::run(long double jd, KSNumbers *num)
+{
+    int updated = 0;
+    for (Tier &tier : m_Tiers)
+    {
+        if (!tier.due && std::abs(static_cast<double>(jd - tier.last)) <= tier.resolution())
+            continue;
+
+        tier.update(num);
+        tier.last = jd;
+        tier.due = false;
+        tier.runs++;
+        updated++;
+
+        for (int triggered : tier.triggers)
+            m_Tiers[triggered].due = true;
+    }
+    return updated;
+}
+
+void TimeTierScheduler::invalidate()
+{
+    for (Tier &tier : m_Tiers)
+        tier.due = true;
+}
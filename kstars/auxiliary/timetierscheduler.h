@@ -0,0 +1,76 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+class KSNumbers;
+
+/**
+ * @class TimeTierScheduler
+ * @short Runs the updates that depend on the simulation time only when they are due.
+ *
+ * Each tier declares the time resolution it needs, in days, and is updated once the simulation
+ * time moved further than that from its last update, forward or backward. Tiers run in the
+ * order they were added, coarse ones first, so that a tier may trigger a finer one that builds
+ * on it rather than both doing the same work.
+ */
+class TimeTierScheduler
+{
+    public:
+        /** @return the resolution in days, negative for a tier due at every run */
+        typedef std::function<double()> Resolution;
+        typedef std::function<void(KSNumbers *)> Update;
+
+        /** @brief addTier Add a tier after those there are, due at the first run. @return its index */
+        int addTier(const QString &name, const Resolution &resolution, const Update &update);
+
+        /** @brief addTrigger Run @p triggered, which must come after @p tier, whenever @p tier runs */
+        void addTrigger(int tier, int triggered);
+
+        /**
+         * @brief run Update the tiers that are due at @p jd
+         * @return the number of tiers that were updated
+         */
+        int run(long double jd, KSNumbers *num);
+
+        /** @brief invalidate Make all tiers due at the next run */
+        void invalidate();
+
+        int count() const
+        {
+            return m_Tiers.size();
+        }
+
+        const QString &name(int tier) const
+        {
+            return m_Tiers[tier].name;
+        }
+
+        /** @return how many times @p tier was updated */
+        quint64 runs(int tier) const
+        {
+            return m_Tiers[tier].runs;
+        }
+
+    private:
+        struct Tier
+        {
+            QString name;
+            Resolution resolution;
+            Update update;
+            QVector<int> triggers;
+            long double last { 0 };
+            bool due { true };
+            quint64 runs { 0 };
+        };
+
+        QVector<Tier> m_Tiers;
+};
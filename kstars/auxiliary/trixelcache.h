@@ -11,6 +11,7 @@
 #include <stdexcept>
 #include <vector>
 #include <list>
+#include <utility>
 
 /**
  * \brief A simple integer indexed elastically cached wrapper around
@@ -34,8 +35,8 @@
  *
  * When it is convenient `TrixelCache::prune()` may be called, which
  * clears the least recently used elements (by default initializing them)
- * until the number of elements does not exceed the cache size. This is
- * expensive relative to setting an elment which has almost no cost.
+ * until the number of elements does not exceed the cache size. Both
+ * are constant time per element and never allocate.
  *
  * \tparam content The content type to use. Most likely a QList,
  * `std::vector or std::list.`
@@ -112,6 +113,7 @@ class TrixelCache
             throw std::range_error("cache_size cannot exceet data_size");
 
         _data.resize(data_size);
+        reset_links();
     };
 
     /** Retrieve an element at \p index. */
@@ -133,20 +135,13 @@ class TrixelCache
         if (_noop)
             return;
 
-        remove_dublicate_indices();
-        const int delta =
-            _used_indices.size() - (keep > _cache_size ? keep : _cache_size);
-
-        if (delta <= 0)
-            return;
-
-        auto begin = _used_indices.begin();
-        std::advance(begin, delta);
-
-        std::for_each(begin, _used_indices.end(),
-                      [&](size_t index) { _data[index].reset(); });
-
-        _used_indices = {};
+        const size_t limit = keep > _cache_size ? keep : _cache_size;
+        while (_used_count > limit)
+        {
+            const size_t index = _links[head()].prev;
+            unlink(index);
+            _data[index].reset();
+        }
     }
 
     /**
@@ -166,18 +161,18 @@ class TrixelCache
     /** @return the size of the cache */
     size_t size() const { return _cache_size; };
 
-    /** @return the number of set elements in the cache, slow */
-    size_t current_usage()
-    {
-        remove_dublicate_indices();
-        return _used_indices.size();
-    };
+    /** @return the number of primed elements in the cache */
+    size_t current_usage() const { return _used_count; };
 
-    /** @return a list of currently primed indices, slow */
-    std::list<size_t> primed_indices()
+    /** @return a list of currently primed indices, most recently used first */
+    std::list<size_t> primed_indices() const
     {
-        remove_dublicate_indices();
-        return _used_indices;
+        std::list<size_t> indices;
+        for (size_t index = _links[head()].next; index != head();
+             index        = _links[index].next)
+            indices.push_back(index);
+
+        return indices;
     };
 
     /** @return wether the cache is just a wrapped vector */
@@ -189,27 +184,60 @@ class TrixelCache
         auto size = _data.size();
         std::vector<element>().swap(_data);
         _data.resize(size);
-        _used_indices.clear();
+        reset_links();
     }
 
   private:
+    /**
+     * The usage list is a doubly linked list threaded through `_links`,
+     * one link per element plus the list head at index `_data.size()`,
+     * so that touching an element never allocates.
+     */
+    struct link
+    {
+        size_t prev;
+        size_t next;
+        bool used;
+    };
+
     size_t _cache_size;
     bool _noop;
     std::vector<element> _data;
-    std::list<size_t> _used_indices;
+    std::vector<link> _links;
+    size_t _used_count{ 0 };
 
-    /** Add an index to the lru caching list */
-    void add_index(const size_t index) { _used_indices.push_front(index); }
+    size_t head() const { return _data.size(); }
 
-    void remove_dublicate_indices()
+    /** Move an index to the front of the lru list */
+    void add_index(const size_t index)
     {
-        std::vector<bool> found(_data.size(), false);
-        _used_indices.remove_if([&](size_t index) {
-            if (found[index])
-                return true;
-
-            found[index] = true;
-            return false;
-        });
-    };
+        if (_links[index].used)
+        {
+            if (_links[head()].next == index)
+                return;
+
+            unlink(index);
+        }
+
+        auto &first = _links[head()];
+        _links[index] = { head(), first.next, true };
+        _links[first.next].prev = index;
+        first.next              = index;
+        _used_count++;
+    }
+
+    void unlink(const size_t index)
+    {
+        auto &current = _links[index];
+        _links[current.prev].next = current.next;
+        _links[current.next].prev = current.prev;
+        current.used              = false;
+        _used_count--;
+    }
+
+    void reset_links()
+    {
+        std::vector<link>(_data.size() + 1, link{ head(), head(), false }).swap(_links);
+        _used_count = 0;
+    }
 };
@@ -6,13 +6,17 @@
 
 #include <limits>
 #include <cmath>
+#include <cstring>
 #include <QSqlDriver>
 #include <QSqlRecord>
 #include <QMutexLocker>
 #include <QTemporaryDir>
+#include <QSaveFile>
+#include <QtConcurrent>
 #include <qsqldatabase.h>
 #include "cachingdms.h"
 #include "catalogsdb.h"
+#include "catalogtiles.h"
 #include "kspaths.h"
 #include "skymesh.h"
 #include "Options.h"
@@ -168,6 +172,17 @@ DBManager::DBManager(const QString &filename) : m_db_file(filename)
         }
     }
 
+    // databases from before the full text index get it once
+    QSqlQuery fts_exists{ m_db };
+    fts_exists.exec(SqlStatements::exists_master_fts);
+    const bool fts_does_exist = fts_exists.next();
+    fts_exists.finish();
+
+    if (fts_does_exist)
+        prepare_fts_query();
+    else
+        compile_master_fts();
+
     m_q_cat_by_id         = make_query(m_db, SqlStatements::get_catalog_by_id, true);
     m_q_obj_by_trixel     = make_query(m_db, SqlStatements::dso_by_trixel, false);
     m_q_obj_by_trixel_no_nulls = make_query(m_db, SqlStatements::dso_by_trixel_no_nulls, false);
@@ -340,6 +355,7 @@ bool DBManager::compile_master_catalog()
     {
         m_db.commit();
     });
+    QFile::remove(tiles_file_name());
     QSqlQuery query{ m_db };
     m_db.transaction();
 
@@ -358,9 +374,43 @@ bool DBManager::compile_master_catalog()
     success &= query.exec(SqlStatements::create_master_mag_index);
     success &= query.exec(SqlStatements::create_master_type_index);
     success &= query.exec(SqlStatements::create_master_name_index);
+
+    // the search falls back to LIKE without it
+    compile_master_fts();
     return success;
 };
 
+bool DBManager::compile_master_fts()
+{
+    QSqlQuery query{ m_db };
+    if (!query.exec(SqlStatements::drop_master_fts) ||
+            !query.exec(SqlStatements::create_master_fts) ||
+            !query.exec(SqlStatements::rebuild_master_fts))
+    {
+        qCWarning(KSTARS_CATALOGS)
+                << "Could not build the full text index over the DSO names:"
+                << query.lastError().text();
+
+        m_has_fts = false;
+        return false;
+    }
+
+    return prepare_fts_query();
+}
+
+bool DBManager::prepare_fts_query()
+{
+    m_q_obj_by_name_fts = QSqlQuery{ m_db };
+    m_has_fts           = m_q_obj_by_name_fts.prepare(SqlStatements::dso_by_name_fts);
+
+    if (!m_has_fts)
+        qCWarning(KSTARS_CATALOGS)
+                << "No full text index over the DSO names, searching by substring:"
+                << m_q_obj_by_name_fts.lastError().text();
+
+    return m_has_fts;
+}
+
 const Catalog read_catalog(const QSqlQuery &query)
 {
     return { query.value("id").toInt(),
@@ -496,6 +546,29 @@ CatalogObjectList DBManager::fetch_objects(QSqlQuery &query) const
     return objects;
 }
 
+/**
+ * Turn the search term \p name into a FTS5 query matching each of its
+ * words as a prefix.
+ */
+QString fts_prefix_query(const QString &name)
+{
+    QStringList terms;
+    for (auto word : name.split(' ', Qt::SkipEmptyParts))
+    {
+        // words without any letters or digits would be an empty phrase
+        const auto is_word_char = [](const QChar & c)
+        {
+            return c.isLetterOrNumber();
+        };
+        if (std::none_of(word.cbegin(), word.cend(), is_word_char))
+            continue;
+
+        terms << QString("\"%1\"*").arg(word.replace('"', "\"\""));
+    }
+
+    return terms.join(' ');
+}
+
 CatalogObjectList DBManager::find_objects_by_name(const QString &name, const int limit,
         const bool exactMatchOnly)
 {
@@ -514,10 +587,24 @@ CatalogObjectList DBManager::find_objects_by_name(const QString &name, const int
 
     Q_ASSERT(objs.size() <= 1);
 
-    m_q_obj_by_name.bindValue(":name", name);
-    m_q_obj_by_name.bindValue(":limit", int(limit - objs.size()));
+    CatalogObjectList moreObjects;
+    const auto &match = fts_prefix_query(name);
+    if (m_has_fts && !match.isEmpty())
+    {
+        m_q_obj_by_name_fts.bindValue(":match", match);
+        m_q_obj_by_name_fts.bindValue(":name", name);
+        m_q_obj_by_name_fts.bindValue(":limit", int(limit - objs.size()));
+
+        moreObjects = fetch_objects(m_q_obj_by_name_fts);
+    }
+    else
+    {
+        m_q_obj_by_name.bindValue(":name", name);
+        m_q_obj_by_name.bindValue(":limit", int(limit - objs.size()));
+
+        moreObjects = fetch_objects(m_q_obj_by_name);
+    }
 
-    CatalogObjectList moreObjects = fetch_objects(m_q_obj_by_name);
     moreObjects.splice(moreObjects.begin(), objs);
     return moreObjects;
 
@@ -657,8 +744,6 @@ inline void bind_catalogobject(QSqlQuery &query, const int catalog_id,
                                const float flux, Trixel trixel,
                                const CatalogObject::oid &new_id)
 {
-    query.prepare(SqlStatements::insert_dso(catalog_id));
-
     query.bindValue(":hash", new_id); // no dedupe, maybe in the future
     query.bindValue(":oid", new_id);
     query.bindValue(":type", static_cast<int>(t));
@@ -712,6 +797,7 @@ DBManager::add_object(const int catalog_id, const SkyObject::TYPE t, const Cachi
     SkyPoint tmp{ r, d };
     const auto trixel = SkyMesh::Create(m_htmesh_level)->index(&tmp);
     QSqlQuery query{ m_db };
+    query.prepare(SqlStatements::insert_dso(catalog_id));
 
     const auto new_id =
         CatalogObject::getId(t, r.Degrees(), d.Degrees(), n, catalog_identifier);
@@ -1054,7 +1140,8 @@ DBManager::get_catalog_statistics(const int catalog_id)
 
 std::pair<bool, QString>
 CatalogsDB::DBManager::add_objects(const int catalog_id,
-                                   const CatalogObjectVector &objects)
+                                   const CatalogObjectVector &objects,
+                                   const std::function<void(int, int)> &progress)
 {
     {
         const auto &success = get_catalog(catalog_id);
@@ -1065,14 +1152,33 @@ CatalogsDB::DBManager::add_objects(const int catalog_id,
             return { false, i18n("Catalog is immutable!") };
     }
 
-    m_db.transaction();
-    QSqlQuery query{ m_db };
+    // indexing the objects is the expensive part besides sqlite
+    auto *mesh = SkyMesh::Create(m_htmesh_level);
+    std::vector<std::pair<const CatalogObject *, Trixel>> rows;
+    rows.reserve(objects.size());
     for (const auto &object : objects)
+        rows.emplace_back(&object, 0);
+
+    QtConcurrent::blockingMap(rows, [mesh](std::pair<const CatalogObject *, Trixel> &row)
     {
-        SkyPoint tmp{ object.ra(), object.dec() };
-        const auto trixel = SkyMesh::Create(m_htmesh_level)->index(&tmp);
+        SkyPoint tmp{ row.first->ra(), row.first->dec() };
+        row.second = mesh->index(&tmp);
+    });
+
+    constexpr size_t progress_interval = 10000;
+    const int total                    = rows.size();
+    if (progress)
+        progress(0, total);
+
+    // one statement and one transaction for all rows, the indices of
+    // the master catalog are built once afterwards
+    m_db.transaction();
+    QSqlQuery query{ m_db };
+    query.prepare(SqlStatements::insert_dso(catalog_id));
 
-        bind_catalogobject(query, catalog_id, object, trixel);
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        bind_catalogobject(query, catalog_id, *rows[i].first, rows[i].second);
 
         if (!query.exec())
         {
@@ -1080,10 +1186,17 @@ CatalogsDB::DBManager::add_objects(const int catalog_id,
             if (err.startsWith("UNIQUE"))
                 err = i18n("The object is already in the catalog!");
 
+            m_db.rollback();
             return { false, i18n("Could not insert object! %1", err) };
         }
+
+        if (progress && (i + 1) % progress_interval == 0)
+            progress(i + 1, total);
     }
 
+    if (progress)
+        progress(total, total);
+
     return { m_db.commit() &&update_catalog_views() &&compile_master_catalog(),
              m_db.lastError().text() };
 };
@@ -24,6 +24,7 @@
 
 #include <unordered_set>
 #include <utility>
+#include <functional>
 #include "catalogobject.h"
 #include "nan.h"
 #include "typedef.h"
@@ -122,6 +123,7 @@ struct CatalogStatistics
 };
 
 const QString db_file_extension = "kscat";
+const QString tiles_file_extension = "tiles";
 constexpr int application_id    = 0x4d515158;
 constexpr int custom_cat_min_id = 1000;
 constexpr int user_catalog_id   = 0;
@@ -207,6 +209,8 @@ class DBManager
         swap(m_q_obj_by_trixel_null_mag, other.m_q_obj_by_trixel_null_mag);
         swap(m_q_obj_by_name, other.m_q_obj_by_name);
         swap(m_q_obj_by_name_exact, other.m_q_obj_by_name_exact);
+        swap(m_q_obj_by_name_fts, other.m_q_obj_by_name_fts);
+        swap(m_has_fts, other.m_has_fts);
         swap(m_q_obj_by_lim, other.m_q_obj_by_lim);
         swap(m_q_obj_by_maglim, other.m_q_obj_by_maglim);
         swap(m_q_obj_by_maglim_and_type, other.m_q_obj_by_maglim_and_type);
@@ -279,6 +283,11 @@ class DBManager
      * limit"
      * \param exactMatchOnly If true, the supplied name must match exactly
      *
+     * If the full text index is available, the words of \p `name` are
+     * matched as prefixes of the words in those fields, with the names
+     * starting with \p `name` ranked first. Otherwise they are matched
+     * as substrings.
+     *
      * \return a list of matching objects
      */
     CatalogObjectList find_objects_by_name(const QString &name, const int limit = -1,
@@ -403,11 +412,17 @@ class DBManager
      * Add the \p `objects` to a table with \p `catalog_id`. For the
      * rest of the arguments see `CatalogObject::CatalogObject`.
      *
+     * The objects are inserted in a single transaction, which is rolled
+     * back if any of them fails. If given, \p `progress` is called
+     * with the number of inserted objects and their total every now and
+     * then.
+     *
      * \returns wether the operation was successful and if not, an
      * error message
      */
-    std::pair<bool, QString> add_objects(const int catalog_id,
-                                         const CatalogObjectVector &objects);
+    std::pair<bool, QString>
+    add_objects(const int catalog_id, const CatalogObjectVector &objects,
+                const std::function<void(int, int)> &progress = {});
 
     /**
      * Remove the catalog object with the \p `oid` from the catalog with the
@@ -510,10 +525,39 @@ class DBManager
      * the master table. **Caution** you may want to call
      * `update_catalog_views` beforhand.
      *
+     * The tile file, which would be stale afterwards, is removed.
+     *
      * @return true in case of success, false in case of an error
      */
     bool compile_master_catalog();
 
+    /**
+     * (Re)builds the full text index over the names of the master
+     * catalog.
+     *
+     * @return true in case of success, false if the index couldn't be
+     * built, e.g. because sqlite lacks FTS5
+     */
+    bool compile_master_fts();
+
+    /**
+     * Writes the master catalog into the memory mappable tile file
+     * under \p file_path (see `CatalogsDB::TileFile`), replacing it
+     * atomically if it exists.
+     *
+     * \returns wether the operation was successful and if not, an
+     * error message
+     */
+    std::pair<bool, QString> compile_tiles(const QString &file_path);
+
+    /**
+     * @return the path of the tile file belonging to the database
+     */
+    QString tiles_file_name() const
+    {
+        return QString("%1.%2").arg(m_db_file).arg(tiles_file_extension);
+    };
+
     /**
      * Updates the all_catalog_view so that it includes all known
      * catalogs.
@@ -572,6 +616,7 @@ class DBManager
     QSqlQuery m_q_obj_by_trixel_no_nulls;
     QSqlQuery m_q_obj_by_name;
     QSqlQuery m_q_obj_by_name_exact;
+    QSqlQuery m_q_obj_by_name_fts;
     QSqlQuery m_q_obj_by_lim;
     QSqlQuery m_q_obj_by_maglim;
     QSqlQuery m_q_obj_by_maglim_and_type;
@@ -597,6 +642,11 @@ class DBManager
      */
     int m_db_version = -1;
 
+    /**
+     * Wether the full text index over the object names is available.
+     */
+    bool m_has_fts = false;
+
     /**
      * A simple mutex to be locked when using prepared statements,
      * that are stored in the class.
@@ -669,6 +719,11 @@ class DBManager
      */
     CatalogObjectVector _get_objects_in_trixel_generic(QSqlQuery &query, const int trixel);
 
+    /**
+     * Prepares `m_q_obj_by_name_fts` and sets `m_has_fts` accordingly.
+     */
+    bool prepare_fts_query();
+
     //@}
 };
 
@@ -0,0 +1,149 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "catalogtiles.h"
+
+#include <cstring>
+
+using namespace CatalogsDB;
+
+std::pair<bool, QString> TileFile::open(const QString &file_path, const int htmesh_level,
+                                        const int master_count, const QString &db_file)
+{
+    close();
+
+    m_file.setFileName(file_path);
+    if (!m_file.open(QIODevice::ReadOnly))
+        return { false, m_file.errorString() };
+
+    m_size = m_file.size();
+    if (m_size < qint64(sizeof(Tiles::Header)))
+    {
+        m_file.close();
+        return { false, QString("Tile file '%1' is truncated.").arg(file_path) };
+    }
+
+    m_data = m_file.map(0, m_size);
+    if (m_data == nullptr)
+    {
+        const auto &error = m_file.errorString();
+        m_file.close();
+        return { false, error };
+    }
+
+    const auto &head          = header();
+    const quint64 index_end   = sizeof(Tiles::Header) + quint64(head.trixel_count) * sizeof(Tiles::Trixel);
+    const quint64 records_end = index_end + quint64(head.object_count) * sizeof(Tiles::Record);
+
+    QString error;
+    if (std::memcmp(head.magic, Tiles::magic, sizeof(Tiles::magic)) != 0 ||
+            head.byte_order != Tiles::byte_order)
+        error = QString("'%1' is not a tile file.").arg(file_path);
+    else if (head.version != Tiles::version)
+        error = QString("Tile file version %1 is not supported.").arg(head.version);
+    else if (head.htmesh_level != quint32(htmesh_level) ||
+             head.master_count != quint32(master_count))
+        error = QString("Tile file '%1' does not match the master catalog.").arg(file_path);
+    else if (head.trixel_count != quint32(8) << (2 * htmesh_level) ||
+             head.strings_offset < records_end ||
+             head.strings_offset + head.strings_size != quint64(m_size))
+        error = QString("Tile file '%1' is corrupt.").arg(file_path);
+
+    if (!error.isEmpty())
+    {
+        close();
+        return { false, error };
+    }
+
+    m_db_file = db_file;
+    return { true, "" };
+}
+
+void TileFile::close()
+{
+    if (m_data != nullptr)
+        m_file.unmap(const_cast<uchar *>(m_data));
+
+    m_file.close();
+    m_data = nullptr;
+    m_size = 0;
+}
+
+CatalogObjectVector TileFile::get_objects_in_trixel_no_nulls(const int trixel) const
+{
+    if (!is_open() || trixel < 0 || quint32(trixel) >= header().trixel_count)
+        return {};
+
+    const auto &entry = reinterpret_cast<const Tiles::Trixel *>(m_data + sizeof(Tiles::Header))[trixel];
+    return read_objects(entry.first, entry.known_mag_count);
+}
+
+CatalogObjectVector TileFile::get_objects_in_trixel_null_mag(const int trixel) const
+{
+    if (!is_open() || trixel < 0 || quint32(trixel) >= header().trixel_count)
+        return {};
+
+    const auto &entry = reinterpret_cast<const Tiles::Trixel *>(m_data + sizeof(Tiles::Header))[trixel];
+    return read_objects(entry.first + entry.known_mag_count, entry.null_mag_count);
+}
+
+CatalogObjectVector TileFile::read_objects(const quint32 first, const quint32 count) const
+{
+    CatalogObjectVector objects;
+    if (count == 0 || quint64(first) + count > header().object_count)
+        return objects;
+
+    const auto *records = reinterpret_cast<const Tiles::Record *>(
+                              m_data + sizeof(Tiles::Header) +
+                              quint64(header().trixel_count) * sizeof(Tiles::Trixel));
+
+    objects.reserve(count);
+    for (quint32 i = first; i < first + count; i++)
+    {
+        const auto &record = records[i];
+        objects.emplace_back(read_bytes(record.oid),
+                             static_cast<SkyObject::TYPE>(record.type), dms(record.ra),
+                             dms(record.dec), record.mag, read_string(record.name),
+                             read_string(record.long_name),
+                             read_string(record.catalog_identifier), record.catalog_id,
+                             record.major, record.minor, record.position_angle,
+                             record.flux, m_db_file);
+    }
+
+    return objects;
+}
+
+QString TileFile::read_string(const quint32 offset) const
+{
+    const auto &head = header();
+    if (quint64(offset) + sizeof(quint32) > head.strings_size)
+        return QString();
+
+    const uchar *entry = m_data + head.strings_offset + offset;
+    quint32 length;
+    std::memcpy(&length, entry, sizeof(length));
+
+    if (length == 0 || quint64(offset) + sizeof(quint32) + 2 * quint64(length) > head.strings_size)
+        return QString();
+
+    return QString(reinterpret_cast<const QChar *>(entry + sizeof(quint32)), length);
+}
+
+QByteArray TileFile::read_bytes(const quint32 offset) const
+{
+    const auto &head = header();
+    if (quint64(offset) + sizeof(quint32) > head.strings_size)
+        return QByteArray();
+
+    const uchar *entry = m_data + head.strings_offset + offset;
+    quint32 length;
+    std::memcpy(&length, entry, sizeof(length));
+
+    if (quint64(offset) + sizeof(quint32) + quint64(length) > head.strings_size)
+        return QByteArray();
+
+    return QByteArray(reinterpret_cast<const char *>(entry + sizeof(quint32)), length);
+}
@@ -0,0 +1,146 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+
+#include "catalogsdb.h"
+
+namespace CatalogsDB
+{
+/**
+ * The on-disk layout of a DSO tile file, as written by
+ * `DBManager::compile_tiles` and read by `TileFile`.
+ *
+ * The file starts with a `Header`, followed by one `Trixel` entry for
+ * each trixel of the mesh, the `Record`s of all objects grouped by
+ * trixel and finally the string table. Inside a trixel the objects of
+ * known magnitude come first, brightest first, followed by those of
+ * unknown magnitude. Strings are stored as a `quint32` length followed
+ * by that many UTF-16 code units (bytes for the object id), each entry
+ * aligned to four bytes.
+ *
+ * The file is written in host byte order and only ever read on the
+ * machine that compiled it.
+ */
+namespace Tiles
+{
+constexpr char magic[8]        = { 'K', 'S', 'D', 'S', 'O', 'T', 'I', 'L' };
+constexpr quint32 version      = 1;
+constexpr quint32 byte_order   = 0x01020304;
+
+struct Header
+{
+    char magic[8];
+    quint32 version;
+    quint32 byte_order;
+    quint32 htmesh_level;
+    quint32 trixel_count;
+    quint32 object_count;
+    quint32 master_count;
+    quint64 strings_offset;
+    quint64 strings_size;
+};
+static_assert(sizeof(Header) == 48, "tile header has to be packed");
+
+struct Trixel
+{
+    quint32 first;
+    quint32 known_mag_count;
+    quint32 null_mag_count;
+};
+static_assert(sizeof(Trixel) == 12, "tile index entry has to be packed");
+
+struct Record
+{
+    double ra;
+    double dec;
+    double position_angle;
+    float mag;
+    float major;
+    float minor;
+    float flux;
+    qint32 type;
+    qint32 catalog_id;
+    quint32 oid;
+    quint32 name;
+    quint32 long_name;
+    quint32 catalog_identifier;
+};
+static_assert(sizeof(Record) == 64, "tile record has to be packed");
+} // namespace Tiles
+
+/**
+ * A read-only, memory mapped view of a tile file.
+ *
+ * Reading the objects of a trixel from the mapping neither touches
+ * the database nor takes a lock, so that it is safe to do from
+ * several threads at once. The names are copied straight out of the
+ * string table, which is only paged in as far as the visible trixels
+ * require.
+ *
+ * A `TileFile` that failed to open or went stale is simply not open;
+ * the caller is expected to fall back to `DBManager`.
+ */
+class TileFile
+{
+  public:
+    TileFile() = default;
+    ~TileFile() { close(); }
+
+    TileFile(const TileFile &) = delete;
+    TileFile &operator=(const TileFile &) = delete;
+
+    /**
+     * Maps the tile file under \p file_path. It is only accepted if it
+     * was made for a mesh of \p htmesh_level from a master catalog of
+     * \p master_count objects, i.e. the current one. The objects read
+     * from it are attributed to the database \p db_file.
+     *
+     * \returns wether the file could be opened and an error message
+     * if not
+     */
+    std::pair<bool, QString> open(const QString &file_path, const int htmesh_level,
+                                  const int master_count, const QString &db_file);
+
+    /**
+     * Unmaps the file.
+     */
+    void close();
+
+    bool is_open() const { return m_data != nullptr; }
+
+    /**
+     * @return the objects of known magnitude in \p trixel, brightest
+     * first, like `DBManager::get_objects_in_trixel_no_nulls`.
+     */
+    CatalogObjectVector get_objects_in_trixel_no_nulls(const int trixel) const;
+
+    /**
+     * @return the objects of unknown magnitude in \p trixel, like
+     * `DBManager::get_objects_in_trixel_null_mag`.
+     */
+    CatalogObjectVector get_objects_in_trixel_null_mag(const int trixel) const;
+
+  private:
+    QFile m_file;
+    const uchar *m_data = nullptr;
+    qint64 m_size       = 0;
+    QString m_db_file;
+
+    const Tiles::Header &header() const
+    {
+        return *reinterpret_cast<const Tiles::Header *>(m_data);
+    }
+
+    CatalogObjectVector read_objects(const quint32 first, const quint32 count) const;
+    QString read_string(const quint32 offset) const;
+    QByteArray read_bytes(const quint32 offset) const;
+};
+} // namespace CatalogsDB
@@ -312,6 +312,15 @@ const QString exists_catalog_by_id = "SELECT 1 FROM catalogs WHERE id = :id";
 const QString exists_master =
     "SELECT name FROM sqlite_master WHERE type='table' AND name='master';";
 
+/* full text search over the names in the master catalog, rebuilt with it */
+const QString drop_master_fts = "DROP TABLE IF EXISTS master_fts";
+const QString create_master_fts =
+    "CREATE VIRTUAL TABLE master_fts USING fts5(name, long_name, catalog_identifier, "
+    "content='master', prefix='1 2 3', tokenize='unicode61 remove_diacritics 2')";
+const QString rebuild_master_fts = "INSERT INTO master_fts(master_fts) VALUES('rebuild')";
+const QString exists_master_fts =
+    "SELECT name FROM sqlite_master WHERE type='table' AND name='master_fts';";
+
 /* DSO queries */
 const QString _dso_by_catalog = QString("SELECT %1 FROM cat_%2").arg(catalog_fields);
 inline const QString dso_by_catalog(int catalog_id)
@@ -335,6 +344,11 @@ const QString _dso_by_trixel_no_nulls = "SELECT %1 FROM master WHERE trixel = "
                                         " BY magnitude DESC";
 const QString dso_by_trixel_no_nulls = QString(_dso_by_trixel_no_nulls).arg(object_fields);
 
+// The objects in the order of the tile file, the trixel being the last column.
+const QString _dso_for_tiles = "SELECT %1, trixel FROM master ORDER BY trixel ASC, "
+                               "magnitude IS NULL, magnitude ASC";
+const QString dso_for_tiles  = QString(_dso_for_tiles).arg(object_fields);
+
 const QString _dso_by_oid = "SELECT %1 FROM master WHERE oid = :id LIMIT 1";
 
 const QString dso_by_oid = QString(_dso_by_oid).arg(object_fields);
@@ -355,8 +369,19 @@ const QString _dso_by_name =
 
 const QString _dso_by_name_exact = "SELECT %1 FROM master WHERE name = :name LIMIT 1";
 
+// names starting with the search term first, the shortest of those
+// being the closest match, then by relevance
+const QString _dso_by_name_fts =
+    "SELECT %1 FROM master_fts JOIN master ON master.rowid = master_fts.rowid "
+    "WHERE master_fts MATCH :match ORDER BY master.name LIKE :name || \"%\" DESC, "
+    "length(master.name), master_fts.rank, master.%2 LIMIT :limit";
+
 const QString dso_by_name       = QString(_dso_by_name).arg(object_fields).arg(mag_asc);
 const QString dso_by_name_exact = QString(_dso_by_name_exact).arg(object_fields);
+const QString dso_by_name_fts =
+    QString(_dso_by_name_fts)
+    .arg(create_field_list(dso_query_fields.begin(), dso_query_fields.end(), "master."))
+    .arg(mag_asc);
 
 inline const QString dso_by_name_and_catalog(const int id)
 {
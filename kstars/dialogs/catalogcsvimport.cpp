@@ -13,6 +13,7 @@
 #include <QLabel>
 #include <QComboBox>
 #include <QFormLayout>
+#include <QtConcurrent>
 
 /**
  * Maps the name of the field to a tuple [Tooltip, Unit, Can be ignored?]
@@ -298,7 +299,6 @@ void CatalogCSVImport::read_n_objects(size_t n)
     const CatalogObject defaults{};
 
     m_objects.clear();
-    m_objects.reserve(std::min(m_doc.GetRowCount(), n));
 
     //  pure magic, it's like LISP macros
     const auto make_getter = [this, &column_map](const QString &field, auto def) {
@@ -383,26 +383,49 @@ void CatalogCSVImport::read_n_objects(size_t n)
     const auto get_pa         = make_getter("Position Angle", defaults.pa());
     const auto get_flux       = make_getter("Flux", defaults.flux());
 
-    for (size_t i = 0; i < std::min(m_doc.GetRowCount(), n); i++)
+    // The document is only read, so the rows are converted in chunks
+    // concurrently and concatenated in order.
+    struct chunk
     {
-        const auto &raw_type = get_type(i);
-
-        const auto type = parse_type(raw_type, type_map);
-
-        const auto ra         = get_ra(i);
-        const auto dec        = get_dec(i);
-        const auto mag        = get_mag(i);
-        const auto name       = get_name(i);
-        const auto long_name  = get_long_name(i);
-        const auto identifier = get_identifier(i);
-        const auto a          = get_a(i);
-        const auto b          = get_b(i);
-        const auto pa         = get_pa(i);
-        const auto flux       = get_flux(i);
-
-        m_objects.emplace_back(CatalogObject::oid{}, type, ra, dec, mag, name, long_name,
-                               identifier, -1, a, b, pa, flux);
-    }
+        size_t begin;
+        size_t end;
+        std::vector<CatalogObject> objects;
+    };
+
+    constexpr size_t chunk_size = 10000;
+    const size_t row_count      = std::min(m_doc.GetRowCount(), n);
+    std::vector<chunk> chunks;
+    for (size_t begin = 0; begin < row_count; begin += chunk_size)
+        chunks.push_back({ begin, std::min(row_count, begin + chunk_size), {} });
+
+    QtConcurrent::blockingMap(chunks, [&](chunk & part)
+    {
+        part.objects.reserve(part.end - part.begin);
+        for (size_t i = part.begin; i < part.end; i++)
+        {
+            const auto &raw_type = get_type(i);
+
+            const auto type = parse_type(raw_type, type_map);
+
+            const auto ra         = get_ra(i);
+            const auto dec        = get_dec(i);
+            const auto mag        = get_mag(i);
+            const auto name       = get_name(i);
+            const auto long_name  = get_long_name(i);
+            const auto identifier = get_identifier(i);
+            const auto a          = get_a(i);
+            const auto b          = get_b(i);
+            const auto pa         = get_pa(i);
+            const auto flux       = get_flux(i);
+
+            part.objects.emplace_back(CatalogObject::oid{}, type, ra, dec, mag, name,
+                                      long_name, identifier, -1, a, b, pa, flux);
+        }
+    });
+
+    m_objects.reserve(row_count);
+    for (auto &part : chunks)
+        std::move(part.objects.begin(), part.objects.end(), std::back_inserter(m_objects));
 };
 
 SkyObject::TYPE CatalogCSVImport::parse_type(const std::string &type,
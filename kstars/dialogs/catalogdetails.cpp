@@ -5,6 +5,7 @@
 */
 
 #include <QMessageBox>
+#include <QProgressDialog>
 #include "catalogdetails.h"
 #include "detaildialog.h"
 #include "kstarsdata.h"
@@ -207,7 +208,18 @@ void CatalogDetails::import_csv()
     if (dialog.exec() != QDialog::Accepted)
         return;
 
-    const auto &success_add = m_manager.add_objects(m_catalog.id, dialog.get_objects());
+    const auto &objects = dialog.get_objects();
+    QProgressDialog progressDlg(i18n("Importing objects..."), QString(), 0, objects.size(),
+                                this);
+    progressDlg.setWindowModality(Qt::WindowModal);
+    progressDlg.setMinimumDuration(500);
+
+    const auto &success_add =
+        m_manager.add_objects(m_catalog.id, objects, [&](int done, int total)
+    {
+        progressDlg.setMaximum(total);
+        progressDlg.setValue(done);
+    });
 
     if (!success_add.first)
         QMessageBox::warning(this, i18n("Warning"),
@@ -13,8 +13,11 @@
 #include "detaildialog.h"
 #include "skymap.h"
 #include "skyobjects/skyobject.h"
+#include "skycomponents/asteroidscomponent.h"
+#include "skycomponents/cometscomponent.h"
 #include "skycomponents/starcomponent.h"
 #include "skycomponents/skymapcomposite.h"
+#include "skycomponents/solarsystemcomposite.h"
 #include "tools/nameresolver.h"
 #include "skyobjectlistmodel.h"
 #include "catalogscomponent.h"
@@ -228,7 +231,14 @@ void FindDialog::filterByType()
 {
     KStarsData *data = KStarsData::Instance();
 
-    switch (ui->FilterType->currentIndex())
+    // Comets and asteroids are only read once they are needed
+    const int filter = ui->FilterType->currentIndex();
+    if (filter == 0 || filter == 2 || filter == 8)
+        data->skyComposite()->solarSystemComposite()->cometsComponent()->loadDataIfNeeded();
+    if (filter == 0 || filter == 2 || filter == 9)
+        data->skyComposite()->solarSystemComposite()->asteroidsComponent()->loadDataIfNeeded();
+
+    switch (filter)
     {
         case 0: // All object types
         {
@@ -462,22 +472,24 @@ void FindDialog::slotResolve()
 
 CatalogObject *FindDialog::resolveAndAdd(CatalogsDB::DBManager &db_manager, const QString &query)
 {
-    CatalogObject *dso = nullptr;
     const auto &cedata = NameResolver::resolveName(query);
+    if (!cedata.first)
+        return nullptr;
+    return addResolved(db_manager, cedata.second);
+}
 
-    if (cedata.first)
-    {
-        db_manager.add_object(CatalogsDB::user_catalog_id, cedata.second);
-        const auto &added_object =
-            db_manager.get_object(cedata.second.getId(), CatalogsDB::user_catalog_id);
+CatalogObject *FindDialog::addResolved(CatalogsDB::DBManager &db_manager, const CatalogObject &object)
+{
+    CatalogObject *dso = nullptr;
+    db_manager.add_object(CatalogsDB::user_catalog_id, object);
+    const auto &added_object = db_manager.get_object(object.getId(), CatalogsDB::user_catalog_id);
 
-        if (added_object.first)
-        {
-            dso = &KStarsData::Instance()
-                  ->skyComposite()
-                  ->catalogsComponent()
-                  ->insertStaticObject(added_object.second);
-        }
+    if (added_object.first)
+    {
+        dso = &KStarsData::Instance()
+              ->skyComposite()
+              ->catalogsComponent()
+              ->insertStaticObject(added_object.second);
     }
     return dso;
 }
@@ -75,6 +75,13 @@ class FindDialog : public QDialog
      */
     static CatalogObject *resolveAndAdd(CatalogsDB::DBManager &db_manager, const QString &query);
 
+    /**
+     * @short Adds an object resolved using the internet to the database
+     * @note Can only be called when KStars is fully initialized
+     * @return a pointer to the DeepSkyObject (instance managed by internetResolvedComponent) if successful, nullptr otherwise
+     */
+    static CatalogObject *addResolved(CatalogsDB::DBManager &db_manager, const CatalogObject &object);
+
   public slots:
     /**
      * When Text is entered in the QLineEdit, filter the List of objects
@@ -15,6 +15,9 @@
 
 #include <QSqlQuery>
 
+#include <algorithm>
+#include <numeric>
+
 #ifdef HAVE_GEOCLUE2
 #include <QGeoPositionInfoSource>
 #endif
@@ -124,9 +127,6 @@ void LocationDialog::initCityList()
     KStarsData *data = KStarsData::Instance();
     foreach (GeoLocation *loc, data->getGeoList())
     {
-        ld->GeoBox->addItem(loc->fullName());
-        filteredCityList.append(loc);
-
         //If TZ is not an even integer value, add it to listbox
         if (loc->TZ0() - int(loc->TZ0()) && ld->TZBox->findText(QLocale().toString(loc->TZ0())) != -1)
         {
@@ -141,11 +141,10 @@ void LocationDialog::initCityList()
         }
     }
 
-    //Sort the list of Cities alphabetically...note that filteredCityList may now have a different ordering!
-    ld->GeoBox->sortItems();
-
-    ld->CountLabel->setText(
-        i18np("One city matches search criteria", "%1 cities match search criteria", ld->GeoBox->count()));
+    buildCityIndex();
+    QVector<int> entries(cityIndex.size());
+    std::iota(entries.begin(), entries.end(), 0);
+    showCities(entries);
 
     // attempt to highlight the current kstars location in the GeoBox
     ld->GeoBox->setCurrentItem(nullptr);
@@ -159,6 +158,52 @@ void LocationDialog::initCityList()
     }
 }
 
+void LocationDialog::buildCityIndex()
+{
+    const QList<GeoLocation *> &locations = KStarsData::Instance()->getGeoList();
+    cityIndex.clear();
+    cityIndex.reserve(locations.size());
+    for (GeoLocation *loc : locations)
+    {
+        CityEntry entry;
+        entry.city     = loc->translatedName().toCaseFolded();
+        entry.province = loc->province().isEmpty() ? QString() : loc->translatedProvince().toCaseFolded();
+        entry.country  = loc->translatedCountry().toCaseFolded();
+        entry.fullName = loc->fullName();
+        entry.location = loc;
+        cityIndex.append(entry);
+    }
+    std::sort(cityIndex.begin(), cityIndex.end(), [](const CityEntry & a, const CityEntry & b)
+    {
+        return a.city < b.city;
+    });
+}
+
+void LocationDialog::showCities(QVector<int> entries)
+{
+    std::sort(entries.begin(), entries.end(), [this](int a, int b)
+    {
+        return cityIndex[a].fullName < cityIndex[b].fullName;
+    });
+
+    //Do NOT delete members of filteredCityList!
+    filteredCityList.clear();
+    QStringList names;
+    names.reserve(entries.size());
+    for (int i : entries)
+    {
+        names.append(cityIndex[i].fullName);
+        filteredCityList.append(cityIndex[i].location);
+    }
+
+    // The list and filteredCityList are in the same order, changeCity() relies on it
+    ld->GeoBox->clear();
+    ld->GeoBox->addItems(names);
+
+    ld->CountLabel->setText(
+        i18np("One city matches search criteria", "%1 cities match search criteria", ld->GeoBox->count()));
+}
+
 void LocationDialog::enqueueFilterCity()
 {
     if (timer)
@@ -174,38 +219,27 @@ void LocationDialog::enqueueFilterCity()
 
 void LocationDialog::filterCity()
 {
-    KStarsData *data = KStarsData::Instance();
-    ld->GeoBox->clear();
-    //Do NOT delete members of filteredCityList!
-    while (!filteredCityList.isEmpty())
-        filteredCityList.takeFirst();
-
     nameModified = false;
     dataModified = false;
     ld->AddCityButton->setEnabled(false);
     ld->UpdateButton->setEnabled(false);
 
-    foreach (GeoLocation *loc, data->getGeoList())
+    const QString city     = ld->CityFilter->text().toCaseFolded();
+    const QString province = ld->ProvinceFilter->text().toCaseFolded();
+    const QString country  = ld->CountryFilter->text().toCaseFolded();
+
+    // The cities starting with the city filter follow each other in the index
+    auto it = std::lower_bound(cityIndex.cbegin(), cityIndex.cend(), city, [](const CityEntry & entry, const QString & key)
     {
-        QString sc(loc->translatedName());
-        QString ss(loc->translatedCountry());
-        QString sp = "";
-        if (!loc->province().isEmpty())
-            sp = loc->translatedProvince();
-
-        if (sc.startsWith(ld->CityFilter->text(), Qt::CaseInsensitive) &&
-                sp.startsWith(ld->ProvinceFilter->text(), Qt::CaseInsensitive) &&
-                ss.startsWith(ld->CountryFilter->text(), Qt::CaseInsensitive))
-        {
-            ld->GeoBox->addItem(loc->fullName());
-            filteredCityList.append(loc);
-        }
+        return entry.city < key;
+    });
+    QVector<int> entries;
+    for (; it != cityIndex.cend() && it->city.startsWith(city); ++it)
+    {
+        if (it->province.startsWith(province) && it->country.startsWith(country))
+            entries.append(it - cityIndex.cbegin());
     }
-
-    ld->GeoBox->sortItems();
-
-    ld->CountLabel->setText(
-        i18np("One city matches search criteria", "%1 cities match search criteria", ld->GeoBox->count()));
+    showCities(entries);
 
     if (ld->GeoBox->count() > 0) // set first item in list as selected
         ld->GeoBox->setCurrentItem(ld->GeoBox->item(0));
@@ -219,17 +253,9 @@ void LocationDialog::changeCity()
 
     //when the selected city changes, set newCity, and redraw map
     SelectedCity = nullptr;
-    if (ld->GeoBox->currentItem())
-    {
-        for (auto &loc : filteredCityList)
-        {
-            if (loc->fullName() == ld->GeoBox->currentItem()->text())
-            {
-                SelectedCity = loc;
-                break;
-            }
-        }
-    }
+    const int row = ld->GeoBox->currentItem() ? ld->GeoBox->currentRow() : -1;
+    if (row >= 0 && row < filteredCityList.size())
+        SelectedCity = filteredCityList.at(row);
 
     ld->MapView->repaint();
 
@@ -469,6 +495,7 @@ bool LocationDialog::updateCity(CityOperation operation)
     }
 
     //(possibly) insert new city into GeoBox by running filterCity()
+    buildCityIndex();
     filterCity();
 
     //Attempt to highlight new city in list
@@ -493,25 +520,15 @@ bool LocationDialog::updateCity(CityOperation operation)
 
 void LocationDialog::findCitiesNear(int lng, int lat)
 {
-    KStarsData *data = KStarsData::Instance();
     //find all cities within 3 degrees of (lng, lat); list them in GeoBox
-    ld->GeoBox->clear();
-    //Remember, do NOT delete members of filteredCityList
-    while (!filteredCityList.isEmpty())
-        filteredCityList.takeFirst();
-
-    foreach (GeoLocation *loc, data->getGeoList())
+    QVector<int> entries;
+    for (int i = 0; i < cityIndex.size(); i++)
     {
+        const GeoLocation *loc = cityIndex[i].location;
         if ((abs(lng - int(loc->lng()->Degrees())) < 3) && (abs(lat - int(loc->lat()->Degrees())) < 3))
-        {
-            ld->GeoBox->addItem(loc->fullName());
-            filteredCityList.append(loc);
-        }
+            entries.append(i);
     }
-
-    ld->GeoBox->sortItems();
-    ld->CountLabel->setText(
-        i18np("One city matches search criteria", "%1 cities match search criteria", ld->GeoBox->count()));
+    showCities(entries);
 
     if (ld->GeoBox->count() > 0) // set first item in list as selected
         ld->GeoBox->setCurrentItem(ld->GeoBox->item(0));
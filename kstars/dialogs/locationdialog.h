@@ -16,6 +16,7 @@
 #endif
 #include <QDialog>
 #include <QList>
+#include <QVector>
 
 class QTimer;
 class QNetworkAccessManager;
@@ -177,6 +178,24 @@ protected slots:
     /** Make sure Longitude and Latitude values are valid. */
     bool checkLongLat();
 
+    /** Index the locations of KStarsData for filterCity(), again whenever they change. */
+    void buildCityIndex();
+
+    /** Show the cities of the index at @p entries, sorted by name, in the city list. */
+    void showCities(QVector<int> entries);
+
+    // The names a location is filtered and listed by, translated. The filters compare their case folded forms.
+    struct CityEntry
+    {
+        QString city;
+        QString province;
+        QString country;
+        QString fullName;
+        GeoLocation *location { nullptr };
+    };
+    // Sorted by city for a binary search of the city filter
+    QVector<CityEntry> cityIndex;
+
     bool dataModified { false };
     bool nameModified { false };
 
@@ -31,6 +31,7 @@
 // Auxiliary
 #include "auxiliary/QProgressIndicator.h"
 #include "auxiliary/ksmessagebox.h"
+#include "auxiliary/kstrace.h"
 #include "ekos/auxiliary/darkprocessor.h"
 #include "ekos/auxiliary/filtermanager.h"
 #include "ekos/auxiliary/stellarsolverprofileeditor.h"
@@ -45,6 +46,7 @@
 #include "kstarsdata.h"
 #include "skymapcomposite.h"
 #include "ekos/auxiliary/solverutils.h"
+#include "ekos/auxiliary/solverindexcache.h"
 #include "ekos/auxiliary/rotatorutils.h"
 
 // INDI
@@ -511,6 +513,7 @@ void Align::slotMountModel()
             abort();
         });
         connect(this, &Ekos::Align::newStatus, m_MountModel, &Ekos::MountModel::setAlignStatus, Qt::UniqueConnection);
+        connect(this, &Ekos::Align::newImage, m_MountModel, &Ekos::MountModel::setImageCaptured, Qt::UniqueConnection);
     }
 
     m_MountModel->show();
@@ -691,6 +694,9 @@ bool Align::setMount(ISD::Mount *device)
         m_Mount->disconnect(this);
 
     m_Mount = device;
+    // Pointing errors of another mount say nothing about this one
+    m_PointingErrors.clear();
+    m_IndexToUse = m_HealpixToUse = -1;
 
     if (m_Mount)
     {
@@ -1405,6 +1411,7 @@ QStringList Align::generateRemoteArgs(const QSharedPointer<FITSData> &data)
 // Initialization is activated through the predefined argument "initialCall = true".
 bool Align::captureAndSolve(bool initialCall)
 {
+    KSTRACE_SCOPE("align", "captureAndSolve");
     // Set target to current telescope position,if no object is selected yet.
     if (m_TargetCoord.ra().degree() < 0) // see default constructor skypoint()
     {
@@ -1683,6 +1690,7 @@ bool Align::captureAndSolve(bool initialCall)
 
 void Align::processData(const QSharedPointer<FITSData> &data)
 {
+    KSTRACE_SCOPE("align", "processData");
     auto chip = data->property("chip");
     if (chip.isValid() && chip.toInt() == ISD::CameraChip::GUIDE_CCD)
         return;
@@ -1804,6 +1812,8 @@ void Align::setSolverAction(int mode)
 
 void Align::startSolving()
 {
+    KSTRACE_SCOPE("align", "startSolving");
+    KSTrace::Instance()->asyncBegin("align", "Solve");
     //RUN_PAH(syncStage());
 
     // This is needed because they might have directories stored in the config file.
@@ -1813,6 +1823,7 @@ void Align::startSolving()
 
     m_UsedScale = false;
     m_UsedPosition = false;
+    m_NarrowedSearch = false;
     m_ScaleUsed = 0;
     m_RAUsed = 0;
     m_DECUsed = 0;
@@ -1969,6 +1980,30 @@ void Align::startSolving()
                 m_UsedPosition = true;
                 m_RAUsed = m_TelescopeCoord.ra().Degrees();
                 m_DECUsed = m_TelescopeCoord.dec().Degrees();
+
+                // Recent solves tell how far off the mount is, no need to search much further
+                const double radius = pointingSearchRadius();
+                if (radius > 0 && radius < params.search_radius && matchPAHStage(PAA::PAH_IDLE))
+                {
+                    params.search_radius = radius;
+                    m_StellarSolver->setParameters(params);
+                    m_NarrowedSearch = true;
+                    appendLogText(i18n("Searching within %1 degrees of the mount position.", QString::number(radius, 'f', 2)));
+
+                    // Close to the last solution, the index that solved it most likely solves this one too
+                    const SkyPoint lastSolution(m_LastSolutionRA / 15.0, m_LastSolutionDEC);
+                    const dms distance = SkyPoint(m_RAUsed / 15.0, m_DECUsed).angularDistanceTo(&lastSolution);
+                    if (type == SSolver::SOLVER_STELLARSOLVER && m_IndexToUse >= 0 && distance.Degrees() < radius)
+                    {
+                        const QStringList indexFiles = StellarSolver::getIndexFiles(Options::astrometryIndexFolderList(),
+                                                       m_IndexToUse, m_HealpixToUse);
+                        if (indexFiles.isEmpty() == false)
+                        {
+                            m_StellarSolver->setIndexFilePaths(indexFiles);
+                            SolverIndexCache::Instance()->retain(indexFiles);
+                        }
+                    }
+                }
             }
             else
                 m_StellarSolver->setProperty("UsePosition", false);
@@ -2050,12 +2085,41 @@ void Align::solverComplete()
     {
         FITSImage::Solution solution = m_StellarSolver->getSolution();
         const bool eastToTheRight = solution.parity == FITSImage::POSITIVE ? false : true;
+        if (m_UsedPosition && !m_SolveFromFile)
+            recordPointingError(solution.ra, solution.dec);
+        SolverIndexCache::Instance()->retainSolution(*m_StellarSolver);
         solverFinished(solution.orientation, solution.ra, solution.dec, solution.pixscale, eastToTheRight);
     }
 }
 
+void Align::recordPointingError(double ra, double dec)
+{
+    const SkyPoint used(m_RAUsed / 15.0, m_DECUsed);
+    const SkyPoint solved(ra / 15.0, dec);
+    m_PointingErrors.append(solved.angularDistanceTo(&used).Degrees());
+    if (m_PointingErrors.size() > MAX_POINTING_ERRORS)
+        m_PointingErrors.removeFirst();
+
+    m_LastSolutionRA = ra;
+    m_LastSolutionDEC = dec;
+    m_IndexToUse = m_StellarSolver->getSolutionIndexNumber();
+    m_HealpixToUse = m_StellarSolver->getSolutionHealpix();
+}
+
+double Align::pointingSearchRadius() const
+{
+    if (m_PointingErrors.size() < MIN_POINTING_ERRORS)
+        return -1;
+
+    // Leave room for the error to grow, but don't go below a degree
+    const double worst = *std::max_element(m_PointingErrors.cbegin(), m_PointingErrors.cend());
+    return std::max(1.0, 3 * worst);
+}
+
 void Align::solverFinished(double orientation, double ra, double dec, double pixscale, bool eastToTheRight)
 {
+    KSTRACE_SCOPE("align", "solverFinished");
+    KSTrace::Instance()->asyncEnd("align", "Solve");
     pi->stopAnimation();
     stopB->setEnabled(false);
     solveB->setEnabled(true);
@@ -2336,6 +2400,8 @@ void Align::solverFinished(double orientation, double ra, double dec, double pix
 
 void Align::solverFailed()
 {
+    KSTrace::Instance()->asyncEnd("align", "Solve");
+    KSTrace::Instance()->instant("align", "Solver failed");
 
     // If failed-align logging is enabled, let's save the frame.
     if (Options::saveFailedAlignImages())
@@ -2364,8 +2430,22 @@ void Align::solverFailed()
     }
     if (state != ALIGN_ABORTED)
     {
+        // The mount already left for the next target, so the image cannot be taken again
+        const bool canRetry = !m_SlewAhead;
+
+        // The narrowed search may have missed, try the profile settings before dropping any constraint
+        if (canRetry && m_NarrowedSearch)
+        {
+            appendLogText(i18n("Solver failed. Retrying with the full search radius."));
+            m_PointingErrors.clear();
+            m_IndexToUse = m_HealpixToUse = -1;
+            setAlignTableResult(ALIGN_RESULT_FAILED);
+            captureAndSolve(false);
+            return;
+        }
+
         // Try to solve with scale turned off, if not turned off already
-        if (Options::astrometryUseImageScale() && useBlindScale == BLIND_IDLE)
+        if (canRetry && Options::astrometryUseImageScale() && useBlindScale == BLIND_IDLE)
         {
             appendLogText(i18n("Solver failed. Retrying without scale constraint."));
             useBlindScale = BLIND_ENGAGNED;
@@ -2375,7 +2455,7 @@ void Align::solverFailed()
         }
 
         // Try to solve with the position turned off, if not turned off already
-        if (Options::astrometryUsePosition() && useBlindPosition == BLIND_IDLE)
+        if (canRetry && Options::astrometryUsePosition() && useBlindPosition == BLIND_IDLE)
         {
             appendLogText(i18n("Solver failed. Retrying without position constraint."));
             useBlindPosition = BLIND_ENGAGNED;
@@ -2497,6 +2577,7 @@ bool Align::checkIfRotationRequired()
 void Align::stop(Ekos::AlignState mode)
 {
     m_CaptureTimer.stop();
+    m_SlewAhead = false;
     if (solverModeButtonGroup->checkedId() == SOLVER_LOCAL)
         m_StellarSolver->abort();
     else if (solverModeButtonGroup->checkedId() == SOLVER_REMOTE && remoteParser)
@@ -2869,6 +2950,10 @@ void Align::updateProperty(INDI::Property prop)
 
 void Align::handleMountMotion()
 {
+    // Expected, the image being solved was taken before the mount left
+    if (m_SlewAhead)
+        return;
+
     if (state == ALIGN_PROGRESS)
     {
         if (matchPAHStage(PAA::PAH_IDLE))
@@ -2937,6 +3022,17 @@ void Align::Slew()
     setState(ALIGN_SLEWING);
     emit newStatus(state);
 
+    // The mount is already on its way, or there
+    if (m_SlewAhead)
+    {
+        m_SlewAhead = false;
+        appendLogText(i18n("Waiting for the mount to reach target coordinates: RA (%1) DEC (%2).",
+                           m_TargetCoord.ra().toHMSString(), m_TargetCoord.dec().toDMSString()));
+        if (!m_Mount->isSlewing())
+            handleMountStatus();
+        return;
+    }
+
     //qCDebug(KSTARS_EKOS_ALIGN) << "## Before SLEW command: wasSlewStarted -->" << m_wasSlewStarted;
     //m_wasSlewStarted = currentTelescope->Slew(&m_targetCoord);
     //qCDebug(KSTARS_EKOS_ALIGN) << "## After SLEW command: wasSlewStarted -->" << m_wasSlewStarted;
@@ -2961,6 +3057,22 @@ void Align::Slew()
     }
 }
 
+bool Align::slewAhead(const SkyPoint &target)
+{
+    if (state != ALIGN_PROGRESS || !matchPAHStage(PAA::PAH_IDLE) || m_Mount == nullptr || !m_Mount->isConnected())
+        return false;
+
+    SkyPoint next = target;
+    if (!m_Mount->Slew(&next))
+        return false;
+
+    m_SlewAhead = true;
+    slewStartTimer.start();
+    appendLogText(i18n("Slewing to next target coordinates: RA (%1) DEC (%2) while solving.",
+                       next.ra().toHMSString(), next.dec().toDMSString()));
+    return true;
+}
+
 void Align::SlewToTarget()
 {
     if (canSync && !m_SolveFromFile)
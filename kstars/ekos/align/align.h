@@ -302,6 +302,14 @@ class Align : public QWidget, public Ui::Align
              */
         void Slew();
 
+        /**
+         * @brief slewAhead Start slewing to the next target once the current image is captured, while it is still solved.
+         * The following Slew() then waits for this slew instead of starting another.
+         * @param target coordinates of the next target
+         * @return true if the mount started slewing
+         */
+        bool slewAhead(const SkyPoint &target);
+
         /**
              * @brief Sync the telescope to the solved alignment coordinate, and then slew to the target coordinate.
              */
@@ -488,6 +496,18 @@ class Align : public QWidget, public Ui::Align
              */
         void solverFailed();
 
+        /**
+         * @brief recordPointingError Remember how far the mount position used as the search hint was from
+         * the solution, and which index solved it.
+         */
+        void recordPointingError(double ra, double dec);
+
+        /**
+         * @brief pointingSearchRadius Search radius the recent pointing errors call for.
+         * @return radius in degrees, or -1 if there are too few recent solves to tell.
+         */
+        double pointingSearchRadius() const;
+
         /**
              * @brief We received new telescope info, process them and update FOV.
              */
@@ -800,6 +820,8 @@ class Align : public QWidget, public Ui::Align
 
         /// Have we slewed?
         bool m_wasSlewStarted { false };
+        // The mount left for the next target while the last image is solved, see slewAhead().
+        bool m_SlewAhead { false };
         // Above flag only stays false for 10s after slew start.
         QElapsedTimer slewStartTimer;
         bool didSlewStart();
@@ -937,5 +959,18 @@ class Align : public QWidget, public Ui::Align
         double m_ScaleUsed = 0;
         double m_RAUsed = 0;
         double m_DECUsed = 0;
+
+        // Distance in degrees of the recent solutions from the mount positions they were searched at
+        QVector<double> m_PointingErrors;
+        // Last solution and the index file that solved it, to preselect that index for solves nearby
+        double m_LastSolutionRA = 0;
+        double m_LastSolutionDEC = 0;
+        int m_IndexToUse = -1;
+        int m_HealpixToUse = -1;
+        // Solver searched a smaller radius or fewer indexes than the profile asks for
+        bool m_NarrowedSearch = false;
+        // Number of recent pointing errors kept, and needed to narrow the search
+        static const uint8_t MAX_POINTING_ERRORS = 10;
+        static const uint8_t MIN_POINTING_ERRORS = 3;
 };
 }
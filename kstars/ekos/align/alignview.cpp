@@ -43,7 +43,10 @@ bool AlignView::injectWCS(double orientation, double ra, double dec, double pixs
         if (wcsWatcher.isRunning() == false && m_ImageData->getWCSState() == FITSData::Idle)
         {
             // Load WCS async
-            QFuture<bool> future = QtConcurrent::run(m_ImageData.data(), &FITSData::loadWCS);
+            QFuture<bool> future = ProcessingLanes::run(ProcessingLanes::DISPLAY, [data = m_ImageData.data()]()
+            {
+                return data->loadWCS();
+            });
             wcsWatcher.setFuture(future);
         }
         return true;
@@ -967,6 +967,7 @@ void MountModel::resetAlignmentProcedure()
         QIcon::fromTheme("media-playback-start"));
     m_IsRunning     = false;
     currentAlignmentPoint = 0;
+    m_SlewAheadPoint = -1;
     emit aborted();
 }
 
@@ -1022,6 +1023,7 @@ void MountModel::startStopAlignmentProcedure()
                     statusReport->setIcon(QIcon());
                     alignTable->setItem(row, 3, statusReport);
                 }
+                m_PointingModel.clear();
             }
             startAlignB->setIcon(
                 QIcon::fromTheme("media-playback-pause"));
@@ -1038,6 +1040,7 @@ void MountModel::startStopAlignmentProcedure()
         emit newLog(i18n("The Mount Model Tool is Paused."));
         emit aborted();
         m_IsRunning = false;
+        m_SlewAheadPoint = -1;
 
         QTableWidgetItem *statusReport = new QTableWidgetItem();
         statusReport->setFlags(Qt::ItemIsSelectable);
@@ -1050,26 +1053,52 @@ void MountModel::startAlignmentPoint()
 {
     if (m_IsRunning && currentAlignmentPoint >= 0 && currentAlignmentPoint < alignTable->rowCount())
     {
-        QTableWidgetItem *raCell = alignTable->item(currentAlignmentPoint, 0);
-        QString raString         = raCell->text();
-        dms raDMS                = dms::fromString(raString, false);
-        double raDeg             = raDMS.Degrees();
-
-        QTableWidgetItem *decCell = alignTable->item(currentAlignmentPoint, 1);
-        QString decString         = decCell->text();
-        dms decDMS                = dms::fromString(decString, true);
-        double dec                = decDMS.Degrees();
-
         QProgressIndicator *alignIndicator = new QProgressIndicator(this);
         alignTable->setCellWidget(currentAlignmentPoint, 3, alignIndicator);
         alignIndicator->startAnimation();
 
-        const SkyObject *target = getWizardAlignObject(raDeg, dec);
-        m_AlignInstance->setTarget(*target);
+        // The mount may already be on its way here
+        if (m_SlewAheadPoint == currentAlignmentPoint)
+            m_PointTarget = m_NextTarget;
+        else
+            m_PointTarget = alignmentPointTarget(currentAlignmentPoint);
+        m_SlewAheadPoint = -1;
+
+        m_AlignInstance->setTarget(m_PointTarget);
         m_AlignInstance->Slew();
     }
 }
 
+SkyPoint MountModel::alignmentPointTarget(int row)
+{
+    dms ra  = dms::fromString(alignTable->item(row, 0)->text(), false);
+    dms dec = dms::fromString(alignTable->item(row, 1)->text(), true);
+
+    const SkyObject *object = getWizardAlignObject(ra.Degrees(), dec.Degrees());
+    if (object)
+        return *object;
+
+    // Fixed points are not tied to an object
+    SkyPoint target(ra, dec);
+    target.updateCoordsNow(KStarsData::Instance()->updateNum());
+    return target;
+}
+
+void MountModel::setImageCaptured()
+{
+    // Syncing needs the mount to stay where the image was taken until it is solved
+    if (!m_IsRunning || m_AlignInstance->currentGOTOMode() != Align::GOTO_NOTHING || m_SlewAheadPoint >= 0)
+        return;
+
+    const int next = currentAlignmentPoint + 1;
+    if (next >= alignTable->rowCount())
+        return;
+
+    m_NextTarget = alignmentPointTarget(next);
+    if (m_AlignInstance->slewAhead(m_NextTarget))
+        m_SlewAheadPoint = next;
+}
+
 void MountModel::finishAlignmentPoint(bool solverSucceeded)
 {
     if (m_IsRunning && currentAlignmentPoint >= 0 && currentAlignmentPoint < alignTable->rowCount())
@@ -1083,6 +1112,14 @@ void MountModel::finishAlignmentPoint(bool solverSucceeded)
             statusReport->setIcon(QIcon(":/icons/AlignFailure.svg"));
         alignTable->setItem(currentAlignmentPoint, 3, statusReport);
 
+        if (solverSucceeded && m_AlignInstance->currentGOTOMode() == Align::GOTO_NOTHING)
+        {
+            const QList<double> solution = m_AlignInstance->getSolutionResult();
+            SkyPoint solved(dms(solution[1]), dms(solution[2]));
+            solved.apparentCoord(static_cast<long double>(J2000), KStarsData::Instance()->ut().djd());
+            m_PointingModel.addPoint(m_PointTarget, solved, *KStarsData::Instance()->lst());
+        }
+
         currentAlignmentPoint++;
 
         if (currentAlignmentPoint < alignTable->rowCount())
@@ -1095,11 +1132,34 @@ void MountModel::finishAlignmentPoint(bool solverSucceeded)
             startAlignB->setIcon(
                 QIcon::fromTheme("media-playback-start"));
             emit newLog(i18n("The Mount Model Tool is Finished."));
+            reportPointingModel();
             currentAlignmentPoint = 0;
         }
     }
 }
 
+void MountModel::reportPointingModel()
+{
+    if (m_PointingModel.size() == 0)
+        return;
+
+    if (!m_PointingModel.fit())
+    {
+        emit newLog(i18n("The pointing model could not be fitted to %1 points. Spread the points wider in hour angle and declination.",
+                         m_PointingModel.size()));
+        return;
+    }
+
+    QStringList terms;
+    for (int i = 0; i < PointingModel::TERMS; i++)
+    {
+        const auto term = static_cast<PointingModel::Term>(i);
+        terms << QString("%1 %2\"").arg(PointingModel::termName(term)).arg(m_PointingModel.term(term), 0, 'f', 1);
+    }
+    emit newLog(i18n("Pointing model of %1 points: %2. RMS error left by the model: %3 arcsec.", m_PointingModel.size(),
+                     terms.join(", "), QString::number(m_PointingModel.rms(), 'f', 1)));
+}
+
 void MountModel::setAlignStatus(Ekos::AlignState state)
 {
     switch (state)
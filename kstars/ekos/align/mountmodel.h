@@ -9,6 +9,7 @@
 
 #include "ui_mountmodel.h"
 #include "ekos/ekos.h"
+#include "pointingmodel.h"
 #include "skypoint.h"
 
 #include <QDialog>
@@ -52,6 +53,12 @@ class MountModel : public QDialog, public Ui::mountModel
 
         void setAlignStatus(Ekos::AlignState state);
 
+        /**
+         * @brief setImageCaptured When only reporting errors, start slewing to the next point while the image just
+         * captured is solved.
+         */
+        void setImageCaptured();
+
     protected:
         void slotWizardAlignmentPoints();
         void slotStarSelected(const QString selectedStar);
@@ -88,6 +95,8 @@ class MountModel : public QDialog, public Ui::mountModel
         int findNextAlignmentPointAfter(int currentSpot);
         int findClosestAlignmentPointToTelescope();
         void swapAlignPoints(int firstPt, int secondPt);
+        SkyPoint alignmentPointTarget(int row);
+        void reportPointingModel();
 
         /**
              * @brief Get formatted RA & DEC coordinates compatible with astrometry.net format.
@@ -112,6 +121,12 @@ class MountModel : public QDialog, public Ui::mountModel
         QUrl alignURL;
         SkyPoint telescopeCoord;
 
+        // Target of the current point, and of the next one if the mount already slews there
+        SkyPoint m_PointTarget, m_NextTarget;
+        int m_SlewAheadPoint { -1 };
+        // Errors of the points of a report only run
+        PointingModel m_PointingModel;
+
 
 };
 }
@@ -0,0 +1,149 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "pointingmodel.h"
+
+#include "dms.h"
+#include "skypoint.h"
+
+#include <KLocalizedString>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+void PointingModel::addPoint(const SkyPoint &mount, const SkyPoint &solved, const dms &lst)
+{
+    Point point;
+    point.ha = (lst - mount.ra()).radians();
+    point.dec = mount.dec().radians();
+    // The hour angles share the sidereal time, so their difference is that of the right ascensions
+    point.dHa = solved.ra().deltaAngle(mount.ra()).Degrees() * 3600;
+    point.dDec = mount.dec().deltaAngle(solved.dec()).Degrees() * 3600;
+    m_Points.append(point);
+}
+
+void PointingModel::clear()
+{
+    m_Points.clear();
+    for (int i = 0; i < TERMS; i++)
+        m_Terms[i] = 0;
+    m_RMS = 0;
+}
+
+void PointingModel::equations(const Point &point, double hRow[TERMS], double dRow[TERMS])
+{
+    const double sinH = std::sin(point.ha), cosH = std::cos(point.ha);
+    const double sinD = std::sin(point.dec), cosD = std::cos(point.dec);
+
+    // dH = IH + CH sec(d) + NP tan(d) - MA cos(h) tan(d) + ME sin(h) tan(d), times cos(d) so it is on the sky
+    hRow[IH] = cosD;
+    hRow[ID] = 0;
+    hRow[CH] = 1;
+    hRow[NP] = sinD;
+    hRow[MA] = -cosH * sinD;
+    hRow[ME] = sinH * sinD;
+
+    // dD = ID + MA sin(h) + ME cos(h)
+    dRow[IH] = 0;
+    dRow[ID] = 1;
+    dRow[CH] = 0;
+    dRow[NP] = 0;
+    dRow[MA] = sinH;
+    dRow[ME] = cosH;
+}
+
+bool PointingModel::fit()
+{
+    if (m_Points.size() < MIN_POINTS)
+        return false;
+
+    // Accumulate the normal equations of all points, the right hand side is the last column
+    double n[TERMS][TERMS + 1] = {};
+    for (const auto &point : m_Points)
+    {
+        double hRow[TERMS], dRow[TERMS];
+        equations(point, hRow, dRow);
+        const double h = point.dHa * std::cos(point.dec);
+        for (int i = 0; i < TERMS; i++)
+        {
+            for (int j = 0; j < TERMS; j++)
+                n[i][j] += hRow[i] * hRow[j] + dRow[i] * dRow[j];
+            n[i][TERMS] += hRow[i] * h + dRow[i] * point.dDec;
+        }
+    }
+
+    double largest = 0;
+    for (int i = 0; i < TERMS; i++)
+        largest = std::max(largest, n[i][i]);
+
+    // Gauss-Jordan elimination with partial pivoting
+    for (int col = 0; col < TERMS; col++)
+    {
+        int pivot = col;
+        for (int row = col + 1; row < TERMS; row++)
+            if (std::fabs(n[row][col]) > std::fabs(n[pivot][col]))
+                pivot = row;
+
+        // The points do not separate this term from the others
+        if (std::fabs(n[pivot][col]) < 1e-9 * largest)
+            return false;
+
+        if (pivot != col)
+            for (int j = 0; j <= TERMS; j++)
+                std::swap(n[col][j], n[pivot][j]);
+
+        for (int row = 0; row < TERMS; row++)
+        {
+            if (row == col)
+                continue;
+            const double f = n[row][col] / n[col][col];
+            for (int j = col; j <= TERMS; j++)
+                n[row][j] -= f * n[col][j];
+        }
+    }
+
+    for (int i = 0; i < TERMS; i++)
+        m_Terms[i] = n[i][TERMS] / n[i][i];
+
+    double sum = 0;
+    for (const auto &point : m_Points)
+    {
+        double hRow[TERMS], dRow[TERMS];
+        equations(point, hRow, dRow);
+        double h = point.dHa * std::cos(point.dec), d = point.dDec;
+        for (int i = 0; i < TERMS; i++)
+        {
+            h -= hRow[i] * m_Terms[i];
+            d -= dRow[i] * m_Terms[i];
+        }
+        sum += h * h + d * d;
+    }
+    m_RMS = std::sqrt(sum / m_Points.size());
+
+    return true;
+}
+
+QString PointingModel::termName(Term t)
+{
+    switch (t)
+    {
+        case IH:
+            return i18nc("pointing model term, index error in hour angle", "IH");
+        case ID:
+            return i18nc("pointing model term, index error in declination", "ID");
+        case CH:
+            return i18nc("pointing model term, collimation error", "CH");
+        case NP:
+            return i18nc("pointing model term, axes non-perpendicularity", "NP");
+        case MA:
+            return i18nc("pointing model term, polar axis misalignment in azimuth", "MA");
+        case ME:
+            return i18nc("pointing model term, polar axis misalignment in elevation", "ME");
+        default:
+            return QString();
+    }
+}
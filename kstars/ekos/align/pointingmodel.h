@@ -0,0 +1,93 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+class dms;
+class SkyPoint;
+
+/**
+ *@class PointingModel
+ *@short PointingModel fits the basic equatorial pointing terms to the errors of a set of alignment points.
+ *
+ * Each point pairs the position the mount reports with the position solved from its image.
+ * The six terms, index errors in hour angle and declination, collimation, non-perpendicularity
+ * of the axes and the polar axis misalignment in azimuth and elevation, are fitted to all points
+ * at once by linear least squares. All terms are in arcseconds, in the sense of the mount's
+ * reading minus the sky position.
+ */
+class PointingModel
+{
+    public:
+        typedef enum
+        {
+            IH,
+            ID,
+            CH,
+            NP,
+            MA,
+            ME,
+            TERMS
+        } Term;
+
+        /// At least this many points are needed for a fit
+        static const int MIN_POINTS = 4;
+
+        ///
+        /// \brief addPoint adds an alignment point
+        /// \param mount JNow position reported by the mount
+        /// \param solved JNow position solved from the image taken there
+        /// \param lst local sidereal time the image was taken at
+        ///
+        void addPoint(const SkyPoint &mount, const SkyPoint &solved, const dms &lst);
+
+        void clear();
+
+        int size() const
+        {
+            return m_Points.size();
+        }
+
+        ///
+        /// \brief fit fits the terms to the points added so far
+        /// \return false if there are too few points, or they do not tell the terms apart
+        ///
+        bool fit();
+
+        /// \return the fitted term in arcseconds
+        double term(Term t) const
+        {
+            return m_Terms[t];
+        }
+
+        /// \return the RMS on sky of the errors the fitted terms leave, in arcseconds
+        double rms() const
+        {
+            return m_RMS;
+        }
+
+        /// \return the usual short name of the term, e.g. "IH"
+        static QString termName(Term t);
+
+    private:
+        typedef struct
+        {
+            // Hour angle and declination in radians
+            double ha, dec;
+            // Errors in hour angle and declination in arcseconds
+            double dHa, dDec;
+        } Point;
+
+        // Fills the coefficients of the hour angle (scaled to the sky) and declination equations of a point
+        static void equations(const Point &point, double hRow[TERMS], double dRow[TERMS]);
+
+        QVector<Point> m_Points;
+        double m_Terms[TERMS] {};
+        double m_RMS { 0 };
+};
@@ -336,7 +336,8 @@ void PolarAlignmentAssistant::drawArrows(double azError, double altError)
     arrowAz->setPixmap(azPixmap);
 }
 
-bool PolarAlignmentAssistant::detectStarsPAHRefresh(QList<Edge> *stars, int num, int x, int y, int *starIndex)
+bool PolarAlignmentAssistant::detectStarsPAHRefresh(QList<Edge> *stars, int num, int x, int y, int *starIndex,
+        const QRect &box)
 {
     stars->clear();
     *starIndex = -1;
@@ -348,7 +349,9 @@ bool PolarAlignmentAssistant::detectStarsPAHRefresh(QList<Edge> *stars, int num,
     m_ImageData->setSourceExtractorSettings(settings);
 
     QElapsedTimer timer;
-    m_ImageData->findStars(ALGORITHM_SEP).waitForFinished();
+    timer.start();
+    // Searching just the box keeps refresh up with the camera, the star positions are still those of the full image.
+    m_ImageData->findStars(ALGORITHM_SEP, box).waitForFinished();
 
     QString debugString = QString("PAA Refresh: Detected %1 stars (%2s)")
                           .arg(m_ImageData->getStarCenters().size()).arg(timer.elapsed() / 1000.0, 5, 'f', 3);
@@ -441,7 +444,7 @@ void PolarAlignmentAssistant::processPAHRefresh()
         // the stars haven't moved and we can just use the location of the click.
         // Later we'll need to find the star with starCorrespondence.
         int clickedStarIndex;
-        detectStarsPAHRefresh(&stars, 100, correctionFrom.x(), correctionFrom.y(), &clickedStarIndex);
+        detectStarsPAHRefresh(&stars, 100, correctionFrom.x(), correctionFrom.y(), &clickedStarIndex, m_RefreshBox);
         if (clickedStarIndex < 0)
         {
             debugString = QString("PAA Refresh(%1): Didn't find the clicked star near %2,%3")
@@ -470,10 +473,14 @@ void PolarAlignmentAssistant::processPAHRefresh()
             {
                 // First iteration. Setup starCorrespondence so we can find the user's star.
                 // clickedStarIndex should be the index of a detected star near where the user clicked.
-                starCorrespondencePAH.initialize(stars, clickedStarIndex);
                 if (clickedStarIndex >= 0)
                 {
                     setupCorrectionGraphics(QPointF(stars[clickedStarIndex].x, stars[clickedStarIndex].y));
+                    setupRefreshBox(&stars, &clickedStarIndex, MIN_PAH_REFRESH_STARS);
+                }
+                starCorrespondencePAH.initialize(stars, clickedStarIndex);
+                if (clickedStarIndex >= 0)
+                {
                     emit newCorrectionVector(QLineF(correctionFrom, correctionTo));
                     emit newFrame(m_AlignView);
                 }
@@ -542,6 +549,8 @@ void PolarAlignmentAssistant::processPAHRefresh()
                 {
                     debugString = QString("PAA Refresh(%1): Didn't find the user's star").arg(refreshIteration);
                     qCDebug(KSTARS_EKOS_ALIGN) << debugString;
+                    // The star may have left the box, look at the whole image from now on.
+                    m_RefreshBox = QRect();
                 }
             }
         }
@@ -549,6 +558,7 @@ void PolarAlignmentAssistant::processPAHRefresh()
         {
             debugString = QString("PAA Refresh(%1): Too few stars detected (%2)").arg(refreshIteration).arg(stars.size());
             qCDebug(KSTARS_EKOS_ALIGN) << debugString;
+            m_RefreshBox = QRect();
             emit updatedErrorsChanged(-1, -1, -1);
         }
     }
@@ -909,6 +919,50 @@ void PolarAlignmentAssistant::setupCorrectionGraphics(const QPointF &pixel)
 }
 
 
+void PolarAlignmentAssistant::setupRefreshBox(QList<Edge> *stars, int *starIndex, int minStars)
+{
+    // Stars within this many pixels of the user's path from correctionFrom to correctionTo are kept.
+    constexpr int REFRESH_BOX_MARGIN = 300;
+
+    m_RefreshBox = QRect();
+    if (*starIndex < 0 || *starIndex >= stars->size() || m_ImageData.isNull())
+        return;
+
+    // The whole field moves along with the user's star as the mount is adjusted,
+    // so the reference stars around its path stay in the box.
+    const QRect image(0, 0, m_ImageData->width(), m_ImageData->height());
+    const QRect box = QRectF(correctionFrom, correctionTo).normalized().toAlignedRect()
+                      .adjusted(-REFRESH_BOX_MARGIN, -REFRESH_BOX_MARGIN, REFRESH_BOX_MARGIN, REFRESH_BOX_MARGIN)
+                      .intersected(image);
+
+    // Not worth it if most of the image would be searched anyway.
+    if (2LL * box.width() * box.height() > static_cast<qint64>(image.width()) * image.height())
+        return;
+
+    QList<Edge> boxStars;
+    int boxIndex = -1;
+    for (int i = 0; i < stars->size(); i++)
+    {
+        const Edge &star = (*stars)[i];
+        if (!box.contains(QPoint(star.x, star.y)))
+            continue;
+        if (i == *starIndex)
+            boxIndex = boxStars.size();
+        boxStars.append(star);
+    }
+    if (boxIndex < 0 || boxStars.size() <= minStars)
+        return;
+
+    QString debugString = QString("PAA Refresh: Searching %1x%2 at %3,%4 with %5 of %6 stars")
+                          .arg(box.width()).arg(box.height()).arg(box.x()).arg(box.y())
+                          .arg(boxStars.size()).arg(stars->size());
+    qCDebug(KSTARS_EKOS_ALIGN) << debugString;
+
+    *stars = boxStars;
+    *starIndex = boxIndex;
+    m_RefreshBox = box;
+}
+
 bool PolarAlignmentAssistant::calculatePAHError()
 {
     // Hold on to the imageData so we can use it during the refresh phase.
@@ -1025,6 +1079,7 @@ void PolarAlignmentAssistant::startPAHRefreshProcess()
 
     refreshIteration = 0;
     imageNumber = 0;
+    m_RefreshBox = QRect();
     m_NumHealpixFailures = 0;
 
     setPAHStage(PAH_REFRESH);
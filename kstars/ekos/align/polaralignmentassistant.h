@@ -236,13 +236,18 @@ class PolarAlignmentAssistant : public QWidget, public Ui::PolarAlignmentAssista
         SkyPoint refreshSolution, altOnlyRefreshSolution;
 
 
-        bool detectStarsPAHRefresh(QList<Edge> *stars, int num, int x, int y, int *xyIndex);
+        bool detectStarsPAHRefresh(QList<Edge> *stars, int num, int x, int y, int *xyIndex, const QRect &box = QRect());
+        // Limit the stars of the first refresh image to those around the path of the user's star,
+        // and keep the region so later refresh images are only searched there.
+        void setupRefreshBox(QList<Edge> *stars, int *starIndex, int minStars);
 
         // Incremented every time sufficient # of stars are detected (for move-star refresh) or
         // when solver is successful (for plate-solve refresh).
         int refreshIteration { 0 };
         // Incremented on every image received.
         int imageNumber { 0 };
+        // Region of the refresh images searched for stars, the whole image if empty.
+        QRect m_RefreshBox;
         StarCorrespondence starCorrespondencePAH;
 
         // Class used to estimate alignment error.
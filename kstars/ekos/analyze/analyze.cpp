@@ -9,6 +9,7 @@
 #include <KNotifications/KNotification>
 #include <QDateTime>
 #include <QShortcut>
+#include <QtConcurrent>
 #include <QtGlobal>
 #include <QColor>
 
@@ -827,6 +828,37 @@ void Analyze::addMountCoords(double ra, double dec, double az,
     statsPlot->graph(PIER_SIDE_GRAPH)->addData(time, double(pierSide));
 }
 
+namespace
+{
+// Size of the blocks of a .analyze file read and split ahead of processing.
+constexpr qint64 ANALYZE_READ_BLOCK_SIZE = 4 * 1024 * 1024;
+
+// Read the next block of complete lines from file, split into their comma-separated components.
+QVector<QStringList> readInputBlock(QFile *file)
+{
+    QVector<QStringList> lines;
+    QByteArray block = file->read(ANALYZE_READ_BLOCK_SIZE);
+    // Finish the last line of the block
+    if (!file->atEnd())
+        block += file->readLine();
+
+    int start = 0;
+    while (start < block.size())
+    {
+        int end = block.indexOf('\n', start);
+        if (end < 0)
+            end = block.size();
+        int length = end - start;
+        if (length > 0 && block[start + length - 1] == '\r')
+            length--;
+        if (length > 0)
+            lines.append(QString::fromUtf8(block.constData() + start, length).split(QLatin1Char(',')));
+        start = end + 1;
+    }
+    return lines;
+}
+}
+
 // Read a .analyze file, and setup all the graphics.
 double Analyze::readDataFromFile(const QString &filename)
 {
@@ -834,25 +866,35 @@ double Analyze::readDataFromFile(const QString &filename)
     QFile inputFile(filename);
     if (inputFile.open(QIODevice::ReadOnly))
     {
-        QTextStream in(&inputFile);
-        while (!in.atEnd())
+        // Reading and splitting the lines is done on the thread pool, a block ahead of the
+        // graphs being built here from the previous block. The file is only accessed by
+        // one reader at a time, as the next block is requested once the previous one is done.
+        QFuture<QVector<QStringList>> nextBlock = QtConcurrent::run(readInputBlock, &inputFile);
+        while (true)
         {
-            QString line = in.readLine();
-            double time = processInputLine(line);
-            if (time > lastTime)
-                lastTime = time;
+            const QVector<QStringList> lines = nextBlock.result();
+            const bool done = inputFile.atEnd();
+            if (!done)
+                nextBlock = QtConcurrent::run(readInputBlock, &inputFile);
+
+            for (const auto &line : lines)
+            {
+                double time = processInputLine(line);
+                if (time > lastTime)
+                    lastTime = time;
+            }
+            if (done)
+                break;
         }
         inputFile.close();
     }
     return lastTime;
 }
 
-// Process an input line read from a .analyze file.
-double Analyze::processInputLine(const QString &line)
+// Process an input line read from a .analyze file, already split into its comma-separated components.
+double Analyze::processInputLine(const QStringList &list)
 {
     bool ok;
-    // Break the line into comma-separated components
-    QStringList list = line.split(QLatin1Char(','));
     // We need at least a command and a timestamp
     if (list.size() < 2)
         return 0;
@@ -1818,6 +1860,10 @@ void Analyze::replot(bool adjustSlider)
 
     statsPlot->xAxis->setRange(plotStart, plotStart + plotWidth);
 
+    // Draw the stats graphs, rescaling included, from their decimated data. The full data
+    // is restored once drawn, for the value boxes and other readers of the graph data.
+    decimateStatsGraphs();
+
     // Rescale any automatic y-axes.
     if (statsPlot->isVisible())
     {
@@ -1853,6 +1899,9 @@ void Analyze::replot(bool adjustSlider)
             statsPlot->replot();
         }
     }
+
+    restoreStatsGraphs();
+
     updateStatsValues();
 }
 
@@ -1870,12 +1919,28 @@ void Analyze::statsYZoom(double zoomAmount)
 void Analyze::statsYZoomIn()
 {
     statsYZoom(0.80);
+    decimateStatsGraphs();
     statsPlot->replot();
+    restoreStatsGraphs();
 }
 void Analyze::statsYZoomOut()
 {
     statsYZoom(1.25);
+    decimateStatsGraphs();
     statsPlot->replot();
+    restoreStatsGraphs();
+}
+
+void Analyze::decimateStatsGraphs()
+{
+    for (auto &decimator : statsDecimators)
+        decimator.decimate(statsPlot->xAxis->range(), statsPlot->axisRect()->width());
+}
+
+void Analyze::restoreStatsGraphs()
+{
+    for (auto &decimator : statsDecimators)
+        decimator.restore();
 }
 
 namespace
@@ -2453,6 +2518,11 @@ void Analyze::initStatsPlot()
     PIER_SIDE_GRAPH = initGraphAndCB(statsPlot, pierSideAxis, QCPGraph::lsLine, Qt::darkRed, "Mount Pier Side", shortName,
                                      pierSideCB, Options::setAnalyzePierSide, pierSideOut);
 
+    // Long sessions are drawn from min/max decimated copies of the graphs, see replot().
+    statsDecimators.clear();
+    for (int i = 0; i < statsPlot->graphCount(); ++i)
+        statsDecimators.emplace_back(statsPlot->graph(i));
+
     // This makes mouseMove only get called when a button is pressed.
     statsPlot->setMouseTracking(false);
 
@@ -3261,6 +3331,15 @@ void Analyze::guideStats(double raError, double decError, int raPulse, int decPu
         processGuideStats(logTime(), raError, decError, raPulse, decPulse, snr, skyBg, numStars);
 }
 
+// Only logged, for offline analysis of where guide cycles spend their time. Not displayed.
+void Analyze::guideLatency(double download, double load, double dark, double detection, double pulse, double total)
+{
+    saveMessage("GuideLatency", QString("%1,%2,%3,%4,%5,%6")
+                .arg(QString::number(download, 'f', 3), QString::number(load, 'f', 3),
+                     QString::number(dark, 'f', 3), QString::number(detection, 'f', 3),
+                     QString::number(pulse, 'f', 3), QString::number(total, 'f', 3)));
+}
+
 void Analyze::processGuideStats(double time, double raError, double decError,
                                 int raPulse, int decPulse, double snr, double skyBg, int numStars, bool batchMode)
 {
@@ -8,9 +8,11 @@
 #define ANALYZE_H
 
 #include <memory>
+#include <vector>
 #include "ekos/ekos.h"
 #include "ekos/mount/mount.h"
 #include "indi/indimount.h"
+#include "graphdecimator.h"
 #include "yaxistool.h"
 #include "ui_analyze.h"
 #include "ekos/manager/meridianflipstate.h"
@@ -193,6 +195,7 @@ class Analyze : public QWidget, public Ui::Analyze
         void guideState(Ekos::GuideState status);
         void guideStats(double raError, double decError, int raPulse, int decPulse,
                         double snr, double skyBg, int numStars);
+        void guideLatency(double download, double load, double dark, double detection, double pulse, double total);
 
         // From Focus
         void autofocusStarting(double temperature, const QString &filter);
@@ -419,7 +422,7 @@ class Analyze : public QWidget, public Ui::Analyze
 
         // Read and display an input .analyze file.
         double readDataFromFile(const QString &filename);
-        double processInputLine(const QString &line);
+        double processInputLine(const QStringList &list);
 
         // Opens a FITS file for viewing.
         void displayFITS(const QString &filename);
@@ -453,6 +456,12 @@ class Analyze : public QWidget, public Ui::Analyze
         // The pop-up allowing users to edit y-axis lower and upper graph values.
         YAxisTool m_YAxisTool;
 
+        // Level of detail of each of the statsPlot graphs.
+        // The graphs are drawn decimated between decimateStatsGraphs() and restoreStatsGraphs().
+        void decimateStatsGraphs();
+        void restoreStatsGraphs();
+        std::vector<GraphDecimator> statsDecimators;
+
         // The y-axis values displayed to the left of the stat's graph.
         QCPAxis *activeYAxis { nullptr };
 
@@ -0,0 +1,143 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "graphdecimator.h"
+
+#include <QVarLengthArray>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+// Bucket width of the finest level, in seconds, and ratio between the bucket widths of consecutive levels.
+constexpr double MIN_BUCKET_WIDTH = 4.0;
+constexpr double LEVEL_RATIO = 4.0;
+// The coarsest level has buckets of about 12 days.
+constexpr int MAX_LEVELS = 10;
+// Graphs with fewer samples per pixel than this in the drawn range use their full resolution data.
+constexpr int MIN_SAMPLES_PER_PIXEL = 4;
+}
+
+GraphDecimator::GraphDecimator(QCPGraph *graph) : m_Graph(graph), m_Full(graph->data())
+{
+}
+
+void GraphDecimator::decimate(const QCPRange &range, int pixels)
+{
+    restore();
+    if (pixels <= 0 || m_Full->isEmpty())
+        return;
+
+    const auto begin = m_Full->findBegin(range.lower, false);
+    const auto end = m_Full->findEnd(range.upper, false);
+    if (end - begin < MIN_SAMPLES_PER_PIXEL * pixels)
+        return;
+
+    // Coarsest level whose buckets are no wider than a pixel
+    const double keysPerPixel = range.size() / pixels;
+    int level = -1;
+    double bucketWidth = MIN_BUCKET_WIDTH;
+    while (level + 1 < MAX_LEVELS && bucketWidth <= keysPerPixel)
+    {
+        level++;
+        bucketWidth *= LEVEL_RATIO;
+    }
+    if (level < 0)
+        return;
+
+    update(level + 1);
+    m_Graph->setData(m_Levels[level].data);
+}
+
+void GraphDecimator::restore()
+{
+    if (m_Graph->data() != m_Full)
+        m_Graph->setData(m_Full);
+}
+
+void GraphDecimator::update(int levels)
+{
+    const int size = m_Full->size();
+
+    // Levels are extended as long as samples were only appended since the last update, otherwise rebuilt.
+    const bool appended = size >= m_Consumed &&
+                          (m_Consumed == 0 || (m_Full->constBegin() + m_Consumed - 1)->key == m_LastKey);
+    for (auto &level : m_Levels)
+    {
+        if (!appended)
+        {
+            level.data->clear();
+            level.complete = std::numeric_limits<double>::lowest();
+        }
+        if (!appended || size != m_Consumed)
+            level.upToDate = false;
+    }
+
+    while (m_Levels.size() < levels)
+    {
+        Level level;
+        level.bucketWidth = MIN_BUCKET_WIDTH * std::pow(LEVEL_RATIO, m_Levels.size());
+        level.complete = std::numeric_limits<double>::lowest();
+        level.data.reset(new QCPGraphDataContainer);
+        m_Levels.append(level);
+    }
+
+    for (int i = 0; i < levels; i++)
+    {
+        if (!m_Levels[i].upToDate)
+        {
+            extend(m_Levels[i]);
+            m_Levels[i].upToDate = true;
+        }
+    }
+
+    m_Consumed = size;
+    m_LastKey = size > 0 ? (m_Full->constEnd() - 1)->key : 0;
+}
+
+void GraphDecimator::extend(Level &level) const
+{
+    // The last bucket may have received more samples, so redo it.
+    level.data->remove(level.complete, std::numeric_limits<double>::max());
+
+    const auto end = m_Full->constEnd();
+    auto it = m_Full->findBegin(level.complete, false);
+    while (it != end)
+    {
+        const double bucketStart = std::floor(it->key / level.bucketWidth) * level.bucketWidth;
+        const double bucketEnd = bucketStart + level.bucketWidth;
+
+        auto minIt = end, maxIt = end, nanIt = end;
+        for (; it != end && it->key < bucketEnd; ++it)
+        {
+            if (qIsNaN(it->value))
+            {
+                if (nanIt == end)
+                    nanIt = it;
+                continue;
+            }
+            if (minIt == end || it->value < minIt->value)
+                minIt = it;
+            if (maxIt == end || it->value > maxIt->value)
+                maxIt = it;
+        }
+
+        // Keep the samples in key order, a NaN marking a gap in the bucket.
+        QVarLengthArray<QCPGraphDataContainer::const_iterator, 3> samples;
+        for (const auto &sample : {minIt, maxIt, nanIt})
+        {
+            if (sample != end && std::find(samples.begin(), samples.end(), sample) == samples.end())
+                samples.append(sample);
+        }
+        std::sort(samples.begin(), samples.end());
+        for (const auto &sample : samples)
+            level.data->add(*sample);
+
+        level.complete = bucketStart;
+    }
+}
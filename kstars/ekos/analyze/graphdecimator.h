@@ -0,0 +1,62 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "qcustomplot.h"
+
+#include <QVector>
+
+/**
+ * @class GraphDecimator
+ * @short Draws graphs with far more samples than pixels from a min/max pyramid of their data.
+ *
+ * Each level of the pyramid splits the time axis into buckets four times wider than the level below,
+ * and keeps the minimum and maximum sample of every bucket, plus a NaN sample where the bucket has a
+ * gap, so that the drawn envelope and the gaps are those of the full data. Levels are built on first
+ * use and extended as samples are appended to the graph.
+ *
+ * The graph keeps its full resolution data except between decimate() and restore(), which should
+ * bracket the replot, so that everything else reading the graph data still sees all the samples.
+ */
+class GraphDecimator
+{
+    public:
+        explicit GraphDecimator(QCPGraph *graph);
+
+        /**
+         * @brief decimate Point the graph at the coarsest level with at least one bucket per pixel
+         * over the given key range. Graphs with fewer than a few samples per pixel are left alone.
+         * @param range Key range to be drawn.
+         * @param pixels Width of the range in pixels.
+         */
+        void decimate(const QCPRange &range, int pixels);
+
+        /**
+         * @brief restore Point the graph back at its full resolution data.
+         */
+        void restore();
+
+    private:
+        struct Level
+        {
+            double bucketWidth { 0 };
+            // Key from which buckets may still get samples, i.e. the start of the last bucket.
+            double complete { 0 };
+            bool upToDate { false };
+            QSharedPointer<QCPGraphDataContainer> data;
+        };
+
+        void update(int levels);
+        void extend(Level &level) const;
+
+        QCPGraph *m_Graph { nullptr };
+        QSharedPointer<QCPGraphDataContainer> m_Full;
+        QVector<Level> m_Levels;
+        // Number of full resolution samples and key of the last, when the levels were last updated.
+        int m_Consumed { 0 };
+        double m_LastKey { 0 };
+};
@@ -0,0 +1,347 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "darkcombiner.h"
+
+#include <QDir>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <fitsio.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "ekos_debug.h"
+
+namespace Ekos
+{
+
+namespace
+{
+// Bands smaller than this are not worth dispatching to another thread.
+constexpr uint32_t MinBandSamples = 1 << 16;
+
+// Run function(first, last) concurrently over bands of samples, and wait for all of them.
+template <typename Function>
+void runBands(uint32_t samples, Function function)
+{
+    const uint32_t threads = static_cast<uint32_t>(qMax(1, QThreadPool::globalInstance()->maxThreadCount()));
+    const uint32_t bandSamples = qMax(MinBandSamples, (samples + threads - 1) / threads);
+
+    QList<QFuture<void>> futures;
+    for (uint32_t first = 0; first < samples; first += bandSamples)
+    {
+        const uint32_t last = qMin(samples, first + bandSamples);
+        futures.append(QtConcurrent::run([function, first, last]()
+        {
+            function(first, last);
+        }));
+    }
+    for (auto &future : futures)
+        future.waitForFinished();
+}
+
+template <typename T>
+T toSample(double value)
+{
+    if constexpr (std::is_integral<T>::value)
+    {
+        value = std::round(value);
+        if (value <= static_cast<double>(std::numeric_limits<T>::lowest()))
+            return std::numeric_limits<T>::lowest();
+        if (value >= static_cast<double>(std::numeric_limits<T>::max()))
+            return std::numeric_limits<T>::max();
+    }
+    return static_cast<T>(value);
+}
+
+// Median of values, which is reordered.
+template <typename T>
+double median(T *values, uint32_t count)
+{
+    const uint32_t middle = count / 2;
+    std::nth_element(values, values + middle, values + count);
+    if (count % 2)
+        return values[middle];
+    // The lower half is now all <= values[middle], its largest element completes the pair.
+    return (static_cast<double>(*std::max_element(values, values + middle)) + values[middle]) / 2.0;
+}
+
+// Mean of values after iteratively rejecting the ones further than sigma standard deviations from their
+// median. The deviation is estimated from the median absolute deviation, so a single cosmic ray in a
+// handful of frames doesn't inflate it enough to survive the rejection.
+// deviations is scratch space for at least count values.
+template <typename T>
+double sigmaClippedMean(T *values, uint32_t count, double sigma, double *deviations)
+{
+    constexpr int MaxIterations = 5;
+    for (int iteration = 0; iteration < MaxIterations && count > 2; iteration++)
+    {
+        const double center = median(values, count);
+        for (uint32_t i = 0; i < count; i++)
+            deviations[i] = std::abs(static_cast<double>(values[i]) - center);
+        double spread = 1.4826 * median(deviations, count);
+
+        // Mostly identical samples, fall back to the standard deviation.
+        if (spread <= 0)
+        {
+            double sum = 0, squaredSum = 0;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                sum += values[i];
+                squaredSum += static_cast<double>(values[i]) * values[i];
+            }
+            const double mean = sum / count;
+            spread = std::sqrt(qMax(0.0, squaredSum / count - mean * mean));
+            if (spread <= 0)
+                break;
+        }
+
+        const double limit = sigma * spread;
+        T *kept = std::partition(values, values + count, [center, limit](T value)
+        {
+            return std::abs(static_cast<double>(value) - center) <= limit;
+        });
+        const uint32_t keptCount = static_cast<uint32_t>(kept - values);
+        if (keptCount == count || keptCount == 0)
+            break;
+        count = keptCount;
+    }
+
+    double sum = 0;
+    for (uint32_t i = 0; i < count; i++)
+        sum += values[i];
+    return sum / count;
+}
+
+uint32_t bytesPerSample(int dataType)
+{
+    switch (dataType)
+    {
+        case TBYTE:
+            return sizeof(uint8_t);
+        case TSHORT:
+            return sizeof(int16_t);
+        case TUSHORT:
+            return sizeof(uint16_t);
+        case TLONG:
+            return sizeof(int32_t);
+        case TULONG:
+            return sizeof(uint32_t);
+        case TFLOAT:
+            return sizeof(float);
+        case TLONGLONG:
+            return sizeof(int64_t);
+        case TDOUBLE:
+            return sizeof(double);
+        default:
+            return 0;
+    }
+}
+}
+
+void DarkCombiner::reset(Method method, double sigma)
+{
+    m_Method = method;
+    m_Sigma = sigma;
+    m_DataType = 0;
+    m_BytesPerSample = 0;
+    m_Samples = 0;
+    m_Count = 0;
+    m_Sum.clear();
+    m_Sum.shrink_to_fit();
+    m_Frames.reset();
+}
+
+bool DarkCombiner::add(const uint8_t *buffer, int dataType, uint32_t samples)
+{
+    if (buffer == nullptr || samples == 0 || bytesPerSample(dataType) == 0)
+        return false;
+
+    if (m_Count > 0 && (dataType != m_DataType || samples != m_Samples))
+    {
+        qCWarning(KSTARS_EKOS) << "Dark frame layout changed, restarting the master dark.";
+        reset(m_Method, m_Sigma);
+    }
+
+    m_DataType = dataType;
+    m_BytesPerSample = bytesPerSample(dataType);
+    m_Samples = samples;
+
+    if (m_Method == COMBINE_AVERAGE)
+    {
+        if (m_Count == 0)
+            m_Sum.assign(samples, 0);
+
+        switch (dataType)
+        {
+            case TBYTE:
+                accumulate(reinterpret_cast<const uint8_t *>(buffer));
+                break;
+            case TSHORT:
+                accumulate(reinterpret_cast<const int16_t *>(buffer));
+                break;
+            case TUSHORT:
+                accumulate(reinterpret_cast<const uint16_t *>(buffer));
+                break;
+            case TLONG:
+                accumulate(reinterpret_cast<const int32_t *>(buffer));
+                break;
+            case TULONG:
+                accumulate(reinterpret_cast<const uint32_t *>(buffer));
+                break;
+            case TFLOAT:
+                accumulate(reinterpret_cast<const float *>(buffer));
+                break;
+            case TLONGLONG:
+                accumulate(reinterpret_cast<const int64_t *>(buffer));
+                break;
+            case TDOUBLE:
+                accumulate(reinterpret_cast<const double *>(buffer));
+                break;
+        }
+    }
+    else
+    {
+        if (!m_Frames)
+        {
+            m_Frames.reset(new QTemporaryFile(QDir::tempPath() + "/kstars_darks_XXXXXX"));
+            if (!m_Frames->open())
+            {
+                qCWarning(KSTARS_EKOS) << "Failed to create the dark frames file" << m_Frames->errorString();
+                m_Frames.reset();
+                return false;
+            }
+        }
+
+        const qint64 frameSize = static_cast<qint64>(samples) * m_BytesPerSample;
+        if (!m_Frames->seek(frameSize * m_Count) ||
+                m_Frames->write(reinterpret_cast<const char *>(buffer), frameSize) != frameSize)
+        {
+            qCWarning(KSTARS_EKOS) << "Failed to store dark frame" << m_Frames->errorString();
+            return false;
+        }
+    }
+
+    m_Count++;
+    return true;
+}
+
+template <typename T>
+void DarkCombiner::accumulate(const T *buffer)
+{
+    float *sum = m_Sum.data();
+    runBands(m_Samples, [sum, buffer](uint32_t first, uint32_t last)
+    {
+        for (uint32_t i = first; i < last; i++)
+            sum[i] += buffer[i];
+    });
+}
+
+bool DarkCombiner::combine(uint8_t *target)
+{
+    if (m_Count == 0 || target == nullptr)
+        return false;
+
+    switch (m_DataType)
+    {
+        case TBYTE:
+            return combineAs(reinterpret_cast<uint8_t *>(target));
+        case TSHORT:
+            return combineAs(reinterpret_cast<int16_t *>(target));
+        case TUSHORT:
+            return combineAs(reinterpret_cast<uint16_t *>(target));
+        case TLONG:
+            return combineAs(reinterpret_cast<int32_t *>(target));
+        case TULONG:
+            return combineAs(reinterpret_cast<uint32_t *>(target));
+        case TFLOAT:
+            return combineAs(reinterpret_cast<float *>(target));
+        case TLONGLONG:
+            return combineAs(reinterpret_cast<int64_t *>(target));
+        case TDOUBLE:
+            return combineAs(reinterpret_cast<double *>(target));
+        default:
+            return false;
+    }
+}
+
+template <typename T>
+bool DarkCombiner::combineAs(T *target)
+{
+    if (m_Method == COMBINE_AVERAGE)
+    {
+        average(target);
+        return true;
+    }
+    return combineFromDisk(target);
+}
+
+template <typename T>
+void DarkCombiner::average(T *target) const
+{
+    const float *sum = m_Sum.data();
+    const double count = m_Count;
+    runBands(m_Samples, [sum, target, count](uint32_t first, uint32_t last)
+    {
+        for (uint32_t i = first; i < last; i++)
+            target[i] = toSample<T>(sum[i] / count);
+    });
+}
+
+template <typename T>
+bool DarkCombiner::combineFromDisk(T *target)
+{
+    if (!m_Frames)
+        return false;
+
+    // Each chunk holds the same range of samples of every frame, frame after frame.
+    const uint32_t count = m_Count;
+    const uint32_t chunkSamples = static_cast<uint32_t>(qBound<size_t>(1, m_ChunkMemory / (sizeof(T) * count), m_Samples));
+    const qint64 frameSize = static_cast<qint64>(m_Samples) * sizeof(T);
+    std::vector<T> chunk(static_cast<size_t>(chunkSamples) * count);
+
+    for (uint32_t start = 0; start < m_Samples; start += chunkSamples)
+    {
+        const uint32_t length = qMin(chunkSamples, m_Samples - start);
+        for (uint32_t frame = 0; frame < count; frame++)
+        {
+            char *slice = reinterpret_cast<char *>(chunk.data() + static_cast<size_t>(frame) * length);
+            const qint64 bytes = static_cast<qint64>(length) * sizeof(T);
+            if (!m_Frames->seek(frame * frameSize + static_cast<qint64>(start) * sizeof(T)) ||
+                    m_Frames->read(slice, bytes) != bytes)
+            {
+                qCWarning(KSTARS_EKOS) << "Failed to read back dark frame" << frame << m_Frames->errorString();
+                return false;
+            }
+        }
+
+        const T *values = chunk.data();
+        const Method method = m_Method;
+        const double sigma = m_Sigma;
+        T *output = target + start;
+        runBands(length, [values, output, length, count, method, sigma](uint32_t first, uint32_t last)
+        {
+            std::vector<T> pixel(count);
+            std::vector<double> deviations(count);
+            for (uint32_t i = first; i < last; i++)
+            {
+                for (uint32_t frame = 0; frame < count; frame++)
+                    pixel[frame] = values[static_cast<size_t>(frame) * length + i];
+                const double value = method == COMBINE_MEDIAN ? median(pixel.data(), count) :
+                                     sigmaClippedMean(pixel.data(), count, sigma, deviations.data());
+                output[i] = toSample<T>(value);
+            }
+        });
+    }
+
+    return true;
+}
+
+}
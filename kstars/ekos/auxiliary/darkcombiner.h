@@ -0,0 +1,104 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTemporaryFile>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Ekos
+{
+
+/**
+ * @brief The DarkCombiner class
+ *
+ * Combines dark frames into a master dark as they are received, without keeping all of them in memory.
+ *
+ * Averaged frames are added to a running sum. For median and sigma clipped combines, each frame is appended to a
+ * temporary file instead, and the master is then built in chunks of pixels that fit in a bounded amount of memory,
+ * reading the same chunk of every frame back from disk. Both the accumulation and the per pixel combine are spread
+ * over row bands on the thread pool.
+ */
+class DarkCombiner
+{
+    public:
+        /// Same order as the combination algorithms of the dark library.
+        typedef enum
+        {
+            COMBINE_AVERAGE,
+            COMBINE_MEDIAN,
+            COMBINE_SIGMA_CLIP
+        } Method;
+
+        /**
+         * @brief reset Discard all the frames added so far and start a new master.
+         * @param method Combination algorithm.
+         * @param sigma Rejection threshold in standard deviations for COMBINE_SIGMA_CLIP.
+         */
+        void reset(Method method, double sigma = 3.0);
+
+        /**
+         * @brief add Add a frame to the master. Frames of a different size or data type than the previous ones start a new master.
+         * @param buffer Samples of the frame.
+         * @param dataType CFITSIO data type of the samples.
+         * @param samples Number of samples in buffer, over all channels.
+         * @return False if the frame could not be stored.
+         */
+        bool add(const uint8_t *buffer, int dataType, uint32_t samples);
+
+        /**
+         * @brief combine Write the master frame to target, which must be of the same layout as the added frames.
+         * Frames added so far are kept, so more can be added before combining again.
+         * @return False if no frame was added, or if the stored frames could not be read back.
+         */
+        bool combine(uint8_t *target);
+
+        Method method() const
+        {
+            return m_Method;
+        }
+
+        /**
+         * @brief count Number of frames in the master.
+         */
+        uint32_t count() const
+        {
+            return m_Count;
+        }
+
+        /**
+         * @brief setChunkMemory Limit the memory used to combine frames from disk, mostly for testing.
+         */
+        void setChunkMemory(size_t bytes)
+        {
+            m_ChunkMemory = bytes;
+        }
+
+    private:
+        template <typename T> void accumulate(const T *buffer);
+        template <typename T> bool combineAs(T *target);
+        template <typename T> void average(T *target) const;
+        template <typename T> bool combineFromDisk(T *target);
+
+        Method m_Method { COMBINE_AVERAGE };
+        double m_Sigma { 3.0 };
+        int m_DataType { 0 };
+        uint32_t m_BytesPerSample { 0 };
+        uint32_t m_Samples { 0 };
+        uint32_t m_Count { 0 };
+        size_t m_ChunkMemory { 256 * 1024 * 1024 };
+
+        /// Running sum of the averaged frames. Floats are exact for 50 16-bit frames and keep
+        /// floating point darks intact, at the memory cost of a single 32-bit frame.
+        std::vector<float> m_Sum;
+        /// Frames to be combined from disk, back to back.
+        std::unique_ptr<QTemporaryFile> m_Frames;
+};
+
+}
@@ -20,11 +20,16 @@
 #include "fitsviewer/fitsview.h"
 
 #include <QDesktopServices>
+#include <QMutexLocker>
+#include <QReadLocker>
+#include <QWriteLocker>
 #include <QSqlRecord>
 #include <QSqlTableModel>
 #include <QStatusBar>
+#include <QtConcurrent>
 #include <algorithm>
 #include <array>
+#include <limits>
 
 namespace Ekos
 {
@@ -42,6 +47,8 @@ DarkLibrary::DarkLibrary(QWidget *parent) : QDialog(parent)
 {
     setupUi(this);
 
+    m_CachedDefectMaps.setMaxCost(DEFECT_MAP_CACHE_SIZE);
+
     m_StatusBar = new QStatusBar(this);
     m_StatusLabel = new QLabel(i18n("Idle"), this);
     m_FileLabel = new QLabel(this);
@@ -135,7 +142,7 @@ DarkLibrary::DarkLibrary(QWidget *parent) : QDialog(parent)
     connect(startB, &QPushButton::clicked, this, &DarkLibrary::start);
     connect(stopB, &QPushButton::clicked, this, &DarkLibrary::stop);
 
-    KStarsData::Instance()->userdb()->GetAllDarkFrames(m_DarkFramesDatabaseList);
+    refreshFromDB();
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Defect Map Connections
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -184,6 +191,7 @@ DarkLibrary::DarkLibrary(QWidget *parent) : QDialog(parent)
     m_RememberSummaryView = Options::useSummaryPreview();
     initView();
 
+    m_SettingWidgets.collect(this);
     loadGlobalSettings();
 
     connectSettings();
@@ -200,105 +208,177 @@ DarkLibrary::~DarkLibrary()
 ///////////////////////////////////////////////////////////////////////////////////////
 void DarkLibrary::refreshFromDB()
 {
+    QWriteLocker locker(&m_DarkFramesLock);
     KStarsData::Instance()->userdb()->GetAllDarkFrames(m_DarkFramesDatabaseList);
+
+    m_DarkFramesIndex.clear();
+    for (int row = 0; row < m_DarkFramesDatabaseList.size(); row++)
+        indexDarkFrame(row);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////
-bool DarkLibrary::findDarkFrame(ISD::CameraChip *m_TargetChip, double duration, QSharedPointer<FITSData> &darkData)
+QString DarkLibrary::darkFrameIndexKey(const QString &camera, int chip, int binX, int binY)
 {
-    QVariantMap bestCandidate;
-    for (auto &map : m_DarkFramesDatabaseList)
-    {
-        // First check CCD name matches and check if we are on the correct chip
-        if (map["ccd"].toString() == m_TargetChip->getCCD()->getDeviceName() &&
-                map["chip"].toInt() == static_cast<int>(m_TargetChip->getType()))
+    return QString("%1/%2/%3x%4").arg(camera).arg(chip).arg(binX).arg(binY);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////
+void DarkLibrary::indexDarkFrame(int row)
+{
+    const QVariantMap &map = m_DarkFramesDatabaseList.at(row);
+    auto &entries = m_DarkFramesIndex[darkFrameIndexKey(map["ccd"].toString(), map["chip"].toInt(), map["binX"].toInt(),
+                                                                               map["binY"].toInt())];
+    const DarkFrameIndexEntry entry {map["duration"].toDouble(), row};
+    entries.insert(std::upper_bound(entries.begin(), entries.end(), entry,
+                                    [](const DarkFrameIndexEntry & a, const DarkFrameIndexEntry & b)
+    {
+        return a.duration < b.duration;
+    }), entry);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////
+template <typename Accept, typename Better>
+int DarkLibrary::findBestDarkFrame(const QString &key, double duration, Accept accept, Better better) const
+{
+    auto bucket = m_DarkFramesIndex.constFind(key);
+    if (bucket == m_DarkFramesIndex.constEnd())
+        return -1;
+
+    const QVector<DarkFrameIndexEntry> &entries = bucket.value();
+    int upper = std::lower_bound(entries.cbegin(), entries.cend(), duration, [](const DarkFrameIndexEntry & entry,
+                                 double value)
+    {
+        return entry.duration < value;
+    }) - entries.cbegin();
+    int lower = upper - 1;
+
+    // Frame closest in exposure duration always wins, so walk away from the requested duration on both sides
+    // and stop at the first duration difference with an acceptable frame.
+    QVector<int> rows;
+    while (lower >= 0 || upper < entries.size())
+    {
+        const double lowerDiff = lower >= 0 ? duration - entries[lower].duration : std::numeric_limits<double>::max();
+        const double upperDiff = upper < entries.size() ? entries[upper].duration - duration :
+                                 std::numeric_limits<double>::max();
+        const double diff = std::min(lowerDiff, upperDiff);
+
+        rows.clear();
+        while (lower >= 0 && duration - entries[lower].duration == diff)
+            rows.append(entries[lower--].row);
+        while (upper < entries.size() && entries[upper].duration - duration == diff)
+            rows.append(entries[upper++].row);
+
+        // Ties are broken in database order, as a full scan of the database would.
+        std::sort(rows.begin(), rows.end());
+        int best = -1;
+        for (int row : qAsConst(rows))
         {
-            // Match Gain
-            int gain = getGain();
-            if (gain >= 0 && map["gain"].toInt() != gain)
+            const QVariantMap &map = m_DarkFramesDatabaseList.at(row);
+            if (!accept(map))
                 continue;
+            if (best < 0 || better(map, m_DarkFramesDatabaseList.at(best)))
+                best = row;
+        }
 
-            // Match ISO
-            QString isoValue;
-            if (m_TargetChip->getISOValue(isoValue) && map["iso"].toString() != isoValue)
-                continue;
+        if (best >= 0)
+            return best;
+    }
 
-            // Match binning
-            int binX = 1, binY = 1;
-            m_TargetChip->getBinning(&binX, &binY);
+    return -1;
+}
 
-            // Then check if binning is the same
-            if (map["binX"].toInt() != binX || map["binY"].toInt() != binY)
-                continue;
+///////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////
+bool DarkLibrary::findDarkFrame(ISD::CameraChip *m_TargetChip, double duration, QSharedPointer<FITSData> &darkData)
+{
+    // Match Gain
+    const int gain = getGain();
 
-            // If camera has an active cooler, then we check temperature against the absolute threshold.
-            if (m_TargetChip->getCCD()->hasCoolerControl())
-            {
-                double temperature = 0;
-                m_TargetChip->getCCD()->getTemperature(&temperature);
-                double darkTemperature = map["temperature"].toDouble();
-                // If different is above threshold, it is completely rejected.
-                if (darkTemperature != INVALID_VALUE && fabs(darkTemperature - temperature) > maxDarkTemperatureDiff->value())
-                    continue;
-            }
+    // Match ISO
+    QString isoValue;
+    const bool hasISO = m_TargetChip->getISOValue(isoValue);
 
-            if (bestCandidate.isEmpty())
-            {
-                bestCandidate = map;
-                continue;
-            }
+    // Match binning
+    int binX = 1, binY = 1;
+    m_TargetChip->getBinning(&binX, &binY);
 
-            // We try to find the best frame
-            // Frame closest in exposure duration wins
-            // Frame with temperature closest to stored temperature wins (if temperature is reported)
-            uint32_t thisMapScore = 0;
-            uint32_t bestCandidateScore = 0;
+    double temperature = 0;
+    const bool hasCooler = m_TargetChip->getCCD()->hasCooler();
+    const bool hasCoolerControl = m_TargetChip->getCCD()->hasCoolerControl();
+    if (hasCooler || hasCoolerControl)
+        m_TargetChip->getCCD()->getTemperature(&temperature);
+    const double maxTemperatureDiff = maxDarkTemperatureDiff->value();
 
-            // Else we check for the closest passive temperature
-            if (m_TargetChip->getCCD()->hasCooler())
-            {
-                double temperature = 0;
-                m_TargetChip->getCCD()->getTemperature(&temperature);
-                double diffMap = std::fabs(temperature - map["temperature"].toDouble());
-                double diffBest = std::fabs(temperature - bestCandidate["temperature"].toDouble());
-                // Prefer temperatures closest to target
-                if (diffMap < diffBest)
-                    thisMapScore++;
-                else if (diffBest < diffMap)
-                    bestCandidateScore++;
-            }
+    auto accept = [ = ](const QVariantMap & map)
+    {
+        if (gain >= 0 && map["gain"].toInt() != gain)
+            return false;
 
-            // Duration has a higher score priority over temperature
-            {
-                double diffMap = std::fabs(map["duration"].toDouble() - duration);
-                double diffBest = std::fabs(bestCandidate["duration"].toDouble() - duration);
-                if (diffMap < diffBest)
-                    thisMapScore += 5;
-                else if (diffBest < diffMap)
-                    bestCandidateScore += 5;
-            }
+        if (hasISO && map["iso"].toString() != isoValue)
+            return false;
 
-            // More recent has a higher score than older.
-            {
-                const QDateTime now = QDateTime::currentDateTime();
-                int64_t diffMap  = map["timestamp"].toDateTime().secsTo(now);
-                int64_t diffBest = bestCandidate["timestamp"].toDateTime().secsTo(now);
-                if (diffMap < diffBest)
-                    thisMapScore++;
-                else if (diffBest < diffMap)
-                    bestCandidateScore++;
-            }
+        // If camera has an active cooler, then we check temperature against the absolute threshold.
+        if (hasCoolerControl)
+        {
+            double darkTemperature = map["temperature"].toDouble();
+            // If different is above threshold, it is completely rejected.
+            if (darkTemperature != INVALID_VALUE && fabs(darkTemperature - temperature) > maxTemperatureDiff)
+                return false;
+        }
 
-            // Find candidate with closest time in case we have multiple defect maps
-            if (thisMapScore > bestCandidateScore)
-                bestCandidate = map;
+        return true;
+    };
+
+    // Frames compared have the same duration difference
+    // Frame with temperature closest to stored temperature wins (if temperature is reported)
+    // More recent frame wins
+    const QDateTime now = QDateTime::currentDateTime();
+    auto better = [ = ](const QVariantMap & map, const QVariantMap & bestCandidate)
+    {
+        uint32_t thisMapScore = 0;
+        uint32_t bestCandidateScore = 0;
+
+        // Else we check for the closest passive temperature
+        if (hasCooler)
+        {
+            double diffMap = std::fabs(temperature - map["temperature"].toDouble());
+            double diffBest = std::fabs(temperature - bestCandidate["temperature"].toDouble());
+            // Prefer temperatures closest to target
+            if (diffMap < diffBest)
+                thisMapScore++;
+            else if (diffBest < diffMap)
+                bestCandidateScore++;
         }
-    }
 
-    if (bestCandidate.isEmpty())
-        return false;
+        // More recent has a higher score than older.
+        {
+            int64_t diffMap  = map["timestamp"].toDateTime().secsTo(now);
+            int64_t diffBest = bestCandidate["timestamp"].toDateTime().secsTo(now);
+            if (diffMap < diffBest)
+                thisMapScore++;
+            else if (diffBest < diffMap)
+                bestCandidateScore++;
+        }
+
+        return thisMapScore > bestCandidateScore;
+    };
+
+    QVariantMap bestCandidate;
+    {
+        QReadLocker locker(&m_DarkFramesLock);
+        const int row = findBestDarkFrame(darkFrameIndexKey(m_TargetChip->getCCD()->getDeviceName(),
+                                          static_cast<int>(m_TargetChip->getType()), binX, binY), duration, accept, better);
+        if (row < 0)
+            return false;
+        bestCandidate = m_DarkFramesDatabaseList.at(row);
+    }
 
     if (fabs(bestCandidate["duration"].toDouble() - duration) > 3)
         emit i18n("Using available dark frame with %1 seconds exposure. Please take a dark frame with %1 seconds exposure for more accurate results.",
@@ -315,27 +395,12 @@ bool DarkLibrary::findDarkFrame(ISD::CameraChip *m_TargetChip, double duration,
         return false;
     }
 
-    if (m_CachedDarkFrames.contains(filename))
-    {
-        darkData = m_CachedDarkFrames[filename];
+    darkData = loadDarkFrame(filename);
+    if (darkData)
         return true;
-    }
-
-    // Before adding to cache, clear the cache if memory drops too low.
-    auto memoryMB = KSUtils::getAvailableRAM() / 1e6;
-    if (memoryMB < CACHE_MEMORY_LIMIT)
-        m_CachedDarkFrames.clear();
-
-    // Finally we made it, let's put it in the hash
-    if (cacheDarkFrameFromFile(filename))
-    {
-        darkData = m_CachedDarkFrames[filename];
-        return true;
-    }
 
     // Remove bad dark frame
     emit newLog(i18n("Removing bad dark frame file %1", filename));
-    m_CachedDarkFrames.remove(filename);
     QFile::remove(filename);
     KStarsData::Instance()->userdb()->DeleteDarkFrame(filename);
     return false;
@@ -347,67 +412,41 @@ bool DarkLibrary::findDarkFrame(ISD::CameraChip *m_TargetChip, double duration,
 ///////////////////////////////////////////////////////////////////////////////////////
 bool DarkLibrary::findDefectMap(ISD::CameraChip *m_TargetChip, double duration, QSharedPointer<DefectMap> &defectMap)
 {
-    QVariantMap bestCandidate;
-    for (auto &map : m_DarkFramesDatabaseList)
-    {
-        if (map["defectmap"].toString().isEmpty())
-            continue;
+    int binX = 1, binY = 1;
+    m_TargetChip->getBinning(&binX, &binY);
 
-        // First check CCD name matches and check if we are on the correct chip
-        if (map["ccd"].toString() == m_TargetChip->getCCD()->getDeviceName() &&
-                map["chip"].toInt() == static_cast<int>(m_TargetChip->getType()))
-        {
-            int binX, binY;
-            m_TargetChip->getBinning(&binX, &binY);
+    double temperature = 0;
+    const bool hasCooler = m_TargetChip->getCCD()->hasCooler();
+    if (hasCooler)
+        m_TargetChip->getCCD()->getTemperature(&temperature);
 
-            // Then check if binning is the same
-            if (map["binX"].toInt() == binX && map["binY"].toInt() == binY)
-            {
-                if (bestCandidate.isEmpty())
-                {
-                    bestCandidate = map;
-                    continue;
-                }
-
-                // We try to find the best frame
-                // Frame closest in exposure duration wins
-                // Frame with temperature closest to stored temperature wins (if temperature is reported)
-                uint32_t thisMapScore = 0;
-                uint32_t bestCandidateScore = 0;
-
-                // Else we check for the closest passive temperature
-                if (m_TargetChip->getCCD()->hasCooler())
-                {
-                    double temperature = 0;
-                    m_TargetChip->getCCD()->getTemperature(&temperature);
-                    double diffMap = std::fabs(temperature - map["temperature"].toDouble());
-                    double diffBest = std::fabs(temperature - bestCandidate["temperature"].toDouble());
-                    // Prefer temperatures closest to target
-                    if (diffMap < diffBest)
-                        thisMapScore++;
-                    else if (diffBest < diffMap)
-                        bestCandidateScore++;
-                }
-
-                // Duration has a higher score priority over temperature
-                double diffMap = std::fabs(map["duration"].toDouble() - duration);
-                double diffBest = std::fabs(bestCandidate["duration"].toDouble() - duration);
-                if (diffMap < diffBest)
-                    thisMapScore += 2;
-                else if (diffBest < diffMap)
-                    bestCandidateScore += 2;
-
-                // Find candidate with closest time in case we have multiple defect maps
-                if (thisMapScore > bestCandidateScore)
-                    bestCandidate = map;
-            }
-        }
-    }
+    auto accept = [](const QVariantMap & map)
+    {
+        return !map["defectmap"].toString().isEmpty();
+    };
 
+    // Frames compared have the same duration difference
+    // Frame with temperature closest to stored temperature wins (if temperature is reported)
+    auto better = [ = ](const QVariantMap & map, const QVariantMap & bestCandidate)
+    {
+        if (!hasCooler)
+            return false;
 
-    if (bestCandidate.isEmpty())
-        return false;
+        double diffMap = std::fabs(temperature - map["temperature"].toDouble());
+        double diffBest = std::fabs(temperature - bestCandidate["temperature"].toDouble());
+        // Prefer temperatures closest to target
+        return diffMap < diffBest;
+    };
 
+    QVariantMap bestCandidate;
+    {
+        QReadLocker locker(&m_DarkFramesLock);
+        const int row = findBestDarkFrame(darkFrameIndexKey(m_TargetChip->getCCD()->getDeviceName(),
+                                          static_cast<int>(m_TargetChip->getType()), binX, binY), duration, accept, better);
+        if (row < 0)
+            return false;
+        bestCandidate = m_DarkFramesDatabaseList.at(row);
+    }
 
     QString darkFilename = bestCandidate["filename"].toString();
     QString defectFilename = bestCandidate["defectmap"].toString();
@@ -415,18 +454,10 @@ bool DarkLibrary::findDefectMap(ISD::CameraChip *m_TargetChip, double duration,
     if (darkFilename.isEmpty() || defectFilename.isEmpty())
         return false;
 
-    if (m_CachedDefectMaps.contains(darkFilename))
-    {
-        defectMap = m_CachedDefectMaps[darkFilename];
-        return true;
-    }
-
     // Finally we made it, let's put it in the hash
-    if (cacheDefectMapFromFile(darkFilename, defectFilename))
-    {
-        defectMap = m_CachedDefectMaps[darkFilename];
+    defectMap = loadDefectMap(darkFilename, defectFilename);
+    if (defectMap)
         return true;
-    }
     else
     {
         // Remove bad dark frame
@@ -440,18 +471,33 @@ bool DarkLibrary::findDefectMap(ISD::CameraChip *m_TargetChip, double duration,
 ///////////////////////////////////////////////////////////////////////////////////////
 bool DarkLibrary::cacheDefectMapFromFile(const QString &key, const QString &filename)
 {
+    return !loadDefectMap(key, filename).isNull();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////
+QSharedPointer<DefectMap> DarkLibrary::loadDefectMap(const QString &key, const QString &filename)
+{
+    {
+        QMutexLocker locker(&m_CacheMutex);
+        if (auto cached = m_CachedDefectMaps.object(key))
+            return *cached;
+    }
+
     QSharedPointer<DefectMap> oneMap;
     oneMap.reset(new DefectMap());
 
     if (oneMap->load(filename))
     {
         oneMap->filterPixels();
-        m_CachedDefectMaps[key] = oneMap;
-        return true;
+        QMutexLocker locker(&m_CacheMutex);
+        m_CachedDefectMaps.insert(key, new QSharedPointer<DefectMap>(oneMap));
+        return oneMap;
     }
 
     emit newLog(i18n("Failed to load defect map file %1", filename));
-    return false;
+    return QSharedPointer<DefectMap>();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -459,21 +505,76 @@ bool DarkLibrary::cacheDefectMapFromFile(const QString &key, const QString &file
 ///////////////////////////////////////////////////////////////////////////////////////
 bool DarkLibrary::cacheDarkFrameFromFile(const QString &filename)
 {
+    return !loadDarkFrame(filename).isNull();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////
+QSharedPointer<FITSData> DarkLibrary::loadDarkFrame(const QString &filename)
+{
+    QMutexLocker locker(&m_CacheMutex);
+
+    // Wait for any other thread already loading this master, a prefetch most likely.
+    while (m_LoadingDarkFrames.contains(filename))
+        m_DarkFrameLoaded.wait(&m_CacheMutex);
+
+    if (auto cached = m_CachedDarkFrames.object(filename))
+        return *cached;
+
+    m_LoadingDarkFrames.insert(filename);
+    locker.unlock();
+
     QSharedPointer<FITSData> data;
     data.reset(new FITSData(FITS_CALIBRATE), &QObject::deleteLater);
     QFuture<bool> rc = data->loadFromFile(filename);
-
     rc.waitForFinished();
-    if (rc.result())
-    {
-        m_CachedDarkFrames[filename] = data;
-    }
-    else
+
+    locker.relock();
+    m_LoadingDarkFrames.remove(filename);
+    m_DarkFrameLoaded.wakeAll();
+
+    if (!rc.result())
     {
         emit newLog(i18n("Failed to load dark frame file %1", filename));
+        return QSharedPointer<FITSData>();
     }
 
-    return rc;
+    // Before adding to cache, clear the cache if memory drops too low.
+    auto memoryMB = KSUtils::getAvailableRAM() / 1e6;
+    if (memoryMB < CACHE_MEMORY_LIMIT)
+        m_CachedDarkFrames.clear();
+
+    const qint64 bytes = static_cast<qint64>(data->samplesPerChannel()) * data->channels() * data->getBytesPerPixel();
+    m_CachedDarkFrames.setMaxCost(static_cast<int>(Options::darkLibraryCacheSize()) * 1024);
+    // A master larger than the whole cache is not kept, but still returned for this frame.
+    m_CachedDarkFrames.insert(filename, new QSharedPointer<FITSData>(data), qMax<int>(1, bytes / 1024));
+    return data;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////
+void DarkLibrary::prefetchDarkFrame(ISD::CameraChip *targetChip, double duration)
+{
+    if (Options::darkLibraryCacheSize() == 0)
+        return;
+
+    QtConcurrent::run([this, targetChip, duration]()
+    {
+        QSharedPointer<FITSData> darkData;
+        findDarkFrame(targetChip, duration, darkData);
+    });
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////
+void DarkLibrary::removeFromCache(const QString &filename)
+{
+    QMutexLocker locker(&m_CacheMutex);
+    m_CachedDarkFrames.remove(filename);
+    m_CachedDefectMaps.remove(filename);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -540,11 +641,13 @@ void DarkLibrary::updateProperty(INDI::Property prop)
         return;
     }
 
-    uint32_t totalElements = m_CurrentDarkFrame->channels() * m_CurrentDarkFrame->samplesPerChannel();
-    if (totalElements != m_DarkMasterBuffer.size())
-        m_DarkMasterBuffer.assign(totalElements, 0);
+    const uint32_t totalElements = m_CurrentDarkFrame->channels() * m_CurrentDarkFrame->samplesPerChannel();
+    if (!m_DarkCombiner.add(m_CurrentDarkFrame->getImageBuffer(), m_CurrentDarkFrame->dataType(), totalElements))
+    {
+        m_FileLabel->setText(i18n("Failed to store dark data."));
+        return;
+    }
 
-    aggregate(m_CurrentDarkFrame);
     darkProgress->setValue(darkProgress->value() + 1);
     m_StatusLabel->setText(i18n("Received %1/%2 images.", darkProgress->value(), darkProgress->maximum()));
 }
@@ -626,6 +729,7 @@ void DarkLibrary::clearExpired()
     for (int i = 0; i < darkframe.rowCount(); ++i)
     {
         QString oneFile = darkframe.record(i).value("filename").toString();
+        removeFromCache(oneFile);
         QFile::remove(oneFile);
         QString defectMap = darkframe.record(i).value("defectmap").toString();
         if (defectMap.isEmpty() == false)
@@ -671,6 +775,7 @@ void DarkLibrary::clearAll()
     for (int i = 0; i < darkFramesModel->rowCount(); ++i)
     {
         QString oneFile = darkFramesModel->record(i).value("filename").toString();
+        removeFromCache(oneFile);
         QFile::remove(oneFile);
         QString defectMap = darkFramesModel->record(i).value("defectmap").toString();
         if (defectMap.isEmpty() == false)
@@ -697,6 +802,7 @@ void DarkLibrary::clearRow(int index)
     QSqlRecord record = darkFramesModel->record(index);
     QString filename = record.value("filename").toString();
     QString defectMap = record.value("defectmap").toString();
+    removeFromCache(filename);
     QFile::remove(filename);
     if (!defectMap.isEmpty())
         QFile::remove(defectMap);
@@ -842,11 +948,18 @@ void DarkLibrary::loadCurrentMasterDark(const QString &camera, int masterIndex)
 void DarkLibrary::loadCurrentMasterDefectMap()
 {
     // Find if we have an existing map
-    if (m_CachedDefectMaps.contains(m_MasterDarkFrameFilename))
+    QSharedPointer<DefectMap> cachedMap;
     {
-        if (m_CurrentDefectMap != m_CachedDefectMaps.value(m_MasterDarkFrameFilename))
+        QMutexLocker locker(&m_CacheMutex);
+        if (auto cached = m_CachedDefectMaps.object(m_MasterDarkFrameFilename))
+            cachedMap = *cached;
+    }
+
+    if (cachedMap)
+    {
+        if (m_CurrentDefectMap != cachedMap)
         {
-            m_CurrentDefectMap = m_CachedDefectMaps.value(m_MasterDarkFrameFilename);
+            m_CurrentDefectMap = cachedMap;
             m_DarkView->setDefectMap(m_CurrentDefectMap);
             m_CurrentDefectMap->setDarkData(m_CurrentDarkFrame);
         }
@@ -1194,6 +1307,7 @@ void DarkLibrary::generateDarkJobs()
 void DarkLibrary::execute()
 {
     m_DarkImagesCounter = 0;
+    m_DarkCombiner.reset(static_cast<DarkCombiner::Method>(combinAlgorithmCombo->currentIndex()));
     darkProgress->setValue(0);
     darkProgress->setTextVisible(true);
     connect(m_CaptureModule, &Capture::newImage, this, &DarkLibrary::processNewImage, Qt::UniqueConnection);
@@ -1238,121 +1352,21 @@ void DarkLibrary::initView()
     });
 }
 
-///////////////////////////////////////////////////////////////////////////////////////
-///
-///////////////////////////////////////////////////////////////////////////////////////
-void DarkLibrary::aggregate(const QSharedPointer<FITSData> &data)
-{
-    switch (data->dataType())
-    {
-        case TBYTE:
-            aggregateInternal<uint8_t>(data);
-            break;
-
-        case TSHORT:
-            aggregateInternal<int16_t>(data);
-            break;
-
-        case TUSHORT:
-            aggregateInternal<uint16_t>(data);
-            break;
-
-        case TLONG:
-            aggregateInternal<int32_t>(data);
-            break;
-
-        case TULONG:
-            aggregateInternal<uint32_t>(data);
-            break;
-
-        case TFLOAT:
-            aggregateInternal<float>(data);
-            break;
-
-        case TLONGLONG:
-            aggregateInternal<int64_t>(data);
-            break;
-
-        case TDOUBLE:
-            aggregateInternal<double>(data);
-            break;
-
-        default:
-            break;
-    }
-}
-
-///////////////////////////////////////////////////////////////////////////////////////
-///
-///////////////////////////////////////////////////////////////////////////////////////
-template <typename T>
-void DarkLibrary::aggregateInternal(const QSharedPointer<FITSData> &data)
-{
-    T const *darkBuffer  = reinterpret_cast<T const*>(data->getImageBuffer());
-    for (uint32_t i = 0; i < m_DarkMasterBuffer.size(); i++)
-        m_DarkMasterBuffer[i] += darkBuffer[i];
-}
-
 ///////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////
 void DarkLibrary::generateMasterFrame(const QSharedPointer<FITSData> &data, const QJsonObject &metadata)
 {
-    switch (data->dataType())
+    const bool combined = m_DarkCombiner.combine(data->getWritableImageBuffer());
+    // Start over for the next master
+    m_DarkCombiner.reset(m_DarkCombiner.method());
+    if (!combined)
     {
-        case TBYTE:
-            generateMasterFrameInternal<uint8_t>(data, metadata);
-            break;
-
-        case TSHORT:
-            generateMasterFrameInternal<int16_t>(data, metadata);
-            break;
-
-        case TUSHORT:
-            generateMasterFrameInternal<uint16_t>(data, metadata);
-            break;
-
-        case TLONG:
-            generateMasterFrameInternal<int32_t>(data, metadata);
-            break;
-
-        case TULONG:
-            generateMasterFrameInternal<uint32_t>(data, metadata);
-            break;
-
-        case TFLOAT:
-            generateMasterFrameInternal<float>(data, metadata);
-            break;
-
-        case TLONGLONG:
-            generateMasterFrameInternal<int64_t>(data, metadata);
-            break;
-
-        case TDOUBLE:
-            generateMasterFrameInternal<double>(data, metadata);
-            break;
-
-        default:
-            break;
+        m_FileLabel->setText(i18n("Failed to combine dark frames."));
+        return;
     }
 
     emit newImage(data);
-    // Reset Master Buffer
-    m_DarkMasterBuffer.assign(m_DarkMasterBuffer.size(), 0);
-
-}
-
-///////////////////////////////////////////////////////////////////////////////////////
-///
-///////////////////////////////////////////////////////////////////////////////////////
-template <typename T>  void DarkLibrary::generateMasterFrameInternal(const QSharedPointer<FITSData> &data,
-        const QJsonObject &metadata)
-{
-    T *writableBuffer = reinterpret_cast<T *>(data->getWritableImageBuffer());
-    const uint32_t count = metadata["count"].toInt();
-    // Average the values
-    for (uint32_t i = 0; i < m_DarkMasterBuffer.size(); i++)
-        writableBuffer[i] = m_DarkMasterBuffer[i] / count;
 
     QString ts = QDateTime::currentDateTime().toString("yyyy-MM-ddThh-mm-ss");
     QString path = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("darks/darkframe_" + ts +
@@ -1381,9 +1395,16 @@ template <typename T>  void DarkLibrary::generateMasterFrameInternal(const QShar
     map["filename"]    = path;
     map["timestamp"]   = QDateTime::currentDateTime().toString(Qt::ISODate);
 
-    m_DarkFramesDatabaseList.append(map);
+    {
+        QWriteLocker locker(&m_DarkFramesLock);
+        m_DarkFramesDatabaseList.append(map);
+        indexDarkFrame(m_DarkFramesDatabaseList.size() - 1);
+    }
     m_FileLabel->setText(i18n("Master Dark saved to %1", path));
-    KStarsData::Instance()->userdb()->AddDarkFrame(map);
+    KStarsData::Instance()->userdb()->post([map](KSUserDB & db)
+    {
+        return db.AddDarkFrame(map);
+    });
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -1438,6 +1459,7 @@ void DarkLibrary::saveDefectMap()
 
         if (newFile)
         {
+            QWriteLocker locker(&m_DarkFramesLock);
             auto currentMap = std::find_if(m_DarkFramesDatabaseList.begin(),
                                            m_DarkFramesDatabaseList.end(), [&](const QVariantMap & oneMap)
             {
@@ -1448,7 +1470,10 @@ void DarkLibrary::saveDefectMap()
             {
                 (*currentMap)["defectmap"] = filename;
                 (*currentMap)["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
-                KStarsData::Instance()->userdb()->UpdateDarkFrame(*currentMap);
+                KStarsData::Instance()->userdb()->post([frame = *currentMap](KSUserDB & db)
+                {
+                    return db.UpdateDarkFrame(frame);
+                });
             }
         }
     }
@@ -1667,7 +1692,7 @@ void DarkLibrary::loadGlobalSettings()
 
     QVariantMap settings;
     // All Combo Boxes
-    for (auto &oneWidget : findChildren<QComboBox*>())
+    for (auto &oneWidget : m_SettingWidgets.comboBoxes())
     {
         if (oneWidget->objectName() == "opticalTrainCombo")
             continue;
@@ -1682,7 +1707,7 @@ void DarkLibrary::loadGlobalSettings()
     }
 
     // All Double Spin Boxes
-    for (auto &oneWidget : findChildren<QDoubleSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.doubleSpinBoxes())
     {
         key = oneWidget->objectName();
         value = Options::self()->property(key.toLatin1());
@@ -1694,7 +1719,7 @@ void DarkLibrary::loadGlobalSettings()
     }
 
     // All Spin Boxes
-    for (auto &oneWidget : findChildren<QSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.spinBoxes())
     {
         key = oneWidget->objectName();
         value = Options::self()->property(key.toLatin1());
@@ -1706,7 +1731,7 @@ void DarkLibrary::loadGlobalSettings()
     }
 
     // All Checkboxes
-    for (auto &oneWidget : findChildren<QCheckBox*>())
+    for (auto &oneWidget : m_SettingWidgets.checkBoxes())
     {
         key = oneWidget->objectName();
         value = Options::self()->property(key.toLatin1());
@@ -1727,23 +1752,23 @@ void DarkLibrary::loadGlobalSettings()
 void DarkLibrary::connectSettings()
 {
     // All Combo Boxes
-    for (auto &oneWidget : findChildren<QComboBox*>())
+    for (auto &oneWidget : m_SettingWidgets.comboBoxes())
         connect(oneWidget, QOverload<int>::of(&QComboBox::activated), this, &Ekos::DarkLibrary::syncSettings);
 
     // All Double Spin Boxes
-    for (auto &oneWidget : findChildren<QDoubleSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.doubleSpinBoxes())
         connect(oneWidget, &QDoubleSpinBox::editingFinished, this, &Ekos::DarkLibrary::syncSettings);
 
     // All Spin Boxes
-    for (auto &oneWidget : findChildren<QSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.spinBoxes())
         connect(oneWidget, &QSpinBox::editingFinished, this, &Ekos::DarkLibrary::syncSettings);
 
     // All Checkboxes
-    for (auto &oneWidget : findChildren<QCheckBox*>())
+    for (auto &oneWidget : m_SettingWidgets.checkBoxes())
         connect(oneWidget, &QCheckBox::toggled, this, &Ekos::DarkLibrary::syncSettings);
 
     // All Radio buttons
-    for (auto &oneWidget : findChildren<QRadioButton*>())
+    for (auto &oneWidget : m_SettingWidgets.radioButtons())
         connect(oneWidget, &QCheckBox::toggled, this, &Ekos::DarkLibrary::syncSettings);
 
     // Train combo box should NOT be synced.
@@ -1756,23 +1781,23 @@ void DarkLibrary::connectSettings()
 void DarkLibrary::disconnectSettings()
 {
     // All Combo Boxes
-    for (auto &oneWidget : findChildren<QComboBox*>())
+    for (auto &oneWidget : m_SettingWidgets.comboBoxes())
         disconnect(oneWidget, QOverload<int>::of(&QComboBox::activated), this, &Ekos::DarkLibrary::syncSettings);
 
     // All Double Spin Boxes
-    for (auto &oneWidget : findChildren<QDoubleSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.doubleSpinBoxes())
         disconnect(oneWidget, &QDoubleSpinBox::editingFinished, this, &Ekos::DarkLibrary::syncSettings);
 
     // All Spin Boxes
-    for (auto &oneWidget : findChildren<QSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.spinBoxes())
         disconnect(oneWidget, &QSpinBox::editingFinished, this, &Ekos::DarkLibrary::syncSettings);
 
     // All Checkboxes
-    for (auto &oneWidget : findChildren<QCheckBox*>())
+    for (auto &oneWidget : m_SettingWidgets.checkBoxes())
         disconnect(oneWidget, &QCheckBox::toggled, this, &Ekos::DarkLibrary::syncSettings);
 
     // All Radio buttons
-    for (auto &oneWidget : findChildren<QRadioButton*>())
+    for (auto &oneWidget : m_SettingWidgets.radioButtons())
         disconnect(oneWidget, &QCheckBox::toggled, this, &Ekos::DarkLibrary::syncSettings);
 
 }
@@ -1785,19 +1810,19 @@ QVariantMap DarkLibrary::getAllSettings() const
     QVariantMap settings;
 
     // All Combo Boxes
-    for (auto &oneWidget : findChildren<QComboBox*>())
+    for (auto &oneWidget : m_SettingWidgets.comboBoxes())
         settings.insert(oneWidget->objectName(), oneWidget->currentText());
 
     // All Double Spin Boxes
-    for (auto &oneWidget : findChildren<QDoubleSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.doubleSpinBoxes())
         settings.insert(oneWidget->objectName(), oneWidget->value());
 
     // All Spin Boxes
-    for (auto &oneWidget : findChildren<QSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.spinBoxes())
         settings.insert(oneWidget->objectName(), oneWidget->value());
 
     // All Checkboxes
-    for (auto &oneWidget : findChildren<QCheckBox*>())
+    for (auto &oneWidget : m_SettingWidgets.checkBoxes())
         settings.insert(oneWidget->objectName(), oneWidget->isChecked());
 
     return settings;
@@ -1815,7 +1840,7 @@ void DarkLibrary::setAllSettings(const QVariantMap &settings)
     for (auto &name : settings.keys())
     {
         // Combo
-        auto comboBox = findChild<QComboBox*>(name);
+        auto comboBox = qobject_cast<QComboBox*>(m_SettingWidgets.widget(name));
         if (comboBox)
         {
             syncControl(settings, name, comboBox);
@@ -1823,7 +1848,7 @@ void DarkLibrary::setAllSettings(const QVariantMap &settings)
         }
 
         // Double spinbox
-        auto doubleSpinBox = findChild<QDoubleSpinBox*>(name);
+        auto doubleSpinBox = qobject_cast<QDoubleSpinBox*>(m_SettingWidgets.widget(name));
         if (doubleSpinBox)
         {
             syncControl(settings, name, doubleSpinBox);
@@ -1831,7 +1856,7 @@ void DarkLibrary::setAllSettings(const QVariantMap &settings)
         }
 
         // spinbox
-        auto spinBox = findChild<QSpinBox*>(name);
+        auto spinBox = qobject_cast<QSpinBox*>(m_SettingWidgets.widget(name));
         if (spinBox)
         {
             syncControl(settings, name, spinBox);
@@ -1839,7 +1864,7 @@ void DarkLibrary::setAllSettings(const QVariantMap &settings)
         }
 
         // checkbox
-        auto checkbox = findChild<QCheckBox*>(name);
+        auto checkbox = qobject_cast<QCheckBox*>(m_SettingWidgets.widget(name));
         if (checkbox)
         {
             syncControl(settings, name, checkbox);
@@ -1847,7 +1872,7 @@ void DarkLibrary::setAllSettings(const QVariantMap &settings)
         }
 
         // Radio button
-        auto radioButton = findChild<QRadioButton*>(name);
+        auto radioButton = qobject_cast<QRadioButton*>(m_SettingWidgets.widget(name));
         if (radioButton)
         {
             syncControl(settings, name, radioButton);
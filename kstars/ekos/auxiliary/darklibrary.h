@@ -8,12 +8,19 @@
 
 #include "indi/indicamera.h"
 #include "indi/indidustcap.h"
+#include "darkcombiner.h"
 #include "darkview.h"
 #include "defectmap.h"
+#include "settingwidgets.h"
 #include "ekos/ekos.h"
 
+#include <QCache>
 #include <QDialog>
+#include <QMutex>
 #include <QPointer>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QWaitCondition>
 #include "ui_darklibrary.h"
 
 class QSqlTableModel;
@@ -74,6 +81,14 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
          */
         bool findDefectMap(ISD::CameraChip *targetChip, double duration, QSharedPointer<DefectMap> &defectMap);        
 
+        /**
+         * @brief prefetchDarkFrame Load the dark frame findDarkFrame would pick for the passed parameters into the cache
+         * in the background, so it is ready by the time the frame it is meant for is received.
+         * @param targetChip Target Chip
+         * @param duration Exposure duration
+         */
+        void prefetchDarkFrame(ISD::CameraChip *targetChip, double duration);
+
         void refreshFromDB();
         bool setCamera(ISD::Camera *device);
         void removeDevice(const QSharedPointer<ISD::GenericDevice> &device);
@@ -165,13 +180,6 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
          */
         void execute();
 
-        /**
-         * @brief generateMasterFrameHelper Calls templated generateMasterFrame with the correct data type.
-         * @param data Passed dark frame data to generateMasterFrame
-         * @param metadata passed metadata to generateMasterFrame
-         */
-        void generateMasterFrame(const QSharedPointer<FITSData> &data, const QJsonObject &metadata);
-
         /**
          * @brief generateMasterFrame After data aggregation is done, the selected stacking algorithm is applied and the master dark
          * frame is saved to disk and user database along with the metadata.
@@ -179,20 +187,7 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
          * and then save it to disk.
          * @param metadata information on frame to help in the stacking process.
          */
-        template <typename T>  void generateMasterFrameInternal(const QSharedPointer<FITSData> &data, const QJsonObject &metadata);
-
-        /**
-         * @brief aggregateHelper Calls tempelated aggregate function with the appropiate data type.
-         * @param data Dark frame data to pass on to aggregate function.
-         */
-        void aggregate(const QSharedPointer<FITSData> &data);
-
-        /**
-         * @brief aggregate Aggregate the data as per the selected algorithm. Each time a new dark frame is received, this function
-         * adds the frame data to the dark buffer.
-         * @param data Dark frame data.
-         */
-        template <typename T> void aggregateInternal(const QSharedPointer<FITSData> &data);
+        void generateMasterFrame(const QSharedPointer<FITSData> &data, const QJsonObject &metadata);
 
         /**
          * @brief cacheDarkFrameFromFile Load dark frame from disk and saves it in the local dark frames cache
@@ -201,6 +196,13 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
          */
         bool cacheDarkFrameFromFile(const QString &filename);
 
+        /**
+         * @brief loadDarkFrame Get a dark frame from the cache, loading it from disk if needed. Safe to call from any thread.
+         * @param filename path of dark frame to load
+         * @return Loaded dark frame, or null if it could not be loaded.
+         */
+        QSharedPointer<FITSData> loadDarkFrame(const QString &filename);
+
 
         ////////////////////////////////////////////////////////////////////////////////////////////////
         /// Misc Functions
@@ -236,6 +238,41 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
          */
         bool cacheDefectMapFromFile(const QString &key, const QString &filename);
 
+        /**
+         * @brief loadDefectMap Get a defect map from the cache, loading it from disk if needed. Safe to call from any thread.
+         * @param key Key to use in the cache, the filename of the dark frame of the defect map
+         * @param filename path of defect map to load
+         * @return Loaded defect map, or null if it could not be loaded.
+         */
+        QSharedPointer<DefectMap> loadDefectMap(const QString &key, const QString &filename);
+
+        /**
+         * @brief removeFromCache Drop a deleted master and its defect map from the caches.
+         * @param filename path of the dark frame
+         */
+        void removeFromCache(const QString &filename);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////
+        /// Dark Frames Index
+        ////////////////////////////////////////////////////////////////////////////////////////////////
+        static QString darkFrameIndexKey(const QString &camera, int chip, int binX, int binY);
+
+        /**
+         * @brief indexDarkFrame Add a row of the dark frames database list to the index.
+         */
+        void indexDarkFrame(int row);
+
+        /**
+         * @brief findBestDarkFrame Find the best database row for a camera, chip and binning.
+         * @param key Index key of the camera, chip and binning.
+         * @param duration Exposure duration. Closest durations always win.
+         * @param accept Predicate rejecting unsuitable rows.
+         * @param better Predicate telling whether a row beats the best so far, among rows as close in duration.
+         * @return Row in the database list, or -1 if none was accepted.
+         */
+        template <typename Accept, typename Better>
+        int findBestDarkFrame(const QString &key, double duration, Accept accept, Better better) const;
+
         ////////////////////////////////////////////////////////////////////
         /// Settings
         ////////////////////////////////////////////////////////////////////
@@ -273,8 +310,25 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
         ////////////////////////////////////////////////////////////////////////////////////////////////
 
         QList<QVariantMap> m_DarkFramesDatabaseList;
-        QMap<QString, QSharedPointer<FITSData>> m_CachedDarkFrames;
-        QMap<QString, QSharedPointer<DefectMap>> m_CachedDefectMaps;
+        struct DarkFrameIndexEntry
+        {
+            double duration;
+            // Row in m_DarkFramesDatabaseList
+            int row;
+        };
+        // Rows of m_DarkFramesDatabaseList per camera, chip and binning, sorted by duration.
+        QHash<QString, QVector<DarkFrameIndexEntry>> m_DarkFramesIndex;
+        // Guards the database list and its index, which are searched from the threads of the dark processors.
+        QReadWriteLock m_DarkFramesLock;
+        // Masters loaded from disk, keyed by filename. Least recently used ones are evicted first once the
+        // dark frames exceed Options::darkLibraryCacheSize(), their cost being their size in KiB.
+        QCache<QString, QSharedPointer<FITSData>> m_CachedDarkFrames;
+        QCache<QString, QSharedPointer<DefectMap>> m_CachedDefectMaps;
+        // Guards the caches, which are also used from the threads of the dark processors.
+        QMutex m_CacheMutex;
+        // Dark frames being loaded by some thread, so other threads wait for them instead of loading them again.
+        QSet<QString> m_LoadingDarkFrames;
+        QWaitCondition m_DarkFrameLoaded;
 
         ISD::Camera *m_Camera {nullptr};
         ISD::CameraChip *m_TargetChip {nullptr};
@@ -285,7 +339,7 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
         QSqlTableModel *darkFramesModel = nullptr;
         QSortFilterProxyModel *sortFilter = nullptr;
 
-        std::vector<uint32_t> m_DarkMasterBuffer;
+        DarkCombiner m_DarkCombiner;
         uint32_t m_DarkImagesCounter {0};
         bool m_RememberFITSViewer {true};
         bool m_RememberSummaryView {true};
@@ -302,8 +356,11 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
         // Settings
         QVariantMap m_Settings;
         QVariantMap m_GlobalSettings;
+        SettingWidgets m_SettingWidgets;
 
         // Do not add to cache if system memory falls below 250MB.
         static constexpr uint16_t CACHE_MEMORY_LIMIT {250};
+        // Defect maps are small, keep up to this many of them.
+        static constexpr uint16_t DEFECT_MAP_CACHE_SIZE {16};
 };
 }
@@ -7,11 +7,187 @@
 #include "darkprocessor.h"
 #include "darklibrary.h"
 #include "ekos/auxiliary/opticaltrainsettings.h"
+#include "auxiliary/kstrace.h"
+#include "auxiliary/processinglanes.h"
 
+#include <QtConcurrent>
+
+#include <algorithm>
 #include <array>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KSTARS_DARK_SIMD_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define KSTARS_DARK_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 #include "ekos_debug.h"
 
+namespace
+{
+
+// Don't bother other threads for fewer samples than this.
+constexpr uint32_t MinBandSamples = 1 << 16;
+
+// Light samples below the dark are clipped to zero, as are NaN floating point samples.
+template <typename T>
+void subtractRowScalar(T *light, const T *dark, uint32_t count)
+{
+    for (uint32_t x = 0; x < count; x++)
+        light[x] = (light[x] > dark[x]) ? (light[x] - dark[x]) : 0;
+}
+
+#if defined(KSTARS_DARK_SIMD_X86)
+bool cpuHasAVX2()
+{
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+    return hasAVX2;
+}
+
+__attribute__((target("avx2")))
+void subtractRowAVX2(uint8_t *light, const uint8_t *dark, uint32_t count)
+{
+    const uint32_t vectorCount = count / 32;
+    for (uint32_t i = 0; i < vectorCount * 32; i += 32)
+    {
+        const __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(light + i));
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dark + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(light + i), _mm256_subs_epu8(l, d));
+    }
+    subtractRowScalar(light + vectorCount * 32, dark + vectorCount * 32, count - vectorCount * 32);
+}
+
+__attribute__((target("avx2")))
+void subtractRowAVX2(uint16_t *light, const uint16_t *dark, uint32_t count)
+{
+    const uint32_t vectorCount = count / 16;
+    for (uint32_t i = 0; i < vectorCount * 16; i += 16)
+    {
+        const __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(light + i));
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dark + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(light + i), _mm256_subs_epu16(l, d));
+    }
+    subtractRowScalar(light + vectorCount * 16, dark + vectorCount * 16, count - vectorCount * 16);
+}
+
+__attribute__((target("avx2")))
+void subtractRowAVX2(float *light, const float *dark, uint32_t count)
+{
+    const uint32_t vectorCount = count / 8;
+    const __m256 zero = _mm256_setzero_ps();
+    for (uint32_t i = 0; i < vectorCount * 8; i += 8)
+    {
+        const __m256 difference = _mm256_sub_ps(_mm256_loadu_ps(light + i), _mm256_loadu_ps(dark + i));
+        // Returns the second operand when the first is NaN, so NaN samples are clipped too.
+        _mm256_storeu_ps(light + i, _mm256_max_ps(difference, zero));
+    }
+    subtractRowScalar(light + vectorCount * 8, dark + vectorCount * 8, count - vectorCount * 8);
+}
+#endif
+
+#if defined(KSTARS_DARK_SIMD_NEON)
+void subtractRowNEON(uint8_t *light, const uint8_t *dark, uint32_t count)
+{
+    const uint32_t vectorCount = count / 16;
+    for (uint32_t i = 0; i < vectorCount * 16; i += 16)
+        vst1q_u8(light + i, vqsubq_u8(vld1q_u8(light + i), vld1q_u8(dark + i)));
+    subtractRowScalar(light + vectorCount * 16, dark + vectorCount * 16, count - vectorCount * 16);
+}
+
+void subtractRowNEON(uint16_t *light, const uint16_t *dark, uint32_t count)
+{
+    const uint32_t vectorCount = count / 8;
+    for (uint32_t i = 0; i < vectorCount * 8; i += 8)
+        vst1q_u16(light + i, vqsubq_u16(vld1q_u16(light + i), vld1q_u16(dark + i)));
+    subtractRowScalar(light + vectorCount * 8, dark + vectorCount * 8, count - vectorCount * 8);
+}
+
+void subtractRowNEON(float *light, const float *dark, uint32_t count)
+{
+    const uint32_t vectorCount = count / 4;
+    const float32x4_t zero = vdupq_n_f32(0);
+    for (uint32_t i = 0; i < vectorCount * 4; i += 4)
+    {
+        const float32x4_t difference = vsubq_f32(vld1q_f32(light + i), vld1q_f32(dark + i));
+        // Keep the difference only where it is strictly positive, which also drops NaN samples.
+        const uint32x4_t positive = vcgtq_f32(difference, zero);
+        vst1q_f32(light + i, vbslq_f32(positive, difference, zero));
+    }
+    subtractRowScalar(light + vectorCount * 4, dark + vectorCount * 4, count - vectorCount * 4);
+}
+#endif
+
+template <typename T>
+void subtractRowDispatch(T *light, const T *dark, uint32_t count)
+{
+#if defined(KSTARS_DARK_SIMD_X86)
+    if (cpuHasAVX2())
+        return subtractRowAVX2(light, dark, count);
+    subtractRowScalar(light, dark, count);
+#elif defined(KSTARS_DARK_SIMD_NEON)
+    subtractRowNEON(light, dark, count);
+#else
+    subtractRowScalar(light, dark, count);
+#endif
+}
+
+// Vectorized kernels exist for the common camera data types, everything else uses the scalar loop.
+template <typename T>
+void subtractRow(T *light, const T *dark, uint32_t count)
+{
+    subtractRowScalar(light, dark, count);
+}
+
+template <>
+void subtractRow(uint8_t *light, const uint8_t *dark, uint32_t count)
+{
+    subtractRowDispatch(light, dark, count);
+}
+
+template <>
+void subtractRow(uint16_t *light, const uint16_t *dark, uint32_t count)
+{
+    subtractRowDispatch(light, dark, count);
+}
+
+template <>
+void subtractRow(float *light, const float *dark, uint32_t count)
+{
+    subtractRowDispatch(light, dark, count);
+}
+
+// Run function(firstRow, lastRow) over bands of rows in the lane of the frame and wait for all of them.
+template <typename Function>
+void runRowBands(uint32_t height, uint32_t width, Function function)
+{
+    const ProcessingLanes::Lane lane = ProcessingLanes::current();
+    const uint32_t maxBands = static_cast<uint32_t>(qMax(1, ProcessingLanes::pool(lane)->maxThreadCount()));
+    const uint64_t samples = static_cast<uint64_t>(width) * height;
+    const uint32_t bands = static_cast<uint32_t>(qBound<uint64_t>(1, samples / MinBandSamples, qMin(maxBands, qMax(1u, height))));
+    if (bands <= 1)
+    {
+        function(0, height);
+        return;
+    }
+
+    const uint32_t rowsPerBand = (height + bands - 1) / bands;
+    QList<QFuture<void>> futures;
+    for (uint32_t first = 0; first < height; first += rowsPerBand)
+    {
+        const uint32_t last = qMin(height, first + rowsPerBand);
+        futures.append(ProcessingLanes::run(lane, [ = ]()
+        {
+            function(first, last);
+        }));
+    }
+    for (auto &future : futures)
+        future.waitForFinished();
+}
+
+}
+
 namespace Ekos
 {
 
@@ -76,35 +252,31 @@ template <typename T>
 void DarkProcessor::normalizeDefectsInternal(const QSharedPointer<DefectMap> &defectMap,
         const QSharedPointer<FITSData> &lightData, uint16_t offsetX, uint16_t offsetY)
 {
+    KSTRACE_SCOPE("dark", "normalizeDefects");
 
     T *lightBuffer = reinterpret_cast<T *>(lightData->getWritableImageBuffer());
     const uint32_t width = lightData->width();
+    const uint32_t height = lightData->height();
 
     // Account for offset X and Y
     // e.g. if we send a subframed light frame 100x100 pixels wide
     // but the source defect map covers 1000x1000 pixels array, then we need to only compensate
     // for the 100x100 region.
-    for (BadPixelSet::const_iterator onePixel = defectMap->hotThreshold();
-            onePixel != defectMap->hotPixels().cend(); ++onePixel)
+    // Defects are sorted by row, so skip straight to the first row of the region and stop after its last one.
+    const std::vector<BadPixel> &defects = defectMap->sortedDefects();
+    auto onePixel = std::lower_bound(defects.cbegin(), defects.cend(), offsetY + 1, [](const BadPixel & pixel, uint32_t y)
     {
-        const uint16_t x = (*onePixel).x;
-        const uint16_t y = (*onePixel).y;
-
-        if (x <= offsetX || y <= offsetY)
-            continue;
-
-        uint32_t offset = (x - offsetX) + (y - offsetY) * width;
-
-        lightBuffer[offset] = median3x3Filter(x - offsetX, y - offsetY, width, lightBuffer);
-    }
-
-    for (BadPixelSet::const_iterator onePixel = defectMap->coldPixels().cbegin();
-            onePixel != defectMap->coldThreshold(); ++onePixel)
+        return pixel.y < y;
+    });
+    for (; onePixel != defects.cend(); ++onePixel)
     {
-        const uint16_t x = (*onePixel).x;
-        const uint16_t y = (*onePixel).y;
+        const uint32_t x = (*onePixel).x;
+        const uint32_t y = (*onePixel).y;
 
-        if (x <= offsetX || y <= offsetY)
+        // The 3x3 filter needs a neighbour on every side.
+        if (y + 2 > offsetY + height)
+            break;
+        if (x <= offsetX || x + 2 > offsetX + width)
             continue;
 
         uint32_t offset = (x - offsetX) + (y - offsetY) * width;
@@ -198,6 +370,7 @@ template <typename T>
 void DarkProcessor::subtractInternal(const QSharedPointer<FITSData> &darkData, const QSharedPointer<FITSData> &lightData,
                                      uint16_t offsetX, uint16_t offsetY)
 {
+    KSTRACE_SCOPE("dark", "subtractDark");
     const uint32_t width = lightData->width();
     const uint32_t height = lightData->height();
     T *lightBuffer = reinterpret_cast<T *>(lightData->getWritableImageBuffer());
@@ -206,14 +379,11 @@ void DarkProcessor::subtractInternal(const QSharedPointer<FITSData> &darkData, c
     const uint32_t darkoffset = offsetX + offsetY * darkStride;
     T const *darkBuffer  = reinterpret_cast<T const*>(darkData->getImageBuffer()) + darkoffset;
 
-    for (uint32_t y = 0; y < height; y++)
+    runRowBands(height, width, [ = ](uint32_t firstRow, uint32_t lastRow)
     {
-        for (uint32_t x = 0; x < width; x++)
-            lightBuffer[x] = (lightBuffer[x] > darkBuffer[x]) ? (lightBuffer[x] - darkBuffer[x]) : 0;
-
-        lightBuffer += width;
-        darkBuffer += darkStride;
-    }
+        for (uint32_t y = firstRow; y < lastRow; y++)
+            subtractRow(lightBuffer + static_cast<size_t>(y) * width, darkBuffer + static_cast<size_t>(y) * darkStride, width);
+    });
 
     lightData->calculateStats(true);
 }
@@ -233,7 +403,11 @@ void DarkProcessor::denoise(int trainID, ISD::CameraChip *m_TargetChip, const QS
     if (settings.isValid())
         useDefect = settings.toMap().contains("preferDefectsRadio");
 
-    QFuture<bool> result = QtConcurrent::run(this, &DarkProcessor::denoiseInternal, useDefect);
+    // The frame is calibrated in the lane of the module it is for, so guide frames don't wait for others
+    QFuture<bool> result = ProcessingLanes::run(targetData->lane(), [this, useDefect]()
+    {
+        return denoiseInternal(useDefect);
+    });
     m_Watcher.setFuture(result);
 }
 
@@ -242,6 +416,7 @@ void DarkProcessor::denoise(int trainID, ISD::CameraChip *m_TargetChip, const QS
 ///////////////////////////////////////////////////////////////////////////////////////
 bool DarkProcessor::denoiseInternal(bool useDefect)
 {
+    KSTRACE_SCOPE("dark", "denoise");
     // Check if we have preference for defect map
     // If yes, check if defect map exists
     // If not, we check if we have regular dark frame as backup.
@@ -24,7 +24,7 @@ QJsonObject BadPixel::json() const
 //////////////////////////////////////////////////////////////////////////////
 ///
 //////////////////////////////////////////////////////////////////////////////
-DefectMap::DefectMap() : QObject()
+DefectMap::DefectMap() : QObject(), m_ColdPixelsThreshold(m_ColdPixels.cbegin()), m_HotPixelsThreshold(m_HotPixels.cend())
 {
 
 }
@@ -58,6 +58,10 @@ bool DefectMap::load(const QString &filename)
 
     m_HotPixels.clear();
     m_ColdPixels.clear();
+    // Nothing passes the thresholds until the pixels are filtered again.
+    m_HotPixelsThreshold = m_HotPixels.cend();
+    m_ColdPixelsThreshold = m_ColdPixels.cbegin();
+    m_SortedDefects.clear();
 
     for (const auto &onePixel : qAsConst(hot))
     {
@@ -264,6 +268,7 @@ void DefectMap::filterPixels()
     else
         m_ColdPixelsCount = std::distance(m_ColdPixels.cbegin(), m_ColdPixelsThreshold);
 
+    updateSortedDefects();
     emit pixelsUpdated(m_HotPixelsCount, m_ColdPixelsCount);
 }
 
@@ -273,6 +278,7 @@ void DefectMap::filterPixels()
 void DefectMap::setHotEnabled(bool enabled)
 {
     m_HotEnabled = enabled;
+    updateSortedDefects();
     emit pixelsUpdated(m_HotEnabled ? m_HotPixelsCount : 0, m_ColdPixelsCount);
 }
 
@@ -282,5 +288,22 @@ void DefectMap::setHotEnabled(bool enabled)
 void DefectMap::setColdEnabled(bool enabled)
 {
     m_ColdEnabled = enabled;
+    updateSortedDefects();
     emit pixelsUpdated(m_HotPixelsCount, m_ColdEnabled ? m_ColdPixelsCount : 0);
 }
+
+//////////////////////////////////////////////////////////////////////////////
+///
+//////////////////////////////////////////////////////////////////////////////
+void DefectMap::updateSortedDefects()
+{
+    m_SortedDefects.clear();
+    m_SortedDefects.reserve((m_HotEnabled ? m_HotPixelsCount : 0) + (m_ColdEnabled ? m_ColdPixelsCount : 0));
+    m_SortedDefects.insert(m_SortedDefects.end(), hotThreshold(), m_HotPixels.cend());
+    m_SortedDefects.insert(m_SortedDefects.end(), m_ColdPixels.cbegin(), coldThreshold());
+
+    std::sort(m_SortedDefects.begin(), m_SortedDefects.end(), [](const BadPixel & a, const BadPixel & b)
+    {
+        return a.y < b.y || (a.y == b.y && a.x < b.x);
+    });
+}
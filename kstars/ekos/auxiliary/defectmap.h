@@ -7,6 +7,7 @@
 #pragma once
 
 #include <set>
+#include <vector>
 #include <QJsonObject>
 #include <QJsonArray>
 
@@ -89,6 +90,13 @@ class DefectMap : public QObject
         {
             return m_ColdPixelsCount;
         }
+        /**
+         * @brief sortedDefects Enabled hot and cold pixels past their thresholds, sorted by row then column.
+         */
+        const std::vector<BadPixel> &sortedDefects() const
+        {
+            return m_SortedDefects;
+        }
 
         void filterPixels();
     signals:
@@ -102,9 +110,12 @@ class DefectMap : public QObject
         double calculateSigma(uint8_t aggressiveness);
         template <typename T>
         void initBadPixelsInternal(double hotPixelThreshold, double coldPixelThreshold);
+        void updateSortedDefects();
 
         BadPixelSet m_ColdPixels, m_HotPixels;
         BadPixelSet::const_iterator m_ColdPixelsThreshold, m_HotPixelsThreshold;
+        // Defects to correct in memory order, rebuilt whenever the thresholds or enabled sets change.
+        std::vector<BadPixel> m_SortedDefects;
         uint8_t m_HotPixelsAggressiveness {75}, m_ColdPixelsAggressiveness {75};
         uint32_t m_HotPixelsCount {0}, m_ColdPixelsCount {0};
         double m_HotSigma {0}, m_ColdSigma {0};
@@ -446,7 +446,12 @@ void FilterManager::updateProperty(INDI::Property prop)
         refreshFilterPosition();
 
         if (state == FILTER_CHANGE)
-            executeOperationQueue();
+        {
+            m_FilterMovePending = false;
+            // Wait for the focuser if its offset is applied together with the filter change
+            if (!m_OffsetPending)
+                executeOperationQueue();
+        }
         // If filter is changed externally, record its current offset as the starting offset.
         else if (state == FILTER_IDLE && m_ActiveFilters.count() >= m_currentFilterPosition)
             lastFilterOffset = m_ActiveFilters[m_currentFilterPosition - 1]->offset();
@@ -466,6 +471,7 @@ void FilterManager::buildOperationQueue(FilterState operation)
 {
     operationQueue.clear();
     m_useTargetFilter = false;
+    m_OffsetWithChange = m_FilterMovePending = m_OffsetPending = false;
 
     switch (operation)
     {
@@ -478,7 +484,13 @@ void FilterManager::buildOperationQueue(FilterState operation)
             {
                 operationQueue.enqueue(FILTER_CHANGE);
                 if (m_FocusReady && (m_Policy & OFFSET_POLICY))
-                    operationQueue.enqueue(FILTER_OFFSET);
+                {
+                    // The offset does not need the new filter in place, so move the focuser alongside the wheel if possible
+                    if (canOffsetDuringChange())
+                        m_OffsetWithChange = true;
+                    else
+                        operationQueue.enqueue(FILTER_OFFSET);
+                }
                 else
                 {
                     // Keep track of filter and offset either here or after the offset has been processed
@@ -523,9 +535,16 @@ bool FilterManager::executeOperationQueue()
             if (m_useTargetFilter)
                 targetFilterPosition = m_ActiveFilters.indexOf(targetFilter) + 1;
             m_FilterWheel->setPosition(targetFilterPosition);
+            m_FilterMovePending = true;
 
             emit newStatus(state);
 
+            if (m_OffsetWithChange)
+            {
+                m_OffsetWithChange = false;
+                m_OffsetPending = startFocusOffset();
+            }
+
             if (m_FilterConfirmSet)
             {
                 connect(KSMessageBox::Instance(), &KSMessageBox::accepted, this, [this]()
@@ -551,20 +570,9 @@ bool FilterManager::executeOperationQueue()
         case FILTER_OFFSET:
         {
             state = FILTER_OFFSET;
-            if (m_useTargetFilter)
-            {
-                targetFilterOffset = targetFilter->offset() - lastFilterOffset;
-                lastFilterOffset   = targetFilter->offset();
-                currentFilter = targetFilter;
-                m_useTargetFilter = false;
-            }
-            if (targetFilterOffset == 0)
-                actionRequired = false;
-            else
-            {
-                emit newFocusOffset(targetFilterOffset, false);
+            actionRequired = startFocusOffset();
+            if (actionRequired)
                 emit newStatus(state);
-            }
         }
         break;
 
@@ -600,10 +608,41 @@ bool FilterManager::executeOneOperation(FilterState operation)
     return actionRequired;
 }
 
+bool FilterManager::canOffsetDuringChange() const
+{
+    // A filter wheel built into the focuser may not move both at once, and a manual
+    // filter change has to be confirmed before anything else moves.
+    return !m_FocuserName.isEmpty() && m_FilterWheel != nullptr && m_FocuserName != m_FilterWheel->getDeviceName()
+           && m_FilterConfirmSet == nullptr;
+}
+
+bool FilterManager::startFocusOffset()
+{
+    if (m_useTargetFilter)
+    {
+        targetFilterOffset = targetFilter->offset() - lastFilterOffset;
+        lastFilterOffset   = targetFilter->offset();
+        currentFilter = targetFilter;
+        m_useTargetFilter = false;
+    }
+    if (targetFilterOffset == 0)
+        return false;
+
+    emit newFocusOffset(targetFilterOffset, false);
+    return true;
+}
+
 void FilterManager::setFocusOffsetComplete()
 {
     if (state == FILTER_OFFSET)
         executeOperationQueue();
+    else if (state == FILTER_CHANGE && m_OffsetPending)
+    {
+        m_OffsetPending = false;
+        // Wait for the filter wheel if it is still moving
+        if (!m_FilterMovePending)
+            executeOperationQueue();
+    }
 }
 
 double FilterManager::getFilterExposure(const QString &name) const
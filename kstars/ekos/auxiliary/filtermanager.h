@@ -181,10 +181,12 @@ class FilterManager : public QDialog, public Ui::FilterSettings
         /**
          * @brief setFocusReady Set whether a focuser device is active and in use.
          * @param enabled true if focus is ready, false otherwise.
+         * @param focuserName device name of the focuser, used to tell whether it can move together with the filter wheel.
          */
-        void setFocusReady(bool enabled)
+        void setFocusReady(bool enabled, const QString &focuserName = QString())
         {
             m_FocusReady = enabled;
+            m_FocuserName = focuserName;
         }
 
 
@@ -299,6 +301,10 @@ class FilterManager : public QDialog, public Ui::FilterSettings
         void buildOperationQueue(FilterState operation);
         bool executeOperationQueue();
         bool executeOneOperation(FilterState operation);
+        // Whether the focuser offset can be applied while the filter wheel moves
+        bool canOffsetDuringChange() const;
+        // Request the focuser offset of the target filter, returns false if there is nothing to move
+        bool startFocusOffset();
 
         // Update model
         void syncDBToINDI();
@@ -317,6 +323,11 @@ class FilterManager : public QDialog, public Ui::FilterSettings
 
 
         bool m_FocusReady { false };
+        QString m_FocuserName;
+        // Filter change and focuser offset issued together, and which of them are still moving
+        bool m_OffsetWithChange { false };
+        bool m_FilterMovePending { false };
+        bool m_OffsetPending { false };
         bool m_FocusAbsPositionPending { false};
         int m_FocusAbsPosition { -1 };
 
@@ -0,0 +1,309 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "framerecorder.h"
+
+#include "Options.h"
+#include "auxiliary/kspaths.h"
+#include "fitsviewer/fitsdata.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QtConcurrent>
+
+#include <cstdlib>
+
+#include <ekos_debug.h>
+
+namespace
+{
+const QByteArray g_Magic("KSFRAMES");
+constexpr quint32 g_Version = 1;
+constexpr QDataStream::Version g_StreamVersion = QDataStream::Qt_5_12;
+// Fast compression, the frames come in while the session runs
+constexpr int g_CompressionLevel = 1;
+}
+
+namespace Ekos
+{
+
+FrameRecorder::FrameRecorder()
+{
+    m_WriterPool.setMaxThreadCount(1);
+}
+
+FrameRecorder::~FrameRecorder()
+{
+    close();
+}
+
+FrameRecorder *FrameRecorder::Instance()
+{
+    static FrameRecorder recorder;
+    return &recorder;
+}
+
+void FrameRecorder::record(Source source, const QSharedPointer<FITSData> &imageData, const QVariantMap &metadata)
+{
+    if (!Options::recordEkosFrames())
+    {
+        if (isOpen())
+            close();
+        return;
+    }
+    if (imageData.isNull() || imageData->getImageBuffer() == nullptr)
+        return;
+    if (!isOpen() && !open(nextFilename()))
+        return;
+
+    if (m_Pending.load() >= MAX_PENDING)
+    {
+        if (!m_Dropping)
+            qCWarning(KSTARS_EKOS) << "Frames come in faster than they can be recorded, dropping frames.";
+        m_Dropping = true;
+        return;
+    }
+    m_Dropping = false;
+
+    Frame frame;
+    frame.source = source;
+    frame.timestamp = m_Clock.elapsed();
+    frame.metadata = metadata;
+    QVariant exposure;
+    if (imageData->getRecordValue("EXPTIME", exposure))
+        frame.exposure = exposure.toDouble();
+
+    // The modules go on processing the frame, keep the pixels as they are now
+    const FITSImage::Statistic &stats = imageData->getStatistics();
+    const QByteArray pixels(reinterpret_cast<const char *>(imageData->getImageBuffer()),
+                            static_cast<qint64>(stats.samples_per_channel) * stats.channels * stats.bytesPerPixel);
+    const uint32_t dataType = stats.dataType;
+    const int width = stats.width, height = stats.height, channels = stats.channels;
+
+    m_Pending++;
+    QtConcurrent::run(&m_WriterPool, [this, frame, pixels, dataType, width, height, channels]() mutable
+    {
+        frame.fits = toFITS(dataType, width, height, channels, pixels);
+        if (!frame.fits.isEmpty())
+            write(frame);
+        m_Pending--;
+    });
+}
+
+bool FrameRecorder::open(const QString &filename)
+{
+    close();
+
+    QMutexLocker locker(&m_Mutex);
+    m_File.setFileName(filename);
+    if (!m_File.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qCWarning(KSTARS_EKOS) << "Cannot record frames to" << filename << m_File.errorString();
+        return false;
+    }
+
+    QDataStream out(&m_File);
+    out.setVersion(g_StreamVersion);
+    out.writeRawData(g_Magic.constData(), g_Magic.size());
+    out << g_Version;
+    m_File.flush();
+    m_Clock.start();
+    qCInfo(KSTARS_EKOS) << "Recording guide and focus frames to" << filename;
+    return true;
+}
+
+bool FrameRecorder::write(const Frame &frame)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream.setVersion(g_StreamVersion);
+    stream << static_cast<quint8>(frame.source) << frame.timestamp << frame.exposure << frame.metadata
+           << qCompress(frame.fits, g_CompressionLevel);
+
+    QMutexLocker locker(&m_Mutex);
+    if (!m_File.isOpen())
+        return false;
+
+    // Each frame is flushed with its size first, a frame cut short is then told apart from the next
+    QDataStream out(&m_File);
+    out.setVersion(g_StreamVersion);
+    out << static_cast<quint32>(record.size());
+    if (out.writeRawData(record.constData(), record.size()) != record.size() || !m_File.flush())
+    {
+        qCWarning(KSTARS_EKOS) << "Cannot record frames to" << m_File.fileName() << m_File.errorString();
+        return false;
+    }
+    return true;
+}
+
+void FrameRecorder::close()
+{
+    m_WriterPool.waitForDone();
+
+    QMutexLocker locker(&m_Mutex);
+    if (m_File.isOpen())
+    {
+        qCInfo(KSTARS_EKOS) << "Recorded guide and focus frames to" << m_File.fileName();
+        m_File.close();
+    }
+}
+
+bool FrameRecorder::isOpen() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_File.isOpen();
+}
+
+QString FrameRecorder::filename() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_File.fileName();
+}
+
+QString FrameRecorder::nextFilename() const
+{
+    const QString path = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("frames");
+    QDir().mkpath(path);
+    // No colons, they are illegal on Windows
+    return QDir(path).filePath(QString("frames_%1.ksframes").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss")));
+}
+
+QByteArray FrameRecorder::toFITS(uint32_t dataType, int width, int height, int channels, const QByteArray &pixels)
+{
+    int bitpix = 0, type = 0;
+    switch (dataType)
+    {
+        case TBYTE:
+            bitpix = BYTE_IMG;
+            type = TBYTE;
+            break;
+        case TSHORT:
+            bitpix = SHORT_IMG;
+            type = TSHORT;
+            break;
+        case TUSHORT:
+            bitpix = USHORT_IMG;
+            type = TUSHORT;
+            break;
+        // FITSData keeps 32-bit integers, which are C ints for cfitsio
+        case TLONG:
+            bitpix = LONG_IMG;
+            type = TINT;
+            break;
+        case TULONG:
+            bitpix = ULONG_IMG;
+            type = TUINT;
+            break;
+        case TFLOAT:
+            bitpix = FLOAT_IMG;
+            type = TFLOAT;
+            break;
+        case TLONGLONG:
+            bitpix = LONGLONG_IMG;
+            type = TLONGLONG;
+            break;
+        case TDOUBLE:
+            bitpix = DOUBLE_IMG;
+            type = TDOUBLE;
+            break;
+        default:
+            return QByteArray();
+    }
+
+    const long elements = static_cast<long>(width) * height * channels;
+    if (elements <= 0 || pixels.size() < elements * (std::abs(bitpix) / 8))
+        return QByteArray();
+
+    fitsfile *fptr = nullptr;
+    int status = 0;
+    void *buffer = nullptr;
+    size_t bufferSize = 0;
+    long naxes[3] = {width, height, channels};
+    fits_create_memfile(&fptr, &buffer, &bufferSize, 2880, realloc, &status);
+    fits_create_img(fptr, bitpix, channels > 1 ? 3 : 2, naxes, &status);
+    fits_write_img(fptr, type, 1, elements, const_cast<char *>(pixels.constData()), &status);
+    fits_flush_file(fptr, &status);
+
+    QByteArray fits;
+    if (status == 0)
+        fits = QByteArray(static_cast<const char *>(buffer), bufferSize);
+    else
+    {
+        char error[FLEN_STATUS] = {0};
+        fits_get_errstatus(status, error);
+        qCWarning(KSTARS_EKOS) << "Cannot encode recorded frame:" << error;
+    }
+
+    if (fptr)
+    {
+        status = 0;
+        fits_close_file(fptr, &status);
+    }
+    free(buffer);
+    return fits;
+}
+
+bool FrameReader::open(const QString &filename)
+{
+    m_File.close();
+    m_File.setFileName(filename);
+    if (!m_File.open(QIODevice::ReadOnly))
+    {
+        m_Error = m_File.errorString();
+        return false;
+    }
+
+    QDataStream in(&m_File);
+    in.setVersion(g_StreamVersion);
+    QByteArray magic(g_Magic.size(), '\0');
+    quint32 version = 0;
+    if (in.readRawData(magic.data(), magic.size()) != magic.size() || magic != g_Magic)
+    {
+        m_Error = QString("%1 is not a frame recording").arg(filename);
+        m_File.close();
+        return false;
+    }
+    in >> version;
+    if (version != g_Version)
+    {
+        m_Error = QString("Unsupported frame recording version %1").arg(version);
+        m_File.close();
+        return false;
+    }
+    m_Error.clear();
+    return true;
+}
+
+bool FrameReader::next(FrameRecorder::Frame &frame)
+{
+    if (!m_File.isOpen())
+        return false;
+
+    QDataStream in(&m_File);
+    in.setVersion(g_StreamVersion);
+    quint32 size = 0;
+    in >> size;
+    if (in.status() != QDataStream::Ok || size > m_File.bytesAvailable())
+        return false;
+
+    const QByteArray record = m_File.read(size);
+    QDataStream stream(record);
+    stream.setVersion(g_StreamVersion);
+    quint8 source = 0;
+    QByteArray compressed;
+    stream >> source >> frame.timestamp >> frame.exposure >> frame.metadata >> compressed;
+    if (stream.status() != QDataStream::Ok)
+    {
+        m_Error = QString("Corrupt frame at offset %1").arg(m_File.pos() - size);
+        return false;
+    }
+    frame.source = static_cast<FrameRecorder::Source>(source);
+    frame.fits = qUncompress(compressed);
+    return !frame.fits.isEmpty();
+}
+
+}
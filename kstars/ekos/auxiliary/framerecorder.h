@@ -0,0 +1,126 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <QVariantMap>
+
+#include <atomic>
+
+class FITSData;
+
+namespace Ekos
+{
+
+/**
+ * @class FrameRecorder
+ * @short Records the guide and focus frames of a session to replay them offline.
+ *
+ * Each frame is kept as a FITS image with the time it came in, its exposure and the state of the
+ * module that received it, such as the focuser position. Frames are appended to one compact
+ * sequence file, compressed, and the file is flushed after each frame so that a recording cut
+ * short by a crash is still readable up to its last complete frame. FrameReader reads it back.
+ *
+ * Modules hand their frames to the shared Instance(), which records them while the
+ * RecordEkosFrames option is set. The pixels are copied at once; the FITS encoding, compression
+ * and writing run on a thread of their own, in order, so the modules don't wait on the disk.
+ */
+class FrameRecorder
+{
+    public:
+        typedef enum
+        {
+            GUIDE,
+            FOCUS
+        } Source;
+
+        struct Frame
+        {
+            Source source { GUIDE };
+            // milliseconds since the recording started
+            qint64 timestamp { 0 };
+            // exposure duration in seconds, 0 if unknown
+            double exposure { 0 };
+            // state of the module, such as the focuser position
+            QVariantMap metadata;
+            // the frame as a FITS image
+            QByteArray fits;
+        };
+
+        /** Frames waiting to be written beyond which new frames are dropped */
+        static constexpr int MAX_PENDING = 8;
+
+        FrameRecorder();
+        ~FrameRecorder();
+
+        /** @return the recorder the modules share, writing under the "frames" data directory */
+        static FrameRecorder *Instance();
+
+        /**
+         * @brief record Queue a received frame for writing if the RecordEkosFrames option is set
+         * @param source module that received the frame
+         * @param imageData the frame, only its pixels are read and only before this returns
+         * @param metadata state of the module to keep with the frame
+         */
+        void record(Source source, const QSharedPointer<FITSData> &imageData, const QVariantMap &metadata = QVariantMap());
+
+        /** @brief open Start a new recording in @p filename, @return false if it can't be written */
+        bool open(const QString &filename);
+        /** @brief write Append a frame, its timestamp is kept as given, @return false on error */
+        bool write(const Frame &frame);
+        /** @brief close Finish writing the queued frames and close the recording */
+        void close();
+
+        bool isOpen() const;
+        QString filename() const;
+
+        /** @return the pixels of a FITSData buffer as a FITS image, empty on error */
+        static QByteArray toFITS(uint32_t dataType, int width, int height, int channels, const QByteArray &pixels);
+
+    private:
+        QString nextFilename() const;
+
+        QFile m_File;
+        mutable QMutex m_Mutex;
+        QElapsedTimer m_Clock;
+        QThreadPool m_WriterPool;
+        std::atomic<int> m_Pending { 0 };
+        bool m_Dropping { false };
+};
+
+/**
+ * @class FrameReader
+ * @short Reads back the frames written by FrameRecorder, in the order they were recorded.
+ */
+class FrameReader
+{
+    public:
+        /** @brief open Open a recording, @return false if it is not a frame recording */
+        bool open(const QString &filename);
+
+        /**
+         * @brief next Read the next frame
+         * @return false at the end of the recording, or at a frame left incomplete when recording stopped
+         */
+        bool next(FrameRecorder::Frame &frame);
+
+        QString errorString() const
+        {
+            return m_Error;
+        }
+
+    private:
+        QFile m_File;
+        QString m_Error;
+};
+
+}
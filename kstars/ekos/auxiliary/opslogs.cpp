@@ -9,12 +9,16 @@
 #include "kstars.h"
 #include "Options.h"
 #include "auxiliary/kspaths.h"
+#include "auxiliary/ksnotification.h"
+#include "auxiliary/kstrace.h"
 #include "indi/indilistener.h"
 
 #include <KConfigDialog>
 #include <KFormat>
 #include <KMessageBox>
 
+#include <QDateTime>
+#include <QFileDialog>
 #include <QFrame>
 #include <QUrl>
 #include <QDesktopServices>
@@ -35,6 +39,7 @@ OpsLogs::OpsLogs() : QFrame(KStars::Instance())
     connect(m_ConfigDialog->button(QDialogButtonBox::Ok), SIGNAL(clicked()), SLOT(refreshInterface()));
 
     connect(clearLogsB, SIGNAL(clicked()), this, SLOT(slotClearLogs()));
+    connect(saveTraceB, &QPushButton::clicked, this, &OpsLogs::slotSaveTrace);
     connect(kcfg_VerboseLogging, SIGNAL(toggled(bool)), this, SLOT(slotToggleVerbosityOptions()));
 
     connect(kcfg_LogToFile, SIGNAL(toggled(bool)), this, SLOT(slotToggleOutputOptions()));
@@ -119,6 +124,8 @@ void OpsLogs::refreshInterface()
 
     Options::setINDILogging((m_INDIDebugInterface > 0));
 
+    KSTrace::Instance()->setEnabled(Options::ekosTracing());
+
     m_SettingsChanged = (previousInterface != m_INDIDebugInterface);
 }
 
@@ -161,4 +168,17 @@ void OpsLogs::slotClearLogs()
     }
 }
 
+void OpsLogs::slotSaveTrace()
+{
+    const QString logsDir = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("logs");
+    const QString defaultName = QString("ekos_trace_%1.json").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss"));
+    const QString filename = QFileDialog::getSaveFileName(this, i18nc("@title:window", "Save Performance Trace"),
+                             QDir(logsDir).filePath(defaultName), i18n("Chrome Trace (*.json)"));
+    if (filename.isEmpty())
+        return;
+
+    if (KSTrace::Instance()->save(filename) == false)
+        KSNotification::error(i18n("Failed to save performance trace to %1", filename));
+}
+
 }
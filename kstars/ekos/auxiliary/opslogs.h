@@ -34,6 +34,7 @@ class OpsLogs : public QFrame, public Ui::OpsLogs
     void slotToggleVerbosityOptions();
     void slotToggleOutputOptions();
     void slotClearLogs();
+    void slotSaveTrace();
 
   private:
     qint64 getDirSize(const QString &dirPath);
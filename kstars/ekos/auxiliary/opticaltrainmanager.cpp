@@ -11,6 +11,7 @@
 #include "kstarsdata.h"
 #include "kstars.h"
 #include "indi/indilistener.h"
+#include "ekos/auxiliary/opticaltrainsettings.h"
 #include "ekos/auxiliary/profilesettings.h"
 #include "oal/equipmentwriter.h"
 
@@ -580,6 +581,7 @@ bool OpticalTrainManager::removeOpticalTrain(const QString &name)
             auto id = oneTrain["id"].toInt();
             KStarsData::Instance()->userdb()->DeleteOpticalTrain(id);
             KStarsData::Instance()->userdb()->DeleteOpticalTrainSettings(id);
+            OpticalTrainSettings::Instance()->removeOpticalTrain(id);
             refreshTrains();
             selectOpticalTrain(nullptr);
             return true;
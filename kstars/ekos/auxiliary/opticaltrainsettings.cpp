@@ -34,6 +34,8 @@ OpticalTrainSettings *OpticalTrainSettings::Instance()
 ////////////////////////////////////////////////////////////////////////////
 void OpticalTrainSettings::release()
 {
+    if (m_Instance)
+        m_Instance->flush();
     delete (m_Instance);
     m_Instance = nullptr;
 }
@@ -43,6 +45,9 @@ void OpticalTrainSettings::release()
 ////////////////////////////////////////////////////////////////////////////
 OpticalTrainSettings::OpticalTrainSettings(QObject *parent) : QObject(parent)
 {
+    m_WriteTimer.setSingleShot(true);
+    m_WriteTimer.setInterval(WRITE_DELAY);
+    connect(&m_WriteTimer, &QTimer::timeout, this, &OpticalTrainSettings::flush);
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -51,12 +56,20 @@ OpticalTrainSettings::OpticalTrainSettings(QObject *parent) : QObject(parent)
 void OpticalTrainSettings::setOpticalTrainID(uint32_t id)
 {
     m_TrainID = id;
+    auto cached = m_Cache.constFind(m_TrainID);
+    if (cached != m_Cache.constEnd())
+    {
+        m_Settings = cached.value();
+        return;
+    }
+
     // If not in database yet, create an empty entry.
     if (KStars::Instance()->data()->userdb()->GetOpticalTrainSettings(m_TrainID, m_Settings) == false)
     {
         initSettings();
         KStars::Instance()->data()->userdb()->GetOpticalTrainSettings(m_TrainID, m_Settings);
     }
+    m_Cache.insert(m_TrainID, m_Settings);
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -75,9 +88,7 @@ void OpticalTrainSettings::initSettings()
 void OpticalTrainSettings::setSettings(const QVariantMap &settings)
 {
     m_Settings = settings;
-    auto object = QJsonObject::fromVariantMap(m_Settings);
-    KStars::Instance()->data()->userdb()->UpdateOpticalTrainSettings(m_TrainID,
-            QJsonDocument(object).toJson(QJsonDocument::Compact));
+    scheduleWrite();
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -94,8 +105,46 @@ QVariant OpticalTrainSettings::getOneSetting(Settings id)
 void OpticalTrainSettings::setOneSetting(Settings id, const QVariant &value)
 {
     m_Settings[QString::number(id)] = value;
-    auto object = QJsonObject::fromVariantMap(m_Settings);
-    KStars::Instance()->data()->userdb()->UpdateOpticalTrainSettings(m_TrainID,
-            QJsonDocument(object).toJson(QJsonDocument::Compact));
+    scheduleWrite();
+}
+
+////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////
+void OpticalTrainSettings::scheduleWrite()
+{
+    m_Cache.insert(m_TrainID, m_Settings);
+    m_Pending.insert(m_TrainID);
+    if (!m_WriteTimer.isActive())
+        m_WriteTimer.start();
+}
+
+////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////
+void OpticalTrainSettings::flush()
+{
+    m_WriteTimer.stop();
+    for (auto trainID : qAsConst(m_Pending))
+    {
+        auto json = QJsonDocument(QJsonObject::fromVariantMap(m_Cache.value(trainID))).toJson(QJsonDocument::Compact);
+        // Settings change often during a session, write them without blocking.
+        KStars::Instance()->data()->userdb()->post([trainID, json](KSUserDB & db)
+        {
+            return db.UpdateOpticalTrainSettings(trainID, json);
+        });
+    }
+    m_Pending.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////
+void OpticalTrainSettings::removeOpticalTrain(uint32_t id)
+{
+    m_Cache.remove(id);
+    m_Pending.remove(id);
+    if (id == m_TrainID)
+        m_Settings.clear();
 }
 }
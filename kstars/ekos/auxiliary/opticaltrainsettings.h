@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <QHash>
 #include <QJsonArray>
 #include <QObject>
+#include <QSet>
+#include <QTimer>
 #include <QVariantMap>
 
 namespace Ekos
@@ -28,6 +31,9 @@ namespace Ekos
  * 1. The ID is a unique number from the Settings enum.
  * 2. The Payload is QVariant.
  *
+ * The settings of each train are read from the database once and kept in memory. Changes are
+ * written back after WRITE_DELAY milliseconds, so a burst of changes is written once.
+ *
  * @author Jasem Mutlaq
  * @version 1.0
  */
@@ -64,6 +70,15 @@ class OpticalTrainSettings : public QObject
         QVariant getOneSetting(Settings id);
         void initSettings();
         void setSettings(const QVariantMap &settings);
+
+        /**
+         * @brief flush Write the changed settings to the database now instead of after the delay.
+         */
+        void flush();
+        /**
+         * @brief removeOpticalTrain Forget the settings of a train deleted from the database.
+         */
+        void removeOpticalTrain(uint32_t id);
         const QVariantMap &getSettings() const
         {
             return m_Settings;
@@ -77,8 +92,18 @@ class OpticalTrainSettings : public QObject
         OpticalTrainSettings(QObject *parent = nullptr);
         static OpticalTrainSettings *m_Instance;
 
+        // Keep the changed settings of the current train and write them after the delay.
+        void scheduleWrite();
+
+        static constexpr int WRITE_DELAY {500};
+
         uint32_t m_TrainID {0};
         QVariantMap m_Settings;
+        // Settings of the trains read so far
+        QHash<uint32_t, QVariantMap> m_Cache;
+        // Trains whose settings changed since they were last written
+        QSet<uint32_t> m_Pending;
+        QTimer m_WriteTimer;
 };
 
 }
@@ -34,6 +34,8 @@ ProfileSettings *ProfileSettings::Instance()
 ////////////////////////////////////////////////////////////////////////////
 void ProfileSettings::release()
 {
+    if (m_Instance)
+        m_Instance->flush();
     delete (m_Instance);
     m_Instance = nullptr;
 }
@@ -43,6 +45,9 @@ void ProfileSettings::release()
 ////////////////////////////////////////////////////////////////////////////
 ProfileSettings::ProfileSettings(QObject *parent) : QObject(parent)
 {
+    m_WriteTimer.setSingleShot(true);
+    m_WriteTimer.setInterval(WRITE_DELAY);
+    connect(&m_WriteTimer, &QTimer::timeout, this, &ProfileSettings::flush);
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -50,6 +55,8 @@ ProfileSettings::ProfileSettings(QObject *parent) : QObject(parent)
 ////////////////////////////////////////////////////////////////////////////
 void ProfileSettings::setProfile(const QSharedPointer<ProfileInfo> &profile)
 {
+    // Changes belong to the previous profile
+    flush();
     m_Profile = profile;
     // If not in database yet, create an empty entry.
     if (KStars::Instance()->data()->userdb()->GetProfileSettings(m_Profile->id, m_Settings) == false)
@@ -75,9 +82,7 @@ void ProfileSettings::initSettings()
 void ProfileSettings::setSettings(const QVariantMap &settings)
 {
     m_Settings = settings;
-    auto object = QJsonObject::fromVariantMap(m_Settings);
-    KStars::Instance()->data()->userdb()->UpdateProfileSettings(m_Profile->id,
-            QJsonDocument(object).toJson(QJsonDocument::Compact));
+    scheduleWrite();
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -94,8 +99,35 @@ QVariant ProfileSettings::getOneSetting(Settings id)
 void ProfileSettings::setOneSetting(Settings id, const QVariant &value)
 {
     m_Settings[QString::number(id)] = value;
-    auto object = QJsonObject::fromVariantMap(m_Settings);
-    KStars::Instance()->data()->userdb()->UpdateProfileSettings(m_Profile->id,
-            QJsonDocument(object).toJson(QJsonDocument::Compact));
+    scheduleWrite();
+}
+
+////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////
+void ProfileSettings::scheduleWrite()
+{
+    m_Pending = true;
+    if (!m_WriteTimer.isActive())
+        m_WriteTimer.start();
+}
+
+////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////
+void ProfileSettings::flush()
+{
+    m_WriteTimer.stop();
+    if (!m_Pending || m_Profile.isNull())
+        return;
+
+    m_Pending = false;
+    auto json = QJsonDocument(QJsonObject::fromVariantMap(m_Settings)).toJson(QJsonDocument::Compact);
+    // Settings change often during a session, write them without blocking.
+    KStars::Instance()->data()->userdb()->post([profileID = m_Profile->id, json](KSUserDB & db)
+    {
+        db.UpdateProfileSettings(profileID, json);
+        return true;
+    });
 }
 }
@@ -11,6 +11,7 @@
 #include <QJsonArray>
 #include <QObject>
 #include <QSharedPointer>
+#include <QTimer>
 #include <QVariantMap>
 
 namespace Ekos
@@ -31,6 +32,9 @@ namespace Ekos
  * 1. The ID is a unique number from the Settings enum.
  * 2. The Payload is QVariant.
  *
+ * Changes are written back to the database after WRITE_DELAY milliseconds, so a burst of changes
+ * is written once.
+ *
  * @author Jasem Mutlaq
  * @version 1.0
  */
@@ -62,6 +66,12 @@ class ProfileSettings : public QObject
         QVariant getOneSetting(Settings id);
         void initSettings();
         void setSettings(const QVariantMap &settings);
+
+        /**
+         * @brief flush Write the changed settings to the database now instead of after the delay.
+         */
+        void flush();
+
         const QVariantMap &getSettings() const
         {
             return m_Settings;
@@ -79,8 +89,15 @@ class ProfileSettings : public QObject
         ProfileSettings(QObject *parent = nullptr);
         static ProfileSettings *m_Instance;
 
+        void scheduleWrite();
+
+        static constexpr int WRITE_DELAY {500};
+
         QSharedPointer<ProfileInfo> m_Profile;
         QVariantMap m_Settings;
+        // Settings changed since they were last written
+        bool m_Pending {false};
+        QTimer m_WriteTimer;
 };
 
 }
@@ -0,0 +1,44 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "settingwidgets.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDoubleSpinBox>
+#include <QGroupBox>
+#include <QRadioButton>
+#include <QSpinBox>
+#include <QSplitter>
+
+namespace Ekos
+{
+
+void SettingWidgets::collect(const QObject *parent)
+{
+    m_Widgets.clear();
+    add(m_ComboBoxes, parent);
+    add(m_DoubleSpinBoxes, parent);
+    add(m_SpinBoxes, parent);
+    add(m_CheckBoxes, parent);
+    add(m_GroupBoxes, parent);
+    add(m_Splitters, parent);
+    add(m_RadioButtons, parent);
+}
+
+template <typename T>
+void SettingWidgets::add(QList<T *> &list, const QObject *parent)
+{
+    list = parent->findChildren<T *>();
+    for (auto &oneWidget : list)
+    {
+        // Like findChild(), the first widget found of the first type wins
+        if (!m_Widgets.contains(oneWidget->objectName()))
+            m_Widgets.insert(oneWidget->objectName(), oneWidget);
+    }
+}
+
+}
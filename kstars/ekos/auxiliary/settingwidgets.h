@@ -0,0 +1,94 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+class QObject;
+class QWidget;
+class QComboBox;
+class QDoubleSpinBox;
+class QSpinBox;
+class QCheckBox;
+class QGroupBox;
+class QSplitter;
+class QRadioButton;
+
+namespace Ekos
+{
+
+/**
+ * @brief The SettingWidgets class
+ *
+ * The widgets of a module whose state is saved in its settings, collected once the user interface
+ * of the module is complete. Modules walk these lists, and look widgets up by name, each time the
+ * settings are read, written or connected, instead of searching all their children again.
+ */
+class SettingWidgets
+{
+    public:
+        /**
+         * @brief collect Collect the setting widgets among all children of parent.
+         * Widgets created after this are not part of the settings.
+         */
+        void collect(const QObject *parent);
+
+        const QList<QComboBox *> &comboBoxes() const
+        {
+            return m_ComboBoxes;
+        }
+        const QList<QDoubleSpinBox *> &doubleSpinBoxes() const
+        {
+            return m_DoubleSpinBoxes;
+        }
+        const QList<QSpinBox *> &spinBoxes() const
+        {
+            return m_SpinBoxes;
+        }
+        const QList<QCheckBox *> &checkBoxes() const
+        {
+            return m_CheckBoxes;
+        }
+        const QList<QGroupBox *> &groupBoxes() const
+        {
+            return m_GroupBoxes;
+        }
+        const QList<QSplitter *> &splitters() const
+        {
+            return m_Splitters;
+        }
+        const QList<QRadioButton *> &radioButtons() const
+        {
+            return m_RadioButtons;
+        }
+
+        /**
+         * @brief widget Setting widget named name, the first one in the order of the lists above
+         * if several share the name, nullptr if there is none.
+         */
+        QWidget *widget(const QString &name) const
+        {
+            return m_Widgets.value(name, nullptr);
+        }
+
+    private:
+        template <typename T>
+        void add(QList<T *> &list, const QObject *parent);
+
+        QList<QComboBox *> m_ComboBoxes;
+        QList<QDoubleSpinBox *> m_DoubleSpinBoxes;
+        QList<QSpinBox *> m_SpinBoxes;
+        QList<QCheckBox *> m_CheckBoxes;
+        QList<QGroupBox *> m_GroupBoxes;
+        QList<QSplitter *> m_Splitters;
+        QList<QRadioButton *> m_RadioButtons;
+        QHash<QString, QWidget *> m_Widgets;
+};
+
+}
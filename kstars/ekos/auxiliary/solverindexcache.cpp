@@ -0,0 +1,115 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "solverindexcache.h"
+
+#include "Options.h"
+
+#include <ekos_align_debug.h>
+#include <stellarsolver.h>
+
+#include <QtConcurrent>
+
+// Pages are touched this far apart to read them in
+static const qint64 g_pageSize = 4096;
+
+SolverIndexCache *SolverIndexCache::m_Instance = nullptr;
+
+SolverIndexCache *SolverIndexCache::Instance()
+{
+    if (m_Instance)
+        return m_Instance;
+
+    m_Instance = new SolverIndexCache();
+    return m_Instance;
+}
+
+SolverIndexCache::SolverIndexCache()
+{
+    m_ReadAheadPool.setMaxThreadCount(1);
+}
+
+SolverIndexCache::Index::~Index()
+{
+    if (data)
+        file.unmap(data);
+}
+
+void SolverIndexCache::retain(const QStringList &indexFiles)
+{
+    if (Options::solverIndexCacheSize() == 0)
+    {
+        m_Indexes.clear();
+        return;
+    }
+
+    for (const auto &oneFile : indexFiles)
+    {
+        auto cached = std::find_if(m_Indexes.begin(), m_Indexes.end(), [&oneFile](const QSharedPointer<Index> &oneIndex)
+        {
+            return oneIndex->file.fileName() == oneFile;
+        });
+        if (cached != m_Indexes.end())
+        {
+            auto index = *cached;
+            m_Indexes.erase(cached);
+            m_Indexes.append(index);
+            continue;
+        }
+
+        QSharedPointer<Index> index(new Index());
+        index->file.setFileName(oneFile);
+        if (!index->file.open(QIODevice::ReadOnly))
+            continue;
+        index->size = index->file.size();
+        index->data = index->file.map(0, index->size);
+        if (!index->data)
+        {
+            qCDebug(KSTARS_EKOS_ALIGN) << "Failed to map index file" << oneFile << index->file.errorString();
+            continue;
+        }
+        m_Indexes.append(index);
+
+        QtConcurrent::run(&m_ReadAheadPool, [index]()
+        {
+            volatile uchar sum = 0;
+            for (qint64 offset = 0; offset < index->size; offset += g_pageSize)
+                sum += index->data[offset];
+            Q_UNUSED(sum)
+        });
+    }
+
+    evict();
+}
+
+void SolverIndexCache::retainSolution(StellarSolver &solver)
+{
+    const int index = solver.getSolutionIndexNumber();
+    if (index < 0)
+        return;
+
+    retain(StellarSolver::getIndexFiles(Options::astrometryIndexFolderList(), index, solver.getSolutionHealpix()));
+}
+
+qint64 SolverIndexCache::size() const
+{
+    qint64 total = 0;
+    for (const auto &oneIndex : m_Indexes)
+        total += oneIndex->size;
+    return total;
+}
+
+void SolverIndexCache::evict()
+{
+    // The most recent index always stays, even if it alone is over the budget
+    const qint64 budget = static_cast<qint64>(Options::solverIndexCacheSize()) * 1024 * 1024;
+    qint64 total = size();
+    while (m_Indexes.size() > 1 && total > budget)
+    {
+        total -= m_Indexes.first()->size;
+        m_Indexes.removeFirst();
+    }
+}
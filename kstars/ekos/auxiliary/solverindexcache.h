@@ -0,0 +1,67 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QFile>
+#include <QList>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QThreadPool>
+
+class StellarSolver;
+
+/**
+ * @class SolverIndexCache
+ * @short Keeps the index files of recent solves resident in memory.
+ *
+ * StellarSolver reads its index files from disk on every solve. Mosaics, meridian flip checks and
+ * polar alignment solve the same region over and over, so the index files that solved it are mapped
+ * here and read ahead on a thread of their own. The solver then finds them in the page cache. Files
+ * are released least recently used first once they exceed Options::solverIndexCacheSize().
+ *
+ * Shared by Align, the Polar Alignment Assistant and everything else that solves through SolverUtils.
+ */
+class SolverIndexCache
+{
+    public:
+        static SolverIndexCache *Instance();
+
+        /**
+         * @brief retain Map and read ahead the index files, or mark them as just used if they already are.
+         * @param indexFiles absolute paths of index files.
+         */
+        void retain(const QStringList &indexFiles);
+
+        /**
+         * @brief retainSolution Retain the index files that solved the last solution of solver, if any.
+         */
+        void retainSolution(StellarSolver &solver);
+
+        /** @return total size of the retained index files in bytes */
+        qint64 size() const;
+
+    private:
+        SolverIndexCache();
+
+        class Index
+        {
+            public:
+                ~Index();
+
+                QFile file;
+                uchar *data { nullptr };
+                qint64 size { 0 };
+        };
+
+        void evict();
+
+        static SolverIndexCache *m_Instance;
+
+        // Least recently used first. The read ahead keeps its own reference to the index it reads.
+        QList<QSharedPointer<Index>> m_Indexes;
+        QThreadPool m_ReadAheadPool;
+};
@@ -6,6 +6,7 @@
 
 #include "solverutils.h"
 
+#include "solverindexcache.h"
 #include "fitsviewer/fitsdata.h"
 #include "Options.h"
 #include <QRegularExpression>
@@ -85,6 +86,7 @@ void SolverUtils::prepareSolver()
         QStringList indexFiles = StellarSolver::getIndexFiles(
                                      Options::astrometryIndexFolderList(), m_IndexToUse, m_HealpixToUse);
         m_StellarSolver->setIndexFilePaths(indexFiles);
+        SolverIndexCache::Instance()->retain(indexFiles);
     }
     else
         m_StellarSolver->setIndexFolderPaths(Options::astrometryIndexFolderList());
@@ -188,7 +190,10 @@ void SolverUtils::solverDone()
         FITSImage::Solution solution;
         const bool success = m_StellarSolver->solvingDone() && !m_StellarSolver->failed();
         if (success)
+        {
             solution = m_StellarSolver->getSolution();
+            SolverIndexCache::Instance()->retainSolution(*m_StellarSolver);
+        }
         emit done(false, success, solution, elapsed);
     }
     else
@@ -0,0 +1,115 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "capturecoordinator.h"
+
+#include <ekos_capture_debug.h>
+
+namespace Ekos
+{
+
+CaptureCoordinator *CaptureCoordinator::Instance()
+{
+    static CaptureCoordinator coordinator;
+    return &coordinator;
+}
+
+void CaptureCoordinator::addTrain(QObject *train, std::function<bool()> isExposing)
+{
+    if (train == nullptr)
+        return;
+
+    if (!m_Trains.contains(train))
+        connect(train, &QObject::destroyed, this, [this, train]()
+    {
+        removeTrain(train);
+    });
+    m_Trains[train].isExposing = std::move(isExposing);
+}
+
+void CaptureCoordinator::removeTrain(QObject *train)
+{
+    if (m_Trains.remove(train) > 0)
+        disconnect(train, &QObject::destroyed, this, nullptr);
+}
+
+bool CaptureCoordinator::requestDither(QObject *train)
+{
+    auto it = m_Trains.find(train);
+    if (it == m_Trains.end())
+        return true;
+
+    if (!it->ditherRequested)
+        qCDebug(KSTARS_EKOS_CAPTURE) << "Dither requested by" << train;
+    it->ditherRequested = true;
+
+    for (auto other = m_Trains.constBegin(); other != m_Trains.constEnd(); ++other)
+        if (other.key() != train && other->isExposing && other->isExposing())
+        {
+            qCDebug(KSTARS_EKOS_CAPTURE) << "Dither waits for the exposure of" << other.key();
+            return false;
+        }
+    return true;
+}
+
+void CaptureCoordinator::ditherFinished(QObject *train)
+{
+    auto it = m_Trains.find(train);
+    if (it != m_Trains.end())
+        it->ditherRequested = false;
+}
+
+bool CaptureCoordinator::mayStartExposure(QObject *train) const
+{
+    for (auto other = m_Trains.constBegin(); other != m_Trains.constEnd(); ++other)
+        if (other.key() != train && other->ditherRequested)
+            return false;
+    return true;
+}
+
+void CaptureCoordinator::frameCaptured(double exposure)
+{
+    if (!m_Throughput.isValid())
+        m_Throughput.start();
+    m_Frames++;
+    m_Exposure += exposure;
+
+    const double frames = framesPerHour();
+    const double exposurePerHour = this->exposurePerHour();
+    if (m_Trains.size() > 1)
+        qCInfo(KSTARS_EKOS_CAPTURE) << "Capture throughput of" << m_Trains.size() << "trains:" << frames
+                                    << "frames and" << exposurePerHour / 60 << "minutes of exposure per hour";
+    emit newThroughput(frames, exposurePerHour);
+}
+
+double CaptureCoordinator::perHour(double value) const
+{
+    // The first frame alone doesn't tell a rate
+    if (!m_Throughput.isValid() || m_Frames < 2)
+        return 0;
+    const double hours = m_Throughput.elapsed() / 3600000.0;
+    return hours > 0 ? value / hours : 0;
+}
+
+double CaptureCoordinator::framesPerHour() const
+{
+    // The clock starts with the first frame, which is not counted in the rate
+    return perHour(m_Frames - 1);
+}
+
+double CaptureCoordinator::exposurePerHour() const
+{
+    return perHour(m_Frames > 0 ? m_Exposure * (m_Frames - 1) / m_Frames : 0);
+}
+
+void CaptureCoordinator::resetThroughput()
+{
+    m_Throughput.invalidate();
+    m_Frames = 0;
+    m_Exposure = 0;
+}
+
+}
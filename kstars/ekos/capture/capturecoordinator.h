@@ -0,0 +1,88 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+
+#include <functional>
+
+namespace Ekos
+{
+
+/**
+ * @class CaptureCoordinator
+ * @short Coordinates the capture sequences of several optical trains running at the same time.
+ *
+ * Each capture pipeline registers itself as a train. A dither moves the mount under all of them,
+ * so it must not happen while another train is exposing: a train due to dither waits until the
+ * other trains have finished their running exposures, and the other trains don't start a new one
+ * until the dither is over. With a single train nothing waits.
+ *
+ * The coordinator also sums up the frames captured by all trains, so that the throughput of a
+ * multi-train rig is reported as a whole. It lives in the GUI thread, like the capture pipelines.
+ */
+class CaptureCoordinator : public QObject
+{
+        Q_OBJECT
+
+    public:
+        static CaptureCoordinator *Instance();
+
+        /**
+         * @brief addTrain Register a capture pipeline, it is removed again when it is destroyed
+         * @param isExposing tells whether the train has an exposure running
+         */
+        void addTrain(QObject *train, std::function<bool()> isExposing);
+        void removeTrain(QObject *train);
+        int trainCount() const
+        {
+            return m_Trains.size();
+        }
+
+        /**
+         * @brief requestDither Ask to dither before the next exposure of @p train
+         * @return true if no other train is exposing and dithering may start. Otherwise the dither
+         * stays requested and the other trains hold their next exposures until it is finished.
+         */
+        bool requestDither(QObject *train);
+        /** @brief ditherFinished The dither of @p train is over or was given up */
+        void ditherFinished(QObject *train);
+        /** @return false while another train waits for or runs a dither */
+        bool mayStartExposure(QObject *train) const;
+
+        /** @brief frameCaptured Count a frame of @p exposure seconds captured by one of the trains */
+        void frameCaptured(double exposure);
+        /** @return frames per hour captured by all trains since the first frame */
+        double framesPerHour() const;
+        /** @return exposure time per hour captured by all trains since the first frame, in seconds */
+        double exposurePerHour() const;
+        /** @brief resetThroughput Start counting the throughput again */
+        void resetThroughput();
+
+    signals:
+        void newThroughput(double framesPerHour, double exposurePerHour);
+
+    private:
+        CaptureCoordinator() = default;
+
+        struct Train
+        {
+            std::function<bool()> isExposing;
+            bool ditherRequested { false };
+        };
+
+        double perHour(double value) const;
+
+        QHash<QObject *, Train> m_Trains;
+        QElapsedTimer m_Throughput;
+        int m_Frames { 0 };
+        double m_Exposure { 0 };
+};
+
+}
@@ -339,21 +339,26 @@ void CaptureModuleState::resetDitherCounter()
         m_ditherCounter = Options::ditherFrames();
 }
 
-bool CaptureModuleState::checkDithering()
+bool CaptureModuleState::isDitheringRequired()
 {
     // No need if preview only
     if (m_activeJob && m_activeJob->jobType() == SequenceJob::JOBTYPE_PREVIEW)
         return false;
 
-    if ( (Options::ditherEnabled() || Options::ditherNoGuiding())
-            // 2017-09-20 Jasem: No need to dither after post meridian flip guiding
-            && getMeridianFlipState()->getMeridianFlipStage() != MeridianFlipState::MF_GUIDING
-            // We must be either in guide mode or if non-guide dither (via pulsing) is enabled
-            && (getGuideState() == GUIDE_GUIDING || Options::ditherNoGuiding())
-            // Must be only done for light frames
-            && (m_activeJob != nullptr && m_activeJob->getFrameType() == FRAME_LIGHT)
-            // Check dither counter
-            && m_ditherCounter == 0)
+    return (Options::ditherEnabled() || Options::ditherNoGuiding())
+           // 2017-09-20 Jasem: No need to dither after post meridian flip guiding
+           && getMeridianFlipState()->getMeridianFlipStage() != MeridianFlipState::MF_GUIDING
+           // We must be either in guide mode or if non-guide dither (via pulsing) is enabled
+           && (getGuideState() == GUIDE_GUIDING || Options::ditherNoGuiding())
+           // Must be only done for light frames
+           && (m_activeJob != nullptr && m_activeJob->getFrameType() == FRAME_LIGHT)
+           // Check dither counter
+           && m_ditherCounter == 0;
+}
+
+bool CaptureModuleState::checkDithering()
+{
+    if (isDitheringRequired())
     {
         // reset the dither counter
         resetDitherCounter();
@@ -654,9 +659,9 @@ void CaptureModuleState::updateFocusState(FocusState state)
             // forward to the active job
             if (m_activeJob != nullptr)
                 m_activeJob->setAutoFocusReady(true);
-            // reset the timer if a full autofocus was run (rather than an HFR check)
+            // reset the timer and the other pending triggers if a full autofocus was run (rather than an HFR check)
             if (m_refocusState->getFocusHFRInAutofocus())
-                m_refocusState->startRefocusTimer(true);
+                m_refocusState->autoFocusCompleted();
 
             // update HFR Threshold for those algorithms that use Autofocus as reference
             if (Options::hFRCheckAlgorithm() == HFR_CHECK_MEDIAN_MEASURE ||
@@ -413,6 +413,43 @@ class CaptureModuleState: public QObject
             m_RememberFastExposure = value;
         }
 
+        /**
+         * @brief isPipelinedExposure True if the next exposure was already started when the image being
+         * processed was received, see Options::capturePipelining().
+         */
+        bool isPipelinedExposure() const
+        {
+            return m_PipelinedExposure;
+        }
+        void setPipelinedExposure(bool value)
+        {
+            m_PipelinedExposure = value;
+        }
+
+        /**
+         * @brief isBurstExposure True if fast exposure has been enabled by capture to let the driver
+         * capture the frames of the active job in bursts, see Options::captureBurstMode().
+         */
+        bool isBurstExposure() const
+        {
+            return m_BurstExposure;
+        }
+        void setBurstExposure(bool value)
+        {
+            m_BurstExposure = value;
+        }
+        /**
+         * @brief burstFramesLeft Frames the driver still has to capture in the current fast exposure run.
+         */
+        int burstFramesLeft() const
+        {
+            return m_BurstFramesLeft;
+        }
+        void setBurstFramesLeft(int value)
+        {
+            m_BurstFramesLeft = value;
+        }
+
         bool dirty() const
         {
             return m_Dirty;
@@ -591,6 +628,12 @@ class CaptureModuleState: public QObject
 
         bool checkDithering();
 
+        /**
+             * @brief Check, whether dithering is necessary, without initiating it.
+             * @see checkDithering()
+             */
+        bool isDitheringRequired();
+
         bool checkCapturing()
         {
             return (m_CaptureState == CAPTURE_CAPTURING || m_CaptureState == CAPTURE_PAUSE_PLANNED);
@@ -1051,6 +1094,11 @@ class CaptureModuleState: public QObject
         bool m_ignoreJobProgress { true };
         // Fast Exposure
         bool m_RememberFastExposure {false};
+        // Next exposure started before the received image was processed
+        bool m_PipelinedExposure {false};
+        // Fast exposure enabled for bursts of short frames, and frames left in the current burst
+        bool m_BurstExposure {false};
+        int m_BurstFramesLeft {0};
         // Set dirty bit to indicate sequence queue file was modified and needs saving.
         bool m_Dirty { false };
         // Capturing (incl. preparation actions) is active
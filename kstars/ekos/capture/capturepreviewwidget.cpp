@@ -15,9 +15,12 @@
 #include "capture.h"
 #include "sequencejob.h"
 #include "fitsviewer/fitsdata.h"
+#include "fitsviewer/fitsthumbnail.h"
 #include "fitsviewer/summaryfitsview.h"
 #include "ekos/scheduler/schedulermodulestate.h"
 
+#include <QFutureWatcher>
+
 using Ekos::SequenceJob;
 
 CapturePreviewWidget::CapturePreviewWidget(QWidget *parent) : QWidget(parent)
@@ -100,17 +103,21 @@ void CapturePreviewWidget::updateJobProgress(Ekos::SequenceJob *job, const QShar
     m_overlay->addFrameData(m_currentFrame);
     m_overlay->setVisible(true);
 
-    // load frame
+    // load the thumbnail of the frame, the capture module keeps the frame itself
     if (m_fitsPreview != nullptr && Options::useSummaryPreview())
-        m_fitsPreview->loadData(data);
+    {
+        const QSharedPointer<FITSData> thumbnail = FITSThumbnail::create(data);
+        m_overlay->setThumbnail(m_currentFrame.filename, thumbnail);
+        m_fitsPreview->loadData(thumbnail.isNull() ? data : thumbnail);
+    }
 }
 
 void CapturePreviewWidget::showNextFrame()
 {
     m_overlay->setEnabled(false);
     if (m_overlay->showNextFrame())
-        m_fitsPreview->loadFile(m_overlay->currentFrame().filename);
-    // Hint: since the FITSView loads in the background, we have to wait for FITSView::load() to enable the layer
+        showFrame(m_overlay->currentFrame().filename);
+    // Hint: since the frame loads in the background, we have to wait for FITSView::load() to enable the layer
     else
         m_overlay->setEnabled(true);
 }
@@ -119,12 +126,52 @@ void CapturePreviewWidget::showPreviousFrame()
 {
     m_overlay->setEnabled(false);
     if (m_overlay->showPreviousFrame())
-        m_fitsPreview->loadFile(m_overlay->currentFrame().filename);
-    // Hint: since the FITSView loads in the background, we have to wait for FITSView::load() to enable the layer
+        showFrame(m_overlay->currentFrame().filename);
+    // Hint: since the frame loads in the background, we have to wait for FITSView::load() to enable the layer
     else
         m_overlay->setEnabled(true);
 }
 
+void CapturePreviewWidget::showFrame(const QString &filename)
+{
+    const QSharedPointer<FITSData> thumbnail = m_overlay->thumbnail(filename);
+    if (thumbnail != nullptr)
+    {
+        m_fitsPreview->loadData(thumbnail);
+        return;
+    }
+
+    // The frame is only held until its thumbnail is made, a bayered one is not even debayered
+    QSharedPointer<FITSData> data(new FITSData(), &QObject::deleteLater);
+    data->setKeepMosaic(true);
+    auto watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, data, filename]()
+    {
+        watcher->deleteLater();
+        const QSharedPointer<FITSData> thumbnail = watcher->result() ?
+                FITSThumbnail::create(data) : QSharedPointer<FITSData>();
+        if (thumbnail == nullptr)
+        {
+            qCWarning(KSTARS_EKOS_CAPTURE) << "Loading" << filename << "failed:" << data->getLastError();
+            m_overlay->setEnabled(true);
+            return;
+        }
+        m_overlay->setThumbnail(filename, thumbnail);
+        m_fitsPreview->loadData(thumbnail);
+    });
+    watcher->setFuture(data->loadFromFile(filename));
+}
+
+void CapturePreviewWidget::showFullResolution()
+{
+    if (m_overlay->hasFrames() == false)
+        return;
+
+    // Until the next frame is shown, the view holds the whole frame
+    m_overlay->setEnabled(false);
+    m_fitsPreview->loadFile(m_overlay->currentFrame().filename);
+}
+
 void CapturePreviewWidget::deleteCurrentFrame()
 {
     m_overlay->setEnabled(false);
@@ -165,7 +212,7 @@ void CapturePreviewWidget::deleteCurrentFrame()
             // delete it from the history and update the FITS view
             if (m_overlay->deleteFrame(pos) && m_overlay->hasFrames())
             {
-                m_fitsPreview->loadFile(m_overlay->currentFrame().filename);
+                showFrame(m_overlay->currentFrame().filename);
                 // Hint: since the FITSView loads in the background, we have to wait for FITSView::load() to enable the layer
             }
             else
@@ -226,6 +273,7 @@ void CapturePreviewWidget::setSummaryFITSView(SummaryFITSView *view)
     {
         m_overlay->setEnabled(true);
     });
+    connect(view, &SummaryFITSView::fullResolutionRequested, this, &CapturePreviewWidget::showFullResolution);
 }
 
 void CapturePreviewWidget::setEnabled(bool enabled)
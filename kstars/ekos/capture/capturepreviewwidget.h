@@ -55,6 +55,11 @@ public:
      */
     void deleteCurrentFrame();
 
+    /**
+     * @brief Replace the thumbnail of the displayed frame by the frame itself
+     */
+    void showFullResolution();
+
     /**
      * @brief Set the summary FITS view
      */
@@ -95,6 +100,11 @@ public slots:
     void updateCaptureCountDown(int delta);
 
 private:
+    /**
+     * @brief Show the thumbnail of a frame from the history, making it if it is not cached
+     */
+    void showFrame(const QString &filename);
+
     QSharedPointer<Ekos::SchedulerModuleState> m_schedulerModuleState = nullptr;
     Ekos::Capture *m_captureModule = nullptr;
     Ekos::Mount *m_mountModule = nullptr;
@@ -4,6 +4,7 @@
     SPDX-License-Identifier: GPL-2.0-or-later
 */
 #include "captureprocess.h"
+#include "capturecoordinator.h"
 #include "capturedeviceadaptor.h"
 #include "refocusstate.h"
 #include "sequencejob.h"
@@ -13,6 +14,7 @@
 #include "ekos/auxiliary/darkprocessor.h"
 #include "ekos/auxiliary/opticaltrainmanager.h"
 #include "ekos/auxiliary/profilesettings.h"
+#include "auxiliary/kstrace.h"
 #include "ekos/guide/guide.h"
 #include "indi/indilistener.h"
 #include "indi/indirotator.h"
@@ -69,6 +71,12 @@ CaptureProcess::CaptureProcess(QSharedPointer<CaptureModuleState> newModuleState
     {
         emit newLog(m_CaptureScript.readAllStandardOutput());
     });
+
+    // coordinate dithering and throughput with the capture sequences of other optical trains
+    CaptureCoordinator::Instance()->addTrain(this, [this]()
+    {
+        return state()->getCaptureState() == CAPTURE_CAPTURING;
+    });
 }
 
 bool CaptureProcess::setMount(ISD::Mount *device)
@@ -303,6 +311,8 @@ void CaptureProcess::capturePreview(bool loop)
 void CaptureProcess::stopCapturing(CaptureState targetState)
 {
     clearFlatCache();
+    // don't hold the other optical trains for a dither that won't come
+    CaptureCoordinator::Instance()->ditherFinished(this);
 
     state()->resetAlignmentRetries();
     //seqTotalCount   = 0;
@@ -375,6 +385,7 @@ void CaptureProcess::stopCapturing(CaptureState targetState)
     state()->setCaptureState(targetState);
 
     state()->setLooping(false);
+    state()->setPipelinedExposure(false);
     state()->setBusy(false);
 
     state()->getCaptureDelayTimer().stop();
@@ -396,6 +407,15 @@ void CaptureProcess::stopCapturing(CaptureState targetState)
             && devices()->getActiveCamera()->isFastExposureEnabled())
         devices()->getActiveChip()->abortExposure();
 
+    // Fast exposure enabled for bursts is only kept for the job it was enabled for.
+    if (state()->isBurstExposure())
+    {
+        state()->setBurstExposure(false);
+        state()->setBurstFramesLeft(0);
+        if (devices()->getActiveCamera())
+            devices()->getActiveCamera()->setFastExposureEnabled(false);
+    }
+
     // communicate successful stop
     emit captureStopped();
 }
@@ -759,9 +779,17 @@ IPState CaptureProcess::checkLightFramePendingTasks()
         return IPS_BUSY;
 
     // step 5: check if dithering is required or running
-    if ((state()->getCaptureState() == CAPTURE_DITHERING && state()->getDitheringState() != IPS_OK)
-            || state()->checkDithering())
+    //         Dithering moves the mount under all optical trains. Wait while another train dithers,
+    //         and before dithering wait until the other trains have finished their exposures.
+    if (CaptureCoordinator::Instance()->mayStartExposure(this) == false)
+        return IPS_BUSY;
+    if (state()->getCaptureState() == CAPTURE_DITHERING && state()->getDitheringState() != IPS_OK)
+        return IPS_BUSY;
+    if (state()->isDitheringRequired() && CaptureCoordinator::Instance()->requestDither(this) == false)
         return IPS_BUSY;
+    if (state()->checkDithering())
+        return IPS_BUSY;
+    CaptureCoordinator::Instance()->ditherFinished(this);
 
     // step 6: check if re-focusing is required
     //         Needs to be checked after dithering checks to avoid dithering in parallel
@@ -792,6 +820,7 @@ void CaptureProcess::captureStarted(CaptureModuleState::CAPTUREResult rc)
     {
         case CaptureModuleState::CAPTURE_OK:
         {
+            KSTrace::Instance()->asyncBegin("capture", "Exposure");
             state()->setCaptureState(CAPTURE_CAPTURING);
             state()->getCaptureTimeout().start(static_cast<int>(activeJob()->getCoreProperty(
                                                    SequenceJob::SJ_Exposure).toDouble()) * 1000 +
@@ -836,6 +865,14 @@ void CaptureProcess::captureStarted(CaptureModuleState::CAPTUREResult rc)
 
 void CaptureProcess::checkNextExposure()
 {
+    // Let the camera write the previous images to disk before piling up more of them in memory.
+    if (activeJob() != nullptr && activeCamera() && activeCamera()->isSaveQueueFull())
+    {
+        qCDebug(KSTARS_EKOS_CAPTURE) << "Waiting for captured images to be saved before the next exposure.";
+        QTimer::singleShot(100, this, &CaptureProcess::checkNextExposure);
+        return;
+    }
+
     IPState started = startNextExposure();
     // if starting the next exposure did not succeed due to pending jobs running,
     // we retry after 1 second
@@ -886,6 +923,7 @@ IPState CaptureProcess::startNextExposure()
 
 IPState CaptureProcess::resumeSequence()
 {
+    KSTRACE_SCOPE("capture", "resumeSequence");
     // before we resume, we will check if pausing is requested
     if (checkPausing(CaptureModuleState::CONTINUE_ACTION_CAPTURE_COMPLETE) == true)
         return IPS_BUSY;
@@ -907,6 +945,14 @@ IPState CaptureProcess::resumeSequence()
     // continue the current job
     else
     {
+        // The next exposure has been started when this image was received, it only had to be counted.
+        if (state()->isPipelinedExposure())
+        {
+            state()->setPipelinedExposure(false);
+            state()->setCaptureState(CAPTURE_CAPTURING);
+            return IPS_OK;
+        }
+
         // If we suspended guiding due to primary chip download, resume guide chip guiding now - unless
         // a meridian flip is ongoing
         if (state()->getGuideState() == GUIDE_SUSPENDED && state()->suspendGuidingOnDownload() &&
@@ -916,14 +962,17 @@ IPState CaptureProcess::resumeSequence()
             emit resumeGuiding();
         }
 
-        // If looping, we just increment the file system image count
+        // If looping, we just increment the file system image count. The driver sends the frames one after
+        // another, so there is no need to scan the directory for the next free ID after every frame.
         if (activeCamera()->isFastExposureEnabled())
         {
-            if (activeCamera()->getUploadMode() != ISD::Camera::UPLOAD_LOCAL)
+            if (activeCamera()->getUploadMode() != ISD::Camera::UPLOAD_LOCAL &&
+                    state()->getMeridianFlipState()->getMeridianFlipStage() < MeridianFlipState::MF_ALIGNING)
             {
-                state()->checkSeqBoundary(state()->sequenceURL());
+                state()->setNextSequenceID(state()->nextSequenceID() + 1);
                 activeCamera()->setNextSequenceID(state()->nextSequenceID());
             }
+            state()->setBurstFramesLeft(state()->burstFramesLeft() - 1);
         }
 
         // ensure state image received to recover properly after pausing
@@ -945,9 +994,16 @@ IPState CaptureProcess::resumeSequence()
             // pending tasks. If not continue as is.
             if (activeCamera()->isFastExposureEnabled())
             {
+                // A burst ran out of frames, the driver has to be given the next one.
+                if (state()->isBurstExposure() && state()->burstFramesLeft() <= 0)
+                {
+                    checkNextExposure();
+                    return IPS_OK;
+                }
+
+                // Only light frames have mid-sequence tasks
                 if (activeJob() &&
-                        activeJob()->getFrameType() == FRAME_LIGHT &&
-                        checkLightFramePendingTasks() == IPS_OK)
+                        (activeJob()->getFrameType() != FRAME_LIGHT || checkLightFramePendingTasks() == IPS_OK))
                 {
                     // Continue capturing seamlessly
                     state()->setCaptureState(CAPTURE_CAPTURING);
@@ -970,6 +1026,8 @@ IPState CaptureProcess::resumeSequence()
 
 void CaptureProcess::processFITSData(const QSharedPointer<FITSData> &data)
 {
+    KSTRACE_SCOPE("capture", "processFITSData");
+    KSTrace::Instance()->asyncEnd("capture", "Exposure");
     ISD::CameraChip * tChip = nullptr;
 
     QString blobInfo;
@@ -1075,14 +1133,65 @@ void CaptureProcess::processFITSData(const QSharedPointer<FITSData> &data)
         updateImageMetadataAction(state()->imageData());
     }
 
-    // image has been received and processed successfully.
-    state()->setCaptureState(CAPTURE_IMAGE_RECEIVED);
+    // image has been received and processed successfully, unless the next one is already exposing.
+    if (state()->isPipelinedExposure() == false)
+        state()->setCaptureState(CAPTURE_IMAGE_RECEIVED);
     // processing finished successfully
     imageCapturingCompleted();
     // hand over to the capture module
     emit processingFITSfinished(true);
 }
 
+void CaptureProcess::startPipelinedExposure(ISD::CameraChip *chip)
+{
+    auto theJob = activeJob();
+    if (Options::capturePipelining() == false || theJob == nullptr || chip != devices()->getActiveChip())
+        return;
+
+    // Only for sequence frames not exposed in a loop by the driver or for framing
+    if (theJob->jobType() == SequenceJob::JOBTYPE_PREVIEW || state()->isLooping() ||
+            activeCamera()->isFastExposureEnabled() || chip->getCaptureMode() != FITS_NORMAL ||
+            activeCamera()->getUploadMode() == ISD::Camera::UPLOAD_LOCAL || activeCamera()->isSaveQueueFull())
+        return;
+
+    // Nothing may be pending between the two exposures: no pause or abort, meridian flip,
+    // guiding to resume, delay or capture scripts...
+    if (state()->getCaptureState() != CAPTURE_CAPTURING ||
+            state()->getMeridianFlipState()->getMeridianFlipStage() != MeridianFlipState::MF_NONE ||
+            state()->getGuideState() == GUIDE_SUSPENDED ||
+            theJob->getCoreProperty(SequenceJob::SJ_Delay).toInt() > 0 ||
+            theJob->getScript(SCRIPT_PRE_CAPTURE).isEmpty() == false ||
+            theJob->getScript(SCRIPT_POST_CAPTURE).isEmpty() == false)
+        return;
+
+    // ... and the job needs more frames than the received one.
+    if (theJob->getCompleted() + 1 >= theJob->getCoreProperty(SequenceJob::SJ_Count).toInt())
+        return;
+
+    switch (theJob->getFrameType())
+    {
+        case FRAME_FLAT:
+            // The next exposure time depends on the received flat
+            if (theJob->getFlatFieldDuration() == DURATION_ADU)
+                return;
+            break;
+        case FRAME_LIGHT:
+            // Dithering is due after the received frame, or refocusing might be
+            if (((Options::ditherEnabled() || Options::ditherNoGuiding()) && state()->getDitherCounter() <= 1)
+                    || Options::enforceRefocusEveryN() || Options::enforceAutofocusOnTemperature()
+                    || Options::enforceAutofocusHFR() || state()->getRefocusState()->isRefocusAfterMeridianFlip())
+                return;
+            break;
+        default:
+            break;
+    }
+
+    qCDebug(KSTARS_EKOS_CAPTURE) << "Starting next exposure while processing the received image.";
+    // The received image is still processed and counted first, see resumeSequence()
+    state()->setPipelinedExposure(true);
+    captureImage();
+}
+
 void CaptureProcess::processNewRemoteFile(QString file)
 {
     emit newLog(i18n("Remote image saved to %1", file));
@@ -1100,15 +1209,20 @@ void CaptureProcess::imageCapturingCompleted()
 
     // If fast exposure is off, disconnect exposure progress
     // otherwise, keep it going since it fires off from driver continuous capture process.
-    if (activeCamera()->isFastExposureEnabled() == false && state()->isLooping() == false)
+    // The same holds if the next exposure has been started already.
+    if (activeCamera()->isFastExposureEnabled() == false && state()->isLooping() == false
+            && state()->isPipelinedExposure() == false)
     {
         disconnect(activeCamera(), &ISD::Camera::newExposureValue, this,
                    &CaptureProcess::setExposureProgress);
         DarkLibrary::Instance()->disconnect(this);
     }
-    // stop timers
-    state()->getCaptureTimeout().stop();
-    state()->setCaptureTimeoutCounter(0);
+    // stop timers, except the capture timeout of the next exposure
+    if (state()->isPipelinedExposure() == false)
+    {
+        state()->getCaptureTimeout().stop();
+        state()->setCaptureTimeoutCounter(0);
+    }
 
     state()->downloadProgressTimer().stop();
 
@@ -1128,6 +1242,7 @@ void CaptureProcess::imageCapturingCompleted()
 
     // update counters
     updateCompletedCaptureCountersAction();
+    CaptureCoordinator::Instance()->frameCaptured(thejob->getCoreProperty(SequenceJob::SJ_Exposure).toDouble());
 
     switch (thejob->getFrameType())
     {
@@ -1255,6 +1370,8 @@ void CaptureProcess::processJobCompletion2()
     else
     {
         activeJob()->done();
+        // Keep the frames of this job indexed for the next session.
+        PlaceholderPath::saveFileIndex();
 
         if (activeJob()->jobType() != SequenceJob::JOBTYPE_PREVIEW)
         {
@@ -1330,6 +1447,7 @@ IPState CaptureProcess::startNextJob()
 
 void CaptureProcess::captureImage()
 {
+    KSTRACE_SCOPE("capture", "captureImage");
     if (activeJob() == nullptr)
         return;
 
@@ -1343,13 +1461,25 @@ void CaptureProcess::captureImage()
 
     state()->getCaptureTimeout().stop();
     state()->getCaptureDelayTimer().stop();
+
+    // Let the driver capture many short frames in a row instead of commanding each one of them.
+    if (state()->isBurstExposure() == false && checkBurstExposure())
+    {
+        qCInfo(KSTARS_EKOS_CAPTURE) << "Capturing frames in bursts of up to" << Options::captureBurstSize() << "frames.";
+        state()->setBurstExposure(true);
+        activeCamera()->setFastExposureEnabled(true);
+    }
+
     if (activeCamera()->isFastExposureEnabled())
     {
         int remaining = state()->isLooping() ? 100000 : (activeJob()->getCoreProperty(
                             SequenceJob::SJ_Count).toInt() -
                         activeJob()->getCompleted());
+        if (state()->isBurstExposure())
+            remaining = std::min(remaining, static_cast<int>(Options::captureBurstSize()));
         if (remaining > 1)
             activeCamera()->setFastCount(static_cast<uint>(remaining));
+        state()->setBurstFramesLeft(remaining);
     }
 
     setCamera(true);
@@ -1378,6 +1508,11 @@ void CaptureProcess::captureImage()
     {
         if (activeCamera()->getUploadMode() != ISD::Camera::UPLOAD_CLIENT)
             activeCamera()->setUploadMode(ISD::Camera::UPLOAD_CLIENT);
+
+        // Load the master dark the preview will be denoised with while it is exposing.
+        if (Options::autoDark() && state()->useGuideHead() == false)
+            DarkLibrary::Instance()->prefetchDarkFrame(devices()->getActiveChip(),
+                    activeJob()->getCoreProperty(SequenceJob::SJ_Exposure).toDouble());
     }
     // If batch mode, ensure upload mode mathces the active job target.
     else
@@ -1452,6 +1587,25 @@ void CaptureProcess::captureImage()
     emit captureImageStarted();
 }
 
+bool CaptureProcess::checkBurstExposure()
+{
+    auto theJob = activeJob();
+    if (Options::captureBurstMode() == false || theJob == nullptr || activeCamera()->isFastExposureEnabled()
+            || state()->isRememberFastExposure() || !activeCamera()->getProperty("CCD_FAST_TOGGLE"))
+        return false;
+
+    // Bursts are for sequences of short frames...
+    if (theJob->jobType() == SequenceJob::JOBTYPE_PREVIEW || state()->isLooping() ||
+            theJob->getCoreProperty(SequenceJob::SJ_Exposure).toDouble() > Options::captureBurstMaxExposure() ||
+            theJob->getCoreProperty(SequenceJob::SJ_Count).toInt() - theJob->getCompleted() < 2)
+        return false;
+
+    // ... the driver can expose without waiting for each of them to be processed.
+    return theJob->getCoreProperty(SequenceJob::SJ_Delay).toInt() == 0 &&
+           theJob->getScript(SCRIPT_PRE_CAPTURE).isEmpty() && theJob->getScript(SCRIPT_POST_CAPTURE).isEmpty() &&
+           (theJob->getFrameType() != FRAME_FLAT || theJob->getFlatFieldDuration() != DURATION_ADU);
+}
+
 void CaptureProcess::resetFrame()
 {
     devices()->setActiveChip(state()->useGuideHead() ?
@@ -2365,6 +2519,8 @@ void CaptureProcess::setCamera(bool connection)
     {
         // TODO: do not simply forward the newExposureValue
         connect(activeCamera(), &ISD::Camera::newExposureValue, this, &CaptureProcess::setExposureProgress, Qt::UniqueConnection);
+        connect(activeCamera(), &ISD::Camera::frameReceived, this, &CaptureProcess::startPipelinedExposure,
+                Qt::UniqueConnection);
         connect(activeCamera(), &ISD::Camera::newImage, this, &CaptureProcess::processFITSData, Qt::UniqueConnection);
         connect(activeCamera(), &ISD::Camera::newRemoteFile, this, &CaptureProcess::processNewRemoteFile, Qt::UniqueConnection);
         connect(activeCamera(), &ISD::Camera::ready, this, &CaptureProcess::cameraReady, Qt::UniqueConnection);
@@ -2373,6 +2529,7 @@ void CaptureProcess::setCamera(bool connection)
     {
         // TODO: do not simply forward the newExposureValue
         disconnect(activeCamera(), &ISD::Camera::newExposureValue, this, &CaptureProcess::setExposureProgress);
+        disconnect(activeCamera(), &ISD::Camera::frameReceived, this, &CaptureProcess::startPipelinedExposure);
         disconnect(activeCamera(), &ISD::Camera::newImage, this, &CaptureProcess::processFITSData);
         disconnect(activeCamera(), &ISD::Camera::newRemoteFile, this, &CaptureProcess::processNewRemoteFile);
         //    disconnect(m_Camera, &ISD::Camera::previewFITSGenerated, this, &Capture::setGeneratedPreviewFITS);
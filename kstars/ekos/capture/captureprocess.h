@@ -386,6 +386,14 @@ public:
      */
     void processFITSData(const QSharedPointer<FITSData> &data);
 
+    /**
+     * @brief startPipelinedExposure Start the next exposure of the active job as soon as an image is received,
+     * so that the camera exposes while the image is loaded, analyzed and displayed. Only done if
+     * Options::capturePipelining() is set and nothing needs to happen between the two exposures.
+     * @param chip chip the image has been received from
+     */
+    void startPipelinedExposure(ISD::CameraChip *chip);
+
     /**
      * @brief setNewRemoteFile A new image has been stored as remote file
      * @param file local file path
@@ -448,6 +456,12 @@ public:
      */
     void captureImage();
 
+    /**
+     * @brief checkBurstExposure Check if the frames of the active job should be captured in bursts, using the
+     * fast exposure of the driver, see Options::captureBurstMode().
+     */
+    bool checkBurstExposure();
+
     /**
      * @brief resetFrame Reset frame settings of the camera
      */
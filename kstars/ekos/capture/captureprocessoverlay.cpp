@@ -5,6 +5,7 @@
  */
 
 #include "captureprocessoverlay.h"
+#include "fitsviewer/fitsdata.h"
 #include "QTime"
 #include "QFileInfo"
 
@@ -184,6 +185,7 @@ bool CaptureProcessOverlay::CaptureHistory::deleteFrame(int pos)
 {
     if (m_history.size() != 0 && pos < m_history.size())
     {
+        m_thumbnails.remove(m_history.at(pos).filename);
         m_history.removeAt(pos);
         // adapt the current position if the deleted frame was deleted before it or itself
         if (m_position >= pos)
@@ -205,6 +207,7 @@ void CaptureProcessOverlay::CaptureHistory::reset()
 {
     m_position = -1;
     m_history.clear();
+    m_thumbnails.clear();
 }
 
 bool CaptureProcessOverlay::CaptureHistory::forward()
@@ -252,6 +255,21 @@ void CaptureProcessOverlay::CaptureHistory::updateTargetStatistics()
         m_position = m_history.size() - 1;
 }
 
+QSharedPointer<FITSData> CaptureProcessOverlay::CaptureHistory::thumbnail(const QString &filename) const
+{
+    QSharedPointer<FITSData> *data = m_thumbnails.object(filename);
+    return data != nullptr ? *data : QSharedPointer<FITSData>();
+}
+
+void CaptureProcessOverlay::CaptureHistory::setThumbnail(const QString &filename, const QSharedPointer<FITSData> &data)
+{
+    if (data.isNull())
+        return;
+    const qint64 bytes = qint64(data->width()) * data->height() * data->channels() * data->getBytesPerPixel();
+    m_thumbnails.insert(filename, new QSharedPointer<FITSData>(data), int(std::max<qint64>(1, std::min<qint64>(bytes,
+                        THUMBNAIL_CACHE_BYTES))));
+}
+
 void CaptureProcessOverlay::CaptureHistory::countNewFrame(QString target, CCDFrameType frameType, QString filter,
         double exptime)
 {
@@ -10,6 +10,7 @@
 
 #include "indi/indicommon.h"
 
+#include <QCache>
 #include <QWidget>
 
 class FITSData;
@@ -44,6 +45,9 @@ public:
     // map target --> frame statistics
     typedef QMap<QString, FrameStatistics> TargetStatistics;
 
+    // memory the thumbnails of the capture history may take
+    static constexpr int THUMBNAIL_CACHE_BYTES = 128 * 1024 * 1024;
+
     /**
      * @brief Navigator through the capture history.
      */
@@ -100,6 +104,15 @@ public:
          */
         void updateTargetStatistics();
 
+        /**
+         * @brief The thumbnail kept for the given file, nullptr if there is none
+         */
+        QSharedPointer<FITSData> thumbnail(const QString &filename) const;
+        /**
+         * @brief Keep the thumbnail of the given file, the least recently used ones are dropped
+         */
+        void setThumbnail(const QString &filename, const QSharedPointer<FITSData> &data);
+
         // capture statistics
         TargetStatistics statistics;
 
@@ -107,6 +120,9 @@ public:
         QList<FrameData> m_history;
         int m_position = -1;
 
+        // thumbnails of the frames in the history, by file name
+        QCache<QString, QSharedPointer<FITSData>> m_thumbnails { THUMBNAIL_CACHE_BYTES };
+
         /**
          * @brief Add a new frame to the statistics
          * @param target current target being processed
@@ -153,6 +169,15 @@ public:
      */
     bool hasFrames() {return m_captureHistory.size() > 0;}
 
+    /**
+     * @brief The thumbnail kept for the given file, nullptr if there is none
+     */
+    QSharedPointer<FITSData> thumbnail(const QString &filename) const {return m_captureHistory.thumbnail(filename);}
+    /**
+     * @brief Keep the thumbnail of the given file with the capture history
+     */
+    void setThumbnail(const QString &filename, const QSharedPointer<FITSData> &data) {m_captureHistory.setThumbnail(filename, data);}
+
     /**
      * @brief Update the statistics display for captured frames
      */
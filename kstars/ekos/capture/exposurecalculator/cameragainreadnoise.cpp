@@ -11,7 +11,7 @@
 
 #include <ekos_capture_debug.h>
 
-int OptimalExposure::CameraGainReadNoise::getGain()
+int OptimalExposure::CameraGainReadNoise::getGain() const
 {
     return gain;
 }
@@ -21,7 +21,7 @@ void OptimalExposure::CameraGainReadNoise::setGain(int newGain)
     gain = newGain;
 }
 
-double OptimalExposure::CameraGainReadNoise::getReadNoise()
+double OptimalExposure::CameraGainReadNoise::getReadNoise() const
 {
     return readNoise;
 }
@@ -21,9 +21,9 @@ class CameraGainReadNoise
         CameraGainReadNoise() {}
         CameraGainReadNoise(int gain, double readNoise);
 
-        int getGain();
+        int getGain() const;
         void setGain(int newGain);
-        double getReadNoise();
+        double getReadNoise() const;
         void setReadNoise(double newReadNoise);
 
     private:
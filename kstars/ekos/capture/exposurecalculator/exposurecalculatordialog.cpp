@@ -71,6 +71,8 @@ ExposureCalculatorDialog::ExposureCalculatorDialog(QWidget *parent,
     {
         ui->imagingCameraSelector->clear();
         refreshCameraSelector(ui, availableCameraFiles, aPreferredCameraId);
+        // The selected camera is already read, parse the others in the background so switching to them is instant
+        OptimalExposure::FileUtilityCameraData::preloadCameraDataFiles(availableCameraFiles);
 
         ui->exposureCalculatorFrame->setEnabled(false);
 
@@ -20,6 +20,8 @@
 #include <QDirIterator>
 #include <QXmlStreamWriter>
 #include <QXmlStreamReader>
+#include <QFileInfo>
+#include <QtConcurrent>
 #include "fileutilitycameradata.h"
 #include "imagingcameradata.h"
 #include "cameragainreadnoise.h"
@@ -43,6 +45,10 @@ QString const OptimalExposure::FileUtilityCameraData::cameraApplicationDataRepos
 QString const OptimalExposure::FileUtilityCameraData::cameraLocalDataRepository
     = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("kstars/cameradata/");
 
+QHash<QString, OptimalExposure::FileUtilityCameraData::CachedCameraData>
+OptimalExposure::FileUtilityCameraData::cameraDataCache;
+QMutex OptimalExposure::FileUtilityCameraData::cameraDataCacheMutex;
+
 QStringList OptimalExposure::FileUtilityCameraData::getAvailableCameraFilesList()
 {
     QStringList cameraDataFiles;
@@ -305,6 +311,53 @@ void OptimalExposure::FileUtilityCameraData::downloadCameraDataFile(
 int OptimalExposure::FileUtilityCameraData::readCameraDataFile(QString aCameraDataFile,
         OptimalExposure::ImagingCameraData *anImagingCameraData)
 {
+    const QDateTime lastModified = QFileInfo(aCameraDataFile).lastModified();
+    {
+        QMutexLocker locker(&cameraDataCacheMutex);
+        auto cached = cameraDataCache.constFind(aCameraDataFile);
+        if (cached != cameraDataCache.constEnd() && cached->lastModified == lastModified)
+        {
+            *anImagingCameraData = cached->data;
+            return 0;
+        }
+    }
+
+    if (parseCameraDataFile(aCameraDataFile, anImagingCameraData))
+    {
+        QMutexLocker locker(&cameraDataCacheMutex);
+        cameraDataCache.insert(aCameraDataFile, {lastModified, *anImagingCameraData});
+    }
+    return 0;
+}
+
+void OptimalExposure::FileUtilityCameraData::preloadCameraDataFiles(const QStringList &cameraDataFiles)
+{
+    QStringList pending;
+    {
+        QMutexLocker locker(&cameraDataCacheMutex);
+        for (const QString &aCameraDataFile : cameraDataFiles)
+            if (!cameraDataCache.contains(aCameraDataFile))
+                pending.append(aCameraDataFile);
+    }
+    if (pending.isEmpty())
+        return;
+
+    // Fire and forget, readCameraDataFile() parses a file itself when its preload has not reached it yet
+    QtConcurrent::run([pending]() mutable
+    {
+        QtConcurrent::blockingMap(pending, [](const QString & aCameraDataFile)
+        {
+            OptimalExposure::ImagingCameraData anImagingCameraData;
+            readCameraDataFile(aCameraDataFile, &anImagingCameraData);
+        });
+    });
+}
+
+bool OptimalExposure::FileUtilityCameraData::parseCameraDataFile(const QString &aCameraDataFile,
+        OptimalExposure::ImagingCameraData *anImagingCameraData)
+{
+    bool parsed = false;
+
     //    QString aCameraDataFile = OptimalExposure::FileUtilityCameraData::cameraApplicationDataRepository +
     //                              cameraIdToCameraDataFileName(cameraId);
 
@@ -471,6 +524,7 @@ int OptimalExposure::FileUtilityCameraData::readCameraDataFile(QString aCameraDa
 
                 }
                 // qCInfo(KSTARS_EKOS_CAPTURE) << "Read xml data for " + anImagingCameraData->getCameraId();
+                parsed = !xmlReader.hasError();
 
             }
             else
@@ -491,7 +545,7 @@ int OptimalExposure::FileUtilityCameraData::readCameraDataFile(QString aCameraDa
     }
 
     file.close();
-    return 0;
+    return parsed;
 }
 
 int OptimalExposure::FileUtilityCameraData::writeCameraDataFile(OptimalExposure::ImagingCameraData *anImagingCameraData)
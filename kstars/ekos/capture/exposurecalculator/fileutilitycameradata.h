@@ -15,6 +15,9 @@
 #include <QtNetwork/QNetworkReply>
 #include <QUrl>
 #include <QTimer>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
 #include "imagingcameradata.h"
 #include "cameragainreadnoise.h"
 #include "fileutilitycameradatadialog.h"
@@ -35,6 +38,8 @@ class FileUtilityCameraData
         void static downloadRepositoryCameraDataFileList(QDialog *aDialog);
         void static downloadCameraDataFile(QString cameraId, QDialog *aDialog);
         int static readCameraDataFile(QString cameraId, ImagingCameraData *anImagingCameraData);
+        // Parse the camera data files in parallel in the background, so selecting any of them later needs no parsing
+        void static preloadCameraDataFiles(const QStringList &cameraDataFiles);
         int static writeCameraDataFile(ImagingCameraData *anImagingCameraData);
         void static buildCameraDataFile();
         void static initializeCameraDataPaths();
@@ -47,6 +52,18 @@ class FileUtilityCameraData
 
         QString static const cameraDataRemoteRepositoryList;
         QString static const cameraDataRemoteRepository;
+
+    private:
+        bool static parseCameraDataFile(const QString &aCameraDataFile, ImagingCameraData *anImagingCameraData);
+
+        // Camera data already parsed in this session, by file, with the modification time of the file it was parsed from
+        struct CachedCameraData
+        {
+            QDateTime lastModified;
+            ImagingCameraData data;
+        };
+        static QHash<QString, CachedCameraData> cameraDataCache;
+        static QMutex cameraDataCacheMutex;
 };
 }
 
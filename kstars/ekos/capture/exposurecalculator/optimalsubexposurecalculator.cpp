@@ -155,43 +155,36 @@ QVector<CalculatedGainSubExposureTime> OptimalSubExposureCalculator::calculateGa
     // qCInfo(KSTARS_EKOS_CAPTURE) << "Calculating gain sub-exposure vector: ";
     QVector<CalculatedGainSubExposureTime> aCalculatedGainSubExposureTimeVector;
 
-    OptimalExposure::CameraGainReadMode aSelectedReadMode =
+    const OptimalExposure::CameraGainReadMode aSelectedReadMode =
         anImagingCameraData.getCameraGainReadModeVector()[aSelectedCameraReadMode];
     // qCInfo(KSTARS_EKOS_CAPTURE) << "\t with camera read mode: "
     //  << aSelectedReadMode.getCameraGainReadModeName();
 
-    QVector<OptimalExposure::CameraGainReadNoise> aCameraGainReadNoiseVector
+    const QVector<OptimalExposure::CameraGainReadNoise> &aCameraGainReadNoiseVector
         = aSelectedReadMode.getCameraGainReadNoiseVector();
 
-    for(QVector<OptimalExposure::CameraGainReadNoise>::iterator rn = aCameraGainReadNoiseVector.begin();
-            rn != aCameraGainReadNoiseVector.end(); ++rn)
+    // A color sensor spreads the light pollution over its three channels
+    double aSensorFactor = 0.0;
+    switch(anImagingCameraData.getSensorType())
     {
-        int aGain = rn->getGain();
-        // qCInfo(KSTARS_EKOS_CAPTURE) << "At a gain of: " << aGain;
-        double aReadNoise = rn->getReadNoise();
-        // qCInfo(KSTARS_EKOS_CAPTURE) << "\t camera read-noise is: " << aReadNoise;
-
-        // initial sub exposure.
-        double anOptimalSubExposure = 0.0;
-
-
-        switch(anImagingCameraData.getSensorType())
-        {
-            case SENSORTYPE_MONOCHROME:
-                anOptimalSubExposure =  cFactor * pow(aReadNoise, 2) / lightPollutionForOpticFocalRatio;
-                break;
-
-            case SENSORTYPE_COLOR:
-                anOptimalSubExposure = (double)3.0 * cFactor * pow(aReadNoise, 2) / lightPollutionForOpticFocalRatio;
-                break;
-        }
-
-        // qCInfo(KSTARS_EKOS_CAPTURE) << "anOptimalSubExposure is: " << anOptimalSubExposure;
-
-        CalculatedGainSubExposureTime *aSubExposureTime = new CalculatedGainSubExposureTime(aGain, anOptimalSubExposure);
+        case SENSORTYPE_MONOCHROME:
+            aSensorFactor = 1.0;
+            break;
 
-        aCalculatedGainSubExposureTimeVector.append(*aSubExposureTime);
+        case SENSORTYPE_COLOR:
+            aSensorFactor = 3.0;
+            break;
+    }
+    const double anExposureFactor = aSensorFactor * cFactor / lightPollutionForOpticFocalRatio;
 
+    // One pass over the read-noise table, straight into a vector sized for it
+    aCalculatedGainSubExposureTimeVector.reserve(aCameraGainReadNoiseVector.size());
+    for(const OptimalExposure::CameraGainReadNoise &rn : aCameraGainReadNoiseVector)
+    {
+        const double aReadNoise = rn.getReadNoise();
+        // qCInfo(KSTARS_EKOS_CAPTURE) << "At a gain of: " << rn.getGain() << " camera read-noise is: " << aReadNoise;
+        aCalculatedGainSubExposureTimeVector.append(CalculatedGainSubExposureTime(rn.getGain(),
+                anExposureFactor * aReadNoise * aReadNoise));
     }
 
     return aCalculatedGainSubExposureTimeVector;
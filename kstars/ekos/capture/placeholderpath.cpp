@@ -9,6 +9,14 @@
 #include "sequencejob.h"
 #include "kspaths.h"
 
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QHash>
+#include <QMutex>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 
@@ -273,6 +281,44 @@ QString PlaceholderPath::generateReplacement(const QMap<PathProperty, QVariant>
     }
 }
 
+QVector<PlaceholderPath::Placeholder> PlaceholderPath::formatPlaceholders(const QString &format)
+{
+    static const QRegularExpression
+#if defined(Q_OS_WIN)
+    re("(?<replace>\\%(?<name>(filename|f|Datetime|D|Type|T|exposure|e|exp|E|Filter|F|target|t|temperature|C|bin|B|gain|G|offset|O|iso|I|pierside|P|sequence|s))(?<level>\\d+)?)(?<sep>[_\\\\])?");
+#else
+    re("(?<replace>\\%(?<name>(filename|f|Datetime|D|Type|T|exposure|e|exp|E|Filter|F|target|t|temperature|C|bin|B|gain|G|offset|O|iso|I|pierside|P|sequence|s))(?<level>\\d+)?)(?<sep>[_/])?");
+#endif
+    static QMutex mutex;
+    static QHash<QString, QVector<Placeholder>> formats;
+
+    QMutexLocker locker(&mutex);
+    auto cached = formats.constFind(format);
+    if (cached != formats.constEnd())
+        return *cached;
+
+    // Only a handful of formats are used in a session, but keep the cache bounded anyway.
+    if (formats.size() >= 256)
+        formats.clear();
+
+    QVector<Placeholder> placeholders;
+    auto matches = re.globalMatch(format);
+    while (matches.hasNext())
+    {
+        const auto match = matches.next();
+        Placeholder placeholder;
+        placeholder.name = match.captured("name");
+        placeholder.level = match.captured("level").toInt();
+        placeholder.start = match.capturedStart();
+        placeholder.length = match.capturedLength();
+        placeholder.replaceLength = match.capturedLength("replace");
+        placeholders.append(placeholder);
+    }
+
+    formats.insert(format, placeholders);
+    return placeholders;
+}
+
 QString PlaceholderPath::generateFilenameInternal(const QMap<PathProperty, QVariant> &pathPropertyMap,
         const bool local,
         const bool batch_mode,
@@ -283,7 +329,6 @@ QString PlaceholderPath::generateFilenameInternal(const QMap<PathProperty, QVari
         const bool gettingSignature) const
 {
     QString targetNameSanitized = KSUtils::sanitize(pathPropertyMap[PP_TARGETNAME].toString());
-    int i = 0;
 
     const QString format = pathPropertyMap[PP_FORMAT].toString();
     const bool isDarkFlat = pathPropertyMap[PP_DARKFLAT].isValid() && pathPropertyMap[PP_DARKFLAT].toBool();
@@ -309,20 +354,18 @@ QString PlaceholderPath::generateFilenameInternal(const QMap<PathProperty, QVari
 #if defined(Q_OS_WIN)
     tempFormat.replace("\\", "/");
 #endif
-    QRegularExpressionMatch match;
-    QRegularExpression
-#if defined(Q_OS_WIN)
-    re("(?<replace>\\%(?<name>(filename|f|Datetime|D|Type|T|exposure|e|exp|E|Filter|F|target|t|temperature|C|bin|B|gain|G|offset|O|iso|I|pierside|P|sequence|s))(?<level>\\d+)?)(?<sep>[_\\\\])?");
-#else
-    re("(?<replace>\\%(?<name>(filename|f|Datetime|D|Type|T|exposure|e|exp|E|Filter|F|target|t|temperature|C|bin|B|gain|G|offset|O|iso|I|pierside|P|sequence|s))(?<level>\\d+)?)(?<sep>[_/])?");
-#endif
+    // Placeholders are located once per format, file names are generated for every captured frame.
+    const QVector<Placeholder> placeholders = formatPlaceholders(tempFormat);
+    QString result;
+    int position = 0;
 
-    while ((i = tempFormat.indexOf(re, i, &match)) != -1)
+    for (const auto &placeholder : placeholders)
     {
         QString replacement = "";
-        if ((match.captured("name") == "filename") || (match.captured("name") == "f"))
+        const QString &name = placeholder.name;
+        if ((name == "filename") || (name == "f"))
             replacement = m_seqFilename.baseName();
-        else if ((match.captured("name") == "Datetime") || (match.captured("name") == "D"))
+        else if ((name == "Datetime") || (name == "D"))
         {
             if (glob || gettingSignature)
             {
@@ -335,15 +378,15 @@ QString PlaceholderPath::generateFilenameInternal(const QMap<PathProperty, QVari
             else
                 replacement = QDateTime::currentDateTime().toString("yyyy-MM-ddThh-mm-ss");
         }
-        else if ((match.captured("name") == "Type") || (match.captured("name") == "T"))
+        else if ((name == "Type") || (name == "T"))
         {
             if (isDarkFlat)
                 replacement = "DarkFlat";
             else
                 replacement = getFrameType(frameType);
         }
-        else if ((match.captured("name") == "exposure") || (match.captured("name") == "e") ||
-                 (match.captured("name") == "exp") || (match.captured("name") == "E"))
+        else if ((name == "exposure") || (name == "e") ||
+                 (name == "exp") || (name == "E"))
         {
             double fractpart, intpart;
             double exposure = pathPropertyMap[PP_EXPOSURE].toDouble();
@@ -355,10 +398,10 @@ QString PlaceholderPath::generateFilenameInternal(const QMap<PathProperty, QVari
             else
                 replacement = QString::number(exposure, 'f', 6);
             // append _secs for placeholders "exposure" and "e"
-            if ((match.captured("name") == "exposure") || (match.captured("name") == "e"))
+            if ((name == "exposure") || (name == "e"))
                 replacement += QString("_secs");
         }
-        else if ((match.captured("name") == "Filter") || (match.captured("name") == "F"))
+        else if ((name == "Filter") || (name == "F"))
         {
             QString filter = pathPropertyMap[PP_FILTER].toString();
             if (filter.isEmpty() == false
@@ -370,43 +413,43 @@ QString PlaceholderPath::generateFilenameInternal(const QMap<PathProperty, QVari
                 replacement = filter;
             }
         }
-        else if ((match.captured("name") == "target") || (match.captured("name") == "t"))
+        else if ((name == "target") || (name == "t"))
         {
             replacement = targetNameSanitized;
         }
-        else if (((match.captured("name") == "temperature") || (match.captured("name") == "C")))
+        else if (((name == "temperature") || (name == "C")))
         {
             replacement = generateReplacement(pathPropertyMap, PP_TEMPERATURE,
                                               (glob || gettingSignature) && pathPropertyMap[PP_TEMPERATURE].isValid() == false);
         }
-        else if (((match.captured("name") == "bin") || (match.captured("name") == "B")))
+        else if (((name == "bin") || (name == "B")))
         {
             replacement = generateReplacement(pathPropertyMap, PP_BIN,
                                               (glob || gettingSignature) && pathPropertyMap[PP_BIN].isValid() == false);
         }
-        else if (((match.captured("name") == "gain") || (match.captured("name") == "G")))
+        else if (((name == "gain") || (name == "G")))
         {
             replacement = generateReplacement(pathPropertyMap, PP_GAIN,
                                               (glob || gettingSignature) && pathPropertyMap[PP_GAIN].isValid() == false);
         }
-        else if (((match.captured("name") == "offset") || (match.captured("name") == "O")))
+        else if (((name == "offset") || (name == "O")))
         {
             replacement = generateReplacement(pathPropertyMap, PP_OFFSET,
                                               (glob || gettingSignature) && pathPropertyMap[PP_OFFSET].isValid() == false);
         }
-        else if (((match.captured("name") == "iso") || (match.captured("name") == "I"))
+        else if (((name == "iso") || (name == "I"))
                  && pathPropertyMap[PP_ISO].isValid())
         {
             replacement = generateReplacement(pathPropertyMap, PP_ISO,
                                               (glob || gettingSignature) && pathPropertyMap[PP_ISO].isValid() == false);
         }
-        else if (((match.captured("name") == "pierside") || (match.captured("name") == "P")))
+        else if (((name == "pierside") || (name == "P")))
         {
             replacement = generateReplacement(pathPropertyMap, PP_PIERSIDE, glob || gettingSignature);
         }
         // Disable for now %d & %p tags to simplfy
-        //        else if ((match.captured("name") == "directory") || (match.captured("name") == "d") ||
-        //                 (match.captured("name") == "path") || (match.captured("name") == "p"))
+        //        else if ((name == "directory") || (name == "d") ||
+        //                 (name == "path") || (name == "p"))
         //        {
         //            int level = 0;
         //            if (!match.captured("level").isEmpty())
@@ -414,21 +457,18 @@ QString PlaceholderPath::generateFilenameInternal(const QMap<PathProperty, QVari
         //            QFileInfo dir = m_seqFilename;
         //            for (int j = 0; j < level; ++j)
         //                dir = QFileInfo(dir.dir().path());
-        //            if (match.captured("name") == "directory" || match.captured("name") == "d")
+        //            if (name == "directory" || name == "d")
         //                replacement = dir.dir().dirName();
-        //            else if (match.captured("name") == "path" || match.captured("name") == "p")
+        //            else if (name == "path" || name == "p")
         //                replacement = dir.path();
         //        }
-        else if ((match.captured("name") == "sequence") || (match.captured("name") == "s"))
+        else if ((name == "sequence") || (name == "s"))
         {
             if (glob)
                 replacement = "(?<id>\\d+)";
             else if (local)
             {
-                int level = 0;
-                if (!match.captured("level").isEmpty())
-                    level = match.captured("level").toInt();
-                replacement = QString("%1").arg(nextSequenceID, level, 10, QChar('0'));
+                replacement = QString("%1").arg(nextSequenceID, placeholder.level, 10, QChar('0'));
             }
             else
             {
@@ -437,14 +477,20 @@ QString PlaceholderPath::generateFilenameInternal(const QMap<PathProperty, QVari
             }
         }
         else
-            qWarning() << "Unknown replacement string: " << match.captured("replace");
+            qWarning() << "Unknown replacement string: " << tempFormat.mid(placeholder.start, placeholder.replaceLength);
 
+        result += tempFormat.mid(position, placeholder.start - position);
+        // An empty replacement also drops the separator that follows the placeholder
         if (replacement.isEmpty())
-            tempFormat = tempFormat.replace(match.capturedStart(), match.capturedLength(), replacement);
+            position = placeholder.start + placeholder.length;
         else
-            tempFormat = tempFormat.replace(match.capturedStart("replace"), match.capturedLength("replace"), replacement);
-        i += replacement.length();
+        {
+            result += replacement;
+            position = placeholder.start + placeholder.replaceLength;
+        }
     }
+    result += tempFormat.mid(position);
+    tempFormat = result;
 
     if (!gettingSignature)
         tempFilename = tempFormat + extension;
@@ -534,18 +580,205 @@ QList<int> PlaceholderPath::getCompletedFileIds(const SequenceJob &job)
     filename.replace("{IDRE}", idRE);
     filename.replace("{DATETIMERE}", datetimeRE);
 
-    QStringList matchingFiles = dir.entryList(QDir::Files);
-    QRegularExpressionMatch match;
-    QRegularExpression re("^" + filename + "$");
-    QList<int> ids = {};
-    for (auto &name : matchingFiles)
+    return indexedFileIds(dir.path(), "^" + filename + "$");
+}
+
+namespace
+{
+// Files of the directories sequence IDs were looked up in, so that capture does not list directories with
+// thousands of frames again for every new one. A listing is trusted as long as the modification time of its
+// directory does not change, and only if the directory had not been modified shortly before it was listed,
+// since the coarse time resolution of some file systems could otherwise hide a change made right after.
+struct DirectoryIndex
+{
+    QDateTime modified;
+    bool stable { false };
+    QSet<QString> files;
+    // File name patterns looked up in the directory, with the sequence IDs of the matching files
+    QHash<QString, QPair<QRegularExpression, QList<int>>> ids;
+    // Base name patterns looked up in the directory, with the number of matching files
+    QHash<QString, QPair<QRegularExpression, int>> counts;
+};
+
+// FAT file systems store modification times in 2 second steps
+constexpr qint64 MODIFICATION_TIME_RESOLUTION_MS = 2000;
+
+QMutex directoryIndexMutex;
+QHash<QString, DirectoryIndex> directoryIndex;
+
+// The listings are kept in the cache between sessions, so that the first lookup in a directory
+// with many frames doesn't list it either, as long as the directory did not change since.
+constexpr quint32 FILE_INDEX_VERSION = 1;
+bool directoryIndexLoaded = false;
+bool directoryIndexChanged = false;
+
+QString fileIndexPath()
+{
+    return QDir(KSPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("captureindex.dat");
+}
+
+// Reads the listings saved by PlaceholderPath::saveFileIndex(). directoryIndexMutex must be locked.
+void loadDirectoryIndex()
+{
+    directoryIndexLoaded = true;
+
+    QFile file(fileIndexPath());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    quint32 version = 0;
+    QHash<QString, QPair<QDateTime, QSet<QString>>> saved;
+    in >> version;
+    if (version != FILE_INDEX_VERSION)
+        return;
+    in >> saved;
+    if (in.status() != QDataStream::Ok)
     {
-        match = re.match(name);
-        if (match.hasMatch())
-            ids << match.captured("id").toInt();
+        qCWarning(KSTARS_EKOS_CAPTURE) << "Ignoring corrupt capture file index" << file.fileName();
+        return;
     }
 
-    return ids;
+    for (auto it = saved.cbegin(); it != saved.cend(); ++it)
+    {
+        if (directoryIndex.contains(it.key()))
+            continue;
+        DirectoryIndex &index = directoryIndex[it.key()];
+        index.modified = it.value().first;
+        index.stable = true;
+        index.files = it.value().second;
+    }
+}
+
+// Returns the index of the directory, listing it again if it may have changed. directoryIndexMutex must be locked.
+DirectoryIndex &lockedDirectoryIndex(const QString &key)
+{
+    if (directoryIndexLoaded == false)
+        loadDirectoryIndex();
+
+    const QDateTime modified = QFileInfo(key).lastModified();
+
+    DirectoryIndex &index = directoryIndex[key];
+    if (index.stable == false || modified.isValid() == false || index.modified != modified)
+    {
+        directoryIndexChanged = true;
+        const QStringList files = QDir(key).entryList(QDir::Files);
+        index.files.clear();
+        for (const auto &name : files)
+            index.files.insert(name);
+        index.modified = modified;
+        index.stable = modified.isValid() && modified.msecsTo(QDateTime::currentDateTime()) > MODIFICATION_TIME_RESOLUTION_MS;
+        index.ids.clear();
+        index.counts.clear();
+    }
+    return index;
+}
+}
+
+QList<int> PlaceholderPath::indexedFileIds(const QString &directory, const QString &pattern)
+{
+    const QString key = QDir::cleanPath(directory);
+
+    QMutexLocker locker(&directoryIndexMutex);
+    DirectoryIndex &index = lockedDirectoryIndex(key);
+
+    auto ids = index.ids.find(pattern);
+    if (ids == index.ids.end())
+    {
+        QRegularExpression re(pattern);
+        QList<int> matchingIds;
+        for (const auto &name : qAsConst(index.files))
+        {
+            const auto match = re.match(name);
+            if (match.hasMatch())
+                matchingIds << match.captured("id").toInt();
+        }
+        ids = index.ids.insert(pattern, qMakePair(re, matchingIds));
+    }
+
+    return ids->second;
+}
+
+int PlaceholderPath::indexedFileCount(const QString &directory, const QString &pattern)
+{
+    const QString key = QDir::cleanPath(directory);
+
+    QMutexLocker locker(&directoryIndexMutex);
+    DirectoryIndex &index = lockedDirectoryIndex(key);
+
+    auto count = index.counts.find(pattern);
+    if (count == index.counts.end())
+    {
+        QRegularExpression re(pattern);
+        int matching = 0;
+        for (const auto &name : qAsConst(index.files))
+        {
+            if (re.match(QFileInfo(name).completeBaseName()).hasMatch())
+                matching++;
+        }
+        count = index.counts.insert(pattern, qMakePair(re, matching));
+    }
+
+    return count->second;
+}
+
+void PlaceholderPath::addToFileIndex(const QString &filename)
+{
+    const QFileInfo info(filename);
+    const QString key = QDir::cleanPath(info.path());
+
+    QMutexLocker locker(&directoryIndexMutex);
+    auto index = directoryIndex.find(key);
+    if (index == directoryIndex.end())
+        return;
+
+    const QString name = info.fileName();
+    if (index->files.contains(name) == false)
+    {
+        index->files.insert(name);
+        for (auto &ids : index->ids)
+        {
+            const auto match = ids.first.match(name);
+            if (match.hasMatch())
+                ids.second << match.captured("id").toInt();
+        }
+        const QString baseName = info.completeBaseName();
+        for (auto &count : index->counts)
+        {
+            if (count.first.match(baseName).hasMatch())
+                count.second++;
+        }
+    }
+    // The directory changed because of this file only, so the listing stays complete.
+    index->modified = QFileInfo(key).lastModified();
+    directoryIndexChanged = true;
+}
+
+void PlaceholderPath::saveFileIndex()
+{
+    QMutexLocker locker(&directoryIndexMutex);
+    if (directoryIndexChanged == false)
+        return;
+
+    // Listings that may miss a change are not worth keeping.
+    QHash<QString, QPair<QDateTime, QSet<QString>>> saved;
+    for (auto it = directoryIndex.cbegin(); it != directoryIndex.cend(); ++it)
+    {
+        if (it.value().stable)
+            saved.insert(it.key(), qMakePair(it.value().modified, it.value().files));
+    }
+
+    QDir().mkpath(QFileInfo(fileIndexPath()).path());
+    QSaveFile file(fileIndexPath());
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(KSTARS_EKOS_CAPTURE) << "Unable to save the capture file index" << file.fileName();
+        return;
+    }
+    QDataStream out(&file);
+    out << FILE_INDEX_VERSION << saved;
+    if (file.commit())
+        directoryIndexChanged = false;
 }
 
 int PlaceholderPath::getCompletedFiles(const SequenceJob &job)
@@ -555,7 +788,6 @@ int PlaceholderPath::getCompletedFiles(const SequenceJob &job)
 
 int PlaceholderPath::getCompletedFiles(const QString &path)
 {
-    int seqFileCount = 0;
 #ifdef Q_OS_WIN
     // Splitting directory and baseName in QFileInfo does not distinguish regular expression backslash from directory separator on Windows.
     // So do not use QFileInfo for the code that separates directory and basename for Windows.
@@ -589,21 +821,8 @@ int PlaceholderPath::getCompletedFiles(const QString &path)
     QString const sig_dir(path_info.dir().path());
     QString const sig_file(path_info.completeBaseName());
 #endif
-    QRegularExpression re(sig_file);
-
-    QDirIterator it(sig_dir, QDir::Files);
-
     /* FIXME: this counts all files with prefix in the storage location, not just captures. DSS analysis files are counted in, for instance. */
-    while (it.hasNext())
-    {
-        QString const fileName = QFileInfo(it.next()).completeBaseName();
-
-        QRegularExpressionMatch match = re.match(fileName);
-        if (match.hasMatch())
-            seqFileCount++;
-    }
-
-    return seqFileCount;
+    return indexedFileCount(sig_dir, sig_file);
 }
 
 int PlaceholderPath::checkSeqBoundary(const SequenceJob &job)
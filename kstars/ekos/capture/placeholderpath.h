@@ -10,6 +10,7 @@
 #include "indi/indistd.h"
 #include <QDebug>
 #include <QFileInfo>
+#include <QVector>
 
 class QString;
 class SchedulerJob;
@@ -151,6 +152,19 @@ class PlaceholderPath
          */
         int checkSeqBoundary(const SequenceJob &job);
 
+        /**
+         * @brief addToFileIndex Record a file just created, so that looking up sequence IDs in its directory
+         * does not need to list the directory again.
+         * @param filename full path of the file
+         */
+        static void addToFileIndex(const QString &filename);
+
+        /**
+         * @brief saveFileIndex Keep the directory listings of the file index for the next session, if they changed.
+         * They are loaded again with the first lookup, and trusted for the directories that did not change since.
+         */
+        static void saveFileIndex();
+
         /**
          * @brief Property type definitions
          */
@@ -187,6 +201,36 @@ class PlaceholderPath
         }
 
 private:
+        /**
+         * @brief The Placeholder struct locates a placeholder tag in a format string.
+         */
+        struct Placeholder
+        {
+            QString name;
+            int level { 0 };
+            // whole match including the separator that follows the tag, and the tag alone
+            int start { 0 };
+            int length { 0 };
+            int replaceLength { 0 };
+        };
+
+        /**
+         * @brief formatPlaceholders Placeholder tags of format, in order. Parsed once per format.
+         */
+        static QVector<Placeholder> formatPlaceholders(const QString &format);
+
+        /**
+         * @brief indexedFileIds Sequence IDs of the files in directory matching pattern, with a named "id" group.
+         * Directory listings are kept and only refreshed when the directory changes.
+         */
+        static QList<int> indexedFileIds(const QString &directory, const QString &pattern);
+
+        /**
+         * @brief indexedFileCount Number of the files in directory whose base name, without extension, matches pattern.
+         * Uses the same directory listings as indexedFileIds().
+         */
+        static int indexedFileCount(const QString &directory, const QString &pattern);
+
         // TODO use QVariantMap or QVariantList instead of passing this many args.
         QString generateFilenameInternal(const QMap<PathProperty, QVariant> &pathPropertyMap, const bool local, const bool batch_mode, const int nextSequenceID, const QString &extension,
                                  const QString &filename, const bool glob = false, const bool gettingSignature = false) const;
@@ -122,6 +122,21 @@ void RefocusState::addHFRValue(const QString &filter)
 
 
 
+void RefocusState::autoFocusCompleted()
+{
+    // time and temperature based refocusing count from now on
+    startRefocusTimer(true);
+    if (isRefocusAfterMeridianFlip())
+    {
+        setRefocusAfterMeridianFlip(false);
+        appendLogText(i18n("Refocus after meridian flip not needed, Autofocus just completed."));
+    }
+    if (isInSequenceFocus())
+        resetInSequenceFocusCounter();
+    // no adaptive focus on top of a fresh Autofocus
+    setAdaptiveFocusDone(true);
+}
+
 void RefocusState::appendLogText(const QString &message)
 {
     qCInfo(KSTARS_EKOS_CAPTURE()) << message;
@@ -157,6 +157,13 @@ class RefocusState : public QObject
          */
         void addHFRValue(const QString &filter);
 
+        /**
+         * @brief A full Autofocus run has completed, whoever triggered it (e.g. the filter manager
+         *        after a filter change). It satisfies every refocus trigger pending at that time, so
+         *        they are cleared instead of running another Autofocus right after it.
+         */
+        void autoFocusCompleted();
+
     signals:
         // new log text for the module log window
         void newLog(const QString &text);
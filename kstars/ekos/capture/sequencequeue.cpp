@@ -14,172 +14,229 @@
 #include "ksnotification.h"
 #include "sequencejob.h"
 
+#include <QFileInfo>
+#include <QMutex>
+
 // Current Sequence File Format:
 constexpr double SQ_FORMAT_VERSION = 2.6;
 // We accept file formats with version back to:
 constexpr double SQ_COMPAT_VERSION = 2.0;
 
+namespace
+{
+// Sequence files parsed by SequenceQueue::parseFile(), so that neither the capture module switching between
+// the jobs of a schedule nor the scheduler estimating them read and parse the same files again every time.
+// A file is parsed again once its size or modification time changes.
+// As for the capture directory index, an entry is only kept if the file had not been modified shortly
+// before it was read, since the coarse time resolution of some file systems could hide a change made right after.
+struct ParsedSequence
+{
+    QDateTime modified;
+    qint64 size { -1 };
+    QList<std::shared_ptr<XMLEle>> roots;
+};
+
+// FAT file systems store modification times in 2 second steps
+constexpr qint64 MODIFICATION_TIME_RESOLUTION_MS = 2000;
+
+QMutex parsedSequencesMutex;
+QHash<QString, ParsedSequence> parsedSequences;
+}
+
 namespace Ekos
 {
 
+bool SequenceQueue::parseFile(const QString &fileURL, QList<std::shared_ptr<XMLEle>> &roots, QString &errorText)
+{
+    const QFileInfo info(fileURL);
+    const QDateTime modified = info.lastModified();
+    const qint64 size = info.size();
+
+    QMutexLocker locker(&parsedSequencesMutex);
+    auto cached = parsedSequences.constFind(fileURL);
+    if (cached != parsedSequences.constEnd() && modified.isValid() && cached->modified == modified && cached->size == size)
+    {
+        roots = cached->roots;
+        return true;
+    }
+    parsedSequences.remove(fileURL);
+
+    QFile sFile;
+    sFile.setFileName(fileURL);
+
+    if (!sFile.open(QIODevice::ReadOnly))
+    {
+        errorText = i18n("Unable to open sequence queue file '%1'", fileURL);
+        return false;
+    }
+    const QByteArray content = sFile.readAll();
+
+    LilXML *xmlParser = newLilXML();
+    char errmsg[MAXRBUF];
+    QList<std::shared_ptr<XMLEle>> parsed;
+
+    for (const char c : content)
+    {
+        XMLEle *root = readXMLEle(xmlParser, c, errmsg);
+
+        if (root)
+            parsed.append(std::shared_ptr<XMLEle>(root, delXMLEle));
+        else if (errmsg[0])
+        {
+            errorText = QString(errmsg);
+            delLilXML(xmlParser);
+            return false;
+        }
+    }
+    delLilXML(xmlParser);
+
+    if (modified.isValid() && modified.msecsTo(QDateTime::currentDateTime()) > MODIFICATION_TIME_RESOLUTION_MS)
+        parsedSequences.insert(fileURL, {modified, size, parsed});
+    roots = parsed;
+    return true;
+}
+
 bool SequenceQueue::load(const QString &fileURL, const QString &targetName,
                          const QSharedPointer<CaptureDeviceAdaptor> devices,
                          const QSharedPointer<CaptureModuleState> state)
 {
-    QFile sFile(fileURL);
-    if (!sFile.open(QIODevice::ReadOnly))
+    QList<std::shared_ptr<XMLEle>> roots;
+    QString errorText;
+    if (!parseFile(fileURL, roots, errorText))
     {
-        QString message = i18n("Unable to open file %1", fileURL);
-        KSNotification::sorry(message, i18n("Could Not Open File"));
+        emit newLog(errorText);
         return false;
     }
 
-    LilXML * xmlParser = newLilXML();
-
-    char errmsg[MAXRBUF];
-    XMLEle * root = nullptr;
     XMLEle * ep   = nullptr;
-    char c;
 
     // We expect all data read from the XML to be in the C locale - QLocale::c().
     QLocale cLocale = QLocale::c();
 
-    while (sFile.getChar(&c))
+    for (const auto &element : roots)
     {
-        root = readXMLEle(xmlParser, c, errmsg);
+        XMLEle *root = element.get();
+        double sqVersion = cLocale.toDouble(findXMLAttValu(root, "version"));
+        if (sqVersion < SQ_COMPAT_VERSION)
+        {
+            emit newLog(i18n("Deprecated sequence file format version %1. Please construct a new sequence file.",
+                             sqVersion));
+            return false;
+        }
 
-        if (root)
+        for (ep = nextXMLEle(root, 1); ep != nullptr; ep = nextXMLEle(root, 0))
         {
-            double sqVersion = cLocale.toDouble(findXMLAttValu(root, "version"));
-            if (sqVersion < SQ_COMPAT_VERSION)
+            if (!strcmp(tagXMLEle(ep), "Observer"))
             {
-                emit newLog(i18n("Deprecated sequence file format version %1. Please construct a new sequence file.",
-                                 sqVersion));
-                return false;
+                state->setObserverName(QString(pcdataXMLEle(ep)));
             }
-
-            for (ep = nextXMLEle(root, 1); ep != nullptr; ep = nextXMLEle(root, 0))
+            else if (!strcmp(tagXMLEle(ep), "GuideDeviation"))
             {
-                if (!strcmp(tagXMLEle(ep), "Observer"))
-                {
-                    state->setObserverName(QString(pcdataXMLEle(ep)));
-                }
-                else if (!strcmp(tagXMLEle(ep), "GuideDeviation"))
-                {
-                    m_GuideDeviationSet = true;
-                    m_EnforceGuideDeviation = !strcmp(findXMLAttValu(ep, "enabled"), "true");
-                    m_GuideDeviation = cLocale.toDouble(pcdataXMLEle(ep));
-                }
-                else if (!strcmp(tagXMLEle(ep), "CCD"))
-                {
-                    // Old field in some files. Without this empty test, it would fall through to the else condition and create a job.
-                }
-                else if (!strcmp(tagXMLEle(ep), "FilterWheel"))
-                {
-                    // Old field in some files. Without this empty test, it would fall through to the else condition and create a job.
-                }
-                else if (!strcmp(tagXMLEle(ep), "GuideStartDeviation"))
-                {
-                    m_GuideStartDeviationSet = true;
-                    m_EnforceStartGuiderDrift = !strcmp(findXMLAttValu(ep, "enabled"), "true");
-                    m_StartGuideDeviation = cLocale.toDouble(pcdataXMLEle(ep));
-                }
-                else if (!strcmp(tagXMLEle(ep), "Autofocus"))
-                {
-                    // Old field in some files. Without this empty test, it would fall through to the else condition and create a job.
-                }
-                else if (!strcmp(tagXMLEle(ep), "HFRCheck"))
-                {
-                    m_AutofocusSet = true;
-                    m_EnforceAutofocusHFR = !strcmp(findXMLAttValu(ep, "enabled"), "true");
+                m_GuideDeviationSet = true;
+                m_EnforceGuideDeviation = !strcmp(findXMLAttValu(ep, "enabled"), "true");
+                m_GuideDeviation = cLocale.toDouble(pcdataXMLEle(ep));
+            }
+            else if (!strcmp(tagXMLEle(ep), "CCD"))
+            {
+                // Old field in some files. Without this empty test, it would fall through to the else condition and create a job.
+            }
+            else if (!strcmp(tagXMLEle(ep), "FilterWheel"))
+            {
+                // Old field in some files. Without this empty test, it would fall through to the else condition and create a job.
+            }
+            else if (!strcmp(tagXMLEle(ep), "GuideStartDeviation"))
+            {
+                m_GuideStartDeviationSet = true;
+                m_EnforceStartGuiderDrift = !strcmp(findXMLAttValu(ep, "enabled"), "true");
+                m_StartGuideDeviation = cLocale.toDouble(pcdataXMLEle(ep));
+            }
+            else if (!strcmp(tagXMLEle(ep), "Autofocus"))
+            {
+                // Old field in some files. Without this empty test, it would fall through to the else condition and create a job.
+            }
+            else if (!strcmp(tagXMLEle(ep), "HFRCheck"))
+            {
+                m_AutofocusSet = true;
+                m_EnforceAutofocusHFR = !strcmp(findXMLAttValu(ep, "enabled"), "true");
 
-                    XMLEle *epHFR;
-                    //Set default values in case of malformed XML
-                    m_HFRDeviation = 0.0;
-                    m_HFRCheckAlgorithm = HFR_CHECK_LAST_AUTOFOCUS;
-                    m_HFRCheckThresholdPercentage = HFR_CHECK_DEFAULT_THRESHOLD;
-                    m_HFRCheckFrames = 1;
+                XMLEle *epHFR;
+                //Set default values in case of malformed XML
+                m_HFRDeviation = 0.0;
+                m_HFRCheckAlgorithm = HFR_CHECK_LAST_AUTOFOCUS;
+                m_HFRCheckThresholdPercentage = HFR_CHECK_DEFAULT_THRESHOLD;
+                m_HFRCheckFrames = 1;
 
-                    for (epHFR = nextXMLEle(ep, 1); epHFR != nullptr; epHFR = nextXMLEle(ep, 0))
+                for (epHFR = nextXMLEle(ep, 1); epHFR != nullptr; epHFR = nextXMLEle(ep, 0))
+                {
+                    if (!strcmp(tagXMLEle(epHFR), "HFRDeviation"))
                     {
-                        if (!strcmp(tagXMLEle(epHFR), "HFRDeviation"))
-                        {
-                            double const HFRValue = cLocale.toDouble(pcdataXMLEle(epHFR));
-                            // Set the HFR value from XML, or reset it to zero, don't let another unrelated older HFR be used
-                            if (HFRValue >= 0.0)
-                                m_HFRDeviation = HFRValue;
-                        }
-
-                        if (!strcmp(tagXMLEle(epHFR), "HFRCheckAlgorithm"))
-                        {
-                            int HFRCheckAlgo = cLocale.toInt(pcdataXMLEle(epHFR));
-                            // Set the HFR Check Algo from XML, or reset it to Last Autofocus
-                            if (HFRCheckAlgo >= 0 && HFRCheckAlgo < HFR_CHECK_MAX_ALGO)
-                                m_HFRCheckAlgorithm = static_cast<HFR_CHECK_ALGORITHM>(HFRCheckAlgo);
-                        }
-                        else if (!strcmp(tagXMLEle(epHFR), "HFRCheckThreshold"))
-                        {
-                            double const hFRCheckThreshold = cLocale.toDouble(pcdataXMLEle(epHFR));
-                            // Set the HFR Threshold Percentage from XML, or reset it to 10%, don't let another unrelated older value be used
-                            if (hFRCheckThreshold >= 0.0)
-                                m_HFRCheckThresholdPercentage = hFRCheckThreshold;
-                        }
-                        else if (!strcmp(tagXMLEle(epHFR), "HFRCheckFrames"))
-                        {
-                            int const hFRCheckFrames = cLocale.toInt(pcdataXMLEle(epHFR));
-                            // Set the HFR Frames from XML, or reset it to 1, don't let another unrelated older value be used
-                            if (hFRCheckFrames > 1)
-                                m_HFRCheckFrames = hFRCheckFrames;
-                        }
+                        double const HFRValue = cLocale.toDouble(pcdataXMLEle(epHFR));
+                        // Set the HFR value from XML, or reset it to zero, don't let another unrelated older HFR be used
+                        if (HFRValue >= 0.0)
+                            m_HFRDeviation = HFRValue;
+                    }
+
+                    if (!strcmp(tagXMLEle(epHFR), "HFRCheckAlgorithm"))
+                    {
+                        int HFRCheckAlgo = cLocale.toInt(pcdataXMLEle(epHFR));
+                        // Set the HFR Check Algo from XML, or reset it to Last Autofocus
+                        if (HFRCheckAlgo >= 0 && HFRCheckAlgo < HFR_CHECK_MAX_ALGO)
+                            m_HFRCheckAlgorithm = static_cast<HFR_CHECK_ALGORITHM>(HFRCheckAlgo);
+                    }
+                    else if (!strcmp(tagXMLEle(epHFR), "HFRCheckThreshold"))
+                    {
+                        double const hFRCheckThreshold = cLocale.toDouble(pcdataXMLEle(epHFR));
+                        // Set the HFR Threshold Percentage from XML, or reset it to 10%, don't let another unrelated older value be used
+                        if (hFRCheckThreshold >= 0.0)
+                            m_HFRCheckThresholdPercentage = hFRCheckThreshold;
+                    }
+                    else if (!strcmp(tagXMLEle(epHFR), "HFRCheckFrames"))
+                    {
+                        int const hFRCheckFrames = cLocale.toInt(pcdataXMLEle(epHFR));
+                        // Set the HFR Frames from XML, or reset it to 1, don't let another unrelated older value be used
+                        if (hFRCheckFrames > 1)
+                            m_HFRCheckFrames = hFRCheckFrames;
                     }
-                }
-                else if (!strcmp(tagXMLEle(ep), "RefocusOnTemperatureDelta"))
-                {
-                    m_RefocusOnTemperatureDeltaSet = true;
-                    m_EnforceAutofocusOnTemperature = !strcmp(findXMLAttValu(ep, "enabled"), "true");
-                    double const deltaValue = cLocale.toDouble(pcdataXMLEle(ep));
-                    m_MaxFocusTemperatureDelta = deltaValue;
-                }
-                else if (!strcmp(tagXMLEle(ep), "RefocusEveryN"))
-                {
-                    m_RefocusEveryNSet = true;
-                    m_EnforceRefocusEveryN = !strcmp(findXMLAttValu(ep, "enabled"), "true");
-                    int const minutesValue = cLocale.toInt(pcdataXMLEle(ep));
-                    // Set the refocus period from XML, or reset it to zero, don't let another unrelated older refocus period be used.
-                    m_RefocusEveryN = minutesValue > 0 ? minutesValue : 0;
-                }
-                else if (!strcmp(tagXMLEle(ep), "RefocusOnMeridianFlip"))
-                {
-                    m_RefocusOnMeridianFlipSet = true;
-                    m_RefocusAfterMeridianFlip = !strcmp(findXMLAttValu(ep, "enabled"), "true");
-                }
-                else if (!strcmp(tagXMLEle(ep), "MeridianFlip"))
-                {
-                    // meridian flip is managed by the mount only
-                    // older files might nevertheless contain MF settings
-                    if (! strcmp(findXMLAttValu(ep, "enabled"), "true"))
-                        emit newLog(
-                            i18n("Meridian flip configuration has been shifted to the mount module. Please configure the meridian flip there."));
-                }
-                else
-                {
-                    auto job = new SequenceJob(devices, state, SequenceJob::JOBTYPE_BATCH, ep, targetName);
-                    m_allJobs.append(job);
                 }
             }
-            delXMLEle(root);
-        }
-        else if (errmsg[0])
-        {
-            emit newLog(QString(errmsg));
-            delLilXML(xmlParser);
-            return false;
+            else if (!strcmp(tagXMLEle(ep), "RefocusOnTemperatureDelta"))
+            {
+                m_RefocusOnTemperatureDeltaSet = true;
+                m_EnforceAutofocusOnTemperature = !strcmp(findXMLAttValu(ep, "enabled"), "true");
+                double const deltaValue = cLocale.toDouble(pcdataXMLEle(ep));
+                m_MaxFocusTemperatureDelta = deltaValue;
+            }
+            else if (!strcmp(tagXMLEle(ep), "RefocusEveryN"))
+            {
+                m_RefocusEveryNSet = true;
+                m_EnforceRefocusEveryN = !strcmp(findXMLAttValu(ep, "enabled"), "true");
+                int const minutesValue = cLocale.toInt(pcdataXMLEle(ep));
+                // Set the refocus period from XML, or reset it to zero, don't let another unrelated older refocus period be used.
+                m_RefocusEveryN = minutesValue > 0 ? minutesValue : 0;
+            }
+            else if (!strcmp(tagXMLEle(ep), "RefocusOnMeridianFlip"))
+            {
+                m_RefocusOnMeridianFlipSet = true;
+                m_RefocusAfterMeridianFlip = !strcmp(findXMLAttValu(ep, "enabled"), "true");
+            }
+            else if (!strcmp(tagXMLEle(ep), "MeridianFlip"))
+            {
+                // meridian flip is managed by the mount only
+                // older files might nevertheless contain MF settings
+                if (! strcmp(findXMLAttValu(ep, "enabled"), "true"))
+                    emit newLog(
+                        i18n("Meridian flip configuration has been shifted to the mount module. Please configure the meridian flip there."));
+            }
+            else
+            {
+                auto job = new SequenceJob(devices, state, SequenceJob::JOBTYPE_BATCH, ep, targetName);
+                m_allJobs.append(job);
+            }
         }
     }
 
     state->setSequenceURL(QUrl::fromLocalFile(fileURL));
     state->setDirty(false);
-    delLilXML(xmlParser);
     return true;
 }
 
@@ -11,6 +11,8 @@
 #include <QString>
 #include "sequencejob.h"
 
+#include <memory>
+
 /**
  * @class SequenceJob
  * @short SequenceQueue represents a sequence of capture jobs to be executed
@@ -39,6 +41,14 @@ class SequenceQueue : public QObject
 
         bool save(const QString &path, const QString &observerName);
 
+        /**
+         * @brief parseFile Read the top level elements of a sequence file.
+         * The elements are kept until the file changes, so loading the same sequence again does not parse it
+         * again. They are shared with all other readers of the file and must not be modified.
+         * @return false with the error in @p errorText if the file cannot be read or is not valid XML
+         */
+        static bool parseFile(const QString &fileURL, QList<std::shared_ptr<XMLEle>> &roots, QString &errorText);
+
         void setOptions();
         void loadOptions();
 
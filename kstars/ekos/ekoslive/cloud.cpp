@@ -9,6 +9,7 @@
 #include "cloud.h"
 #include "commands.h"
 #include "fitsviewer/fitsdata.h"
+#include "auxiliary/processinglanes.h"
 
 #include "ekos_debug.h"
 #include "version.h"
@@ -16,7 +17,6 @@
 #include "Options.h"
 
 #include <QtConcurrent>
-#include <QFutureWatcher>
 #include <KFormat>
 
 namespace EkosLive
@@ -33,10 +33,24 @@ Cloud::Cloud(Ekos::Manager * manager, QVector<QSharedPointer<NodeManager>> &node
         connect(nodeManager->cloud(), &Node::connected, this, &Cloud::onConnected);
         connect(nodeManager->cloud(), &Node::disconnected, this, &Cloud::onDisconnected);
         connect(nodeManager->cloud(), &Node::onTextReceived, this, &Cloud::onTextReceived);
+        connect(nodeManager->cloud(), &Node::sendBacklogCleared, this, [this]()
+        {
+            const bool written = std::none_of(m_NodeManagers.begin(), m_NodeManagers.end(), [](auto & nodeManager)
+            {
+                return nodeManager->cloud() && nodeManager->cloud()->sendBacklog() > 0;
+            });
+            if (written)
+            {
+                m_InFlight.clear();
+                sendNextUpload();
+            }
+        });
     }
 
-    connect(&watcher, &QFutureWatcher<bool>::finished, this, &Cloud::sendImage, Qt::UniqueConnection);
-    connect(this, &Cloud::newImage, this, &Cloud::uploadImage);
+    // A single thread, so that uploads never take more than a core from the capture pipeline
+    m_UploadPool.setMaxThreadCount(1);
+    m_BandwidthTimer.setSingleShot(true);
+    connect(&m_BandwidthTimer, &QTimer::timeout, this, &Cloud::sendNextUpload);
     connect(Options::self(), &Options::EkosLiveCloudChanged, this, &Cloud::updateOptions);
 }
 
@@ -60,6 +74,9 @@ void Cloud::onConnected()
     qCInfo(KSTARS_EKOS) << "Connected to Cloud Websocket server at" << node->url().toDisplayString();
 
     emit connected();
+
+    // Resume the uploads that waited for the connection
+    sendNextUpload();
 }
 
 void Cloud::onDisconnected()
@@ -67,6 +84,13 @@ void Cloud::onDisconnected()
     qCInfo(KSTARS_EKOS) << "Disconnected from Cloud Websocket server.";
     m_sendBlobs = true;
 
+    // The server keeps no partial uploads, so an image cut short goes out again in full
+    if (!m_InFlight.isEmpty())
+    {
+        m_OutgoingUploads.prepend(m_InFlight);
+        m_InFlight.clear();
+    }
+
     for (auto &oneFile : temporaryFiles)
         QFile::remove(oneFile);
     temporaryFiles.clear();
@@ -91,6 +115,10 @@ void Cloud::onTextReceived(const QString &message)
         m_sendBlobs = msgObj["payload"].toBool();
     else if (command == commands[LOGOUT])
     {
+        m_PendingUploads.clear();
+        m_OutgoingUploads.clear();
+        m_InFlight.clear();
+
         for (auto &nodeManager : m_NodeManagers)
         {
             if (nodeManager->cloud() == nullptr)
@@ -106,9 +134,24 @@ void Cloud::upload(const QSharedPointer<FITSData> &data, const QString &uuid)
     if (Options::ekosLiveCloud() == false  || m_sendBlobs == false)
         return;
 
-    m_UUID = uuid;
-    m_ImageData = data;
-    sendImage();
+    Upload upload;
+    upload.uuid = uuid;
+    upload.filename = data->filename();
+
+    // Skip empty or useless metadata
+    for (const auto &oneRecord : data->getRecords())
+    {
+        if (oneRecord.key.isEmpty() || oneRecord.value.toString().isEmpty())
+            continue;
+        upload.metadata.insert(oneRecord.key.toLower(), QJsonValue::fromVariant(oneRecord.value));
+    }
+
+    // Images that were never saved as FITS are compressed from memory
+    const QString suffix = QFileInfo(upload.filename).suffix().toLower();
+    if (!QFileInfo::exists(upload.filename) || !(suffix.startsWith("fit") || suffix == "fts" || suffix == "fz"))
+        upload.data = data;
+
+    queueUpload(upload);
 }
 
 void Cloud::upload(const QString &filename, const QString &uuid)
@@ -116,39 +159,69 @@ void Cloud::upload(const QString &filename, const QString &uuid)
     if (Options::ekosLiveCloud() == false  || m_sendBlobs == false)
         return;
 
-    watcher.waitForFinished();
-    m_UUID = uuid;
-    m_ImageData.reset(new FITSData(), &QObject::deleteLater);
-    QFuture<bool> result = m_ImageData->loadFromFile(filename);
-    watcher.setFuture(result);
+    Upload upload;
+    upload.uuid = uuid;
+    upload.filename = filename;
+    queueUpload(upload);
 }
 
-void Cloud::sendImage()
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Cloud::queueUpload(const Upload &upload)
 {
-    QtConcurrent::run(this, &Cloud::asyncUpload);
+    if (m_PendingUploads.size() + m_OutgoingUploads.size() >= MAX_QUEUED_UPLOADS)
+    {
+        qCWarning(KSTARS_EKOS) << "Cloud uploads are falling behind, dropping the oldest image.";
+        if (!m_OutgoingUploads.isEmpty())
+            m_OutgoingUploads.dequeue();
+        else
+            m_PendingUploads.dequeue();
+    }
+
+    m_PendingUploads.enqueue(upload);
+    compressNextUpload();
 }
 
-void Cloud::asyncUpload()
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Cloud::compressNextUpload()
 {
-    // Send complete metadata
-    // Add file name and size
-    QJsonObject metadata;
-    // Skip empty or useless metadata
-    for (const auto &oneRecord : m_ImageData->getRecords())
+    if (m_Compressing || m_PendingUploads.isEmpty())
+        return;
+
+    m_Compressing = true;
+    const Upload upload = m_PendingUploads.dequeue();
+    QtConcurrent::run(&m_UploadPool, [this, upload]()
     {
-        if (oneRecord.key.isEmpty() || oneRecord.value.toString().isEmpty())
-            continue;
-        metadata.insert(oneRecord.key.toLower(), QJsonValue::fromVariant(oneRecord.value));
-    }
+        ProcessingLanes::prioritise(ProcessingLanes::DISPLAY);
+        const QByteArray image = compress(upload);
+        QMetaObject::invokeMethod(this, [this, image]()
+        {
+            m_Compressing = false;
+            if (!image.isEmpty())
+            {
+                m_OutgoingUploads.enqueue(image);
+                sendNextUpload();
+            }
+            compressNextUpload();
+        }, Qt::QueuedConnection);
+    });
+}
 
-    // Filename only without path
-    QString filepath = m_ImageData->filename();
-    QString filenameOnly = QFileInfo(filepath).fileName();
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+QByteArray Cloud::compress(const Upload &upload)
+{
+    QString filenameOnly = QFileInfo(upload.filename).fileName();
+    QJsonObject metadata = upload.metadata.isEmpty() ? readHeader(upload.filename) : upload.metadata;
 
     // Add filename and size as wells
-    metadata.insert("uuid", m_UUID);
+    metadata.insert("uuid", upload.uuid);
     metadata.insert("filename", filenameOnly);
-    metadata.insert("filesize", static_cast<int>(m_ImageData->size()));
+    metadata.insert("filesize", static_cast<int>(upload.data ? upload.data->size() : QFileInfo(upload.filename).size()));
     // Must set Content-Disposition so
     metadata.insert("Content-Disposition", QString("attachment;filename=%1.fz").arg(filenameOnly));
 
@@ -157,33 +230,115 @@ void Cloud::asyncUpload()
     meta = meta.leftJustified(METADATA_PACKET, 0);
     image += meta;
 
-    QString compressedFile = QDir::tempPath() + QString("/ekoslivecloud%1").arg(m_UUID);
-    m_ImageData->saveImage(compressedFile + QStringLiteral("[compress R]"));
+    QString compressedFile = QDir::tempPath() + QString("/ekoslivecloud%1").arg(upload.uuid);
+    if (upload.filename.endsWith(".fz", Qt::CaseInsensitive) && !upload.data)
+    {
+        // Already compressed
+        compressedFile = upload.filename;
+    }
+    else if (upload.data)
+        upload.data->saveImage(compressedFile + QStringLiteral("[compress R]"));
+    else
+    {
+        // Rice compress the saved file as fpack does, leaving the image in memory alone
+        fpstate fpvar;
+        fp_init(&fpvar);
+        int islossless = 0;
+        fp_pack(upload.filename.toLocal8Bit().data(), QString("!%1").arg(compressedFile).toLocal8Bit().data(), fpvar,
+                &islossless);
+    }
+
     // Upload the compressed image
     QFile compressedImage(compressedFile);
-    if (compressedImage.open(QIODevice::ReadOnly))
+    bool compressed = compressedImage.open(QIODevice::ReadOnly) && compressedImage.size() > 0;
+    if (compressed)
     {
         image += compressedImage.readAll();
-        emit newImage(image);
-        qCInfo(KSTARS_EKOS) << "Uploaded" << compressedFile << " to the cloud";
+        qCInfo(KSTARS_EKOS) << "Compressed" << upload.filename << "for the cloud";
     }
+    else
+        qCWarning(KSTARS_EKOS) << "Failed to compress" << upload.filename << "for the cloud";
+    compressedImage.close();
 
     // Remove from disk if temporary
-    if (compressedFile != filepath && compressedFile.startsWith(QDir::tempPath()))
+    if (compressedFile != upload.filename && compressedFile.startsWith(QDir::tempPath()))
         QFile::remove(compressedFile);
 
-    m_ImageData.reset();
+    return compressed ? image : QByteArray();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+QJsonObject Cloud::readHeader(const QString &filename)
+{
+    QJsonObject metadata;
+    fitsfile *fptr = nullptr;
+    int status = 0, keys = 0;
+
+    if (fits_open_diskfile(&fptr, filename.toLocal8Bit(), READONLY, &status) ||
+            fits_get_hdrspace(fptr, &keys, nullptr, &status))
+    {
+        qCWarning(KSTARS_EKOS) << "Failed to read the header of" << filename;
+        if (fptr)
+            fits_close_file(fptr, &status);
+        return metadata;
+    }
+
+    char key[FLEN_KEYWORD], value[FLEN_VALUE], comment[FLEN_COMMENT];
+    for (int i = 1; i <= keys; i++)
+    {
+        if (fits_read_keyn(fptr, i, key, value, comment, &status))
+            break;
+
+        QString text = QString(value).trimmed();
+        // Skip empty or useless metadata
+        if (key[0] == 0 || text.isEmpty())
+            continue;
+
+        bool isNumber = false;
+        const double number = text.toDouble(&isNumber);
+        if (text.startsWith('\''))
+            metadata.insert(QString(key).toLower(), text.mid(1, text.length() - 2).trimmed());
+        else if (isNumber)
+            metadata.insert(QString(key).toLower(), number);
+        else
+            metadata.insert(QString(key).toLower(), text);
+    }
+
+    status = 0;
+    fits_close_file(fptr, &status);
+    return metadata;
 }
 
-void Cloud::uploadImage(const QByteArray &image)
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Cloud::sendNextUpload()
 {
+    if (m_OutgoingUploads.isEmpty() || m_BandwidthTimer.isActive() || isConnected() == false)
+        return;
+
+    // Wait until the previous image is on the network
+    for (auto &nodeManager : m_NodeManagers)
+    {
+        if (nodeManager->cloud() && nodeManager->cloud()->sendBacklog() > 0)
+            return;
+    }
+
+    m_InFlight = m_OutgoingUploads.dequeue();
     for (auto &nodeManager : m_NodeManagers)
     {
         if (nodeManager->cloud() == nullptr)
             continue;
 
-        nodeManager->cloud()->sendBinaryMessage(image);
+        nodeManager->cloud()->sendBinaryMessage(m_InFlight);
     }
+    qCInfo(KSTARS_EKOS) << "Uploaded" << m_InFlight.size() << "bytes to the cloud";
+
+    // Hold the next image back long enough to stay within the cap on average
+    if (Options::ekosLiveCloudBandwidth() > 0)
+        m_BandwidthTimer.start(int(m_InFlight.size() / (Options::ekosLiveCloudBandwidth() * 1.024)));
 }
 
 void Cloud::updateOptions()
@@ -9,6 +9,9 @@
 #pragma once
 
 #include <QtWebSockets/QWebSocket>
+#include <QQueue>
+#include <QThreadPool>
+#include <QTimer>
 #include <memory>
 
 #include "ekos/manager.h"
@@ -36,7 +39,6 @@ class Cloud : public QObject
     signals:
         void connected();
         void disconnected();
-        void newImage(const QByteArray &image);
 
     public slots:
         void updateOptions();
@@ -49,20 +51,42 @@ class Cloud : public QObject
         // Communication
         void onTextReceived(const QString &message);
 
-        // Send image
-        void sendImage();
-
-        void uploadImage(const QByteArray &image);
+        // Send the next compressed image once the connections caught up
+        void sendNextUpload();
 
     private:
-        void asyncUpload();
+        typedef struct
+        {
+            QString uuid;
+            QString filename;
+            // Only set when the image is not on disk as a FITS file
+            QSharedPointer<FITSData> data;
+            // Header records, read from the file when empty
+            QJsonObject metadata;
+        } Upload;
+
+        void queueUpload(const Upload &upload);
+        void compressNextUpload();
+
+        /**
+         * @brief compress Build the message of an upload: its metadata followed by the Rice
+         * compressed image. Runs on the upload thread.
+         */
+        static QByteArray compress(const Upload &upload);
+        static QJsonObject readHeader(const QString &filename);
 
         Ekos::Manager * m_Manager { nullptr };
         QVector<QSharedPointer<NodeManager>> m_NodeManagers;
-        QString m_UUID;
 
-        QSharedPointer<FITSData> m_ImageData;
-        QFutureWatcher<bool> watcher;
+        // Images are compressed one at a time on their own thread
+        QThreadPool m_UploadPool;
+        QQueue<Upload> m_PendingUploads;
+        bool m_Compressing { false };
+        // Compressed images waiting for the connections and the bandwidth cap
+        QQueue<QByteArray> m_OutgoingUploads;
+        // The image the connections are still writing, sent again if they drop
+        QByteArray m_InFlight;
+        QTimer m_BandwidthTimer;
 
         QString extension;
         QStringList temporaryFiles;
@@ -83,5 +107,7 @@ class Cloud : public QObject
         static const uint16_t RECONNECT_INTERVAL = 5000;
         // Retry for 1 hour before giving up
         static const uint16_t RECONNECT_MAX_TRIES = 720;
+        // Oldest images are dropped beyond this many waiting uploads
+        static const uint16_t MAX_QUEUED_UPLOADS = 16;
 };
 }
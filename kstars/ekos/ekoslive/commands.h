@@ -184,6 +184,10 @@ enum COMMANDS
 
     // Storage Options
     SET_BLOBS,
+    SET_TILE_UPDATES,
+    SET_STATE_BATCHING,
+    NEW_STATE_BATCH,
+    SET_ENCODING,
 
     // DSLRs
     DSLR_GET_INFO,
@@ -401,6 +405,10 @@ static QMap<COMMANDS, QString> const commands =
     {OPTION_GET, "option_get"},
 
     {SET_BLOBS, "set_blobs"},
+    {SET_TILE_UPDATES, "set_tile_updates"},
+    {SET_STATE_BATCHING, "set_state_batching"},
+    {NEW_STATE_BATCH, "new_state_batch"},
+    {SET_ENCODING, "set_encoding"},
 
     {DSLR_GET_INFO, "dslr_get_info"},
     {DSLR_SET_INFO, "dslr_set_info"},
@@ -18,6 +18,7 @@
 #include "ekos/guide/guide.h"
 #include "ekos/align/align.h"
 #include "kspaths.h"
+#include "auxiliary/processinglanes.h"
 #include "Options.h"
 
 #include "ekos_debug.h"
@@ -30,6 +31,14 @@
 namespace EkosLive
 {
 
+// Scale of the images and JPEG quality of each stream level, from the best to the most economical
+static const struct
+{
+    double scale;
+    int quality;
+} g_streamLevels[] = {{1.0, 90}, {0.75, 80}, {0.5, 70}, {0.35, 55}};
+static const int g_streamLevelCount = sizeof(g_streamLevels) / sizeof(g_streamLevels[0]);
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -42,8 +51,12 @@ Media::Media(Ekos::Manager * manager, QVector<QSharedPointer<NodeManager>> &node
         connect(nodeManager->media(), &Node::disconnected, this, &Media::onDisconnected);
         connect(nodeManager->media(), &Node::onTextReceived, this, &Media::onTextReceived);
         connect(nodeManager->media(), &Node::onBinaryReceived, this, &Media::onBinaryReceived);
+        connect(nodeManager->media(), &Node::sendBacklogCleared, this, &Media::resumeFrames);
     }
 
+    // Leave the other cores to guiding and capture
+    m_EncodingPool.setMaxThreadCount(2);
+
     connect(this, &Media::newMetadata, this, &Media::uploadMetadata);
     connect(this, &Media::newImage, this, [this](const QByteArray & image)
     {
@@ -74,6 +87,9 @@ void Media::onConnected()
 
     qCInfo(KSTARS_EKOS) << "Connected to Media Websocket server at" << node->url().toDisplayString();
 
+    // The new client needs full frames to composite tiles onto
+    m_LastImages.clear();
+
     emit connected();
 }
 
@@ -88,9 +104,14 @@ void Media::onDisconnected()
 
     qCInfo(KSTARS_EKOS) << "Disconnected from Message Websocket server at" << node->url().toDisplayString();
 
+    // Frames held back for this connection may go to the others
+    resumeFrames();
+
     if (isConnected() == false)
     {
         m_sendBlobs = true;
+        m_TileUpdates = false;
+        m_LastImages.clear();
 
         for (const QString &oneFile : temporaryFiles)
             QFile::remove(oneFile);
@@ -122,6 +143,12 @@ void Media::onTextReceived(const QString &message)
         extension = payload["ext"].toString();
     else if (command == commands[SET_BLOBS])
         m_sendBlobs = msgObj["payload"].toBool();
+    else if (command == commands[SET_TILE_UPDATES])
+    {
+        // Start over with full frames
+        m_TileUpdates = msgObj["payload"].toBool();
+        m_LastImages.clear();
+    }
     // Get a list of object based on criteria
     else if (command == commands[ASTRO_GET_OBJECTS_IMAGE])
     {
@@ -288,7 +315,7 @@ void Media::sendData(const QSharedPointer<FITSData> &data, const QString &uuid)
 
     m_TemporaryView.reset(new FITSView());
     m_TemporaryView->loadData(data);
-    QtConcurrent::run(this, &Media::upload, m_TemporaryView);
+    upload(m_TemporaryView);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -304,7 +331,7 @@ void Media::sendFile(const QString &filename, const QString &uuid)
     QSharedPointer<FITSView> previewImage(new FITSView());
     connect(previewImage.get(), &FITSView::loaded, this, [this, previewImage]()
     {
-        QtConcurrent::run(this, &Media::upload, previewImage);
+        upload(previewImage);
     });
     previewImage->loadFile(filename);
 }
@@ -328,9 +355,6 @@ void Media::sendView(const QSharedPointer<FITSView> &view, const QString &uuid)
 void Media::upload(const QSharedPointer<FITSView> &view)
 {
     const QString ext = "jpg";
-    QByteArray jpegData;
-    QBuffer buffer(&jpegData);
-    buffer.open(QIODevice::WriteOnly);
 
     const QSharedPointer<FITSData> imageData = view->imageData();
     QString resolution = QString("%1x%2").arg(imageData->width()).arg(imageData->height());
@@ -380,32 +404,214 @@ void Media::upload(const QSharedPointer<FITSView> &view)
     // the rest to the image data.
     QByteArray meta = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
     meta = meta.leftJustified(METADATA_PACKET, 0);
-    buffer.write(meta);
 
     auto fastImage = (!Options::ekosLiveHighBandwidth() || m_UUID[0] == "+");
     auto scaleWidth = fastImage ? HB_IMAGE_WIDTH / 2 : HB_IMAGE_WIDTH;
 
     // For low bandwidth images
     // Except for dark frames +D
-    QPixmap scaledImage = view->getDisplayPixmap().width() > scaleWidth ?
-                          view->getDisplayPixmap().scaledToWidth(scaleWidth, fastImage ? Qt::FastTransformation : Qt::SmoothTransformation) :
-                          view->getDisplayPixmap();
-    scaledImage.save(&buffer, ext.toLatin1().constData(), HB_IMAGE_QUALITY);
+    const QImage image = view->getDisplayPixmap().toImage();
+    queueFrame(m_UUID, meta, [image, scaleWidth, fastImage]()
+    {
+        return image.width() > scaleWidth ?
+               image.scaledToWidth(scaleWidth, fastImage ? Qt::FastTransformation : Qt::SmoothTransformation) :
+               image;
+    });
+}
 
-    buffer.close();
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Media::queueFrame(const QString &stream, const QByteArray &metadata, const std::function<QImage()> &render)
+{
+    // Replaces any frame of the stream that is still waiting
+    m_PendingFrames.insert(stream, {metadata, render});
 
-    emit newImage(jpegData);
+    if (!m_EncodingStreams.contains(stream))
+        encodeNextFrame(stream);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////
-void Media::sendUpdatedFrame(const QSharedPointer<FITSView> &view)
+void Media::encodeNextFrame(const QString &stream)
+{
+    // The frame waits, and may be superseded, until the connections catch up
+    if (isCongested())
+        return;
+
+    const Frame frame = m_PendingFrames.take(stream);
+    m_EncodingStreams.insert(stream);
+
+    updateStreamLevel();
+    const double scale = g_streamLevels[m_StreamLevel].scale;
+    const int quality = std::min<int>(HB_IMAGE_QUALITY, g_streamLevels[m_StreamLevel].quality);
+
+    // Live streams of clients that composite tiles only get the tiles that changed
+    const bool tiled = m_TileUpdates && stream.startsWith('+');
+    const QImage previous = tiled ? m_LastImages.value(stream) : QImage();
+
+    QtConcurrent::run(&m_EncodingPool, [this, stream, frame, scale, quality, tiled, previous]()
+    {
+        ProcessingLanes::prioritise(ProcessingLanes::DISPLAY);
+        QImage image = frame.render();
+        if (scale < 1 && !image.isNull())
+            image = image.scaledToWidth(std::max(1, int(image.width() * scale)), Qt::FastTransformation);
+
+        const QList<QByteArray> messages = tiled ? encodeTiles(stream, frame.metadata, image, previous, quality) :
+                                           QList<QByteArray>({encodeImage(frame.metadata, image, quality)});
+
+        QMetaObject::invokeMethod(this, [this, stream, tiled, image, messages]()
+        {
+            m_EncodingStreams.remove(stream);
+            if (tiled && m_TileUpdates)
+                m_LastImages.insert(stream, image);
+            for (const auto &message : messages)
+                emit newImage(message);
+
+            if (m_PendingFrames.contains(stream))
+                encodeNextFrame(stream);
+        }, Qt::QueuedConnection);
+    });
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+QByteArray Media::encodeImage(const QByteArray &metadata, const QImage &image, int quality)
 {
-    QString ext = "jpg";
     QByteArray jpegData;
     QBuffer buffer(&jpegData);
     buffer.open(QIODevice::WriteOnly);
+    buffer.write(metadata);
+
+    QImageWriter writer(&buffer, "jpg");
+    writer.setQuality(quality);
+    writer.write(image);
+    buffer.close();
+
+    return jpegData;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+QList<QByteArray> Media::encodeTiles(const QString &stream, const QByteArray &metadata, const QImage &image,
+                                     const QImage &previous, int quality)
+{
+    // Without a comparable previous frame the client needs the full one
+    if (previous.isNull() || previous.size() != image.size() || previous.format() != image.format() || image.depth() < 8)
+        return {encodeImage(metadata, image, quality)};
+
+    const int bytesPerPixel = image.depth() / 8;
+    QList<QRect> dirtyTiles;
+    for (int y = 0; y < image.height(); y += UPDATE_TILE_SIZE)
+    {
+        for (int x = 0; x < image.width(); x += UPDATE_TILE_SIZE)
+        {
+            const QRect tile = QRect(x, y, UPDATE_TILE_SIZE, UPDATE_TILE_SIZE).intersected(image.rect());
+            for (int row = tile.top(); row <= tile.bottom(); row++)
+            {
+                if (memcmp(image.constScanLine(row) + tile.left() * bytesPerPixel,
+                           previous.constScanLine(row) + tile.left() * bytesPerPixel, tile.width() * bytesPerPixel))
+                {
+                    dirtyTiles.append(tile);
+                    break;
+                }
+            }
+        }
+    }
+
+    const int columns = (image.width() + UPDATE_TILE_SIZE - 1) / UPDATE_TILE_SIZE;
+    const int rows = (image.height() + UPDATE_TILE_SIZE - 1) / UPDATE_TILE_SIZE;
+    // A full frame compresses better than many tiles
+    if (dirtyTiles.size() > columns * rows / 2)
+        return {encodeImage(metadata, image, quality)};
+
+    QList<QByteArray> messages;
+    for (const auto &tile : dirtyTiles)
+    {
+        QJsonObject tileMetadata =
+        {
+            {"uuid", stream},
+            {"ext", "jpg"},
+            {"tile", QJsonObject({{"x", tile.x()}, {"y", tile.y()}, {"width", tile.width()}, {"height", tile.height()}})},
+            {"frame", QJsonObject({{"width", image.width()}, {"height", image.height()}})}
+        };
+        QByteArray meta = QJsonDocument(tileMetadata).toJson(QJsonDocument::Compact);
+        meta = meta.leftJustified(METADATA_PACKET, 0);
+        messages.append(encodeImage(meta, image.copy(tile), quality));
+    }
+    return messages;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Media::resumeFrames()
+{
+    for (const auto &stream : m_PendingFrames.keys())
+    {
+        if (!m_EncodingStreams.contains(stream))
+            encodeNextFrame(stream);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+bool Media::isCongested() const
+{
+    return std::any_of(m_NodeManagers.begin(), m_NodeManagers.end(), [](auto & nodeManager)
+    {
+        return nodeManager->media()->isConnected() && nodeManager->media()->sendBacklog() > MAX_SEND_BACKLOG;
+    });
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Media::updateStreamLevel()
+{
+    qint64 backlog = 0;
+    quint64 roundTrip = 0;
+    for (auto &nodeManager : m_NodeManagers)
+    {
+        if (nodeManager->media()->isConnected() == false)
+            continue;
+        backlog = std::max(backlog, nodeManager->media()->sendBacklog());
+        roundTrip = std::max(roundTrip, nodeManager->media()->roundTripTime());
+    }
+
+    if (backlog > DEGRADE_SEND_BACKLOG || roundTrip > DEGRADE_ROUND_TRIP)
+    {
+        m_GoodFrames = 0;
+        if (m_StreamLevel < g_streamLevelCount - 1)
+        {
+            m_StreamLevel++;
+            qCDebug(KSTARS_EKOS) << "EkosLive media stream level lowered to" << m_StreamLevel << "backlog" << backlog
+                                 << "round trip" << roundTrip;
+        }
+    }
+    else if (backlog == 0 && roundTrip < RECOVER_ROUND_TRIP)
+    {
+        if (m_StreamLevel > 0 && ++m_GoodFrames >= RECOVER_FRAMES)
+        {
+            m_GoodFrames = 0;
+            m_StreamLevel--;
+            qCDebug(KSTARS_EKOS) << "EkosLive media stream level raised to" << m_StreamLevel;
+        }
+    }
+    else
+        m_GoodFrames = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Media::sendUpdatedFrame(const QSharedPointer<FITSView> &view)
+{
+    QString ext = "jpg";
 
     const QSharedPointer<FITSData> imageData = view->imageData();
 
@@ -452,62 +658,67 @@ void Media::sendUpdatedFrame(const QSharedPointer<FITSView> &view)
     // the rest to the image data.
     QByteArray meta = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
     meta = meta.leftJustified(METADATA_PACKET, 0);
-    buffer.write(meta);
 
     // For low bandwidth images
-    QPixmap scaledImage;
+    const QImage image = view->getDisplayPixmap().toImage();
     // Align images
     if (correctionVector.isNull() == false)
     {
-        scaledImage = view->getDisplayPixmap();
         const double currentZoom = view->getCurrentZoom();
-        const double normalizedZoom = currentZoom / 100;
-        // If zoom level is not 100%, then scale.
-        if (fabs(normalizedZoom - 1) > 0.001)
-            scaledImage = view->getDisplayPixmap().scaledToWidth(view->zoomedWidth());
-        else
-            scaledImage = view->getDisplayPixmap();
-        // as we factor in the zoom level, we adjust center and length accordingly
-        QPointF center = 0.5 * correctionVector.p1() * normalizedZoom + 0.5 * correctionVector.p2() * normalizedZoom;
-        uint32_t length = qMax(correctionVector.length() / normalizedZoom, 100 / normalizedZoom);
-
-        QRect boundingRectable;
-        boundingRectable.setSize(QSize(length * 2, length * 2));
-        QPoint topLeft = (center - QPointF(length, length)).toPoint();
-        boundingRectable.moveTo(topLeft);
-        boundingRectable = boundingRectable.intersected(scaledImage.rect());
-
-        emit newBoundingRect(boundingRectable, scaledImage.size(), currentZoom);
-
-        scaledImage = scaledImage.copy(boundingRectable);
+        const int zoomedWidth = view->zoomedWidth();
+        const QLineF vector = correctionVector;
+        queueFrame("+A", meta, [this, image, currentZoom, zoomedWidth, vector]()
+        {
+            const double normalizedZoom = currentZoom / 100;
+            // If zoom level is not 100%, then scale.
+            QImage scaledImage = (fabs(normalizedZoom - 1) > 0.001) ? image.scaledToWidth(zoomedWidth) : image;
+            // as we factor in the zoom level, we adjust center and length accordingly
+            QPointF center = 0.5 * vector.p1() * normalizedZoom + 0.5 * vector.p2() * normalizedZoom;
+            uint32_t length = qMax(vector.length() / normalizedZoom, 100 / normalizedZoom);
+
+            QRect boundingRectable;
+            boundingRectable.setSize(QSize(length * 2, length * 2));
+            QPoint topLeft = (center - QPointF(length, length)).toPoint();
+            boundingRectable.moveTo(topLeft);
+            boundingRectable = boundingRectable.intersected(scaledImage.rect());
+
+            emit newBoundingRect(boundingRectable, scaledImage.size(), currentZoom);
+
+            return scaledImage.copy(boundingRectable);
+        });
     }
     else
     {
-        scaledImage = view->getDisplayPixmap().width() > HB_IMAGE_WIDTH / 2 ?
-                      view->getDisplayPixmap().scaledToWidth(HB_IMAGE_WIDTH / 2, Qt::FastTransformation) :
-                      view->getDisplayPixmap();
         emit newBoundingRect(QRect(), QSize(), 100);
+        queueFrame("+A", meta, [image]()
+        {
+            return image.width() > HB_IMAGE_WIDTH / 2 ? image.scaledToWidth(HB_IMAGE_WIDTH / 2, Qt::FastTransformation) : image;
+        });
     }
-
-    scaledImage.save(&buffer, ext.toLatin1().constData(), HB_IMAGE_QUALITY);
-    buffer.close();
-    emit newImage(jpegData);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////
-void Media::sendVideoFrame(const QSharedPointer<QImage> &frame)
+void Media::sendVideoFrame(const QSharedPointer<QImage> &frame, const QByteArray &jpeg)
 {
     if (Options::ekosLiveImageTransfer() == false || m_sendBlobs == false || !frame)
         return;
 
+    // Video frames come often enough to simply drop those the link has no room for
+    if (isCongested())
+        return;
+
+    updateStreamLevel();
     int32_t width = Options::ekosLiveHighBandwidth() ? HB_VIDEO_WIDTH : HB_VIDEO_WIDTH / 2;
+    width *= g_streamLevels[m_StreamLevel].scale;
     QByteArray image;
     QBuffer buffer(&image);
     buffer.open(QIODevice::WriteOnly);
 
-    QImage videoImage = (frame->width() > width) ? frame->scaledToWidth(width) : *frame;
+    // JPEG frames that need no scaling go out as the driver sent them
+    const bool passThrough = !jpeg.isEmpty() && frame->width() <= width;
+    const QImage videoImage = (frame->width() > width) ? frame->scaledToWidth(width) : *frame;
 
     QString resolution = QString("%1x%2").arg(videoImage.width()).arg(videoImage.height());
 
@@ -523,11 +734,16 @@ void Media::sendVideoFrame(const QSharedPointer<QImage> &frame)
     meta = meta.leftJustified(METADATA_PACKET, 0);
     buffer.write(meta);
 
-    QImageWriter writer;
-    writer.setDevice(&buffer);
-    writer.setFormat("JPG");
-    writer.setCompression(6);
-    writer.write(videoImage);
+    if (passThrough)
+        buffer.write(jpeg);
+    else
+    {
+        QImageWriter writer;
+        writer.setDevice(&buffer);
+        writer.setFormat("JPG");
+        writer.setCompression(6);
+        writer.write(videoImage);
+    }
     buffer.close();
 
     for (auto &nodeManager : m_NodeManagers)
@@ -9,6 +9,8 @@
 #pragma once
 
 #include <QtWebSockets/QWebSocket>
+#include <QThreadPool>
+#include <functional>
 #include <memory>
 
 #include "ekos/manager.h"
@@ -52,7 +54,7 @@ class Media : public QObject
 
     public slots:
         // Capture
-        void sendVideoFrame(const QSharedPointer<QImage> &frame);
+        void sendVideoFrame(const QSharedPointer<QImage> &frame, const QByteArray &jpeg);
 
         // Correction Vector
         void setCorrectionVector(QLineF correctionVector)
@@ -81,6 +83,46 @@ class Media : public QObject
     private:
         void upload(const QSharedPointer<FITSView> &view);
 
+        /**
+         * @brief queueFrame Encode a frame for the clients on the encoding pool.
+         * Frames of the same stream are encoded one at a time. A frame still waiting when a newer one
+         * of its stream comes in is dropped, so that only the newest frame of each stream is encoded.
+         * @param stream the stream of the frame, e.g. the UUID of a module frame
+         * @param metadata the metadata packet that comes before the image
+         * @param render called on the pool to produce the scaled image to encode
+         */
+        void queueFrame(const QString &stream, const QByteArray &metadata, const std::function<QImage()> &render);
+        void encodeNextFrame(const QString &stream);
+
+        /**
+         * @brief encodeTiles Encode the tiles of @p image that differ from @p previous, each as its own message.
+         * Only done for clients that asked for tile updates, which composite the tiles onto the last full frame.
+         * @return the messages, none if nothing changed, or a single full frame if too much did
+         */
+        static QList<QByteArray> encodeTiles(const QString &stream, const QByteArray &metadata, const QImage &image,
+                                             const QImage &previous, int quality);
+        static QByteArray encodeImage(const QByteArray &metadata, const QImage &image, int quality);
+        void resumeFrames();
+
+        /**
+         * @brief isCongested Check if the backlog of any connection is too large to send more frames.
+         * Frames are then held back, so that only the newest frame of each stream goes out once the link has caught up.
+         */
+        bool isCongested() const;
+
+        /**
+         * @brief updateStreamLevel Pick the image size and quality for the next frame from the backlog
+         * and round trip time of the slowest connection. Levels drop at once, and recover one at a time
+         * after several frames without backlog.
+         */
+        void updateStreamLevel();
+
+        struct Frame
+        {
+            QByteArray metadata;
+            std::function<QImage()> render;
+        };
+
         Ekos::Manager * m_Manager { nullptr };
         QVector<QSharedPointer<NodeManager>> m_NodeManagers;
         QString m_UUID;
@@ -90,6 +132,19 @@ class Media : public QObject
         QSharedPointer<FITSView> m_TemporaryView;
 
         bool m_sendBlobs { true};
+        // Send the changed tiles of live frames, see encodeTiles()
+        bool m_TileUpdates { false };
+        // Last image sent on each live stream, to find the changed tiles
+        QHash<QString, QImage> m_LastImages;
+
+        // Frames waiting for encoding, and the streams with a frame being encoded
+        QHash<QString, Frame> m_PendingFrames;
+        QSet<QString> m_EncodingStreams;
+        QThreadPool m_EncodingPool;
+
+        // Index in the stream levels, 0 being full size and quality
+        int m_StreamLevel { 0 };
+        int m_GoodFrames { 0 };
 
         // Image width for high-bandwidth setting
         static const uint16_t HB_IMAGE_WIDTH = 1920;
@@ -112,6 +167,20 @@ class Media : public QObject
         // Binary Metadata Size
         static const uint16_t METADATA_PACKET = 512;
 
+        // Width and height of the tiles of tile updates
+        static const uint16_t UPDATE_TILE_SIZE = 128;
+
+        // Hold frames back while this many bytes wait on a connection
+        static const uint32_t MAX_SEND_BACKLOG = 1024 * 1024;
+        // Lower the stream level when this many bytes wait on a connection
+        static const uint32_t DEGRADE_SEND_BACKLOG = 256 * 1024;
+        // Lower the stream level above this round trip time (ms)
+        static const uint16_t DEGRADE_ROUND_TRIP = 1000;
+        // Raise the stream level again below this round trip time (ms)
+        static const uint16_t RECOVER_ROUND_TRIP = 300;
+        // Frames without backlog before the stream level is raised again
+        static const uint8_t RECOVER_FRAMES = 5;
+
         // HIPS Tile Width and Height
         static const uint16_t HIPS_TILE_WIDTH = 512;
         static const uint16_t HIPS_TILE_HEIGHT = 512;
@@ -50,7 +50,8 @@ Message::Message(Ekos::Manager *manager, QVector<QSharedPointer<NodeManager>> &n
 
     connect(manager, &Ekos::Manager::newModule, this, &Message::sendModuleState);
 
-    m_ThrottleTS = QDateTime::currentDateTime();
+    m_StateTimer.setSingleShot(true);
+    connect(&m_StateTimer, &QTimer::timeout, this, &Message::publishPendingStates);
 
     m_PendingPropertiesTimer.setInterval(500);
     connect(&m_PendingPropertiesTimer, &QTimer::timeout, this, &Message::sendPendingProperties);
@@ -90,6 +91,9 @@ void Message::onDisconnected()
     if (isConnected() == false)
     {
         m_PendingPropertiesTimer.stop();
+        m_StateTimer.stop();
+        m_PendingStates.clear();
+        m_StateBatching = false;
         emit disconnected();
     }
 }
@@ -125,6 +129,14 @@ void Message::onTextReceived(const QString &message)
         emit expired(node->url());
         return;
     }
+    else if (command == commands[SET_ENCODING])
+    {
+        node->setCborEncoding(msgObj["payload"].toString() == "cbor");
+    }
+    else if (command == commands[SET_STATE_BATCHING])
+    {
+        m_StateBatching = msgObj["payload"].toBool();
+    }
     else if (command == commands[SET_CLIENT_STATE])
     {
         // If client is connected, make sure clock is ticking
@@ -2166,6 +2178,53 @@ void Message::sendDialog(const QJsonObject &message)
     sendResponse(commands[DIALOG_GET_INFO], message);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Message::publishState(const QString &command, const QJsonObject &status, bool immediate)
+{
+    if (isConnected() == false)
+        return;
+
+    QJsonObject &pending = m_PendingStates[command];
+    for (auto it = status.constBegin(); it != status.constEnd(); ++it)
+        pending.insert(it.key(), it.value());
+
+    if (immediate)
+    {
+        sendResponse(command, m_PendingStates.take(command));
+        if (m_PendingStates.isEmpty())
+            m_StateTimer.stop();
+    }
+    else if (m_StateTimer.isActive() == false)
+        m_StateTimer.start(Options::ekosLiveStateInterval());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Message::publishPendingStates()
+{
+    if (m_PendingStates.isEmpty())
+        return;
+
+    // Clients that asked for it get all modules in one message
+    if (m_StateBatching && m_PendingStates.size() > 1)
+    {
+        QJsonArray batch;
+        for (auto it = m_PendingStates.constBegin(); it != m_PendingStates.constEnd(); ++it)
+            batch.append(QJsonObject({{"type", it.key()}, {"payload", it.value()}}));
+        sendResponse(commands[NEW_STATE_BATCH], batch);
+    }
+    else
+    {
+        for (auto it = m_PendingStates.constBegin(); it != m_PendingStates.constEnd(); ++it)
+            sendResponse(it.key(), it.value());
+    }
+
+    m_PendingStates.clear();
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2227,17 +2286,7 @@ void Message::autofocusAborted()
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateMountStatus(const QJsonObject &status, bool throttle)
 {
-    if (throttle)
-    {
-        QDateTime now = QDateTime::currentDateTime();
-        if (m_ThrottleTS.msecsTo(now) >= THROTTLE_INTERVAL)
-        {
-            m_ThrottleTS = now;
-            sendResponse(commands[NEW_MOUNT_STATE], status);
-        }
-    }
-    else
-        sendResponse(commands[NEW_MOUNT_STATE], status);
+    publishState(commands[NEW_MOUNT_STATE], status, !throttle);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2245,7 +2294,7 @@ void Message::updateMountStatus(const QJsonObject &status, bool throttle)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateCaptureStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_CAPTURE_STATE], status);
+    publishState(commands[NEW_CAPTURE_STATE], status, status.contains("status"));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2253,7 +2302,7 @@ void Message::updateCaptureStatus(const QJsonObject &status)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateFocusStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_FOCUS_STATE], status);
+    publishState(commands[NEW_FOCUS_STATE], status, status.contains("status"));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2261,7 +2310,7 @@ void Message::updateFocusStatus(const QJsonObject &status)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateGuideStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_GUIDE_STATE], status);
+    publishState(commands[NEW_GUIDE_STATE], status, status.contains("status"));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2269,7 +2318,7 @@ void Message::updateGuideStatus(const QJsonObject &status)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateDomeStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_DOME_STATE], status);
+    publishState(commands[NEW_DOME_STATE], status, status.contains("status"));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2277,7 +2326,7 @@ void Message::updateDomeStatus(const QJsonObject &status)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateCapStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_CAP_STATE], status);
+    publishState(commands[NEW_CAP_STATE], status, status.contains("status"));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -200,6 +200,18 @@ class Message : public QObject
 
         void dispatchDebounceQueue();
 
+        /**
+         * @brief publishState Merge a partial state update of a module into the state pending for it.
+         * Pending states are published together every EkosLiveStateInterval milliseconds, keeping
+         * only the latest value of each key, so frequent updates cost one message per interval.
+         * @param command State command, e.g. new_guide_state
+         * @param status Keys that changed
+         * @param immediate Publish the pending state now, for changes that clients must not miss
+         * like a module going from one status to another.
+         */
+        void publishState(const QString &command, const QJsonObject &status, bool immediate = false);
+        void publishPendingStates();
+
         KStarsDateTime getNextDawn();
 
         void sendResponse(const QString &command, const QJsonObject &payload);
@@ -239,7 +251,9 @@ class Message : public QObject
         QTimer m_DebouncedSend;
         QMap<QString, QVariantMap> m_DebouncedMap;
 
-        QDateTime m_ThrottleTS;
+        QTimer m_StateTimer;
+        QMap<QString, QJsonObject> m_PendingStates;
+        bool m_StateBatching { false };
         CatalogsDB::DBManager m_DSOManager;        
 
         typedef enum
@@ -250,8 +264,5 @@ class Message : public QObject
             West,
             All
         } Direction;
-
-        // Throttle interval
-        static const uint16_t THROTTLE_INTERVAL = 1000;
 };
 }
@@ -16,11 +16,17 @@
 #include <QUrlQuery>
 #include <QTimer>
 #include <QJsonDocument>
+#include <QJsonArray>
+#include <QCborArray>
+#include <QCborMap>
+#include <QtEndian>
 
 #include <KActionCollection>
 #include <basedevice.h>
 #include <QUuid>
 
+#include <algorithm>
+
 namespace EkosLive
 {
 Node::Node(const QString &name) : m_Name(name)
@@ -29,6 +35,14 @@ Node::Node(const QString &name) : m_Name(name)
     connect(&m_WebSocket, &QWebSocket::disconnected, this, &Node::onDisconnected);
     connect(&m_WebSocket, static_cast<void(QWebSocket::*)(QAbstractSocket::SocketError)>(&QWebSocket::error), this,
             &Node::onError);
+    connect(&m_WebSocket, &QWebSocket::bytesWritten, this, &Node::onBytesWritten);
+    connect(&m_WebSocket, &QWebSocket::pong, this, &Node::onPong);
+
+    m_PingTimer.setInterval(PING_INTERVAL);
+    connect(&m_PingTimer, &QTimer::timeout, this, [this]()
+    {
+        m_WebSocket.ping();
+    });
 
     m_Path = "/" + m_Name + "/ekos";
 }
@@ -69,6 +83,11 @@ void Node::onConnected()
 
     m_isConnected = true;
     m_ReconnectTries = 0;
+    m_SendBacklog = 0;
+    m_RoundTripTime = 0;
+    m_CborEncoding = false;
+    m_PingTimer.start();
+    m_WebSocket.ping();
 
     connect(&m_WebSocket, &QWebSocket::textMessageReceived,  this, &Node::onTextReceived, Qt::UniqueConnection);
     connect(&m_WebSocket, &QWebSocket::binaryMessageReceived,  this, &Node::onBinaryReceived, Qt::UniqueConnection);
@@ -80,6 +99,7 @@ void Node::onDisconnected()
 {
     qCInfo(KSTARS_EKOS) << "Disconnected from" << m_Name << "Websocket server at" << m_URL.toDisplayString();
     m_isConnected = false;
+    m_PingTimer.stop();
 
     disconnect(&m_WebSocket, &QWebSocket::textMessageReceived,  this, &Node::onTextReceived);
     disconnect(&m_WebSocket, &QWebSocket::binaryMessageReceived,  this, &Node::onBinaryReceived);
@@ -99,16 +119,28 @@ void Node::onError(QAbstractSocket::SocketError error)
     }
 }
 
+void Node::onBytesWritten(qint64 bytes)
+{
+    if (m_SendBacklog == 0)
+        return;
+
+    // Frame headers are written too, so the backlog is an estimate
+    m_SendBacklog = std::max<qint64>(0, m_SendBacklog - bytes);
+    if (m_SendBacklog == 0)
+        emit sendBacklogCleared();
+}
+
+void Node::onPong(quint64 elapsedTime)
+{
+    m_RoundTripTime = (m_RoundTripTime == 0) ? elapsedTime : (3 * m_RoundTripTime + elapsedTime) / 4;
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Node::sendResponse(const QString &command, const QJsonObject &payload)
 {
-    if (m_isConnected == false)
-        return;
-
-    m_WebSocket.sendTextMessage(QJsonDocument({{"type", command}, {"payload", payload}}).toJson(QJsonDocument::Compact));
+    sendPayload(command, payload);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -116,10 +148,7 @@ void Node::sendResponse(const QString &command, const QJsonObject &payload)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Node::sendResponse(const QString &command, const QJsonArray &payload)
 {
-    if (m_isConnected == false)
-        return;
-
-    m_WebSocket.sendTextMessage(QJsonDocument({{"type", command}, {"payload", payload}}).toJson(QJsonDocument::Compact));
+    sendPayload(command, payload);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -127,21 +156,79 @@ void Node::sendResponse(const QString &command, const QJsonArray &payload)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Node::sendResponse(const QString &command, const QString &payload)
 {
-    if (m_isConnected == false)
-        return;
-
-    m_WebSocket.sendTextMessage(QJsonDocument({{"type", command}, {"payload", payload}}).toJson(QJsonDocument::Compact));
+    sendPayload(command, payload);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Node::sendResponse(const QString &command, bool payload)
+{
+    sendPayload(command, payload);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Node::sendPayload(const QString &command, const QJsonValue &payload)
 {
     if (m_isConnected == false)
         return;
 
-    m_WebSocket.sendTextMessage(QJsonDocument({{"type", command}, {"payload", payload}}).toJson(QJsonDocument::Compact));
+    if (m_CborEncoding)
+    {
+        QCborMap message;
+        message.insert(QStringLiteral("type"), command);
+        message.insert(QStringLiteral("payload"), toCbor(payload));
+        m_SendBacklog += m_WebSocket.sendBinaryMessage(message.toCborValue().toCbor());
+    }
+    else
+        m_WebSocket.sendTextMessage(QJsonDocument({{"type", command}, {"payload", payload}}).toJson(QJsonDocument::Compact));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+QCborValue Node::toCbor(const QJsonValue &value)
+{
+    if (value.isObject())
+    {
+        const QJsonObject object = value.toObject();
+        QCborMap map;
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it)
+            map.insert(it.key(), toCbor(it.value()));
+        return map;
+    }
+
+    if (value.isArray())
+    {
+        const QJsonArray array = value.toArray();
+        const bool numeric = array.size() >= PACKED_ARRAY_MIN && std::all_of(array.begin(), array.end(),
+                             [](const QJsonValue & element)
+        {
+            return element.isDouble();
+        });
+
+        // Histograms, guide graphs and the like go out as one little endian float64 typed array
+        if (numeric)
+        {
+            QByteArray packed(array.size() * int(sizeof(double)), Qt::Uninitialized);
+            auto data = packed.data();
+            for (const auto &element : array)
+            {
+                qToLittleEndian(element.toDouble(), data);
+                data += sizeof(double);
+            }
+            return QCborValue(QCborTag(86), packed);
+        }
+
+        QCborArray cborArray;
+        for (const auto &element : array)
+            cborArray.append(toCbor(element));
+        return cborArray;
+    }
+
+    return QCborValue::fromJsonValue(value);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -161,7 +248,7 @@ void Node::sendBinaryMessage(const QByteArray &message)
 {
     if (m_isConnected == false)
         return;
-    m_WebSocket.sendBinaryMessage(message);
+    m_SendBacklog += m_WebSocket.sendBinaryMessage(message);
 }
 
 }
@@ -9,7 +9,9 @@
 #pragma once
 
 #include <QtWebSockets/QWebSocket>
+#include <QCborValue>
 #include <QJsonObject>
+#include <QTimer>
 #include <memory>
 
 namespace EkosLive
@@ -34,7 +36,21 @@ class Node : public QObject
         void sendBinaryMessage(const QByteArray &message);
         bool isConnected() const {return m_isConnected;}        
 
-        void setAuthResponse(const QJsonObject &response)
+        /** @brief sendBacklog Bytes handed to the socket that are not written to the network yet */
+        qint64 sendBacklog() const {return m_SendBacklog;}
+
+        /** @brief roundTripTime Smoothed round trip time of the pings to the server in ms, 0 until the first pong */
+        quint64 roundTripTime() const {return m_RoundTripTime;}
+
+        /**
+         * @brief setCborEncoding Send responses as binary CBOR messages rather than JSON text.
+         * Numeric arrays are packed as RFC 8746 typed arrays of little endian doubles (tag 86).
+         * The encoding is negotiated by the client and reset on every connection.
+         */
+        void setCborEncoding(bool enabled) {m_CborEncoding = enabled;}
+        bool cborEncoding() const {return m_CborEncoding;}
+
+                void setAuthResponse(const QJsonObject &response)
         {
             m_AuthResponse = response;
         }
@@ -44,6 +60,7 @@ class Node : public QObject
         void disconnected();
         void onTextReceived(const QString &message);
         void onBinaryReceived(const QByteArray &message);
+        void sendBacklogCleared();
 
     public slots:
         void connectServer();
@@ -54,9 +71,15 @@ class Node : public QObject
         void onConnected();
         void onDisconnected();
         void onError(QAbstractSocket::SocketError error);
+        void onBytesWritten(qint64 bytes);
+        void onPong(quint64 elapsedTime);
 
    private:
+        void sendPayload(const QString &command, const QJsonValue &payload);
+        static QCborValue toCbor(const QJsonValue &value);
+
         QWebSocket m_WebSocket;
+        QTimer m_PingTimer;
         QJsonObject m_AuthResponse;
         uint16_t m_ReconnectTries {0};
         QUrl m_URL;
@@ -64,6 +87,9 @@ class Node : public QObject
         QString m_Path;
 
         bool m_isConnected { false };
+        bool m_CborEncoding { false };
+        qint64 m_SendBacklog { 0 };
+        quint64 m_RoundTripTime { 0 };
         bool m_sendBlobs { true};
 
         QMap<int, bool> m_Options;        
@@ -74,5 +100,9 @@ class Node : public QObject
         static const uint16_t RECONNECT_MAX_TRIES = 720;
         // Throttle interval
         static const uint16_t THROTTLE_INTERVAL = 1000;
+        // Measure the round trip time every 5 seconds
+        static const uint16_t PING_INTERVAL = 5000;
+        // Shorter numeric arrays are not worth packing
+        static const uint16_t PACKED_ARRAY_MIN = 16;
 };
 }
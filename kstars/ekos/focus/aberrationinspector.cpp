@@ -10,7 +10,9 @@
 #include <kstars_debug.h>
 #include "kstars.h"
 #include "Options.h"
+#include "auxiliary/processinglanes.h"
 #include <QSplitter>
+#include <gsl/gsl_errno.h>
 
 const float RADIANS2DEGREES = 360.0f / (2.0f * M_PI);
 
@@ -441,20 +443,48 @@ void AberrationInspector::fitCurves()
         }
     }
 
+    // The tiles are independent so fit them on the thread pool, each with its own solver, and then update
+    // the widgets in tile order. The solvers switch the GSL error handler off and back on around each fit,
+    // so keep it off for the duration to stop concurrent fits from restoring each other's handler.
+    struct TileFit
+    {
+        std::unique_ptr<CurveFitting> curveFitting;
+        double position { 0.0 };
+        double measure { 0.0 };
+        double R2 { 0.0 };
+        bool foundFit { false };
+    };
+    std::vector<TileFit> tileFits(m_measures.count());
+
+    auto const oldErrorHandler = gsl_set_error_handler_off();
+    QList<QFuture<void>> futures;
     for (int tile = 0; tile < m_measures.count(); tile++)
     {
-        curveFitting->fitCurve(CurveFitting::FittingGoal::BEST, m_positions, m_measures[tile], m_weights[tile], outliers,
-                               m_data.curveFit, m_data.useWeights, m_data.optDir);
-
-        double position = 0.0;
-        double measure = 0.0;
-        double R2 = 0.0;
-        bool foundFit = curveFitting->findMinMax(expected, static_cast<double>(minPos), static_cast<double>(maxPos), &position,
-                        &measure, m_data.curveFit, m_data.optDir);
-        if (foundFit)
-            R2 = curveFitting->calculateR2(m_data.curveFit);
-
-        position = round(position);
+        futures.append(ProcessingLanes::run(ProcessingLanes::FOCUS, [ =, &tileFits, &outliers]()
+        {
+            TileFit &fit = tileFits[tile];
+            fit.curveFitting.reset(new CurveFitting());
+            fit.curveFitting->fitCurve(CurveFitting::FittingGoal::BEST, m_positions, m_measures[tile], m_weights[tile], outliers,
+                                       m_data.curveFit, m_data.useWeights, m_data.optDir);
+
+            fit.foundFit = fit.curveFitting->findMinMax(expected, static_cast<double>(minPos), static_cast<double>(maxPos),
+                           &fit.position, &fit.measure, m_data.curveFit, m_data.optDir);
+            if (fit.foundFit)
+                fit.R2 = fit.curveFitting->calculateR2(m_data.curveFit);
+        }));
+    }
+    for (auto &future : futures)
+        future.waitForFinished();
+    gsl_set_error_handler(oldErrorHandler);
+
+    for (int tile = 0; tile < m_measures.count(); tile++)
+    {
+        const TileFit &fit = tileFits[tile];
+        const double position = round(fit.position);
+        const double measure = fit.measure;
+        const bool foundFit = fit.foundFit;
+        const double R2 = fit.R2;
+
         m_minimum.append(position);
         m_minMeasure.append(measure);
         m_fit.append(foundFit);
@@ -470,7 +500,7 @@ void AberrationInspector::fitCurves()
 
         m_plot->addData(m_positions, m_measures[tile], m_weights[tile], outliers);
         // Fit the curve - note this needs curveFitting with the parameters for the current solution
-        m_plot->drawCurve(tile, curveFitting.get(), position, measure, foundFit, R2);
+        m_plot->drawCurve(tile, fit.curveFitting.get(), position, measure, foundFit, R2);
         // Draw solutions on the plot
         m_plot->drawMaxMin(tile, position, measure);
         // Draw the CFZ for the central tile
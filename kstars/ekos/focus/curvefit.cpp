@@ -1,6 +1,7 @@
 #include "curvefit.h"
 #include "ekos/ekos.h"
 #include <ekos_focus_debug.h>
+#include <cmath>
 
 // Constants used to identify the number of parameters used for different curve types
 constexpr int NUM_HYPERBOLA_PARAMS = 4;
@@ -478,7 +479,8 @@ double gaufxy(double x, double y, double a, double x0, double y0, double A, doub
 // Calculates f(x,y) for each data point in the gaussian.
 int gauFxy(const gsl_vector * X, void * inParams, gsl_vector * outResultVec)
 {
-    CurveFitting::DataPoint3DT * DataPoint = ((struct CurveFitting::DataPoint3DT *)inParams);
+    const CurveFitting::DataPoint3DT * DataPoint = ((const struct CurveFitting::DataPoint3DT *)inParams);
+    const CurveFitting::DataPT3D * dps = DataPoint->dps.constData();
 
     double a  = gsl_vector_get (X, A_IDX);
     double x0  = gsl_vector_get (X, B_IDX);
@@ -491,8 +493,10 @@ int gauFxy(const gsl_vector * X, void * inParams, gsl_vector * outResultVec)
     for(int i = 0; i < DataPoint->dps.size(); ++i)
     {
         // Gaussian equation
-        double zij = gaufxy(DataPoint->dps[i].x, DataPoint->dps[i].y, a, x0, y0, A, B, C, b);
-        gsl_vector_set(outResultVec, i, (zij - DataPoint->dps[i].z));
+        const double xmx0 = dps[i].x - x0;
+        const double ymy0 = dps[i].y - y0;
+        const double zij = b + a * exp(-((A * xmx0 * xmx0) + (2.0 * B * xmx0 * ymy0) + (C * ymy0 * ymy0)));
+        gsl_vector_set(outResultVec, i, (zij - dps[i].z));
     }
 
     return GSL_SUCCESS;
@@ -510,7 +514,8 @@ int gauFxy(const gsl_vector * X, void * inParams, gsl_vector * outResultVec)
 // df/dC      = -(y-y0)^2.a.phi
 int gauJxy(const gsl_vector * X, void * inParams, gsl_matrix * J)
 {
-    CurveFitting::DataPoint3DT * DataPoint = ((struct CurveFitting::DataPoint3DT *)inParams);
+    const CurveFitting::DataPoint3DT * DataPoint = ((const struct CurveFitting::DataPoint3DT *)inParams);
+    const CurveFitting::DataPT3D * dps = DataPoint->dps.constData();
 
     // Get current coefficients
     const double a  = gsl_vector_get (X, A_IDX);
@@ -523,23 +528,24 @@ int gauJxy(const gsl_vector * X, void * inParams, gsl_matrix * J)
 
     for(int i = 0; i < DataPoint->dps.size(); ++i)
     {
-        // Calculate the Jacobian Matrix
-        const double x = DataPoint->dps[i].x;
+        // Calculate the Jacobian Matrix, writing the row in place
+        const double x = dps[i].x;
         const double xmx0 = x - x0;
         const double xmx02 = xmx0 * xmx0;
-        const double y = DataPoint->dps[i].y;
+        const double y = dps[i].y;
         const double ymy0 = y - y0;
         const double ymy02 = ymy0 * ymy0;
         const double phi = exp(-((A * xmx02) + (2.0 * B * xmx0 * ymy0) + (C * ymy02)));
         const double aphi = a * phi;
 
-        gsl_matrix_set(J, i, A_IDX, phi);
-        gsl_matrix_set(J, i, B_IDX, 2.0 * aphi * ((A * xmx0) + (B * ymy0)));
-        gsl_matrix_set(J, i, C_IDX, 2.0 * aphi * ((B * xmx0) + (C * ymy0)));
-        gsl_matrix_set(J, i, D_IDX, -1.0 * aphi * xmx02);
-        gsl_matrix_set(J, i, E_IDX, -2.0 * aphi * xmx0 * ymy0);
-        gsl_matrix_set(J, i, F_IDX, -1.0 * aphi * ymy02);
-        gsl_matrix_set(J, i, G_IDX, 1.0);
+        double * row = gsl_matrix_ptr(J, i, 0);
+        row[A_IDX] = phi;
+        row[B_IDX] = 2.0 * aphi * ((A * xmx0) + (B * ymy0));
+        row[C_IDX] = 2.0 * aphi * ((B * xmx0) + (C * ymy0));
+        row[D_IDX] = -1.0 * aphi * xmx02;
+        row[E_IDX] = -2.0 * aphi * xmx0 * ymy0;
+        row[F_IDX] = -1.0 * aphi * ymy02;
+        row[G_IDX] = 1.0;
     }
 
     return GSL_SUCCESS;
@@ -585,7 +591,8 @@ int gauJxy(const gsl_vector * X, void * inParams, gsl_matrix * J)
 //
 int gauFxyxy(const gsl_vector* X,  const gsl_vector* v, void* inParams, gsl_vector* fvv)
 {
-    CurveFitting::DataPoint3DT * DataPoint = ((struct CurveFitting::DataPoint3DT *)inParams);
+    const CurveFitting::DataPoint3DT * DataPoint = ((const struct CurveFitting::DataPoint3DT *)inParams);
+    const CurveFitting::DataPT3D * dps = DataPoint->dps.constData();
 
     // Get current coefficients
     const double a  = gsl_vector_get (X, A_IDX);
@@ -606,10 +613,10 @@ int gauFxyxy(const gsl_vector* X,  const gsl_vector* v, void* inParams, gsl_vect
 
     for(int i = 0; i < DataPoint->dps.size(); ++i)
     {
-        double x = DataPoint->dps[i].x;
+        double x = dps[i].x;
         double xmx0 = x - x0;
         double xmx02 = xmx0 * xmx0;
-        double y = DataPoint->dps[i].y;
+        double y = dps[i].y;
         double ymy0 = y - y0;
         double ymy02 = ymy0 * ymy0;
         double phi = exp(-((A * xmx02) + (2.0 * B * xmx0 * ymy0) + (C * ymy02)));
@@ -1515,10 +1522,14 @@ void CurveFitting::parMakeGuess(const int attempt, const DataPointT &dataPoints,
     }
 }
 
-QVector<double> CurveFitting::gaussian_fit(DataPoint3DT data, const StarParams &starParams)
+QVector<double> CurveFitting::gaussian_fit(const DataPoint3DT &data, const StarParams &starParams)
 {
     QVector<double> vc;
 
+    // Warm start the solver from the moments of the star, falling back to the HFR if they cannot be computed
+    double moments[5];
+    const bool useMoments = gauMoments(data, starParams, moments);
+
     // Set the gsl error handler off as it aborts the program on error.
     auto const oldErrorHandler = gsl_set_error_handler_off();
 
@@ -1536,7 +1547,8 @@ QVector<double> CurveFitting::gaussian_fit(DataPoint3DT data, const StarParams &
     fdf.fvv = gauFxyxy;
     fdf.n = data.dps.size();
     fdf.p = NUM_GAUSSIAN_PARAMS;
-    fdf.params = &data;
+    // The callbacks only read the data points
+    fdf.params = const_cast<DataPoint3DT *>(&data);
 
     // Allocate the guess vector
     gsl_vector * guess = gsl_vector_alloc(NUM_GAUSSIAN_PARAMS);
@@ -1553,7 +1565,7 @@ QVector<double> CurveFitting::gaussian_fit(DataPoint3DT data, const StarParams &
     for (int attempt = 0; attempt < 5; attempt++)
     {
         // Make initial guesses
-        gauMakeGuess(attempt, starParams, guess);
+        gauMakeGuess(attempt, starParams, useMoments ? moments : nullptr, guess);
 
         // If using weights load up the GSL vector
         if (data.useWeights)
@@ -1645,9 +1657,62 @@ QVector<double> CurveFitting::gaussian_fit(DataPoint3DT data, const StarParams &
     return vc;
 }
 
+// Estimate the shape of the star from the intensity weighted moments of the background subtracted cutout.
+// For f = exp-(A(x-x0)^2 + 2B(x-x0)(y-y0) + C(y-y0)^2) the coefficient matrix [A B; B C] is half the inverse
+// of the covariance matrix of the star, so the moments give x0, y0, A, B and C, elongation included, which is
+// usually much closer to the solution than assuming a round star of the detected HFR.
+// moments is filled with x0, y0, A, B, C. Returns false if there is not enough signal to estimate them.
+bool CurveFitting::gauMoments(const DataPoint3DT &data, const StarParams &starParams, double *moments)
+{
+    const double background = std::max(starParams.background, 0.0);
+    const DataPT3D *dps = data.dps.constData();
+
+    double sum = 0, sumX = 0, sumY = 0;
+    for (int i = 0; i < data.dps.size(); i++)
+    {
+        const double w = dps[i].z - background;
+        if (w <= 0)
+            continue;
+        sum += w;
+        sumX += w * dps[i].x;
+        sumY += w * dps[i].y;
+    }
+    if (sum <= 0)
+        return false;
+
+    const double x0 = sumX / sum;
+    const double y0 = sumY / sum;
+    double sxx = 0, sxy = 0, syy = 0;
+    for (int i = 0; i < data.dps.size(); i++)
+    {
+        const double w = dps[i].z - background;
+        if (w <= 0)
+            continue;
+        const double dx = dps[i].x - x0;
+        const double dy = dps[i].y - y0;
+        sxx += w * dx * dx;
+        sxy += w * dx * dy;
+        syy += w * dy * dy;
+    }
+    sxx /= sum;
+    sxy /= sum;
+    syy /= sum;
+
+    const double det = sxx * syy - sxy * sxy;
+    if (!std::isfinite(det) || det <= 0)
+        return false;
+
+    moments[0] = x0;
+    moments[1] = y0;
+    moments[2] = syy / (2.0 * det);
+    moments[3] = -sxy / (2.0 * det);
+    moments[4] = sxx / (2.0 * det);
+    return true;
+}
+
 // Initialise parameters before starting the solver. Its important to start with a guess as near to the solution as possible
-// Since we have already run some HFR calcs on the star, use these values to calculate the guess
-void CurveFitting::gauMakeGuess(const int attempt, const StarParams &starParams, gsl_vector * guess)
+// Use the moments of the star if available, otherwise the HFR already calculated for the star
+void CurveFitting::gauMakeGuess(const int attempt, const StarParams &starParams, const double *moments, gsl_vector * guess)
 {
     // If we are retrying then perturb the initial conditions. The hope is that by doing this the solver
     // will be nudged to find a solution this time
@@ -1655,12 +1720,20 @@ void CurveFitting::gauMakeGuess(const int attempt, const StarParams &starParams,
 
     // Default from the input star details
     const double a  = std::max(starParams.peak, 0.0) * perturbation;       // Peak value
-    const double x0 = std::max(starParams.centroid_x, 0.0) * perturbation; // Centroid x
-    const double y0 = std::max(starParams.centroid_y, 0.0) * perturbation; // Centroid y
+    double x0 = std::max(starParams.centroid_x, 0.0) * perturbation;       // Centroid x
+    double y0 = std::max(starParams.centroid_y, 0.0) * perturbation;       // Centroid y
     const double b  = std::max(starParams.background, 0.0) * perturbation; // Background
 
     double A = 1.0, B = 0.0, C = 1.0;
-    if (starParams.HFR > 0.0)
+    if (moments != nullptr)
+    {
+        x0 = moments[0] * perturbation;
+        y0 = moments[1] * perturbation;
+        A = moments[2] * perturbation;
+        B = moments[3] * perturbation;
+        C = moments[4] * perturbation;
+    }
+    else if (starParams.HFR > 0.0)
     {
         // Use 2*HFR value as FWHM along with theta to calc A, B, C
         // FWHM = 2.sqrt(2.ln(2)).sigma
@@ -140,7 +140,6 @@ class CurveFitting
                 return;
             }
 
-            m_dataPoints.dps.clear();
             m_dataPoints.useWeights = useWeights;
 
             // Load up the data structures for the solver.
@@ -149,9 +148,15 @@ class CurveFitting
             int width = end.first - start.first;
             int height = end.second - start.second;
 
+            // Fill the cutout in place, row by row, rather than appending point by point
+            m_dataPoints.dps.resize(std::max(0, width * height));
+            DataPT3D *dp = m_dataPoints.dps.data();
             for (int j = 0; j < height; j++)
-                for (int i = 0; i < width; i++)
-                    m_dataPoints.push_back(i + 0.5, j + 0.5, imageBuffer[start.first + i + ((start.second + j) * imageWidth)], 1.0);
+            {
+                const T *row = imageBuffer + start.first + ((start.second + j) * imageWidth);
+                for (int i = 0; i < width; i++, dp++)
+                    *dp = {i + 0.5, j + 0.5, static_cast<double>(row[i]), 1.0};
+            }
 
             m_CurveType = curveFit;
             switch (m_CurveType)
@@ -227,7 +232,7 @@ class CurveFitting
         QVector<double> parabola_fit(FittingGoal goal, const QVector<double> data_x, const QVector<double> data_y,
                                      const QVector<double> data_weights,
                                      const QVector<bool> outliers, bool useWeights, const OptimisationDirection optDir);
-        QVector<double> gaussian_fit(DataPoint3DT data, const StarParams &starParams);
+        QVector<double> gaussian_fit(const DataPoint3DT &data, const StarParams &starParams);
         QVector<double> plane_fit(const DataPoint3DT data);
 
         bool minimumQuadratic(double expected, double minPosition, double maxPosition, double *position, double *value);
@@ -244,7 +249,8 @@ class CurveFitting
         void parMakeGuess(const int attempt, const DataPointT &dataPoints, gsl_vector * guess);
         void parSetupParams(FittingGoal goal, gsl_multifit_nlinear_parameters *params, int *numIters, double *xtol, double *gtol,
                             double *ftol);
-        void gauMakeGuess(const int attempt, const StarParams &starParams, gsl_vector * guess);
+        bool gauMoments(const DataPoint3DT &data, const StarParams &starParams, double *moments);
+        void gauMakeGuess(const int attempt, const StarParams &starParams, const double *moments, gsl_vector * guess);
         void gauSetupParams(gsl_multifit_nlinear_parameters *params, int *numIters, double *xtol, double *gtol, double *ftol);
         void plaMakeGuess(const int attempt, gsl_vector * guess);
         void plaSetupParams(gsl_multifit_nlinear_parameters *params, int *numIters, double *xtol, double *gtol, double *ftol);
@@ -9,6 +9,7 @@
 #include "focusadaptor.h"
 #include "focusalgorithms.h"
 #include "focusfwhm.h"
+#include "focuspredictor.h"
 #include "aberrationinspector.h"
 #include "aberrationinspectorutils.h"
 #include "kstars.h"
@@ -22,7 +23,9 @@
 
 // KStars Auxiliary
 #include "auxiliary/kspaths.h"
+#include "auxiliary/ksuserdb.h"
 #include "auxiliary/ksmessagebox.h"
+#include "auxiliary/kstrace.h"
 
 // Ekos Auxiliary
 #include "ekos/auxiliary/darklibrary.h"
@@ -31,6 +34,7 @@
 #include "ekos/auxiliary/opticaltrainmanager.h"
 #include "ekos/auxiliary/opticaltrainsettings.h"
 #include "ekos/auxiliary/filtermanager.h"
+#include "ekos/auxiliary/framerecorder.h"
 #include "ekos/auxiliary/stellarsolverprofileeditor.h"
 
 // FITS
@@ -88,6 +92,7 @@ Focus::Focus() : QWidget()
     resetButtons();
 
     // #7 Load All settings
+    m_SettingWidgets.collect(this);
     loadGlobalSettings();
 
     // #8 Init Setting Connection now
@@ -750,7 +755,7 @@ void Focus::checkFocuser()
         focuserLabel->setText(m_Focuser->getDeviceName());
 
     if (m_FilterManager)
-        m_FilterManager->setFocusReady(m_Focuser->isConnected());
+        m_FilterManager->setFocusReady(m_Focuser->isConnected(), m_Focuser->getDeviceName());
 
     hasDeviation = m_Focuser->hasDeviation();
 
@@ -1065,6 +1070,7 @@ void Focus::start()
     }
 
     inAutoFocus = true;
+    KSTrace::Instance()->asyncBegin("focus", "Autofocus");
     m_AFRun++;
     AFStartRetries = 0;
     m_LastFocusDirection = FOCUS_NONE;
@@ -1160,6 +1166,7 @@ void Focus::start()
                                << " Adaptive Focus:" << ( m_OpsFocusSettings->focusAdaptive->isChecked() ? "yes" : "no" )
                                << " Min Move:" << m_OpsFocusSettings->focusAdaptiveMinMove->value()
                                << " Adapt Start:" << ( m_OpsFocusSettings->focusAdaptStart->isChecked() ? "yes" : "no" )
+                               << " Predictive:" << ( m_OpsFocusSettings->focusPredictive->isChecked() ? "yes" : "no" )
                                << " Max Total Move:" << m_OpsFocusSettings->focusAdaptiveMaxMove->value();
     qCInfo(KSTARS_EKOS_FOCUS)  << "Process Tab."
                                << " Detection:" << m_OpsFocusProcess->focusDetection->currentText()
@@ -1238,8 +1245,7 @@ void Focus::start()
 
         if (m_FocusAlgorithm == FOCUS_LINEAR1PASS)
         {
-            // Curve fitting for stars and FWHM processing
-            starFitting.reset(new CurveFitting());
+            // FWHM processing
             focusFWHM.reset(new FocusFWHM(m_ScaleCalc));
             focusFourierPower.reset(new FocusFourierPower(m_ScaleCalc));
             // Donut Buster
@@ -1269,12 +1275,53 @@ void Focus::setupLinearFocuser(int initialPosition)
             m_StarMeasure, m_StarPSF, m_OpsFocusProcess->focusRefineCurveFit->isChecked(), m_FocusWalk,
             m_OpsFocusProcess->focusDonut->isChecked(), m_OpsFocusProcess->focusOutlierRejection->value(), m_OptDir, m_ScaleCalc);
 
+    if (m_OpsFocusSettings->focusPredictive->isChecked() && m_FocusAlgorithm == FOCUS_LINEAR1PASS)
+        setupFocusPrediction(params.temperature, &params.predictedPosition, &params.earlyStopR2);
+
     if (canAbsMove)
         initialFocuserAbsPosition = initialPosition;
     linearFocuser.reset(MakeLinearFocuser(params));
     linearRequestedPosition = linearFocuser->initialPosition();
 }
 
+// Predict the focus position from earlier runs with this train and filter, so the walk starts around it.
+// The prediction is only used when its uncertainty is well within the walk, otherwise the minimum could be missed.
+void Focus::setupFocusPrediction(double temperature, int *predictedPosition, double *earlyStopR2)
+{
+    QList<QVariantMap> history;
+    const uint32_t train = OpticalTrainManager::Instance()->id(opticalTrainCombo->currentText());
+    if (!KStarsData::Instance()->userdb()->GetFocusRuns(train, m_AFfilter, FocusPredictor::MAX_RUNS, history))
+        return;
+
+    QVector<FocusPredictor::Run> runs;
+    for (const auto &oneRun : history)
+        runs.append({oneRun["Position"].toInt(), oneRun["Temperature"].toDouble(), oneRun["Altitude"].toDouble()});
+
+    FocusPredictor predictor;
+    predictor.setRuns(runs);
+    const double altitude = (mountAlt < 0.0 || mountAlt > 90.0) ? INVALID_VALUE : mountAlt;
+    int position;
+    double uncertainty;
+    if (!predictor.predict(temperature, altitude, &position, &uncertainty))
+    {
+        qCDebug(KSTARS_EKOS_FOCUS) << "Focus prediction: too few runs with" << m_AFfilter;
+        return;
+    }
+
+    const double halfWalk = (m_OpsFocusMechanics->focusNumSteps->value() - 1) / 2.0 * m_OpsFocusMechanics->focusTicks->value();
+    if (3 * uncertainty > halfWalk)
+    {
+        appendLogText(i18n("Focus prediction %1 is too uncertain (±%2 steps), walking from the current position.",
+                           position, static_cast<int>(uncertainty)));
+        return;
+    }
+
+    *predictedPosition = position;
+    *earlyStopR2 = m_OpsFocusProcess->focusR2Limit->value();
+    appendLogText(i18n("Starting Autofocus around predicted position %1 (±%2 steps).", position,
+                       static_cast<int>(uncertainty)));
+}
+
 // Initialise donut buster
 bool Focus::initDonutProcessing()
 {
@@ -1405,6 +1452,8 @@ void Focus::stop(Ekos::FocusState completionState)
 
     opticalTrainCombo->setEnabled(true);
     resetDonutProcessing();
+    if (inAutoFocus)
+        KSTrace::Instance()->asyncEnd("focus", "Autofocus");
     inAutoFocus = false;
     inAdjustFocus = false;
     adaptFocus->setInAdaptiveFocus(false);
@@ -1414,6 +1463,7 @@ void Focus::stop(Ekos::FocusState completionState)
     focuserAdditionalMovementUpdateDir = true;
     inFocusLoop = false;
     captureInProgress = false;
+    m_PendingImageData.reset();
     isVShapeSolution = false;
     captureFailureCounter = 0;
     minimumRequiredHFR = INVALID_STAR_MEASURE;
@@ -1594,6 +1644,18 @@ void Focus::capture(double settleTime)
     }
 }
 
+bool Focus::canCaptureAhead() const
+{
+    // Only within a focus point of an autofocus run, with more frames to average after the one received.
+    if (inAutoFocus == false || inFocusLoop || captureInProgress || m_PendingImageData)
+        return false;
+    if (starMeasureFrames.count() + 1 >= m_OpsFocusProcess->focusFramesCount->value())
+        return false;
+
+    // Until a star is selected, the analysis may still change the frame (e.g. subframing around the star).
+    return m_OpsFocusSettings->focusUseFullField->isChecked() || starSelected;
+}
+
 void Focus::prepareCapture(ISD::CameraChip *targetChip)
 {
     if (m_Camera->getUploadMode() == ISD::Camera::UPLOAD_LOCAL)
@@ -1849,14 +1911,31 @@ void Focus::reconnectFocuser(const QString &focuser)
 
 void Focus::processData(const QSharedPointer<FITSData> &data)
 {
+    KSTRACE_SCOPE("focus", "processData");
     // Ignore guide head if there is any.
     if (data->property("chip").toInt() == ISD::CameraChip::GUIDE_CCD)
         return;
 
+    // Frame captured ahead while the previous one is still being analysed, process it once done.
+    if (data && hfrInProgress)
+    {
+        m_PendingImageData = data;
+        captureTimeout.stop();
+        captureTimeoutCounter = 0;
+        disconnect(m_Camera, &ISD::Camera::newImage, this, &Ekos::Focus::processData);
+        disconnect(m_Camera, &ISD::Camera::error, this, &Ekos::Focus::processCaptureError);
+        return;
+    }
+
     if (data)
     {
         m_FocusView->loadData(data);
         m_ImageData = data;
+        FrameRecorder::Instance()->record(FrameRecorder::FOCUS, data,
+        {
+            {"position", currentPosition},
+            {"autofocus", inAutoFocus}
+        });
     }
     else
         m_ImageData.reset();
@@ -1885,6 +1964,7 @@ void Focus::processData(const QSharedPointer<FITSData> &data)
 
 void Focus::starDetectionFinished()
 {
+    KSTRACE_SCOPE("focus", "starDetectionFinished");
     appendLogText(i18n("Detection complete."));
 
     // Beware as this HFR value is then treated specifically by the graph renderer
@@ -1961,44 +2041,60 @@ void Focus::starDetectionFinished()
 // The image has been processed for star centroids and HFRs so now process it for star FWHMs
 void Focus::getFWHM(const QList<Edge *> &stars, double *FWHM, double *weight)
 {
-    *FWHM = INVALID_STAR_MEASURE;
-    *weight = 0.0;
+    QVector<double> FWHMs, weights;
+    getFWHM(stars, QVector<int>(stars.size(), 0), 1, &FWHMs, &weights);
+    *FWHM = FWHMs[0];
+    *weight = weights[0];
+}
+
+void Focus::getFWHM(const QList<Edge *> &stars, const QVector<int> &starTiles, const int numTiles, QVector<double> *FWHMs,
+                    QVector<double> *weights)
+{
+    FWHMs->fill(INVALID_STAR_MEASURE, numTiles);
+    weights->fill(0.0, numTiles);
 
     auto imageBuffer = m_ImageData->getImageBuffer();
 
     switch (m_ImageData->getStatistics().dataType)
     {
         case TBYTE:
-            focusFWHM->processFWHM(reinterpret_cast<uint8_t const *>(imageBuffer), stars, m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<uint8_t const *>(imageBuffer), stars, m_ImageData, starTiles, numTiles, FWHMs,
+                                   weights);
             break;
 
         case TSHORT: // Don't think short is used as its recorded as unsigned short
-            focusFWHM->processFWHM(reinterpret_cast<short const *>(imageBuffer), stars, m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<short const *>(imageBuffer), stars, m_ImageData, starTiles, numTiles, FWHMs,
+                                   weights);
             break;
 
         case TUSHORT:
-            focusFWHM->processFWHM(reinterpret_cast<unsigned short const *>(imageBuffer), stars, m_ImageData, starFitting, FWHM,
-                                   weight);
+            focusFWHM->processFWHM(reinterpret_cast<unsigned short const *>(imageBuffer), stars, m_ImageData, starTiles, numTiles, FWHMs,
+                                   weights);
             break;
 
         case TLONG:  // Don't think long is used as its recorded as unsigned long
-            focusFWHM->processFWHM(reinterpret_cast<long const *>(imageBuffer), stars, m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<long const *>(imageBuffer), stars, m_ImageData, starTiles, numTiles, FWHMs,
+                                   weights);
             break;
 
         case TULONG:
-            focusFWHM->processFWHM(reinterpret_cast<unsigned long const *>(imageBuffer), stars, m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<unsigned long const *>(imageBuffer), stars, m_ImageData, starTiles, numTiles, FWHMs,
+                                   weights);
             break;
 
         case TFLOAT:
-            focusFWHM->processFWHM(reinterpret_cast<float const *>(imageBuffer), stars, m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<float const *>(imageBuffer), stars, m_ImageData, starTiles, numTiles, FWHMs,
+                                   weights);
             break;
 
         case TLONGLONG:
-            focusFWHM->processFWHM(reinterpret_cast<long long const *>(imageBuffer), stars, m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<long long const *>(imageBuffer), stars, m_ImageData, starTiles, numTiles, FWHMs,
+                                   weights);
             break;
 
         case TDOUBLE:
-            focusFWHM->processFWHM(reinterpret_cast<double const *>(imageBuffer), stars, m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<double const *>(imageBuffer), stars, m_ImageData, starTiles, numTiles, FWHMs,
+                                   weights);
             break;
 
         default:
@@ -2077,6 +2173,7 @@ double Focus::calculateStarWeight(const bool useWeights, const std::vector<doubl
 
 void Focus::analyzeSources()
 {
+    KSTRACE_SCOPE("focus", "analyzeSources");
     appendLogText(i18n("Detecting sources..."));
     hfrInProgress = true;
 
@@ -2250,6 +2347,23 @@ void Focus::completeFocusProcedure(FocusState completionState, bool plot)
             setLastFocusAlt();
             resetAdaptiveFocus(m_OpsFocusSettings->focusAdaptive->isChecked());
 
+            // Keep the result so later runs can predict where focus will be
+            if (m_FocusAlgorithm == FOCUS_LINEAR1PASS)
+            {
+                QVariantMap oneRun;
+                oneRun["Train"] = OpticalTrainManager::Instance()->id(opticalTrainCombo->currentText());
+                oneRun["Filter"] = m_AFfilter;
+                oneRun["Position"] = currentPosition;
+                oneRun["Temperature"] = m_LastSourceAutofocusTemperature;
+                oneRun["Altitude"] = m_LastSourceAutofocusAlt;
+                oneRun["Value"] = currentHFR;
+                oneRun["Timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+                KStarsData::Instance()->userdb()->post([oneRun](KSUserDB & db)
+                {
+                    return db.AddFocusRun(oneRun);
+                });
+            }
+
             // CR add auto focus position, temperature and filter to log in CSV format
             // this will help with setting up focus offsets and temperature compensation
             qCInfo(KSTARS_EKOS_FOCUS) << "Autofocus values: position," << currentPosition << ", temperature,"
@@ -2363,7 +2477,15 @@ void Focus::setCurrentMeasure()
     // Take the new HFR into account, eventually continue to stack samples
     if (appendMeasure(currentMeasure))
     {
-        capture();
+        // The next frame may already have been captured ahead, or still be exposing
+        if (m_PendingImageData)
+        {
+            auto data = m_PendingImageData;
+            m_PendingImageData.reset();
+            processData(data);
+        }
+        else if (captureInProgress == false)
+            capture();
         return;
     }
     else starMeasureFrames.clear();
@@ -2489,7 +2611,9 @@ void Focus::calculateAbInsData()
     const QVector<QRect> tiles = mosaicmask->tiles();
     auto stars = m_ImageData->getStarCenters();
     QVector<QList<Edge *>> tileStars(NUM_TILES);
+    QVector<int> starTiles(stars.count(), -1);
 
+    // Assign the stars to the tiles in one pass over the frame
     for (int star = 0; star < stars.count(); star++)
     {
         const int x = stars[star]->x;
@@ -2500,11 +2624,17 @@ void Focus::calculateAbInsData()
             if (thisTile.contains(x, y))
             {
                 tileStars[tile].append(stars[star]);
+                starTiles[star] = tile;
                 break;
             }
         }
     }
 
+    // FWHMs are fitted for all the tiles at once
+    QVector<double> tileFWHMs, tileFWHMWeights;
+    if (m_StarMeasure == FOCUS_STAR_FWHM)
+        getFWHM(stars, starTiles, NUM_TILES, &tileFWHMs, &tileFWHMWeights);
+
     // Get the measure for each tile
     for (int tile = 0; tile < tileStars.count(); tile++)
     {
@@ -2517,7 +2647,8 @@ void Focus::calculateAbInsData()
         }
         else if (m_StarMeasure == FOCUS_STAR_FWHM)
         {
-            getFWHM(tileStars[tile], &measure, &weight);
+            measure = tileFWHMs[tile];
+            weight = tileFWHMWeights[tile];
         }
         else if (m_StarMeasure == FOCUS_STAR_FOURIER_POWER)
         {
@@ -2600,7 +2731,12 @@ void Focus::setCaptureComplete()
     // THEN let's find stars in the image and get current HFR
     if (inFocusLoop == false || (inFocusLoop && (m_FocusView->isTrackingBoxEnabled()
                                  || m_OpsFocusSettings->focusUseFullField->isChecked())))
+    {
+        // Expose the next frame of this focus point while detecting stars in this one
+        if (canCaptureAhead())
+            capture();
         analyzeSources();
+    }
     else
         setHFRComplete();
 }
@@ -3213,6 +3349,7 @@ void Focus::scanStartPos()
 
 void Focus::autoFocusLinear()
 {
+    KSTRACE_SCOPE("focus", "autoFocusLinear");
     if (!autoFocusChecks())
         return;
 
@@ -3300,6 +3437,7 @@ void Focus::autoFocusLinear()
 
 void Focus::autoFocusAbs()
 {
+    KSTRACE_SCOPE("focus", "autoFocusAbs");
     // Q_ASSERT_X(canAbsMove || canRelMove, __FUNCTION__, "Prerequisite: only absolute and relative focusers");
 
     static int minHFRPos = 0, focusOutLimit = 0, focusInLimit = 0, lastHFRPos = 0, fluctuations = 0;
@@ -5264,7 +5402,7 @@ void Focus::loadGlobalSettings()
 
     QVariantMap settings;
     // All Combo Boxes
-    for (auto &oneWidget : findChildren<QComboBox*>())
+    for (auto &oneWidget : m_SettingWidgets.comboBoxes())
     {
         if (oneWidget->objectName() == "opticalTrainCombo")
             continue;
@@ -5281,7 +5419,7 @@ void Focus::loadGlobalSettings()
     }
 
     // All Double Spin Boxes
-    for (auto &oneWidget : findChildren<QDoubleSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.doubleSpinBoxes())
     {
         key = oneWidget->objectName();
         value = Options::self()->property(key.toLatin1());
@@ -5295,7 +5433,7 @@ void Focus::loadGlobalSettings()
     }
 
     // All Spin Boxes
-    for (auto &oneWidget : findChildren<QSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.spinBoxes())
     {
         key = oneWidget->objectName();
         value = Options::self()->property(key.toLatin1());
@@ -5309,7 +5447,7 @@ void Focus::loadGlobalSettings()
     }
 
     // All Checkboxes
-    for (auto &oneWidget : findChildren<QCheckBox*>())
+    for (auto &oneWidget : m_SettingWidgets.checkBoxes())
     {
         key = oneWidget->objectName();
         value = Options::self()->property(key.toLatin1());
@@ -5323,7 +5461,7 @@ void Focus::loadGlobalSettings()
     }
 
     // All Checkable Groupboxes
-    for (auto &oneWidget : findChildren<QGroupBox*>())
+    for (auto &oneWidget : m_SettingWidgets.groupBoxes())
     {
         if (oneWidget->isCheckable())
         {
@@ -5340,7 +5478,7 @@ void Focus::loadGlobalSettings()
     }
 
     // All Splitters
-    for (auto &oneWidget : findChildren<QSplitter*>())
+    for (auto &oneWidget : m_SettingWidgets.splitters())
     {
         key = oneWidget->objectName();
         value = Options::self()->property(key.toLatin1());
@@ -5356,7 +5494,7 @@ void Focus::loadGlobalSettings()
     }
 
     // All Radio buttons
-    for (auto &oneWidget : findChildren<QRadioButton*>())
+    for (auto &oneWidget : m_SettingWidgets.radioButtons())
     {
         key = oneWidget->objectName();
         value = Options::self()->property(key.toLatin1());
@@ -5395,66 +5533,66 @@ void Focus::checkMosaicMaskLimits()
 void Focus::connectSyncSettings()
 {
     // All Combo Boxes
-    for (auto &oneWidget : findChildren<QComboBox*>())
+    for (auto &oneWidget : m_SettingWidgets.comboBoxes())
         // Don't sync Optical Train combo
         if (oneWidget != opticalTrainCombo)
             connect(oneWidget, QOverload<int>::of(&QComboBox::activated), this, &Ekos::Focus::syncSettings);
 
     // All Double Spin Boxes
-    for (auto &oneWidget : findChildren<QDoubleSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.doubleSpinBoxes())
         connect(oneWidget, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &Ekos::Focus::syncSettings);
 
     // All Spin Boxes
-    for (auto &oneWidget : findChildren<QSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.spinBoxes())
         connect(oneWidget, QOverload<int>::of(&QSpinBox::valueChanged), this, &Ekos::Focus::syncSettings);
 
     // All Checkboxes
-    for (auto &oneWidget : findChildren<QCheckBox*>())
+    for (auto &oneWidget : m_SettingWidgets.checkBoxes())
         connect(oneWidget, &QCheckBox::toggled, this, &Ekos::Focus::syncSettings);
 
     // All Checkable Groupboxes
-    for (auto &oneWidget : findChildren<QGroupBox*>())
+    for (auto &oneWidget : m_SettingWidgets.groupBoxes())
         if (oneWidget->isCheckable())
             connect(oneWidget, &QGroupBox::toggled, this, &Ekos::Focus::syncSettings);
 
     // All Splitters
-    for (auto &oneWidget : findChildren<QSplitter*>())
+    for (auto &oneWidget : m_SettingWidgets.splitters())
         connect(oneWidget, &QSplitter::splitterMoved, this, &Ekos::Focus::syncSettings);
 
     // All Radio Buttons
-    for (auto &oneWidget : findChildren<QRadioButton*>())
+    for (auto &oneWidget : m_SettingWidgets.radioButtons())
         connect(oneWidget, &QRadioButton::toggled, this, &Ekos::Focus::syncSettings);
 }
 
 void Focus::disconnectSyncSettings()
 {
     // All Combo Boxes
-    for (auto &oneWidget : findChildren<QComboBox*>())
+    for (auto &oneWidget : m_SettingWidgets.comboBoxes())
         disconnect(oneWidget, QOverload<int>::of(&QComboBox::activated), this, &Ekos::Focus::syncSettings);
 
     // All Double Spin Boxes
-    for (auto &oneWidget : findChildren<QDoubleSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.doubleSpinBoxes())
         disconnect(oneWidget, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &Ekos::Focus::syncSettings);
 
     // All Spin Boxes
-    for (auto &oneWidget : findChildren<QSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.spinBoxes())
         disconnect(oneWidget, QOverload<int>::of(&QSpinBox::valueChanged), this, &Ekos::Focus::syncSettings);
 
     // All Checkboxes
-    for (auto &oneWidget : findChildren<QCheckBox*>())
+    for (auto &oneWidget : m_SettingWidgets.checkBoxes())
         disconnect(oneWidget, &QCheckBox::toggled, this, &Ekos::Focus::syncSettings);
 
     // All Checkable Groupboxes
-    for (auto &oneWidget : findChildren<QGroupBox*>())
+    for (auto &oneWidget : m_SettingWidgets.groupBoxes())
         if (oneWidget->isCheckable())
             disconnect(oneWidget, &QGroupBox::toggled, this, &Ekos::Focus::syncSettings);
 
     // All Splitters
-    for (auto &oneWidget : findChildren<QSplitter*>())
+    for (auto &oneWidget : m_SettingWidgets.splitters())
         disconnect(oneWidget, &QSplitter::splitterMoved, this, &Ekos::Focus::syncSettings);
 
     // All Radio Buttons
-    for (auto &oneWidget : findChildren<QRadioButton*>())
+    for (auto &oneWidget : m_SettingWidgets.radioButtons())
         disconnect(oneWidget, &QRadioButton::toggled, this, &Ekos::Focus::syncSettings);
 }
 
@@ -5827,6 +5965,7 @@ void Focus::setFocusAlgorithm(Algorithm algorithm)
             // Disable adaptive focus
             m_OpsFocusSettings->focusAdaptive->setChecked(false);
             m_OpsFocusSettings->focusAdaptStart->setChecked(false);
+            m_OpsFocusSettings->focusPredictive->setChecked(false);
             m_OpsFocusSettings->adaptiveFocusGroup->setEnabled(false);
 
             // Mechanics changes
@@ -5953,6 +6092,7 @@ void Focus::setFocusAlgorithm(Algorithm algorithm)
             // Disable adaptive focus
             m_OpsFocusSettings->focusAdaptive->setChecked(false);
             m_OpsFocusSettings->focusAdaptStart->setChecked(false);
+            m_OpsFocusSettings->focusPredictive->setChecked(false);
             m_OpsFocusSettings->adaptiveFocusGroup->setEnabled(false);
 
             // Mechanics changes
@@ -6074,6 +6214,7 @@ void Focus::setFocusAlgorithm(Algorithm algorithm)
             // Disable adaptive focus
             m_OpsFocusSettings->focusAdaptive->setChecked(false);
             m_OpsFocusSettings->focusAdaptStart->setChecked(false);
+            m_OpsFocusSettings->focusPredictive->setChecked(false);
             m_OpsFocusSettings->adaptiveFocusGroup->setEnabled(false);
 
             // Mechanics changes
@@ -6858,32 +6999,32 @@ QVariantMap Focus::getAllSettings() const
     QVariantMap settings;
 
     // All Combo Boxes
-    for (auto &oneWidget : findChildren<QComboBox*>())
+    for (auto &oneWidget : m_SettingWidgets.comboBoxes())
         settings.insert(oneWidget->objectName(), oneWidget->currentText());
 
     // All Double Spin Boxes
-    for (auto &oneWidget : findChildren<QDoubleSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.doubleSpinBoxes())
         settings.insert(oneWidget->objectName(), oneWidget->value());
 
     // All Spin Boxes
-    for (auto &oneWidget : findChildren<QSpinBox*>())
+    for (auto &oneWidget : m_SettingWidgets.spinBoxes())
         settings.insert(oneWidget->objectName(), oneWidget->value());
 
     // All Checkboxes
-    for (auto &oneWidget : findChildren<QCheckBox*>())
+    for (auto &oneWidget : m_SettingWidgets.checkBoxes())
         settings.insert(oneWidget->objectName(), oneWidget->isChecked());
 
     // All Checkable Groupboxes
-    for (auto &oneWidget : findChildren<QGroupBox*>())
+    for (auto &oneWidget : m_SettingWidgets.groupBoxes())
         if (oneWidget->isCheckable())
             settings.insert(oneWidget->objectName(), oneWidget->isChecked());
 
     // All Splitters
-    for (auto &oneWidget : findChildren<QSplitter*>())
+    for (auto &oneWidget : m_SettingWidgets.splitters())
         settings.insert(oneWidget->objectName(), QString::fromUtf8(oneWidget->saveState().toBase64()));
 
     // All Radio Buttons
-    for (auto &oneWidget : findChildren<QRadioButton*>())
+    for (auto &oneWidget : m_SettingWidgets.radioButtons())
         settings.insert(oneWidget->objectName(), oneWidget->isChecked());
 
     return settings;
@@ -6898,7 +7039,7 @@ void Focus::setAllSettings(const QVariantMap &settings)
     for (auto &name : settings.keys())
     {
         // Combo
-        auto comboBox = findChild<QComboBox*>(name);
+        auto comboBox = qobject_cast<QComboBox*>(m_SettingWidgets.widget(name));
         if (comboBox)
         {
             syncControl(settings, name, comboBox);
@@ -6906,7 +7047,7 @@ void Focus::setAllSettings(const QVariantMap &settings)
         }
 
         // Double spinbox
-        auto doubleSpinBox = findChild<QDoubleSpinBox*>(name);
+        auto doubleSpinBox = qobject_cast<QDoubleSpinBox*>(m_SettingWidgets.widget(name));
         if (doubleSpinBox)
         {
             syncControl(settings, name, doubleSpinBox);
@@ -6914,7 +7055,7 @@ void Focus::setAllSettings(const QVariantMap &settings)
         }
 
         // spinbox
-        auto spinBox = findChild<QSpinBox*>(name);
+        auto spinBox = qobject_cast<QSpinBox*>(m_SettingWidgets.widget(name));
         if (spinBox)
         {
             syncControl(settings, name, spinBox);
@@ -6922,7 +7063,7 @@ void Focus::setAllSettings(const QVariantMap &settings)
         }
 
         // checkbox
-        auto checkbox = findChild<QCheckBox*>(name);
+        auto checkbox = qobject_cast<QCheckBox*>(m_SettingWidgets.widget(name));
         if (checkbox)
         {
             syncControl(settings, name, checkbox);
@@ -6930,7 +7071,7 @@ void Focus::setAllSettings(const QVariantMap &settings)
         }
 
         // Checkable Groupboxes
-        auto groupbox = findChild<QGroupBox*>(name);
+        auto groupbox = qobject_cast<QGroupBox*>(m_SettingWidgets.widget(name));
         if (groupbox && groupbox->isCheckable())
         {
             syncControl(settings, name, groupbox);
@@ -6938,7 +7079,7 @@ void Focus::setAllSettings(const QVariantMap &settings)
         }
 
         // Splitters
-        auto splitter = findChild<QSplitter*>(name);
+        auto splitter = qobject_cast<QSplitter*>(m_SettingWidgets.widget(name));
         if (splitter)
         {
             syncControl(settings, name, splitter);
@@ -6946,7 +7087,7 @@ void Focus::setAllSettings(const QVariantMap &settings)
         }
 
         // Radio button
-        auto radioButton = findChild<QRadioButton*>(name);
+        auto radioButton = qobject_cast<QRadioButton*>(m_SettingWidgets.widget(name));
         if (radioButton)
         {
             syncControl(settings, name, radioButton);
@@ -11,6 +11,7 @@
 #include "ekos/ekos.h"
 #include "parameters.h"
 #include "ekos/auxiliary/filtermanager.h"
+#include "ekos/auxiliary/settingwidgets.h"
 
 #include "indi/indicamera.h"
 #include "indi/indifocuser.h"
@@ -477,6 +478,13 @@ class Focus : public QWidget, public Ui::Focus
 
         void setCaptureComplete();
 
+        /**
+         * @brief canCaptureAhead Check whether the next frame of the current focus point can be exposed while the frame
+         * just received is analysed. This is only the case for autofocus frames averaged at the same position, once the
+         * frame settings cannot change anymore.
+         */
+        bool canCaptureAhead() const;
+
         void showFITSViewer();
 
         void toggleFocusingWidgetFullScreen();
@@ -780,6 +788,9 @@ class Focus : public QWidget, public Ui::Focus
 
         // Process the image to get star FWHMs
         void getFWHM(const QList<Edge *> &stars, double *FWHM, double *weight);
+        // Process the image once to get the star FWHMs of each tile, starTiles holding the tile of each star
+        void getFWHM(const QList<Edge *> &stars, const QVector<int> &starTiles, const int numTiles, QVector<double> *FWHMs,
+                     QVector<double> *weights);
 
         // Process the image to get the Fourier Transform Power
         // If tile = -1 use the whole image; if mosaicTile is specified use just that
@@ -889,6 +900,14 @@ class Focus : public QWidget, public Ui::Focus
          */
         void setupLinearFocuser(int initialPosition);
 
+        /**
+         * @brief Predict the focus position from earlier Autofocus runs with the current train and filter
+         * @param temperature current temperature, INVALID_VALUE if not known
+         * @param predictedPosition set to the prediction, left alone if there is none
+         * @param earlyStopR2 set to the R2 at which the walk may end, left alone if there is no prediction
+         */
+        void setupFocusPrediction(double temperature, int *predictedPosition, double *earlyStopR2);
+
         /**
          * @brief Process the scan for the Autofocus starting position
          */
@@ -1124,9 +1143,6 @@ class Focus : public QWidget, public Ui::Focus
         // Curve fitting for focuser movement.
         std::unique_ptr<CurveFitting> curveFitting;
 
-        // Curve fitting for stars.
-        std::unique_ptr<CurveFitting> starFitting;
-
         // FWHM processing.
         std::unique_ptr<FocusFWHM> focusFWHM;
 
@@ -1161,6 +1177,8 @@ class Focus : public QWidget, public Ui::Focus
 
         // Data
         QSharedPointer<FITSData> m_ImageData;
+        // Next frame of a multi-frame focus point received while the current one is still being analysed
+        QSharedPointer<FITSData> m_PendingImageData;
 
         // Linear focuser.
         std::unique_ptr<FocusAlgorithmInterface> linearFocuser;
@@ -1183,6 +1201,7 @@ class Focus : public QWidget, public Ui::Focus
 
         QVariantMap m_Settings;
         QVariantMap m_GlobalSettings;
+        SettingWidgets m_SettingWidgets;
 
         // Dark Processor
         QPointer<DarkProcessor> m_DarkProcessor;
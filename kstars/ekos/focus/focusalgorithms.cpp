@@ -128,6 +128,9 @@ class LinearFocusAlgorithm : public FocusAlgorithmInterface
         // Called by L1P to finish off the first pass, setting state variables.
         int finishFirstPass(int position, double value);
 
+        // Whether an L1P walk is centred on a predicted position and may end early.
+        bool isPredictive() const;
+
         // Peirce's criterion
         // Returns the squared threshold error deviation for outlier identification
         // using Peirce's criterion based on Gould's methodology.
@@ -326,6 +329,7 @@ void LinearFocusAlgorithm::computeInitialPosition()
 // Generally this is just the number of outward points * step size.
 // For LINEAR1PASS most walks have a constant step size so again it is the number of outward points * step size.
 // For LINEAR1PASS and FOCUS_WALK_CFZ_SHUFFLE the middle 3 or 4 points are separated by half step size
+// A predictive walk keeps its shape but is centred on the predicted position instead of the start position.
 int LinearFocusAlgorithm::getFirstPosition()
 {
     if (params.focusAlgorithm != Focus::FOCUS_LINEAR1PASS)
@@ -333,6 +337,8 @@ int LinearFocusAlgorithm::getFirstPosition()
 
     int firstPosition;
     double outSteps, numFullStepsOut, numHalfStepsOut;
+    const int centre = isPredictive() ? std::clamp(params.predictedPosition, minPositionLimit, maxPositionLimit) :
+                       params.startPosition;
 
     switch (params.focusWalk)
     {
@@ -342,7 +348,7 @@ int LinearFocusAlgorithm::getFirstPosition()
 
         case Focus::FOCUS_WALK_FIXED_STEPS:
             outSteps = (params.numSteps - 1) / 2.0f;
-            firstPosition = params.startPosition + (outSteps * params.initialStepSize);
+            firstPosition = centre + (outSteps * params.initialStepSize);
             break;
 
         case Focus::FOCUS_WALK_CFZ_SHUFFLE:
@@ -358,7 +364,7 @@ int LinearFocusAlgorithm::getFirstPosition()
                 numHalfStepsOut = 1.5f;
                 numFullStepsOut = (params.numSteps / 2.0f) - 2.0f;
             }
-            firstPosition = params.startPosition + (numFullStepsOut * params.initialStepSize) + (numHalfStepsOut *
+            firstPosition = centre + (numFullStepsOut * params.initialStepSize) + (numHalfStepsOut *
                             (params.initialStepSize / 2.0f));
 
             break;
@@ -793,6 +799,31 @@ int LinearFocusAlgorithm::linearWalk(int position, double value, const double st
             foundFit = params.curveFitting->findMinMax(position, 0, params.maxPositionAllowed, &minPos, &minVal,
                        static_cast<CurveFitting::CurveFit>(params.curveFit), params.optimisationDirection);
 
+            // A walk centred on a predicted focus may end once both sides of the minimum are sampled
+            // and the curve fits well enough; the remaining points would only sharpen a curve already trusted.
+            if (foundFit && isPredictive() && params.earlyStopR2 > 0 && numSteps < params.numSteps)
+            {
+                const int inside = std::count_if(positions.begin(), positions.end(), [minPos](int p)
+                {
+                    return p < minPos;
+                });
+                const int outside = positions.size() - inside;
+                if (inside >= 2 && outside >= 2 &&
+                        params.curveFitting->calculateR2(params.curveFit) >= params.earlyStopR2)
+                {
+                    params.curveFitting->fitCurve(CurveFitting::FittingGoal::BEST, positions, values, weights, pass1Outliers,
+                                                  params.curveFit, params.useWeights, params.optimisationDirection);
+                    if (params.curveFitting->findMinMax(position, 0, params.maxPositionAllowed, &minPos, &minVal,
+                                                        static_cast<CurveFitting::CurveFit>(params.curveFit), params.optimisationDirection))
+                    {
+                        qCDebug(KSTARS_EKOS_FOCUS) << QString("Linear1Pass: early stop after %1 of %2 steps, solution %3 = %4")
+                                                   .arg(numSteps).arg(params.numSteps).arg(minPos).arg(minVal);
+                        return finishFirstPass(static_cast<int>(round(minPos)), minVal);
+                    }
+                    foundFit = false;
+                }
+            }
+
             if (numSteps >= params.numSteps)
             {
                 // linearWalk has now completed either successfully (foundFit=true) or not
@@ -1140,6 +1171,12 @@ int LinearFocusAlgorithm::setupSecondPass(int position, double value, double mar
     return requestedPosition;
 }
 
+bool LinearFocusAlgorithm::isPredictive() const
+{
+    return params.focusAlgorithm == Focus::FOCUS_LINEAR1PASS && params.predictedPosition >= 0 &&
+           (params.focusWalk == Focus::FOCUS_WALK_FIXED_STEPS || params.focusWalk == Focus::FOCUS_WALK_CFZ_SHUFFLE);
+}
+
 // Called by L1P to finish off the first pass by setting state variables
 int LinearFocusAlgorithm::finishFirstPass(int position, double value)
 {
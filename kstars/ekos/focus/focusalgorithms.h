@@ -80,6 +80,10 @@ class FocusAlgorithmInterface
             CurveFitting::OptimisationDirection optimisationDirection;
             // How to assign weights to focus measurements
             Mathematics::RobustStatistics::ScaleCalculation scaleCalculation;
+            // L1P fixed and CFZ walks: position of best focus predicted from earlier runs, -1 if none
+            int predictedPosition = -1;
+            // L1P fixed and CFZ walks: end the walk early once the curve fit reaches this R2, 0 to walk to the end
+            double earlyStopR2 = 0;
 
             FocusParams(CurveFitting *_curveFitting, int _maxTravel, int _initialStepSize, int _startPosition,
                         int _minPositionAllowed, int _maxPositionAllowed, int _maxIterations,
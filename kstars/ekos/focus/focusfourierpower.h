@@ -15,7 +15,6 @@
 #include "curvefit.h"
 #include "../ekos.h"
 #include <ekos_focus_debug.h>
-#include <gsl/gsl_fft_complex.h>
 
 namespace Ekos
 {
@@ -43,10 +42,9 @@ namespace Ekos
 // fitsviewer will have procvessed the image prior to this routine being called so background
 // information is available here.
 //
-// So we need to perform a 2D FFT on the image. GSL only performs basic 1D FFTs so this
-// routine performs a FFT on each row and then uses the results to perform a FFT on each
-// column. An optimisation would be to use a more sophisticated FFT routine. FFTW3 could,
-// for example, be used.
+// The measure is the total power of the 2D FFT of the image. By Parseval's theorem this equals
+// the mean of the squared pixel values, so it is computed from the pixels in a single pass
+// without transforming the image at all.
 //
 // Currently just the first channel (if there is more than 1) is used by this routine. It would
 // be possible to use all channels or offer the user a choice of which channel(s) to use. If
@@ -111,148 +109,64 @@ class FocusFourierPower
                 height = width;
             }
 
-            // Allocate memory for the Fourier Transform
-            unsigned long N = width * height;
-            double *image = new(std::nothrow) double[2 * N];
-            if (!image)
-            {
-                qCDebug(KSTARS_EKOS_FOCUS) << QString("%1 Unable to allocate memory to perform Fourier Transforms").arg(__FUNCTION__);
-                return;
-            }
-
-            /* Allocate memory for GSL complex wavetables, and workspace */
-            gsl_fft_complex_wavetable *rowWT = gsl_fft_complex_wavetable_alloc(width);
-            gsl_fft_complex_workspace *rowWS = gsl_fft_complex_workspace_alloc(width);
-            gsl_fft_complex_wavetable *colWT = gsl_fft_complex_wavetable_alloc(height);
-            gsl_fft_complex_workspace *colWS = gsl_fft_complex_workspace_alloc(height);
-            if (!rowWT || !rowWS || !colWT || !colWS)
-            {
-                qCDebug(KSTARS_EKOS_FOCUS) << QString("%1 Unable to allocate memory2 to perform Fourier Transforms").arg(__FUNCTION__);
-                delete[] image;
-                return;
-            }
-
-            // Set the gsl error handler off as it aborts the program on error.
-            auto const oldErrorHandler = gsl_set_error_handler_off();
-
-            // Convert the image to complex double datatype as required by GSL FFT
+            // The image values are the real part of the transform input, the imaginary part being zero.
             // The real part is just the background subtracted pixel value clipped to zero
-            // The imaginary part is zero.
             auto skyBackground = imageData->getSkyBackground();
             auto bg = skyBackground.mean + 3.0 * skyBackground.sigma;
+            auto squared = [bg](double pixel)
+            {
+                const double v = std::max(0.0, pixel - bg);
+                return v * v;
+            };
 
-            // Load the "image" buffer from the passed in image data. As the loop is quite large I've created 3 loops
+            // Sum the squared image values. As the loop is quite large I've created 3 loops
             // each with minimal work inside. This makes the overall code larger but avoids repeated tests within the loop
+            const unsigned long N = static_cast<unsigned long>(width) * height;
+            if (N == 0)
+                return;
+            double power = 0.0;
             if (tile < 0)
             {
-                // Setup image for whole sensor
+                // Whole sensor
                 if (mask.isNull() || mask->active() == false)
                 {
                     // No active mask
                     for (unsigned long i = 0; i < N; i++)
-                    {
-                        image[i * 2] = std::max(0.0, (double) imageBuffer[i] - bg);
-                        image[i * 2 + 1] = 0.0;
-                    }
+                        power += squared(imageBuffer[i]);
                 }
                 else
                 {
                     // There is an active mask on the sensor so honour these settings
-                    unsigned int posX = 0, posY = 0;
-                    for (unsigned long i = 0; i < N; i++)
-                    {
-                        if (mask->isVisible(posX, posY))
-                            image[i * 2] = std::max(0.0, (double) imageBuffer[i] - bg);
-                        else
-                            image[i * 2] = 0.0;
-
-                        image[i * 2 + 1] = 0.0;
-
-                        if (++posX == stats.width)
-                        {
-                            posX = 0;
-                            posY++;
-                        }
-                    }
+                    unsigned long i = 0;
+                    for (unsigned int posY = 0; posY < height; posY++)
+                        for (unsigned int posX = 0; posX < width; posX++, i++)
+                            if (mask->isVisible(posX, posY))
+                                power += squared(imageBuffer[i]);
                 }
             }
             else
             {
                 // A mosaic tile has been specified so we know we are dealing with a mosaic mask
-                unsigned int posX = mosaicMask->tiles()[tile].topLeft().x();
-                unsigned int posY = mosaicMask->tiles()[tile].topLeft().y();
-
-                unsigned long offset = posY * stats.width + posX;
-                const unsigned int widthLimit = posX + width;
-
-                // Perform calc for a specific tile of a mosaic mask
-                for (unsigned long i = 0; i < N; i++)
+                const unsigned int posX = mosaicMask->tiles()[tile].topLeft().x();
+                const unsigned int posY = mosaicMask->tiles()[tile].topLeft().y();
+                for (unsigned int y = 0; y < height; y++)
                 {
-                    image[i * 2] = std::max(0.0, (double) imageBuffer[offset + i] - bg);
-                    image[i * 2 + 1] = 0.0;
-
-                    if (++posX == widthLimit)
-                    {
-                        posX = mosaicMask->tiles()[tile].topLeft().x();
-                        offset += stats.width - width;
-                    }
+                    const auto row = &imageBuffer[static_cast<unsigned long>(posY + y) * stats.width + posX];
+                    for (unsigned int x = 0; x < width; x++)
+                        power += squared(row[x]);
                 }
             }
 
-            // Perform FFT on all the rows
-            int status = 0;
-            for (unsigned int j = 0; j < height; j++)
-            {
-                status = gsl_fft_complex_forward(&image[j * 2 * width], 1, width, rowWT, rowWS);
-                if (status != 0)
-                {
-                    qCDebug(KSTARS_EKOS_FOCUS) << QString("Error %1 [%2] calculating FFT on row %3").arg(status).arg(gsl_strerror(status)).
-                                               arg(j);
-                    break;
-                }
-            }
+            // By Parseval's theorem the power of the 2D FFT, sum(|F(u,v)|^2) / N^2, is sum(f(x,y)^2) / N
+            power /= N;
 
-            if (status == 0)
-            {
-                // Perform FFT on all the cols
-                for (unsigned int i = 0; i < width; i++)
-                {
-                    status = gsl_fft_complex_forward(&image[2 * i], width, height, colWT, colWS);
-                    if (status != 0)
-                    {
-                        qCDebug(KSTARS_EKOS_FOCUS) << QString("Error %1 [%2] calculating FFT on col %3").arg(status).arg(gsl_strerror(status)).arg(
-                                                       i);
-                        break;
-                    }
-                }
-            }
-
-            if (status == 0)
-            {
-                double power = 0.0;
-                for (unsigned long i = 0; i < N; i++)
-                    power += pow(image[i * 2], 2.0) + pow(image[i * 2 + 1], 2.0);
-
-                power /= pow(N, 2.0);
-
-                if (tile < 0)
-                    qCDebug(KSTARS_EKOS_FOCUS) << QString("FFT power sensor %1x%2 = %3").arg(stats.width).arg(stats.height).arg(power);
-                else
-                    qCDebug(KSTARS_EKOS_FOCUS) << QString("FFT power tile %1 %2x%3 = %4").arg(tile).arg(stats.width).arg(stats.height).arg(
-                                                   power);
-
-                *fourierPower = power;
-            }
-
-            // free memory
-            delete[] image;
-            gsl_fft_complex_wavetable_free(rowWT);
-            gsl_fft_complex_workspace_free(rowWS);
-            gsl_fft_complex_wavetable_free(colWT);
-            gsl_fft_complex_workspace_free(colWS);
+            if (tile < 0)
+                qCDebug(KSTARS_EKOS_FOCUS) << QString("FFT power sensor %1x%2 = %3").arg(stats.width).arg(stats.height).arg(power);
+            else
+                qCDebug(KSTARS_EKOS_FOCUS) << QString("FFT power tile %1 %2x%3 = %4").arg(tile).arg(stats.width).arg(stats.height).arg(
+                                               power);
 
-            // Restore old GSL error handler
-            gsl_set_error_handler(oldErrorHandler);
+            *fourierPower = power;
         }
 
         static double constexpr INVALID_STAR_MEASURE = -1.0;
@@ -1,4 +1,6 @@
 #include "focusfwhm.h"
+
+#include <algorithm>
 #include <ekos_focus_debug.h>
 
 namespace Ekos
@@ -13,6 +15,36 @@ FocusFWHM::~FocusFWHM()
 {
 }
 
+void FocusFWHM::calculateFWHM(const std::vector<double> &FWHMs, const std::vector<double> &R2s, const int processed,
+                              double *FWHM, double *weight)
+{
+    if (FWHMs.size() == 0)
+    {
+        *FWHM = INVALID_STAR_MEASURE;
+        *weight = 0.0;
+        return;
+    }
+
+    // There are many ways to compute a robust location. Using data on the simulator there wasn't much to choose
+    // between the Location measures available in RobustStatistics, so will use basic 2 Sigma Clipping
+    double FWHM_sc = Mathematics::RobustStatistics::ComputeLocation(Mathematics::RobustStatistics::LOCATION_SIGMACLIPPING,
+                     FWHMs, 2.0);
+    double R2_median = Mathematics::RobustStatistics::ComputeLocation(Mathematics::RobustStatistics::LOCATION_MEDIAN,
+                       R2s, 2.0);
+    double FWHMweight = Mathematics::RobustStatistics::ComputeWeight(m_ScaleCalc, FWHMs);
+
+    qCDebug(KSTARS_EKOS_FOCUS) << "Processed Stars=" << processed
+                               << " Solved=" << FWHMs.size()
+                               << " R2 min/max/median=" << *std::min_element(R2s.begin(), R2s.end())
+                               << "/" << *std::max_element(R2s.begin(), R2s.end())
+                               << "/" << R2_median
+                               << " FWHM=" << FWHM_sc
+                               << " Weight=" << FWHMweight;
+
+    *FWHM = FWHM_sc;
+    *weight = FWHMweight;
+}
+
 // Returns true if two rectangular boxes (b1, b2) overlap.
 bool FocusFWHM::boxOverlap(const QPair<int, int> b1Start, const QPair<int, int> b1End, const QPair<int, int> b2Start,
                            const QPair<int, int> b2End)
@@ -7,9 +7,11 @@
 #pragma once
 
 #include <QList>
+#include <gsl/gsl_errno.h>
 #include "../fitsviewer/fitsstardetector.h"
 #include "fitsviewer/fitsview.h"
 #include "fitsviewer/fitsdata.h"
+#include "auxiliary/processinglanes.h"
 #include "curvefit.h"
 #include "../ekos.h"
 #include <ekos_focus_debug.h>
@@ -29,12 +31,20 @@ class FocusFWHM
 
         template <typename T>
         void processFWHM(const T &imageBuffer, const QList<Edge *> &focusStars, const QSharedPointer<FITSData> &imageData,
-                         std::unique_ptr<CurveFitting> &starFitting,
                          double *FWHM, double *weight)
         {
-            CurveFitting::StarParams starParams, starParams2;
-            std::vector<double> FWHMs, R2s;
+            QVector<double> FWHMs, weights;
+            processFWHM(imageBuffer, focusStars, imageData, QVector<int>(focusStars.size(), 0), 1, &FWHMs, &weights);
+            *FWHM = FWHMs[0];
+            *weight = weights[0];
+        }
 
+        // Fit all the stars of the image in a single pass and summarise their FWHMs per group, e.g. per mosaic tile.
+        // groups holds the group of each of focusStars, or -1 to ignore the star. FWHMs and weights are resized to numGroups.
+        template <typename T>
+        void processFWHM(const T &imageBuffer, const QList<Edge *> &focusStars, const QSharedPointer<FITSData> &imageData,
+                         const QVector<int> &groups, const int numGroups, QVector<double> *FWHMs, QVector<double> *weights)
+        {
             auto skyBackground = imageData->getSkyBackground();
             auto stats = imageData->getStatistics();
 
@@ -46,8 +56,8 @@ class FocusFWHM
             {
                 int starSize = focusStars[s]->numPixels;
 
-                // If the star size is invalid then ignore this star
-                if (starSize <= 0)
+                // If the star size is invalid, or the star is not requested, then ignore this star
+                if (starSize <= 0 || groups[s] < 0 || groups[s] >= numGroups)
                     continue;
 
                 // factor scales a box around the star to use in fitting the Gaussian
@@ -92,78 +102,102 @@ class FocusFWHM
                 }
             }
 
-            // We have the list of stars to process now so iterate through the list fitting a curve, etc
+            // We have the list of stars to process now so fit a curve to each of them. The fits are independent, so
+            // split the valid stars in batches over the focus lane, each with its own solver.
+            QVector<int> validStars;
             for (int s = 0; s < stars.size(); s++)
             {
-                if (!stars[s].isValid)
-                    continue;
+                if (stars[s].isValid)
+                    validStars.push_back(s);
+            }
+
+            QVector<double> starFWHMs(stars.size(), INVALID_STAR_MEASURE);
+            QVector<double> starR2s(stars.size(), 0.0);
+            const int batches = qMax(1, qMin(validStars.size(), ProcessingLanes::pool(ProcessingLanes::FOCUS)->maxThreadCount()));
+            const int starsPerBatch = (validStars.size() + batches - 1) / batches;
+
+            // The solver saves and restores the GSL error handler around each fit. Turn it off for the whole batch
+            // so that concurrent fits cannot restore each other's handler.
+            auto const oldErrorHandler = gsl_set_error_handler_off();
 
-                starParams.background = skyBackground.mean;
-                starParams.peak = focusStars[stars[s].star]->val;
-                starParams.centroid_x = focusStars[stars[s].star]->x - stars[s].start.first;
-                starParams.centroid_y = focusStars[stars[s].star]->y - stars[s].start.second;
-                starParams.HFR = focusStars[stars[s].star]->HFR;
-                starParams.theta = 0.0;
-                starParams.FWHMx = -1;
-                starParams.FWHMy = -1;
-                starParams.FWHM = -1;
-
-                starFitting->fitCurve3D(imageBuffer, stats.width, stars[s].start, stars[s].end, starParams, CurveFitting::FOCUS_GAUSSIAN,
-                                        false);
-                if (starFitting->getStarParams(CurveFitting::FOCUS_GAUSSIAN, &starParams2))
+            QList<QFuture<void>> futures;
+            for (int first = 0; first < validStars.size(); first += starsPerBatch)
+            {
+                const int last = qMin(validStars.size(), first + starsPerBatch);
+                futures.append(ProcessingLanes::run(ProcessingLanes::FOCUS, [ =, &imageBuffer, &focusStars, &stars, &validStars, &starFWHMs, &starR2s]()
                 {
-                    starParams2.centroid_x += stars[s].start.first;
-                    starParams2.centroid_y += stars[s].start.second;
-                    double R2 = starFitting->calculateR2(CurveFitting::FOCUS_GAUSSIAN);
-                    if (R2 >= 0.25)
+                    CurveFitting starFitting;
+                    CurveFitting::StarParams starParams, starParams2;
+
+                    for (int i = first; i < last; i++)
                     {
-                        // Filter stars - 0.25 works OK on Sim
-                        FWHMs.push_back(starParams2.FWHM);
-                        R2s.push_back(R2);
-
-                        qCDebug(KSTARS_EKOS_FOCUS) << "Star" << s << " R2=" << R2
-                                                   << " x=" << focusStars[s]->x << " vs " << starParams2.centroid_x
-                                                   << " y=" << focusStars[s]->y << " vs " << starParams2.centroid_y
-                                                   << " HFR=" << focusStars[s]->HFR << " FWHM=" << starParams2.FWHM
+                        const int s = validStars[i];
+                        const Edge *focusStar = focusStars[stars[s].star];
+
+                        starParams.background = skyBackground.mean;
+                        starParams.peak = focusStar->val;
+                        starParams.centroid_x = focusStar->x - stars[s].start.first;
+                        starParams.centroid_y = focusStar->y - stars[s].start.second;
+                        starParams.HFR = focusStar->HFR;
+                        starParams.theta = 0.0;
+                        starParams.FWHMx = -1;
+                        starParams.FWHMy = -1;
+                        starParams.FWHM = -1;
+
+                        starFitting.fitCurve3D(imageBuffer, stats.width, stars[s].start, stars[s].end, starParams,
+                                               CurveFitting::FOCUS_GAUSSIAN, false);
+                        if (!starFitting.getStarParams(CurveFitting::FOCUS_GAUSSIAN, &starParams2))
+                            continue;
+
+                        starParams2.centroid_x += stars[s].start.first;
+                        starParams2.centroid_y += stars[s].start.second;
+                        starR2s[s] = starFitting.calculateR2(CurveFitting::FOCUS_GAUSSIAN);
+                        starFWHMs[s] = starParams2.FWHM;
+
+                        qCDebug(KSTARS_EKOS_FOCUS) << "Star" << s << " R2=" << starR2s[s]
+                                                   << " x=" << focusStar->x << " vs " << starParams2.centroid_x
+                                                   << " y=" << focusStar->y << " vs " << starParams2.centroid_y
+                                                   << " HFR=" << focusStar->HFR << " FWHM=" << starParams2.FWHM
                                                    << " Background=" << skyBackground.mean << " vs " << starParams2.background
-                                                   << " Peak=" << focusStars[s]->val << "vs" << starParams2.peak;
+                                                   << " Peak=" << focusStar->val << "vs" << starParams2.peak;
                     }
-                }
+                }));
             }
 
-            if (FWHMs.size() == 0)
-            {
-                *FWHM = INVALID_STAR_MEASURE;
-                *weight = 0.0;
-            }
-            else
+            for (auto &future : futures)
+                future.waitForFinished();
+
+            gsl_set_error_handler(oldErrorHandler);
+
+            // Collect the results in star order so that the statistics do not depend on scheduling
+            QVector<std::vector<double>> groupFWHMs(numGroups), groupR2s(numGroups);
+            QVector<int> groupStars(numGroups, 0);
+            for (const int s : validStars)
             {
-                // There are many ways to compute a robust location. Using data on the simulator there wasn't much to choose
-                // between the Location measures available in RobustStatistics, so will use basic 2 Sigma Clipping
-                double FWHM_sc = Mathematics::RobustStatistics::ComputeLocation(Mathematics::RobustStatistics::LOCATION_SIGMACLIPPING,
-                                 FWHMs, 2.0);
-                double R2_median = Mathematics::RobustStatistics::ComputeLocation(Mathematics::RobustStatistics::LOCATION_MEDIAN,
-                                   R2s, 2.0);
-                double FWHMweight = Mathematics::RobustStatistics::ComputeWeight(m_ScaleCalc, FWHMs);
-
-                qCDebug(KSTARS_EKOS_FOCUS) << "Original Stars=" << focusStars.size()
-                                           << " Processed=" << stars.size()
-                                           << " Solved=" << FWHMs.size()
-                                           << " R2 min/max/median=" << *std::min_element(R2s.begin(), R2s.end())
-                                           << "/" << *std::max_element(R2s.begin(), R2s.end())
-                                           << "/" << R2_median
-                                           << " FWHM=" << FWHM_sc
-                                           << " Weight=" << FWHMweight;
-
-                *FWHM = FWHM_sc;
-                *weight = FWHMweight;
+                const int group = groups[stars[s].star];
+                groupStars[group]++;
+                // Filter stars - 0.25 works OK on Sim
+                if (starFWHMs[s] != INVALID_STAR_MEASURE && starR2s[s] >= 0.25)
+                {
+                    groupFWHMs[group].push_back(starFWHMs[s]);
+                    groupR2s[group].push_back(starR2s[s]);
+                }
             }
+
+            FWHMs->fill(INVALID_STAR_MEASURE, numGroups);
+            weights->fill(0.0, numGroups);
+            for (int group = 0; group < numGroups; group++)
+                calculateFWHM(groupFWHMs[group], groupR2s[group], groupStars[group], &(*FWHMs)[group], &(*weights)[group]);
         }
 
         static double constexpr INVALID_STAR_MEASURE = -1.0;
 
     private:
 
+        // Robust location and weight of the FWHMs of the solved stars. processed is the number of stars fitted.
+        void calculateFWHM(const std::vector<double> &FWHMs, const std::vector<double> &R2s, const int processed,
+                           double *FWHM, double *weight);
+
         bool boxOverlap(const QPair<int, int> b1Start, const QPair<int, int> b1End, const QPair<int, int> b2Start,
                         const QPair<int, int> b2End);
 
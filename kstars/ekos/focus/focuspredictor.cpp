@@ -0,0 +1,176 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "focuspredictor.h"
+
+#include "ekos/ekos.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ekos
+{
+
+namespace
+{
+
+bool known(double value)
+{
+    return value != INVALID_VALUE;
+}
+
+// Whether the runs spread over more than minSpread of the value extracted by get, ignoring unknown values
+template <typename Get>
+bool spreads(const QVector<FocusPredictor::Run> &runs, Get get, double minSpread)
+{
+    double lo = HUGE_VAL, hi = -HUGE_VAL;
+    for (const auto &run : runs)
+    {
+        if (!known(get(run)))
+            continue;
+        lo = std::min(lo, get(run));
+        hi = std::max(hi, get(run));
+    }
+    return hi - lo >= minSpread;
+}
+
+// Solve the k x k system a x = b in place by Gaussian elimination with partial pivoting
+bool solve(double a[3][3], double b[3], int k)
+{
+    for (int col = 0; col < k; col++)
+    {
+        int pivot = col;
+        for (int row = col + 1; row < k; row++)
+            if (std::fabs(a[row][col]) > std::fabs(a[pivot][col]))
+                pivot = row;
+        if (std::fabs(a[pivot][col]) < 1e-12)
+            return false;
+        std::swap(a[col], a[pivot]);
+        std::swap(b[col], b[pivot]);
+
+        for (int row = col + 1; row < k; row++)
+        {
+            const double factor = a[row][col] / a[col][col];
+            for (int c = col; c < k; c++)
+                a[row][c] -= factor * a[col][c];
+            b[row] -= factor * b[col];
+        }
+    }
+    for (int row = k - 1; row >= 0; row--)
+    {
+        for (int c = row + 1; c < k; c++)
+            b[row] -= a[row][c] * b[c];
+        b[row] /= a[row][row];
+    }
+    return true;
+}
+
+}
+
+bool FocusPredictor::predict(double temperature, double altitude, int *position, double *uncertainty) const
+{
+    QVector<Run> runs = m_Runs.mid(0, MAX_RUNS);
+
+    // Each term is only fitted when it is known now and for enough runs, which spread enough over it
+    auto temperatureOf = [](const Run & run)
+    {
+        return run.temperature;
+    };
+    auto altitudeOf = [](const Run & run)
+    {
+        return run.altitude;
+    };
+    auto keepKnown = [](const QVector<Run> &from, double (*get)(const Run &))
+    {
+        QVector<Run> kept;
+        for (const auto &run : from)
+            if (known(get(run)))
+                kept.append(run);
+        return kept;
+    };
+
+    int k = 1;
+    bool useTemperature = false, useAltitude = false;
+    if (known(temperature) && spreads(runs, temperatureOf, MIN_TEMPERATURE_SPREAD))
+    {
+        const QVector<Run> kept = keepKnown(runs, temperatureOf);
+        if (kept.size() > MIN_RUNS)
+        {
+            runs = kept;
+            useTemperature = true;
+            k++;
+        }
+    }
+    if (known(altitude) && spreads(runs, altitudeOf, MIN_ALTITUDE_SPREAD))
+    {
+        const QVector<Run> kept = keepKnown(runs, altitudeOf);
+        if (kept.size() > std::max(MIN_RUNS, k + 1))
+        {
+            runs = kept;
+            useAltitude = true;
+            k++;
+        }
+    }
+
+    const int n = runs.size();
+    if (n < MIN_RUNS)
+        return false;
+
+    // Centre the terms so the normal equations are well conditioned
+    double meanT = 0, meanA = 0;
+    for (const auto &run : runs)
+    {
+        meanT += useTemperature ? run.temperature / n : 0;
+        meanA += useAltitude ? run.altitude / n : 0;
+    }
+    auto terms = [&](double t, double alt, double x[3])
+    {
+        int i = 0;
+        x[i++] = 1;
+        if (useTemperature)
+            x[i++] = t - meanT;
+        if (useAltitude)
+            x[i++] = alt - meanA;
+    };
+
+    double a[3][3] = {}, b[3] = {};
+    for (const auto &run : runs)
+    {
+        double x[3];
+        terms(run.temperature, run.altitude, x);
+        for (int i = 0; i < k; i++)
+        {
+            for (int j = 0; j < k; j++)
+                a[i][j] += x[i] * x[j];
+            b[i] += x[i] * run.position;
+        }
+    }
+    if (!solve(a, b, k))
+        return false;
+
+    double ssr = 0;
+    for (const auto &run : runs)
+    {
+        double x[3];
+        terms(run.temperature, run.altitude, x);
+        double fitted = 0;
+        for (int i = 0; i < k; i++)
+            fitted += b[i] * x[i];
+        ssr += (run.position - fitted) * (run.position - fitted);
+    }
+
+    double x[3];
+    terms(temperature, altitude, x);
+    double predicted = 0;
+    for (int i = 0; i < k; i++)
+        predicted += b[i] * x[i];
+
+    *position = static_cast<int>(std::round(predicted));
+    *uncertainty = (n > k ? std::sqrt(ssr / (n - k)) : 0) * std::sqrt(1.0 + 1.0 / n);
+    return true;
+}
+
+}
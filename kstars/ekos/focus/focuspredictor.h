@@ -0,0 +1,64 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QVector>
+
+namespace Ekos
+{
+
+/**
+ * @class FocusPredictor
+ * @short Predicts the position of best focus from earlier Autofocus runs with the same train and filter.
+ *
+ * The positions of the runs are fitted by least squares with a straight line in temperature and
+ * altitude, each of which is only used when the runs spread enough over it to tell its effect
+ * from noise. Otherwise the prediction is their mean. The scatter of the runs around the fit
+ * gives the uncertainty of the prediction, which the focus algorithm uses to decide how far out
+ * of the prediction it must start its walk.
+ */
+class FocusPredictor
+{
+    public:
+        struct Run
+        {
+            int position;
+            // INVALID_VALUE when not known
+            double temperature;
+            double altitude;
+        };
+
+        /** Runs needed to predict anything */
+        static constexpr int MIN_RUNS = 3;
+        /** Runs used at most, the latest ones */
+        static constexpr int MAX_RUNS = 20;
+        /** Spread of temperatures, in °C, below which temperature is not fitted */
+        static constexpr double MIN_TEMPERATURE_SPREAD = 1.0;
+        /** Spread of altitudes, in degrees, below which altitude is not fitted */
+        static constexpr double MIN_ALTITUDE_SPREAD = 10.0;
+
+        /** @brief setRuns Set the runs to predict from, most recent first */
+        void setRuns(const QVector<Run> &runs)
+        {
+            m_Runs = runs;
+        }
+
+        /**
+         * @brief predict the position of best focus
+         * @param temperature current temperature, INVALID_VALUE if not known
+         * @param altitude current altitude, INVALID_VALUE if not known
+         * @param position set to the predicted position
+         * @param uncertainty set to the standard deviation of the prediction, in ticks
+         * @return false if there are too few runs
+         */
+        bool predict(double temperature, double altitude, int *position, double *uncertainty) const;
+
+    private:
+        QVector<Run> m_Runs;
+};
+
+}
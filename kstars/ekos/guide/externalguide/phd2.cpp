@@ -22,16 +22,43 @@
 
 #include <QJsonDocument>
 #include <QNetworkReply>
+#include <QtConcurrent>
 
 #include <ekos_guide_debug.h>
 
 #define MAX_SET_CONNECTED_RETRIES   3
 
+// Events that change nothing in KStars, dropped before they are parsed
+static const QSet<QByteArray> g_ignoredEvents =
+{
+    "Calibrating", "Settling", "SettleBegin", "GuidingDithered", "GuideParamChange", "ConfigurationChange"
+};
+// Longer lines, like star images, are parsed off the GUI thread
+static const int g_parserLineSize = 4096;
+
+// The name of the event a line notifies, if any, without parsing the line
+static QByteArray eventName(const QByteArray &line)
+{
+    static const QByteArray key("\"Event\"");
+    const int from = line.indexOf(key);
+    if (from < 0)
+        return QByteArray();
+
+    const int colon = line.indexOf(':', from + key.size());
+    const int start = colon < 0 ? -1 : line.indexOf('"', colon + 1);
+    const int end = start < 0 ? -1 : line.indexOf('"', start + 1);
+    if (end < 0)
+        return QByteArray();
+
+    return line.mid(start + 1, end - start - 1);
+}
+
 namespace Ekos
 {
 PHD2::PHD2()
 {
     tcpSocket = new QTcpSocket(this);
+    m_ParsePool.setMaxThreadCount(1);
 
     //This list of available PHD Events is on https://github.com/OpenPHDGuiding/phd2/wiki/EventMonitoring
 
@@ -231,6 +258,11 @@ void PHD2::ResetConnectionState()
     isSettling = false;
     isDitherActive = false;
 
+    // Drop whatever the old connection still had to say
+    m_PendingLines.clear();
+    m_Parsing = false;
+    m_ParseGeneration++;
+
     ditherTimer->stop();
     abortTimer->stop();
 
@@ -299,26 +331,91 @@ void PHD2::readPHD2()
         if (line.isEmpty())
             continue;
 
-        QJsonParseError qjsonError;
-
-        QJsonDocument jdoc = QJsonDocument::fromJson(line, &qjsonError);
-
-        if (qjsonError.error != QJsonParseError::NoError)
+        if (g_ignoredEvents.contains(eventName(line)))
         {
-            emit newLog(i18n("PHD2: invalid response received: %1", QString(line)));
-            emit newLog(i18n("PHD2: JSON error: %1", qjsonError.errorString()));
+            if (Options::verboseLogging())
+                qCDebug(KSTARS_EKOS_GUIDE) << "PHD2: event:" << line;
             continue;
         }
 
-        QJsonObject jsonObj = jdoc.object();
+        // Lines keep their order, once one waits for the parser thread those after it wait too
+        if (m_Parsing || !m_PendingLines.isEmpty() || line.size() > g_parserLineSize)
+            m_PendingLines.enqueue(line);
+        else
+            dispatchLine(parseLine(line));
+    }
 
-        if (jsonObj.contains("Event"))
-            processPHD2Event(jsonObj, line);
-        else if (jsonObj.contains("error"))
-            processPHD2Error(jsonObj, line);
-        else if (jsonObj.contains("result"))
-            processPHD2Result(jsonObj, line);
+    parsePendingLines();
+}
+
+PHD2::ParsedLine PHD2::parseLine(const QByteArray &line)
+{
+    ParsedLine parsed;
+    parsed.line = line;
+
+    QJsonParseError qjsonError;
+    QJsonDocument jdoc = QJsonDocument::fromJson(line, &qjsonError);
+    if (qjsonError.error != QJsonParseError::NoError)
+        parsed.error = qjsonError.errorString();
+    else
+        parsed.object = jdoc.object();
+
+    return parsed;
+}
+
+void PHD2::dispatchLine(const ParsedLine &parsed)
+{
+    if (!parsed.error.isEmpty())
+    {
+        emit newLog(i18n("PHD2: invalid response received: %1", QString(parsed.line)));
+        emit newLog(i18n("PHD2: JSON error: %1", parsed.error));
+        return;
     }
+
+    const QJsonObject &jsonObj = parsed.object;
+
+    if (jsonObj.contains("Event"))
+        processPHD2Event(jsonObj, parsed.line);
+    else if (jsonObj.contains("error"))
+        processPHD2Error(jsonObj, parsed.line);
+    else if (jsonObj.contains("result"))
+        processPHD2Result(jsonObj, parsed.line);
+}
+
+void PHD2::parsePendingLines()
+{
+    if (m_Parsing || m_PendingLines.isEmpty())
+        return;
+
+    m_Parsing = true;
+    const QList<QByteArray> lines = m_PendingLines;
+    m_PendingLines.clear();
+    const uint32_t generation = m_ParseGeneration;
+
+    QtConcurrent::run(&m_ParsePool, [this, lines, generation]()
+    {
+        QVector<ParsedLine> parsedLines;
+        parsedLines.reserve(lines.size());
+        for (const auto &line : lines)
+            parsedLines.append(parseLine(line));
+
+        QMetaObject::invokeMethod(this, [this, parsedLines, generation]()
+        {
+            if (generation != m_ParseGeneration)
+                return;
+
+            m_Parsing = false;
+            for (const auto &parsed : parsedLines)
+            {
+                dispatchLine(parsed);
+                // The connection was reset while handling the line
+                if (generation != m_ParseGeneration)
+                    return;
+            }
+
+            parsePendingLines();
+        }, Qt::QueuedConnection);
+    });
 }
 
 void PHD2::processPHD2Event(const QJsonObject &jsonEvent, const QByteArray &line)
@@ -12,6 +12,8 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QPointer>
+#include <QQueue>
+#include <QThreadPool>
 #include <QTimer>
 
 class FITSView;
@@ -233,6 +235,18 @@ class PHD2 : public GuideInterface
         void sendRpcCall(QJsonObject &call, PHD2ResultType resultType);
         void sendNextRpcCall();
 
+        // A line received from PHD2, parsed
+        struct ParsedLine
+        {
+            QByteArray line;
+            QJsonObject object;
+            QString error;
+        };
+        static ParsedLine parseLine(const QByteArray &line);
+        void dispatchLine(const ParsedLine &parsed);
+        // Parse the pending lines on the parser thread, then dispatch them in order
+        void parsePendingLines();
+
         void processPHD2Event(const QJsonObject &jsonEvent, const QByteArray &rawResult);
         void processPHD2Result(const QJsonObject &jsonObj, const QByteArray &rawResult);
         void processStarImage(const QJsonObject &jsonStarFrame);
@@ -292,6 +306,13 @@ class PHD2 : public GuideInterface
         // Try to connect this many times before giving up.
         static const uint8_t PHD2_RECONNECT_THRESHOLD {10};
 
+        // Lines waiting for the parser thread, bumping the generation drops those in flight
+        QQueue<QByteArray> m_PendingLines;
+        bool m_Parsing { false };
+        uint32_t m_ParseGeneration { 0 };
+        // Last, so that it is destroyed first and waits for the parser before anything else goes
+        QThreadPool m_ParsePool;
+
 };
 
 }
@@ -41,6 +41,7 @@
 
 #include "ui_manualdither.h"
 
+#include <algorithm>
 #include <random>
 
 #define CAPTURE_TIMEOUT_THRESHOLD 30000
@@ -786,6 +787,10 @@ bool Guide::captureOneFrame()
     // Timeout is exposure duration + timeout threshold in seconds
     captureTimeout.start(finalExposure * 1000 + CAPTURE_TIMEOUT_THRESHOLD);
 
+    // The exposure end is estimated, so command latency to the camera shows up in the download time.
+    m_GuideLatency.startCycle();
+    m_GuideLatency.mark(GuideLatency::EXPOSURE_END, GuideLatency::timestamp() + static_cast<qint64>(finalExposure * 1e6));
+
     targetChip->capture(finalExposure);
 
     return true;
@@ -832,6 +837,12 @@ bool Guide::abort()
 
     setBusy(false);
 
+    if (m_GuideLatency.cycles() > 0)
+    {
+        appendLogText(m_GuideLatency.summary());
+        m_GuideLatency.clear();
+    }
+
     switch (m_State)
     {
         case GUIDE_IDLE:
@@ -1014,6 +1025,8 @@ void Guide::processData(const QSharedPointer<FITSData> &data)
 
     if (data)
     {
+        m_GuideLatency.mark(GuideLatency::BLOB_RECEIVED, data->property("blobReceivedTime").toLongLong());
+        m_GuideLatency.mark(GuideLatency::FITS_LOADED, data->property("loadedTime").toLongLong());
         m_GuideView->loadData(data);
         m_ImageData = data;
     }
@@ -1100,10 +1113,17 @@ void Guide::setCaptureComplete()
 
         case GUIDE_CALIBRATING:
             m_GuiderInstance->calibrate();
+            // The calibration moves the star away from the lock position, the subframe follows it.
+            if (m_State == GUIDE_CALIBRATING)
+                recenterSubframe();
             break;
 
         case GUIDE_GUIDING:
+            m_GuideLatency.mark(GuideLatency::DARK_SUBTRACTED);
             m_GuiderInstance->guide();
+            // The next exposure starts after the guide pulses, so the subframe can still be moved for it.
+            if (m_State == GUIDE_GUIDING)
+                recenterSubframe();
             break;
 
         case GUIDE_DITHERING:
@@ -1181,7 +1201,14 @@ bool Guide::sendMultiPulse(GuideDirection ra_dir, int ra_msecs, GuideDirection d
 
         m_PulseTimer.start(delay);
     }
-    return m_Guider->doPulse(ra_dir, ra_msecs, dec_dir, dec_msecs);
+
+    QElapsedTimer dispatchTimer;
+    dispatchTimer.start();
+    const bool result = m_Guider->doPulse(ra_dir, ra_msecs, dec_dir, dec_msecs);
+    logPulseDispatch(dispatchTimer.nsecsElapsed());
+    if (followWithCapture == StartCaptureAfterPulses)
+        m_GuideLatency.mark(GuideLatency::PULSE_ISSUED);
+    return result;
 }
 
 bool Guide::sendSinglePulse(GuideDirection dir, int msecs, CaptureAfterPulses followWithCapture)
@@ -1199,7 +1226,35 @@ bool Guide::sendSinglePulse(GuideDirection dir, int msecs, CaptureAfterPulses fo
         m_PulseTimer.start(delay);
     }
 
-    return m_Guider->doPulse(dir, msecs);
+    QElapsedTimer dispatchTimer;
+    dispatchTimer.start();
+    const bool result = m_Guider->doPulse(dir, msecs);
+    logPulseDispatch(dispatchTimer.nsecsElapsed());
+    if (followWithCapture == StartCaptureAfterPulses)
+        m_GuideLatency.mark(GuideLatency::PULSE_ISSUED);
+    return result;
+}
+
+void Guide::logPulseDispatch(qint64 nsecs)
+{
+    // Pulses are sent to the INDI server synchronously from the frame processing, so this is the time
+    // spent writing them to the server connection. It should stay well below a millisecond.
+    const double msecs = nsecs / 1e6;
+    if (msecs > PULSE_DISPATCH_WARNING_MS)
+        qCWarning(KSTARS_EKOS_GUIDE) << "Guide pulse dispatch took" << msecs << "ms";
+    else
+        qCDebug(KSTARS_EKOS_GUIDE) << "Guide pulse dispatched in" << msecs << "ms";
+}
+
+void Guide::completeLatencyCycle()
+{
+    if (internalGuider->processedTime() > 0)
+        m_GuideLatency.mark(GuideLatency::STAR_DETECTED, internalGuider->processedTime());
+
+    GuideLatency::Intervals intervals;
+    if (m_GuideLatency.completeCycle(&intervals))
+        emit guideLatency(intervals[GuideLatency::DOWNLOAD], intervals[GuideLatency::LOAD], intervals[GuideLatency::DARK],
+                          intervals[GuideLatency::DETECTION], intervals[GuideLatency::PULSE], intervals[GuideLatency::TOTAL]);
 }
 
 bool Guide::calibrate()
@@ -1250,6 +1305,8 @@ bool Guide::calibrate()
 
 bool Guide::guide()
 {
+    m_GuideLatency.clear();
+
     auto executeGuide = [this]()
     {
         if(guiderType != GUIDE_PHD2)
@@ -1810,6 +1867,60 @@ void Guide::syncTrackingBoxPosition()
     }
 }
 
+void Guide::recenterSubframe()
+{
+    if (!m_Camera || guiderType != GUIDE_INTERNAL || subFramed == false || internalGuider->SEPMultiStarEnabled())
+        return;
+
+    ISD::CameraChip *targetChip = m_Camera->getChip(useGuideHead ? ISD::CameraChip::GUIDE_CCD : ISD::CameraChip::PRIMARY_CCD);
+    if (targetChip == nullptr || frameSettings.contains(targetChip) == false)
+        return;
+
+    QVariantMap settings = frameSettings[targetChip];
+    const int subBinX = std::max(1, settings["binx"].toInt());
+    const int subBinY = std::max(1, settings["biny"].toInt());
+    // Frame in binned pixels
+    const int x = settings["x"].toInt() / subBinX;
+    const int y = settings["y"].toInt() / subBinY;
+    const int w = settings["w"].toInt() / subBinX;
+    const int h = settings["h"].toInt() / subBinY;
+
+    // The subframe is four tracking boxes wide, so this leaves the lock position up to a box from the center.
+    // While calibrating, the star is followed instead.
+    const double marginX = guideSquareSize->currentText().toDouble() / subBinX;
+    const double marginY = guideSquareSize->currentText().toDouble() / subBinY;
+    double lockX, lockY;
+    if (m_State == GUIDE_CALIBRATING)
+        internalGuider->getStarPosition(&lockX, &lockY);
+    else
+        internalGuider->getTargetPosition(&lockX, &lockY);
+    if (lockX >= marginX && lockX <= w - marginX && lockY >= marginY && lockY <= h - marginY)
+        return;
+
+    int minX, maxX, minY, maxY, minW, maxW, minH, maxH;
+    targetChip->getFrameMinMax(&minX, &maxX, &minY, &maxY, &minW, &maxW, &minH, &maxH);
+
+    const int newX = std::max(minX / subBinX, std::min(maxW / subBinX - w, x + qRound(lockX - w / 2.0)));
+    const int newY = std::max(minY / subBinY, std::min(maxH / subBinY - h, y + qRound(lockY - h / 2.0)));
+    const int dx = newX - x, dy = newY - y;
+    if (dx == 0 && dy == 0)
+        return;
+
+    qCDebug(KSTARS_EKOS_GUIDE) << "Recentering guide subframe on lock position" << lockX << lockY << "by" << dx << dy;
+
+    settings["x"] = newX * subBinX;
+    settings["y"] = newY * subBinY;
+    frameSettings[targetChip] = settings;
+    m_GuiderInstance->setFrameParams(settings["x"].toInt(), settings["y"].toInt(), settings["w"].toInt(), settings["h"].toInt(),
+                                     subBinX, subBinY);
+
+    // Star and lock positions are relative to the frame origin.
+    internalGuider->shiftFrameOrigin(dx, dy);
+    starCenter.setX(starCenter.x() - dx);
+    starCenter.setY(starCenter.y() - dy);
+    syncTrackingBoxPosition();
+}
+
 bool Guide::setGuiderType(int type)
 {
     // Use default guider option
@@ -2106,6 +2217,9 @@ void Guide::setAxisDelta(double ra, double de)
 
     ra = -ra;  //The ra is backwards in sign from how it should be displayed on the graph.
 
+    if (guiderType == GUIDE_INTERNAL && m_State == GUIDE_GUIDING)
+        completeLatencyCycle();
+
     int currentNumPoints = driftGraph->graph(GuideGraph::G_RA)->dataCount();
     guideSlider->setMaximum(currentNumPoints);
     if(graphOnLatestPt)
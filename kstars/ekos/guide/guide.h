@@ -8,6 +8,7 @@
 
 #include "ui_guide.h"
 #include "guideinterface.h"
+#include "guidelatency.h"
 #include "ekos/ekos.h"
 #include "indi/indicamera.h"
 #include "indi/indimount.h"
@@ -451,6 +452,9 @@ class Guide : public QWidget, public Ui::Guide
         void guideStats(double raError, double decError, int raPulse, int decPulse,
                         double snr, double skyBg, int numStars);
 
+        // Milliseconds spent in each stage of a guide cycle, see GuideLatency::Interval. NaN for skipped stages.
+        void guideLatency(double download, double load, double dark, double detection, double pulse, double total);
+
         void guideChipUpdated(ISD::CameraChip *);
         void settingsUpdated(const QVariantMap &settings);
         void driverTimedout(const QString &deviceName);
@@ -474,6 +478,23 @@ class Guide : public QWidget, public Ui::Guide
              */
         void syncTrackingBoxPosition();   
 
+        /**
+         * @brief recenterSubframe Move the guide subframe back over the lock position once the lock position,
+         * e.g. after a few dithers, gets within a tracking box of the subframe edge.
+         */
+        void recenterSubframe();
+
+        /**
+         * @brief logPulseDispatch Report how long sending a guide pulse to the INDI server took.
+         */
+        void logPulseDispatch(qint64 nsecs);
+
+        /**
+         * @brief completeLatencyCycle Add the stage times of the guide cycle that just issued its correction
+         * to the latency statistics, and report them to Analyze.
+         */
+        void completeLatencyCycle();
+
         /**
              * @brief setBusy Indicate busy status within the module visually
              * @param enable True if module is busy, false otherwise
@@ -597,6 +618,11 @@ class Guide : public QWidget, public Ui::Guide
 
         // Pulse Timer
         QTimer m_PulseTimer;
+        // Pulse dispatch taking longer than this is reported, since it delays the guide correction.
+        static constexpr double PULSE_DISPATCH_WARNING_MS = 50;
+
+        // Stage times of the guide loop, summarized in the log when guiding stops.
+        GuideLatency m_GuideLatency;
 
         // Log
         QStringList m_LogText;
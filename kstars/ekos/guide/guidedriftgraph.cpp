@@ -366,6 +366,7 @@ void GuideDriftGraph::clear()
     graph(GuideGraph::G_RA_RMS)->data()->clear(); //RA RMS
     graph(GuideGraph::G_DEC_RMS)->data()->clear(); //DEC RMS
     graph(GuideGraph::G_RMS)->data()->clear(); //RMS
+    snrMax = 0;
     clearItems();  //Clears dither text items from the graph
     setupNSEWLabels();
     replot();
@@ -545,7 +546,26 @@ void GuideDriftGraph::setAxisDelta(double ra, double de)
         graph(GuideGraph::G_RA_HIGHLIGHT)->addData(key, ra); //Set highlighted RA point to latest point
         graph(GuideGraph::G_DEC_HIGHLIGHT)->addData(key, de); //Set highlighted DEC point to latest point
     }
-    replot();
+    trimHistory();
+    replot(QCustomPlot::rpQueuedReplot);
+}
+
+void GuideDriftGraph::trimHistory()
+{
+    const int size = graph(GuideGraph::G_RA)->dataCount();
+    if (size <= GuideGraph::HISTORY_CAPACITY + GuideGraph::HISTORY_TRIM_CHUNK)
+        return;
+
+    // Cut all graphs at the same time so that their samples keep matching indices.
+    // The containers drop leading samples without moving the remaining ones.
+    const double cutKey = graph(GuideGraph::G_RA)->dataMainKey(size - GuideGraph::HISTORY_CAPACITY);
+    for (int i = 0; i < graphCount(); i++)
+        graph(i)->data()->removeBefore(cutKey);
+
+    snrMax = 0;
+    for (const auto &snr : *graph(GuideGraph::G_SNR)->data())
+        snrMax = std::max(snrMax, snr.value);
+    snrAxis->setRange(-1.05 * snrMax, 1.05 * snrMax);
 }
 
 void GuideDriftGraph::setAxisSigma(double ra, double de)
@@ -570,13 +590,11 @@ void GuideDriftGraph::setSNR(double snr)
     graph(GuideGraph::G_SNR)->addData(key, snr);
 
     // Sets the SNR axis to have the maximum be 95% of the way up from the middle to the top.
-    QCPGraphData snrMax = *std::min_element(graph(GuideGraph::G_SNR)->data()->begin(),
-                                            graph(GuideGraph::G_SNR)->data()->end(),
-                                            [](QCPGraphData const & s1, QCPGraphData const & s2)
+    if (snr > snrMax)
     {
-        return s1.value > s2.value;
-    });
-    snrAxis->setRange(-1.05 * snrMax.value, 1.05 * snrMax.value);
+        snrMax = snr;
+        snrAxis->setRange(-1.05 * snrMax, 1.05 * snrMax);
+    }
 }
 
 void GuideDriftGraph::updateCorrectionsScaleVisibility()
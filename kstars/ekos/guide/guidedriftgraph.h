@@ -64,6 +64,11 @@ public slots:
     void refreshColorScheme();
 
 private:
+    /**
+     * @brief trimHistory Drop the oldest samples of all graphs once the history exceeds its capacity.
+     */
+    void trimHistory();
+
     // The scales of these zoom levels are defined in Guide::zoomX().
     static constexpr int defaultXZoomLevel = 3;
     int driftGraphZoomLevel {defaultXZoomLevel};
@@ -71,6 +76,8 @@ private:
 
     // Axis for the SNR part of the driftGraph. Qt owns this pointer's memory.
     QCPAxis *snrAxis;
+    // Largest SNR in the graph, kept up to date as samples are added so the axis is rescaled in constant time.
+    double snrMax { 0 };
 
     // Guide timer
     QTime guideTimer;
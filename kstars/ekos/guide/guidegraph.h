@@ -23,4 +23,9 @@ enum DRIFT_GRAPH_INDICES
     G_DEC_RMS = 8,
     G_RMS = 9
 };
+
+// Samples kept by the drift graph and the target plot, about 14 hours of guiding at one frame per second.
+// The oldest samples are dropped in chunks of HISTORY_TRIM_CHUNK once the history is that much longer.
+constexpr int HISTORY_CAPACITY = 50000;
+constexpr int HISTORY_TRIM_CHUNK = 1000;
 }  // namespace
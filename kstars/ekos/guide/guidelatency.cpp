@@ -0,0 +1,132 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "guidelatency.h"
+
+#include "klocalizedstring.h"
+
+#include <QStringList>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+// Upper edge of the first histogram bin, in milliseconds. Each further bin is sqrt(2) times wider,
+// so the last one ends after about 20 minutes.
+constexpr double FIRST_BIN_EDGE = 0.1;
+
+int binIndex(double msecs, int binCount)
+{
+    if (msecs < FIRST_BIN_EDGE)
+        return 0;
+    const int index = static_cast<int>(std::floor(2 * std::log2(msecs / FIRST_BIN_EDGE))) + 1;
+    return std::min(index, binCount - 1);
+}
+
+double binUpperEdge(int index)
+{
+    return FIRST_BIN_EDGE * std::pow(2.0, index / 2.0);
+}
+}
+
+qint64 GuideLatency::timestamp()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void GuideLatency::startCycle()
+{
+    m_Stages.fill(0);
+}
+
+void GuideLatency::mark(Stage stage, qint64 time)
+{
+    m_Stages[stage] = time;
+}
+
+bool GuideLatency::completeCycle(Intervals *intervals)
+{
+    intervals->fill(std::numeric_limits<double>::quiet_NaN());
+
+    if (m_Stages[EXPOSURE_END] == 0)
+        return false;
+
+    qint64 last = 0;
+    for (int i = DOWNLOAD; i < TOTAL; i++)
+    {
+        if (m_Stages[i] != 0 && m_Stages[i + 1] != 0)
+            (*intervals)[i] = (m_Stages[i + 1] - m_Stages[i]) / 1000.0;
+        if (m_Stages[i + 1] != 0)
+            last = m_Stages[i + 1];
+    }
+    if (last == 0)
+        return false;
+    (*intervals)[TOTAL] = (last - m_Stages[EXPOSURE_END]) / 1000.0;
+
+    for (int i = 0; i < INTERVAL_COUNT; i++)
+    {
+        const double msecs = (*intervals)[i];
+        if (std::isnan(msecs))
+            continue;
+        m_Histograms[i][binIndex(std::max(0.0, msecs), BIN_COUNT)]++;
+        m_Samples[i]++;
+    }
+    m_Cycles++;
+
+    // Don't count this cycle again.
+    startCycle();
+    return true;
+}
+
+void GuideLatency::clear()
+{
+    for (auto &histogram : m_Histograms)
+        histogram.fill(0);
+    m_Samples.fill(0);
+    m_Cycles = 0;
+    startCycle();
+}
+
+double GuideLatency::percentile(Interval interval, double fraction) const
+{
+    const int samples = m_Samples[interval];
+    if (samples == 0)
+        return std::numeric_limits<double>::quiet_NaN();
+
+    const int target = std::max(1, static_cast<int>(std::ceil(fraction * samples)));
+    int count = 0;
+    for (int i = 0; i < BIN_COUNT; i++)
+    {
+        count += m_Histograms[interval][i];
+        if (count >= target)
+            return binUpperEdge(i);
+    }
+    return binUpperEdge(BIN_COUNT - 1);
+}
+
+QString GuideLatency::summary() const
+{
+    const QString names[INTERVAL_COUNT] =
+    {
+        i18n("download"), i18n("load"), i18n("dark"), i18n("detection"), i18n("pulse"), i18n("total")
+    };
+
+    QStringList parts;
+    for (int i = 0; i < INTERVAL_COUNT; i++)
+    {
+        if (m_Samples[i] == 0)
+            continue;
+        parts << i18nc("guide loop stage latency, median and 95th percentile in ms", "%1 %2/%3",
+                       names[i],
+                       QString::number(percentile(static_cast<Interval>(i), 0.5), 'g', 3),
+                       QString::number(percentile(static_cast<Interval>(i), 0.95), 'g', 3));
+    }
+    return i18n("Guide loop latency over %1 frames, median/95% in ms: %2", m_Cycles, parts.join(", "));
+}
@@ -0,0 +1,100 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QString>
+
+#include <array>
+
+/**
+ * @class GuideLatency
+ * @short Times the stages of each guide cycle, from the end of the exposure to the guide pulse, and keeps a
+ * histogram of every stage over the guiding session.
+ *
+ * Stage times are microseconds of the monotonic clock returned by timestamp(). ISD::Camera stamps each image
+ * with the same clock when its BLOB arrives and when it is loaded, in the "blobReceivedTime" and "loadedTime"
+ * properties of the FITSData.
+ */
+class GuideLatency
+{
+    public:
+        enum Stage
+        {
+            EXPOSURE_END,
+            BLOB_RECEIVED,
+            FITS_LOADED,
+            DARK_SUBTRACTED,
+            STAR_DETECTED,
+            PULSE_ISSUED,
+            STAGE_COUNT
+        };
+
+        // Each interval ends at the stage of the same index + 1, except TOTAL which spans the whole cycle.
+        enum Interval
+        {
+            DOWNLOAD,
+            LOAD,
+            DARK,
+            DETECTION,
+            PULSE,
+            TOTAL,
+            INTERVAL_COUNT
+        };
+
+        using Intervals = std::array<double, INTERVAL_COUNT>;
+
+        /**
+         * @brief timestamp Current time of the monotonic clock used for the stage times, in microseconds.
+         */
+        static qint64 timestamp();
+
+        /**
+         * @brief startCycle Forget the stage times of the previous cycle.
+         */
+        void startCycle();
+
+        /**
+         * @brief mark Record the time a stage of the current cycle was reached.
+         */
+        void mark(Stage stage, qint64 time = timestamp());
+
+        /**
+         * @brief completeCycle Add the intervals between the stages of the current cycle to the histograms.
+         * @param intervals Set to the intervals in milliseconds, NaN for those with a stage that wasn't reached.
+         * @return false if the cycle has no exposure end or nothing after it, in which case nothing is added.
+         */
+        bool completeCycle(Intervals *intervals);
+
+        /**
+         * @brief clear Empty the histograms, e.g. when a new guiding session starts.
+         */
+        void clear();
+
+        int cycles() const
+        {
+            return m_Cycles;
+        }
+
+        /**
+         * @brief percentile Upper bound, in milliseconds, of the given fraction of the interval samples.
+         * Histogram bins are a factor of sqrt(2) apart, which limits the resolution. Returns NaN without samples.
+         */
+        double percentile(Interval interval, double fraction) const;
+
+        /**
+         * @brief summary Median and 95th percentile of each interval, for the guide log.
+         */
+        QString summary() const;
+
+    private:
+        static constexpr int BIN_COUNT = 48;
+
+        std::array<qint64, STAGE_COUNT> m_Stages {};
+        std::array<std::array<int, BIN_COUNT>, INTERVAL_COUNT> m_Histograms {};
+        std::array<int, INTERVAL_COUNT> m_Samples {};
+        int m_Cycles { 0 };
+};
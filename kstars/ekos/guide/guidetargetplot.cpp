@@ -61,14 +61,14 @@ GuideTargetPlot::GuideTargetPlot(QWidget *parent) : QCustomPlot (parent)
     setInteractions(QCP::iRangeZoom);
     setInteraction(QCP::iRangeDrag, true);
 
-    addGraph();
-    graph(GuideGraph::G_RA)->setLineStyle(QCPGraph::lsNone);
-    graph(GuideGraph::G_RA)->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssStar, Qt::gray, 5));
+    guidePoints = new QCPCurve(xAxis, yAxis);
+    guidePoints->setLineStyle(QCPCurve::lsNone);
+    guidePoints->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssStar, Qt::gray, 5));
 
-    addGraph();
-    graph(GuideGraph::G_DEC)->setLineStyle(QCPGraph::lsNone);
-    graph(GuideGraph::G_DEC)->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssPlusCircle, QPen(Qt::yellow, 2), QBrush(),
-            10));
+    highlightPoint = addGraph();
+    highlightPoint->setLineStyle(QCPGraph::lsNone);
+    highlightPoint->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssPlusCircle, QPen(Qt::yellow, 2), QBrush(),
+                                    10));
 
     setupNSEWLabels();
 
@@ -78,8 +78,8 @@ GuideTargetPlot::GuideTargetPlot(QWidget *parent) : QCustomPlot (parent)
 
 void GuideTargetPlot::showPoint(double ra, double de)
 {
-    graph(GuideGraph::G_DEC)->data()->clear(); //Clear Guide highlighted point
-    graph(GuideGraph::G_DEC)->addData(ra, de); //Set guide highlighted point
+    highlightPoint->data()->clear(); //Clear Guide highlighted point
+    highlightPoint->addData(ra, de); //Set guide highlighted point
     replot();
 }
 
@@ -238,8 +238,9 @@ void GuideTargetPlot::autoScaleGraphs(double accuracyRadius)
 
 void GuideTargetPlot::clear()
 {
-    graph(GuideGraph::G_RA)->data()->clear(); //Guide data
-    graph(GuideGraph::G_DEC)->data()->clear(); //Guide highlighted point
+    guidePoints->data()->clear(); //Guide data
+    guideSampleCount = 0;
+    highlightPoint->data()->clear(); //Guide highlighted point
     setupNSEWLabels();
     replot();
 }
@@ -247,11 +248,13 @@ void GuideTargetPlot::clear()
 void GuideTargetPlot::setAxisDelta(double ra, double de)
 {
     //Add to Drift Plot
-    graph(GuideGraph::G_RA)->addData(ra, de);
+    guidePoints->addData(guideSampleCount++, ra, de);
+    if (guidePoints->dataCount() > GuideGraph::HISTORY_CAPACITY + GuideGraph::HISTORY_TRIM_CHUNK)
+        guidePoints->data()->removeBefore(guideSampleCount - GuideGraph::HISTORY_CAPACITY);
     if(graphOnLatestPt)
     {
-        graph(GuideGraph::G_DEC)->data()->clear(); //Clear highlighted point
-        graph(GuideGraph::G_DEC)->addData(ra, de); //Set highlighted point to latest point
+        highlightPoint->data()->clear(); //Clear highlighted point
+        highlightPoint->addData(ra, de); //Set highlighted point to latest point
     }
 
     if (xAxis->range().contains(ra) == false || yAxis->range().contains(de) == false)
@@ -264,5 +267,5 @@ void GuideTargetPlot::setAxisDelta(double ra, double de)
         });
     }
 
-    replot();
+    replot(QCustomPlot::rpQueuedReplot);
 }
@@ -46,6 +46,12 @@ private:
     QCPCurve *redTarget { nullptr };
     QCPCurve *concentricRings { nullptr };
 
+    // Guide star positions, keyed by sample number so that new samples are appended and the oldest dropped
+    // from the front. The highlighted point is the latest or the one selected in the guide history.
+    QCPCurve *guidePoints { nullptr };
+    QCPGraph *highlightPoint { nullptr };
+    int guideSampleCount { 0 };
+
     bool graphOnLatestPt = true;
 
 };
@@ -17,6 +17,7 @@
  * @brief     The GP class implements the Gaussian Process functionality.
  */
 
+#include <algorithm>
 #include <cstdint>
 
 #include "gaussian_process.h"
@@ -270,42 +271,40 @@ void GP::inferSD(const Eigen::VectorXd &data_loc,
     // calculate covariance between data and prediction point for point selection
     covariance = covFunc_->evaluate(data_loc, prediction_loc);
 
-    // generate index vector
-    std::vector<int> index(covariance.size(), 0);
-    for (size_t i = 0 ; i != index.size() ; i++)
-    {
-        index[i] = i;
-    }
-
-    // sort indices with respect to covariance value
-    std::sort(index.begin(), index.end(),
-              covariance_ordering(covariance)
-             );
-
     bool use_var = data_var.rows() > 0; // true means heteroscedastic noise
 
     if (n < data_loc.rows())
     {
-        std::vector<double> loc_arr(n);
-        std::vector<double> out_arr(n);
-        std::vector<double> var_arr(n);
+        // generate index vector
+        std::vector<int> index(covariance.size(), 0);
+        for (size_t i = 0 ; i != index.size() ; i++)
+        {
+            index[i] = i;
+        }
+
+        // move the indices of the n points with the largest covariance to the front. The GP doesn't
+        // depend on the order of its data points, so partitioning in linear time is enough instead
+        // of sorting the whole history on every step.
+        std::nth_element(index.begin(), index.begin() + n, index.end(),
+                         covariance_ordering(covariance)
+                        );
+
+        data_loc_.resize(n);
+        data_out_.resize(n);
+        if (use_var)
+        {
+            data_var_.resize(n);
+        }
 
         for (int i = 0; i < n; ++i)
         {
-            loc_arr[i] = data_loc[index[i]];
-            out_arr[i] = data_out[index[i]];
+            data_loc_[i] = data_loc[index[i]];
+            data_out_[i] = data_out[index[i]];
             if (use_var)
             {
-                var_arr[i] = data_var[index[i]];
+                data_var_[i] = data_var[index[i]];
             }
         }
-
-        data_loc_ = Eigen::Map<Eigen::VectorXd>(loc_arr.data(), n, 1);
-        data_out_ = Eigen::Map<Eigen::VectorXd>(out_arr.data(), n, 1);
-        if (use_var)
-        {
-            data_var_ = Eigen::Map<Eigen::VectorXd>(var_arr.data(), n, 1);
-        }
     }
     else // we can use all points and don't neet to select
     {
@@ -7,6 +7,8 @@
 
 #include "Options.h"
 
+#include <algorithm>
+
 namespace Ekos
 {
 
@@ -110,6 +112,56 @@ void CalibrationProcess::getPulse(GuideDirection *dir, int *msecs) const
     *msecs = pulseMsecs;
 }
 
+void CalibrationProcess::shiftFrameOrigin(double dx, double dy)
+{
+    start_x1 -= dx;
+    start_y1 -= dy;
+    end_x1 -= dx;
+    end_y1 -= dy;
+    start_x2 -= dx;
+    start_y2 -= dy;
+    end_x2 -= dx;
+    end_y2 -= dy;
+    last_x -= dx;
+    last_y -= dy;
+    start_backlash_x -= dx;
+    start_backlash_y -= dy;
+}
+
+void CalibrationProcess::AxisFit::reset()
+{
+    *this = AxisFit();
+}
+
+void CalibrationProcess::AxisFit::add(double msecs, double pixels)
+{
+    samples++;
+    sumT += msecs;
+    sumD += pixels;
+    sumTT += msecs * msecs;
+    sumTD += msecs * pixels;
+}
+
+bool CalibrationProcess::AxisFit::valid() const
+{
+    return samples >= 3 && samples * sumTT - sumT * sumT > 0 && pixelsPerMs() > 0;
+}
+
+double CalibrationProcess::AxisFit::pixelsPerMs() const
+{
+    return (samples * sumTD - sumT * sumD) / (samples * sumTT - sumT * sumT);
+}
+
+int CalibrationProcess::returnPulse(const AxisFit &fit, int pulseSent, double drift, int defaultPulse) const
+{
+    if (!Options::calibrationFastReturn() || !fit.valid() || drift <= 0)
+        return defaultPulse;
+
+    // Never more than it took to move out, the next iterations take up any backlash.
+    const int pulse = static_cast<int>(std::lround(drift / fit.pixelsPerMs()));
+    return std::max(defaultPulse, std::min(pulseSent, pulse));
+}
+
 void CalibrationProcess::addStatus(Ekos::GuideState s)
 {
     status = s;
@@ -188,6 +240,9 @@ void CalibrationProcess::startState()
     last_y = start_x2;
 
     addPulse(RA_INC_DIR, last_pulse);
+    raFit.reset();
+    raFit.add(0, 0);
+    ra_pulse_sent = last_pulse;
 
     ra_iterations++;
 
@@ -213,6 +268,7 @@ void CalibrationProcess::raOutState(double cur_x, double cur_y)
     // If we've moved 15 pixels, we can cut short the requested number of iterations.
     const double xDrift = cur_x - start_x1;
     const double yDrift = cur_y - start_y1;
+    raFit.add(ra_pulse_sent, std::hypot(xDrift, yDrift));
     if (((ra_iterations >= maximumSteps) ||
             (std::hypot(xDrift, yDrift) > Options::calibrationMaxMove()))
             && (fabs(xDrift) > 1.5 || fabs(yDrift) > 1.5))
@@ -235,6 +291,7 @@ void CalibrationProcess::raOutState(double cur_x, double cur_y)
         ra_distance = 0;
         backlash = 0;
 
+        last_pulse = returnPulse(raFit, ra_pulse_sent, std::hypot(xDrift, yDrift), last_pulse);
         addPulse(RA_DEC_DIR, last_pulse);
         ra_iterations++;
 
@@ -269,6 +326,7 @@ void CalibrationProcess::raOutState(double cur_x, double cur_y)
         last_y = cur_y;
 
         addPulse(RA_INC_DIR, last_pulse);
+        ra_pulse_sent += last_pulse;
 
         ra_iterations++;
     }
@@ -326,6 +384,7 @@ void CalibrationProcess::raInState(double cur_x, double cur_y)
     {
         if (ra_iterations < turn_back_time)
         {
+            last_pulse = returnPulse(raFit, ra_pulse_sent, driftRA, last_pulse);
             addPulse(RA_DEC_DIR, last_pulse);
             ra_iterations++;
             return;
@@ -365,6 +424,9 @@ void CalibrationProcess::raInState(double cur_x, double cur_y)
 
             qCDebug(KSTARS_EKOS_GUIDE) << "Start X2 " << start_x2 << " start Y2 " << start_y2;
             addPulse(DEC_INC_DIR, Options::calibrationPulseDuration());
+            decFit.reset();
+            decFit.add(0, 0);
+            de_pulse_sent = Options::calibrationPulseDuration();
             dec_iterations++;
             addLogStatus(i18n("DEC drifting forward..."));
         }
@@ -418,6 +480,9 @@ void CalibrationProcess::decBacklashState(double cur_x, double cur_y)
 
         qCDebug(KSTARS_EKOS_GUIDE) << "Start X2 " << start_x2 << " start Y2 " << start_y2;
         addPulse(DEC_INC_DIR, Options::calibrationPulseDuration());
+        decFit.reset();
+        decFit.add(0, 0);
+        de_pulse_sent = Options::calibrationPulseDuration();
         dec_iterations++;
         addLogStatus(i18n("DEC drifting forward..."));
         return;
@@ -444,6 +509,7 @@ void CalibrationProcess::decOutState(double cur_x, double cur_y)
                                      start_x2, start_y2);
     const double xDrift = cur_x - start_x2;
     const double yDrift = cur_y - start_y2;
+    decFit.add(de_pulse_sent, std::hypot(xDrift, yDrift));
     if (((dec_iterations >= maximumSteps) ||
             (std::hypot(xDrift, yDrift) > Options::calibrationMaxMove()))
             && (fabs(xDrift) > 1.5 || fabs(yDrift) > 1.5))
@@ -466,6 +532,7 @@ void CalibrationProcess::decOutState(double cur_x, double cur_y)
 
         de_distance = 0;
 
+        last_pulse = returnPulse(decFit, de_pulse_sent, std::hypot(xDrift, yDrift), last_pulse);
         addPulse(DEC_DEC_DIR, last_pulse);
         addLogStatus(i18n("DEC drifting reverse..."));
         dec_iterations++;
@@ -503,6 +570,7 @@ void CalibrationProcess::decOutState(double cur_x, double cur_y)
         last_y = cur_y;
 
         addPulse(DEC_INC_DIR, last_pulse);
+        de_pulse_sent += last_pulse;
 
         dec_iterations++;
     }
@@ -557,6 +625,7 @@ void CalibrationProcess::decInState(double cur_x, double cur_y)
     {
         if (dec_iterations < turn_back_time)
         {
+            last_pulse = returnPulse(decFit, de_pulse_sent, driftRA, last_pulse);
             addPulse(DEC_DEC_DIR, last_pulse);
             dec_iterations++;
             return;
@@ -60,6 +60,10 @@ class CalibrationProcess
 
         void iterate(double x, double y);
 
+        // Move the stored star positions to match a guide frame whose origin moved by dx, dy pixels,
+        // e.g. when the subframe follows the calibration star.
+        void shiftFrameOrigin(double dx, double dy);
+
         // Return values from each iteration.
         void getCalibrationUpdate(
             GuideInterface::CalibrationUpdateType *type,
@@ -87,6 +91,21 @@ class CalibrationProcess
         void addLogStatus(const QString &status);
         void addStatus(Ekos::GuideState s);
 
+        // Least-squares line through the distance the star moved from the start of an axis
+        // against the pulse time sent so far, updated with each iteration of the axis.
+        struct AxisFit
+        {
+            void reset();
+            void add(double msecs, double pixels);
+            bool valid() const;
+            double pixelsPerMs() const;
+
+            int samples { 0 };
+            double sumT { 0 }, sumD { 0 }, sumTT { 0 }, sumTD { 0 };
+        };
+        // Pulse bringing the star back by drift pixels, or defaultPulse without a fit of the axis.
+        int returnPulse(const AxisFit &fit, int pulseSent, double drift, int defaultPulse) const;
+
         // calibration parameters
         int maximumSteps { 5 };
         int turn_back_time { 0 };
@@ -97,6 +116,11 @@ class CalibrationProcess
         int ra_total_pulse { 0 };
         int de_total_pulse { 0 };
         uint8_t backlash { 0 };
+        // Pulse time sent out along each axis, for the axis fits
+        int ra_pulse_sent { 0 };
+        int de_pulse_sent { 0 };
+        AxisFit raFit;
+        AxisFit decFit;
 
         // calibration coordinates
         double start_x1 { 0 };
@@ -0,0 +1,170 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "dithersettle.h"
+
+#include "fitsviewer/fitsdata.h"
+
+#include <algorithm>
+#include <cmath>
+
+void DitherSettle::reset(double x, double y)
+{
+    m_X = x;
+    m_Y = y;
+    m_Previous.clear();
+    m_Current.clear();
+    m_Shift = -1;
+}
+
+bool DitherSettle::addFrame(const QSharedPointer<FITSData> &imageData)
+{
+    if (imageData.isNull())
+        return false;
+
+    const int width = imageData->getStatistics().width;
+    const int height = imageData->getStatistics().height;
+    const uint8_t *buffer = imageData->getImageBuffer();
+    bool copied = false;
+    switch (imageData->dataType())
+    {
+        case TBYTE:
+            copied = copyWindow(buffer, width, height);
+            break;
+        case TSHORT:
+            copied = copyWindow(reinterpret_cast<const int16_t *>(buffer), width, height);
+            break;
+        case TUSHORT:
+            copied = copyWindow(reinterpret_cast<const uint16_t *>(buffer), width, height);
+            break;
+        case TLONG:
+            copied = copyWindow(reinterpret_cast<const int32_t *>(buffer), width, height);
+            break;
+        case TULONG:
+            copied = copyWindow(reinterpret_cast<const uint32_t *>(buffer), width, height);
+            break;
+        case TFLOAT:
+            copied = copyWindow(reinterpret_cast<const float *>(buffer), width, height);
+            break;
+        case TLONGLONG:
+            copied = copyWindow(reinterpret_cast<const int64_t *>(buffer), width, height);
+            break;
+        case TDOUBLE:
+            copied = copyWindow(reinterpret_cast<const double *>(buffer), width, height);
+            break;
+        default:
+            break;
+    }
+    return copied && compareWindows();
+}
+
+bool DitherSettle::addFrame(const float *image, int width, int height)
+{
+    return copyWindow(image, width, height) && compareWindows();
+}
+
+template <typename T>
+bool DitherSettle::copyWindow(const T *image, int width, int height)
+{
+    const int x0 = static_cast<int>(std::lround(m_X)) - WINDOW / 2;
+    const int y0 = static_cast<int>(std::lround(m_Y)) - WINDOW / 2;
+    if (image == nullptr || x0 < 0 || y0 < 0 || x0 + WINDOW > width || y0 + WINDOW > height)
+    {
+        // The star is too close to the edge of the frame
+        m_Previous.clear();
+        m_Current.clear();
+        return false;
+    }
+
+    std::swap(m_Previous, m_Current);
+    m_Current.resize(WINDOW * WINDOW);
+    float *out = m_Current.data();
+    for (int y = 0; y < WINDOW; y++)
+    {
+        const T *row = image + static_cast<size_t>(y0 + y) * width + x0;
+        for (int x = 0; x < WINDOW; x++)
+            *out++ = static_cast<float>(row[x]);
+    }
+    return true;
+}
+
+bool DitherSettle::compareWindows()
+{
+    m_Shift = -1;
+    if (m_Previous.size() != m_Current.size())
+        return false;
+
+    constexpr int side = 2 * STAMP_RADIUS + 1;
+    constexpr int n = side * side;
+    constexpr int shifts = 2 * SEARCH_RADIUS + 1;
+
+    // The stamp of the previous frame, zero mean
+    float stamp[n];
+    double mean = 0;
+    for (int y = 0; y < side; y++)
+        for (int x = 0; x < side; x++)
+            mean += m_Previous[(y + SEARCH_RADIUS) * WINDOW + x + SEARCH_RADIUS];
+    mean /= n;
+    double stampNorm = 0;
+    for (int y = 0; y < side; y++)
+        for (int x = 0; x < side; x++)
+        {
+            const float value = m_Previous[(y + SEARCH_RADIUS) * WINDOW + x + SEARCH_RADIUS] - mean;
+            stamp[y * side + x] = value;
+            stampNorm += value * value;
+        }
+    // A flat stamp shows no star
+    if (stampNorm <= 0)
+        return false;
+
+    // Correlation of the stamp with the current frame moved by each shift. The stamp is zero mean, so
+    // the mean of the current frame drops out of the numerator.
+    double correlation[shifts][shifts];
+    int bestX = 0, bestY = 0;
+    for (int dy = 0; dy < shifts; dy++)
+        for (int dx = 0; dx < shifts; dx++)
+        {
+            double product = 0, sum = 0, sumSquares = 0;
+            for (int y = 0; y < side; y++)
+            {
+                const float *row = m_Current.data() + (y + dy) * WINDOW + dx;
+                const float *stampRow = stamp + y * side;
+                for (int x = 0; x < side; x++)
+                {
+                    product += stampRow[x] * row[x];
+                    sum += row[x];
+                    sumSquares += row[x] * row[x];
+                }
+            }
+            const double norm = sumSquares - sum * sum / n;
+            correlation[dy][dx] = norm > 0 ? product / std::sqrt(stampNorm * norm) : 0;
+            if (correlation[dy][dx] > correlation[bestY][bestX])
+            {
+                bestX = dx;
+                bestY = dy;
+            }
+        }
+
+    if (correlation[bestY][bestX] < MIN_CORRELATION)
+        return false;
+
+    // Refine the peak to a fraction of a pixel with a parabola through it and its neighbours
+    auto refine = [](double before, double peak, double after)
+    {
+        const double curvature = before - 2 * peak + after;
+        if (curvature >= 0)
+            return 0.0;
+        return std::max(-0.5, std::min(0.5, 0.5 * (before - after) / curvature));
+    };
+    double shiftX = bestX - SEARCH_RADIUS, shiftY = bestY - SEARCH_RADIUS;
+    if (bestX > 0 && bestX < shifts - 1)
+        shiftX += refine(correlation[bestY][bestX - 1], correlation[bestY][bestX], correlation[bestY][bestX + 1]);
+    if (bestY > 0 && bestY < shifts - 1)
+        shiftY += refine(correlation[bestY - 1][bestX], correlation[bestY][bestX], correlation[bestY + 1][bestX]);
+
+    m_Shift = std::hypot(shiftX, shiftY);
+    return true;
+}
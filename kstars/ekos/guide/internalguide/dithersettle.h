@@ -0,0 +1,63 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QSharedPointer>
+
+#include <vector>
+
+class FITSData;
+
+/**
+ * @class DitherSettle
+ * @short Tells when the guide star stopped moving after a dither, without detecting stars.
+ *
+ * A small stamp of each guide frame around the guide star is cross-correlated with the stamp of
+ * the previous frame. The shift with the highest normalised cross-correlation, refined to a
+ * fraction of a pixel, is how far the star moved between the two frames. Guiding has settled
+ * once that is below the tolerance, which may be long before the settle time is over.
+ */
+class DitherSettle
+{
+    public:
+        /** Half the width of the stamp compared between frames, in pixels */
+        static constexpr int STAMP_RADIUS = 8;
+        /** Largest shift between frames looked for, in pixels */
+        static constexpr int SEARCH_RADIUS = 4;
+        /** Correlation below which the frames are not taken to show the same star */
+        static constexpr double MIN_CORRELATION = 0.5;
+
+        /** @brief reset Forget the previous frame and centre the stamps on @p x, @p y */
+        void reset(double x, double y);
+
+        /**
+         * @brief addFrame Compare the stamp of a guide frame with the stamp of the previous one
+         * @return true if the star was found in both, shift() is then how far it moved
+         */
+        bool addFrame(const QSharedPointer<FITSData> &imageData);
+        bool addFrame(const float *image, int width, int height);
+
+        /** @return how far the star moved between the last two frames, in pixels */
+        double shift() const
+        {
+            return m_Shift;
+        }
+
+    private:
+        // Side of the window copied from each frame, the stamp and the margin searched around it
+        static constexpr int WINDOW = 2 * (STAMP_RADIUS + SEARCH_RADIUS) + 1;
+
+        template <typename T>
+        bool copyWindow(const T *image, int width, int height);
+        bool compareWindows();
+
+        double m_X { 0 };
+        double m_Y { 0 };
+        std::vector<float> m_Previous;
+        std::vector<float> m_Current;
+        double m_Shift { -1 };
+};
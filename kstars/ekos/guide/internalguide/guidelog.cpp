@@ -11,7 +11,7 @@
 
 #include <QDateTime>
 #include <QStandardPaths>
-#include <QTextStream>
+#include <QtConcurrent>
 
 #include "auxiliary/kspaths.h"
 #include <version.h>
@@ -22,6 +22,10 @@
 namespace
 {
 
+// Buffered log lines are written at least this often, or as soon as there are this many bytes.
+constexpr qint64 LOG_FLUSH_INTERVAL_MS = 5000;
+constexpr int LOG_FLUSH_SIZE = 64 * 1024;
+
 // These conversion aren't correct. I believe the KStars way of doing it, with RA_INC etc
 // is better, however, it is consistent and will work with phdlogview.
 QString directionString(GuideDirection direction)
@@ -88,15 +92,48 @@ GuideLog::GuideLog()
 GuideLog::~GuideLog()
 {
     endLog();
+    writeFuture.waitForFinished();
+}
+
+void GuideLog::disable()
+{
+    if (enabled && initialized)
+        flushLog(false);
+    enabled = false;
 }
 
 void GuideLog::appendToLog(const QString &lines)
 {
     if (!enabled)
         return;
-    QTextStream out(&logFile);
-    out << lines;
-    out.flush();
+    pendingLines.append(lines.toUtf8());
+    if (pendingLines.size() >= LOG_FLUSH_SIZE || !flushTimer.isValid() || flushTimer.elapsed() >= LOG_FLUSH_INTERVAL_MS)
+        flushLog(false);
+}
+
+void GuideLog::flushLog(bool blocking)
+{
+    // Only one write at a time, so that lines reach the file in order.
+    writeFuture.waitForFinished();
+    flushTimer.start();
+    if (pendingLines.isEmpty())
+        return;
+
+    QByteArray lines;
+    lines.swap(pendingLines);
+    if (blocking)
+    {
+        logFile.write(lines);
+        logFile.flush();
+    }
+    else
+    {
+        writeFuture = QtConcurrent::run([this, lines]()
+        {
+            logFile.write(lines);
+            logFile.flush();
+        });
+    }
 }
 
 // Creates the filename and opens the file.
@@ -130,6 +167,7 @@ void GuideLog::endLog()
 
     appendToLog(QString("Log closed at %1\n")
                 .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss")));
+    flushLog(true);
     logFile.close();
 }
 
@@ -209,6 +247,8 @@ void GuideLog::endGuiding()
 {
     appendToLog(QString("Guiding Ends at %1\n\n")
                 .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss")));
+    // Guiding may stay stopped for a while, don't leave the end of the session in the buffer.
+    flushLog(false);
     isGuiding = false;
 }
 
@@ -286,6 +326,7 @@ void GuideLog::endCalibration(double raSpeed, double decSpeed)
                             "Calibration complete\n\n")
                     .arg(QString::number(raSpeed, 'f', 1))
                     .arg(QString::number(decSpeed, 'f', 1)));
+    flushLog(false);
 }
 
 void GuideLog::ditherInfo(double dx, double dy, double x, double y)
@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <QByteArray>
 #include <QElapsedTimer>
 #include <QFile>
+#include <QFuture>
 
 #include "indi/indicommon.h"
 #include "indi/indimount.h"
@@ -65,10 +67,7 @@ class GuideLog
         {
             enabled = true;
         }
-        void disable()
-        {
-            enabled = false;
-        }
+        void disable();
 
         // These are called for each guiding session.
         void startGuiding(const GuideInfo &info);
@@ -94,11 +93,19 @@ class GuideLog
         void startLog();
         void endLog();
         void appendToLog(const QString &lines);
+        // Hand the buffered lines to a thread pool write, or write them here and wait if blocking.
+        void flushLog(bool blocking);
 
         // Log file info.
         QFile logFile;
         QString logFileName;
 
+        // Lines not yet written. They are written in the background every few seconds or when the
+        // buffer grows large, so that guide steps don't pay for a file write each.
+        QByteArray pendingLines;
+        QElapsedTimer flushTimer;
+        QFuture<void> writeFuture;
+
         // Message indeces and timers.
         int guideIndex = 1;
         int calibrationIndex = 1;
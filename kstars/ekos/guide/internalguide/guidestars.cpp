@@ -13,6 +13,9 @@
 #include "Options.h"
 
 #include <math.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
 #include <stellarsolver.h>
 #include "ekos/auxiliary/stellarsolverprofileeditor.h"
 #include <QTime>
@@ -33,6 +36,9 @@
 // margin below (e.g. if a guide star was selected that was near the max guide-star hfr, the later
 // the hfr increased a little, we still want to be able to find it.
 constexpr double HFR_MARGIN = 2.0;
+
+// Don't accept reference stars whose position is more than this many pixels from expected.
+constexpr double MAX_STAR_ASSOCIATION_DISTANCE = 10;
 /*
  Start with a set of reference (x,y) positions from stars, where one is designated a guide star.
  Given these and a set of new input stars, determine a mapping of new stars to the references.
@@ -85,6 +91,14 @@ void logStars(const QString &label, const QString &label2, const SkyBackground &
         qCDebug(KSTARS_EKOS_GUIDE) << line;
     }
 }
+
+QVariantMap sepSettings()
+{
+    QVariantMap settings;
+    settings["optionsProfileIndex"] = Options::guideOptionsProfile();
+    settings["optionsProfileGroup"] = static_cast<int>(Ekos::GuideProfiles);
+    return settings;
+}
 }  //namespace
 
 GuideStars::GuideStars()
@@ -102,6 +116,7 @@ int GuideStars::getStarMap(int index)
 void GuideStars::setupStarCorrespondence(const QList<Edge> &neighbors, int guideIndex)
 {
     qCDebug(KSTARS_EKOS_GUIDE) << "setupStarCorrespondence: neighbors " << neighbors.size() << "guide index" << guideIndex;
+    m_TrackingValid = false;
     if (neighbors.size() >= MIN_STAR_CORRESPONDENCE_SIZE)
     {
         starMap.clear();
@@ -296,9 +311,6 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
     if (firstFrame)
         unreliableDectionCounter = 0;
 
-    // Don't accept reference stars whose position is more than this many pixels from expected.
-    constexpr double maxStarAssociationDistance = 10;
-
     if (imageData == nullptr)
         return GuiderUtils::Vector(-1, -1, -1);
 
@@ -316,12 +328,23 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
 
     // Allow a little margin above the max hfr for guide stars when searching for the guide star.
     const double maxHFR = Options::guideMaxHFR() + HFR_MARGIN;
+    bool tracked = false;
     if (starCorrespondence.size() > 0)
     {
-
-        findTopStars(imageData, STARS_TO_SEARCH, &detectedStars, maxHFR);
+        // Between full detections, only measure the reference stars where they are expected.
+        tracked = !firstFrame && !needsFullDetection() && trackReferenceStars(imageData, &detectedStars);
+        if (tracked)
+            m_FramesSinceDetection++;
+        else
+        {
+            findTopStars(imageData, STARS_TO_SEARCH, &detectedStars, maxHFR);
+            m_FramesSinceDetection = 0;
+        }
         if (detectedStars.empty())
+        {
+            m_TrackingValid = false;
             return GuiderUtils::Vector(-1, -1, -1);
+        }
 
         // Allow it to guide even if the main guide star isn't detected (as long as enough reference stars are).
         starCorrespondence.setAllowMissingGuideStar(allowMissingGuideStar);
@@ -335,7 +358,7 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
         if (starCorrespondence.size() > 25) minFraction =  0.33;
         else if (starCorrespondence.size() > 15) minFraction =  0.4;
 
-        Edge foundStar = starCorrespondence.find(detectedStars, maxStarAssociationDistance, &starMap, true, minFraction);
+        Edge foundStar = starCorrespondence.find(detectedStars, MAX_STAR_ASSOCIATION_DISTANCE, &starMap, true, minFraction);
 
         // Is there a correspondence to the guide star
         // Should we also weight distance to the tracking box?
@@ -351,6 +374,8 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
                 qCDebug(KSTARS_EKOS_GUIDE) << QString("StarCorrespondence found star %1 at %2 %3 SNR %4")
                                            .arg(i).arg(star.x, 0, 'f', 1).arg(star.y, 0, 'f', 1).arg(SNR, 0, 'f', 1);
 
+                m_TrackingValid = true;
+                m_LastGuideStarPosition = GuiderUtils::Vector(star.x, star.y, 0);
                 if (guideView != nullptr)
                     plotStars(guideView, trackingBox);
                 return GuiderUtils::Vector(star.x, star.y, 0);
@@ -364,12 +389,22 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
             guideStarMass = foundStar.sum;
             unreliableDectionCounter = 0;  // debating this
             qCDebug(KSTARS_EKOS_GUIDE) << "StarCorrespondence invented at" << foundStar.x << foundStar.y << "SNR" << guideStarSNR;
+            m_TrackingValid = true;
+            m_LastGuideStarPosition = GuiderUtils::Vector(foundStar.x, foundStar.y, 0);
             if (guideView != nullptr)
                 plotStars(guideView, trackingBox);
             return GuiderUtils::Vector(foundStar.x, foundStar.y, 0);
         }
     }
 
+    // Tracking lost the stars, look for them again in the whole image.
+    m_TrackingValid = false;
+    if (tracked)
+    {
+        qCDebug(KSTARS_EKOS_GUIDE) << "Multistar: tracking lost the reference stars, detecting all stars";
+        return findGuideStar(imageData, trackingBox, guideView, firstFrame);
+    }
+
     qCDebug(KSTARS_EKOS_GUIDE) << "StarCorrespondence not used. It failed to find the guide star.";
 
     if (++unreliableDectionCounter > MAX_CONSECUTIVE_UNRELIABLE)
@@ -444,17 +479,149 @@ SSolver::Parameters GuideStars::getStarExtractionParameters(int num)
     return params;
 }
 
+QFuture<bool> GuideStars::detectStars(const QSharedPointer<FITSData> &imageData)
+{
+    imageData->setSourceExtractorSettings(sepSettings());
+    return imageData->findStars(ALGORITHM_SEP);
+}
+
+bool GuideStars::needsFullDetection() const
+{
+    const int interval = Options::guideMultistarDetectionInterval();
+    return !m_TrackingValid || interval <= 1 || m_FramesSinceDetection + 1 >= interval;
+}
+
+bool GuideStars::trackReferenceStars(const QSharedPointer<FITSData> &imageData, QList<Edge> *stars) const
+{
+    stars->clear();
+    if (!m_TrackingValid || starCorrespondence.guideStar() < 0)
+        return false;
+
+    // Stars move less than the association distance between frames, the window also holds the star itself.
+    const double maxRadius = 2 * (Options::guideMaxHFR() + HFR_MARGIN);
+    const int halfSize = static_cast<int>(std::ceil(MAX_STAR_ASSOCIATION_DISTANCE + maxRadius));
+    const QRect frame(0, 0, imageData->width(), imageData->height());
+
+    std::vector<float> window;
+    for (int i = 0; i < starCorrespondence.size(); ++i)
+    {
+        const QVector2D offset = starCorrespondence.offset(i);
+        const int x = static_cast<int>(std::lround(m_LastGuideStarPosition.x + offset.x()));
+        const int y = static_cast<int>(std::lround(m_LastGuideStarPosition.y + offset.y()));
+        const QRect box = QRect(x - halfSize, y - halfSize, 2 * halfSize + 1, 2 * halfSize + 1).intersected(frame);
+        if (box.isEmpty())
+            continue;
+
+        window.resize(box.width() * box.height());
+        Edge star;
+        if (!imageData->getFloatBuffer(window.data(), box) ||
+                !measureStar(window.data(), box.width(), box.height(), maxRadius, &star))
+            continue;
+        star.x += box.x();
+        star.y += box.y();
+        stars->append(star);
+    }
+
+    DLOG(KSTARS_EKOS_GUIDE) << "Multistar: tracked" << stars->size() << "of" << starCorrespondence.size() << "references";
+    return stars->size() >= MIN_STAR_CORRESPONDENCE_SIZE;
+}
+
+bool GuideStars::measureStar(const float *window, int width, int height, double maxRadius, Edge *star)
+{
+    // The whole star must fit in the window around its peak.
+    const int margin = static_cast<int>(std::ceil(maxRadius));
+    if (width <= 2 * margin || height <= 2 * margin)
+        return false;
+
+    // Background and noise, as median and MAD of a 2 pixel wide border.
+    constexpr int BORDER = 2;
+    std::vector<float> border;
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+            if (x < BORDER || y < BORDER || x >= width - BORDER || y >= height - BORDER)
+                border.push_back(window[y * width + x]);
+    std::nth_element(border.begin(), border.begin() + border.size() / 2, border.end());
+    const double background = border[border.size() / 2];
+    for (auto &value : border)
+        value = std::fabs(value - background);
+    std::nth_element(border.begin(), border.begin() + border.size() / 2, border.end());
+    const double noise = std::max(1.4826 * border[border.size() / 2],
+                                  std::numeric_limits<float>::epsilon() * std::max(1.0, std::fabs(background)));
+
+    int peakX = -1, peakY = -1;
+    float peak = std::numeric_limits<float>::lowest();
+    for (int y = margin; y < height - margin; ++y)
+        for (int x = margin; x < width - margin; ++x)
+            if (window[y * width + x] > peak)
+            {
+                peak = window[y * width + x];
+                peakX = x;
+                peakY = y;
+            }
+    if (peakX < 0 || peak - background < 5 * noise)
+        return false;
+
+    // Flux weighted centroid of the pixels above the noise around the peak.
+    const double threshold = background + 3 * noise;
+    const double radiusSq = maxRadius * maxRadius;
+    double flux = 0, sumX = 0, sumY = 0;
+    int numPixels = 0;
+    for (int y = peakY - margin; y <= peakY + margin; ++y)
+        for (int x = peakX - margin; x <= peakX + margin; ++x)
+        {
+            const double value = window[y * width + x];
+            if (value <= threshold || (x - peakX) * (x - peakX) + (y - peakY) * (y - peakY) > radiusSq)
+                continue;
+            flux += value - background;
+            sumX += (value - background) * x;
+            sumY += (value - background) * y;
+            numPixels++;
+        }
+    if (flux <= 0)
+        return false;
+    const double centerX = sumX / flux, centerY = sumY / flux;
+
+    // The HFR is the radius around the centroid that holds half of the flux.
+    QVector<std::pair<double, double>> samples;
+    samples.reserve(numPixels);
+    for (int y = peakY - margin; y <= peakY + margin; ++y)
+        for (int x = peakX - margin; x <= peakX + margin; ++x)
+        {
+            const double value = window[y * width + x];
+            if (value <= threshold || (x - peakX) * (x - peakX) + (y - peakY) * (y - peakY) > radiusSq)
+                continue;
+            samples.push_back(std::make_pair(std::hypot(x - centerX, y - centerY), value - background));
+        }
+    std::sort(samples.begin(), samples.end());
+    double hfr = 0, accumulated = 0;
+    for (const auto &sample : samples)
+    {
+        accumulated += sample.second;
+        hfr = sample.first;
+        if (accumulated >= flux / 2)
+            break;
+    }
+
+    star->x = centerX;
+    star->y = centerY;
+    star->val = static_cast<int>(peak - background);
+    star->sum = flux;
+    star->numPixels = numPixels;
+    star->HFR = std::max(0.5, hfr);
+    star->width = star->HFR;
+    return true;
+}
+
 // This is the interface to star detection.
 int GuideStars::findAllSEPStars(const QSharedPointer<FITSData> &imageData, QList<Edge *> *sepStars, int num)
 {
     if (imageData == nullptr)
         return 0;
 
-    QVariantMap settings;
-    settings["optionsProfileIndex"] = Options::guideOptionsProfile();
-    settings["optionsProfileGroup"] = static_cast<int>(Ekos::GuideProfiles);
-    imageData->setSourceExtractorSettings(settings);
-    imageData->findStars(ALGORITHM_SEP).waitForFinished();
+    // Only detect if detectStars() has not already done it.
+    imageData->setSourceExtractorSettings(sepSettings());
+    if (!imageData->areStarsFound(ALGORITHM_SEP))
+        imageData->findStars(ALGORITHM_SEP).waitForFinished();
     skyBackground = imageData->getSkyBackground();
 
     QList<Edge *> edges = imageData->getStarCenters();
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <QObject>
+#include <QFuture>
 #include <QList>
 #include <QVector3D>
 
@@ -54,6 +55,14 @@ class GuideStars
         // most desirable guide star.
         QVector3D selectGuideStar(const QSharedPointer<FITSData> &imageData);
 
+        // Starts the SEP detection of the image's stars in the background. Watch the returned
+        // future, the following selectGuideStar() or findGuideStar() then reuse its results.
+        static QFuture<bool> detectStars(const QSharedPointer<FITSData> &imageData);
+
+        // Returns true when the next frame needs a full SEP detection. Otherwise, when multi-star
+        // tracking is enabled, findGuideStar() only measures the stars around their predicted positions.
+        bool needsFullDetection() const;
+
         // Finds the guide star previously selected with selectGuideStar()
         // in a new image. This sets up internal structures for getDrift().
         GuiderUtils::Vector findGuideStar(const QSharedPointer<FITSData> &imageData, const QRect &trackingBox,
@@ -102,6 +111,7 @@ class GuideStars
         void reset()
         {
             starCorrespondence.reset();
+            m_TrackingValid = false;
         }
 
     private:
@@ -138,6 +148,17 @@ class GuideStars
                                   int maxX, int maxY,
                                   const QList<double> &minDistances);
 
+        // Measures the reference stars in small windows around their positions predicted from the
+        // last guide star position, instead of detecting all the stars of the image.
+        // Returns false if too few of them could be measured.
+        bool trackReferenceStars(const QSharedPointer<FITSData> &imageData, QList<Edge> *stars) const;
+
+        // Measures the star nearest to the center of a window of float samples: background and noise
+        // come from the window's border, the centroid, flux and HFR from the pixels above the noise
+        // within maxRadius of the peak. Positions are relative to the window.
+        // Returns false if no star stands out of the noise.
+        static bool measureStar(const float *window, int width, int height, double maxRadius, Edge *star);
+
         // Computes the distance from stars[i] to its closest neighbor.
         double findMinDistance(int index, const QList<Edge*> &stars);
 
@@ -159,6 +180,12 @@ class GuideStars
         }
         int getStarMap(int index);
 
+        // Multi-star tracking state, the position of the guide star in the last frame and the number
+        // of frames tracked since the last full detection.
+        bool m_TrackingValid { false };
+        GuiderUtils::Vector m_LastGuideStarPosition;
+        int m_FramesSinceDetection { 0 };
+
         // Sky background value generated by the SEP processing.
         // Used to calculate star SNR values.
         SkyBackground skyBackground;
@@ -12,13 +12,16 @@
 #include "gmath.h"
 #include "Options.h"
 #include "auxiliary/kspaths.h"
+#include "auxiliary/kstrace.h"
 #include "fitsviewer/fitsdata.h"
 #include "fitsviewer/fitsview.h"
 #include "guidealgorithms.h"
 #include "ksnotification.h"
+#include "ekos/auxiliary/framerecorder.h"
 #include "ekos/auxiliary/stellarsolverprofileeditor.h"
 #include "fitsviewer/fitsdata.h"
 #include "../guideview.h"
+#include "../guidelatency.h"
 
 #include <KMessageBox>
 
@@ -52,6 +55,9 @@ InternalGuider::InternalGuider()
 
     m_darkGuideTimer = std::make_unique<QTimer>(this);
     m_captureTimer = std::make_unique<QTimer>(this);
+    m_DitherSettleTimer = std::make_unique<QTimer>(this);
+    m_DitherSettleTimer->setSingleShot(true);
+    connect(m_DitherSettleTimer.get(), &QTimer::timeout, this, &InternalGuider::setDitherSettled);
 
     setDarkGuideTimerInterval();
 
@@ -61,6 +67,16 @@ InternalGuider::InternalGuider()
     {
         this->m_captureTimer->start();
     });
+
+    connect(&m_StarDetectionWatcher, &QFutureWatcher<bool>::finished, this, [this]()
+    {
+        // Guiding may have stopped, or moved on to another frame, while the stars were detected.
+        const QSharedPointer<FITSData> image = m_StarDetectionImage;
+        m_StarDetectionImage.clear();
+        if (image.isNull() || image != m_ImageData || state < GUIDE_GUIDING)
+            return;
+        processGuiding();
+    });
 }
 
 void InternalGuider::setExposureTime()
@@ -95,8 +111,19 @@ bool InternalGuider::isInferencePeriodFinished()
 }
 bool InternalGuider::guide()
 {
+    if (state == GUIDE_DITHERING_SETTLE)
+        checkDitherSettled();
+
     if (state >= GUIDE_GUIDING)
     {
+        // Keep the event loop running during the star detection, findGuideStar() then reuses its results.
+        if (pmath->usingSEPMultiStar() && !m_ImageData.isNull()
+                && (m_isFirstFrame || pmath->getGuideStars().needsFullDetection()))
+        {
+            m_StarDetectionImage = m_ImageData;
+            m_StarDetectionWatcher.setFuture(GuideStars::detectStars(m_ImageData));
+            return true;
+        }
         return processGuiding();
     }
 
@@ -279,6 +306,7 @@ bool InternalGuider::ditherXY(double x, double y)
 
 bool InternalGuider::dither(double pixels)
 {
+    KSTRACE_SCOPE("guide", "dither");
     if (Options::ditherWithOnePulse() )
         return onePulseDither(pixels);
 
@@ -414,7 +442,7 @@ bool InternalGuider::dither(double pixels)
         if (Options::gPGEnabled())
             pmath->getGPG().ditheringSettled(true);
 
-        QTimer::singleShot(Options::ditherSettle() * 1000, this, SLOT(setDitherSettled()));
+        startDitherSettle(Options::ditherSettle() * 1000);
     }
     else
     {
@@ -520,7 +548,7 @@ bool InternalGuider::onePulseDither(double pixels)
     if (Options::gPGEnabled())
         pmath->getGPG().ditheringSettled(true);
 
-    QTimer::singleShot(totalMSecs, this, SLOT(setDitherSettled()));
+    startDitherSettle(totalMSecs);
     return true;
 }
 
@@ -547,7 +575,7 @@ bool InternalGuider::abortDither()
         if (Options::gPGEnabled())
             pmath->getGPG().ditheringSettled(false);
 
-        QTimer::singleShot(Options::ditherSettle() * 1000, this, SLOT(setDitherSettled()));
+        startDitherSettle(Options::ditherSettle() * 1000);
         return true;
     }
 }
@@ -593,7 +621,7 @@ bool InternalGuider::processManualDithering()
                 emit newStatus(state);
             }
 
-            QTimer::singleShot(Options::ditherSettle() * 1000, this, SLOT(setDitherSettled()));
+            startDitherSettle(Options::ditherSettle() * 1000);
         }
         else
         {
@@ -613,7 +641,7 @@ bool InternalGuider::processManualDithering()
                 emit newStatus(state);
             }
 
-            QTimer::singleShot(Options::ditherSettle() * 1000, this, SLOT(setDitherSettled()));
+            startDitherSettle(Options::ditherSettle() * 1000);
             return true;
         }
 
@@ -623,6 +651,62 @@ bool InternalGuider::processManualDithering()
     return true;
 }
 
+void InternalGuider::getTargetPosition(double *x, double *y) const
+{
+    pmath->getTargetPosition(x, y);
+}
+
+void InternalGuider::getStarPosition(double *x, double *y) const
+{
+    pmath->getStarScreenPosition(x, y);
+}
+
+void InternalGuider::shiftFrameOrigin(double dx, double dy)
+{
+    double x, y;
+    pmath->getTargetPosition(&x, &y);
+    pmath->setTargetPosition(x - dx, y - dy);
+
+    m_DitherTargetPosition.x -= dx;
+    m_DitherTargetPosition.y -= dy;
+    if (state == GUIDE_CALIBRATING && calibrationProcess)
+    {
+        calibrationStartX -= dx;
+        calibrationStartY -= dy;
+        calibrationProcess->shiftFrameOrigin(dx, dy);
+    }
+    // The previous frame no longer lines up with the next one
+    m_DitherSettle.reset(x - dx, y - dy);
+    for (auto &position : m_ProgressiveDither)
+    {
+        position.x -= dx;
+        position.y -= dy;
+    }
+}
+
+void InternalGuider::startDitherSettle(int msecs)
+{
+    double x, y;
+    pmath->getTargetPosition(&x, &y);
+    m_DitherSettle.reset(x, y);
+    m_DitherSettleTimer->start(msecs);
+}
+
+void InternalGuider::checkDitherSettled()
+{
+    // The settle time is then only the longest wait, guiding settles as soon as the star stops moving
+    if (!Options::ditherSettleEarly() || !m_DitherSettleTimer->isActive())
+        return;
+
+    if (m_DitherSettle.addFrame(m_ImageData) && m_DitherSettle.shift() < Options::ditherSettleTolerance())
+    {
+        qCDebug(KSTARS_EKOS_GUIDE) << "Dither settled early, the guide star moved" << m_DitherSettle.shift()
+                                   << "pixels since the last frame," << m_DitherSettleTimer->remainingTime() << "ms before the settle time.";
+        m_DitherSettleTimer->stop();
+        setDitherSettled();
+    }
+}
+
 void InternalGuider::setDitherSettled()
 {
     guideLog.settleCompletedInfo();
@@ -744,6 +828,13 @@ void InternalGuider::iterateCalibration()
     pmath->getStarScreenPosition(&starX, &starY);
     calibrationProcess->iterate(starX, starY);
 
+    // Send the pulse first, the mount moves while the calibration plot and log are updated
+    GuideDirection pulseDirection;
+    int pulseMsecs;
+    calibrationProcess->getPulse(&pulseDirection, &pulseMsecs);
+    if (pulseDirection != NO_DIR)
+        emit newSinglePulse(pulseDirection, pulseMsecs, StartCaptureAfterPulses);
+
     auto status = calibrationProcess->getStatus();
     if (status != GUIDE_CALIBRATING)
         emit newStatus(status);
@@ -759,12 +850,6 @@ void InternalGuider::iterateCalibration()
     if (updateMessage.length())
         emit calibrationUpdate(type, updateMessage, x, y);
 
-    GuideDirection pulseDirection;
-    int pulseMsecs;
-    calibrationProcess->getPulse(&pulseDirection, &pulseMsecs);
-    if (pulseDirection != NO_DIR)
-        emit newSinglePulse(pulseDirection, pulseMsecs, StartCaptureAfterPulses);
-
     if (status == GUIDE_CALIBRATION_ERROR)
     {
         KSNotification::event(QLatin1String("CalibrationFailed"), i18n("Guiding calibration failed"),
@@ -789,6 +874,7 @@ void InternalGuider::setGuideView(const QSharedPointer<GuideView> &guideView)
 void InternalGuider::setImageData(const QSharedPointer<FITSData> &data)
 {
     m_ImageData = data;
+    FrameRecorder::Instance()->record(FrameRecorder::GUIDE, data, {{"state", static_cast<int>(state)}});
     if (Options::saveGuideImages())
     {
         QDateTime now(QDateTime::currentDateTime());
@@ -925,6 +1011,7 @@ void InternalGuider::emitAxisPulse(const cproc_out_params * out)
 
 bool InternalGuider::processGuiding()
 {
+    KSTRACE_SCOPE("guide", "processGuiding");
     const cproc_out_params *out;
 
     // On first frame, center the box (reticle) around the star so we do not start with an offset the results in
@@ -952,6 +1039,7 @@ bool InternalGuider::processGuiding()
     {
         auto const timeStep = calculateGPGTimeStep();
         pmath->performProcessing(state, m_ImageData, m_GuideFrame, timeStep, &guideLog);
+        m_ProcessedTime = GuideLatency::timestamp();
         if (pmath->usingSEPMultiStar())
         {
             QString info = "";
@@ -1273,7 +1361,7 @@ bool InternalGuider::reacquire()
                 emit newStatus(state);
             }
 
-            QTimer::singleShot(Options::ditherSettle() * 1000, this, SLOT(setDitherSettled()));
+            startDitherSettle(Options::ditherSettle() * 1000);
         }
         else
         {
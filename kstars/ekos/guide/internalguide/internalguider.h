@@ -15,8 +15,10 @@
 #include "calibration.h"
 #include "calibrationprocess.h"
 #include "gmath.h"
+#include "dithersettle.h"
 #include "ekos_guide_debug.h"
 #include <QFile>
+#include <QFutureWatcher>
 #include <QPointer>
 #include <QQueue>
 #include <QTime>
@@ -112,6 +114,23 @@ class InternalGuider : public GuideInterface
         // Manual Dither
         bool processManualDithering();
 
+        // Time the guide star of the last frame was found and its correction computed, see GuideLatency::timestamp().
+        qint64 processedTime() const
+        {
+            return m_ProcessedTime;
+        }
+
+        // Lock position in binned pixels of the current guide frame.
+        void getTargetPosition(double *x, double *y) const;
+        // Guide star position in binned pixels of the last guide frame.
+        void getStarPosition(double *x, double *y) const;
+        /**
+         * @brief shiftFrameOrigin Move the lock, dither target and calibration positions to match a guide
+         * frame whose origin moved by dx, dy binned pixels, e.g. to keep a subframe centered on the lock
+         * position, or on the star while calibrating.
+         */
+        void shiftFrameOrigin(double dx, double dy);
+
         void updateGPGParameters();
         void resetGPG() override;
         void resetDarkGuiding();
@@ -140,6 +159,9 @@ class InternalGuider : public GuideInterface
         void startDarkGuiding();
         bool abortDither();
         bool onePulseDither(double pixels);
+        // Wait for guiding to settle after a dither, at most msecs
+        void startDitherSettle(int msecs);
+        void checkDitherSettled();
 
         void reset();
 
@@ -149,9 +171,13 @@ class InternalGuider : public GuideInterface
         std::unique_ptr<cgmath> pmath;
         QSharedPointer<GuideView> m_GuideFrame;
         QSharedPointer<FITSData> m_ImageData;
+        // Multi-star guiding detects the stars of each frame in the background, then processes it.
+        QFutureWatcher<bool> m_StarDetectionWatcher;
+        QSharedPointer<FITSData> m_StarDetectionImage;
         bool m_isStarted { false };
         bool m_isSubFramed { false };
         bool m_isFirstFrame { false };
+        qint64 m_ProcessedTime { 0 };
         int m_starLostCounter { 0 };
 
         QFile logFile;
@@ -159,6 +185,8 @@ class InternalGuider : public GuideInterface
 
         GuiderUtils::Vector m_DitherTargetPosition;
         uint8_t m_DitherRetries {0};
+        std::unique_ptr<QTimer> m_DitherSettleTimer;
+        DitherSettle m_DitherSettle;
 
         QElapsedTimer reacquireTimer;
         int m_highRMSCounter {0};
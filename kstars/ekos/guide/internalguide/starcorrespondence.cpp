@@ -7,58 +7,105 @@
 #include "starcorrespondence.h"
 
 #include <math.h>
+#include <algorithm>
 #include "ekos_guide_debug.h"
 
-// Finds the star in sortedStars that's closest to x,y and within maxDistance pixels.
-// Returns the index of the closest star in  sortedStars, or -1 if none satisfies the criteria.
-// sortedStars must be sorted by x, from lower x to higher x.
-// Fills distance to the pixel distance to the closest star.
-int StarCorrespondence::findClosestStar(double x, double y, const QList<Edge> sortedStars,
-                                        double maxDistance, double *distance) const
+StarGrid::StarGrid(const QList<Edge> &stars, double cellSize)
 {
-    if (x < -maxDistance || y < -maxDistance ||
-            x > imageWidth + maxDistance || y > imageWidth + maxDistance)
-        return -1;
+    const int size = stars.size();
+    if (size == 0)
+        return;
 
-    const int size = sortedStars.size();
-    int startPoint = 0;
+    m_X.reserve(size);
+    m_Y.reserve(size);
+    double maxX = stars[0].x, maxY = stars[0].y;
+    m_MinX = maxX;
+    m_MinY = maxY;
+    for (const auto &star : stars)
+    {
+        m_X.push_back(star.x);
+        m_Y.push_back(star.y);
+        m_MinX = std::min<double>(m_MinX, star.x);
+        m_MinY = std::min<double>(m_MinY, star.y);
+        maxX = std::max<double>(maxX, star.x);
+        maxY = std::max<double>(maxY, star.y);
+    }
 
-    // Efficiency improvement to quickly find the start point.
-    // Increments by size/10 to find a better start point.
-    const int coarseIncrement = size / 10;
-    if (coarseIncrement > 1)
+    // Cells smaller than the average spacing of the stars would mostly be empty.
+    const double area = std::max(1.0, (maxX - m_MinX) * (maxY - m_MinY));
+    m_CellSize = std::max({cellSize, 1.0, std::sqrt(area / size)});
+    m_Columns = static_cast<int>((maxX - m_MinX) / m_CellSize) + 1;
+    m_Rows = static_cast<int>((maxY - m_MinY) / m_CellSize) + 1;
+
+    // Counting sort of the stars by cell. Stars keep their order within a cell.
+    QVector<int> cells(size);
+    m_CellStart = QVector<int>(m_Columns * m_Rows + 1, 0);
+    for (int i = 0; i < size; ++i)
     {
-        for (int i = 0; i < size; i += coarseIncrement)
-        {
-            if (sortedStars[i].x < x - maxDistance)
-                startPoint = i;
-            else
-                break;
-        }
+        const int column = static_cast<int>((m_X[i] - m_MinX) / m_CellSize);
+        const int row = static_cast<int>((m_Y[i] - m_MinY) / m_CellSize);
+        cells[i] = row * m_Columns + column;
+        m_CellStart[cells[i] + 1]++;
     }
+    for (int c = 0; c < m_Columns * m_Rows; ++c)
+        m_CellStart[c + 1] += m_CellStart[c];
+    m_CellStars = QVector<int>(size);
+    QVector<int> fill = m_CellStart;
+    for (int i = 0; i < size; ++i)
+        m_CellStars[fill[cells[i]]++] = i;
+}
 
-    // Iterate through the stars starting with the star with lowest x where x >= x - maxDistance
-    // through the star with greatest x where x <= x + maxDistance.  Find the closest star to x,y.
+int StarGrid::findClosest(double x, double y, double maxDistance, double *distance) const
+{
     int bestIndex = -1;
     double bestSquaredDistance = maxDistance * maxDistance;
-    for (int i = startPoint; i < size; ++i)
+    if (m_X.isEmpty() || maxDistance < 0)
     {
-        auto &star = sortedStars[i];
-        if (star.x < x - maxDistance) continue;
-        if (star.x > x + maxDistance) break;
-        const double xDiff = star.x - x;
-        const double yDiff = star.y - y;
-        const double squaredDistance = xDiff * xDiff + yDiff * yDiff;
-        if (squaredDistance <= bestSquaredDistance)
+        if (distance != nullptr) *distance = maxDistance;
+        return bestIndex;
+    }
+
+    // Only the cells overlapping the square of side 2 * maxDistance around x,y can hold a candidate.
+    const int firstColumn = std::max(0.0, std::floor((x - maxDistance - m_MinX) / m_CellSize));
+    const int lastColumn = std::min(m_Columns - 1.0, std::floor((x + maxDistance - m_MinX) / m_CellSize));
+    const int firstRow = std::max(0.0, std::floor((y - maxDistance - m_MinY) / m_CellSize));
+    const int lastRow = std::min(m_Rows - 1.0, std::floor((y + maxDistance - m_MinY) / m_CellSize));
+    for (int row = firstRow; row <= lastRow; ++row)
+    {
+        for (int column = firstColumn; column <= lastColumn; ++column)
         {
-            bestIndex = i;
-            bestSquaredDistance = squaredDistance;
+            const int cell = row * m_Columns + column;
+            for (int c = m_CellStart[cell]; c < m_CellStart[cell + 1]; ++c)
+            {
+                const int i = m_CellStars[c];
+                const double xDiff = m_X[i] - x;
+                const double yDiff = m_Y[i] - y;
+                const double squaredDistance = xDiff * xDiff + yDiff * yDiff;
+                if (squaredDistance < bestSquaredDistance || (squaredDistance == bestSquaredDistance && i > bestIndex))
+                {
+                    bestIndex = i;
+                    bestSquaredDistance = squaredDistance;
+                }
+            }
         }
     }
     if (distance != nullptr) *distance = sqrt(bestSquaredDistance);
     return bestIndex;
 }
 
+// Finds the star indexed by grid that's closest to x,y and within maxDistance pixels.
+// Returns the index of the closest star, or -1 if none satisfies the criteria.
+// Fills distance to the pixel distance to the closest star.
+int StarCorrespondence::findClosestStar(double x, double y, const StarGrid &grid,
+                                        double maxDistance, double *distance) const
+{
+    if (x < -maxDistance || y < -maxDistance ||
+            x > imageWidth + maxDistance || y > imageHeight + maxDistance)
+        return -1;
+
+    return grid.findClosest(x, y, maxDistance, distance);
+}
+
 namespace
 {
 // Sorts stars by their x values, places the sorted stars into sortedStars.
@@ -133,7 +180,8 @@ void StarCorrespondence::reset()
     initialized = false;
 }
 
-int StarCorrespondence::findInternal(const QList<Edge> &stars, double maxDistance, QVector<int> *starMap,
+int StarCorrespondence::findInternal(const QList<Edge> &stars, const StarGrid &grid, double maxDistance,
+                                     QVector<int> *starMap,
                                      int guideStarIndex, const QVector<Offsets> &offsets,
                                      int *numFound, int *numNotFound, double minFraction) const
 {
@@ -182,7 +230,7 @@ int StarCorrespondence::findInternal(const QList<Edge> &stars, double maxDistanc
             const auto &offset = offsets[offsetIndex];
             double distance;
             const int closestIndex = findClosestStar(starX + offset.x, starY + offset.y,
-                                     stars, maxDistance, &distance);
+                                     grid, maxDistance, &distance);
             if (closestIndex < 0)
             {
                 // This reference star position had no corresponding input star.
@@ -326,14 +374,15 @@ Edge StarCorrespondence::find(const QList<Edge> &stars, double maxDistance,
     if (!initialized)  return foundStar;
     int numFound, numNotFound;
 
-    // findClosestStar needs an input with stars sorted by their x.
-    // Do this outside of the loops.
+    // The stars are sorted by their x, so that ties are resolved as they always were, and indexed
+    // once for all the searches of findClosestStar().
     QList<Edge> sortedStars;
     QVector<int> sortedToOriginal;
     sortByX(stars, &sortedStars, &sortedToOriginal);
+    const StarGrid grid(sortedStars, maxDistance);
 
     QVector<int> sortedStarMap;
-    int bestStarIndex = findInternal(sortedStars, maxDistance, &sortedStarMap, guideStarIndex,
+    int bestStarIndex = findInternal(sortedStars, grid, maxDistance, &sortedStarMap, guideStarIndex,
                                      guideStarOffsets, &numFound, &numNotFound, minFraction);
 
     if (bestStarIndex > -1)
@@ -367,7 +416,7 @@ Edge StarCorrespondence::find(const QList<Edge> &stars, double maxDistance,
             QVector<Offsets> gStarOffsets;
             makeOffsets(guideStarOffsets, &gStarOffsets, gStarIndex);
             QVector<int> newStarMap;
-            int detectedStarIndex = findInternal(sortedStars, maxDistance, &newStarMap,
+            int detectedStarIndex = findInternal(sortedStars, grid, maxDistance, &newStarMap,
                                                  gStarIndex, gStarOffsets,
                                                  &numFound, &numNotFound, minFraction);
             if (detectedStarIndex >= 0 && numFound > bestNumFound)
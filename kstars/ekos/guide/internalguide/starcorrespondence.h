@@ -14,6 +14,32 @@
 #include "fitsviewer/fitsdata.h"
 #include "vect.h"
 
+/*
+ * A uniform grid over a set of star positions. It is built once per set of stars, after which the
+ * stars close to a position are found by visiting the few cells around it instead of scanning
+ * the whole list.
+ */
+class StarGrid
+{
+    public:
+        // cellSize should be about the largest search distance used with findClosest().
+        StarGrid(const QList<Edge> &stars, double cellSize);
+
+        // Returns the index in stars of the star closest to x,y within maxDistance pixels,
+        // or -1 if there is none. On a tie, the star with the highest index wins.
+        // Fills distance with the pixel distance to that star.
+        int findClosest(double x, double y, double maxDistance, double *distance) const;
+
+    private:
+        QVector<float> m_X, m_Y;
+        double m_CellSize { 1 };
+        double m_MinX { 0 }, m_MinY { 0 };
+        int m_Columns { 0 }, m_Rows { 0 };
+        // The stars of cell c are m_CellStars[m_CellStart[c]] to m_CellStars[m_CellStart[c + 1] - 1].
+        QVector<int> m_CellStart;
+        QVector<int> m_CellStars;
+};
+
 /*
  * This class is useful to track a guide star by noting its position relative to other stars.
  * It is intended to be resilient to translation, a bit of positional noise, and slight field rotation.
@@ -111,7 +137,8 @@ class StarCorrespondence
         void adaptOffsets(const QList<Edge> &stars, const QVector<int> &starMap);
 
         // Utility used by find. Useful for iterating when the guide star is missing.
-        int findInternal(const QList<Edge> &stars, double maxDistance, QVector<int> *starMap,
+        // grid indexes stars.
+        int findInternal(const QList<Edge> &stars, const StarGrid &grid, double maxDistance, QVector<int> *starMap,
                          int guideStarIndex, const QVector<Offsets> &offsets,
                          int *numFound, int *numNotFound, double minFraction) const;
 
@@ -127,9 +154,8 @@ class StarCorrespondence
         Edge inventStarPosition(const QList<Edge> &stars, const QVector<int> &starMap,
                                 QVector<Offsets> offsets, Offsets offset) const;
 
-        // Finds the star closest to x,y. Returns the index in sortedStars.
-        // sortedStars should be sorted in x, which allows for a speedup in search.
-        int findClosestStar(double x, double y, const QList<Edge> sortedStars,
+        // Finds the star closest to x,y. Returns the index in the stars indexed by grid.
+        int findClosestStar(double x, double y, const StarGrid &grid,
                             double maxDistance, double *distance) const;
 
         // The offsets of the reference stars relative to the guide star.
@@ -552,6 +552,7 @@ void Manager::reset()
     RotatorUtils::release();
 
     m_DriverDevicesCount = 0;
+    m_ConnectTimers.clear();
 
     removeTabs();
 
@@ -1305,6 +1306,7 @@ void Manager::connectDevices()
     for (auto &device : devices)
     {
         qCDebug(KSTARS_EKOS) << "Connecting " << device->getDeviceName();
+        m_ConnectTimers[device->getDeviceName()].start();
         device->Connect();
     }
 
@@ -1448,6 +1450,14 @@ void Manager::deviceConnected()
 
     auto device = qobject_cast<ISD::GenericDevice *>(sender());
 
+    auto connectTimer = m_ConnectTimers.find(device->getDeviceName());
+    if (connectTimer != m_ConnectTimers.end())
+    {
+        appendLogText(i18n("%1 connected in %2 seconds.", device->getDeviceName(),
+                           QString::number(connectTimer->elapsed() / 1000.0, 'f', 1)));
+        m_ConnectTimers.erase(connectTimer);
+    }
+
     if (Options::verboseLogging())
     {
         qCInfo(KSTARS_EKOS) << device->getDeviceName()
@@ -3140,6 +3150,9 @@ void Manager::connectModules()
 
             connect(guideModule(), &Ekos::Guide::guideStats,
                     analyzeProcess.get(), &Ekos::Analyze::guideStats, Qt::UniqueConnection);
+
+            connect(guideModule(), &Ekos::Guide::guideLatency,
+                    analyzeProcess.get(), &Ekos::Analyze::guideLatency, Qt::UniqueConnection);
         }
     }
 
@@ -3423,6 +3436,7 @@ void Manager::setDeviceReady()
                 else
                 {
                     qCInfo(KSTARS_EKOS) << "Connecting to" << device->getDeviceName();
+                    m_ConnectTimers[device->getDeviceName()].start();
                     device->Connect();
                 }
             }
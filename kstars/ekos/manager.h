@@ -23,6 +23,7 @@
 #include "ekos/capture/rotatorsettings.h"
 
 #include <QDialog>
+#include <QElapsedTimer>
 #include <QHash>
 
 #include <memory>
@@ -563,6 +564,9 @@ class Manager : public QDialog, public Ui::Manager
         std::unique_ptr<Selector::Dialog> m_PortSelector;
         QTimer m_PortSelectorTimer;
 
+        // Started when a device is asked to connect, for its connection time in the log
+        QMap<QString, QElapsedTimer> m_ConnectTimers;
+
         QMap<QString, QSharedPointer<FilterManager>> m_FilterManagers;
         QMap<QString, QSharedPointer<RotatorSettings>> m_RotatorControllers;
 
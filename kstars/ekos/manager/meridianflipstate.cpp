@@ -9,14 +9,37 @@
 #include "Options.h"
 
 #include "kstarsdata.h"
+#include "kstarsdatetime.h"
 #include "indicom.h"
 
 #include <ekos_capture_debug.h>
 
+#include <cmath>
+
 namespace Ekos
 {
+
+namespace
+{
+
+// Prediction and coordinates may differ by this much, in hours of hour angle, before the flip timer is re-armed
+constexpr double FLIP_TIME_TOLERANCE_HRS = 30.0 / 3600.0;
+
+QString flipCountdownText(double hrsToFlip)
+{
+    int hh = static_cast<int> (hrsToFlip);
+    int mm = static_cast<int> ((hrsToFlip - hh) * 60);
+    int ss = static_cast<int> ((hrsToFlip - hh - mm / 60.0) * 3600);
+    return i18n("Meridian flip in %1", QTime(hh, mm, ss).toString(Qt::TextDate));
+}
+
+}
+
 MeridianFlipState::MeridianFlipState(QObject *parent) : QObject(parent)
 {
+    m_FlipTimer.setSingleShot(true);
+    m_FlipTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_FlipTimer, &QTimer::timeout, this, &MeridianFlipState::processFlipTime);
 }
 
 QString MeridianFlipState::MFStageString(MFStage stage)
@@ -122,6 +145,9 @@ void MeridianFlipState::updateMeridianFlipStage(const MFStage &stage)
 bool MeridianFlipState::checkMeridianFlip(dms lst)
 {
     // checks if a flip is possible
+    // the timer is armed again below if the flip is still ahead
+    m_FlipTimer.stop();
+
     if (m_hasMount == false)
     {
         publishMFMountStatusText(i18n("Meridian flip inactive (no scope connected)"));
@@ -196,10 +222,7 @@ bool MeridianFlipState::checkMeridianFlip(dms lst)
         ha -= 24.0;
     hrsToFlip = offset + getFlipDelayHrs() - ha;
 
-    int hh = static_cast<int> (hrsToFlip);
-    int mm = static_cast<int> ((hrsToFlip - hh) * 60);
-    int ss = static_cast<int> ((hrsToFlip - hh - mm / 60.0) * 3600);
-    QString message = i18n("Meridian flip in %1", QTime(hh, mm, ss).toString(Qt::TextDate));
+    QString message = flipCountdownText(hrsToFlip);
 
     // handle the meridian flip state machine
     switch (getMeridianFlipMountState())
@@ -222,6 +245,9 @@ bool MeridianFlipState::checkMeridianFlip(dms lst)
                 initialPierSide = currentPosition.pierSide;
                 updateMFMountState(MOUNT_FLIP_PLANNED);
             }
+            // a tracking mount reaches the flip at a predictable time
+            else if (m_MountStatus == ISD::Mount::MOUNT_TRACKING)
+                armFlipTimer(hrsToFlip);
             break;
 
         case MOUNT_FLIP_PLANNED:
@@ -486,6 +512,10 @@ void MeridianFlipState::setMountStatus(ISD::Mount::Status status)
     qCDebug(KSTARS_EKOS_MOUNT) << "New mount state for MF:" << ISD::Mount::mountStates[status];
     m_PrevMountStatus = m_MountStatus;
     m_MountStatus = status;
+
+    // the flip time only holds while tracking, the next coordinate update predicts it again
+    if (status != ISD::Mount::MOUNT_TRACKING)
+        m_FlipTimer.stop();
 }
 
 void MeridianFlipState::setMountParkStatus(ISD::ParkStatus status)
@@ -510,6 +540,7 @@ void MeridianFlipState::updatePosition(MountPosition &pos, const SkyPoint &posit
 void MeridianFlipState::updateTelescopeCoord(const SkyPoint &position, ISD::Mount::PierSide pierSide, const dms &ha)
 {
     updatePosition(currentPosition, position, pierSide, ha, true);
+    m_PositionAge.restart();
 
     // If we just finished a slew, let's update initialHA and the current target's position,
     // but only if the meridian flip is enabled
@@ -526,10 +557,18 @@ void MeridianFlipState::updateTelescopeCoord(const SkyPoint &position, ISD::Moun
                                    meridianFlipStatusString(meridianFlipMountState);
         // ensure that this is executed only once
         m_PrevMountStatus = m_MountStatus;
+        // new target, predict its flip time again
+        m_FlipTimer.stop();
     }
 
-    QChar sgn(ha.Hours() <= 12.0 ? '+' : '-');
+    if (verifyFlipTime())
+        return;
+
+    processMeridianFlipCheck();
+}
 
+void MeridianFlipState::processMeridianFlipCheck()
+{
     dms lst = KStarsData::Instance()->geo()->GSTtoLST(KStarsData::Instance()->clock()->utc().gst());
 
     // don't check the meridian flip while in motion
@@ -547,6 +586,49 @@ void MeridianFlipState::updateTelescopeCoord(const SkyPoint &position, ISD::Moun
     }
 }
 
+void MeridianFlipState::armFlipTimer(double hrsToFlip)
+{
+    // hour angle runs at sidereal rate
+    const int msecs = static_cast<int>(std::ceil(hrsToFlip * 3600000.0 / SIDEREALSECOND));
+    const double flipHA = currentPosition.ha.HoursHa() + hrsToFlip;
+
+    if (m_FlipTimer.isActive() && currentPosition.pierSide == m_FlipPierSide &&
+            std::abs(rangeHA(flipHA - m_FlipHA)) < FLIP_TIME_TOLERANCE_HRS)
+        return;
+
+    m_FlipHA = flipHA;
+    m_FlipPierSide = currentPosition.pierSide;
+    m_FlipTimer.start(msecs);
+    qCDebug(KSTARS_EKOS_MOUNT) << "Meridian flip expected at" << QDateTime::currentDateTimeUtc().addMSecs(msecs).toString(
+                                   Qt::ISODate) << "ha=" << rangeHA(flipHA);
+}
+
+bool MeridianFlipState::verifyFlipTime()
+{
+    if (!m_FlipTimer.isActive() || getMeridianFlipMountState() != MOUNT_FLIP_NONE || !isEnabled()
+            || m_MountStatus != ISD::Mount::MOUNT_TRACKING || currentPosition.pierSide != m_FlipPierSide)
+        return false;
+
+    const double hrsToFlip = m_FlipTimer.remainingTime() * SIDEREALSECOND / 3600000.0;
+    if (std::abs(rangeHA(m_FlipHA - currentPosition.ha.HoursHa() - hrsToFlip)) >= FLIP_TIME_TOLERANCE_HRS)
+    {
+        qCDebug(KSTARS_EKOS_MOUNT) << "Mount position does not match the expected meridian flip time, checking again.";
+        return false;
+    }
+
+    publishMFMountStatusText(flipCountdownText(hrsToFlip));
+    return true;
+}
+
+void MeridianFlipState::processFlipTime()
+{
+    // the last coordinates are from a while ago, the hour angle has moved on since
+    const double hours = currentPosition.ha.Hours() + m_PositionAge.elapsed() * SIDEREALSECOND / 3600000.0;
+    currentPosition.ha = dms(hours * 15.0);
+    m_PositionAge.restart();
+    processMeridianFlipCheck();
+}
+
 void MeridianFlipState::setTargetPosition(SkyPoint *pos)
 {
     if (pos != nullptr)
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <QElapsedTimer>
 #include <QObject>
+#include <QTimer>
 #include "skypoint.h"
 
 #include <ekos_mount_debug.h>
@@ -103,7 +105,7 @@ public:
     void setEnabled(bool value);
     // offset past the meridian
     double getOffset() const { return m_offset; }
-    void setOffset(double newOffset) { m_offset = newOffset; }
+    void setOffset(double newOffset) { m_offset = newOffset; m_FlipTimer.stop(); }
 
     /**
      * @brief connectMount Establish the connection to the mount
@@ -173,7 +175,7 @@ public:
     MeridianFlipMountState getMeridianFlipMountState() const { return meridianFlipMountState; }
 
     double getFlipDelayHrs() const { return flipDelayHrs; }
-    void setFlipDelayHrs(double value) { flipDelayHrs = value; }
+    void setFlipDelayHrs(double value) { flipDelayHrs = value; m_FlipTimer.stop(); }
 
     /**
      * @brief Change the meridian flip mount state
@@ -267,6 +269,15 @@ private:
 
     double flipDelayHrs = 0.0;      // delays the next flip attempt if it fails
 
+    // While tracking, the flip is planned by a timer armed for the predicted flip time. Coordinate
+    // updates only verify the prediction, and re-arm the timer when it no longer holds.
+    QTimer m_FlipTimer;
+    // hour angle of the mount and pier side at the predicted flip
+    double m_FlipHA { 0 };
+    ISD::Mount::PierSide m_FlipPierSide { ISD::Mount::PIER_UNKNOWN };
+    // age of currentPosition, to extrapolate the hour angle when the timer fires
+    QElapsedTimer m_PositionAge;
+
     /**
      * @brief Internal method for changing the mount meridian flip state. From extermal, use {@see updateMFMountState()}
      */
@@ -284,6 +295,27 @@ private:
      */
     void startMeridianFlip();
 
+    /**
+     * @brief Check the meridian flip at the current position and start it if necessary.
+     */
+    void processMeridianFlipCheck();
+
+    /**
+     * @brief Arm the flip timer for a flip in hrsToFlip hours of hour angle, unless it is already armed for that time.
+     */
+    void armFlipTimer(double hrsToFlip);
+
+    /**
+     * @brief Check a coordinate update against the armed flip time.
+     * @return true if the timer is armed and the update agrees with it, so no complete check is necessary
+     */
+    bool verifyFlipTime();
+
+    /**
+     * @brief The flip timer has fired: bring the hour angle up to now and check the flip.
+     */
+    void processFlipTime();
+
     /**
      * @brief Calculate the minimal end time from now plus {@see minMeridianFlipEndTime}
      */
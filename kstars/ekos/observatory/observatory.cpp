@@ -67,10 +67,12 @@ Observatory::Observatory()
     connect(&warningTimer, &QTimer::timeout, [this]()
     {
         execute(m_WarningActions);
+        updateActionsStatus();
     });
     connect(&alertTimer, &QTimer::timeout, [this]()
     {
         execute(m_AlertActions);
+        updateActionsStatus();
     });
 
     connect(weatherSourceCombo, &QComboBox::currentTextChanged, this, &Observatory::setWeatherSource);
@@ -90,11 +92,8 @@ Observatory::Observatory()
         setAutoScaleValues(checked);
         refreshSensorGraph();
     });
-    connect(&weatherStatusTimer, &QTimer::timeout, [this]()
-    {
-        weatherWarningStatusLabel->setText(getWarningActionsStatus());
-        weatherAlertStatusLabel->setText(getAlertActionsStatus());
-    });
+    weatherStatusTimer.setInterval(1000);
+    connect(&weatherStatusTimer, &QTimer::timeout, this, &Observatory::updateActionsStatus);
 
 
 }
@@ -108,6 +107,8 @@ bool Observatory::setDome(ISD::Dome *device)
         m_Dome->disconnect(this);
 
     m_Dome = device;
+    m_DomeStatus = ISD::Dome::DOME_IDLE;
+    m_DomeStatusKnown = false;
 
     domeBox->setEnabled(true);
 
@@ -235,6 +236,11 @@ void Observatory::shutdownDome()
 
 void Observatory::setDomeStatus(ISD::Dome::Status status)
 {
+    if (m_DomeStatusKnown && status == m_DomeStatus)
+        return;
+    m_DomeStatus = status;
+    m_DomeStatusKnown = true;
+
     qCDebug(KSTARS_EKOS_OBSERVATORY) << "Setting dome status to " << status;
 
     switch (status)
@@ -538,7 +544,7 @@ void Observatory::initWeather()
     setWarningActions(getWarningActions());
     setAlertActions(getAlertActions());
     initWeatherActions(true);
-    weatherStatusTimer.start(1000);
+    updateActionsStatus();
 }
 
 void Observatory::shutdownWeather()
@@ -751,12 +757,11 @@ void Observatory::setWeatherStatus(ISD::Weather::Status status)
 
         weatherStatusLabel->setPixmap(QIcon::fromTheme(label).pixmap(QSize(28, 28)));
         m_WeatherStatus = status;
-    }
-
-    // update weather sensor data
-    if (m_WeatherSource)
-        updateSensorData(m_WeatherSource->data());
 
+        // update weather sensor data, later changes arrive through newData
+        if (m_WeatherSource)
+            updateSensorData(m_WeatherSource->data());
+    }
 }
 
 void Observatory::initSensorGraphs()
@@ -974,6 +979,7 @@ void Observatory::setWarningActionsActive(bool active)
     // start warning timer if activated
     else if (m_WeatherSource->status() == ISD::Weather::WEATHER_WARNING)
         startWarningTimer();
+    updateActionsStatus();
 }
 
 void Observatory::startWarningTimer()
@@ -985,6 +991,7 @@ void Observatory::startWarningTimer()
     }
     else if (warningTimer.isActive())
         warningTimer.stop();
+    updateActionsStatus();
 }
 
 void Observatory::setAlertActionsActive(bool active)
@@ -998,6 +1005,7 @@ void Observatory::setAlertActionsActive(bool active)
     // start alert timer if activated
     else if (m_WeatherSource->status() == ISD::Weather::WEATHER_ALERT)
         startAlertTimer();
+    updateActionsStatus();
 }
 
 void Observatory::setAutoScaleValues(bool value)
@@ -1015,6 +1023,7 @@ void Observatory::startAlertTimer()
     }
     else if (alertTimer.isActive())
         alertTimer.stop();
+    updateActionsStatus();
 }
 
 QString Observatory::getWarningActionsStatus()
@@ -1039,6 +1048,21 @@ QString Observatory::getAlertActionsStatus()
     return i18n("Status: inactive");
 }
 
+void Observatory::updateActionsStatus()
+{
+    weatherWarningStatusLabel->setText(getWarningActionsStatus());
+    weatherAlertStatusLabel->setText(getAlertActionsStatus());
+
+    // The countdown only needs refreshing while one of the delays runs
+    if (warningTimer.isActive() || alertTimer.isActive())
+    {
+        if (!weatherStatusTimer.isActive())
+            weatherStatusTimer.start();
+    }
+    else
+        weatherStatusTimer.stop();
+}
+
 void Observatory::weatherChanged(ISD::Weather::Status status)
 {
     switch (status)
@@ -1058,6 +1082,7 @@ void Observatory::weatherChanged(ISD::Weather::Status status)
         default:
             break;
     }
+    updateActionsStatus();
     //emit newStatus(status);
 }
 
@@ -84,8 +84,9 @@ class Observatory : public QWidget, public Ui::Observatory
         QStringList m_LogText;
         void appendLogText(const QString &);
 
-        // timer for refreshing the observatory status
+        // timer refreshing the countdown of the weather actions, running only while one is pending
         QTimer weatherStatusTimer;
+        void updateActionsStatus();
 
         // reacting on weather changes
         void setWarningActions(WeatherActions actions);
@@ -206,6 +207,8 @@ class Observatory : public QWidget, public Ui::Observatory
 
     private:
         ISD::Dome *m_Dome {nullptr};
+        ISD::Dome::Status m_DomeStatus { ISD::Dome::DOME_IDLE };
+        bool m_DomeStatusKnown { false };
         ISD::Weather *m_WeatherSource {nullptr};
         QList<ISD::Weather *> m_WeatherSources;
 
@@ -17,10 +17,14 @@
 #include "ekos/manager.h"
 #include "ekos/mount/mount.h"
 #include "schedulerprocess.h"
+#include "schedulerutils.h"
 #include "skymapcomposite.h"
 #include "ksparser.h"
+#include "ksnotification.h"
 
 #include <QDBusReply>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 
 namespace Ekos
 {
@@ -620,22 +624,23 @@ void FramingAssistantUI::createJobs()
     else if (completionVal == "FinishLoop")
         completionSettings = {{"loopCheck", true}};
 
+    // The template is read once here, the sequence files of all tiles are then written in the background
+    QFile sequenceFile(sequence);
+    if (!sequenceFile.open(QIODevice::ReadOnly))
+    {
+        KSNotification::sorry(i18n("Unable to open file %1", sequence), i18n("Could Not Open File"));
+        return;
+    }
+    const QByteArray sequenceData = sequenceFile.readAll();
+    sequenceFile.close();
+
+    QStringList prefixes;
+    QList<QVariantMap> jobSettings;
     int batchCount = 0;
     for (auto oneTile : tiles->tiles())
     {
         batchCount++;
-        XMLEle *root = scheduler->process()->getSequenceJobRoot(sequence);
-        if (root == nullptr)
-            return;
-
         const auto oneTarget = QString("%1-Part_%2").arg(target).arg(batchCount);
-        if (scheduler->process()->createJobSequence(root, oneTarget, outputDirectory) == false)
-        {
-            delXMLEle(root);
-            return;
-        }
-
-        delXMLEle(root);
         auto oneSequence = QString("%1/%2.esq").arg(outputDirectory, oneTarget);
 
         // First job should Always focus if possible
@@ -656,15 +661,48 @@ void FramingAssistantUI::createJobs()
             {"schedulerGuideStep", ui->guideStepCheck->isChecked()}
         };
 
-        scheduler->setAllSettings(settings);
-        scheduler->saveJob();
+        prefixes.append(oneTarget);
+        jobSettings.append(settings);
     }
 
-    auto schedulerListFile = QString("%1/%2.esl").arg(outputDirectory, target);
-    scheduler->process()->saveScheduler(QUrl::fromLocalFile(schedulerListFile));
-    accept();
-    Ekos::Manager::Instance()->activateModule(i18n("Scheduler"), true);
-    scheduler->updateJobTable();
+    ui->createJobsB->setEnabled(false);
+
+    auto watcher = new QFutureWatcher<QString>(this);
+    connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher, scheduler, jobSettings, outputDirectory, target]()
+    {
+        watcher->deleteLater();
+        ui->createJobsB->setEnabled(true);
+
+        const QString errorText = watcher->result();
+        if (!errorText.isEmpty())
+        {
+            KSNotification::sorry(errorText, i18n("Could Not Open File"));
+            return;
+        }
+
+        for (const auto &settings : jobSettings)
+        {
+            scheduler->setAllSettings(settings);
+            scheduler->saveJob();
+        }
+
+        auto schedulerListFile = QString("%1/%2.esl").arg(outputDirectory, target);
+        scheduler->process()->saveScheduler(QUrl::fromLocalFile(schedulerListFile));
+        accept();
+        Ekos::Manager::Instance()->activateModule(i18n("Scheduler"), true);
+        scheduler->updateJobTable();
+    });
+
+    watcher->setFuture(QtConcurrent::run([sequenceData, prefixes, outputDirectory]()
+    {
+        QString errorText;
+        for (const auto &prefix : prefixes)
+        {
+            if (SchedulerUtils::writeJobSequence(sequenceData, prefix, outputDirectory, errorText) == false)
+                break;
+        }
+        return errorText;
+    }));
 }
 
 void FramingAssistantUI::setMountState(ISD::Mount::Status value)
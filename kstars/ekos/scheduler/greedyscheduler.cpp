@@ -15,11 +15,16 @@
 #include "schedulerjob.h"
 #include "schedulerutils.h"
 
+#include <QtConcurrent>
+
 #define TEST_PRINT if (false) fprintf
 
 // Can make the scheduling a bit faster by sampling every other minute instead of every minute.
 constexpr int SCHEDULE_RESOLUTION_MINUTES = 2;
 
+// With at least this many jobs, selectNextJob() searches their start times in parallel.
+constexpr int PARALLEL_SEARCH_JOBS = 16;
+
 namespace Ekos
 {
 
@@ -60,7 +65,26 @@ void GreedyScheduler::scheduleJobs(const QList<SchedulerJob *> &jobs,
 
     prepareJobsForEvaluation(jobs, now, capturedFramesCount, logger);
 
+    // Jobs that didn't change since the previous schedule get their constraint timelines back,
+    // and the simulation replays the previous one until the first step a change could affect.
+    m_Changes.clear();
+    m_Replay = findChanges(jobs, &m_Changes);
+
+    // The constraints of all jobs are computed once, in parallel, for the next few days.
+    // The simulated copies of the jobs share them.
+    SchedulerJob::computeTimelines(jobs, now);
+
+    PreviousSchedule previous;
+    previous.jobs = jobs;
+    previous.settings = scheduleSettings();
+    for (auto job : jobs)
+        previous.inputs.append(std::make_shared<const SchedulerJob>(*job));
+
+    m_Steps.clear();
     scheduledJob = selectNextJob(jobs, now, nullptr, SIMULATE, &when, nullptr, nullptr, &capturedFramesCount);
+    m_Replay = false;
+    previous.steps = m_Steps;
+    m_Previous = previous;
     auto schedule = getSchedule();
     if (logger != nullptr)
     {
@@ -109,6 +133,9 @@ bool GreedyScheduler::checkJob(const QList<SchedulerJob *> &jobs,
             (m_LastCheckJobSim.isValid() && m_LastCheckJobSim.secsTo(now) < 60))
         simType = DONT_SIMULATE;
 
+    // Only computed again when the timelines get old
+    SchedulerJob::computeTimelines(jobs, now);
+
     const SchedulerJob *next = selectNextJob(jobs, now, currentJob, simType, &startTime);
     if (next == currentJob && now.secsTo(startTime) <= 1)
     {
@@ -273,8 +300,92 @@ QDateTime firstPossibleStart(const SchedulerJob *job, const QDateTime &now,
         possibleStart = now;
     return possibleStart;
 }
+
+// Whether everything about a job that selectNextJob() and simulate() look at is the same.
+bool sameInputs(const SchedulerJob &a, const SchedulerJob &b)
+{
+    return a.getName() == b.getName() && a.getGroup() == b.getGroup() && a.getState() == b.getState() &&
+           a.getTargetCoords().ra0().Degrees() == b.getTargetCoords().ra0().Degrees() &&
+           a.getTargetCoords().dec0().Degrees() == b.getTargetCoords().dec0().Degrees() &&
+           a.getMinAltitude() == b.getMinAltitude() && a.getMinMoonSeparation() == b.getMinMoonSeparation() &&
+           a.getEnforceTwilight() == b.getEnforceTwilight() &&
+           a.getEnforceArtificialHorizon() == b.getEnforceArtificialHorizon() &&
+           a.getFileStartupCondition() == b.getFileStartupCondition() && a.getFileStartupTime() == b.getFileStartupTime() &&
+           a.getStartupCondition() == b.getStartupCondition() &&
+           a.getCompletionCondition() == b.getCompletionCondition() && a.getCompletionTime() == b.getCompletionTime() &&
+           a.getEstimatedTime() == b.getEstimatedTime() && a.getEstimatedTimePerRepeat() == b.getEstimatedTimePerRepeat() &&
+           a.getEstimatedTimeLeftThisRepeat() == b.getEstimatedTimeLeftThisRepeat() &&
+           a.getEstimatedStartupTime() == b.getEstimatedStartupTime() &&
+           a.getCompletedIterations() == b.getCompletedIterations() &&
+           a.getLastAbortTime() == b.getLastAbortTime() && a.getLastErrorTime() == b.getLastErrorTime();
+}
 }  // namespace
 
+QString GreedyScheduler::scheduleSettings() const
+{
+    return SchedulerJob::constraintSettings() +
+           QString(" %1 %2 %3 %4 %5").arg(rescheduleAbortsImmediate).arg(rescheduleAbortsQueue)
+           .arg(rescheduleErrors).arg(abortDelaySeconds).arg(errorDelaySeconds) +
+           QString(" %1 %2 %3").arg(Options::greedyScheduling()).arg(Options::rememberJobProgress())
+           .arg(Options::schedulerRepeatSequences());
+}
+
+bool GreedyScheduler::findChanges(const QList<SchedulerJob *> &jobs, QList<int> *changed)
+{
+    // The repeated simulations of "repeat after completion" aren't kept.
+    if (m_Previous.jobs != jobs || m_Previous.settings != scheduleSettings() ||
+            (!Options::rememberJobProgress() && Options::schedulerRepeatSequences()))
+        return false;
+
+    for (int i = 0; i < jobs.size(); ++i)
+    {
+        const SchedulerJob &previous = *m_Previous.inputs[i];
+        jobs[i]->reuseTimeline(previous);
+        if (sameInputs(*jobs[i], previous))
+            continue;
+
+        // START_AT jobs take precedence over the whole queue.
+        if (jobs[i]->getFileStartupCondition() == START_AT || previous.getFileStartupCondition() == START_AT)
+            return false;
+        changed->append(i);
+    }
+    return true;
+}
+
+bool GreedyScheduler::canReplay(const QList<SchedulerJob *> &simJobs, const QDateTime &simTime, int step,
+                                const QList<int> &changed) const
+{
+    if (step >= m_Previous.steps.size())
+        return false;
+
+    const SimulationStep &previous = m_Previous.steps[step];
+    if (changed.contains(previous.job))
+        return false;
+
+    // Group members can be run in place of the selected job, and repeats look ahead at other times.
+    const QString &group = simJobs[previous.job]->getGroup();
+    if (!group.isEmpty() && !changed.isEmpty())
+        return false;
+
+    // Each changed job must start when it did, or not have been looked at.
+    for (int i : changed)
+    {
+        auto it = previous.startTimes.find(i);
+        if (it == previous.startTimes.end())
+            continue;
+
+        SchedulerJob * const job = simJobs[i];
+        QDateTime startTime;
+        if (allowJob(job, rescheduleAbortsImmediate, rescheduleAbortsQueue, rescheduleErrors))
+            startTime = job->getNextPossibleStartTime(
+                            firstPossibleStart(job, simTime, rescheduleAbortsQueue, abortDelaySeconds, rescheduleErrors,
+                                               errorDelaySeconds), SCHEDULE_RESOLUTION_MINUTES, false);
+        if (startTime != it.value())
+            return false;
+    }
+    return true;
+}
+
 // Consider all jobs marked as JOB_EVALUATION/ABORT/ERROR. Assume ordered by highest priority first.
 // - Find the job with the earliest start time (given constraints like altitude, twilight, ...)
 //   that can run for at least 10 minutes before a higher priority job.
@@ -296,7 +407,7 @@ QDateTime firstPossibleStart(const SchedulerJob *job, const QDateTime &now,
 SchedulerJob *GreedyScheduler::selectNextJob(const QList<SchedulerJob *> &jobs, const QDateTime &now,
         const SchedulerJob * const currentJob, SimulationType simType, QDateTime *when,
         QDateTime *nextInterruption, QString *interruptReason,
-        const QMap<QString, uint16_t> *capturedFramesCount)
+        const QMap<QString, uint16_t> *capturedFramesCount, QHash<int, QDateTime> *startTimes)
 {
     // Don't schedule a job that will be preempted in less than MIN_RUN_SECS.
     constexpr int MIN_RUN_SECS = 10 * 60;
@@ -311,23 +422,57 @@ SchedulerJob *GreedyScheduler::selectNextJob(const QList<SchedulerJob *> &jobs,
     SchedulerJob * nextJob = nullptr;
     QString interruptStr;
 
-    for (int i = 0; i < jobs.size(); ++i)
+    // Find the first time job i can meet all its constraints.
+    auto searchStartTime = [&](int i)
     {
         SchedulerJob * const job = jobs[i];
-        const bool evaluatingCurrentJob = (currentJob && (job == currentJob));
-
-        if (!allowJob(job, rescheduleAbortsImmediate, rescheduleAbortsQueue, rescheduleErrors))
-            continue;
-
         // If the job state is abort or error, might have to delay the first possible start time.
         QDateTime startSearchingtAt = firstPossibleStart(
                                           job, now, rescheduleAbortsQueue, abortDelaySeconds, rescheduleErrors, errorDelaySeconds);
 
-        // Find the first time this job can meet all its constraints.
         // I found that passing in an "until" 4th argument actually hurt performance, as it reduces
         // the effectiveness of the cache that getNextPossibleStartTime uses.
-        const QDateTime startTime = job->getNextPossibleStartTime(startSearchingtAt, SCHEDULE_RESOLUTION_MINUTES,
-                                    evaluatingCurrentJob);
+        return job->getNextPossibleStartTime(startSearchingtAt, SCHEDULE_RESOLUTION_MINUTES,
+                                             currentJob && (job == currentJob));
+    };
+
+    // The searches of the jobs don't depend on each other and are most of the work here. With many jobs,
+    // they are all run at once on the thread pool and the loops below look the results up. The jobs are
+    // still considered one after the other by priority, so the selection doesn't depend on which search
+    // finishes first.
+    std::vector<QDateTime> searchedStartTimes;
+    if (jobs.size() >= PARALLEL_SEARCH_JOBS)
+    {
+        QVector<int> allowed;
+        for (int i = 0; i < jobs.size(); ++i)
+        {
+            if (allowJob(jobs[i], rescheduleAbortsImmediate, rescheduleAbortsQueue, rescheduleErrors))
+                allowed.append(i);
+        }
+        searchedStartTimes.resize(jobs.size());
+        QtConcurrent::blockingMap(allowed, [&](int &i)
+        {
+            searchedStartTimes[i] = searchStartTime(i);
+        });
+    }
+    auto nextPossibleStartTime = [&](int i)
+    {
+        return searchedStartTimes.empty() ? searchStartTime(i) : searchedStartTimes[i];
+    };
+
+    for (int i = 0; i < jobs.size(); ++i)
+    {
+        SchedulerJob * const job = jobs[i];
+        const bool evaluatingCurrentJob = (currentJob && (job == currentJob));
+
+        if (!allowJob(job, rescheduleAbortsImmediate, rescheduleAbortsQueue, rescheduleErrors))
+        {
+            if (startTimes) (*startTimes)[i] = QDateTime();
+            continue;
+        }
+
+        const QDateTime startTime = nextPossibleStartTime(i);
+        if (startTimes) (*startTimes)[i] = startTime;
         if (startTime.isValid())
         {
             if (nextJob == nullptr)
@@ -392,15 +537,14 @@ SchedulerJob *GreedyScheduler::selectNextJob(const QList<SchedulerJob *> &jobs,
             if (atJob->getFileStartupCondition() == START_AT && atTime.isValid())
             {
                 if (!allowJob(atJob, rescheduleAbortsImmediate, rescheduleAbortsQueue, rescheduleErrors))
+                {
+                    if (startTimes) (*startTimes)[i] = QDateTime();
                     continue;
-                // If the job state is abort or error, might have to delay the first possible start time.
-                QDateTime startSearchingtAt = firstPossibleStart(
-                                                  atJob, now, rescheduleAbortsQueue, abortDelaySeconds, rescheduleErrors,
-                                                  errorDelaySeconds);
+                }
                 // atTime above is the user-specified start time. atJobStartTime is the time it can
                 // actually start, given all the constraints (altitude, twilight, etc).
-                const QDateTime atJobStartTime = atJob->getNextPossibleStartTime(startSearchingtAt, SCHEDULE_RESOLUTION_MINUTES, currentJob
-                                                 && (atJob == currentJob));
+                const QDateTime atJobStartTime = nextPossibleStartTime(i);
+                if (startTimes) (*startTimes)[i] = atJobStartTime;
                 if (atJobStartTime.isValid())
                 {
                     // This difference between the user-specified start time, and the time it can really start.
@@ -463,13 +607,8 @@ SchedulerJob *GreedyScheduler::selectNextJob(const QList<SchedulerJob *> &jobs,
 
                 const bool evaluatingCurrentJob = (currentJob && (job == currentJob));
 
-                // If the job state is abort or error, might have to delay the first possible start time.
-                QDateTime startSearchingtAt = firstPossibleStart(
-                                                  job, now, rescheduleAbortsQueue, abortDelaySeconds, rescheduleErrors, errorDelaySeconds);
-
-                // Find the first time this job can meet all its constraints.
-                const QDateTime startTime = job->getNextPossibleStartTime(startSearchingtAt, SCHEDULE_RESOLUTION_MINUTES,
-                                            evaluatingCurrentJob);
+                const QDateTime startTime = nextPossibleStartTime(i);
+                if (startTimes) (*startTimes)[i] = startTime;
 
                 // Only consider jobs that can start soon.
                 if (!startTime.isValid() || startTime.secsTo(nextStart) > MAX_INTERRUPT_SECS)
@@ -575,86 +714,178 @@ QDateTime GreedyScheduler::simulate(const QList<SchedulerJob *> &jobs, const QDa
     for(int i = 0; i < simJobs.size(); ++i)
         workDone[simJobs[i]] = 0.0;
 
+    // Only the simulation of scheduleJobs() is kept, and it may replay the previous one. See findChanges().
+    const bool recording = (simType == SIMULATE);
+    bool replaying = recording && m_Replay && !m_Previous.steps.isEmpty();
+    QList<int> replayChanges = m_Changes;
+    int replayedSteps = 0;
+    QList<SimulationStep> steps;
+    m_Replay = false;
+
     while (true)
     {
-        QDateTime jobStartTime;
-        QDateTime jobInterruptTime;
-        QString interruptReason;
-        // Find the next job to be scheduled, when it starts, and when a higher priority
-        // job might preempt it, why it would be preempted.
-        // Note: 4th arg, fullSchedule, must be false or we'd loop forever.
-        SchedulerJob *selectedJob = selectNextJob(
-                                        simJobs, simTime, nullptr, DONT_SIMULATE, &jobStartTime, &jobInterruptTime, &interruptReason);
-        if (selectedJob == nullptr)
-            break;
+        SchedulerJob *selectedJob = nullptr;
+        QDateTime jobStartTime, jobStopTime;
+        QString stopReason;
+        QHash<int, QDateTime> startTimes;
 
-        TEST_PRINT(stderr, "%d   %s\n", __LINE__, QString("%1 starting at %2 interrupted at \"%3\" reason \"%4\"")
-                   .arg(selectedJob->getName()).arg(jobStartTime.toString("MM/dd hh:mm"))
-                   .arg(jobInterruptTime.toString("MM/dd hh:mm")).arg(interruptReason).toLatin1().data());
-        // Are we past the end time?
-        if (endTime.isValid() && jobStartTime.secsTo(endTime) < 0) break;
-
-        // It's possible there are start_at jobs that can preempt this job.
-        // Find the next start_at time, and use that as an end constraint to getNextEndTime
-        // if it's before jobInterruptTime.
-        QDateTime nextStartAtTime;
-        foreach (SchedulerJob *job, simJobs)
-        {
-            if (job != selectedJob &&
-                    job->getStartupCondition() == START_AT &&
-                    jobStartTime.secsTo(job->getStartupTime()) > 0 &&
-                    (job->getState() == SCHEDJOB_EVALUATION ||
-                     job->getState() == SCHEDJOB_SCHEDULED))
-            {
-                QDateTime startAtTime = job->getStartupTime();
-                if (!nextStartAtTime.isValid() || nextStartAtTime.secsTo(startAtTime) < 0)
-                    nextStartAtTime = startAtTime;
-            }
-        }
-        // Check to see if the above start-at stop time is before the interrupt stop time.
-        QDateTime constraintStopTime = jobInterruptTime;
-        if (nextStartAtTime.isValid() &&
-                (!constraintStopTime.isValid() ||
-                 nextStartAtTime.secsTo(constraintStopTime) < 0))
-            constraintStopTime = nextStartAtTime;
-
-        QString constraintReason;
-        // Get the time that this next job would fail its constraints, and a human-readable explanation.
-        QDateTime jobConstraintTime = selectedJob->getNextEndTime(jobStartTime, SCHEDULE_RESOLUTION_MINUTES, &constraintReason,
-                                      constraintStopTime);
-        if (nextStartAtTime.isValid() && jobConstraintTime.isValid() &&
-                std::abs(jobConstraintTime.secsTo(nextStartAtTime)) < 2 * SCHEDULE_RESOLUTION_MINUTES)
-            constraintReason = "interrupted by start-at job";
-        TEST_PRINT(stderr, "%d   %s\n", __LINE__,     QString("  constraint \"%1\" reason \"%2\"")
-                   .arg(jobConstraintTime.toString("MM/dd hh:mm")).arg(constraintReason).toLatin1().data());
-        QDateTime jobCompletionTime;
-        if (selectedJob->getEstimatedTime() > 0)
+        // Replay the step of the previous simulation if none of the changes could affect it.
+        if (replaying && iterations > 0 && (replaying = canReplay(simJobs, simTime, iterations, replayChanges)))
         {
-            // Estimate when the job might complete, if it was allowed to run without interruption.
-            const int timeLeft = selectedJob->getEstimatedTime() - workDone[selectedJob];
-            jobCompletionTime = jobStartTime.addSecs(timeLeft);
-            TEST_PRINT(stderr, "%d   %s\n", __LINE__, QString("  completion \"%1\" time left %2s")
-                       .arg(jobCompletionTime.toString("MM/dd hh:mm")).arg(timeLeft).toLatin1().data());
+            const SimulationStep &previous = m_Previous.steps[iterations];
+            selectedJob = simJobs[previous.job];
+            jobStartTime = previous.start;
+            jobStopTime = previous.stop;
+            stopReason = previous.reason;
+            startTimes = previous.startTimes;
+            replayedSteps++;
         }
-        // Consider the 3 stopping times computed above (preemption, constraints missed, and completion),
-        // see which comes soonest, and set the jobStopTime and jobStopReason.
-        QDateTime jobStopTime = jobInterruptTime;
-        QString stopReason = jobStopTime.isValid() ? interruptReason : "";
-        if (jobConstraintTime.isValid() && (!jobStopTime.isValid() || jobStopTime.secsTo(jobConstraintTime) < 0))
+        else
         {
-            stopReason = constraintReason;
-            jobStopTime = jobConstraintTime;
-            TEST_PRINT(stderr, "%d   %s\n", __LINE__, QString("  picked constraint").toLatin1().data());
-        }
-        if (jobCompletionTime.isValid() && (!jobStopTime.isValid() || jobStopTime.secsTo(jobCompletionTime) < 0))
-        {
-            stopReason = "job completion";
-            jobStopTime = jobCompletionTime;
-            TEST_PRINT(stderr, "%d   %s\n", __LINE__, QString("  picked completion").toLatin1().data());
+            QDateTime jobInterruptTime;
+            QString interruptReason;
+            // Find the next job to be scheduled, when it starts, and when a higher priority
+            // job might preempt it, why it would be preempted.
+            // Note: 4th arg, fullSchedule, must be false or we'd loop forever.
+            selectedJob = selectNextJob(simJobs, simTime, nullptr, DONT_SIMULATE, &jobStartTime, &jobInterruptTime,
+                                        &interruptReason, nullptr, &startTimes);
+            if (selectedJob == nullptr)
+                break;
+
+            TEST_PRINT(stderr, "%d   %s\n", __LINE__, QString("%1 starting at %2 interrupted at \"%3\" reason \"%4\"")
+                       .arg(selectedJob->getName()).arg(jobStartTime.toString("MM/dd hh:mm"))
+                       .arg(jobInterruptTime.toString("MM/dd hh:mm")).arg(interruptReason).toLatin1().data());
+            // Are we past the end time?
+            if (endTime.isValid() && jobStartTime.secsTo(endTime) < 0) break;
+
+            // It's possible there are start_at jobs that can preempt this job.
+            // Find the next start_at time, and use that as an end constraint to getNextEndTime
+            // if it's before jobInterruptTime.
+            QDateTime nextStartAtTime;
+            foreach (SchedulerJob *job, simJobs)
+            {
+                if (job != selectedJob &&
+                        job->getStartupCondition() == START_AT &&
+                        jobStartTime.secsTo(job->getStartupTime()) > 0 &&
+                        (job->getState() == SCHEDJOB_EVALUATION ||
+                         job->getState() == SCHEDJOB_SCHEDULED))
+                {
+                    QDateTime startAtTime = job->getStartupTime();
+                    if (!nextStartAtTime.isValid() || nextStartAtTime.secsTo(startAtTime) < 0)
+                        nextStartAtTime = startAtTime;
+                }
+            }
+            // Check to see if the above start-at stop time is before the interrupt stop time.
+            QDateTime constraintStopTime = jobInterruptTime;
+            if (nextStartAtTime.isValid() &&
+                    (!constraintStopTime.isValid() ||
+                     nextStartAtTime.secsTo(constraintStopTime) < 0))
+                constraintStopTime = nextStartAtTime;
+
+            QString constraintReason;
+            // Get the time that this next job would fail its constraints, and a human-readable explanation.
+            QDateTime jobConstraintTime = selectedJob->getNextEndTime(jobStartTime, SCHEDULE_RESOLUTION_MINUTES, &constraintReason,
+                                          constraintStopTime);
+            if (nextStartAtTime.isValid() && jobConstraintTime.isValid() &&
+                    std::abs(jobConstraintTime.secsTo(nextStartAtTime)) < 2 * SCHEDULE_RESOLUTION_MINUTES)
+                constraintReason = "interrupted by start-at job";
+            TEST_PRINT(stderr, "%d   %s\n", __LINE__,     QString("  constraint \"%1\" reason \"%2\"")
+                       .arg(jobConstraintTime.toString("MM/dd hh:mm")).arg(constraintReason).toLatin1().data());
+            QDateTime jobCompletionTime;
+            if (selectedJob->getEstimatedTime() > 0)
+            {
+                // Estimate when the job might complete, if it was allowed to run without interruption.
+                const int timeLeft = selectedJob->getEstimatedTime() - workDone[selectedJob];
+                jobCompletionTime = jobStartTime.addSecs(timeLeft);
+                TEST_PRINT(stderr, "%d   %s\n", __LINE__, QString("  completion \"%1\" time left %2s")
+                           .arg(jobCompletionTime.toString("MM/dd hh:mm")).arg(timeLeft).toLatin1().data());
+            }
+            // Consider the 3 stopping times computed above (preemption, constraints missed, and completion),
+            // see which comes soonest, and set the jobStopTime and jobStopReason.
+            jobStopTime = jobInterruptTime;
+            stopReason = jobStopTime.isValid() ? interruptReason : "";
+            if (jobConstraintTime.isValid() && (!jobStopTime.isValid() || jobStopTime.secsTo(jobConstraintTime) < 0))
+            {
+                stopReason = constraintReason;
+                jobStopTime = jobConstraintTime;
+                TEST_PRINT(stderr, "%d   %s\n", __LINE__, QString("  picked constraint").toLatin1().data());
+            }
+            if (jobCompletionTime.isValid() && (!jobStopTime.isValid() || jobStopTime.secsTo(jobCompletionTime) < 0))
+            {
+                stopReason = "job completion";
+                jobStopTime = jobCompletionTime;
+                TEST_PRINT(stderr, "%d   %s\n", __LINE__, QString("  picked completion").toLatin1().data());
+            }
+
+            // This if clause handles the simulation of scheduler repeat groups
+            // which applies to scheduler jobs with repeat-style completion conditions.
+            if (!selectedJob->getGroup().isEmpty() &&
+                    (selectedJob->getCompletionCondition() == FINISH_LOOP ||
+                     selectedJob->getCompletionCondition() == FINISH_REPEAT ||
+                     selectedJob->getCompletionCondition() == FINISH_AT))
+            {
+                // Estimate the time it would take to complete the current repeat, if this is a repeated job.
+                int leftThisRepeat = selectedJob->getEstimatedTimeLeftThisRepeat();
+                int secsPerRepeat = selectedJob->getEstimatedTimePerRepeat();
+                int secsLeftThisRepeat = (workDone[selectedJob] < leftThisRepeat) ?
+                                         leftThisRepeat - workDone[selectedJob] : secsPerRepeat;
+
+                if (workDone[selectedJob] == 0)
+                    secsLeftThisRepeat += selectedJob->getEstimatedStartupTime();
+
+                // If it would finish a repeat, run one repeat and see if it would still be scheduled.
+                if (secsLeftThisRepeat > 0 &&
+                        (!jobStopTime.isValid() || secsLeftThisRepeat < jobStartTime.secsTo(jobStopTime)))
+                {
+                    auto tempStart = jobStartTime;
+                    auto tempInterrupt = jobInterruptTime;
+                    auto tempReason = stopReason;
+                    SchedulerJob keepJob = *selectedJob;
+
+                    auto t = jobStartTime.addSecs(secsLeftThisRepeat);
+                    int iteration = selectedJob->getCompletedIterations();
+                    int iters = 0, maxIters = 20;  // just in case...
+                    while ((!jobStopTime.isValid() || t.secsTo(jobStopTime) > 0) && iters++ < maxIters)
+                    {
+                        selectedJob->setCompletedIterations(++iteration);
+                        TEST_PRINT(stderr, "%d   %s\n", __LINE__, QString("  iteration=%1").arg(iteration).toLatin1().data());
+                        SchedulerJob *next = selectNextJob(simJobs, t, nullptr, DONT_SIMULATE, &tempStart, &tempInterrupt, &tempReason);
+                        if (next != selectedJob)
+                        {
+                            stopReason = "interrupted for group member";
+                            jobStopTime = t;
+                            TEST_PRINT(stderr, "%d   %s\n", __LINE__, QString(" switched to group member %1 at %2")
+                                       .arg(next == nullptr ? "null" : next->getName()).arg(t.toString("MM/dd hh:mm")).toLatin1().data());
+
+                            break;
+                        }
+                        t = t.addSecs(secsPerRepeat);
+                    }
+                    *selectedJob = keepJob;
+                }
+            }
+
+            // The first step is always simulated, as the simulation starts at a later time than the previous one.
+            // If it ends as it did, the previous steps may be replayed from there.
+            if (replaying && iterations == 0)
+            {
+                const SimulationStep &previous = m_Previous.steps[0];
+                const int index = simJobs.indexOf(selectedJob);
+                replaying = previous.job == index && previous.stop.isValid() == jobStopTime.isValid() &&
+                            (!jobStopTime.isValid() ||
+                             std::abs(jobStopTime.secsTo(previous.stop)) <= SCHEDULE_RESOLUTION_MINUTES * 60);
+                if (replaying)
+                {
+                    jobStopTime = previous.stop;
+                    stopReason = previous.reason;
+                    // Its state from here on may differ from that of the previous simulation
+                    if (!replayChanges.contains(index))
+                        replayChanges.append(index);
+                }
+            }
         }
 
-        // This if clause handles the simulation of scheduler repeat groups
-        // which applies to scheduler jobs with repeat-style completion conditions.
+        // Keep the progress of repeated group jobs from before this simulation.
         if (!selectedJob->getGroup().isEmpty() &&
                 (selectedJob->getCompletionCondition() == FINISH_LOOP ||
                  selectedJob->getCompletionCondition() == FINISH_REPEAT ||
@@ -664,46 +895,6 @@ QDateTime GreedyScheduler::simulate(const QList<SchedulerJob *> &jobs, const QDa
                 originalIteration[selectedJob] = selectedJob->getCompletedIterations();
             if (originalSecsLeftIteration.find(selectedJob) == originalSecsLeftIteration.end())
                 originalSecsLeftIteration[selectedJob] = selectedJob->getEstimatedTimeLeftThisRepeat();
-
-            // Estimate the time it would take to complete the current repeat, if this is a repeated job.
-            int leftThisRepeat = selectedJob->getEstimatedTimeLeftThisRepeat();
-            int secsPerRepeat = selectedJob->getEstimatedTimePerRepeat();
-            int secsLeftThisRepeat = (workDone[selectedJob] < leftThisRepeat) ?
-                                     leftThisRepeat - workDone[selectedJob] : secsPerRepeat;
-
-            if (workDone[selectedJob] == 0)
-                secsLeftThisRepeat += selectedJob->getEstimatedStartupTime();
-
-            // If it would finish a repeat, run one repeat and see if it would still be scheduled.
-            if (secsLeftThisRepeat > 0 &&
-                    (!jobStopTime.isValid() || secsLeftThisRepeat < jobStartTime.secsTo(jobStopTime)))
-            {
-                auto tempStart = jobStartTime;
-                auto tempInterrupt = jobInterruptTime;
-                auto tempReason = stopReason;
-                SchedulerJob keepJob = *selectedJob;
-
-                auto t = jobStartTime.addSecs(secsLeftThisRepeat);
-                int iteration = selectedJob->getCompletedIterations();
-                int iters = 0, maxIters = 20;  // just in case...
-                while ((!jobStopTime.isValid() || t.secsTo(jobStopTime) > 0) && iters++ < maxIters)
-                {
-                    selectedJob->setCompletedIterations(++iteration);
-                    TEST_PRINT(stderr, "%d   %s\n", __LINE__, QString("  iteration=%1").arg(iteration).toLatin1().data());
-                    SchedulerJob *next = selectNextJob(simJobs, t, nullptr, DONT_SIMULATE, &tempStart, &tempInterrupt, &tempReason);
-                    if (next != selectedJob)
-                    {
-                        stopReason = "interrupted for group member";
-                        jobStopTime = t;
-                        TEST_PRINT(stderr, "%d   %s\n", __LINE__, QString(" switched to group member %1 at %2")
-                                   .arg(next == nullptr ? "null" : next->getName()).arg(t.toString("MM/dd hh:mm")).toLatin1().data());
-
-                        break;
-                    }
-                    t = t.addSecs(secsPerRepeat);
-                }
-                *selectedJob = keepJob;
-            }
         }
 
         // Increment the work done, for the next time this job might be scheduled in this simulation.
@@ -751,6 +942,8 @@ QDateTime GreedyScheduler::simulate(const QList<SchedulerJob *> &jobs, const QDa
                        .arg(selectedJob->getName()).toLatin1().data());
         }
         schedule.append(JobSchedule(jobs[copiedJobs.indexOf(selectedJob)], jobStartTime, jobStopTime, stopReason));
+        if (recording)
+            steps.append(SimulationStep{copiedJobs.indexOf(selectedJob), jobStartTime, jobStopTime, stopReason, startTimes});
         simEndTime = jobStopTime;
         simTime = jobStopTime.addSecs(60);
 
@@ -787,6 +980,14 @@ QDateTime GreedyScheduler::simulate(const QList<SchedulerJob *> &jobs, const QDa
         }
     }
 
+    if (recording)
+    {
+        m_Steps = steps;
+        if (replayedSteps > 0)
+            qCDebug(KSTARS_EKOS_SCHEDULER) << QString("Greedy Scheduler replayed %1 of %2 steps of the previous plan")
+                                           .arg(replayedSteps).arg(steps.size());
+    }
+
     // This simulation has been run using a deep-copy of the jobs list, so as not to interfere with
     // some of their stored data. However, we do wish to update several fields of the "real" scheduleJobs.
     // Note that the original jobs list and "copiedJobs" should be in the same order..
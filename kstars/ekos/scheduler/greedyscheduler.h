@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <QHash>
 #include <QList>
 #include <QMap>
 #include <QDateTime>
@@ -13,6 +14,8 @@
 #include <QString>
 #include <QVector>
 
+#include <memory>
+
 namespace Ekos
 {
 
@@ -161,7 +164,8 @@ class GreedyScheduler : public QObject
                                     QDateTime *when = nullptr,
                                     QDateTime *nextInterruption = nullptr,
                                     QString *interruptReason = nullptr,
-                                    const QMap<QString, uint16_t> *capturedFramesCount = nullptr);
+                                    const QMap<QString, uint16_t> *capturedFramesCount = nullptr,
+                                    QHash<int, QDateTime> *startTimes = nullptr);
 
         // Simulate the running of the scheduler from time to endTime by appending
         // JobSchedule entries to the schedule.
@@ -172,6 +176,19 @@ class GreedyScheduler : public QObject
                            const QMap<QString, uint16_t> *capturedFramesCount,
                            SimulationType simType);
 
+        // Compares jobs with those the previous schedule was computed from. Unchanged constraints get their
+        // timelines back, and the indices of the jobs that changed are put in changed. Returns false if
+        // the previous schedule may not be replayed at all.
+        bool findChanges(const QList<SchedulerJob *> &jobs, QList<int> *changed);
+
+        // Returns true if the step of the previous simulation would be the same with the simulated jobs
+        // as they are at simTime. Only the jobs in changed may differ from the previous simulation.
+        bool canReplay(const QList<SchedulerJob *> &simJobs, const QDateTime &simTime, int step,
+                       const QList<int> &changed) const;
+
+        // The settings, other than those of the jobs, a schedule depends on.
+        QString scheduleSettings() const;
+
         // Error/Abort restart parameters.
         // Defaults don't matter much, will be set by UI.
         bool rescheduleAbortsImmediate { false };
@@ -191,6 +208,33 @@ class GreedyScheduler : public QObject
         // The time of the last simulation in checkJob().
         // We don't simulate too frequently.
         QDateTime m_LastCheckJobSim;
+
+        // A step of a simulation: the index of the job selected, when it runs and why it stops,
+        // and the start times of the jobs selectNextJob() evaluated, by index.
+        struct SimulationStep
+        {
+            int job;
+            QDateTime start;
+            QDateTime stop;
+            QString reason;
+            QHash<int, QDateTime> startTimes;
+        };
+
+        // What the previous scheduleJobs() found the jobs to be, and the steps of its simulation.
+        // Only the simulation after the first change that matters has to be run again.
+        struct PreviousSchedule
+        {
+            QList<SchedulerJob *> jobs;
+            QList<std::shared_ptr<const SchedulerJob>> inputs;
+            QList<SimulationStep> steps;
+            QString settings;
+        };
+        PreviousSchedule m_Previous;
+        // The steps recorded by the last simulation of scheduleJobs().
+        QList<SimulationStep> m_Steps;
+        // Set by scheduleJobs() when its simulation may replay m_Previous, with the jobs that changed.
+        bool m_Replay { false };
+        QList<int> m_Changes;
 };
 
 }  // namespace Ekos
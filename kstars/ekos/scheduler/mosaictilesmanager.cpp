@@ -10,6 +10,7 @@
 
 #include "kstars.h"
 #include "kstarsdata.h"
+#include "ksnumbers.h"
 #include "ekos_scheduler_debug.h"
 
 #include <QGraphicsSceneMouseEvent>
@@ -112,6 +113,9 @@ void MosaicTilesManager::updateTiles(QPointF skymapCenter, bool s_shaped)
     qCDebug(KSTARS_EKOS_SCHEDULER) << "Mosaic Tile FovW" << fovW << "FovH" << fovH << "initX" << x << "initY" << y <<
                                    "Offset X " << xOffset << " Y " << yOffset << " rotation " << getPA() << " reverseOdd " << s_shaped;
 
+    // All tiles are brought to the same epoch, so the precession and nutation are computed once
+    KSNumbers num(KStars::Instance()->data()->ut().djd());
+
     int index = 0;
     for (int col = 0; col < m_HorizontalTiles; col++)
     {
@@ -138,7 +142,7 @@ void MosaicTilesManager::updateTiles(QPointF skymapCenter, bool s_shaped)
 
             tile->skyCenter.setRA0((skyCenter.ra0().Degrees() + tileSkyOffsetScaled.width()) / 15.0);
             tile->skyCenter.setDec0(skyCenter.dec0().Degrees() + tileSkyOffsetScaled.height());
-            tile->skyCenter.apparentCoord(static_cast<long double>(J2000), KStars::Instance()->data()->ut().djd());
+            tile->skyCenter.apparentCoord(&num);
 
             tile->rotation = tile->skyCenter.ra0().Degrees() - skyCenter.ra0().Degrees();
 
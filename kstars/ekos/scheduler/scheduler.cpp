@@ -33,11 +33,11 @@
 #include "greedyscheduler.h"
 #include "ekos/auxiliary/solverutils.h"
 #include "ekos/auxiliary/stellarsolverprofile.h"
+#include "fitsviewer/fitsdata.h"
 
 #include <KConfigDialog>
 #include <KActionCollection>
 
-#include <fitsio.h>
 #include <ekos_scheduler_debug.h>
 #include <indicom.h>
 #include "ekos/capture/sequenceeditor.h"
@@ -578,80 +578,47 @@ void Scheduler::processFITSSelection(const QUrl &url)
     setDirty();
 
     const QString filename = fitsEdit->text();
-    int status = 0;
-    double ra = 0, dec = 0;
     dms raDMS, deDMS;
-    char comment[128], error_status[512];
-    fitsfile *fptr = nullptr;
+    QVariant value;
 
-    if (fits_open_diskfile(&fptr, filename.toLatin1(), READONLY, &status))
+    // Only the keywords are needed, don't load the pixels.
+    FITSData data;
+    if (!data.loadHeaderFromFile(filename))
     {
-        fits_report_error(stderr, status);
-        fits_get_errstatus(status, error_status);
-        qCCritical(KSTARS_EKOS_SCHEDULER) << QString::fromUtf8(error_status);
+        qCCritical(KSTARS_EKOS_SCHEDULER) << data.getLastError();
         return;
     }
 
-    status = 0;
-    if (fits_movabs_hdu(fptr, 1, IMAGE_HDU, &status))
+    if (data.getRecordValue("OBJCTRA", value))
+        raDMS = dms::fromString(value.toString(), false);
+    else if (data.getRecordValue("RA", value))
+        raDMS.setD(value.toDouble());
+    else
     {
-        fits_report_error(stderr, status);
-        fits_get_errstatus(status, error_status);
-        qCCritical(KSTARS_EKOS_SCHEDULER) << QString::fromUtf8(error_status);
+        process()->appendLogText(i18n("FITS header: cannot find OBJCTRA."));
         return;
     }
 
-    status = 0;
-    char objectra_str[32] = {0};
-    if (fits_read_key(fptr, TSTRING, "OBJCTRA", objectra_str, comment, &status))
-    {
-        if (fits_read_key(fptr, TDOUBLE, "RA", &ra, comment, &status))
-        {
-            fits_report_error(stderr, status);
-            fits_get_errstatus(status, error_status);
-            process()->appendLogText(i18n("FITS header: cannot find OBJCTRA (%1).", QString(error_status)));
-            return;
-        }
-
-        raDMS.setD(ra);
-    }
+    if (data.getRecordValue("OBJCTDEC", value))
+        deDMS = dms::fromString(value.toString(), true);
+    else if (data.getRecordValue("DEC", value))
+        deDMS.setD(value.toDouble());
     else
     {
-        raDMS = dms::fromString(objectra_str, false);
-    }
-
-    status = 0;
-    char objectde_str[32] = {0};
-    if (fits_read_key(fptr, TSTRING, "OBJCTDEC", objectde_str, comment, &status))
-    {
-        if (fits_read_key(fptr, TDOUBLE, "DEC", &dec, comment, &status))
-        {
-            fits_report_error(stderr, status);
-            fits_get_errstatus(status, error_status);
-            process()->appendLogText(i18n("FITS header: cannot find OBJCTDEC (%1).", QString(error_status)));
-            return;
-        }
-
-        deDMS.setD(dec);
-    }
-    else
-    {
-        deDMS = dms::fromString(objectde_str, true);
+        process()->appendLogText(i18n("FITS header: cannot find OBJCTDEC."));
+        return;
     }
 
     raBox->show(raDMS);
     decBox->show(deDMS);
 
-    char object_str[256] = {0};
-    if (fits_read_key(fptr, TSTRING, "OBJECT", object_str, comment, &status))
+    if (data.getRecordValue("OBJECT", value))
+        nameEdit->setText(value.toString());
+    else
     {
         QFileInfo info(filename);
         nameEdit->setText(info.completeBaseName());
     }
-    else
-    {
-        nameEdit->setText(object_str);
-    }
 }
 
 void Scheduler::setSequence(const QString &sequenceFileURL)
@@ -15,15 +15,29 @@
 #include "schedulermodulestate.h"
 #include "schedulerutils.h"
 #include "ksalmanac.h"
+#include "ksephemeris.h"
 #include "ksmoon.h"
+#include "ksnumbers.h"
 
 #include <knotification.h>
 
+#include <QtConcurrent>
+
 #include <ekos_scheduler_debug.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 #define BAD_SCORE -1000
 #define MIN_ALTITUDE 15.0
 
+// Length of the constraint timelines, in minutes. The simulation plans 48 hours ahead and
+// calculateNextTime() looks 24 hours past that, leaving half a day to reuse a timeline.
+static const int g_timelineMinutes = 84 * 60;
+// A timeline is computed again once its start is this many minutes in the past
+static const int g_timelineReuseMinutes = 12 * 60;
+
 namespace Ekos
 {
 GeoLocation *SchedulerJob::storedGeo = nullptr;
@@ -554,6 +568,10 @@ bool SchedulerJob::moonSeparationOK(QDateTime const &when) const
     o.updateCoordsNow(&numbers);
 
     CachingDms LST = SchedulerModuleState::getGeo()->GSTtoLST(SchedulerModuleState::getGeo()->LTtoUT(ltWhen).gst());
+
+    // The moon is shared by all the jobs, which may be searched from several threads at once
+    static std::mutex moonMutex;
+    const std::lock_guard<std::mutex> lock(moonMutex);
     moon->updateCoords(&numbers, true, SchedulerModuleState::getGeo()->lat(), &LST, true);
 
     double const separation = moon->angularDistanceTo(&o).Degrees();
@@ -561,6 +579,319 @@ bool SchedulerJob::moonSeparationOK(QDateTime const &when) const
     return (separation >= getMinMoonSeparation());
 }
 
+namespace
+{
+// The conditions that are the same for all the timelines computed together
+struct TimelineSky
+{
+    // Local time and UT of the first minute
+    KStarsDateTime start;
+    KStarsDateTime ut;
+    // Whether each minute is during the astronomical night
+    std::vector<bool> dark;
+    // Unit vectors towards the topocentric place of the Moon at each minute, empty if no job needs it
+    std::vector<std::array<double, 3>> moon;
+};
+}
+
+// The constraints checked by calculateNextTime(), sampled every minute. The minutes where the job
+// may start, or keep running, are kept as sorted intervals [first, last[, so a search is a walk
+// through a handful of intervals rather than through every minute.
+class SchedulerJob::ConstraintTimeline
+{
+    public:
+        // The constraints a minute meets
+        enum
+        {
+            DARK        = 1 << 0, // twilight
+            ALTITUDE    = 1 << 1, // altitude, mount limits and artificial horizon
+            MOON        = 1 << 2, // moon separation
+            NOT_SETTING = 1 << 3, // setting altitude cutoff
+        };
+        typedef std::pair<int, int> Interval;
+
+        ConstraintTimeline(const SchedulerJob &job, const TimelineSky &sky);
+
+        // The minute of the timeline closest to time, or -1 if outside of it
+        int minute(const QDateTime &time) const;
+        int size() const
+        {
+            return int(flags.size());
+        }
+
+        // Answer calculateNextTime() for count minutes from minute first, which is ltWhen
+        QDateTime nextTime(const SchedulerJob &job, const QDateTime &ltWhen, int first, int count,
+                           bool checkIfConstraintsAreMet, int increment, QString *reason, bool runningJob) const;
+
+    private:
+        static std::vector<Interval> intervals(const std::vector<quint8> &flags, quint8 mask);
+        // The first of the minutes first + n * increment, with n * increment < count, inside or outside
+        // of intervals, as an offset from first, or -1 if there is none
+        static int firstInside(const std::vector<Interval> &intervals, int first, int increment, int count);
+        static int firstOutside(const std::vector<Interval> &intervals, int first, int increment, int count);
+
+    public:
+        // What constraintSettings() was when the timeline was computed
+        QString settings;
+
+    private:
+        KStarsDateTime start;
+        TargetAltitudes altitudes;
+        std::vector<quint8> flags;
+        // Minutes where the job may start, and where it may keep running
+        std::vector<Interval> starts;
+        std::vector<Interval> runs;
+};
+
+SchedulerJob::ConstraintTimeline::ConstraintTimeline(const SchedulerJob &job, const TimelineSky &sky)
+    : start(sky.start), altitudes(job.getTargetCoords(), sky.ut, SchedulerModuleState::getGeo()), flags(sky.dark.size(), 0)
+{
+    int const count = size();
+    std::vector<double> alt(count), az(count);
+    std::unique_ptr<bool[]> setting(new bool[count]);
+    altitudes.altitudes(0, 60, count, alt.data(), az.data(), setting.get());
+
+    // The target at its apparent place for the start, as moonSeparationOK() has it
+    bool const checkMoon = 0 < job.getMinMoonSeparation() && !sky.moon.empty();
+    double target[3] = { 0, 0, 0 };
+    double maxCos = 1;
+    if (checkMoon)
+    {
+        SkyObject o;
+        o.setRA0(job.getTargetCoords().ra0());
+        o.setDec0(job.getTargetCoords().dec0());
+        o.updateCoordsNow(KSNumbers::shared(sky.ut.djd()).get());
+
+        double sinRA, cosRA, sinDec, cosDec;
+        o.ra().SinCos(sinRA, cosRA);
+        o.dec().SinCos(sinDec, cosDec);
+        target[0] = cosDec * cosRA;
+        target[1] = cosDec * sinRA;
+        target[2] = sinDec;
+        maxCos = cos(job.getMinMoonSeparation() * dms::DegToRad);
+    }
+
+    double const SETTING_ALTITUDE_CUTOFF = Options::settingAltitudeCutoff();
+    bool const enforceTwilight = job.getEnforceTwilight();
+
+    for (int i = 0; i < count; ++i)
+    {
+        quint8 f = 0;
+        if (!enforceTwilight || sky.dark[i])
+            f |= DARK;
+        if (job.satisfiesAltitudeConstraint(az[i], alt[i]))
+            f |= ALTITUDE;
+        if (!checkMoon ||
+                sky.moon[i][0] * target[0] + sky.moon[i][1] * target[1] + sky.moon[i][2] * target[2] <= maxCos)
+            f |= MOON;
+        if (!setting[i] || job.satisfiesAltitudeConstraint(az[i], alt[i] - SETTING_ALTITUDE_CUTOFF))
+            f |= NOT_SETTING;
+        flags[i] = f;
+    }
+
+    runs   = intervals(flags, DARK | ALTITUDE | MOON);
+    starts = intervals(flags, DARK | ALTITUDE | MOON | NOT_SETTING);
+}
+
+std::vector<SchedulerJob::ConstraintTimeline::Interval> SchedulerJob::ConstraintTimeline::intervals(
+    const std::vector<quint8> &flags, quint8 mask)
+{
+    std::vector<Interval> result;
+    int const count = int(flags.size());
+    for (int i = 0; i < count; ++i)
+    {
+        if ((flags[i] & mask) != mask)
+            continue;
+        int const first = i;
+        while (i < count && (flags[i] & mask) == mask)
+            ++i;
+        result.emplace_back(first, i);
+    }
+    return result;
+}
+
+int SchedulerJob::ConstraintTimeline::minute(const QDateTime &time) const
+{
+    int const m = qRound(start.secsTo(time) / 60.0);
+    return (0 <= m && m < size()) ? m : -1;
+}
+
+int SchedulerJob::ConstraintTimeline::firstInside(const std::vector<Interval> &intervals, int first, int increment,
+        int count)
+{
+    // The first interval that ends after the first minute
+    auto it = std::upper_bound(intervals.begin(), intervals.end(), first, [](int m, const Interval & interval)
+    {
+        return m < interval.second;
+    });
+    for (; it != intervals.end(); ++it)
+    {
+        int const n = it->first > first ? (it->first - first + increment - 1) / increment * increment : 0;
+        if (n >= count)
+            return -1;
+        if (first + n < it->second)
+            return n;
+    }
+    return -1;
+}
+
+int SchedulerJob::ConstraintTimeline::firstOutside(const std::vector<Interval> &intervals, int first, int increment,
+        int count)
+{
+    auto it = std::upper_bound(intervals.begin(), intervals.end(), first, [](int m, const Interval & interval)
+    {
+        return m < interval.second;
+    });
+    for (int n = 0; n < count; )
+    {
+        while (it != intervals.end() && it->second <= first + n)
+            ++it;
+        if (it == intervals.end() || it->first > first + n)
+            return n;
+        // Inside an interval, skip to its end
+        n = (it->second - first + increment - 1) / increment * increment;
+    }
+    return -1;
+}
+
+QDateTime SchedulerJob::ConstraintTimeline::nextTime(const SchedulerJob &job, const QDateTime &ltWhen, int first,
+        int count, bool checkIfConstraintsAreMet, int increment, QString *reason, bool runningJob) const
+{
+    increment = std::max(1, increment);
+
+    if (checkIfConstraintsAreMet)
+    {
+        int const n = firstInside(runningJob ? runs : starts, first, increment, count);
+        return n < 0 ? QDateTime() : ltWhen.addSecs(n * 60);
+    }
+
+    int const n = firstOutside(runs, first, increment, count);
+    if (n < 0)
+        return QDateTime();
+
+    if (reason)
+    {
+        quint8 const f = flags[first + n];
+        if (!(f & DARK))
+            *reason = "twilight";
+        else if (!(f & ALTITUDE))
+        {
+            double azimuth = 0;
+            double const altitude = altitudes.altitude((first + n) * 60.0, &azimuth);
+            job.satisfiesAltitudeConstraint(azimuth, altitude, reason);
+        }
+        else
+            *reason = QString("moon separation");
+    }
+    return ltWhen.addSecs(n * 60);
+}
+
+void SchedulerJob::computeTimelines(const QList<SchedulerJob *> &jobs, const QDateTime &from)
+{
+    GeoLocation const *geo = SchedulerModuleState::getGeo();
+    KStarsDateTime const ltFrom(from.isValid() ?
+                                Qt::UTC == from.timeSpec() ? geo->UTtoLT(KStarsDateTime(from)) : from :
+                                getLocalTime());
+
+    // This also has the artificial horizon compute its constraints here rather than from several threads
+    QString const settings = constraintSettings();
+
+    QList<SchedulerJob *> pending;
+    KSMoon const *moon = nullptr;
+    bool twilight = false;
+    for (auto job : jobs)
+    {
+        if (job->constraintTimeline && job->constraintTimeline->settings == settings)
+        {
+            int const minute = job->constraintTimeline->minute(ltFrom);
+            if (0 <= minute && minute <= g_timelineReuseMinutes)
+                continue;
+        }
+        pending.append(job);
+        if (0 < job->getMinMoonSeparation() && job->moon != nullptr)
+            moon = job->moon;
+        twilight |= job->getEnforceTwilight();
+    }
+    if (pending.isEmpty())
+        return;
+
+    TimelineSky sky;
+    sky.start = ltFrom;
+    sky.ut = geo->LTtoUT(ltFrom);
+    sky.dark.assign(g_timelineMinutes, true);
+
+    // The night only begins and ends a few times over the timeline, and each answer holds until the next of these
+    for (int i = 0; twilight && i < g_timelineMinutes; )
+    {
+        KStarsDateTime const t = ltFrom.addSecs(i * 60);
+        QDateTime minDawnDusk;
+        bool const dark = pending.first()->runsDuringAstronomicalNightTimeInternal(t, &minDawnDusk);
+        int const end = std::min(g_timelineMinutes, std::max(i + 1, i + int(std::ceil(t.secsTo(minDawnDusk) / 60.0))));
+        std::fill(sky.dark.begin() + i, sky.dark.begin() + end, dark);
+        i = end;
+    }
+
+    // The Moon is fitted once for all jobs, which then only evaluate polynomials
+    if (moon != nullptr)
+    {
+        KSEphemeris ephemeris;
+        ephemeris.fit(*moon, sky.ut.djd(), sky.ut.djd() + g_timelineMinutes / 1440.0);
+
+        sky.moon.resize(g_timelineMinutes);
+        for (int i = 0; i < g_timelineMinutes; ++i)
+        {
+            KStarsDateTime const ut = sky.ut.addSecs(i * 60);
+            CachingDms const LST = geo->GSTtoLST(ut.gst());
+            SkyPoint point;
+            ephemeris.position(ut.djd(), &point, geo->lat(), &LST);
+
+            double sinRA, cosRA, sinDec, cosDec;
+            point.ra().SinCos(sinRA, cosRA);
+            point.dec().SinCos(sinDec, cosDec);
+            sky.moon[i] = { cosDec * cosRA, cosDec * sinRA, sinDec };
+        }
+    }
+
+    QtConcurrent::blockingMap(pending, [&sky, &settings](SchedulerJob * &job)
+    {
+        auto timeline = std::make_shared<ConstraintTimeline>(*job, sky);
+        timeline->settings = settings;
+        job->constraintTimeline = timeline;
+    });
+}
+
+bool SchedulerJob::reuseTimeline(const SchedulerJob &other)
+{
+    if (!other.constraintTimeline ||
+            other.targetCoords.ra0().Degrees() != targetCoords.ra0().Degrees() ||
+            other.targetCoords.dec0().Degrees() != targetCoords.dec0().Degrees() ||
+            other.minAltitude != minAltitude || other.minMoonSeparation != minMoonSeparation ||
+            other.enforceTwilight != enforceTwilight || other.enforceArtificialHorizon != enforceArtificialHorizon)
+        return false;
+
+    constraintTimeline = other.constraintTimeline;
+    return true;
+}
+
+QString SchedulerJob::constraintSettings()
+{
+    GeoLocation const *geo = SchedulerModuleState::getGeo();
+    QString settings = QString("%1 %2 %3 %4").arg(geo->lat()->Degrees()).arg(geo->lng()->Degrees())
+                       .arg(geo->elevation()).arg(geo->TZ());
+    settings += QString(" %1 %2 %3 %4").arg(Options::enableAltitudeLimits()).arg(Options::minimumAltLimit())
+                .arg(Options::maximumAltLimit()).arg(Options::settingAltitudeCutoff());
+    settings += QString(" %1 %2 %3").arg(Options::preDawnTime()).arg(Options::dawnOffset()).arg(Options::duskOffset());
+
+    // Sampling the artificial horizon is enough to notice it was edited
+    ArtificialHorizon const *horizon = getHorizon();
+    if (horizon != nullptr)
+    {
+        for (int azimuth = 0; azimuth < 360; azimuth += 5)
+            settings += QString(" %1").arg(horizon->altitudeConstraint(azimuth));
+    }
+    return settings;
+}
+
 QDateTime SchedulerJob::calculateNextTime(QDateTime const &when, bool checkIfConstraintsAreMet, int increment,
         QString *reason, bool runningJob, const QDateTime &until) const
 {
@@ -571,15 +902,12 @@ QDateTime SchedulerJob::calculateNextTime(QDateTime const &when, bool checkIfCon
                           Qt::UTC == when.timeSpec() ? SchedulerModuleState::getGeo()->UTtoLT(KStarsDateTime(when)) : when :
                           getLocalTime());
 
-    // Create a sky object with the target catalog coordinates
-    SkyPoint const target = getTargetCoords();
-    SkyObject o;
-    o.setRA0(target.ra0());
-    o.setDec0(target.dec0());
-
     // Calculate the UT at the argument time
     KStarsDateTime const ut = SchedulerModuleState::getGeo()->LTtoUT(ltWhen);
 
+    // The apparent place of the target is computed once for the whole search
+    TargetAltitudes const altitudes(getTargetCoords(), ut, SchedulerModuleState::getGeo());
+
     double const SETTING_ALTITUDE_CUTOFF = Options::settingAltitudeCutoff();
 
     auto maxMinute = 1e8;
@@ -589,6 +917,12 @@ QDateTime SchedulerJob::calculateNextTime(QDateTime const &when, bool checkIfCon
     if (maxMinute > 24 * 60)
         maxMinute = 24 * 60;
 
+    // Look the answer up if the whole search is inside the timeline of the job
+    int const first = constraintTimeline ? constraintTimeline->minute(ltWhen) : -1;
+    if (first >= 0 && maxMinute > 0 && first + maxMinute <= constraintTimeline->size())
+        return constraintTimeline->nextTime(*this, ltWhen, first, int(maxMinute), checkIfConstraintsAreMet, increment,
+                                            reason, runningJob);
+
     // Within the next 24 hours, search when the job target matches the altitude and moon constraints
     for (unsigned int minute = 0; minute < maxMinute; minute += increment)
     {
@@ -616,15 +950,10 @@ QDateTime SchedulerJob::calculateNextTime(QDateTime const &when, bool checkIfCon
             }
         }
 
-        // Update RA/DEC of the target for the current fraction of the day
-        KSNumbers numbers(ltOffset.djd());
-        o.updateCoordsNow(&numbers);
-
-        // Compute local sidereal time for the current fraction of the day, calculate altitude
-        CachingDms const LST = SchedulerModuleState::getGeo()->GSTtoLST(SchedulerModuleState::getGeo()->LTtoUT(ltOffset).gst());
-        o.EquatorialToHorizontal(&LST, SchedulerModuleState::getGeo()->lat());
-        double const altitude = o.alt().Degrees();
-        double const azimuth = o.az().Degrees();
+        // Calculate altitude for the current fraction of the day
+        double azimuth = 0;
+        bool setting = false;
+        double const altitude = altitudes.altitude(minute * 60.0, &azimuth, &setting);
 
         bool const altitudeOK = satisfiesAltitudeConstraint(azimuth, altitude, reason);
         if (altitudeOK)
@@ -648,12 +977,7 @@ QDateTime SchedulerJob::calculateNextTime(QDateTime const &when, bool checkIfCon
             {
                 if (!runningJob)
                 {
-                    double offset = LST.Hours() - o.ra().Hours();
-                    if (24.0 <= offset)
-                        offset -= 24.0;
-                    else if (offset < 0.0)
-                        offset += 24.0;
-                    if (0.0 <= offset && offset < 12.0)
+                    if (setting)
                     {
                         bool const settingAltitudeOK = satisfiesAltitudeConstraint(azimuth, altitude - SETTING_ALTITUDE_CUTOFF);
                         if (!settingAltitudeOK)
@@ -14,6 +14,8 @@
 #include "kstarsdatetime.h"
 #include <QJsonObject>
 
+#include <memory>
+
 class ArtificialHorizon;
 class KSMoon;
 class TestSchedulerUnit;
@@ -477,11 +479,37 @@ class SchedulerJob
         QString jobStartupConditionString(StartupCondition condition) const;
         QString jobCompletionConditionString(CompletionCondition condition) const;
 
-        // Clear the cache that keeps results for getNextPossibleStartTime().
+        // Clear the cache that keeps results for getNextPossibleStartTime(), and the constraint timeline.
         void clearCache()
         {
             startTimeCache.clear();
+            constraintTimeline.reset();
         }
+
+        /**
+         * @brief computeTimelines Precompute when the constraints of jobs are met, minute by minute
+         * over the next few days, so that calculateNextTime() looks its answers up rather than steps
+         * through the night. The timelines of the jobs are computed in parallel.
+         * @param jobs the jobs, those with a timeline recent enough for from keep it
+         * @param from the time the timelines start at, now if omitted
+         * @note The timelines are dropped by clearCache(), which must be called when the constraints,
+         * the location or the options change.
+         */
+        static void computeTimelines(const QList<SchedulerJob *> &jobs, const QDateTime &from = QDateTime());
+
+        /**
+         * @brief reuseTimeline Take the constraint timeline of other, a copy of this job kept from an
+         * earlier schedule, if the constraints of the two jobs are the same.
+         * @return true if the timeline was taken
+         */
+        bool reuseTimeline(const SchedulerJob &other);
+
+        /**
+         * @brief constraintSettings Describe the location, the options and the artificial horizon the
+         * constraints of all jobs depend on.
+         * @return a string that changes when any of these changes
+         */
+        static QString constraintSettings();
         double getAltitudeAtStartup() const
         {
             return altitudeAtStartup;
@@ -627,6 +655,10 @@ private:
         };
         StartTimeCache startTimeCache;
 
+        // The constraints checked by calculateNextTime(), precomputed by computeTimelines().
+        class ConstraintTimeline;
+        std::shared_ptr<const ConstraintTimeline> constraintTimeline;
+
         // These are used in testing, instead of KStars::Instance() resources
         static KStarsDateTime *storedLocalTime;
         static GeoLocation *storedGeo;
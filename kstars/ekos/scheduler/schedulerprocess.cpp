@@ -15,6 +15,7 @@
 #include "ksnotification.h"
 #include "kstars.h"
 #include "kstarsdata.h"
+#include "auxiliary/kstrace.h"
 #include "indi/indistd.h"
 #include "skymapcomposite.h"
 #include "mosaiccomponent.h"
@@ -2317,6 +2318,7 @@ void SchedulerProcess::startJobEvaluation()
 
 void SchedulerProcess::evaluateJobs(bool evaluateOnly)
 {
+    KSTRACE_SCOPE("scheduler", "evaluateJobs");
     for (auto job : moduleState()->jobs())
         job->clearCache();
 
@@ -2579,6 +2581,7 @@ void SchedulerProcess::iterate()
 
 int SchedulerProcess::runSchedulerIteration()
 {
+    KSTRACE_SCOPE("scheduler", "runSchedulerIteration");
     qint64 now = QDateTime::currentMSecsSinceEpoch();
     if (moduleState()->startMSecs() == 0)
         moduleState()->setStartMSecs(now);
@@ -2836,6 +2839,7 @@ void SchedulerProcess::applyConfig()
 
 bool SchedulerProcess::executeJob(SchedulerJob * job)
 {
+    KSTRACE_SCOPE("scheduler", "executeJob");
     if (job == nullptr)
         return false;
 
@@ -4331,48 +4335,13 @@ void SchedulerProcess::registerNewDevice(const QString &name, int interface)
 
 bool SchedulerProcess::createJobSequence(XMLEle * root, const QString &prefix, const QString &outputDir)
 {
-    XMLEle *ep    = nullptr;
-    XMLEle *subEP = nullptr;
-
-    for (ep = nextXMLEle(root, 1); ep != nullptr; ep = nextXMLEle(root, 0))
-    {
-        if (!strcmp(tagXMLEle(ep), "Job"))
-        {
-            for (subEP = nextXMLEle(ep, 1); subEP != nullptr; subEP = nextXMLEle(ep, 0))
-            {
-                if (!strcmp(tagXMLEle(subEP), "Prefix"))
-                {
-                    XMLEle *rawPrefix = findXMLEle(subEP, "RawPrefix");
-                    if (rawPrefix)
-                    {
-                        editXMLEle(rawPrefix, prefix.toLatin1().constData());
-                    }
-                }
-                else if (!strcmp(tagXMLEle(subEP), "FITSDirectory"))
-                {
-                    editXMLEle(subEP, outputDir.toLatin1().constData());
-                }
-            }
-        }
-    }
-
-    QDir().mkpath(outputDir);
-
-    QString filename = QString("%1/%2.esq").arg(outputDir, prefix);
-    FILE *outputFile = fopen(filename.toLatin1().constData(), "w");
-
-    if (outputFile == nullptr)
+    QString errorText;
+    if (SchedulerUtils::writeJobSequence(root, prefix, outputDir, errorText) == false)
     {
-        QString message = i18n("Unable to write to file %1", filename);
-        KSNotification::sorry(message, i18n("Could Not Open File"));
+        KSNotification::sorry(errorText, i18n("Could Not Open File"));
         return false;
     }
 
-    fprintf(outputFile, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>");
-    prXMLEle(outputFile, root, 0);
-
-    fclose(outputFile);
-
     return true;
 }
 
@@ -4523,6 +4492,7 @@ void SchedulerProcess::updateCompletedJobsCount(bool forced)
     }
 
     moduleState()->setCapturedFramesCount(newFramesCount);
+    PlaceholderPath::saveFileIndex();
 
     {
         qCDebug(KSTARS_EKOS_SCHEDULER) << "Frame map summary:";
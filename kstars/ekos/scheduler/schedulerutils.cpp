@@ -8,13 +8,26 @@
 #include "schedulerjob.h"
 #include "schedulermodulestate.h"
 #include "ekos/capture/sequencejob.h"
+#include "ekos/capture/sequencequeue.h"
 #include "Options.h"
 #include "skypoint.h"
 #include "kstarsdata.h"
 #include <ekos_scheduler_debug.h>
 
+#include <QDir>
+#include <QFileInfo>
+
+#include <cmath>
+#include <memory>
+
 namespace Ekos {
 
+// Radians of hour angle per second of time
+static const double g_hourAnglePerSecond = SIDEREALSECOND * dms::PI / 43200.0;
+// TargetAltitudes::altitudes() steps the hour angle by rotations, starting
+// afresh from sin() and cos() after this many of them
+static const int g_rotations = 64;
+
 SchedulerUtils::SchedulerUtils()
 {
 
@@ -332,60 +345,114 @@ SequenceJob *SchedulerUtils::processSequenceJobInfo(XMLEle *root, SchedulerJob *
 
 bool SchedulerUtils::loadSequenceQueue(const QString &fileURL, SchedulerJob *schedJob, QList<SequenceJob *> &jobs, bool &hasAutoFocus, ModuleLogger *logger)
 {
-    QFile sFile;
-    sFile.setFileName(fileURL);
-
-    if (!sFile.open(QIODevice::ReadOnly))
+    QList<std::shared_ptr<XMLEle>> roots;
+    QString errorText;
+    if (!SequenceQueue::parseFile(fileURL, roots, errorText))
     {
-        if (logger != nullptr) logger->appendLogText(i18n("Unable to open sequence queue file '%1'", fileURL));
-                return false;
+        if (logger != nullptr) logger->appendLogText(errorText);
+        return false;
     }
 
-    LilXML *xmlParser = newLilXML();
-    char errmsg[MAXRBUF];
-    XMLEle *root = nullptr;
-    XMLEle *ep   = nullptr;
-    char c;
+    XMLEle *ep = nullptr;
 
-    while (sFile.getChar(&c))
+    for (const auto &root : roots)
     {
-        root = readXMLEle(xmlParser, c, errmsg);
-
-        if (root)
+        for (ep = nextXMLEle(root.get(), 1); ep != nullptr; ep = nextXMLEle(root.get(), 0))
         {
-            for (ep = nextXMLEle(root, 1); ep != nullptr; ep = nextXMLEle(root, 0))
+            if (!strcmp(tagXMLEle(ep), "Autofocus"))
+                hasAutoFocus = (!strcmp(findXMLAttValu(ep, "enabled"), "true"));
+            else if (!strcmp(tagXMLEle(ep), "Job"))
             {
-                if (!strcmp(tagXMLEle(ep), "Autofocus"))
-                    hasAutoFocus = (!strcmp(findXMLAttValu(ep, "enabled"), "true"));
-                else if (!strcmp(tagXMLEle(ep), "Job"))
+                SequenceJob *thisJob = processSequenceJobInfo(ep, schedJob);
+                jobs.append(thisJob);
+                if (jobs.count() == 1)
                 {
-                    SequenceJob *thisJob = processSequenceJobInfo(ep, schedJob);
-                    jobs.append(thisJob);
-                    if (jobs.count() == 1)
+                    auto &firstJob = jobs.first();
+                    if (FRAME_LIGHT == firstJob->getFrameType() && nullptr != schedJob)
                     {
-                        auto &firstJob = jobs.first();
-                        if (FRAME_LIGHT == firstJob->getFrameType() && nullptr != schedJob)
-                        {
-                            schedJob->setInitialFilter(firstJob->getCoreProperty(SequenceJob::SJ_Filter).toString());
-                        }
-
+                        schedJob->setInitialFilter(firstJob->getCoreProperty(SequenceJob::SJ_Filter).toString());
                     }
+
                 }
             }
-            delXMLEle(root);
         }
-        else if (errmsg[0])
+    }
+
+    return true;
+}
+
+bool SchedulerUtils::writeJobSequence(XMLEle *root, const QString &prefix, const QString &outputDir, QString &errorText)
+{
+    XMLEle *ep    = nullptr;
+    XMLEle *subEP = nullptr;
+
+    for (ep = nextXMLEle(root, 1); ep != nullptr; ep = nextXMLEle(root, 0))
+    {
+        if (!strcmp(tagXMLEle(ep), "Job"))
         {
-            if (logger != nullptr) logger->appendLogText(QString(errmsg));
-            delLilXML(xmlParser);
-            qDeleteAll(jobs);
-            return false;
+            for (subEP = nextXMLEle(ep, 1); subEP != nullptr; subEP = nextXMLEle(ep, 0))
+            {
+                if (!strcmp(tagXMLEle(subEP), "Prefix"))
+                {
+                    XMLEle *rawPrefix = findXMLEle(subEP, "RawPrefix");
+                    if (rawPrefix)
+                    {
+                        editXMLEle(rawPrefix, prefix.toLatin1().constData());
+                    }
+                }
+                else if (!strcmp(tagXMLEle(subEP), "FITSDirectory"))
+                {
+                    editXMLEle(subEP, outputDir.toLatin1().constData());
+                }
+            }
         }
     }
 
+    QDir().mkpath(outputDir);
+
+    QString filename = QString("%1/%2.esq").arg(outputDir, prefix);
+    FILE *outputFile = fopen(filename.toLatin1().constData(), "w");
+
+    if (outputFile == nullptr)
+    {
+        errorText = i18n("Unable to write to file %1", filename);
+        return false;
+    }
+
+    fprintf(outputFile, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>");
+    prXMLEle(outputFile, root, 0);
+
+    fclose(outputFile);
+
     return true;
 }
 
+bool SchedulerUtils::writeJobSequence(const QByteArray &sequence, const QString &prefix, const QString &outputDir,
+                                      QString &errorText)
+{
+    LilXML *xmlParser = newLilXML();
+    char errmsg[MAXRBUF];
+    XMLEle *root = nullptr;
+
+    for (const char c : sequence)
+    {
+        root = readXMLEle(xmlParser, c, errmsg);
+        if (root || errmsg[0])
+            break;
+    }
+    delLilXML(xmlParser);
+
+    if (root == nullptr)
+    {
+        errorText = i18n("Unable to read the sequence queue for %1", prefix);
+        return false;
+    }
+
+    const bool result = writeJobSequence(root, prefix, outputDir, errorText);
+    delXMLEle(root);
+    return result;
+}
+
 bool SchedulerUtils::estimateJobTime(SchedulerJob *schedJob, const QMap<QString, uint16_t> &capturedFramesCount, ModuleLogger *logger)
 {
     static SchedulerJob *jobWarned = nullptr;
@@ -721,8 +788,7 @@ double SchedulerUtils::findAltitude(const SkyPoint &target, const QDateTime &whe
     o.setDec0(target.dec0());
 
     // Update RA/DEC of the target for the current fraction of the day
-    KSNumbers numbers(ltWhen.djd());
-    o.updateCoordsNow(&numbers);
+    o.updateCoordsNow(KSNumbers::shared(ltWhen.djd()).get());
 
     // Calculate alt/az coordinates using KStars instance's geolocation
     CachingDms const LST = SchedulerModuleState::getGeo()->GSTtoLST(SchedulerModuleState::getGeo()->LTtoUT(ltWhen).gst());
@@ -754,4 +820,86 @@ double SchedulerUtils::findAltitude(const SkyPoint &target, const QDateTime &whe
     return o.alt().Degrees();
 }
 
+TargetAltitudes::TargetAltitudes(const SkyPoint &target, const KStarsDateTime &ut, const GeoLocation *geo) : m_reference(ut)
+{
+    // Create a sky object with the target catalog coordinates, at its apparent place for the reference
+    SkyObject o;
+    o.setRA0(target.ra0());
+    o.setDec0(target.dec0());
+    o.updateCoordsNow(KSNumbers::shared(ut.djd()).get());
+
+    CachingDms const LST = geo->GSTtoLST(ut.gst());
+    m_hourAngle = LST.radians() - o.ra().radians();
+    o.dec().SinCos(m_sinDec, m_cosDec);
+    geo->lat()->SinCos(m_sinLat, m_cosLat);
+}
+
+// The altitude, and optionally the azimuth, as SkyPoint::EquatorialToHorizontal() finds them
+static double horizontal(double sinDec, double cosDec, double sinLat, double cosLat, double sinHA, double cosHA,
+                         double *azimuth)
+{
+    double const sinAlt = sinDec * sinLat + cosDec * cosLat * cosHA;
+
+    if (azimuth)
+    {
+        double const cosAlt = sqrt(1 - sinAlt * sinAlt);
+        double const arg    = (sinDec - sinLat * sinAlt) / (cosLat * cosAlt);
+        double az           = arg <= -1.0 ? dms::PI : arg >= 1.0 ? 0.0 : acos(arg);
+        if (sinHA > 0.0 && az != 0.0)
+            az = 2.0 * dms::PI - az; // resolve acos() ambiguity
+        *azimuth = az / dms::DegToRad;
+    }
+
+    return asin(sinAlt) / dms::DegToRad;
+}
+
+double TargetAltitudes::altitude(double seconds, double *azimuth, bool *is_setting) const
+{
+    double const hourAngle = m_hourAngle + seconds * g_hourAnglePerSecond;
+
+    if (is_setting)
+    {
+        // The target has passed the meridian if its hour angle, reduced to [0,24h[, is under 12h
+        double const reduced = hourAngle - 2.0 * dms::PI * floor(hourAngle / (2.0 * dms::PI));
+        *is_setting = reduced < dms::PI;
+    }
+
+    return horizontal(m_sinDec, m_cosDec, m_sinLat, m_cosLat, sin(hourAngle), cos(hourAngle), azimuth);
+}
+
+void TargetAltitudes::altitudes(double start, double step, int count, double *altitudes, double *azimuths,
+                                bool *settings) const
+{
+    CachingRadians const rotation(step * g_hourAnglePerSecond);
+    CachingRadians hourAngle;
+
+    // The hour angles are stepped through in chunks, each chunk converted at once
+    constexpr int chunk = 256;
+    double sinHAs[chunk], cosHAs[chunk], sinDecs[chunk], cosDecs[chunk];
+    std::fill_n(sinDecs, chunk, m_sinDec);
+    std::fill_n(cosDecs, chunk, m_cosDec);
+
+    for (int first = 0; first < count; first += chunk)
+    {
+        int const n = std::min(chunk, count - first);
+        for (int j = 0; j < n; ++j)
+        {
+            int const i = first + j;
+            if (i % g_rotations == 0)
+                hourAngle = CachingRadians(m_hourAngle + (start + i * step) * g_hourAnglePerSecond);
+
+            double const sinHA = hourAngle.sin(), cosHA = hourAngle.cos();
+            sinHAs[j] = sinHA;
+            cosHAs[j] = cosHA;
+            if (settings)
+                settings[i] = sinHA > 0.0 || (sinHA == 0.0 && cosHA > 0.0);
+
+            hourAngle = hourAngle + rotation;
+        }
+
+        SkyPoint::horizontal(sinHAs, cosHAs, sinDecs, cosDecs, n, m_sinLat, m_cosLat, altitudes + first,
+                             azimuths ? azimuths + first : nullptr);
+    }
+}
+
 } // namespace
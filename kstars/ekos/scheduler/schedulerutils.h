@@ -10,11 +10,13 @@
 #include "schedulertypes.h"
 #include "ekos/auxiliary/modulelogger.h"
 #include "dms.h"
+#include "kstarsdatetime.h"
 #include "libindi/lilxml.h"
 
 #include <QString>
 #include <QUrl>
 
+class GeoLocation;
 class SkyPoint;
 
 namespace Ekos {
@@ -95,6 +97,22 @@ public:
          */
     static bool estimateJobTime(SchedulerJob *schedJob, const QMap<QString, uint16_t> &capturedFramesCount, ModuleLogger *logger);
 
+    /**
+     * @brief writeJobSequence Save the capture sequence root with its prefix and output directory replaced, as outputDir/prefix.esq.
+     * Does not involve the GUI, so that the sequences of large mosaics can be written off the GUI thread.
+     * @param root the capture sequence, edited in place
+     * @param prefix prefix to set for the job sequence
+     * @param outputDir output directory to set for the job sequence
+     * @param errorText set to what went wrong if the file could not be saved
+     * @return true if the file was saved
+     */
+    static bool writeJobSequence(XMLEle *root, const QString &prefix, const QString &outputDir, QString &errorText);
+
+    /**
+     * @brief writeJobSequence Like above, for the capture sequence given as the content of a sequence file.
+     */
+    static bool writeJobSequence(const QByteArray &sequence, const QString &prefix, const QString &outputDir, QString &errorText);
+
     /**
      * @brief timeHeuristics Estimates the number of seconds of overhead above and beyond imaging time, used by estimateJobTime.
      * @param schedJob the scheduler job.
@@ -123,5 +141,57 @@ public:
     static double findAltitude(const SkyPoint &target, const QDateTime &when, bool *is_setting = nullptr, bool debug = false);
 };
 
+/**
+ * @class TargetAltitudes
+ * @short Altitudes of a fixed target at many times around a reference time.
+ *
+ * The apparent place of the target and the local sidereal time are computed once, at the
+ * reference time. The altitude at another time then only depends on the hour angle, which
+ * runs at the sidereal rate. Over a day the apparent place moves by well under an arcsecond,
+ * far below what the scheduler resolves, so this stands in for findAltitude() in the loops
+ * that step through a night.
+ */
+class TargetAltitudes
+{
+public:
+    /**
+     * @param target Target, with its catalog coordinates set
+     * @param ut reference time, in UT
+     * @param geo location of the observer
+     */
+    TargetAltitudes(const SkyPoint &target, const KStarsDateTime &ut, const GeoLocation *geo);
+
+    /** @return the reference time, in UT */
+    const KStarsDateTime &reference() const { return m_reference; }
+
+    /**
+     * @brief altitude Find the altitude of the target at a time
+     * @param seconds time since the reference, in seconds
+     * @param azimuth set to the azimuth of the target, in degrees (optional)
+     * @param is_setting set to whether the target has passed the meridian (optional)
+     * @return the altitude in degrees, like findAltitude()
+     */
+    double altitude(double seconds, double *azimuth = nullptr, bool *is_setting = nullptr) const;
+
+    /**
+     * @brief altitudes Find the altitudes of the target at evenly spaced times
+     * @param start time of the first altitude since the reference, in seconds
+     * @param step seconds between two altitudes
+     * @param count number of altitudes
+     * @param altitudes filled with count altitudes, in degrees
+     * @param azimuths filled with count azimuths, in degrees (optional)
+     * @param settings filled with count flags telling whether the target has passed the meridian (optional)
+     */
+    void altitudes(double start, double step, int count, double *altitudes, double *azimuths = nullptr,
+                   bool *settings = nullptr) const;
+
+private:
+    KStarsDateTime m_reference;
+    /// Hour angle at the reference, in radians
+    double m_hourAngle { 0 };
+    double m_sinDec { 0 }, m_cosDec { 1 };
+    double m_sinLat { 0 }, m_cosLat { 1 };
+};
+
 
 } // namespace
@@ -0,0 +1,122 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QVector>
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/**
+ * Full resolution histograms, with one bin per possible ADU value.
+ *
+ * They are only built for 8 and 16 bit unsigned data, where the bins fit in cache.
+ * A single pass over the image is then enough to derive exact medians, percentiles and
+ * median absolute deviations without sorting.
+ */
+namespace FineHistogram
+{
+
+template <typename T>
+constexpr bool isSupported()
+{
+    return std::is_same<T, uint8_t>::value || std::is_same<T, uint16_t>::value;
+}
+
+/**
+ * @brief fill Count all the samples of a region of an image, e.g. a selection.
+ * @param origin First sample of the region.
+ * @param width Number of samples per row of the region.
+ * @param height Number of rows of the region.
+ * @param pitch Distance in samples between the starts of two rows.
+ * @param histogram Receives one count per ADU value.
+ */
+template <typename T>
+void fill(const T *origin, uint32_t width, uint32_t height, uint32_t pitch, QVector<uint32_t> &histogram)
+{
+    static_assert(isSupported<T>(), "Fine histograms are only supported for 8 and 16 bit unsigned data");
+    histogram.fill(0, static_cast<int>(std::numeric_limits<T>::max()) + 1);
+    auto *bins = histogram.data();
+    for (uint32_t y = 0; y < height; y++)
+    {
+        const T *row = origin + static_cast<size_t>(y) * pitch;
+        for (uint32_t x = 0; x < width; x++)
+            bins[row[x]]++;
+    }
+}
+
+/**
+ * @brief fill Count all the samples of the buffer.
+ * @param buffer The samples, e.g. one channel of a FITS image.
+ * @param count Number of samples in buffer.
+ * @param histogram Receives one count per ADU value.
+ */
+template <typename T>
+void fill(const T *buffer, uint32_t count, QVector<uint32_t> &histogram)
+{
+    fill(buffer, count, 1, count, histogram);
+}
+
+/**
+ * @brief total Number of samples counted in the histogram.
+ */
+inline uint64_t total(const QVector<uint32_t> &histogram)
+{
+    uint64_t sum = 0;
+    for (const auto bin : histogram)
+        sum += bin;
+    return sum;
+}
+
+/**
+ * @brief percentile Return the ADU value of the sample of rank fraction * samples.
+ * @note With fraction = 0.5 this is the element std::nth_element would return for the middle position.
+ */
+inline int percentile(const QVector<uint32_t> &histogram, double fraction)
+{
+    const uint64_t samples = total(histogram);
+    if (samples == 0)
+        return 0;
+
+    const uint64_t rank = qMin<uint64_t>(samples - 1, static_cast<uint64_t>(fraction * samples));
+    uint64_t accumulator = 0;
+    for (int i = 0; i < histogram.size(); i++)
+    {
+        accumulator += histogram[i];
+        if (accumulator > rank)
+            return i;
+    }
+    return histogram.size() - 1;
+}
+
+/**
+ * @brief medianDeviation Median of the absolute deviations from median, without the 1.4826 factor.
+ */
+inline int medianDeviation(const QVector<uint32_t> &histogram, int median)
+{
+    const uint64_t samples = total(histogram);
+    if (samples == 0)
+        return 0;
+
+    // Fold the histogram around the median, deviation d holds the samples at median +/- d.
+    const uint64_t rank = samples / 2;
+    const int size = histogram.size();
+    uint64_t accumulator = 0;
+    for (int d = 0; d < size; d++)
+    {
+        if (median + d < size)
+            accumulator += histogram[median + d];
+        if (d > 0 && median - d >= 0)
+            accumulator += histogram[median - d];
+        if (accumulator > rank)
+            return d;
+    }
+    return size - 1;
+}
+
+}
@@ -16,8 +16,31 @@
 #include "fitsdata.h"
 
 #include <QElapsedTimer>
+#include <QMutex>
 #include <QtConcurrent>
 
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Once three lines are found, the next frame of the same size is only searched this close to them
+constexpr int SEARCH_WINDOW_DEGREES = 6;
+// A full sweep is still done this often, in case a line was lost
+constexpr int FULL_SWEEP_INTERVAL = 10;
+
+// The angles of the lines found in the last frame, focusing goes through frames of the same box
+struct PreviousSolution
+{
+    QSize size;
+    QVector<int> angles;
+    int frames { 0 };
+};
+
+QMutex g_PreviousSolutionMutex;
+PreviousSolution g_PreviousSolution;
+}
+
 //void FITSBahtinovDetector::configure(const QString &setting, const QVariant &value)
 //{
 //    if (!setting.compare("NUMBER_OF_AVERAGE_ROWS", Qt::CaseInsensitive))
@@ -50,29 +73,29 @@ QFuture<bool> FITSBahtinovDetector::findSources(QRect const &boundary)
     switch (stats.dataType)
     {
         case TSHORT:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<int16_t>, boundary);
+            return findInLane(lane(), this, &FITSBahtinovDetector::findBahtinovStar<int16_t>, boundary);
 
         case TUSHORT:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<uint16_t>, boundary);
+            return findInLane(lane(), this, &FITSBahtinovDetector::findBahtinovStar<uint16_t>, boundary);
 
         case TLONG:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<int32_t>, boundary);
+            return findInLane(lane(), this, &FITSBahtinovDetector::findBahtinovStar<int32_t>, boundary);
 
         case TULONG:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<uint32_t>, boundary);
+            return findInLane(lane(), this, &FITSBahtinovDetector::findBahtinovStar<uint32_t>, boundary);
 
         case TFLOAT:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<float>, boundary);
+            return findInLane(lane(), this, &FITSBahtinovDetector::findBahtinovStar<float>, boundary);
 
         case TLONGLONG:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<int64_t>, boundary);
+            return findInLane(lane(), this, &FITSBahtinovDetector::findBahtinovStar<int64_t>, boundary);
 
         case TDOUBLE:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<double>, boundary);
+            return findInLane(lane(), this, &FITSBahtinovDetector::findBahtinovStar<double>, boundary);
 
         default:
         case TBYTE:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<uint8_t>, boundary);
+            return findInLane(lane(), this, &FITSBahtinovDetector::findBahtinovStar<uint8_t>, boundary);
 
     }
 }
@@ -139,23 +162,67 @@ bool FITSBahtinovDetector::findBahtinovStar(const QRect &boundary)
     const int steps = 180;
     double radPerStep = M_PI / steps;
 
+    int NUMBER_OF_AVERAGE_ROWS = getValue("NUMBER_OF_AVERAGE_ROWS", 1).toInt();
+    if (NUMBER_OF_AVERAGE_ROWS % 2 == 0)
+    {
+        NUMBER_OF_AVERAGE_ROWS--;
+        qCWarning(KSTARS_FITS) << "Warning, number of rows must be an odd number, correcting number of rows to "
+                               << NUMBER_OF_AVERAGE_ROWS;
+    }
+    // Rows must be a positive number!
+    if (NUMBER_OF_AVERAGE_ROWS < 1)
+    {
+        NUMBER_OF_AVERAGE_ROWS = 1;
+        qCWarning(KSTARS_FITS) << "Warning, number of rows must be positive correcting number of rows to "
+                               << NUMBER_OF_AVERAGE_ROWS;
+    }
+
+    // Only look around the lines of the previous frame, unless it is time for a full sweep
+    QVector<bool> searched(steps, true);
+    bool windowed = false;
+    {
+        QMutexLocker locker(&g_PreviousSolutionMutex);
+        if (g_PreviousSolution.size == QSize(subW, subH) && g_PreviousSolution.angles.size() == 3 &&
+                ++g_PreviousSolution.frames < FULL_SWEEP_INTERVAL)
+        {
+            windowed = true;
+            searched.fill(false);
+            for (int previous : g_PreviousSolution.angles)
+                for (int angle = previous - SEARCH_WINDOW_DEGREES; angle <= previous + SEARCH_WINDOW_DEGREES; angle++)
+                    searched[(angle + steps) % steps] = true;
+        }
+        else
+            g_PreviousSolution.frames = 0;
+    }
+
     timer1.start();
 
+    QVector<std::pair<int, BahtinovLineAverage>> sweep;
     for (int angle = 0; angle < steps; angle++)
     {
-        // TODO Apply multi threading to speed up calculation
-        BahtinovLineAverage lineAverage = calculateMaxAverage<T>(boundedImage, angle);
-        // Store line average in map
-        lineAveragesPerAngle.insert(angle, lineAverage);
+        if (searched[angle])
+            sweep.append({ angle, BahtinovLineAverage() });
     }
 
-    qCDebug(KSTARS_FITS) << "Getting max average for all 180 rotations took" << timer1.elapsed() << "milliseconds";
+    // Each angle rotates its own copy of the image, so they are all done at once
+    ProcessingLanes::blockingMap(lane(), sweep, [&](std::pair<int, BahtinovLineAverage> &lineAverage)
+    {
+        lineAverage.second = calculateMaxAverage<T>(boundedImage, lineAverage.first, NUMBER_OF_AVERAGE_ROWS);
+    });
+
+    // Store line averages in map
+    for (const auto &lineAverage : sweep)
+        lineAveragesPerAngle.insert(lineAverage.first, lineAverage.second);
+
+    qCDebug(KSTARS_FITS) << "Getting max average for" << sweep.size() << "rotations took" << timer1.elapsed() <<
+                         "milliseconds";
 
     // Not needed anymore
     delete boundedImage;
 
     // Calculate Bahtinov angles
     QVector<HoughLine*> bahtinov_angles;
+    QVector<int> foundAngles;
 
     // For all three Bahtinov angles
     for (int index1 = 0; index1 < 3; index1++)
@@ -174,6 +241,7 @@ bool FITSBahtinovDetector::findBahtinovStar(const QRect &boundary)
             }
         }
         HoughLine* pHoughLine = new HoughLine(maxAngle * radPerStep, maxAverageOffset, subW, subH, maxAverage);
+        foundAngles.append(static_cast<int>(maxAngle));
         if (pHoughLine != nullptr)
         {
             bahtinov_angles.append(pHoughLine);
@@ -198,6 +266,7 @@ bool FITSBahtinovDetector::findBahtinovStar(const QRect &boundary)
 
     // Proceed with focus offset calculation, but only when at least 3 lines have been detected
     QVector<HoughLine*> top3Lines;
+    bool solved = false;
     if (bahtinov_angles.size() >= 3)
     {
         HoughLine::getSortedTopThreeLines(bahtinov_angles, top3Lines);
@@ -248,6 +317,7 @@ bool FITSBahtinovDetector::findBahtinovStar(const QRect &boundary)
                 center->line.append(*midLine);
                 center->line.append(*otherLine);
                 starCenters.append(center);
+                solved = true;
             }
             else
             {
@@ -260,6 +330,21 @@ bool FITSBahtinovDetector::findBahtinovStar(const QRect &boundary)
         }
     }
 
+    {
+        // A line at the edge of its window may have moved out of it, so a full sweep is needed then
+        bool tracked = solved;
+        if (windowed)
+        {
+            for (int angle : foundAngles)
+                tracked = tracked && searched[(angle + SEARCH_WINDOW_DEGREES) % steps] &&
+                          searched[(angle - SEARCH_WINDOW_DEGREES + steps) % steps];
+        }
+
+        QMutexLocker locker(&g_PreviousSolutionMutex);
+        g_PreviousSolution.size = QSize(subW, subH);
+        g_PreviousSolution.angles = tracked ? foundAngles : QVector<int>();
+    }
+
     // Clean up Bahtinov line array (of pointers) as they are no longer needed
     for (int index = 0; index < bahtinov_angles.size(); index++)
     {
@@ -282,7 +367,7 @@ bool FITSBahtinovDetector::findBahtinovStar(const QRect &boundary)
 }
 
 template <typename T>
-BahtinovLineAverage FITSBahtinovDetector::calculateMaxAverage(const FITSData *data, int angle)
+BahtinovLineAverage FITSBahtinovDetector::calculateMaxAverage(const FITSData *data, int angle, int NUMBER_OF_AVERAGE_ROWS)
 {
     int BBP = data->getBytesPerPixel();
     int size = data->getStatistics().samples_per_channel;
@@ -300,21 +385,6 @@ BahtinovLineAverage FITSBahtinovDetector::calculateMaxAverage(const FITSData *da
 
     //    printf("Angle;%d;Width;%d;Height;%d;Rows;%d;;RowSum;", angle, width, height, NUMBER_OF_AVERAGE_ROWS);
 
-    int NUMBER_OF_AVERAGE_ROWS = getValue("NUMBER_OF_AVERAGE_ROWS", 1).toInt();
-    if (NUMBER_OF_AVERAGE_ROWS % 2 == 0)
-    {
-        NUMBER_OF_AVERAGE_ROWS--;
-        qCWarning(KSTARS_FITS) << "Warning, number of rows must be an odd number, correcting number of rows to "
-                               << NUMBER_OF_AVERAGE_ROWS;
-    }
-    // Rows must be a positive number!
-    if (NUMBER_OF_AVERAGE_ROWS < 1)
-    {
-        NUMBER_OF_AVERAGE_ROWS = 1;
-        qCWarning(KSTARS_FITS) << "Warning, number of rows must be positive correcting number of rows to "
-                               << NUMBER_OF_AVERAGE_ROWS;
-    }
-
     for (int y = 0; y < height; y++)
     {
         int yMin = y - ((NUMBER_OF_AVERAGE_ROWS - 1) / 2);
@@ -421,6 +491,20 @@ bool FITSBahtinovDetector::rotateImage(const FITSData *data, int angle, T * rotI
     int topEdge = qCeil(hy - innerCircleRadius);
     int bottomEdge = qFloor(hy + innerCircleRadius);
 
+    // The rotation of each column and each row, translated back, so a pixel only takes two additions
+    const int columns = std::max(0, rightEdge - leftEdge), rows = std::max(0, bottomEdge - topEdge);
+    std::vector<double> xCos(columns), xSin(columns), ySin(rows), yCos(rows);
+    for (int x1 = leftEdge; x1 < rightEdge; x1++)
+    {
+        xCos[x1 - leftEdge] = (x1 - hx) * cosAngle + hx;
+        xSin[x1 - leftEdge] = (x1 - hx) * sinAngle + hy;
+    }
+    for (int y1 = topEdge; y1 < bottomEdge; y1++)
+    {
+        ySin[y1 - topEdge] = (y1 - hy) * sinAngle;
+        yCos[y1 - topEdge] = (y1 - hy) * cosAngle;
+    }
+
     for (int i = 0; i < numChannels; i++)
     {
         int offset = size * i;
@@ -428,17 +512,9 @@ bool FITSBahtinovDetector::rotateImage(const FITSData *data, int angle, T * rotI
         {
             for (int y1 = topEdge; y1 < bottomEdge; y1++)
             {
-                // translate point back to origin:
-                double x2 = x1 - hx;
-                double y2 = y1 - hy;
-
-                // rotate point
-                double xnew = x2 * cosAngle - y2 * sinAngle;
-                double ynew = x2 * sinAngle + y2 * cosAngle;
-
-                // translate point back:
-                x2 = xnew + hx;
-                y2 = ynew + hy;
+                // rotate point around the center
+                double x2 = xCos[x1 - leftEdge] - ySin[y1 - topEdge];
+                double y2 = xSin[x1 - leftEdge] + yCos[y1 - topEdge];
 
                 int orgIndex = y1 * height + x1;
                 int newIndex = qRound(y2) * height + qRound(x2);
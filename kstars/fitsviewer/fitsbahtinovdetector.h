@@ -58,7 +58,7 @@ class FITSBahtinovDetector: public FITSStarDetector
 
     private:
         template <typename T>
-        BahtinovLineAverage calculateMaxAverage(const FITSData *data, int angle);
+        BahtinovLineAverage calculateMaxAverage(const FITSData *data, int angle, int NUMBER_OF_AVERAGE_ROWS);
         template <typename T>
         bool rotateImage(const FITSData *data, int angle, T * rotimage);
 };
@@ -57,28 +57,28 @@ QFuture<bool> FITSCentroidDetector::findSources(const QRect &boundary)
     {
         case TBYTE:
         default:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<uint8_t const>, boundary);
+            return findInLane(lane(), this, &FITSCentroidDetector::findSources<uint8_t const>, boundary);
 
         case TSHORT:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<int16_t const>, boundary);
+            return findInLane(lane(), this, &FITSCentroidDetector::findSources<int16_t const>, boundary);
 
         case TUSHORT:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<uint16_t const>, boundary);
+            return findInLane(lane(), this, &FITSCentroidDetector::findSources<uint16_t const>, boundary);
 
         case TLONG:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<int32_t const>, boundary);
+            return findInLane(lane(), this, &FITSCentroidDetector::findSources<int32_t const>, boundary);
 
         case TULONG:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<uint32_t const>, boundary);
+            return findInLane(lane(), this, &FITSCentroidDetector::findSources<uint32_t const>, boundary);
 
         case TFLOAT:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<float const>, boundary);
+            return findInLane(lane(), this, &FITSCentroidDetector::findSources<float const>, boundary);
 
         case TLONGLONG:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<int64_t const>, boundary);
+            return findInLane(lane(), this, &FITSCentroidDetector::findSources<int64_t const>, boundary);
 
         case TDOUBLE:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<double const>, boundary);
+            return findInLane(lane(), this, &FITSCentroidDetector::findSources<double const>, boundary);
 
     }
 }
@@ -94,9 +94,7 @@ bool FITSCentroidDetector::findSources(const QRect &boundary)
     double JMIndex = getValue("JMINDEX", 100.0).toDouble();
 
     int initStdDev = MINIMUM_STDVAR;
-    double threshold = 0, sum = 0, avg = 0, min = 0;
-    int starDiameter     = 0;
-    int pixVal           = 0;
+    double threshold = 0, sum = 0, min = 0;
     int minimumEdgeCount = MINIMUM_EDGE_LIMIT;
 
     auto * buffer = reinterpret_cast<T const *>(m_ImageData->getImageBuffer());
@@ -181,69 +179,88 @@ bool FITSCentroidDetector::findSources(const QRect &boundary)
             subH = subY + boundary.height();
         }
 
-        // Detect "edges" that are above threshold
-        for (int i = subY; i < subH; i++)
+        // Detect "edges" that are above threshold, in bands of rows scanned at once
+        struct RowBand
         {
-            starDiameter = 0;
-
-            for (int j = subX; j < subW; j++)
+            int start;
+            int end;
+            QList<Edge *> edges;
+        };
+        QVector<RowBand> bands;
+        for (int start = subY; start < subH; start += ROW_BAND_HEIGHT)
+            bands.append({ start, qMin(start + ROW_BAND_HEIGHT, subH), QList<Edge *>() });
+
+        ProcessingLanes::blockingMap(lane(), bands, [&](RowBand & band)
+        {
+            for (int i = band.start; i < band.end; i++)
             {
-                pixVal = buffer[j + (i * stats.width)] - min;
+                // Each row starts afresh, so that the bands do not depend on one another
+                double avg = 0, sum = 0;
+                int starDiameter = 0;
 
-                // If pixel value > threshold, let's get its weighted average
-                if (pixVal >= threshold)
-                {
-                    avg += j * pixVal;
-                    sum += pixVal;
-                    starDiameter++;
-                }
-                // Value < threshold but avg exists
-                else if (sum > 0)
+                for (int j = subX; j < subW; j++)
                 {
-                    // We found a potential centroid edge
-                    if (starDiameter >= minEdgeWidth)
+                    int pixVal = buffer[j + (i * stats.width)] - min;
+
+                    // If pixel value > threshold, let's get its weighted average
+                    if (pixVal >= threshold)
+                    {
+                        avg += j * pixVal;
+                        sum += pixVal;
+                        starDiameter++;
+                    }
+                    // Value < threshold but avg exists
+                    else if (sum > 0)
                     {
-                        float center = avg / sum + 0.5;
-                        if (center > 0)
+                        // We found a potential centroid edge
+                        if (starDiameter >= minEdgeWidth)
                         {
-                            int i_center = std::floor(center);
-
-                            // Check if center is 10% or more brighter than edge, if not skip
-                            if (((buffer[i_center + (i * stats.width)] - min) /
-                                    (buffer[i_center + (i * stats.width) - starDiameter / 2] - min) >=
-                                    dispersion_ratio) &&
-                                    ((buffer[i_center + (i * stats.width)] - min) /
-                                     (buffer[i_center + (i * stats.width) + starDiameter / 2] - min) >=
-                                     dispersion_ratio))
+                            float center = avg / sum + 0.5;
+                            if (center > 0)
                             {
-                                qCDebug(KSTARS_FITS)
-                                        << "Edge center is " << buffer[i_center + (i * stats.width)] - min
-                                        << " Edge is " << buffer[i_center + (i * stats.width) - starDiameter / 2] - min
-                                        << " and ratio is "
-                                        << ((buffer[i_center + (i * stats.width)] - min) /
-                                            (buffer[i_center + (i * stats.width) - starDiameter / 2] - min))
-                                        << " located at X: " << center << " Y: " << i + 0.5;
-
-                                auto * newEdge = new Edge();
-
-                                newEdge->x       = center;
-                                newEdge->y       = i + 0.5;
-                                newEdge->scanned = 0;
-                                newEdge->val     = buffer[i_center + (i * stats.width)] - min;
-                                newEdge->width   = starDiameter;
-                                newEdge->HFR     = 0;
-                                newEdge->sum     = sum;
-
-                                edges.append(newEdge);
+                                int i_center = std::floor(center);
+
+                                // Check if center is 10% or more brighter than edge, if not skip
+                                if (((buffer[i_center + (i * stats.width)] - min) /
+                                        (buffer[i_center + (i * stats.width) - starDiameter / 2] - min) >=
+                                        dispersion_ratio) &&
+                                        ((buffer[i_center + (i * stats.width)] - min) /
+                                         (buffer[i_center + (i * stats.width) + starDiameter / 2] - min) >=
+                                         dispersion_ratio))
+                                {
+                                    qCDebug(KSTARS_FITS)
+                                            << "Edge center is " << buffer[i_center + (i * stats.width)] - min
+                                            << " Edge is " << buffer[i_center + (i * stats.width) - starDiameter / 2] - min
+                                            << " and ratio is "
+                                            << ((buffer[i_center + (i * stats.width)] - min) /
+                                                (buffer[i_center + (i * stats.width) - starDiameter / 2] - min))
+                                            << " located at X: " << center << " Y: " << i + 0.5;
+
+                                    auto * newEdge = new Edge();
+
+                                    newEdge->x       = center;
+                                    newEdge->y       = i + 0.5;
+                                    newEdge->scanned = 0;
+                                    newEdge->val     = buffer[i_center + (i * stats.width)] - min;
+                                    newEdge->width   = starDiameter;
+                                    newEdge->HFR     = 0;
+                                    newEdge->sum     = sum;
+
+                                    band.edges.append(newEdge);
+                                }
                             }
                         }
-                    }
 
-                    // Reset
-                    avg = sum = starDiameter = 0;
+                        // Reset
+                        avg = sum = starDiameter = 0;
+                    }
                 }
             }
-        }
+        });
+
+        // The edges are kept in the order of the rows
+        for (auto &band : bands)
+            edges.append(band.edges);
 
         qCDebug(KSTARS_FITS) << "Total number of edges found is: " << edges.count();
 
@@ -366,11 +383,6 @@ bool FITSCentroidDetector::findSources(const QRect &boundary)
 
             qCDebug(KSTARS_FITS) << "Found a real center with number with (" << rCenter->x << "," << rCenter->y << ")";
 
-            // Calculate Total Flux From Center, Half Flux, Full Summation
-            double TF   = 0;
-            double HF   = 0;
-            double FSum = 0;
-
             cen_x = (int)std::floor(rCenter->x);
             cen_y = (int)std::floor(rCenter->y);
 
@@ -380,47 +392,59 @@ bool FITSCentroidDetector::findSources(const QRect &boundary)
                 continue;
             }
 
-            // Complete sum along the radius
-            //for (int k=0; k < rCenter->width; k++)
-            for (int k = rCenter->width / 2; k >= -(rCenter->width / 2); k--)
-            {
-                FSum += buffer[cen_x - k + (cen_y * stats.width)] - min;
-                //qDebug() << Q_FUNC_INFO << image_buffer[cen_x-k+(cen_y*stats.width)] - min;
-            }
+            starCenters.append(rCenter);
+        }
+    }
 
-            // Half flux
-            HF = FSum / 2.0;
+    // The flux of each center only reads the image, so they are all integrated at once
+    ProcessingLanes::blockingMap(lane(), starCenters, [&](Edge * &rCenter)
+    {
+        // Calculate Total Flux From Center, Half Flux, Full Summation
+        double TF   = 0;
+        double HF   = 0;
+        double FSum = 0;
 
-            // Total flux starting from center
-            TF = buffer[cen_y * stats.width + cen_x] - min;
+        const int cen_x = (int)std::floor(rCenter->x);
+        const int cen_y = (int)std::floor(rCenter->y);
 
-            int pixelCounter = 1;
+        // Complete sum along the radius
+        //for (int k=0; k < rCenter->width; k++)
+        for (int k = rCenter->width / 2; k >= -(rCenter->width / 2); k--)
+        {
+            FSum += buffer[cen_x - k + (cen_y * stats.width)] - min;
+            //qDebug() << Q_FUNC_INFO << image_buffer[cen_x-k+(cen_y*stats.width)] - min;
+        }
 
-            // Integrate flux along radius axis until we reach half flux
-            for (int k = 1; k < rCenter->width / 2; k++)
-            {
-                if (TF >= HF)
-                {
-                    qCDebug(KSTARS_FITS) << "Stopping at TF " << TF << " after #" << k << " pixels.";
-                    break;
-                }
+        // Half flux
+        HF = FSum / 2.0;
 
-                TF += buffer[cen_y * stats.width + cen_x + k] - min;
-                TF += buffer[cen_y * stats.width + cen_x - k] - min;
+        // Total flux starting from center
+        TF = buffer[cen_y * stats.width + cen_x] - min;
 
-                pixelCounter++;
-            }
+        int pixelCounter = 1;
 
-            // Calculate weighted Half Flux Radius
-            rCenter->HFR = pixelCounter * (HF / TF);
-            // Store full flux
-            rCenter->val = FSum;
+        // Integrate flux along radius axis until we reach half flux
+        for (int k = 1; k < rCenter->width / 2; k++)
+        {
+            if (TF >= HF)
+            {
+                qCDebug(KSTARS_FITS) << "Stopping at TF " << TF << " after #" << k << " pixels.";
+                break;
+            }
 
-            qCDebug(KSTARS_FITS) << "HFR for this center is " << rCenter->HFR << " pixels and the total flux is " << FSum;
+            TF += buffer[cen_y * stats.width + cen_x + k] - min;
+            TF += buffer[cen_y * stats.width + cen_x - k] - min;
 
-            starCenters.append(rCenter);
+            pixelCounter++;
         }
-    }
+
+        // Calculate weighted Half Flux Radius
+        rCenter->HFR = pixelCounter * (HF / TF);
+        // Store full flux
+        rCenter->val = FSum;
+
+        qCDebug(KSTARS_FITS) << "HFR for this center is " << rCenter->HFR << " pixels and the total flux is " << FSum;
+    });
 
     if (starCenters.count() > 1 && m_Mode != FITS_FOCUS)
     {
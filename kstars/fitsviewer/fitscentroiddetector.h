@@ -54,6 +54,8 @@ class FITSCentroidDetector: public FITSStarDetector
         int LOW_EDGE_CUTOFF_1  { 50 };
         /** @brief */
         int LOW_EDGE_CUTOFF_2  { 10 };
+        /** @brief Number of rows each thread scans for edges. */
+        int ROW_BAND_HEIGHT { 64 };
         /** @} */
 
     protected:
@@ -15,6 +15,9 @@
 #include "fitssepdetector.h"
 
 #include "fpack.h"
+#include "finehistogram.h"
+#include "histogrambins.h"
+#include "imagebufferpool.h"
 
 #include "kstarsdata.h"
 #include "ksutils.h"
@@ -23,12 +26,14 @@
 #include "skymapcomposite.h"
 #include "auxiliary/ksnotification.h"
 #include "auxiliary/robuststatistics.h"
+#include "auxiliary/kstrace.h"
 
 #include <KFormat>
 #include <QApplication>
 #include <QImage>
 #include <QtConcurrent>
 #include <QImageReader>
+#include <QtEndian>
 
 #if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
 #include <wcshdr.h>
@@ -45,6 +50,16 @@
 
 #include <cfloat>
 #include <cmath>
+#include <memory>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KSTARS_FITS_SIMD_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define KSTARS_FITS_SIMD_NEON
+#include <arm_neon.h>
+#endif
 
 #include <fits_debug.h>
 
@@ -100,9 +115,10 @@ FITSData::FITSData(const QSharedPointer<FITSData> &other)
     this->m_Mode = other->m_Mode;
     this->m_Statistics.channels = other->m_Statistics.channels;
     memcpy(&m_Statistics, &(other->m_Statistics), sizeof(m_Statistics));
-    m_ImageBuffer = new uint8_t[m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel];
-    memcpy(m_ImageBuffer, other->m_ImageBuffer,
-           m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel);
+    m_ImageBufferSize = m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel;
+    m_ImageBuffer = ImageBufferPool::instance().acquire(m_ImageBufferSize);
+    if (m_ImageBuffer != nullptr)
+        memcpy(m_ImageBuffer, other->m_ImageBuffer, m_ImageBufferSize);
 }
 
 FITSData::~FITSData()
@@ -127,8 +143,6 @@ FITSData::~FITSData()
         qDeleteAll(starCenters);
     starCenters.clear();
 
-    if (m_SkyObjects.count() > 0)
-        qDeleteAll(m_SkyObjects);
     m_SkyObjects.clear();
 
     if (fptr != nullptr)
@@ -139,6 +153,8 @@ FITSData::~FITSData()
         m_PackBuffer = nullptr;
         fptr = nullptr;
     }
+
+    unmapFile();
 }
 
 void FITSData::loadCommon(const QString &inFilename)
@@ -162,8 +178,11 @@ void FITSData::loadCommon(const QString &inFilename)
 bool FITSData::loadFromBuffer(const QByteArray &buffer, const QString &extension, const QString &inFilename)
 {
     loadCommon(inFilename);
+    unmapFile();
     m_Extension = extension;
     qCDebug(KSTARS_FITS) << "Reading file buffer (" << KFormat().formatByteSize(buffer.size()) << ")";
+    // The parallel decoding runs in the lane of the frame, even on the thread of the module
+    ProcessingLanes::Scope scope(lane());
     return privateLoad(buffer);
 }
 
@@ -173,7 +192,49 @@ QFuture<bool> FITSData::loadFromFile(const QString &inFilename)
     QFileInfo info(m_Filename);
     m_Extension = info.completeSuffix().toLower();
     qCDebug(KSTARS_FITS) << "Loading file " << m_Filename;
-    return QtConcurrent::run(this, &FITSData::privateLoad, QByteArray());
+    unmapFile();
+    return ProcessingLanes::run(lane(), [this]()
+    {
+        return privateLoad(mapFile());
+    });
+}
+
+QByteArray FITSData::mapFile()
+{
+#ifdef Q_OS_WIN
+    // Windows can't delete or replace a file while it is mapped.
+    return QByteArray();
+#endif
+
+    // Compressed files are unpacked from disk by fpack.
+    if (!m_Extension.contains("fit") || m_Extension.contains("fz"))
+        return QByteArray();
+
+    m_MappedFile.setFileName(m_Filename);
+    if (!m_MappedFile.open(QIODevice::ReadOnly))
+        return QByteArray();
+
+    const qint64 size = m_MappedFile.size();
+    if (size > 0 && size <= std::numeric_limits<int>::max())
+        m_MappedData = m_MappedFile.map(0, size);
+
+    if (m_MappedData == nullptr)
+    {
+        m_MappedFile.close();
+        return QByteArray();
+    }
+
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(m_MappedData), static_cast<int>(size));
+}
+
+void FITSData::unmapFile()
+{
+    if (m_MappedData != nullptr)
+    {
+        m_MappedFile.unmap(m_MappedData);
+        m_MappedData = nullptr;
+    }
+    m_MappedFile.close();
 }
 
 namespace
@@ -189,8 +250,41 @@ QString fitsErrorToString(int status)
 }
 }
 
+bool FITSData::loadHeaderFromFile(const QString &inFilename)
+{
+    int status = 0;
+
+    loadCommon(inFilename);
+    unmapFile();
+    m_Extension = QFileInfo(m_Filename).completeSuffix().toLower();
+
+    // CFITSIO only reads the header blocks, the data units stay on disk.
+    if (fits_open_diskfile(&fptr, m_Filename.toLocal8Bit(), READONLY, &status))
+    {
+        m_LastError = i18n("Error opening fits file %1 : %2", m_Filename, fitsErrorToString(status));
+        fptr = nullptr;
+        return false;
+    }
+
+    // fpack stores the image keywords in the compressed image extension.
+    int naxis = 0, hduCount = 0;
+    if (fits_get_img_dim(fptr, &naxis, &status) == 0 && naxis == 0 &&
+            fits_get_num_hdus(fptr, &hduCount, &status) == 0 && hduCount > 1)
+        fits_movabs_hdu(fptr, 2, nullptr, &status);
+
+    const bool rc = status == 0 && parseHeader();
+    if (!rc)
+        m_LastError = i18n("Could not read the header of %1: %2", m_Filename, fitsErrorToString(status));
+
+    status = 0;
+    fits_close_file(fptr, &status);
+    fptr = nullptr;
+    return rc;
+}
+
 bool FITSData::privateLoad(const QByteArray &buffer)
 {
+    KSTRACE_SCOPE("fits", "load");
     m_isTemporary = m_Filename.startsWith(KSPaths::writableLocation(QStandardPaths::TempLocation));
     cacheHFR = -1;
     cacheEccentricity = -1;
@@ -209,10 +303,11 @@ bool FITSData::privateLoad(const QByteArray &buffer)
 
 bool FITSData::loadFITSImage(const QByteArray &buffer, const bool isCompressed)
 {
-    int status = 0, anynull = 0;
+    int status = 0, anynull = 0, compressedHDU = 0;
     long naxes[3];
 
     m_HistogramConstructed = false;
+    m_FineHistogramConstructed = false;
 
     if (m_Extension.contains(".fz") || isCompressed)
     {
@@ -239,7 +334,11 @@ bool FITSData::loadFITSImage(const QByteArray &buffer, const bool isCompressed)
             size_t m_PackBufferSize = 100000;
             free(m_PackBuffer);
             m_PackBuffer = (uint8_t *)malloc(m_PackBufferSize);
-            rc = fp_unpack_data_to_data(buffer.data(), buffer.size(), &m_PackBuffer, &m_PackBufferSize, fpvar) == 0;
+            // Tiles are compressed independently, so only unpack the header here and decompress
+            // the pixels in parallel once the image buffer is allocated.
+            compressedHDU = unpackCompressedHeader(buffer, &m_PackBufferSize);
+            rc = compressedHDU > 0 ||
+                 fp_unpack_data_to_data(buffer.data(), buffer.size(), &m_PackBuffer, &m_PackBufferSize, fpvar) == 0;
 
             if (rc)
             {
@@ -405,7 +504,7 @@ bool FITSData::loadFITSImage(const QByteArray &buffer, const bool isCompressed)
         m_Statistics.channels = 1;
 
     m_ImageBufferSize = m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel;
-    m_ImageBuffer = new uint8_t[m_ImageBufferSize];
+    m_ImageBuffer = ImageBufferPool::instance().acquire(m_ImageBufferSize);
     if (m_ImageBuffer == nullptr)
     {
         qCWarning(KSTARS_FITS) << "FITSData: Not enough memory for image_buffer channel. Requested: "
@@ -421,10 +520,20 @@ bool FITSData::loadFITSImage(const QByteArray &buffer, const bool isCompressed)
     flipVCounter   = 0;
     long nelements = m_Statistics.samples_per_channel * m_Statistics.channels;
 
-    if (fits_read_img(fptr, m_Statistics.dataType, 1, nelements, nullptr, m_ImageBuffer, &anynull, &status))
+    // When the whole FITS file is already in memory (e.g. an INDI BLOB), decode the pixels directly
+    // from the buffer so the frame is only touched once. Otherwise let CFITSIO do the conversion.
+    if (compressedHDU > 0)
     {
-        m_LastError = i18n("Error reading image: %1", fitsErrorToString(status));
-        return false;
+        if (!readCompressedImage(buffer, compressedHDU, nelements))
+            return false;
+    }
+    else if (buffer.isEmpty() || isCompressed || !readFITSImageFromMemory(buffer, nelements))
+    {
+        if (fits_read_img(fptr, m_Statistics.dataType, 1, nelements, nullptr, m_ImageBuffer, &anynull, &status))
+        {
+            m_LastError = i18n("Error reading image: %1", fitsErrorToString(status));
+            return false;
+        }
     }
 
     parseHeader();
@@ -439,7 +548,8 @@ bool FITSData::loadFITSImage(const QByteArray &buffer, const bool isCompressed)
 
     // Only check for debayed IF the original naxes[2] is 1
     // which is for single channels.
-    if (naxes[2] == 1 && m_Statistics.channels == 1 && Options::autoDebayer() && checkDebayer())
+    // A mosaic that is kept still gets its Bayer parameters from checkDebayer()
+    if (naxes[2] == 1 && m_Statistics.channels == 1 && Options::autoDebayer() && checkDebayer() && !m_KeepMosaic)
     {
         // Save bayer image on disk in case we need to save it later since debayer destorys this data
         if (m_isTemporary && m_TemporaryDataFile.open())
@@ -463,9 +573,183 @@ bool FITSData::loadFITSImage(const QByteArray &buffer, const bool isCompressed)
     return true;
 }
 
+bool FITSData::readFITSImageFromMemory(const QByteArray &buffer, long nelements)
+{
+    int status = 0, bitpix = 0;
+    LONGLONG headStart = 0, dataStart = 0, dataEnd = 0;
+    double bscale = 1, bzero = 0;
+
+    if (fits_get_img_type(fptr, &bitpix, &status) ||
+            fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, &status))
+        return false;
+
+    // Missing keywords are fine, defaults apply.
+    fits_read_key_dbl(fptr, "BSCALE", &bscale, nullptr, &status);
+    status = 0;
+    fits_read_key_dbl(fptr, "BZERO", &bzero, nullptr, &status);
+    status = 0;
+
+    const size_t length = static_cast<size_t>(nelements) * m_Statistics.bytesPerPixel;
+    if (bscale != 1 || dataStart < 0 || static_cast<size_t>(dataStart) + length > static_cast<size_t>(buffer.size()))
+        return false;
+
+    const uint8_t *source = reinterpret_cast<const uint8_t *>(buffer.constData()) + dataStart;
+
+    // Only the layouts INDI drivers actually send are handled here, anything else goes through CFITSIO.
+    if (bitpix == BYTE_IMG && bzero == 0 && m_Statistics.dataType == TBYTE)
+    {
+        memcpy(m_ImageBuffer, source, length);
+    }
+    else if (bitpix == SHORT_IMG && bzero == 32768 && m_Statistics.dataType == TUSHORT)
+    {
+        // Unsigned 16bit is stored as big endian signed with a 32768 offset.
+        auto target = reinterpret_cast<uint16_t *>(m_ImageBuffer);
+        for (long i = 0; i < nelements; i++)
+            target[i] = qFromBigEndian<uint16_t>(source + 2 * i) ^ 0x8000;
+    }
+    else if (bitpix == FLOAT_IMG && bzero == 0 && m_Statistics.dataType == TFLOAT)
+    {
+        auto target = reinterpret_cast<uint32_t *>(m_ImageBuffer);
+        for (long i = 0; i < nelements; i++)
+            target[i] = qFromBigEndian<uint32_t>(source + 4 * i);
+    }
+    else
+        return false;
+
+    return true;
+}
+
+int FITSData::unpackCompressedHeader(const QByteArray &buffer, size_t *size)
+{
+    // Each thread needs its own CFITSIO handle, which is only safe with a reentrant library.
+    if (!fits_is_reentrant())
+        return 0;
+
+    int status = 0, hdu = 0, hduCount = 0;
+    fitsfile *compressed = nullptr, *header = nullptr;
+    void *data = const_cast<void *>(reinterpret_cast<const void *>(buffer.data()));
+    size_t dataSize = buffer.size();
+
+    if (fits_open_memfile(&compressed, "", READONLY, &data, &dataSize, 0, nullptr, &status))
+        return 0;
+
+    // fpack leaves an empty primary array in front of the compressed image extension.
+    fits_get_num_hdus(compressed, &hduCount, &status);
+    for (int i = 1; i <= hduCount && status == 0 && hdu == 0; i++)
+    {
+        if (fits_movabs_hdu(compressed, i, nullptr, &status) == 0 && fits_is_compressed_image(compressed, &status))
+            hdu = i;
+    }
+
+    if (hdu > 0)
+    {
+        void *headerBuffer = m_PackBuffer;
+        if (fits_create_memfile(&header, &headerBuffer, size, 100000, realloc, &status) == 0)
+        {
+            fits_img_decompress_header(compressed, header, &status);
+            fits_close_file(header, &status);
+        }
+        m_PackBuffer = reinterpret_cast<uint8_t *>(headerBuffer);
+    }
+
+    int closeStatus = 0;
+    fits_close_file(compressed, &closeStatus);
+
+    if (status)
+    {
+        qCDebug(KSTARS_FITS) << "Falling back to serial decompression:" << fitsErrorToString(status);
+        return 0;
+    }
+
+    return hdu;
+}
+
+bool FITSData::readCompressedImage(const QByteArray &buffer, int hdu, long nelements)
+{
+    const long width = m_Statistics.width, height = m_Statistics.height;
+    const uint32_t channels = m_Statistics.channels;
+    Q_ASSERT(nelements == width * height * channels);
+
+    // Read the tile size from the compressed image so that no tile is decompressed by two bands.
+    int status = 0;
+    long tileRows = 1;
+    {
+        fitsfile *compressed = nullptr;
+        void *data = const_cast<void *>(reinterpret_cast<const void *>(buffer.data()));
+        size_t dataSize = buffer.size();
+        long tileSize[3] = {0, 1, 1};
+        if (fits_open_memfile(&compressed, "", READONLY, &data, &dataSize, 0, nullptr, &status) == 0)
+        {
+            if (fits_movabs_hdu(compressed, hdu, nullptr, &status) == 0 &&
+                    fits_get_tile_dim(compressed, 3, tileSize, &status) == 0)
+                tileRows = qMax(1L, qMin(height, tileSize[1]));
+            int closeStatus = 0;
+            fits_close_file(compressed, &closeStatus);
+        }
+        if (status)
+        {
+            m_LastError = i18n("Error reading compressed image: %1", fitsErrorToString(status));
+            return false;
+        }
+    }
+
+    const long tiles = (height + tileRows - 1) / tileRows;
+    const long bands = qMax(1L, qMin<long>(tiles, ProcessingLanes::pool(lane())->maxThreadCount()));
+    const long rowsPerBand = ((tiles + bands - 1) / bands) * tileRows;
+
+    QList<QFuture<int>> futures;
+    for (long start = 0; start < height; start += rowsPerBand)
+    {
+        const long end = qMin(height, start + rowsPerBand);
+        futures.append(ProcessingLanes::run(lane(), [ =, &buffer]()
+        {
+            int status = 0, anynull = 0;
+            fitsfile *compressed = nullptr;
+            void *data = const_cast<void *>(reinterpret_cast<const void *>(buffer.data()));
+            size_t dataSize = buffer.size();
+
+            if (fits_open_memfile(&compressed, "", READONLY, &data, &dataSize, 0, nullptr, &status) == 0 &&
+                    fits_movabs_hdu(compressed, hdu, nullptr, &status) == 0)
+            {
+                for (uint32_t channel = 0; channel < channels && status == 0; channel++)
+                {
+                    long firstPixel[3] = {1, start + 1, channel + 1};
+                    long lastPixel[3] = {width, end, channel + 1};
+                    long increment[3] = {1, 1, 1};
+                    const size_t offset = static_cast<size_t>(channel) * m_Statistics.samples_per_channel + start * width;
+                    uint8_t *target = m_ImageBuffer + offset * m_Statistics.bytesPerPixel;
+                    fits_read_subset(compressed, m_Statistics.dataType, firstPixel, lastPixel, increment, nullptr,
+                                     target, &anynull, &status);
+                }
+            }
+
+            int closeStatus = 0;
+            if (compressed)
+                fits_close_file(compressed, &closeStatus);
+            return status;
+        }));
+    }
+
+    for (auto &future : futures)
+    {
+        future.waitForFinished();
+        if (future.result() && status == 0)
+            status = future.result();
+    }
+
+    if (status)
+    {
+        m_LastError = i18n("Error reading compressed image: %1", fitsErrorToString(status));
+        return false;
+    }
+
+    return true;
+}
+
 bool FITSData::loadXISFImage(const QByteArray &buffer)
 {
     m_HistogramConstructed = false;
+    m_FineHistogramConstructed = false;
     clearImageBuffers();
 
 #ifdef HAVE_XISF
@@ -543,7 +827,12 @@ bool FITSData::loadXISFImage(const QByteArray &buffer)
         }
 
         m_ImageBufferSize = image.imageDataSize();
-        m_ImageBuffer = new uint8_t[m_ImageBufferSize];
+        m_ImageBuffer = ImageBufferPool::instance().acquire(m_ImageBufferSize);
+        if (m_ImageBuffer == nullptr)
+        {
+            m_LastError = i18n("FITSData: Not enough memory for image_buffer channel. Requested: %1 bytes ", m_ImageBufferSize);
+            return false;
+        }
         std::memcpy(m_ImageBuffer, image.imageData(), m_ImageBufferSize);
 
         calculateStats(false, false);
@@ -561,6 +850,63 @@ bool FITSData::loadXISFImage(const QByteArray &buffer)
 
 }
 
+#ifdef HAVE_XISF
+// Apply the XISFCompression option, in the order of its combo box, to an image about to be written
+static bool setXISFCompression(LibXISF::Image &image)
+{
+    static const LibXISF::DataBlock::CompressionCodec codecs[] =
+    {
+        LibXISF::DataBlock::None, LibXISF::DataBlock::LZ4, LibXISF::DataBlock::LZ4HC,
+        LibXISF::DataBlock::Zlib, LibXISF::DataBlock::ZSTD
+    };
+    const int index = Options::xISFCompression();
+    if (index <= 0 || index >= static_cast<int>(sizeof(codecs) / sizeof(codecs[0])))
+        return false;
+
+    image.setCompression(codecs[index]);
+    // Grouping the bytes of a sample together turns the slowly varying high bytes into long runs
+    image.setByteshuffling(Options::xISFByteShuffle() && image.sampleFormat() != LibXISF::Image::UInt8);
+    return true;
+}
+#endif
+
+bool FITSData::compressXISF(const QByteArray &xisf, QByteArray &compressed)
+{
+#ifdef HAVE_XISF
+    try
+    {
+        LibXISF::XISFReader xisfReader;
+        LibXISF::ByteArray byteArray(xisf.constData(), xisf.size());
+        xisfReader.open(byteArray);
+        if (xisfReader.imagesCount() == 0)
+            return false;
+
+        LibXISF::XISFWriter xisfWriter;
+        for (uint32_t i = 0; i < xisfReader.imagesCount(); i++)
+        {
+            LibXISF::Image image = xisfReader.getImage(i);
+            if (!setXISFCompression(image))
+                return false;
+            xisfWriter.writeImage(image);
+        }
+
+        LibXISF::ByteArray output;
+        xisfWriter.save(output);
+        compressed = QByteArray(output.data(), output.size());
+    }
+    catch (LibXISF::Error &err)
+    {
+        qCWarning(KSTARS_FITS) << "Error compressing XISF image" << err.what();
+        return false;
+    }
+    return true;
+#else
+    Q_UNUSED(xisf)
+    Q_UNUSED(compressed)
+    return false;
+#endif
+}
+
 bool FITSData::saveXISFImage(const QString &newFilename)
 {
 #ifdef HAVE_XISF
@@ -595,6 +941,7 @@ bool FITSData::saveXISFImage(const QString &newFilename)
         std::memcpy(image.imageData(), m_ImageBuffer, m_ImageBufferSize);
         for (auto &fitsKeyword : m_HeaderRecords)
             image.addFITSKeyword({fitsKeyword.key.toUtf8().data(), fitsKeyword.value.toString().toUtf8().data(), fitsKeyword.comment.toUtf8().data()});
+        setXISFCompression(image);
 
         xisfWriter.writeImage(image);
         xisfWriter.save(newFilename.toLocal8Bit().data());
@@ -690,7 +1037,7 @@ bool FITSData::loadCanonicalImage(const QByteArray &buffer)
     clearImageBuffers();
     m_ImageBufferSize = m_Statistics.samples_per_channel * m_Statistics.channels * static_cast<uint16_t>
                         (m_Statistics.bytesPerPixel);
-    m_ImageBuffer = new uint8_t[m_ImageBufferSize];
+    m_ImageBuffer = ImageBufferPool::instance().acquire(m_ImageBufferSize);
     if (m_ImageBuffer == nullptr)
     {
         m_LastError = i18n("FITSData: Not enough memory for image_buffer channel. Requested: %1 bytes ", m_ImageBufferSize);
@@ -765,6 +1112,12 @@ bool FITSData::loadRAWImage(const QByteArray &buffer)
         m_Statistics.size = buffer.size();
     }
 
+    // Focus and guide frames only need the stars, so each 2x2 Bayer cell is taken as one pixel
+    // instead of being interpolated, which is several times faster and a quarter of the memory.
+    // Alignment keeps the full resolution as the solver relies on the plate scale.
+    if (Options::halfSizeRAW() && (m_Mode == FITS_FOCUS || m_Mode == FITS_GUIDE))
+        RawProcessor.imgdata.params.half_size = 1;
+
     // Let us unpack the thumbnail
     if ((ret = RawProcessor.unpack()) != LIBRAW_SUCCESS)
     {
@@ -802,7 +1155,7 @@ bool FITSData::loadRAWImage(const QByteArray &buffer)
     m_Statistics.samples_per_channel = m_Statistics.width * m_Statistics.height;
     clearImageBuffers();
     m_ImageBufferSize = m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel;
-    m_ImageBuffer = new uint8_t[m_ImageBufferSize];
+    m_ImageBuffer = ImageBufferPool::instance().acquire(m_ImageBufferSize);
     if (m_ImageBuffer == nullptr)
     {
         m_LastError = i18n("FITSData: Not enough memory for image_buffer channel. Requested: %1 bytes ", m_ImageBufferSize);
@@ -1014,6 +1367,14 @@ bool FITSData::saveImage(const QString &newFilename)
 
     /* Write keywords */
 
+    // Reserve the header for all the keywords below at once, CFITSIO would otherwise grow it
+    // block by block. Statistics, history, date and the WCS rotation keywords need about 30.
+    if (fits_set_hdrsize(fptr, m_HeaderRecords.count() + 32, &status))
+    {
+        m_LastError = i18n("Failed to reserve header: %1", fitsErrorToString(status));
+        return false;
+    }
+
     // Minimum
     if (fits_update_key(fptr, TDOUBLE, "DATAMIN", &(m_Statistics.min), "Minimum value", &status))
     {
@@ -1080,23 +1441,23 @@ bool FITSData::saveImage(const QString &newFilename)
     // Skip first 10 standard records and copy the rest.
     for (int i = 10; i < m_HeaderRecords.count(); i++)
     {
-        QString key = m_HeaderRecords[i].key;
-        const char *comment = m_HeaderRecords[i].comment.toLatin1().constBegin();
-        QVariant value = m_HeaderRecords[i].value;
+        const QByteArray key = m_HeaderRecords[i].key.toLatin1();
+        const QByteArray comment = m_HeaderRecords[i].comment.toLatin1();
+        const QVariant &value = m_HeaderRecords[i].value;
 
         switch (value.type())
         {
             case QVariant::Int:
             {
                 int number = value.toInt();
-                fits_write_key(fptr, TINT, key.toLatin1().constData(), &number, comment, &status);
+                fits_write_key(fptr, TINT, key.constData(), &number, comment.constData(), &status);
             }
             break;
 
             case QVariant::Double:
             {
                 double number = value.toDouble();
-                fits_write_key(fptr, TDOUBLE, key.toLatin1().constData(), &number, comment, &status);
+                fits_write_key(fptr, TDOUBLE, key.constData(), &number, comment.constData(), &status);
             }
             break;
 
@@ -1105,7 +1466,7 @@ bool FITSData::saveImage(const QString &newFilename)
             {
                 char valueBuffer[256] = {0};
                 strncpy(valueBuffer, value.toString().toLatin1().constData(), 256 - 1);
-                fits_write_key(fptr, TSTRING, key.toLatin1().constData(), valueBuffer, comment, &status);
+                fits_write_key(fptr, TSTRING, key.constData(), valueBuffer, comment.constData(), &status);
             }
         }
     }
@@ -1159,14 +1520,9 @@ bool FITSData::saveImage(const QString &newFilename)
 
 void FITSData::clearImageBuffers()
 {
-    delete[] m_ImageBuffer;
+    ImageBufferPool::instance().release(m_ImageBuffer);
     m_ImageBuffer = nullptr;
-    if(m_ImageRoiBuffer != nullptr )
-    {
-        delete[] m_ImageRoiBuffer;
-        m_ImageRoiBuffer = nullptr;
-
-    }
+    m_ROIRect = QRect();
     //m_BayerBuffer = nullptr;
 }
 
@@ -1180,101 +1536,61 @@ void FITSData::makeRoiBuffer(QRect roi)
     {
         return;
     }
-    if(m_ImageRoiBuffer != nullptr )
-    {
-        delete[] m_ImageRoiBuffer;
-        m_ImageRoiBuffer = nullptr;
-    }
-    int xoffset = roi.topLeft().x() - 1;
-    int yoffset = roi.topLeft().y() - 1;
-    uint32_t bpp = m_Statistics.bytesPerPixel;
-    m_ImageRoiBuffer = new uint8_t[roi.height()*roi.width()*m_Statistics.channels * m_Statistics.bytesPerPixel]();
-    for(int n = 0 ; n < m_Statistics.channels ; n++)
-    {
-        for(int i = 0; i < roi.height(); i++)
-        {
-            size_t i1 = n * channelSize * bpp +  i * roi.width() * bpp;
-            size_t i2 = n * m_Statistics.samples_per_channel * bpp + (yoffset + i) * width() * bpp + xoffset * bpp;
-            memcpy(&m_ImageRoiBuffer[i1],
-                   &m_ImageBuffer[i2],
-                   roi.width() * bpp);
-        }
 
-    }
+    // The selection is 1-based. Its statistics are computed straight from the image buffer.
+    m_ROIRect = roi.translated(-1, -1).intersected(QRect(0, 0, m_Statistics.width, m_Statistics.height));
+    if (m_ROIRect.isEmpty())
+        return;
+
     memcpy(&m_ROIStatistics, &m_Statistics, sizeof(FITSImage::Statistic));
-    m_ROIStatistics.samples_per_channel = roi.height() * roi.width();
-    m_ROIStatistics.width = roi.width();
-    m_ROIStatistics.height = roi.height();
+    m_ROIStatistics.samples_per_channel = m_ROIRect.height() * m_ROIRect.width();
+    m_ROIStatistics.width = m_ROIRect.width();
+    m_ROIStatistics.height = m_ROIRect.height();
     calculateStats(false, true);
 }
+uint32_t FITSData::statisticsRowStep() const
+{
+    // Guide and focus loops only need the statistics for display and background levels.
+    if (m_Mode != FITS_GUIDE && m_Mode != FITS_FOCUS)
+        return 1;
+
+    // At least MinSampledStatistics samples are always used, which keeps the standard error of
+    // the mean below stddev / 512.
+    constexpr uint32_t MinSampledStatistics = 1 << 18;
+    const uint32_t maxStep = m_Statistics.samples_per_channel / MinSampledStatistics;
+    return qMax(1u, qMin(static_cast<uint32_t>(Options::loopFrameStatisticsSampling()), maxStep));
+}
+
 void FITSData::calculateStats(bool refresh, bool roi)
 {
-    // Calculate min max
+    KSTRACE_SCOPE("fits", "calculateStats");
     if(roi == false)
     {
-        calculateMinMax(refresh);
+        m_StatisticsRowStep = statisticsRowStep();
+
+        // Try to read min/max and mean/stddev if in file
+        const bool minMaxFound = !refresh && readMinMaxKeywords();
         calculateMedian(refresh);
+        const bool stdDevFound = !refresh && readStdDevKeywords();
 
-        // Try to read mean/median/stddev if in file
-        if (refresh == false && fptr)
-        {
-            int status = 0;
-            int nfound = 0;
-            if (fits_read_key_dbl(fptr, "MEAN1", &m_Statistics.mean[0], nullptr, &status) == 0)
-                nfound++;
-            // NB. These could fail if missing, which is OK.
-            fits_read_key_dbl(fptr, "MEAN2", & m_Statistics.mean[1], nullptr, &status);
-            fits_read_key_dbl(fptr, "MEAN3", &m_Statistics.mean[2], nullptr, &status);
+        // If all is OK, we're done
+        if (minMaxFound && stdDevFound)
+            return;
 
-            status = 0;
-            if (fits_read_key_dbl(fptr, "STDDEV1", &m_Statistics.stddev[0], nullptr, &status) == 0)
-                nfound++;
-            // NB. These could fail if missing, which is OK.
-            fits_read_key_dbl(fptr, "STDDEV2", &m_Statistics.stddev[1], nullptr, &status);
-            fits_read_key_dbl(fptr, "STDDEV3", &m_Statistics.stddev[2], nullptr, &status);
+        // Whatever is missing is computed in a single pass over the image, so keep the header values.
+        const FITSImage::Statistic headerStatistics = m_Statistics;
+        calculateFusedStats();
 
-            // If all is OK, we're done
-            if (nfound == 2)
-                return;
+        if (minMaxFound)
+        {
+            std::copy(headerStatistics.min, headerStatistics.min + 3, m_Statistics.min);
+            std::copy(headerStatistics.max, headerStatistics.max + 3, m_Statistics.max);
         }
-
-        // Get standard deviation and mean in one run
-        switch (m_Statistics.dataType)
+        if (stdDevFound)
         {
-            case TBYTE:
-                calculateStdDev<uint8_t>();
-                break;
-
-            case TSHORT:
-                calculateStdDev<int16_t>();
-                break;
-
-            case TUSHORT:
-                calculateStdDev<uint16_t>();
-                break;
-
-            case TLONG:
-                calculateStdDev<int32_t>();
-                break;
-
-            case TULONG:
-                calculateStdDev<uint32_t>();
-                break;
-
-            case TFLOAT:
-                calculateStdDev<float>();
-                break;
-
-            case TLONGLONG:
-                calculateStdDev<int64_t>();
-                break;
-
-            case TDOUBLE:
-                calculateStdDev<double>();
-                break;
-
-            default:
-                return;
+            std::copy(headerStatistics.mean, headerStatistics.mean + 3, m_Statistics.mean);
+            std::copy(headerStatistics.stddev, headerStatistics.stddev + 3, m_Statistics.stddev);
+            return;
         }
 
         // FIXME That's not really SNR, must implement a proper solution for this value
@@ -1282,185 +1598,110 @@ void FITSData::calculateStats(bool refresh, bool roi)
     }
     else
     {
-        calculateMinMax(refresh, roi);
         calculateMedian(refresh, roi);
+        calculateFusedStats(roi);
+    }
+}
 
-        switch (m_ROIStatistics.dataType)
-        {
-            case TBYTE:
-                calculateStdDev<uint8_t>(roi);
-                break;
-
-            case TSHORT:
-                calculateStdDev<int16_t>(roi);
-                break;
+bool FITSData::readMinMaxKeywords()
+{
+    if (fptr == nullptr)
+        return false;
 
-            case TUSHORT:
-                calculateStdDev<uint16_t>(roi);
-                break;
+    int status = 0, nfound = 0;
 
-            case TLONG:
-                calculateStdDev<int32_t>(roi);
-                break;
+    if (fits_read_key_dbl(fptr, "DATAMIN", &(m_Statistics.min[0]), nullptr, &status) == 0)
+        nfound++;
+    else if (fits_read_key_dbl(fptr, "MIN1", &(m_Statistics.min[0]), nullptr, &status) == 0)
+        nfound++;
 
-            case TULONG:
-                calculateStdDev<uint32_t>(roi);
-                break;
+    // NB. These could fail if missing, which is OK.
+    fits_read_key_dbl(fptr, "MIN2", &m_Statistics.min[1], nullptr, &status);
+    fits_read_key_dbl(fptr, "MIN3", &m_Statistics.min[2], nullptr, &status);
 
-            case TFLOAT:
-                calculateStdDev<float>(roi);
-                break;
+    status = 0;
 
-            case TLONGLONG:
-                calculateStdDev<int64_t>(roi);
-                break;
+    if (fits_read_key_dbl(fptr, "DATAMAX", &(m_Statistics.max[0]), nullptr, &status) == 0)
+        nfound++;
+    else if (fits_read_key_dbl(fptr, "MAX1", &(m_Statistics.max[0]), nullptr, &status) == 0)
+        nfound++;
 
-            case TDOUBLE:
-                calculateStdDev<double>(roi);
-                break;
+    // NB. These could fail if missing, which is OK.
+    fits_read_key_dbl(fptr, "MAX2", &m_Statistics.max[1], nullptr, &status);
+    fits_read_key_dbl(fptr, "MAX3", &m_Statistics.max[2], nullptr, &status);
 
-            default:
-                return;
-        }
-    }
+    // If we found both keywords, no need to calculate them, unless they are both zeros
+    return (nfound == 2 && !(m_Statistics.min[0] == 0 && m_Statistics.max[0] == 0));
 }
 
-void FITSData::calculateMinMax(bool refresh, bool roi)
+bool FITSData::readStdDevKeywords()
 {
-    if(roi == false)
-    {
-        int status, nfound = 0;
+    if (fptr == nullptr)
+        return false;
 
-        status = 0;
+    int status = 0, nfound = 0;
 
-        // Only fetch from header if we have a single channel
-        // Otherwise, calculate manually.
-        if (fptr != nullptr && !refresh)
-        {
+    if (fits_read_key_dbl(fptr, "MEAN1", &m_Statistics.mean[0], nullptr, &status) == 0)
+        nfound++;
+    // NB. These could fail if missing, which is OK.
+    fits_read_key_dbl(fptr, "MEAN2", & m_Statistics.mean[1], nullptr, &status);
+    fits_read_key_dbl(fptr, "MEAN3", &m_Statistics.mean[2], nullptr, &status);
 
-            status = 0;
+    status = 0;
+    if (fits_read_key_dbl(fptr, "STDDEV1", &m_Statistics.stddev[0], nullptr, &status) == 0)
+        nfound++;
+    // NB. These could fail if missing, which is OK.
+    fits_read_key_dbl(fptr, "STDDEV2", &m_Statistics.stddev[1], nullptr, &status);
+    fits_read_key_dbl(fptr, "STDDEV3", &m_Statistics.stddev[2], nullptr, &status);
 
-            if (fits_read_key_dbl(fptr, "DATAMIN", &(m_Statistics.min[0]), nullptr, &status) == 0)
-                nfound++;
-            else if (fits_read_key_dbl(fptr, "MIN1", &(m_Statistics.min[0]), nullptr, &status) == 0)
-                nfound++;
-
-            // NB. These could fail if missing, which is OK.
-            fits_read_key_dbl(fptr, "MIN2", &m_Statistics.min[1], nullptr, &status);
-            fits_read_key_dbl(fptr, "MIN3", &m_Statistics.min[2], nullptr, &status);
-
-            status = 0;
-
-            if (fits_read_key_dbl(fptr, "DATAMAX", &(m_Statistics.max[0]), nullptr, &status) == 0)
-                nfound++;
-            else if (fits_read_key_dbl(fptr, "MAX1", &(m_Statistics.max[0]), nullptr, &status) == 0)
-                nfound++;
-
-            // NB. These could fail if missing, which is OK.
-            fits_read_key_dbl(fptr, "MAX2", &m_Statistics.max[1], nullptr, &status);
-            fits_read_key_dbl(fptr, "MAX3", &m_Statistics.max[2], nullptr, &status);
-
-            // If we found both keywords, no need to calculate them, unless they are both zeros
-            if (nfound == 2 && !(m_Statistics.min[0] == 0 && m_Statistics.max[0] == 0))
-                return;
-        }
-
-        m_Statistics.min[0] = 1.0E30;
-        m_Statistics.max[0] = -1.0E30;
-
-        m_Statistics.min[1] = 1.0E30;
-        m_Statistics.max[1] = -1.0E30;
-
-        m_Statistics.min[2] = 1.0E30;
-        m_Statistics.max[2] = -1.0E30;
-
-        switch (m_Statistics.dataType)
-        {
-            case TBYTE:
-                calculateMinMax<uint8_t>();
-                break;
-
-            case TSHORT:
-                calculateMinMax<int16_t>();
-                break;
-
-            case TUSHORT:
-                calculateMinMax<uint16_t>();
-                break;
-
-            case TLONG:
-                calculateMinMax<int32_t>();
-                break;
-
-            case TULONG:
-                calculateMinMax<uint32_t>();
-                break;
-
-            case TFLOAT:
-                calculateMinMax<float>();
-                break;
-
-            case TLONGLONG:
-                calculateMinMax<int64_t>();
-                break;
-
-            case TDOUBLE:
-                calculateMinMax<double>();
-                break;
+    return nfound == 2;
+}
 
-            default:
-                break;
-        }
-    }
-    else
+void FITSData::calculateFusedStats(bool roi)
+{
+    FITSImage::Statistic &stats = roi ? m_ROIStatistics : m_Statistics;
+    for (int n = 0; n < 3; n++)
     {
-        m_ROIStatistics.min[0] = 1.0E30;
-        m_ROIStatistics.max[0] = -1.0E30;
-
-        m_ROIStatistics.min[1] = 1.0E30;
-        m_ROIStatistics.max[1] = -1.0E30;
-
-        m_ROIStatistics.min[2] = 1.0E30;
-        m_ROIStatistics.max[2] = -1.0E30;
-
-        switch (m_Statistics.dataType)
-        {
-            case TBYTE:
-                calculateMinMax<uint8_t>(roi);
-                break;
+        stats.min[n] = 1.0E30;
+        stats.max[n] = -1.0E30;
+    }
 
-            case TSHORT:
-                calculateMinMax<int16_t>(roi);
-                break;
+    switch (m_Statistics.dataType)
+    {
+        case TBYTE:
+            calculateFusedStats<uint8_t>(roi);
+            break;
 
-            case TUSHORT:
-                calculateMinMax<uint16_t>(roi);
-                break;
+        case TSHORT:
+            calculateFusedStats<int16_t>(roi);
+            break;
 
-            case TLONG:
-                calculateMinMax<int32_t>(roi);
-                break;
+        case TUSHORT:
+            calculateFusedStats<uint16_t>(roi);
+            break;
 
-            case TULONG:
-                calculateMinMax<uint32_t>(roi);
-                break;
+        case TLONG:
+            calculateFusedStats<int32_t>(roi);
+            break;
 
-            case TFLOAT:
-                calculateMinMax<float>(roi);
-                break;
+        case TULONG:
+            calculateFusedStats<uint32_t>(roi);
+            break;
 
-            case TLONGLONG:
-                calculateMinMax<int64_t>(roi);
-                break;
+        case TFLOAT:
+            calculateFusedStats<float>(roi);
+            break;
 
-            case TDOUBLE:
-                calculateMinMax<double>(roi);
-                break;
+        case TLONGLONG:
+            calculateFusedStats<int64_t>(roi);
+            break;
 
-            default:
-                break;
-        }
+        case TDOUBLE:
+            calculateFusedStats<double>(roi);
+            break;
 
+        default:
+            break;
     }
 }
 
@@ -1580,7 +1821,47 @@ void FITSData::calculateMedian(bool refresh, bool roi)
 template <typename T>
 void FITSData::calculateMedian(bool roi)
 {
-    auto * buffer = reinterpret_cast<T *>(roi ? m_ImageRoiBuffer : m_ImageBuffer);
+    auto * buffer = reinterpret_cast<T *>(m_ImageBuffer);
+    // A selection is a strided view of the image, rows are pitch samples apart.
+    const uint32_t pitch = m_Statistics.width;
+    const uint32_t width = roi ? m_ROIStatistics.width : m_Statistics.width;
+    const uint32_t height = roi ? m_ROIStatistics.height : m_Statistics.height;
+    const uint32_t originOffset = roi ? m_ROIRect.y() * pitch + m_ROIRect.x() : 0;
+
+    // For 8 and 16 bit data count every sample once, the exact median then comes without any sort.
+    // The full frame counts are kept, so the display histogram can be derived without another pass.
+    if constexpr (FineHistogram::isSupported<T>())
+    {
+        QVector<QVector<uint32_t>> roiHistogram(m_Statistics.channels);
+        QVector<QVector<uint32_t>> &histograms = roi ? roiHistogram : m_FineHistogram;
+        histograms.resize(m_Statistics.channels);
+
+        // Sampled frames only count every m_StatisticsRowStep-th row.
+        const uint32_t step = roi ? 1 : m_StatisticsRowStep;
+        const uint32_t rows = (height + step - 1) / step;
+
+        QVector<QFuture<void>> futures;
+        for (int n = 0; n < m_Statistics.channels; n++)
+        {
+            const T *origin = buffer + n * m_Statistics.samples_per_channel + originOffset;
+            futures.append(ProcessingLanes::run(lane(), [ =, &histograms]()
+            {
+                FineHistogram::fill(origin, width, rows, pitch * step, histograms[n]);
+            }));
+        }
+        for (QFuture<void> future : futures)
+            future.waitForFinished();
+
+        for (int n = 0; n < m_Statistics.channels; n++)
+        {
+            const double median = FineHistogram::percentile(histograms[n], 0.5);
+            roi ? m_ROIStatistics.median[n] = median : m_Statistics.median[n] = median;
+        }
+        if (!roi)
+            m_FineHistogramConstructed = true;
+        return;
+    }
+
     const uint32_t maxMedianSize = 500000;
     uint32_t medianSize = roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel;
     uint8_t downsample = 1;
@@ -1598,273 +1879,856 @@ void FITSData::calculateMedian(bool roi)
 
     for (uint8_t n = 0; n < m_Statistics.channels; n++)
     {
-        auto *oneChannel = buffer + n * (roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel);
-        for (uint32_t upto = 0; upto < (roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel);
-                upto += downsample)
-            samples.push_back(oneChannel[upto]);
-        auto median = Mathematics::RobustStatistics::ComputeLocation(Mathematics::RobustStatistics::LOCATION_MEDIAN, samples);
+        const T *origin = buffer + n * m_Statistics.samples_per_channel + originOffset;
+        samples.clear();
+        for (uint32_t upto = 0; upto < width * height; upto += downsample)
+            samples.push_back(origin[(upto / width) * pitch + upto % width]);
+        // The samples are refilled for the next channel, so they may be reordered instead of copied
+        auto median = Mathematics::RobustStatistics::ComputeLocationInPlace(Mathematics::RobustStatistics::LOCATION_MEDIAN,
+                      samples);
         roi ? m_ROIStatistics.median[n] = median : m_Statistics.median[n] = median;
     }
 }
 
+namespace
+{
+// This struct is used when returning results from the threaded fused statistics pass,
+// min, max, sum and squared sum are all gathered while the samples are in cache.
+struct FusedStatsData
+{
+    double min;
+    double max;
+    double sum;
+    double squaredSum;
+    double numSamples;
+    FusedStatsData(double mn, double mx, double s, double sq, double n) : min(mn), max(mx), sum(s), squaredSum(sq),
+        numSamples(n) {}
+    FusedStatsData() : min(0), max(0), sum(0), squaredSum(0), numSamples(0) {}
+};
+
+// Portable scalar kernel, used for all types without a vectorized kernel and as the fallback
+// when the CPU lacks the required instruction set.
 template <typename T>
-QPair<T, T> FITSData::getParitionMinMax(uint32_t start, uint32_t stride, bool roi)
+FusedStatsData fusedStatsScalar(const T *buffer, uint32_t count)
 {
-    auto * buffer = reinterpret_cast<T *>(roi ? m_ImageRoiBuffer : m_ImageBuffer);
     T min = std::numeric_limits<T>::max();
-    T max = std::numeric_limits<T>::min();
-
-    uint32_t end = start + stride;
-
-    for (uint32_t i = start; i < end; i++)
+    T max = std::numeric_limits<T>::lowest();
+    double sum = 0;
+    double squaredSum = 0;
+    for (uint32_t i = 0; i < count; i++)
     {
-        min = qMin(buffer[i], min);
-        max = qMax(buffer[i], max);
-        //        if (buffer[i] < min)
-        //            min = buffer[i];
-        //        else if (buffer[i] > max)
-        //            max = buffer[i];
+        const T value = buffer[i];
+        min = qMin(value, min);
+        max = qMax(value, max);
+        const double sample = value;
+        sum += sample;
+        squaredSum += sample * sample;
     }
-
-    return qMakePair(min, max);
+    return FusedStatsData(min, max, sum, squaredSum, count);
 }
 
-template <typename T>
-void FITSData::calculateMinMax(bool roi)
+// Combine the results of a vectorized body with the scalar tail.
+FusedStatsData mergeFusedStats(const FusedStatsData &a, const FusedStatsData &b)
 {
-    T min = std::numeric_limits<T>::max();
-    T max = std::numeric_limits<T>::min();
+    if (a.numSamples <= 0)
+        return b;
+    if (b.numSamples <= 0)
+        return a;
+    return FusedStatsData(qMin(a.min, b.min), qMax(a.max, b.max), a.sum + b.sum, a.squaredSum + b.squaredSum,
+                          a.numSamples + b.numSamples);
+}
 
+#if defined(KSTARS_FITS_SIMD_X86)
+__attribute__((target("avx2")))
+FusedStatsData fusedStatsAVX2(const uint8_t *buffer, uint32_t count)
+{
+    const uint32_t vectorCount = count / 32;
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i vmin = _mm256_set1_epi8(static_cast<char>(0xFF));
+    __m256i vmax = zero;
+    __m256i vsum = zero;
+    __m256i vsquared = zero;
+
+    for (uint32_t block = 0; block < vectorCount; block += 4096)
+    {
+        // 32bit squared sums can hold 4096 iterations of 4 squares of 255 without overflow.
+        __m256i blockSquared = zero;
+        const uint32_t blockEnd = qMin(vectorCount, block + 4096);
+        for (uint32_t i = block; i < blockEnd; i++)
+        {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(buffer + i * 32));
+            vmin = _mm256_min_epu8(vmin, v);
+            vmax = _mm256_max_epu8(vmax, v);
+            vsum = _mm256_add_epi64(vsum, _mm256_sad_epu8(v, zero));
+            const __m256i lo = _mm256_unpacklo_epi8(v, zero);
+            const __m256i hi = _mm256_unpackhi_epi8(v, zero);
+            blockSquared = _mm256_add_epi32(blockSquared, _mm256_madd_epi16(lo, lo));
+            blockSquared = _mm256_add_epi32(blockSquared, _mm256_madd_epi16(hi, hi));
+        }
+        vsquared = _mm256_add_epi64(vsquared, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(blockSquared)));
+        vsquared = _mm256_add_epi64(vsquared, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(blockSquared, 1)));
+    }
 
-    // Create N threads
-    const uint8_t nThreads = 16;
+    alignas(32) uint8_t mins[32], maxs[32];
+    alignas(32) uint64_t sums[4], squares[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(mins), vmin);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(maxs), vmax);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(sums), vsum);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(squares), vsquared);
 
-    for (int n = 0; n < m_Statistics.channels; n++)
+    FusedStatsData body;
+    if (vectorCount > 0)
     {
-        uint32_t cStart = n * (roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel);
-
-        // Calculate how many elements we process per thread
-        uint32_t tStride = (roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel) / nThreads;
-
-        // Calculate the final stride since we can have some left over due to division above
-        uint32_t fStride = tStride + ((roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel) -
-                                      (tStride * nThreads));
-
-        // Start location for inspecting elements
-        uint32_t tStart = cStart;
-
-        // List of futures
-        QList<QFuture<QPair<T, T>>> futures;
-
-        for (int i = 0; i < nThreads; i++)
+        uint8_t min = mins[0], max = maxs[0];
+        for (int i = 1; i < 32; i++)
         {
-            // Run threads
-            futures.append(QtConcurrent::run(this, &FITSData::getParitionMinMax<T>, tStart, (i == (nThreads - 1)) ? fStride : tStride,
-                                             roi));
-            tStart += tStride;
+            min = qMin(min, mins[i]);
+            max = qMax(max, maxs[i]);
         }
+        body = FusedStatsData(min, max,
+                              static_cast<double>(sums[0] + sums[1] + sums[2] + sums[3]),
+                              static_cast<double>(squares[0] + squares[1] + squares[2] + squares[3]),
+                              vectorCount * 32.0);
+    }
 
-        // Now wait for results
-        for (int i = 0; i < nThreads; i++)
+    return mergeFusedStats(body, fusedStatsScalar(buffer + vectorCount * 32, count - vectorCount * 32));
+}
+
+__attribute__((target("avx2")))
+FusedStatsData fusedStatsAVX2(const uint16_t *buffer, uint32_t count)
+{
+    const uint32_t vectorCount = count / 16;
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i vmin = _mm256_set1_epi16(static_cast<short>(0xFFFF));
+    __m256i vmax = zero;
+    __m256i vsum = zero;
+    __m256i vsquared = zero;
+
+    for (uint32_t block = 0; block < vectorCount; block += 16384)
+    {
+        // 32bit sums can hold 16384 iterations of 2 x 65535 per lane without overflow.
+        __m256i blockSum = zero;
+        const uint32_t blockEnd = qMin(vectorCount, block + 16384);
+        for (uint32_t i = block; i < blockEnd; i++)
         {
-            QPair<T, T> result = futures[i].result();
-            min = qMin(result.first, min);
-            max = qMax(result.second, max);
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(buffer + i * 16));
+            vmin = _mm256_min_epu16(vmin, v);
+            vmax = _mm256_max_epu16(vmax, v);
+            const __m256i lo = _mm256_unpacklo_epi16(v, zero);
+            const __m256i hi = _mm256_unpackhi_epi16(v, zero);
+            blockSum = _mm256_add_epi32(blockSum, _mm256_add_epi32(lo, hi));
+            // Squares of 16bit values fit exactly in unsigned 32bit, widen them before accumulating.
+            const __m256i lo2 = _mm256_mullo_epi32(lo, lo);
+            const __m256i hi2 = _mm256_mullo_epi32(hi, hi);
+            vsquared = _mm256_add_epi64(vsquared, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(lo2)));
+            vsquared = _mm256_add_epi64(vsquared, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(lo2, 1)));
+            vsquared = _mm256_add_epi64(vsquared, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(hi2)));
+            vsquared = _mm256_add_epi64(vsquared, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(hi2, 1)));
         }
+        vsum = _mm256_add_epi64(vsum, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(blockSum)));
+        vsum = _mm256_add_epi64(vsum, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(blockSum, 1)));
+    }
 
-        if(!roi)
+    alignas(32) uint16_t mins[16], maxs[16];
+    alignas(32) uint64_t sums[4], squares[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(mins), vmin);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(maxs), vmax);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(sums), vsum);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(squares), vsquared);
+
+    FusedStatsData body;
+    if (vectorCount > 0)
+    {
+        uint16_t min = mins[0], max = maxs[0];
+        for (int i = 1; i < 16; i++)
         {
-            m_Statistics.min[n] = min;
-            m_Statistics.max[n] = max;
+            min = qMin(min, mins[i]);
+            max = qMax(max, maxs[i]);
         }
-        else
+        body = FusedStatsData(min, max,
+                              static_cast<double>(sums[0] + sums[1] + sums[2] + sums[3]),
+                              static_cast<double>(squares[0] + squares[1] + squares[2] + squares[3]),
+                              vectorCount * 16.0);
+    }
+
+    return mergeFusedStats(body, fusedStatsScalar(buffer + vectorCount * 16, count - vectorCount * 16));
+}
+
+__attribute__((target("avx2")))
+FusedStatsData fusedStatsAVX2(const float *buffer, uint32_t count)
+{
+    const uint32_t vectorCount = count / 8;
+    __m256 vmin = _mm256_set1_ps(std::numeric_limits<float>::max());
+    __m256 vmax = _mm256_set1_ps(std::numeric_limits<float>::lowest());
+    __m256d vsum = _mm256_setzero_pd();
+    __m256d vsquared = _mm256_setzero_pd();
+
+    for (uint32_t i = 0; i < vectorCount; i++)
+    {
+        const __m256 v = _mm256_loadu_ps(buffer + i * 8);
+        // Keep the accumulator as second operand so NaN samples are ignored like in the scalar code.
+        vmin = _mm256_min_ps(v, vmin);
+        vmax = _mm256_max_ps(v, vmax);
+        // Accumulate in double precision like the scalar code does.
+        const __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        const __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+        vsum = _mm256_add_pd(vsum, _mm256_add_pd(lo, hi));
+        vsquared = _mm256_add_pd(vsquared, _mm256_add_pd(_mm256_mul_pd(lo, lo), _mm256_mul_pd(hi, hi)));
+    }
+
+    alignas(32) float mins[8], maxs[8];
+    alignas(32) double sums[4], squares[4];
+    _mm256_store_ps(mins, vmin);
+    _mm256_store_ps(maxs, vmax);
+    _mm256_store_pd(sums, vsum);
+    _mm256_store_pd(squares, vsquared);
+
+    FusedStatsData body;
+    if (vectorCount > 0)
+    {
+        float min = mins[0], max = maxs[0];
+        for (int i = 1; i < 8; i++)
         {
-            m_ROIStatistics.min[n] = min;
-            m_ROIStatistics.max[n] = max;
+            min = qMin(min, mins[i]);
+            max = qMax(max, maxs[i]);
         }
+        body = FusedStatsData(min, max, sums[0] + sums[1] + sums[2] + sums[3],
+                              squares[0] + squares[1] + squares[2] + squares[3], vectorCount * 8.0);
     }
 
+    return mergeFusedStats(body, fusedStatsScalar(buffer + vectorCount * 8, count - vectorCount * 8));
 }
 
-// This struct is used when returning results from the threaded getSumAndSquaredSum calculations
-// used to compute the mean and variance of the image.
-struct SumData
+bool cpuHasAVX2()
 {
-    double sum;
-    double squaredSum;
-    double numSamples;
-    SumData(double s, double sq, int n) : sum(s), squaredSum(sq), numSamples(n) {}
-    SumData() : sum(0), squaredSum(0), numSamples(0) {}
-};
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+    return hasAVX2;
+}
+#endif
 
-template <typename T>
-SumData getSumAndSquaredSum(uint32_t start, uint32_t stride, uint8_t *buff)
+#if defined(KSTARS_FITS_SIMD_NEON)
+FusedStatsData fusedStatsNEON(const uint8_t *buffer, uint32_t count)
 {
-    auto * buffer = reinterpret_cast<T *>(buff);
-    const uint32_t end = start + stride;
-    double sum = 0;
-    double squaredSum = 0;
-    for (uint32_t i = start; i < end; i++)
+    const uint32_t vectorCount = count / 16;
+    uint8x16_t vmin = vdupq_n_u8(0xFF);
+    uint8x16_t vmax = vdupq_n_u8(0);
+    uint64x2_t vsum = vdupq_n_u64(0);
+    uint64x2_t vsquared = vdupq_n_u64(0);
+
+    for (uint32_t i = 0; i < vectorCount; i++)
     {
-        double sample = buffer[i];
-        sum += sample;
-        squaredSum += sample * sample;
+        const uint8x16_t v = vld1q_u8(buffer + i * 16);
+        vmin = vminq_u8(vmin, v);
+        vmax = vmaxq_u8(vmax, v);
+        vsum = vpadalq_u32(vsum, vpaddlq_u16(vpaddlq_u8(v)));
+        const uint16x8_t lo = vmull_u8(vget_low_u8(v), vget_low_u8(v));
+        const uint16x8_t hi = vmull_u8(vget_high_u8(v), vget_high_u8(v));
+        vsquared = vpadalq_u32(vsquared, vaddq_u32(vpaddlq_u16(lo), vpaddlq_u16(hi)));
     }
-    const double numSamples = end - start;
-    return SumData(sum, squaredSum, numSamples);
+
+    FusedStatsData body;
+    if (vectorCount > 0)
+        body = FusedStatsData(vminvq_u8(vmin), vmaxvq_u8(vmax), static_cast<double>(vaddvq_u64(vsum)),
+                              static_cast<double>(vaddvq_u64(vsquared)), vectorCount * 16.0);
+
+    return mergeFusedStats(body, fusedStatsScalar(buffer + vectorCount * 16, count - vectorCount * 16));
+}
+
+FusedStatsData fusedStatsNEON(const uint16_t *buffer, uint32_t count)
+{
+    const uint32_t vectorCount = count / 8;
+    uint16x8_t vmin = vdupq_n_u16(0xFFFF);
+    uint16x8_t vmax = vdupq_n_u16(0);
+    uint64x2_t vsum = vdupq_n_u64(0);
+    uint64x2_t vsquared = vdupq_n_u64(0);
+
+    for (uint32_t i = 0; i < vectorCount; i++)
+    {
+        const uint16x8_t v = vld1q_u16(buffer + i * 8);
+        vmin = vminq_u16(vmin, v);
+        vmax = vmaxq_u16(vmax, v);
+        vsum = vpadalq_u32(vsum, vpaddlq_u16(v));
+        const uint32x4_t lo = vmull_u16(vget_low_u16(v), vget_low_u16(v));
+        const uint32x4_t hi = vmull_u16(vget_high_u16(v), vget_high_u16(v));
+        vsquared = vpadalq_u32(vsquared, lo);
+        vsquared = vpadalq_u32(vsquared, hi);
+    }
+
+    FusedStatsData body;
+    if (vectorCount > 0)
+        body = FusedStatsData(vminvq_u16(vmin), vmaxvq_u16(vmax), static_cast<double>(vaddvq_u64(vsum)),
+                              static_cast<double>(vaddvq_u64(vsquared)), vectorCount * 8.0);
+
+    return mergeFusedStats(body, fusedStatsScalar(buffer + vectorCount * 8, count - vectorCount * 8));
 }
 
+FusedStatsData fusedStatsNEON(const float *buffer, uint32_t count)
+{
+    const uint32_t vectorCount = count / 4;
+    float32x4_t vmin = vdupq_n_f32(std::numeric_limits<float>::max());
+    float32x4_t vmax = vdupq_n_f32(std::numeric_limits<float>::lowest());
+    float64x2_t vsum = vdupq_n_f64(0);
+    float64x2_t vsquared = vdupq_n_f64(0);
+
+    for (uint32_t i = 0; i < vectorCount; i++)
+    {
+        const float32x4_t v = vld1q_f32(buffer + i * 4);
+        vmin = vminnmq_f32(vmin, v);
+        vmax = vmaxnmq_f32(vmax, v);
+        const float64x2_t lo = vcvt_f64_f32(vget_low_f32(v));
+        const float64x2_t hi = vcvt_high_f64_f32(v);
+        vsum = vaddq_f64(vsum, vaddq_f64(lo, hi));
+        vsquared = vfmaq_f64(vsquared, lo, lo);
+        vsquared = vfmaq_f64(vsquared, hi, hi);
+    }
+
+    FusedStatsData body;
+    if (vectorCount > 0)
+        body = FusedStatsData(vminnmvq_f32(vmin), vmaxnmvq_f32(vmax), vaddvq_f64(vsum), vaddvq_f64(vsquared),
+                              vectorCount * 4.0);
+
+    return mergeFusedStats(body, fusedStatsScalar(buffer + vectorCount * 4, count - vectorCount * 4));
+}
+#endif
+
 template <typename T>
-void FITSData::calculateStdDev(bool roi )
+FusedStatsData fusedStatsDispatch(const T *buffer, uint32_t count)
 {
+#if defined(KSTARS_FITS_SIMD_X86)
+    if (cpuHasAVX2())
+        return fusedStatsAVX2(buffer, count);
+    return fusedStatsScalar(buffer, count);
+#elif defined(KSTARS_FITS_SIMD_NEON)
+    return fusedStatsNEON(buffer, count);
+#else
+    return fusedStatsScalar(buffer, count);
+#endif
+}
+
+// Vectorized kernels exist for the common camera data types, everything else uses the scalar loop.
+template <typename T>
+FusedStatsData fusedStats(const T *buffer, uint32_t count)
+{
+    return fusedStatsScalar(buffer, count);
+}
+
+template <>
+FusedStatsData fusedStats<uint8_t>(const uint8_t *buffer, uint32_t count)
+{
+    return fusedStatsDispatch(buffer, count);
+}
+
+template <>
+FusedStatsData fusedStats<uint16_t>(const uint16_t *buffer, uint32_t count)
+{
+    return fusedStatsDispatch(buffer, count);
+}
+
+template <>
+FusedStatsData fusedStats<float>(const float *buffer, uint32_t count)
+{
+    return fusedStatsDispatch(buffer, count);
+}
+}
+
+template <typename T>
+void FITSData::calculateFusedStats(bool roi)
+{
+    if (roi)
+    {
+        calculateRoiFusedStats<T>();
+        return;
+    }
+
     // Create N threads
     const uint8_t nThreads = 16;
+    FITSImage::Statistic &stats = m_Statistics;
+    auto * buffer = reinterpret_cast<const T *>(m_ImageBuffer);
+
+    // Sampled statistics, whole rows are kept so the vectorized kernels still apply.
+    if (m_StatisticsRowStep > 1)
+    {
+        const uint32_t width = stats.width, step = m_StatisticsRowStep;
+        const uint32_t rows = (stats.height + step - 1) / step;
+        const uint32_t rowsPerThread = (rows + nThreads - 1) / nThreads;
+        for (int n = 0; n < m_Statistics.channels; n++)
+        {
+            const T *origin = buffer + n * stats.samples_per_channel;
+            QList<QFuture<FusedStatsData>> futures;
+            for (uint32_t first = 0; first < rows; first += rowsPerThread)
+            {
+                const uint32_t last = qMin(rows, first + rowsPerThread);
+                futures.append(ProcessingLanes::run(lane(), [origin, width, step, first, last]()
+                {
+                    FusedStatsData sampled;
+                    for (uint32_t row = first; row < last; row++)
+                        sampled = mergeFusedStats(sampled, fusedStats<T>(origin + static_cast<size_t>(row) * step * width, width));
+                    return sampled;
+                }));
+            }
+
+            FusedStatsData total;
+            for (auto &future : futures)
+                total = mergeFusedStats(total, future.result());
+
+            if (total.numSamples <= 0) continue;
+            const double mean = total.sum / total.numSamples;
+            const double variance = total.squaredSum / total.numSamples - mean * mean;
+            stats.min[n]    = total.min;
+            stats.max[n]    = total.max;
+            stats.mean[n]   = mean;
+            stats.stddev[n] = sqrt(variance);
+        }
+        return;
+    }
 
     for (int n = 0; n < m_Statistics.channels; n++)
     {
-        uint32_t cStart = n * (roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel);
+        uint32_t cStart = n * stats.samples_per_channel;
 
         // Calculate how many elements we process per thread
-        uint32_t tStride = (roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel) / nThreads;
+        uint32_t tStride = stats.samples_per_channel / nThreads;
 
         // Calculate the final stride since we can have some left over due to division above
-        uint32_t fStride = tStride + ((roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel) -
-                                      (tStride * nThreads));
+        uint32_t fStride = tStride + (stats.samples_per_channel - (tStride * nThreads));
 
         // Start location for inspecting elements
         uint32_t tStart = cStart;
 
         // List of futures
-        QList<QFuture<SumData>> futures;
+        QList<QFuture<FusedStatsData>> futures;
 
         for (int i = 0; i < nThreads; i++)
         {
             // Run threads
-            uint8_t *buff = roi ? m_ImageRoiBuffer : m_ImageBuffer;
-            futures.append(QtConcurrent::run(&getSumAndSquaredSum<T>, tStart,
-                                             (i == (nThreads - 1)) ? fStride : tStride, buff));
+            const T *start = buffer + tStart;
+            const uint32_t count = (i == (nThreads - 1)) ? fStride : tStride;
+            futures.append(ProcessingLanes::run(lane(), [start, count]()
+            {
+                return fusedStats<T>(start, count);
+            }));
             tStart += tStride;
         }
 
         // Now wait for results
-        double sum = 0, squared_sum = 0;
-        double numSamples = 0;
+        FusedStatsData total;
         for (int i = 0; i < nThreads; i++)
-        {
-            const SumData result = futures[i].result();
-            sum += result.sum;
-            squared_sum += result.squaredSum;
-            numSamples += result.numSamples;
+            total = mergeFusedStats(total, futures[i].result());
 
-        }
-        if (numSamples <= 0) continue;
-        const double mean = sum / numSamples;
-        const double variance = squared_sum / numSamples - mean * mean;
-        if(!roi)
+        if (total.numSamples <= 0) continue;
+        const double mean = total.sum / total.numSamples;
+        const double variance = total.squaredSum / total.numSamples - mean * mean;
+        stats.min[n]    = total.min;
+        stats.max[n]    = total.max;
+        stats.mean[n]   = mean;
+        stats.stddev[n] = sqrt(variance);
+    }
+}
+
+template <typename T>
+void FITSData::calculateRoiFusedStats()
+{
+    // The selection is processed in place, one row of the image buffer at a time.
+    const uint32_t pitch = m_Statistics.width;
+    const uint32_t width = m_ROIStatistics.width;
+    const uint32_t height = m_ROIStatistics.height;
+    auto * buffer = reinterpret_cast<const T *>(m_ImageBuffer) + m_ROIRect.y() * pitch + m_ROIRect.x();
+
+    // Tracking boxes are small, threads only pay off for large selections.
+    const uint32_t nThreads = m_ROIStatistics.samples_per_channel < 256 * 1024 ? 1 : 16;
+    const uint32_t rowsPerThread = (height + nThreads - 1) / nThreads;
+
+    for (int n = 0; n < m_Statistics.channels; n++)
+    {
+        const T *origin = buffer + n * m_Statistics.samples_per_channel;
+        const auto rowsStats = [origin, pitch, width](uint32_t first, uint32_t last)
         {
-            m_Statistics.mean[n]   = mean;
-            m_Statistics.stddev[n] = sqrt(variance);
-        }
+            FusedStatsData rows;
+            for (uint32_t y = first; y < last; y++)
+                rows = mergeFusedStats(rows, fusedStats<T>(origin + y * pitch, width));
+            return rows;
+        };
+
+        FusedStatsData total;
+        if (nThreads == 1)
+            total = rowsStats(0, height);
         else
         {
-            m_ROIStatistics.mean[n] = mean;
-            m_ROIStatistics.stddev[n] = sqrt(variance);
+            QList<QFuture<FusedStatsData>> futures;
+            for (uint32_t first = 0; first < height; first += rowsPerThread)
+            {
+                const uint32_t last = qMin(height, first + rowsPerThread);
+                futures.append(ProcessingLanes::run(lane(), [rowsStats, first, last]()
+                {
+                    return rowsStats(first, last);
+                }));
+            }
+            for (auto &future : futures)
+                total = mergeFusedStats(total, future.result());
         }
+
+        if (total.numSamples <= 0) continue;
+        const double mean = total.sum / total.numSamples;
+        const double variance = total.squaredSum / total.numSamples - mean * mean;
+        m_ROIStatistics.min[n]    = total.min;
+        m_ROIStatistics.max[n]    = total.max;
+        m_ROIStatistics.mean[n]   = mean;
+        m_ROIStatistics.stddev[n] = sqrt(variance);
+    }
+}
+
+namespace
+{
+// Bands smaller than this are not worth dispatching to another thread.
+constexpr uint32_t FilterMinBandRows = 32;
+
+// Run function(first, last) concurrently over bands of rows in the pool of lane, and wait for all of them.
+template <typename Function>
+void filterRowBands(ProcessingLanes::Lane lane, uint32_t height, Function function)
+{
+    const uint32_t maxBands = 4 * static_cast<uint32_t>(qMax(1, ProcessingLanes::pool(lane)->maxThreadCount()));
+    const uint32_t bandRows = qMax(FilterMinBandRows, (height + maxBands - 1) / maxBands);
+
+    QList<QFuture<void>> futures;
+    for (uint32_t first = 0; first < height; first += bandRows)
+    {
+        const uint32_t last = qMin(height, first + bandRows);
+        futures.append(ProcessingLanes::run(lane, [function, first, last]()
+        {
+            function(first, last);
+        }));
+    }
+    for (auto &future : futures)
+        future.waitForFinished();
+}
+
+// accumulator[i] += weight * source[i], the inner loop of both passes of the separable filter.
+void accumulateWeightedScalar(float *accumulator, const float *source, float weight, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        accumulator[i] += weight * source[i];
+}
+
+#if defined(KSTARS_FITS_SIMD_X86)
+__attribute__((target("avx2")))
+void accumulateWeightedAVX2(float *accumulator, const float *source, float weight, uint32_t count)
+{
+    const uint32_t vectorCount = count / 8;
+    const __m256 vweight = _mm256_set1_ps(weight);
+    for (uint32_t i = 0; i < vectorCount * 8; i += 8)
+    {
+        const __m256 product = _mm256_mul_ps(vweight, _mm256_loadu_ps(source + i));
+        _mm256_storeu_ps(accumulator + i, _mm256_add_ps(_mm256_loadu_ps(accumulator + i), product));
+    }
+    accumulateWeightedScalar(accumulator + vectorCount * 8, source + vectorCount * 8, weight, count - vectorCount * 8);
+}
+#endif
+
+#if defined(KSTARS_FITS_SIMD_NEON)
+void accumulateWeightedNEON(float *accumulator, const float *source, float weight, uint32_t count)
+{
+    const uint32_t vectorCount = count / 4;
+    for (uint32_t i = 0; i < vectorCount * 4; i += 4)
+        vst1q_f32(accumulator + i, vmlaq_n_f32(vld1q_f32(accumulator + i), vld1q_f32(source + i), weight));
+    accumulateWeightedScalar(accumulator + vectorCount * 4, source + vectorCount * 4, weight, count - vectorCount * 4);
+}
+#endif
+
+void accumulateWeighted(float *accumulator, const float *source, float weight, uint32_t count)
+{
+#if defined(KSTARS_FITS_SIMD_X86)
+    if (cpuHasAVX2())
+        return accumulateWeightedAVX2(accumulator, source, weight, count);
+    accumulateWeightedScalar(accumulator, source, weight, count);
+#elif defined(KSTARS_FITS_SIMD_NEON)
+    accumulateWeightedNEON(accumulator, source, weight, count);
+#else
+    accumulateWeightedScalar(accumulator, source, weight, count);
+#endif
+}
+
+// Integer samples are rounded and clamped back into their range, floating point ones are kept as is.
+template <typename T>
+T filterResult(float value)
+{
+    if constexpr (std::is_integral<T>::value)
+    {
+        const float rounded = std::nearbyint(value);
+        if (rounded <= static_cast<float>(std::numeric_limits<T>::lowest()))
+            return std::numeric_limits<T>::lowest();
+        if (rounded >= static_cast<float>(std::numeric_limits<T>::max()))
+            return std::numeric_limits<T>::max();
+        return static_cast<T>(rounded);
     }
+    else
+        return static_cast<T>(value);
+}
 }
 
-QVector<double> FITSData::createGaussianKernel(int size, double sigma)
+QVector<float> FITSData::createGaussianKernel(int size, double sigma)
 {
-    QVector<double> kernel(size * size);
-    kernel.fill(0.0, size * size);
+    QVector<float> kernel(size, 0.0f);
+    if (sigma <= 0)
+    {
+        kernel[(size - 1) / 2] = 1.0f;
+        return kernel;
+    }
 
+    // The 2D Gaussian is the product of two 1D Gaussians, so the 1D kernel applied along rows
+    // then along columns is the same as the normalized 2D kernel.
+    QVector<double> weights(size);
     double kernelSum = 0.0;
     int fOff = (size - 1) / 2;
-    double normal = 1.0 / (2.0 * M_PI * sigma * sigma);
-    for (int y = -fOff; y <= fOff; y++)
+    for (int x = -fOff; x <= fOff; x++)
     {
-        for (int x = -fOff; x <= fOff; x++)
-        {
-            double distance = ((y * y) + (x * x)) / (2.0 * sigma * sigma);
-            int index = (y + fOff) * size + (x + fOff);
-            kernel[index] = normal * qExp(-distance);
-            kernelSum += kernel.at(index);
-        }
+        weights[x + fOff] = qExp(-(x * x) / (2.0 * sigma * sigma));
+        kernelSum += weights[x + fOff];
     }
-    for (int y = 0; y < size; y++)
+    for (int x = 0; x < size; x++)
+        kernel[x] = static_cast<float>(weights[x] / kernelSum);
+
+    return kernel;
+}
+
+template <typename T>
+void FITSData::separableFilter(const QVector<float> &kernel)
+{
+    const uint32_t width = m_Statistics.width;
+    const uint32_t height = m_Statistics.height;
+    const int taps = kernel.size();
+    const uint32_t radius = taps / 2;
+    if (taps <= 1 || width == 0 || height == 0)
+        return;
+
+    // The horizontal pass of a whole channel is kept in float, the vertical pass then needs rows
+    // from the neighbouring bands.
+    const uint32_t scratchSize = width * height * sizeof(float);
+    uint8_t *scratchBuffer = ImageBufferPool::instance().acquire(scratchSize);
+    if (scratchBuffer == nullptr)
     {
-        for (int x = 0; x < size; x++)
+        qCWarning(KSTARS_FITS) << "FITSData: Not enough memory for the filter buffer of" << scratchSize << "bytes";
+        return;
+    }
+    float *scratch = reinterpret_cast<float *>(scratchBuffer);
+    const float *weights = kernel.constData();
+
+    for (int channel = 0; channel < m_Statistics.channels; channel++)
+    {
+        T *plane = reinterpret_cast<T *>(m_ImageBuffer) + channel * m_Statistics.samples_per_channel;
+
+        // Each row is extended by repeating its first and last samples, so the taps never leave the image.
+        filterRowBands(lane(), height, [ = ](uint32_t first, uint32_t last)
         {
-            int index = y * size + x;
-            kernel[index] = kernel.at(index) * 1.0 / kernelSum;
-        }
+            std::vector<float> padded(width + 2 * radius);
+            for (uint32_t y = first; y < last; y++)
+            {
+                const T *row = plane + y * width;
+                for (uint32_t x = 0; x < radius; x++)
+                {
+                    padded[x] = row[0];
+                    padded[radius + width + x] = row[width - 1];
+                }
+                for (uint32_t x = 0; x < width; x++)
+                    padded[radius + x] = row[x];
+
+                float *out = scratch + y * width;
+                std::fill(out, out + width, 0.0f);
+                for (int k = 0; k < taps; k++)
+                    accumulateWeighted(out, padded.data() + k, weights[k], width);
+            }
+        });
+
+        // Columns are extended the same way by clamping the source row.
+        filterRowBands(lane(), height, [ = ](uint32_t first, uint32_t last)
+        {
+            std::vector<float> accumulator(width);
+            for (uint32_t y = first; y < last; y++)
+            {
+                std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+                for (int k = 0; k < taps; k++)
+                {
+                    const int64_t sourceY = qBound<int64_t>(0, static_cast<int64_t>(y) + k - radius, height - 1);
+                    accumulateWeighted(accumulator.data(), scratch + sourceY * width, weights[k], width);
+                }
+
+                T *row = plane + y * width;
+                for (uint32_t x = 0; x < width; x++)
+                    row[x] = filterResult<T>(accumulator[x]);
+            }
+        });
+    }
+
+    ImageBufferPool::instance().release(scratchBuffer);
+}
+
+template <typename T>
+void FITSData::gaussianBlur(int kernelSize, double sigma)
+{
+    // Size must be an odd number!
+    if (kernelSize % 2 == 0)
+    {
+        kernelSize--;
+        qCInfo(KSTARS_FITS) << "Warning, size must be an odd number, correcting size to " << kernelSize;
     }
+    // Edge must be a positive number!
+    if (kernelSize < 1)
+    {
+        kernelSize = 1;
+    }
+
+    separableFilter<T>(createGaussianKernel(kernelSize, sigma));
+}
+
+namespace
+{
+template <typename T>
+void toFloatScalar(const T *source, float *destination, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        destination[i] = source[i];
+}
+
+#if defined(KSTARS_FITS_SIMD_X86)
+__attribute__((target("avx2")))
+void toFloatAVX2(const uint8_t *source, float *destination, uint32_t count)
+{
+    const uint32_t vectorCount = count / 8;
+    for (uint32_t i = 0; i < vectorCount * 8; i += 8)
+    {
+        const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(source + i));
+        _mm256_storeu_ps(destination + i, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v)));
+    }
+    toFloatScalar(source + vectorCount * 8, destination + vectorCount * 8, count - vectorCount * 8);
+}
+
+__attribute__((target("avx2")))
+void toFloatAVX2(const uint16_t *source, float *destination, uint32_t count)
+{
+    const uint32_t vectorCount = count / 8;
+    for (uint32_t i = 0; i < vectorCount * 8; i += 8)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+        _mm256_storeu_ps(destination + i, _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(v)));
+    }
+    toFloatScalar(source + vectorCount * 8, destination + vectorCount * 8, count - vectorCount * 8);
+}
+#endif
+
+#if defined(KSTARS_FITS_SIMD_NEON)
+void toFloatNEON(const uint8_t *source, float *destination, uint32_t count)
+{
+    const uint32_t vectorCount = count / 8;
+    for (uint32_t i = 0; i < vectorCount * 8; i += 8)
+    {
+        const uint16x8_t v = vmovl_u8(vld1_u8(source + i));
+        vst1q_f32(destination + i, vcvtq_f32_u32(vmovl_u16(vget_low_u16(v))));
+        vst1q_f32(destination + i + 4, vcvtq_f32_u32(vmovl_high_u16(v)));
+    }
+    toFloatScalar(source + vectorCount * 8, destination + vectorCount * 8, count - vectorCount * 8);
+}
+
+void toFloatNEON(const uint16_t *source, float *destination, uint32_t count)
+{
+    const uint32_t vectorCount = count / 8;
+    for (uint32_t i = 0; i < vectorCount * 8; i += 8)
+    {
+        const uint16x8_t v = vld1q_u16(source + i);
+        vst1q_f32(destination + i, vcvtq_f32_u32(vmovl_u16(vget_low_u16(v))));
+        vst1q_f32(destination + i + 4, vcvtq_f32_u32(vmovl_high_u16(v)));
+    }
+    toFloatScalar(source + vectorCount * 8, destination + vectorCount * 8, count - vectorCount * 8);
+}
+#endif
+
+template <typename T>
+void toFloatDispatch(const T *source, float *destination, uint32_t count)
+{
+#if defined(KSTARS_FITS_SIMD_X86)
+    if (cpuHasAVX2())
+        return toFloatAVX2(source, destination, count);
+    toFloatScalar(source, destination, count);
+#elif defined(KSTARS_FITS_SIMD_NEON)
+    toFloatNEON(source, destination, count);
+#else
+    toFloatScalar(source, destination, count);
+#endif
+}
+
+// Camera data is 8 or 16 bit unsigned, the other types are converted by the scalar loop.
+template <typename T>
+void toFloat(const T *source, float *destination, uint32_t count)
+{
+    toFloatScalar(source, destination, count);
+}
+
+template <>
+void toFloat<uint8_t>(const uint8_t *source, float *destination, uint32_t count)
+{
+    toFloatDispatch(source, destination, count);
+}
 
-    return kernel;
+template <>
+void toFloat<uint16_t>(const uint16_t *source, float *destination, uint32_t count)
+{
+    toFloatDispatch(source, destination, count);
+}
 }
 
 template <typename T>
-void FITSData::convolutionFilter(const QVector<double> &kernel, int kernelSize)
+void FITSData::convertToFloat(float *buffer, const QRect &area) const
 {
-    T * imagePtr = reinterpret_cast<T *>(m_ImageBuffer);
-
-    // Create variable for pixel data for each kernel
-    T gt = 0;
+    auto const *rawBuffer = reinterpret_cast<T const *>(m_ImageBuffer);
+    const uint32_t width = area.width();
+    for (int y = area.top(); y <= area.bottom(); y++)
+        toFloat(rawBuffer + static_cast<size_t>(y) * m_Statistics.width + area.left(),
+                buffer + static_cast<size_t>(y - area.top()) * width, width);
+}
 
-    // This is how much your center pixel is offset from the border of your kernel
-    int fOff = (kernelSize - 1) / 2;
+bool FITSData::getFloatBuffer(float *buffer, const QRect &area) const
+{
+    if (buffer == nullptr || m_ImageBuffer == nullptr || area.isEmpty()
+            || !QRect(0, 0, m_Statistics.width, m_Statistics.height).contains(area))
+        return false;
 
-    // Start with the pixel that is offset fOff from top and fOff from the left side
-    // this is so entire kernel is on your image
-    for (int offsetY = 0; offsetY < m_Statistics.height; offsetY++)
+    switch (m_Statistics.dataType)
     {
-        for (int offsetX = 0; offsetX < m_Statistics.width; offsetX++)
-        {
-            // reset gray value to 0
-            gt = 0;
-            // position of the kernel center pixel
-            int byteOffset = offsetY * m_Statistics.width + offsetX;
+        case TBYTE:
+            convertToFloat<uint8_t>(buffer, area);
+            break;
 
-            // kernel calculations
-            for (int filterY = -fOff; filterY <= fOff; filterY++)
-            {
-                for (int filterX = -fOff; filterX <= fOff; filterX++)
-                {
-                    if ((offsetY + filterY) >= 0 && (offsetY + filterY) < m_Statistics.height
-                            && ((offsetX + filterX) >= 0 && (offsetX + filterX) < m_Statistics.width ))
-                    {
+        case TSHORT:
+            convertToFloat<int16_t>(buffer, area);
+            break;
 
-                        int calcOffset = byteOffset + filterX + filterY * m_Statistics.width;
-                        int index = (filterY + fOff) * kernelSize + (filterX + fOff);
-                        double kernelValue = kernel.at(index);
-                        gt += (imagePtr[calcOffset]) * kernelValue;
-                    }
-                }
-            }
+        case TUSHORT:
+            convertToFloat<uint16_t>(buffer, area);
+            break;
 
-            // set new data in the other byte array for your image data
-            imagePtr[byteOffset] = gt;
-        }
-    }
-}
+        case TLONG:
+            convertToFloat<int32_t>(buffer, area);
+            break;
 
-template <typename T>
-void FITSData::gaussianBlur(int kernelSize, double sigma)
-{
-    // Size must be an odd number!
-    if (kernelSize % 2 == 0)
-    {
-        kernelSize--;
-        qCInfo(KSTARS_FITS) << "Warning, size must be an odd number, correcting size to " << kernelSize;
-    }
-    // Edge must be a positive number!
-    if (kernelSize < 1)
-    {
-        kernelSize = 1;
+        case TULONG:
+            convertToFloat<uint32_t>(buffer, area);
+            break;
+
+        case TFLOAT:
+            convertToFloat<float>(buffer, area);
+            break;
+
+        case TLONGLONG:
+            convertToFloat<int64_t>(buffer, area);
+            break;
+
+        case TDOUBLE:
+            convertToFloat<double>(buffer, area);
+            break;
+
+        default:
+            return false;
     }
 
-    QVector<double> gaussianKernel = createGaussianKernel(kernelSize, sigma);
-    convolutionFilter<T>(gaussianKernel, kernelSize);
+    return true;
 }
 
 void FITSData::setMinMax(double newMin, double newMax, uint8_t channel)
@@ -2047,8 +2911,15 @@ bool FITSData::parseSolution(FITSImage::Solution &solution) const
     return (coordOK || scaleOK);
 }
 
+bool FITSData::areStarsFound(StarAlgorithm algorithm, const QRect &trackingBox) const
+{
+    return starsSearched && m_StarFindFuture.isFinished() && starAlgorithm == algorithm && m_StarFindBox == trackingBox
+           && m_StarFindSettings == m_SourceExtractorSettings;
+}
+
 QFuture<bool> FITSData::findStars(StarAlgorithm algorithm, const QRect &trackingBox)
 {
+    KSTRACE_SCOPE("fits", "findStars");
     if (m_StarFindFuture.isRunning())
         m_StarFindFuture.waitForFinished();
 
@@ -2056,6 +2927,8 @@ QFuture<bool> FITSData::findStars(StarAlgorithm algorithm, const QRect &tracking
     qDeleteAll(starCenters);
     starCenters.clear();
     starsSearched = true;
+    m_StarFindSettings = m_SourceExtractorSettings;
+    m_StarFindBox = trackingBox;
 
     switch (algorithm)
     {
@@ -2244,7 +3117,7 @@ double FITSData::getHFR(HFRType type)
         }
     }
 
-    auto m = Mathematics::RobustStatistics::ComputeLocation(Mathematics::RobustStatistics::LOCATION_SIGMACLIPPING,
+    auto m = Mathematics::RobustStatistics::ComputeLocationInPlace(Mathematics::RobustStatistics::LOCATION_SIGMACLIPPING,
              HFRs, 2);
 
     cacheHFR = m;
@@ -2299,6 +3172,9 @@ void FITSData::applyFilter(FITSScale type, uint8_t * image, QVector<double> * mi
     if (type == FITS_NONE)
         return;
 
+    if (image == nullptr)
+        m_FineHistogramConstructed = false;
+
     QVector<double> dataMin(3);
     QVector<double> dataMax(3);
 
@@ -2565,12 +3441,12 @@ void FITSData::applyFilter(FITSScale type, uint8_t * targetImage, QVector<double
 
             if (calcStats)
             {
+                calculateFusedStats<T>();
                 for (int i = 0; i < 3; i++)
                 {
                     m_Statistics.min[i] = min[i];
                     m_Statistics.max[i] = max[i];
                 }
-                calculateStdDev<T>();
             }
         }
         break;
@@ -2674,7 +3550,13 @@ void FITSData::applyFilter(FITSScale type, uint8_t * targetImage, QVector<double
             delete[] extension;
 
             if (calcStats)
-                calculateStdDev<T>();
+            {
+                // Only mean and standard deviation are refreshed, the range is kept.
+                const FITSImage::Statistic previous = m_Statistics;
+                calculateFusedStats<T>();
+                std::copy(previous.min, previous.min + 3, m_Statistics.min);
+                std::copy(previous.max, previous.max + 3, m_Statistics.max);
+            }
         }
         break;
 
@@ -2906,13 +3788,48 @@ bool FITSData::searchObjects()
 
     m_ObjectsSearched = true;
 
-    SkyPoint startPoint;
-    SkyPoint endPoint;
+    return findObjectsInImage();
+}
+
+QVector<QPointF> FITSData::wcsEdges() const
+{
+    QVector<QPointF> edges;
+    if (m_WCSHandle == nullptr || width() < 2 || height() < 2)
+        return edges;
+
+    // The edges, without counting the corners twice
+    const int count = 2 * height() + 2 * (width() - 2);
+    std::vector<double> pixcrd(2 * count), imgcrd(2 * count), world(2 * count), phi(count), theta(count);
+    std::vector<int> stat(count);
+    int n = 0;
+    for (int y = 0; y < height(); y++, n += 2)
+    {
+        pixcrd[2 * n] = 0;
+        pixcrd[2 * n + 1] = y;
+        pixcrd[2 * n + 2] = width() - 1;
+        pixcrd[2 * n + 3] = y;
+    }
+    for (int x = 1; x < width() - 1; x++, n += 2)
+    {
+        pixcrd[2 * n] = x;
+        pixcrd[2 * n + 1] = 0;
+        pixcrd[2 * n + 2] = x;
+        pixcrd[2 * n + 3] = height() - 1;
+    }
 
-    pixelToWCS(QPointF(0, 0), startPoint);
-    pixelToWCS(QPointF(width() - 1, height() - 1), endPoint);
+    // Invalid pixels only fail their own coordinates
+    const int status = wcsp2s(m_WCSHandle, count, 2, pixcrd.data(), imgcrd.data(), phi.data(), theta.data(), world.data(),
+                              stat.data());
+    if (status != 0 && status != WCSERR_BAD_PIX)
+        return edges;
 
-    return findObjectsInImage(startPoint, endPoint);
+    edges.reserve(count);
+    for (int i = 0; i < count; i++)
+    {
+        if (stat[i] == 0)
+            edges.append(QPointF(world[2 * i], world[2 * i + 1]));
+    }
+    return edges;
 }
 
 bool FITSData::findWCSBounds(double &minRA, double &maxRA, double &minDec, double &maxDec)
@@ -2928,34 +3845,13 @@ bool FITSData::findWCSBounds(double &minRA, double &maxRA, double &minDec, doubl
     maxDec = -1000;
     minDec = 1000;
 
-    auto updateMinMax = [&](int x, int y)
-    {
-        int stat[2];
-        double imgcrd[2], phi, pixcrd[2], theta, world[2];
-
-        pixcrd[0] = x;
-        pixcrd[1] = y;
-
-        if (wcsp2s(m_WCSHandle, 1, 2, &pixcrd[0], &imgcrd[0], &phi, &theta, &world[0], &stat[0]))
-            return;
-
-        minRA = std::min(minRA, world[0]);
-        maxRA = std::max(maxRA, world[0]);
-        minDec = std::min(minDec, world[1]);
-        maxDec = std::max(maxDec, world[1]);
-    };
-
     // Find min and max values from edges
-    for (int y = 0; y < height(); y++)
-    {
-        updateMinMax(0, y);
-        updateMinMax(width() - 1, y);
-    }
-
-    for (int x = 1; x < width() - 1; x++)
+    for (const auto &edge : wcsEdges())
     {
-        updateMinMax(x, 0);
-        updateMinMax(x, height() - 1);
+        minRA = std::min(minRA, edge.x());
+        maxRA = std::max(maxRA, edge.x());
+        minDec = std::min(minDec, edge.y());
+        maxDec = std::max(maxDec, edge.y());
     }
 
     // Check if either pole is in the image
@@ -2981,39 +3877,36 @@ bool FITSData::findWCSBounds(double &minRA, double &maxRA, double &minDec, doubl
 #endif
 
 #if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
-bool FITSData::findObjectsInImage(SkyPoint startPoint, SkyPoint endPoint)
+bool FITSData::findObjectsInImage()
 {
     if (KStarsData::Instance() == nullptr)
         return false;
 
-    int w = width();
-    int h = height();
-    QVariant date;
-    KSNumbers * num = nullptr;
+    m_SkyObjects.clear();
 
-    if (getRecordValue("DATE-OBS", date))
+    // The image lies within the circle around its center that holds its edges, wherever it is on the sky
+    SkyPoint center;
+    const QVector<QPointF> edges = wcsEdges();
+    if (edges.isEmpty() || !pixelToWCS(QPointF(width() / 2.0, height() / 2.0), center))
     {
-        QString tsString(date.toString());
-        tsString = tsString.remove('\'').trimmed();
-        // Add Zulu time to indicate UTC
-        tsString += "Z";
-
-        QDateTime ts = QDateTime::fromString(tsString, Qt::ISODate);
-
-        if (ts.isValid())
-            num = new KSNumbers(KStarsDateTime(ts).djd());
+        m_LastError = i18n("No world coordinate systems found.");
+        return false;
     }
 
-    //Set to current time if the above does not work.
-    if (num == nullptr)
-        num = new KSNumbers(KStarsData::Instance()->ut().djd());
-
-    startPoint.updateCoordsNow(num);
-    endPoint.updateCoordsNow(num);
-
-    m_SkyObjects.clear();
+    double sinDec0, cosDec0;
+    center.dec0().SinCos(sinDec0, cosDec0);
+    const double ra0 = center.ra0().radians();
+    double minCos = 1;
+    for (const auto &edge : edges)
+    {
+        const double dec = edge.y() * dms::DegToRad;
+        const double cosDistance = sinDec0 * std::sin(dec) + cosDec0 * std::cos(dec) * std::cos(edge.x() * dms::DegToRad - ra0);
+        minCos = std::min(minCos, cosDistance);
+    }
+    const double radius = std::acos(std::max(-1.0, minCos)) / dms::DegToRad;
 
-    QList<SkyObject *> list = KStarsData::Instance()->skyComposite()->findObjectsInArea(startPoint, endPoint);
+    // Stars are not annotated, so only the deep-sky catalogs are looked up
+    QList<SkyObject *> list = KStarsData::Instance()->skyComposite()->findObjectsInArea(center, radius, false);
     list.erase(std::remove_if(list.begin(), list.end(), [](SkyObject * oneObject)
     {
         int type = oneObject->type();
@@ -3022,24 +3915,41 @@ bool FITSData::findObjectsInImage(SkyPoint startPoint, SkyPoint endPoint)
                 type == SkyObject::SATELLITE);
     }), list.end());
 
-    double world[2], phi, theta, imgcrd[2], pixcrd[2];
-    int stat[2];
-    for (auto &object : list)
+    const int count = list.size();
+    if (count == 0)
+        return true;
+
+    // Project all candidates at once
+    std::vector<double> world(2 * count), imgcrd(2 * count), pixcrd(2 * count), phi(count), theta(count);
+    std::vector<int> stat(count);
+    for (int i = 0; i < count; i++)
     {
-        world[0] = object->ra0().Degrees();
-        world[1] = object->dec0().Degrees();
+        world[2 * i] = list[i]->ra0().Degrees();
+        world[2 * i + 1] = list[i]->dec0().Degrees();
+    }
 
-        if (wcss2p(m_WCSHandle, 1, 2, &world[0], &phi, &theta, &imgcrd[0], &pixcrd[0], &stat[0]) == 0)
-        {
-            //The X and Y are set to the found position if it does work.
-            int x = pixcrd[0];
-            int y = pixcrd[1];
-            if (x > 0 && y > 0 && x < w && y < h)
-                m_SkyObjects.append(new FITSSkyObject(object, x, y));
-        }
+    // Invalid coordinates only fail their own objects
+    const int status = wcss2p(m_WCSHandle, count, 2, world.data(), phi.data(), theta.data(), imgcrd.data(), pixcrd.data(),
+                              stat.data());
+    if (status != 0 && status != WCSERR_BAD_WORLD)
+        return false;
+
+    const int w = width();
+    const int h = height();
+    m_SkyObjects.reserve(count);
+    for (int i = 0; i < count; i++)
+    {
+        if (stat[i] != 0)
+            continue;
+
+        //The X and Y are set to the found position if it does work.
+        int x = pixcrd[2 * i];
+        int y = pixcrd[2 * i + 1];
+        if (x > 0 && y > 0 && x < w && y < h)
+            m_SkyObjects.append(FITSSkyObject(list[i], x, y));
     }
+    m_SkyObjects.squeeze();
 
-    delete (num);
     return true;
 }
 #endif
@@ -3102,7 +4012,7 @@ bool FITSData::rotFITS(int rotate, int mirror)
     int BBP = m_Statistics.bytesPerPixel;
 
     /* Allocate buffer for rotated image */
-    rotimage = new uint8_t[m_Statistics.samples_per_channel * m_Statistics.channels * BBP];
+    rotimage = ImageBufferPool::instance().acquire(m_Statistics.samples_per_channel * m_Statistics.channels * BBP);
 
     if (rotimage == nullptr)
     {
@@ -3325,7 +4235,7 @@ bool FITSData::rotFITS(int rotate, int mirror)
         }
     }
 
-    delete[] m_ImageBuffer;
+    ImageBufferPool::instance().release(m_ImageBuffer);
     m_ImageBuffer = rotimage;
 
     return true;
@@ -3616,6 +4526,8 @@ void FITSData::rotWCSFITS(int angle, int mirror)
 
 uint8_t * FITSData::getWritableImageBuffer()
 {
+    // The caller may change the pixels, so any counts we have are no longer trusted.
+    m_FineHistogramConstructed = false;
     return m_ImageBuffer;
 }
 
@@ -3626,7 +4538,7 @@ uint8_t const * FITSData::getImageBuffer() const
 
 void FITSData::setImageBuffer(uint8_t * buffer)
 {
-    delete[] m_ImageBuffer;
+    ImageBufferPool::instance().release(m_ImageBuffer);
     m_ImageBuffer = buffer;
 }
 
@@ -3714,6 +4626,31 @@ bool FITSData::checkDebayer()
     return true;
 }
 
+bool FITSData::releaseImageBuffer()
+{
+    // A debayered image may have been debayered differently than a load would
+    if (m_ImageBuffer == nullptr || m_isTemporary || HasDebayer || m_Filename.isEmpty() || !QFileInfo::exists(m_Filename))
+        return false;
+
+    clearImageBuffers();
+    m_HistogramIntensity.clear();
+    m_HistogramFrequency.clear();
+    m_CumulativeFrequency.clear();
+    m_FineHistogram.clear();
+    resetHistogram();
+    m_ImageBufferReleased = true;
+    return true;
+}
+
+bool FITSData::restoreImageBuffer()
+{
+    if (!m_ImageBufferReleased)
+        return true;
+
+    m_ImageBufferReleased = false;
+    return loadFromFile(m_Filename).result();
+}
+
 void FITSData::getBayerParams(BayerParams * param)
 {
     param->method  = debayerParams.method;
@@ -3759,185 +4696,411 @@ bool FITSData::debayer(bool reload)
     }
 }
 
-bool FITSData::debayer_8bit()
+namespace
 {
-    dc1394error_t error_code;
-
-    uint32_t rgb_size = m_Statistics.samples_per_channel * 3 * m_Statistics.bytesPerPixel;
-    uint8_t * destinationBuffer = nullptr;
-
-    try
-    {
-        destinationBuffer = new uint8_t[rgb_size];
-    }
-    catch (const std::bad_alloc &e)
-    {
-        logOOMError(rgb_size);
-        m_LastError = i18n("Unable to allocate memory for temporary bayer buffer: %1", e.what());
-        return false;
-    }
-
-    auto * bayer_source_buffer      = reinterpret_cast<uint8_t *>(m_ImageBuffer);
-    auto * bayer_destination_buffer = reinterpret_cast<uint8_t *>(destinationBuffer);
-
-    if (bayer_destination_buffer == nullptr)
-    {
-        logOOMError(rgb_size);
-        m_LastError = i18n("Unable to allocate memory for temporary bayer buffer.");
-        return false;
+// Each band decodes this many extra rows above and below its own rows so that the bayer.c
+// kernels see the same neighbourhood as when decoding the whole image. It is even to keep the
+// Bayer phase of the band, and covers the widest kernel support (AHD).
+constexpr uint32_t DebayerHaloRows = 8;
+// Smaller bands are not worth the overhead of the halo.
+constexpr uint32_t DebayerMinBandRows = 64;
+
+// Run function(first, last) concurrently over bands of an even number of rows, in the lane of the frame.
+template <typename Function>
+dc1394error_t debayerRowBands(uint32_t height, Function function, uint32_t minBandRows = DebayerMinBandRows)
+{
+    const ProcessingLanes::Lane lane = ProcessingLanes::current();
+    const int threads = ProcessingLanes::pool(lane)->maxThreadCount();
+    // The halo is pure overhead without several threads.
+    if (threads <= 1)
+        minBandRows = height;
+    const uint32_t maxBands = 4 * static_cast<uint32_t>(threads);
+    uint32_t bandRows = qMax(minBandRows, (height + maxBands - 1) / maxBands);
+    bandRows += bandRows % 2;
+
+    QList<QFuture<dc1394error_t>> futures;
+    for (uint32_t first = 0; first < height; first += bandRows)
+    {
+        const uint32_t last = qMin(height, first + bandRows);
+        futures.append(ProcessingLanes::run(lane, [function, first, last]()
+        {
+            return function(first, last);
+        }));
     }
 
-    int ds1394_height = m_Statistics.height;
-    auto dc1394_source = bayer_source_buffer;
-
-    if (debayerParams.offsetY == 1)
+    dc1394error_t result = DC1394_SUCCESS;
+    for (auto &future : futures)
     {
-        dc1394_source += m_Statistics.width;
-        ds1394_height--;
+        future.waitForFinished();
+        if (future.result() != DC1394_SUCCESS)
+            result = future.result();
     }
-    // offsetX == 1 is handled in checkDebayer() and should be 0 here.
+    return result;
+}
 
-    error_code = dc1394_bayer_decoding_8bit(dc1394_source, bayer_destination_buffer, m_Statistics.width, ds1394_height,
-                                            debayerParams.filter,
-                                            debayerParams.method);
+// Decode each band with its halo into a small interleaved RGB buffer, then copy its own rows
+// into the FITS planes. Downsample packs its output at the start of the buffer, and AHD lazily
+// initializes shared tables without locking, so both still decode the whole image at once.
+template <typename T, typename Decode>
+dc1394error_t debayerInBands(const T *bayer, T *planes, uint32_t width, uint32_t height, uint32_t planeSize,
+                             int planeCount, dc1394bayer_method_t method, Decode decode)
+{
+    const bool banded = method != DC1394_BAYER_METHOD_DOWNSAMPLE && method != DC1394_BAYER_METHOD_AHD;
+    const uint32_t minBandRows = banded ? DebayerMinBandRows : height;
+    return debayerRowBands(height, [ = ](uint32_t first, uint32_t last)
+    {
+        const uint32_t top = first > DebayerHaloRows ? first - DebayerHaloRows : 0;
+        const uint32_t bottom = qMin(height, last + DebayerHaloRows);
+
+        std::unique_ptr<T[]> rgb(new (std::nothrow) T[static_cast<size_t>(bottom - top) * width * 3]());
+        if (!rgb)
+            return DC1394_MEMORY_ALLOCATION_FAILURE;
+
+        const dc1394error_t error = decode(bayer + static_cast<size_t>(top) * width, rgb.get(), width, bottom - top);
+        if (error != DC1394_SUCCESS)
+            return error;
+
+        // Data in R1G1B1, we need to copy them into 3 layers for FITS
+        const T *source = rgb.get() + static_cast<size_t>(first - top) * width * 3;
+        const size_t offset = static_cast<size_t>(first) * width;
+        const size_t count = static_cast<size_t>(last - first) * width;
+        for (int channel = 0; channel < planeCount; channel++)
+        {
+            T *plane = planes + static_cast<size_t>(channel) * planeSize + offset;
+            for (size_t i = 0; i < count; i++)
+                plane[i] = source[i * 3 + channel];
+        }
+        return DC1394_SUCCESS;
+    }, minBandRows);
+}
 
-    if (error_code != DC1394_SUCCESS)
-    {
-        m_LastError = i18n("Debayer failed (%1)", error_code);
-        m_Statistics.channels = 1;
-        delete[] destinationBuffer;
-        return false;
-    }
+// Pointers to the planes receiving one Bayer row. A row only holds green and one of red or
+// blue, named here the row color. The other color is only present on the rows above and below.
+template <typename T>
+struct BilinearPlanes
+{
+    T *rowColor;
+    T *otherColor;
+    T *green;
+};
 
-    if (m_ImageBufferSize != rgb_size)
+// Bilinear interpolation of pixels [x, end) of a row, the same arithmetic as dc1394_bayer_Bilinear.
+// Green pixels take the row color from their left and right neighbours and the other color from
+// above and below, the others take green from the 4 direct neighbours and the other color from
+// the 4 diagonal ones.
+template <typename T>
+void bilinearRowScalar(const T *up, const T *row, const T *down, uint32_t x, uint32_t end, bool greenEven,
+                       const BilinearPlanes<T> &planes)
+{
+    for (; x < end; x++)
     {
-        delete[] m_ImageBuffer;
-        try
+        const bool green = ((x & 1) == 0) == greenEven;
+        T rowColor, otherColor, greenValue;
+        if (green)
         {
-            m_ImageBuffer = new uint8_t[rgb_size];
+            rowColor = static_cast<T>((row[x - 1] + row[x + 1] + 1) >> 1);
+            otherColor = static_cast<T>((up[x] + down[x] + 1) >> 1);
+            greenValue = row[x];
         }
-        catch (const std::bad_alloc &e)
+        else
         {
-            delete[] destinationBuffer;
-            logOOMError(rgb_size);
-            m_LastError = i18n("Unable to allocate memory for temporary bayer buffer: %1", e.what());
-            return false;
+            rowColor = row[x];
+            otherColor = static_cast<T>((up[x - 1] + up[x + 1] + down[x - 1] + down[x + 1] + 2) >> 2);
+            greenValue = static_cast<T>((up[x] + down[x] + row[x - 1] + row[x + 1] + 2) >> 2);
         }
-
-        m_ImageBufferSize = rgb_size;
+        if (planes.rowColor)
+            planes.rowColor[x] = rowColor;
+        if (planes.otherColor)
+            planes.otherColor[x] = otherColor;
+        if (planes.green)
+            planes.green[x] = greenValue;
     }
+}
+
+#if defined(KSTARS_FITS_SIMD_X86)
+__attribute__((target("avx2")))
+inline __m256i bilinearAverage2(__m256i a, __m256i b, uint8_t)
+{
+    return _mm256_avg_epu8(a, b);
+}
 
-    auto bayered_buffer = reinterpret_cast<uint8_t *>(m_ImageBuffer);
+__attribute__((target("avx2")))
+inline __m256i bilinearAverage2(__m256i a, __m256i b, uint16_t)
+{
+    return _mm256_avg_epu16(a, b);
+}
 
-    // Data in R1G1B1, we need to copy them into 3 layers for FITS
+__attribute__((target("avx2")))
+inline __m256i bilinearAverage4(__m256i a, __m256i b, __m256i c, __m256i d, uint8_t)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i two = _mm256_set1_epi16(2);
+    __m256i lo = _mm256_add_epi16(_mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero)),
+                                  _mm256_add_epi16(_mm256_unpacklo_epi8(c, zero), _mm256_unpacklo_epi8(d, zero)));
+    __m256i hi = _mm256_add_epi16(_mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero)),
+                                  _mm256_add_epi16(_mm256_unpackhi_epi8(c, zero), _mm256_unpackhi_epi8(d, zero)));
+    lo = _mm256_srli_epi16(_mm256_add_epi16(lo, two), 2);
+    hi = _mm256_srli_epi16(_mm256_add_epi16(hi, two), 2);
+    return _mm256_packus_epi16(lo, hi);
+}
 
-    uint8_t * rBuff = bayered_buffer;
-    uint8_t * gBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height);
-    uint8_t * bBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height * 2);
+__attribute__((target("avx2")))
+inline __m256i bilinearAverage4(__m256i a, __m256i b, __m256i c, __m256i d, uint16_t)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i two = _mm256_set1_epi32(2);
+    __m256i lo = _mm256_add_epi32(_mm256_add_epi32(_mm256_unpacklo_epi16(a, zero), _mm256_unpacklo_epi16(b, zero)),
+                                  _mm256_add_epi32(_mm256_unpacklo_epi16(c, zero), _mm256_unpacklo_epi16(d, zero)));
+    __m256i hi = _mm256_add_epi32(_mm256_add_epi32(_mm256_unpackhi_epi16(a, zero), _mm256_unpackhi_epi16(b, zero)),
+                                  _mm256_add_epi32(_mm256_unpackhi_epi16(c, zero), _mm256_unpackhi_epi16(d, zero)));
+    lo = _mm256_srli_epi32(_mm256_add_epi32(lo, two), 2);
+    hi = _mm256_srli_epi32(_mm256_add_epi32(hi, two), 2);
+    return _mm256_packus_epi32(lo, hi);
+}
 
-    int imax = m_Statistics.samples_per_channel * 3 - 3;
-    for (int i = 0; i <= imax; i += 3)
-    {
-        *rBuff++ = bayer_destination_buffer[i];
-        *gBuff++ = bayer_destination_buffer[i + 1];
-        *bBuff++ = bayer_destination_buffer[i + 2];
-    }
+template <typename T>
+__attribute__((target("avx2")))
+inline __m256i bilinearLoad(const T *pointer)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pointer));
+}
 
-    // TODO Maybe all should be treated the same
-    // Doing single channel saves lots of memory though for non-essential
-    // frames
-    m_Statistics.channels = (m_Mode == FITS_NORMAL || m_Mode == FITS_CALIBRATE) ? 3 : 1;
-    m_Statistics.dataType = TBYTE;
-    delete[] destinationBuffer;
-    return true;
+// Vectorized body of bilinearRowScalar, x must be even. Returns the first pixel left to do.
+template <typename T>
+__attribute__((target("avx2")))
+uint32_t bilinearRowAVX2(const T *up, const T *row, const T *down, uint32_t x, uint32_t end, bool greenEven,
+                         const BilinearPlanes<T> &planes)
+{
+    constexpr uint32_t lanes = 32 / sizeof(T);
+    // All bits set on the lanes holding green pixels.
+    const __m256i evenLanes = sizeof(T) == 1 ? _mm256_set1_epi16(0x00FF) : _mm256_set1_epi32(0x0000FFFF);
+    const __m256i greenMask = greenEven ? evenLanes : _mm256_xor_si256(evenLanes, _mm256_set1_epi8(-1));
+
+    for (; x + lanes <= end; x += lanes)
+    {
+        const __m256i center = bilinearLoad(row + x);
+        const __m256i left = bilinearLoad(row + x - 1);
+        const __m256i right = bilinearLoad(row + x + 1);
+        const __m256i above = bilinearLoad(up + x);
+        const __m256i below = bilinearLoad(down + x);
+
+        const __m256i horizontal = bilinearAverage2(left, right, T());
+        const __m256i vertical = bilinearAverage2(above, below, T());
+        const __m256i diagonal = bilinearAverage4(bilinearLoad(up + x - 1), bilinearLoad(up + x + 1), bilinearLoad(down + x - 1),
+                                 bilinearLoad(down + x + 1), T());
+        const __m256i cross = bilinearAverage4(above, below, left, right, T());
+
+        if (planes.rowColor)
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(planes.rowColor + x),
+                                _mm256_blendv_epi8(center, horizontal, greenMask));
+        if (planes.otherColor)
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(planes.otherColor + x),
+                                _mm256_blendv_epi8(diagonal, vertical, greenMask));
+        if (planes.green)
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(planes.green + x),
+                                _mm256_blendv_epi8(cross, center, greenMask));
+    }
+    return x;
 }
+#endif
 
-bool FITSData::debayer_16bit()
+#if defined(KSTARS_FITS_SIMD_NEON)
+inline uint16x8_t bilinearAverage4(uint16x8_t a, uint16x8_t b, uint16x8_t c, uint16x8_t d)
 {
-    dc1394error_t error_code;
+    const uint32x4_t lo = vaddq_u32(vaddl_u16(vget_low_u16(a), vget_low_u16(b)), vaddl_u16(vget_low_u16(c),
+                                    vget_low_u16(d)));
+    const uint32x4_t hi = vaddq_u32(vaddl_u16(vget_high_u16(a), vget_high_u16(b)), vaddl_u16(vget_high_u16(c),
+                                    vget_high_u16(d)));
+    return vcombine_u16(vrshrn_n_u32(lo, 2), vrshrn_n_u32(hi, 2));
+}
 
-    uint32_t rgb_size = m_Statistics.samples_per_channel * 3 * m_Statistics.bytesPerPixel;
-    uint8_t *destinationBuffer = nullptr;
-    try
-    {
-        destinationBuffer = new uint8_t[rgb_size];
-    }
-    catch (const std::bad_alloc &e)
+inline uint8x16_t bilinearAverage4(uint8x16_t a, uint8x16_t b, uint8x16_t c, uint8x16_t d)
+{
+    const uint16x8_t lo = vaddq_u16(vaddl_u8(vget_low_u8(a), vget_low_u8(b)), vaddl_u8(vget_low_u8(c), vget_low_u8(d)));
+    const uint16x8_t hi = vaddq_u16(vaddl_u8(vget_high_u8(a), vget_high_u8(b)), vaddl_u8(vget_high_u8(c),
+                                    vget_high_u8(d)));
+    return vcombine_u8(vrshrn_n_u16(lo, 2), vrshrn_n_u16(hi, 2));
+}
+
+uint32_t bilinearRowNEON(const uint16_t *up, const uint16_t *row, const uint16_t *down, uint32_t x, uint32_t end,
+                         bool greenEven, const BilinearPlanes<uint16_t> &planes)
+{
+    const uint16x8_t evenLanes = vreinterpretq_u16_u32(vdupq_n_u32(0x0000FFFF));
+    const uint16x8_t greenMask = greenEven ? evenLanes : vmvnq_u16(evenLanes);
+
+    for (; x + 8 <= end; x += 8)
+    {
+        const uint16x8_t center = vld1q_u16(row + x), left = vld1q_u16(row + x - 1), right = vld1q_u16(row + x + 1);
+        const uint16x8_t above = vld1q_u16(up + x), below = vld1q_u16(down + x);
+        const uint16x8_t diagonal = bilinearAverage4(vld1q_u16(up + x - 1), vld1q_u16(up + x + 1),
+                                    vld1q_u16(down + x - 1), vld1q_u16(down + x + 1));
+        if (planes.rowColor)
+            vst1q_u16(planes.rowColor + x, vbslq_u16(greenMask, vrhaddq_u16(left, right), center));
+        if (planes.otherColor)
+            vst1q_u16(planes.otherColor + x, vbslq_u16(greenMask, vrhaddq_u16(above, below), diagonal));
+        if (planes.green)
+            vst1q_u16(planes.green + x, vbslq_u16(greenMask, center, bilinearAverage4(above, below, left, right)));
+    }
+    return x;
+}
+
+uint32_t bilinearRowNEON(const uint8_t *up, const uint8_t *row, const uint8_t *down, uint32_t x, uint32_t end,
+                         bool greenEven, const BilinearPlanes<uint8_t> &planes)
+{
+    const uint8x16_t evenLanes = vreinterpretq_u8_u16(vdupq_n_u16(0x00FF));
+    const uint8x16_t greenMask = greenEven ? evenLanes : vmvnq_u8(evenLanes);
+
+    for (; x + 16 <= end; x += 16)
+    {
+        const uint8x16_t center = vld1q_u8(row + x), left = vld1q_u8(row + x - 1), right = vld1q_u8(row + x + 1);
+        const uint8x16_t above = vld1q_u8(up + x), below = vld1q_u8(down + x);
+        const uint8x16_t diagonal = bilinearAverage4(vld1q_u8(up + x - 1), vld1q_u8(up + x + 1),
+                                    vld1q_u8(down + x - 1), vld1q_u8(down + x + 1));
+        if (planes.rowColor)
+            vst1q_u8(planes.rowColor + x, vbslq_u8(greenMask, vrhaddq_u8(left, right), center));
+        if (planes.otherColor)
+            vst1q_u8(planes.otherColor + x, vbslq_u8(greenMask, vrhaddq_u8(above, below), diagonal));
+        if (planes.green)
+            vst1q_u8(planes.green + x, vbslq_u8(greenMask, center, bilinearAverage4(above, below, left, right)));
+    }
+    return x;
+}
+#endif
+
+// Bilinear debayer straight from the Bayer buffer into the FITS planes, rows are independent so
+// bands need no halo. Output matches dc1394_bayer_Bilinear, with black borders. A null plane
+// pointer skips that color.
+template <typename T>
+dc1394error_t debayerBilinear(const T *bayer, T *red, T *green, T *blue, uint32_t width, uint32_t height,
+                              dc1394color_filter_t tile)
+{
+    if ((tile > DC1394_COLOR_FILTER_MAX) || (tile < DC1394_COLOR_FILTER_MIN))
+        return DC1394_INVALID_COLOR_FILTER;
+
+    // Phase of the first interpolated row, as in bayer.c.
+    const bool firstRowBlue = tile != DC1394_COLOR_FILTER_BGGR && tile != DC1394_COLOR_FILTER_GBRG;
+    const bool firstRowStartsGreen = tile == DC1394_COLOR_FILTER_GBRG || tile == DC1394_COLOR_FILTER_GRBG;
+
+    return debayerRowBands(height, [ = ](uint32_t first, uint32_t last)
     {
-        logOOMError(rgb_size);
-        m_LastError = i18n("Unable to allocate memory for temporary bayer buffer: %1", e.what());
-        return false;
-    }
+        for (uint32_t y = first; y < last; y++)
+        {
+            const size_t offset = static_cast<size_t>(y) * width;
+            T * const rowPlanes[3] = { red ? red + offset : nullptr, green ? green + offset : nullptr,
+                                       blue ? blue + offset : nullptr
+                                     };
+            if (y == 0 || y == height - 1)
+            {
+                for (T *plane : rowPlanes)
+                    if (plane)
+                        std::fill(plane, plane + width, 0);
+                continue;
+            }
+
+            const bool odd = (y - 1) % 2;
+            // Bayer rows alternate, e.g. RGRG then GBGB.
+            const bool rowBlue = firstRowBlue != odd;
+            const bool greenEven = firstRowStartsGreen == odd;
+            const BilinearPlanes<T> planes { rowPlanes[rowBlue ? 2 : 0], rowPlanes[rowBlue ? 0 : 2], rowPlanes[1] };
+            for (T *plane : rowPlanes)
+                if (plane)
+                    plane[0] = plane[width - 1] = 0;
+
+            const T *row = bayer + offset;
+            uint32_t x = 1;
+            bilinearRowScalar(row - width, row, row + width, x, 2, greenEven, planes);
+            x = 2;
+#if defined(KSTARS_FITS_SIMD_X86)
+            if (cpuHasAVX2())
+                x = bilinearRowAVX2(row - width, row, row + width, x, width - 1, greenEven, planes);
+#elif defined(KSTARS_FITS_SIMD_NEON)
+            x = bilinearRowNEON(row - width, row, row + width, x, width - 1, greenEven, planes);
+#endif
+            bilinearRowScalar(row - width, row, row + width, x, width - 1, greenEven, planes);
+        }
+        return DC1394_SUCCESS;
+    });
+}
+}
+
+bool FITSData::debayer_8bit()
+{
+    return debayer<uint8_t>();
+}
+
+bool FITSData::debayer_16bit()
+{
+    return debayer<uint16_t>();
+}
 
-    auto * bayer_source_buffer      = reinterpret_cast<uint16_t *>(m_ImageBuffer);
-    auto * bayer_destination_buffer = reinterpret_cast<uint16_t *>(destinationBuffer);
+template <typename T>
+bool FITSData::debayer()
+{
+    // TODO Maybe all should be treated the same
+    // Doing single channel saves lots of memory though for non-essential
+    // frames
+    const bool fullColor = m_Mode == FITS_NORMAL || m_Mode == FITS_CALIBRATE;
+    const int planeCount = fullColor ? 3 : 1;
+    const uint32_t planeSize = m_Statistics.samples_per_channel;
+    const uint32_t rgb_size = planeSize * planeCount * m_Statistics.bytesPerPixel;
 
-    if (bayer_destination_buffer == nullptr)
+    uint8_t *destination = ImageBufferPool::instance().acquire(rgb_size);
+    if (destination == nullptr)
     {
         logOOMError(rgb_size);
         m_LastError = i18n("Unable to allocate memory for temporary bayer buffer.");
         return false;
     }
 
-    int ds1394_height = m_Statistics.height;
-    auto dc1394_source = bayer_source_buffer;
+    auto destinationBuffer = reinterpret_cast<T *>(destination);
+    const uint32_t width = m_Statistics.width;
+    uint32_t ds1394_height = m_Statistics.height;
+    auto dc1394_source = reinterpret_cast<const T *>(m_ImageBuffer);
 
     if (debayerParams.offsetY == 1)
     {
-        dc1394_source += m_Statistics.width;
+        dc1394_source += width;
         ds1394_height--;
     }
     // offsetX == 1 is handled in checkDebayer() and should be 0 here.
 
-    error_code = dc1394_bayer_decoding_16bit(dc1394_source, bayer_destination_buffer, m_Statistics.width, ds1394_height,
-                 debayerParams.filter,
-                 debayerParams.method, 16);
-
-    if (error_code != DC1394_SUCCESS)
+    dc1394error_t error_code;
+    // Frames that only keep one channel, e.g. for focusing or guiding, are only previews and the
+    // interpolated red plane is all they need.
+    if ((!fullColor || debayerParams.method == DC1394_BAYER_METHOD_BILINEAR) && width >= 3 && ds1394_height >= 3)
     {
-        m_LastError = i18n("Debayer failed (%1)");
-        m_Statistics.channels = 1;
-        delete[] destinationBuffer;
-        return false;
+        error_code = debayerBilinear(dc1394_source, destinationBuffer,
+                                     fullColor ? destinationBuffer + planeSize : nullptr,
+                                     fullColor ? destinationBuffer + 2 * planeSize : nullptr,
+                                     width, ds1394_height, debayerParams.filter);
     }
-
-    if (m_ImageBufferSize != rgb_size)
+    else
     {
-        delete[] m_ImageBuffer;
-        try
-        {
-            m_ImageBuffer = new uint8_t[rgb_size];
-        }
-        catch (const std::bad_alloc &e)
+        const BayerParams params = debayerParams;
+        error_code = debayerInBands(dc1394_source, destinationBuffer, width, ds1394_height, planeSize, planeCount,
+                                    params.method, [params](const T * bayer, T * rgb, uint32_t sx, uint32_t sy)
         {
-            logOOMError(rgb_size);
-            delete[] destinationBuffer;
-            m_LastError = i18n("Unable to allocate memory for temporary bayer buffer: %1", e.what());
-            return false;
-        }
-
-        m_ImageBufferSize = rgb_size;
+            if constexpr (std::is_same<T, uint8_t>::value)
+                return dc1394_bayer_decoding_8bit(bayer, rgb, sx, sy, params.filter, params.method);
+            else
+                return dc1394_bayer_decoding_16bit(bayer, rgb, sx, sy, params.filter, params.method, 16);
+        });
     }
 
-    auto bayered_buffer = reinterpret_cast<uint16_t *>(m_ImageBuffer);
-
-    // Data in R1G1B1, we need to copy them into 3 layers for FITS
-
-    uint16_t * rBuff = bayered_buffer;
-    uint16_t * gBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height);
-    uint16_t * bBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height * 2);
-
-    int imax = m_Statistics.samples_per_channel * 3 - 3;
-    for (int i = 0; i <= imax; i += 3)
+    if (error_code != DC1394_SUCCESS)
     {
-        *rBuff++ = bayer_destination_buffer[i];
-        *gBuff++ = bayer_destination_buffer[i + 1];
-        *bBuff++ = bayer_destination_buffer[i + 2];
+        m_LastError = i18n("Debayer failed (%1)", error_code);
+        m_Statistics.channels = 1;
+        ImageBufferPool::instance().release(destination);
+        return false;
     }
 
-    m_Statistics.channels = (m_Mode == FITS_NORMAL || m_Mode == FITS_CALIBRATE) ? 3 : 1;
-    m_Statistics.dataType = TUSHORT;
-    delete[] destinationBuffer;
+    ImageBufferPool::instance().release(m_ImageBuffer);
+    m_ImageBuffer = destination;
+    m_ImageBufferSize = rgb_size;
+
+    m_Statistics.channels = planeCount;
+    m_Statistics.dataType = std::is_same<T, uint8_t>::value ? TBYTE : TUSHORT;
     return true;
 }
 
@@ -3956,6 +5119,23 @@ double FITSData::getADU() const
     return (adu / static_cast<double>(m_Statistics.channels));
 }
 
+ProcessingLanes::Lane FITSData::lane() const
+{
+    switch (m_Mode)
+    {
+        case FITS_GUIDE:
+            return ProcessingLanes::GUIDE;
+        case FITS_FOCUS:
+            return ProcessingLanes::FOCUS;
+        case FITS_NORMAL:
+        case FITS_CALIBRATE:
+        case FITS_ALIGN:
+            return ProcessingLanes::CAPTURE;
+        default:
+            return ProcessingLanes::DISPLAY;
+    }
+}
+
 QString FITSData::getLastError() const
 {
     return m_LastError;
@@ -4410,7 +5590,7 @@ template <typename T> void FITSData::constructHistogramInternal()
 
     for (int n = 0; n < m_Statistics.channels; n++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        futures.append(ProcessingLanes::run(lane(), [ = ]()
         {
             for (int i = 0; i < m_HistogramBinCount; i++)
                 m_HistogramIntensity[n][i] = m_Statistics.min[n] + (m_HistogramBinWidth[n] * i);
@@ -4419,16 +5599,28 @@ template <typename T> void FITSData::constructHistogramInternal()
 
     for (int n = 0; n < m_Statistics.channels; n++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        // Re-bin the full resolution counts gathered by calculateMedian if we have them.
+        if constexpr (FineHistogram::isSupported<T>())
         {
-            uint32_t offset = n * samples;
-
-            for (uint32_t i = 0; i < samples; i += sampleBy)
+            if (m_FineHistogramConstructed && n < m_FineHistogram.size())
             {
-                int32_t id = histogramBinInternal<T>(buffer[i + offset], n);
-                m_HistogramFrequency[n][id] += sampleBy;
+                futures.append(ProcessingLanes::run(lane(), [ = ]()
+                {
+                    const QVector<uint32_t> &fine = m_FineHistogram[n];
+                    for (int value = 0; value < fine.size(); value++)
+                    {
+                        if (fine[value] > 0)
+                            m_HistogramFrequency[n][histogramBinInternal<T>(static_cast<T>(value), n)] +=
+                                static_cast<double>(fine[value]) * m_StatisticsRowStep;
+                    }
+                }));
+                continue;
             }
-        }));
+        }
+
+        // Spreads over the thread pool on its own.
+        HistogramBins::accumulate(buffer + static_cast<size_t>(n) * samples, samples, sampleBy, m_Statistics.min[n],
+                                  m_HistogramBinWidth[n], m_HistogramBinCount, m_HistogramFrequency[n], lane());
     }
 
     for (QFuture<void> future : futures)
@@ -4438,7 +5630,7 @@ template <typename T> void FITSData::constructHistogramInternal()
 
     for (int n = 0; n < m_Statistics.channels; n++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        futures.append(ProcessingLanes::run(lane(), [ = ]()
         {
             uint32_t accumulator = 0;
             for (int i = 0; i < m_HistogramBinCount; i++)
@@ -24,6 +24,7 @@
 #include "fitscommon.h"
 #include "fitsstardetector.h"
 #include "auxiliary/imagemask.h"
+#include "auxiliary/processinglanes.h"
 
 #ifdef WIN32
 // This header must be included before fitsio.h to avoid compiler errors with Visual Studio
@@ -113,6 +114,14 @@ class FITSData : public QObject
          */
         QFuture<bool> loadFromFile(const QString &inFilename);
 
+        /**
+         * @brief loadHeaderFromFile Read only the header of a FITS file, leaving its pixels on disk.
+         * @param inFilename Path to FITS file (or compressed fits.fz)
+         * @return bool indicating success or failure. On success the keywords are available through
+         * getRecords() and getRecordValue().
+         */
+        bool loadHeaderFromFile(const QString &inFilename);
+
         /**
          * @brief loadFITSFromMemory Loading FITS from memory buffer.
          * @param buffer The memory buffer containing the fits data.
@@ -176,6 +185,8 @@ class FITSData : public QObject
         {
             return m_Statistics.dataType;
         }
+        /** @return the lane the frame is processed in, after the module its mode is for */
+        ProcessingLanes::Lane lane() const;
         double getMin(uint8_t channel = 0, bool roi = false) const
         {
             return roi ?  m_ROIStatistics.min[channel] : m_Statistics.min[channel];
@@ -303,6 +314,14 @@ class FITSData : public QObject
             starCenters = centers;
         }
         QFuture<bool> findStars(StarAlgorithm algorithm = ALGORITHM_CENTROID, const QRect &trackingBox = QRect());
+        /**
+         * @brief areStarsFound Check whether the stars of the last findStars() can be reused.
+         * @return true if its detection is complete, and was run with this algorithm, tracking box and
+         * the current source extractor settings.
+         * @note This lets a caller watch the future of findStars() and later code pick up the results
+         * instead of detecting again.
+         */
+        bool areStarsFound(StarAlgorithm algorithm, const QRect &trackingBox = QRect()) const;
 
         void setSkyBackground(const SkyBackground &bg)
         {
@@ -320,9 +339,12 @@ class FITSData : public QObject
         {
             m_SourceExtractorSettings = settings;
         }
-        // Use SEP (Sextractor Library) to find stars
-        template <typename T>
-        void getFloatBuffer(float *buffer, int x, int y, int w, int h) const;
+        /**
+         * @brief getFloatBuffer Convert the samples of the first channel inside area to float, row after row.
+         * @param buffer receives area.width() * area.height() samples.
+         * @return false if area is empty or not inside the image.
+         */
+        bool getFloatBuffer(float *buffer, const QRect &area) const;
         //int findSEPStars(QList<Edge*> &, const int8_t &boundary = int8_t()) const;
 
         // filter all stars that are visible through the given mask
@@ -437,6 +459,35 @@ class FITSData : public QObject
         void getBayerParams(BayerParams *param);
         void setBayerParams(BayerParams *param);
 
+        /**
+         * @brief releaseImageBuffer Free the pixels and histograms of an image that can be read again
+         * from its file unchanged. The statistics and header stay.
+         * @return false if the image is not backed by such a file
+         */
+        bool releaseImageBuffer();
+        /**
+         * @brief restoreImageBuffer Read again the pixels freed by releaseImageBuffer(), this blocks.
+         */
+        bool restoreImageBuffer();
+        bool isImageBufferReleased() const
+        {
+            return m_ImageBufferReleased;
+        }
+
+        /**
+         * @brief setKeepMosaic Keep bayered frames loaded from now on as the raw mosaic instead of
+         * debayering them, for callers that only need a binned image of the frame.
+         */
+        void setKeepMosaic(bool keep)
+        {
+            m_KeepMosaic = keep;
+        }
+        /** @return true if the image buffer holds a Bayer mosaic that was not debayered */
+        bool isMosaic() const
+        {
+            return HasDebayer && m_KeepMosaic && m_Statistics.channels == 1;
+        }
+
         ////////////////////////////////////////////////////////////////////////////////////////
         ////////////////////////////////////////////////////////////////////////////////////////
         /// Public Histogram Functions
@@ -446,6 +497,7 @@ class FITSData : public QObject
         void resetHistogram()
         {
             m_HistogramConstructed = false;
+            m_FineHistogramConstructed = false;
         }
         double getHistogramBinWidth(int channel = 0)
         {
@@ -489,6 +541,17 @@ class FITSData : public QObject
         {
             return m_HistogramConstructed;
         }
+
+        // Full resolution histograms (one bin per ADU value, one vector per channel).
+        // Only available for 8 and 16 bit data once statistics are calculated.
+        bool isFineHistogramConstructed() const
+        {
+            return m_FineHistogramConstructed;
+        }
+        const QVector<QVector<uint32_t>> &getFineHistograms() const
+        {
+            return m_FineHistogram;
+        }
         void constructHistogram();
 
         ////////////////////////////////////////////////////////////////////////////////////////
@@ -539,11 +602,16 @@ class FITSData : public QObject
 #ifndef KSTARS_LITE
 #ifdef HAVE_WCSLIB
         bool searchObjects();
-        bool findObjectsInImage(SkyPoint startPoint, SkyPoint endPoint);
+        /**
+         * @brief findObjectsInImage Annotate the deep-sky objects in the image. The candidates are
+         * looked up in the trixels of the circle around the image center that holds the image edges,
+         * and all of them are projected to pixels in one call.
+         */
+        bool findObjectsInImage();
         bool findWCSBounds(double &minRA, double &maxRA, double &minDec, double &maxDec);
 #endif
 #endif
-        const QList<FITSSkyObject *> &getSkyObjects() const
+        const QVector<FITSSkyObject> &getSkyObjects() const
         {
             return m_SkyObjects;
         }
@@ -565,6 +633,14 @@ class FITSData : public QObject
          */
         static bool ImageToFITS(const QString &filename, const QString &format, QString &output);
 
+        /**
+         * @brief compressXISF Rewrite an XISF file with the codec and byte shuffling of the XISFCompression options.
+         * @param xisf content of the XISF file, as received from the camera
+         * @param compressed set to the compressed file
+         * @return false if compression is disabled or failed, then the original file should be written.
+         */
+        static bool compressXISF(const QByteArray &xisf, QByteArray &compressed);
+
         QString getLastError() const;
 
         static bool readableFilename(const QString &filename);
@@ -586,6 +662,10 @@ class FITSData : public QObject
 
     private:
         void loadCommon(const QString &inFilename);
+        // Map FITS files in memory so CFITSIO reads from the mapping and the pixels are decoded
+        // straight from the page cache. Returns an empty buffer if the file can't be mapped.
+        QByteArray mapFile();
+        void unmapFile();
         /**
          * @brief privateLoad Load an image (FITS, RAW, or images supported by Qt like jpeg, png).
          * @param Buffer pointer to image data. If buffer is emtpy, read from disk (m_Filename).
@@ -597,6 +677,14 @@ class FITSData : public QObject
         bool loadCanonicalImage(const QByteArray &buffer);
         // Load FITS images.
         bool loadFITSImage(const QByteArray &buffer, const bool isCompressed = false);
+        // Copy FITS pixels straight from an in-memory FITS buffer into m_ImageBuffer, bypassing CFITSIO
+        // intermediate buffers. Returns false if the data layout requires CFITSIO to convert it.
+        bool readFITSImageFromMemory(const QByteArray &buffer, long nelements);
+        // Unpack only the header of the first tile compressed image in buffer into m_PackBuffer.
+        // Returns the HDU of the compressed image, or 0 if the tiles can't be decompressed in parallel.
+        int unpackCompressedHeader(const QByteArray &buffer, size_t *size);
+        // Decompress the tiles of the compressed image HDU of buffer in parallel row bands into m_ImageBuffer.
+        bool readCompressedImage(const QByteArray &buffer, int hdu, long nelements);
         // Load XISF images.
         bool loadXISFImage(const QByteArray &buffer);
         // Save XISF images.
@@ -605,10 +693,20 @@ class FITSData : public QObject
         bool loadRAWImage(const QByteArray &buffer);
 
         void rotWCSFITS(int angle, int mirror);
-        void calculateMinMax(bool refresh = false, bool roi = false);
+        // Read statistics stored in the FITS header. Returns true if the keywords were found.
+        bool readMinMaxKeywords();
+        bool readStdDevKeywords();
+        // Row step for the full frame statistics. Guide and focus frames are sampled, others are exact.
+        uint32_t statisticsRowStep() const;
+        // Calculate min, max, mean and standard deviation in a single pass.
+        void calculateFusedStats(bool roi = false);
         void calculateMedian(bool refresh = false, bool roi = false);
         bool checkDebayer();
         void readWCSKeys();
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+        // World coordinates in degrees of the edge pixels, projected in one call. Those that fail are left out.
+        QVector<QPointF> wcsEdges() const;
+#endif
 
         // Record last FITS error
         void recordLastError(int errorCode);
@@ -630,23 +728,21 @@ class FITSData : public QObject
         void applyFilter(FITSScale type, uint8_t *targetImage, QVector<double> * min = nullptr, QVector<double> * max = nullptr);
 
         template <typename T>
-        void calculateMinMax(bool roi = false);
+        void calculateFusedStats(bool roi = false);
         template <typename T>
-        void calculateMedian(bool roi = false);
-
+        void calculateRoiFusedStats();
         template <typename T>
-        QPair<T, T> getParitionMinMax(uint32_t start, uint32_t stride, bool roi);
+        void calculateMedian(bool roi = false);
 
-        /* Calculate the Gaussian blur matrix and apply it to the image using the convolution filter */
-        QVector<double> createGaussianKernel(int size, double sigma);
+        /* Calculate the 1D Gaussian kernel and apply it to all channels along rows then columns */
+        QVector<float> createGaussianKernel(int size, double sigma);
         template <typename T>
-        void convolutionFilter(const QVector<double> &kernel, int kernelSize);
+        void separableFilter(const QVector<float> &kernel);
         template <typename T>
         void gaussianBlur(int kernelSize, double sigma);
 
-        /* Calculate running average & standard deviation */
         template <typename T>
-        void calculateStdDev( bool roi = false );
+        void convertToFloat(float *buffer, const QRect &area) const;
 
         template <typename T>
         void convertToQImage(double dataMin, double dataMax, double scale, double zero, QImage &image);
@@ -666,10 +762,8 @@ class FITSData : public QObject
         uint8_t *m_ImageBuffer { nullptr };
         /// Above buffer size in bytes
         uint32_t m_ImageBufferSize { 0 };
-        /// Image Buffer if Selection is to be done
-        uint8_t *m_ImageRoiBuffer { nullptr };
-        /// Above buffer size in bytes
-        uint32_t m_ImageRoiBufferSize { 0 };
+        /// Selection in image pixels, its statistics are computed in place from the image buffer
+        QRect m_ROIRect;
         /// Is this a temporary file or one loaded from disk?
         bool m_isTemporary { false };
         /// is this file compress (.fits.fz)?
@@ -682,8 +776,15 @@ class FITSData : public QObject
         bool HasWCS { false };        /// Do we have WCS keywords in this FITS data?
         /// Is the image debayarable?
         bool HasDebayer { false };
+        /// Are bayered images left undebayered when loaded?
+        bool m_KeepMosaic { false };
+        /// Were the pixels freed until the image is needed again?
+        bool m_ImageBufferReleased { false };
         /// Buffer to hold fpack uncompressed data
         uint8_t *m_PackBuffer {nullptr};
+        /// Memory mapped image file, CFITSIO reads from it as long as fptr is open
+        QFile m_MappedFile;
+        uchar *m_MappedData {nullptr};
 
         /// Our very own file name
         QString m_Filename, m_compressedFilename, m_Extension;
@@ -727,7 +828,7 @@ class FITSData : public QObject
         // A list of header records
         QList<Record> m_HeaderRecords;
 
-        QList<FITSSkyObject *> m_SkyObjects;
+        QVector<FITSSkyObject> m_SkyObjects;
         bool m_ObjectsSearched {false};
 
         QString m_LastError;
@@ -744,6 +845,10 @@ class FITSData : public QObject
         uint16_t m_HistogramBinCount { 0 };
         double m_JMIndex { 1 };
         bool m_HistogramConstructed { false };
+        QVector<QVector<uint32_t>> m_FineHistogram;
+        bool m_FineHistogramConstructed { false };
+        /// Full frame statistics only looked at every m_StatisticsRowStep-th row, see statisticsRowStep().
+        uint32_t m_StatisticsRowStep { 1 };
 
         ////////////////////////////////////////////////////////////////////////////////////////
         ////////////////////////////////////////////////////////////////////////////////////////
@@ -754,6 +859,9 @@ class FITSData : public QObject
         SkyBackground m_SkyBackground;
         // Detector Settings
         QVariantMap m_SourceExtractorSettings;
+        // Settings and tracking box of the last star detection
+        QVariantMap m_StarFindSettings;
+        QRect m_StarFindBox;
         QFuture<bool> m_StarFindFuture;
         QScopedPointer<FITSStarDetector, QScopedPointerDeleteLater> m_StarDetector;
 
@@ -25,28 +25,28 @@ QFuture<bool> FITSGradientDetector::findSources(const QRect &boundary)
 
         case TBYTE:
         default:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<uint8_t>, boundary);
+            return findInLane(lane(), this, &FITSGradientDetector::findSources<uint8_t>, boundary);
 
         case TSHORT:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<int16_t>, boundary);
+            return findInLane(lane(), this, &FITSGradientDetector::findSources<int16_t>, boundary);
 
         case TUSHORT:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<uint16_t>, boundary);
+            return findInLane(lane(), this, &FITSGradientDetector::findSources<uint16_t>, boundary);
 
         case TLONG:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<int32_t>, boundary);
+            return findInLane(lane(), this, &FITSGradientDetector::findSources<int32_t>, boundary);
 
         case TULONG:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<uint16_t>, boundary);
+            return findInLane(lane(), this, &FITSGradientDetector::findSources<uint16_t>, boundary);
 
         case TFLOAT:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<float>, boundary);
+            return findInLane(lane(), this, &FITSGradientDetector::findSources<float>, boundary);
 
         case TLONGLONG:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<int64_t>, boundary);
+            return findInLane(lane(), this, &FITSGradientDetector::findSources<int64_t>, boundary);
 
         case TDOUBLE:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<double>, boundary);
+            return findInLane(lane(), this, &FITSGradientDetector::findSources<double>, boundary);
     }
 }
 
@@ -298,75 +298,87 @@ void FITSGradientDetector::sobel(FITSData const *data, QVector<float> &gradient,
     gradient.resize(stats.samples_per_channel);
     direction.resize(stats.samples_per_channel);
 
-    for (int y = 0; y < stats.height; y++)
+    const T * image       = reinterpret_cast<T const *>(data->getImageBuffer());
+    float * gradientData  = gradient.data();
+    float * directionData = direction.data();
+
+    // Each band of rows only reads the image and writes its own rows, so they are all done at once
+    QVector<int> bands;
+    for (int y = 0; y < stats.height; y += ROW_BAND_HEIGHT)
+        bands.append(y);
+
+    ProcessingLanes::blockingMap(lane(), bands, [&](int &band)
     {
-        size_t yOffset    = y * stats.width;
-        const T * grayLine = reinterpret_cast<T const *>(data->getImageBuffer()) + yOffset;
+        for (int y = band; y < qMin(band + ROW_BAND_HEIGHT, stats.height); y++)
+        {
+            size_t yOffset    = y * stats.width;
+            const T * grayLine = image + yOffset;
 
-        const T * grayLine_m1 = y < 1 ? grayLine : grayLine - stats.width;
-        const T * grayLine_p1 = y >= stats.height - 1 ? grayLine : grayLine + stats.width;
+            const T * grayLine_m1 = y < 1 ? grayLine : grayLine - stats.width;
+            const T * grayLine_p1 = y >= stats.height - 1 ? grayLine : grayLine + stats.width;
 
-        float * gradientLine  = gradient.data() + yOffset;
-        float * directionLine = direction.data() + yOffset;
+            float * gradientLine  = gradientData + yOffset;
+            float * directionLine = directionData + yOffset;
 
-        for (int x = 0; x < stats.width; x++)
-        {
-            int x_m1 = x < 1 ? x : x - 1;
-            int x_p1 = x >= stats.width - 1 ? x : x + 1;
-
-            int gradX = grayLine_m1[x_p1] + 2 * grayLine[x_p1] + grayLine_p1[x_p1] - grayLine_m1[x_m1] -
-                        2 * grayLine[x_m1] - grayLine_p1[x_m1];
-
-            int gradY = grayLine_m1[x_m1] + 2 * grayLine_m1[x] + grayLine_m1[x_p1] - grayLine_p1[x_m1] -
-                        2 * grayLine_p1[x] - grayLine_p1[x_p1];
-
-            gradientLine[x] = qAbs(gradX) + qAbs(gradY);
-
-            /* Gradient directions are classified in 4 possible cases
-             *
-             * dir 0
-             *
-             * x x x
-             * - - -
-             * x x x
-             *
-             * dir 1
-             *
-             * x x /
-             * x / x
-             * / x x
-             *
-             * dir 2
-             *
-             * \ x x
-             * x \ x
-             * x x \
-             *
-             * dir 3
-             *
-             * x | x
-             * x | x
-             * x | x
-             */
-            if (gradX == 0 && gradY == 0)
-                directionLine[x] = 0;
-            else if (gradX == 0)
-                directionLine[x] = 3;
-            else
+            for (int x = 0; x < stats.width; x++)
             {
-                qreal a = 180. * atan(qreal(gradY) / gradX) / M_PI;
-
-                if (a >= -22.5 && a < 22.5)
+                int x_m1 = x < 1 ? x : x - 1;
+                int x_p1 = x >= stats.width - 1 ? x : x + 1;
+
+                int gradX = grayLine_m1[x_p1] + 2 * grayLine[x_p1] + grayLine_p1[x_p1] - grayLine_m1[x_m1] -
+                            2 * grayLine[x_m1] - grayLine_p1[x_m1];
+
+                int gradY = grayLine_m1[x_m1] + 2 * grayLine_m1[x] + grayLine_m1[x_p1] - grayLine_p1[x_m1] -
+                            2 * grayLine_p1[x] - grayLine_p1[x_p1];
+
+                gradientLine[x] = qAbs(gradX) + qAbs(gradY);
+
+                /* Gradient directions are classified in 4 possible cases
+                 *
+                 * dir 0
+                 *
+                 * x x x
+                 * - - -
+                 * x x x
+                 *
+                 * dir 1
+                 *
+                 * x x /
+                 * x / x
+                 * / x x
+                 *
+                 * dir 2
+                 *
+                 * \ x x
+                 * x \ x
+                 * x x \
+                 *
+                 * dir 3
+                 *
+                 * x | x
+                 * x | x
+                 * x | x
+                 */
+                if (gradX == 0 && gradY == 0)
                     directionLine[x] = 0;
-                else if (a >= 22.5 && a < 67.5)
-                    directionLine[x] = 2;
-                else if (a >= -67.5 && a < -22.5)
-                    directionLine[x] = 1;
-                else
+                else if (gradX == 0)
                     directionLine[x] = 3;
+                else
+                {
+                    qreal a = 180. * atan(qreal(gradY) / gradX) / M_PI;
+
+                    if (a >= -22.5 && a < 22.5)
+                        directionLine[x] = 0;
+                    else if (a >= 22.5 && a < 67.5)
+                        directionLine[x] = 2;
+                    else if (a >= -67.5 && a < -22.5)
+                        directionLine[x] = 1;
+                    else
+                        directionLine[x] = 3;
+                }
             }
         }
-    }
+    });
 }
 
 int FITSGradientDetector::partition(int width, int height, QVector<float> &gradient, QVector<int> &ids) const
@@ -42,6 +42,9 @@ class FITSGradientDetector: public FITSStarDetector
         template <typename T>
         void sobel(FITSData const * data, QVector<float> &gradient, QVector<float> &direction) const;
 
+        /** @internal Number of rows each thread runs the Sobel operator on. */
+        static constexpr int ROW_BAND_HEIGHT { 64 };
+
         /** @internal Identify gradient connections.
          * @param width, height are the dimensions of the frame to work on.
          * @param gradient is the vector holding the amount of change in pixel sequences.
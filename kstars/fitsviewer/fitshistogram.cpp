@@ -13,6 +13,7 @@
 #include "fitstab.h"
 #include "fitsview.h"
 #include "fitsviewer.h"
+#include "histogrambins.h"
 
 #include <KMessageBox>
 
@@ -216,28 +217,17 @@ template <typename T> void FITSHistogram::constructHistogram()
 
     for (int n = 0; n < channels; n++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        futures.append(ProcessingLanes::run(ProcessingLanes::DISPLAY, [ = ]()
         {
             for (int i = 0; i < binCount; i++)
                 intensity[n][i] = FITSMin[n] + (binWidth[n] * i);
         }));
     }
 
+    // Spreads over the thread pool on its own.
     for (int n = 0; n < channels; n++)
-    {
-        futures.append(QtConcurrent::run([ = ]()
-        {
-            uint32_t offset = n * samples;
-
-            for (uint32_t i = 0; i < samples; i += sampleBy)
-            {
-                int32_t id = rint((buffer[i + offset] - FITSMin[n]) / binWidth[n]);
-                if (id < 0)
-                    id = 0;
-                frequency[n][id] += sampleBy;
-            }
-        }));
-    }
+        HistogramBins::accumulate(buffer + static_cast<size_t>(n) * samples, samples, sampleBy, FITSMin[n], binWidth[n],
+                                  binCount - 1, frequency[n], ProcessingLanes::DISPLAY);
 
     for (QFuture<void> future : futures)
         future.waitForFinished();
@@ -246,7 +236,7 @@ template <typename T> void FITSHistogram::constructHistogram()
 
     for (int n = 0; n < channels; n++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        futures.append(ProcessingLanes::run(ProcessingLanes::DISPLAY, [ = ]()
         {
             uint32_t accumulator = 0;
             for (int i = 0; i < binCount; i++)
@@ -264,7 +254,7 @@ template <typename T> void FITSHistogram::constructHistogram()
 
     for (int n = 0; n < channels; n++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        futures.append(ProcessingLanes::run(ProcessingLanes::DISPLAY, [ = ]()
         {
             double median[3] = {0};
             const bool cutoffSpikes = ui->hideSaturated->isChecked();
@@ -4,7 +4,6 @@
     SPDX-License-Identifier: GPL-2.0-or-later
 */
 
-#include <zlib.h>
 #include <QApplication>
 
 #include "fitshistogramcommand.h"
@@ -16,183 +15,87 @@ FITSHistogramCommand::FITSHistogramCommand(const QSharedPointer<FITSData> &data,
         FITSHistogramEditor * inHisto,
         FITSScale newType,
         const QVector<double> &lmin,
-        const QVector<double> &lmax) : m_ImageData(data), histogram(inHisto),
-    type(newType), min(lmin), max(lmax)
+        const QVector<double> &lmax,
+        const QSharedPointer<History> &history) : m_ImageData(data), histogram(inHisto),
+    type(newType), min(lmin), max(lmax), m_History(history)
 {
 }
 
-FITSHistogramCommand::~FITSHistogramCommand()
+void FITSHistogramCommand::apply(FITSScale filter, const QVector<double> &filterMin, const QVector<double> &filterMax)
 {
-    delete[] delta;
-}
-
-bool FITSHistogramCommand::calculateDelta(const uint8_t * buffer)
-{
-    uint8_t const * image_buffer = m_ImageData->getImageBuffer();
-    uint32_t totalPixels = m_ImageData->samplesPerChannel() * m_ImageData->channels();
-    unsigned long totalBytes = totalPixels * m_ImageData->getBytesPerPixel();
-
-    auto * raw_delta = new uint8_t[totalBytes];
-
-    if (raw_delta == nullptr)
+    QVector<double> dataMin = filterMin, dataMax = filterMax;
+    switch (filter)
     {
-        qCWarning(KSTARS_FITS) << "Error! not enough memory to create image delta";
-        return false;
-    }
-
-    for (uint32_t i = 0; i < totalBytes; i++)
-        raw_delta[i] = buffer[i] ^ image_buffer[i];
-
-    compressedBytes = sizeof(uint8_t) * totalBytes + totalBytes / 64 + 16 + 3;
-    delete[] delta;
-    delta = new uint8_t[compressedBytes];
+        case FITS_AUTO:
+        case FITS_LINEAR:
+            m_ImageData->applyFilter(FITS_LINEAR, nullptr, &dataMin, &dataMax);
+            break;
 
-    if (delta == nullptr)
-    {
-        delete[] raw_delta;
-        qCCritical(KSTARS_FITS)
-                << "FITSHistogram Error: Ran out of memory compressing delta";
-        return false;
-    }
+        case FITS_LOG:
+            m_ImageData->applyFilter(FITS_LOG, nullptr, &dataMin, &dataMax);
+            break;
 
-    int r = compress2(delta, &compressedBytes, raw_delta, totalBytes, 5);
+        case FITS_SQRT:
+            m_ImageData->applyFilter(FITS_SQRT, nullptr, &dataMin, &dataMax);
+            break;
 
-    if (r != Z_OK)
-    {
-        delete[] raw_delta;
-        /* this should NEVER happen */
-        qCCritical(KSTARS_FITS)
-                << "FITSHistogram Error: Failed to compress raw_delta";
-        return false;
+        default:
+            m_ImageData->applyFilter(filter);
+            break;
     }
-
-    delete[] raw_delta;
-    return true;
 }
 
-bool FITSHistogramCommand::reverseDelta()
+void FITSHistogramCommand::keep(int index)
 {
-    uint8_t const * image_buffer = m_ImageData->getImageBuffer();
-    uint32_t totalPixels = m_ImageData->samplesPerChannel() * m_ImageData->channels();
-    unsigned long totalBytes = totalPixels * m_ImageData->getBytesPerPixel();
-
-    auto * output_image = new uint8_t[totalBytes];
-
-    if (output_image == nullptr)
-    {
-        qCWarning(KSTARS_FITS) << "Error! not enough memory to create output image";
-        return false;
-    }
-
-    auto * raw_delta = new uint8_t[totalBytes];
-
-    if (raw_delta == nullptr)
-    {
-        delete[] output_image;
-        qCWarning(KSTARS_FITS) << "Error! not enough memory to create image delta";
-        return false;
-    }
-
-    int r = uncompress(raw_delta, &totalBytes, delta, compressedBytes);
-    if (r != Z_OK)
-    {
-        qCCritical(KSTARS_FITS)
-                << "FITSHistogram compression error in reverseDelta()";
-        delete[] output_image;
-        delete[] raw_delta;
-        return false;
-    }
+    const uint32_t totalBytes = m_ImageData->samplesPerChannel() * m_ImageData->channels() *
+                                m_ImageData->getBytesPerPixel();
 
-    for (unsigned int i = 0; i < totalBytes; i++)
-        output_image[i] = raw_delta[i] ^ image_buffer[i];
+    History::Snapshot snapshot;
+    snapshot.buffer = QByteArray(reinterpret_cast<const char *>(m_ImageData->getImageBuffer()), totalBytes);
+    m_ImageData->saveStatistics(snapshot.stats);
+    m_History->m_Snapshots.insert(index, snapshot);
 
-    m_ImageData->setImageBuffer(output_image);
+    // The first image is always kept, the most recent ones besides it
+    while (m_History->m_Snapshots.size() > History::MAX_RETAINED_BUFFERS + 1)
+        m_History->m_Snapshots.erase(std::next(m_History->m_Snapshots.begin()));
+}
 
-    delete[] raw_delta;
+void FITSHistogramCommand::restore(const History::Snapshot &snapshot)
+{
+    auto * buffer = new uint8_t[snapshot.buffer.size()];
+    memcpy(buffer, snapshot.buffer.constData(), snapshot.buffer.size());
+    m_ImageData->setImageBuffer(buffer);
 
-    return true;
+    FITSImage::Statistic stats = snapshot.stats;
+    m_ImageData->restoreStatistics(stats);
 }
 
 void FITSHistogramCommand::redo()
 {
-    uint8_t const * image_buffer = m_ImageData->getImageBuffer();
-    uint8_t * buffer = nullptr;
-    uint32_t totalPixels = m_ImageData->samplesPerChannel() * m_ImageData->channels();
-    int BBP = m_ImageData->getBytesPerPixel();
-
     QApplication::setOverrideCursor(Qt::WaitCursor);
 
-    if (delta != nullptr)
-    {
-        FITSImage::Statistic prevStats;
-        m_ImageData->saveStatistics(prevStats);
-
-        reverseDelta();
-
-        m_ImageData->restoreStatistics(stats);
-
-        stats = prevStats;
-    }
+    if (isGeometric())
+        m_ImageData->applyFilter(type);
     else
     {
-        m_ImageData->saveStatistics(stats);
-
-        // If it's rotation of flip, no need to calculate delta
-        if (type >= FITS_ROTATE_CW && type <= FITS_MOUNT_FLIP_V)
+        if (m_Index < 0)
         {
-            m_ImageData->applyFilter(type);
+            // The filters that were undone before this one was pushed are gone
+            m_Index = m_History->m_Applied;
+            while (m_History->m_Steps.size() > m_Index)
+                m_History->m_Steps.removeLast();
+            while (!m_History->m_Snapshots.isEmpty() && m_History->m_Snapshots.lastKey() >= m_Index)
+                m_History->m_Snapshots.erase(std::prev(m_History->m_Snapshots.end()));
+
+            m_History->m_Steps.append({type, min, max});
+            keep(m_Index);
         }
-        else
-        {
-            buffer = new uint8_t[totalPixels * BBP];
-
-            if (buffer == nullptr)
-            {
-                qWarning(KSTARS_FITS()) << "Error! not enough memory to create image buffer in redo()";
-                QApplication::restoreOverrideCursor();
-                return;
-            }
-
-            memcpy(buffer, image_buffer, totalPixels * BBP);
-
-            QVector<double> dataMin = min, dataMax = max;
-            switch (type)
-            {
-                case FITS_AUTO:
-                case FITS_LINEAR:
-                    m_ImageData->applyFilter(FITS_LINEAR, nullptr, &dataMin, &dataMax);
-                    break;
-
-                case FITS_LOG:
-                    m_ImageData->applyFilter(FITS_LOG, nullptr, &dataMin, &dataMax);
-                    break;
 
-                case FITS_SQRT:
-                    m_ImageData->applyFilter(FITS_SQRT, nullptr, &dataMin, &dataMax);
-                    break;
-
-                default:
-                    m_ImageData->applyFilter(type);
-                    break;
-            }
-
-            calculateDelta(buffer);
-            delete[] buffer;
-        }
+        // Filters are applied again rather than stored
+        apply(type, min, max);
+        m_History->m_Applied = m_Index + 1;
     }
 
-    //    if (histogram != nullptr)
-    //    {
-    //        histogram->construct();
-
-    //        //        if (tab->getViewer()->isStarsMarked())
-    //        //            imageData->findStars().waitForFinished();
-    //    }
-
-    //    image->pushFilter(type);
-    //    image->rescale(ZOOM_KEEP_LEVEL);
-    //    image->updateFrame();
-
     QApplication::restoreOverrideCursor();
 }
 
@@ -200,47 +103,41 @@ void FITSHistogramCommand::undo()
 {
     QApplication::setOverrideCursor(Qt::WaitCursor);
 
-    if (delta != nullptr)
-    {
-        FITSImage::Statistic prevStats;
-        m_ImageData->saveStatistics(prevStats);
-
-        reverseDelta();
-
-        m_ImageData->restoreStatistics(stats);
-
-        stats = prevStats;
-    }
-    else
+    switch (type)
     {
-        switch (type)
+        case FITS_ROTATE_CW:
+            m_ImageData->applyFilter(FITS_ROTATE_CCW);
+            break;
+        case FITS_ROTATE_CCW:
+            m_ImageData->applyFilter(FITS_ROTATE_CW);
+            break;
+        case FITS_MOUNT_FLIP_H:
+        case FITS_MOUNT_FLIP_V:
+            m_ImageData->applyFilter(type);
+            break;
+        default:
         {
-            case FITS_ROTATE_CW:
-                m_ImageData->applyFilter(FITS_ROTATE_CCW);
-                break;
-            case FITS_ROTATE_CCW:
-                m_ImageData->applyFilter(FITS_ROTATE_CW);
-                break;
-            case FITS_MOUNT_FLIP_H:
-            case FITS_MOUNT_FLIP_V:
-                m_ImageData->applyFilter(type);
-                break;
-            default:
+            // The closest image kept at or before this filter, there is always the first one
+            auto snapshot = m_History->m_Snapshots.upperBound(m_Index);
+            if (snapshot == m_History->m_Snapshots.begin())
+            {
+                qCWarning(KSTARS_FITS) << "No image kept to undo" << text();
                 break;
-        }
-    }
-
-    //    if (histogram != nullptr)
-    //    {
-    //        histogram->construct();
+            }
+            snapshot--;
 
-    //        //        if (tab->getViewer()->isStarsMarked())
-    //        //            imageData->findStars().waitForFinished();
-    //    }
+            const int from = snapshot.key();
+            restore(snapshot.value());
+            for (int i = from; i < m_Index; i++)
+                apply(m_History->m_Steps[i].type, m_History->m_Steps[i].min, m_History->m_Steps[i].max);
+            // Undoing further back is likely, and now starts from here
+            if (from < m_Index)
+                keep(m_Index);
 
-    //    image->popFilter();
-    //    image->rescale(ZOOM_KEEP_LEVEL);
-    //    image->updateFrame();
+            m_History->m_Applied = m_Index;
+        }
+        break;
+    }
 
     QApplication::restoreOverrideCursor();
 }
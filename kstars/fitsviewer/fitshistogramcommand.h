@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <QByteArray>
+#include <QMap>
 #include <QUndoCommand>
 #include "fitsdata.h"
 
@@ -15,27 +17,68 @@ class FITSHistogramEditor;
 class FITSHistogramCommand : public QUndoCommand
 {
     public:
+        /**
+         * @brief The filters applied to an image one after the other, shared by their commands.
+         *
+         * Undoing a filter needs the image as it was before it. Rather than a delta per filter, the
+         * image before the first filter is kept once, along with the images before the most recent
+         * filters. A filter whose image was not kept is undone by going back to the closest image
+         * kept before it, and applying the filters in between again.
+         *
+         * Rotations and flips are undone by their inverse, the filters after one go to a new history.
+         */
+        class History
+        {
+            public:
+                // Copies of the image kept besides the first one
+                static constexpr int MAX_RETAINED_BUFFERS = 2;
+
+            private:
+                friend class FITSHistogramCommand;
+
+                struct Step
+                {
+                    FITSScale type;
+                    QVector<double> min, max;
+                };
+                struct Snapshot
+                {
+                    QByteArray buffer;
+                    FITSImage::Statistic stats;
+                };
+
+                QList<Step> m_Steps;
+                // Image before the step of the same index
+                QMap<int, Snapshot> m_Snapshots;
+                // Steps currently applied to the image
+                int m_Applied { 0 };
+        };
+
         FITSHistogramCommand(const QSharedPointer<FITSData> &data, FITSHistogramEditor * inHisto, FITSScale newType,
                              const QVector<double> &lmin,
-                             const QVector<double> &lmax);
-        virtual ~FITSHistogramCommand();
+                             const QVector<double> &lmax, const QSharedPointer<History> &history);
+        virtual ~FITSHistogramCommand() = default;
 
         virtual void redo() override;
         virtual void undo() override;
         virtual QString text() const;
 
     private:
-        bool calculateDelta(const uint8_t * buffer);
-        bool reverseDelta();
+        bool isGeometric() const
+        {
+            return type >= FITS_ROTATE_CW && type <= FITS_MOUNT_FLIP_V;
+        }
 
-        FITSImage::Statistic stats;
+        void apply(FITSScale filter, const QVector<double> &filterMin, const QVector<double> &filterMax);
+        void keep(int index);
+        void restore(const History::Snapshot &snapshot);
 
         QSharedPointer<FITSData> m_ImageData;
         FITSHistogramEditor * histogram { nullptr };
         FITSScale type;
         QVector<double> min, max;
 
-        unsigned char * delta { nullptr };
-        unsigned long compressedBytes { 0 };
-
+        QSharedPointer<History> m_History;
+        // Position of the filter in the history, -1 until it is applied once
+        int m_Index { -1 };
 };
@@ -177,7 +177,7 @@ void FITSHistogramEditor::applyScale()
     //        type = FITS_LOG;
     //    else
     type = FITS_LINEAR;
-    emit newHistogramCommand(new FITSHistogramCommand(m_ImageData, this, type, min, max));
+    emit newHistogramCommand(new FITSHistogramCommand(m_ImageData, this, type, min, max, m_FilterHistory));
 }
 
 void FITSHistogramEditor::applyFilter(FITSScale ftype)
@@ -186,12 +186,17 @@ void FITSHistogramEditor::applyFilter(FITSScale ftype)
     min.append(ui->minREdit->value());
     type = ftype;
 
-    emit newHistogramCommand(new FITSHistogramCommand(m_ImageData, this, type, min, max));
+    emit newHistogramCommand(new FITSHistogramCommand(m_ImageData, this, type, min, max, m_FilterHistory));
+
+    // Rotations and flips are undone on their own, the filters after them start from the new image
+    if (type >= FITS_ROTATE_CW && type <= FITS_MOUNT_FLIP_V)
+        m_FilterHistory.reset(new FITSHistogramCommand::History());
 }
 
 void FITSHistogramEditor::setImageData(const QSharedPointer<FITSData> &data)
 {
     m_ImageData = data;
+    m_FilterHistory.reset(new FITSHistogramCommand::History());
     ui->histogramPlot->setImageData(data);
 
     connect(m_ImageData.data(), &FITSData::dataChanged, [this]
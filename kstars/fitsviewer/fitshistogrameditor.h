@@ -64,4 +64,6 @@ class FITSHistogramEditor : public QDialog
         bool isGUISynced { false};
         bool m_Constructed { false };
         QSharedPointer<FITSData> m_ImageData;
+        // Filters applied to the image since it was loaded or last rotated
+        QSharedPointer<FITSHistogramCommand::History> m_FilterHistory { new FITSHistogramCommand::History() };
 };
@@ -265,10 +265,10 @@ void FITSLabel::mouseMoveEvent(QMouseEvent *e)
         bool objFound = false;
         for (auto &listObject : imageData->getSkyObjects())
         {
-            if ((std::abs(listObject->x() - x) < 5 / scale) && (std::abs(listObject->y() - y) < 5 / scale))
+            if ((std::abs(listObject.x() - x) < 5 / scale) && (std::abs(listObject.y() - y) < 5 / scale))
             {
                 QToolTip::showText(e->globalPos(),
-                                   QToolTip::text() + '\n' + listObject->skyObject()->name() + '\n' + listObject->skyObject()->longname(), this);
+                                   QToolTip::text() + '\n' + listObject.skyObject()->name() + '\n' + listObject.skyObject()->longname(), this);
                 objFound = true;
                 break;
             }
@@ -373,9 +373,9 @@ void FITSLabel::mousePressEvent(QMouseEvent *e)
         {
             for (auto &listObject : view_data->getSkyObjects())
             {
-                if ((std::abs(listObject->x() - x) < 10 / scale) && (std::abs(listObject->y() - y) < 10 / scale))
+                if ((std::abs(listObject.x() - x) < 10 / scale) && (std::abs(listObject.y() - y) < 10 / scale))
                 {
-                    SkyObject *object = listObject->skyObject();
+                    SkyObject *object = listObject.skyObject();
                     KSPopupMenu *pmenu;
                     pmenu = new KSPopupMenu();
                     object->initPopupMenu(pmenu);
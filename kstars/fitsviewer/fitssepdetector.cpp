@@ -53,9 +53,76 @@
 // (e.g. unfiltered number of stars detected,background sky level). Waiting on rlancaste's
 // investigations into SEP before doing this.
 
+#ifdef HAVE_STELLARSOLVER
+namespace
+{
+// Tiles smaller than this, on either side, are not worth a solver of their own.
+constexpr int MinTileSize = 1024;
+// Each tile is extracted with this margin around it, which must be larger than the stars
+// so that a star centered in the tile is never cut by the edge of the extracted area.
+constexpr int TileOverlap = 128;
+
+struct TileSources
+{
+    QList<FITSImage::Star> stars;
+    FITSImage::Background background;
+};
+
+// Split the frame in a grid of about one tile per thread, with tiles as square as possible.
+QList<QRect> extractionTiles(const QRect &frame, int threads)
+{
+    const int maxColumns = qMax(1, frame.width() / MinTileSize);
+    const int maxRows = qMax(1, frame.height() / MinTileSize);
+    if (threads <= 1 || maxColumns * maxRows <= 1)
+        return QList<QRect>();
+
+    const double aspect = static_cast<double>(frame.width()) / frame.height();
+    const int columns = qBound(1, static_cast<int>(std::lround(std::sqrt(threads * aspect))), maxColumns);
+    const int rows = qBound(1, (threads + columns - 1) / columns, maxRows);
+
+    QList<QRect> tiles;
+    for (int row = 0; row < rows; row++)
+    {
+        const int top = frame.top() + row * frame.height() / rows;
+        const int bottom = frame.top() + (row + 1) * frame.height() / rows;
+        for (int column = 0; column < columns; column++)
+        {
+            const int left = frame.left() + column * frame.width() / columns;
+            const int right = frame.left() + (column + 1) * frame.width() / columns;
+            tiles.append(QRect(left, top, right - left, bottom - top));
+        }
+    }
+    return tiles;
+}
+
+// Extract the stars of the tile and its margin, in full frame coordinates.
+TileSources extractTile(const QPointer<FITSData> &image, const SSolver::Parameters &params, bool runHFR,
+                        const QRect &tile)
+{
+    TileSources result;
+    if (image.isNull())
+        return result;
+
+    const QRect frame(0, 0, image->width(), image->height());
+    const QRect extended = tile.adjusted(-TileOverlap, -TileOverlap, TileOverlap, TileOverlap).intersected(frame);
+
+    QScopedPointer<StellarSolver, QScopedPointerDeleteLater> solver(new StellarSolver(image->getStatistics(),
+            image->getImageBuffer()));
+    solver->setParameters(params);
+    solver->setLogLevel(SSolver::LOG_NONE);
+    solver->setSSLogLevel(SSolver::LOG_OFF);
+    solver->extract(runHFR, extended);
+
+    result.stars = solver->getStarList();
+    result.background = solver->getBackground();
+    return result;
+}
+}
+#endif
+
 QFuture<bool> FITSSEPDetector::findSources(QRect const &boundary)
 {
-    return QtConcurrent::run(this, &FITSSEPDetector::findSourcesAndBackground, boundary);
+    return findInLane(lane(), this, &FITSSEPDetector::findSourcesAndBackground, boundary);
 }
 
 bool FITSSEPDetector::findSourcesAndBackground(QRect const &boundary)
@@ -127,24 +194,69 @@ bool FITSSEPDetector::findSourcesAndBackground(QRect const &boundary)
     }
 
     QList<FITSImage::Star> stars;
+    FITSImage::Background bg;
     const bool runHFR = group != Ekos::AlignProfiles;
 
-    solver->setLogLevel(SSolver::LOG_NONE);
-    solver->setSSLogLevel(SSolver::LOG_OFF);
+    const QRect frame = boundary.isValid() ? boundary : QRect(0, 0, m_ImageData->width(), m_ImageData->height());
+    const int threads = ProcessingLanes::pool(lane())->maxThreadCount();
+    const QList<QRect> tiles = Options::stellarSolverTiles() ? extractionTiles(frame, threads) : QList<QRect>();
+    if (tiles.size() > 1)
+    {
+        // Each tile runs its own solver, the partitions would only compete with the tiles for the cores.
+        SSolver::Parameters params = solver->getCurrentParameters();
+        params.partition = false;
 
-    if (boundary.isValid())
-        solver->extract(runHFR, boundary);
+        QList<QFuture<TileSources>> futures;
+        for (const auto &tile : tiles)
+        {
+            futures.append(ProcessingLanes::run(lane(), [image, params, runHFR, tile]()
+            {
+                return extractTile(image, params, runHFR, tile);
+            }));
+        }
+
+        // Seams are deduplicated by keeping each star only in the tile whose core contains its center.
+        // The background is the average of the tiles, weighted by their areas.
+        double globalSum = 0, globalSquaredRMSSum = 0, areaSum = 0;
+        bg.num_stars_detected = 0;
+        for (int i = 0; i < futures.size(); i++)
+        {
+            futures[i].waitForFinished();
+            const TileSources result = futures[i].result();
+            for (const auto &star : result.stars)
+            {
+                if (tiles[i].contains(static_cast<int>(star.x), static_cast<int>(star.y)))
+                    stars.append(star);
+            }
+            const double area = static_cast<double>(tiles[i].width()) * tiles[i].height();
+            globalSum += result.background.global * area;
+            globalSquaredRMSSum += result.background.globalrms * result.background.globalrms * area;
+            areaSum += area;
+            bg.num_stars_detected += result.background.num_stars_detected;
+            bg.bw = result.background.bw;
+            bg.bh = result.background.bh;
+        }
+        bg.global = globalSum / areaSum;
+        bg.globalrms = sqrt(globalSquaredRMSSum / areaSum);
+    }
     else
-        solver->extract(runHFR);
+    {
+        solver->setLogLevel(SSolver::LOG_NONE);
+        solver->setSSLogLevel(SSolver::LOG_OFF);
+
+        if (boundary.isValid())
+            solver->extract(runHFR, boundary);
+        else
+            solver->extract(runHFR);
 
-    stars = solver->getStarList();
+        stars = solver->getStarList();
+        bg = solver->getBackground();
+    }
 
     // If m_ImageData goes out of scope, also return.
     if (stars.empty() || image.isNull())
         return false;
 
-    auto bg = solver->getBackground();
-
     skyBG.mean = bg.global;
     skyBG.sigma = bg.globalrms;
     skyBG.numPixelsInSkyEstimate = bg.bw * bg.bh;
@@ -189,31 +301,6 @@ bool FITSSEPDetector::findSourcesAndBackground(QRect const &boundary)
 #endif
 }
 
-template <typename T>
-void FITSSEPDetector::getFloatBuffer(float * buffer, int x, int y, int w, int h, FITSData const *data) const
-{
-    auto * rawBuffer = reinterpret_cast<T const *>(data->getImageBuffer());
-
-    if (buffer == nullptr)
-        return;
-
-    float * floatPtr = buffer;
-
-    int x2 = x + w;
-    int y2 = y + h;
-
-    FITSImage::Statistic const &stats = data->getStatistics();
-
-    for (int y1 = y; y1 < y2; y1++)
-    {
-        int offset = y1 * stats.width;
-        for (int x1 = x; x1 < x2; x1++)
-        {
-            *floatPtr++ = rawBuffer[offset + x1];
-        }
-    }
-}
-
 SkyBackground::SkyBackground(double mean_, double sigma_, double numPixels_)
 {
     initialize(mean_, sigma_, numPixels_);
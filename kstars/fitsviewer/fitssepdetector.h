@@ -29,15 +29,6 @@ class FITSSEPDetector : public FITSStarDetector
          */
         bool findSourcesAndBackground(QRect const &boundary = QRect());
 
-    protected:
-        /** @internal Consolidate a float data buffer from FITS data.
-         * @param buffer is the destination float block.
-         * @param x, y, w, h define a (x,y)-(x+w,y+h) sub-frame to extract from the FITS data out to block 'buffer'.
-         * @param image_data is the FITS data block to extract from.
-         */
-        template <typename T>
-        void getFloatBuffer(float * buffer, int x, int y, int w, int h, FITSData const * image_data) const;
-
     private:
 
         void clearSolver();
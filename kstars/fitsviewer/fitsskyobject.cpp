@@ -10,14 +10,14 @@
 
 #include "fitsskyobject.h"
 
-FITSSkyObject::FITSSkyObject(SkyObject /*const*/ * object, int xPos, int yPos) : QObject()
+FITSSkyObject::FITSSkyObject(SkyObject /*const*/ * object, int xPos, int yPos)
 {
     skyObjectStored = object;
     xLoc            = xPos;
     yLoc            = yPos;
 }
 
-SkyObject /*const*/ * FITSSkyObject::skyObject()
+SkyObject /*const*/ * FITSSkyObject::skyObject() const
 {
     return skyObjectStored;
 }
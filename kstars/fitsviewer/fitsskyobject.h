@@ -11,25 +11,22 @@
 #ifndef FITSSKYOBJECT_H
 #define FITSSKYOBJECT_H
 
-#include <QObject>
-
 class SkyObject;
 
-class FITSSkyObject : public QObject
+/** @brief The position of a SkyObject in a frame, kept by value in the annotations of FITSData. */
+class FITSSkyObject
 {
-    Q_OBJECT
-
 public:
     /** @brief Locate a SkyObject at a pixel position.
      * @param object is the SkyObject to locate in the frame.
      * @param xPos and yPos are the pixel position of the SkyObject in the frame.
      */
-    explicit FITSSkyObject(SkyObject /*const*/ *object, int xPos, int yPos);
+    explicit FITSSkyObject(SkyObject /*const*/ *object = nullptr, int xPos = 0, int yPos = 0);
 
 public:
     /** @brief Getting the SkyObject this instance locates.
      */
-    SkyObject /*const*/ *skyObject();
+    SkyObject /*const*/ *skyObject() const;
 
 public:
     /** @brief Getting the pixel position of the SkyObject this instance locates. */
@@ -1,5 +1,8 @@
 #include "fitsstardetector.h"
 
+#include "fitsdata.h"
+#include "imagebufferpool.h"
+
 //void FITSStarDetector::configure(QStandardItemModel const &settings)
 //{
 //    Q_ASSERT(2 <= settings.columnCount());
@@ -20,3 +23,32 @@ QVariant FITSStarDetector::getValue(const QString &key, QVariant defaultValue) c
     else
         return defaultValue;
 }
+
+FITSStarDetector::~FITSStarDetector()
+{
+    ImageBufferPool::instance().release(m_FloatBuffer);
+}
+
+ProcessingLanes::Lane FITSStarDetector::lane() const
+{
+    return m_ImageData ? m_ImageData->lane() : ProcessingLanes::current();
+}
+
+const float *FITSStarDetector::getFloatBuffer(QRect area)
+{
+    if (m_ImageData == nullptr)
+        return nullptr;
+    if (!area.isValid())
+        area = QRect(0, 0, m_ImageData->width(), m_ImageData->height());
+
+    const uint32_t size = area.width() * area.height() * sizeof(float);
+    if (size > m_FloatBufferSize)
+    {
+        ImageBufferPool::instance().release(m_FloatBuffer);
+        m_FloatBuffer = ImageBufferPool::instance().acquire(size);
+        m_FloatBufferSize = m_FloatBuffer ? size : 0;
+    }
+
+    auto *buffer = reinterpret_cast<float *>(m_FloatBuffer);
+    return m_ImageData->getFloatBuffer(buffer, area) ? buffer : nullptr;
+}
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "auxiliary/processinglanes.h"
+
 #include <QObject>
 #include <QHash>
 #include <QStandardItem>
@@ -52,6 +54,7 @@ class FITSStarDetector : public QObject
         /** @brief Instantiate a detector for a FITS data file.
          */
         explicit FITSStarDetector(FITSData *data): QObject(), m_ImageData(data) {};
+        virtual ~FITSStarDetector() override;
 
         /** @brief Find sources in the parent FITS data file.
          * @param starCenters is the list of sources to append to.
@@ -81,7 +84,33 @@ class FITSStarDetector : public QObject
         //void configure(QStandardItemModel const &settings);
 
     protected:
+        /** @brief Convert the samples of the parent FITS data inside area to float.
+         * @param area is the sub-frame to convert, by default the full frame.
+         * @return The samples row after row, or nullptr if they could not be converted.
+         * @note The buffer is owned by the detector and reused by the next call, it grows on demand.
+         * When the detector goes away it is handed to ImageBufferPool, so that the detector of the
+         * next frame picks it up again, until the pool trims it.
+         */
+        const float *getFloatBuffer(QRect area = QRect());
+
+        /** @return the lane the parent FITS data is processed in */
+        ProcessingLanes::Lane lane() const;
+
+        /** @brief Run a search of the detector in the lane of the parent FITS data. */
+        template <class Detector, typename Find>
+        static QFuture<bool> findInLane(ProcessingLanes::Lane lane, Detector *detector, Find find, const QRect &boundary)
+        {
+            return ProcessingLanes::run(lane, [detector, find, boundary]()
+            {
+                return (detector->*find)(boundary);
+            });
+        }
+
         FITSData *m_ImageData {nullptr};
         QVariantMap m_Settings;
+
+    private:
+        uint8_t *m_FloatBuffer {nullptr};
+        uint32_t m_FloatBufferSize {0};
 };
 
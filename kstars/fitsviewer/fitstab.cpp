@@ -14,6 +14,7 @@
 #include "fitsviewer.h"
 #include "ksnotification.h"
 #include "kstars.h"
+#include "livestacker.h"
 #include "Options.h"
 #include "ui_fitsheaderdialog.h"
 #include "ui_statform.h"
@@ -292,7 +293,27 @@ bool FITSTab::loadData(const QSharedPointer<FITSData> &data, FITSMode mode, FITS
 
     m_View->setFilter(filter);
 
-    if (!m_View->loadData(data))
+    QSharedPointer<FITSData> shown = data;
+    if (m_LiveStacker)
+    {
+        m_LiveStacker->setSigmaRejection(Options::liveStackSigmaRejection());
+        switch (m_LiveStacker->add(data))
+        {
+            case LiveStacker::NO_STARS:
+                emit newStatus(i18n("Live stack: too few stars, frame skipped"), FITS_MESSAGE);
+                break;
+            case LiveStacker::NOT_REGISTERED:
+                emit newStatus(i18n("Live stack: frame could not be aligned, skipped"), FITS_MESSAGE);
+                break;
+            default:
+                emit newStatus(i18np("Live stack: %1 frame", "Live stack: %1 frames", m_LiveStacker->frames()), FITS_MESSAGE);
+                break;
+        }
+        if (m_LiveStacker->frames() > 0)
+            shown = m_LiveStacker->stack();
+    }
+
+    if (!m_View->loadData(shown))
     {
         // On Failure to load
         // connect(view.get(), &FITSView::failed, this, &FITSTab::failed);
@@ -323,6 +344,47 @@ bool FITSTab::saveImage(const QString &filename)
     return m_View->saveImage(filename);
 }
 
+void FITSTab::setLiveStacking(bool enable)
+{
+    if (enable)
+        m_LiveStacker.reset(new LiveStacker());
+    else
+        m_LiveStacker.reset();
+}
+
+void FITSTab::releaseMemory(bool pixels)
+{
+    if (m_View.isNull() || m_View->imageData().isNull())
+        return;
+
+    m_View->releaseDisplay();
+
+    // Only what can be read again as is from the file, a stack is rebuilt from the frames
+    if (pixels && undoStack->isClean() && m_View->getMode() == FITS_NORMAL && !m_LiveStacker &&
+            m_View->imageData()->releaseImageBuffer())
+        qCDebug(KSTARS_FITS) << "Released the pixels of" << m_View->imageData()->filename();
+}
+
+void FITSTab::restoreMemory()
+{
+    if (m_View.isNull() || m_View->imageData().isNull())
+        return;
+
+    const QSharedPointer<FITSData> &imageData = m_View->imageData();
+    if (imageData->isImageBufferReleased() && !imageData->restoreImageBuffer())
+    {
+        emit newStatus(i18n("Failed to reload %1: %2", imageData->filename(), imageData->getLastError()), FITS_MESSAGE);
+        return;
+    }
+
+    m_View->restoreDisplay();
+}
+
+qint64 FITSTab::memoryUsage() const
+{
+    return m_View.isNull() ? 0 : m_View->memoryUsage();
+}
+
 void FITSTab::copyFITS()
 {
     QApplication::clipboard()->setImage(m_View->getDisplayImage());
@@ -29,6 +29,7 @@ class FITSView;
 class FITSViewer;
 class FITSData;
 class FITSStretchUI;
+class LiveStacker;
 
 /**
  * @brief The FITSTab class holds information on the current view (drawing area) in addition to the undo/redo stacks
@@ -83,6 +84,26 @@ class FITSTab : public QWidget
 
         bool saveImage(const QString &filename);
 
+        /**
+         * @brief setLiveStacking Stack the frames loaded into the tab from now on, and show the stack
+         * instead of each frame.
+         * @note The stack is started again whenever live stacking is turned on.
+         */
+        void setLiveStacking(bool enable);
+
+        /**
+         * @brief releaseMemory Drop the rendered image of the tab while it is in the background and,
+         * if @p pixels, the pixels of an unmodified file too. restoreMemory() brings them back.
+         */
+        void releaseMemory(bool pixels);
+        void restoreMemory();
+        /** @return the bytes held by the image of the tab and its renders */
+        qint64 memoryUsage() const;
+        bool isLiveStacking() const
+        {
+            return m_LiveStacker != nullptr;
+        }
+
         inline QUndoStack *getUndoStack()
         {
             return undoStack;
@@ -192,6 +213,9 @@ class FITSTab : public QWidget
         QList<QString> m_BlinkFilenames;
         int m_BlinkIndex { 0 };
 
+        // Stack of the frames loaded while live stacking is on
+        std::unique_ptr<LiveStacker> m_LiveStacker;
+
     signals:
         void debayerToggled(bool);
         void newStatus(const QString &msg, FITSBar id);
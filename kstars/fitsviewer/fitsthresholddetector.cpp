@@ -29,29 +29,29 @@ QFuture<bool> FITSThresholdDetector::findSources(QRect const &boundary)
     switch (stats.dataType)
     {
         case TSHORT:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<int16_t>, boundary);
+            return findInLane(lane(), this, &FITSThresholdDetector::findOneStar<int16_t>, boundary);
 
         case TUSHORT:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<uint16_t>, boundary);
+            return findInLane(lane(), this, &FITSThresholdDetector::findOneStar<uint16_t>, boundary);
 
         case TLONG:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<int32_t>, boundary);
+            return findInLane(lane(), this, &FITSThresholdDetector::findOneStar<int32_t>, boundary);
 
         case TULONG:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<uint32_t>, boundary);
+            return findInLane(lane(), this, &FITSThresholdDetector::findOneStar<uint32_t>, boundary);
 
         case TFLOAT:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<float>, boundary);
+            return findInLane(lane(), this, &FITSThresholdDetector::findOneStar<float>, boundary);
 
         case TLONGLONG:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<int64_t>, boundary);
+            return findInLane(lane(), this, &FITSThresholdDetector::findOneStar<int64_t>, boundary);
 
         case TDOUBLE:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<double>, boundary);
+            return findInLane(lane(), this, &FITSThresholdDetector::findOneStar<double>, boundary);
 
         case TBYTE:
         default:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<uint8_t>, boundary);
+            return findInLane(lane(), this, &FITSThresholdDetector::findOneStar<uint8_t>, boundary);
     }
 
 }
@@ -0,0 +1,193 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "fitsthumbnail.h"
+
+#include "fitsdata.h"
+#include "auxiliary/processinglanes.h"
+
+#include <fits_debug.h>
+
+#include <numeric>
+#include <type_traits>
+
+namespace
+{
+
+// Channel of each pixel of a 2x2 Bayer cell, top left, top right, bottom left, bottom right
+const int *cellChannels(dc1394color_filter_t filter)
+{
+    static const int RGGB[] = { 0, 1, 1, 2 };
+    static const int BGGR[] = { 2, 1, 1, 0 };
+    static const int GRBG[] = { 1, 0, 2, 1 };
+    static const int GBRG[] = { 1, 2, 0, 1 };
+
+    switch (filter)
+    {
+        case DC1394_COLOR_FILTER_BGGR:
+            return BGGR;
+        case DC1394_COLOR_FILTER_GRBG:
+            return GRBG;
+        case DC1394_COLOR_FILTER_GBRG:
+            return GBRG;
+        default:
+            return RGGB;
+    }
+}
+
+template <typename T>
+T average(double sum, int count)
+{
+    if (std::is_integral<T>::value)
+        return static_cast<T>(sum / count + 0.5);
+    return static_cast<T>(sum / count);
+}
+
+// Average each factor x factor block of every channel
+template <typename T>
+void binPlanes(const T *source, T *target, int width, int height, int channels, int factor)
+{
+    const int targetWidth = width / factor, targetHeight = height / factor;
+    const int count = factor * factor;
+
+    QVector<int> rows(targetHeight);
+    std::iota(rows.begin(), rows.end(), 0);
+    ProcessingLanes::blockingMap(ProcessingLanes::DISPLAY, rows, [&](int &y)
+    {
+        for (int c = 0; c < channels; c++)
+        {
+            const T *plane = source + size_t(c) * width * height;
+            T *out = target + size_t(c) * targetWidth * targetHeight + size_t(y) * targetWidth;
+            for (int x = 0; x < targetWidth; x++)
+            {
+                double sum = 0;
+                for (int j = 0; j < factor; j++)
+                {
+                    const T *row = plane + size_t(y * factor + j) * width + x * factor;
+                    for (int i = 0; i < factor; i++)
+                        sum += row[i];
+                }
+                out[x] = average<T>(sum, count);
+            }
+        }
+    });
+}
+
+// Average the red, green and blue pixels of each factor x factor block of the mosaic, which
+// makes superpixels when factor is 2
+template <typename T>
+void binMosaic(const T *source, T *target, int width, int height, int offsetY, dc1394color_filter_t filter,
+               int factor)
+{
+    const int targetWidth = width / factor, targetHeight = (height - offsetY) / factor;
+    const size_t planeSize = size_t(targetWidth) * targetHeight;
+    const int *channels = cellChannels(filter);
+    // Each block holds a quarter red, half green and a quarter blue pixels
+    const int counts[] = { factor * factor / 4, factor * factor / 2, factor * factor / 4 };
+
+    QVector<int> rows(targetHeight);
+    std::iota(rows.begin(), rows.end(), 0);
+    ProcessingLanes::blockingMap(ProcessingLanes::DISPLAY, rows, [&](int &y)
+    {
+        for (int x = 0; x < targetWidth; x++)
+        {
+            double sums[3] = { 0, 0, 0 };
+            for (int j = 0; j < factor; j++)
+            {
+                const T *row = source + size_t(offsetY + y * factor + j) * width + x * factor;
+                const int *cellRow = channels + 2 * (j & 1);
+                for (int i = 0; i < factor; i++)
+                    sums[cellRow[i & 1]] += row[i];
+            }
+            for (int c = 0; c < 3; c++)
+                target[c * planeSize + size_t(y) * targetWidth + x] = average<T>(sums[c], counts[c]);
+        }
+    });
+}
+
+template <typename T>
+QSharedPointer<FITSData> createThumbnail(const QSharedPointer<FITSData> &data, int maxSize)
+{
+    const int width = data->width(), height = data->height();
+    const bool mosaic = data->isMosaic();
+    BayerParams params;
+    data->getBayerParams(&params);
+    const int offsetY = mosaic ? params.offsetY : 0;
+    // A mosaic cannot be read in blocks smaller than its cells
+    const int factor = std::max(mosaic ? 2 : 1, FITSThumbnail::binning(width, height - offsetY, maxSize));
+    if (factor == 1)
+        return data;
+
+    FITSImage::Statistic stats;
+    stats.width = width / factor;
+    stats.height = (height - offsetY) / factor;
+    stats.channels = mosaic ? 3 : data->channels();
+    stats.dataType = data->dataType();
+    stats.bytesPerPixel = sizeof(T);
+    stats.ndim = stats.channels == 1 ? 2 : 3;
+    stats.samples_per_channel = uint32_t(stats.width) * stats.height;
+    if (stats.width == 0 || stats.height == 0)
+        return data;
+
+    auto *buffer = new uint8_t[size_t(stats.samples_per_channel) * stats.channels * sizeof(T)];
+    auto source = reinterpret_cast<const T *>(data->getImageBuffer());
+    auto target = reinterpret_cast<T *>(buffer);
+    if (mosaic)
+        binMosaic(source, target, width, height, offsetY, params.filter, factor);
+    else
+        binPlanes(source, target, width, height, stats.channels, factor);
+
+    QSharedPointer<FITSData> thumbnail(new FITSData(), &QObject::deleteLater);
+    thumbnail->restoreStatistics(stats);
+    thumbnail->setProperty("dataType", stats.dataType);
+    thumbnail->setImageBuffer(buffer);
+    thumbnail->calculateStats(true);
+    return thumbnail;
+}
+
+}
+
+namespace FITSThumbnail
+{
+
+int binning(int width, int height, int maxSize)
+{
+    int factor = 1;
+    while (maxSize > 0 && std::max(width, height) / factor > maxSize)
+        factor *= 2;
+    return factor;
+}
+
+QSharedPointer<FITSData> create(const QSharedPointer<FITSData> &data, int maxSize)
+{
+    if (data.isNull() || data->getImageBuffer() == nullptr)
+        return QSharedPointer<FITSData>();
+
+    switch (data->dataType())
+    {
+        case TBYTE:
+            return createThumbnail<uint8_t>(data, maxSize);
+        case TSHORT:
+            return createThumbnail<int16_t>(data, maxSize);
+        case TUSHORT:
+            return createThumbnail<uint16_t>(data, maxSize);
+        case TLONG:
+            return createThumbnail<int32_t>(data, maxSize);
+        case TULONG:
+            return createThumbnail<uint32_t>(data, maxSize);
+        case TFLOAT:
+            return createThumbnail<float>(data, maxSize);
+        case TLONGLONG:
+            return createThumbnail<int64_t>(data, maxSize);
+        case TDOUBLE:
+            return createThumbnail<double>(data, maxSize);
+        default:
+            qCWarning(KSTARS_FITS) << "No thumbnail for data type" << data->dataType();
+            return QSharedPointer<FITSData>();
+    }
+}
+
+}
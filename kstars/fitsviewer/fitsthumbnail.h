@@ -0,0 +1,37 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QSharedPointer>
+
+class FITSData;
+
+/**
+ * @namespace FITSThumbnail
+ * @short Small images of frames, for previews that do not need every pixel.
+ *
+ * A thumbnail is binned straight from the pixel buffer of the frame, by the power of two that
+ * brings it under the requested size. A raw Bayer mosaic is turned into colour by superpixels,
+ * each 2x2 cell of the mosaic giving one RGB pixel, so the frame is never debayered at full
+ * resolution. The thumbnail is an ordinary FITSData, of the data type of the frame, with its
+ * own statistics, so views stretch and display it like any other frame.
+ */
+namespace FITSThumbnail
+{
+// Longest side of the thumbnails of the capture summary, about the size of the preview
+constexpr int THUMBNAIL_SIZE = 1024;
+
+/**
+ * @brief create Bin @p data down to at most @p maxSize pixels on its longest side.
+ * @return the thumbnail, @p data itself if it is small enough already, or nullptr if the data type
+ * is not supported.
+ */
+QSharedPointer<FITSData> create(const QSharedPointer<FITSData> &data, int maxSize = THUMBNAIL_SIZE);
+
+/** @return the power of two binning that brings @p width x @p height under @p maxSize */
+int binning(int width, int height, int maxSize);
+}
@@ -99,8 +99,11 @@ void FITSView::doStretch(QImage *outputImage)
         tempParams = StretchParams();  // Keeping it linear
     else if (autoStretch)
     {
-        // Compute new auto-stretch params.
-        stretchParams = stretch.computeParams(m_ImageData->getImageBuffer());
+        // Compute new auto-stretch params, reusing the histograms from the statistics pass if available.
+        if (m_ImageData->isFineHistogramConstructed())
+            stretchParams = stretch.computeParams(m_ImageData->getFineHistograms());
+        else
+            stretchParams = stretch.computeParams(m_ImageData->getImageBuffer());
         emit newStretch(stretchParams);
         tempParams = stretchParams;
     }
@@ -257,6 +260,7 @@ FITSView::FITSView(QWidget * parent, FITSMode fitsMode, FITSScale filterType) :
     });
 
     connect(&fitsWatcher, &QFutureWatcher<bool>::finished, this, &FITSView::loadInFrame);
+    connect(&m_FullStretchWatcher, &QFutureWatcher<QImage>::finished, this, &FITSView::finishFullResolutionStretch);
 
     setCursorMode(
         selectCursor); //This is the default mode because the Focus and Align FitsViews should not be in dragMouse mode
@@ -283,6 +287,7 @@ FITSView::~FITSView()
     m_Suspended = true;
     fitsWatcher.waitForFinished();
     wcsWatcher.waitForFinished();
+    m_FullStretchWatcher.waitForFinished();
 }
 
 /**
@@ -334,7 +339,10 @@ void FITSView::setCursorMode(CursorMode mode)
     {
         if (m_ImageData->getWCSState() == FITSData::Idle && !wcsWatcher.isRunning())
         {
-            QFuture<bool> future = QtConcurrent::run(m_ImageData.data(), &FITSData::loadWCS);
+            QFuture<bool> future = ProcessingLanes::run(ProcessingLanes::DISPLAY, [data = m_ImageData.data()]()
+            {
+                return data->loadWCS();
+            });
             wcsWatcher.setFuture(future);
         }
     }
@@ -373,6 +381,7 @@ void FITSView::loadFile(const QString &inFilename)
     fitsWatcher.waitForFinished();
     // In case loadWCS is still running for previous image data, let's wait until it's over
     wcsWatcher.waitForFinished();
+    m_DisplayReleased = false;
 
     //    delete m_ImageData;
     //    m_ImageData = nullptr;
@@ -414,6 +423,7 @@ bool FITSView::loadData(const QSharedPointer<FITSData> &data)
 
     // In case loadWCS is still running for previous image data, let's wait until it's over
     wcsWatcher.waitForFinished();
+    m_DisplayReleased = false;
 
     filterStack.clear();
     filterStack.push(FITS_NONE);
@@ -493,7 +503,18 @@ bool FITSView::processData()
         m_PreviewSampling = m_AdaptiveSampling;
     }
 
+    // For large images in the viewer, show a coarse preview right away and replace it
+    // with the full resolution image once it is stretched in the background.
+    constexpr int progressiveNumPixels = 4000 * 1000;
+    const bool progressive = mode == FITS_NORMAL && Options::progressivePreview() &&
+                             Options::stretchPreviewSampling() > 1 && m_PreviewSampling == m_AdaptiveSampling &&
+                             image_width * image_height / (m_AdaptiveSampling * m_AdaptiveSampling) >= progressiveNumPixels;
+
     // Rescale to fits window on first load
+    cancelFullResolutionStretch();
+    if (progressive)
+        m_PreviewSampling = Options::stretchPreviewSampling() * m_AdaptiveSampling;
+
     if (firstLoad)
     {
         currentZoom = 100;
@@ -523,7 +544,10 @@ bool FITSView::processData()
             Options::autoWCS() &&
             !wcsWatcher.isRunning())
     {
-        QFuture<bool> future = QtConcurrent::run(m_ImageData.data(), &FITSData::loadWCS);
+        QFuture<bool> future = ProcessingLanes::run(ProcessingLanes::DISPLAY, [data = m_ImageData.data()]()
+        {
+            return data->loadWCS();
+        });
         wcsWatcher.setFuture(future);
     }
     else
@@ -543,9 +567,101 @@ bool FITSView::processData()
     // Fore immediate load of frame for first load.
     m_QueueUpdate = true;
     updateFrame(true);
+
+    if (progressive)
+        startFullResolutionStretch();
     return true;
 }
 
+void FITSView::startFullResolutionStretch()
+{
+    const QSharedPointer<FITSData> data = m_ImageData;
+    // The preview stretch already computed any automatic parameters.
+    const StretchParams params = stretchImage ? stretchParams : StretchParams();
+    const int sampling = m_AdaptiveSampling;
+    QImage image = createDisplayImage(sampling);
+
+    // Only one background stretch at a time, a cancelled one may still be running.
+    m_FullStretchWatcher.waitForFinished();
+    m_FullStretchWatcher.setProperty("generation", ++m_FullStretchGeneration);
+    m_FullStretchPending = true;
+    m_FullStretchWatcher.setFuture(ProcessingLanes::run(ProcessingLanes::DISPLAY, [data, params, sampling, image]() mutable
+    {
+        Stretch stretch(static_cast<int>(data->width()), static_cast<int>(data->height()),
+                        data->channels(), data->dataType());
+        stretch.setParams(params);
+        stretch.run(data->getImageBuffer(), &image, sampling);
+        return image;
+    }));
+}
+
+void FITSView::finishFullResolutionStretch()
+{
+    // Anything that re-rendered the image in the meantime (zoom, stretch, new data) cancelled us.
+    if (!m_FullStretchPending || m_FullStretchWatcher.property("generation").toInt() != m_FullStretchGeneration)
+        return;
+
+    m_FullStretchPending = false;
+    m_PreviewSampling = m_AdaptiveSampling;
+    rawImage = m_FullStretchWatcher.result();
+    // Resizes the frame for the new sampling, and lets listeners know the final image is there.
+    m_QueueUpdate = true;
+    updateFrame(true);
+}
+
+void FITSView::cancelFullResolutionStretch()
+{
+    if (!m_FullStretchPending)
+        return;
+
+    // Let the background stretch finish, its result is ignored.
+    m_FullStretchGeneration++;
+    m_FullStretchPending = false;
+    m_PreviewSampling = m_AdaptiveSampling;
+}
+
+void FITSView::releaseDisplay()
+{
+    if (m_DisplayReleased)
+        return;
+
+    fitsWatcher.waitForFinished();
+    cancelFullResolutionStretch();
+    m_FullStretchWatcher.waitForFinished();
+
+    m_DisplayReleased = true;
+    rawImage = QImage();
+    displayPixmap = QPixmap();
+    m_ImageLayer = QPixmap();
+    m_HiPSOverlayPixmap = QPixmap();
+    if (m_ImageFrame)
+        m_ImageFrame->setPixmap(QPixmap());
+}
+
+void FITSView::restoreDisplay()
+{
+    if (!m_DisplayReleased)
+        return;
+
+    m_DisplayReleased = false;
+    if (!m_ImageData)
+        return;
+    if (markStars)
+        searchStars();
+    rescale(ZOOM_KEEP_LEVEL);
+    m_QueueUpdate = true;
+    updateFrame(true);
+}
+
+qint64 FITSView::memoryUsage() const
+{
+    qint64 bytes = rawImage.sizeInBytes() + qint64(displayPixmap.width()) * displayPixmap.height() * displayPixmap.depth() / 8
+                   + qint64(m_ImageLayer.width()) * m_ImageLayer.height() * m_ImageLayer.depth() / 8;
+    if (m_ImageData && !m_ImageData->isImageBufferReleased())
+        bytes += qint64(m_ImageData->samplesPerChannel()) * m_ImageData->channels() * m_ImageData->getBytesPerPixel();
+    return bytes;
+}
+
 void FITSView::loadInFrame()
 {
     m_LastError = m_ImageData->getLastError();
@@ -621,6 +737,9 @@ bool FITSView::rescale(FITSZoom type)
 {
     if (!m_ImageData)
         return false;
+    // Rendered again when the view is restored
+    if (m_DisplayReleased)
+        return true;
 
     int image_width  = m_ImageData->width();
     int image_height = m_ImageData->height();
@@ -676,6 +795,10 @@ bool FITSView::rescale(FITSZoom type)
             break;
     }
 
+    // If the full resolution image isn't ready yet, render it now rather than
+    // re-rendering the preview.
+    cancelFullResolutionStretch();
+
     initDisplayImage();
     m_ImageFrame->setScaledContents(true);
     doStretch(&rawImage);
@@ -780,6 +903,8 @@ void FITSView::setImageMask(ImageMask *mask)
     }
 
     m_ImageMask.reset(mask);
+    // the mosaic mask changes the image layer
+    m_ImageLayer = QPixmap();
 }
 
 // isImageLarge() returns whether we use the large-image rendering strategy or the small-image strategy.
@@ -815,7 +940,7 @@ void FITSView::updateFrame(bool now)
     QMutexLocker locker(&updateMutex);
 
     // Do not process if suspended.
-    if (m_Suspended)
+    if (m_Suspended || m_DisplayReleased)
         return;
 
     // JM 2021-03-13: This timer is used to throttle updateFrame calls to improve performance
@@ -878,9 +1003,43 @@ bool FITSView::initDisplayPixmap(QImage &image, float scale)
     return true;
 }
 
+// The conversion (and for small images the smooth scaling) of the image to a pixmap is done only when the
+// image, the zoom or the mask change. Redrawing the overlays, e.g. for a new guide star position, starts
+// from a copy of that image layer.
+bool FITSView::updateImageLayer(float scale)
+{
+    const QSize size = isLargeImage() ? rawImage.size() : QSize(currentWidth, currentHeight);
+    if (!m_ImageLayer.isNull() && m_ImageLayerKey == rawImage.cacheKey() && m_ImageLayerScale == scale
+            && m_ImageLayerSize == size)
+    {
+        displayPixmap = m_ImageLayer;
+        return true;
+    }
+
+    bool ok;
+    if (isLargeImage())
+        ok = initDisplayPixmap(rawImage, scale);
+    else
+    {
+        QImage scaledImage = rawImage.scaled(currentWidth, currentHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        ok = initDisplayPixmap(scaledImage, scale);
+    }
+    if (!ok)
+    {
+        m_ImageLayer = QPixmap();
+        return false;
+    }
+
+    m_ImageLayer = displayPixmap;
+    m_ImageLayerKey = rawImage.cacheKey();
+    m_ImageLayerScale = scale;
+    m_ImageLayerSize = size;
+    return true;
+}
+
 void FITSView::updateFrameLargeImage()
 {
-    if (!initDisplayPixmap(rawImage, 1.0 / m_PreviewSampling))
+    if (!updateImageLayer(1.0 / m_PreviewSampling))
         return;
     QPainter painter(&displayPixmap);
     // Possibly scale the fonts as we're drawing on the full image, not just the visible part of the scroll window.
@@ -896,8 +1055,7 @@ void FITSView::updateFrameLargeImage()
 
 void FITSView::updateFrameSmallImage()
 {
-    QImage scaledImage = rawImage.scaled(currentWidth, currentHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    if (!initDisplayPixmap(scaledImage, currentZoom / ZOOM_DEFAULT))
+    if (!updateImageLayer(currentZoom / ZOOM_DEFAULT))
         return;
 
     QPainter painter(&displayPixmap);
@@ -1533,8 +1691,8 @@ void FITSView::drawObjectNames(QPainter * painter, double scale)
     painter->setPen(QPen(QColor(KStarsData::Instance()->colorScheme()->colorNamed("FITSObjectLabelColor"))));
     for (const auto &listObject : m_ImageData->getSkyObjects())
     {
-        painter->drawRect(listObject->x() * scale - 5, listObject->y() * scale - 5, 10, 10);
-        painter->drawText(listObject->x() * scale + 10, listObject->y() * scale + 10, listObject->skyObject()->name());
+        painter->drawRect(listObject.x() * scale - 5, listObject.y() * scale - 5, 10, 10);
+        painter->drawText(listObject.x() * scale + 10, listObject.y() * scale + 10, listObject.skyObject()->name());
     }
 }
 
@@ -1989,7 +2147,10 @@ void FITSView::toggleEQGrid()
 
     if (m_ImageData->getWCSState() == FITSData::Idle && !wcsWatcher.isRunning())
     {
-        QFuture<bool> future = QtConcurrent::run(m_ImageData.data(), &FITSData::loadWCS);
+        QFuture<bool> future = ProcessingLanes::run(ProcessingLanes::DISPLAY, [data = m_ImageData.data()]()
+        {
+            return data->loadWCS();
+        });
         wcsWatcher.setFuture(future);
         return;
     }
@@ -2004,7 +2165,10 @@ void FITSView::toggleHiPSOverlay()
 
     if (m_ImageData->getWCSState() == FITSData::Idle && !wcsWatcher.isRunning())
     {
-        QFuture<bool> future = QtConcurrent::run(m_ImageData.data(), &FITSData::loadWCS);
+        QFuture<bool> future = ProcessingLanes::run(ProcessingLanes::DISPLAY, [data = m_ImageData.data()]()
+        {
+            return data->loadWCS();
+        });
         wcsWatcher.setFuture(future);
         return;
     }
@@ -2038,7 +2202,10 @@ void FITSView::toggleObjects()
 
     if (m_ImageData->getWCSState() == FITSData::Idle && !wcsWatcher.isRunning())
     {
-        QFuture<bool> future = QtConcurrent::run(m_ImageData.data(), &FITSData::loadWCS);
+        QFuture<bool> future = ProcessingLanes::run(ProcessingLanes::DISPLAY, [data = m_ImageData.data()]()
+        {
+            return data->loadWCS();
+        });
         wcsWatcher.setFuture(future);
         return;
     }
@@ -2189,7 +2356,8 @@ void FITSView::toggleStars(bool enable)
 {
     markStars = enable;
 
-    if (markStars)
+    // Searched when the view is restored
+    if (markStars && !m_DisplayReleased)
         searchStars();
 }
 
@@ -2317,24 +2485,28 @@ QPoint FITSView::getImagePoint(QPoint viewPortPoint)
 }
 
 void FITSView::initDisplayImage()
+{
+    rawImage = createDisplayImage(m_PreviewSampling);
+}
+
+QImage FITSView::createDisplayImage(int sampling) const
 {
     // Account for leftover when sampling. Thus a 5-wide image sampled by 2
     // would result in a width of 3 (samples 0, 2 and 4).
-    int w = (m_ImageData->width() + m_PreviewSampling - 1) / m_PreviewSampling;
-    int h = (m_ImageData->height() + m_PreviewSampling - 1) / m_PreviewSampling;
+    int w = (m_ImageData->width() + sampling - 1) / sampling;
+    int h = (m_ImageData->height() + sampling - 1) / sampling;
 
     if (m_ImageData->channels() == 1)
     {
-        rawImage = QImage(w, h, QImage::Format_Indexed8);
+        QImage image(w, h, QImage::Format_Indexed8);
 
-        rawImage.setColorCount(256);
+        image.setColorCount(256);
         for (int i = 0; i < 256; i++)
-            rawImage.setColor(i, qRgb(i, i, i));
-    }
-    else
-    {
-        rawImage = QImage(w, h, QImage::Format_RGB32);
+            image.setColor(i, qRgb(i, i, i));
+        return image;
     }
+
+    return QImage(w, h, QImage::Format_RGB32);
 }
 
 /**
@@ -77,6 +77,25 @@ class FITSView : public QScrollArea
 
         // Save FITS
         bool saveImage(const QString &newFilename);
+
+        /**
+         * @brief releaseDisplay Drop the rendered image of a view that is not shown, until restoreDisplay().
+         * Nothing is rendered in between, new data restores the view.
+         */
+        void releaseDisplay();
+        /**
+         * @brief restoreDisplay Render the image dropped by releaseDisplay() again.
+         */
+        void restoreDisplay();
+        bool isDisplayReleased() const
+        {
+            return m_DisplayReleased;
+        }
+        /**
+         * @brief memoryUsage Bytes taken by the pixels of the image and its renders.
+         */
+        qint64 memoryUsage() const;
+
         // Rescale image lineary from image_buffer, fit to window if desired
         bool rescale(FITSZoom type);
 
@@ -364,9 +383,17 @@ class FITSView : public QScrollArea
     private:
         bool processData();
         void doStretch(QImage *outputImage);
+        // Creates an empty display image for the current data, downsampled by sampling.
+        QImage createDisplayImage(int sampling) const;
+        // Stretch the full resolution image in the background, while the preview is displayed.
+        void startFullResolutionStretch();
+        void finishFullResolutionStretch();
+        void cancelFullResolutionStretch();
         double scaleSize(double size);
         bool isLargeImage();
         bool initDisplayPixmap(QImage &image, float space);
+        // Brings the image layer up to date for the current image and scale, returns false on failure
+        bool updateImageLayer(float scale);
         void updateFrameLargeImage();
         void updateFrameSmallImage();
         bool drawHFR(QPainter * painter, const QString &hfr, int x, int y);
@@ -387,6 +414,12 @@ class FITSView : public QScrollArea
         QImage rawImage;
         // Actual pixmap after all the overlays
         QPixmap displayPixmap;
+        // The image alone, as shown at the current zoom. Overlay changes only repaint the overlays over a copy of it.
+        QPixmap m_ImageLayer;
+        // What m_ImageLayer was made from, it is rebuilt when any of them changes
+        qint64 m_ImageLayerKey { 0 };
+        float m_ImageLayerScale { 0 };
+        QSize m_ImageLayerSize;
 
         bool firstLoad { true };
         bool markStars { false };
@@ -420,6 +453,11 @@ class FITSView : public QScrollArea
         bool m_StretchingInProgress { false};
         // Adaptive sampling is based on available RAM
         uint8_t m_AdaptiveSampling {1};
+        // Progressive display: a downsampled preview is shown while the full resolution
+        // image is stretched by this watcher. The generation discards outdated results.
+        QFutureWatcher<QImage> m_FullStretchWatcher;
+        int m_FullStretchGeneration { 0 };
+        bool m_FullStretchPending { false };
 
         // mask for star detection
         QSharedPointer<ImageMask> m_ImageMask;
@@ -461,6 +499,8 @@ class FITSView : public QScrollArea
         int magnifyingGlassY { -1 };
         bool showMagnifyingGlass { false };
         bool m_Suspended {false};
+        // The render was dropped while the view is in the background
+        bool m_DisplayReleased {false};
         // Schedule updated when we have changes that adds
         // information to the view (not just zoom)
         bool m_QueueUpdate {false};
@@ -304,6 +304,13 @@ FITSViewer::FITSViewer(QWidget *parent) : KXmlGuiWindow(parent)
     action->setCheckable(true);
     connect(action, &QAction::triggered, this, &FITSViewer::toggleStars);
 
+    action = actionCollection()->addAction("live_stacking");
+    action->setIcon(QIcon::fromTheme("layer-visible-on"));
+    action->setText(i18n("Live Stacking"));
+    action->setToolTip(i18n("Align and stack the frames received in the current tab"));
+    action->setCheckable(true);
+    connect(action, &QAction::triggered, this, &FITSViewer::toggleLiveStacking);
+
 #ifdef HAVE_DATAVISUALIZATION
     action = actionCollection()->addAction("toggle_3D_graph");
     action->setIcon(QIcon::fromTheme("star_profile", QIcon(":/icons/star_profile.svg")));
@@ -770,6 +777,12 @@ void FITSViewer::tabFocusUpdated(int currentIndex)
     if (currentIndex < 0 || m_Tabs.empty())
         return;
 
+    FITSTab *current = m_Tabs[currentIndex].get();
+    current->restoreMemory();
+    m_TabsByUse.removeOne(current);
+    m_TabsByUse.append(current);
+    applyMemoryBudget();
+
     m_Tabs[currentIndex]->tabPositionUpdated();
 
     auto view = m_Tabs[currentIndex]->getView();
@@ -816,11 +829,45 @@ void FITSViewer::tabFocusUpdated(int currentIndex)
 
     actionCollection()->action("next_blink")->setEnabled(m_Tabs[currentIndex]->blinkFilenames().size() > 1);
     actionCollection()->action("previous_blink")->setEnabled(m_Tabs[currentIndex]->blinkFilenames().size() > 1);
+    actionCollection()->action("live_stacking")->setChecked(m_Tabs[currentIndex]->isLiveStacking());
 
     updateScopeButton();
     updateWCSFunctions();
 }
 
+void FITSViewer::applyMemoryBudget()
+{
+    const qint64 budget = qint64(Options::fitsTabMemoryBudget()) * 1024 * 1024;
+    if (budget <= 0)
+        return;
+
+    // Tabs never viewed come first, then the least recently viewed, the current one is left alone
+    QList<FITSTab *> background;
+    for (auto &tab : m_Tabs)
+    {
+        if (!m_TabsByUse.contains(tab.get()))
+            background.append(tab.get());
+    }
+    background.append(m_TabsByUse.mid(0, m_TabsByUse.size() - 1));
+
+    qint64 total = 0;
+    for (auto &tab : m_Tabs)
+        total += tab->memoryUsage();
+
+    // Renders first, they are made again quickly, then the pixels that have to be read from disk
+    for (bool pixels : {false, true})
+    {
+        for (FITSTab *tab : background)
+        {
+            if (total <= budget)
+                return;
+            total -= tab->memoryUsage();
+            tab->releaseMemory(pixels);
+            total += tab->memoryUsage();
+        }
+    }
+}
+
 void FITSViewer::starProfileButtonOff()
 {
     updateButtonStatus("toggle_3D_graph", i18n("View 3D Graph"), false);
@@ -1225,6 +1272,7 @@ void FITSViewer::closeTab(int index)
 
     fitsMap.remove(UID);
     m_Tabs.removeOne(tab);
+    m_TabsByUse.removeOne(tab.get());
 
     if (m_Tabs.empty())
     {
@@ -1572,6 +1620,20 @@ void FITSViewer::toggleStars()
     }
 }
 
+void FITSViewer::toggleLiveStacking()
+{
+    QAction *action = actionCollection()->action("live_stacking");
+    if (m_Tabs.empty())
+    {
+        action->setChecked(false);
+        return;
+    }
+
+    auto tab = m_Tabs[fitsTabWidget->currentIndex()];
+    tab->setLiveStacking(action->isChecked());
+    updateStatusBar(action->isChecked() ? i18n("Live stacking started") : i18n("Live stacking stopped"), FITS_MESSAGE);
+}
+
 void FITSViewer::applyFilter(int ftype)
 {
     if (m_Tabs.empty())
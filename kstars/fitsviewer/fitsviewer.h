@@ -116,6 +116,7 @@ class FITSViewer : public KXmlGuiWindow
         void updateTabStatus(bool clean, const QUrl &imageURL);
         void closeTab(int index);
         void toggleStars();
+        void toggleLiveStacking();
         void nextTab();
         void previousTab();
         void toggleCrossHair();
@@ -145,6 +146,8 @@ class FITSViewer : public KXmlGuiWindow
         bool addFITSCommon(const QSharedPointer<FITSTab> &tab, const QUrl &imageName,
                            FITSMode mode, const QString &previewText);
         bool updateFITSCommon(const QSharedPointer<FITSTab> &tab, const QUrl &imageName);
+        // Release the memory of the least recently viewed tabs beyond FitsTabMemoryBudget
+        void applyMemoryBudget();
 
         QTabWidget *fitsTabWidget { nullptr };
         QUndoGroup *undoGroup { nullptr };
@@ -154,6 +157,8 @@ class FITSViewer : public KXmlGuiWindow
         QAction *saveFileAction { nullptr };
         QAction *saveFileAsAction { nullptr };
         QList<QSharedPointer<FITSTab>> m_Tabs;
+        // Tabs in the order they were last viewed, the current one last
+        QList<FITSTab *> m_TabsByUse;
         int fitsID { 0 };
         bool markStars { false };
         QMap<int, QSharedPointer<FITSTab>> fitsMap;
@@ -0,0 +1,100 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "auxiliary/processinglanes.h"
+
+#include <QFuture>
+#include <QVector>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/**
+ * Histograms with bins of equal width, built in parallel.
+ *
+ * Every thread counts a band of the samples into private bins, which are merged once all the
+ * bands are done, so no two threads ever write to the same bin.
+ */
+namespace HistogramBins
+{
+
+/// Don't bother other threads for fewer samples than this.
+constexpr uint32_t MinBandSamples = 1 << 16;
+
+/**
+ * @brief accumulate Add the samples of one channel to bins.
+ * @param buffer First sample of the channel.
+ * @param samples Number of samples of the channel.
+ * @param sampleBy Only count every sampleBy-th sample, with a weight of sampleBy.
+ * @param min Value at the centre of the first bin.
+ * @param binWidth Width of a bin.
+ * @param lastBin Samples outside of the bins are counted in bin 0 or lastBin.
+ * @param bins Receives the counts, its size must be larger than lastBin.
+ * @param lane The lane to count in, by default that of the calling task.
+ */
+template <typename T>
+void accumulate(const T *buffer, uint32_t samples, uint32_t sampleBy, double min, double binWidth, int lastBin,
+                QVector<double> &bins, ProcessingLanes::Lane lane = ProcessingLanes::current())
+{
+    const auto binOf = [min, binWidth, lastBin](double value)
+    {
+        // NaN samples land in the first bin.
+        const double id = std::rint((value - min) / binWidth);
+        return !(id > 0) ? 0 : (id >= lastBin ? lastBin : static_cast<int32_t>(id));
+    };
+
+    // 8 and 16 bit samples are binned through a table of all their possible values, which
+    // replaces the division per sample and gives the very same bins.
+    constexpr bool useTable = std::is_same<T, uint8_t>::value || std::is_same<T, uint16_t>::value;
+    QVector<uint16_t> table;
+    if (useTable)
+    {
+        table.resize(static_cast<int>(std::numeric_limits<T>::max()) + 1);
+        for (int value = 0; value < table.size(); value++)
+            table[value] = static_cast<uint16_t>(binOf(value));
+    }
+    const uint16_t *lookup = table.constData();
+
+    sampleBy = qMax(1u, sampleBy);
+    const uint32_t counted = (samples + sampleBy - 1) / sampleBy;
+    const uint32_t bands = qMax(1u, qMin(static_cast<uint32_t>(qMax(1, ProcessingLanes::pool(lane)->maxThreadCount())),
+                                         counted / MinBandSamples));
+    const uint32_t perBand = (counted + bands - 1) / bands;
+    const int binCount = bins.size();
+
+    QList<QFuture<QVector<uint32_t>>> futures;
+    for (uint32_t first = 0; first < counted; first += perBand)
+    {
+        const uint32_t last = qMin(counted, first + perBand);
+        futures.append(ProcessingLanes::run(lane, [ = ]()
+        {
+            QVector<uint32_t> local(binCount, 0);
+            uint32_t *counts = local.data();
+            for (uint32_t k = first; k < last; k++)
+            {
+                const T value = buffer[static_cast<size_t>(k) * sampleBy];
+                if constexpr (useTable)
+                    counts[lookup[value]]++;
+                else
+                    counts[binOf(value)]++;
+            }
+            return local;
+        }));
+    }
+
+    for (auto &future : futures)
+    {
+        const QVector<uint32_t> local = future.result();
+        for (int i = 0; i < binCount; i++)
+            bins[i] += static_cast<double>(local[i]) * sampleBy;
+    }
+}
+
+}
@@ -0,0 +1,102 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "imagebufferpool.h"
+
+#include "ksutils.h"
+
+#include <new>
+
+namespace
+{
+constexpr uint32_t SizeClassGranularity = 64 * 1024;
+constexpr int MaxFreeBuffers = 8;
+}
+
+ImageBufferPool &ImageBufferPool::instance()
+{
+    // Never destroyed, FITSData instances may release their buffers during static destruction.
+    static ImageBufferPool *pool = new ImageBufferPool();
+    return *pool;
+}
+
+uint32_t ImageBufferPool::sizeClass(uint32_t size)
+{
+    const uint64_t rounded = (static_cast<uint64_t>(size) + SizeClassGranularity - 1) / SizeClassGranularity *
+                             SizeClassGranularity;
+    return rounded > UINT32_MAX ? size : static_cast<uint32_t>(rounded);
+}
+
+uint8_t *ImageBufferPool::acquire(uint32_t size)
+{
+    const uint32_t bytes = sizeClass(size);
+
+    QMutexLocker locker(&m_Mutex);
+    for (int i = m_Free.size() - 1; i >= 0; i--)
+    {
+        if (m_Free[i].second == bytes)
+        {
+            uint8_t *buffer = m_Free[i].first;
+            m_Free.remove(i);
+            m_FreeBytes -= bytes;
+            m_Acquired.insert(buffer, bytes);
+            return buffer;
+        }
+    }
+
+    uint8_t *buffer = new (std::nothrow) uint8_t[bytes];
+    if (buffer == nullptr)
+    {
+        // Buffers of other geometries may be what stands in the way.
+        trim(0);
+        buffer = new (std::nothrow) uint8_t[bytes];
+        if (buffer == nullptr)
+            return nullptr;
+    }
+
+    m_Acquired.insert(buffer, bytes);
+    return buffer;
+}
+
+void ImageBufferPool::release(uint8_t *buffer)
+{
+    if (buffer == nullptr)
+        return;
+
+    QMutexLocker locker(&m_Mutex);
+    auto acquired = m_Acquired.find(buffer);
+    if (acquired == m_Acquired.end())
+    {
+        delete[] buffer;
+        return;
+    }
+
+    const uint32_t bytes = acquired.value();
+    m_Acquired.erase(acquired);
+
+    if (m_FreeLimit == 0)
+        m_FreeLimit = KSUtils::isHardwareLimited() ? 256ull * 1024 * 1024 : 1024ull * 1024 * 1024;
+
+    m_Free.append(qMakePair(buffer, bytes));
+    m_FreeBytes += bytes;
+    trim(m_FreeLimit);
+}
+
+void ImageBufferPool::clear()
+{
+    QMutexLocker locker(&m_Mutex);
+    trim(0);
+}
+
+void ImageBufferPool::trim(uint64_t limit)
+{
+    while (!m_Free.isEmpty() && (m_FreeBytes > limit || m_Free.size() > MaxFreeBuffers))
+    {
+        delete[] m_Free.first().first;
+        m_FreeBytes -= m_Free.first().second;
+        m_Free.removeFirst();
+    }
+}
@@ -0,0 +1,60 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+
+#include <cstdint>
+
+/**
+ * @class ImageBufferPool
+ * Recycles the pixel buffers of FITSData instances.
+ *
+ * Guiding, focusing and capturing keep loading frames of the same geometry, so a buffer released
+ * by one frame is kept for the next one of the same size class instead of going back to the heap.
+ * This avoids churning hundreds of megabytes per minute through malloc and fragmenting the heap
+ * on small boards. Only a bounded amount of memory is kept for reuse.
+ */
+class ImageBufferPool
+{
+    public:
+        static ImageBufferPool &instance();
+
+        /**
+         * @brief acquire Get an uninitialized buffer of at least size bytes.
+         * @return the buffer, or nullptr if the memory could not be allocated.
+         */
+        uint8_t *acquire(uint32_t size);
+
+        /**
+         * @brief release Give back a buffer, it may be reused by a later acquire().
+         * @note Buffers allocated elsewhere with new uint8_t[] are simply deleted.
+         */
+        void release(uint8_t *buffer);
+
+        /**
+         * @brief clear Free all the buffers kept for reuse.
+         */
+        void clear();
+
+    private:
+        ImageBufferPool() = default;
+
+        // Frames of the same geometry round to the same class, close ROI sizes share one.
+        static uint32_t sizeClass(uint32_t size);
+        void trim(uint64_t limit);
+
+        QMutex m_Mutex;
+        // Size class of each buffer handed out by acquire().
+        QHash<uint8_t *, uint32_t> m_Acquired;
+        // Released buffers and their size class, oldest first.
+        QVector<QPair<uint8_t *, uint32_t>> m_Free;
+        uint64_t m_FreeBytes { 0 };
+        uint64_t m_FreeLimit { 0 };
+};
@@ -0,0 +1,391 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "livestacker.h"
+
+#include "fits_debug.h"
+#include "fitsdata.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+// Brightest stars of each frame the triangles are made of
+constexpr int MATCH_STARS = 20;
+// Stars matched for a frame to be registered
+constexpr int MIN_MATCHES = 3;
+// Difference of the side ratios under which two triangles have the same shape
+constexpr double TRIANGLE_TOLERANCE = 0.01;
+// Triangles smaller than this, in pixels, are too sensitive to the centroids
+constexpr double MIN_TRIANGLE_SIZE = 10;
+// Change of scale allowed between frames, they come from the same optics
+constexpr double MAX_SCALE_CHANGE = 0.1;
+// Distance in pixels beyond which a matched star is an outlier
+constexpr double MAX_RESIDUAL = 2;
+// Samples of a pixel before its deviation is trusted to reject others
+constexpr uint16_t MIN_REJECTION_FRAMES = 3;
+// Rows each thread resamples
+constexpr int ROW_BAND_HEIGHT = 64;
+
+struct Triangle
+{
+    // Sides relative to the longest one, each vertex is opposite the side of its rank
+    double r1, r2;
+    double longest;
+    int vertex[3];
+};
+
+QVector<Triangle> triangles(const QVector<QPointF> &stars)
+{
+    QVector<Triangle> result;
+    const int n = std::min(int(stars.size()), MATCH_STARS);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = i + 1; j < n; j++)
+        {
+            for (int k = j + 1; k < n; k++)
+            {
+                std::pair<double, int> sides[3] =
+                {
+                    { std::hypot(stars[j].x() - stars[k].x(), stars[j].y() - stars[k].y()), i },
+                    { std::hypot(stars[i].x() - stars[k].x(), stars[i].y() - stars[k].y()), j },
+                    { std::hypot(stars[i].x() - stars[j].x(), stars[i].y() - stars[j].y()), k }
+                };
+                std::sort(std::begin(sides), std::end(sides));
+
+                const double longest = sides[2].first;
+                if (longest < MIN_TRIANGLE_SIZE)
+                    continue;
+                // Vertices could not be told apart if two sides are about the same
+                if ((sides[1].first - sides[0].first) / longest < 2 * TRIANGLE_TOLERANCE ||
+                        (sides[2].first - sides[1].first) / longest < 2 * TRIANGLE_TOLERANCE)
+                    continue;
+
+                result.append({ sides[0].first / longest, sides[1].first / longest, longest,
+                                { sides[0].second, sides[1].second, sides[2].second } });
+            }
+        }
+    }
+    return result;
+}
+
+// Least squares similarity transform taking the first point of each pair to the second
+bool fit(const QVector<QPair<QPointF, QPointF>> &pairs, LiveStacker::Transform &transform)
+{
+    if (pairs.size() < 2)
+        return false;
+
+    QPointF from, to;
+    for (const auto &pair : pairs)
+    {
+        from += pair.first;
+        to += pair.second;
+    }
+    from /= pairs.size();
+    to /= pairs.size();
+
+    double norm = 0, a = 0, b = 0;
+    for (const auto &pair : pairs)
+    {
+        const QPointF p = pair.first - from, q = pair.second - to;
+        norm += p.x() * p.x() + p.y() * p.y();
+        a += p.x() * q.x() + p.y() * q.y();
+        b += p.x() * q.y() - p.y() * q.x();
+    }
+    if (norm <= 0)
+        return false;
+
+    transform.a = a / norm;
+    transform.b = b / norm;
+    transform.tx = to.x() - (transform.a * from.x() - transform.b * from.y());
+    transform.ty = to.y() - (transform.b * from.x() + transform.a * from.y());
+    return true;
+}
+}
+
+double LiveStacker::Transform::scale() const
+{
+    return std::hypot(a, b);
+}
+
+double LiveStacker::Transform::rotation() const
+{
+    return std::atan2(b, a) * 180 / M_PI;
+}
+
+bool LiveStacker::match(const QVector<QPointF> &reference, const QVector<QPointF> &frame, Transform &transform)
+{
+    QVector<Triangle> referenceTriangles = triangles(reference);
+    const QVector<Triangle> frameTriangles = triangles(frame);
+    if (referenceTriangles.isEmpty() || frameTriangles.isEmpty())
+        return false;
+
+    std::sort(referenceTriangles.begin(), referenceTriangles.end(), [](const Triangle & t1, const Triangle & t2)
+    {
+        return t1.r1 < t2.r1;
+    });
+
+    // Each pair of triangles of the same shape votes for its three pairs of vertices
+    const int nReference = std::min(int(reference.size()), MATCH_STARS);
+    const int nFrame = std::min(int(frame.size()), MATCH_STARS);
+    std::vector<int> votes(nReference * nFrame, 0);
+    for (const auto &t : frameTriangles)
+    {
+        auto it = std::lower_bound(referenceTriangles.cbegin(), referenceTriangles.cend(), t.r1 - TRIANGLE_TOLERANCE,
+                                   [](const Triangle & r, double value)
+        {
+            return r.r1 < value;
+        });
+        for (; it != referenceTriangles.cend() && it->r1 <= t.r1 + TRIANGLE_TOLERANCE; ++it)
+        {
+            if (std::fabs(it->r2 - t.r2) > TRIANGLE_TOLERANCE || std::fabs(t.longest / it->longest - 1) > MAX_SCALE_CHANGE)
+                continue;
+            for (int v = 0; v < 3; v++)
+                votes[it->vertex[v] * nFrame + t.vertex[v]]++;
+        }
+    }
+
+    // A star is matched to the one it shares most triangles with, both ways
+    QVector<QPair<QPointF, QPointF>> pairs;
+    for (int i = 0; i < nReference; i++)
+    {
+        const auto row = votes.cbegin() + i * nFrame;
+        const int j = int(std::max_element(row, row + nFrame) - row);
+        if (row[j] < 2)
+            continue;
+
+        bool mutual = true;
+        for (int k = 0; k < nReference && mutual; k++)
+            mutual = k == i || votes[k * nFrame + j] < row[j];
+        if (mutual)
+            pairs.append({ reference[i], frame[j] });
+    }
+
+    // Drop the worst match until all of them agree
+    while (pairs.size() >= MIN_MATCHES)
+    {
+        if (!fit(pairs, transform))
+            return false;
+
+        int worst = -1;
+        double worstResidual = MAX_RESIDUAL;
+        for (int i = 0; i < pairs.size(); i++)
+        {
+            const QPointF d = transform.map(pairs[i].first) - pairs[i].second;
+            const double residual = std::hypot(d.x(), d.y());
+            if (residual > worstResidual)
+            {
+                worst = i;
+                worstResidual = residual;
+            }
+        }
+
+        if (worst < 0)
+            return std::fabs(transform.scale() - 1) <= MAX_SCALE_CHANGE;
+        pairs.remove(worst);
+    }
+    return false;
+}
+
+void LiveStacker::setSigmaRejection(double kappa)
+{
+    m_Kappa = std::max(0.0, kappa);
+    if (m_Kappa > 0 && m_M2.size() != m_Mean.size())
+        m_M2.assign(m_Mean.size(), 0);
+}
+
+void LiveStacker::reset()
+{
+    m_Width = m_Height = m_Channels = 0;
+    m_ReferenceStars.clear();
+    m_Mean.clear();
+    m_M2.clear();
+    m_Count.clear();
+    m_Frames = m_Rejected = 0;
+}
+
+QVector<QPointF> LiveStacker::stars(const QSharedPointer<FITSData> &frame)
+{
+    if (!frame->areStarsFound(ALGORITHM_SEP))
+        frame->findStars(ALGORITHM_SEP).waitForFinished();
+
+    QList<Edge *> edges = frame->getStarCenters();
+    std::sort(edges.begin(), edges.end(), [](const Edge * e1, const Edge * e2)
+    {
+        return e1->sum > e2->sum;
+    });
+
+    QVector<QPointF> result;
+    for (int i = 0; i < edges.size() && i < MATCH_STARS; i++)
+        result.append(QPointF(edges[i]->x, edges[i]->y));
+    return result;
+}
+
+void LiveStacker::start(const QSharedPointer<FITSData> &frame, const QVector<QPointF> &stars)
+{
+    reset();
+    m_Width = frame->width();
+    m_Height = frame->height();
+    m_Channels = frame->channels();
+    m_ReferenceStars = stars;
+
+    const size_t samples = size_t(m_Width) * m_Height * m_Channels;
+    m_Mean.assign(samples, 0);
+    m_Count.assign(samples, 0);
+    if (m_Kappa > 0)
+        m_M2.assign(samples, 0);
+}
+
+LiveStacker::Result LiveStacker::add(const QSharedPointer<FITSData> &frame)
+{
+    if (frame.isNull())
+        return NO_STARS;
+
+    const QVector<QPointF> frameStars = stars(frame);
+    if (frameStars.size() < MIN_MATCHES)
+    {
+        m_Rejected++;
+        return NO_STARS;
+    }
+
+    Result result = STACKED;
+    Transform transform;
+    if (m_Frames == 0 || frame->width() != m_Width || frame->height() != m_Height || frame->channels() != m_Channels)
+    {
+        start(frame, frameStars);
+        result = REFERENCE;
+    }
+    else if (!match(m_ReferenceStars, frameStars, transform))
+    {
+        qCDebug(KSTARS_FITS) << "Live stacking could not register frame" << m_Frames + m_Rejected + 1;
+        m_Rejected++;
+        return NOT_REGISTERED;
+    }
+
+    qCDebug(KSTARS_FITS) << "Live stacking frame shifted by" << transform.tx << transform.ty << "rotated by"
+                         << transform.rotation() << "degrees";
+
+    const uint8_t *buffer = frame->getImageBuffer();
+    switch (frame->getStatistics().dataType)
+    {
+        case TSHORT:
+            accumulate(reinterpret_cast<const int16_t *>(buffer), transform);
+            break;
+        case TUSHORT:
+            accumulate(reinterpret_cast<const uint16_t *>(buffer), transform);
+            break;
+        case TLONG:
+            accumulate(reinterpret_cast<const int32_t *>(buffer), transform);
+            break;
+        case TULONG:
+            accumulate(reinterpret_cast<const uint32_t *>(buffer), transform);
+            break;
+        case TFLOAT:
+            accumulate(reinterpret_cast<const float *>(buffer), transform);
+            break;
+        case TLONGLONG:
+            accumulate(reinterpret_cast<const int64_t *>(buffer), transform);
+            break;
+        case TDOUBLE:
+            accumulate(reinterpret_cast<const double *>(buffer), transform);
+            break;
+        default:
+        case TBYTE:
+            accumulate(buffer, transform);
+            break;
+    }
+
+    m_Frames++;
+    return result;
+}
+
+template <typename T>
+void LiveStacker::accumulate(const T *buffer, const Transform &transform)
+{
+    const int width = m_Width, height = m_Height;
+    const size_t plane = size_t(width) * height;
+
+    QVector<int> bands;
+    for (int y = 0; y < height; y += ROW_BAND_HEIGHT)
+        bands.append(y);
+
+    // Each band only writes the pixels of its own rows
+    QtConcurrent::blockingMap(bands, [&](int &band)
+    {
+        for (int y = band; y < std::min(band + ROW_BAND_HEIGHT, height); y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                // Where the pixel of the reference falls in the frame
+                const QPointF p = transform.map(QPointF(x, y));
+                if (p.x() < 0 || p.y() < 0 || p.x() > width - 1 || p.y() > height - 1)
+                    continue;
+
+                const int x0 = int(p.x()), y0 = int(p.y());
+                const int x1 = std::min(x0 + 1, width - 1), y1 = std::min(y0 + 1, height - 1);
+                const float fx = p.x() - x0, fy = p.y() - y0;
+
+                for (int c = 0; c < m_Channels; c++)
+                {
+                    const T *channel = buffer + c * plane;
+                    const float top = channel[y0 * width + x0] * (1 - fx) + channel[y0 * width + x1] * fx;
+                    const float bottom = channel[y1 * width + x0] * (1 - fx) + channel[y1 * width + x1] * fx;
+                    const float value = top * (1 - fy) + bottom * fy;
+
+                    const size_t index = c * plane + size_t(y) * width + x;
+                    uint16_t &count = m_Count[index];
+                    float &mean = m_Mean[index];
+                    if (count == std::numeric_limits<uint16_t>::max())
+                        continue;
+
+                    if (m_Kappa > 0 && count >= MIN_REJECTION_FRAMES)
+                    {
+                        const float sigma = std::sqrt(m_M2[index] / (count - 1));
+                        if (sigma > 0 && std::fabs(value - mean) > m_Kappa * sigma)
+                            continue;
+                    }
+
+                    // Welford's update of the mean and the squared deviations
+                    count++;
+                    const float delta = value - mean;
+                    mean += delta / count;
+                    if (m_Kappa > 0)
+                        m_M2[index] += delta * (value - mean);
+                }
+            }
+        }
+    });
+}
+
+QSharedPointer<FITSData> LiveStacker::stack() const
+{
+    if (m_Frames == 0)
+        return QSharedPointer<FITSData>();
+
+    const uint32_t samples = uint32_t(m_Mean.size());
+    auto *buffer = new uint8_t[samples * sizeof(float)];
+    memcpy(buffer, m_Mean.data(), samples * sizeof(float));
+
+    FITSImage::Statistic stats;
+    stats.width = m_Width;
+    stats.height = m_Height;
+    stats.channels = m_Channels;
+    stats.dataType = TFLOAT;
+    stats.bytesPerPixel = sizeof(float);
+    stats.ndim = m_Channels == 1 ? 2 : 3;
+    stats.samples_per_channel = uint32_t(m_Width) * m_Height;
+
+    QSharedPointer<FITSData> data(new FITSData());
+    data->restoreStatistics(stats);
+    data->setProperty("dataType", stats.dataType);
+    data->setImageBuffer(buffer);
+    data->calculateStats(true);
+    return data;
+}
@@ -0,0 +1,115 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QPointF>
+#include <QSharedPointer>
+#include <QVector>
+
+#include <cstdint>
+#include <vector>
+
+class FITSData;
+
+/**
+ * @class LiveStacker
+ * @short Stacks frames as they arrive, for electronically assisted astronomy.
+ *
+ * The first frame is the reference. The stars of every further frame are matched to those of the
+ * reference by the shape of the triangles they form, which gives the shift, rotation and scale of
+ * the frame. The frame is then resampled onto the reference and folded into the running mean of
+ * each pixel, so adding a frame costs one pass over it whatever the number of frames stacked.
+ *
+ * With sigma rejection, the variance of each pixel is kept as well, and a pixel of a frame that
+ * is too far from the mean is left out, which removes satellite trails, planes and hot pixels.
+ */
+class LiveStacker
+{
+    public:
+        /** @brief Similarity transform from the reference to a frame */
+        struct Transform
+        {
+            // x' = a x - b y + tx, y' = b x + a y + ty
+            double a { 1 }, b { 0 }, tx { 0 }, ty { 0 };
+
+            QPointF map(const QPointF &p) const
+            {
+                return QPointF(a * p.x() - b * p.y() + tx, b * p.x() + a * p.y() + ty);
+            }
+            double scale() const;
+            /** @return the rotation in degrees */
+            double rotation() const;
+        };
+
+        typedef enum
+        {
+            STACKED,        // The frame was added to the stack
+            REFERENCE,      // The frame is the new reference, the stack was started again
+            NO_STARS,       // Too few stars were found in the frame
+            NOT_REGISTERED  // The stars of the frame could not be matched to the reference
+        } Result;
+
+        /** @brief setSigmaRejection Leave out pixels further than @p kappa standard deviations from the mean, 0 to stack them all */
+        void setSigmaRejection(double kappa);
+
+        /**
+         * @brief add Register @p frame against the reference and add it to the stack.
+         * @note The stars of the frame are detected with SEP if they were not, which blocks. A frame of
+         * another size or number of channels than the reference starts a new stack.
+         */
+        Result add(const QSharedPointer<FITSData> &frame);
+
+        /** @return the mean of the stacked frames as 32-bit floats, nullptr if nothing was stacked */
+        QSharedPointer<FITSData> stack() const;
+
+        /** @brief reset Forget the stack, the next frame is the reference */
+        void reset();
+
+        /** @return the number of frames in the stack, the reference included */
+        int frames() const
+        {
+            return m_Frames;
+        }
+
+        /** @return the number of frames that could not be registered */
+        int rejectedFrames() const
+        {
+            return m_Rejected;
+        }
+
+        /**
+         * @brief match Find the transform from @p reference stars to @p frame stars
+         * @param reference positions of the reference stars, brightest first
+         * @param frame positions of the stars of the frame, brightest first
+         * @param transform set to the transform that was found
+         * @return false if too few stars could be matched
+         */
+        static bool match(const QVector<QPointF> &reference, const QVector<QPointF> &frame, Transform &transform);
+
+    private:
+        // The brightest stars of the frame, detecting them if needed
+        static QVector<QPointF> stars(const QSharedPointer<FITSData> &frame);
+
+        void start(const QSharedPointer<FITSData> &frame, const QVector<QPointF> &stars);
+
+        template <typename T>
+        void accumulate(const T *buffer, const Transform &transform);
+
+        int m_Width { 0 };
+        int m_Height { 0 };
+        int m_Channels { 0 };
+        QVector<QPointF> m_ReferenceStars;
+
+        // Running mean, sum of squared deviations and count of each sample, channels one after the other
+        std::vector<float> m_Mean;
+        std::vector<float> m_M2;
+        std::vector<uint16_t> m_Count;
+
+        double m_Kappa { 0 };
+        int m_Frames { 0 };
+        int m_Rejected { 0 };
+};
@@ -4,10 +4,15 @@
 */
 
 #include "stretch.h"
+#include "finehistogram.h"
+#include "auxiliary/kstrace.h"
+#include "auxiliary/processinglanes.h"
 
 #include <fitsio.h>
 #include <math.h>
-#include <QtConcurrent>
+
+#include <limits>
+#include <type_traits>
 
 namespace
 {
@@ -45,165 +50,153 @@ T median(T const *values, int size, int sampleBy)
     return median(samples);
 }
 
-// This stretches one channel given the input parameters.
+// The stretch transfer function of one channel given the input parameters.
 // Based on the spec in section 8.5.6
 // https://pixinsight.com/doc/docs/XISF-1.0-spec/XISF-1.0-spec.html
-// Uses multiple threads, blocks until done.
 // The extension parameters are not used.
-// Sampling is applied to the output (that is, with sampling=2, we compute every other output
-// sample both in width and height, so the output would have about 4X fewer pixels.
 template <typename T>
-void stretchOneChannel(T *input_buffer, QImage *output_image,
-                       const StretchParams &stretch_params,
-                       int input_range, int image_height, int image_width, int sampling)
+class ChannelStretch
 {
-    QVector<QFuture<void>> futures;
+    public:
+        ChannelStretch(const StretchParams1Channel &params, int inputRange)
+        {
+            // Maximum possible input value (e.g. 1024*64 - 1 for a 16 bit unsigned int).
+            const float maxInput = inputRange > 1 ? inputRange - 1 : inputRange;
+
+            midtones = params.midtones;
+            const float highlights = params.highlights;
+            const float shadows    = params.shadows;
+
+            // Precomputed expressions moved out of the loop.
+            // highlights - shadows, protecting for divide-by-0, in a 0->1.0 scale.
+            const float hsRangeFactor = highlights == shadows ? 1.0f : 1.0f / (highlights - shadows);
+            // Shadow and highlight values translated to the ADU scale.
+            nativeShadows = shadows * maxInput;
+            nativeHighlights = highlights * maxInput;
+            // Constants based on above needed for the stretch calculations.
+            k1 = (midtones - 1) * hsRangeFactor * maxOutput / maxInput;
+            k2 = ((2 * midtones) - 1) * hsRangeFactor / maxInput;
+        }
 
-    // We're outputting uint8, so the max output is 255.
-    constexpr int maxOutput = 255;
+        uint8_t operator()(T input) const
+        {
+            if (input < nativeShadows) return 0;
+            else if (input >= nativeHighlights) return maxOutput;
+            const T inputFloored = (input - nativeShadows);
+            return (inputFloored * k1) / (inputFloored * k2 - midtones);
+        }
 
-    // Maximum possible input value (e.g. 1024*64 - 1 for a 16 bit unsigned int).
-    const float maxInput = input_range > 1 ? input_range - 1 : input_range;
+    private:
+        // We're outputting uint8, so the max output is 255.
+        static constexpr int maxOutput = 255;
 
-    const float midtones   = stretch_params.grey_red.midtones;
-    const float highlights = stretch_params.grey_red.highlights;
-    const float shadows    = stretch_params.grey_red.shadows;
+        float midtones;
+        float k1;
+        float k2;
+        T nativeShadows;
+        T nativeHighlights;
+};
 
-    // Precomputed expressions moved out of the loop.
-    // highlights - shadows, protecting for divide-by-0, in a 0->1.0 scale.
-    const float hsRangeFactor = highlights == shadows ? 1.0f : 1.0f / (highlights - shadows);
-    // Shadow and highlight values translated to the ADU scale.
-    const T nativeShadows = shadows * maxInput;
-    const T nativeHighlights = highlights * maxInput;
-    // Constants based on above needed for the stretch calculations.
-    const float k1 = (midtones - 1) * hsRangeFactor * maxOutput / maxInput;
-    const float k2 = ((2 * midtones) - 1) * hsRangeFactor / maxInput;
+// For 8 and 16 bit unsigned input, the transfer function over the whole input range is
+// cheaper to tabulate once than to evaluate for each of the millions of pixels.
+template <typename T>
+constexpr bool useLookupTable()
+{
+    return std::is_same<T, uint8_t>::value || std::is_same<T, unsigned short>::value;
+}
 
-    // Increment the input index by the sampling, the output index increments by 1.
-    for (int j = 0, jout = 0; j < image_height; j += sampling, jout++)
-    {
-        futures.append(QtConcurrent::run([ = ]()
+template <typename T>
+class LookupStretch
+{
+    public:
+        explicit LookupStretch(const ChannelStretch<T> &stretch)
+            : table(static_cast<int>(std::numeric_limits<T>::max()) + 1)
         {
-            T * inputLine  = input_buffer + j * image_width;
-            auto * scanLine = output_image->scanLine(jout);
+            for (int i = 0; i < table.size(); i++)
+                table[i] = stretch(static_cast<T>(i));
+        }
 
-            for (int i = 0, iout = 0; i < image_width; i += sampling, iout++)
-            {
-                const T input = inputLine[i];
-                if (input < nativeShadows) scanLine[iout] = 0;
-                else if (input >= nativeHighlights) scanLine[iout] = maxOutput;
-                else
-                {
-                    const T inputFloored = (input - nativeShadows);
-                    scanLine[iout] = (inputFloored * k1) / (inputFloored * k2 - midtones);
-                }
-            }
+        uint8_t operator()(T input) const
+        {
+            return table[input];
+        }
+
+    private:
+        QVector<uint8_t> table;
+};
+
+// Runs function(firstRow, lastRow) on bands of output rows, one band per pool thread or so.
+// Uses multiple threads, blocks until done. Stretching for the screen runs in the display lane,
+// unless a module stretches its frame in its own lane.
+template <typename F>
+void runInRowBands(int outputHeight, const F &function)
+{
+    const ProcessingLanes::Lane lane = ProcessingLanes::current(ProcessingLanes::DISPLAY);
+    const int numBands = qMax(1, qMin(outputHeight, 2 * ProcessingLanes::pool(lane)->maxThreadCount()));
+    const int bandHeight = (outputHeight + numBands - 1) / numBands;
+
+    QVector<QFuture<void>> futures;
+    for (int first = 0; first < outputHeight; first += bandHeight)
+    {
+        const int last = qMin(outputHeight, first + bandHeight);
+        futures.append(ProcessingLanes::run(lane, [ &function, first, last]()
+        {
+            function(first, last);
         }));
     }
     for(QFuture<void> future : futures)
         future.waitForFinished();
 }
 
+// This stretches one channel given the input parameters.
+// Sampling is applied to the output (that is, with sampling=2, we compute every other output
+// sample both in width and height, so the output would have about 4X fewer pixels.
+template <typename T, typename S>
+void stretchOneChannel(T *input_buffer, QImage *output_image, const S &stretch,
+                       int image_width, int sampling)
+{
+    runInRowBands(output_image->height(), [ &, input_buffer](int first, int last)
+    {
+        // Increment the input index by the sampling, the output index increments by 1.
+        for (int jout = first; jout < last; jout++)
+        {
+            T * inputLine  = input_buffer + jout * sampling * image_width;
+            auto * scanLine = output_image->scanLine(jout);
+
+            for (int i = 0, iout = 0; i < image_width; i += sampling, iout++)
+                scanLine[iout] = stretch(inputLine[i]);
+        }
+    });
+}
+
 // This is like the above 1-channel stretch, but extended for 3 channels.
-// This could have been more modular, but the three channels are combined
-// into a single qRgb value at the end, so it seems the simplest thing is to
-// replicate the code. It is assume the colors are not interleaved--the red image
+// The three channels are combined into a single qRgb value at the end.
+// It is assume the colors are not interleaved--the red image
 // is stored fully, then the green, then the blue.
 // Sampling is applied to the output (that is, with sampling=2, we compute every other output
 // sample both in width and height, so the output would have about 4X fewer pixels.
-template <typename T>
+template <typename T, typename S>
 void stretchThreeChannels(T *inputBuffer, QImage *outputImage,
-                          const StretchParams &stretchParams,
-                          int inputRange, int imageHeight, int imageWidth, int sampling)
+                          const S &stretchR, const S &stretchG, const S &stretchB,
+                          int imageHeight, int imageWidth, int sampling)
 {
-    QVector<QFuture<void>> futures;
-
-    // We're outputting uint8, so the max output is 255.
-    constexpr int maxOutput = 255;
-
-    // Maximum possible input value (e.g. 1024*64 - 1 for a 16 bit unsigned int).
-    const float maxInput = inputRange > 1 ? inputRange - 1 : inputRange;
-
-    const float midtonesR   = stretchParams.grey_red.midtones;
-    const float highlightsR = stretchParams.grey_red.highlights;
-    const float shadowsR    = stretchParams.grey_red.shadows;
-    const float midtonesG   = stretchParams.green.midtones;
-    const float highlightsG = stretchParams.green.highlights;
-    const float shadowsG    = stretchParams.green.shadows;
-    const float midtonesB   = stretchParams.blue.midtones;
-    const float highlightsB = stretchParams.blue.highlights;
-    const float shadowsB    = stretchParams.blue.shadows;
-
-    // Precomputed expressions moved out of the loop.
-    // highlights - shadows, protecting for divide-by-0, in a 0->1.0 scale.
-    const float hsRangeFactorR = highlightsR == shadowsR ? 1.0f : 1.0f / (highlightsR - shadowsR);
-    const float hsRangeFactorG = highlightsG == shadowsG ? 1.0f : 1.0f / (highlightsG - shadowsG);
-    const float hsRangeFactorB = highlightsB == shadowsB ? 1.0f : 1.0f / (highlightsB - shadowsB);
-    // Shadow and highlight values translated to the ADU scale.
-    const T nativeShadowsR = shadowsR * maxInput;
-    const T nativeShadowsG = shadowsG * maxInput;
-    const T nativeShadowsB = shadowsB * maxInput;
-    const T nativeHighlightsR = highlightsR * maxInput;
-    const T nativeHighlightsG = highlightsG * maxInput;
-    const T nativeHighlightsB = highlightsB * maxInput;
-    // Constants based on above needed for the stretch calculations.
-    const float k1R = (midtonesR - 1) * hsRangeFactorR * maxOutput / maxInput;
-    const float k1G = (midtonesG - 1) * hsRangeFactorG * maxOutput / maxInput;
-    const float k1B = (midtonesB - 1) * hsRangeFactorB * maxOutput / maxInput;
-    const float k2R = ((2 * midtonesR) - 1) * hsRangeFactorR / maxInput;
-    const float k2G = ((2 * midtonesG) - 1) * hsRangeFactorG / maxInput;
-    const float k2B = ((2 * midtonesB) - 1) * hsRangeFactorB / maxInput;
-
     const int size = imageWidth * imageHeight;
 
-    for (int j = 0, jout = 0; j < imageHeight; j += sampling, jout++)
+    runInRowBands(outputImage->height(), [ &, inputBuffer](int first, int last)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        for (int jout = first; jout < last; jout++)
         {
             // R, G, B input images are stored one after another.
-            T * inputLineR  = inputBuffer + j * imageWidth;
+            T * inputLineR  = inputBuffer + jout * sampling * imageWidth;
             T * inputLineG  = inputLineR + size;
             T * inputLineB  = inputLineG + size;
 
             auto * scanLine = reinterpret_cast<QRgb*>(outputImage->scanLine(jout));
 
             for (int i = 0, iout = 0; i < imageWidth; i += sampling, iout++)
-            {
-                const T inputR = inputLineR[i];
-                const T inputG = inputLineG[i];
-                const T inputB = inputLineB[i];
-
-                uint8_t red, green, blue;
-
-                if (inputR < nativeShadowsR) red = 0;
-                else if (inputR >= nativeHighlightsR) red = maxOutput;
-                else
-                {
-                    const T inputFloored = (inputR - nativeShadowsR);
-                    red = (inputFloored * k1R) / (inputFloored * k2R - midtonesR);
-                }
-
-                if (inputG < nativeShadowsG) green = 0;
-                else if (inputG >= nativeHighlightsG) green = maxOutput;
-                else
-                {
-                    const T inputFloored = (inputG - nativeShadowsG);
-                    green = (inputFloored * k1G) / (inputFloored * k2G - midtonesG);
-                }
-
-                if (inputB < nativeShadowsB) blue = 0;
-                else if (inputB >= nativeHighlightsB) blue = maxOutput;
-                else
-                {
-                    const T inputFloored = (inputB - nativeShadowsB);
-                    blue = (inputFloored * k1B) / (inputFloored * k2B - midtonesB);
-                }
-                scanLine[iout] = qRgb(red, green, blue);
-            }
-        }));
-    }
-    for(QFuture<void> future : futures)
-        future.waitForFinished();
+                scanLine[iout] = qRgb(stretchR(inputLineR[i]), stretchG(inputLineG[i]), stretchB(inputLineB[i]));
+        }
+    });
 }
 
 template <typename T>
@@ -211,37 +204,33 @@ void stretchChannels(T *input_buffer, QImage *output_image,
                      const StretchParams &stretch_params,
                      int input_range, int image_height, int image_width, int num_channels, int sampling)
 {
+    using V = typename std::remove_const<T>::type;
+    const ChannelStretch<V> stretchR(stretch_params.grey_red, input_range);
     if (num_channels == 1)
-        stretchOneChannel(input_buffer, output_image, stretch_params, input_range,
-                          image_height, image_width, sampling);
+    {
+        if constexpr (useLookupTable<V>())
+            stretchOneChannel(input_buffer, output_image, LookupStretch<V>(stretchR), image_width, sampling);
+        else
+            stretchOneChannel(input_buffer, output_image, stretchR, image_width, sampling);
+    }
     else if (num_channels == 3)
-        stretchThreeChannels(input_buffer, output_image, stretch_params, input_range,
-                             image_height, image_width, sampling);
-}
-
-// See section 8.5.7 in above link  https://pixinsight.com/doc/docs/XISF-1.0-spec/XISF-1.0-spec.html
-template <typename T>
-void computeParamsOneChannel(T const *buffer, StretchParams1Channel *params,
-                             int inputRange, int height, int width)
-{
-    // Find the median sample.
-    constexpr int maxSamples = 500000;
-    const int sampleBy = width * height < maxSamples ? 1 : width * height / maxSamples;
-
-    T medianSample = median(buffer, width * height, sampleBy);
-    // Find the Median deviation: 1.4826 * median of abs(sample[i] - median).
-    const int numSamples = width * height / sampleBy;
-    std::vector<T> deviations(numSamples);
-    for (int index = 0, i = 0; i < numSamples; ++i, index += sampleBy)
     {
-        if (medianSample > buffer[index])
-            deviations[i] = medianSample - buffer[index];
+        const ChannelStretch<V> stretchG(stretch_params.green, input_range);
+        const ChannelStretch<V> stretchB(stretch_params.blue, input_range);
+        if constexpr (useLookupTable<V>())
+            stretchThreeChannels(input_buffer, output_image, LookupStretch<V>(stretchR),
+                                 LookupStretch<V>(stretchG), LookupStretch<V>(stretchB), image_height, image_width, sampling);
         else
-            deviations[i] = buffer[index] - medianSample;
+            stretchThreeChannels(input_buffer, output_image, stretchR, stretchG, stretchB,
+                                 image_height, image_width, sampling);
     }
+}
 
+// See section 8.5.7 in above link  https://pixinsight.com/doc/docs/XISF-1.0-spec/XISF-1.0-spec.html
+// Computes the parameters given the median sample and the median of abs(sample[i] - median).
+void computeParamsFromMedian(float medianSample, float medDev, StretchParams1Channel *params, int inputRange)
+{
     // Shift everything to 0 -> 1.0.
-    const float medDev = median(deviations);
     const float normalizedMedian = medianSample / static_cast<float>(inputRange);
     const float MADN = 1.4826 * medDev / static_cast<float>(inputRange);
 
@@ -279,6 +268,37 @@ void computeParamsOneChannel(T const *buffer, StretchParams1Channel *params,
     params->highlights_expansion = 1.0;
 }
 
+template <typename T>
+void computeParamsOneChannel(T const *buffer, StretchParams1Channel *params,
+                             int inputRange, int height, int width)
+{
+    // Find the median sample.
+    constexpr int maxSamples = 500000;
+    const int sampleBy = width * height < maxSamples ? 1 : width * height / maxSamples;
+
+    T medianSample = median(buffer, width * height, sampleBy);
+    // Find the Median deviation: 1.4826 * median of abs(sample[i] - median).
+    const int numSamples = width * height / sampleBy;
+    std::vector<T> deviations(numSamples);
+    for (int index = 0, i = 0; i < numSamples; ++i, index += sampleBy)
+    {
+        if (medianSample > buffer[index])
+            deviations[i] = medianSample - buffer[index];
+        else
+            deviations[i] = buffer[index] - medianSample;
+    }
+
+    computeParamsFromMedian(medianSample, median(deviations), params, inputRange);
+}
+
+// Same as above, but the median and median deviation are read from a full resolution histogram,
+// so neither sampling nor sorting is needed.
+void computeParamsOneChannel(const QVector<uint32_t> &histogram, StretchParams1Channel *params, int inputRange)
+{
+    const int medianSample = FineHistogram::percentile(histogram, 0.5);
+    computeParamsFromMedian(medianSample, FineHistogram::medianDeviation(histogram, medianSample), params, inputRange);
+}
+
 // Need to know the possible range of input values.
 // Using the type of the sample and guessing.
 // Perhaps we should examine the contents for the file
@@ -319,6 +339,7 @@ Stretch::Stretch(int width, int height, int channels, int data_type)
 
 void Stretch::run(uint8_t const *input, QImage *outputImage, int sampling)
 {
+    KSTRACE_SCOPE("fits", "stretch");
     Q_ASSERT(outputImage->width() == (image_width + sampling - 1) / sampling);
     Q_ASSERT(outputImage->height() == (image_height + sampling - 1) / sampling);
     recalculateInputRange(input);
@@ -439,3 +460,15 @@ StretchParams Stretch::computeParams(uint8_t const *input)
     }
     return result;
 }
+
+StretchParams Stretch::computeParams(const QVector<QVector<uint32_t>> &histograms)
+{
+    StretchParams result;
+    for (int channel = 0; channel < image_channels && channel < histograms.size(); ++channel)
+    {
+        StretchParams1Channel *params = channel == 0 ? &result.grey_red :
+                                        (channel == 1 ? &result.green : &result.blue);
+        computeParamsOneChannel(histograms[channel], params, input_range);
+    }
+    return result;
+}
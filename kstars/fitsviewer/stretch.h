@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <QImage>
+#include <QVector>
 
 struct StretchParams1Channel
 {
@@ -68,6 +69,12 @@ class Stretch
          */
         StretchParams computeParams(const uint8_t *input);
 
+        /**
+         * @brief computeParams Same as above, but uses full resolution histograms of 8 or 16 bit
+         * integer data (one bin per ADU value, one vector per channel) instead of sampling the image.
+         */
+        StretchParams computeParams(const QVector<QVector<uint32_t>> &histograms);
+
         /**
          * @brief run run the stretch algorithm according to the params given
          * placing the output in output_image.
@@ -26,6 +26,8 @@ void SummaryFITSView::createFloatingToolBar()
                                                          i18n("Show Capture Process Information"),
                                                          this, SLOT(toggleShowProcessInfo()));
     toggleProcessInfoAction->setCheckable(true);
+    floatingToolBar->addAction(QIcon::fromTheme("zoom-original"), i18n("Show Full Resolution"), this,
+                               &SummaryFITSView::fullResolutionRequested);
 }
 
 void SummaryFITSView::showProcessInfo(bool show)
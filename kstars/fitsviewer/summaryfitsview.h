@@ -32,6 +32,10 @@ public slots:
 
     void resizeEvent(QResizeEvent *event) override;
 
+signals:
+    // the frame is shown as a thumbnail, and the user asked for all of it
+    void fullResolutionRequested();
+
 private:
     // floating bar
     bool m_showProcessInfo { false };
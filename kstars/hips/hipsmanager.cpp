@@ -10,6 +10,7 @@
 
 #include "auxiliary/kspaths.h"
 #include "auxiliary/ksuserdb.h"
+#include "auxiliary/memorybudget.h"
 #include "kstars.h"
 #include "kstarsdata.h"
 #include "kstars_debug.h"
@@ -18,14 +19,19 @@
 
 #include <KConfigDialog>
 
+#include <QElapsedTimer>
 #include <QTime>
 #include <QHash>
 #include <QNetworkDiskCache>
 #include <QPainter>
+#include <QtConcurrent>
 
 static QNetworkDiskCache *g_discCache = nullptr;
 static UrlFileDownload *g_download = nullptr;
 
+// Prefetching stops while this many tiles are still on their way
+static const int g_maxPendingPrefetch = 16;
+
 static int qHash(const pixCacheKey_t &key, uint seed)
 {
     return qHash(QString("%1_%2_%3").arg(key.level).arg(key.pix).arg(key.uid), seed);
@@ -76,8 +82,12 @@ HIPSManager::HIPSManager() : QObject(KStars::Instance())
     qint64 net = Options::hIPSNetCache();
     qint64 value = net * 1024 * 1024;
     g_discCache->setMaximumCacheSize(Options::hIPSNetCache() * 1024 * 1024);
-    value = Options::hIPSMemoryCache() * 1024 * 1024;
-    m_cache.setMaxCost(Options::hIPSMemoryCache() * 1024 * 1024);
+    setMemoryCacheSize();
+    // Tiles are downloaded again, or read from the disk cache, when they are needed
+    connect(MemoryBudget::Instance(), &MemoryBudget::lowMemory, this, [this]()
+    {
+        m_cache.clear();
+    });
 
 
 
@@ -110,8 +120,27 @@ void HIPSManager::showSettings()
     dialog->show();
 }
 
+void HIPSManager::setMemoryCacheSize()
+{
+    qint64 decoded = Options::hIPSMemoryCache() * 1024LL * 1024;
+    qint64 encoded = Options::hIPSCompressedCache() * 1024LL * 1024;
+
+    // The decoded tiles get most of the share, the encoded ones take a fraction of the space
+    const qint64 share = MemoryBudget::Instance()->share(MemoryBudget::HIPS);
+    if (share > 0)
+    {
+        decoded = qMin(decoded, share * 3 / 4);
+        encoded = qMin(encoded, share / 4);
+    }
+    m_cache.setMaxCost(static_cast<int>(decoded));
+    m_cache.setMaxEncodedCost(static_cast<int>(encoded));
+}
+
 void HIPSManager::slotApply()
 {
+    g_discCache->setMaximumCacheSize(Options::hIPSNetCache() * 1024 * 1024);
+    setMemoryCacheSize();
+
     if (Options::hIPSUseOfflineSource())
     {
         QDir hipsDirectory(Options::hIPSOfflinePath());
@@ -168,6 +197,8 @@ QImage *HIPSManager::getPix(bool allsky, int level, int pix, bool &freeImage)
     key.pix = pix;
     key.uid = m_uid;
 
+    m_frameKeys.insert(key);
+
     pixCacheItem_t *item = getCacheItem(key);
 
     if (m_downloadMap.contains(key))
@@ -200,6 +231,8 @@ QImage *HIPSManager::getPix(bool allsky, int level, int pix, bool &freeImage)
 
     if (item != nullptr)
     {
+        m_cache.countHit();
+
         QImage *cacheImage = item->image;
 
         Q_ASSERT(!item->image->isNull());
@@ -222,13 +255,57 @@ QImage *HIPSManager::getPix(bool allsky, int level, int pix, bool &freeImage)
         return cacheImage;
     }
 
+    // Only dropped from the decoded images, decode it again
+    const QByteArray *data = m_cache.getEncoded(key);
+    if (data != nullptr)
+    {
+        m_cache.countEncodedHit();
+        decode(key, *data);
+        return nullptr;
+    }
+
+    m_cache.countMiss();
+    download(key, allsky);
+
+    return nullptr;
+}
+
+void HIPSManager::prefetch(int level, int pix)
+{
+    if (Options::hIPSUseOfflineSource() == false && m_currentSource.isEmpty())
+        return;
+
+    pixCacheKey_t key { level, pix, m_uid };
+
+    m_frameKeys.insert(key);
+
+    if (m_downloadMap.contains(key) || g_download->pending() >= g_maxPendingPrefetch)
+        return;
+
+    // Tiles still at hand encoded are only decoded once they come into view
+    if (getCacheItem(key) == nullptr && m_cache.getEncoded(key) == nullptr)
+        download(key, false);
+}
+
+void HIPSManager::endFrame()
+{
+    g_download->abortObsolete([this](const pixCacheKey_t &key)
+    {
+        return !m_frameKeys.contains(key);
+    });
+
+    m_frameKeys.clear();
+}
+
+void HIPSManager::download(const pixCacheKey_t &key, bool allsky)
+{
     QString path;
 
     if (!allsky)
     {
-        int dir = (pix / 10000) * 10000;
+        int dir = (key.pix / 10000) * 10000;
 
-        path = "/Norder" + QString::number(level) + "/Dir" + QString::number(dir) + "/Npix" + QString::number(pix) +
+        path = "/Norder" + QString::number(key.level) + "/Dir" + QString::number(dir) + "/Npix" + QString::number(key.pix) +
                '.' + m_currentFormat;
     }
     else
@@ -240,8 +317,6 @@ QImage *HIPSManager::getPix(bool allsky, int level, int pix, bool &freeImage)
     downloadURL.setPath(downloadURL.path() + path);
     g_download->begin(downloadURL, key);
     m_downloadMap.insert(key);
-
-    return nullptr;
 }
 
 
@@ -348,22 +423,8 @@ void HIPSManager::slotDone(QNetworkReply::NetworkError error, QByteArray &data,
 {
     if (error == QNetworkReply::NoError)
     {
-        m_downloadMap.remove(key);
-
-        auto *item = new pixCacheItem_t;
-
-        item->image = new QImage();
-        if (item->image->loadFromData(data))
-        {
-            addToMemoryCache(key, item);
-
-            //SkyMap::Instance()->forceUpdate();
-        }
-        else
-        {
-            delete item;
-            qCWarning(KSTARS) << "no image. Data size: " << data.length();
-        }
+        m_cache.addEncoded(key, data);
+        decode(key, data);
     }
     else
     {
@@ -387,6 +448,52 @@ void HIPSManager::removeTimer(pixCacheKey_t &key)
     emit sigRepaint();
 }
 
+void HIPSManager::decode(const pixCacheKey_t &key, const QByteArray &data)
+{
+    // The tile stays in the download map until it is decoded, so that getPix() neither
+    // requests it again nor stops drawing its parent in the meantime.
+    m_downloadMap.insert(key);
+
+    QtConcurrent::run(&m_decodePool, [this, data, key]()
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        auto *image = new QImage();
+        if (!image->loadFromData(data))
+        {
+            qCWarning(KSTARS) << "no image. Data size: " << data.length();
+            delete image;
+            image = nullptr;
+        }
+
+        qint64 usecs = timer.nsecsElapsed() / 1000;
+
+        QMetaObject::invokeMethod(this, [this, key, image, usecs]()
+        {
+            tileDecoded(key, image, usecs);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void HIPSManager::tileDecoded(pixCacheKey_t key, QImage *image, qint64 usecs)
+{
+    m_downloadMap.remove(key);
+    m_cache.countDecode(usecs);
+
+    if (image == nullptr)
+    {
+        m_cache.removeEncoded(key);
+        return;
+    }
+
+    auto *item = new pixCacheItem_t;
+    item->image = image;
+    addToMemoryCache(key, item);
+
+    //SkyMap::Instance()->forceUpdate();
+}
+
 PixCache *HIPSManager::getCache()
 {
     return &m_cache;
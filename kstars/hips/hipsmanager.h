@@ -14,6 +14,7 @@
 #include "urlfiledownload.h"
 
 #include <QObject>
+#include <QThreadPool>
 
 #include <memory>
 
@@ -53,6 +54,19 @@ class HIPSManager : public QObject
 
         QImage *getPix(bool allsky, int level, int pix, bool &freeImage);
 
+        /**
+         * @brief prefetch Request a tile that is not in view yet but likely to be soon.
+         * Unlike getPix(), this does not request it while too many downloads are pending,
+         * but still keeps a pending download of it from being aborted by endFrame().
+         */
+        void prefetch(int level, int pix);
+
+        /**
+         * @brief endFrame Abort the pending downloads of tiles neither drawn nor prefetched
+         * since the last call, e.g. after panning or zooming away from them.
+         */
+        void endFrame();
+
         void readSources();
 
         void cancelAll();
@@ -116,9 +130,17 @@ class HIPSManager : public QObject
 
         // Cache
         PixCache m_cache;
+        // Tiles being downloaded or decoded
         QSet <pixCacheKey_t> m_downloadMap;
+        // Tiles asked for in the current frame
+        QSet <pixCacheKey_t> m_frameKeys;
 
+        // Sets the memory cache sizes from the options, within the memory budget
+        void setMemoryCacheSize();
         void addToMemoryCache(pixCacheKey_t &key, pixCacheItem_t *item);
+        void download(const pixCacheKey_t &key, bool allsky);
+        void decode(const pixCacheKey_t &key, const QByteArray &data);
+        void tileDecoded(pixCacheKey_t key, QImage *image, qint64 usecs);
         pixCacheItem_t *getCacheItem(pixCacheKey_t &key);
 
         // List of all sources in the database
@@ -139,4 +161,7 @@ class HIPSManager : public QObject
         uint16_t m_currentTileWidth { 0 };
         QUrl m_currentURL;
         QMap<int, int> m_OfflineLevelsMap;
+
+        // Decodes the downloaded tiles, destroyed (and waited for) first
+        QThreadPool m_decodePool;
 };
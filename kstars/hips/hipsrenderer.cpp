@@ -15,9 +15,16 @@
 #include "skyqpainter.h"
 #include "projections/projector.h"
 
+#include <algorithm>
+
+static QVector3D toVector(double ra, double de)
+{
+    return QVector3D(cos(de) * cos(ra), cos(de) * sin(ra), sin(de));
+}
+
 HIPSRenderer::HIPSRenderer()
 {
-    m_scanRender.reset(new ScanRender());
+    m_scanRender.reset(new ParallelScanRender());
     m_HEALpix.reset(new HEALPix());
 }
 
@@ -96,21 +103,35 @@ bool HIPSRenderer::render(uint16_t w, uint16_t h, QImage *hipsImage, const Proje
     m_scanRender->setBilinearInterpolationEnabled(Options::hIPSBiLinearInterpolation()
             && (size >= HIPSManager::Instance()->getCurrentTileWidth() || allSky));
 
-    renderRec(allSky, level, centerPix, hipsImage);
+    // Only queues the tiles, which are then drawn in bands in parallel
+    renderRec(allSky, level, centerPix);
+    m_scanRender->render(hipsImage);
+
+    qDeleteAll(m_freeImages);
+    m_freeImages.clear();
 
     m_scanRender->setBilinearInterpolationEnabled(old);
 
+    if (Options::hIPSShowGrid())
+        drawGrid(hipsImage);
+
+    if (!allSky)
+        prefetch(level, toVector(ra, de), fov);
+
+    // Drop the downloads of tiles we have moved away from
+    HIPSManager::Instance()->endFrame();
+
     return true;
 }
 
-void HIPSRenderer::renderRec(bool allsky, int level, int pix, QImage *pDest)
+void HIPSRenderer::renderRec(bool allsky, int level, int pix)
 {
     if (m_renderedMap.contains(pix))
     {
         return;
     }
 
-    if (renderPix(allsky, level, pix, pDest))
+    if (renderPix(allsky, level, pix))
     {
         m_renderedMap.insert(pix);
         int dirs[8];
@@ -118,14 +139,14 @@ void HIPSRenderer::renderRec(bool allsky, int level, int pix, QImage *pDest)
 
         m_HEALpix->neighbours(nside, pix, dirs);
 
-        renderRec(allsky, level, dirs[0], pDest);
-        renderRec(allsky, level, dirs[2], pDest);
-        renderRec(allsky, level, dirs[4], pDest);
-        renderRec(allsky, level, dirs[6], pDest);
+        renderRec(allsky, level, dirs[0]);
+        renderRec(allsky, level, dirs[2]);
+        renderRec(allsky, level, dirs[4]);
+        renderRec(allsky, level, dirs[6]);
     }
 }
 
-bool HIPSRenderer::renderPix(bool allsky, int level, int pix, QImage *pDest)
+bool HIPSRenderer::renderPix(bool allsky, int level, int pix)
 {
     SkyPoint cornerSkyCoords[4];
     QPointF cornerScreenCoords[4];
@@ -215,31 +236,19 @@ bool HIPSRenderer::renderPix(bool allsky, int level, int pix, QImage *pDest)
 
                     for (int i = 0; i < 4; i++)
                         fineScreenCoords[i] = m_projector->toScreen(&fineSkyPoints[i]);
-                    m_scanRender->renderPolygon(3, fineScreenCoords, pDest, image, uv[j]);
+                    m_scanRender->addPolygon(3, fineScreenCoords, image, uv[j]);
                     j++;
                 }
             }
 
             if (freeImage)
-            {
-                delete image;
-            }
+                m_freeImages.append(image);
         }
 
         if (Options::hIPSShowGrid())
         {
-            QPainter p(pDest);
-            p.setRenderHint(QPainter::Antialiasing);
-            p.setPen(gridColor);
-
-            p.drawLine(cornerScreenCoords[0].x(), cornerScreenCoords[0].y(), cornerScreenCoords[1].x(), cornerScreenCoords[1].y());
-            p.drawLine(cornerScreenCoords[1].x(), cornerScreenCoords[1].y(), cornerScreenCoords[2].x(), cornerScreenCoords[2].y());
-            p.drawLine(cornerScreenCoords[2].x(), cornerScreenCoords[2].y(), cornerScreenCoords[3].x(), cornerScreenCoords[3].y());
-            p.drawLine(cornerScreenCoords[3].x(), cornerScreenCoords[3].y(), cornerScreenCoords[0].x(), cornerScreenCoords[0].y());
-            p.drawText((cornerScreenCoords[0].x() + cornerScreenCoords[1].x() + cornerScreenCoords[2].x() + cornerScreenCoords[3].x()) /
-                       4,
-                       (cornerScreenCoords[0].y() + cornerScreenCoords[1].y() + cornerScreenCoords[2].y() + cornerScreenCoords[3].y()) / 4,
-                       QString::number(pix) + " / " + QString::number(level));
+            m_gridCells.append(QPolygonF({ cornerScreenCoords[0], cornerScreenCoords[1], cornerScreenCoords[2], cornerScreenCoords[3] }));
+            m_gridLabels.append(QString::number(pix) + " / " + QString::number(level));
         }
 
         return true;
@@ -247,3 +256,106 @@ bool HIPSRenderer::renderPix(bool allsky, int level, int pix, QImage *pDest)
 
     return false;
 }
+
+void HIPSRenderer::prefetch(int level, const QVector3D &center, double fov)
+{
+    HIPSManager *manager = HIPSManager::Instance();
+
+    const QVector3D motion = (level == m_lastLevel) ? (center - m_lastCenter).normalized() : QVector3D();
+
+    if (m_lastFov > 0 && fov != m_lastFov)
+        m_zoom = (fov < m_lastFov) ? -1 : 1;
+
+    m_lastCenter = center;
+    m_lastFov    = fov;
+    m_lastLevel  = level;
+
+    // Pixels sorted by their distance from the center, those ahead of the panning direction first
+    auto byDistance = [](const QPair<float, int> &a, const QPair<float, int> &b)
+    {
+        return a.first < b.first;
+    };
+
+    QVector<QPair<float, int>> rendered;
+    for (int pix : m_renderedMap)
+        rendered.append(qMakePair((pixCenter(level, pix) - center).length(), pix));
+    std::sort(rendered.begin(), rendered.end(), byDistance);
+
+    QSet<int> seen = m_renderedMap;
+    QVector<QPair<float, int>> ring;
+    int dirs[8];
+    int nside = 1 << level;
+
+    for (const auto &one : rendered)
+    {
+        m_HEALpix->neighbours(nside, one.second, dirs);
+
+        for (int neighbour : dirs)
+        {
+            if (neighbour < 0 || seen.contains(neighbour))
+                continue;
+
+            seen.insert(neighbour);
+
+            QVector3D offset = pixCenter(level, neighbour) - center;
+            float ahead      = QVector3D::dotProduct(offset.normalized(), motion);
+            ring.append(qMakePair(offset.length() * (1 - 0.9f * ahead), neighbour));
+        }
+    }
+    std::sort(ring.begin(), ring.end(), byDistance);
+
+    // The tiles of the level we're zooming towards come first
+    if (m_zoom < 0 && level < manager->getCurrentOrder() && manager->getUsableLevel(level + 1) == level + 1)
+    {
+        int childs[4];
+
+        for (const auto &one : rendered)
+        {
+            m_HEALpix->getPixChilds(one.second, childs);
+
+            for (int child : childs)
+                manager->prefetch(level + 1, child);
+        }
+    }
+    else if (m_zoom > 0 && level > 3 && manager->getUsableLevel(level - 1) == level - 1)
+    {
+        for (const auto &one : rendered)
+            manager->prefetch(level - 1, one.second / 4);
+    }
+
+    for (const auto &one : ring)
+        manager->prefetch(level, one.second);
+}
+
+QVector3D HIPSRenderer::pixCenter(int level, int pix)
+{
+    SkyPoint cornerSkyCoords[4];
+    QVector3D sum;
+
+    m_HEALpix->getCornerPoints(level, pix, cornerSkyCoords);
+
+    for (const auto &corner : cornerSkyCoords)
+        sum += toVector(corner.ra0().radians(), corner.dec0().radians());
+
+    return sum.normalized();
+}
+
+void HIPSRenderer::drawGrid(QImage *pDest)
+{
+    QPainter p(pDest);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setPen(gridColor);
+
+    for (int i = 0; i < m_gridCells.size(); i++)
+    {
+        const QPolygonF &cell = m_gridCells[i];
+
+        p.drawPolygon(cell);
+        p.drawText((cell[0].x() + cell[1].x() + cell[2].x() + cell[3].x()) / 4,
+                   (cell[0].y() + cell[1].y() + cell[2].y() + cell[3].y()) / 4,
+                   m_gridLabels[i]);
+    }
+
+    m_gridCells.clear();
+    m_gridLabels.clear();
+}
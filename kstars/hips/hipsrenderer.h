@@ -12,6 +12,9 @@
 #include "hipsmanager.h"
 #include "scanrender.h"
 
+#include <QPolygonF>
+#include <QVector3D>
+
 #include <memory>
 
 class Projector;
@@ -23,8 +26,9 @@ public:
   explicit HIPSRenderer();
   //void render(mapView_t *view, CSkPainter *painter, QImage *pDest);
   bool render(uint16_t w, uint16_t h, QImage *hipsImage, const Projector *m_proj);
-  void renderRec(bool allsky, int level, int pix, QImage *pDest);
-  bool renderPix(bool allsky, int level, int pix, QImage *pDest);
+  void renderRec(bool allsky, int level, int pix);
+  bool renderPix(bool allsky, int level, int pix);
+  void prefetch(int level, const QVector3D &center, double fov);
 
 signals:
 
@@ -36,7 +40,22 @@ private:
   int m_size { 0 };
   QSet<int>  m_renderedMap;
   std::unique_ptr<HEALPix> m_HEALpix;
-  std::unique_ptr<ScanRender> m_scanRender;
+  std::unique_ptr<ParallelScanRender> m_scanRender;
+  // Images to free once the frame is drawn
+  QVector<QImage *> m_freeImages;
+  // Corners of the grid cells to draw over the tiles, and their labels
+  QVector<QPolygonF> m_gridCells;
+  QStringList m_gridLabels;
   const Projector *m_projector;
   QColor gridColor;
+
+  // View of the previous frame, to tell which way it is moving
+  QVector3D m_lastCenter;
+  double m_lastFov { 0 };
+  int m_lastLevel { 0 };
+  // Last change of the field of view: -1 zooming in, 1 zooming out
+  int m_zoom { 0 };
+
+  QVector3D pixCenter(int level, int pix);
+  void drawGrid(QImage *pDest);
 };
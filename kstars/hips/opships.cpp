@@ -52,6 +52,28 @@ OpsHIPSCache::OpsHIPSCache() : QFrame(KStars::Instance())
         HIPSManager::Instance()->setOfflineLevels(orders);
         HIPSManager::Instance()->setCurrentSource("DSS Colored");
     });
+
+    connect(&m_statisticsTimer, &QTimer::timeout, this, &OpsHIPSCache::slotUpdateStatistics);
+    m_statisticsTimer.start(1000);
+    slotUpdateStatistics();
+}
+
+void OpsHIPSCache::slotUpdateStatistics()
+{
+    if (!isVisible() && !statisticsLabel->text().isEmpty())
+        return;
+
+    PixCache *cache = HIPSManager::Instance()->getCache();
+    const auto &statistics = cache->statistics();
+    const double average = statistics.decodes > 0 ? statistics.decodeTime / 1000.0 / statistics.decodes : 0;
+
+    statisticsLabel->setText(i18n("Decoded: %1 MB, %2 hits\n"
+                                  "Compressed: %3 MB, %4 hits\n"
+                                  "Misses: %5\n"
+                                  "Decoded tiles: %6, %7 ms on average",
+                                  QString::number(cache->used() / 1048576.0, 'f', 1), statistics.hits,
+                                  QString::number(cache->usedEncoded() / 1048576.0, 'f', 1), statistics.encodedHits,
+                                  statistics.misses, statistics.decodes, QString::number(average, 'f', 1)));
 }
 
 OpsHIPS::OpsHIPS() : QFrame(KStars::Instance())
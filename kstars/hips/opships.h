@@ -10,6 +10,8 @@
 #include "ui_opshipsdisplay.h"
 #include "ui_opshipscache.h"
 
+#include <QTimer>
+
 class KConfigDialog;
 class FileDownloader;
 
@@ -27,6 +29,12 @@ class OpsHIPSCache : public QFrame, public Ui::OpsHIPSCache
 
   public:
     explicit OpsHIPSCache();
+
+  private slots:
+    void slotUpdateStatistics();
+
+  private:
+    QTimer m_statisticsTimer;
 };
 
 /**
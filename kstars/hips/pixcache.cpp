@@ -48,6 +48,12 @@ void PixCache::setMaxCost(int maxCost)
   m_cache.setMaxCost(maxCost);
 }
 
+void PixCache::clear()
+{
+  m_cache.clear();
+  m_encoded.clear();
+}
+
 void PixCache::printCache()
 {
   qDebug() << Q_FUNC_INFO << " -- cache ---------------";
@@ -58,3 +64,35 @@ int PixCache::used()
 {
   return m_cache.totalCost();
 }
+
+void PixCache::addEncoded(pixCacheKey_t &key, const QByteArray &data)
+{
+  if (data.size() < m_encoded.maxCost())
+    m_encoded.insert(key, new QByteArray(data), data.size());
+}
+
+const QByteArray *PixCache::getEncoded(pixCacheKey_t &key)
+{
+  return m_encoded.object(key);
+}
+
+void PixCache::removeEncoded(pixCacheKey_t &key)
+{
+  m_encoded.remove(key);
+}
+
+void PixCache::setMaxEncodedCost(int maxCost)
+{
+  m_encoded.setMaxCost(maxCost);
+}
+
+int PixCache::usedEncoded()
+{
+  return m_encoded.totalCost();
+}
+
+void PixCache::countDecode(qint64 usecs)
+{
+  m_statistics.decodes++;
+  m_statistics.decodeTime += usecs;
+}
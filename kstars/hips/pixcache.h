@@ -8,20 +8,53 @@
 
 #include "hips.h"
 
+#include <QByteArray>
 #include <QCache>
 
+/**
+ * Memory cache of HiPS tiles in two tiers: the decoded images, ready to be drawn,
+ * and the encoded (JPEG/PNG) data as downloaded, which takes a fraction of the
+ * space. A tile dropped from the decoded tier can thus be decoded again without
+ * going to the disk cache or the network.
+ */
 class PixCache
 {
 public:
   PixCache() = default;
 
+  struct statistics_t
+  {
+    quint64 hits { 0 };           // found decoded
+    quint64 encodedHits { 0 };    // found encoded only, decoded again
+    quint64 misses { 0 };         // had to be downloaded
+    quint64 decodes { 0 };
+    qint64  decodeTime { 0 };     // total, in microseconds
+  };
+
   void add(pixCacheKey_t &key, pixCacheItem_t *item, int cost);
   pixCacheItem_t *get(pixCacheKey_t &key);
   void setMaxCost(int maxCost);
   void printCache();
   int  used();
 
+  void addEncoded(pixCacheKey_t &key, const QByteArray &data);
+  const QByteArray *getEncoded(pixCacheKey_t &key);
+  void removeEncoded(pixCacheKey_t &key);
+  void setMaxEncodedCost(int maxCost);
+  int  usedEncoded();
+
+  // Drops all tiles, decoded and encoded
+  void clear();
+
+  void countHit() { m_statistics.hits++; }
+  void countEncodedHit() { m_statistics.encodedHits++; }
+  void countMiss() { m_statistics.misses++; }
+  void countDecode(qint64 usecs);
+  const statistics_t &statistics() const { return m_statistics; }
+
 private:  
   QCache <pixCacheKey_t, pixCacheItem_t> m_cache;
+  QCache <pixCacheKey_t, QByteArray> m_encoded;
+  statistics_t m_statistics;
 };
 
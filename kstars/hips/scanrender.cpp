@@ -8,6 +8,14 @@
 
 #include "scanrender.h"
 
+#include <QThread>
+#include <QtConcurrent>
+#include <QtMath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 //#include <omp.h>
 //#define PARALLEL_OMP
 
@@ -19,6 +27,36 @@
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wcast-align"
 
+#ifdef __SSE2__
+// Bilinear interpolation between the pixels a b (top) and c d (bottom) at fx, fy,
+// all four channels at once in 16 bit lanes, with weights of 8 bit precision.
+static inline quint32 bilinearSSE2(quint32 a, quint32 b, quint32 c, quint32 d, float fx, float fy)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i half = _mm_set1_epi16(128);
+  const short wx = fx * 256 + 0.5f;
+  const short wy = fy * 256 + 0.5f;
+  const short wx1 = 256 - wx;
+
+  // a, c in the lower and b, d in the upper four lanes
+  __m128i ab = _mm_unpacklo_epi8(_mm_set_epi32(0, 0, static_cast<int>(b), static_cast<int>(a)), zero);
+  __m128i cd = _mm_unpacklo_epi8(_mm_set_epi32(0, 0, static_cast<int>(d), static_cast<int>(c)), zero);
+  const __m128i weights = _mm_set_epi16(wx, wx, wx, wx, wx1, wx1, wx1, wx1);
+
+  ab = _mm_mullo_epi16(ab, weights);
+  cd = _mm_mullo_epi16(cd, weights);
+
+  __m128i top = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(ab, _mm_srli_si128(ab, 8)), half), 8);
+  __m128i bottom = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(cd, _mm_srli_si128(cd, 8)), half), 8);
+  __m128i v = _mm_add_epi16(_mm_mullo_epi16(top, _mm_set1_epi16(256 - wy)),
+                            _mm_mullo_epi16(bottom, _mm_set1_epi16(wy)));
+
+  v = _mm_srli_epi16(_mm_add_epi16(v, half), 8);
+
+  return static_cast<quint32>(_mm_cvtsi128_si32(_mm_packus_epi16(v, v))) | 0xff000000;
+}
+#endif
+
 //////////////////////////////
 ScanRender::ScanRender(void)
 //////////////////////////////
@@ -53,7 +91,15 @@ void ScanRender::resetScanPoly(int sx, int sy)
   }
 
   m_sx = sx;
-  m_sy = sy;
+  m_sy = qMin(sy, m_bottom);
+}
+
+///////////////////////////////////////////////
+void ScanRender::setBand(int top, int bottom)
+///////////////////////////////////////////////
+{
+  m_top = top;
+  m_bottom = bottom;
 }
 
 //////////////////////////////////////////////////////////
@@ -73,7 +119,7 @@ void ScanRender::scanLine(int x1, int y1, int x2, int y2)
     side = 1;
   }
 
-  if (y2 < 0)
+  if (y2 < m_top)
   {
     return; // offscreen
   }
@@ -99,12 +145,12 @@ void ScanRender::scanLine(int x1, int y1, int x2, int y2)
     y2 = m_sy - 1;
   }
 
-  if (y1 < 0)
+  if (y1 < m_top)
   { // partially off screen
-    float m = (float) -y1;
+    float m = (float) (m_top - y1);
 
     x += dx * m;
-    y1 = 0;
+    y1 = m_top;
   }
 
   int minY = qMin(y1, y2);
@@ -168,7 +214,7 @@ void ScanRender::scanLine(int x1, int y1, int x2, int y2, float u1, float v1, fl
     side = 1;
   }
 
-  if (y2 < 0)
+  if (y2 < m_top)
     return; // offscreen
   if (y1 >= m_sy)
     return; // offscreen
@@ -191,15 +237,15 @@ void ScanRender::scanLine(int x1, int y1, int x2, int y2, float u1, float v1, fl
   duv[0] = (u2 - u1) / dy;
   duv[1] = (v2 - v1) / dy;
 
-  if (y1 < 0)
+  if (y1 < m_top)
   { // partially off screen
-    float m = (float) -y1;
+    float m = (float) (m_top - y1);
 
     uv[0] += duv[0] * m;
     uv[1] += duv[1] * m;
 
     x += dx * m;
-    y1 = 0;
+    y1 = m_top;
   }
 
   int minY = qMin(y1, y2);
@@ -333,7 +379,7 @@ void ScanRender::renderPolygon(QImage *dst, QImage *src)
     renderPolygonNI(dst, src);
 }
 
-void ScanRender::renderPolygon(int interpolation, QPointF *pts, QImage *pDest, QImage *pSrc, QPointF *uv)
+void ScanRender::renderPolygon(int interpolation, const QPointF *pts, QImage *pDest, QImage *pSrc, const QPointF *uv)
 {
   QPointF Auv = uv[0];
   QPointF Buv = uv[1];
@@ -613,6 +659,11 @@ void ScanRender::renderPolygonBI(QImage *dst, QImage *src)
         quint32 c = bitsSrc[(index + sw) % size];
         quint32 d = bitsSrc[(index + sw + 1) % size];
 
+#ifdef __SSE2__
+        Q_UNUSED(x_1diff);
+        Q_UNUSED(y_1diff);
+        *pDst = bilinearSSE2(a, b, c, d, x_diff, y_diff);
+#else
         int qxy1 = (x_1diff * y_1diff) * 65536;
         int qxy2 =(x_diff * y_1diff) * 65536;
         int qxy = (x_diff * y_diff) * 65536;
@@ -628,6 +679,7 @@ void ScanRender::renderPolygonBI(QImage *dst, QImage *src)
         int red = (((a>>16)&0xff)*(qxy1) + ((b>>16)&0xff)*(qxy2) +((c>>16)&0xff)*(qyx1)  + ((d>>16)&0xff)*(qxy)) >> 16;
 
         *pDst = 0xff000000 | (((red)<<16)&0xff0000) | (((green)<<8)&0xff00) | (blue);
+#endif
 
         pDst++;
 
@@ -879,4 +931,82 @@ void ScanRender::renderPolygonAlphaNI(QImage *dst, QImage *src)
   }  
 }
 
+void ParallelScanRender::setBilinearInterpolationEnabled(bool enable)
+{
+  bBilinear = enable;
+}
+
+bool ParallelScanRender::isBilinearInterpolationEnabled() const
+{
+  return bBilinear;
+}
+
+void ParallelScanRender::addPolygon(int interpolation, const QPointF *pts, QImage *pSrc, const QPointF *uv)
+{
+  polygon_t polygon;
+
+  polygon.interpolation = interpolation;
+  polygon.src = pSrc;
+  polygon.minY = qFloor(pts[0].y());
+  polygon.maxY = qCeil(pts[0].y());
+
+  for (int i = 0; i < 4; i++)
+  {
+    polygon.pts[i] = pts[i];
+    polygon.uv[i] = uv[i];
+    polygon.minY = qMin(polygon.minY, qFloor(pts[i].y()));
+    polygon.maxY = qMax(polygon.maxY, qCeil(pts[i].y()));
+  }
+
+  m_polygons.append(polygon);
+}
+
+void ParallelScanRender::render(QImage *pDest)
+{
+  if (m_polygons.isEmpty())
+    return;
+
+  int height = pDest->height();
+  int count = qBound(1, QThread::idealThreadCount(), qMax(1, height / 16));
+  int bandHeight = (height + count - 1) / count;
+
+  if (static_cast<int>(m_bands.size()) != count)
+  {
+    m_bands.clear();
+    m_bands.resize(count);
+  }
+
+  for (int i = 0; i < count; i++)
+  {
+    if (!m_bands[i].render)
+      m_bands[i].render.reset(new ScanRender());
+
+    m_bands[i].top = i * bandHeight;
+    m_bands[i].bottom = qMin(height, (i + 1) * bandHeight);
+    m_bands[i].render->setBand(m_bands[i].top, m_bands[i].bottom);
+    m_bands[i].render->setBilinearInterpolationEnabled(bBilinear);
+  }
+
+  // Detach the destination once here, each band then writes its own rows through a QImage of its own
+  uchar *bits = pDest->bits();
+  int width = pDest->width();
+  int bytesPerLine = pDest->bytesPerLine();
+  QImage::Format format = pDest->format();
+
+  QtConcurrent::blockingMap(m_bands, [&](band_t &band)
+  {
+    QImage dest(bits, width, height, bytesPerLine, format);
+
+    for (const polygon_t &polygon : qAsConst(m_polygons))
+    {
+      if (polygon.maxY < band.top || polygon.minY >= band.bottom)
+        continue;
+
+      band.render->renderPolygon(polygon.interpolation, polygon.pts, &dest, polygon.src, polygon.uv);
+    }
+  });
+
+  m_polygons.clear();
+}
+
 #pragma GCC diagnostic pop
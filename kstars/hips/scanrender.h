@@ -11,6 +11,10 @@
 #include <QImage>
 #include <QColor>
 #include <QPointF>
+#include <QVector>
+
+#include <memory>
+#include <vector>
 
 #define MAX_BK_SCANLINES      32000
 
@@ -28,11 +32,13 @@ class ScanRender
     void setBilinearInterpolationEnabled(bool enable);
     bool isBilinearInterpolationEnabled(void);
     void resetScanPoly(int sx, int sy);
+    /** Only draw the scanlines from top to bottom - 1 */
+    void setBand(int top, int bottom);
     void scanLine(int x1, int y1, int x2, int y2);
     void scanLine(int x1, int y1, int x2, int y2, float u1, float v1, float u2, float v2);
     void renderPolygon(QColor col, QImage *dst);
     void renderPolygon(QImage *dst, QImage *src);
-    void renderPolygon(int interpolation, QPointF *pts, QImage *pDest, QImage *pSrc, QPointF *uv);
+    void renderPolygon(int interpolation, const QPointF *pts, QImage *pDest, QImage *pSrc, const QPointF *uv);
 
     void renderPolygonNI(QImage *dst, QImage *src);
     void renderPolygonBI(QImage *dst, QImage *src);
@@ -50,6 +56,50 @@ private:
     int      plMaxY { 0 };
     int      m_sx { 0 };
     int      m_sy { 0 };
+    int      m_top { 0 };
+    int      m_bottom { MAX_BK_SCANLINES };
     bkScan_t scLR[MAX_BK_SCANLINES];
     bool     bBilinear { false };
 };
+
+/**
+ * Draws textured polygons like ScanRender::renderPolygon(), but queues them to split
+ * the destination image into horizontal bands, each drawn by its own ScanRender on a
+ * thread of its own. The polygons are drawn in the order they were added in every band,
+ * so that the result is the same as drawing them one after the other.
+ */
+class ParallelScanRender
+{
+  public:
+    ParallelScanRender() = default;
+
+    void setBilinearInterpolationEnabled(bool enable);
+    bool isBilinearInterpolationEnabled(void) const;
+
+    /** Queue a polygon for render(). The source image has to stay valid until then. */
+    void addPolygon(int interpolation, const QPointF *pts, QImage *pSrc, const QPointF *uv);
+    /** Draw the queued polygons onto pDest and clear the queue */
+    void render(QImage *pDest);
+
+  private:
+    typedef struct
+    {
+      int     interpolation;
+      QPointF pts[4];
+      QPointF uv[4];
+      QImage *src;
+      int     minY;
+      int     maxY;
+    } polygon_t;
+
+    typedef struct
+    {
+      std::unique_ptr<ScanRender> render;
+      int top;
+      int bottom;
+    } band_t;
+
+    QVector<polygon_t>  m_polygons;
+    std::vector<band_t> m_bands;
+    bool                bBilinear { false };
+};
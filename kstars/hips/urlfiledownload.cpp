@@ -28,6 +28,8 @@ void UrlFileDownload::begin(const QUrl &url, const pixCacheKey_t &key)
     QVariant val;
     val.setValue(key);
     reply->setProperty("user_data0", val);
+
+    m_replies.append(reply);
 }
 
 void UrlFileDownload::abortAll()
@@ -35,8 +37,22 @@ void UrlFileDownload::abortAll()
     emit sigAbort();
 }
 
+void UrlFileDownload::abortObsolete(const std::function<bool(const pixCacheKey_t &key)> &obsolete)
+{
+    // Aborting finishes the reply right away, which removes it from the list
+    const QList<QNetworkReply *> replies = m_replies;
+
+    for (QNetworkReply *reply : replies)
+    {
+        if (reply->isRunning() && obsolete(reply->property("user_data0").value<pixCacheKey_t>()))
+            reply->abort();
+    }
+}
+
 void UrlFileDownload::downloadFinished(QNetworkReply *reply)
 {
+    m_replies.removeOne(reply);
+
     pixCacheKey_t key = reply->property("user_data0").value<pixCacheKey_t>();
 
     //QVariant fromCache = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute);
@@ -13,6 +13,8 @@
 
 #include <QtNetwork>
 
+#include <functional>
+
 class UrlFileDownload : public QObject
 {
   Q_OBJECT
@@ -20,6 +22,13 @@ public:
   explicit UrlFileDownload(QObject *parent, QNetworkDiskCache *cache);
   void begin(const QUrl &url, const pixCacheKey_t &key);
   void abortAll();
+  /**
+   * Abort the pending downloads whose key is \p obsolete, e.g. those of
+   * tiles that went out of view before they arrived. Their completion is
+   * reported as QNetworkReply::OperationCanceledError.
+   */
+  void abortObsolete(const std::function<bool(const pixCacheKey_t &key)> &obsolete);
+  int pending() const { return m_replies.size(); }
 
 signals:
   void sigDownloadDone(QNetworkReply::NetworkError error, QByteArray &data, pixCacheKey_t &key);
@@ -32,6 +41,7 @@ private slots:
 
 private:    
   QNetworkAccessManager m_manager;
+  QList<QNetworkReply *> m_replies;
 };
 
 #endif // URLFILEDOWNLOAD_H
@@ -20,7 +20,7 @@
  *****************************************************************************/
 
 HTMesh::HTMesh(int level, int buildLevel, int numBuffers)
-    : m_level(level), m_buildLevel(buildLevel), m_numBuffers(numBuffers), htmDebug(0)
+    : m_level(level), m_buildLevel(buildLevel), m_numBuffers(numBuffers), m_lastCircle(numBuffers), htmDebug(0)
 {
     name = "HTMesh";
     if (m_buildLevel > 0)
@@ -79,6 +79,7 @@ bool HTMesh::performIntersection(RangeConvex *convex, BufNum bufNum)
     if (!validBufNum(bufNum))
         return false;
 
+    m_lastCircle[bufNum].valid = false;
     convex->setOlevel(m_level);
     HtmRange range;
     convex->intersect(htm, &range);
@@ -109,7 +110,35 @@ void HTMesh::intersect(double ra, double dec, double radius, BufNum bufNum)
     convex.add(c); // [ed:RangeConvex::add]
 
     if (!performIntersection(&convex, bufNum))
+    {
         printf("In intersect(%f, %f, %f)\n", ra, dec, radius);
+        return;
+    }
+
+    Circle &last = m_lastCircle[bufNum];
+    last.valid   = true;
+    last.ra      = ra;
+    last.dec     = dec;
+    last.radius  = radius;
+}
+
+void HTMesh::intersectCircle(double ra, double dec, double radius, double slack, BufNum bufNum)
+{
+    if (!validBufNum(bufNum))
+        return;
+
+    // the previous circle still covers this one?
+    const Circle &last = m_lastCircle[bufNum];
+    if (last.valid && radius <= last.radius)
+    {
+        double cosDist = SpatialVector(ra, dec) * SpatialVector(last.ra, last.dec);
+        if (cosDist > 1.0)
+            cosDist = 1.0;
+        if (acos(cosDist) / degree2Rad + radius <= last.radius)
+            return;
+    }
+
+    intersect(ra, dec, radius + slack, bufNum);
 }
 
 // TRIANGLE
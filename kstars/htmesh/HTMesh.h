@@ -13,6 +13,7 @@
 #define HTMESH_H
 
 #include <cstdio>
+#include <vector>
 #include "typedef.h"
 
 class SpatialIndex;
@@ -95,6 +96,22 @@ class HTMesh
          */
     void intersect(double ra, double dec, double radius, BufNum bufNum = 0);
 
+    /**
+         *@short finds the trixels that cover the specified circle, or a
+         * circle up to slack degrees larger.
+         * The intersection is only redone if the result already in bufNum
+         * does not cover the circle, so that repeated and slightly moved
+         * apertures, e.g. while the sky map is redrawn or panned, come for
+         * free.  The result is recomputed for a circle that is slack degrees
+         * larger so that it keeps covering the following ones for a while.
+         *@param ra Central ra in degrees
+         *@param dec Central dec in degrees
+         *@param radius Radius of the circle in degrees
+         *@param slack how many degrees the circle may be enlarged by
+         *@param bufNum the output buffer to hold the results
+         */
+    void intersectCircle(double ra, double dec, double radius, double slack, BufNum bufNum = 0);
+
     /** @short finds the trixels that cover the specified line segment
          */
     void intersect(double ra1, double dec1, double ra2, double dec2, BufNum bufNum = 0);
@@ -143,6 +160,14 @@ class HTMesh
     MeshBuffer **m_meshBuffer;
     BufNum m_numBuffers;
 
+    // The circle whose result each buffer holds, if it holds one
+    struct Circle
+    {
+        bool valid { false };
+        double ra { 0 }, dec { 0 }, radius { 0 };
+    };
+    std::vector<Circle> m_lastCircle;
+
     double degree2Rad;
     double edge, edge10, eps;
 
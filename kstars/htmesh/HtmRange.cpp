@@ -1,102 +1,48 @@
 #include <HtmRange.h>
 
-#include <stdio.h>
-#include <string.h>
+#include <algorithm>
 
-#define INSIDE         1
-#define OUTSIDE        -1
-#define INTERSECT      0
-#define GAP_HISTO_SIZE 10000
-
-extern "C" {
-int cc_ID2name(char *name, uint64 id);
-}
-
-HtmRange::HtmRange()
-{
-    my_los = new SkipList;
-    my_his = new SkipList;
-}
-
-HtmRange::~HtmRange()
-{
-    my_los->freeRange(-1, KEY_MAX);
-    my_his->freeRange(-1, KEY_MAX);
-    delete my_los;
-    delete my_his;
-}
-
-InclusionType HtmRange::tinside(const Key mid) const
+void HtmRange::mergeRange(const Key lo, const Key hi)
 {
-    // clearly out, inside, share a boundary, off by one to some boundary
-    InclusionType t1, t2;
-
-    Key GH = my_his->findMAX(mid);
-    Key GL = my_los->findMAX(mid);
-
-    if (GH < GL)
-        t1 = InclInside;
-    else
-        t1 = InclOutside;
-
-    Key SH = my_his->findMIN(mid);
-    Key SL = my_los->findMIN(mid);
-    if (SH < SL)
-        t2 = InclInside;
-    else
-        t2 = InclOutside;
-
-    if (t1 == t2)
-        return t1;
-    if (t1 == InclInside)
-        return InclHi;
-    else
-        return InclLo;
+    my_ranges.emplace_back(lo, hi);
 }
 
-void HtmRange::mergeRange(const Key lo, const Key hi)
+void HtmRange::normalize()
 {
-    int lo_flag = tinside(lo);
-    int hi_flag = tinside(hi);
+    if (my_sorted == my_ranges.size())
+        return;
 
-    // delete all nodes (key) in his and los where lo < key < hi
-    my_his->freeRange(lo, hi);
-    my_los->freeRange(lo, hi);
+    std::sort(my_ranges.begin(), my_ranges.end());
 
-    // add if not inside a pre-existing interval
-    if (lo_flag == InclHi)
-    {
-    }
-    else if (lo_flag == InclLo || (lo_flag == InclOutside))
-    {
-        my_los->insert(lo, 33);
-    }
-
-    if (hi_flag == InclLo)
-    {
-    }
-    else if (hi_flag == InclOutside || hi_flag == InclHi)
+    // coalesce in place, i.e. ranges that overlap or touch become one
+    size_t last = 0;
+    for (size_t i = 1; i < my_ranges.size(); i++)
     {
-        my_his->insert(hi, 33);
+        if (my_ranges[i].first <= my_ranges[last].second + 1)
+            my_ranges[last].second = std::max(my_ranges[last].second, my_ranges[i].second);
+        else
+            my_ranges[++last] = my_ranges[i];
     }
+    my_ranges.resize(last + 1);
+    my_sorted = my_ranges.size();
 }
 
 void HtmRange::reset()
 {
-    my_los->reset();
-    my_his->reset();
+    normalize();
+    my_next = 0;
 }
 
 int HtmRange::getNext(Key *lo, Key *hi)
 {
-    *lo = my_los->getkey();
-    if (*lo <= (Key)0)
+    normalize();
+    if (my_next >= my_ranges.size())
     {
         *hi = *lo = (Key)0;
         return 0;
     }
-    *hi = my_his->getkey();
-    my_his->step();
-    my_los->step();
+    *lo = my_ranges[my_next].first;
+    *hi = my_ranges[my_next].second;
+    my_next++;
     return 1;
 }
@@ -1,34 +1,38 @@
 #ifndef _HTMHANGE_H_
 #define _HTMHANGE_H_
 
-#include <SkipList.h>
+#include <SpatialGeneral.h>
 
-enum InclusionType
-{
-    InclOutside = 0,
-    InclInside,
-    InclLo, /* number is on low end of an interval */
-    InclHi, /* number is on high end of an interval */
-    InclAdjacentXXX
-};
+#include <utility>
+#include <vector>
+
+typedef int64 Key; // key type
 
+/** @class HtmRange
+   HtmRange collects the ranges of htmids found by an intersection and hands
+   them back in ascending order, overlapping and adjacent ranges merged.
+
+   The ranges are kept in a plain vector.  mergeRange() just appends, the
+   sorting and merging is done once when the ranges are read back, which is
+   much cheaper than keeping a sorted structure up to date on every insert.
+*/
 class LINKAGE HtmRange
 {
   public:
-    HtmRange();
-    ~HtmRange();
+    HtmRange() = default;
 
     int getNext(Key *lo, Key *hi);
 
     void mergeRange(const Key lo, const Key hi);
     void reset();
 
-  protected:
-    InclusionType tinside(const Key mid) const;
-
   private:
-    SkipList *my_los;
-    SkipList *my_his;
+    // sorts and merges the ranges added since the last call
+    void normalize();
+
+    std::vector<std::pair<Key, Key>> my_ranges;
+    size_t my_sorted { 0 }; // the ranges before this index are sorted and disjoint
+    size_t my_next { 0 };   // the range returned by the next getNext()
 };
 
 #endif
@@ -574,10 +574,29 @@ void RangeConvex::intersect(const SpatialIndex *idx, HtmRange *htmrange)
     if (constraints_.empty())
         return; // nothing to intersect!!
 
-    // Start with root nodes (index = 1-8) and intersect triangles
-    for (uint32 i = 1; i <= 8; i++)
+    // flatten the constraints for testVertex()
+    planes_.resize(4 * constraints_.size());
+    for (size_t i = 0; i < constraints_.size(); i++)
+    {
+        planes_[4 * i]     = constraints_[i].a_.x();
+        planes_[4 * i + 1] = constraints_[i].a_.y();
+        planes_[4 * i + 2] = constraints_[i].a_.z();
+        planes_[4 * i + 3] = constraints_[i].d_;
+    }
+
+    // Start with root nodes (index = 1-8) and intersect triangles.
+    // The tree is walked with an explicit stack instead of recursing,
+    // the order the trixels are found in does not matter to HtmRange.
+    std::vector<uint64> pending;
+    pending.reserve(64);
+    for (uint32 i = 8; i >= 1; i--)
+        pending.push_back(i);
+
+    while (!pending.empty())
     {
-        testTrixel(i);
+        const uint64 id = pending.back();
+        pending.pop_back();
+        testTrixel(id, pending);
     }
 }
 
@@ -624,92 +643,47 @@ inline void RangeConvex::saveTrixel(uint64 htmid)
 
 /////////////TRIANGLETEST/////////////////////////////////
 // testTrixel: this is the main test of a triangle vs a Convex.  It
-// will properly mark up the flags for the triangular node[index], and
-// all its children
-SpatialMarkup RangeConvex::testTrixel(uint64 id)
+// will properly mark up the flags for the triangular node[index].
+// The children that still need testing are pushed to pending.
+SpatialMarkup RangeConvex::testTrixel(uint64 id, std::vector<uint64> &pending)
 {
-    SpatialMarkup mark;
-    uint64 childID;
-    uint64 tid;
-
-    // const struct SpatialIndex::QuadNode &indexNode = index_->nodes_[id];
     const struct SpatialIndex::QuadNode *indexNode = &index_->nodes_[id];
 
-    //
     // do the face test on the triangle
-
-    // was: mark =  testNode(V(NV(0)),V(NV(1)),V(NV(2)));
-    // changed to by Gyorgy Fekete. Overall Speedup approx. 2%
-
-    mark = testNode(id); // was:(indexNode or  id);
+    SpatialMarkup mark = testNode(id);
 
     switch (mark)
     {
         case fULL:
-            tid = N(id).id_;
-
-            saveTrixel(tid); //was:  plist_->push_back(tid);
-
+            saveTrixel(N(id).id_);
             return mark;
         case rEJECT:
-            tid = N(id).id_;
             return mark;
         default:
             // if pARTIAL or dONTKNOW, then continue, test children,
             //    but do not reach beyond the leaf nodes.
-            //    If Convex is fully contained within one (sWALLOWED),
-            //    we can stop looking further in another child
-
-            // #define NC(n,m)	index_->nodes_[(n)].childID_[(m)]	// the children n->m
-            // childID = index_->nodes_[id].childID_[0];
-
-            // Test how many of the four children are rejected?
-            //
-            // [ed:algo]
-            //
             break;
     }
 
-    // NEW NEW algorithm  Disabled when enablenew is 0
-    //
+    if (indexNode->childID_[0] != 0)
+    {
+        pending.push_back(indexNode->childID_[3]);
+        pending.push_back(indexNode->childID_[2]);
+        pending.push_back(indexNode->childID_[1]);
+        pending.push_back(indexNode->childID_[0]);
+    }
+    else /// No children...
     {
-        childID = indexNode->childID_[0];
-        if (childID != 0)
+        if (addlevel_)
         {
-            ////////////// [ed:split]
-            tid     = N(id).id_;
-            childID = indexNode->childID_[0];
-            testTrixel(childID);
-            childID = indexNode->childID_[1];
-            testTrixel(childID);
-            childID = indexNode->childID_[2];
-            testTrixel(childID);
-            childID = indexNode->childID_[3];
-            testTrixel(childID);
+            testPartial(addlevel_, N(id).id_, V(NV(0)), V(NV(1)), V(NV(2)), 0);
         }
-        else /// No children...
+        else
         {
-            if (addlevel_)
-            {
-                testPartial(addlevel_, N(id).id_, V(NV(0)), V(NV(1)), V(NV(2)), 0);
-            }
-            else
-            {
-                saveTrixel(N(id).id_); // was: plist_->push_back(N(id).id_);
-            }
+            saveTrixel(N(id).id_);
         }
-    } ///////////////////////////// END OF NEW ALGORITHM returns mark below;
-
-    /* NEW NEW NEW
-       If rejected, then we return [done]
-       If full, then we list the id (propagate to children) [done]
-
-       If partial, then we look ahead to see how many children are rejected.
-       But ah, next iteration could benefit from having computed this already.
+    }
 
-       If two children are rejected, then we stop
-       If one or 0 nodes are rejected, then we
-    */
     return mark;
 }
 
@@ -783,26 +757,19 @@ void RangeConvex::testPartial(size_t level, uint64 id, const SpatialVector &v0,
 // testNode: tests the QuadNodes for intersections.
 //
 SpatialMarkup RangeConvex::testNode(uint64 id)
-//uint64 id)
-// const struct SpatialIndex::QuadNode *indexNode)
 {
-    const SpatialVector *v0, *v1, *v2;
-    // const struct SpatialIndex::QuadNode &indexNode = index_->nodes_[id];
-    const struct SpatialIndex::QuadNode *indexNode = &index_->nodes_[id];
-    int m;
-    m  = indexNode->v_[0];
-    v0 = &index_->vertices_[m]; // the vertex vector m
-
-    m  = indexNode->v_[1];
-    v1 = &index_->vertices_[m];
-
-    m  = indexNode->v_[2];
-    v2 = &index_->vertices_[m];
-
     // Start with testing the vertices for the QuadNode with this convex.
-    int vsum = testVertex(v0) + testVertex(v1) + testVertex(v2);
+    const float64 *c = &index_->nodeCorners_[9 * id];
+    int vsum         = testVertex(c) + testVertex(c + 3) + testVertex(c + 6);
 
-    SpatialMarkup mark = testTriangle(*v0, *v1, *v2, vsum);
+    // the vertices themselves are only needed if the vertex test is not
+    // conclusive already
+    if (vsum == 1 || vsum == 2)
+        return pARTIAL;
+
+    const struct SpatialIndex::QuadNode *indexNode = &index_->nodes_[id];
+    SpatialMarkup mark = testTriangle(index_->vertices_[indexNode->v_[0]], index_->vertices_[indexNode->v_[1]],
+                                      index_->vertices_[indexNode->v_[2]], vsum);
 
     // since we cannot play games using the on-the-fly triangles,
     // substitute dontknow with partial.
@@ -972,6 +939,16 @@ int RangeConvex::testVertex(const SpatialVector *v)
 
     return 1;
 }
+int RangeConvex::testVertex(const float64 *v)
+{
+    const float64 *p   = planes_.data();
+    const float64 *end = p + planes_.size();
+    for (; p != end; p += 4)
+        if ((p[0] * v[0]) + (p[1] * v[1]) + (p[2] * v[2]) < p[3])
+            return 0;
+
+    return 1;
+}
 
 /////////////TESTHOLE/////////////////////////////////////
 // testHole: test for holes. If there is a negative constraint whose center
@@ -93,8 +93,9 @@ class LINKAGE RangeConvex
     void saveTrixel(uint64 htmid);
 
     // testTrixel: Test the nodes of the index if the convex hits it
-    // the argument gives the index of the nodes_ array to specify the QuadNode
-    SpatialMarkup testTrixel(uint64 nodeIndex);
+    // the argument gives the index of the nodes_ array to specify the QuadNode,
+    // the children left to test are pushed to pending
+    SpatialMarkup testTrixel(uint64 nodeIndex, std::vector<uint64> &pending);
 
     // test each quadnode for intersections. Calls testTriangle after having
     // tested the vertices using testVertex.
@@ -126,6 +127,8 @@ class LINKAGE RangeConvex
     // Test if vertices are inside the convex for a node.
     int testVertex(const SpatialVector &v);
     int testVertex(const SpatialVector *v);
+    // Same, for x, y, z of a node corner of the index, using planes_
+    int testVertex(const float64 *v);
 
     // testHole : look for 'holes', i.e. negative constraints that have their
     // centers inside the node with the three corners v0,v1,v2.
@@ -162,6 +165,7 @@ class LINKAGE RangeConvex
     bool testVectorInside(const SpatialVector &v0, const SpatialVector &v1, const SpatialVector &v2, SpatialVector &v);
 
     std::vector<SpatialConstraint> constraints_; // The vector of constraints
+    std::vector<float64> planes_;                // x, y, z and d of each constraint
     const SpatialIndex *index_;                  // A pointer to the index
     std::vector<SpatialVector> corners_;
     SpatialConstraint boundingCircle_; // For zERO convexes, the bc.
@@ -113,6 +113,26 @@ SpatialIndex::SpatialIndex(size_t maxlevel, size_t buildlevel)
     }
 
     sortIndex();
+    makeNodeCorners();
+}
+
+/////////////MAKENODECORNERS//////////////////////////////
+// makeNodeCorners: copy the vertices of the nodes into one flat array
+//
+void SpatialIndex::makeNodeCorners()
+{
+    nodeCorners_.resize(9 * nodes_.size());
+    for (size_t i = 0; i < nodes_.size(); i++)
+    {
+        float64 *c = &nodeCorners_[9 * i];
+        for (int k = 0; k < 3; k++)
+        {
+            const SpatialVector &v = vertices_[nodes_[i].v_[k]];
+            c[3 * k]     = v.x_;
+            c[3 * k + 1] = v.y_;
+            c[3 * k + 2] = v.z_;
+        }
+    }
 }
 
 /////////////NODEVERTEX///////////////////////////////////
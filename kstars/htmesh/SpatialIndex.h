@@ -142,6 +142,12 @@ class LINKAGE SpatialIndex
     std::vector<SpatialVector> vertices_;
     uint64 index_; // the current index_ of vertices
 
+    // x, y, z of the three vertices of every node, nine per node, so that
+    // the intersection can test a node without chasing the vertex indices
+    std::vector<float64> nodeCorners_;
+
+    void makeNodeCorners();
+
     friend class SpatialEdge;
     friend class SpatialConvex;
     friend class RangeConvex;
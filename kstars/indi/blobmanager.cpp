@@ -10,23 +10,149 @@
 
 #include "indi_debug.h"
 
-BlobManager::BlobManager(QObject *parent, const QString &host, int port, const QString &device,
-                         const QString &prop) : QObject(parent), m_Device(device), m_Property(prop)
+BlobManager::BlobManager(QObject *parent, const QString &host, int port) : QObject(parent)
 {
-    // Set INDI server params
+    // Set INDI server params. The connection is made once the first property is added.
     setServer(host.toLatin1().constData(), port);
+}
+
+void BlobManager::addProperty(INDI::Property prop)
+{
+    const QString device = prop.getDeviceName();
+    const QString property = prop.getName();
+
+    QMutexLocker locker(&m_PropertiesMutex);
+    if (findProperty(device, property) != m_Properties.end())
+        return;
+
+    const bool newDevice = std::none_of(m_Properties.cbegin(), m_Properties.cend(), [&device](const BLOBProperty & oneBLOB)
+    {
+        return oneBLOB.device == device;
+    });
+    const BLOBProperty blob {device, property, true, prop};
+    m_Properties.append(blob);
+
+    // Device already defined, the property can be enabled right away
+    if (m_ReadyDevices.contains(device))
+    {
+        locker.unlock();
+        enableProperty(blob);
+        emit connected(prop);
+        return;
+    }
 
-    // We're only interested in a particular device
-    watchDevice(m_Device.toLatin1().constData());
+    // Otherwise the property is enabled once the device is defined, see newDevice()
+    if (!newDevice)
+        return;
 
-    // Connect immediately
+    watchDevice(device.toLatin1().constData());
+    m_ReadyDevices.clear();
+    locker.unlock();
+
+    if (isServerConnected())
+    {
+        qCDebug(KSTARS_INDI) << "BLOB manager reconnecting to receive BLOBs of device" << device;
+        disconnectServer();
+    }
     connectServer();
 }
 
+bool BlobManager::removeProperty(const QString &device, const QString &property)
+{
+    QMutexLocker locker(&m_PropertiesMutex);
+    auto blob = findProperty(device, property);
+    if (blob == m_Properties.end())
+        return false;
+
+    m_Properties.erase(blob);
+    const bool ready = m_ReadyDevices.contains(device);
+    locker.unlock();
+
+    // Device stays watched, but its property no longer sends BLOBs over this connection
+    if (ready)
+        setBLOBMode(B_NEVER, device.toLatin1().constData(), property.toLatin1().constData());
+    return true;
+}
+
+void BlobManager::removeDevice(const QString &device)
+{
+    QMutexLocker locker(&m_PropertiesMutex);
+    m_Properties.erase(std::remove_if(m_Properties.begin(), m_Properties.end(), [&device](const BLOBProperty & oneBLOB)
+    {
+        return oneBLOB.device == device;
+    }), m_Properties.end());
+    m_ReadyDevices.remove(device);
+}
+
+bool BlobManager::hasDevice(const QString &device) const
+{
+    QMutexLocker locker(&m_PropertiesMutex);
+    return findProperty(device, QString()) != m_Properties.cend();
+}
+
+bool BlobManager::hasProperty(const QString &device, const QString &property) const
+{
+    QMutexLocker locker(&m_PropertiesMutex);
+    return findProperty(device, property) != m_Properties.cend();
+}
+
+int BlobManager::count() const
+{
+    QMutexLocker locker(&m_PropertiesMutex);
+    return m_Properties.count();
+}
+
+bool BlobManager::enabled(const QString &device, const QString &property) const
+{
+    QMutexLocker locker(&m_PropertiesMutex);
+    auto blob = findProperty(device, property);
+    return blob != m_Properties.cend() && blob->enabled;
+}
+
+void BlobManager::setEnabled(bool enabled, const QString &device, const QString &property)
+{
+    QMutexLocker locker(&m_PropertiesMutex);
+    auto blob = findProperty(device, property);
+    if (blob == m_Properties.end())
+        return;
+
+    blob->enabled = enabled;
+    const QString name = blob->property;
+    locker.unlock();
+
+    setBLOBMode(enabled ? B_ONLY : B_NEVER, device.toLatin1().constData(), name.toLatin1().constData());
+}
+
+QList<BlobManager::BLOBProperty>::iterator BlobManager::findProperty(const QString &device, const QString &property)
+{
+    return std::find_if(m_Properties.begin(), m_Properties.end(), [&device, &property](const BLOBProperty & oneBLOB)
+    {
+        return oneBLOB.device == device && (property.isEmpty() || oneBLOB.property == property);
+    });
+}
+
+QList<BlobManager::BLOBProperty>::const_iterator BlobManager::findProperty(const QString &device,
+        const QString &property) const
+{
+    return std::find_if(m_Properties.cbegin(), m_Properties.cend(), [&device, &property](const BLOBProperty & oneBLOB)
+    {
+        return oneBLOB.device == device && (property.isEmpty() || oneBLOB.property == property);
+    });
+}
+
+void BlobManager::enableProperty(const BLOBProperty &blob)
+{
+    const QByteArray device = blob.device.toLatin1();
+    const QByteArray property = blob.property.toLatin1();
+    setBLOBMode(blob.enabled ? B_ONLY : B_NEVER, device.constData(), property.constData());
+    // enable Direct Blob Access for faster BLOB loading.
+    enableDirectBlobAccess(device.constData(), property.constData());
+}
+
 void BlobManager::serverDisconnected(int exit_code)
 {
-    qCDebug(KSTARS_INDI) << "INDI server disconnected from BLOB manager for Device:" << m_Device << "Property:" << m_Property <<
-                         "Exit code:" << exit_code;
+    qCDebug(KSTARS_INDI) << "INDI server disconnected from BLOB manager with" << count() << "properties. Exit code:" <<
+                         exit_code;
 }
 
 void BlobManager::updateProperty(INDI::Property prop)
@@ -37,18 +163,24 @@ void BlobManager::updateProperty(INDI::Property prop)
 
 void BlobManager::newDevice(INDI::BaseDevice device)
 {
-    // Got out target device, let's now set to BLOB ONLY for the particular property we want
-    if (QString(device.getDeviceName()) == m_Device)
+    // Got one of our target devices, let's now set to BLOB ONLY for the properties we want of it
+    const QString name = device.getDeviceName();
+    QList<BLOBProperty> blobs;
     {
-        setBLOBMode(B_ONLY, m_Device.toLatin1().constData(), m_Property.toLatin1().constData());
-        // enable Direct Blob Access for faster BLOB loading.
-        enableDirectBlobAccess(m_Device.toLatin1().constData(), m_Property.toLatin1().constData());
-        emit connected();
+        QMutexLocker locker(&m_PropertiesMutex);
+        for (const auto &oneBLOB : m_Properties)
+        {
+            if (oneBLOB.device == name)
+                blobs.append(oneBLOB);
+        }
+        if (blobs.isEmpty())
+            return;
+        m_ReadyDevices.insert(name);
     }
-}
 
-void BlobManager::setEnabled(bool enabled)
-{
-    m_Enabled = enabled;
-    setBLOBMode(enabled ? B_ONLY : B_NEVER, m_Device.toLatin1().constData(), m_Property.toLatin1().constData());
+    for (const auto &oneBLOB : blobs)
+    {
+        enableProperty(oneBLOB);
+        emit connected(oneBLOB.prop);
+    }
 }
@@ -13,18 +13,25 @@
 #include <QObject>
 #endif
 
+#include <QList>
+#include <QMutex>
+#include <QSet>
+
 class DeviceInfo;
 class DriverInfo;
 class ServerManager;
 
 /**
  * @class BlobManager
- * BlobManager manages connection to INDI server to handle a specific BLOB.
+ * BlobManager manages a connection to INDI server that receives BLOBs only.
+ *
+ * A connection serves the BLOB properties of one or more devices, all the BLOB properties of a device
+ * are received over the same connection. Each connection is parsed by a thread of its own.
  *
  * BlobManager is a subclass of INDI::BaseClient class part of the INDI Library.
  *
  * @author Jasem Mutlaq
- * @version 1.0
+ * @version 1.1
  */
 #ifdef USE_QT5_INDI
 class BlobManager : public INDI::BaseClientQt
@@ -33,16 +40,42 @@ class BlobManager : public QObject, public INDI::BaseClient
 #endif
 {
     Q_OBJECT
-    Q_PROPERTY(QString device MEMBER m_Device)
-    Q_PROPERTY(QString property MEMBER m_Property)
-    Q_PROPERTY(bool enabled READ enabled WRITE setEnabled)
 
   public:
-    BlobManager(QObject *parent, const QString &host, int port, const QString &device, const QString &prop);
+    BlobManager(QObject *parent, const QString &host, int port);
     virtual ~BlobManager() override = default;
 
-    bool enabled() { return m_Enabled; }
-    void setEnabled(bool enabled);
+    /**
+     * @brief addProperty Receive the BLOBs of a property over this connection.
+     * @param prop BLOB property of the main client, emitted with connected() once its BLOBs are enabled.
+     * @note A device new to a connection that is already up makes it reconnect, since INDI server only
+     * defines the devices asked for on connection.
+     */
+    void addProperty(INDI::Property prop);
+
+    /**
+     * @brief removeProperty Stop receiving the BLOBs of a property.
+     * @return true if the property was received over this connection.
+     */
+    bool removeProperty(const QString &device, const QString &property);
+
+    /**
+     * @brief removeDevice Stop receiving the BLOBs of all properties of a device.
+     */
+    void removeDevice(const QString &device);
+
+    bool hasDevice(const QString &device) const;
+    bool hasProperty(const QString &device, const QString &property) const;
+
+    /** @return number of properties received over this connection */
+    int count() const;
+
+    /**
+     * @brief enabled Whether the BLOBs of a property are received.
+     * @param property name of the property, or empty for the first property of the device.
+     */
+    bool enabled(const QString &device, const QString &property) const;
+    void setEnabled(bool enabled, const QString &device, const QString &property);
 
   protected:
     virtual void newDevice(INDI::BaseDevice device) override;
@@ -51,13 +84,28 @@ class BlobManager : public QObject, public INDI::BaseClient
     virtual void serverConnected() override {}
     virtual void serverDisconnected(int exit_code) override;
 
-  signals:   
+  signals:
     void propertyUpdated(INDI::Property prop);
-    void connected();
+    void connected(INDI::Property prop);
     void connectionFailure();
 
   private:
-    QString m_Device;
-    QString m_Property;
-    bool m_Enabled { true };
+    typedef struct
+    {
+        QString device;
+        QString property;
+        bool enabled;
+        INDI::Property prop;
+    } BLOBProperty;
+
+    // Must be called with m_PropertiesMutex locked
+    QList<BLOBProperty>::iterator findProperty(const QString &device, const QString &property);
+    QList<BLOBProperty>::const_iterator findProperty(const QString &device, const QString &property) const;
+    void enableProperty(const BLOBProperty &blob);
+
+    // Touched from the main thread and from the thread of the connection
+    QList<BLOBProperty> m_Properties;
+    // Devices defined by INDI server on this connection
+    QSet<QString> m_ReadyDevices;
+    mutable QMutex m_PropertiesMutex;
 };
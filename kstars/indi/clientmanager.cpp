@@ -20,6 +20,10 @@ ClientManager::ClientManager()
 {
     connect(this, &ClientManager::newINDIProperty, this, &ClientManager::processNewProperty, Qt::UniqueConnection);
     connect(this, &ClientManager::removeBLOBManager, this, &ClientManager::processRemoveBLOBManager, Qt::UniqueConnection);
+
+    m_UpdateTimer.setSingleShot(true);
+    m_UpdateTimer.setInterval(UPDATE_INTERVAL);
+    connect(&m_UpdateTimer, &QTimer::timeout, this, &ClientManager::dispatchPendingUpdates);
 }
 
 bool ClientManager::isDriverManaged(const QSharedPointer<DriverInfo> &driver)
@@ -93,13 +97,73 @@ void ClientManager::newProperty(INDI::Property property)
 
 void ClientManager::updateProperty(INDI::Property property)
 {
-    emit updateINDIProperty(property);
+    // Drivers may send numbers and texts many times a second, e.g. coordinates while slewing or
+    // temperatures while cooling. These are coalesced and dispatched once per interval. Other
+    // updates are dispatched right away, after what was queued before them so the order holds.
+    const bool coalesce = property.getType() == INDI_NUMBER || property.getType() == INDI_TEXT;
+    bool schedule = !coalesce;
+    {
+        QMutexLocker locker(&m_PendingUpdatesMutex);
+        if (coalesce)
+        {
+            const QString key = QString("%1.%2").arg(property.getDeviceName(), property.getName());
+            if (m_CoalescedUpdates.contains(key))
+                return;
+            m_CoalescedUpdates.insert(key);
+        }
+        m_PendingUpdates.append(property);
+
+        if (!m_DispatchScheduled)
+        {
+            m_DispatchScheduled = true;
+            schedule = true;
+        }
+    }
+
+    if (!schedule)
+        return;
+
+    if (coalesce)
+        QMetaObject::invokeMethod(this, [this]()
+    {
+        if (!m_UpdateTimer.isActive())
+            m_UpdateTimer.start();
+    }, Qt::QueuedConnection);
+    else
+        QMetaObject::invokeMethod(this, &ClientManager::dispatchPendingUpdates, Qt::QueuedConnection);
+}
+
+void ClientManager::dispatchPendingUpdates()
+{
+    m_UpdateTimer.stop();
+
+    QVector<INDI::Property> updates;
+    {
+        QMutexLocker locker(&m_PendingUpdatesMutex);
+        updates.swap(m_PendingUpdates);
+        m_CoalescedUpdates.clear();
+        m_DispatchScheduled = false;
+    }
+
+    for (auto &oneProperty : updates)
+        emit updateINDIProperty(oneProperty);
 }
 
 void ClientManager::removeProperty(INDI::Property prop)
 {
     const QString name = prop.getName();
     const QString device = prop.getDeviceName();
+
+    // Updates still waiting for the property must not follow its removal
+    {
+        QMutexLocker locker(&m_PendingUpdatesMutex);
+        m_PendingUpdates.erase(std::remove_if(m_PendingUpdates.begin(), m_PendingUpdates.end(), [&](INDI::Property & oneProperty)
+        {
+            return name == oneProperty.getName() && device == oneProperty.getDeviceName();
+        }), m_PendingUpdates.end());
+        m_CoalescedUpdates.remove(QString("%1.%2").arg(device, name));
+    }
+
     emit removeINDIProperty(prop);
 
     // If BLOB property is removed, remove its corresponding property if one exists.
@@ -111,12 +175,11 @@ void ClientManager::processRemoveBLOBManager(const QString &device, const QStrin
 {
     auto manager = std::find_if(blobManagers.begin(), blobManagers.end(), [device, property](auto & oneManager)
     {
-        const auto bProperty = oneManager->property("property").toString();
-        const auto bDevice = oneManager->property("device").toString();
-        return (device == bDevice && property == bProperty);
+        return oneManager->removeProperty(device, property);
     });
 
-    if (manager != blobManagers.end())
+    // Connection is closed once it has nothing left to receive
+    if (manager != blobManagers.end() && (*manager)->count() == 0)
     {
         (*manager)->disconnectServer();
         (*manager)->deleteLater();
@@ -128,16 +191,37 @@ void ClientManager::processNewProperty(INDI::Property prop)
 {
     // Only handle RW and RO BLOB properties
     if (prop.getType() == INDI_BLOB && prop.getPermission() != IP_WO)
+        findBLOBManager(prop.getDeviceName())->addProperty(prop);
+}
+
+BlobManager *ClientManager::findBLOBManager(const QString &device)
+{
+    // All BLOBs of a device share a connection
+    for (auto &oneManager : blobManagers)
     {
-        BlobManager *bm = new BlobManager(this, getHost(), getPort(), prop.getDeviceName(), prop.getName());
-        connect(bm, &BlobManager::propertyUpdated, this, &ClientManager::updateINDIProperty);
-        connect(bm, &BlobManager::connected, this, [prop, this]()
+        if (oneManager->hasDevice(device))
+            return oneManager;
+    }
+
+    // Each device gets a connection of its own while there are fewer than configured,
+    // after that the connection with the fewest properties is shared.
+    if (blobManagers.count() >= static_cast<int>(std::max(1u, Options::iNDIBLOBConnections())))
+    {
+        return *std::min_element(blobManagers.begin(), blobManagers.end(), [](auto & left, auto & right)
         {
-            if (prop && prop.getRegistered())
-                emit newBLOBManager(prop.getDeviceName(), prop);
+            return left->count() < right->count();
         });
-        blobManagers.append(bm);
     }
+
+    BlobManager *bm = new BlobManager(this, getHost(), getPort());
+    connect(bm, &BlobManager::propertyUpdated, this, &ClientManager::updateINDIProperty);
+    connect(bm, &BlobManager::connected, this, [this](INDI::Property prop)
+    {
+        if (prop && prop.getRegistered())
+            emit newBLOBManager(prop.getDeviceName(), prop);
+    });
+    blobManagers.append(bm);
+    return bm;
 }
 
 void ClientManager::disconnectAll()
@@ -155,10 +239,14 @@ void ClientManager::removeDevice(INDI::BaseDevice dp)
     while (it.hasNext())
     {
         auto &oneManager = it.next();
-        if (oneManager->property("device").toString() == deviceName)
+        if (oneManager->hasDevice(deviceName))
         {
-            oneManager->disconnect();
-            it.remove();
+            oneManager->removeDevice(deviceName);
+            if (oneManager->count() == 0)
+            {
+                oneManager->disconnect();
+                it.remove();
+            }
         }
     }
 
@@ -336,9 +424,9 @@ void ClientManager::setBLOBEnabled(bool enabled, const QString &device, const QS
 {
     for(auto &bm : blobManagers)
     {
-        if (bm->property("device") == device && (property.isEmpty() || bm->property("property") == property))
+        if (bm->hasProperty(device, property))
         {
-            bm->setEnabled(enabled);
+            bm->setEnabled(enabled, device, property);
             return;
         }
     }
@@ -348,8 +436,8 @@ bool ClientManager::isBLOBEnabled(const QString &device, const QString &property
 {
     for(auto &bm : blobManagers)
     {
-        if (bm->property("device") == device && bm->property("property") == property)
-            return bm->property("enabled").toBool();
+        if (bm->hasProperty(device, property))
+            return bm->enabled(device, property);
     }
 
     return false;
@@ -6,7 +6,11 @@
 
 #pragma once
 
+#include <QMutex>
 #include <QPointer>
+#include <QSet>
+#include <QTimer>
+#include <QVector>
 
 #ifdef USE_QT5_INDI
 #include <baseclientqt.h>
@@ -100,6 +104,9 @@ class ClientManager : public QObject, public INDI::BaseClient
 
     private:
         void processNewProperty(INDI::Property prop);
+        // Connection that receives the BLOBs of device, created if needed
+        BlobManager *findBLOBManager(const QString &device);
+        void dispatchPendingUpdates();
         void processRemoveBLOBManager(const QString &device, const QString &property);
         QList<QSharedPointer<DriverInfo>> m_ManagedDrivers;
         QList<BlobManager *> blobManagers;
@@ -134,4 +141,15 @@ class ClientManager : public QObject, public INDI::BaseClient
         static constexpr uint8_t MAX_RETRIES {2};
         uint8_t m_ConnectionRetries {MAX_RETRIES};
         bool m_PendingConnection {false};
+
+        // Property updates waiting to be dispatched from the main thread, in the order they arrived.
+        // A number or text property is queued once however often it changes before the dispatch,
+        // since INDI::Property refers to the live property and so carries its latest values anyway.
+        QVector<INDI::Property> m_PendingUpdates;
+        QSet<QString> m_CoalescedUpdates;
+        QMutex m_PendingUpdatesMutex;
+        bool m_DispatchScheduled {false};
+        QTimer m_UpdateTimer;
+        // Number and text updates are dispatched at most this often, in milliseconds
+        static constexpr int UPDATE_INTERVAL {20};
 };
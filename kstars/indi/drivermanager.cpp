@@ -383,18 +383,49 @@ void DriverManager::startLocalDrivers(ServerManager *serverManager)
 {
     connect(serverManager, &ServerManager::driverStarted, this, &DriverManager::processDriverStartup, Qt::UniqueConnection);
     connect(serverManager, &ServerManager::driverFailed, this, &DriverManager::processDriverFailure, Qt::UniqueConnection);
-    QtConcurrent::run(serverManager, &ServerManager::startDriver, serverManager->pendingDrivers().first());
+    connect(serverManager, &ServerManager::driverBatchFinished, this, [this, serverManager](bool success)
+    {
+        processDriverBatch(serverManager, success);
+    });
+    m_DriverStartupTimer.start();
+    startDriverBatch(serverManager);
+}
+
+void DriverManager::startDriverBatch(ServerManager *serverManager)
+{
+    // Drivers without startup rules do not wait for each other, INDI server runs them side by side
+    QtConcurrent::run(serverManager, &ServerManager::startDrivers, serverManager->nextDriverBatch());
 }
 
 void DriverManager::processDriverStartup(const QSharedPointer<DriverInfo> &driver)
 {
+    qCInfo(KSTARS_INDI) << "Driver" << driver->getName() << "started after" << m_DriverStartupTimer.elapsed() << "ms";
     emit driverStarted(driver);
+}
+
+void DriverManager::processDriverFailure(const QSharedPointer<DriverInfo> &driver, const QString &message)
+{
+    emit driverFailed(driver, message);
+
+    qCWarning(KSTARS_INDI) << "Driver" << driver->getName() << "failed to start.";
+}
 
-    auto manager = driver->getServerManager();
+void DriverManager::processDriverBatch(ServerManager *serverManager, bool success)
+{
     // Do we have more pending drivers?
-    if (manager->pendingDrivers().count() > 0)
+    if (serverManager->pendingDrivers().count() > 0)
     {
-        QtConcurrent::run(manager, &ServerManager::startDriver, manager->pendingDrivers().first());
+        if (success)
+            startDriverBatch(serverManager);
+        else
+        {
+            qCWarning(KSTARS_INDI) << "Retrying failed drivers in 5 seconds...";
+            QTimer::singleShot(5000, serverManager, [this, serverManager]()
+            {
+                if (serverManager->pendingDrivers().count() > 0)
+                    startDriverBatch(serverManager);
+            });
+        }
         return;
     }
 
@@ -405,25 +436,7 @@ void DriverManager::processDriverStartup(const QSharedPointer<DriverInfo> &drive
     }
 
     // Otherwise proceed to start Client Manager
-    startClientManager(manager->managedDrivers(), manager->getHost(), manager->getPort());
-}
-
-void DriverManager::processDriverFailure(const QSharedPointer<DriverInfo> &driver, const QString &message)
-{
-    emit driverFailed(driver, message);
-
-    qCWarning(KSTARS_INDI) << "Driver" << driver->getName() << "failed to start. Retrying in 5 seconds...";
-
-    QTimer::singleShot(5000, this, [driver]()
-    {
-        auto manager = driver->getServerManager();
-        // Do we have more pending drivers?
-        if (manager->pendingDrivers().count() > 0)
-        {
-            QtConcurrent::run(manager, &ServerManager::startDriver, manager->pendingDrivers().first());
-            return;
-        }
-    });
+    startClientManager(serverManager->managedDrivers(), serverManager->getHost(), serverManager->getPort());
 }
 
 void DriverManager::startClientManager(const QList<QSharedPointer<DriverInfo>> &qdv, const QString &host, int port)
@@ -12,6 +12,7 @@
 #include "ui_drivermanager.h"
 
 #include <QDialog>
+#include <QElapsedTimer>
 #include <QFrame>
 #include <QIcon>
 #include <QString>
@@ -153,6 +154,8 @@ class DriverManager : public QDialog
 
         void startClientManager(const QList<QSharedPointer<DriverInfo>> &qdv, const QString &host, int port);
         void startLocalDrivers(ServerManager *serverManager);
+        void startDriverBatch(ServerManager *serverManager);
+        void processDriverBatch(ServerManager *serverManager, bool success);
         void processDriverStartup(const QSharedPointer<DriverInfo> &driver);
         void processDriverFailure(const QSharedPointer<DriverInfo> &driver, const QString &message);
 
@@ -179,6 +182,8 @@ class DriverManager : public QDialog
         QList<ClientManager *> clients;
         QStringList driversStringList;
         QPointer<CustomDrivers> m_CustomDrivers;
+        // Time since local drivers started, for the startup log
+        QElapsedTimer m_DriverStartupTimer;
 
     public slots:
         void resizeDeviceColumn();
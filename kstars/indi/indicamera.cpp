@@ -23,13 +23,23 @@
 
 #include <KNotifications/KNotification>
 #include "auxiliary/ksmessagebox.h"
+#include "auxiliary/processinglanes.h"
 #include "ksnotification.h"
 #include <QImageReader>
 #include <QFileInfo>
 #include <QStatusBar>
 #include <QtConcurrent>
 
+#include <chrono>
+
 #include <basedevice.h>
+#include <fitsio.h>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 const QStringList RAWFormats = { "cr2", "cr3", "crw", "nef", "raf", "dng", "arw", "orf" };
 
@@ -38,6 +48,77 @@ const QString &getFITSModeStringString(FITSMode mode)
     return FITSModes[mode];
 }
 
+// Monotonic time in microseconds, the clock the guide module times its loop with (GuideLatency::timestamp()).
+static qint64 monotonicMicroseconds()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Longest side of the frames decoded for the summary preview, see fitsThumbnail()
+static const long g_thumbnailSize = 640;
+
+// A copy of the FITS image in buffer reduced to about g_thumbnailSize pixels across, with its header
+// records. Only the rows and columns kept are read. The step is even so that a Bayer frame keeps
+// the pixels of one color, the thumbnail is then mono. Returns an empty array if the image can't be read.
+static QByteArray fitsThumbnail(const QByteArray &buffer)
+{
+    fitsfile *in = nullptr;
+    int status = 0;
+    void *inBuffer = const_cast<char *>(buffer.constData());
+    size_t inSize = buffer.size();
+    if (fits_open_memfile(&in, "thumbnail", READONLY, &inBuffer, &inSize, 0, nullptr, &status))
+        return QByteArray();
+
+    int bitpix = 0, naxis = 0;
+    long naxes[3] = {1, 1, 1};
+    fits_get_img_param(in, 3, &bitpix, &naxis, naxes, &status);
+    if (status || naxis < 2 || std::max(naxes[0], naxes[1]) <= g_thumbnailSize)
+    {
+        status = 0;
+        fits_close_file(in, &status);
+        return QByteArray();
+    }
+
+    long step = (std::max(naxes[0], naxes[1]) + g_thumbnailSize - 1) / g_thumbnailSize;
+    step += step % 2;
+    long first[3] = {1, 1, 1}, last[3] = {naxes[0], naxes[1], naxes[2]}, inc[3] = {step, step, 1};
+    long size[3] = {(naxes[0] + step - 1) / step, (naxes[1] + step - 1) / step, naxes[2]};
+    std::vector<float> pixels(size[0] * size[1] * size[2]);
+    fits_read_subset(in, TFLOAT, first, last, inc, nullptr, pixels.data(), nullptr, &status);
+
+    fitsfile *out = nullptr;
+    void *outBuffer = nullptr;
+    size_t outSize = 0;
+    fits_create_memfile(&out, &outBuffer, &outSize, 2880, realloc, &status);
+    fits_copy_header(in, out, &status);
+    fits_resize_img(out, FLOAT_IMG, naxis, size, &status);
+    if (status == 0)
+    {
+        // Pixels are written as read, unscaled and no longer a mosaic
+        for (const char *key : {"BZERO", "BSCALE", "BAYERPAT"})
+        {
+            int keyStatus = 0;
+            fits_delete_key(out, key, &keyStatus);
+        }
+    }
+    fits_write_img(out, TFLOAT, 1, pixels.size(), pixels.data(), &status);
+
+    QByteArray thumbnail;
+    int closeStatus = 0;
+    fits_close_file(in, &closeStatus);
+    if (out)
+    {
+        fits_flush_file(out, &status);
+        if (status == 0)
+            thumbnail = QByteArray(static_cast<const char *>(outBuffer), outSize);
+        closeStatus = 0;
+        fits_close_file(out, &closeStatus);
+    }
+    free(outBuffer);
+    return thumbnail;
+}
+
 namespace ISD
 {
 
@@ -50,16 +131,19 @@ Camera::Camera(GenericDevice *parent) : ConcreteDevice(parent)
 
     connect(m_Parent->getClientManager(), &ClientManager::newBLOBManager, this, &Camera::setBLOBManager, Qt::UniqueConnection);
     m_LastNotificationTS = QDateTime::currentDateTime();
+    m_WriterPool.setMaxThreadCount(1);
 }
 
 Camera::~Camera()
 {
     if (m_ImageViewerWindow)
         m_ImageViewerWindow->close();
-    if (fileWriteThread.isRunning())
-        fileWriteThread.waitForFinished();
-    if (fileWriteBuffer != nullptr)
-        delete [] fileWriteBuffer;
+    // Don't lose queued images, the writer thread only exits once the queue is empty.
+    QMutexLocker locker(&m_PendingWritesMutex);
+    while (m_WriterActive)
+        m_PendingWritesChanged.wait(&m_PendingWritesMutex);
+    locker.unlock();
+    fileWriteThread.waitForFinished();
 }
 
 void Camera::setBLOBManager(const char *device, INDI::Property prop)
@@ -569,6 +653,8 @@ bool Camera::generateFilename(bool batch_mode, const QString &extension, QString
         return false;
     test_file.flush();
     test_file.close();
+    // Spare the next sequence ID lookup a directory scan.
+    Ekos::PlaceholderPath::addToFileIndex(*filename);
     return true;
 }
 
@@ -576,36 +662,28 @@ bool Camera::writeImageFile(const QString &filename, INDI::Property prop, bool i
 {
     // TODO: Not yet threading the writes for non-fits files.
     // Would need to deal with the raw conversion, etc.
-    if (is_fits)
+    // XISF images to compress are threaded too, compressing them takes longer than writing them.
+    const bool compress = !is_fits && BType == BLOB_XISF && Options::xISFCompression() > 0;
+    if (is_fits || compress)
     {
-        // Check if the last write is still ongoing, and if so wait.
-        // It is using the fileWriteBuffer.
-        if (fileWriteThread.isRunning())
-        {
-            fileWriteThread.waitForFinished();
-        }
-
-        // Wait until the file is written before overwritting the filename.
-        fileWriteFilename = filename;
-
         // Will write blob data in a separate thread, and can't depend on the blob
         // memory, so copy it first.
-
         auto bp = prop.getBLOB()->at(0);
-        // Check buffer size.
-        if (fileWriteBufferSize != bp->getBlobLen())
-        {
-            if (fileWriteBuffer != nullptr)
-                delete [] fileWriteBuffer;
-            fileWriteBufferSize = bp->getBlobLen();
-            fileWriteBuffer = new char[fileWriteBufferSize];
-        }
+        PendingWrite write { filename, QByteArray(static_cast<const char *>(bp->getBlob()), bp->getBlobLen()), compress };
+
+        QMutexLocker locker(&m_PendingWritesMutex);
+        // Capture normally waits for the queue to drain, see isSaveQueueFull(). Fast exposures don't,
+        // so block here rather than holding an unbounded number of frames in memory.
+        while (m_PendingWrites.size() >= static_cast<int>(Options::imageSaveQueueSize()))
+            m_PendingWritesChanged.wait(&m_PendingWritesMutex);
 
-        // Copy memory, and write file on a separate thread.
         // Probably too late to return an error if the file couldn't write.
-        memcpy(fileWriteBuffer, bp->getBlob(), bp->getBlobLen());
-        fileWriteThread = QtConcurrent::run(this, &ISD::Camera::WriteImageFileInternal, fileWriteFilename, fileWriteBuffer,
-                                            bp->getBlobLen());
+        m_PendingWrites.enqueue(write);
+        if (!m_WriterActive)
+        {
+            m_WriterActive = true;
+            fileWriteThread = QtConcurrent::run(&m_WriterPool, this, &ISD::Camera::processPendingWrites);
+        }
     }
     else
     {
@@ -661,6 +739,7 @@ QSharedPointer<FITSViewer> Camera::getFITSViewer()
 
 bool Camera::processBLOB(INDI::Property prop)
 {
+    const qint64 blobReceivedTime = monotonicMicroseconds();
     auto bvp = prop.getBLOB();
     // Ignore write-only BLOBs since we only receive it for state-change
     if (bvp->getPermission() == IP_WO || bvp->at(0)->getSize() == 0)
@@ -767,6 +846,9 @@ bool Camera::processBLOB(INDI::Property prop)
         m_LastNotificationTS = QDateTime::currentDateTime();
     }
 
+    // The camera is free for the next exposure while this image is loaded and processed.
+    emit frameReceived(targetChip);
+
     // Check if we need to process RAW or regular image. Anything but FITS.
 #if 0
     if (BType == BLOB_IMAGE || BType == BLOB_RAW)
@@ -866,6 +948,22 @@ bool Camera::processBLOB(INDI::Property prop)
     }
 
     QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<char *>(bp->getBlob()), bp->getSize());
+
+    // Sequence images that are only shown in the summary preview are decoded at thumbnail size,
+    // the full image is already on its way to disk.
+    QByteArray thumbnail;
+    if (BType == BLOB_FITS &&
+            targetChip->getCaptureMode() == FITS_NORMAL &&
+            targetChip->isBatchMode() &&
+            Options::useFITSViewer() == false &&
+            Options::summaryPreviewThumbnail() &&
+            Options::autoHFR() == false)
+    {
+        thumbnail = fitsThumbnail(buffer);
+        if (thumbnail.isEmpty() == false)
+            buffer = thumbnail;
+    }
+
     QSharedPointer<FITSData> imageData;
     imageData.reset(new FITSData(targetChip->getCaptureMode()), &QObject::deleteLater);
     if (!imageData->loadFromBuffer(buffer, shortFormat, filename))
@@ -874,6 +972,10 @@ bool Camera::processBLOB(INDI::Property prop)
         return true;
     }
 
+    // Stage times of the guide loop latency statistics
+    imageData->setProperty("blobReceivedTime", blobReceivedTime);
+    imageData->setProperty("loadedTime", monotonicMicroseconds());
+
     handleImage(targetChip, filename, prop, imageData);
     return true;
 }
@@ -1805,8 +1907,37 @@ bool Camera::setScopeInfo(double focalLength, double aperture)
     return true;
 }
 
+bool Camera::isSaveQueueFull()
+{
+    QMutexLocker locker(&m_PendingWritesMutex);
+    return m_PendingWrites.size() >= static_cast<int>(Options::imageSaveQueueSize());
+}
+
+void Camera::processPendingWrites()
+{
+    ProcessingLanes::prioritise(ProcessingLanes::CAPTURE);
+    QMutexLocker locker(&m_PendingWritesMutex);
+    while (!m_PendingWrites.isEmpty())
+    {
+        // Implicitly shared copy, the image stays queued until it is written.
+        const PendingWrite write = m_PendingWrites.head();
+        locker.unlock();
+        QByteArray compressed;
+        if (write.compress && FITSData::compressXISF(write.data, compressed))
+            WriteImageFileInternal(write.filename, compressed.constData(), compressed.size());
+        else
+            WriteImageFileInternal(write.filename, write.data.constData(), write.data.size());
+        locker.relock();
+
+        m_PendingWrites.dequeue();
+        m_PendingWritesChanged.wakeAll();
+    }
+    m_WriterActive = false;
+    m_PendingWritesChanged.wakeAll();
+}
+
 // Internal function to write an image blob to disk.
-bool Camera::WriteImageFileInternal(const QString &filename, char *buffer, const size_t size)
+bool Camera::WriteImageFileInternal(const QString &filename, const char *buffer, const size_t size)
 {
     QFile file(filename);
     if (!file.open(QIODevice::WriteOnly))
@@ -1828,6 +1959,17 @@ bool Camera::WriteImageFileInternal(const QString &filename, char *buffer, const
         }
     }
     ok = file.flush() && ok;
+    // Make sure the image reached the storage device, e.g. before a USB stick is pulled.
+    if (ok && Options::imageSaveSync())
+    {
+#ifdef Q_OS_WIN
+        ok = _commit(file.handle()) == 0;
+#else
+        ok = fsync(file.handle()) == 0;
+#endif
+    }
+    if (!ok)
+        qCCritical(KSTARS_INDI) << "ISD:CCD Error: Unable to write file: " << filename;
     file.close();
     file.setPermissions(QFileDevice::ReadUser |
                         QFileDevice::WriteUser |
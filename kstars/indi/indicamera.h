@@ -15,8 +15,12 @@
 #include "fitsviewer/fitsviewer.h"
 #include "ekos/capture/placeholderpath.h"
 
+#include <QMutex>
+#include <QQueue>
 #include <QStringList>
 #include <QPointer>
+#include <QThreadPool>
+#include <QWaitCondition>
 #include <QtConcurrent>
 
 #include <memory>
@@ -221,6 +225,12 @@ class Camera : public ConcreteDevice
         }
         bool setFastCount(uint32_t count);
 
+        /**
+         * @brief isSaveQueueFull Check whether as many captured images are waiting to be written to disk
+         * as Options::imageSaveQueueSize() allows. Capture should not start new exposures until it drains.
+         */
+        bool isSaveQueueFull();
+
         const QMap<QString, double> &getExposurePresets() const
         {
             return m_ExposurePresets;
@@ -250,8 +260,11 @@ class Camera : public ConcreteDevice
         void videoStreamToggled(bool enabled);
         void videoRecordToggled(bool enabled);
         void newFPS(double instantFPS, double averageFPS);
-        void newVideoFrame(const QSharedPointer<QImage> &frame);
+        /** @p jpeg holds the frame as the driver sent it if it is a JPEG, empty otherwise */
+        void newVideoFrame(const QSharedPointer<QImage> &frame, const QByteArray &jpeg);
         // Data
+        /** Emitted as soon as a captured image is received and, in batch mode, queued for saving, before it is loaded. */
+        void frameReceived(ISD::CameraChip *chip);
         void newImage(const QSharedPointer<FITSData> &data);
         // View
         void newView(const QSharedPointer<FITSView> &view);
@@ -261,7 +274,9 @@ class Camera : public ConcreteDevice
         bool generateFilename(bool batch_mode, const QString &extension, QString *filename);
         // Saves an image to disk on a separate thread.
         bool writeImageFile(const QString &filename, INDI::Property prop, bool is_fits);
-        bool WriteImageFileInternal(const QString &filename, char *buffer, const size_t size);
+        bool WriteImageFileInternal(const QString &filename, const char *buffer, const size_t size);
+        // Writer thread loop, writes the queued images until the queue is empty.
+        void processPendingWrites();
         // Creates or finds the FITSViewer.
         // TODO: Need to remove all FITSViewer related functions from INDI::Camera
         QSharedPointer<FITSViewer> getFITSViewer();
@@ -314,10 +329,22 @@ class Camera : public ConcreteDevice
         QMap<QString, double> m_ExposurePresets;
         QPair<double, double> m_ExposurePresetsMinMax;
 
-        // Used when writing the image fits file to disk in a separate thread.
-        char *fileWriteBuffer { nullptr };
-        int fileWriteBufferSize { 0 };
-        QString fileWriteFilename;
+        // Used when writing the image fits files to disk in a separate thread.
+        // Images stay in the queue while they are written, so its size bounds the memory in use.
+        struct PendingWrite
+        {
+            QString filename;
+            QByteArray data;
+            // XISF image to compress before it is written
+            bool compress { false };
+        };
+        QQueue<PendingWrite> m_PendingWrites;
+        QMutex m_PendingWritesMutex;
+        QWaitCondition m_PendingWritesChanged;
+        bool m_WriterActive { false };
         QFuture<void> fileWriteThread;
+        // Each camera writes on a thread of its own, so the trains of a multi-camera rig don't queue
+        // their images behind each other or behind the image processing in the global pool.
+        QThreadPool m_WriterPool;
 };
 }
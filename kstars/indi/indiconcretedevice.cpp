@@ -104,27 +104,27 @@ void ConcreteDevice::processProperties()
 
 INDI::PropertyView<INumber> *ConcreteDevice::getNumber(const QString &name) const
 {
-    return m_Parent->getBaseDevice().getNumber(name.toLatin1().constData());
+    return m_Parent->getProperty(name).getNumber();
 }
 
 INDI::PropertyView<IText>   *ConcreteDevice::getText(const QString &name) const
 {
-    return m_Parent->getBaseDevice().getText(name.toLatin1().constData());
+    return m_Parent->getProperty(name).getText();
 }
 
 INDI::PropertyView<ISwitch> *ConcreteDevice::getSwitch(const QString &name) const
 {
-    return m_Parent->getBaseDevice().getSwitch(name.toLatin1().constData());
+    return m_Parent->getProperty(name).getSwitch();
 }
 
 INDI::PropertyView<ILight>  *ConcreteDevice::getLight(const QString &name) const
 {
-    return m_Parent->getBaseDevice().getLight(name.toLatin1().constData());
+    return m_Parent->getProperty(name).getLight();
 }
 
 INDI::PropertyView<IBLOB>   *ConcreteDevice::getBLOB(const QString &name) const
 {
-    return m_Parent->getBaseDevice().getBLOB(name.toLatin1().constData());
+    return m_Parent->getProperty(name).getBLOB();
 }
 
 void ConcreteDevice::sendNewProperty(INDI::Property prop)
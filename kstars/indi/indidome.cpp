@@ -204,7 +204,7 @@ void Dome::processSwitch(INDI::Property prop)
             m_Status = DOME_IDLE;
             emit newStatus(m_Status);
         }
-        else if (svp->getState() == IPS_ALERT)
+        else if (svp->getState() == IPS_ALERT && lastStatus != DOME_ERROR)
         {
             m_Status = DOME_ERROR;
             emit newStatus(m_Status);
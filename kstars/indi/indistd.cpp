@@ -175,6 +175,7 @@ void GenericDevice::registerProperty(INDI::Property prop)
     m_ReadyTimer->start();
 
     const QString name = prop.getName();
+    m_PropertyCache.insert(name, prop);
 
     // In case driver already started
     if (name == "CONNECTION")
@@ -304,6 +305,7 @@ void GenericDevice::updateProperty(INDI::Property prop)
 
 void GenericDevice::removeProperty(INDI::Property prop)
 {
+    m_PropertyCache.remove(prop.getName());
     emit propertyDeleted(prop);
 }
 
@@ -850,12 +852,12 @@ bool GenericDevice::setProperty(QObject *setPropCommand)
 bool GenericDevice::getMinMaxStep(const QString &propName, const QString &elementName, double *min, double *max,
                                   double *step)
 {
-    auto nvp = m_BaseDevice.getNumber(propName.toLatin1());
+    auto nvp = getProperty(propName).getNumber();
 
     if (!nvp)
         return false;
 
-    auto np = nvp.findWidgetByName(elementName.toLatin1());
+    auto np = nvp->findWidgetByName(elementName.toLatin1());
 
     if (!np)
         return false;
@@ -869,16 +871,23 @@ bool GenericDevice::getMinMaxStep(const QString &propName, const QString &elemen
 
 IPState GenericDevice::getState(const QString &propName)
 {
-    return m_BaseDevice.getPropertyState(propName.toLatin1().constData());
+    auto prop = getProperty(propName);
+    return prop ? prop.getState() : IPS_IDLE;
 }
 
 IPerm GenericDevice::getPermission(const QString &propName)
 {
-    return m_BaseDevice.getPropertyPermission(propName.toLatin1().constData());
+    auto prop = getProperty(propName);
+    return prop ? prop.getPermission() : IP_RO;
 }
 
 INDI::Property GenericDevice::getProperty(const QString &propName)
 {
+    auto cached = m_PropertyCache.constFind(propName);
+    if (cached != m_PropertyCache.constEnd())
+        return cached.value();
+
+    // Defined by the driver but not registered with us yet
     return m_BaseDevice.getProperty(propName.toLatin1().constData());
 }
 
@@ -999,7 +1008,7 @@ bool GenericDevice::getJSONProperty(const QString &propName, QJsonObject &propOb
 
 bool GenericDevice::getJSONBLOB(const QString &propName, const QString &elementName, QJsonObject &blobObject)
 {
-    auto blobProperty = m_BaseDevice.getProperty(propName.toLatin1().constData());
+    auto blobProperty = getProperty(propName);
     if (!blobProperty.isValid())
         return false;
 
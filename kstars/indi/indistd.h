@@ -13,6 +13,7 @@
 #include <indiproperty.h>
 #include <basedevice.h>
 
+#include <QHash>
 #include <QObject>
 #include <QVariant>
 #include <QJsonArray>
@@ -294,6 +295,8 @@ class GenericDevice : public GDInterface
         QSharedPointer<DriverInfo> m_DriverInfo;
         DeviceInfo *m_DeviceInfo { nullptr };
         INDI::BaseDevice m_BaseDevice;
+        // Registered properties by name, so lookups on the update paths don't scan the base device
+        QHash<QString, INDI::Property> m_PropertyCache;
         ClientManager *m_ClientManager { nullptr };
         QTimer *watchDogTimer { nullptr };
         QTimer *m_ReadyTimer {nullptr};
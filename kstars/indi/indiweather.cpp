@@ -44,7 +44,7 @@ void Weather::processNumber(INDI::Property prop)
 
     if (nvp->isNameMatch("WEATHER_PARAMETERS"))
     {
-        m_Data = QJsonArray();
+        QJsonArray data;
 
         // read all sensor values received
         for (int i = 0; i < nvp->nnp; i++)
@@ -56,8 +56,14 @@ void Weather::processNumber(INDI::Property prop)
                 {"label", number->getLabel()},
                 {"value", number->getValue()}
             };
-            m_Data.push_back(sensor);
+            data.push_back(sensor);
         }
+
+        // Drivers resend their parameters at each refresh, only changes are passed on
+        if (data == m_Data)
+            return;
+
+        m_Data = data;
         emit newData(m_Data);
         emit newJSONData(QJsonDocument(m_Data).toJson());
     }
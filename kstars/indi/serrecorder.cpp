@@ -0,0 +1,175 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "serrecorder.h"
+
+#include "kstars_debug.h"
+
+#include <KLocalizedString>
+
+#include <QDateTime>
+#include <QtConcurrent>
+#include <QtEndian>
+
+#include <cstring>
+
+// SER time stamps count 100 ns ticks from the start of year 1
+static qint64 serTime(const QDateTime &time)
+{
+    return time.toMSecsSinceEpoch() * 10000 + Q_INT64_C(621355968000000000);
+}
+
+SERRecorder::SERRecorder()
+{
+    m_WriterPool.setMaxThreadCount(1);
+}
+
+SERRecorder::~SERRecorder()
+{
+    close();
+}
+
+bool SERRecorder::open(const QString &filename, int width, int height, ColorID color, QString &error)
+{
+    close();
+
+    m_File.setFileName(filename);
+    // The recorder keeps its own buffer
+    if (!m_File.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered))
+    {
+        error = i18n("Failed to create %1: %2", filename, m_File.errorString());
+        return false;
+    }
+
+    m_Width = width;
+    m_Height = height;
+    m_Color = color;
+    const QDateTime now = QDateTime::currentDateTime();
+    m_StartTime = serTime(QDateTime(now.date(), now.time(), Qt::UTC));
+    m_StartTimeUTC = serTime(now.toUTC());
+    m_DroppedFrames = 0;
+    m_Timestamps.clear();
+    m_WriteError = false;
+
+    // The header starts the first block, it is written again with the frame count on close
+    m_Buffer.reserve(WRITE_BUFFER_SIZE + WRITE_BLOCK);
+    m_Buffer = header();
+    return true;
+}
+
+bool SERRecorder::addFrame(const QByteArray &frame)
+{
+    if (!isOpen())
+        return false;
+
+    QMutexLocker locker(&m_FramesMutex);
+    if (m_Frames.size() >= MAX_QUEUED_FRAMES)
+    {
+        m_DroppedFrames++;
+        return false;
+    }
+
+    m_Frames.enqueue(frame);
+    m_Timestamps.append(serTime(QDateTime::currentDateTimeUtc()));
+    if (!m_WriterActive)
+    {
+        m_WriterActive = true;
+        m_Writer = QtConcurrent::run(&m_WriterPool, [this]()
+        {
+            processFrames();
+        });
+    }
+    return true;
+}
+
+void SERRecorder::close()
+{
+    if (!isOpen())
+        return;
+
+    QMutexLocker locker(&m_FramesMutex);
+    while (m_WriterActive)
+        m_FramesChanged.wait(&m_FramesMutex);
+    locker.unlock();
+    m_Writer.waitForFinished();
+
+    // Time stamps follow the last frame
+    for (const auto &timestamp : m_Timestamps)
+    {
+        char value[sizeof(qint64)];
+        qToLittleEndian(timestamp, value);
+        m_Buffer.append(value, sizeof(value));
+    }
+    writeBuffer(true);
+
+    if (m_File.seek(0))
+        m_File.write(header());
+
+    if (m_WriteError)
+        qCWarning(KSTARS) << "Failed to write" << m_File.fileName() << m_File.errorString();
+    else
+        qCInfo(KSTARS) << "Recorded" << m_Timestamps.size() << "frames to" << m_File.fileName() << "and dropped" <<
+                       m_DroppedFrames;
+
+    m_File.close();
+    m_Buffer.clear();
+    m_Buffer.squeeze();
+}
+
+void SERRecorder::processFrames()
+{
+    QMutexLocker locker(&m_FramesMutex);
+    while (!m_Frames.isEmpty())
+    {
+        const QByteArray frame = m_Frames.dequeue();
+        m_FramesChanged.wakeAll();
+        locker.unlock();
+
+        m_Buffer.append(frame);
+        if (m_Buffer.size() >= static_cast<int>(WRITE_BUFFER_SIZE))
+            writeBuffer(false);
+
+        locker.relock();
+    }
+    m_WriterActive = false;
+    m_FramesChanged.wakeAll();
+}
+
+void SERRecorder::writeBuffer(bool all)
+{
+    // Whole blocks only, the rest waits for the next frames
+    const qint64 size = all ? m_Buffer.size() : (m_Buffer.size() / WRITE_BLOCK) * WRITE_BLOCK;
+    if (size == 0)
+        return;
+
+    if (!m_WriteError && m_File.write(m_Buffer.constData(), size) != size)
+        m_WriteError = true;
+
+    const qint64 rest = m_Buffer.size() - size;
+    if (rest > 0)
+        std::memmove(m_Buffer.data(), m_Buffer.constData() + size, rest);
+    m_Buffer.resize(rest);
+}
+
+QByteArray SERRecorder::header() const
+{
+    QByteArray header(178, 0);
+    char *data = header.data();
+
+    std::memcpy(data, "LUCAM-RECORDER", 14);
+    qToLittleEndian<qint32>(0, data + 14);
+    qToLittleEndian<qint32>(m_Color, data + 18);
+    qToLittleEndian<qint32>(0, data + 22);
+    qToLittleEndian<qint32>(m_Width, data + 26);
+    qToLittleEndian<qint32>(m_Height, data + 30);
+    qToLittleEndian<qint32>(8, data + 34);
+    qToLittleEndian<qint32>(m_Timestamps.size(), data + 38);
+    // Observer, instrument and telescope are left blank
+    qToLittleEndian<qint64>(m_StartTime, data + 162);
+    qToLittleEndian<qint64>(m_StartTimeUTC, data + 170);
+
+    return header;
+}
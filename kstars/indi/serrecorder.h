@@ -0,0 +1,104 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QFuture>
+#include <QMutex>
+#include <QQueue>
+#include <QThreadPool>
+#include <QVector>
+#include <QWaitCondition>
+
+/**
+ * @class SERRecorder
+ * @short Records raw video frames to a SER file on a thread of its own.
+ *
+ * Frames are queued as they arrive and written by the recorder thread into a large buffer
+ * that goes to disk in whole blocks, so the file is written at block aligned offsets.
+ * If the disk falls behind and the queue is full, frames are dropped rather than stalling
+ * the caller.
+ */
+class SERRecorder
+{
+    public:
+        /** SER color IDs */
+        typedef enum
+        {
+            MONO = 0,
+            BAYER_RGGB = 8,
+            BAYER_GRBG = 9,
+            BAYER_GBRG = 10,
+            BAYER_BGGR = 11,
+            RGB = 100
+        } ColorID;
+
+        SERRecorder();
+        ~SERRecorder();
+
+        /**
+         * @brief open Create @p filename for frames of @p width by @p height 8 bit pixels
+         * @return false with @p error set if the file could not be created
+         */
+        bool open(const QString &filename, int width, int height, ColorID color, QString &error);
+
+        /**
+         * @brief addFrame Queue a frame for writing, time stamped now
+         * @return false if the frame was dropped because the disk is falling behind
+         */
+        bool addFrame(const QByteArray &frame);
+
+        /** @brief close Write the queued frames and the trailer, then close the file */
+        void close();
+
+        bool isOpen() const
+        {
+            return m_File.isOpen();
+        }
+        uint32_t frameCount() const
+        {
+            return m_Timestamps.size();
+        }
+        uint32_t droppedFrames() const
+        {
+            return m_DroppedFrames;
+        }
+
+    private:
+        void processFrames();
+        void writeBuffer(bool all);
+        QByteArray header() const;
+
+        QFile m_File;
+        int m_Width { 0 };
+        int m_Height { 0 };
+        ColorID m_Color { MONO };
+        qint64 m_StartTime { 0 };
+        qint64 m_StartTimeUTC { 0 };
+        uint32_t m_DroppedFrames { 0 };
+        // Timestamps of the frames queued so far, written as the trailer of the file
+        QVector<qint64> m_Timestamps;
+
+        // Only touched by the recorder thread while it runs
+        QByteArray m_Buffer;
+        bool m_WriteError { false };
+
+        QQueue<QByteArray> m_Frames;
+        QMutex m_FramesMutex;
+        QWaitCondition m_FramesChanged;
+        bool m_WriterActive { false };
+        QThreadPool m_WriterPool;
+        QFuture<void> m_Writer;
+
+        // Size of the blocks the buffer is written in
+        static const uint32_t WRITE_BLOCK = 1 << 20;
+        // The buffer is written once it holds this much
+        static const uint32_t WRITE_BUFFER_SIZE = 8 * WRITE_BLOCK;
+        // Frames beyond this are dropped
+        static const uint16_t MAX_QUEUED_FRAMES = 256;
+};
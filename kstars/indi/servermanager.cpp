@@ -283,6 +283,39 @@ void ServerManager::startDriver(const QSharedPointer<DriverInfo> &driver)
     emit driverStarted(driver);
 }
 
+void ServerManager::startDrivers(const QList<QSharedPointer<DriverInfo>> &drivers)
+{
+    bool success = true;
+    for (auto &oneDriver : drivers)
+    {
+        startDriver(oneDriver);
+        // Drivers that failed to start remain pending
+        if (m_PendingDrivers.contains(oneDriver))
+            success = false;
+    }
+
+    emit driverBatchFinished(success);
+}
+
+QList<QSharedPointer<DriverInfo>> ServerManager::nextDriverBatch() const
+{
+    QList<QSharedPointer<DriverInfo>> batch;
+    for (auto &oneDriver : m_PendingDrivers)
+    {
+        const QJsonObject rule = oneDriver->startupRule();
+        const bool hasRule = rule["PreDelay"].toInt(0) > 0 || rule["PostDelay"].toInt(0) > 0 ||
+                             rule["PreScript"].toString().isEmpty() == false || rule["PostScript"].toString().isEmpty() == false;
+
+        if (hasRule && batch.isEmpty() == false)
+            break;
+        batch.append(oneDriver);
+        if (hasRule)
+            break;
+    }
+
+    return batch;
+}
+
 void ServerManager::stopDriver(const QSharedPointer<DriverInfo> &driver)
 {
     QTextStream out(&indiFIFO);
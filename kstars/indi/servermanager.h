@@ -56,6 +56,19 @@ class ServerManager : public QObject
         }
 
         void startDriver(const QSharedPointer<DriverInfo> &driver);
+
+        /**
+         * @brief startDrivers Start drivers one after the other, then emit driverBatchFinished().
+         * @param drivers Pending drivers, see nextDriverBatch().
+         */
+        void startDrivers(const QList<QSharedPointer<DriverInfo>> &drivers);
+
+        /**
+         * @brief nextDriverBatch Pending drivers that may be started together. A driver with a startup rule
+         * may depend on the drivers before it, or be needed by those after it, so it is started on its own.
+         */
+        QList<QSharedPointer<DriverInfo>> nextDriverBatch() const;
+
         void stopDriver(const QSharedPointer<DriverInfo> &driver);
         bool restartDriver(const QSharedPointer<DriverInfo> &driver);
 
@@ -119,4 +132,6 @@ class ServerManager : public QObject
         void driverStopped(const QSharedPointer<DriverInfo> &driver);
         void driverRestarted(const QSharedPointer<DriverInfo> &driver);
         void driverFailed(const QSharedPointer<DriverInfo> &driver, const QString &message);
+        // All drivers of a startDrivers() batch were processed, success is false if any of them failed.
+        void driverBatchFinished(bool success);
 };
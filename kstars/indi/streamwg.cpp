@@ -12,6 +12,7 @@
 #include "Options.h"
 #include "kstars_debug.h"
 #include "collimationoverlayoptions.h"
+#include "ksnotification.h"
 #include "qobjectdefs.h"
 
 #include <basedevice.h>
@@ -302,6 +303,12 @@ void StreamWG::enableStream(bool enable)
     }
     else
     {
+        if (m_LocalRecording)
+        {
+            stopLocalRecording();
+            updateRecordStatus(false);
+        }
+
         processStream = false;
         //instFPS->setText("--");
         avgFPS->setText("--");
@@ -333,6 +340,10 @@ void StreamWG::setSize(int wd, int ht)
 
 void StreamWG::updateRecordStatus(bool enabled)
 {
+    // The driver is not recording this one
+    if (m_LocalRecording)
+        return;
+
     if ((enabled && isRecording) || (!enabled && !isRecording))
         return;
 
@@ -358,7 +369,19 @@ void StreamWG::toggleRecord()
         isRecording = false;
         recordB->setToolTip(i18n("Start recording"));
 
-        m_Camera->stopRecording();
+        if (m_LocalRecording)
+            stopLocalRecording();
+        else
+            m_Camera->stopRecording();
+    }
+    else if (options->recordLocallyC->isChecked())
+    {
+        isRecording = startLocalRecording();
+        if (isRecording)
+        {
+            recordB->setIcon(stopIcon);
+            recordB->setToolTip(i18n("Stop recording"));
+        }
     }
     else
     {
@@ -397,6 +420,14 @@ void StreamWG::newFrame(INDI::Property prop)
 {
     auto bp = prop.getBLOB()->at(0);
 
+    if (m_LocalRecording)
+    {
+        recordFrame(bp);
+        // Decoding every frame would limit the recording rate
+        if (m_LocalRecording && (m_RecordedFrames - 1) % options->displayEverySpin->value() != 0)
+            return;
+    }
+
     bool rc = (m_DebayerActive
                && !strcmp(bp->getFormat(), ".stream")) ? videoFrame->newBayerFrame(bp, m_DebayerParams) : videoFrame->newFrame(bp);
 
@@ -404,6 +435,117 @@ void StreamWG::newFrame(INDI::Property prop)
         qCWarning(KSTARS) << "Failed to load video frame.";
 }
 
+bool StreamWG::startLocalRecording()
+{
+    QString filename = options->recordFilenameEdit->text();
+    QString directory = options->recordDirectoryEdit->text();
+    const QDateTime now = QDateTime::currentDateTime();
+    for (auto text : {&filename, &directory})
+    {
+        text->replace("_D_", now.toString("yyyy-MM-dd"));
+        text->replace("_H_", now.toString("HH-mm-ss"));
+        text->replace("_T_", now.toString("yyyy-MM-ddTHH-mm-ss"));
+        // No filter is known here
+        text->replace("_F_", "");
+    }
+    if (filename.isEmpty())
+        filename = QString("%1_%2").arg(m_Camera->getDeviceName(), now.toString("yyyy-MM-ddTHH-mm-ss"));
+    if (!filename.endsWith(".ser", Qt::CaseInsensitive))
+        filename += ".ser";
+
+    if (!QDir().mkpath(directory))
+    {
+        KSNotification::error(i18n("Failed to create directory %1", directory));
+        return false;
+    }
+
+    // The file is created with the first frame, which tells its pixel format
+    m_RecordFilename = QDir(directory).filePath(filename);
+    m_Recorder.reset(new SERRecorder());
+    m_RecordedFrames = 0;
+    m_RecordTimer.start();
+    m_LocalRecording = true;
+    return true;
+}
+
+void StreamWG::stopLocalRecording()
+{
+    m_LocalRecording = false;
+    if (!m_Recorder)
+        return;
+
+    const uint32_t dropped = m_Recorder->droppedFrames();
+    m_Recorder->close();
+    m_Recorder.reset();
+
+    if (dropped > 0)
+        KSNotification::event(QLatin1String("IndiServerMessage"),
+                              i18np("%1 frame was dropped while recording %2, the disk could not keep up.",
+                                    "%1 frames were dropped while recording %2, the disk could not keep up.", dropped, m_RecordFilename),
+                              KSNotification::INDI, KSNotification::Warn);
+}
+
+void StreamWG::recordFrame(const IBLOB *bp)
+{
+    if (!m_Recorder->isOpen())
+    {
+        const uint32_t pixels = streamWidth * streamHeight;
+        const bool raw = !strcmp(bp->format, ".stream");
+        if (!raw || pixels == 0 || (bp->size != static_cast<int>(pixels) && bp->size != static_cast<int>(pixels * 3)))
+        {
+            stopLocalRecording();
+            updateRecordStatus(false);
+            KSNotification::error(i18n("Only uncompressed 8 bit streams can be recorded locally."));
+            return;
+        }
+
+        SERRecorder::ColorID color = SERRecorder::RGB;
+        if (bp->size == static_cast<int>(pixels))
+        {
+            color = SERRecorder::MONO;
+            if (m_DebayerActive)
+            {
+                switch (m_DebayerParams.filter)
+                {
+                    case DC1394_COLOR_FILTER_RGGB:
+                        color = SERRecorder::BAYER_RGGB;
+                        break;
+                    case DC1394_COLOR_FILTER_GBRG:
+                        color = SERRecorder::BAYER_GBRG;
+                        break;
+                    case DC1394_COLOR_FILTER_GRBG:
+                        color = SERRecorder::BAYER_GRBG;
+                        break;
+                    case DC1394_COLOR_FILTER_BGGR:
+                        color = SERRecorder::BAYER_BGGR;
+                        break;
+                }
+            }
+        }
+
+        QString error;
+        if (!m_Recorder->open(m_RecordFilename, streamWidth, streamHeight, color, error))
+        {
+            stopLocalRecording();
+            updateRecordStatus(false);
+            KSNotification::error(error);
+            return;
+        }
+    }
+
+    // The blob belongs to the INDI client, the recorder thread gets a copy
+    m_Recorder->addFrame(QByteArray(static_cast<const char *>(bp->blob), bp->size));
+    m_RecordedFrames++;
+
+    const bool done = (options->recordDurationR->isChecked() && m_RecordTimer.elapsed() >= options->durationSpin->value() * 1000)
+                      || (options->recordFramesR->isChecked() && m_RecordedFrames >= static_cast<uint32_t>(options->framesSpin->value()));
+    if (done)
+    {
+        stopLocalRecording();
+        updateRecordStatus(false);
+    }
+}
+
 void StreamWG::resetFrame()
 {
     m_Camera->resetStreamingFrame();
@@ -10,10 +10,12 @@
 #include "ui_streamform.h"
 #include "ui_recordingoptions.h"
 #include "fitsviewer/bayer.h"
+#include "serrecorder.h"
 #include <indidevapi.h>
 
 #include <QCloseEvent>
 #include <QColor>
+#include <QElapsedTimer>
 #include <QIcon>
 #include <QImage>
 #include <QPaintEvent>
@@ -22,6 +24,8 @@
 #include <QVBoxLayout>
 #include <QVector>
 
+#include <memory>
+
 class RecordOptions : public QDialog, public Ui::recordingOptions
 {
         Q_OBJECT
@@ -83,11 +87,16 @@ class StreamWG : public QDialog, public Ui::streamForm
 
     signals:
         void hidden();
-        void imageChanged(const QSharedPointer<QImage> &frame);
+        void imageChanged(const QSharedPointer<QImage> &frame, const QByteArray &jpeg);
 
     private:
         bool queryDebayerParameters();
 
+        // Recording raw frames to a SER file on this computer
+        bool startLocalRecording();
+        void stopLocalRecording();
+        void recordFrame(const IBLOB *bp);
+
         bool processStream;
         int streamWidth, streamHeight;
         bool colorFrame, isRecording;
@@ -107,4 +116,10 @@ class StreamWG : public QDialog, public Ui::streamForm
 
         // Options panels
         RecordOptions *options;
+
+        std::unique_ptr<SERRecorder> m_Recorder;
+        QString m_RecordFilename;
+        QElapsedTimer m_RecordTimer;
+        uint32_t m_RecordedFrames { 0 };
+        bool m_LocalRecording { false };
 };
@@ -11,6 +11,7 @@
 #include "kstarsdata.h"
 #include "kstars.h"
 
+#include <QBuffer>
 #include <QImageReader>
 #include <QMouseEvent>
 #include <QResizeEvent>
@@ -22,6 +23,7 @@
 VideoWG::VideoWG(QWidget *parent) : QLabel(parent)
 {
     streamImage.reset(new QImage());
+    m_FrameRing.resize(FRAME_RING_SIZE);
 
     grayTable.resize(256);
 
@@ -46,35 +48,73 @@ bool VideoWG::newFrame(IBLOB *bp)
         format.remove('.');
         format.remove("stream_");
         m_RawFormatSupported = QImageReader::supportedImageFormats().contains(format.toLatin1());
+        m_RawFormatJPEG = (format == "jpg" || format == "jpeg" || format == "mjpg" || format == "mjpeg");
         m_RawFormat = format;
     }
 
+    const auto blob = static_cast<const char *>(bp->blob);
     if (m_RawFormatSupported)
-        rc = streamImage->loadFromData(static_cast<uchar *>(bp->blob), bp->size);
-    else if (static_cast<uint32_t>(bp->size) == totalBaseCount)
     {
-        streamImage.reset(new QImage(static_cast<uchar *>(bp->blob), streamW, streamH, QImage::Format_Indexed8));
-        streamImage->setColorTable(grayTable);
-        rc = !streamImage->isNull();
+        // QImageReader decodes into the buffer of the frame when the size and format match
+        QBuffer buffer;
+        buffer.setData(QByteArray::fromRawData(blob, bp->size));
+        buffer.open(QIODevice::ReadOnly);
+        QImageReader reader(&buffer);
+        QImage &frame = nextFrame();
+        rc = reader.read(&frame);
+        if (rc)
+            showFrame(frame, m_RawFormatJPEG ? QByteArray(blob, bp->size) : QByteArray());
     }
-    else if (static_cast<uint32_t>(bp->size) == totalBaseCount * 3)
+    else if (static_cast<uint32_t>(bp->size) == totalBaseCount || static_cast<uint32_t>(bp->size) == totalBaseCount * 3)
     {
-        streamImage.reset(new QImage(static_cast<uchar *>(bp->blob), streamW, streamH, QImage::Format_RGB888));
-        rc = !streamImage->isNull();
+        const bool gray = static_cast<uint32_t>(bp->size) == totalBaseCount;
+        QImage &frame = nextFrame(streamW, streamH, gray ? QImage::Format_Indexed8 : QImage::Format_RGB888);
+        rc = !frame.isNull();
+        if (rc)
+        {
+            if (gray)
+                frame.setColorTable(grayTable);
+
+            // Lines of the frame are padded to 32 bits, those of the blob are not
+            const int lineSize = gray ? streamW : streamW * 3;
+            for (int y = 0; y < streamH; y++)
+                memcpy(frame.scanLine(y), blob + y * lineSize, lineSize);
+            showFrame(frame);
+        }
     }
 
-    if (rc)
-    {
-        kPix = QPixmap::fromImage(streamImage->scaled(size(), Qt::KeepAspectRatio));
+    return rc;
+}
+
+QImage &VideoWG::nextFrame()
+{
+    m_FrameIndex = (m_FrameIndex + 1) % FRAME_RING_SIZE;
+    QImage &frame = m_FrameRing[m_FrameIndex];
+    // A receiver still holds on to this one, leave its buffer to it
+    if (!frame.isNull() && !frame.isDetached())
+        frame = QImage();
+    return frame;
+}
 
-        paintOverlay(kPix);
+QImage &VideoWG::nextFrame(int width, int height, QImage::Format format)
+{
+    QImage &frame = nextFrame();
+    if (frame.width() != width || frame.height() != height || frame.format() != format)
+        frame = QImage(width, height, format);
+    return frame;
+}
 
-        setPixmap(kPix);
-    }
+void VideoWG::showFrame(const QImage &frame, const QByteArray &jpeg)
+{
+    streamImage.reset(new QImage(frame));
 
-    emit imageChanged(streamImage);
+    kPix = QPixmap::fromImage(frame.scaled(size(), Qt::KeepAspectRatio));
 
-    return rc;
+    paintOverlay(kPix);
+
+    setPixmap(kPix);
+
+    emit imageChanged(streamImage, jpeg);
 }
 
 bool VideoWG::save(const QString &filename, const char *format)
@@ -140,15 +180,22 @@ void VideoWG::mouseReleaseEvent(QMouseEvent *event)
 
 bool VideoWG::debayer(const IBLOB *bp, const BayerParams &params)
 {
-    uint32_t rgb_size = streamW * streamH * 3;
-    auto * destinationBuffer = new uint8_t[rgb_size];
-
-    if (destinationBuffer == nullptr)
+    QImage &frame = nextFrame(streamW, streamH, QImage::Format_RGB888);
+    if (frame.isNull())
     {
-        qCCritical(KSTARS) << "Unable to allocate memory for temporary bayer buffer.";
+        qCCritical(KSTARS) << "Unable to allocate memory for bayer frame.";
         return false;
     }
 
+    // Decode straight into the frame unless its lines are padded
+    const int lineSize = streamW * 3;
+    uint8_t * destinationBuffer = frame.bits();
+    if (frame.bytesPerLine() != lineSize)
+    {
+        m_BayerBuffer.resize(lineSize * streamH);
+        destinationBuffer = m_BayerBuffer.data();
+    }
+
     int ds1394_height = streamH;
 
     uint8_t * dc1394_source = reinterpret_cast<uint8_t*>(bp->blob);
@@ -167,26 +214,17 @@ bool VideoWG::debayer(const IBLOB *bp, const BayerParams &params)
     if (error_code != DC1394_SUCCESS)
     {
         qCCritical(KSTARS) << "Debayer failed" << error_code;
-        delete[] destinationBuffer;
         return false;
     }
 
-    streamImage.reset(new QImage(destinationBuffer, streamW, streamH, QImage::Format_RGB888));
-    bool rc = !streamImage->isNull();
-
-    if (rc)
+    if (destinationBuffer != frame.bits())
     {
-        kPix = QPixmap::fromImage(streamImage->scaled(size(), Qt::KeepAspectRatio));
-
-        paintOverlay(kPix);
-
-        setPixmap(kPix);
+        for (int y = 0; y < streamH; y++)
+            memcpy(frame.scanLine(y), destinationBuffer + y * lineSize, lineSize);
     }
 
-    emit imageChanged(streamImage);
-
-    delete[] destinationBuffer;
-    return rc;
+    showFrame(frame);
+    return true;
 }
 
 void VideoWG::paintOverlay(QPixmap &imagePix)
@@ -10,6 +10,7 @@
 
 #include <indidevapi.h>
 
+#include <QImage>
 #include <QPixmap>
 #include <QVector>
 #include <QColor>
@@ -21,7 +22,6 @@
 #include <memory>
 #include <mutex>
 
-class QImage;
 class QRubberBand;
 class QSqlTableModel;
 
@@ -53,16 +53,31 @@ class VideoWG : public QLabel
 
     signals:
         void newSelection(QRect);
-        void imageChanged(const QSharedPointer<QImage> &frame);
+        /**
+         * @brief imageChanged Emitted for every frame received.
+         * @param frame Decoded frame. Its buffer is reused for a later frame unless a receiver keeps a copy of the QImage.
+         * @param jpeg The frame as the driver sent it if it is a JPEG, so that it can be passed on without encoding it
+         * again. Empty for other formats.
+         */
+        void imageChanged(const QSharedPointer<QImage> &frame, const QByteArray &jpeg);
 
     private:
         bool debayer(const IBLOB *bp, const BayerParams &params);
+        // Next image of the frame ring, reusing its buffer when nothing else refers to it any more
+        QImage &nextFrame();
+        QImage &nextFrame(int width, int height, QImage::Format format);
+        void showFrame(const QImage &frame, const QByteArray &jpeg = QByteArray());
 
         uint16_t streamW { 0 };
         uint16_t streamH { 0 };
         uint32_t totalBaseCount { 0 };
         QVector<QRgb> grayTable;
         QSharedPointer<QImage> streamImage;
+        // Frames are decoded into a fixed set of buffers rather than into a new image each
+        QVector<QImage> m_FrameRing;
+        int m_FrameIndex { 0 };
+        QVector<uint8_t> m_BayerBuffer;
+        bool m_RawFormatJPEG { false };
         QPixmap kPix;
         QRubberBand *rubberBand { nullptr };
         QPoint origin;
@@ -81,4 +96,7 @@ class VideoWG : public QLabel
         QPainter *painter = nullptr;
         float scale;
         void PaintOneItem (QString type, QPointF position, int sizeX, int sizeY, int thickness);
+
+        // Enough for the receivers still busy with the previous frames
+        static const uint8_t FRAME_RING_SIZE = 4;
 };
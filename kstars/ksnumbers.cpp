@@ -8,6 +8,15 @@
 #include "ksnumbers.h"
 
 #include "kstarsdatetime.h" //for J2000 define
+#include "Options.h"
+
+#include <QCache>
+#include <QMutex>
+
+#include <cmath>
+
+// Number of rounded times whose numbers are kept by KSNumbers::shared()
+static const int g_sharedCount = 1024;
 
 // 63 elements
 const int KSNumbers::arguments[NUTTERMS][5] = {
@@ -152,6 +161,35 @@ void KSNumbers::computeConstantValues()
     P2B(2, 2) = CYB;
 }
 
+std::shared_ptr<const KSNumbers> KSNumbers::shared(long double jd)
+{
+    typedef std::shared_ptr<const KSNumbers> Shared;
+    static QMutex mutex;
+    static QCache<qint64, Shared> cache(g_sharedCount);
+
+    const long double resolution = Options::numbersCacheResolution() / 86400.0L;
+    if (!(resolution > 0))
+        return std::make_shared<const KSNumbers>(jd);
+
+    // The entry of a key is checked against the time it stands for, in case the
+    // resolution was changed since
+    const qint64 key          = qint64(std::floor(jd / resolution + 0.5L));
+    const long double rounded = key * resolution;
+    {
+        QMutexLocker locker(&mutex);
+        const Shared *entry = cache.object(key);
+        if (entry != nullptr && (*entry)->julianDay() == rounded)
+            return *entry;
+    }
+
+    // Computed unlocked, another thread may insert the same numbers meanwhile
+    Shared numbers = std::make_shared<const KSNumbers>(rounded);
+
+    QMutexLocker locker(&mutex);
+    cache.insert(key, new Shared(numbers));
+    return numbers;
+}
+
 void KSNumbers::updateValues(long double jd)
 {
     dms arg;
@@ -21,6 +21,8 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <memory>
+
 #define NUTTERMS 63
 
 /** @class KSNumbers
@@ -47,6 +49,16 @@ class KSNumbers
      * @param jd  Julian Day for which the new instance is initialized
      */
     explicit KSNumbers(long double jd);
+
+    /**
+     * @short The numbers for @p jd rounded to Options::numbersCacheResolution() seconds
+     *
+     * The instances are kept and shared between callers, from any thread, so that loops
+     * over many nearby times do not compute the same numbers again and again. As the
+     * Julian Day itself is rounded, they suit the apparent places of stars and deep-sky
+     * objects but not the positions of solar system bodies, which follow julianDay().
+     */
+    static std::shared_ptr<const KSNumbers> shared(long double jd);
     ~KSNumbers() = default;
 
     /**
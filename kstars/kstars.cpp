@@ -21,6 +21,7 @@
 #include "texturemanager.h"
 #include "dialogs/finddialog.h"
 #include "dialogs/exportimagedialog.h"
+#include "auxiliary/kstrace.h"
 #include "skycomponents/starblockfactory.h"
 #ifdef HAVE_INDI
 #include "ekos/manager.h"
@@ -72,6 +73,7 @@ KStars::KStars(bool doSplash, bool clockrun, const QString &startdate)
         KSUtils::Logging::UseDefault();
 
     KSUtils::Logging::SyncFilterRules();
+    KSTrace::Instance()->setEnabled(Options::ekosTracing());
 
     qCInfo(KSTARS) << "Welcome to KStars" << KSTARS_VERSION << KSTARS_BUILD_RELEASE;
     qCInfo(KSTARS) << "Build:" << KSTARS_BUILD_TS;
@@ -421,6 +421,30 @@ class KStars : public KXmlGuiWindow
         Q_SCRIPTABLE Q_NOREPLY void exportImage(const QString &filename, int width = -1, int height = -1,
                                                 bool includeLegend = false);
 
+        /** DBUS interface function.  Export a chart of the sky around each of many objects, without changing the map.
+             * The charts are exported in the background, one per event loop iteration.
+             * @param objectNames names of the objects at the center of the charts
+             * @param directory local directory of the charts, each named after its object with the extension .png
+             * @param fov width of the charts in degrees
+             * @param width the width of the charts in pixels
+             * @param height the height of the charts in pixels
+             * @return the number of charts queued, objects not found are skipped
+             */
+        Q_SCRIPTABLE int exportCharts(const QStringList &objectNames, const QString &directory, double fov,
+                                      int width, int height);
+
+        /** DBUS interface function.  Export a chart of the sky, without changing the map.
+             * The chart is exported in the background after the charts already queued.
+             * @param RA_J2000 J2000.0 Right Ascension of the center of the chart in hours
+             * @param Dec_J2000 J2000.0 Declination of the center of the chart in degrees
+             * @param fov width of the chart in degrees
+             * @param filename local file of the chart, its extension gives the image format
+             * @param width the width of the chart in pixels
+             * @param height the height of the chart in pixels
+             */
+        Q_SCRIPTABLE Q_NOREPLY void exportChart(double RA_J2000, double Dec_J2000, double fov, const QString &filename,
+                                                int width, int height);
+
         /** DBUS interface function.  Return a URL to retrieve Digitized Sky Survey image.
              * @param objectName name of the object.
              * @note If the object is note found, the string "ERROR" is returned.
@@ -451,6 +475,21 @@ class KStars : public KXmlGuiWindow
              */
         Q_SCRIPTABLE QString getObjectPositionInfo(const QString &objectName);
 
+        /** DBUS interface function.  Return XML containing position info about many sky objects at once
+             * @param objectNames names of the objects.
+             * @note The root element holds an object element for each name, in the same order and with the
+             * same content as getObjectPositionInfo(). The element of an object that was not found only has its Name.
+             */
+        Q_SCRIPTABLE QString getObjectsPositionInfo(const QStringList &objectNames);
+
+        /** DBUS interface function.  Return XML containing position info about many J2000.0 coordinates at once
+             * @param RA_J2000 J2000.0 right ascensions, in degrees
+             * @param Dec_J2000 J2000.0 declinations, in degrees
+             * @note The root element holds an object element for each pair of coordinates, named after them,
+             * with the same content as getObjectPositionInfo().
+             */
+        Q_SCRIPTABLE QString getCoordinatesPositionInfo(const QList<double> &RA_J2000, const QList<double> &Dec_J2000);
+
         /** DBUS interface function. Render eyepiece view and save it in the file(s) specified
              * @note See EyepieceField::renderEyepieceView() for more info. This is a DBus proxy that calls that method, and then writes the resulting image(s) to file(s).
              * @note Important: If imagePath is empty, but overlay is true, or destPathImage is supplied, this method will make a blocking DSS download.
@@ -473,6 +512,13 @@ class KStars : public KXmlGuiWindow
              */
         Q_SCRIPTABLE QString getSkyMapDimensions();
 
+        /** DBUS interface function.  Get the time spent on each part of the sky map.
+             * @return newline-separated lines of tab-separated fields: the name of a component, the phase
+             * (update, cull, project, draw or label), and its milliseconds in the last frame and on average.
+             * The first line is the whole frame, with an empty phase.
+             */
+        Q_SCRIPTABLE QString getDrawTimings();
+
         /** DBUS interface function.  Return a newline-separated list of objects in the observing wishlist.
              * @note Unfortunately, unnamed objects are troublesome. Hopefully, we don't have them on the observing list.
              */
@@ -31,9 +31,11 @@
 
 #include <QSqlQuery>
 #include <QSqlRecord>
+#include <QElapsedTimer>
 #include <QtConcurrent>
 
 #include "kstars_debug.h"
+#include "kstars_startup_debug.h"
 
 // Qt version calming
 #include <qtskipemptyparts.h>
@@ -113,6 +115,53 @@ KStarsData::KStarsData()
 #endif
     // at startup times run forward
     setTimeDirection(0.0);
+    initTimeTiers();
+}
+
+void KStarsData::initTimeTiers()
+{
+    // Precession and nutation change little in a day. Their new values are taken up by the sky update
+    const int numbers = m_TimeTiers.addTier("Precession", []()
+    {
+        return 1.0;
+    }, [this](KSNumbers * num)
+    {
+        m_preUpdateNumID++;
+        m_preUpdateNum = KSNumbers(*num);
+    });
+
+    m_TimeTiers.addTier("Solar system bodies", []()
+    {
+        return 0.01;
+    }, [this](KSNumbers * num)
+    {
+        skyComposite()->updateSolarSystemBodies(num);
+    });
+
+    // Moon moves ~30 arcmin/hr, so update its position every minute.
+    m_TimeTiers.addTier("Moons", []()
+    {
+        return 0.00069444;
+    }, [this](KSNumbers * num)
+    {
+        skyComposite()->updateMoons(num);
+    });
+
+    //Update Alt/Az coordinates.  Timescale varies with zoom level
+    //If Clock is in Manual Mode, always update. (?)
+    const int sky = m_TimeTiers.addTier("Sky", [this]()
+    {
+        return clock()->isManualMode() ? -1.0 : 0.1 / Options::zoomFactor();
+    }, [this](KSNumbers * num)
+    {
+        m_preUpdateID++;
+        //omit KSNumbers arg == just update Alt/Az coords // <-- Eh? -- asimha. Looks like this behavior / ideology has changed drastically.
+        skyComposite()->update(num);
+
+        emit skyUpdate(clock()->isManualMode());
+    });
+
+    m_TimeTiers.addTrigger(numbers, sky);
 }
 
 KStarsData::~KStarsData()
@@ -130,6 +179,15 @@ KStarsData::~KStarsData()
 
 bool KStarsData::initialize()
 {
+    // Startup timing breakdown, see also SkyMapComposite
+    QElapsedTimer total, timer;
+    total.start();
+    timer.start();
+    auto lap = [&timer](const char *what)
+    {
+        qCDebug(KSTARS_STARTUP) << what << "took" << timer.restart() << "ms";
+    };
+
     //Load Time Zone Rules//
     emit progressText(i18n("Reading time zone rules"));
     if (!readTimeZoneRulebook())
@@ -137,6 +195,7 @@ bool KStarsData::initialize()
         fatalErrorMessage("TZrules.dat");
         return false;
     }
+    lap("Time zone rules");
 
     emit progressText(
         i18n("Upgrade existing user city db to support geographic elevation."));
@@ -181,21 +240,27 @@ bool KStarsData::initialize()
         fixcitydb.close();
     }
 
-    //Load Cities//
+    //Load Cities// while the sky objects load
     emit progressText(i18n("Loading city data"));
-    if (!readCityData())
-    {
-        fatalErrorMessage("citydb.sqlite");
-        return false;
-    }
+    QFuture<bool> cities = QtConcurrent::run(this, &KStarsData::readCityData);
 
     //Initialize User Database//
     emit progressText(i18n("Loading User Information"));
     m_ksuserdb.Initialize();
+    lap("User database");
 
     //Initialize SkyMapComposite//
     emit progressText(i18n("Loading sky objects"));
     m_SkyComposite.reset(new SkyMapComposite());
+    lap("Sky objects");
+
+    // The custom locations follow the others, and their database is used from here later on
+    if (!cities.result() || !readUserCityData())
+    {
+        fatalErrorMessage("citydb.sqlite");
+        return false;
+    }
+    lap("Waiting for cities and custom locations");
     //Load Image URLs//
     //#ifndef Q_OS_ANDROID
     //On Android these 2 calls produce segfault. WARNING
@@ -228,6 +293,8 @@ bool KStarsData::initialize()
 #ifndef KSTARS_LITE
     readADVTreeData();
 #endif
+    lap("Observing list, user log and ADV tree");
+    qCDebug(KSTARS_STARTUP) << "Data initialized in" << total.elapsed() << "ms";
     return true;
 }
 
@@ -257,40 +324,9 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
         }
     }
 
+    // Only the tiers due at this time are updated, so fast time steps skip what has not moved
     KSNumbers num(ut().djd());
-
-    if (std::abs(ut().djd() - LastNumUpdate.djd()) > 1.0)
-    {
-        LastNumUpdate = KStarsDateTime(ut().djd());
-        m_preUpdateNumID++;
-        m_preUpdateNum = KSNumbers(num);
-        skyComposite()->update(&num);
-    }
-
-    if (std::abs(ut().djd() - LastPlanetUpdate.djd()) > 0.01)
-    {
-        LastPlanetUpdate = KStarsDateTime(ut().djd());
-        skyComposite()->updateSolarSystemBodies(&num);
-    }
-
-    // Moon moves ~30 arcmin/hr, so update its position every minute.
-    if (std::abs(ut().djd() - LastMoonUpdate.djd()) > 0.00069444)
-    {
-        LastMoonUpdate = ut();
-        skyComposite()->updateMoons(&num);
-    }
-
-    //Update Alt/Az coordinates.  Timescale varies with zoom level
-    //If Clock is in Manual Mode, always update. (?)
-    if (std::abs(ut().djd() - LastSkyUpdate.djd()) > 0.1 / Options::zoomFactor() || clock()->isManualMode())
-    {
-        LastSkyUpdate = ut();
-        m_preUpdateID++;
-        //omit KSNumbers arg == just update Alt/Az coords // <-- Eh? -- asimha. Looks like this behavior / ideology has changed drastically.
-        skyComposite()->update(&num);
-
-        emit skyUpdate(clock()->isManualMode());
-    }
+    m_TimeTiers.run(ut().djd(), &num);
 }
 
 void KStarsData::syncUpdateIDs()
@@ -312,11 +348,8 @@ unsigned int KStarsData::incUpdateID()
 
 void KStarsData::setFullTimeUpdate()
 {
-    //Set the update markers to invalid dates to trigger updates in each category
-    LastSkyUpdate    = KStarsDateTime(QDateTime());
-    LastPlanetUpdate = KStarsDateTime(QDateTime());
-    LastMoonUpdate   = KStarsDateTime(QDateTime());
-    LastNumUpdate    = KStarsDateTime(QDateTime());
+    //Trigger updates in each category
+    m_TimeTiers.invalidate();
 }
 
 void KStarsData::syncLST()
@@ -472,9 +505,14 @@ bool KStarsData::readCityData()
     }
     citydb.close();
 
+    return citiesFound;
+}
+
+bool KStarsData::readUserCityData()
+{
     // Reading local database
     QSqlDatabase mycitydb = QSqlDatabase::addDatabase("QSQLITE", "mycitydb");
-    dbfile = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("mycitydb.sqlite");
+    QString dbfile = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("mycitydb.sqlite");
 
     if (QFile::exists(dbfile))
     {
@@ -506,7 +544,7 @@ bool KStarsData::readCityData()
         }
     }
 
-    return citiesFound;
+    return true;
 }
 
 bool KStarsData::readTimeZoneRulebook()
@@ -13,6 +13,7 @@
 #include "ksuserdb.h"
 #include "simclock.h"
 #include "skyobjectuserdata.h"
+#include "auxiliary/timetierscheduler.h"
 #include <qobject.h>
 #ifndef KSTARS_LITE
 #include "oal/oal.h"
@@ -133,10 +134,9 @@ class KStarsData : public QObject
 
         /**
          * The Sky is updated more frequently than the moon, which is updated more frequently
-         * than the planets.  The date of the last update for each category is recorded so we
-         * know when we need to do it again (see KStars::updateTime()).
-         * Initializing these to -1000000.0 ensures they will be updated immediately
-         * on the first call to KStars::updateTime().
+         * than the planets.  Each of them is a tier of the time scheduler, which records when
+         * it was last updated so we know when we need to do it again (see updateTime()).
+         * This makes all of them due at the next call to updateTime().
          */
         void setFullTimeUpdate();
 
@@ -466,15 +466,23 @@ class KStarsData : public QObject
 
       private:
         /**
-         * Populate list of geographic locations from "citydb.sqlite" database. Also check for custom
-         * locations file "mycitydb.sqlite" database, but don't require it.  Each line in the file
+         * Populate list of geographic locations from "citydb.sqlite" database. Each line in the file
          * provides the information required to create one GeoLocation object.
-         * @short Fill list of geographic locations from file(s)
+         * @short Fill list of geographic locations from file
+         * @note Runs on a thread of its own while the sky objects are loaded, so it touches nothing but the
+         * list of locations and the time zone rules.
          * @return true if at least one city read successfully.
          * @see KStarsData::processCity()
          */
         bool readCityData();
 
+        /**
+         * Append the custom locations of the "mycitydb.sqlite" database to the list of geographic locations,
+         * if there is such a database.
+         * @return false if the database exists but could not be read.
+         */
+        bool readUserCityData();
+
         /** Read the data file that contains daylight savings time rules. */
         bool readTimeZoneRulebook();
 
@@ -580,7 +588,9 @@ class KStarsData : public QObject
         QList<FOV *> visibleFOVs;       // List of visible FOVs. Cached from Options::FOVNames
         QList<std::shared_ptr<FOV>> transientFOVs;     // List of non-permenant transient FOVs.
 
-        KStarsDateTime LastNumUpdate, LastSkyUpdate, LastPlanetUpdate, LastMoonUpdate;
+        // Precession and nutation, solar system bodies, moons and horizontal coordinates
+        TimeTierScheduler m_TimeTiers;
+        void initTimeTiers();
         KStarsDateTime NextDSTChange;
         // FIXME: Used in kstarsdcop.cpp only
         KStarsDateTime StoredDate;
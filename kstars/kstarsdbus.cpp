@@ -35,9 +35,14 @@
 
 #include <KActionCollection>
 
+#include <QDir>
 #include <QPrintDialog>
 #include <QPrinter>
 #include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QtConcurrent>
+
+#include <memory>
 
 #include "kstars_debug.h"
 
@@ -461,6 +466,8 @@ void KStars::changeViewOption(const QString &op, const QString &val)
         Options::setShadeGeoBox(bVal);
     if (op == "ShadeFocusBox" && bOk)
         Options::setShadeFocusBox(bVal);
+    if (op == "ShowDrawTimings" && bOk)
+        Options::setShowDrawTimings(bVal);
 
     //[View]
     // FIXME: REGRESSION
@@ -716,6 +723,37 @@ void KStars::exportImage(const QString &url, int w, int h, bool includeLegend)
     m_ImageExporter->exportImage(url);
 }
 
+int KStars::exportCharts(const QStringList &objectNames, const QString &directory, double fov, int width, int height)
+{
+    QDir dir(directory);
+    int queued = 0;
+    for (const auto &name : objectNames)
+    {
+        SkyObject *target = data()->objectNamed(name);
+        if (!target)
+        {
+            qCWarning(KSTARS) << "Chart object" << name << "not found";
+            continue;
+        }
+
+        // Object names may contain characters which are not valid in file names
+        QString fileName = name;
+        fileName.replace(QRegularExpression("[^\\w+-]+"), "_");
+        m_KStarsData->imageExporter()->queueChart(dir.filePath(fileName + ".png"), *target, fov, QSize(width, height));
+        queued++;
+    }
+    return queued;
+}
+
+void KStars::exportChart(double RA_J2000, double Dec_J2000, double fov, const QString &filename, int width, int height)
+{
+    SkyPoint center;
+    center.setRA0(RA_J2000);
+    center.setDec0(Dec_J2000);
+    center.updateCoordsNow(data()->updateNum());
+    m_KStarsData->imageExporter()->queueChart(filename, center, fov, QSize(width, height));
+}
+
 QString KStars::getDSSURL(const QString &objectName)
 {
     SkyObject *target = data()->objectNamed(objectName);
@@ -816,30 +854,20 @@ QString KStars::getObjectDataXML(const QString &objectName, bool fallbackToInter
     return output;
 }
 
-QString KStars::getObjectPositionInfo(const QString &objectName)
+namespace
 {
-    Q_ASSERT(data());
-    const SkyObject *obj = data()->objectNamed(objectName); // make sure we work with a clone
-    if (!obj)
-    {
-        return QString("<xml></xml>");
-    }
-    SkyObject *target = obj->clone();
-    if (!target) // should not happen
-    {
-        qWarning() << "ERROR: Could not clone SkyObject " << objectName << "!";
-        return QString("<xml></xml>");
-    }
-
-    const KSNumbers *updateNum = data()->updateNum();
-    const KStarsDateTime ut    = data()->ut();
-    const GeoLocation *geo     = data()->geo();
+// Write the position, rise, set and transit of target, whose coordinates are updated, as elements of an object
+void writePositionInfo(QXmlStreamWriter &stream, SkyObject *target, KStarsData *data)
+{
+    const KSNumbers *updateNum = data->updateNum();
+    const KStarsDateTime ut    = data->ut();
+    const GeoLocation *geo     = data->geo();
     QString riseTimeString, setTimeString, transitTimeString;
     QString riseAzString, setAzString, transitAltString;
 
     // Make sure the coordinates of the SkyObject are updated
-    target->updateCoords(updateNum, true, geo->lat(), data()->lst(), true);
-    target->EquatorialToHorizontal(data()->lst(), geo->lat());
+    target->updateCoords(updateNum, true, geo->lat(), data->lst(), true);
+    target->EquatorialToHorizontal(data->lst(), geo->lat());
 
     // Compute rise, set and transit times and parameters -- Code pulled from DetailDialog
     QTime riseTime    = target->riseSetTime(ut, geo, true);   //true = use rise time
@@ -882,14 +910,9 @@ QString KStars::getObjectPositionInfo(const QString &objectName)
     transitTimeString = QString::asprintf("%02d:%02d", transitTime.hour(), transitTime.minute());
     transitAltString  = transitAlt.toDMSString(true, true);
 
-    QString output;
-    QXmlStreamWriter stream(&output);
-    stream.setAutoFormatting(true);
-    stream.writeStartDocument();
-    stream.writeStartElement("object");
     stream.writeTextElement("Name", target->name());
     stream.writeTextElement("RA_Dec_Epoch_JD", QString::number(target->getLastPrecessJD(), 'f', 3));
-    stream.writeTextElement("AltAz_JD", QString::number(data()->ut().djd(), 'f', 3));
+    stream.writeTextElement("AltAz_JD", QString::number(data->ut().djd(), 'f', 3));
     stream.writeTextElement("RA_HMS", target->ra().toHMSString(true));
     stream.writeTextElement("Dec_DMS", target->dec().toDMSString(true, true));
     stream.writeTextElement("RA_J2000_HMS", target->ra0().toHMSString(true));
@@ -909,12 +932,104 @@ QString KStars::getObjectPositionInfo(const QString &objectName)
     stream.writeTextElement("Transit", transitTimeString);
     stream.writeTextElement("Transit_Alt_DMS", transitAltString);
     stream.writeTextElement("Time_Zone_Offset", QString::asprintf("%02.2f", geo->TZ()));
+}
+
+// The object element of each target, or one with only the name of the objects not found. Fixed objects are
+// independent of each other and computed in parallel. Solar system bodies share the ephemerides of the
+// Earth, they are computed here.
+QString writePositionsInfo(const QVector<SkyObject *> &targets, const QStringList &names, KStarsData *data)
+{
+    QVector<QString> elements(targets.size());
+    auto writeElement = [&](int i)
+    {
+        QXmlStreamWriter stream(&elements[i]);
+        stream.setAutoFormatting(true);
+        stream.writeStartElement("object");
+        if (targets[i])
+            writePositionInfo(stream, targets[i], data);
+        else
+            stream.writeTextElement("Name", names.value(i));
+        stream.writeEndElement(); // object
+    };
+
+    QVector<int> fixed;
+    for (int i = 0; i < targets.size(); i++)
+    {
+        if (targets[i] && !targets[i]->isSolarSystem())
+            fixed.append(i);
+        else
+            writeElement(i);
+    }
+    QtConcurrent::blockingMap(fixed, [&writeElement](int &i)
+    {
+        writeElement(i);
+    });
+
+    QString output = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<objects>\n";
+    for (const auto &element : elements)
+        output += element + "\n";
+    output += "</objects>\n";
+    return output;
+}
+}
+
+QString KStars::getObjectPositionInfo(const QString &objectName)
+{
+    Q_ASSERT(data());
+    const SkyObject *obj = data()->objectNamed(objectName); // make sure we work with a clone
+    if (!obj)
+    {
+        return QString("<xml></xml>");
+    }
+    std::unique_ptr<SkyObject> target(obj->clone());
+    if (!target) // should not happen
+    {
+        qWarning() << "ERROR: Could not clone SkyObject " << objectName << "!";
+        return QString("<xml></xml>");
+    }
 
+    QString output;
+    QXmlStreamWriter stream(&output);
+    stream.setAutoFormatting(true);
+    stream.writeStartDocument();
+    stream.writeStartElement("object");
+    writePositionInfo(stream, target.get(), data());
     stream.writeEndElement(); // object
     stream.writeEndDocument();
     return output;
 }
 
+QString KStars::getObjectsPositionInfo(const QStringList &objectNames)
+{
+    Q_ASSERT(data());
+    std::vector<std::unique_ptr<SkyObject>> clones;
+    QVector<SkyObject *> targets;
+    for (const auto &objectName : objectNames)
+    {
+        const SkyObject *obj = data()->objectNamed(objectName);
+        clones.emplace_back(obj ? obj->clone() : nullptr);
+        targets.append(clones.back().get());
+    }
+    return writePositionsInfo(targets, objectNames, data());
+}
+
+QString KStars::getCoordinatesPositionInfo(const QList<double> &RA_J2000, const QList<double> &Dec_J2000)
+{
+    Q_ASSERT(data());
+    const int count = std::min(RA_J2000.size(), Dec_J2000.size());
+    std::vector<std::unique_ptr<SkyObject>> points;
+    QVector<SkyObject *> targets;
+    QStringList names;
+    for (int i = 0; i < count; i++)
+    {
+        const QString name = QString("%1 %2").arg(RA_J2000[i]).arg(Dec_J2000[i]);
+        points.emplace_back(new SkyObject(SkyObject::TYPE_UNKNOWN, dms(RA_J2000[i]), dms(Dec_J2000[i]), 0.0, name));
+        targets.append(points.back().get());
+        names.append(name);
+    }
+    return writePositionsInfo(targets, names, data());
+}
+
 void KStars::renderEyepieceView(const QString &objectName, const QString &destPathChart, const double fovWidth,
                                 const double fovHeight, const double rotation, const double scale, const bool flip,
                                 const bool invert, QString imagePath, const QString &destPathImage, const bool overlay,
@@ -999,6 +1114,12 @@ QString KStars::getSkyMapDimensions()
 {
     return (QString::number(map()->width()) + 'x' + QString::number(map()->height()));
 }
+
+QString KStars::getDrawTimings()
+{
+    return data()->skyComposite()->drawTimings().report().join('\n');
+}
+
 void KStars::printImage(bool usePrintDialog, bool useChartColors)
 {
     //QPRINTER_FOR_NOW
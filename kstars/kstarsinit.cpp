@@ -330,6 +330,15 @@ void KStars::initActions()
     ka->setChecked(Options::showGeoBox());
     ka->setEnabled(Options::showInfoBoxes());
 
+    ka = actionCollection()->add<KToggleAction>("show_draw_timings")
+         << i18nc("Show the time spent on each part of the sky map", "Show &Draw Timings");
+    ka->setChecked(Options::showDrawTimings());
+    connect(ka, &QAction::toggled, this, [this](bool toggled)
+    {
+        Options::setShowDrawTimings(toggled);
+        map()->forceUpdate();
+    });
+
     //Toolbar options
     newToggleAction(actionCollection(), "show_mainToolBar", i18n("Show Main Toolbar"), toolBar("kstarsToolBar"),
                     SLOT(setVisible(bool)));
@@ -8,6 +8,7 @@
 
 #include "klocalizedcontext.h"
 #include "kspaths.h"
+#include "memorybudget.h"
 #include "ksplanetbase.h"
 #include "kstarsdata.h"
 #include "ksutils.h"
@@ -291,6 +292,9 @@ void KStarsLite::handleStateChange(Qt::ApplicationState state)
         //data()->colorScheme()->saveToConfig();
         //synch the config file with the Config object
         writeConfig();
+
+        // Android kills the apps in the background that take the most memory first
+        MemoryBudget::Instance()->onLowMemory();
     }
 }
 
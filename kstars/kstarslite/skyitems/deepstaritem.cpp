@@ -17,6 +17,7 @@
 #include "htmesh/MeshIterator.h"
 #include "projections/projector.h"
 #include "skynodes/pointsourcenode.h"
+#include "skynodes/starbatchnode.h"
 #include "skynodes/trixelnode.h"
 
 DeepStarItem::DeepStarItem(DeepStarComponent *deepStarComp, RootNode *rootNode)
@@ -31,6 +32,11 @@ DeepStarItem::DeepStarItem(DeepStarComponent *deepStarComp, RootNode *rootNode)
         {
             TrixelNode *trixel = new TrixelNode(m_starBlockList->at(c)->getTrixel());
             appendChildNode(trixel);
+
+            // All stars of the trixel are drawn by one node
+            StarBatchNode *batch = new StarBatchNode(rootNode);
+            trixel->appendChildNode(batch);
+            m_batches.append(batch);
             int blockCount = m_starBlockList->at(c)->getBlockCount();
 
             for (int i = 0; i < blockCount; ++i)
@@ -163,27 +169,14 @@ void DeepStarItem::update()
                 const Projector *projector = SkyMapLite::Instance()->projector();
                 double delLim              = SkyMapLite::deleteLimit();
 
+                StarBatchNode *batch       = m_batches[trixelID];
+
                 if (trixelID != regionID)
                 {
                     trixel->hide();
 
                     if (trixel->hideCount() > delLim)
-                    {
-                        QLinkedList<QPair<SkyObject *, SkyNode *>>::iterator i = trixel->m_nodes.begin();
-
-                        while (i != trixel->m_nodes.end())
-                        {
-                            SkyNode *node = (*i).second;
-                            if (node)
-                            {
-                                trixel->removeChildNode(node);
-                                delete node;
-
-                                *i = QPair<SkyObject *, SkyNode *>((*i).first, 0);
-                            }
-                            ++i;
-                        }
-                    }
+                        batch->release();
 
                     trixel = static_cast<TrixelNode *>(trixel->nextSibling());
                     ++trixelID;
@@ -198,70 +191,30 @@ void DeepStarItem::update()
                         regionID = region.next();
                     }
 
-                    QLinkedList<QPair<SkyObject *, SkyNode *>>::iterator i = (&trixel->m_nodes)->begin();
+                    batch->clear();
 
-                    while (i != (&trixel->m_nodes)->end())
+                    // Deep stars are not labelled, so they are only kept as quads in the batch
+                    if (!hideFaintStars || !hideStarsMag)
                     {
-                        bool hide     = false;
-                        bool hideSlew = false;
-
-                        bool drawLabel = false;
-
-                        StarObject *starObj = static_cast<StarObject *>((*i).first);
-                        SkyNode *node       = (*i).second;
-
-                        int mag = starObj->mag();
-
-                        // break loop if maglim is reached
-                        if (mag > maglim)
-                            hide = true;
-                        if (hideFaintStars && hideStarsMag)
-                            hideSlew = true;
-                        if (starObj->updateID != KStarsData::Instance()->updateID())
-                            starObj->JITupdate();
-
-                        if (node)
+                        for (const auto &pair : trixel->m_nodes)
                         {
-                            if (node->hideCount() > delLim || hide)
-                            {
-                                trixel->removeChildNode(node);
-                                delete node;
-                                *i = QPair<SkyObject *, SkyNode *>((*i).first, 0);
-                            }
-                            else
-                            {
-                                if (!hideSlew)
-                                {
-                                    node->update(drawLabel);
-                                }
-                                else
-                                {
-                                    node->hide();
-                                }
-                            }
-                        }
-                        else
-                        {
-                            if (!hide && !hideSlew && projector->checkVisibility(starObj))
-                            {
-                                QPointF pos;
-
-                                bool visible = false;
-                                pos          = projector->toScreen(starObj, true, &visible);
-                                if (visible && projector->onScreen(pos))
-                                {
-                                    PointSourceNode *point =
-                                        new PointSourceNode(starObj, rootNode(), LabelsItem::label_t::STAR_LABEL,
-                                                            starObj->spchar(), starObj->mag(), trixelID);
-                                    trixel->appendChildNode(point);
-
-                                    *i = QPair<SkyObject *, SkyNode *>((*i).first, static_cast<SkyNode *>(point));
-                                    point->updatePos(pos, drawLabel);
-                                }
-                            }
+                            StarObject *starObj = static_cast<StarObject *>(pair.first);
+
+                            int mag = starObj->mag();
+                            if (mag > maglim)
+                                continue;
+                            if (starObj->updateID != updateID)
+                                starObj->JITupdate();
+                            if (!projector->checkVisibility(starObj))
+                                continue;
+
+                            bool visible      = false;
+                            const QPointF pos = projector->toScreen(starObj, true, &visible);
+                            if (visible && projector->onScreen(pos))
+                                batch->addStar(pos, PointSourceNode::starWidth(starObj->mag()), starObj->spchar());
                         }
-                        ++i;
                     }
+                    batch->commit();
                 }
             }
             else if (false)
@@ -13,6 +13,7 @@ class DeepStarComponent;
 class SkyMesh;
 class StarBlockFactory;
 class StarBlockList;
+class StarBatchNode;
 
 /**
  * @class DeepStarItem
@@ -44,4 +45,6 @@ class DeepStarItem : public SkyItem
     DeepStarComponent *m_deepStarComp { nullptr };
     QVector<std::shared_ptr<StarBlockList>> *m_starBlockList { nullptr };
     bool m_staticStars { false };
+    /** Batch of stars of each trixel, by trixel ID */
+    QVector<StarBatchNode *> m_batches;
 };
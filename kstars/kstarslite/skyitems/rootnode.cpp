@@ -42,7 +42,11 @@
 
 #include "kstarslite/skyitems/fovitem.h"
 
+#include "kstarslite/skyitems/skynodes/nodes/pointnode.h"
+
+#include <QPainter>
 #include <QSGFlatColorMaterial>
+#include <QSGTextureMaterial>
 
 RootNode::RootNode() : m_skyMapLite(SkyMapLite::Instance())
     {
@@ -153,6 +157,12 @@ void RootNode::testLeakDelete()
 
 RootNode::~RootNode()
 {
+    qDeleteAll(m_pointNodePool);
+    if (m_starMaterial)
+    {
+        delete m_starMaterial->texture();
+        delete m_starMaterial;
+    }
     for (int i = 0; i < m_textureCache.length(); ++i)
     {
         for (int c = 0; c < m_textureCache[i].size(); ++c)
@@ -180,6 +190,85 @@ void RootNode::genCachedTextures()
                 win->createTextureFromImage(images[i][c]->toImage(), QQuickWindow::TextureCanUseAtlas);
         }
     }
+
+    genStarAtlas();
+}
+
+void RootNode::genStarAtlas()
+{
+    QVector<QVector<QPixmap *>> images = m_skyMapLite->getImageCache();
+
+    // One row of images per spectral class
+    int width = 0, height = 0;
+    for (const auto &row : images)
+    {
+        int rowWidth = 0, rowHeight = 0;
+        for (int c = 1; c < row.length(); ++c)
+        {
+            rowWidth += row[c]->width();
+            rowHeight = qMax(rowHeight, row[c]->height());
+        }
+        width = qMax(width, rowWidth);
+        height += rowHeight;
+    }
+
+    QImage atlas(qMax(width, 1), qMax(height, 1), QImage::Format_ARGB32_Premultiplied);
+    atlas.fill(Qt::transparent);
+    m_starAtlasRects = QVector<QVector<QRectF>>(images.length());
+
+    QPainter p(&atlas);
+    int y = 0;
+    for (int i = 0; i < images.length(); ++i)
+    {
+        m_starAtlasRects[i] = QVector<QRectF>(images[i].length());
+        int x = 0, rowHeight = 0;
+        for (int c = 1; c < images[i].length(); ++c)
+        {
+            const QPixmap *image = images[i][c];
+            p.drawPixmap(x, y, *image);
+            m_starAtlasRects[i][c] = QRectF(x, y, image->width(), image->height());
+            x += image->width();
+            rowHeight = qMax(rowHeight, image->height());
+        }
+        y += rowHeight;
+    }
+    p.end();
+    m_starAtlasSize = atlas.size();
+
+    // Nodes hold on to the material, only its texture is replaced
+    QSGTexture *texture = m_skyMapLite->window()->createTextureFromImage(atlas);
+    texture->setFiltering(QSGTexture::Linear);
+    if (!m_starMaterial)
+    {
+        m_starMaterial = new QSGTextureMaterial;
+        m_starMaterial->setFiltering(QSGTexture::Linear);
+    }
+    else
+        delete m_starMaterial->texture();
+    m_starMaterial->setTexture(texture);
+}
+
+QRectF RootNode::starAtlasRect(int size, char spType) const
+{
+    return m_starAtlasRects[SkyMapLite::Instance()->harvardToIndex(spType)][size];
+}
+
+PointNode *RootNode::takePointNode(char spType, float size)
+{
+    if (m_pointNodePool.isEmpty())
+        return new PointNode(this, spType, size);
+
+    PointNode *node = m_pointNodePool.takeLast();
+    node->reset(spType, size);
+    return node;
+}
+
+void RootNode::recyclePointNode(PointNode *node)
+{
+    if (m_pointNodePool.size() < MAX_POOLED_POINT_NODES)
+        m_pointNodePool.append(node);
+    else
+        delete node;
 }
 
 QSGTexture *RootNode::getCachedTexture(int size, char spType)
@@ -11,7 +11,9 @@
 #include <QSGClipNode>
 
 class QSGTexture;
+class QSGTextureMaterial;
 class SkyMapLite;
+class PointNode;
 
 class StarItem;
 class DeepSkyItem;
@@ -70,6 +72,32 @@ class RootNode : public QSGClipNode
      */
     QSGTexture *getCachedTexture(int size, char spType);
 
+    /** @short material whose texture is an atlas of all cached star images, shared by StarBatchNode */
+    inline QSGTextureMaterial *starMaterial() { return m_starMaterial; }
+
+    /**
+     * @return rectangle in pixels of the image of a star in the atlas of starMaterial()
+     * @param size size of the star
+     * @param spType spectral class
+     */
+    QRectF starAtlasRect(int size, char spType) const;
+
+    /** @return size in pixels of the atlas of starMaterial() */
+    inline QSizeF starAtlasSize() const { return m_starAtlasSize; }
+
+    /**
+     * @short takePointNode returns a PointNode recycled from a deleted node, or a new one
+     * @param spType spectral class
+     * @param size size of the star
+     */
+    PointNode *takePointNode(char spType, float size);
+
+    /**
+     * @short recyclePointNode keeps a PointNode that is no longer in the scene for takePointNode().
+     * The node has to be removed from its parent first.
+     */
+    void recyclePointNode(PointNode *node);
+
     /** @short triangulates and sets new clipping polygon provided by Projection system */
     void updateClipPoly();
 
@@ -95,10 +123,21 @@ class RootNode : public QSGClipNode
     inline TelescopeSymbolsItem *telescopeSymbolsItem() { return m_telescopeSymbols; }
 
   private:
+    /** @short builds the atlas of starMaterial() from the cached images of stars */
+    void genStarAtlas();
+
     QVector<QVector<QSGTexture *>> m_textureCache;
     QVector<QVector<QSGTexture *>> m_oldTextureCache;
     SkyMapLite *m_skyMapLite { nullptr };
 
+    QSGTextureMaterial *m_starMaterial { nullptr };
+    QVector<QVector<QRectF>> m_starAtlasRects;
+    QSizeF m_starAtlasSize;
+
+    // Nodes of stars that left the view, reused by those that come in
+    QVector<PointNode *> m_pointNodePool;
+    static constexpr int MAX_POOLED_POINT_NODES = 1024;
+
     QPolygonF m_clipPoly;
     QSGGeometry *m_clipGeometry { nullptr };
 
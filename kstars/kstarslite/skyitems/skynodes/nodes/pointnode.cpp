@@ -39,6 +39,15 @@ void PointNode::setSize(float size)
     }
 }
 
+void PointNode::reset(char sp, float size)
+{
+    spType = sp;
+    // The texture is looked up again even if the size is the same
+    m_size = -1;
+    setSize(size);
+    show();
+}
+
 QSizeF PointNode::size() const
 {
     return texture->rect().size();
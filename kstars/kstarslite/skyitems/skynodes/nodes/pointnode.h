@@ -38,6 +38,13 @@ class PointNode : public SkyOpacityNode
      */
     void setSize(float size);
 
+    /**
+     * @short reset gives a recycled PointNode the spectral type and size of another star
+     * @param sp spectral type
+     * @param size size of PointNode
+     */
+    void reset(char sp, float size);
+
     QSizeF size() const;
 
   private:
@@ -22,7 +22,7 @@ PointSourceNode::PointSourceNode(SkyObject *skyObject, RootNode *parentNode, Lab
 {
 }
 
-float PointSourceNode::starWidth(float mag) const
+float PointSourceNode::starWidth(float mag)
 {
     //adjust maglimit for ZoomLevel
     const double maxSize = 10.0;
@@ -33,7 +33,7 @@ float PointSourceNode::starWidth(float mag) const
 
     float sizeFactor = maxSize + (lgz - lgmin);
 
-    float m_sizeMagLim = map()->sizeMagLim();
+    float m_sizeMagLim = SkyMapLite::Instance()->sizeMagLim();
 
     float size = (sizeFactor * (m_sizeMagLim - mag) / m_sizeMagLim) + 1.;
     if (size <= 1.0)
@@ -46,6 +46,11 @@ float PointSourceNode::starWidth(float mag) const
 
 PointSourceNode::~PointSourceNode()
 {
+    if (m_point)
+    {
+        m_opacity->removeChildNode(m_point);
+        m_rootNode->recyclePointNode(m_point);
+    }
     if (m_label &&
         (m_labelType == LabelsItem::label_t::STAR_LABEL || m_labelType == LabelsItem::label_t::CATALOG_STAR_LABEL))
     {
@@ -57,7 +62,7 @@ void PointSourceNode::updatePoint()
 {
     if (!m_point)
     {
-        m_point = new PointNode(m_rootNode, m_spType, starWidth(m_size));
+        m_point = m_rootNode->takePointNode(m_spType, starWidth(m_size));
         addChildNode(m_point);
     }
     show();
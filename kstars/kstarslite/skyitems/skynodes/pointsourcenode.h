@@ -41,7 +41,7 @@ class PointSourceNode : public SkyNode
     virtual ~PointSourceNode();
 
     /** @short Get the width of a star of magnitude mag */
-    float starWidth(float mag) const;
+    static float starWidth(float mag);
 
     /**
      * @short updatePoint initializes PointNode if not done that yet. Makes it visible and updates
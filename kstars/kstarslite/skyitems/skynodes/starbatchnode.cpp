@@ -0,0 +1,70 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "starbatchnode.h"
+
+#include "skymaplite.h"
+#include "../rootnode.h"
+
+#include <QQuickWindow>
+#include <QSGTextureMaterial>
+
+#include <cstring>
+
+StarBatchNode::StarBatchNode(RootNode *rootNode) : m_rootNode(rootNode)
+{
+    QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 0);
+    geometry->setDrawingMode(GL_TRIANGLES);
+    setGeometry(geometry);
+    setFlag(QSGNode::OwnsGeometry);
+
+    // The material belongs to RootNode, which changes its texture along with the color scheme
+    setMaterial(m_rootNode->starMaterial());
+}
+
+void StarBatchNode::addStar(const QPointF &pos, float size, char spType)
+{
+    const QRectF source   = m_rootNode->starAtlasRect(qMin(static_cast<int>(size), 14), spType);
+    const QSizeF atlas    = m_rootNode->starAtlasSize();
+    // The textures are drawn at their size in device independent pixels, as in PointNode
+    const qreal ratio     = SkyMapLite::Instance()->window()->effectiveDevicePixelRatio();
+    const float halfWidth = 0.5 * source.width() / ratio, halfHeight = 0.5 * source.height() / ratio;
+
+    const float left = pos.x() - halfWidth, right = pos.x() + halfWidth;
+    const float top = pos.y() - halfHeight, bottom = pos.y() + halfHeight;
+    const float tl = source.left() / atlas.width(), tr = source.right() / atlas.width();
+    const float tt = source.top() / atlas.height(), tb = source.bottom() / atlas.height();
+
+    QSGGeometry::TexturedPoint2D quad[6];
+    quad[0].set(left, top, tl, tt);
+    quad[1].set(right, top, tr, tt);
+    quad[2].set(left, bottom, tl, tb);
+    quad[3].set(right, top, tr, tt);
+    quad[4].set(right, bottom, tr, tb);
+    quad[5].set(left, bottom, tl, tb);
+    for (const auto &vertex : quad)
+        m_vertices.append(vertex);
+}
+
+void StarBatchNode::commit()
+{
+    QSGGeometry *g = geometry();
+    if (g->vertexCount() != m_vertices.size())
+        g->allocate(m_vertices.size());
+    if (!m_vertices.isEmpty())
+        std::memcpy(g->vertexDataAsTexturedPoint2D(), m_vertices.constData(),
+                    m_vertices.size() * sizeof(QSGGeometry::TexturedPoint2D));
+    g->markVertexDataDirty();
+    markDirty(QSGNode::DirtyGeometry);
+}
+
+void StarBatchNode::release()
+{
+    if (geometry()->vertexCount() == 0 && m_vertices.capacity() == 0)
+        return;
+    m_vertices = QVector<QSGGeometry::TexturedPoint2D>();
+    geometry()->allocate(0);
+    markDirty(QSGNode::DirtyGeometry);
+}
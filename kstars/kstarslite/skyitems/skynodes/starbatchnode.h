@@ -0,0 +1,55 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QSGGeometry>
+#include <QSGGeometryNode>
+#include <QVector>
+
+class RootNode;
+
+/**
+ * @class StarBatchNode
+ *
+ * A QSGGeometryNode that draws many stars as textured quads of a single geometry. All batches share
+ * the material of RootNode, whose texture is an atlas of the images of stars, so the scene graph
+ * renders them without a node, a matrix or a texture switch per star.
+ *
+ * Stars are added again on each update between clear() and commit(). The vertex buffer grows to
+ * the number of stars seen and is reused afterwards.
+ *
+ * @short A node that holds the stars of a trixel in one geometry
+ */
+class StarBatchNode : public QSGGeometryNode
+{
+  public:
+    /**
+     * @short Constructor
+     * @param rootNode pointer to the top parent RootNode which holds the atlas of stars
+     */
+    explicit StarBatchNode(RootNode *rootNode);
+
+    /** @short Start a new set of stars */
+    void clear() { m_vertices.clear(); }
+
+    /**
+     * @short addStar adds a star to the batch
+     * @param pos position of the star on SkyMapLite
+     * @param size size of the star as from PointSourceNode::starWidth()
+     * @param spType spectral class of the star
+     */
+    void addStar(const QPointF &pos, float size, char spType);
+
+    /** @short Upload the stars added since clear() */
+    void commit();
+
+    /** @short Drop the stars and the memory they took. Used for trixels that have been hidden for long. */
+    void release();
+
+  private:
+    RootNode *m_rootNode { nullptr };
+    QVector<QSGGeometry::TexturedPoint2D> m_vertices;
+};
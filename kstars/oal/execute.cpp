@@ -320,8 +320,8 @@ void Execute::slotEndSession()
                 KSNotification::sorry(message, i18n("Could Not Open File"));
                 return;
             }
-            QTextStream ostream(&f);
-            ostream << logObject->writeLog(false);
+            if (!logObject->writeLog(&f, false))
+                KSNotification::sorry(i18n("Could not save the session to %1", f.fileName()));
             f.close();
         }
     }
@@ -31,14 +31,14 @@ OAL::Log::~Log()
     qDeleteAll(m_scopeList);
     qDeleteAll(m_dslrLensList);
     qDeleteAll(m_observationList);
+    delete writer;
+    delete reader;
 }
 
 void OAL::Log::writeBegin()
 {
-    output       = "";
     //m_targetList = KSUtils::makeVanillaPointerList(KStarsData::Instance()->observingList()->sessionList());
     m_targetList = KStarsData::Instance()->observingList()->sessionList();
-    writer       = new QXmlStreamWriter(&output);
     writer->setAutoFormatting(true);
     writer->writeStartDocument();
     writer->writeNamespace("http://observation.sourceforge.net/openastronomylog", "oal");
@@ -49,6 +49,23 @@ void OAL::Log::writeBegin()
 }
 
 QString OAL::Log::writeLog(bool _native)
+{
+    output.clear();
+    delete writer;
+    writer = new QXmlStreamWriter(&output);
+    writeDocument(_native);
+    return output;
+}
+
+bool OAL::Log::writeLog(QIODevice *device, bool _native)
+{
+    output.clear();
+    delete writer;
+    writer = new QXmlStreamWriter(device);
+    return writeDocument(_native);
+}
+
+bool OAL::Log::writeDocument(bool _native)
 {
     native = _native;
     writeBegin();
@@ -65,14 +82,16 @@ QString OAL::Log::writeLog(bool _native)
     writeFilters();
     writeImagers();
     writeObservations();
-    writeEnd();
-    return output;
+    return writeEnd();
 }
 
-void OAL::Log::writeEnd()
+bool OAL::Log::writeEnd()
 {
     writer->writeEndDocument();
+    const bool success = !writer->hasError();
     delete writer;
+    writer = nullptr;
+    return success;
 }
 
 void OAL::Log::writeObservers()
@@ -507,7 +526,20 @@ void OAL::Log::writeGeoDate()
 
 void OAL::Log::readBegin(QString input)
 {
+    delete reader;
     reader = new QXmlStreamReader(input);
+    readDocument();
+}
+
+bool OAL::Log::readBegin(QIODevice *device)
+{
+    delete reader;
+    reader = new QXmlStreamReader(device);
+    return readDocument();
+}
+
+bool OAL::Log::readDocument()
+{
     while (!reader->atEnd())
     {
         reader->readNext();
@@ -517,6 +549,12 @@ void OAL::Log::readBegin(QString input)
             readLog();
         }
     }
+    const bool success = !reader->hasError();
+    if (!success)
+        qCWarning(KSTARS) << "Failed to read observation log:" << reader->errorString();
+    delete reader;
+    reader = nullptr;
+    return success;
 }
 
 void OAL::Log::readUnknownElement()
@@ -949,164 +987,158 @@ void OAL::Log::readGeoDate()
     dt.setDate(QDate::fromString(date, "ddMMyyyy"));
 }
 
-OAL::Observer *OAL::Log::findObserverByName(const QString &name)
+// The index is built again whenever the list changed. The copy of the list it
+// keeps shares the items of the list until then, so that a change of the list
+// detaches it and is seen by comparing the two. Items renamed in place are
+// caught when found under their former key.
+template <typename T, typename Key>
+T *OAL::Log::find(Index<T> &index, const QList<T *> &list, const QString &key, Key keyOf)
 {
-    foreach (OAL::Observer *obs, *observerList())
+    for (int attempt = 0; attempt < 2; attempt++)
     {
-        if (QString(obs->name() + ' ' + obs->surname()) == name)
-            return obs;
+        if (attempt > 0 || index.items.constBegin() != list.constBegin() || index.items.size() != list.size())
+        {
+            index.items = list;
+            index.entries.clear();
+            index.entries.reserve(list.size());
+            // Like a search of the list, the first item with the key wins
+            for (auto it = list.crbegin(); it != list.crend(); ++it)
+                index.entries.insert(keyOf(*it), *it);
+        }
+
+        T *item = index.entries.value(key, nullptr);
+        if (item == nullptr || keyOf(item) == key)
+            return item;
     }
     return nullptr;
 }
 
+OAL::Observer *OAL::Log::findObserverByName(const QString &name)
+{
+    return find(m_ObserverNames, m_observerList, name, [](OAL::Observer * o)
+    {
+        return QString(o->name() + ' ' + o->surname());
+    });
+}
+
 OAL::Observer *OAL::Log::findObserverById(const QString &id)
 {
-    foreach (OAL::Observer *obs, *observerList())
+    return find(m_ObserverIds, m_observerList, id, [](OAL::Observer * o)
     {
-        if (obs->id() == id)
-            return obs;
-    }
-    return nullptr;
+        return o->id();
+    });
 }
 
 OAL::Session *OAL::Log::findSessionByName(const QString &id)
 {
-    foreach (OAL::Session *s, *sessionList())
+    return find(m_SessionIds, m_sessionList, id, [](OAL::Session * s)
     {
-        if (s->id() == id)
-            return s;
-    }
-    return nullptr;
+        return s->id();
+    });
 }
 
 OAL::Site *OAL::Log::findSiteById(const QString &id)
 {
-    foreach (OAL::Site *s, *siteList())
+    return find(m_SiteIds, m_siteList, id, [](OAL::Site * s)
     {
-        if (s->id() == id)
-            return s;
-    }
-    return nullptr;
+        return s->id();
+    });
 }
 
 OAL::Site *OAL::Log::findSiteByName(const QString &name)
 {
-    foreach (OAL::Site *s, *siteList())
+    return find(m_SiteNames, m_siteList, name, [](OAL::Site * s)
     {
-        if (s->name() == name)
-            return s;
-    }
-    return nullptr;
+        return s->name();
+    });
 }
 
 OAL::Scope *OAL::Log::findScopeById(const QString &id)
 {
-    foreach (OAL::Scope *s, *scopeList())
+    return find(m_ScopeIds, m_scopeList, id, [](OAL::Scope * s)
     {
-        if (s->id() == id)
-            return s;
-    }
-    return nullptr;
+        return s->id();
+    });
 }
 
 OAL::Eyepiece *OAL::Log::findEyepieceById(const QString &id)
 {
-    foreach (OAL::Eyepiece *e, *eyepieceList())
+    return find(m_EyepieceIds, m_eyepieceList, id, [](OAL::Eyepiece * e)
     {
-        if (e->id() == id)
-            return e;
-    }
-    return nullptr;
+        return e->id();
+    });
 }
 
 OAL::Lens *OAL::Log::findLensById(const QString &id)
 {
-    foreach (OAL::Lens *l, *lensList())
+    return find(m_LensIds, m_lensList, id, [](OAL::Lens * l)
     {
-        if (l->id() == id)
-            return l;
-    }
-    return nullptr;
+        return l->id();
+    });
 }
 
 OAL::Filter *OAL::Log::findFilterById(const QString &id)
 {
-    foreach (OAL::Filter *f, *filterList())
+    return find(m_FilterIds, m_filterList, id, [](OAL::Filter * f)
     {
-        if (f->id() == id)
-            return f;
-    }
-    return nullptr;
+        return f->id();
+    });
 }
 
 OAL::Scope *OAL::Log::findScopeByName(const QString &name)
 {
-    foreach (OAL::Scope *s, *scopeList())
+    return find(m_ScopeNames, m_scopeList, name, [](OAL::Scope * s)
     {
-        if (s->name() == name)
-            return s;
-    }
-    return nullptr;
+        return s->name();
+    });
 }
 
 OAL::DSLRLens *OAL::Log::findDSLRLensByName(const QString &name)
 {
-    for (const auto &s : *dslrLensList())
+    return find(m_DSLRLensNames, m_dslrLensList, name, [](OAL::DSLRLens * s)
     {
-        if (s->name() == name)
-            return s;
-    }
-    return nullptr;
+        return s->name();
+    });
 }
 
 OAL::DSLRLens *OAL::Log::findDSLRLensById(const QString &id)
 {
-    for (const auto &s : *dslrLensList())
+    return find(m_DSLRLensIds, m_dslrLensList, id, [](OAL::DSLRLens * s)
     {
-        if (s->id() == id)
-            return s;
-    }
-    return nullptr;
+        return s->id();
+    });
 }
 
 OAL::Eyepiece *OAL::Log::findEyepieceByName(const QString &name)
 {
-    foreach (OAL::Eyepiece *e, *eyepieceList())
+    return find(m_EyepieceNames, m_eyepieceList, name, [](OAL::Eyepiece * e)
     {
-        if (e->name() == name)
-            return e;
-    }
-    return nullptr;
+        return e->name();
+    });
 }
 
 OAL::Filter *OAL::Log::findFilterByName(const QString &name)
 {
-    foreach (OAL::Filter *f, *filterList())
+    return find(m_FilterNames, m_filterList, name, [](OAL::Filter * f)
     {
-        if (f->name() == name)
-            return f;
-    }
-    return nullptr;
+        return f->name();
+    });
 }
 
 OAL::Lens *OAL::Log::findLensByName(const QString &name)
 {
-    foreach (OAL::Lens *l, *lensList())
+    return find(m_LensNames, m_lensList, name, [](OAL::Lens * l)
     {
-        if (l->name() == name)
-            return l;
-    }
-    return nullptr;
+        return l->name();
+    });
 }
 
 OAL::Observation *OAL::Log::findObservationByName(const QString &id)
 {
-    foreach (OAL::Observation *o, *observationList())
+    return find(m_ObservationIds, m_observationList, id, [](OAL::Observation * o)
     {
-        if (o->id() == id)
-            return o;
-    }
-    return nullptr;
+        return o->id();
+    });
 }
 
 void OAL::Log::readAll()
@@ -8,6 +8,7 @@
 
 #include "oal/oal.h"
 
+#include <QHash>
 #include <QString>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
@@ -28,12 +29,18 @@
  * @class Log
  *
  * Implementation of <a href="https://code.google.com/p/openastronomylog/">Open Astronomy Log</a> (OAL) XML specifications to record observation logs.
+ *
+ * Logs are written to and read from a QIODevice as a stream, so a large log is never held in
+ * memory as a whole. Observers, sites, sessions, equipment and observations are looked up by id
+ * or name through hashes built from the lists.
  */
 class OAL::Log
 {
     public:
         ~Log();
         QString writeLog(bool native = true);
+        /** @brief writeLog Write the log straight to @p device, @return false on a write error */
+        bool writeLog(QIODevice *device, bool native = true);
         void writeBegin();
         void writeGeoDate();
         void writeObservers();
@@ -98,8 +105,10 @@ class OAL::Log
         void writeFilter(OAL::Filter *f);
         void writeObservation(OAL::Observation *o);
         //        void writeImager();
-        void writeEnd();
+        bool writeEnd();
         void readBegin(QString input);
+        /** @brief readBegin Read the log from @p device as it is parsed, @return false if it is not valid XML */
+        bool readBegin(QIODevice *device);
         void readLog();
         void readUnknownElement();
         void readTargets();
@@ -153,6 +162,20 @@ class OAL::Log
         }
 
     private:
+        // Items of a list by key, with the copy of the list they were taken from
+        template <typename T>
+        struct Index
+        {
+            QList<T *> items;
+            QHash<QString, T *> entries;
+        };
+
+        template <typename T, typename Key>
+        static T *find(Index<T> &index, const QList<T *> &list, const QString &key, Key keyOf);
+
+        bool writeDocument(bool native);
+        bool readDocument();
+
         QList<QSharedPointer<SkyObject>> m_targetList;
         QList<OAL::Observer *> m_observerList;
         QList<OAL::Eyepiece *> m_eyepieceList;
@@ -171,4 +194,14 @@ class OAL::Log
         QHash<QString, QTime> TimeHash;
         KStarsDateTime dt;
         GeoLocation *geo { nullptr };
+
+        Index<OAL::Observer> m_ObserverIds, m_ObserverNames;
+        Index<OAL::Site> m_SiteIds, m_SiteNames;
+        Index<OAL::Session> m_SessionIds;
+        Index<OAL::Scope> m_ScopeIds, m_ScopeNames;
+        Index<OAL::DSLRLens> m_DSLRLensIds, m_DSLRLensNames;
+        Index<OAL::Eyepiece> m_EyepieceIds, m_EyepieceNames;
+        Index<OAL::Lens> m_LensIds, m_LensNames;
+        Index<OAL::Filter> m_FilterIds, m_FilterNames;
+        Index<OAL::Observation> m_ObservationIds;
 };
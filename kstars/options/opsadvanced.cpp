@@ -31,6 +31,7 @@ OpsAdvanced::OpsAdvanced() : QFrame(KStars::Instance())
     connect(SlewTimeScale, SIGNAL(scaleChanged(float)), this, SLOT(slotChangeTimeScale(float)));
 
     connect(kcfg_HideOnSlew, SIGNAL(clicked()), this, SLOT(slotToggleHideOptions()));
+    connect(kcfg_AdaptiveQuality, &QCheckBox::toggled, kcfg_AdaptiveQualityFPS, &QWidget::setEnabled);
 
     connect(kcfg_VerboseLogging, SIGNAL(toggled(bool)), this, SLOT(slotToggleVerbosityOptions()));
 
@@ -60,6 +60,17 @@ Eigen::Vector2f EquirectangularProjector::toScreenVec(const SkyPoint *o, bool oR
     return p;
 }
 
+void EquirectangularProjector::toScreen(const SkyPoint *const *points, int count, QPointF *screen, bool *visible,
+                                        bool oRefract) const
+{
+    // The projection isn't based on projectionK(), so go through toScreenVec()
+    for (int i = 0; i < count; i++)
+    {
+        screen[i] = KSUtils::vecToPoint(toScreenVec(points[i], oRefract, &visible[i]));
+        visible[i] = visible[i] && checkVisibility(points[i]);
+    }
+}
+
 SkyPoint EquirectangularProjector::fromScreen(const QPointF &p, dms *LST, const dms *lat, bool onlyAltAz) const
 {
     SkyPoint result;
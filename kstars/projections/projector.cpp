@@ -43,8 +43,25 @@ Projector::Projector(const ViewParams &p)
     updateClipPoly();
 }
 
+quint64 Projector::s_lastViewID = 0;
+
 void Projector::setViewParams(const ViewParams &p)
 {
+    // What the focus is doesn't matter, only where it is in the coordinates we project
+    const double focusLong = p.useAltAz ? p.focus->az().Degrees() : p.focus->ra().Degrees();
+    const double focusLat  = p.useAltAz ? p.focus->alt().Degrees() : p.focus->dec().Degrees();
+    const bool sameView = m_viewID != 0 && p.width == m_vp.width && p.height == m_vp.height &&
+                          p.zoomFactor == m_vp.zoomFactor && p.rotationAngle.Degrees() == m_vp.rotationAngle.Degrees() &&
+                          p.useRefraction == m_vp.useRefraction && p.useAltAz == m_vp.useAltAz &&
+                          p.fillGround == m_vp.fillGround && p.mirror == m_vp.mirror &&
+                          focusLong == m_viewFocusLong && focusLat == m_viewFocusLat;
+    if (!sameView)
+    {
+        m_viewID        = ++s_lastViewID;
+        m_viewFocusLong = focusLong;
+        m_viewFocusLat  = focusLat;
+    }
+
     m_vp = p;
 
     /** Precompute cached values */
@@ -95,6 +112,59 @@ QPointF Projector::toScreen(const SkyPoint *o, bool oRefract, bool *onVisibleHem
     return KSUtils::vecToPoint(toScreenVec(o, oRefract, onVisibleHemisphere));
 }
 
+void Projector::toScreen(const SkyPoint *const *points, int count, QPointF *screen, bool *visible, bool oRefract) const
+{
+    // Same as toScreenVec(), with everything that only depends on the view taken out of the loop
+    oRefract &= m_vp.useRefraction;
+    const bool useAltAz = m_vp.useAltAz;
+    const double focusX = useAltAz ? m_vp.focus->az().radians() : m_vp.focus->ra().radians();
+    const double cosMaxField = cosMaxFieldAngle();
+
+    for (int i = 0; i < count; i++)
+    {
+        const SkyPoint *o = points[i];
+        double Y, dX;
+        double sindX, cosdX, sinY, cosY;
+
+        if (useAltAz)
+        {
+            Y  = oRefract ? SkyPoint::refract(o->alt()).radians() : o->alt().radians();
+            dX = focusX - o->az().radians();
+        }
+        else
+        {
+            dX = o->ra().radians() - focusX;
+            Y  = o->dec().radians();
+        }
+
+        if (!(std::isfinite(Y) && std::isfinite(dX)))
+        {
+            screen[i]  = QPointF(0, 0);
+            visible[i] = false;
+            continue;
+        }
+
+        dX = KSUtils::reduceAngle(dX, -dms::PI, dms::PI);
+
+#ifdef HAVE_SINCOS
+        sincos(dX, &sindX, &cosdX);
+        sincos(Y, &sinY, &cosY);
+#else
+        sindX = sin(dX);
+        cosdX = cos(dX);
+        sinY  = sin(Y);
+        cosY  = cos(Y);
+#endif
+
+        const double c = m_sinY0 * sinY + m_cosY0 * cosY * cosdX;
+        const double k = projectionK(c);
+        const auto p = rst(k * cosY * sindX, k * (m_cosY0 * sinY - m_sinY0 * cosY * cosdX));
+
+        screen[i]  = QPointF(p.x(), p.y());
+        visible[i] = c > cosMaxField && checkVisibility(o);
+    }
+}
+
 bool Projector::onScreen(const QPointF &p) const
 {
     return (0 <= p.x() && p.x() <= m_vp.width && 0 <= p.y() && p.y() <= m_vp.height);
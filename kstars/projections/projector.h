@@ -74,6 +74,17 @@ class Projector
             return m_vp;
         }
 
+        /**
+         * @short A number identifying the current view parameters
+         * It changes whenever setViewParams() gets parameters that project things differently
+         * than before, and differs between projectors. Screen positions computed for one viewID()
+         * stay valid as long as it and the coordinates projected don't change.
+         */
+        quint64 viewID() const
+        {
+            return m_viewID;
+        }
+
         enum Projection
         {
             Lambert,
@@ -134,6 +145,20 @@ class Projector
          */
         QPointF toScreen(const SkyPoint *o, bool oRefract = true, bool *onVisibleHemisphere = nullptr) const;
 
+        /**
+         * @short Project many points at once, e.g. the stars of a trixel or the points of a line.
+         *
+         * Gives the same screen positions as toScreen() on each point, but the view dependent terms are
+         * computed only once for all the points.
+         * @param points the points to project
+         * @param count number of points
+         * @param screen set to the screen position of each point
+         * @param visible set to whether each point is on the visible hemisphere and passes checkVisibility()
+         * @param oRefract same as for toScreenVec()
+         */
+        virtual void toScreen(const SkyPoint *const *points, int count, QPointF *screen, bool *visible,
+                              bool oRefract = true) const;
+
         /**
          * @short Determine RA, Dec coordinates of the pixel at (dx, dy), which are the
          * screen pixel coordinate offsets from the center of the Sky pixmap.
@@ -359,4 +384,10 @@ class Projector
         //Used by CheckVisibility
         double m_xrange { 0 };
         bool m_isPoleVisible { false };
+
+        // Focus coordinates of the current viewID(), horizontal ones in alt-az mode
+        double m_viewFocusLong { 0 };
+        double m_viewFocusLat { 0 };
+        quint64 m_viewID { 0 };
+        static quint64 s_lastViewID;
 };
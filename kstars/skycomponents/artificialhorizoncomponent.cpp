@@ -15,8 +15,18 @@
 #include "skypainter.h"
 #include "projections/projector.h"
 
+#include <algorithm>
+#include <atomic>
+
 #define UNDEFINED_ALTITUDE -90
 
+static std::atomic<unsigned int> g_entityRevision { 0 };
+
+unsigned int ArtificialHorizonEntity::revision()
+{
+    return g_entityRevision;
+}
+
 ArtificialHorizonEntity::~ArtificialHorizonEntity()
 {
     clearList();
@@ -40,6 +50,7 @@ bool ArtificialHorizonEntity::enabled() const
 void ArtificialHorizonEntity::setEnabled(bool Enabled)
 {
     m_Enabled = Enabled;
+    ++g_entityRevision;
 }
 
 bool ArtificialHorizonEntity::ceiling() const
@@ -50,11 +61,13 @@ bool ArtificialHorizonEntity::ceiling() const
 void ArtificialHorizonEntity::setCeiling(bool value)
 {
     m_Ceiling = value;
+    ++g_entityRevision;
 }
 
 void ArtificialHorizonEntity::setList(const std::shared_ptr<LineList> &list)
 {
     m_List = list;
+    ++g_entityRevision;
 }
 
 std::shared_ptr<LineList> ArtificialHorizonEntity::list() const
@@ -65,6 +78,7 @@ std::shared_ptr<LineList> ArtificialHorizonEntity::list() const
 void ArtificialHorizonEntity::clearList()
 {
     m_List.reset();
+    ++g_entityRevision;
 }
 
 namespace
@@ -156,7 +170,6 @@ void ArtificialHorizon::load(const QList<ArtificialHorizonEntity *> &list)
 {
     m_HorizonList = list;
     resetPrecomputeConstraints();
-    checkForCeilings();
 }
 
 bool ArtificialHorizonComponent::load()
@@ -615,7 +628,6 @@ void ArtificialHorizon::removeRegion(const QString &regionName, bool lineOnly)
         delete (regionHorizon);
     }
     resetPrecomputeConstraints();
-    checkForCeilings();
 }
 
 void ArtificialHorizonComponent::removeRegion(const QString &regionName, bool lineOnly)
@@ -626,19 +638,6 @@ void ArtificialHorizonComponent::removeRegion(const QString &regionName, bool li
     horizon.removeRegion(regionName, lineOnly);
 }
 
-void ArtificialHorizon::checkForCeilings()
-{
-    noCeilingConstraints = true;
-    for (const auto &r : m_HorizonList)
-    {
-        if (r->ceiling() && r->enabled())
-        {
-            noCeilingConstraints = false;
-            break;
-        }
-    }
-}
-
 void ArtificialHorizon::addRegion(const QString &regionName, bool enabled, const std::shared_ptr<LineList> &list,
                                   bool ceiling)
 {
@@ -651,7 +650,6 @@ void ArtificialHorizon::addRegion(const QString &regionName, bool enabled, const
 
     m_HorizonList.append(horizon);
     resetPrecomputeConstraints();
-    checkForCeilings();
 }
 
 void ArtificialHorizonComponent::addRegion(const QString &regionName, bool enabled, const std::shared_ptr<LineList> &list,
@@ -702,7 +700,7 @@ constexpr int PRECOMPUTED_RESOLUTION = 10;
 
 double ArtificialHorizon::altitudeConstraint(double azimuthDegrees) const
 {
-    if (precomputedConstraints.size() != 360 * PRECOMPUTED_RESOLUTION)
+    if (!precomputedValid())
         precomputeConstraints();
     return precomputedConstraint(azimuthDegrees);
 }
@@ -717,29 +715,75 @@ double ArtificialHorizon::altitudeConstraintInternal(double azimuthDegrees) cons
 }
 
 // Quantize the constraints to within .1 degrees (so there are 360*10=3600
-// precomputed values).
+// precomputed values). Along with the highest constraint, keep all the lines
+// crossing each azimuth, so that isVisible() can deal with ceilings from the table too.
 void ArtificialHorizon::precomputeConstraints() const
 {
+    constexpr int maxval = 360 * PRECOMPUTED_RESOLUTION;
+    precomputedRevision = ArtificialHorizonEntity::revision();
     precomputedConstraints.clear();
-    precomputedConstraints.fill(0, 360 * PRECOMPUTED_RESOLUTION);
-    for (int i = 0; i < 360 * PRECOMPUTED_RESOLUTION; ++i)
+    precomputedConstraints.fill(UNDEFINED_ALTITUDE, maxval);
+    precomputedLines.clear();
+    precomputedStarts.clear();
+    precomputedStarts.reserve(maxval + 1);
+
+    noCeilingConstraints = true;
+    for (const auto &horizon : m_HorizonList)
+    {
+        if (horizon->enabled() && horizon->ceiling())
+            noCeilingConstraints = false;
+    }
+
+    for (int i = 0; i < maxval; ++i)
     {
         const double az = i / static_cast<double>(PRECOMPUTED_RESOLUTION);
+        const int start = precomputedLines.size();
+        precomputedStarts.append(start);
+        for (const auto &horizon : m_HorizonList)
+        {
+            if (!horizon->enabled()) continue;
+            bool constraintExists = false;
+            const double constraint = horizon->altitudeConstraint(az, &constraintExists);
+            if (constraintExists)
+                precomputedLines.append(PrecomputedLine{constraint, horizon->ceiling()});
+        }
+        // Stable, so that lines at the same altitude keep the order of the horizon list,
+        // which decides between them in getConstraintAbove() and getConstraintBelow().
+        std::stable_sort(precomputedLines.begin() + start, precomputedLines.end(),
+                         [](const PrecomputedLine & a, const PrecomputedLine & b)
+        {
+            return a.altitude < b.altitude;
+        });
         precomputedConstraints[i] = altitudeConstraintInternal(az);
     }
+    precomputedStarts.append(precomputedLines.size());
 }
 
 void ArtificialHorizon::resetPrecomputeConstraints() const
 {
     precomputedConstraints.clear();
+    precomputedLines.clear();
+    precomputedStarts.clear();
 }
 
-double ArtificialHorizon::precomputedConstraint(double azimuth) const
+bool ArtificialHorizon::precomputedValid() const
+{
+    return precomputedConstraints.size() == 360 * PRECOMPUTED_RESOLUTION &&
+           precomputedRevision == ArtificialHorizonEntity::revision();
+}
+
+int ArtificialHorizon::precomputedIndex(double azimuth) const
 {
     constexpr int maxval = 360 * PRECOMPUTED_RESOLUTION;
-    int index = azimuth * PRECOMPUTED_RESOLUTION + 0.5;
-    if (index == maxval)
+    int index = normalizeDegrees(azimuth) * PRECOMPUTED_RESOLUTION + 0.5;
+    if (index >= maxval)
         index = 0;
+    return index;
+}
+
+double ArtificialHorizon::precomputedConstraint(double azimuth) const
+{
+    const int index = precomputedIndex(azimuth);
     if (index < 0 || index >= precomputedConstraints.size())
         return UNDEFINED_ALTITUDE;
     return precomputedConstraints[index];
@@ -772,6 +816,8 @@ const ArtificialHorizonEntity *ArtificialHorizon::getConstraintBelow(double azim
 
 bool ArtificialHorizon::isAltitudeOK(double azimuthDegrees, double altitudeDegrees, QString *reason) const
 {
+    if (!precomputedValid())
+        precomputeConstraints();
     if (noCeilingConstraints)
     {
         const double constraint = altitudeConstraint(azimuthDegrees);
@@ -788,29 +834,43 @@ bool ArtificialHorizon::isAltitudeOK(double azimuthDegrees, double altitudeDegre
 // An altitude is blocked (not visible) if either:
 // - there are constraints above and the closest above constraint is not a ceiling, or
 // - there are constraints below and the closest below constraint is a ceiling.
+// The constraints come from the lines precomputed for the azimuth, which are sorted by altitude.
 bool ArtificialHorizon::isVisible(double azimuthDegrees, double altitudeDegrees, QString *reason) const
 {
-    const ArtificialHorizonEntity *above = getConstraintAbove(azimuthDegrees, altitudeDegrees);
-    if (above != nullptr && !above->ceiling())
+    if (!precomputedValid())
+        precomputeConstraints();
+
+    const int index = precomputedIndex(azimuthDegrees);
+    const auto first = precomputedLines.cbegin() + precomputedStarts[index];
+    const auto last = precomputedLines.cbegin() + precomputedStarts[index + 1];
+
+    // The closest line above, and the first of those at the closest altitude below.
+    const auto above = std::upper_bound(first, last, altitudeDegrees, [](double altitude, const PrecomputedLine & line)
+    {
+        return altitude < line.altitude;
+    });
+    if (above != last && !above->ceiling)
     {
         if (reason != nullptr)
-        {
-            bool ignoreMe;
-            double constraint = above->altitudeConstraint(azimuthDegrees, &ignoreMe);
-            *reason = QString("altitude %1 < horizon %2").arg(altitudeDegrees, 0, 'f', 1).arg(constraint, 0, 'f', 1);
-        }
+            *reason = QString("altitude %1 < horizon %2").arg(altitudeDegrees, 0, 'f', 1).arg(above->altitude, 0, 'f', 1);
         return false;
     }
-    const ArtificialHorizonEntity *below = getConstraintBelow(azimuthDegrees, altitudeDegrees);
-    if (below != nullptr && below->ceiling())
+    auto below = std::lower_bound(first, last, altitudeDegrees, [](const PrecomputedLine & line, double altitude)
     {
-        if (reason != nullptr)
+        return line.altitude < altitude;
+    });
+    if (below != first)
+    {
+        below = std::lower_bound(first, below, (below - 1)->altitude, [](const PrecomputedLine & line, double altitude)
         {
-            bool ignoreMe;
-            double constraint = below->altitudeConstraint(azimuthDegrees, &ignoreMe);
-            *reason = QString("altitude %1 > ceiling %2").arg(altitudeDegrees, 0, 'f', 1).arg(constraint, 0, 'f', 1);
+            return line.altitude < altitude;
+        });
+        if (below->ceiling)
+        {
+            if (reason != nullptr)
+                *reason = QString("altitude %1 > ceiling %2").arg(altitudeDegrees, 0, 'f', 1).arg(below->altitude, 0, 'f', 1);
+            return false;
         }
-        return false;
     }
     return true;
 }
@@ -42,6 +42,9 @@ class ArtificialHorizonEntity
         // constraintExists will be set to false if there is no constraint for the azimuth.
         double altitudeConstraint(double azimuthDegrees, bool *constraintExists) const;
 
+        // Counts the changes made to any entity, so that the horizons know when to recompute.
+        static unsigned int revision();
+
     private:
         QString m_Region;
         bool m_Enabled { false };
@@ -115,16 +118,28 @@ class ArtificialHorizon
         QList<ArtificialHorizonEntity *> m_HorizonList;
         bool testing { false };
 
-        // Methods and data structure for precomputing altitudeConstraint(azimuth).
+        // Methods and data structure for precomputing altitudeConstraint(azimuth) and isVisible().
         // This way, we don't traverse the potentially horizon list each time
-        // we query the horizon constraint.
+        // we query the horizon constraint. The tables are rebuilt once the regions
+        // or any of their entities change.
+        struct PrecomputedLine
+        {
+            double altitude;
+            bool ceiling;
+        };
         void precomputeConstraints() const;
         void resetPrecomputeConstraints() const;
+        bool precomputedValid() const;
+        int precomputedIndex(double azimuth) const;
         double precomputedConstraint(double azimuth) const;
         double altitudeConstraintInternal(double azimuthDegrees) const;
         mutable QVector<double> precomputedConstraints;
-        bool noCeilingConstraints { true };
-        void checkForCeilings();
+        // The enabled lines crossing each azimuth, sorted by altitude. Those of the azimuth
+        // with index i run from precomputedStarts[i] up to precomputedStarts[i + 1].
+        mutable QVector<PrecomputedLine> precomputedLines;
+        mutable QVector<int> precomputedStarts;
+        mutable unsigned int precomputedRevision { 0 };
+        mutable bool noCeilingConstraints { true };
         friend TestArtificialHorizon;
 };
 
@@ -13,6 +13,7 @@
 #include "ksfilereader.h"
 #include "kstarsdata.h"
 #include "kstars_debug.h"
+#include "ksnumbers.h"
 #include "Options.h"
 #include "solarsystemcomposite.h"
 #include "skycomponent.h"
@@ -40,12 +41,42 @@
 AsteroidsComponent::AsteroidsComponent(SolarSystemComposite *parent)
     : BinaryListComponent(this, "asteroids"), SolarSystemListComponent(parent)
 {
-    loadData();
 }
 
 bool AsteroidsComponent::selected()
 {
-    return Options::showAsteroids();
+    if (!Options::showAsteroids())
+        return false;
+
+    // Loaded the first time they are shown
+    loadDataIfNeeded();
+    return true;
+}
+
+void AsteroidsComponent::loadDataIfNeeded()
+{
+    if (isDataLoaded())
+        return;
+
+    loadData();
+    updateSolarSystemBodies(KStarsData::Instance()->updateNum());
+}
+
+bool AsteroidsComponent::toUpdate(KSPlanetBase *body, const KSNumbers *num)
+{
+    KSAsteroid *ast = static_cast<KSAsteroid *>(body);
+
+    // Keep the drawn and focused ones, and those with a trail, up to date
+    if (ast->toCalculate() || ast->hasTrail())
+        return true;
+
+    // Leave out those that never get bright enough to be drawn
+    const double limit = Options::magLimitAsteroid();
+    if (ast->brightestMagnitude() > limit)
+        return false;
+
+    // The others only brighten slowly, so look at them once a day unless they are close to the limit
+    return ast->mag() <= limit + 2.0 || fabs(num->julianDay() - ast->getLastPrecessJD()) >= 1.0;
 }
 
 /*
@@ -235,6 +266,12 @@ SkyObject *AsteroidsComponent::objectNearest(SkyPoint *p, double &maxrad)
     if (!selected())
         return nullptr;
 
+    if (m_PointIndex.isValid())
+        return m_PointIndex.nearest(p, maxrad, [](SkyObject * o)
+    {
+        return static_cast<KSAsteroid *>(o)->toDraw();
+    });
+
     for (auto o : m_ObjectList)
     {
         if (!((dynamic_cast<KSAsteroid*>(o)->toDraw())))
@@ -40,6 +40,9 @@ class AsteroidsComponent : public QObject, public SolarSystemListComponent,
 
         void draw(SkyPainter *skyp) override;
         bool selected() override;
+
+        /** @short Load the asteroids now unless they are loaded already, they are not loaded at start up */
+        void loadDataIfNeeded();
         SkyObject *objectNearest(SkyPoint *p, double &maxrad) override;
 
         void updateDataFile(bool isAutoUpdate = false);
@@ -48,6 +51,9 @@ class AsteroidsComponent : public QObject, public SolarSystemListComponent,
         void downloadReady();
         void downloadError(const QString &errorString);
 
+    protected:
+        bool toUpdate(KSPlanetBase *body, const KSNumbers *num) override;
+
     private:
         void loadDataFromText() override;
 
@@ -8,8 +8,11 @@
 
 #include <QDataStream>
 #include <QDebug>
+#include <QFile>
+#include <QFileInfo>
 
 #include "listcomponent.h"
+#include "nameindex.h"
 #include "binarylistcomponent.h"
 #include "auxiliary/kspaths.h"
 
@@ -34,6 +37,11 @@
  * This is a concession to the already present architecture.
  *
  * File paths are determent by the means of KSPaths::writableLocation.
+ *
+ * The binary starts with a header holding a magic number, the format revision, the object
+ * type, the number of objects and a checksum of the rest. It is memory mapped for loading
+ * and if any of these do not match, or the text file is newer, it is rebuilt from the text.
+ * Bump `binformat` whenever a serializer changes.
  */
 template <class T, typename Component>
 class BinaryListComponent
@@ -57,6 +65,15 @@ public:
      */
     BinaryListComponent(Component* parent, QString basename, QString txtExt, QString binExt);
 
+    /**
+     * @brief isDataLoaded
+     * @return True once the component data was loaded, components may wait until it is first needed
+     */
+    bool isDataLoaded() const
+    {
+        return dataLoaded;
+    }
+
 protected:
     /**
      * @brief loadData
@@ -77,15 +94,17 @@ protected:
     /**
      * @brief loadDataFromBinary
      * @short Opens the default binfile and calls `loadDataFromBinary([FILE])`
+     * @return True if the binary was valid and loaded
      */
-    virtual void loadDataFromBinary();
+    virtual bool loadDataFromBinary();
 
     /**
      * @brief loadDataFromBinary
      * @param binfile the binary file
      * @short Loads the component data from the given binary.
+     * @return True if the binary was valid and loaded, else the component is left empty
      */
-    virtual void loadDataFromBinary(QFile &binfile);
+    virtual bool loadDataFromBinary(QFile &binfile);
 
     /**
      * @brief writeBinary
@@ -136,10 +155,13 @@ protected:
 
     QString filepath_txt;
     QString filepath_bin;
+    bool dataLoaded { false };
 
 // Don't allow the children to mess with the Binary Version!
 private:
     QDataStream::Version binversion = QDataStream::Qt_5_5;
+    static constexpr quint32 binmagic  = 0x4B53424C; // "KSBL"
+    static constexpr quint32 binformat = 1;
     Component* parent;
 };
 
@@ -162,6 +184,8 @@ void  BinaryListComponent<T, Component>::loadData()
 template<class T, typename Component>
 void  BinaryListComponent<T, Component>::loadData(bool dropBinaryFile)
 {
+    dataLoaded = true;
+
     // Clear old Stuff (in case of reload)
     clearData();
 
@@ -170,46 +194,86 @@ void  BinaryListComponent<T, Component>::loadData(bool dropBinaryFile)
         dropBinary();
 
     QFile binfile(filepath_bin);
-    if (binfile.exists()) {
-        loadDataFromBinary(binfile);
-    } else {
-        loadDataFromText();
-        writeBinary(binfile);
-    }
+    const QFileInfo txtinfo(filepath_txt);
+    const bool outdated = txtinfo.exists() && txtinfo.lastModified() > QFileInfo(binfile).lastModified();
+
+    if (binfile.exists() && !outdated && loadDataFromBinary(binfile))
+        return;
+
+    loadDataFromText();
+    writeBinary(binfile);
 }
 
 template<class T, typename Component>
-void  BinaryListComponent<T, Component>::loadDataFromBinary()
+bool  BinaryListComponent<T, Component>::loadDataFromBinary()
 {
     QFile binfile(filepath_bin);
-    loadDataFromBinary(binfile);
+    return loadDataFromBinary(binfile);
 }
 
 template<class T, typename Component>
-void  BinaryListComponent<T, Component>::loadDataFromBinary(QFile &binfile)
+bool  BinaryListComponent<T, Component>::loadDataFromBinary(QFile &binfile)
 {
-    // Open our binary file and create a Stream
-    if (binfile.open(QIODevice::ReadOnly))
+    // Open our binary file and map it
+    const uchar *data = nullptr;
+    if (binfile.open(QIODevice::ReadOnly) && binfile.size() > 0)
+        data = binfile.map(0, binfile.size());
+
+    if (data == nullptr)
+    {
+        qWarning() << "Failed loading binary data from" << binfile.fileName();
+        binfile.close();
+        return false;
+    }
+
+    bool valid = false;
     {
-        QDataStream in(&binfile);
+        const QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char *>(data), int(binfile.size()));
+        QDataStream in(raw);
 
         // Use the specified binary version
         // TODO: Place this into the config
         in.setVersion(binversion);
         in.setFloatingPointPrecision(QDataStream::DoublePrecision);
 
-        while(!in.atEnd()){
+        quint32 magic = 0, format = 0, count = 0;
+        qint32 type = -1;
+        quint16 checksum = 0;
+        in >> magic >> format >> type >> count >> checksum;
+
+        const int offset = int(in.device()->pos());
+        valid = in.status() == QDataStream::Ok && magic == binmagic && format == binformat &&
+                type == qint32(T::TYPE) &&
+                checksum == qChecksum(raw.constData() + offset, uint(raw.size() - offset));
+
+        for (quint32 n = 0; valid && n < count; ++n)
+        {
             T *new_object = nullptr;
             in >> new_object;
+            if (in.status() != QDataStream::Ok)
+            {
+                delete new_object;
+                valid = false;
+                break;
+            }
 
             parent->appendListObject(new_object);
             // Add name to the list of object names
             parent->objectNames(T::TYPE).append(new_object->name());
             parent->objectLists(T::TYPE).append(QPair<QString, const SkyObject *>(new_object->name(), new_object));
         }
-        binfile.close();
+        valid = valid && in.atEnd();
+    }
+
+    binfile.unmap(const_cast<uchar *>(data));
+    binfile.close();
+
+    if (!valid)
+    {
+        qWarning() << "Binary data in" << binfile.fileName() << "is outdated or corrupt";
+        clearData();
     }
-    else qWarning() << "Failed loading binary data from" << binfile.fileName();
+    return valid;
 }
 
 template<class T, typename Component>
@@ -222,16 +286,32 @@ void  BinaryListComponent<T, Component>::writeBinary()
 template<class T, typename Component>
 void  BinaryListComponent<T, Component>::writeBinary(QFile &binfile)
 {
+    // Dump out everything, so that the header can carry its checksum
+    QByteArray payload;
+    {
+        QDataStream out(&payload, QIODevice::WriteOnly);
+        out.setVersion(binversion);
+        out.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+        for(auto object : parent->m_ObjectList){
+             out << *((T*)object);
+        }
+    }
+
     // Open our file and create a stream
-    binfile.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    if (!binfile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "Failed writing binary data to" << binfile.fileName();
+        return;
+    }
+
     QDataStream out(&binfile);
     out.setVersion(binversion);
     out.setFloatingPointPrecision(QDataStream::DoublePrecision);
 
-    // Now just dump out everything
-    for(auto object : parent->m_ObjectList){
-         out << *((T*)object);
-    }
+    out << binmagic << binformat << qint32(T::TYPE) << quint32(parent->m_ObjectList.size())
+        << qChecksum(payload.constData(), uint(payload.size()));
+    out.writeRawData(payload.constData(), payload.size());
 
     binfile.close();
 }
@@ -252,6 +332,8 @@ template<class T, typename Component>
 void  BinaryListComponent<T, Component>::clearData()
 {
     // Clear lists
+    NameIndex::invalidate();
+    parent->m_PointIndex.invalidate();
     qDeleteAll(parent->m_ObjectList);
     parent->m_ObjectList.clear();
     parent->m_ObjectHash.clear();
@@ -47,9 +47,25 @@ CatalogsComponent::CatalogsComponent(SkyComposite *parent, const QString &db_fil
 
     m_catalog_colors = m_db_manager.get_catalog_colors();
     tryImportSkyComponents();
+    openTiles();
+
+    // The trixels on the screen are read again by the next draw
+    m_lowMemoryConnection = QObject::connect(MemoryBudget::Instance(), &MemoryBudget::lowMemory, [this]()
+    {
+        cancelLoading();
+        m_mainCache.clear();
+        m_unknownMagCache.clear();
+    });
     qCInfo(KSTARS) << "Loaded DSO catalogs.";
 }
 
+CatalogsComponent::~CatalogsComponent()
+{
+    QObject::disconnect(m_lowMemoryConnection);
+    cancelLoading();
+    m_loader.waitForFinished();
+}
+
 double compute_maglim()
 {
     double maglim = Options::magLimitDrawDeepSky();
@@ -86,12 +102,13 @@ void CatalogsComponent::draw(SkyPainter *skyp)
 
     auto &map       = *SkyMap::Instance();
     auto hideLabels = (map.isSlewing() && Options::hideOnSlew()) ||
+                      !data->skyComposite()->renderQuality().labels() ||
                       !(Options::showDeepSkyMagnitudes() || Options::showDeepSkyNames());
 
     const auto label_padding{ 1 + (1 - (Options::deepSkyLabelDensity() / 100)) * 50 };
-    auto &proj = *map.projector();
 
     updateSkyMesh(map);
+    mergeLoadedTrixels();
 
     size_t num_trixels{ 0 };
     const auto zoomFactor = Options::zoomFactor();
@@ -132,37 +149,31 @@ void CatalogsComponent::draw(SkyPainter *skyp)
     // Helper lambda to fill the appropriate cache for a given trixel
     auto fillCache = [&](
         TrixelCache<ObjectList>::element& cacheElement,
-        ObjectList (CatalogsDB::DBManager::*fillFunction)(const int),
+        ObjectList (CatalogsDB::TileFile::*tileFunction)(const int) const,
+        bool unknownMag,
         Trixel trixel
         ) -> void {
-        if (!cacheElement.is_set())
-        {
-            try
-            {
-                cacheElement = (m_db_manager.*fillFunction)(trixel);
-            }
-            catch (const CatalogsDB::DatabaseError &e)
-            {
-                qCCritical(KSTARS)
-                    << "Could not load catalog objects in trixel: " << trixel << ", "
-                    << e.what();
-
-                KMessageBox::detailedError(
-                    nullptr, i18n("Could not load catalog objects in trixel: %1", trixel),
-                    e.what());
-
-                throw; // do not silently fail
-            }
-        }
+        if (cacheElement.is_set())
+            return;
+
+        // Reading the tiles is cheap, the database is left to the worker
+        // and the trixel stays empty until it is done
+        if (m_tiles.is_open())
+            cacheElement = (m_tiles.*tileFunction)(trixel);
+        else
+            requestTrixel(trixel, unknownMag);
     };
 
-    // Helper lambda to JIT update and draw
-    auto drawObjects = [&](std::vector<CatalogObject*>& objects) {
-        // TODO: If we are sure that JITupdate has no side effects
-        // that may cause races etc, it will be worth parallelizing
+    // Helper lambda to queue the objects of a trixel for drawObjects()
+    auto queueObjects = [&](const std::vector<CatalogObject*>& objects,
+                            QVector<SkyPainter::CatalogDrawList>& lists) {
+        if (objects.empty())
+            return;
 
+        SkyPainter::CatalogDrawList list;
+        list.objects.reserve(objects.size());
+        list.colors.reserve(objects.size());
         for (CatalogObject *object : objects) {
-            object->JITupdate();
             auto &color = m_catalog_colors[object->catalogId()][color_scheme];
             if (!color.isValid())
             {
@@ -174,20 +185,43 @@ void CatalogsComponent::draw(SkyPainter *skyp)
                 }
             }
 
-            skyp->setPen(color);
-
             if (Options::showInlineImages())
                 object->load_image();
 
-            if (skyp->drawCatalogObject(*object) && !hideLabels)
+            list.objects.append(object);
+            list.colors.append(color);
+        }
+        lists.append(list);
+    };
+
+    // Helper lambda to JIT update and project the queued objects on the
+    // thread pool, then draw them here. Each object is in one trixel only,
+    // so no two workers update the same object.
+    std::function<void(SkyPainter::CatalogDrawList &)> prepare = [skyp](SkyPainter::CatalogDrawList & list)
+    {
+        for (CatalogObject *object : list.objects)
+            object->JITupdate();
+        skyp->prepareCatalogObjects(&list);
+    };
+    auto drawObjects = [&](QVector<SkyPainter::CatalogDrawList>& lists) {
+        QtConcurrent::blockingMap(lists, prepare);
+
+        for (auto &list : lists) {
+            skyp->drawCatalogObjects(&list);
+
+            if (hideLabels)
+                continue;
+            for (int i = 0; i < list.objects.size(); i++)
             {
-                labeler.drawNameLabel(object, proj.toScreen(object), label_padding);
+                if (list.visible.at(i))
+                    labeler.drawNameLabel(list.objects.at(i), list.screen.at(i), label_padding);
             }
         }
     };
 
     std::vector<CatalogObject*> drawListKnownMag;
     drawListKnownMag.reserve(expectedKnownMagObjectsPerTrixel);
+    QVector<SkyPainter::CatalogDrawList> knownMagLists;
 
     // Handle the objects of known magnitude
     MeshIterator region(m_skyMesh, DRAW_BUF);
@@ -198,7 +232,8 @@ void CatalogsComponent::draw(SkyPainter *skyp)
 
         // Fill the cache for this trixel
         auto &objectsKnownMag = m_mainCache[trixel];
-        fillCache(objectsKnownMag, &CatalogsDB::DBManager::get_objects_in_trixel_no_nulls, trixel);
+        fillCache(objectsKnownMag, &CatalogsDB::TileFile::get_objects_in_trixel_no_nulls,
+                  false, trixel);
         drawListKnownMag.clear();
 
         // Filter based on magnitude and size
@@ -224,16 +259,19 @@ void CatalogsComponent::draw(SkyPainter *skyp)
             drawListKnownMag.push_back(const_cast<CatalogObject*>(&object));
         }
 
-        // JIT update and draw
-        drawObjects(drawListKnownMag);
+        queueObjects(drawListKnownMag, knownMagLists);
     }
 
+    // JIT update and draw
+    drawObjects(knownMagLists);
+
     // Handle the objects of unknown magnitude
     if (showUnknownMagObjects)
     {
         std::vector<CatalogObject*> drawListUnknownMag;
         drawListUnknownMag.reserve(expectedUnknownMagObjectsPerTrixel);
         QMutex drawListUnknownMagLock;
+        QVector<SkyPainter::CatalogDrawList> unknownMagLists;
 
         MeshIterator region(m_skyMesh, DRAW_BUF);
         while (region.hasNext())
@@ -243,7 +281,8 @@ void CatalogsComponent::draw(SkyPainter *skyp)
 
             // Fill cache
             auto &objectsUnknownMag = m_unknownMagCache[trixel];
-            fillCache(objectsUnknownMag, &CatalogsDB::DBManager::get_objects_in_trixel_null_mag, trixel);
+            fillCache(objectsUnknownMag, &CatalogsDB::TileFile::get_objects_in_trixel_null_mag,
+                      true, trixel);
 
             // Filter
             QtConcurrent::blockingMap(
@@ -272,10 +311,12 @@ void CatalogsComponent::draw(SkyPainter *skyp)
                     drawListUnknownMag.push_back(const_cast<CatalogObject*>(&object));
                 });
 
-            // JIT update and draw
-            drawObjects(drawListUnknownMag);
+            queueObjects(drawListUnknownMag, unknownMagLists);
         }
 
+        // JIT update and draw
+        drawObjects(unknownMagLists);
+
     }
 
     // prune only if the to-be-pruned trixels are likely not visible
@@ -294,6 +335,165 @@ void CatalogsComponent::updateSkyMesh(SkyMap &map, MeshBufNum_t buf)
     m_skyMesh->aperture(focus, radius + 1.0, buf);
 }
 
+void CatalogsComponent::openTiles()
+{
+    const auto &path  = m_db_manager.tiles_file_name();
+    const auto &stats = m_db_manager.get_master_statistics();
+    if (!stats.first)
+    {
+        m_tiles.close();
+        qCWarning(KSTARS) << "Could not count the DSOs, reading them from the database.";
+        return;
+    }
+
+    const auto open = [&]()
+    {
+        return m_tiles.open(path, m_db_manager.htmesh_level(), stats.second.total_count,
+                            m_db_manager.db_file_name());
+    };
+
+    auto success = open();
+    if (!success.first)
+    {
+        qCDebug(KSTARS) << "Compiling the DSO tiles:" << success.second;
+        success = m_db_manager.compile_tiles(path);
+        if (success.first)
+            success = open();
+    }
+
+    if (!success.first)
+        qCWarning(KSTARS) << "Could not use the DSO tiles, reading from the database:"
+                          << success.second;
+}
+
+CatalogsComponent::ObjectList CatalogsComponent::objectsInTrixel(Trixel trixel)
+{
+    if (!m_tiles.is_open())
+        return m_db_manager.get_objects_in_trixel(trixel);
+
+    auto objects    = m_tiles.get_objects_in_trixel_no_nulls(trixel);
+    auto unknownMag = m_tiles.get_objects_in_trixel_null_mag(trixel);
+    objects.insert(objects.end(), std::make_move_iterator(unknownMag.begin()),
+                   std::make_move_iterator(unknownMag.end()));
+    return objects;
+}
+
+void CatalogsComponent::requestTrixel(Trixel trixel, bool unknownMag)
+{
+    QMutexLocker _{ &m_loaderMutex };
+
+    auto &loading = unknownMag ? m_loadingUnknownMag : m_loadingKnownMag;
+    if (!loading.insert(trixel).second)
+        return;
+
+    m_loadQueue.emplace_back(trixel, unknownMag);
+    if (m_loaderRunning)
+        return;
+
+    m_loaderRunning = true;
+    m_loader        = QtConcurrent::run([this]()
+    {
+        loadTrixels();
+    });
+}
+
+void CatalogsComponent::loadTrixels()
+{
+    try
+    {
+        // QSqlDatabase connections must not be shared between threads
+        CatalogsDB::DBManager manager{ m_db_manager.db_file_name() };
+
+        while (true)
+        {
+            std::pair<Trixel, bool> next;
+            int generation;
+            {
+                QMutexLocker _{ &m_loaderMutex };
+                if (m_loadQueue.empty())
+                {
+                    m_loaderRunning = false;
+                    break;
+                }
+
+                next       = m_loadQueue.front();
+                generation = m_loaderGeneration;
+                m_loadQueue.erase(m_loadQueue.begin());
+            }
+
+            auto objects = next.second ? manager.get_objects_in_trixel_null_mag(next.first)
+                           : manager.get_objects_in_trixel_no_nulls(next.first);
+
+            QMutexLocker _{ &m_loaderMutex };
+            if (generation == m_loaderGeneration)
+                m_loaded.push_back({ next.first, next.second, std::move(objects) });
+        }
+    }
+    catch (const CatalogsDB::DatabaseError &)
+    {
+        QMutexLocker _{ &m_loaderMutex };
+        m_loaderError = std::current_exception();
+        m_loadQueue.clear();
+        m_loaderRunning = false;
+    }
+
+    if (SkyMap::Instance())
+        QMetaObject::invokeMethod(SkyMap::Instance(), "forceUpdate", Qt::QueuedConnection);
+}
+
+void CatalogsComponent::mergeLoadedTrixels()
+{
+    std::vector<LoadedTrixel> loaded;
+    std::exception_ptr error;
+    {
+        QMutexLocker _{ &m_loaderMutex };
+        loaded.swap(m_loaded);
+        std::swap(error, m_loaderError);
+
+        for (const auto &item : loaded)
+            (item.unknownMag ? m_loadingUnknownMag : m_loadingKnownMag).erase(item.trixel);
+
+        if (error)
+        {
+            m_loadingKnownMag.clear();
+            m_loadingUnknownMag.clear();
+        }
+    }
+
+    for (auto &item : loaded)
+    {
+        auto &cache = item.unknownMag ? m_unknownMagCache : m_mainCache;
+        cache[item.trixel] = std::move(item.objects);
+    }
+
+    if (!error)
+        return;
+
+    try
+    {
+        std::rethrow_exception(error);
+    }
+    catch (const CatalogsDB::DatabaseError &e)
+    {
+        qCCritical(KSTARS) << "Could not load catalog objects: " << e.what();
+
+        KMessageBox::detailedError(nullptr, i18n("Could not load catalog objects."),
+                                   e.what());
+
+        throw; // do not silently fail
+    }
+}
+
+void CatalogsComponent::cancelLoading()
+{
+    QMutexLocker _{ &m_loaderMutex };
+    m_loaderGeneration++;
+    m_loadQueue.clear();
+    m_loadingKnownMag.clear();
+    m_loadingUnknownMag.clear();
+    m_loaded.clear();
+}
+
 CatalogObject &CatalogsComponent::insertStaticObject(const CatalogObject &obj)
 {
     auto trixel     = m_skyMesh->index(&obj);
@@ -349,7 +549,7 @@ void CatalogsComponent::objectsInArea(QList<SkyObject *> &list, const SkyRegion
     {
         try
         {
-            for (auto &dso : m_db_manager.get_objects_in_trixel(it.key()))
+            for (auto &dso : objectsInTrixel(it.key()))
             {
                 auto &obj = insertStaticObject(dso);
                 list.append(&obj);
@@ -384,7 +584,7 @@ SkyObject *CatalogsComponent::objectNearest(SkyPoint *p, double &maxrad)
         auto trixel = region.next();
         try
         {
-            auto objects = m_db_manager.get_objects_in_trixel(trixel);
+            auto objects = objectsInTrixel(trixel);
             if (!found)
                 found = objects.size() > 0;
 
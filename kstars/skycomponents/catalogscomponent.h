@@ -9,13 +9,20 @@
 
 #include "skycomponent.h"
 #include "catalogsdb.h"
+#include "catalogtiles.h"
 #include "catalogobject.h"
 #include "skymesh.h"
 #include "trixelcache.h"
 #include "Options.h"
+#include "auxiliary/memorybudget.h"
 
 #include "polyfills/qstring_hash.h"
+#include <QFuture>
+#include <QMutex>
+#include <algorithm>
+#include <exception>
 #include <unordered_map>
+#include <unordered_set>
 
 class SkyMesh;
 class SkyMap;
@@ -55,11 +62,15 @@ class CatalogsComponent : public SkyComponent
         explicit CatalogsComponent(SkyComposite *parent, const QString &db_filename,
                                    bool load_default = false);
 
-        ~CatalogsComponent() override = default;
+        ~CatalogsComponent() override;
 
         /**
          * Draws the objects in the currently visible trixels by
          * dynamically loading them from the database.
+         *
+         * Trixels that have to be read from the database rather than the
+         * tiles are loaded in the background and skipped until they are
+         * available, at which point the sky map is repainted.
          */
         void draw(SkyPainter *skyp) override;
 
@@ -110,9 +121,11 @@ class CatalogsComponent : public SkyComponent
          */
         void dropCache()
         {
+            cancelLoading();
             m_mainCache.clear();
             m_unknownMagCache.clear();
             m_catalog_colors = m_db_manager.get_catalog_colors();
+            openTiles();
         };
 
         /**
@@ -129,6 +142,13 @@ class CatalogsComponent : public SkyComponent
          */
         CatalogsDB::DBManager m_db_manager;
 
+        /**
+         * The memory mapped tiles of the master catalog, from which the
+         * objects are read instead of the database whenever they are
+         * available.
+         */
+        CatalogsDB::TileFile m_tiles;
+
         /**
          * A pointer to a SkyMesh of the appropriate level.
          *
@@ -152,6 +172,35 @@ class CatalogsComponent : public SkyComponent
          */
         TrixelCache<ObjectList> m_unknownMagCache;
 
+        //@{
+        /**
+         * Background loading of trixels from the database. The draw
+         * queues the missing trixels in `m_loadQueue`, a worker drains the
+         * queue with its own database connection and leaves the objects in
+         * `m_loaded`, from where the next draw moves them into the caches.
+         * All of these are guarded by `m_loaderMutex`.
+         */
+        struct LoadedTrixel
+        {
+            Trixel trixel;
+            bool unknownMag;
+            ObjectList objects;
+        };
+
+        QMutex m_loaderMutex;
+        std::vector<std::pair<Trixel, bool>> m_loadQueue;
+        std::unordered_set<Trixel> m_loadingKnownMag;
+        std::unordered_set<Trixel> m_loadingUnknownMag;
+        std::vector<LoadedTrixel> m_loaded;
+        std::exception_ptr m_loaderError;
+        bool m_loaderRunning{ false };
+        int m_loaderGeneration{ 0 };
+        QFuture<void> m_loader;
+        //@}
+
+        /** Drops the cached trixels when the device runs low on memory */
+        QMetaObject::Connection m_lowMemoryConnection;
+
         /**
          * A trixel indexed map of lists containing manually loaded
          * `CatalogObject`s.
@@ -183,9 +232,47 @@ class CatalogsComponent : public SkyComponent
         void updateSkyMesh(SkyMap &map, MeshBufNum_t buf = DRAW_BUF);
         size_t calculateCacheSize(const unsigned int percentage)
         {
-            return m_skyMesh->size() * percentage / 100.f;
+            // A memory budget cuts the share of the sky cached down
+            return std::max<size_t>(1, m_skyMesh->size() * percentage / 100.f *
+                                    MemoryBudget::Instance()->scale());
         }
 
+        /**
+         * (Re)open the tile file of the database, compiling it first if
+         * it is missing or stale. If that fails, the objects are read
+         * from the database.
+         */
+        void openTiles();
+
+        /**
+         * @return all objects in \p trixel, from the tiles if possible.
+         */
+        ObjectList objectsInTrixel(Trixel trixel);
+
+        /**
+         * Queue \p trixel to be loaded in the background, unless it
+         * already is. \p unknownMag selects the objects of unknown
+         * magnitude.
+         */
+        void requestTrixel(Trixel trixel, bool unknownMag);
+
+        /**
+         * The worker draining `m_loadQueue`.
+         */
+        void loadTrixels();
+
+        /**
+         * Move the trixels loaded in the background into the caches and
+         * rethrow an error of the worker, if any.
+         */
+        void mergeLoadedTrixels();
+
+        /**
+         * Forget the queued and loaded trixels, e.g. because the
+         * database changed.
+         */
+        void cancelLoading();
+
         /**
          * Try importing the old skycomponents database.
          */
@@ -37,14 +37,27 @@
 #include <cmath>
 
 CometsComponent::CometsComponent(SolarSystemComposite *parent)
-    : SolarSystemListComponent(parent)
+    : BinaryListComponent(this, "cometels", "json.gz", "bin"), SolarSystemListComponent(parent)
 {
-    loadData();
 }
 
 bool CometsComponent::selected()
 {
-    return Options::showComets();
+    if (!Options::showComets())
+        return false;
+
+    // Loaded the first time they are shown
+    loadDataIfNeeded();
+    return true;
+}
+
+void CometsComponent::loadDataIfNeeded()
+{
+    if (isDataLoaded())
+        return;
+
+    loadData();
+    updateSolarSystemBodies(KStarsData::Instance()->updateNum());
 }
 
 /*
@@ -75,20 +88,15 @@ bool CometsComponent::selected()
  * @li 20 comet total magnitude slope parameter
  * @li 21 comet nuclear magnitude slope parameter
  * @note See KSComet constructor for more details.
+ * @note This is only run when the binary cache is missing or stale, see BinaryListComponent.
  */
-void CometsComponent::loadData()
+void CometsComponent::loadDataFromText()
 {
     QString name, orbit_class;
 
     emitProgressText(i18n("Loading comets"));
     qCInfo(KSTARS) << "Loading comets";
 
-    qDeleteAll(m_ObjectList);
-    m_ObjectList.clear();
-
-    objectNames(SkyObject::COMET).clear();
-    objectLists(SkyObject::COMET).clear();
-
     QString file_name = KSPaths::locate(QStandardPaths::AppLocalDataLocation, QString("cometels.json.gz"));
 
     try
@@ -360,7 +368,7 @@ void CometsComponent::downloadReady()
 #endif
 
     // Reload comets
-    loadData();
+    loadData(true);
 
 #ifdef KSTARS_LITE
     KStarsLite::Instance()->data()->setFullTimeUpdate();
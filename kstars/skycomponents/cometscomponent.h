@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include "binarylistcomponent.h"
 #include "ksparser.h"
 #include "solarsystemlistcomponent.h"
+#include "skyobjects/kscomet.h"
 #include "filedownloader.h"
 
 #include <QList>
@@ -23,10 +25,12 @@ class SkyLabeler;
  * @author Jason Harris
  * @version 0.1
  */
-class CometsComponent : public QObject, public SolarSystemListComponent
+class CometsComponent : public QObject, public SolarSystemListComponent,
+    virtual public BinaryListComponent<KSComet, CometsComponent>
 {
         Q_OBJECT
 
+        friend class BinaryListComponent<KSComet, CometsComponent>;
     public:
         /**
          * @short Default constructor.
@@ -38,6 +42,9 @@ class CometsComponent : public QObject, public SolarSystemListComponent
         virtual ~CometsComponent() override = default;
 
         bool selected() override;
+
+        /** @short Load the comets now unless they are loaded already, they are not loaded at start up */
+        void loadDataIfNeeded();
         void draw(SkyPainter *skyp) override;
         void updateDataFile(bool isAutoUpdate = false);
 
@@ -46,7 +53,7 @@ class CometsComponent : public QObject, public SolarSystemListComponent
         void downloadError(const QString &errorString);
 
     private:
-        void loadData();
+        void loadDataFromText() override;
 
         QPointer<FileDownloader> downloadJob;
 };
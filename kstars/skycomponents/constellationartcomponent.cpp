@@ -106,7 +106,8 @@ void ConstellationArtComponent::draw(SkyPainter *skyp)
 {
     Q_UNUSED(skyp)
 #ifndef KSTARS_LITE
-    if (Options::showConstellationArt() && SkyMap::IsSlewing() == false)
+    // The painters cache what they need, so the art is only hidden on slews when asked to
+    if (Options::showConstellationArt() && !(Options::hideOnSlew() && SkyMap::IsSlewing()))
     {
         for (int i = 0; i < records; i++)
             skyp->drawConstellationArtImage(m_ConstList[i]);
@@ -6,6 +6,7 @@
 
 #include "constellationboundarylines.h"
 
+#include "auxiliary/ksdatasnapshot.h"
 #include "ksfilereader.h"
 #include "kstarsdata.h"
 #include "linelist.h"
@@ -22,6 +23,9 @@
 
 #include <QHash>
 
+#include <algorithm>
+#include <cmath>
+
 ConstellationBoundaryLines::ConstellationBoundaryLines(SkyComposite *parent)
     : NoPrecessIndex(parent, i18n("Constellation Boundaries"))
 {
@@ -32,31 +36,126 @@ ConstellationBoundaryLines::ConstellationBoundaryLines(SkyComposite *parent)
         m_polyIndex.append(std::shared_ptr<PolyListList>(new PolyListList()));
     }
 
-    KStarsData *data = KStarsData::Instance();
-    int verbose      = 0; // -1 => create cbounds-$x.idx on stdout
+    int verbose = 0; // -1 => create cbounds-$x.idx on stdout
     //  0 => normal
+
+    intro();
+
+    // The parsed boundaries and their trixels are kept in a snapshot for the next start up
+    const QString idxFname = QString("cbounds-%1.idx").arg(m_skyMesh->level());
+    KSDataSnapshot snapshot(QString("cbounds-%1").arg(m_skyMesh->level()), { "cbounds.dat", idxFname },
+                            SNAPSHOT_VERSION);
+    QVector<Boundary> boundaries;
+    bool indexed = false;
+
+    if (verbose == 0 && snapshot.load())
+    {
+        const QByteArray payload = snapshot.payload();
+        QDataStream in(payload);
+        KSDataSnapshot::setupStream(in);
+        qint32 count = 0;
+        in >> count;
+        if (count > 0 && count < payload.size())
+        {
+            boundaries.resize(count);
+            for (auto &boundary : boundaries)
+                in >> boundary.name >> boundary.points >> boundary.flags >> boundary.trixels;
+        }
+        indexed = in.status() == QDataStream::Ok && in.atEnd() && !boundaries.isEmpty() &&
+                  std::all_of(boundaries.cbegin(), boundaries.cend(), [](const Boundary & boundary)
+        {
+            return boundary.flags.size() == boundary.points.size();
+        });
+        if (!indexed)
+            boundaries.clear();
+    }
+
+    if (!indexed)
+    {
+        if (!readBoundaries(boundaries, indexed, verbose))
+            return;
+
+        if (indexed && verbose == 0)
+        {
+            QByteArray payload;
+            QDataStream out(&payload, QIODevice::WriteOnly);
+            KSDataSnapshot::setupStream(out);
+            out << qint32(boundaries.size());
+            for (const auto &boundary : boundaries)
+                out << boundary.name << boundary.points << boundary.flags << boundary.trixels;
+            snapshot.save(payload);
+        }
+    }
+
+    for (const auto &boundary : boundaries)
+        appendBoundary(boundary, indexed, verbose);
+
+    indexBoundaryCells(boundaries);
+}
+
+int ConstellationBoundaryLines::cellIndex(double raHours, double decDegrees)
+{
+    raHours = std::fmod(raHours, 24.0);
+    if (raHours < 0)
+        raHours += 24.0;
+    const int column = std::min(static_cast<int>(raHours * RA_CELLS / 24.0), RA_CELLS - 1);
+    const int row = std::max(0, std::min(static_cast<int>((decDegrees + 90.0) * DEC_CELLS / 180.0), DEC_CELLS - 1));
+    return row * RA_CELLS + column;
+}
+
+void ConstellationBoundaryLines::indexBoundaryCells(const QVector<Boundary> &boundaries)
+{
+    // segments lying on a cell border also mark the cell next to it
+    constexpr double margin = 1e-7;
+
+    m_BoundaryCells.assign(RA_CELLS * DEC_CELLS, false);
+    m_CellPolys.reset(new std::atomic<PolyList *>[RA_CELLS * DEC_CELLS]);
+    for (int i = 0; i < RA_CELLS * DEC_CELLS; i++)
+        m_CellPolys[i].store(nullptr, std::memory_order_relaxed);
+
+    for (const auto &boundary : boundaries)
+    {
+        const QVector<QPointF> &points = boundary.points;
+        for (int i = 0; i < points.size(); i++)
+        {
+            // the polygons are closed, the last point connects to the first one
+            const QPointF &a = points.at(i);
+            const QPointF &b = points.at((i + 1) % points.size());
+
+            // RA of polygons wrapping around 0h may be negative, cellIndex() takes care of it
+            const int firstColumn = static_cast<int>(std::floor((std::min(a.x(), b.x()) - margin) * RA_CELLS / 24.0));
+            const int lastColumn = std::min(firstColumn + RA_CELLS - 1,
+                                            static_cast<int>(std::floor((std::max(a.x(), b.x()) + margin) * RA_CELLS / 24.0)));
+            const int firstRow = cellIndex(0, std::min(a.y(), b.y()) - margin) / RA_CELLS;
+            const int lastRow = cellIndex(0, std::max(a.y(), b.y()) + margin) / RA_CELLS;
+            for (int row = firstRow; row <= lastRow; row++)
+                for (int column = firstColumn; column <= lastColumn; column++)
+                {
+                    // the centre of the cell, to land in it after wrapping
+                    const int cell = cellIndex((column + 0.5) * 24.0 / RA_CELLS, (row + 0.5) * 180.0 / DEC_CELLS - 90.0);
+                    m_BoundaryCells[cell] = true;
+                }
+        }
+    }
+}
+
+bool ConstellationBoundaryLines::readBoundaries(QVector<Boundary> &boundaries, bool &indexed, int debug)
+{
     const char *fname = "cbounds.dat";
     int flag = 0;
     double ra, dec = 0, lastRa, lastDec;
-    std::shared_ptr<LineList> lineList;
-    std::shared_ptr<PolyList> polyList;
     bool ok = false;
 
-    intro();
-
     // Open the .idx file and skip past the first line
-    KSFileReader idxReader, *idxFile = nullptr;
-    QString idxFname = QString("cbounds-%1.idx").arg(SkyMesh::Instance()->level());
-    if (idxReader.open(idxFname))
-    {
+    KSFileReader idxReader;
+    indexed = debug != -1 && idxReader.open(QString("cbounds-%1.idx").arg(m_skyMesh->level()));
+    if (indexed)
         idxReader.readLine();
-        idxFile = &idxReader;
-    }
 
     // now open the file that contains the points
     KSFileReader fileReader;
     if (!fileReader.open(fname))
-        return;
+        return false;
 
     fileReader.setProgress(i18n("Loading Constellation Boundaries"), 13124, 10);
 
@@ -71,16 +170,19 @@ ConstellationBoundaryLines::ConstellationBoundaryLines(SkyComposite *parent)
             continue;          // ignore comments
         if (line.at(0) == ':') // :constellation line
         {
-            if (lineList.get())
-                appendLine(lineList);
-            lineList.reset();
-
-            if (polyList.get())
-                appendPoly(polyList, idxFile, verbose);
-            QString cName = line.mid(1);
-            polyList.reset(new PolyList(cName));
-            if (verbose == -1)
-                printf(":\n");
+            Boundary boundary;
+            boundary.name = line.mid(1);
+
+            // The trixels of each boundary follow a ':' line of their own
+            while (indexed && idxReader.hasMoreLines())
+            {
+                QString idxLine = idxReader.readLine();
+                if (idxLine.at(0) == ':')
+                    break;
+                boundary.trixels.append(idxLine.toInt());
+            }
+
+            boundaries.append(boundary);
             lastRa = lastDec = -1000.0;
             continue;
         }
@@ -105,38 +207,71 @@ ConstellationBoundaryLines::ConstellationBoundaryLines(SkyComposite *parent)
 
         // always add the point to the boundary (and toss dupes)
 
-        // By the time we come here, we should have polyList. Else we aren't doing good
-        Q_ASSERT(polyList); // Is this the right fix?
+        // By the time we come here, we should have a boundary. Else we aren't doing good
+        Q_ASSERT(!boundaries.isEmpty());
 
-        polyList->append(QPointF(ra, dec));
-        if (ra < 0)
-            polyList->setWrapRA(true);
+        Boundary &boundary = boundaries.last();
+        boundary.points.append(QPointF(ra, dec));
+        boundary.flags.append(char(flag ? 1 : 0));
 
         if (flag)
+        {
+            lastRa  = ra;
+            lastDec = dec;
+        }
+        else
+            lastRa = lastDec = -1000.0;
+    }
+
+    return true;
+}
+
+void ConstellationBoundaryLines::appendBoundary(const Boundary &boundary, bool indexed, int debug)
+{
+    KStarsData *data = KStarsData::Instance();
+    std::shared_ptr<LineList> lineList;
+    std::shared_ptr<PolyList> polyList(new PolyList(boundary.name));
+
+    if (debug == -1)
+        printf(":\n");
+
+    for (int i = 0; i < boundary.points.size(); i++)
+    {
+        const QPointF &node = boundary.points.at(i);
+
+        polyList->append(node);
+        if (node.x() < 0)
+            polyList->setWrapRA(true);
+
+        if (boundary.flags.at(i))
         {
             if (!lineList.get())
                 lineList.reset(new LineList());
 
-            std::shared_ptr<SkyPoint> point(new SkyPoint(ra, dec));
+            std::shared_ptr<SkyPoint> point(new SkyPoint(node.x(), node.y()));
 
             point->EquatorialToHorizontal(data->lst(), data->geo()->lat());
             lineList->append(std::move(point));
-            lastRa  = ra;
-            lastDec = dec;
         }
         else
         {
             if (lineList.get())
                 appendLine(lineList);
             lineList.reset();
-            lastRa = lastDec = -1000.0;
         }
     }
 
     if (lineList.get())
         appendLine(lineList);
-    if (polyList.get())
-        appendPoly(polyList, idxFile, verbose);
+
+    if (!indexed)
+        return appendPoly(polyList, debug);
+
+    for (Trixel trixel : boundary.trixels)
+    {
+        if (trixel >= 0 && trixel < m_polyIndex.size())
+            m_polyIndex[trixel]->append(polyList);
+    }
 }
 
 bool ConstellationBoundaryLines::selected()
@@ -154,22 +289,6 @@ void ConstellationBoundaryLines::preDraw(SkyPainter *skyp)
     skyp->setPen(QPen(QBrush(color), 1, Qt::SolidLine));
 }
 
-void ConstellationBoundaryLines::appendPoly(std::shared_ptr<PolyList> &polyList, KSFileReader *file, int debug)
-{
-    if (!file || debug == -1)
-        return appendPoly(polyList, debug);
-
-    while (file->hasMoreLines())
-    {
-        QString line = file->readLine();
-        if (line.at(0) == ':')
-            return;
-        Trixel trixel = line.toInt();
-
-        m_polyIndex[trixel]->append(polyList);
-    }
-}
-
 void ConstellationBoundaryLines::appendPoly(const std::shared_ptr<PolyList> &polyList, int debug)
 {
     if (debug >= 0 && debug < m_skyMesh->debug())
@@ -193,6 +312,25 @@ void ConstellationBoundaryLines::appendPoly(const std::shared_ptr<PolyList> &pol
 }
 
 PolyList *ConstellationBoundaryLines::ContainingPoly(const SkyPoint *p) const
+{
+    if (!m_CellPolys)
+        return searchPoly(p);
+
+    const int cell = cellIndex(p->ra().Hours(), p->dec().Degrees());
+    if (m_BoundaryCells[cell])
+        return searchPoly(p);
+
+    PolyList *polyList = m_CellPolys[cell].load(std::memory_order_relaxed);
+    if (polyList == nullptr)
+    {
+        // no boundary crosses the cell, whatever point of it is searched gives the same polygon
+        polyList = searchPoly(p);
+        m_CellPolys[cell].store(polyList, std::memory_order_relaxed);
+    }
+    return polyList;
+}
+
+PolyList *ConstellationBoundaryLines::searchPoly(const SkyPoint *p) const
 {
     //printf("called ContainingPoly(p)\n");
 
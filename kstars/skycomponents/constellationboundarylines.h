@@ -8,12 +8,17 @@
 
 #include "noprecessindex.h"
 
+#include <QByteArray>
 #include <QHash>
 #include <QPolygonF>
+#include <QVector>
+
+#include <atomic>
+#include <memory>
+#include <vector>
 
 class PolyList;
 class ConstellationBoundary;
-class KSFileReader;
 
 typedef QVector<std::shared_ptr<PolyList>> PolyListList;
 typedef QVector<std::shared_ptr<PolyListList>> PolyIndex;
@@ -48,18 +53,55 @@ class ConstellationBoundaryLines : public NoPrecessIndex
     void preDraw(SkyPainter *skyp) override;
 
   private:
-    void appendPoly(const std::shared_ptr<PolyList> &polyList, int debug = 0);
+    /** @short The boundary of one constellation as read from cbounds.dat and its index */
+    struct Boundary
+    {
+        QString name;
+        QVector<QPointF> points;
+        // Whether the segment ending at each point is drawn
+        QByteArray flags;
+        // Trixels read from cbounds-N.idx
+        QVector<qint32> trixels;
+    };
 
     /**
-     * @short reads the indices from the KSFileReader instead of using
-     * the SkyMesh to create them.  If the file pointer is null or if
-     * debug == -1 then we fall back to using the index.
+     * @short reads the boundaries from cbounds.dat and, unless debug == -1,
+     * their trixels from cbounds-N.idx.
+     * @p indexed is set if the trixels were read, if not they are left to the SkyMesh.
+     * @return false if cbounds.dat could not be read
      */
-    void appendPoly(std::shared_ptr<PolyList> &polyList, KSFileReader *file, int debug);
+    bool readBoundaries(QVector<Boundary> &boundaries, bool &indexed, int debug);
+
+    /** @short adds the lines and the indexed polygon of @p boundary */
+    void appendBoundary(const Boundary &boundary, bool indexed, int debug);
+
+    void appendPoly(const std::shared_ptr<PolyList> &polyList, int debug = 0);
 
     PolyList *ContainingPoly(const SkyPoint *p) const;
 
+    /** @short finds the polygon containing @p p among the polygons of its trixels */
+    PolyList *searchPoly(const SkyPoint *p) const;
+
+    /**
+     * @short marks the cells of the RA/Dec grid that a segment of the boundaries crosses.
+     * All points of any other cell lie in the same constellation, which is looked up once and
+     * kept for the cell, so most lookups skip the polygons.
+     */
+    void indexBoundaryCells(const QVector<Boundary> &boundaries);
+
+    static int cellIndex(double raHours, double decDegrees);
+
+    // RA/Dec grid of 4 minutes by 1 degree
+    static constexpr int RA_CELLS = 360;
+    static constexpr int DEC_CELLS = 180;
+    std::vector<bool> m_BoundaryCells;
+    // constellation of each cell no boundary crosses, filled when it is first looked up
+    std::unique_ptr<std::atomic<PolyList *>[]> m_CellPolys;
+
     SkyMesh *m_skyMesh { nullptr };
     PolyIndex m_polyIndex;
     int m_polyIndexCnt { 0 };
+
+    // Raise whenever the layout of the snapshot of the boundaries changes
+    static const quint32 SNAPSHOT_VERSION = 1;
 };
@@ -8,9 +8,11 @@
 
 #include "byteorder.h"
 #include "kstarsdata.h"
+#include "ksutils.h"
 #include "Options.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
+#include "skymapcomposite.h"
 #endif
 #include "skymesh.h"
 #include "skypainter.h"
@@ -29,6 +31,15 @@
 #include <windows.h>
 #endif
 
+namespace
+{
+// How far ahead prefetchAhead() looks, and the longest gap between draws still taken as one pan
+constexpr double PREFETCH_LOOKAHEAD_MS = 500.0;
+constexpr qint64 PREFETCH_MAX_INTERVAL_MS = 1000;
+// Reading one byte of each page is enough for the OS to load it from the file
+constexpr quint64 PREFETCH_PAGE_SIZE = 4096;
+}
+
 DeepStarComponent::DeepStarComponent(SkyComposite *parent, QString fileName, float trigMag, bool staticstars)
     : ListComponent(parent), m_reindexNum(J2000), triggerMag(trigMag), m_FaintMagnitude(-5.0), staticStars(staticstars),
       dataFileName(fileName)
@@ -42,6 +53,8 @@ DeepStarComponent::DeepStarComponent(SkyComposite *parent, QString fileName, flo
 
 DeepStarComponent::~DeepStarComponent()
 {
+    // The page-in reads the mapping, which closeFile() removes
+    m_Prefetch.waitForFinished();
     if (fileOpened)
         starReader.closeFile();
     fileOpened = false;
@@ -246,8 +259,6 @@ void DeepStarComponent::draw(SkyPainter *skyp)
     StarObject::starsUpdated        = 0;
 #endif
     SkyMap *map       = SkyMap::Instance();
-    KStarsData *data  = KStarsData::Instance();
-    UpdateID updateID = data->updateID();
 
     //FIXME_FOV -- maybe not clamp like that...
     float radius = map->projector()->fov();
@@ -287,6 +298,8 @@ void DeepStarComponent::draw(SkyPainter *skyp)
     // If we are to hide the fainter stars (eg: while slewing), we set the magnitude limit to hideStarsMag.
     if (hideFaintStars && maglim > hideStarsMag)
         maglim = hideStarsMag;
+    // Frames too slow for the map to move smoothly draw fewer stars
+    maglim -= KStarsData::Instance()->skyComposite()->renderQuality().starMagnitudeReduction();
 
     StarBlockFactory *m_StarBlockFactory = StarBlockFactory::Instance();
     //    m_StarBlockFactory->drawID = m_skyMesh->drawID();
@@ -308,18 +321,11 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         while (region.hasNext())
         {
             Trixel currentRegion = region.next();
-            for (int i = 0; i < m_starBlockList.at(currentRegion)->getBlockCount(); ++i)
+            // Only stamps the blocks, so this doesn't copy the shared pointers
+            for (const auto &block : m_starBlockList.at(currentRegion)->contents())
             {
-                std::shared_ptr<StarBlock> prevBlock = ((i >= 1) ? m_starBlockList.at(currentRegion)->block(
-                        i - 1) : std::shared_ptr<StarBlock>());
-                std::shared_ptr<StarBlock> block     = m_starBlockList.at(currentRegion)->block(i);
-
-                if (i == 0 && !m_StarBlockFactory->markFirst(block))
-                    qCWarning(KSTARS) << "markFirst failed in trixel" << currentRegion;
-                if (i > 0 && !m_StarBlockFactory->markNext(prevBlock, block))
-                    qCWarning(KSTARS) << "markNext failed in trixel" << currentRegion << "while marking block" << i;
-                if (i < m_starBlockList.at(currentRegion)->getBlockCount() &&
-                        m_starBlockList.at(currentRegion)->block(i)->getFaintMag() < maglim)
+                m_StarBlockFactory->markUsed(block.get());
+                if (block->getFaintMag() >= maglim)
                     break;
             }
         }
@@ -327,6 +333,7 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         region.reset();
     }
 
+    QVector<SkyPainter::StarDrawList> drawLists;
     while (region.hasNext())
     {
         ++nTrixels;
@@ -357,25 +364,11 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         //        qDebug() << Q_FUNC_INFO << "Drawing SBL for trixel " << currentRegion << ", SBL has "
         //                 <<  m_starBlockList[ currentRegion ]->getBlockCount() << " blocks";
 
-        // REMARK: The following should never carry state, except for const parameters like updateID and maglim
-        std::function<void(std::shared_ptr<StarBlock>)> mapFunction = [&updateID, &maglim](std::shared_ptr<StarBlock> myBlock)
-        {
-            for (StarObject &star : myBlock->contents())
-            {
-                if (star.updateID != updateID)
-                    star.JITupdate();
-                if (star.mag() > maglim)
-                    break;
-            }
-        };
-
-        QtConcurrent::blockingMap(m_starBlockList.at(currentRegion)->contents(), mapFunction);
-
+        // Blocks used in this draw are not recycled by later calls to fillToMag(), see StarBlockFactory::getBlock()
         for (int i = 0; i < m_starBlockList.at(currentRegion)->getBlockCount(); ++i)
         {
             std::shared_ptr<StarBlock> block = m_starBlockList.at(currentRegion)->block(i);
-            //            qDebug() << Q_FUNC_INFO << "---> Drawing stars from block " << i << " of trixel " <<
-            //                currentRegion << ". SB has " << block->getStarCount() << " stars";
+            SkyPainter::StarDrawList list;
             for (int j = 0; j < block->getStarCount(); j++)
             {
                 StarObject *curStar = block->star(j);
@@ -383,20 +376,37 @@ void DeepStarComponent::draw(SkyPainter *skyp)
                 //                qDebug() << Q_FUNC_INFO << "We claim that he's from trixel " << currentRegion
                 //<< ", and indexStar says he's from " << m_skyMesh->indexStar( curStar );
 
-                float mag = curStar->mag();
-
-                if (mag > maglim)
+                if (curStar->mag() > maglim)
                     break;
-
-                if (skyp->drawPointSource(curStar, mag, curStar->spchar()))
-                    visibleStarCount++;
+                list.stars.append(curStar);
             }
+            if (!list.stars.isEmpty())
+                drawLists.append(list);
         }
 
         // DEBUG: Uncomment to identify problems with Star Block Factory / preservation of Magnitude Order in the LRU Cache
         //        verifySBLIntegrity();
-        t_drawUnnamed += t.restart();
     }
+
+    // Update and project the stars of all the blocks on the thread pool, then draw them here
+    // REMARK: The following should never carry state
+    std::function<void(SkyPainter::StarDrawList &)> prepare = [skyp](SkyPainter::StarDrawList & list)
+    {
+        StarObject::JITupdate(list.stars.constData(), list.stars.size());
+        skyp->prepareStars(&list);
+    };
+    {
+        DrawTimings::Scope scope(KStarsData::Instance()->skyComposite()->drawTimings(), "Stars", DrawTimings::PROJECT);
+        QtConcurrent::blockingMap(drawLists, prepare);
+    }
+
+    for (auto &list : drawLists)
+        visibleStarCount += skyp->drawStars(&list);
+    t_drawUnnamed += t.restart();
+
+    if (!staticStars)
+        prefetchAhead(focus, radius, maglim);
+
     m_skyMesh->inDraw(false);
 #ifdef PROFILE_SINCOS
     trig_calls_here += dms::trig_function_calls;
@@ -422,6 +432,66 @@ void DeepStarComponent::draw(SkyPainter *skyp)
 #endif
 }
 
+void DeepStarComponent::prefetchAhead(const SkyPoint *focus, double radius, float maglim)
+{
+    if (!starReader.isMapped())
+        return;
+
+    const qint64 elapsed = m_PrefetchTimer.isValid() ? m_PrefetchTimer.restart() : 0;
+    if (!m_PrefetchTimer.isValid())
+        m_PrefetchTimer.start();
+
+    const double dRA  = KSUtils::reduceAngle(focus->ra().Degrees() - m_PrefetchFocus.ra().Degrees(), -180.0, 180.0);
+    const double dDec = focus->dec().Degrees() - m_PrefetchFocus.dec().Degrees();
+    m_PrefetchFocus.set(focus->ra(), focus->dec());
+
+    // Not panning, or still paging in what the previous draw asked for
+    if (elapsed <= 0 || elapsed > PREFETCH_MAX_INTERVAL_MS || !m_Prefetch.isFinished())
+        return;
+
+    // Ignore moves so small that the aperture just drawn already covers where they lead
+    const double scale = PREFETCH_LOOKAHEAD_MS / elapsed;
+    const double dx    = dRA * cos(focus->dec().radians()) * scale;
+    const double dy    = dDec * scale;
+    if (dx * dx + dy * dy < 0.01 * radius * radius)
+        return;
+
+    // SkyMesh::aperture() would start another draw as far as the StarBlockFactory is concerned, so
+    // convert to catalog coordinates here and index the region without touching the draw ID
+    SkyPoint ahead(dms(focus->ra().Degrees() + dRA * scale), dms(qBound(-90.0, focus->dec().Degrees() + dy, 90.0)));
+    ahead.catalogueCoord(KStarsData::Instance()->updateNum()->julianDay());
+    m_skyMesh->index(&ahead, radius + 1.0, PREFETCH_BUF);
+
+    QVector<QPair<quint64, quint64>> ranges;
+    MeshIterator region(m_skyMesh, PREFETCH_BUF);
+    while (region.hasNext())
+    {
+        Trixel currentRegion = region.next();
+        quint64 offset = 0, size = 0;
+        if (currentRegion < m_starBlockList.size() &&
+                m_starBlockList.at(currentRegion)->pendingRange(maglim, &offset, &size))
+            ranges.append(qMakePair(offset, size));
+    }
+    if (ranges.isEmpty())
+        return;
+
+    // Only reads the mapping, so it doesn't race with fillToMag() or the StarBlockFactory
+    const BinFileHelper *reader = &starReader;
+    m_Prefetch = QtConcurrent::run([reader, ranges]()
+    {
+        volatile uchar sink = 0;
+        for (const auto &range : ranges)
+        {
+            const uchar *data = reader->mappedRecord(range.first, static_cast<int>(range.second));
+            if (!data)
+                continue;
+            for (quint64 i = 0; i < range.second; i += PREFETCH_PAGE_SIZE)
+                sink = sink + data[i];
+            sink = sink + data[range.second - 1];
+        }
+    });
+}
+
 bool DeepStarComponent::openDataFile()
 {
     if (starReader.getFileHandle())
@@ -462,6 +532,9 @@ bool DeepStarComponent::openDataFile()
         if (starReader.getByteSwap())
             MSpT = bswap_16(MSpT);
         fileOpened = true;
+        // Stars are then loaded from memory, falling back on reading the file if it can't be mapped
+        if (!starReader.mapFile())
+            qCInfo(KSTARS) << "  Could not map " << dataFileName << ", reading it instead";
         qCInfo(KSTARS) << "  Sky Mesh Size: " << m_skyMesh->size();
         for (long int i = 0; i < m_skyMesh->size(); i++)
         {
@@ -640,13 +713,11 @@ bool DeepStarComponent::verifySBLIntegrity()
                                   << ", brightMag of block #" << i << " = " << block->getBrightMag();
                 integrity = false;
             }
-            if (i > 1 && (!block->prev))
-                qCWarning(KSTARS) << "Trixel " << trixel << ": ERROR: Block" << i << "is unlinked in LRU Cache";
-            if (block->prev && block->prev->parent == m_starBlockList[trixel].get() &&
-                    block->prev != m_starBlockList[trixel]->block(i - 1))
+            // getBlock() can only recycle the last block of a list, so the marked blocks must come first
+            if (i > 0 && block->drawID > m_starBlockList[trixel]->block(i - 1)->drawID)
             {
-                qCWarning(KSTARS) << "Trixel " << trixel
-                                  << ": ERROR: SBF LRU Cache linked list seems to be broken at before block " << i;
+                qCWarning(KSTARS) << "Trixel " << trixel << ": ERROR: Block" << i
+                                  << "was drawn more recently than the block before it";
                 integrity = false;
             }
             faintMag = block->getFaintMag();
@@ -20,8 +20,12 @@
 #include "listcomponent.h"
 #include "starblockfactory.h"
 #include "skyobjects/deepstardata.h"
+#include "skyobjects/skypoint.h"
 #include "skyobjects/stardata.h"
 
+#include <QElapsedTimer>
+#include <QFuture>
+
 class SkyLabeler;
 class SkyMesh;
 class StarBlockFactory;
@@ -102,6 +106,13 @@ class DeepStarComponent : public ListComponent
     static StarBlockFactory m_StarBlockFactory;
 
   private:
+    /**
+     * @short Page in, on the thread pool, the catalog file ranges of the trixels around the
+     * point the focus will reach shortly if the map keeps panning as it did since the last draw.
+     * fillToMag() then finds them in memory instead of waiting on the disk.
+     */
+    void prefetchAhead(const SkyPoint *focus, double radius, float maglim);
+
     SkyMesh *m_skyMesh { nullptr };
     KSNumbers m_reindexNum;
 
@@ -124,6 +135,11 @@ class DeepStarComponent : public ListComponent
     QVector<std::shared_ptr<StarBlockList>> m_starBlockList;
     QHash<int, StarObject *> m_CatalogNumber;
 
+    // Focus and time of the previous draw, and the page-in started from them
+    SkyPoint m_PrefetchFocus;
+    QElapsedTimer m_PrefetchTimer;
+    QFuture<void> m_Prefetch;
+
     bool staticStars { false };
 
     // Stuff required for reading data
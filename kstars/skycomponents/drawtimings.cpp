@@ -0,0 +1,87 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "drawtimings.h"
+
+void DrawTimings::beginFrame()
+{
+    for (auto &entry : m_Entries)
+    {
+        if (entry.phase != UPDATE)
+            entry.last = 0;
+    }
+    m_FrameTimer.start();
+}
+
+void DrawTimings::endFrame()
+{
+    if (!m_FrameTimer.isValid())
+        return;
+
+    const bool first = m_FrameAverage == 0;
+    m_Frame = m_FrameTimer.nsecsElapsed() / 1e6;
+    m_FrameAverage = first ? m_Frame : m_FrameAverage + SMOOTHING * (m_Frame - m_FrameAverage);
+    m_FrameTimer.invalidate();
+
+    for (auto &entry : m_Entries)
+    {
+        if (entry.phase != UPDATE)
+            entry.average += SMOOTHING * (entry.last - entry.average);
+    }
+}
+
+void DrawTimings::add(const QString &name, Phase phase, qint64 nsecs)
+{
+    const QPair<QString, int> key(name, phase);
+    auto index = m_Index.constFind(key);
+    if (index == m_Index.constEnd())
+    {
+        // A new entry starts its average from its first time
+        index = m_Index.insert(key, m_Entries.size());
+        Entry entry;
+        entry.name = name;
+        entry.phase = phase;
+        entry.average = nsecs / 1e6;
+        m_Entries.append(entry);
+    }
+
+    Entry &entry = m_Entries[index.value()];
+    if (phase == UPDATE)
+    {
+        entry.last = nsecs / 1e6;
+        entry.average += SMOOTHING * (entry.last - entry.average);
+    }
+    else
+        entry.last += nsecs / 1e6;
+}
+
+QStringList DrawTimings::report() const
+{
+    QStringList lines;
+    lines << QString("Frame\t\t%1\t%2").arg(m_Frame, 0, 'f', 2).arg(m_FrameAverage, 0, 'f', 2);
+    for (const auto &entry : m_Entries)
+        lines << QString("%1\t%2\t%3\t%4").arg(entry.name, phaseName(entry.phase)).arg(entry.last, 0, 'f', 2)
+              .arg(entry.average, 0, 'f', 2);
+    return lines;
+}
+
+QString DrawTimings::phaseName(Phase phase)
+{
+    switch (phase)
+    {
+        case UPDATE:
+            return "update";
+        case CULL:
+            return "cull";
+        case PROJECT:
+            return "project";
+        case DRAW:
+            return "draw";
+        case LABEL:
+            return "label";
+    }
+    return QString();
+}
@@ -0,0 +1,118 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @class DrawTimings
+ * @short Time spent on each part of a sky map frame.
+ *
+ * SkyMapComposite times the updates of its components, the culling of the sky mesh, the drawing
+ * of each component and the labels. Components may also time parts of their own work, such as
+ * the stars do for updating and projecting their blocks. Each entry keeps its time in the last
+ * frame and a running average. The sky map shows them when ShowDrawTimings is set, and they are
+ * available over D-Bus, to tune which layers a machine can afford.
+ */
+class DrawTimings
+{
+    public:
+        enum Phase
+        {
+            UPDATE,
+            CULL,
+            PROJECT,
+            DRAW,
+            LABEL
+        };
+
+        struct Entry
+        {
+            QString name;
+            Phase phase;
+            /** Milliseconds in the last frame, or in the last update */
+            double last { 0 };
+            double average { 0 };
+        };
+
+        /** @short Times the scope it lives in, and adds it to the entry of @p name */
+        class Scope
+        {
+            public:
+                Scope(DrawTimings &timings, const QString &name, Phase phase)
+                    : m_Timings(timings), m_Name(name), m_Phase(phase)
+                {
+                    m_Timer.start();
+                }
+                ~Scope()
+                {
+                    m_Timings.add(m_Name, m_Phase, m_Timer.nsecsElapsed());
+                }
+
+            private:
+                DrawTimings &m_Timings;
+                QString m_Name;
+                Phase m_Phase;
+                QElapsedTimer m_Timer;
+        };
+
+        /** @short Run @p f, timing it as the entry of @p name */
+        template <typename F>
+        void time(const QString &name, Phase phase, F &&f)
+        {
+            Scope scope(*this, name, phase);
+            f();
+        }
+
+        /** @short Start a frame. What is not timed in it counts as zero. */
+        void beginFrame();
+
+        /** @short End the frame, and fold its times into the averages */
+        void endFrame();
+
+        /**
+         * @brief add Add @p nsecs to the entry of @p name in this frame. Updates do not happen
+         * every frame, so their entries are replaced instead.
+         */
+        void add(const QString &name, Phase phase, qint64 nsecs);
+
+        const QVector<Entry> &entries() const
+        {
+            return m_Entries;
+        }
+
+        /** @return milliseconds the last frame took */
+        double frame() const
+        {
+            return m_Frame;
+        }
+
+        double frameAverage() const
+        {
+            return m_FrameAverage;
+        }
+
+        /** @return one line per entry, the frame first, with the name, phase, last and average milliseconds */
+        QStringList report() const;
+
+        static QString phaseName(Phase phase);
+
+    private:
+        // Weight of the last frame in the running averages
+        static constexpr double SMOOTHING = 0.1;
+
+        QVector<Entry> m_Entries;
+        QHash<QPair<QString, int>, int> m_Index;
+        QElapsedTimer m_FrameTimer;
+        double m_Frame { 0 };
+        double m_FrameAverage { 0 };
+};
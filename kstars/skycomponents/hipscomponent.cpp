@@ -11,6 +11,8 @@
 #include "hipscomponent.h"
 
 #include "Options.h"
+#include "kstarsdata.h"
+#include "skymapcomposite.h"
 #include "skypainter.h"
 #include "skymap.h"
 
@@ -32,6 +34,10 @@ void HIPSComponent::draw(SkyPainter *skyp)
     if ( (SkyMap::IsSlewing() && !Options::hIPSPanning()) || !selected())
         return;
 
+    // Not while frames are too slow for the map to move smoothly
+    if (!KStarsData::Instance()->skyComposite()->renderQuality().surveys())
+        return;
+
     // If we are tracking and we currently have a focus object or point
     // Then no need for re-render every update cycle since that is CPU intensive
     // Draw the cached HiPS image for 5000ms. When this expires, render the image again and
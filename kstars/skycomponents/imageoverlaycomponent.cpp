@@ -14,6 +14,7 @@
 #include "fitsviewer/fitsdata.h"
 #endif
 #include "auxiliary/kspaths.h"
+#include "auxiliary/ksutils.h"
 #include "ekos/auxiliary/solverutils.h"
 #include "ekos/auxiliary/stellarsolverprofile.h"
 
@@ -23,6 +24,9 @@
 #include <QComboBox>
 #include <QtConcurrent>
 #include <QRegularExpression>
+#include <QThread>
+
+#include <algorithm>
 
 namespace
 {
@@ -124,6 +128,58 @@ QString toDecString(double dec)
 {
     return toDecString(dms(dec));
 }
+
+// Reads the position and scale a FITS file was captured with, using the keywords and
+// conversions of FITSData::parseSolution(). Other images carry no such hints.
+void readHeaderHints(const QString &filename, double &ra, double &dec, bool &positionOK, double &scale, bool &scaleOK)
+{
+    positionOK = scaleOK = false;
+#ifdef HAVE_CFITSIO
+    fitsfile *fptr = nullptr;
+    int status = 0;
+    if (fits_open_diskfile(&fptr, filename.toLocal8Bit(), READONLY, &status))
+        return;
+
+    auto readDouble = [fptr](const char *key, double &value)
+    {
+        int keyStatus = 0;
+        return fits_read_key(fptr, TDOUBLE, key, &value, nullptr, &keyStatus) == 0;
+    };
+    auto readAngle = [fptr](const char *key, bool hours, double &value)
+    {
+        char text[FLEN_VALUE] = {0};
+        int keyStatus = 0;
+        if (fits_read_key(fptr, TSTRING, key, text, nullptr, &keyStatus) != 0)
+            return false;
+        dms angle;
+        if (!angle.setFromString(QString(text).trimmed(), !hours))
+            return false;
+        value = angle.Degrees();
+        return true;
+    };
+
+    positionOK = (readAngle("OBJCTRA", true, ra) || readDouble("RA", ra)) &&
+                 (readAngle("OBJCTDEC", false, dec) || readDouble("DEC", dec));
+
+    double focalLength = 0, pixelSize = 0, binning = 1;
+    if (readDouble("SCALE", scale) && scale > 0)
+        scaleOK = true;
+    else if (readDouble("FOCALLEN", focalLength) && readDouble("PIXSIZE1", pixelSize) && focalLength > 0 && pixelSize > 0)
+    {
+        if (!readDouble("XBINNING", binning) || binning <= 0)
+            binning = 1;
+        scale = (206264.8062470963552 * (pixelSize / 1000.0)) / (focalLength * binning);
+        scaleOK = true;
+    }
+
+    fits_close_file(fptr, &status);
+#else
+    Q_UNUSED(filename);
+    Q_UNUSED(ra);
+    Q_UNUSED(dec);
+    Q_UNUSED(scale);
+#endif
+}
 }  // namespace
 
 ImageOverlayComponent::ImageOverlayComponent(SkyComposite *parent) : SkyComponent(parent)
@@ -283,14 +339,16 @@ void ImageOverlayComponent::statusCellChanged(int row)
             const QComboBox *ewItem = dynamic_cast<QComboBox*>(m_ImageOverlayTable->cellWidget(row, EAST_TO_RIGHT_COL));
             m_Overlays[row].m_EastToTheRight = ewItem->currentIndex();
 
-            if (m_Overlays[row].m_Img.get() == nullptr)
+            if (m_Overlays[row].m_Pyramid.get() == nullptr)
             {
                 // Load the image.
                 const QString fullFilename = QString("%1/%2").arg(m_Directory).arg(m_Overlays[row].m_Filename);
-                QImage *img = loadImageFile(fullFilename, !m_Overlays[row].m_EastToTheRight);
-                m_Overlays[row].m_Width = img->width();
-                m_Overlays[row].m_Height = img->height();
-                m_Overlays[row].m_Img.reset(img);
+                m_Overlays[row].m_Pyramid = loadImageFile(fullFilename, !m_Overlays[row].m_EastToTheRight);
+                if (m_Overlays[row].m_Pyramid)
+                {
+                    m_Overlays[row].m_Width = m_Overlays[row].m_Pyramid->size().width();
+                    m_Overlays[row].m_Height = m_Overlays[row].m_Pyramid->size().height();
+                }
             }
             saveToUserDB();
             QString msg = i18n("Stored OK status for %1.", m_Overlays[row].m_Filename);
@@ -453,10 +511,11 @@ void ImageOverlayComponent::loadAllImageFiles()
 void ImageOverlayComponent::loadImageFileLoop()
 {
     emit updateLog(i18n("Loading image files..."));
-    while (loadImageFile());
+    // A single pass, images that cannot be read stay without a pyramid
+    loadImageFile();
     int num = 0;
     for (const auto &o : m_Overlays)
-        if (o.m_Img.get() != nullptr)
+        if (o.m_Pyramid.get() != nullptr)
             num++;
     emit updateLog(i18n("%1 image files loaded.", num));
     // Restore editing for the table.
@@ -464,18 +523,10 @@ void ImageOverlayComponent::loadImageFileLoop()
     m_Initialized = true;
 }
 
-QImage *ImageOverlayComponent::loadImageFile (const QString &fullFilename, bool mirror)
+QSharedPointer<ImageOverlayPyramid> ImageOverlayComponent::loadImageFile (const QString &fullFilename, bool mirror)
 {
-    QSharedPointer<QImage> tempImage(new QImage(fullFilename));
-    if (tempImage.get() == nullptr) return nullptr;
-    int scaleWidth = std::min(tempImage->width(), Options::imageOverlayMaxDimension());
-    QImage *processedImg = new QImage;
-    if (mirror)
-        *processedImg = tempImage->mirrored(true, false).scaledToWidth(scaleWidth); // It's reflected horizontally.
-    else
-        *processedImg = tempImage->scaledToWidth(scaleWidth);
-
-    return processedImg;
+    // The first load of an image tiles it into the cache, later ones just read a thumbnail
+    return ImageOverlayPyramid::open(fullFilename, mirror, Options::imageOverlayMaxDimension());
 }
 
 bool ImageOverlayComponent::loadImageFile()
@@ -484,11 +535,10 @@ bool ImageOverlayComponent::loadImageFile()
 
     for (auto &o : m_Overlays)
     {
-        if (o.m_Status == o.ImageOverlay::AVAILABLE && o.m_Img.get() == nullptr)
+        if (o.m_Status == o.ImageOverlay::AVAILABLE && o.m_Pyramid.get() == nullptr)
         {
             QString fullFilename = QString("%1%2%3").arg(m_Directory).arg(QDir::separator()).arg(o.m_Filename);
-            QImage *img = loadImageFile(fullFilename, !o.m_EastToTheRight);
-            o.m_Img.reset(img);
+            o.m_Pyramid = loadImageFile(fullFilename, !o.m_EastToTheRight);
             updatedSomething = true;
 
             // Note: The original width and height in o.m_Width/m_Height is kept even
@@ -584,39 +634,63 @@ void ImageOverlayComponent::saveToUserDB()
         KStarsData::Instance()->userdb()->AddImageOverlay(metadata);
 }
 
-void ImageOverlayComponent::solveImage(const QString &filename)
+void ImageOverlayComponent::solveImage(int row, const QString &filename, bool singleThreaded)
 {
-    if (!m_Initialized) return;
-    m_SolveButton->setText(i18n("Abort"));
     const int solverTimeout = Options::imageOverlayTimeout();
     auto profiles = Ekos::getDefaultAlignOptionsProfiles();
     auto parameters = profiles.at(m_SolverProfile->currentIndex());
     // Double search radius
     parameters.search_radius = parameters.search_radius * 2;
+    // Several images are solved at once, one thread each
+    if (singleThreaded)
+        parameters.multiAlgorithm = SSolver::NOT_MULTI;
+
+    QSharedPointer<SolverUtils> solver(new SolverUtils(parameters, solverTimeout),  &QObject::deleteLater);
+    m_Solvers[row] = solver;
+    connect(solver.get(), &SolverUtils::done, this, [this, row](bool timedOut, bool success,
+            const FITSImage::Solution & solution, double elapsedSeconds)
+    {
+        solverDone(row, timedOut, success, solution, elapsedSeconds);
+    });
 
-    m_Solver.reset(new SolverUtils(parameters, solverTimeout),  &QObject::deleteLater);
-    connect(m_Solver.get(), &SolverUtils::done, this, &ImageOverlayComponent::solverDone, Qt::UniqueConnection);
-
-    if (m_RowsToSolve.size() > 1)
+    if (m_RowsToSolve.size() > 0)
         emit updateLog(i18n("Solving: %1. %2 in queue.", filename, m_RowsToSolve.size()));
     else
         emit updateLog(i18n("Solving: %1.", filename));
 
     // If the user added some RA/DEC/Scale values to the table, they will be used in the solve
     // (but aren't remembered in the DB unless the solve is successful).
-    int row = m_RowsToSolve[0];
     QString raString = m_ImageOverlayTable->item(row, RA_COL)->text().toLatin1().data();
     QString decString = m_ImageOverlayTable->item(row, DEC_COL)->text().toLatin1().data();
     QString scaleString = m_ImageOverlayTable->item(row, ARCSEC_PER_PIXEL_COL)->text().toLatin1().data();
 
     dms raDMS, decDMS;
     const bool useHMS = isHMS(raString);
-    const bool raOK = raDMS.setFromString(raString, !useHMS) && (raDMS.Degrees() != 0.00);
-    const bool decOK = decDMS.setFromString(decString) && (decDMS.Degrees() != 0.00);
+    bool raOK = raDMS.setFromString(raString, !useHMS) && (raDMS.Degrees() != 0.00);
+    bool decOK = decDMS.setFromString(decString) && (decDMS.Degrees() != 0.00);
     bool scaleOK = false;
     double scale = scaleString.toDouble(&scaleOK);
     scaleOK = scaleOK && scale != 0.00;
 
+    // Otherwise FITS files may carry hints from their capture.
+    if (!(raOK && decOK) || !scaleOK)
+    {
+        double headerRA = 0, headerDEC = 0, headerScale = 0;
+        bool positionFound = false, scaleFound = false;
+        readHeaderHints(filename, headerRA, headerDEC, positionFound, headerScale, scaleFound);
+        if (!(raOK && decOK) && positionFound)
+        {
+            raDMS.setD(headerRA);
+            decDMS.setD(headerDEC);
+            raOK = decOK = true;
+        }
+        if (!scaleOK && scaleFound)
+        {
+            scale = headerScale;
+            scaleOK = true;
+        }
+    }
+
     // Use the default scale if it is > 0 and scale was not specified in the UI table.
     if (!scaleOK && Options::imageOverlayDefaultScale() > 0.0001)
     {
@@ -628,12 +702,22 @@ void ImageOverlayComponent::solveImage(const QString &filename)
     {
         auto lowScale = scale * 0.75;
         auto highScale = scale * 1.25;
-        m_Solver->useScale(true, lowScale, highScale);
+        solver->useScale(true, lowScale, highScale);
     }
     if (raOK && decOK)
-        m_Solver->usePosition(true, raDMS.Degrees(), decDMS.Degrees());
+        solver->usePosition(true, raDMS.Degrees(), decDMS.Degrees());
 
-    m_Solver->runSolver(filename);
+    solver->runSolver(filename);
+}
+
+int ImageOverlayComponent::maxSolvers() const
+{
+    // Each solver takes a core and holds its image and the index files it searches,
+    // so a core and some memory are left for the rest of KStars.
+    const int cores = std::max(1, QThread::idealThreadCount() - 1);
+    const double availableRAM = KSUtils::getAvailableRAM();
+    const int byMemory = availableRAM > 0 ? static_cast<int>(availableRAM / SOLVER_MEMORY) : 1;
+    return std::max(1, std::min({cores, byMemory, MAX_SOLVERS}));
 }
 
 void ImageOverlayComponent::tryAgain()
@@ -668,7 +752,7 @@ void ImageOverlayComponent::show()
                 emit updateLog(i18n("Can't show %1. Not plate solved.", m_Overlays[row].m_Filename));
                 return;
             }
-            if (m_Overlays[row].m_Img.get() == nullptr)
+            if (m_Overlays[row].m_Pyramid.get() == nullptr)
             {
                 emit updateLog(i18n("Can't show %1. Image not loaded.", m_Overlays[row].m_Filename));
                 return;
@@ -701,8 +785,14 @@ void ImageOverlayComponent::abortSolving()
 {
     if (!m_Initialized) return;
     m_RowsToSolve.clear();
-    if (m_Solver)
-        m_Solver->abort();
+    // Aborted solvers still report back, and are kept until they stop
+    for (auto &solver : m_Solvers)
+    {
+        disconnect(solver.get(), &SolverUtils::done, this, nullptr);
+        solver->abort();
+        m_AbortedSolvers.append(solver);
+    }
+    m_Solvers.clear();
     emit updateLog(i18n("Solving aborted."));
     m_SolveButton->setText(i18n("Solve"));
 }
@@ -715,9 +805,13 @@ void ImageOverlayComponent::startSolving()
         abortSolving();
         return;
     }
-    if (m_Solver && m_Solver->isRunning())
+    m_AbortedSolvers.erase(std::remove_if(m_AbortedSolvers.begin(), m_AbortedSolvers.end(),
+                                          [](const QSharedPointer<SolverUtils> &solver)
+    {
+        return !solver->isRunning();
+    }), m_AbortedSolvers.end());
+    if (!m_AbortedSolvers.isEmpty())
     {
-        m_Solver->abort();
         if (m_RowsToSolve.size() > 0)
             m_TryAgainTimer.start(2000);
         return;
@@ -747,28 +841,37 @@ void ImageOverlayComponent::startSolving()
         m_RowsToSolve.clear();
         for (int row : selectedRows)
             m_RowsToSolve.push_back(row);
+        std::sort(m_RowsToSolve.begin(), m_RowsToSolve.end());
     }
 
-    if (m_RowsToSolve.size() > 0)
+    // Free memory is only checked once per batch
+    m_MaxSolvers = maxSolvers();
+    if (m_RowsToSolve.size() > 1)
+        emit updateLog(i18n("Solving %1 images, up to %2 at a time.", m_RowsToSolve.size(), m_MaxSolvers));
+    startSolvers();
+}
+
+void ImageOverlayComponent::startSolvers()
+{
+    while (m_Solvers.size() < m_MaxSolvers && m_RowsToSolve.size() > 0)
     {
-        const int row = m_RowsToSolve[0];
+        const int row = m_RowsToSolve.takeFirst();
         const QString filename =
             QString("%1/%2").arg(m_Directory).arg(m_Overlays[row].m_Filename);
         if ((m_Overlays[row].m_Status == ImageOverlay::AVAILABLE) &&
                 !shouldSolveAnyway(m_ImageOverlayTable, row))
         {
             emit updateLog(i18n("%1 already solved. Skipping.", filename));
-            m_RowsToSolve.removeFirst();
-            if (m_RowsToSolve.size() > 0)
-                startSolving();
-            return;
+            continue;
         }
 
-        auto img = new QImage(filename);
-        m_Overlays[row].m_Width = img->width();
-        m_Overlays[row].m_Height = img->height();
-        solveImage(filename);
+        // Only the size is needed here, which the reader gets without decoding the image
+        const QSize size = QImageReader(filename).size();
+        m_Overlays[row].m_Width = size.width();
+        m_Overlays[row].m_Height = size.height();
+        solveImage(row, filename, m_MaxSolvers > 1);
     }
+    m_SolveButton->setText(m_Solvers.isEmpty() ? i18n("Solve") : i18n("Abort"));
 }
 
 void ImageOverlayComponent::reload()
@@ -780,16 +883,13 @@ void ImageOverlayComponent::reload()
     loadAllImageFiles();
 }
 
-void ImageOverlayComponent::solverDone(bool timedOut, bool success, const FITSImage::Solution &solution,
-                                       double elapsedSeconds)
+void ImageOverlayComponent::solverDone(int solverRow, bool timedOut, bool success,
+                                       const FITSImage::Solution &solution, double elapsedSeconds)
 {
-    disconnect(m_Solver.get(), &SolverUtils::done, this, &ImageOverlayComponent::solverDone);
-    m_SolveButton->setText(i18n("Solve"));
-    if (m_RowsToSolve.size() == 0)
+    const QSharedPointer<SolverUtils> solver = m_Solvers.take(solverRow);
+    if (!solver)
         return;
-
-    const int solverRow = m_RowsToSolve[0];
-    m_RowsToSolve.removeFirst();
+    disconnect(solver.get(), &SolverUtils::done, this, nullptr);
 
     QComboBox *statusItem = dynamic_cast<QComboBox*>(m_ImageOverlayTable->cellWidget(solverRow, STATUS_COL));
     if (timedOut)
@@ -836,16 +936,13 @@ void ImageOverlayComponent::solverDone(bool timedOut, bool success, const FITSIm
 
         // Load the image.
         QString fullFilename = QString("%1/%2").arg(m_Directory).arg(m_Overlays[solverRow].m_Filename);
-        QImage *img = loadImageFile(fullFilename, !m_Overlays[solverRow].m_EastToTheRight);
-        m_Overlays[solverRow].m_Img.reset(img);
+        m_Overlays[solverRow].m_Pyramid = loadImageFile(fullFilename, !m_Overlays[solverRow].m_EastToTheRight);
     }
-    saveToUserDB();
+    // Only this overlay changed
+    KStarsData::Instance()->userdb()->AddImageOverlay(m_Overlays[solverRow]);
+    m_TableGroupBox->setTitle(i18n("Image Overlays.  %1 images, %2 available.", m_Overlays.size(), numAvailable()));
 
-    if (m_RowsToSolve.size() > 0)
-        startSolving();
-    else
-    {
+    startSolvers();
+    if (m_Solvers.isEmpty())
         emit updateLog(i18n("Done solving. %1 available.", numAvailable()));
-        m_TableGroupBox->setTitle(i18n("Image Overlays.  %1 images, %2 available.", m_Overlays.size(), numAvailable()));
-    }
 }
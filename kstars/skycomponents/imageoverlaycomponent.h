@@ -7,7 +7,9 @@
 #pragma once
 
 #include "imageoverlaycomponent.h"
+#include "imageoverlaypyramid.h"
 #include "skycomponent.h"
+#include <QMap>
 #include <QSharedPointer>
 #include <QImage>
 #include <QObject>
@@ -56,7 +58,8 @@ class ImageOverlay
         bool m_EastToTheRight = true;
         int m_Width = 0;
         int m_Height = 0;
-        QSharedPointer<QImage> m_Img = nullptr;
+        // Tiles of the image, only a thumbnail of them is kept in memory
+        QSharedPointer<ImageOverlayPyramid> m_Pyramid = nullptr;
 };
 
 /**
@@ -104,8 +107,11 @@ private slots:
 private:
     void loadFromUserDB();
     void saveToUserDB();
-    void solveImage(const QString &filename);
-    void solverDone(bool timedOut, bool success, const FITSImage::Solution &solution, double elapsedSeconds);
+    void solveImage(int row, const QString &filename, bool singleThreaded);
+    void solverDone(int row, bool timedOut, bool success, const FITSImage::Solution &solution, double elapsedSeconds);
+    // Starts solvers on the queued rows, up to m_MaxSolvers at a time
+    void startSolvers();
+    int maxSolvers() const;
     void initializeGui();
     int numAvailable();
     void cellChanged(int row, int col);
@@ -117,7 +123,7 @@ private:
     void loadAllImageFiles();
     void loadImageFileLoop();
     bool loadImageFile();
-    QImage *loadImageFile (const QString &fullFilename, bool mirror);
+    QSharedPointer<ImageOverlayPyramid> loadImageFile (const QString &fullFilename, bool mirror);
 
 
     QTableWidget *m_ImageOverlayTable;
@@ -131,9 +137,16 @@ private:
 
     QList<ImageOverlay> m_Overlays;
     QMap<QString, int> m_Filenames;
-    QSharedPointer<SolverUtils> m_Solver;
+    // The running solvers by row, and the rows waiting for one
+    QMap<int, QSharedPointer<SolverUtils>> m_Solvers;
     QList<int> m_RowsToSolve;
+    QList<QSharedPointer<SolverUtils>> m_AbortedSolvers;
+    int m_MaxSolvers { 1 };
     QString m_Directory;
     QTimer m_TryAgainTimer;
     QFuture<void> m_LoadImagesFuture;
+
+    // Solvers are not run beyond this, nor beyond a core each or this much free memory each
+    static constexpr int MAX_SOLVERS = 8;
+    static constexpr double SOLVER_MEMORY = 1024.0 * 1024 * 1024;
 };
@@ -0,0 +1,226 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "imageoverlaypyramid.h"
+
+#include "auxiliary/kspaths.h"
+#include "skymap.h"
+
+#include <QCache>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutex>
+#include <QPainter>
+#include <QSet>
+#include <QtConcurrent>
+
+#include <cmath>
+
+namespace
+{
+
+constexpr quint32 PYRAMID_MAGIC = 0x4B534950; // "KSIP"
+// Raise whenever the tiles or the manifest change
+constexpr quint32 PYRAMID_VERSION = 1;
+// Memory the tiles read for all overlays may take
+constexpr int TILE_CACHE_BYTES = 64 * 1024 * 1024;
+
+QMutex g_TilesMutex;
+QCache<QString, QImage> g_Tiles(TILE_CACHE_BYTES);
+QSet<QString> g_PendingTiles;
+
+QString manifestPath(const QString &directory)
+{
+    return QDir(directory).filePath("pyramid.dat");
+}
+
+}
+
+ImageOverlayPyramid::ImageOverlayPyramid(const QString &directory, const QVector<QSize> &sizes,
+        const QImage &thumbnail)
+    : m_Directory(directory), m_Sizes(sizes), m_Thumbnail(thumbnail)
+{
+}
+
+QString ImageOverlayPyramid::tilePath(int level, int x, int y) const
+{
+    return QDir(m_Directory).filePath(QString("%1-%2-%3.png").arg(level).arg(x).arg(y));
+}
+
+QSharedPointer<ImageOverlayPyramid> ImageOverlayPyramid::open(const QString &filename, bool mirror, int maxDimension)
+{
+    const QFileInfo info(filename);
+    if (!info.exists())
+        return QSharedPointer<ImageOverlayPyramid>();
+
+    // Any change to the file or to the way it is scaled makes a new pyramid
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(QString("%1|%2|%3|%4|%5|%6").arg(info.absoluteFilePath()).arg(info.size())
+                 .arg(info.lastModified().toMSecsSinceEpoch()).arg(mirror).arg(maxDimension)
+                 .arg(PYRAMID_VERSION).toUtf8());
+    const QString directory = QDir(KSPaths::writableLocation(QStandardPaths::CacheLocation))
+                              .filePath(QString("imageoverlays/%1").arg(QString(hash.result().toHex())));
+
+    QFile manifest(manifestPath(directory));
+    if (manifest.open(QIODevice::ReadOnly))
+    {
+        QDataStream in(&manifest);
+        quint32 magic = 0, version = 0;
+        QVector<QSize> sizes;
+        in >> magic >> version >> sizes;
+
+        if (in.status() == QDataStream::Ok && magic == PYRAMID_MAGIC && version == PYRAMID_VERSION && !sizes.isEmpty())
+        {
+            const QImage top(QDir(directory).filePath(QString("%1-0-0.png").arg(sizes.size() - 1)));
+            if (!top.isNull())
+            {
+                const QImage thumbnail = top.width() > THUMBNAIL_SIZE ?
+                                         top.scaledToWidth(THUMBNAIL_SIZE, Qt::SmoothTransformation) : top;
+                return QSharedPointer<ImageOverlayPyramid>(new ImageOverlayPyramid(directory, sizes, thumbnail));
+            }
+        }
+    }
+
+    return build(filename, directory, mirror, maxDimension);
+}
+
+QSharedPointer<ImageOverlayPyramid> ImageOverlayPyramid::build(const QString &filename, const QString &directory,
+        bool mirror, int maxDimension)
+{
+    QImage image(filename);
+    if (image.isNull())
+        return QSharedPointer<ImageOverlayPyramid>();
+
+    if (mirror)
+        image = image.mirrored(true, false); // It's reflected horizontally.
+    if (image.width() > maxDimension && maxDimension > 0)
+        image = image.scaledToWidth(maxDimension, Qt::SmoothTransformation);
+
+    // Whatever was left of an earlier build is replaced
+    QDir dir(directory);
+    dir.removeRecursively();
+    if (!dir.mkpath("."))
+        return QSharedPointer<ImageOverlayPyramid>();
+
+    QVector<QSize> sizes;
+    while (true)
+    {
+        const int level = sizes.size();
+        sizes.append(image.size());
+        for (int y = 0; y * TILE_SIZE < image.height(); y++)
+        {
+            for (int x = 0; x * TILE_SIZE < image.width(); x++)
+            {
+                const QImage tile = image.copy(x * TILE_SIZE, y * TILE_SIZE,
+                                               std::min(TILE_SIZE, image.width() - x * TILE_SIZE),
+                                               std::min(TILE_SIZE, image.height() - y * TILE_SIZE));
+                if (!tile.save(dir.filePath(QString("%1-%2-%3.png").arg(level).arg(x).arg(y)), "PNG"))
+                    return QSharedPointer<ImageOverlayPyramid>();
+            }
+        }
+
+        if (image.width() <= TILE_SIZE && image.height() <= TILE_SIZE)
+            break;
+        image = image.scaled((image.width() + 1) / 2, (image.height() + 1) / 2, Qt::IgnoreAspectRatio,
+                             Qt::SmoothTransformation);
+    }
+
+    // The manifest goes last, so an interrupted build is done again
+    QFile manifest(manifestPath(directory));
+    if (!manifest.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return QSharedPointer<ImageOverlayPyramid>();
+    QDataStream out(&manifest);
+    out << PYRAMID_MAGIC << PYRAMID_VERSION << sizes;
+    manifest.close();
+
+    const QImage thumbnail = image.width() > THUMBNAIL_SIZE ?
+                             image.scaledToWidth(THUMBNAIL_SIZE, Qt::SmoothTransformation) : image;
+    return QSharedPointer<ImageOverlayPyramid>(new ImageOverlayPyramid(directory, sizes, thumbnail));
+}
+
+int ImageOverlayPyramid::levelFor(double screenWidth) const
+{
+    for (int level = m_Sizes.size() - 1; level > 0; level--)
+    {
+        if (m_Sizes[level].width() >= screenWidth)
+            return level;
+    }
+    return 0;
+}
+
+QImage ImageOverlayPyramid::tile(int level, int x, int y) const
+{
+    const QString path = tilePath(level, x, y);
+
+    QMutexLocker locker(&g_TilesMutex);
+    if (const QImage *image = g_Tiles.object(path))
+        return *image;
+    if (g_PendingTiles.contains(path))
+        return QImage();
+    g_PendingTiles.insert(path);
+    locker.unlock();
+
+    QtConcurrent::run([path]()
+    {
+        // A tile that cannot be read is cached as a null image, so it is not asked for again
+        QImage *image = new QImage(path);
+        {
+            QMutexLocker locker(&g_TilesMutex);
+            g_PendingTiles.remove(path);
+            g_Tiles.insert(path, image, std::max(1, int(image->sizeInBytes())));
+        }
+#ifndef KSTARS_LITE
+        if (SkyMap::Instance())
+            QMetaObject::invokeMethod(SkyMap::Instance(), "forceUpdate", Qt::QueuedConnection);
+#endif
+    });
+    return QImage();
+}
+
+void ImageOverlayPyramid::draw(QPainter &painter, double w, double h) const
+{
+    const QRectF target(-0.5 * w, -0.5 * h, w, h);
+
+    // Whatever is not read yet shows at the thumbnail's resolution
+    painter.drawImage(target, m_Thumbnail);
+
+    const int level = levelFor(w);
+    const QSize size = m_Sizes[level];
+    if (size.width() <= m_Thumbnail.width())
+        return;
+
+    // Only the part of the image in the window is needed
+    QRectF visible = target;
+    bool invertible = false;
+    const QTransform toImage = painter.worldTransform().inverted(&invertible);
+    if (invertible)
+        visible &= toImage.mapRect(QRectF(painter.window()));
+    if (visible.isEmpty())
+        return;
+
+    const double sx = w / size.width(), sy = h / size.height();
+    const int columns = (size.width() + TILE_SIZE - 1) / TILE_SIZE;
+    const int rows = (size.height() + TILE_SIZE - 1) / TILE_SIZE;
+    const int x0 = std::max(0, int(std::floor((visible.left() - target.left()) / sx / TILE_SIZE)));
+    const int x1 = std::min(columns - 1, int(std::floor((visible.right() - target.left()) / sx / TILE_SIZE)));
+    const int y0 = std::max(0, int(std::floor((visible.top() - target.top()) / sy / TILE_SIZE)));
+    const int y1 = std::min(rows - 1, int(std::floor((visible.bottom() - target.top()) / sy / TILE_SIZE)));
+
+    for (int y = y0; y <= y1; y++)
+    {
+        for (int x = x0; x <= x1; x++)
+        {
+            const QImage image = tile(level, x, y);
+            if (image.isNull())
+                continue;
+            painter.drawImage(QRectF(target.left() + x * TILE_SIZE * sx, target.top() + y * TILE_SIZE * sy,
+                                     image.width() * sx, image.height() * sy), image);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QImage>
+#include <QSharedPointer>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+class QPainter;
+
+/**
+ * @class ImageOverlayPyramid
+ * @short Multi-resolution tiles of an image overlay, cached on disk.
+ *
+ * Level 0 is the image, mirrored if need be and scaled down to the maximum overlay dimension.
+ * Each further level halves the one before until the image fits in a single tile. The tiles
+ * are written once to the cache directory, keyed on the image file and the way it was scaled.
+ * Only a thumbnail of each overlay stays in memory. The tiles the sky map needs for its field
+ * of view and zoom are read in the background, and kept in a cache shared by all overlays.
+ */
+class ImageOverlayPyramid
+{
+    public:
+        static constexpr int TILE_SIZE = 256;
+        static constexpr int THUMBNAIL_SIZE = 128;
+
+        /**
+         * @brief open Open the pyramid of an image, building it first if it is not in the cache
+         * @param filename the image file
+         * @param mirror whether the image is reflected horizontally
+         * @param maxDimension width level 0 is scaled down to
+         * @return nullptr if the image could not be read. This is slow, and meant for a background thread.
+         */
+        static QSharedPointer<ImageOverlayPyramid> open(const QString &filename, bool mirror, int maxDimension);
+
+        /** @return the size of level 0 */
+        QSize size() const
+        {
+            return m_Sizes.first();
+        }
+
+        int levels() const
+        {
+            return m_Sizes.size();
+        }
+
+        /**
+         * @brief draw Draw the image into the rectangle of @p w by @p h centered on the origin of the
+         * painter, from the tiles of the level that matches its size on the screen. Only the tiles in
+         * the painter's window are drawn. Those not read yet are requested, the thumbnail stands in
+         * for them and the sky map is redrawn once they arrive.
+         */
+        void draw(QPainter &painter, double w, double h) const;
+
+    private:
+        ImageOverlayPyramid(const QString &directory, const QVector<QSize> &sizes, const QImage &thumbnail);
+
+        static QSharedPointer<ImageOverlayPyramid> build(const QString &filename, const QString &directory, bool mirror,
+                int maxDimension);
+
+        // The coarsest level at least as wide as the image is on the screen
+        int levelFor(double screenWidth) const;
+
+        // The tile, or a null image if it still has to be read
+        QImage tile(int level, int x, int y) const;
+        QString tilePath(int level, int x, int y) const;
+
+        QString m_Directory;
+        QVector<QSize> m_Sizes;
+        QImage m_Thumbnail;
+};
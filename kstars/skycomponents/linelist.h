@@ -9,6 +9,8 @@
 #include "typedef.h"
 
 #include <QList>
+#include <QPointF>
+#include <QVector>
 
 class SkyPoint;
 class KSNumbers;
@@ -45,6 +47,18 @@ class LineList
     UpdateID updateID;
     UpdateID updateNumID;
 
+    /**
+     * Screen positions of the points and whether they are visible, kept by
+     * SkyQPainter for the Projector::viewID() and updateID they were projected
+     * at.  Set cacheScreenPoints only for lists whose points change with the
+     * updateID alone, as LineListIndex does for the lists it indexes.
+     */
+    bool cacheScreenPoints { false };
+    QVector<QPointF> screenPoints;
+    QVector<bool> screenVisible;
+    quint64 screenViewID { 0 };
+    UpdateID screenUpdateID { 0 };
+
   private:
     SkyList pointList;
 };
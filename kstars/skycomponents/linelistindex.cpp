@@ -77,6 +77,7 @@ void LineListIndex::appendLine(const std::shared_ptr<LineList> &lineList)
         m_lineIndex->value(trixel)->append(lineList);
     }
     m_listList.append(lineList);
+    lineList->cacheScreenPoints = true;
 }
 
 void LineListIndex::appendPoly(const std::shared_ptr<LineList> &lineList)
@@ -95,6 +96,7 @@ void LineListIndex::appendPoly(const std::shared_ptr<LineList> &lineList)
         }
         m_polyIndex->value(trixel)->append(lineList);
     }
+    lineList->cacheScreenPoints = true;
 }
 
 void LineListIndex::appendBoth(const std::shared_ptr<LineList> &lineList)
@@ -192,10 +194,11 @@ void LineListIndex::drawLines(SkyPainter *skyp)
                 continue;
             lineList->drawID = drawID;
 
-            if (lineList->updateID != updateID)
-                JITupdate(lineList.get());
+            LineList *drawnList = levelOfDetail(lineList.get());
+            if (drawnList->updateID != updateID)
+                JITupdate(drawnList);
 
-            skyp->drawSkyPolyline(lineList.get(), skipList(lineList.get()), label());
+            skyp->drawSkyPolyline(drawnList, skipList(drawnList), label());
         }
     }
 }
@@ -223,10 +226,11 @@ void LineListIndex::drawFilled(SkyPainter *skyp)
                 continue;
             lineList->drawID = drawID;
 
-            if (lineList->updateID != updateID)
-                JITupdate(lineList.get());
+            LineList *drawnList = levelOfDetail(lineList.get());
+            if (drawnList->updateID != updateID)
+                JITupdate(drawnList);
 
-            skyp->drawSkyPolygon(lineList.get());
+            skyp->drawSkyPolygon(drawnList);
         }
     }
 }
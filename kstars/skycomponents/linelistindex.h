@@ -160,6 +160,13 @@ class LineListIndex : public SkyComponent
 
     virtual LineListLabel *label() { return nullptr; }
 
+    /**
+     * @short Returns the list to draw in place of lineList, e.g. a simplified
+     * version of it.  Overridden by MilkyWay to draw coarser contours when
+     * zoomed out.  The default is to draw lineList itself.
+     */
+    virtual LineList *levelOfDetail(LineList *lineList) { return lineList; }
+
     inline LineListList listList() const { return m_listList; }
 
   private:
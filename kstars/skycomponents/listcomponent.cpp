@@ -7,6 +7,7 @@
 #include "listcomponent.h"
 
 #include "kstarsdata.h"
+#include "nameindex.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
 #endif
@@ -17,6 +18,8 @@ ListComponent::ListComponent(SkyComposite *parent) : SkyComponent(parent)
 
 ListComponent::~ListComponent()
 {
+    NameIndex::invalidate();
+    m_PointIndex.invalidate();
     qDeleteAll(m_ObjectList);
     m_ObjectList.clear();
     m_ObjectHash.clear();
@@ -26,6 +29,9 @@ ListComponent::~ListComponent()
 
 void ListComponent::clear()
 {
+    if (!m_ObjectList.isEmpty())
+        NameIndex::invalidate();
+    m_PointIndex.invalidate();
     while (!m_ObjectList.isEmpty())
     {
         SkyObject *o = m_ObjectList.takeFirst();
@@ -38,6 +44,7 @@ void ListComponent::appendListObject(SkyObject *object)
 {
     // Append to the Object List
     m_ObjectList.append(object);
+    m_PointIndex.invalidate();
 
     // Insert multiple Names
     m_ObjectHash.insert(object->name().toLower(), object);
@@ -61,7 +68,7 @@ void ListComponent::update(KSNumbers *num)
 SkyObject *ListComponent::findByName(const QString &name, bool exact)
 {
     Q_UNUSED(exact)
-    return m_ObjectHash[name.toLower()]; // == nullptr if not found.
+    return m_ObjectHash.value(name.toLower()); // == nullptr if not found.
 }
 
 SkyObject *ListComponent::objectNearest(SkyPoint *p, double &maxrad)
@@ -69,6 +76,9 @@ SkyObject *ListComponent::objectNearest(SkyPoint *p, double &maxrad)
     if (!selected())
         return nullptr;
 
+    if (m_PointIndex.isValid())
+        return m_PointIndex.nearest(p, maxrad);
+
     SkyObject *oBest = nullptr;
     foreach (SkyObject *o, m_ObjectList)
     {
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "pointindex.h"
 #include "skycomponent.h"
 
 #include <QList>
@@ -63,4 +64,6 @@ class ListComponent : public SkyComponent
     protected:
         QList<SkyObject *> m_ObjectList;
         QHash<QString, SkyObject *> m_ObjectHash;
+        /** Built by the components that move their objects, after they moved them */
+        PointIndex m_PointIndex;
 };
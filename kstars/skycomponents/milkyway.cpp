@@ -8,6 +8,7 @@
 
 #include "ksfilereader.h"
 #include "kstarsdata.h"
+#include "ksutils.h"
 #ifdef KSTARS_LITE
 #include "skymaplite.h"
 #else
@@ -15,10 +16,55 @@
 #endif
 #include "Options.h"
 #include "skypainter.h"
+#include "projections/projector.h"
 #include "skycomponents/skiphashlist.h"
 
 #include <QtConcurrent>
 
+#include <Eigen/Geometry>
+
+namespace
+{
+// Largest distance in degrees between a simplified contour and the points it drops, per level of detail
+const double LEVEL_TOLERANCES[] = { 0.25, 0.5, 1.0, 2.0 };
+const int LEVEL_COUNT = sizeof(LEVEL_TOLERANCES) / sizeof(LEVEL_TOLERANCES[0]);
+
+// How far in pixels a simplified contour may stray from the full one on screen, well within the pen width
+const double MAX_ERROR_PIXELS = 3.0;
+
+// Marks the points of [first, last] to keep so that none of the others is
+// further than tolerance (in radians) from the great circle through its neighbours
+void douglasPeucker(const QVector<Eigen::Vector3d> &vectors, int first, int last, double tolerance, QVector<bool> &keep)
+{
+    if (last - first < 2)
+        return;
+
+    Eigen::Vector3d normal = vectors.at(first).cross(vectors.at(last));
+    const bool closed      = normal.norm() < 1e-12;
+    if (!closed)
+        normal.normalize();
+
+    int farthest    = -1;
+    double distance = tolerance;
+    for (int i = first + 1; i < last; i++)
+    {
+        const double d = closed ? std::acos(qBound(-1.0, vectors.at(first).dot(vectors.at(i)), 1.0)) :
+                         std::abs(std::asin(qBound(-1.0, normal.dot(vectors.at(i)), 1.0)));
+        if (d > distance)
+        {
+            distance = d;
+            farthest = i;
+        }
+    }
+    if (farthest < 0)
+        return;
+
+    keep[farthest] = true;
+    douglasPeucker(vectors, first, farthest, tolerance, keep);
+    douglasPeucker(vectors, farthest, last, tolerance, keep);
+}
+}
+
 MilkyWay::MilkyWay(SkyComposite *parent) : LineListIndex(parent, i18n("Milky Way"))
 {
     intro();
@@ -45,6 +91,70 @@ SkipHashList *MilkyWay::skipList(LineList *lineList)
     return dynamic_cast<SkipHashList *>(lineList);
 }
 
+LineList *MilkyWay::levelOfDetail(LineList *lineList)
+{
+    if (m_level < 0)
+        return lineList;
+
+    QMutexLocker locker(&m_levelsMutex);
+    auto levels = m_levels.constFind(lineList);
+    if (levels == m_levels.constEnd())
+        return lineList;
+    return levels.value().at(m_level).get();
+}
+
+void MilkyWay::simplify(const std::shared_ptr<LineList> &contour)
+{
+    SkipHashList *full = dynamic_cast<SkipHashList *>(contour.get());
+    SkyList *points    = contour->points();
+    const int count    = points->size();
+    if (count < 3)
+        return;
+
+    QVector<Eigen::Vector3d> vectors(count);
+    for (int i = 0; i < count; i++)
+        vectors[i] = KSUtils::fromSperical(points->at(i)->ra0(), points->at(i)->dec0());
+
+    // Skipped segments are kept as they are, so only the stretches between them are simplified
+    QVector<bool> anchor(count, false);
+    anchor[0] = anchor[count - 1] = true;
+    for (int i = 1; i < count; i++)
+    {
+        if (full->skip(i))
+            anchor[i - 1] = anchor[i] = true;
+    }
+
+    QVector<std::shared_ptr<SkipHashList>> levels;
+    for (int level = 0; level < LEVEL_COUNT; level++)
+    {
+        QVector<bool> keep = anchor;
+        int first          = 0;
+        for (int i = 1; i < count; i++)
+        {
+            if (!anchor.at(i))
+                continue;
+            douglasPeucker(vectors, first, i, LEVEL_TOLERANCES[level] * dms::DegToRad, keep);
+            first = i;
+        }
+
+        std::shared_ptr<SkipHashList> simplified(new SkipHashList());
+        simplified->cacheScreenPoints = true;
+        for (int i = 0; i < count; i++)
+        {
+            if (!keep.at(i))
+                continue;
+            // The neighbours of a skipped segment are kept, so the segment is still the one before this point
+            if (full->skip(i))
+                simplified->setSkip(simplified->points()->size());
+            simplified->append(points->at(i));
+        }
+        levels.append(simplified);
+    }
+
+    QMutexLocker locker(&m_levelsMutex);
+    m_levels.insert(contour.get(), levels);
+}
+
 bool MilkyWay::selected()
 {
 #ifndef KSTARS_LITE
@@ -59,6 +169,20 @@ void MilkyWay::draw(SkyPainter *skyp)
     if (!selected())
         return;
 
+    // Draw the coarsest contours whose error stays below a few pixels
+#ifdef KSTARS_LITE
+    const Projector *proj = SkyMapLite::Instance()->projector();
+#else
+    const Projector *proj = SkyMap::Instance()->projector();
+#endif
+    const ViewParams view = proj->viewParams();
+    // fov() is the angle from the center to a corner of the screen
+    const double diagonal     = std::sqrt(view.width * view.width + view.height * view.height);
+    const double pixelDegrees = (diagonal > 0) ? 2.0 * proj->fov() / diagonal : 0;
+    m_level = -1;
+    while (m_level + 1 < LEVEL_COUNT && LEVEL_TOLERANCES[m_level + 1] <= MAX_ERROR_PIXELS * pixelDegrees)
+        m_level++;
+
     QColor color = KStarsData::Instance()->colorScheme()->colorNamed("MWColor");
     skyp->setPen(QPen(color, 3, Qt::SolidLine));
     skyp->setBrush(QBrush(color));
@@ -105,7 +229,10 @@ void MilkyWay::loadContours(QString fname, QString greeting)
         if (firstChar == 'M')
         {
             if (skipList.get())
+            {
+                simplify(skipList);
                 appendBoth(skipList);
+            }
             skipList.reset();
             iSkip    = 0;
         }
@@ -122,5 +249,8 @@ void MilkyWay::loadContours(QString fname, QString greeting)
         iSkip++;
     }
     if (skipList.get())
+    {
+        simplify(skipList);
         appendBoth(skipList);
+    }
 }
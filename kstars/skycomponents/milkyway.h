@@ -8,6 +8,10 @@
 
 #include "linelistindex.h"
 
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+
 /**
  * @class MlkyWay
  *
@@ -56,4 +60,24 @@ class MilkyWay : public LineListIndex
      * FIXME: Implementation is broken!!
      */
     SkipHashList *skipList(LineList *lineList) override;
+
+    /**
+     * @short Returns the simplified version of lineList chosen for the
+     * current zoom by draw(), or lineList itself when zoomed in.
+     */
+    LineList *levelOfDetail(LineList *lineList) override;
+
+  private:
+    /**
+     * @short Makes the coarser versions of a contour, one per level of
+     * detail, with the Douglas-Peucker algorithm.  They share the points of
+     * the contour, and the ends of skipped segments are always kept.
+     */
+    void simplify(const std::shared_ptr<LineList> &contour);
+
+    /// Simplified versions of each contour, coarsest last
+    QHash<LineList *, QVector<std::shared_ptr<SkipHashList>>> m_levels;
+    QMutex m_levelsMutex;
+    /// Level of detail of the current draw, -1 for the full contours
+    int m_level { -1 };
 };
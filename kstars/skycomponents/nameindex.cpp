@@ -0,0 +1,58 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "nameindex.h"
+
+std::atomic<int> NameIndex::s_Generation { 0 };
+
+QString NameIndex::normalize(const QString &name)
+{
+    QString key;
+    key.reserve(name.size());
+    for (const QChar c : name)
+    {
+        if (!c.isSpace())
+            key.append(c.toLower());
+    }
+
+    // "Messier 31" is "M 31"
+    if (key.startsWith(QLatin1String("messier")) && key.size() > 7 && key.at(7).isDigit())
+        key.remove(1, 6);
+    return key;
+}
+
+void NameIndex::invalidate()
+{
+    s_Generation++;
+}
+
+bool NameIndex::isValid() const
+{
+    return m_Generation == s_Generation;
+}
+
+void NameIndex::reset()
+{
+    m_Objects.clear();
+    m_Generation = s_Generation;
+}
+
+void NameIndex::insert(const QString &name, SkyObject *object)
+{
+    if (object == nullptr || !isValid())
+        return;
+
+    const QString key = normalize(name);
+    if (!key.isEmpty() && !m_Objects.contains(key))
+        m_Objects.insert(key, object);
+}
+
+SkyObject *NameIndex::find(const QString &name) const
+{
+    if (!isValid())
+        return nullptr;
+    return m_Objects.value(normalize(name));
+}
@@ -0,0 +1,62 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+
+#include <atomic>
+
+class SkyObject;
+
+/**
+ * @class NameIndex
+ * @short Objects of all sky components by their normalized names.
+ *
+ * Names are compared without case and white space, and with the Messier prefix shortened, so
+ * "M 31", "m31" and "Messier 31" are the same key. SkyMapComposite fills its index from the
+ * object lists of its components, and adds the names it then resolves through the components,
+ * such as catalog aliases looked up in the database.
+ *
+ * The index holds plain pointers. Whatever deletes objects that may be in an index calls
+ * invalidate() first, after which every index is empty until it is filled again.
+ */
+class NameIndex
+{
+    public:
+        /** @return the key @p name is looked up by */
+        static QString normalize(const QString &name);
+
+        /** @brief invalidate Empty every index, because objects they may hold are about to be deleted */
+        static void invalidate();
+
+        /** @return false if the index was never filled, or invalidated since */
+        bool isValid() const;
+
+        /** @brief reset Empty the index and make it valid, to be filled again */
+        void reset();
+
+        /**
+         * @brief insert Add @p object under @p name, unless an object was already added under that name
+         * @note objects are to be added in the order the components are searched in
+         */
+        void insert(const QString &name, SkyObject *object);
+
+        /** @return the object named @p name, or nullptr */
+        SkyObject *find(const QString &name) const;
+
+        int size() const
+        {
+            return isValid() ? m_Objects.size() : 0;
+        }
+
+    private:
+        QHash<QString, SkyObject *> m_Objects;
+        int m_Generation { -1 };
+
+        static std::atomic<int> s_Generation;
+};
@@ -0,0 +1,70 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "pointindex.h"
+
+#include "skymesh.h"
+#include "htmesh/MeshIterator.h"
+#include "skyobjects/skyobject.h"
+
+void PointIndex::invalidate()
+{
+    m_Valid = false;
+}
+
+void PointIndex::clearTrixels()
+{
+    // Keep the vectors of the trixels, the objects are mostly back in the same ones
+    for (auto &objects : m_Objects)
+        objects.clear();
+}
+
+void PointIndex::insert(SkyObject *object)
+{
+    m_Objects[SkyMesh::Instance()->indexNow(object)].append(object);
+}
+
+const QVector<SkyObject *> *PointIndex::objectsIn(Trixel trixel) const
+{
+    if (!m_Valid)
+        return nullptr;
+
+    const auto it = m_Objects.constFind(trixel);
+    return it == m_Objects.constEnd() || it->isEmpty() ? nullptr : &*it;
+}
+
+SkyObject *PointIndex::nearest(const SkyPoint *p, double &maxrad,
+                               const std::function<bool(SkyObject *)> &accept) const
+{
+    if (!m_Valid)
+        return nullptr;
+
+    SkyMesh *mesh = SkyMesh::Instance();
+    mesh->index(p, maxrad, POINT_INDEX_BUF);
+    MeshIterator region(mesh, POINT_INDEX_BUF);
+
+    SkyObject *oBest = nullptr;
+    while (region.hasNext())
+    {
+        const auto it = m_Objects.constFind(region.next());
+        if (it == m_Objects.constEnd())
+            continue;
+
+        for (SkyObject *o : *it)
+        {
+            if (accept && !accept(o))
+                continue;
+
+            double r = o->angularDistanceTo(p).Degrees();
+            if (r < maxrad)
+            {
+                oBest  = o;
+                maxrad = r;
+            }
+        }
+    }
+    return oBest;
+}
@@ -0,0 +1,74 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "typedef.h"
+
+#include <QHash>
+#include <QVector>
+
+#include <functional>
+
+class SkyMesh;
+class SkyObject;
+class SkyPoint;
+
+/**
+ * @class PointIndex
+ * @short Point-like objects of a component by the trixel of their current position.
+ *
+ * Stars and catalog objects are indexed by their catalogue coordinates, as they hardly move.
+ * Solar system bodies, satellites and supernovae are indexed here by their current right
+ * ascension and declination instead, so their component rebuilds the index whenever it has
+ * moved them. A nearest query then only looks at the trixels covering the click aperture, and a
+ * component draws only the objects of the trixels in view.
+ *
+ * An index that was not built, or was invalidated since because objects were added or
+ * deleted, answers no query; the component is to search all its objects instead.
+ */
+class PointIndex
+{
+    public:
+        PointIndex() = default;
+
+        /** @brief build Index @p objects at their present positions */
+        template <typename List>
+        void build(const List &objects)
+        {
+            clearTrixels();
+            for (auto object : objects)
+                insert(object);
+            m_Valid = true;
+        }
+
+        /** @brief invalidate Forget the objects, which are about to change */
+        void invalidate();
+
+        /** @return whether the index holds the objects of its component, where they are now */
+        bool isValid() const
+        {
+            return m_Valid;
+        }
+
+        /**
+         * @brief nearest Find the object closest to @p p, among those @p accept takes
+         * @param maxrad only objects closer than this are found, set to the distance of the one found
+         * @return the nearest object, nullptr if none is closer than @p maxrad
+         */
+        SkyObject *nearest(const SkyPoint *p, double &maxrad,
+                           const std::function<bool(SkyObject *)> &accept = nullptr) const;
+
+        /** @return the objects in @p trixel, nullptr if there are none or the index is not valid */
+        const QVector<SkyObject *> *objectsIn(Trixel trixel) const;
+
+    private:
+        void clearTrixels();
+        void insert(SkyObject *object);
+
+        QHash<Trixel, QVector<SkyObject *>> m_Objects;
+        bool m_Valid { false };
+};
@@ -0,0 +1,26 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "renderquality.h"
+
+void RenderQuality::beginFrame(bool adapt)
+{
+    m_Adapting = adapt;
+    if (!adapt)
+        m_Level = FULL;
+}
+
+void RenderQuality::endFrame(double milliseconds, double budget)
+{
+    if (!m_Adapting)
+        return;
+
+    // Frames between half the budget and the budget keep the level, so that it does not swing back and forth
+    if (milliseconds > budget && m_Level < MAX_LEVEL)
+        m_Level++;
+    else if (milliseconds < budget / 2 && m_Level > FULL)
+        m_Level--;
+}
@@ -0,0 +1,68 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+/**
+ * @class RenderQuality
+ * @short Lowers the quality of the sky map while it moves, so that it keeps up with the frame rate.
+ *
+ * SkyMapComposite starts each frame with beginFrame() and tells how long it took with endFrame().
+ * While the map moves, each frame that took longer than the budget raises the level by one, and
+ * each frame that took less than half of it lowers the level by one. Each level gives up one more
+ * thing: anti-aliasing, then the labels, then rendering HiPS and terrain, then each further level
+ * draws stars one magnitude brighter. A map that stands still is always drawn in full quality.
+ */
+class RenderQuality
+{
+    public:
+        enum Level
+        {
+            FULL,
+            NO_ANTIALIAS,
+            NO_LABELS,
+            NO_SURVEYS,
+            FEWER_STARS
+        };
+
+        /** Levels past FEWER_STARS, each one magnitude fewer */
+        static constexpr int STAR_STEPS = 4;
+        static constexpr int MAX_LEVEL = FEWER_STARS + STAR_STEPS - 1;
+
+        /** @brief beginFrame Start a frame, in full quality unless @p adapt, as while the map moves */
+        void beginFrame(bool adapt);
+
+        /** @brief endFrame Adapt the level to the frame that took @p milliseconds, for a @p budget */
+        void endFrame(double milliseconds, double budget);
+
+        int level() const
+        {
+            return m_Level;
+        }
+
+        bool antialias() const
+        {
+            return m_Level < NO_ANTIALIAS;
+        }
+        bool labels() const
+        {
+            return m_Level < NO_LABELS;
+        }
+        /** @return whether HiPS and terrain are rendered */
+        bool surveys() const
+        {
+            return m_Level < NO_SURVEYS;
+        }
+        /** @return magnitudes the faint limit of stars is to be brought up by */
+        double starMagnitudeReduction() const
+        {
+            return m_Level < FEWER_STARS ? 0 : m_Level - FEWER_STARS + 1;
+        }
+
+    private:
+        int m_Level { FULL };
+        bool m_Adapting { false };
+};
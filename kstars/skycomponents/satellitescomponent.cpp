@@ -9,6 +9,7 @@
 #include "ksfilereader.h"
 #include "ksnotification.h"
 #include "kstarsdata.h"
+#include "nameindex.h"
 #include "Options.h"
 #include "skylabeler.h"
 #include "skymap.h"
@@ -20,6 +21,10 @@
 #include <QProgressDialog>
 #include <QtConcurrent>
 
+// How far ahead the passes are predicted, and the time step of the prediction
+static const double g_passHours   = 12;
+static const double g_passStepMin = 1;
+
 SatellitesComponent::SatellitesComponent(SkyComposite *parent) : SkyComponent(parent)
 {
     QtConcurrent::run(this, &SatellitesComponent::loadData);
@@ -27,6 +32,9 @@ SatellitesComponent::SatellitesComponent(SkyComposite *parent) : SkyComponent(pa
 
 SatellitesComponent::~SatellitesComponent()
 {
+    m_prediction.waitForFinished();
+    NameIndex::invalidate();
+    m_PointIndex.invalidate();
     qDeleteAll(m_groups);
     m_groups.clear();
 }
@@ -81,12 +89,149 @@ void SatellitesComponent::update(KSNumbers *)
     if (!selected())
         return;
 
+    updatePasses();
+
+    // Satellites far below the horizon are only left alone while they are hidden by the ground
+    const Satellite::Context context = Satellite::currentContext(Options::showGround());
+
+    QVector<SkyObject *> visible;
     foreach (SatelliteGroup *group, m_groups)
     {
-        group->updateSatellitesPos();
+        group->updateSatellitesPos(context);
+        for (int i = 0; i < group->size(); i++)
+        {
+            if (group->at(i)->selected())
+                visible.append(group->at(i));
+        }
+    }
+    m_PointIndex.build(visible);
+}
+
+void SatellitesComponent::updatePasses()
+{
+    if (m_prediction.isRunning())
+        return;
+
+    KStarsData *data       = KStarsData::Instance();
+    const GeoLocation *geo = data->geo();
+    const double jd        = data->clock()->utc().djd();
+
+    if (m_predictionUntil > 0 && (geo->lat()->Degrees() != m_predictionGeo.lat()->Degrees() ||
+                                  geo->lng()->Degrees() != m_predictionGeo.lng()->Degrees()))
+        clearPasses();
+
+    for (const Prediction &prediction : m_predictions)
+        prediction.satellite->setPasses(prediction.passes, m_predictionFrom, m_predictionUntil);
+    m_predictions.clear();
+
+    // Predict again once half of the passes are over, or the clock jumped away from them
+    if (jd >= m_predictionFrom && jd < 0.5 * (m_predictionFrom + m_predictionUntil))
+        return;
+
+    m_predictionGeo   = *geo;
+    m_predictionFrom  = jd;
+    m_predictionUntil = jd + g_passHours / 24.0;
+
+    // The contexts are the same for all satellites
+    m_predictionContexts.clear();
+    for (double t = m_predictionFrom; t < m_predictionUntil; t += g_passStepMin / 1440.0)
+        m_predictionContexts.append(Satellite::context(t, m_predictionGeo));
+
+    for (SatelliteGroup *group : m_groups)
+    {
+        for (Satellite *sat : *group)
+        {
+            if (sat->selected())
+                m_predictions.push_back({ sat, *sat, {} });
+        }
+    }
+
+    m_prediction = QtConcurrent::map(m_predictions, [this](Prediction & prediction)
+    {
+        prediction.passes = prediction.copy.predictPasses(m_predictionContexts, m_predictionGeo);
+    });
+}
+
+void SatellitesComponent::clearPasses()
+{
+    m_prediction.waitForFinished();
+    m_predictions.clear();
+    m_predictionFrom = m_predictionUntil = 0;
+
+    for (SatelliteGroup *group : m_groups)
+    {
+        for (Satellite *sat : *group)
+            sat->setPasses({}, 0, 0);
     }
 }
 
+QList<Satellite *> SatellitesComponent::sightings(const SkyPoint &center, double radius, double from,
+        double until) const
+{
+    auto toVector = [](double ra, double dec, double v[3])
+    {
+        double sinRa, cosRa, sinDec, cosDec;
+        dms(ra).SinCos(sinRa, cosRa);
+        dms(dec).SinCos(sinDec, cosDec);
+        v[0] = cosDec * cosRa;
+        v[1] = cosDec * sinRa;
+        v[2] = sinDec;
+    };
+
+    double c[3];
+    toVector(center.ra().Degrees(), center.dec().Degrees(), c);
+    const double cosRadius = cos(radius * dms::DegToRad);
+
+    QList<Satellite *> satellites;
+    for (SatelliteGroup *group : m_groups)
+    {
+        for (Satellite *sat : *group)
+        {
+            if (!sat->selected())
+                continue;
+
+            bool seen = false;
+            for (const Satellite::Pass &pass : sat->passes())
+            {
+                for (int i = 1; !seen && i < pass.track.size(); i++)
+                {
+                    const Satellite::Pass::Point &a = pass.track.at(i - 1);
+                    const Satellite::Pass::Point &b = pass.track.at(i);
+                    if (!(a.visible || b.visible) || b.jd < from || a.jd > until)
+                        continue;
+
+                    // The satellite moves several degrees per time step, check the
+                    // points in between the steps as well
+                    double va[3], vb[3];
+                    toVector(a.ra, a.dec, va);
+                    toVector(b.ra, b.dec, vb);
+                    const int samples = 16;
+                    for (int k = 0; !seen && k <= samples; k++)
+                    {
+                        const double f = double(k) / samples, jd = a.jd + f * (b.jd - a.jd);
+                        if (jd < from || jd > until)
+                            continue;
+
+                        double v[3], norm = 0, dot = 0;
+                        for (int j = 0; j < 3; j++)
+                        {
+                            v[j] = va[j] + f * (vb[j] - va[j]);
+                            norm += v[j] * v[j];
+                            dot += v[j] * c[j];
+                        }
+                        seen = dot >= cosRadius * sqrt(norm);
+                    }
+                }
+            }
+
+            if (seen)
+                satellites.append(sat);
+        }
+    }
+
+    return satellites;
+}
+
 void SatellitesComponent::draw(SkyPainter *skyp)
 {
 #ifndef KSTARS_LITE
@@ -139,6 +284,11 @@ void SatellitesComponent::drawTrails(SkyPainter *skyp)
 
 void SatellitesComponent::updateTLEs()
 {
+    // The satellites are about to be replaced
+    clearPasses();
+    NameIndex::invalidate();
+    m_PointIndex.invalidate();
+
     int i = 0;
     QProgressDialog progressDlg(i18n("Update TLEs..."), i18n("Abort"), 0, m_groups.count());
     progressDlg.setWindowModality(Qt::WindowModal);
@@ -213,6 +363,9 @@ SkyObject *SatellitesComponent::objectNearest(SkyPoint *p, double &maxrad)
     if (!selected())
         return nullptr;
 
+    if (m_PointIndex.isValid())
+        return m_PointIndex.nearest(p, maxrad);
+
     //KStarsData* data = KStarsData::Instance();
 
     SkyObject *oBest = nullptr;
@@ -246,5 +399,5 @@ SkyObject *SatellitesComponent::objectNearest(SkyPoint *p, double &maxrad)
 SkyObject *SatellitesComponent::findByName(const QString &name, bool exact)
 {
     Q_UNUSED(exact)
-    return nameHash[name.toLower()];
+    return nameHash.value(name.toLower());
 }
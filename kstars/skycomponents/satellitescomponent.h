@@ -6,11 +6,16 @@
 
 #pragma once
 
+#include "geolocation.h"
+#include "pointindex.h"
 #include "satellitegroup.h"
 #include "skycomponent.h"
 
+#include <QFuture>
 #include <QList>
 
+#include <vector>
+
 class QPointF;
 class Satellite;
 
@@ -91,12 +96,50 @@ class SatellitesComponent : public SkyComponent
          */
         SkyObject *findByName(const QString &name, bool exact = true) override;
 
+        /**
+         * @short Find the satellites that can be seen crossing a field of view.
+         * This only looks at the passes predicted in the background, so it is cheap
+         * enough to be asked for every exposure.
+         * @param center Center of the field of view, in coordinates of date
+         * @param radius Radius of the field of view in degrees
+         * @param from UTC julian day of the start of the exposure
+         * @param until UTC julian day of the end of the exposure
+         * @return the selected satellites that come within radius of center between from and
+         * until while visible, i.e. sunlit under a dark sky
+         */
+        QList<Satellite *> sightings(const SkyPoint &center, double radius, double from, double until) const;
+
         void loadData();
 
     protected:
         void drawTrails(SkyPainter *skyp) override;
 
     private:
+        /**
+         * @short Hand the passes predicted in the background to the satellites and
+         * start a new prediction when the current one runs out.
+         */
+        void updatePasses();
+
+        /** @short Wait for the prediction and forget all passes */
+        void clearPasses();
+
         QList<SatelliteGroup *> m_groups; // List of all groups
         QHash<QString, Satellite *> nameHash;
+        // Selected satellites by the trixel of their current position, rebuilt on every update
+        PointIndex m_PointIndex;
+
+        /// A satellite whose passes are being predicted, on a copy of it
+        struct Prediction
+        {
+            Satellite *satellite;
+            Satellite copy;
+            QVector<Satellite::Pass> passes;
+        };
+        std::vector<Prediction> m_predictions;
+        QVector<Satellite::Context> m_predictionContexts;
+        GeoLocation m_predictionGeo { dms(0), dms(0) };
+        double m_predictionFrom { 0 };
+        double m_predictionUntil { 0 };
+        QFuture<void> m_prediction;
 };
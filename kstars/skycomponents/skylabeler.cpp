@@ -6,6 +6,7 @@
 
 #include "skylabeler.h"
 
+#include <algorithm>
 #include <cstdio>
 
 #include <QPainter>
@@ -28,6 +29,12 @@ typedef struct LabelRun
 
 } LabelRun;
 
+// Width in pixels of the cells of the occupancy bitmask
+static const int OCCUPANCY_CELL = 32;
+
+// Most text widths cached per font
+static const int MAX_CACHED_WIDTHS = 20000;
+
 //----- Now for the main event ----------------------------------------------//
 
 //----- Static Methods ------------------------------------------------------//
@@ -83,6 +90,7 @@ double SkyLabeler::ZoomOffset()
 SkyLabeler::SkyLabeler()
     : m_fontMetrics(QFont()), m_picture(-1), labelList(NUM_LABEL_TYPES)
 {
+    setMetricsFont(QFont());
 #ifdef KSTARS_LITE
     //Painter is needed to get default font and we use it only once to have only one warning
     m_stdFont = QFont();
@@ -113,7 +121,7 @@ bool SkyLabeler::drawGuideLabel(QPointF &o, const QString &text, double angle)
 {
     // Create bounding rectangle by rotating the (height x width) rectangle
     qreal h = m_fontMetrics.height();
-    qreal w = m_fontMetrics.width(text);
+    qreal w = textWidth(text);
     qreal s = sin(angle * dms::PI / 180.0);
     qreal c = cos(angle * dms::PI / 180.0);
 
@@ -191,7 +199,28 @@ void SkyLabeler::setFont(const QFont &font)
 #else
     m_drawFont = font;
 #endif
-    m_fontMetrics = QFontMetrics(font);
+    setMetricsFont(font);
+}
+
+void SkyLabeler::setMetricsFont(const QFont &font)
+{
+    m_fontMetrics    = QFontMetrics(font);
+    m_fontTextWidths = &m_textWidths[font.key()];
+}
+
+qreal SkyLabeler::textWidth(const QString &text)
+{
+    auto cached = m_fontTextWidths->constFind(text);
+    if (cached != m_fontTextWidths->constEnd())
+        return cached.value();
+
+    // Start over now and then, the names on screen change with the zoom
+    if (m_fontTextWidths->size() >= MAX_CACHED_WIDTHS)
+        m_fontTextWidths->clear();
+
+    const qreal width = m_fontMetrics.width(text);
+    m_fontTextWidths->insert(text, width);
+    return width;
 }
 
 void SkyLabeler::setPen(const QPen &pen)
@@ -227,8 +256,8 @@ void SkyLabeler::resetFont()
 void SkyLabeler::getMargins(const QString &text, float *left, float *right, float *top, float *bot)
 {
     float height     = m_fontMetrics.height();
-    float width      = m_fontMetrics.width(text);
-    float sideMargin = m_fontMetrics.width("MM") + width / 2.0;
+    float width      = textWidth(text);
+    float sideMargin = textWidth("MM") + width / 2.0;
 
     // Create the margins within which it is okay to draw the label
     double winHeight;
@@ -258,14 +287,15 @@ void SkyLabeler::reset(SkyMap *skyMap)
     m_p.begin(&m_picture);
     //This works around BUG 10496 in Qt
     m_p.drawPoint(0, 0);
-    m_p.drawPoint(skyMap->width() + 1, skyMap->height() + 1);
+    // The projector, rather than the map, gives the size of an exported chart
+    m_p.drawPoint(m_proj->viewParams().width + 1, m_proj->viewParams().height + 1);
     // ----- Set up Zoom Dependent Font -----
 
     m_stdFont = QFont(m_p.font());
     setZoomFont();
     m_skyFont     = m_p.font();
-    m_fontMetrics = QFontMetrics(m_skyFont);
-    m_minDeltaX   = (int)m_fontMetrics.width("MMMMM");
+    setMetricsFont(m_skyFont);
+    m_minDeltaX   = (int)textWidth("MMMMM");
 
     // ----- Set up Zoom Dependent Offset -----
     m_offset = SkyLabeler::ZoomOffset();
@@ -291,14 +321,10 @@ void SkyLabeler::reset(SkyMap *skyMap)
         //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
     }
 
-    // Clear all pre-existing rows as needed
-
-    int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
-
-    for (int y = 0; y <= minMaxY; y++)
+    // Clear all pre-existing rows, also those below a screen that got smaller since
+    // markRegion() still reaches them
+    for (auto &row : screenRows)
     {
-        LabelRow *row = screenRows[y];
-
         for (auto &item : *row)
         {
             delete item;
@@ -310,6 +336,8 @@ void SkyLabeler::reset(SkyMap *skyMap)
     if (m_maxY < maxY)
         m_maxY = maxY;
 
+    resetOccupancy(skyMap->width());
+
     // reset the counters
     m_marks = m_hits = m_misses = m_elements = 0;
 
@@ -330,8 +358,8 @@ void SkyLabeler::reset()
     //m_stdFont was moved to constructor
     setZoomFont();
     m_skyFont     = m_drawFont;
-    m_fontMetrics = QFontMetrics(m_skyFont);
-    m_minDeltaX   = (int)m_fontMetrics.width("MMMMM");
+    setMetricsFont(m_skyFont);
+    m_minDeltaX   = (int)textWidth("MMMMM");
     // ----- Set up Zoom Dependent Offset -----
     m_offset = ZoomOffset();
 
@@ -356,13 +384,10 @@ void SkyLabeler::reset()
         //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
     }
 
-    // Clear all pre-existing rows as needed
-
-    int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
-
-    for (int y = 0; y <= minMaxY; y++)
+    // Clear all pre-existing rows, also those below a screen that got smaller since
+    // markRegion() still reaches them
+    for (auto &row : screenRows)
     {
-        LabelRow *row = screenRows[y];
         for (int i = 0; i < row->size(); i++)
         {
             delete row->at(i);
@@ -374,6 +399,8 @@ void SkyLabeler::reset()
     if (m_maxY < maxY)
         m_maxY = maxY;
 
+    resetOccupancy(skyMap->width());
+
     // reset the counters
     m_marks = m_hits = m_misses = m_elements = 0;
 
@@ -417,7 +444,7 @@ bool SkyLabeler::markText(const QPointF &p, const QString &text, qreal padding_f
             1;
     }
 
-    const qreal maxX = p.x() + m_fontMetrics.width(text) * padding_factor;
+    const qreal maxX = p.x() + textWidth(text) * padding_factor;
     const qreal minY = p.y() - m_fontMetrics.height() * padding_factor;
     return markRegion(p.x(), maxX, p.y(), minY);
 }
@@ -460,18 +487,30 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
         minY     = temp;
     }
 
+    // Runs are sorted and don't overlap, so their ends are sorted too
+    auto firstEndingAfter = [](const LabelRow * row, int x)
+    {
+        return std::lower_bound(row->cbegin(), row->cend(), x,
+                                [](const LabelRun * run, int value)
+        {
+            return run->end < value;
+        });
+    };
+
     // check to see if we overlap any existing label
     // We must check all rows before we start marking
+    const int minCell = occupancyCell(minX);
+    const int maxCell = occupancyCell(maxX);
     for (int y = minY; y <= maxY; y++)
     {
+        // Nothing near in this row, no need to look at the runs
+        if (!isOccupied(y, minCell, maxCell))
+            continue;
+
         LabelRow *row = screenRows[y];
-        int i;
-        for (i = 0; i < row->size(); i++)
+        auto run      = firstEndingAfter(row, minX);
+        if (run != row->cend() && (*run)->start <= maxX)
         {
-            if (row->at(i)->end < minX)
-                continue; // skip past these
-            if (row->at(i)->start > maxX)
-                break;
             m_misses++;
             return false;
         }
@@ -483,9 +522,14 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
     // Okay, there was no overlap so let's insert the current rectangle into
     // screenRows.
 
+    // Merging fills gaps of up to m_minDeltaX next to the label, so those might hold a run too
+    const int minMarkCell = occupancyCell(minX - m_minDeltaX);
+    const int maxMarkCell = occupancyCell(maxX + m_minDeltaX);
+
     for (int y = minY; y <= maxY; y++)
     {
         LabelRow *row = screenRows[y];
+        setOccupied(y, minMarkCell, maxMarkCell);
 
         // Simplest case: an empty row
         if (row->size() < 1)
@@ -497,12 +541,7 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
 
         // Find out our place in the universe (or row).
         // H'mm.  Maybe we could cache these numbers above.
-        int i;
-        for (i = 0; i < row->size(); i++)
-        {
-            if (row->at(i)->end >= minX)
-                break;
-        }
+        int i = firstEndingAfter(row, minX) - row->cbegin();
 
         // i now points to first label PAST ours
 
@@ -574,6 +613,36 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
     return true;
 }
 
+void SkyLabeler::resetOccupancy(int width)
+{
+    // One more cell for labels sticking out of the screen on the right
+    m_occupancyWords = (std::max(width, 0) / OCCUPANCY_CELL + 1) / 64 + 1;
+    m_occupancy.fill(0, (m_maxY + 1) * m_occupancyWords);
+}
+
+int SkyLabeler::occupancyCell(int x) const
+{
+    return qBound(0, x / OCCUPANCY_CELL, m_occupancyWords * 64 - 1);
+}
+
+bool SkyLabeler::isOccupied(int y, int minCell, int maxCell) const
+{
+    const quint64 *row = m_occupancy.constData() + y * m_occupancyWords;
+    for (int cell = minCell; cell <= maxCell; cell++)
+    {
+        if (row[cell / 64] & (quint64(1) << (cell % 64)))
+            return true;
+    }
+    return false;
+}
+
+void SkyLabeler::setOccupied(int y, int minCell, int maxCell)
+{
+    quint64 *row = m_occupancy.data() + y * m_occupancyWords;
+    for (int cell = minCell; cell <= maxCell; cell++)
+        row[cell / 64] |= quint64(1) << (cell % 64);
+}
+
 void SkyLabeler::addLabel(SkyObject *obj, SkyLabeler::label_t type)
 {
     bool visible = false;
@@ -8,7 +8,9 @@
 #include "skylabel.h"
 
 #include <QFontMetricsF>
+#include <QHash>
 #include <QList>
+#include <QMap>
 #include <QVector>
 #include <QPainter>
 #include <QPicture>
@@ -51,6 +53,10 @@ typedef QVector<LabelRow *> ScreenRows;
  * saves a lot of space over an explicit array and it also makes checking for
  * overlaps faster and even makes inserting new overlaps faster on average.
  *
+ * On top of the runs, each strip has a coarse bitmask with one bit per
+ * 32 pixel wide cell, set wherever a run might be.  Most labels land in
+ * empty parts of the screen, and those are accepted from the bitmask alone.
+ *
  * Synopsis:
  *
  *   1) Create a new SkyLabeler
@@ -325,7 +331,34 @@ class SkyLabeler
     int marks() { return m_marks; }
 
   private:
+    /**
+     * @short sets the font of m_fontMetrics, and the cache of text widths
+     * measured with it.
+     */
+    void setMetricsFont(const QFont &font);
+
+    /** @short width of text in the current font, measured once per string */
+    qreal textWidth(const QString &text);
+
+    /** @short clears the occupancy bitmask and sizes it for a screen width */
+    void resetOccupancy(int width);
+
+    /** @return true if any of the cells minCell to maxCell of strip y may hold a label */
+    bool isOccupied(int y, int minCell, int maxCell) const;
+
+    /** @short sets the cells minCell to maxCell of strip y */
+    void setOccupied(int y, int minCell, int maxCell);
+
+    /** @return the cell of the occupancy bitmask covering screen column x */
+    int occupancyCell(int x) const;
+
     ScreenRows screenRows;
+    /// Bits of the strips, m_occupancyWords words per strip
+    QVector<quint64> m_occupancy;
+    int m_occupancyWords { 0 };
+    /// Widths of the label texts, one cache per font key
+    QMap<QString, QHash<QString, qreal>> m_textWidths;
+    QHash<QString, qreal> *m_fontTextWidths { nullptr };
     int m_maxX { 0 };
     int m_maxY { 0 };
     int m_size { 0 };
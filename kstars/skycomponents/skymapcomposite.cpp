@@ -52,8 +52,10 @@
 #endif
 
 #include <QApplication>
+#include <QElapsedTimer>
 
 #include <kstars_debug.h>
+#include <kstars_startup_debug.h>
 
 SkyMapComposite::SkyMapComposite(SkyComposite *parent)
     : SkyComposite(parent), m_reindexNum(J2000)
@@ -101,17 +103,28 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
     addComponent(m_Supernovae = new SupernovaeComponent(this), 7);
     SkyMapLite::Instance()->loadingFinished();
 #else
+    // Time each group of components, the Milky Way loads in the background
+    QElapsedTimer timer;
+    timer.start();
+    auto lap = [&timer](const char *what)
+    {
+        qCDebug(KSTARS_STARTUP) << what << "loaded in" << timer.restart() << "ms";
+    };
+
     addComponent(m_MilkyWay = new MilkyWay(this), 50);
     addComponent(m_Stars = StarComponent::Create(this), 10);
+    lap("Stars");
     addComponent(m_EquatorialCoordinateGrid = new EquatorialCoordinateGrid(this));
     addComponent(m_HorizontalCoordinateGrid = new HorizontalCoordinateGrid(this));
     addComponent(m_LocalMeridianComponent = new LocalMeridianComponent(this));
 
     // Do add to components.
     addComponent(m_CBoundLines = new ConstellationBoundaryLines(this), 80);
+    lap("Constellation boundaries");
     m_Cultures.reset(new CultureList());
     addComponent(m_CLines = new ConstellationLines(this, m_Cultures.get()), 85);
     addComponent(m_CNames = new ConstellationNamesComponent(this, m_Cultures.get()), 90);
+    lap("Constellation lines and names");
     addComponent(m_Equator = new Equator(this), 95);
     addComponent(m_Ecliptic = new Ecliptic(this), 95);
     addComponent(m_Horizon = new HorizonComponent(this), 100);
@@ -149,6 +162,8 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
         }
     }
 
+    lap("Equator, ecliptic, horizon and deep-sky catalogs");
+
     addComponent(
         m_ConstellationArt = new ConstellationArtComponent(this, m_Cultures.get()), 100);
 
@@ -166,7 +181,10 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
 
     addComponent(m_ArtificialHorizon = new ArtificialHorizonComponent(this), 110);
 
+    lap("Constellation art, overlays and horizon");
+
     addComponent(m_SolarSystem = new SolarSystemComposite(this), 2);
+    lap("Solar system");
 
     addComponent(m_Flags = new FlagComponent(this), 4);
 
@@ -178,6 +196,7 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
                  130);
     addComponent(m_Satellites = new SatellitesComponent(this), 7);
     addComponent(m_Supernovae = new SupernovaeComponent(this), 7);
+    lap("Flags, satellites and supernovae");
 #endif
     connect(this, SIGNAL(progressText(QString)), KStarsData::Instance(),
             SIGNAL(progressText(QString)));
@@ -212,9 +231,9 @@ void SkyMapComposite::update(KSNumbers *num)
     //m_CLines->update( data, num );  // MUST follow stars.
 
     //12. Solar system
-    m_SolarSystem->update(num);
+    m_DrawTimings.time("Solar system", DrawTimings::UPDATE, [&] { m_SolarSystem->update(num); });
     //13. Satellites
-    m_Satellites->update(num);
+    m_DrawTimings.time("Satellites", DrawTimings::UPDATE, [&] { m_Satellites->update(num); });
     //14. Supernovae
     m_Supernovae->update(num);
     //15. Horizon
@@ -227,12 +246,12 @@ void SkyMapComposite::update(KSNumbers *num)
 
 void SkyMapComposite::updateSolarSystemBodies(KSNumbers *num)
 {
-    m_SolarSystem->updateSolarSystemBodies(num);
+    m_DrawTimings.time("Solar system bodies", DrawTimings::UPDATE, [&] { m_SolarSystem->updateSolarSystemBodies(num); });
 }
 
 void SkyMapComposite::updateMoons(KSNumbers *num)
 {
-    m_SolarSystem->updateMoons(num);
+    m_DrawTimings.time("Moons", DrawTimings::UPDATE, [&] { m_SolarSystem->updateMoons(num); });
 }
 
 //Reimplement draw function so that we have control over the order of
@@ -273,14 +292,19 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     }
 
     m_skyMesh->inDraw(true);
+    m_DrawTimings.beginFrame();
+    m_RenderQuality.beginFrame(map->isSlewing() && Options::adaptiveQuality());
     SkyPoint *focus = map->focus();
-    m_skyMesh->aperture(focus, radius + 1.0, DRAW_BUF); // divide by 2 for testing
-
-    // create the no-precess aperture if needed
-    if (Options::showEquatorialGrid() || Options::showHorizontalGrid() ||
-            Options::showCBounds() || Options::showEquator())
     {
-        m_skyMesh->index(focus, radius + 1.0, NO_PRECESS_BUF);
+        DrawTimings::Scope scope(m_DrawTimings, "Sky mesh", DrawTimings::CULL);
+        m_skyMesh->aperture(focus, radius + 1.0, DRAW_BUF); // divide by 2 for testing
+
+        // create the no-precess aperture if needed
+        if (Options::showEquatorialGrid() || Options::showHorizontalGrid() ||
+                Options::showCBounds() || Options::showEquator())
+        {
+            m_skyMesh->index(focus, radius + 1.0, NO_PRECESS_BUF);
+        }
     }
 
     // clear marks from old labels and prep fonts
@@ -308,75 +332,92 @@ void SkyMapComposite::draw(SkyPainter *skyp)
             }
     }
 
-    m_MilkyWay->draw(skyp);
+    const auto draw = [&](const char *name, SkyComponent *component)
+    {
+        m_DrawTimings.time(name, DrawTimings::DRAW, [&] { component->draw(skyp); });
+    };
+
+    draw("Milky Way", m_MilkyWay);
 
     // Draw HIPS after milky way but before everything else
-    m_HiPS->draw(skyp);
+    draw("HiPS", m_HiPS);
 
-    m_EquatorialCoordinateGrid->draw(skyp);
-    m_HorizontalCoordinateGrid->draw(skyp);
-    m_LocalMeridianComponent->draw(skyp);
+    draw("Equatorial grid", m_EquatorialCoordinateGrid);
+    draw("Horizontal grid", m_HorizontalCoordinateGrid);
+    draw("Local meridian", m_LocalMeridianComponent);
 
     //Draw constellation boundary lines only if we draw western constellations
     if (m_Cultures->current() == "Western")
     {
-        m_CBoundLines->draw(skyp);
-        m_ConstellationArt->draw(skyp);
+        draw("Constellation boundaries", m_CBoundLines);
+        draw("Constellation art", m_ConstellationArt);
     }
     else if (m_Cultures->current() == "Inuit")
     {
-        m_ConstellationArt->draw(skyp);
+        draw("Constellation art", m_ConstellationArt);
     }
 
-    m_CLines->draw(skyp);
+    draw("Constellation lines", m_CLines);
 
-    m_Equator->draw(skyp);
+    draw("Equator", m_Equator);
 
-    m_Ecliptic->draw(skyp);
+    draw("Ecliptic", m_Ecliptic);
 
-    m_Catalogs->draw(skyp);
+    draw("Catalogs", m_Catalogs);
 
-    m_Stars->draw(skyp);
+    draw("Stars", m_Stars);
 
-    m_SolarSystem->drawTrails(skyp);
-    m_SolarSystem->draw(skyp);
+    m_DrawTimings.time("Solar system", DrawTimings::DRAW, [&]
+    {
+        m_SolarSystem->drawTrails(skyp);
+        m_SolarSystem->draw(skyp);
+    });
 
-    m_Satellites->draw(skyp);
+    draw("Satellites", m_Satellites);
 
-    m_Supernovae->draw(skyp);
+    draw("Supernovae", m_Supernovae);
 
-    map->drawObjectLabels(labelObjects());
+    m_DrawTimings.time("Labels", DrawTimings::LABEL, [&]
+    {
+        if (m_RenderQuality.labels())
+        {
+            map->drawObjectLabels(labelObjects());
 
-    m_skyLabeler->drawQueuedLabels();
-    m_CNames->draw(skyp);
-    m_Stars->drawLabels();
+            m_skyLabeler->drawQueuedLabels();
+            m_CNames->draw(skyp);
+        }
+        m_Stars->drawLabels();
+    });
 
     m_ObservingList->pen =
         QPen(QColor(data->colorScheme()->colorNamed("ObsListColor")), 1.);
     m_ObservingList->list2 = KStarsData::Instance()->observingList()->sessionList();
-    m_ObservingList->draw(skyp);
+    draw("Observing list", m_ObservingList);
 
-    m_Flags->draw(skyp);
+    draw("Flags", m_Flags);
 
     m_StarHopRouteList->pen =
         QPen(QColor(data->colorScheme()->colorNamed("StarHopRouteColor")), 1.);
-    m_StarHopRouteList->draw(skyp);
+    draw("Star hop route", m_StarHopRouteList);
 
     // Draw fits overlay before mosaic and terrain/horizon, but after most things.
-    m_ImageOverlay->draw(skyp);
+    draw("Image overlays", m_ImageOverlay);
 
 #ifdef HAVE_INDI
-    m_Mosaic->draw(skyp);
+    draw("Mosaic", m_Mosaic);
 #endif
 
-    m_ArtificialHorizon->draw(skyp);
+    draw("Artificial horizon", m_ArtificialHorizon);
 
-    m_Horizon->draw(skyp);
+    draw("Horizon", m_Horizon);
 
     m_skyMesh->inDraw(false);
 
     // Draw terrain at the end.
-    m_Terrain->draw(skyp);
+    draw("Terrain", m_Terrain);
+
+    m_DrawTimings.endFrame();
+    m_RenderQuality.endFrame(m_DrawTimings.frame(), 1000.0 / Options::adaptiveQualityFPS());
 
     // DEBUG Edit. Keywords: Trixel boundaries. Currently works only in QPainter mode
     // -jbb uncomment these to see trixel outlines:
@@ -555,6 +596,17 @@ QList<SkyObject *> SkyMapComposite::findObjectsInArea(const SkyPoint &p1,
     return list;
 }
 
+QList<SkyObject *> SkyMapComposite::findObjectsInArea(const SkyPoint &center, double radius, bool stars)
+{
+    const SkyRegion &region = m_skyMesh->skyRegion(center, radius);
+    QList<SkyObject *> list;
+    if (stars && m_Stars->selected())
+        m_Stars->objectsInArea(list, region);
+    if (m_Catalogs->selected())
+        m_Catalogs->objectsInArea(list, region);
+    return list;
+}
+
 SkyObject *SkyMapComposite::findByName(const QString &name, bool exact)
 {
 #ifndef KSTARS_LITE
@@ -562,31 +614,66 @@ SkyObject *SkyMapComposite::findByName(const QString &name, bool exact)
         return nullptr;
 #endif
 
+    if (!m_NameIndex.isValid())
+        buildNameIndex();
+    SkyObject *o = m_NameIndex.find(name);
+    if (o)
+    {
+        // As the catalogs do for the objects they find
+        if (auto dso = dynamic_cast<CatalogObject *>(o))
+            dso->JITupdate();
+        return o;
+    }
+
     //We search the children in an "intelligent" order (most-used
     //object types first), in order to avoid wasting too much time
     //looking for a match.  The most important part of this ordering
     //is that stars should be last (because the stars list is so long)
-    SkyObject *o = nullptr;
-    o            = m_SolarSystem->findByName(name);
-    if (o)
-        return o;
-    o = m_Catalogs->findByName(name, exact);
-    if (o)
-        return o;
-    o = m_CNames->findByName(name);
-    if (o)
-        return o;
-    o = m_Stars->findByName(name);
-    if (o)
-        return o;
-    o = m_Supernovae->findByName(name);
-    if (o)
-        return o;
-    o = m_Satellites->findByName(name);
-    if (o)
-        return o;
+    o = m_SolarSystem->findByName(name);
+    if (!o)
+        o = m_Catalogs->findByName(name, exact);
+    if (!o)
+        o = m_CNames->findByName(name);
+    if (!o)
+        o = m_Stars->findByName(name);
+    if (!o)
+        o = m_Supernovae->findByName(name);
+    if (!o)
+        o = m_Satellites->findByName(name);
 
-    return nullptr;
+    // A partial match may be a different object than the name would be next time
+    if (o && exact)
+        m_NameIndex.insert(name, o);
+    return o;
+}
+
+void SkyMapComposite::buildNameIndex()
+{
+    QElapsedTimer timer;
+    timer.start();
+    m_NameIndex.reset();
+
+    // The solar system, the catalogs, the constellations and the stars, as findByName() searches them.
+    // Satellites are left out, they are loaded in the background and found through their component.
+    const QList<int> solarSystem = { SkyObject::PLANET, SkyObject::MOON, SkyObject::ASTEROID, SkyObject::COMET };
+    const QList<int> last = { SkyObject::CONSTELLATION, SkyObject::STAR, SkyObject::CATALOG_STAR,
+                              SkyObject::SUPERNOVA, SkyObject::SATELLITE
+                            };
+    QList<int> types = solarSystem;
+    for (auto it = m_ObjectLists.cbegin(); it != m_ObjectLists.cend(); ++it)
+    {
+        if (!solarSystem.contains(it.key()) && !last.contains(it.key()))
+            types.append(it.key());
+    }
+    types << SkyObject::CONSTELLATION << SkyObject::STAR << SkyObject::CATALOG_STAR << SkyObject::SUPERNOVA;
+
+    for (int type : types)
+    {
+        for (const auto &entry : m_ObjectLists.value(type))
+            m_NameIndex.insert(entry.first, const_cast<SkyObject *>(entry.second));
+    }
+
+    qCDebug(KSTARS) << "Indexed" << m_NameIndex.size() << "object names in" << timer.elapsed() << "ms";
 }
 
 SkyObject *SkyMapComposite::findStarByGenetiveName(const QString name)
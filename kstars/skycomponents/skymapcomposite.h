@@ -7,7 +7,10 @@
 #pragma once
 
 #include "culturelist.h"
+#include "drawtimings.h"
+#include "renderquality.h"
 #include "ksnumbers.h"
+#include "nameindex.h"
 #include "skycomposite.h"
 #include "skylabeler.h"
 #include "skymesh.h"
@@ -136,8 +139,11 @@ class SkyMapComposite : public QObject, public SkyComposite
              *
              * The objects' primary, secondary and long-form names will
              * all be checked for a match.
-             * @note Overloaded from SkyComposite.  In this version, we search
-             * the most likely object classes first to be more efficient.
+             * @note Overloaded from SkyComposite.  In this version, names are
+             * first looked up in an index of all components, without case and
+             * white space, so "M 31" and "m31" match. Names not in the index
+             * are searched for in the most likely object classes first, and an
+             * exact match is then added to the index.
              * @p name the name to be matched
              * @p exact If true, it will return an exact match (default), otherwise it can return
              * a partial match.
@@ -153,6 +159,14 @@ class SkyMapComposite : public QObject, public SkyComposite
              */
         QList<SkyObject *> findObjectsInArea(const SkyPoint &p1, const SkyPoint &p2);
 
+        /**
+             * @return the list of objects in a circle of the sky
+             * @param center J2000 center of the circle
+             * @param radius radius of the circle in degrees
+             * @param stars whether stars are looked up too, or only the deep-sky catalogs
+             */
+        QList<SkyObject *> findObjectsInArea(const SkyPoint &center, double radius, bool stars = true);
+
         bool addNameLabel(SkyObject *o);
         bool removeNameLabel(SkyObject *o);
 
@@ -269,6 +283,18 @@ class SkyMapComposite : public QObject, public SkyComposite
         {
             return m_StarHopRouteList;
         }
+
+        /** @return the times spent on each part of the last frames */
+        DrawTimings &drawTimings()
+        {
+            return m_DrawTimings;
+        }
+
+        /** @return the quality the frame being drawn is drawn in */
+        const RenderQuality &renderQuality() const
+        {
+            return m_RenderQuality;
+        }
     signals:
         void progressText(const QString &message);
 
@@ -276,6 +302,9 @@ class SkyMapComposite : public QObject, public SkyComposite
         QHash<int, QStringList> &getObjectNames() override;
         QHash<int, QVector<QPair<QString, const SkyObject *>>> &getObjectLists() override;
 
+        /** Fill the name index from the object lists, in the order findByName() searches the components */
+        void buildNameIndex();
+
         std::unique_ptr<CultureList> m_Cultures;
         ConstellationBoundaryLines *m_CBoundLines{ nullptr };
         ConstellationNamesComponent *m_CNames{ nullptr };
@@ -310,6 +339,9 @@ class SkyMapComposite : public QObject, public SkyComposite
         std::unique_ptr<SkyLabeler> m_skyLabeler;
 
         KSNumbers m_reindexNum;
+        DrawTimings m_DrawTimings;
+        RenderQuality m_RenderQuality;
+        NameIndex m_NameIndex;
 
         QList<DeepStarComponent *> m_DeepStars;
 
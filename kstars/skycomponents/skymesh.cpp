@@ -67,7 +67,10 @@ void SkyMesh::aperture(SkyPoint *p0, double radius, MeshBufNum_t bufNum)
         p2.updateCoordsNow(data->updateNum());
     }
 
-    HTMesh::intersect(p1.ra().Degrees(), p1.dec().Degrees(), radius, (BufNum)bufNum);
+    // Every component drawing a frame asks for about the same aperture, and
+    // from one frame to the next it hardly moves.  Let the mesh keep its
+    // result as long as it covers the aperture.
+    HTMesh::intersectCircle(p1.ra().Degrees(), p1.dec().Degrees(), radius, 0.5, (BufNum)bufNum);
     m_drawID++;
 }
 
@@ -76,6 +79,11 @@ Trixel SkyMesh::index(const SkyPoint *p)
     return HTMesh::index(p->ra0().Degrees(), p->dec0().Degrees());
 }
 
+Trixel SkyMesh::indexNow(const SkyPoint *p)
+{
+    return HTMesh::index(p->ra().Degrees(), p->dec().Degrees());
+}
+
 Trixel SkyMesh::indexStar(StarObject *star)
 {
     double ra, dec;
@@ -323,3 +331,17 @@ const SkyRegion &SkyMesh::skyRegion(const SkyPoint &_p1, const SkyPoint &_p2)
     skylist.push_back(p4);
     return indexPoly(&skylist);
 }
+
+const SkyRegion &SkyMesh::skyRegion(const SkyPoint &center, double radius)
+{
+    indexHash.clear();
+
+    // The circle is indexed on the catalog positions, which is what index() takes as the current ones
+    SkyPoint p(center.ra0(), center.dec0());
+    index(&p, radius, OBJ_NEAREST_BUF);
+
+    MeshIterator region(this, OBJ_NEAREST_BUF);
+    while (region.hasNext())
+        indexHash[region.next()] = true;
+    return indexHash;
+}
@@ -33,6 +33,8 @@ enum MeshBufNum_t
     NO_PRECESS_BUF  = 1,
     OBJ_NEAREST_BUF = 2,
     IN_CONSTELL_BUF = 3,
+    PREFETCH_BUF    = 4,
+    POINT_INDEX_BUF = 5,
     NUM_MESH_BUF
 };
 
@@ -106,7 +108,9 @@ class SkyMesh : public HTMesh
          * precession.  The drawID also gets incremented which is useful for
          * drawing extended objects.  Typically a safety factor of about one
          * degree is added to the radius to account for proper motion,
-         * refraction and other imperfections.
+         * refraction and other imperfections.  The trixels may cover a
+         * slightly larger aperture, which lets consecutive calls with about
+         * the same aperture reuse the previous result.
          *@param center Center of the aperture
          *@param radius Radius of the aperture in degrees
          *@param bufNum Buffer to use
@@ -118,6 +122,11 @@ class SkyMesh : public HTMesh
          */
     Trixel index(const SkyPoint *p);
 
+    /** @short returns the index of the trixel containing the current
+         * position of p, rather than its catalogue position.
+         */
+    Trixel indexNow(const SkyPoint *p);
+
     /**
          * @short returns the sky region needed to cover the rectangle defined by two
          * SkyPoints p1 and p2
@@ -126,6 +135,13 @@ class SkyMesh : public HTMesh
          */
     const SkyRegion &skyRegion(const SkyPoint &p1, const SkyPoint &p2);
 
+    /**
+         * @short returns the sky region needed to cover a circle
+         * @param center J2000 center of the circle
+         * @param radius radius of the circle in degrees
+         */
+    const SkyRegion &skyRegion(const SkyPoint &center, double radius);
+
     /** @name Stars and CLines
         Routines used for indexing stars and CLines.
         The following four routines are used for indexing stars and CLines.
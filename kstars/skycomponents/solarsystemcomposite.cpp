@@ -14,6 +14,7 @@
 #include "skymap.h"
 #endif
 #include "solarsystemsinglecomponent.h"
+#include "solarsystemtimelapse.h"
 #include "earthshadowcomponent.h"
 #include "skyobjects/ksmoon.h"
 #include "skyobjects/ksplanet.h"
@@ -70,6 +71,14 @@ SolarSystemComposite::SolarSystemComposite(SkyComposite *parent) : SkyComposite(
     m_planets.append(uranus);
     m_planets.append(nep);
 
+    QList<KSPlanetBase *> fitted;
+    for (SolarSystemSingleComponent *planet : m_planets)
+    {
+        if (planet->planet() != m_Moon)
+            fitted.append(planet->planet());
+    }
+    m_TimeLapse.reset(new SolarSystemTimeLapse(fitted));
+
     /*m_planetObjects.append(sun->planet());
     m_planetObjects.append(moon->planet());
     m_planetObjects.append(mercury->planet());
@@ -123,6 +132,7 @@ void SolarSystemComposite::update(KSNumbers *num)
 
 void SolarSystemComposite::updateSolarSystemBodies(KSNumbers *num)
 {
+    m_TimeLapse->update(num->julianDay());
     m_Earth->findPosition(num);
     foreach (SkyComponent *comp, components())
     {
@@ -150,11 +160,13 @@ void SolarSystemComposite::drawTrails(SkyPainter *skyp)
 
 const QList<SkyObject *> &SolarSystemComposite::asteroids() const
 {
+    m_AsteroidsComponent->loadDataIfNeeded();
     return m_AsteroidsComponent->objectList();
 }
 
 const QList<SkyObject *> &SolarSystemComposite::comets() const
 {
+    m_CometsComponent->loadDataIfNeeded();
     return m_CometsComponent->objectList();
 }
 
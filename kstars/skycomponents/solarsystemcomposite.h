@@ -9,6 +9,8 @@
 #include "planetmoonscomponent.h"
 #include "skycomposite.h"
 
+#include <memory>
+
 class AsteroidsComponent;
 class CometsComponent;
 class KSMoon;
@@ -17,6 +19,7 @@ class KSSun;
 //class JupiterMoonsComponent;
 class SkyLabeler;
 class KSEarthShadow;
+class SolarSystemTimeLapse;
 /**
  * @class SolarSystemComposite
  * The solar system composite manages all planets, asteroids and comets.
@@ -62,6 +65,9 @@ class SolarSystemComposite : public SkyComposite
 
     const QList<SolarSystemSingleComponent *> &planets() const;
 
+    /** @return the positions of the Sun and planets fitted ahead of a fast clock */
+    SolarSystemTimeLapse *timeLapse() { return m_TimeLapse.get(); }
+
   private:
     KSPlanet *m_Earth { nullptr };
     KSSun *m_Sun { nullptr };
@@ -74,4 +80,5 @@ class SolarSystemComposite : public SkyComposite
     QList<SolarSystemSingleComponent *> m_planets;
     QList<SkyObject *> m_planetObjects;
     QList<SkyObject *> m_moons;
+    std::unique_ptr<SolarSystemTimeLapse> m_TimeLapse;
 };
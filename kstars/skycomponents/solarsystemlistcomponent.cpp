@@ -18,6 +18,7 @@
 #include <KLocalizedString>
 
 #include <QPen>
+#include <QtConcurrent>
 
 SolarSystemListComponent::SolarSystemListComponent(SolarSystemComposite *p) : ListComponent(p), m_Earth(p->earth())
 {
@@ -46,19 +47,45 @@ void SolarSystemListComponent::update(KSNumbers *)
 
 void SolarSystemListComponent::updateSolarSystemBodies(KSNumbers *num)
 {
-    if (selected())
+    if (!selected())
+        return;
+
+    KStarsData *data = KStarsData::Instance();
+    const CachingDms *lat = data->geo()->lat();
+    const CachingDms *lst = data->lst();
+
+    QVector<KSPlanetBase *> bodies;
+    bodies.reserve(m_ObjectList.size());
+    for (SkyObject *o : m_ObjectList)
     {
-        KStarsData *data = KStarsData::Instance();
-        foreach (SkyObject *o, m_ObjectList)
-        {
-            KSPlanetBase *p = (KSPlanetBase *)o;
-            p->findPosition(num, data->geo()->lat(), data->lst(), m_Earth);
-            p->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+        KSPlanetBase *p = static_cast<KSPlanetBase *>(o);
+        if (!toUpdate(p, num))
+            continue;
 
-            if (p->hasTrail())
-                p->updateTrail(data->lst(), data->geo()->lat());
+        // Trails are few and not to be extended from several threads at once
+        if (p->hasTrail())
+        {
+            p->findPosition(num, lat, lst, m_Earth);
+            p->EquatorialToHorizontal(lst, lat);
+            p->updateTrail(lst, lat);
         }
+        else
+            bodies.append(p);
     }
+
+    // Each body only reads the Earth and the shared time-dependent values
+    QtConcurrent::blockingMap(bodies, [&](KSPlanetBase *p)
+    {
+        p->findPosition(num, lat, lst, m_Earth);
+        p->EquatorialToHorizontal(lst, lat);
+    });
+
+    m_PointIndex.build(m_ObjectList);
+}
+
+bool SolarSystemListComponent::toUpdate(KSPlanetBase *, const KSNumbers *)
+{
+    return true;
 }
 
 void SolarSystemListComponent::drawTrails(SkyPainter *skyp)
@@ -9,6 +9,7 @@
 #include "listcomponent.h"
 
 class KSPlanet;
+class KSPlanetBase;
 class SolarSystemComposite;
 
 /**
@@ -38,6 +39,16 @@ class SolarSystemListComponent : public ListComponent
   protected:
     void drawTrails(SkyPainter *skyp) override;
 
+    /**
+     * @short Whether updateSolarSystemBodies() is to compute the position of @p body now.
+     *
+     * Reimplement this to leave out bodies which could not be drawn anyway. The default
+     * updates all of them.
+     * @p body the body to be updated
+     * @p num the time-dependent values for the update
+     */
+    virtual bool toUpdate(KSPlanetBase *body, const KSNumbers *num);
+
   private:
     KSPlanet *m_Earth { nullptr };
 };
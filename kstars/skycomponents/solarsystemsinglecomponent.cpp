@@ -5,7 +5,9 @@
 */
 
 #include "solarsystemsinglecomponent.h"
+#include "nameindex.h"
 #include "solarsystemcomposite.h"
+#include "solarsystemtimelapse.h"
 #include "skycomponent.h"
 #include <KLocalizedString>
 
@@ -47,6 +49,7 @@ SolarSystemSingleComponent::~SolarSystemSingleComponent()
 {
     removeFromNames(m_Planet);
     removeFromLists(m_Planet);
+    NameIndex::invalidate();
     delete m_Planet;
 }
 
@@ -88,7 +91,7 @@ void SolarSystemSingleComponent::updateSolarSystemBodies(KSNumbers *num)
     if (!m_isMoon && selected())
     {
         KStarsData *data = KStarsData::Instance();
-        m_Planet->findPosition(num, data->geo()->lat(), data->lst(), m_Earth);
+        findPosition(num, data->geo()->lat(), data->lst());
         m_Planet->EquatorialToHorizontal(data->lst(), data->geo()->lat());
         if (m_Planet->hasTrail())
             m_Planet->updateTrail(data->lst(), data->geo()->lat());
@@ -101,12 +104,20 @@ void SolarSystemSingleComponent::updateSolarSystemBodies(KSNumbers *num)
 void SolarSystemSingleComponent::updateMoons(KSNumbers *num)
 {
     KStarsData *data = KStarsData::Instance();
-    m_Planet->findPosition(num, data->geo()->lat(), data->lst(), m_Earth);
+    findPosition(num, data->geo()->lat(), data->lst());
     m_Planet->EquatorialToHorizontal(data->lst(), data->geo()->lat());
     if (m_Planet->hasTrail())
         m_Planet->updateTrail(data->lst(), data->geo()->lat());
 }
 
+void SolarSystemSingleComponent::findPosition(KSNumbers *num, const CachingDms *lat, const CachingDms *LST)
+{
+    // A fast running clock reads the position from the fit when there is one
+    SolarSystemTimeLapse *timeLapse = static_cast<SolarSystemComposite *>(parent())->timeLapse();
+    if (!timeLapse->findPosition(m_Planet, num, lat, LST))
+        m_Planet->findPosition(num, lat, LST, m_Earth);
+}
+
 void SolarSystemSingleComponent::draw(SkyPainter *skyp)
 {
     if (!selected())
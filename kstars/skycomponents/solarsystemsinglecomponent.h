@@ -19,6 +19,7 @@
 
 #include "skycomponent.h"
 
+class CachingDms;
 class SolarSystemComposite;
 class KSNumbers;
 class KSPlanet;
@@ -67,6 +68,9 @@ class SolarSystemSingleComponent : public SkyComponent
         void drawTrails(SkyPainter *skyp) override;
 
     private:
+        // Find the position of the planet, from the time lapse if it has it
+        void findPosition(KSNumbers *num, const CachingDms *lat, const CachingDms *LST);
+
         bool (*visible)();
         bool m_isMoon { false };
         QColor m_Color;
@@ -0,0 +1,123 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "solarsystemtimelapse.h"
+
+#include "kstarsdata.h"
+#include "kstarsdatetime.h"
+#include "ksnumbers.h"
+#include "Options.h"
+#include "skyobjects/ksplanetbase.h"
+
+#include <KLocalizedString>
+
+#include <QtConcurrent>
+
+#include <cmath>
+
+SolarSystemTimeLapse::SolarSystemTimeLapse(const QList<KSPlanetBase *> &bodies) : m_Bodies(bodies)
+{
+}
+
+SolarSystemTimeLapse::~SolarSystemTimeLapse()
+{
+    m_Next.waitForFinished();
+}
+
+bool SolarSystemTimeLapse::isWanted()
+{
+    return Options::timeLapse() && std::abs(KStarsData::Instance()->clock()->scale()) >= MIN_SCALE;
+}
+
+void SolarSystemTimeLapse::update(long double jd)
+{
+    if (!isWanted())
+    {
+        clear();
+        return;
+    }
+
+    if (m_Fitting && m_Next.isFinished())
+    {
+        m_Batch = m_Next.result();
+        m_Next = QFuture<QSharedPointer<Batch>>();
+        m_Fitting = false;
+    }
+
+    if (m_Fitting)
+        return;
+
+    const bool forward = KStarsData::Instance()->clock()->scale() > 0;
+    const long double half = forward ? WINDOW / 2 : -WINDOW / 2;
+    if (!m_Batch || !m_Batch->contains(jd) || !m_Batch->contains(jd + half))
+        fit(jd, forward);
+}
+
+void SolarSystemTimeLapse::fit(long double jd, bool forward)
+{
+    QSharedPointer<Batch> batch(new Batch);
+    batch->start = jd;
+    batch->stop = forward ? jd + WINDOW : jd - WINDOW;
+    for (KSPlanetBase *body : m_Bodies)
+    {
+        std::unique_ptr<KSPlanetBase> copy(static_cast<KSPlanetBase *>(body->clone()));
+        copy->clearTrail();
+        batch->copies.push_back(std::move(copy));
+    }
+    batch->ephemerides.resize(batch->copies.size());
+
+    m_Fitting = true;
+    m_Next = QtConcurrent::run([batch]()
+    {
+        const long double start = std::min(batch->start, batch->stop);
+        const long double stop = std::max(batch->start, batch->stop);
+        for (size_t i = 0; i < batch->copies.size(); i++)
+            batch->ephemerides[i].fit(*batch->copies[i], start, stop);
+        return batch;
+    });
+}
+
+void SolarSystemTimeLapse::clear()
+{
+    // A fit still running is left to finish, it is taken up or replaced when the clock speeds up again
+    m_Batch.reset();
+    m_LastFullUpdate.clear();
+}
+
+bool SolarSystemTimeLapse::findPosition(KSPlanetBase *body, const KSNumbers *num, const CachingDms *lat,
+                                        const CachingDms *LST)
+{
+    const long double jd = num->julianDay();
+    if (!m_Batch || !m_Batch->contains(jd))
+        return false;
+
+    // The fits are in the same order as the bodies
+    const int index = m_Bodies.indexOf(body);
+    if (index < 0)
+        return false;
+    const KSEphemeris &ephemeris = m_Batch->ephemerides[index];
+    if (!ephemeris.contains(jd))
+        return false;
+
+    auto last = m_LastFullUpdate.find(body);
+    if (last == m_LastFullUpdate.end() || std::abs(static_cast<double>(jd - last.value())) > FULL_UPDATE_PERIOD)
+    {
+        m_LastFullUpdate[body] = jd;
+        return false;
+    }
+
+    const double rearth = ephemeris.position(jd, body, lat, LST);
+    body->setRearth(rearth);
+    body->setAngularSize(asin(body->physicalSize() / rearth / AU_KM) * 60. * 180. / dms::PI);
+
+    if (body->hasTrail())
+    {
+        body->addToTrail(KStarsDateTime(num->getJD()).toString("yyyy.MM.dd hh:mm") + i18nc("Universal time", "UT"));
+        if (body->trail().size() > TrailObject::MaxTrail)
+            body->clipTrail();
+    }
+    return true;
+}
@@ -0,0 +1,89 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "skyobjects/ksephemeris.h"
+
+#include <QFuture>
+#include <QHash>
+#include <QList>
+#include <QSharedPointer>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+class CachingDms;
+class KSNumbers;
+class KSPlanetBase;
+
+/**
+ * @class SolarSystemTimeLapse
+ * @short Positions of the Sun and planets fitted ahead of a fast running clock.
+ *
+ * When the clock runs at MIN_SCALE or faster, the time lapse fits a KSEphemeris of each of
+ * its bodies over the next WINDOW days, in the direction the clock runs, on a worker thread.
+ * Until the fit is ready, and outside of it, the bodies are computed from their theory as
+ * usual. Inside it, a position is a polynomial evaluation, so high clock scales play smoothly.
+ * The next window is fitted once half of the current one has gone by.
+ *
+ * Phase, magnitude and the other quantities that only come from the theory still get a full
+ * computation every FULL_UPDATE_PERIOD days of simulated time.
+ */
+class SolarSystemTimeLapse
+{
+    public:
+        /** Clock scale, in seconds per second, from which the time lapse is used */
+        static constexpr double MIN_SCALE = 600;
+        /** Days fitted at once */
+        static constexpr double WINDOW = 2;
+        /** Days between full computations of a body */
+        static constexpr double FULL_UPDATE_PERIOD = 0.5;
+
+        explicit SolarSystemTimeLapse(const QList<KSPlanetBase *> &bodies);
+        ~SolarSystemTimeLapse();
+
+        /** @return true if the clock runs fast enough for the time lapse, and the option asks for it */
+        static bool isWanted();
+
+        /**
+         * @brief update Follow the clock at @p jd: fit the next window if it is needed, or drop the
+         * fits when the time lapse is not wanted anymore
+         */
+        void update(long double jd);
+
+        /**
+         * @brief findPosition Set the position of @p body from the fit
+         * @return false if the fit does not cover @p num, or if the body is due for a full computation,
+         * which the caller then does with KSPlanetBase::findPosition()
+         */
+        bool findPosition(KSPlanetBase *body, const KSNumbers *num, const CachingDms *lat, const CachingDms *LST);
+
+    private:
+        struct Batch
+        {
+            long double start { 0 };
+            long double stop { 0 };
+            // Copies of the bodies, made on the main thread and fitted on a worker, and their fits
+            std::vector<std::unique_ptr<KSPlanetBase>> copies;
+            std::vector<KSEphemeris> ephemerides;
+
+            bool contains(long double jd) const
+            {
+                return jd >= std::min(start, stop) && jd <= std::max(start, stop);
+            }
+        };
+
+        void fit(long double jd, bool forward);
+        void clear();
+
+        QList<KSPlanetBase *> m_Bodies;
+        QSharedPointer<Batch> m_Batch;
+        QFuture<QSharedPointer<Batch>> m_Next;
+        bool m_Fitting { false };
+        QHash<const KSPlanetBase *, long double> m_LastFullUpdate;
+};
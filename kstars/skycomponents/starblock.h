@@ -135,8 +135,7 @@ class StarBlock
     float faintMag { 0 };
     float brightMag { 0 };
     StarBlockList *parent;
-    std::shared_ptr<StarBlock> prev;
-    std::shared_ptr<StarBlock> next;
+    /** The last draw cycle in which the block was used, see StarBlockFactory::markUsed() */
     quint32 drawID { 0 };
 
   private:
@@ -7,10 +7,14 @@
 #include "starblockfactory.h"
 
 #include "starblock.h"
+#include "starblocklist.h"
 #include "starobject.h"
+#include "auxiliary/memorybudget.h"
 
 #include <kstars_debug.h>
 
+#include <algorithm>
+
 // TODO: Implement a better way of deciding this
 #define DEFAULT_NCACHE 12
 
@@ -25,16 +29,26 @@ StarBlockFactory *StarBlockFactory::Instance()
 
 StarBlockFactory::StarBlockFactory()
 {
-    first   = nullptr;
-    last    = nullptr;
-    nBlocks = 0;
+    hand    = 0;
     drawID  = 0;
     nCache  = DEFAULT_NCACHE;
+
+    // A block of the default size, with the stars it holds
+    const qint64 blockBytes = sizeof(StarBlock) + 100 * sizeof(StarBlock::StarBlockEntry);
+    MemoryBudget *budget    = MemoryBudget::Instance();
+    if (budget->isLimited())
+        nMax = std::max<qint64>(nCache, budget->share(MemoryBudget::STAR_BLOCKS) / blockBytes);
+
+    lowMemoryConnection = QObject::connect(budget, &MemoryBudget::lowMemory, [this]()
+    {
+        releaseUnused();
+    });
 }
 
 StarBlockFactory::~StarBlockFactory()
 {
-    deleteBlocks(nBlocks);
+    QObject::disconnect(lowMemoryConnection);
+    deleteBlocks(blocks.size());
     if (pInstance)
         pInstance = nullptr;
 }
@@ -43,266 +57,131 @@ std::shared_ptr<StarBlock> StarBlockFactory::getBlock()
 {
     std::shared_ptr<StarBlock> freeBlock;
 
-    if (nBlocks < nCache)
+    // Sweep the cache from where the last call stopped, so that blocks get a full turn
+    // of the hand to be used again before they are recycled
+    for (int i = 0; blocks.size() >= nCache && i < blocks.size(); ++i)
     {
-        freeBlock.reset(new StarBlock);
-        if (freeBlock.get())
-        {
-            ++nBlocks;
-            return freeBlock;
-        }
-    }
-    if (last && (last->drawID != drawID || last->drawID == 0))
-    {
-        //        qCDebug(KSTARS) << "Recycling block with drawID =" << last->drawID << "and current drawID =" << drawID;
-        if (last->parent->block(last->parent->getBlockCount() - 1) != last)
-            qCDebug(KSTARS) << "ERROR: Goof up here!";
-        freeBlock = last;
-        last      = last->prev;
-        if (last)
-        {
-            last->next = nullptr;
-        }
-        if (freeBlock == first)
+        StarBlock *block = blocks.at(hand).get();
+        const int index  = hand;
+        hand             = (hand + 1) % blocks.size();
+
+        if (!isUnused(block))
+            continue;
+
+        // Blocks are marked from the first one of their list on, and only the last one
+        // can be released, so take that one. It may have been filled in this cycle since.
+        StarBlockList *list = block->parent;
+        if (list)
         {
-            first = nullptr;
+            freeBlock = list->block(list->getBlockCount() - 1);
+            if (!isUnused(freeBlock.get()))
+                continue;
         }
+        else
+            freeBlock = blocks.at(index);
+
+        //        qCDebug(KSTARS) << "Recycling block with drawID =" << freeBlock->drawID << "and current drawID =" << drawID;
         freeBlock->reset();
-        freeBlock->prev = nullptr;
-        freeBlock->next = nullptr;
         return freeBlock;
     }
+
+    // Fainter stars are left out rather than going over the budget
+    if (nMax > 0 && blocks.size() >= nMax && releaseUnused(nMax - 1) == 0)
+        return freeBlock;
+
     freeBlock.reset(new StarBlock);
     if (freeBlock.get())
-        ++nBlocks;
+        blocks.append(freeBlock);
 
     return freeBlock;
 }
 
-bool StarBlockFactory::markFirst(std::shared_ptr<StarBlock>& block)
-{
-    if (!block.get())
-        return false;
-
-    //    fprintf(stderr, "markFirst()!\n");
-    if (!first)
-    {
-        //        qCDebug(KSTARS) << "INFO: Linking in first block";
-        last = first = block;
-        first->prev = first->next = nullptr;
-        first->drawID             = drawID;
-        return true;
-    }
-
-    if (block == first) // Block is already in the front
-    {
-        block->drawID = drawID;
-        return true;
-    }
-
-    if (block == last)
-        last = block->prev;
-
-    if (block->prev)
-        block->prev->next = block->next;
-
-    if (block->next)
-        block->next->prev = block->prev;
-
-    first->prev = block;
-    block->next = first;
-    block->prev = nullptr;
-    first       = block;
-
-    block->drawID = drawID;
-
-    return true;
-}
-
-bool StarBlockFactory::markNext(std::shared_ptr<StarBlock>& after, std::shared_ptr<StarBlock>& block)
+int StarBlockFactory::deleteBlocks(int nblocks)
 {
-    //    fprintf(stderr, "markNext()!\n");
-    if (!block.get() || !after.get())
-    {
-        qCDebug(KSTARS) << "WARNING: markNext called with nullptr argument";
-        return false;
-    }
-
-    if (!first.get())
-    {
-        qCDebug(KSTARS) << "WARNING: markNext called without an existing linked list";
-        return false;
-    }
-
-    if (block == after)
-    {
-        qCDebug(KSTARS) << "ERROR: Trying to mark a block after itself!";
-        return false;
-    }
-
-    if (block->prev == after) // Block is already after 'after'
-    {
-        block->drawID = drawID;
-        return true;
-    }
+    int i = 0;
 
-    if (block == first)
+    // The StarBlockLists keep the blocks they hold, we only stop recycling them
+    for (int pass = 0; pass < 2; ++pass)
     {
-        if (block->next == nullptr)
+        for (int j = blocks.size() - 1; j >= 0 && i != nblocks; --j)
         {
-            qCDebug(KSTARS) << "ERROR: Trying to mark only block after some other block";
-            return false;
+            if (pass == 0 && !isUnused(blocks.at(j).get()))
+                continue;
+            blocks.remove(j);
+            i++;
         }
-        first = block->next;
-    }
-
-    if (after->getFaintMag() > block->getFaintMag() && block->getFaintMag() != -5)
-    {
-        qCDebug(KSTARS) << "WARNING: Marking block with faint mag = " << block->getFaintMag() << " after block with faint mag "
-                 << after->getFaintMag() << "in trixel" << block->parent->getTrixel();
     }
+    hand = 0;
 
-    if (block == last)
-        last = block->prev;
-
-    if (block->prev)
-        block->prev->next = block->next;
-    if (block->next)
-        block->next->prev = block->prev;
-
-    block->next = after->next;
-    if (block->next)
-        block->next->prev = block;
-    block->prev = after;
-    after->next = block;
-
-    if (after == last)
-        last = block;
-
-    block->drawID = drawID;
+    qCDebug(KSTARS) << nblocks << "StarBlocks freed from StarBlockFactory";
 
-    return true;
+    return i;
 }
 
-/*
-bool StarBlockFactory::groupMove( StarBlock *start, const int nblocks ) {
-
-    StarBlock * end = nullptr;
-
-    // Check for trivial cases
-    if( !start || nblocks < 0 )
-        return false;
-
-    if( nblocks == 0 )
-        return true;
-
-    if( !first )
-        return false;
+void StarBlockFactory::printStructure() const
+{
+    int drawn = 0;
 
-    // Check for premature end
-    end = start;
-    for( int i = 1; i < nblocks; ++i ) {
-        if( end == nullptr )
-            return false;
-        end = end->next;
-    }
-    if( end == nullptr )
-        return false;
-
-    // Update drawIDs
-    end = start;
-    for( int i = 1; i < nblocks; ++i ) {
-        end->drawID = drawID;
-        end = end->next;
+    for (const auto &block : blocks)
+    {
+        if (!isUnused(block.get()))
+            ++drawn;
+        if (block->parent)
+            qCDebug(KSTARS) << "Block in trixel" << block->parent->getTrixel() << "with faint mag" << block->getFaintMag()
+                            << "last drawn in cycle" << block->drawID;
     }
-    end->drawID = drawID;
-
-    // Check if we are already in the front
-    if( !start->prev )
-        return true;
-
-    start->prev->next = end->next;
-    end->next->prev = start->prev;
-
-    first->prev = end;
-    end->next = first;
-    start->prev = nullptr;
-    first = start;
+    qCDebug(KSTARS) << drawn << "of" << blocks.size() << "blocks are drawn in cycle" << drawID << ", the hand is at" << hand;
 }
-*/
 
-int StarBlockFactory::deleteBlocks(int nblocks)
+int StarBlockFactory::freeUnused()
 {
-    int i           = 0;
-    std::shared_ptr<StarBlock> temp;
+    int i = 0;
 
-    while (last != nullptr && i != nblocks)
+    for (int j = blocks.size() - 1; j >= 0; --j)
     {
-        temp = last->prev;
-        last.reset();
-        last = temp;
-        i++;
+        if (blocks.at(j)->drawID < drawID)
+        {
+            blocks.remove(j);
+            i++;
+        }
     }
-    if (last)
-        last->next = nullptr;
-    else
-        first = nullptr;
+    hand = 0;
 
-    qCDebug(KSTARS) << nblocks << "StarBlocks freed from StarBlockFactory";
+    qCDebug(KSTARS) << i << "StarBlocks freed from StarBlockFactory";
 
-    nBlocks -= i;
     return i;
 }
 
-void StarBlockFactory::printStructure() const
+int StarBlockFactory::releaseUnused(int keep)
 {
-    std::shared_ptr<StarBlock> cur;
-    Trixel curTrixel = 513; // TODO: Change if we change HTMesh level
-    int index        = 0;
-    bool draw        = false;
+    int released = 0;
 
-    cur = first;
-    do
+    // A block can only leave its StarBlockList from the end, so the lists are trimmed
+    // from behind until none of them ends with an unused block
+    bool progress = true;
+    while (progress && blocks.size() > keep)
     {
-        if (curTrixel != cur->parent->getTrixel())
-        {
-            qCDebug(KSTARS) << "Trixel" << cur->parent->getTrixel() << "starts at index" << index;
-            curTrixel = cur->parent->getTrixel();
-        }
-        if (cur->drawID == drawID && !draw)
+        progress = false;
+        for (int j = blocks.size() - 1; j >= 0 && blocks.size() > keep; --j)
         {
-            qCDebug(KSTARS) << "Blocks from index" << index << "are drawn";
-            draw = true;
+            StarBlock *block = blocks.at(j).get();
+            if (!isUnused(block))
+                continue;
+
+            StarBlockList *list = block->parent;
+            if (list && list->block(list->getBlockCount() - 1).get() != block)
+                continue;
+
+            block->reset();
+            blocks.remove(j);
+            ++released;
+            progress = true;
         }
-        if (cur->drawID != drawID && draw)
-        {
-            qCDebug(KSTARS) << "Blocks from index" << index << "are not drawn";
-            draw = false;
-        }
-        cur = cur->next;
-        ++index;
-    } while (cur != last);
-}
-
-int StarBlockFactory::freeUnused()
-{
-    int i           = 0;
-    std::shared_ptr<StarBlock> temp;
-
-    while (last != nullptr && last->drawID < drawID && i != nBlocks)
-    {
-        temp = last->prev;
-        last.reset();
-        last = temp;
-        i++;
     }
-    if (last)
-        last->next = nullptr;
-    else
-        first = nullptr;
+    hand = 0;
 
-    qCDebug(KSTARS) << i << "StarBlocks freed from StarBlockFactory";
+    if (released > 0)
+        qCDebug(KSTARS) << released << "StarBlocks released from their trixels";
 
-    nBlocks -= i;
-    return i;
+    return released;
 }
@@ -7,15 +7,21 @@
 #pragma once
 
 #include "typedef.h"
+#include "starblock.h"
 
-class StarBlock;
+#include <QMetaObject>
+#include <QVector>
 
 /**
  * @class StarBlockFactory
  *
- * @short A factory that creates StarBlocks and recycles them in an LRU Cache
+ * @short A factory that creates StarBlocks and recycles them in a CLOCK cache
+ *
+ * Marking a block as used in a draw cycle only stamps it with the drawID, so that the
+ * blocks on screen can be marked every frame without reordering any list.
+ *
  * @author Akarsh Simha
- * @version 0.1
+ * @version 0.2
  */
 
 class StarBlockFactory
@@ -25,52 +31,42 @@ class StarBlockFactory
 
     /**
      * Destructor
-     * Deletes the linked list that maintains the Cache, sets the pointer to nullptr
+     * Drops the cache, sets the pointer to nullptr
      */
     ~StarBlockFactory();
 
     /**
      * @short  Return a StarBlock available for use
      *
-     * This method first checks if there are any cached StarBlocks that are not in use.
-     * If such a StarBlock is found, it returns the same for use. Else it freshly allocates
-     * a StarBlock and returns the same. It also moves the StarBlock to the front, marking it
-     * as the most recently used. If the StarBlock had a parent StarBlockList, this method
-     * detaches the StarBlock from the StarBlockList
+     * This method allocates new StarBlocks until the cache holds enough of them. From then
+     * on, it sweeps the cache for a StarBlock not used in the current draw cycle and returns
+     * it for use, allocating a new one only if all of them are in use. If the StarBlock had a
+     * parent StarBlockList, this method detaches the StarBlock from the StarBlockList
      *
-     * @return A StarBlock that is available for use
+     * @return A StarBlock that is available for use, or nullptr if all blocks are in use and the
+     * memory budget has no room for another one
      */
     std::shared_ptr<StarBlock> getBlock();
 
     /**
-     * @short  Mark a StarBlock as most recently used and sync its drawID with the current drawID
-     *
-     * @return true on success, false if the StarBlock supplied was not on our list at all
+     * @short  Mark a StarBlock as used in the current draw cycle, so that getBlock() won't recycle it
+     * @note   Only the last block of a StarBlockList can be recycled, so mark the blocks of a list
+     * from its first block on.
      */
-    bool markFirst(std::shared_ptr<StarBlock>& block);
-
-    /**
-     * @short  Rank a given StarBlock after another given StarBlock in the LRU list
-     * and sync its drawID with the current drawID
-     *
-     * @param  after  The block after which 'block' should be put
-     * @param  block  The block to mark for use
-     * @return true on success, false on failure
-     */
-    bool markNext(std::shared_ptr<StarBlock>& after, std::shared_ptr<StarBlock>& block);
+    inline void markUsed(StarBlock *block) { block->drawID = drawID; }
 
     /**
      * @short  Returns the number of StarBlocks currently produced
      *
      * @return Number of StarBlocks currently allocated
      */
-    inline int getBlockCount() const { return nBlocks; }
+    inline int getBlockCount() const { return blocks.size(); }
 
     /**
      * @short  Frees all StarBlocks that are in the cache
      * @return The number of StarBlocks freed
      */
-    inline int freeAll() { return deleteBlocks(nBlocks); }
+    inline int freeAll() { return deleteBlocks(blocks.size()); }
 
     /**
      * @short  Frees all StarBlocks that are not used in this draw cycle
@@ -78,6 +74,14 @@ class StarBlockFactory
      */
     int freeUnused();
 
+    /**
+     * @short  Releases the blocks not used in this draw cycle from their StarBlockLists, so their
+     * memory is freed. Called when the device runs low on memory.
+     * @param  keep  Number of blocks to keep at least
+     * @return The number of StarBlocks released
+     */
+    int releaseUnused(int keep = 0);
+
     /**
      * @short  Prints the structure of the cache, for debugging
      */
@@ -88,21 +92,26 @@ class StarBlockFactory
   private:
     /**
      * Constructor
-     * Initializes first and last StarBlock pointers to nullptr
+     * Initializes an empty cache
      */
     StarBlockFactory();
 
+    /** @return true if the block may be recycled, i.e. is not used in the current draw cycle */
+    inline bool isUnused(const StarBlock *block) const { return block->drawID != drawID || block->drawID == 0; }
+
     /**
-     * @short  Deletes the N least recently used blocks
+     * @short  Drops N blocks from the cache, those not used in this draw cycle first
      *
      * @param  nblocks  Number of blocks to delete
      * @return Number of blocks successfully deleted
      */
     int deleteBlocks(int nblocks);
 
-    std::shared_ptr<StarBlock> first, last; // Pointers to the beginning and end of the linked list
-    int nBlocks;             // Number of blocks we currently have in the cache
+    QVector<std::shared_ptr<StarBlock>> blocks; // All the blocks we currently have in the cache
+    int hand;                // Index in blocks at which getBlock() resumes looking for an unused block
     int nCache;              // Number of blocks to start recycling cached blocks at
+    int nMax { 0 };          // Number of blocks the memory budget has room for, 0 if unlimited
+    QMetaObject::Connection lowMemoryConnection;
 
     static StarBlockFactory *pInstance;
 };
@@ -18,6 +18,10 @@
 
 #include <QDebug>
 
+#include <cstring>
+
+#include <kstars_debug.h>
+
 StarBlockList::StarBlockList(const Trixel &tr, DeepStarComponent *parent)
 {
     trixel       = tr;
@@ -59,6 +63,15 @@ int StarBlockList::releaseBlock(StarBlock *block)
     return 0;
 }
 
+int StarBlockList::readMappedRecord(const BinFileHelper *reader, void *record, int size) const
+{
+    const uchar *data = reader->mappedRecord(readOffset, size);
+    if (!data)
+        return 0;
+    memcpy(record, data, size);
+    return 1;
+}
+
 bool StarBlockList::fillToMag(float maglim)
 {
     // TODO: Remove staticity of BinFileHelper
@@ -92,7 +105,10 @@ bool StarBlockList::fillToMag(float maglim)
 
     Q_ASSERT(nBlocks == (unsigned int)blocks.size());
 
-    BinFileHelper::unsigned_KDE_fseek(dataFile, readOffset, SEEK_SET);
+    // Records of a mapped file are copied from memory, the OS paging in the parts of the file we need
+    const bool mapped = dSReader->isMapped();
+    if (!mapped)
+        BinFileHelper::unsigned_KDE_fseek(dataFile, readOffset, SEEK_SET);
 
     /*
     qDebug() << Q_FUNC_INFO << "Reading trixel" << trixel << ", id on disk =" << trixelId << ", currently nStars =" << nStars
@@ -110,23 +126,26 @@ bool StarBlockList::fillToMag(float maglim)
 
             if (!newBlock.get())
             {
-                qWarning() << "ERROR: Could not get a new block from StarBlockFactory::getBlock() in trixel " << trixel
-                           << ", while trying to create block #" << nBlocks + 1;
+                // The memory budget has no room for more blocks
+                qCDebug(KSTARS) << "Could not get a new block from StarBlockFactory::getBlock() in trixel" << trixel
+                                << ", while trying to create block #" << nBlocks + 1;
                 return false;
             }
             blocks.append(newBlock);
             blocks[nBlocks]->parent = this;
-            if (nBlocks == 0)
-                SBFactory->markFirst(blocks[0]);
-            else if (!SBFactory->markNext(blocks[nBlocks - 1], blocks[nBlocks]))
-                qWarning() << "ERROR: markNext() failed on block #" << nBlocks + 1 << "in trixel" << trixel;
+            SBFactory->markUsed(newBlock.get());
 
             ++nBlocks;
         }
         // TODO: Make this more general
         if (dSReader->guessRecordSize() == 32)
         {
-            ret = fread(&stardata, sizeof(StarData), 1, dataFile);
+            if (mapped)
+                ret = readMappedRecord(dSReader, &stardata, sizeof(StarData));
+            else
+                ret = fread(&stardata, sizeof(StarData), 1, dataFile);
+            if (ret != 1)
+                return false;
             if (dSReader->getByteSwap())
                 DeepStarComponent::byteSwap(&stardata);
             readOffset += sizeof(StarData);
@@ -134,7 +153,12 @@ bool StarBlockList::fillToMag(float maglim)
         }
         else
         {
-            ret = fread(&deepstardata, sizeof(DeepStarData), 1, dataFile);
+            if (mapped)
+                ret = readMappedRecord(dSReader, &deepstardata, sizeof(DeepStarData));
+            else
+                ret = fread(&deepstardata, sizeof(DeepStarData), 1, dataFile);
+            if (ret != 1)
+                return false;
             if (dSReader->getByteSwap())
                 DeepStarComponent::byteSwap(&deepstardata);
             readOffset += sizeof(DeepStarData);
@@ -154,6 +178,22 @@ bool StarBlockList::fillToMag(float maglim)
     return ((maglim < faintMag) ? true : false);
 }
 
+bool StarBlockList::pendingRange(float maglim, quint64 *offset, quint64 *size) const
+{
+    const BinFileHelper *dSReader = parent->getStarReader();
+
+    if (staticStars || faintMag >= maglim)
+        return false;
+
+    const unsigned long recordCount = dSReader->getRecordCount(trixel);
+    if (nStars >= recordCount)
+        return false;
+
+    *offset = (readOffset <= 0) ? dSReader->getOffset(trixel) : readOffset;
+    *size   = (recordCount - nStars) * dSReader->guessRecordSize();
+    return true;
+}
+
 void StarBlockList::setStaticBlock(std::shared_ptr<StarBlock> &block)
 {
     if (!block)
@@ -8,6 +8,7 @@
 
 #include "typedef.h"
 
+class BinFileHelper;
 class DeepStarComponent;
 class StarBlock;
 
@@ -37,6 +38,16 @@ class StarBlockList
      */
     bool fillToMag(float maglim);
 
+    /**
+     * @short Locates the part of the catalog file that fillToMag() has yet to read for this trixel
+     *
+     * @param maglim Magnitude limit that would be passed to fillToMag()
+     * @param offset Set to the file offset of the first unread record
+     * @param size Set to the size in bytes of the unread records
+     * @return false if fillToMag(maglim) would not read anything
+     */
+    bool pendingRange(float maglim, quint64 *offset, quint64 *size) const;
+
     /**
      * @short Sets the first StarBlock in the list to point to the given StarBlock
      *
@@ -93,6 +104,12 @@ class StarBlockList
     inline Trixel getTrixel() const { return trixel; }
 
   private:
+    /**
+     * @short  Copy the record at readOffset of the mapped catalog file
+     * @return 1 if the record was read, 0 if it is past the end of the file, like fread()
+     */
+    int readMappedRecord(const BinFileHelper *reader, void *record, int size) const;
+
     Trixel trixel;
     unsigned long nStars { 0 };
     long readOffset { 0 };
@@ -17,6 +17,7 @@
 #include "Options.h"
 #include "skylabeler.h"
 #include "skymap.h"
+#include "skymapcomposite.h"
 #include "skymesh.h"
 #ifndef KSTARS_LITE
 #include "skyqpainter.h"
@@ -27,6 +28,7 @@
 #include "kstars_debug.h"
 
 #include <qplatformdefs.h>
+#include <QtConcurrent>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -260,7 +262,8 @@ void StarComponent::draw(SkyPainter *skyp)
     UpdateID updateID     = data->updateID();
 
     bool checkSlewing = (map->isSlewing() && Options::hideOnSlew());
-    m_hideLabels      = checkSlewing || !(Options::showStarMagnitudes() || Options::showStarNames());
+    m_hideLabels      = checkSlewing || !data->skyComposite()->renderQuality().labels() ||
+                        !(Options::showStarMagnitudes() || Options::showStarNames());
 
     //shortcuts to inform whether to draw different objects
     bool hideFaintStars = checkSlewing && Options::hideStars();
@@ -303,35 +306,56 @@ void StarComponent::draw(SkyPainter *skyp)
     // If we are hiding faint stars, then maglim is really the brighter of hideStarsMag and maglim
     if (hideFaintStars && maglim > hideStarsMag)
         maglim = hideStarsMag;
+    // Frames too slow for the map to move smoothly draw fewer stars
+    maglim -= data->skyComposite()->renderQuality().starMagnitudeReduction();
 
     m_StarBlockFactory->drawID = m_skyMesh->drawID();
 
     int nTrixels = 0;
 
+    // Stars are sorted by magnitude, so each trixel in view gets the list of those bright enough
+    QVector<SkyPainter::StarDrawList> drawLists;
     while (region.hasNext())
     {
         ++nTrixels;
         Trixel currentRegion = region.next();
         StarList *starList   = m_starIndex->at(currentRegion);
 
+        SkyPainter::StarDrawList list;
         for (auto &star : *starList)
         {
             if (!star)
                 continue;
-
-            float mag = star->mag();
-
-            // break loop if maglim is reached
-            if (mag > maglim)
+            if (star->mag() > maglim)
                 break;
+            list.stars.append(star);
+        }
+        if (!list.stars.isEmpty())
+            drawLists.append(list);
+    }
 
-            if (star->updateID != updateID)
-                star->JITupdate();
+    // Update and project the stars of all the trixels on the thread pool, then draw them here
+    std::function<void(SkyPainter::StarDrawList &)> prepare = [skyp](SkyPainter::StarDrawList & list)
+    {
+        StarObject::JITupdate(list.stars.constData(), list.stars.size());
+        skyp->prepareStars(&list);
+    };
+    {
+        DrawTimings::Scope scope(KStarsData::Instance()->skyComposite()->drawTimings(), "Stars", DrawTimings::PROJECT);
+        QtConcurrent::blockingMap(drawLists, prepare);
+    }
 
-            bool drawn = skyp->drawPointSource(star, mag, star->spchar());
+    for (auto &list : drawLists)
+    {
+        skyp->drawStars(&list);
 
-            //FIXME_SKYPAINTER: find a better way to do this.
-            if (drawn && !(m_hideLabels || mag > labelMagLim))
+        //FIXME_SKYPAINTER: find a better way to do this.
+        if (m_hideLabels)
+            continue;
+        for (int i = 0; i < list.stars.size(); i++)
+        {
+            StarObject *star = list.stars.at(i);
+            if (list.visible.at(i) && star->mag() <= labelMagLim)
                 addLabel(proj->toScreen(star), star);
         }
     }
@@ -18,9 +18,11 @@
 #include "kstars_debug.h"
 #include "ksnotification.h"
 #include "kstarsdata.h"
+#include "nameindex.h"
 #include "Options.h"
 #include "skylabeler.h"
 #include "skymesh.h"
+#include "htmesh/MeshIterator.h"
 #include "skypainter.h"
 #include "auxiliary/filedownloader.h"
 #include "projections/projector.h"
@@ -31,8 +33,8 @@
 #include <QJsonValue>
 
 #include <zlib.h>
-#include <fstream>
-#include <stdio.h>
+
+#include <algorithm>
 
 #include <csv.h>
 
@@ -41,6 +43,31 @@ const QString SupernovaeComponent::tnsDataFilenameZip("tns-daily.csv.gz");
 const QString SupernovaeComponent::tnsDataUrl(
     "https://indilib.org/jdownloads/kstars/tns-daily.csv.gz");
 
+namespace
+{
+
+// Hands the CSV reader the rows as they are decompressed, files that are not compressed are read as they are
+class GzipByteSource : public io::ByteSourceBase
+{
+    public:
+        explicit GzipByteSource(gzFile file) : m_File(file) {}
+        ~GzipByteSource() override
+        {
+            gzclose(m_File);
+        }
+
+        int read(char *buffer, int size) override
+        {
+            // A read error ends the file
+            return std::max(0, gzread(m_File, buffer, static_cast<unsigned int>(size)));
+        }
+
+    private:
+        gzFile m_File;
+};
+
+}
+
 SupernovaeComponent::SupernovaeComponent(SkyComposite *parent) : ListComponent(parent)
 {
     //QtConcurrent::run(this, &SupernovaeComponent::loadData);
@@ -63,6 +90,10 @@ void SupernovaeComponent::update(KSNumbers *num)
             so->updateCoords(num);
         so->EquatorialToHorizontal(data->lst(), data->geo()->lat());
     }
+
+    // Only precession and nutation move them
+    if (num || !m_PointIndex.isValid())
+        m_PointIndex.build(m_ObjectList);
 }
 
 bool SupernovaeComponent::selected()
@@ -72,19 +103,30 @@ bool SupernovaeComponent::selected()
 
 void SupernovaeComponent::loadData()
 {
-    qDeleteAll(m_ObjectList);
-    m_ObjectList.clear();
+    // The last update downloaded, else the data shipped with KStars
+    QString sFileName = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath(tnsDataFilenameZip);
+    if (!QFile::exists(sFileName))
+        sFileName = KSPaths::locate(QStandardPaths::AppLocalDataLocation, tnsDataFilename);
 
-    objectNames(SkyObject::SUPERNOVA).clear();
-    objectLists(SkyObject::SUPERNOVA).clear();
+    gzFile file = gzopen(sFileName.toLocal8Bit().constData(), "rb");
+    if (file == nullptr)
+    {
+        qCCritical(KSTARS) << "could not open file " << sFileName.toLocal8Bit() << "\n";
+        return;
+    }
 
-    auto sFileName = KSPaths::locate(QStandardPaths::AppLocalDataLocation, QString(tnsDataFilename));
+    const bool firstLoad = m_Rows.isEmpty();
+    KSNumbers *num = KStarsData::Instance()->updateNum();
+    QHash<QByteArray, Row> rows;
+    rows.reserve(m_Rows.size());
+    QList<SkyObject *> objects;
+    QList<Supernova *> created, latest;
 
     try
     {
         io::CSVReader<26, io::trim_chars<' '>, io::double_quote_escape<',', '\"'>,
         io::ignore_overflow>
-        in(sFileName.toLocal8Bit());
+        in(sFileName.toStdString(), std::unique_ptr<io::ByteSourceBase>(new GzipByteSource(file)));
         // skip header
         const char *line = in.next_line();
         if (line == nullptr)
@@ -112,35 +154,90 @@ void SupernovaeComponent::loadData()
                     is_public, end_prop_period, discovery_mag, discovery_filter, discovery_date_s,
                     sender, remarks, discovery_bibcode, classification_bibcode, ext_catalog))
         {
-            auto discovery_date =
-                QDateTime::fromString(discovery_date_s.c_str(), Qt::ISODate);
-            QString qname = QString(name.c_str());
-            dms ra(QString(ra_s.c_str()), false);
-            dms dec(QString(dec_s.c_str()), true);
-
-            Supernova *sup = new Supernova(
-                qname, ra, dec, QString(type.c_str()), QString(host_name.c_str()),
-                QString(discovery_date_s.c_str()), redshift, discovery_mag, discovery_date);
-
-            objectNames(SkyObject::SUPERNOVA).append(QString(name.c_str()));
-
-            appendListObject(sup);
-            objectLists(SkyObject::SUPERNOVA)
-            .append(QPair<QString, const SkyObject *>(qname, sup));
+            const QByteArray key(name.data(), static_cast<int>(name.size()));
+            if (rows.contains(key))
+                continue;
+
+            QByteArray fields;
+            for (const std::string *field : {&name, &ra_s, &dec_s, &type, &host_name, &discovery_date_s})
+                fields.append(field->data(), static_cast<int>(field->size())).append('\0');
+            fields.append(reinterpret_cast<const char *>(&redshift), sizeof(redshift));
+            fields.append(reinterpret_cast<const char *>(&discovery_mag), sizeof(discovery_mag));
+            Row row { nullptr, qHash(fields) };
+
+            // Rows that did not change keep their supernova
+            const auto previous = m_Rows.constFind(key);
+            if (previous != m_Rows.constEnd() && previous->signature == row.signature)
+                row.supernova = previous->supernova;
+            else
+            {
+                auto discovery_date =
+                    QDateTime::fromString(discovery_date_s.c_str(), Qt::ISODate);
+                dms ra(QString(ra_s.c_str()), false);
+                dms dec(QString(dec_s.c_str()), true);
+
+                row.supernova = new Supernova(
+                    QString(name.c_str()), ra, dec, QString(type.c_str()), QString(host_name.c_str()),
+                    QString(discovery_date_s.c_str()), redshift, discovery_mag, discovery_date);
+                row.supernova->updateCoordsNow(num);
+                created.append(row.supernova);
+                if (previous == m_Rows.constEnd())
+                    latest.append(row.supernova);
+            }
+
+            rows.insert(key, row);
+            objects.append(row.supernova);
         }
-
-        m_DataLoading = false;
-        m_DataLoaded  = true;
     }
     catch (io::error::can_not_open_file &ex)
     {
         qCCritical(KSTARS) << "could not open file " << sFileName.toLocal8Bit() << "\n";
+        qDeleteAll(created);
         return;
     }
     catch (std::exception &ex)
     {
         qCCritical(KSTARS) << "unknown exception happened:" << ex.what() << "\n";
+        qDeleteAll(created);
+        return;
+    }
+
+    // Supernovae of rows that changed or are gone
+    QList<Supernova *> deleted;
+    for (auto it = m_Rows.constBegin(); it != m_Rows.constEnd(); ++it)
+    {
+        if (rows.value(it.key()).supernova != it->supernova)
+            deleted.append(it->supernova);
     }
+
+    if (!created.isEmpty() || !deleted.isEmpty())
+    {
+        NameIndex::invalidate();
+        m_PointIndex.invalidate();
+        m_ObjectList.clear();
+        m_ObjectHash.clear();
+        objectNames(SkyObject::SUPERNOVA).clear();
+        objectLists(SkyObject::SUPERNOVA).clear();
+
+        for (auto object : objects)
+        {
+            appendListObject(object);
+            objectNames(SkyObject::SUPERNOVA).append(object->name());
+            objectLists(SkyObject::SUPERNOVA).append(QPair<QString, const SkyObject *>(object->name(), object));
+        }
+    }
+    qDeleteAll(deleted);
+    m_Rows = std::move(rows);
+
+    m_DataLoading = false;
+    m_DataLoaded  = true;
+
+    qCDebug(KSTARS) << "Supernovae:" << objects.size() << "rows," << created.size() << "new or changed," << deleted.size() <<
+                    "replaced or removed";
+
+    // The first load tells nothing new
+    if (!firstLoad && Options::showSupernovaAlerts())
+        notifyNewSupernovae(latest);
 }
 
 SkyObject *SupernovaeComponent::objectNearest(SkyPoint *p, double &maxrad)
@@ -148,6 +245,9 @@ SkyObject *SupernovaeComponent::objectNearest(SkyPoint *p, double &maxrad)
     if (!selected() || !m_DataLoaded)
         return nullptr;
 
+    if (m_PointIndex.isValid())
+        return m_PointIndex.nearest(p, maxrad);
+
     SkyObject *oBest = nullptr;
     double rBest     = maxrad;
 
@@ -190,70 +290,72 @@ void SupernovaeComponent::draw(SkyPainter *skyp)
         return;
     }
 
-    double maglim = zoomMagnitudeLimit();
-    double refage = Options::supernovaDetectionAge();
-    bool hostOnly = Options::supernovaeHostOnly();
-    bool classifiedOnly = Options::supernovaeClassifiedOnly();
+    const double maglim = zoomMagnitudeLimit();
+    const double refage = Options::supernovaDetectionAge();
+    const float magLimitShow = Options::magnitudeLimitShowSupernovae();
+    const bool limitByZoom = Options::limitSupernovaeByZoom();
+    const bool hostOnly = Options::supernovaeHostOnly();
+    const bool classifiedOnly = Options::supernovaeClassifiedOnly();
 
-    for (auto so : m_ObjectList)
+    auto drawSupernova = [&](SkyObject * so)
     {
-        Supernova *sup = dynamic_cast<Supernova *>(so);
+        Supernova *sup = static_cast<Supernova *>(so);
         float mag      = sup->mag();
-        float age      = sup->getAgeDays();
-        QString type     = sup->getType();
 
-        if (mag > float(Options::magnitudeLimitShowSupernovae()))
-            continue;
+        if (mag > magLimitShow)
+            return;
 
-        if (age > refage)
-            continue;
+        if (sup->getAgeDays() > refage)
+            return;
 
         // only SN with host galaxy?
         if (hostOnly && sup->getHostGalaxy() == "")
-            continue;
+            return;
 
         // Do not draw if mag>maglim
-        if (mag > maglim && Options::limitSupernovaeByZoom())
-            continue;
+        if (mag > maglim && limitByZoom)
+            return;
 
         // classified SN only?
-        if (classifiedOnly && type == "")
-            continue;
+        if (classifiedOnly && sup->getType() == "")
+            return;
 
         skyp->drawSupernova(sup);
-    }
-}
+    };
 
-#if 0
-void SupernovaeComponent::notifyNewSupernovae()
-{
-#ifndef KSTARS_LITE
-    //qDebug()<<"New Supernovae discovered";
-    QList<SkyObject *> latestList;
-    foreach (SkyObject * so, latest)
+    // Only the trixels in view, once the supernovae are indexed where they are now
+    if (m_PointIndex.isValid())
     {
-        Supernova * sup = (Supernova *)so;
-
-        if (sup->getMagnitude() > float(Options::magnitudeLimitAlertSupernovae()))
+        MeshIterator region(SkyMesh::Instance(), DRAW_BUF);
+        while (region.hasNext())
         {
-            //qDebug()<<"Not Bright enough to be notified";
-            continue;
+            const QVector<SkyObject *> *objects = m_PointIndex.objectsIn(region.next());
+            if (objects == nullptr)
+                continue;
+            for (auto so : *objects)
+                drawSupernova(so);
         }
-
-        //qDebug()<<"Bright enough to be notified";
-        latestList.append(so);
     }
-    if (!latestList.empty())
+    else
     {
-        NotifyUpdatesUI * ui = new NotifyUpdatesUI(0);
-        ui->addItems(latestList);
-        ui->show();
+        for (auto so : m_ObjectList)
+            drawSupernova(so);
     }
-    //     if (!latest.empty())
-    //         KMessageBox::informationList(0, i18n("New Supernovae discovered!"), latestList, i18n("New Supernovae discovered!"));
-#endif
 }
-#endif
+
+void SupernovaeComponent::notifyNewSupernovae(const QList<Supernova *> &latest)
+{
+    QStringList names;
+    for (auto sup : latest)
+    {
+        if (sup->mag() <= float(Options::magnitudeLimitAlertSupernovae()))
+            names.append(QString("%1 (%2 mag)").arg(sup->name()).arg(sup->mag(), 0, 'f', 1));
+    }
+
+    if (!names.isEmpty())
+        KSNotification::transient(i18n("New supernovae discovered:\n%1", names.join('\n')),
+                                  i18n("New Supernovae"));
+}
 
 void SupernovaeComponent::slotTriggerDataFileUpdate()
 {
@@ -284,58 +386,19 @@ void SupernovaeComponent::slotTriggerDataFileUpdate()
         // copy data manually to target location
         QString fname = url.right(url.size() - 7);
         qInfo() << "fetching data from local file at: " << fname << "\n";
-        QFile::remove(fname);
+        QFile::remove(output);
         auto res = QFile::copy(fname, output);
         qInfo() << "copy returned: " << res << "\n";
-        // uncompress csv
-        unzipData();
-        // Reload Supernova
+        // Merge the update
         loadData();
     }
 }
 
-void SupernovaeComponent::unzipData()
-{
-    // TODO: error handling
-    std::string ifpath =
-        QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation))
-        .filePath(tnsDataFilenameZip)
-        .toStdString();
-    std::string ofpath =
-        QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation))
-        .filePath(tnsDataFilename)
-        .toStdString();
-    auto fhz  = gzopen(ifpath.c_str(), "rb");
-    auto fout = fopen(ofpath.c_str(), "wb");
-
-    if (fhz == NULL)
-    {
-        printf("Error: Failed to gzopen %s\n", ifpath.c_str());
-        exit(0);
-    }
-    unsigned char unzipBuffer[8192];
-    unsigned int unzippedBytes;
-    while (true)
-    {
-        unzippedBytes = gzread(fhz, unzipBuffer, 8192);
-        if (unzippedBytes > 0)
-        {
-            fwrite(unzipBuffer, 1, unzippedBytes, fout);
-        }
-        else
-        {
-            break;
-        }
-    }
-    gzclose(fhz);
-    fclose(fout);
-}
-
 void SupernovaeComponent::downloadReady()
 {
-    // uncompress csv
-    unzipData();
-    // Reload Supernova
+    // Data files unpacked by earlier versions are not read anymore
+    QFile::remove(QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath(tnsDataFilename));
+    // Merge the update
     loadData();
 #ifdef KSTARS_LITE
     KStarsLite::Instance()->data()->setFullTimeUpdate();
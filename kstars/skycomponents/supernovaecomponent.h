@@ -13,6 +13,7 @@
 #include "skyobjects/supernova.h"
 #include "filedownloader.h"
 
+#include <QHash>
 #include <QList>
 #include <QPointer>
 
@@ -45,7 +46,6 @@ class SupernovaeComponent : public QObject, public ListComponent
          */
         void draw(SkyPainter *skyp) override;
 
-        //virtual void notifyNewSupernovae();
         /** @note Basically copy pasted from StarComponent::zoomMagnitudeLimit() */
         static float zoomMagnitudeLimit();
 
@@ -58,8 +58,25 @@ class SupernovaeComponent : public QObject, public ListComponent
         void downloadError(const QString &errorString);
 
     private:
+        /**
+         * @brief loadData Merge the TNS rows into the supernovae, straight from the compressed file
+         *
+         * Only the rows that are new or changed since the last load make new supernovae, the others keep
+         * theirs. Supernovae no longer in the file are deleted.
+         */
         void loadData();
-        void unzipData();
+        /** @brief notifyNewSupernovae Tell about the supernovae the last update added, if bright enough */
+        void notifyNewSupernovae(const QList<Supernova *> &latest);
+
+        struct Row
+        {
+            Supernova *supernova { nullptr };
+            // hash of the fields the supernova is made of
+            uint signature { 0 };
+        };
+        // TNS rows the supernovae were made of, by name
+        QHash<QByteArray, Row> m_Rows;
+
         static const QString tnsDataFilename;
         static const QString tnsDataFilenameZip;
         static const QString tnsDataUrl;
@@ -7,6 +7,8 @@
 #include "terraincomponent.h"
 
 #include "Options.h"
+#include "kstarsdata.h"
+#include "skymapcomposite.h"
 #include "skypainter.h"
 #include "skymap.h"
 
@@ -22,7 +24,9 @@ bool TerrainComponent::selected()
 void TerrainComponent::draw(SkyPainter *skyp)
 {
 #if !defined(KSTARS_LITE)
-    if (((SkyMap::IsSlewing() == false) || Options::terrainPanning()) && selected())
+    // Not while frames are too slow for the map to move smoothly
+    if (((SkyMap::IsSlewing() == false) || Options::terrainPanning()) && selected() &&
+            KStarsData::Instance()->skyComposite()->renderQuality().surveys())
         skyp->drawTerrain();
 #else
     Q_UNUSED(skyp);
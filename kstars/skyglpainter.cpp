@@ -14,6 +14,7 @@
 
 #include <GL/gl.h>
 #include <QGLWidget>
+#include <QVarLengthArray>
 
 #include "skymap.h"
 #include "kstarsdata.h"
@@ -615,6 +616,61 @@ void SkyGLPainter::drawText(int x, int y, const QString text, QFont font, QColor
 
 bool SkyGLPainter::drawConstellationArtImage(ConstellationsArt *obj)
 {
+    if (obj->image().isNull())
+        return false;
+
+    // Project the grid over the image, which follows the curvature of the projection
+    KStarsData *data                 = KStarsData::Instance();
+    const QVector<SkyPoint> &mesh    = obj->meshPoints();
+    constexpr int n                  = ConstellationsArt::MESH_DIVISIONS + 1;
+    QVarLengthArray<Eigen::Vector2f, n * n> screen(mesh.size());
+    QVarLengthArray<bool, n * n> visible(mesh.size());
+    bool onScreen = false;
+    for (int i = 0; i < mesh.size(); i++)
+    {
+        SkyPoint p = mesh[i];
+        p.EquatorialToHorizontal(data->lst(), data->geo()->lat());
+        bool isVisible = false;
+        screen[i]      = m_proj->toScreenVec(&p, true, &isVisible);
+        visible[i]     = isVisible;
+        onScreen       = onScreen || (isVisible && m_proj->onScreen(screen[i]));
+    }
+    if (!onScreen)
+        return false;
+
+    // The widget uploads the image once and keeps the texture for as long as the image lives
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glEnable(GL_TEXTURE_2D);
+    TextureManager::bindTexture(obj->getImageFileName(), m_widget);
+    glColor4f(1, 1, 1, 0.7);
+
+    // Y coordinate of texture is mirrored w.r.t. to vertex coordinates, see drawTexturedRectangle()
+    glBegin(GL_QUADS);
+    for (int row = 0; row < n - 1; row++)
+    {
+        const float t0 = 1 - float(row) / (n - 1), t1 = 1 - float(row + 1) / (n - 1);
+        for (int col = 0; col < n - 1; col++)
+        {
+            const int topLeft = row * n + col, bottomLeft = topLeft + n;
+            // Cells that cross the horizon of the projection are left out
+            if (!visible[topLeft] || !visible[topLeft + 1] || !visible[bottomLeft] || !visible[bottomLeft + 1])
+                continue;
+
+            const float s0 = float(col) / (n - 1), s1 = float(col + 1) / (n - 1);
+            glTexCoord2f(s0, t0);
+            glVertex2fv(screen[topLeft].data());
+            glTexCoord2f(s1, t0);
+            glVertex2fv(screen[topLeft + 1].data());
+            glTexCoord2f(s1, t1);
+            glVertex2fv(screen[bottomLeft + 1].data());
+            glTexCoord2f(s0, t1);
+            glVertex2fv(screen[bottomLeft].data());
+        }
+    }
+    glEnd();
+    glColor4f(1, 1, 1, 1);
+    return true;
 }
 
 void SkyGLPainter::drawSkyLine(SkyPoint *a, SkyPoint *b)
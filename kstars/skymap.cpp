@@ -23,6 +23,7 @@
 #include "ksutils.h"
 #include "Options.h"
 #include "skymapcomposite.h"
+#include "skyqpainter.h"
 #ifdef HAVE_OPENGL
 #include "skymapgldraw.h"
 #endif
@@ -64,6 +65,27 @@
 
 namespace
 {
+Projector *newProjector(int type, const ViewParams &p)
+{
+    switch (type)
+    {
+        case SkyMap::Gnomonic:
+            return new GnomonicProjector(p);
+        case SkyMap::Stereographic:
+            return new StereographicProjector(p);
+        case SkyMap::Orthographic:
+            return new OrthographicProjector(p);
+        case SkyMap::AzimuthalEquidistant:
+            return new AzimuthalEquidistantProjector(p);
+        case SkyMap::Equirectangular:
+            return new EquirectangularProjector(p);
+        case SkyMap::Lambert:
+        default:
+            //TODO: implement other projection classes
+            return new LambertProjector(p);
+    }
+}
+
 // Draw bitmap for zoom cursor. Width is size of pen to draw with.
 QBitmap zoomCursorBitmap(int width)
 {
@@ -1252,32 +1274,47 @@ void SkyMap::setupProjector()
     else
     {
         delete m_proj;
-        switch (Options::projection())
-        {
-            case Gnomonic:
-                m_proj = new GnomonicProjector(p);
-                break;
-            case Stereographic:
-                m_proj = new StereographicProjector(p);
-                break;
-            case Orthographic:
-                m_proj = new OrthographicProjector(p);
-                break;
-            case AzimuthalEquidistant:
-                m_proj = new AzimuthalEquidistantProjector(p);
-                break;
-            case Equirectangular:
-                m_proj = new EquirectangularProjector(p);
-                break;
-            case Lambert:
-            default:
-                //TODO: implement other projection classes
-                m_proj = new LambertProjector(p);
-                break;
-        }
+        m_proj = newProjector(Options::projection(), p);
     }
 }
 
+void SkyMap::renderChart(QPaintDevice *pd, const SkyPoint &center, double fov,
+                         const std::function<void(SkyQPainter *)> &decorate)
+{
+    // The view of the map is restored before returning to the event loop, so it is never
+    // repainted on screen with the chart view.
+    const SkyPoint mapFocus = Focus;
+    const double mapZoom    = Options::zoomFactor();
+    Projector *mapProjector = m_proj;
+
+    Focus = center;
+    Focus.EquatorialToHorizontal(data->lst(), data->geo()->lat());
+    // The chart is fov degrees wide
+    const double zoom = pd->width() / (fov * dms::DegToRad);
+    Options::setZoomFactor(zoom);
+
+    ViewParams p    = mapProjector->viewParams();
+    p.focus         = &Focus;
+    p.width         = pd->width();
+    p.height        = pd->height();
+    p.zoomFactor    = zoom;
+    p.rotationAngle = determineSkyRotation();
+    m_proj          = newProjector(mapProjector->type(), p);
+
+    SkyQPainter painter(pd, QSize(pd->width(), pd->height()));
+    painter.begin();
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    exportSkyImage(&painter);
+    if (decorate)
+        decorate(&painter);
+    painter.end();
+
+    delete m_proj;
+    m_proj = mapProjector;
+    Focus  = mapFocus;
+    Options::setZoomFactor(mapZoom);
+}
+
 void SkyMap::setZoomMouseCursor()
 {
     mouseMoveCursor = false; // no mousemove cursor
@@ -18,6 +18,8 @@
 #include <QtGlobal>
 #include <QTimer>
 
+#include <functional>
+
 class QPainter;
 class QPaintDevice;
 
@@ -316,6 +318,16 @@ class SkyMap : public QGraphicsView
             dynamic_cast<SkyMapDrawAbstract *>(m_SkyMapDraw)->exportSkyImage(painter, scale);
         }
 
+        /**
+             *@short Render a chart of the sky without changing the view of the map
+             *@param pd paint device of the chart, its whole size is drawn
+             *@param center center of the chart, in current equatorial coordinates
+             *@param fov width of the chart in degrees
+             *@param decorate drawn last with the projection of the chart, e.g. a legend
+             */
+        void renderChart(QPaintDevice *pd, const SkyPoint &center, double fov,
+                         const std::function<void(SkyQPainter *)> &decorate = nullptr);
+
         SkyMapDrawAbstract *getSkyMapDrawAbstract()
         {
             return dynamic_cast<SkyMapDrawAbstract *>(m_SkyMapDraw);
@@ -12,6 +12,7 @@
 #include <QPainter>
 #include <QPixmap>
 #include <QPainterPath>
+#include <QFontDatabase>
 
 #include "skymapdrawabstract.h"
 #include "skymap.h"
@@ -37,6 +38,8 @@
 
 #include <config-kstars.h>
 
+#include <algorithm>
+
 #ifdef HAVE_INDI
 #include <basedevice.h>
 #include "indi/indilistener.h"
@@ -86,6 +89,9 @@ void SkyMapDrawAbstract::drawOverlays(QPainter &p, bool drawFov)
 
     drawZoomBox(p);
 
+    if (Options::showDrawTimings())
+        drawDrawTimings(p);
+
     if (m_SkyMap->rotationStart.x() > 0 && m_SkyMap->rotationStart.y() > 0)
     {
         drawOrientationArrows(p);
@@ -202,6 +208,48 @@ void SkyMapDrawAbstract::drawZoomBox(QPainter &p)
     }
 }
 
+void SkyMapDrawAbstract::drawDrawTimings(QPainter &p)
+{
+    const DrawTimings &timings = m_KStarsData->skyComposite()->drawTimings();
+
+    QStringList names, times;
+    names << i18n("Frame");
+    times << i18n("%1 ms (%2 ms)", QString::number(timings.frame(), 'f', 1),
+                  QString::number(timings.frameAverage(), 'f', 1));
+    for (const auto &entry : timings.entries())
+    {
+        names << QString("%1 [%2]").arg(entry.name, DrawTimings::phaseName(entry.phase));
+        times << i18n("%1 ms (%2 ms)", QString::number(entry.last, 'f', 1), QString::number(entry.average, 'f', 1));
+    }
+
+    p.save();
+    p.setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    const QFontMetrics metrics(p.font());
+    int nameWidth = 0, timeWidth = 0;
+    for (int i = 0; i < names.size(); i++)
+    {
+        nameWidth = std::max(nameWidth, metrics.horizontalAdvance(names[i]));
+        timeWidth = std::max(timeWidth, metrics.horizontalAdvance(times[i]));
+    }
+
+    const int pad = 4, gap = 2 * metrics.averageCharWidth();
+    const QRect box(p.viewport().right() - nameWidth - gap - timeWidth - 3 * pad, pad, nameWidth + gap + timeWidth + 2 * pad,
+                    names.size() * metrics.height() + 2 * pad);
+
+    const ColorScheme *cs = m_KStarsData->colorScheme();
+    QColor background = cs->colorNamed("BoxBGColor");
+    background.setAlpha(160);
+    p.fillRect(box, background);
+    p.setPen(cs->colorNamed("BoxTextColor"));
+    for (int i = 0; i < names.size(); i++)
+    {
+        const int y = box.top() + pad + i * metrics.height() + metrics.ascent();
+        p.drawText(box.left() + pad, y, names[i]);
+        p.drawText(box.right() - pad - metrics.horizontalAdvance(times[i]), y, times[i]);
+    }
+    p.restore();
+}
+
 void SkyMapDrawAbstract::drawObjectLabels(QList<SkyObject *> &labelObjects)
 {
     bool checkSlewing =
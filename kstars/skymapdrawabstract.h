@@ -80,6 +80,13 @@ class SkyMapDrawAbstract
         	*/
     void drawZoomBox(QPainter &psky);
 
+    /**
+     * @short Draw the time spent on each part of the last frames in a box at the top right
+     * @param p reference to the QPainter on which to draw (this should be the sky map)
+     * @see DrawTimings
+     */
+    void drawDrawTimings(QPainter &p);
+
     /**Draw a dashed line from the Angular-Ruler start point to the current mouse cursor,
         	*when in Angular-Ruler mode.
         	*@param psky reference to the QPainter on which to draw (this should be the Sky pixmap).
@@ -8,6 +8,8 @@
 
 #include "texturemanager.h"
 
+#include <cmath>
+
 ConstellationsArt::ConstellationsArt(dms &midpointra, dms &midpointdec, double pa, double w, double h,
                                      const QString &abbreviation, const QString &filename)
 {
@@ -30,3 +32,42 @@ void ConstellationsArt::loadImage()
     constellationArtImage = TextureManager::getImage(imageFileName);
     imageLoaded           = true;
 }
+
+const QVector<SkyPoint> &ConstellationsArt::meshPoints()
+{
+    if (!mesh.isEmpty())
+        return mesh;
+
+    const double sinPA = std::sin(positionAngle * dms::DegToRad), cosPA = std::cos(positionAngle * dms::DegToRad);
+    double sinDec0, cosDec0;
+    dec().SinCos(sinDec0, cosDec0);
+
+    mesh.reserve((MESH_DIVISIONS + 1) * (MESH_DIVISIONS + 1));
+    for (int row = 0; row <= MESH_DIVISIONS; row++)
+    {
+        // Offsets from the midpoint in radians, u to the right of the image and v to its top
+        const double v = (0.5 - double(row) / MESH_DIVISIONS) * height * dms::DegToRad;
+        for (int col = 0; col <= MESH_DIVISIONS; col++)
+        {
+            const double u = (double(col) / MESH_DIVISIONS - 0.5) * width * dms::DegToRad;
+
+            // The top is north and the right west at a position angle of 0, as SkyQPainter draws it
+            const double xi  = -u * cosPA - v * sinPA;
+            const double eta = -u * sinPA + v * cosPA;
+
+            // Inverse gnomonic projection about the midpoint
+            const double rho = std::sqrt(xi * xi + eta * eta);
+            if (rho == 0)
+            {
+                mesh.append(SkyPoint(ra(), dec()));
+                continue;
+            }
+            const double c = std::atan(rho), sinC = std::sin(c), cosC = std::cos(c);
+            dms pointRA, pointDec;
+            pointDec.setRadians(std::asin(cosC * sinDec0 + eta * sinC * cosDec0 / rho));
+            pointRA.setRadians(ra().radians() + std::atan2(xi * sinC, rho * cosDec0 * cosC - eta * sinDec0 * sinC));
+            mesh.append(SkyPoint(pointRA.reduce(), pointDec));
+        }
+    }
+    return mesh;
+}
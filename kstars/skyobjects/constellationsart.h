@@ -10,6 +10,7 @@
 
 #include <QImage>
 #include <QString>
+#include <QVector>
 
 class dms;
 
@@ -66,7 +67,11 @@ class ConstellationsArt : public SkyObject
     inline double pa() const override { return positionAngle; }
 
     /** Set the position angle */
-    inline void setPositionAngle(double pa) { positionAngle = pa; }
+    inline void setPositionAngle(double pa)
+    {
+        positionAngle = pa;
+        mesh.clear();
+    }
 
     /** @return an object's width */
     inline double getWidth() { return width; }
@@ -74,6 +79,17 @@ class ConstellationsArt : public SkyObject
     /** @return an object's height*/
     inline double getHeight() { return height; }
 
+    /** Number of cells along each side of the grid of meshPoints() */
+    static constexpr int MESH_DIVISIONS = 8;
+
+    /**
+     * @return the sky positions of a grid of (MESH_DIVISIONS + 1) x (MESH_DIVISIONS + 1) points spanning
+     * the image, row by row from its top left corner. The image lies in the plane tangent to the sky at its
+     * midpoint, with its top towards the position angle. The grid is only computed once, so painters can
+     * draw the image warped by the projection at no more cost than projecting its points.
+     */
+    const QVector<SkyPoint> &meshPoints();
+
   private:
     QString abbrev;
     QString imageFileName;
@@ -82,4 +98,5 @@ class ConstellationsArt : public SkyObject
     double width { 0 };
     double height { 0 };
     bool imageLoaded { false };
+    QVector<SkyPoint> mesh;
 };
@@ -27,6 +27,14 @@ KSAsteroid::KSAsteroid(int _catN, const QString &s, const QString &imfile, long
     setMag(H);
     //Compute the orbital Period from Kepler's 3rd law:
     P = 365.2568984 * pow(a, 1.5); //period in days
+
+    //The asteroid is never closer than its perihelion to the Sun, and never closer than that
+    //minus Earth's aphelion to us. For 0 <= G <= 1 the phase term only makes it fainter,
+    //which gives a bound if the orbit stays outside Earth's:
+    const double perihelion = a * (1.0 - e);
+    const double earthAphelion = 1.0167;
+    if (perihelion > earthAphelion && G >= 0.0 && G <= 1.0)
+        BrightestMag = H + 5.0 * log10(perihelion * (perihelion - earthAphelion));
 }
 
 KSAsteroid *KSAsteroid::clone() const
@@ -38,11 +46,6 @@ KSAsteroid *KSAsteroid::clone() const
 
 bool KSAsteroid::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth)
 {
-    // TODO: (Valentin) TOP LEVEL CONTROL OF CALCULATION FOR ALL OBJECTS
-    if(!toCalculate()){
-        return false;
-    }
-
     //determine the mean anomaly for the desired date.  This is the mean anomaly for the
     //ephemeis epoch, plus the number of days between the desired date and ephemeris epoch,
     //times the asteroid's mean daily motion (360/P):
@@ -140,7 +143,7 @@ bool KSAsteroid::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase
     // So we have to precess as well
     setRA0(ra());
     setDec0(dec());
-    apparentCoord(J2000, lastPrecessJD);
+    apparentCoord(num);
     //nutate(num);
     //aberrate(num);
 
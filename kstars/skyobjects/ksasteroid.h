@@ -10,6 +10,8 @@
 
 #include <QDataStream>
 
+#include <limits>
+
 class dms;
 class KSNumbers;
 
@@ -77,6 +79,12 @@ class KSAsteroid : public KSPlanetBase
     double inline getAbsoluteMagnitude() const { return H; }
     double inline getSlopeParameter() const { return G; }
 
+    /**
+     * @return a lower bound of the asteroid's magnitude over its whole orbit,
+     * or -infinity if its orbit comes close enough to Earth's that there is none
+     */
+    double inline brightestMagnitude() const { return BrightestMag; }
+
     /**
          *@short Sets the asteroid's perihelion distance
          */
@@ -236,6 +244,7 @@ class KSAsteroid : public KSPlanetBase
     dms i, w, M, N;
     double H { 0 };
     double G { 0 };
+    double BrightestMag { -std::numeric_limits<double>::infinity() };
     QString OrbitID, OrbitClass, Dimensions;
     bool NEO { false };
 };
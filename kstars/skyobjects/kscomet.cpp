@@ -286,7 +286,7 @@ bool KSComet::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *E
     // So we have to precess as well
     setRA0(ra());
     setDec0(dec());
-    apparentCoord(J2000, lastPrecessJD);
+    apparentCoord(num);
     findPhysicalParameters();
 
     return true;
@@ -343,6 +343,31 @@ void KSComet::setRotationPeriod(float rot_per)
     RotationPeriod = rot_per;
 }
 
+QDataStream &operator<<(QDataStream &out, const KSComet &comet)
+{
+    out << comet.name() << comet.OrbitClass << static_cast<double>(comet.JDp) << comet.q
+        << comet.e << comet.i << comet.w << comet.N
+        << comet.M1 << comet.M2 << comet.K1 << comet.K2;
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, KSComet *&comet)
+{
+    QString name, orbit_class;
+    double JDp, q, e;
+    dms i, w, N;
+    float M1, M2, K1, K2;
+
+    in >> name >> orbit_class;
+    in >> JDp >> q >> e >> i >> w >> N >> M1 >> M2 >> K1 >> K2;
+
+    comet = new KSComet(name, QString(), q, e, i, w, N, JDp, M1, M2, K1, K2);
+    comet->setOrbitClass(orbit_class);
+    comet->setAngularSize(0.005);
+
+    return in;
+}
+
 //Unused virtual function from KSPlanetBase
 bool KSComet::loadData()
 {
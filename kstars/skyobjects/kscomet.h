@@ -8,6 +8,8 @@
 
 #include "ksplanetbase.h"
 
+#include <QDataStream>
+
 /**
  * @class KSComet
  * @short A subclass of KSPlanetBase that implements comets.
@@ -64,6 +66,8 @@ class KSComet : public KSPlanetBase
     KSComet *clone() const override;
     SkyObject::UID getUID() const override;
 
+    static const SkyObject::TYPE TYPE = SkyObject::COMET;
+
     /** Destructor (empty)*/
     ~KSComet() override = default;
 
@@ -182,6 +186,12 @@ class KSComet : public KSPlanetBase
     void findPhysicalParameters();
 
   private:
+    /**
+     * Serializers
+     */
+    friend QDataStream &operator<<(QDataStream &out, const KSComet &comet);
+    friend QDataStream &operator>>(QDataStream &in, KSComet *&comet);
+
     void findMagnitude(const KSNumbers *) override;
 
     long double JDp { 0 };
@@ -0,0 +1,198 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ksephemeris.h"
+
+#include "cachingdms.h"
+#include "ksnumbers.h"
+#include "kstarsdata.h"
+#include "skyobjects/ksplanet.h"
+
+#include <KLocalizedString>
+
+#include <QThread>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+// Neglected terms allowed relative to the distance of the body, about a milliarcsecond
+static const double g_tolerance = 5e-9;
+// Segments are not halved below this length, in days
+static const double g_minLength = 1.0 / 24.0;
+
+// Clenshaw's recurrence for the sum of c[j] T_j(x)
+static double chebyshev(const std::array<double, KSEphemeris::nodes> &c, double x)
+{
+    double b1 = 0.0, b2 = 0.0;
+    for (int j = KSEphemeris::nodes - 1; j > 0; --j)
+    {
+        const double b0 = 2.0 * x * b1 - b2 + c[j];
+        b2              = b1;
+        b1              = b0;
+    }
+    return x * b1 - b2 + c[0];
+}
+
+double KSEphemeris::segmentLength(const KSPlanetBase &body)
+{
+    // Geocentric positions carry the Earth's motion as well as the body's, so even the
+    // outer planets get no more than a month
+    return body.type() == SkyObject::MOON ? 4.0 : 32.0;
+}
+
+void KSEphemeris::clear()
+{
+    m_start  = 0;
+    m_length = 0;
+    m_segments.reset();
+}
+
+bool KSEphemeris::contains(long double jd) const
+{
+    return m_segments && jd >= m_start && jd <= m_start + m_length * m_segments->size();
+}
+
+bool KSEphemeris::covers(long double startJD, long double stopJD) const
+{
+    return contains(startJD) && contains(stopJD);
+}
+
+void KSEphemeris::fit(const KSPlanetBase &body, long double startJD, long double stopJD)
+{
+    clear();
+    if (!(stopJD > startJD))
+        return;
+
+    // Load whatever the theory needs now rather than from several threads at once
+    std::unique_ptr<KSPlanetBase> copy(static_cast<KSPlanetBase *>(body.clone()));
+    copy->loadData();
+
+    const double span = double(stopJD - startJD);
+    double length     = segmentLength(body);
+    auto segments     = std::make_shared<std::vector<Segment>>();
+    while (true)
+    {
+        const int count = std::max(1, int(std::ceil(span / length)));
+        m_start         = startJD;
+        m_length        = span / count;
+        segments->assign(count, Segment());
+
+        if (fitSegments(body, *segments) || m_length / 2.0 < g_minLength)
+            break;
+        length = m_length / 2.0;
+    }
+    m_segments = segments;
+}
+
+bool KSEphemeris::fitSegments(const KSPlanetBase &body, std::vector<Segment> &segments) const
+{
+    // Each job works through its own run of segments with its own copies of the body and
+    // the Earth. These are made and destroyed here, as some bodies keep count of their copies.
+    struct Job
+    {
+        std::unique_ptr<KSPlanetBase> body;
+        std::unique_ptr<KSPlanet> earth;
+        int first;
+        int last;
+        bool ok;
+    };
+
+    const int count = int(segments.size());
+    const int jobs  = std::min(count, 4 * std::max(1, QThread::idealThreadCount()));
+    std::vector<Job> work(jobs);
+    for (int n = 0; n < jobs; ++n)
+    {
+        Job &job = work[n];
+        job.body.reset(static_cast<KSPlanetBase *>(body.clone()));
+        job.body->clearTrail();
+        job.earth.reset(new KSPlanet(i18n("Earth"), QString(), QColor("white"), 12756.28));
+        job.first = count * n / jobs;
+        job.last  = count * (n + 1) / jobs;
+        job.ok    = true;
+    }
+
+    QtConcurrent::blockingMap(work, [this, &segments](Job &job)
+    {
+        double f[3][nodes];
+        for (int i = job.first; i < job.last; ++i)
+        {
+            const long double mid = m_start + m_length * (i + 0.5);
+            double nearest        = HUGE_VAL;
+
+            for (int k = 0; k < nodes; ++k)
+            {
+                const long double jd = mid + 0.5 * m_length * cos(dms::PI * (k + 0.5) / nodes);
+                KSNumbers num(jd);
+                job.earth->findPosition(&num);
+                job.body->findPosition(&num, nullptr, nullptr, job.earth.get());
+
+                double sinRA, cosRA, sinDec, cosDec;
+                job.body->ra().SinCos(sinRA, cosRA);
+                job.body->dec().SinCos(sinDec, cosDec);
+                const double r = job.body->rearth();
+                f[0][k]        = r * cosDec * cosRA;
+                f[1][k]        = r * cosDec * sinRA;
+                f[2][k]        = r * sinDec;
+                nearest        = std::min(nearest, r);
+            }
+
+            Segment &segment = segments[i];
+            for (int c = 0; c < 3; ++c)
+            {
+                for (int j = 0; j < nodes; ++j)
+                {
+                    double sum = 0.0;
+                    for (int k = 0; k < nodes; ++k)
+                        sum += f[c][k] * cos(dms::PI * j * (k + 0.5) / nodes);
+                    segment[c][j] = (j == 0 ? 1.0 : 2.0) * sum / nodes;
+                }
+
+                // The last coefficients estimate what the polynomial leaves out
+                if (fabs(segment[c][nodes - 1]) + fabs(segment[c][nodes - 2]) > g_tolerance * nearest)
+                    job.ok = false;
+            }
+        }
+    });
+
+    return std::all_of(work.begin(), work.end(), [](const Job &job)
+    {
+        return job.ok;
+    });
+}
+
+double KSEphemeris::position(long double jd, SkyPoint *point, const CachingDms *lat, const CachingDms *LST) const
+{
+    const double t = double(jd - m_start) / m_length;
+    const int i    = std::min(std::max(int(t), 0), int(m_segments->size()) - 1);
+    const double x = 2.0 * (t - i) - 1.0;
+
+    double v[3];
+    for (int c = 0; c < 3; ++c)
+        v[c] = chebyshev((*m_segments)[i][c], x);
+    const double r = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+
+    if (lat && LST)
+    {
+        // Move to the observer, as KSPlanetBase::localizeCoords() does
+        const double u     = atan(0.996647 * tan(lat->radians()));
+        const double scale = 6378.14 / AU_KM;
+        const double rcosp = cos(u) * scale;
+        v[0] -= rcosp * LST->cos();
+        v[1] -= rcosp * LST->sin();
+        v[2] -= 0.996647 * sin(u) * scale;
+    }
+
+    CachingDms ra, dec;
+    ra.setUsing_atan2(v[1], v[0]);
+    ra.reduceToRange(dms::ZERO_TO_2PI);
+    dec.setUsing_atan2(v[2], sqrt(v[0] * v[0] + v[1] * v[1]));
+    point->setRA(ra);
+    point->setDec(dec);
+
+    return r;
+}
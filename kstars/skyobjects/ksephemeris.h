@@ -0,0 +1,81 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+class CachingDms;
+class KSPlanetBase;
+class SkyPoint;
+
+/**
+ * @class KSEphemeris
+ * @short Chebyshev approximation of the apparent position of a solar system body.
+ *
+ * The geocentric apparent position of a body is fitted with Chebyshev polynomials on
+ * segments of equal length that span a range of Julian days. A position inside the range
+ * is then a polynomial evaluation away rather than a run through the full theory, which
+ * pays off for searches that need many positions of the same body, like those of
+ * ApproachSolver.
+ *
+ * The segments are fitted in parallel, on copies of the body. Their length is halved until
+ * the neglected terms stay below about a milliarcsecond. Copies of a fit share its
+ * segments, so an ephemeris is cheap to copy and its copies may be evaluated from several
+ * threads at once.
+ */
+class KSEphemeris
+{
+    public:
+        /** Number of Chebyshev nodes, and so of coefficients, of a segment */
+        static constexpr int nodes = 14;
+
+        KSEphemeris() = default;
+
+        /**
+         * @short Fit the positions of @p body from @p startJD to @p stopJD
+         * @note @p body is left untouched, the positions are computed on copies
+         */
+        void fit(const KSPlanetBase &body, long double startJD, long double stopJD);
+
+        /** @short Drop the fit */
+        void clear();
+
+        /** @return true if the fit covers @p jd */
+        bool contains(long double jd) const;
+
+        /** @return true if the fit covers all of @p startJD to @p stopJD */
+        bool covers(long double startJD, long double stopJD) const;
+
+        /**
+         * @short Set the apparent RA and Dec of @p point to those of the body at @p jd
+         * If @p lat and @p LST are given, the coordinates are topocentric like those computed
+         * by KSPlanetBase::findPosition().
+         * @note @p jd must be covered by the fit, see contains()
+         * @return the distance of the body from the centre of the Earth, in AU
+         */
+        double position(long double jd, SkyPoint *point, const CachingDms *lat = nullptr,
+                        const CachingDms *LST = nullptr) const;
+
+        /** @return the length of the segments a fit of @p body starts out with, in days */
+        static double segmentLength(const KSPlanetBase &body);
+
+    private:
+        /// The coefficients of the geocentric x, y and z, in AU
+        typedef std::array<std::array<double, nodes>, 3> Segment;
+
+        /**
+         * @short Fit @p segments of m_length days from m_start
+         * @return false if the neglected terms of some segment are too large
+         */
+        bool fitSegments(const KSPlanetBase &body, std::vector<Segment> &segments) const;
+
+        long double m_start { 0 };
+        double m_length { 0 };
+        std::shared_ptr<const std::vector<Segment>> m_segments;
+};
@@ -8,112 +8,58 @@
 
 #include "ksnumbers.h"
 #include "ksutils.h"
-#include "ksfilereader.h"
 
 #include <cmath>
 #include <typeinfo>
 
 #include "kstars_debug.h"
 
-// Qt version calming
-#include <qtskipemptyparts.h>
-
-KSPlanet::OrbitDataManager KSPlanet::odm;
-
-KSPlanet::OrbitDataManager::OrbitDataManager()
-{
-    //EMPTY
-}
-
-bool KSPlanet::OrbitDataManager::readOrbitData(const QString &fname, QVector<OrbitData> *vector)
+// Sums the six series of one coordinate, leaving out the terms that contribute less than precision
+static double sumCoordinate(const VSOP87::Series (&series)[6], double tau, double precision)
 {
-    QFile f;
+    double sum  = 0.0;
+    double tpow = 1.0;
 
-    if (KSUtils::openDataFile(f, fname))
+    for (int i = 0; i < 6; ++i)
     {
-        KSFileReader fileReader(f); // close file is included
-        QStringList fields;
-        while (fileReader.hasMoreLines())
-        {
-            fields = fileReader.readLine().split(' ', Qt::SkipEmptyParts);
+        const VSOP87::Term *terms = series[i].terms;
+        double s                  = 0.0;
 
-            if (fields.size() == 3)
+        if (precision <= 0.0)
+        {
+            for (int j = 0; j < series[i].size; ++j)
+                s += terms[j].A * cos(terms[j].B + terms[j].C * tau);
+        }
+        else
+        {
+            // A term contributes at most |A * tau^i|
+            const double cutoff = precision / fabs(tpow);
+            for (int j = 0; j < series[i].size; ++j)
             {
-                double A = fields[0].toDouble();
-                double B = fields[1].toDouble();
-                double C = fields[2].toDouble();
-                vector->append(OrbitData(A, B, C));
+                if (fabs(terms[j].A) >= cutoff)
+                    s += terms[j].A * cos(terms[j].B + terms[j].C * tau);
             }
         }
-    }
-    else
-    {
-        return false;
-    }
-    return true;
-}
-
-bool KSPlanet::OrbitDataManager::loadData(KSPlanet::OrbitDataColl &odc, const QString &n)
-{
-    QString fname, snum;
-    QFile f;
-    int nCount = 0;
-    QString nl = n.toLower();
-
-    if (hash.contains(nl))
-    {
-        odc = hash[nl];
-        return true; //orbit data already loaded
-    }
-
-    //Create a new OrbitDataColl
-    OrbitDataColl ret;
-
-    //Ecliptic Longitude
-    for (int i = 0; i < 6; ++i)
-    {
-        snum.setNum(i);
-        fname = nl + ".L" + snum + ".vsop";
-        if (readOrbitData(fname, &ret.Lon[i]))
-            nCount++;
-    }
-
-    if (nCount == 0)
-        return false;
-
-    //Ecliptic Latitude
-    for (int i = 0; i < 6; ++i)
-    {
-        snum.setNum(i);
-        fname = nl + ".B" + snum + ".vsop";
-        if (readOrbitData(fname, &ret.Lat[i]))
-            nCount++;
-    }
 
-    if (nCount == 0)
-        return false;
-
-    //Heliocentric Distance
-    for (int i = 0; i < 6; ++i)
-    {
-        snum.setNum(i);
-        fname = nl + ".R" + snum + ".vsop";
-        if (readOrbitData(fname, &ret.Dst[i]))
-            nCount++;
+        sum += s * tpow;
+        tpow *= tau;
     }
 
-    if (nCount == 0)
-        return false;
-
-    hash[nl] = ret;
-    odc      = hash[nl];
+    return sum;
+}
 
-    return true;
+void KSPlanet::sumSeries(const VSOP87::Body &body, double tau, double precision, EclipticPosition &ret)
+{
+    ret.longitude.setRadians(sumCoordinate(body.L, tau, precision));
+    ret.longitude.setD(ret.longitude.reduce().Degrees());
+    ret.latitude.setRadians(sumCoordinate(body.B, tau, precision));
+    ret.radius = sumCoordinate(body.R, tau, precision);
 }
 
 KSPlanet::KSPlanet(const QString &s, const QString &imfile, const QColor &c, double pSize)
     : KSPlanetBase(s, imfile, c, pSize)
 {
+    orbitData = VSOP87::body(untranslatedName().toLower().toLatin1().constData());
 }
 
 KSPlanet::KSPlanet(int n) : KSPlanetBase()
@@ -145,6 +91,8 @@ KSPlanet::KSPlanet(int n) : KSPlanetBase()
             qDebug() << Q_FUNC_INFO << "Error: Illegal identifier in KSPlanet constructor: " << n;
             break;
     }
+
+    orbitData = VSOP87::body(untranslatedName().toLower().toLatin1().constData());
 }
 
 KSPlanet *KSPlanet::clone() const
@@ -182,26 +130,15 @@ QString KSPlanet::untranslatedName() const
         return name();
 }
 
-//we don't need the reference to the ODC, so just give it a junk variable
+// The series are compiled in, there is nothing left to load
 bool KSPlanet::loadData()
 {
-    OrbitDataColl odc;
-    return odm.loadData(odc, untranslatedName());
+    return orbitData != nullptr;
 }
 
 void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
 {
-    double sum[6];
-    OrbitDataColl odc;
-    double Tpow[6];
-
-    Tpow[0] = 1.0;
-    for (int i = 1; i < 6; ++i)
-    {
-        Tpow[i] = Tpow[i - 1] * Tau;
-    }
-
-    if (!odm.loadData(odc, untranslatedName()))
+    if (orbitData == nullptr)
     {
         epret.longitude = dms(0.0);
         epret.latitude  = dms(0.0);
@@ -210,56 +147,7 @@ void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
         return;
     }
 
-    //Ecliptic Longitude
-    for (int i = 0; i < 6; ++i)
-    {
-        sum[i] = 0.0;
-        for (int j = 0; j < odc.Lon[i].size(); ++j)
-        {
-            sum[i] += odc.Lon[i][j].A * cos(odc.Lon[i][j].B + odc.Lon[i][j].C * Tau);
-            /*
-            qDebug() << Q_FUNC_INFO << "sum[" << i <<"] =" << sum[i] <<
-                " A = " << odc.Lon[i][j].A << " B = " << odc.Lon[i][j].B <<
-                " C = " << odc.Lon[i][j].C;
-                */
-        }
-        sum[i] *= Tpow[i];
-        //qDebug() << Q_FUNC_INFO << name() << " : sum[" << i << "] = " << sum[i];
-    }
-
-    epret.longitude.setRadians(sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5]);
-    epret.longitude.setD(epret.longitude.reduce().Degrees());
-
-    //Compute Ecliptic Latitude
-    for (uint i = 0; i < 6; ++i)
-    {
-        sum[i] = 0.0;
-        for (int j = 0; j < odc.Lat[i].size(); ++j)
-        {
-            sum[i] += odc.Lat[i][j].A * cos(odc.Lat[i][j].B + odc.Lat[i][j].C * Tau);
-        }
-        sum[i] *= Tpow[i];
-    }
-
-    epret.latitude.setRadians(sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5]);
-
-    //Compute Heliocentric Distance
-    for (uint i = 0; i < 6; ++i)
-    {
-        sum[i] = 0.0;
-        for (int j = 0; j < odc.Dst[i].size(); ++j)
-        {
-            sum[i] += odc.Dst[i][j].A * cos(odc.Dst[i][j].B + odc.Dst[i][j].C * Tau);
-        }
-        sum[i] *= Tpow[i];
-    }
-
-    epret.radius = sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5];
-
-    /*
-    qDebug() << Q_FUNC_INFO << name() << " pre: Lat = " << epret.latitude.toDMSString() << " Long = " <<
-        epret.longitude.toDMSString() << " Dist = " << epret.radius;
-    */
+    sumSeries(*orbitData, Tau, Precision, epret);
 }
 
 bool KSPlanet::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth)
@@ -326,7 +214,7 @@ bool KSPlanet::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *
 
         setRA0(ra());
         setDec0(dec());
-        apparentCoord(J2000, lastPrecessJD);
+        apparentCoord(num);
 
         //nutate(num);
         //aberrate(num);
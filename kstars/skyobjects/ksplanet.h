@@ -7,10 +7,9 @@
 #pragma once
 
 #include "ksplanetbase.h"
+#include "vsop87.h"
 
-#include <QHash>
 #include <QString>
-#include <QVector>
 
 class KSNumbers;
 
@@ -20,10 +19,9 @@ class KSNumbers;
  * (Earth and Pluto have their own specialized classes derived from KSPlanetBase).
  * @note The Sun is subclassed from KSPlanet.
  *
- * KSPlanet contains internal classes to manage the computations of a planet's position.
- * The position is computed as a series of sinusoidal sums, similar to a Fourier
- * transform.  See "Astronomical Algorithms" by Jean Meeus or the file README.planetmath
- * for details.
+ * The position is computed from the VSOP87 theory as a series of sinusoidal sums, similar
+ * to a Fourier transform.  See "Astronomical Algorithms" by Jean Meeus or the file
+ * README.planetmath for details.
  * @short Provides necessary information about objects in the solar system.
  *
  * @author Jason Harris
@@ -73,6 +71,18 @@ class KSPlanet : public KSPlanetBase
      */
     virtual void calcEcliptic(double jm, EclipticPosition &ret) const;
 
+    /**
+     * @short Set the precision of the positions computed by calcEcliptic()
+     * Terms of the theory which contribute less than @p precision, in radians for the
+     * longitude and latitude and in AU for the distance, are left out. This speeds up
+     * tools that need many positions of moderate accuracy, each term dropped adding up
+     * to @p precision to the error. The default of 0 uses the full theory.
+     */
+    void setPrecision(double precision) { Precision = precision; }
+
+    /** @return the precision of the positions, see setPrecision() */
+    double precision() const { return Precision; }
+
   protected:
     /**
      * Calculate the geocentric RA, Dec coordinates of the Planet.
@@ -84,92 +94,18 @@ class KSPlanet : public KSPlanetBase
     bool findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth = nullptr) override;
 
     /**
-     * @class OrbitData
-     * This class contains doubles A,B,C which represent a single term in a planet's
-     * positional expansion sums (each sum-term is A*COS(B+C*T)).
-     *
-     * @author Mark Hollomon
-     * @version 1.0
-     */
-    class OrbitData
-    {
-      public:
-        /** Default constructor */
-        OrbitData() : A(0.), B(0.), C(0.) {}
-        /**
-         * Constructor
-         * @param a the A value
-         * @param b the B value
-         * @param c the C value
-         */
-        OrbitData(double a, double b, double c) : A(a), B(b), C(c) {}
-
-        double A, B, C;
-    };
-
-    typedef QVector<OrbitData> OBArray[6];
-
-    /**
-     * OrbitDataColl contains three groups of six QVectors.  Each QVector is a
-     * list of OrbitData objects, representing a single sum used in computing
-     * the planet's position.  A set of six of these vectors comprises the large
-     * "meta-sum" which yields the planet's Longitude, Latitude, or Distance value.
-     *
-     * @author Mark Hollomon
-     * @version 1.0
-     */
-    class OrbitDataColl
-    {
-      public:
-        /** Constructor */
-        OrbitDataColl() = default;
-
-        OBArray Lon;
-        OBArray Lat;
-        OBArray Dst;
-    };
-
-    /**
-     * OrbitDataManager places the OrbitDataColl objects for all planets in a QDict
-     * indexed by the planets' names. It also loads the positional data of each planet from disk.
-     *
-     * @author Mark Hollomon
-     * @version 1.0
+     * Sum the series of @p body for the time @p tau in Julian millenia since J2000,
+     * leaving out the terms that contribute less than @p precision.
+     * @param ret The ecliptic coordinates are returned by reference through this argument.
      */
-    class OrbitDataManager
-    {
-      public:
-        /** Constructor */
-        OrbitDataManager();
-
-        /**
-         * Load orbital data for a planet from disk.
-       	 * The data is stored on disk in a series of files named
-         * "name.[LBR][0...5].vsop", where "L"=Longitude data, "B"=Latitude data,
-         * and R=Radius data.
-         * @param n the name of the planet whose data is to be loaded from disk.
-         * @param odc reference to the OrbitDataColl containing the planet's orbital data.
-         * @return true if data successfully loaded
-         */
-        bool loadData(OrbitDataColl &odc, const QString &n);
-
-      private:
-        /**
-         * Read a single orbital data file from disk into an OrbitData vector.
-         * The data files are named "name.[LBR][0...5].vsop", where
-         * "L"=Longitude data, "B"=Latitude data, and R=Radius data.
-         * @param fname the filename to be read.
-         * @param vector pointer to the OrbitData vector to be filled with these data.
-         */
-        bool readOrbitData(const QString &fname, QVector<KSPlanet::OrbitData> *vector);
-
-        QHash<QString, OrbitDataColl> hash;
-    };
+    static void sumSeries(const VSOP87::Body &body, double tau, double precision, EclipticPosition &ret);
 
   private:
     void findMagnitude(const KSNumbers *) override;
 
   protected:
     bool data_loaded { false };
-    static OrbitDataManager odm;
+    /// The VSOP87 series of the planet, nullptr if it has none
+    const VSOP87::Body *orbitData { nullptr };
+    double Precision { 0 };
 };
@@ -86,23 +86,24 @@ void KSPlanetBase::EclipticToEquatorial(const CachingDms *Obliquity)
 void KSPlanetBase::updateCoords(const KSNumbers *num, bool includePlanets, const CachingDms *lat, const CachingDms *LST,
                                 bool)
 {
-    KStarsData *kd = KStarsData::Instance();
-
-    if (kd == nullptr || !includePlanets)
+    if (KStarsData::Instance() == nullptr || !includePlanets)
         return;
 
-    kd->skyComposite()->earth()->findPosition(num); //since we don't pass lat & LST, localizeCoords will be skipped
+    // Use an Earth of our own rather than move the one of the sky to another time, which
+    // would also race with recomputeCoords() called from other threads
+    KSPlanet earth(i18n("Earth"), QString(), QColor("white"), 12756.28);
+    earth.findPosition(num); //since we don't pass lat & LST, localizeCoords will be skipped
 
     if (lat && LST)
     {
-        findPosition(num, lat, LST, kd->skyComposite()->earth());
+        findPosition(num, lat, LST, &earth);
         // Don't add to the trail this time
         if (hasTrail())
             Trail.takeLast();
     }
     else
     {
-        findGeocentricPosition(num, kd->skyComposite()->earth());
+        findGeocentricPosition(num, &earth);
     }
 }
 
@@ -8,6 +8,7 @@
 
 #include "mosaictiles.h"
 #include "kstarsdata.h"
+#include "ksnumbers.h"
 #include "Options.h"
 
 MosaicTiles::MosaicTiles() : SkyObject()
@@ -298,6 +299,9 @@ void MosaicTiles::updateTiles()
     // Start by clearing existing tiles.
     clearTiles();
 
+    // All tiles are brought to the same epoch, so the precession and nutation are computed once
+    KSNumbers num(KStarsData::Instance()->ut().djd());
+
     int index = 0;
     for (int col = 0; col < gridW; col++)
     {
@@ -317,7 +321,7 @@ void MosaicTiles::updateTiles()
             auto adjusted_ra0 = (ra0().Degrees() + tileSkyOffsetScaled.width()) / 15.0;
             auto adjusted_de0 = (dec0().Degrees() + tileSkyOffsetScaled.height());
             SkyPoint sky_center(adjusted_ra0, adjusted_de0);
-            sky_center.apparentCoord(static_cast<long double>(J2000), KStarsData::Instance()->ut().djd());
+            sky_center.apparentCoord(&num);
 
             auto tile_center_ra0 = sky_center.ra0().Degrees();
             auto mosaic_center_ra0 = ra0().Degrees();
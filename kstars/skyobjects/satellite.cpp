@@ -17,6 +17,7 @@
 
 #include <QDebug>
 
+#include <algorithm>
 #include <cmath>
 #include <typeinfo>
 
@@ -703,30 +704,140 @@ void Satellite::init()
     }
 }
 
-int Satellite::updatePos()
+Satellite::Context Satellite::currentContext(bool skipBelowHorizon)
 {
     KStarsData *data = KStarsData::Instance();
-    return sgp4((data->clock()->utc().djd() - m_tle_jd) * MINPD);
+    Context context  = Satellite::context(data->clock()->utc().djd(), *data->geo());
+
+    context.lst              = *data->lst();
+    context.skipBelowHorizon = skipBelowHorizon;
+
+    KSSun *sun   = dynamic_cast<KSSun *>(data->skyComposite()->findByName(i18n("Sun")));
+    context.dark = sun != nullptr && sun->alt().Degrees() <= -12.0;
+
+    return context;
 }
 
-int Satellite::sgp4(double tsince)
+Satellite::Context Satellite::context(double jd, const GeoLocation &geo)
 {
-    KStarsData *data = KStarsData::Instance();
+    Context context;
+
+    context.jd = jd;
+    context.lat = *geo.lat();
+
+    // Observer ECI position and velocity
+    double thetageo  = geo.LMST(jd);
+    context.lst.setRadians(thetageo);
+    context.sinlat   = sin(context.lat.radians());
+    context.coslat   = cos(context.lat.radians());
+    context.sintheta = sin(thetageo);
+    context.costheta = cos(thetageo);
+
+    double c         = 1.0 / sqrt(1.0 + F * (F - 2.0) * context.sinlat * context.sinlat);
+    double sq        = (1.0 - F) * (1.0 - F) * c;
+    double achcp     = (RADIUSEARTHKM * c + MEANALT) * context.coslat;
+    context.obs_posx = achcp * context.costheta;
+    context.obs_posy = achcp * context.sintheta;
+    context.obs_posz = (RADIUSEARTHKM * sq + MEANALT) * context.sinlat;
+    context.obs_posw = sqrt(context.obs_posx * context.obs_posx + context.obs_posy * context.obs_posy +
+                            context.obs_posz * context.obs_posz);
+
+    // Find ECI coordinates of the sun
+    double mjd, year, T, M, L, e, C, O, Lsa, nu, R, eps;
+
+    mjd  = jd - 2415020.0;
+    year = 1900.0 + mjd / 365.25;
+    T    = (mjd + deltaET(year) / (MINPD * 60.0)) / 36525.0;
+    M    = DEG2RAD * (Modulus(358.47583 + Modulus(35999.04975 * T, 360.0) - (0.000150 + 0.0000033 * T) * T * T, 360.0));
+    L    = DEG2RAD * (Modulus(279.69668 + Modulus(36000.76892 * T, 360.0) + 0.0003025 * T * T, 360.0));
+    e    = 0.01675104 - (0.0000418 + 0.000000126 * T) * T;
+    C    = DEG2RAD * ((1.919460 - (0.004789 + 0.000014 * T) * T) * sin(M) + (0.020094 - 0.000100 * T) * sin(2 * M) +
+                      0.000293 * sin(3 * M));
+    O    = DEG2RAD * (Modulus(259.18 - 1934.142 * T, 360.0));
+    Lsa  = Modulus(L + C - DEG2RAD * (0.00569 - 0.00479 * sin(O)), TWOPI);
+    nu   = Modulus(M + C, TWOPI);
+    R    = 1.0000002 * (1.0 - e * e) / (1.0 + e * cos(nu));
+    eps  = DEG2RAD * (23.452294 - (0.0130125 + (0.00000164 - 0.000000503 * T) * T) * T + 0.00256 * cos(O));
+    R    = AU * R;
+
+    context.sun_posx = R * cos(Lsa);
+    context.sun_posy = R * sin(Lsa) * cos(eps);
+    context.sun_posz = R * sin(Lsa) * sin(eps);
+    context.sun_posw = R;
+
+    // Altitude of the sun, the same way as that of the satellite in sgp4()
+    double range_posx = context.sun_posx - context.obs_posx;
+    double range_posy = context.sun_posy - context.obs_posy;
+    double range_posz = context.sun_posz - context.obs_posz;
+    double range      = sqrt(range_posx * range_posx + range_posy * range_posy + range_posz * range_posz);
+    double top_z      = context.coslat * context.costheta * range_posx + context.coslat * context.sintheta * range_posy +
+                        context.sinlat * range_posz;
+    context.dark = arcSin(top_z / range) <= -12.0 * DEG2RAD;
+
+    return context;
+}
 
+int Satellite::updatePos()
+{
+    return updatePos(currentContext());
+}
+
+int Satellite::updatePos(const Context &context)
+{
+    if (context.skipBelowHorizon)
+    {
+        if (context.jd >= m_below_from && context.jd < m_below_until)
+            return 0;
+
+        // Only rely on the passes once the satellite was seen well below the horizon,
+        // so that it isn't left behind just above it
+        if (hasPasses(context.jd) && !inPass(context.jd) && alt().Degrees() < -2.0)
+            return 0;
+    }
+
+    return sgp4((context.jd - m_tle_jd) * MINPD, context);
+}
+
+void Satellite::updateSkip(double x, double y, double z, const Context &context)
+{
+    m_below_from = m_below_until = 0;
+
+    // The satellite is above the horizon when the angle between it and the observer,
+    // seen from the center of the earth, is less than acos(observer radius / satellite
+    // radius). Take the apogee for the satellite radius and keep two degrees of margin
+    // for the flattening of the earth, refraction and the perturbations.
+    double r   = sqrt(x * x + y * y + z * z);
+    double psi = acos(std::min(1.0, (x * context.obs_posx + y * context.obs_posy + z * context.obs_posz) /
+                                    (r * context.obs_posw)));
+
+    double e       = m_eccentricity;
+    double apogee  = pow(XKE / m_mean_motion, X2O3) * (1.0 + e) * RADIUSEARTHKM * 1.1;
+    double horizon = acos(std::min(1.0, context.obs_posw / apogee)) + 2.0 * DEG2RAD;
+
+    double gap = psi - horizon;
+    if (gap <= 0)
+        return;
+
+    // That angle changes at most as fast as the satellite goes at perigee plus the earth spins
+    double rate = m_mean_motion * (1.0 + e) * (1.0 + e) / pow(1.0 - e * e, 1.5) + MFACTOR * 60.0;
+
+    m_below_from  = context.jd;
+    m_below_until = context.jd + gap / rate / MINPD;
+}
+
+int Satellite::sgp4(double tsince, const Context &context)
+{
     int ktr;
     double am, axnl, aynl, betal, cosim, cnod, cos2u, coseo1 = 0, cosi, cosip, cosisq, cossu, cosu, delm, delomg, em,
                                                       ecose, el2, eo1, ep, esine, argpm, argpp, argpdf, pl,
                                                       mrt = 0.0, mvt, rdotl, rl, rvdot, rvdotl, sinim, dndt, sin2u, sineo1 = 0, sini, sinip, sinsu, sinu, snod, su, t2,
                                                       t3, t4, tem5, temp, temp1, temp2, tempa, tempe, templ, u, ux, uy, uz, vx, vy, vz, inclm, mm, nm, nodem, xinc,
                                                       xincp, xl, xlm, mp, xmdf, xmx, xmy, nodedf, xnode, nodep, tc, sat_posx, sat_posy, sat_posz, sat_posw, sat_velx,
-                                                      sat_vely, sat_velz, sinlat, obs_posx, obs_posy, obs_posz, obs_posw, /*obs_velx, obs_vely, obs_velz,*/
-                                                      coslat, thetageo, sintheta, costheta, c, sq, achcp, vkmpersec;
+                                                      sat_vely, sat_velz, vkmpersec;
     //    double emsq;
 
     const double temp4 = 1.5e-12;
 
-    double jul_utc = data->clock()->utc().djd();
-
     vkmpersec = RADIUSEARTHKM * XKE / 60.0;
 
     // Update for secular gravity and atmospheric drag
@@ -1135,22 +1246,11 @@ int Satellite::sgp4(double tsince)
         return (6);
     }
 
-    // Observer ECI position and velocity
-    sinlat   = sin(data->geo()->lat()->radians());
-    coslat   = cos(data->geo()->lat()->radians());
-    thetageo = data->geo()->LMST(jul_utc);
-    sintheta = sin(thetageo);
-    costheta = cos(thetageo);
-    c        = 1.0 / sqrt(1.0 + F * (F - 2.0) * sinlat * sinlat);
-    sq       = (1.0 - F) * (1.0 - F) * c;
-    achcp    = (RADIUSEARTHKM * c + MEANALT) * coslat;
-    obs_posx = achcp * costheta;
-    obs_posy = achcp * sintheta;
-    obs_posz = (RADIUSEARTHKM * sq + MEANALT) * sinlat;
-    obs_posw = sqrt(obs_posx * obs_posx + obs_posy * sat_posy + obs_posz * obs_posz);
-    /*obs_velx = -MFACTOR * obs_posy;
-    obs_vely = MFACTOR * obs_posx;
-    obs_velz = 0.;*/
+    // Observer ECI position
+    const double sinlat   = context.sinlat, coslat = context.coslat;
+    const double sintheta = context.sintheta, costheta = context.costheta;
+    const double obs_posx = context.obs_posx, obs_posy = context.obs_posy, obs_posz = context.obs_posz;
+    const double obs_posw = context.obs_posw;
 
     m_altitude = sat_posw - obs_posw + MEANALT;
 
@@ -1179,31 +1279,14 @@ int Satellite::sgp4(double tsince)
 
     setAz(azimuth / DEG2RAD);
     setAlt(elevation / DEG2RAD);
-    HorizontalToEquatorial(data->lst(), data->geo()->lat());
-
-    // is the satellite visible ?
-    // Find ECI coordinates of the sun
-    double mjd, year, T, M, L, e, C, O, Lsa, nu, R, eps;
+    HorizontalToEquatorial(&context.lst, &context.lat);
 
-    mjd  = jul_utc - 2415020.0;
-    year = 1900.0 + mjd / 365.25;
-    T    = (mjd + deltaET(year) / (MINPD * 60.0)) / 36525.0;
-    M    = DEG2RAD * (Modulus(358.47583 + Modulus(35999.04975 * T, 360.0) - (0.000150 + 0.0000033 * T) * T * T, 360.0));
-    L    = DEG2RAD * (Modulus(279.69668 + Modulus(36000.76892 * T, 360.0) + 0.0003025 * T * T, 360.0));
-    e    = 0.01675104 - (0.0000418 + 0.000000126 * T) * T;
-    C    = DEG2RAD * ((1.919460 - (0.004789 + 0.000014 * T) * T) * sin(M) + (0.020094 - 0.000100 * T) * sin(2 * M) +
-                      0.000293 * sin(3 * M));
-    O    = DEG2RAD * (Modulus(259.18 - 1934.142 * T, 360.0));
-    Lsa  = Modulus(L + C - DEG2RAD * (0.00569 - 0.00479 * sin(O)), TWOPI);
-    nu   = Modulus(M + C, TWOPI);
-    R    = 1.0000002 * (1.0 - e * e) / (1.0 + e * cos(nu));
-    eps  = DEG2RAD * (23.452294 - (0.0130125 + (0.00000164 - 0.000000503 * T) * T) * T + 0.00256 * cos(O));
-    R    = AU * R;
+    if (context.skipBelowHorizon)
+        updateSkip(sat_posx, sat_posy, sat_posz, context);
 
-    double sun_posx = R * cos(Lsa);
-    double sun_posy = R * sin(Lsa) * cos(eps);
-    double sun_posz = R * sin(Lsa) * sin(eps);
-    double sun_posw = R;
+    // is the satellite visible ?
+    const double sun_posx = context.sun_posx, sun_posy = context.sun_posy, sun_posz = context.sun_posz;
+    const double sun_posw = context.sun_posw;
 
     // Calculates satellite's eclipse status and depth
     double sd_sun, sd_earth, delta, depth;
@@ -1221,14 +1304,129 @@ int Satellite::sgp4(double tsince)
     double earth_w = sat_posw;
     delta      = PIO2 - arcSin((sun_posx * earth_x + sun_posy * earth_y + sun_posz * earth_z) / (sun_posw * earth_w));
     depth      = sd_earth - sd_sun - delta;
-    KSSun *sun = dynamic_cast<KSSun *>(data->skyComposite()->findByName(i18n("Sun")));
 
     m_is_eclipsed = sd_earth >= sd_sun && depth >= 0;
-    m_is_visible  = !m_is_eclipsed && sun->alt().Degrees() <= -12.0 && elevation >= 0.0;
+    m_is_visible  = !m_is_eclipsed && context.dark && elevation >= 0.0;
 
     return (0);
 }
 
+QVector<Satellite::Pass> Satellite::predictPasses(const QVector<Context> &contexts, const GeoLocation &geo)
+{
+    QVector<Pass> passes;
+    Pass pass;
+    bool up = false;
+
+    for (int i = 0; i < contexts.size(); i++)
+    {
+        Context context          = contexts.at(i);
+        context.skipBelowHorizon = true;
+
+        if (sgp4((context.jd - m_tle_jd) * MINPD, context) != 0)
+            break;
+
+        if (alt().Degrees() >= 0)
+        {
+            if (!up)
+            {
+                up          = true;
+                pass        = Pass();
+                pass.rise   = i > 0 ? horizonCrossing(contexts.at(i - 1).jd, context.jd, geo) : context.jd;
+                pass.maxAlt = -90;
+                // horizonCrossing() moved the satellite
+                sgp4((context.jd - m_tle_jd) * MINPD, context);
+            }
+
+            if (alt().Degrees() > pass.maxAlt)
+            {
+                pass.maxAlt      = alt().Degrees();
+                pass.culmination = context.jd;
+            }
+            pass.track.append({ context.jd, float(ra().Degrees()), float(dec().Degrees()), float(alt().Degrees()),
+                                m_is_visible });
+        }
+        else
+        {
+            if (up)
+            {
+                up       = false;
+                pass.set = horizonCrossing(context.jd, contexts.at(i - 1).jd, geo);
+                passes.append(pass);
+            }
+
+            // Jump over the time the satellite is sure to stay below the horizon
+            while (i + 1 < contexts.size() && contexts.at(i + 1).jd < m_below_until)
+                i++;
+        }
+    }
+
+    if (up)
+    {
+        pass.set = contexts.last().jd;
+        passes.append(pass);
+    }
+
+    // Only keep the tracks that are of interest for sightings
+    for (Pass &p : passes)
+    {
+        bool visible = false;
+        for (const Pass::Point &point : p.track)
+            visible = visible || point.visible;
+
+        if (!visible)
+            p.track.clear();
+        p.track.squeeze();
+    }
+
+    return passes;
+}
+
+double Satellite::horizonCrossing(double below, double above, const GeoLocation &geo)
+{
+    // Bisect down to about a second
+    while (fabs(above - below) > 1.0 / 86400.0)
+    {
+        double middle = 0.5 * (below + above);
+        if (sgp4((middle - m_tle_jd) * MINPD, context(middle, geo)) != 0)
+            break;
+
+        if (alt().Degrees() >= 0)
+            above = middle;
+        else
+            below = middle;
+    }
+
+    return above;
+}
+
+void Satellite::setPasses(const QVector<Pass> &passes, double from, double until)
+{
+    m_passes       = passes;
+    m_passes_from  = from;
+    m_passes_until = until;
+}
+
+const QVector<Satellite::Pass> &Satellite::passes() const
+{
+    return m_passes;
+}
+
+bool Satellite::hasPasses(double jd) const
+{
+    return jd >= m_passes_from && jd < m_passes_until;
+}
+
+bool Satellite::inPass(double jd) const
+{
+    // A couple of minutes of margin for the time steps of the prediction
+    const double margin = 2.0 / MINPD;
+
+    return std::any_of(m_passes.cbegin(), m_passes.cend(), [jd, margin](const Pass & pass)
+    {
+        return jd >= pass.rise - margin && jd <= pass.set + margin;
+    });
+}
+
 QString Satellite::sgp4ErrorString(int code)
 {
     switch (code)
@@ -9,7 +9,9 @@
 #include "skyobject.h"
 
 #include <QString>
+#include <QVector>
 
+class GeoLocation;
 class KSPopupMenu;
 
 /**
@@ -34,9 +36,102 @@ class Satellite : public SkyObject
         /** @short Destructor */
         virtual ~Satellite() override = default;
 
+        /**
+         * @short The observer and the sun at one instant.
+         * These are the same for all satellites, so when updating many satellites
+         * they are computed once with currentContext() and passed to updatePos().
+         */
+        struct Context
+        {
+            /// UTC julian day
+            double jd { 0 };
+            /// Local sidereal time and latitude of the observer
+            dms lst;
+            dms lat;
+            /// Observer latitude and sidereal angle
+            double sinlat { 0 }, coslat { 0 }, sintheta { 0 }, costheta { 0 };
+            /// Observer ECI position (km)
+            double obs_posx { 0 }, obs_posy { 0 }, obs_posz { 0 }, obs_posw { 0 };
+            /// Sun ECI position (km)
+            double sun_posx { 0 }, sun_posy { 0 }, sun_posz { 0 }, sun_posw { 0 };
+            /// True if the sun is at least 12° under horizon
+            bool dark { false };
+            /// True if satellites that cannot have risen since their last update may be left alone
+            bool skipBelowHorizon { false };
+        };
+
+        /**
+         * @return the context of the current simulation time and location.
+         * @param skipBelowHorizon whether updatePos() may skip satellites that are
+         * known to stay below the horizon for a while. Only ever enable this if
+         * those are not drawn anyway.
+         */
+        static Context currentContext(bool skipBelowHorizon = false);
+
+        /**
+         * @return the context at the UTC julian day \p jd for an observer at \p geo.
+         * Unlike currentContext() this does not need the sky composite, whether the sky is
+         * dark is found from the position of the sun computed here.
+         */
+        static Context context(double jd, const GeoLocation &geo);
+
+        /**
+         * @short A pass of the satellite above the horizon.
+         */
+        struct Pass
+        {
+            /// UTC julian days of rise, highest point and set
+            double rise { 0 }, culmination { 0 }, set { 0 };
+            /// Altitude at culmination in degrees
+            double maxAlt { 0 };
+
+            /**
+             * @short A point of the track of a pass.
+             */
+            struct Point
+            {
+                /// UTC julian day
+                double jd;
+                /// Equatorial coordinates of date and altitude in degrees
+                float ra, dec, alt;
+                /// True if the satellite is visible there, i.e. sunlit under a dark sky
+                bool visible;
+            };
+
+            /// The track, only kept for passes during which the satellite is visible at all
+            QVector<Point> track;
+        };
+
+        /**
+         * @short Predict the passes of the satellite.
+         * This propagates the satellite, so it is meant to be run on a copy of it.
+         * @param contexts the contexts of the prediction, one for every time step
+         * @param geo the observer, for the contexts between the time steps
+         */
+        QVector<Pass> predictPasses(const QVector<Context> &contexts, const GeoLocation &geo);
+
+        /**
+         * @short Set the passes predicted between the UTC julian days \p from and \p until.
+         * While the ground is drawn, the satellite is not propagated outside of them.
+         */
+        void setPasses(const QVector<Pass> &passes, double from, double until);
+
+        /** @return The passes set by setPasses() */
+        const QVector<Pass> &passes() const;
+
+        /** @return True if the passes are known at the UTC julian day \p jd */
+        bool hasPasses(double jd) const;
+
         /** @short Update satellite position */
         int updatePos();
 
+        /**
+         * @short Update satellite position for \p context.
+         * This only touches the satellite itself, so that different satellites may
+         * be updated from different threads at the same time.
+         */
+        int updatePos(const Context &context);
+
         /**
          * @return True if the satellite is visible (above horizon, in the sunlight and sun at least 12° under horizon)
          */
@@ -77,10 +172,22 @@ class Satellite : public SkyObject
         void init();
 
         /** @short Compute satellite position */
-        int sgp4(double tsince);
+        int sgp4(double tsince, const Context &context);
+
+        /** @return True if \p jd is in or close to one of the passes */
+        bool inPass(double jd) const;
+
+        /** @return The UTC julian day between \p below and \p above, when the satellite rises or sets */
+        double horizonCrossing(double below, double above, const GeoLocation &geo);
+
+        /**
+         * @short Remember until when the satellite is sure to stay below the horizon,
+         * given its geocentric position \p x, \p y, \p z (km) at \p context.
+         */
+        void updateSkip(double x, double y, double z, const Context &context);
 
         /** @return Arcsine of the argument */
-        double arcSin(double arg);
+        static double arcSin(double arg);
 
         /**
          * Provides the difference between UT (approximately the same as UTC)
@@ -88,10 +195,10 @@ class Satellite : public SkyObject
          * This function is based on a least squares fit of data from 1950
          * to 1991 and will need to be updated periodically.
          */
-        double deltaET(double year);
+        static double deltaET(double year);
 
         /** @return arg1 mod arg2 */
-        double Modulus(double arg1, double arg2);
+        static double Modulus(double arg1, double arg2);
 
         // TLE
         /// Satellite Number
@@ -146,6 +253,11 @@ class Satellite : public SkyObject
         double m_altitude { 0 };
         /// Satellite range from observer in km
         double m_range { 0 };
+        /// Julian days between which the satellite stays below the horizon
+        double m_below_from { 0 }, m_below_until { 0 };
+        /// Predicted passes and the julian days they were predicted for
+        QVector<Pass> m_passes;
+        double m_passes_from { 0 }, m_passes_until { 0 };
 
         // Near Earth
         bool isimp { false };
@@ -11,6 +11,7 @@
 #include "skyobjects/satellite.h"
 
 #include <QTextStream>
+#include <QtConcurrent>
 
 SatelliteGroup::SatelliteGroup(const QString& name, const QString& tle_filename, const QUrl& update_url)
 {
@@ -51,19 +52,36 @@ void SatelliteGroup::readTLE()
 
 void SatelliteGroup::updateSatellitesPos()
 {
-    QMutableListIterator<Satellite *> sats(*this);
+    updateSatellitesPos(Satellite::currentContext());
+}
 
-    while (sats.hasNext())
+void SatelliteGroup::updateSatellitesPos(const Satellite::Context &context)
+{
+    struct Update
     {
-        Satellite *sat = sats.next();
+        Satellite *sat;
+        int rc;
+    };
 
+    QVector<Update> updates;
+    updates.reserve(size());
+    for (Satellite *sat : *this)
+    {
         if (sat->selected())
-        {
-            int rc = sat->updatePos();
-            // If position cannot be calculated, remove it from list
-            if (rc != 0)
-                sats.remove();
-        }
+            updates.append({ sat, 0 });
+    }
+
+    // The satellites are independent of each other, propagate them on all cores
+    QtConcurrent::blockingMap(updates, [&context](Update &update)
+    {
+        update.rc = update.sat->updatePos(context);
+    });
+
+    // If position cannot be calculated, remove it from list
+    for (const Update &update : updates)
+    {
+        if (update.rc != 0)
+            removeOne(update.sat);
     }
 }
 
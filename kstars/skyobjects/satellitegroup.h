@@ -6,11 +6,11 @@
 
 #pragma once
 
+#include "skyobjects/satellite.h"
+
 #include <QString>
 #include <QUrl>
 
-class Satellite;
-
 /**
  * @class SatelliteGroup
  * Represents a group of artificial satellites.
@@ -37,6 +37,12 @@ class SatelliteGroup : public QList<Satellite *>
      */
     void updateSatellitesPos();
 
+    /**
+     * Compute the position of the each selected satellite in the group for \p context,
+     * which is shared by all groups updated at the same time.
+     */
+    void updateSatellitesPos(const Satellite::Context &context);
+
     /**
      * @return TLE filename
      */
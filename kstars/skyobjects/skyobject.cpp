@@ -297,23 +297,31 @@ SkyPoint SkyObject::recomputeCoords(const KStarsDateTime &dt, const GeoLocation
     // Create a clone
     SkyObject *c = this->clone();
 
-    // compute coords of the copy for new time jd
-    KSNumbers num(dt.djd());
-
     // Note: isSolarSystem() below should give the same result on this
     // and c. The only very minor reason to prefer this is so that we
     // have an additional layer of warnings about subclasses of
     // KSPlanetBase that do not implement SkyObject::clone() due to
     // the passing of lat and LST
 
-    if (isSolarSystem() && geo)
+    if (isSolarSystem())
     {
-        CachingDms LST = geo->GSTtoLST(dt.gst());
-        c->updateCoords(&num, true, geo->lat(), &LST);
+        // compute coords of the copy for new time jd
+        KSNumbers num(dt.djd());
+        if (geo)
+        {
+            CachingDms LST = geo->GSTtoLST(dt.gst());
+            c->updateCoords(&num, true, geo->lat(), &LST);
+        }
+        else
+        {
+            c->updateCoords(&num);
+        }
     }
     else
     {
-        c->updateCoords(&num);
+        // Fixed objects only need the precession and nutation, which rise/set searches
+        // over many objects may share
+        c->updateCoords(KSNumbers::shared(dt.djd()).get());
     }
 
     // Transfer the coordinates into a SkyPoint
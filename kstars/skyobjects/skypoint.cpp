@@ -67,6 +67,24 @@ void SkyPoint::set(const dms &r, const dms &d)
     lastPrecessJD = J2000; // By convention, we use J2000 coordinates
 }
 
+namespace
+{
+// Refraction corrections from SkyPoint::altCrit to 90 degrees, every REFRACTION_STEP degrees
+constexpr double REFRACTION_STEP = 0.05;
+
+struct RefractionTable
+{
+    RefractionTable()
+    {
+        for (int i = 0; i <= SIZE; i++)
+            corrections[i] = SkyPoint::refractionCorr(SkyPoint::altCrit + i * REFRACTION_STEP);
+    }
+
+    static constexpr int SIZE = 1820; // (90 - altCrit) / REFRACTION_STEP
+    double corrections[SIZE + 1];
+};
+}
+
 void SkyPoint::EquatorialToHorizontal(const dms *LST, const dms *lat)
 {
     //    qDebug() << Q_FUNC_INFO << "NOTE: This EquatorialToHorizontal overload (using dms pointers instead of CachingDms pointers) is deprecated and should be replaced with CachingDms prototype wherever speed is desirable!";
@@ -140,6 +158,55 @@ void SkyPoint::EquatorialToHorizontal(const CachingDms *LST, const CachingDms *l
     // 	Az.setRadians( atan2( yr, xr ) );
 }
 
+void SkyPoint::EquatorialToHorizontal(SkyPoint *const *points, int count, const CachingDms *LST,
+                                      const CachingDms *lat)
+{
+    QVarLengthArray<double, 512> buffer(6 * count);
+    double *sinHA = buffer.data(), *cosHA = sinHA + count, *sinDec = cosHA + count, *cosDec = sinDec + count;
+    double *alt = cosDec + count, *az = alt + count;
+
+    // The hour angles from the cached values, as CachingDms subtraction finds them
+    const CachingRadians lst(*LST);
+    for (int i = 0; i < count; i++)
+    {
+        const SkyPoint *p = points[i];
+        const CachingRadians hourAngle = lst - CachingRadians(p->ra());
+        sinHA[i]  = hourAngle.sin();
+        cosHA[i]  = hourAngle.cos();
+        sinDec[i] = p->dec().sin();
+        cosDec[i] = p->dec().cos();
+    }
+
+    horizontal(sinHA, cosHA, sinDec, cosDec, count, lat->sin(), lat->cos(), alt, az);
+
+    for (int i = 0; i < count; i++)
+    {
+        points[i]->Alt.setD(alt[i]);
+        points[i]->Az.setD(az[i]);
+    }
+}
+
+void SkyPoint::horizontal(const double *sinHA, const double *cosHA, const double *sinDec, const double *cosDec,
+                          int count, double sinLat, double cosLat, double *alt, double *az)
+{
+    using Array = Eigen::Map<const Eigen::ArrayXd>;
+    const Array sinH(sinHA, count), cosH(cosHA, count), sinD(sinDec, count), cosD(cosDec, count);
+
+    const Eigen::ArrayXd sinAlt = (sinD * sinLat + cosD * cosH * cosLat).min(1.0).max(-1.0);
+    Eigen::Map<Eigen::ArrayXd>(alt, count) = sinAlt.asin() / dms::DegToRad;
+
+    if (az == nullptr)
+        return;
+
+    // As in EquatorialToHorizontal(), the cosine of the altitude is never negative. It is kept off
+    // zero at the zenith, where the azimuth is undefined anyway.
+    const Eigen::ArrayXd cosAlt = (1.0 - sinAlt * sinAlt).sqrt().max(std::numeric_limits<double>::min());
+    const Eigen::ArrayXd azRad = ((sinD - sinAlt * sinLat) / (cosAlt * cosLat)).min(1.0).max(-1.0).acos();
+    // Resolve the acos() ambiguity
+    Eigen::Map<Eigen::ArrayXd>(az, count) =
+        (sinH > 0.0 && azRad != 0.0).select(2.0 * dms::PI - azRad, azRad) / dms::DegToRad;
+}
+
 void SkyPoint::HorizontalToEquatorial(const dms *LST, const dms *lat)
 {
     double HARad, DecRad;
@@ -707,6 +774,15 @@ void SkyPoint::apparentCoord(long double jd0, long double jdf)
     aberrate(&num);
 }
 
+void SkyPoint::apparentCoord(const KSNumbers *num)
+{
+    precess(num);
+    nutate(num);
+    if (Options::useRelativistic() && checkBendLight())
+        bendlight();
+    aberrate(num);
+}
+
 SkyPoint SkyPoint::catalogueCoord(long double jdf)
 {
     KSNumbers num(jdf);
@@ -1074,9 +1150,16 @@ double SkyPoint::refract(const double alt, bool conditional)
         return alt;
     }
     static double corrCrit = SkyPoint::refractionCorr(SkyPoint::altCrit);
+    static const RefractionTable table;
 
     if (alt > SkyPoint::altCrit)
-        return (alt + SkyPoint::refractionCorr(alt));
+    {
+        const double x = (alt - SkyPoint::altCrit) / REFRACTION_STEP;
+        const int i = int(x);
+        if (i >= RefractionTable::SIZE)
+            return (alt + SkyPoint::refractionCorr(alt));
+        return (alt + table.corrections[i] + (table.corrections[i + 1] - table.corrections[i]) * (x - i));
+    }
     else
         return (alt +
                 corrCrit * (alt + 90) /
@@ -321,6 +321,32 @@ class SkyPoint
         // Deprecated method provided for compatibility
         void EquatorialToHorizontal(const dms *LST, const dms *lat);
 
+        /**
+         * Determine the (Altitude, Azimuth) coordinates of many SkyPoints at once, as
+         * EquatorialToHorizontal() does for one. The cached sines and cosines of their
+         * coordinates are gathered into arrays and converted by horizontal().
+         * @param points the SkyPoints to convert
+         * @param count number of SkyPoints
+         * @param LST pointer to the local sidereal time
+         * @param lat pointer to the geographic latitude
+         */
+        static void EquatorialToHorizontal(SkyPoint *const *points, int count, const CachingDms *LST,
+                                           const CachingDms *lat);
+
+        /**
+         * @short Convert contiguous arrays of hour angles and declinations to horizontal coordinates
+         *
+         * The whole arrays go through each step of the conversion in turn, so that the compiler and
+         * Eigen can use SIMD instructions for them.
+         * @param sinHA, cosHA sines and cosines of count hour angles
+         * @param sinDec, cosDec sines and cosines of count declinations
+         * @param sinLat, cosLat sine and cosine of the geographic latitude
+         * @param alt filled with count altitudes, in degrees
+         * @param az filled with count azimuths, in degrees (optional)
+         */
+        static void horizontal(const double *sinHA, const double *cosHA, const double *sinDec, const double *cosDec,
+                               int count, double sinLat, double cosLat, double *alt, double *az = nullptr);
+
         /**
          * Determine the (RA, Dec) coordinates of the
          * SkyPoint from its (Altitude, Azimuth) coordinates, given the local
@@ -395,6 +421,15 @@ class SkyPoint
          */
         void apparentCoord(long double jd0, long double jdf);
 
+        /**
+         * Computes the apparent coordinates for the epoch of @p num from the J2000.0
+         * coordinates in RA0, Dec0. This is the same as apparentCoord(J2000, num->julianDay()),
+         * but reuses the precession and nutation terms of @p num rather than computing them anew.
+         *
+         * @param num time-dependent values for the final epoch
+         */
+        void apparentCoord(const KSNumbers *num);
+
         /**
          * Computes the J2000.0 catalogue coordinates for this SkyPoint using the epoch
          * removing aberration, nutation and precession
@@ -652,6 +687,8 @@ class SkyPoint
         /**
          * @short Apply refraction correction to altitude, depending on conditional
          *
+         * Above altCrit the correction is interpolated in a table of refractionCorr() every
+         * 0.05 degrees, which is within 0.1 arcseconds of it.
          * @param alt altitude to be corrected, in degrees
          * @param conditional an optional boolean to decide whether to apply the correction or not
          * @note If conditional is false, this method returns its argument unmodified. This is a convenience feature as it is often needed to gate these corrections.
@@ -17,6 +17,8 @@
 #include "skymap.h"
 #include "stardata.h"
 
+#include <QVarLengthArray>
+
 #include <typeinfo>
 
 #ifdef PROFILE_UPDATECOORDS
@@ -287,12 +289,101 @@ void StarObject::updateCoords(const KSNumbers *num, bool, const CachingDms *, co
 #endif
 }
 
-bool StarObject::getIndexCoords(const KSNumbers *num, CachingDms &ra, CachingDms &dec)
+void StarObject::updateCoords(StarObject *const *stars, int count, const KSNumbers *num)
 {
-    static double pmms;
+    // Same short-circuiting as in SkyPoint::updateCoords(), checked once for all the stars
+    const bool relativistic = Options::useRelativistic();
+    const bool alwaysRecompute = Options::alwaysRecomputeCoordinates();
+    const double jd = num->getJD();
+
+    // Unit vectors of the catalog positions, one array per component so that the precession vectorizes
+    constexpr int CHUNK_SIZE = 64;
+    StarObject *chunk[CHUNK_SIZE];
+    double x[CHUNK_SIZE], y[CHUNK_SIZE], z[CHUNK_SIZE];
+    int n = 0;
+
+    auto precessChunk = [&]()
+    {
+        const Eigen::Matrix3d &p = num->p2();
+        const double p00 = p(0, 0), p01 = p(0, 1), p02 = p(0, 2);
+        const double p10 = p(1, 0), p11 = p(1, 1), p12 = p(1, 2);
+        const double p20 = p(2, 0), p21 = p(2, 1), p22 = p(2, 2);
+        double vx[CHUNK_SIZE], vy[CHUNK_SIZE], vz[CHUNK_SIZE];
+
+        for (int i = 0; i < n; i++)
+        {
+            vx[i] = p00 * x[i] + p01 * y[i] + p02 * z[i];
+            vy[i] = p10 * x[i] + p11 * y[i] + p12 * z[i];
+            vz[i] = p20 * x[i] + p21 * y[i] + p22 * z[i];
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            StarObject *star = chunk[i];
+            CachingDms ra, dec;
+            ra.setUsing_atan2(vy[i], vx[i]);
+            ra.reduceToRange(dms::ZERO_TO_2PI);
+            dec.setUsing_asin(vz[i]);
+            star->setRA(ra);
+            star->setDec(dec);
+            star->nutate(num);
+            star->aberrate(num);
+            star->lastPrecessJD = jd;
+            Q_ASSERT(std::isfinite(star->ra().Degrees()) && std::isfinite(star->dec().Degrees()));
+        }
+        n = 0;
+    };
+
+    for (int i = 0; i < count; i++)
+    {
+        StarObject *star = stars[i];
+        if (!star)
+            continue;
+
+        Q_ASSERT(std::isfinite(star->lastPrecessJD));
+
+        // Light bending near the Sun is rare enough to go through the one star code path
+        if (relativistic && star->checkBendLight())
+        {
+            star->updateCoords(num);
+            continue;
+        }
+
+        if (!alwaysRecompute && std::abs(star->lastPrecessJD - jd) < 0.00069444) // Update once per solar minute
+            continue;
 
+        if (star->getIndexVector(num, &x[n], &y[n], &z[n]))
+        {
+            // Same as the catalog coordinates getIndexCoords() would return
+            const double norm = 1.0 / std::sqrt(x[n] * x[n] + y[n] * y[n] + z[n] * z[n]);
+            x[n] *= norm;
+            y[n] *= norm;
+            z[n] *= norm;
+        }
+        else
+        {
+            double cosRa, sinRa, cosDec, sinDec;
+            star->ra0().SinCos(sinRa, cosRa);
+            star->dec0().SinCos(sinDec, cosDec);
+            x[n] = cosRa * cosDec;
+            y[n] = sinRa * cosDec;
+            z[n] = sinDec;
+        }
+
+        chunk[n++] = star;
+        if (n == CHUNK_SIZE)
+            precessChunk();
+    }
+
+    if (n > 0)
+        precessChunk();
+}
+
+bool StarObject::getIndexCoords(const KSNumbers *num, CachingDms &ra, CachingDms &dec)
+{
     // =================== NOTE: CODE DUPLICATION ====================
-    // If you modify this, please also modify the other getIndexCoords
+    // If you modify this or getIndexVector, please also modify the
+    // other getIndexCoords
     // ===============================================================
     //
     // Reason for code duplication is as follows:
@@ -318,9 +409,9 @@ bool StarObject::getIndexCoords(const KSNumbers *num, CachingDms &ra, CachingDms
     //    double ddec = pmDec() * num->julianMillenia() / 3600.0;
 
 
-    pmms = pmMagnitudeSquared();
+    double x, y, z;
 
-    if (std::isnan(pmms) || pmms * num->julianMillenia() * num->julianMillenia() < .01)
+    if (!getIndexVector(num, &x, &y, &z))
     {
         // Ignore corrections
         ra  = ra0();
@@ -364,11 +455,34 @@ bool StarObject::getIndexCoords(const KSNumbers *num, CachingDms &ra, CachingDms
 
     */
 
+    // The correction itself uses the formula given in Seidelmann, see getIndexVector()
+    ra.setUsing_atan2(y, x);
+
+    // Note: dec = asin(z) is a poor choice, because we aren't
+    // guaranteed that (x, y, z) lies on the unit sphere due to the
+    // first-order approximation. Therefore, we must "project" out any
+    // change in the length of the vector to get our best estimate,
+    // and this is achieved by using atan. In fact atan gives the
+    // least-squares estimate for an angle given both its sin and
+    // cosine components.
+    dec.setUsing_atan2(z, sqrt(x * x + y * y));
+
+    return true;
+}
+
+bool StarObject::getIndexVector(const KSNumbers *num, double *x, double *y, double *z) const
+{
+    const double pmms = pmMagnitudeSquared();
+
+    if (std::isnan(pmms) || pmms * num->julianMillenia() * num->julianMillenia() < .01)
+        return false;
+
     // Use the formula given in Seidelmann (Explanatory Supplement to
-    // the Astronomical Almanac) instead. The formulas used here are
+    // the Astronomical Almanac) instead of the great circle motion in
+    // the comments of getIndexCoords(). The formulas used here are
     // the combination of (3.23-1), (3.23-3), (3.23-5). Not only does
     // it reduce trigonometry use, it is more likely to be correct
-    // than the stuff we came up with on our own above
+    // than the stuff we came up with on our own
 
     // Although it is not explained in the above reference, a formula
     // that reduces to α' = α + μ_α * t must have μ_α be the rate of
@@ -390,18 +504,9 @@ bool StarObject::getIndexCoords(const KSNumbers *num, CachingDms &ra, CachingDms
     double dX = - net_pmRA * sinRa - net_pmDec * sinDec * cosRa;
     double dY = net_pmRA * cosRa - net_pmDec * sinDec * sinRa;
     double dZ = net_pmDec * cosDec;
-    double x = x0 + dX, y = y0 + dY, z = z0 + dZ;
-
-    ra.setUsing_atan2(y, x);
-
-    // Note: dec = asin(z) is a poor choice, because we aren't
-    // guaranteed that (x, y, z) lies on the unit sphere due to the
-    // first-order approximation. Therefore, we must "project" out any
-    // change in the length of the vector to get our best estimate,
-    // and this is achieved by using atan. In fact atan gives the
-    // least-squares estimate for an angle given both its sin and
-    // cosine components.
-    dec.setUsing_atan2(z, sqrt(x * x + y * y));
+    *x = x0 + dX;
+    *y = y0 + dY;
+    *z = z0 + dZ;
 
     return true;
 }
@@ -411,7 +516,8 @@ bool StarObject::getIndexCoords(const KSNumbers *num, double *ra, double *dec)
     static double pmms;
 
     // =================== NOTE: CODE DUPLICATION ====================
-    // If you modify this, please also modify the other getIndexCoords
+    // If you modify this, please also modify getIndexVector, used by
+    // the other getIndexCoords
     // ===============================================================
     //
     // Reason for code duplication is as follows:
@@ -546,6 +652,37 @@ void StarObject::JITupdate()
     updateID = data->updateID();
 }
 
+void StarObject::JITupdate(StarObject *const *stars, int count)
+{
+    static KStarsData *data = KStarsData::Instance();
+    const quint64 numID = data->updateNumID();
+    const quint64 id = data->updateID();
+
+    QVarLengthArray<StarObject *, 256> stale;
+    for (int i = 0; i < count; i++)
+    {
+        StarObject *star = stars[i];
+        if (star && star->updateNumID != numID)
+        {
+            stale.append(star);
+            star->updateNumID = numID;
+        }
+    }
+    updateCoords(stale.constData(), stale.size(), data->updateNum());
+
+    QVarLengthArray<SkyPoint *, 256> moved;
+    for (int i = 0; i < count; i++)
+    {
+        StarObject *star = stars[i];
+        if (star && star->updateID != id)
+        {
+            moved.append(star);
+            star->updateID = id;
+        }
+    }
+    SkyPoint::EquatorialToHorizontal(moved.constData(), moved.size(), data->lst(), data->geo()->lat());
+}
+
 QString StarObject::sptype(void) const
 {
     return QString(QByteArray(SpType, 2));
@@ -171,6 +171,15 @@ class StarObject : public SkyObject
     void updateCoords(const KSNumbers *num, bool includePlanets = true, const CachingDms *lat = nullptr,
                       const CachingDms *LST = nullptr, bool forceRecompute = false) override;
 
+    /**
+     * @short Same as calling updateCoords(num) on each of the given stars, but faster for many stars.
+     *
+     * The proper motion corrected catalog position of each star is kept as a direction vector, so it
+     * needs no trigonometry before precession, and the stars are precessed in chunks so that the matrix
+     * products vectorize. Null entries are skipped.
+     */
+    static void updateCoords(StarObject *const *stars, int count, const KSNumbers *num);
+
     /**
      * @short Fills ra and dec with the coordinates of the star with the proper
      * motion correction but without precision and its friends.  It is used
@@ -189,6 +198,12 @@ class StarObject : public SkyObject
     /** @short added for JIT updates from both StarComponent and ConstellationLines */
     void JITupdate();
 
+    /**
+     * @short JITupdate() for the given stars, with their coordinates updated together by the batched
+     * updateCoords(). Stars already up to date and null entries are skipped.
+     */
+    static void JITupdate(StarObject *const *stars, int count);
+
     /** @short returns the magnitude of the proper motion correction in milliarcsec/year */
     inline double pmMagnitude() const
     {
@@ -298,6 +313,13 @@ class StarObject : public SkyObject
     // END DEBUG
 
   private:
+    /**
+     * @short Direction of the star at the epoch of num, with the first order proper motion correction,
+     * not normalized. It is the common part of getIndexCoords() and the batched updateCoords().
+     * @return false, leaving x, y and z untouched, if the correction is negligible.
+     */
+    bool getIndexVector(const KSNumbers *num, double *x, double *y, double *z) const;
+
     double PM_RA { 0 };
     double PM_Dec { 0 };
     double Parallax { 0 };
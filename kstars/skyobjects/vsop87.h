@@ -0,0 +1,45 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+/**
+ * The VSOP87 series of the Earth and the major planets.
+ *
+ * The tables are generated from data/vsop87 at build time by
+ * vsop87tables.cmake, so that nothing has to be read or parsed at run time
+ * and they may be used from several threads at once.
+ */
+namespace VSOP87
+{
+/** A single term A*cos(B + C*T) of a series */
+struct Term
+{
+    double A, B, C;
+};
+
+/** The terms of one series, the sum of which is multiplied by T^n */
+struct Series
+{
+    const Term *terms;
+    int size;
+};
+
+/** The six series of the ecliptic longitude, latitude and distance of a body */
+struct Body
+{
+    const char *name;
+    Series L[6];
+    Series B[6];
+    Series R[6];
+};
+
+/**
+ * @return the series of the body @p name, e.g. "mars" or "earth", or nullptr
+ * if there are none
+ */
+const Body *body(const char *name);
+} // namespace VSOP87
@@ -0,0 +1,71 @@
+# SPDX-FileCopyrightText: 2026 KStars Developers
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+# Compiles the VSOP87 series in VSOP87_DIR, files named "body.[LBR][0...5].vsop"
+# with one "A B C" term per line, into the tables declared in vsop87.h.
+#
+# cmake -DVSOP87_DIR=<data/vsop87> -DOUTPUT=<vsop87tables.cpp> -P vsop87tables.cmake
+
+set(bodies earth mercury venus mars jupiter saturn uranus neptune)
+set(number "[-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?")
+
+set(tables "")
+set(index "")
+
+foreach(body ${bodies})
+    set(entry "    { \"${body}\",\n")
+    foreach(coord L B R)
+        string(APPEND entry "      {")
+        foreach(power RANGE 5)
+            set(file "${VSOP87_DIR}/${body}.${coord}${power}.vsop")
+            set(terms "")
+            set(count 0)
+            if(EXISTS "${file}")
+                file(STRINGS "${file}" lines)
+                foreach(line ${lines})
+                    if(line MATCHES "^[ \t]*(${number})[ \t]+(${number})[ \t]+(${number})[ \t]*$")
+                        string(APPEND terms "    { ${CMAKE_MATCH_1}, ${CMAKE_MATCH_3}, ${CMAKE_MATCH_5} },\n")
+                        math(EXPR count "${count} + 1")
+                    endif()
+                endforeach()
+            endif()
+
+            if(count GREATER 0)
+                string(APPEND tables "constexpr Term ${body}_${coord}${power}[] = {\n${terms}};\n\n")
+                string(APPEND entry " { ${body}_${coord}${power}, ${count} },")
+            else()
+                string(APPEND entry " { nullptr, 0 },")
+            endif()
+        endforeach()
+        string(APPEND entry " },\n")
+    endforeach()
+    string(APPEND index "${entry}    },\n")
+endforeach()
+
+file(WRITE "${OUTPUT}"
+"// Generated from data/vsop87 by vsop87tables.cmake, do not edit.
+
+#include \"vsop87.h\"
+
+#include <cstring>
+
+namespace VSOP87
+{
+namespace
+{
+${tables}constexpr Body bodies[] = {
+${index}};
+}
+
+const Body *body(const char *name)
+{
+    for (const Body &b : bodies)
+    {
+        if (std::strcmp(b.name, name) == 0)
+            return &b;
+    }
+    return nullptr;
+}
+}
+")
+
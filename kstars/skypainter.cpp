@@ -12,9 +12,11 @@
 #include "kstarsdata.h"
 #include "skycomponents/skiphashlist.h"
 #include "skycomponents/linelistlabel.h"
+#include "skyobjects/catalogobject.h"
 #include "skyobjects/kscomet.h"
 #include "skyobjects/ksasteroid.h"
 #include "skyobjects/ksplanetbase.h"
+#include "skyobjects/starobject.h"
 #include "skyobjects/trailobject.h"
 #include "skyobjects/constellationsart.h"
 
@@ -22,12 +24,51 @@ SkyPainter::SkyPainter()
 {
 }
 
+void SkyPainter::prepareStars(StarDrawList *) const
+{
+}
+
+int SkyPainter::drawStars(StarDrawList *list)
+{
+    int drawn = 0;
+    list->visible.resize(list->stars.size());
+    for (int i = 0; i < list->stars.size(); i++)
+    {
+        const StarObject *star = list->stars.at(i);
+        list->visible[i] = drawPointSource(star, star->mag(), star->spchar());
+        drawn += list->visible.at(i);
+    }
+    return drawn;
+}
+
+void SkyPainter::prepareCatalogObjects(CatalogDrawList *) const
+{
+}
+
+int SkyPainter::drawCatalogObjects(CatalogDrawList *list)
+{
+    int drawn = 0;
+    list->visible.resize(list->objects.size());
+    for (int i = 0; i < list->objects.size(); i++)
+    {
+        setPen(list->colors.at(i));
+        list->visible[i] = drawCatalogObject(*list->objects.at(i));
+        drawn += list->visible.at(i);
+    }
+    return drawn;
+}
+
 void SkyPainter::setSizeMagLimit(float sizeMagLim)
 {
     m_sizeMagLim = sizeMagLim;
 }
 
 float SkyPainter::starWidth(float mag) const
+{
+    return starWidth(mag, starSizeFactor());
+}
+
+float SkyPainter::starSizeFactor() const
 {
     //adjust maglimit for ZoomLevel
     const double maxSize = 10.0;
@@ -36,7 +77,12 @@ float SkyPainter::starWidth(float mag) const
     //    double lgmax = log10(MAXZOOM);
     double lgz = log10(Options::zoomFactor());
 
-    float sizeFactor = maxSize + (lgz - lgmin);
+    return maxSize + (lgz - lgmin);
+}
+
+float SkyPainter::starWidth(float mag, float sizeFactor) const
+{
+    const double maxSize = 10.0;
 
     float size = (sizeFactor * (m_sizeMagLim - mag) / m_sizeMagLim) + 1.;
     if (size <= 1.0)
@@ -10,7 +10,10 @@
 #include "skycomponents/typedef.h"
 #include "config-kstars.h"
 
+#include <QColor>
 #include <QList>
+#include <QPointF>
+#include <QVector>
 #include <QPainter>
 
 class ConstellationsArt;
@@ -27,6 +30,7 @@ class SkipHashList;
 class SkyMap;
 class SkyObject;
 class SkyPoint;
+class StarObject;
 class Supernova;
 class CatalogObject;
 class ImageOverlay;
@@ -128,6 +132,31 @@ class SkyPainter
          */
         virtual bool drawPointSource(const SkyPoint *loc, float mag, char sp = 'A') = 0;
 
+        /**
+         * @short Stars of one trixel or star block, prepared by prepareStars() and drawn by drawStars().
+         */
+        struct StarDrawList
+        {
+            QVector<StarObject *> stars;
+            QVector<QPointF> screen;
+            // Whether each star is to be drawn, and after drawStars() whether it was
+            QVector<bool> visible;
+        };
+
+        /**
+         * @short Project the stars of a draw list, ready for drawStars().
+         * Unlike the drawing methods, this may be called from worker threads, on different lists at the
+         * same time. The default implementation does nothing, leaving all the work to drawStars().
+         */
+        virtual void prepareStars(StarDrawList *list) const;
+
+        /**
+         * @short Draw the stars of a draw list, e.g. those of a trixel.
+         * The default implementation calls drawPointSource() for each star.
+         * @return number of stars drawn, list->visible telling which.
+         */
+        virtual int drawStars(StarDrawList *list);
+
         /**
         * @short Draw a deep sky object (loaded from the new implementation)
         * @param obj the object to draw
@@ -136,6 +165,35 @@ class SkyPainter
         */
         virtual bool drawCatalogObject(const CatalogObject &obj) = 0;
 
+        /**
+         * @short Deep sky objects of one trixel, prepared by prepareCatalogObjects() and drawn by drawCatalogObjects().
+         */
+        struct CatalogDrawList
+        {
+            QVector<CatalogObject *> objects;
+            // Colour each object is drawn in
+            QVector<QColor> colors;
+            QVector<QPointF> screen;
+            // Angle of the symbol of each object on the screen
+            QVector<float> positionAngles;
+            // Whether each object is to be drawn, and after drawCatalogObjects() whether it was
+            QVector<bool> visible;
+        };
+
+        /**
+         * @short Project the objects of a draw list, ready for drawCatalogObjects().
+         * As prepareStars(), this may be called from worker threads, on different lists at the same time.
+         * The default implementation does nothing, leaving all the work to drawCatalogObjects().
+         */
+        virtual void prepareCatalogObjects(CatalogDrawList *list) const;
+
+        /**
+         * @short Draw the deep sky objects of a draw list, e.g. those of a trixel.
+         * The default implementation calls drawCatalogObject() for each object.
+         * @return number of objects drawn, list->visible telling which.
+         */
+        virtual int drawCatalogObjects(CatalogDrawList *list);
+
         /**
              * @short Draw a planet
              * @param planet the planet to draw
@@ -171,6 +229,15 @@ class SkyPainter
         /** @short Get the width of a star of magnitude mag */
         float starWidth(float mag) const;
 
+        /**
+         * @short Get the width of a star of magnitude mag, given the result of starSizeFactor()
+         * This saves looking up the zoom level for each star when drawing many of them.
+         */
+        float starWidth(float mag, float sizeFactor) const;
+
+        /** @short Zoom dependent factor of the star widths */
+        float starSizeFactor() const;
+
         /**
          * @short Draw a ConstellationsArt object
          * @param obj the object to draw
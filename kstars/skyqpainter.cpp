@@ -6,6 +6,7 @@
 
 #include "skyqpainter.h"
 
+#include <QCache>
 #include <QPointer>
 
 #include "kstarsdata.h"
@@ -29,6 +30,7 @@
 #include "skyobjects/kscomet.h"
 #include "skyobjects/kssun.h"
 #include "skyobjects/satellite.h"
+#include "skyobjects/starobject.h"
 #include "skyobjects/supernova.h"
 #include "skyobjects/ksearthshadow.h"
 #ifdef HAVE_INDI
@@ -37,8 +39,14 @@
 #include "hips/hipsrenderer.h"
 #include "terrain/terrainrenderer.h"
 #include <QElapsedTimer>
+#include <QPainterPath>
+#include <QVarLengthArray>
+#include <QtMath>
 #include "auxiliary/rectangleoverlap.h"
 
+#include <algorithm>
+#include <map>
+
 namespace
 {
 // Convert spectral class to numerical index.
@@ -80,32 +88,236 @@ const int nStarSizes = 15;
 // N.B. Must be in sync with harvardToIndex
 const int nSPclasses = 7;
 
-// Cache for star images.
-//
-// These pixmaps are never deallocated. Not really good...
-QPixmap *imageCache[nSPclasses][nStarSizes] = { { nullptr } };
+// Largest star image of each spectral class, scaled down into the atlases
+QImage starImages[nSPclasses];
 
-std::unique_ptr<QPixmap> visibleSatPixmap, invisibleSatPixmap;
-} // namespace
+// All star images in one pixmap, a row per spectral class and a column per size, so that the
+// stars of a trixel are drawn in a single drawPixmapFragments() call. The images are rendered
+// in device pixels, an atlas is kept for each device pixel ratio the sky was drawn at.
+struct StarAtlas
+{
+    QPixmap pixmap;
+    qreal ratio { 1 };
+    // Distance between images in device pixels, one more than the largest so they don't bleed
+    int pitch { 0 };
 
-int SkyQPainter::starColorMode           = 0;
-QColor SkyQPainter::m_starColor          = QColor();
-QMap<char, QColor> SkyQPainter::ColorMap = QMap<char, QColor>();
+    QRectF source(int spIndex, int size) const
+    {
+        const int extent = qRound(size * ratio);
+        return QRectF(size * pitch, spIndex * pitch, extent, extent);
+    }
+};
+std::map<int, StarAtlas> starAtlases;
 
-void SkyQPainter::releaseImageCache()
+const StarAtlas &starAtlas(qreal ratio)
 {
-    for (char &color : ColorMap.keys())
+    // Ratios are only told apart to a hundredth
+    const int key = qRound(ratio * 100);
+    auto found = starAtlases.find(key);
+    if (found != starAtlases.end())
+        return found->second;
+
+    StarAtlas &atlas = starAtlases[key];
+    atlas.ratio = key / 100.0;
+    atlas.pitch = qCeil((nStarSizes - 1) * atlas.ratio) + 1;
+
+    QImage image(nStarSizes * atlas.pitch, nSPclasses * atlas.pitch, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter p(&image);
+    for (int sp = 0; sp < nSPclasses; sp++)
     {
-        QPixmap **pmap = imageCache[harvardToIndex(color)];
-
+        if (starImages[sp].isNull())
+            continue;
         for (int size = 1; size < nStarSizes; size++)
         {
-            if (pmap[size])
-                delete pmap[size];
+            const QRectF source = atlas.source(sp, size);
+            p.drawImage(source.topLeft(), starImages[sp].scaled(source.size().toSize(), Qt::KeepAspectRatio,
+                        Qt::SmoothTransformation));
+        }
+    }
+    p.end();
+    atlas.pixmap = QPixmap::fromImage(image);
+    return atlas;
+}
+
+// A fragment of the atlas drawing the image of @p size and spectral class @p sp centred on @p pos
+QPainter::PixmapFragment starFragment(const StarAtlas &atlas, const QPointF &pos, float size, char sp)
+{
+    const int isize = qBound(1, static_cast<int>(size), nStarSizes - 1);
+    // Fragments are drawn at the size of their source, the atlas is in device pixels
+    return QPainter::PixmapFragment::create(pos, atlas.source(harvardToIndex(sp), isize), 1 / atlas.ratio,
+                                            1 / atlas.ratio);
+}
 
-            pmap[size] = nullptr;
+std::unique_ptr<QPixmap> visibleSatPixmap, invisibleSatPixmap;
+
+// Constellation art scaled, rotated and faded for the view it was last drawn in. Panning mostly
+// just moves the images, so they are blitted until the zoom or their angle on the screen change.
+struct ArtPixmap
+{
+    QPixmap pixmap;
+    // Where the midpoint of the image is in the pixmap
+    QPointF origin;
+    double zoom { 0 };
+    int angle { 0 };
+};
+// Angles are matched to this many steps per degree
+const int artAngleSteps = 2;
+// Pixmaps larger than this are not cached, they are only drawn when zoomed in on a few constellations
+const int artMaxPixmapSize = 2048;
+QCache<QString, ArtPixmap> artPixmaps(64 * 1024 * 1024);
+
+// How the cached symbol of a deep sky type is filled and drawn
+enum SymbolFill
+{
+    // with the brush of the painter, as drawDeepSkySymbol() does
+    CurrentBrush,
+    // with the colour of the pen, for the dots of clusters
+    PenBrush,
+    // not at all, for the symbols made of lines and for dashed ellipses
+    NoFill
+};
+
+SymbolFill symbolFill(int type)
+{
+    switch (type)
+    {
+        case SkyObject::OPEN_CLUSTER:
+        case SkyObject::ASTERISM:
+            return PenBrush;
+        case SkyObject::GASEOUS_NEBULA:
+        case SkyObject::DARK_NEBULA:
+        case SkyObject::SUPERNOVA_REMNANT:
+        case SkyObject::GALAXY_CLUSTER:
+            return NoFill;
+        default:
+            return CurrentBrush;
+    }
+}
+
+// Whether the symbol of a deep sky type turns with the position angle of the object
+bool symbolRotates(int type)
+{
+    return type != SkyObject::STAR && type != SkyObject::CATALOG_STAR && type != SkyObject::OPEN_CLUSTER &&
+           type != SkyObject::ASTERISM;
+}
+
+// Symbols of deep sky objects as drawDeepSkySymbol() draws them, centred on the origin and not rotated.
+// They are kept by type, size to a quarter of a pixel and eccentricity to a 64th, closer than can be seen.
+QHash<quint64, QPainterPath> deepSkySymbols;
+const int maxDeepSkySymbols = 4096;
+
+// The symbol of a deep sky object of @p size pixels, nullptr if drawDeepSkySymbol() draws it as a point,
+// with a text, or not at all. The symbol is only valid until the next call.
+const QPainterPath *deepSkySymbol(int type, float size, float e, float zoom)
+{
+    switch (type)
+    {
+        case SkyObject::STAR:
+        case SkyObject::CATALOG_STAR:
+        case SkyObject::GLOBULAR_CLUSTER:
+        case SkyObject::PLANETARY_NEBULA:
+            size = std::max(size, 2.f);
+            break;
+        case SkyObject::GALAXY:
+        case SkyObject::QUASAR:
+            if (size < 1. && zoom > 20 * MINZOOM)
+                size = 3.;
+            if (size < 1. && zoom > 5 * MINZOOM)
+                size = 1.;
+            if (size <= 2.)
+                return nullptr;
+            break;
+        case SkyObject::OPEN_CLUSTER:
+        case SkyObject::ASTERISM:
+        case SkyObject::GASEOUS_NEBULA:
+        case SkyObject::DARK_NEBULA:
+        case SkyObject::SUPERNOVA_REMNANT:
+        case SkyObject::GALAXY_CLUSTER:
+            break;
+        default:
+            return nullptr;
+    }
+
+    const quint64 quarters = qRound(size * 4);
+    const quint64 sixtyFourths = qBound(0, qRound(e * 64), 255);
+    const quint64 key = quarters << 16 | sixtyFourths << 8 | quint64(type & 0xff);
+    auto found = deepSkySymbols.constFind(key);
+    if (found != deepSkySymbols.constEnd())
+        return &*found;
+
+    if (deepSkySymbols.size() >= maxDeepSkySymbols)
+        deepSkySymbols.clear();
+
+    const double s = quarters / 4.;
+    const double h = sixtyFourths / 64. * s;
+    QPainterPath path;
+    auto addLine = [&path](double x1, double y1, double x2, double y2)
+    {
+        path.moveTo(x1, y1);
+        path.lineTo(x2, y2);
+    };
+    switch (type)
+    {
+        case SkyObject::STAR:
+        case SkyObject::CATALOG_STAR:
+            path.addEllipse(QRectF(-s / 2, -s / 2, s, s));
+            break;
+        case SkyObject::OPEN_CLUSTER:
+        case SkyObject::ASTERISM:
+        {
+            double psize = 2.;
+            if (s > 50.)
+                psize *= 2.;
+            if (s > 100.)
+                psize *= 2.;
+            const QPointF dots[] = { {-s / 4, -h / 2}, {s / 4, -h / 2}, {-s / 4, h / 2}, {s / 4, h / 2},
+                {-s / 2, -h / 4}, {-s / 2, h / 4}, {s / 2, -h / 4}, {s / 2, h / 4}
+            };
+            for (const QPointF &dot : dots)
+                path.addEllipse(dot, psize / 2, psize / 2);
+            break;
         }
+        case SkyObject::GLOBULAR_CLUSTER:
+            path.addEllipse(QRectF(-s / 2, -h / 2, s, h));
+            addLine(-s / 2, 0, s / 2, 0);
+            addLine(0, -h / 2, 0, h / 2);
+            break;
+        case SkyObject::GASEOUS_NEBULA:
+        case SkyObject::DARK_NEBULA:
+            path.addRect(QRectF(-s / 2, -h / 2, s, h));
+            break;
+        case SkyObject::PLANETARY_NEBULA:
+            path.addEllipse(QRectF(-s / 2, -h / 2, s, h));
+            addLine(0, -h / 2, 0, -h);
+            addLine(0, h / 2, 0, h);
+            addLine(-s / 2, 0, -s, 0);
+            addLine(s / 2, 0, s, 0);
+            break;
+        case SkyObject::SUPERNOVA_REMNANT:
+            path.moveTo(0, -h / 2);
+            path.lineTo(s / 2, 0);
+            path.lineTo(0, h / 2);
+            path.lineTo(-s / 2, 0);
+            path.closeSubpath();
+            break;
+        default:
+            path.addEllipse(QRectF(-s / 2, -h / 2, s, h));
+            break;
     }
+    return &*deepSkySymbols.insert(key, path);
+}
+} // namespace
+
+int SkyQPainter::starColorMode           = 0;
+QColor SkyQPainter::m_starColor          = QColor();
+QMap<char, QColor> SkyQPainter::ColorMap = QMap<char, QColor>();
+
+void SkyQPainter::releaseImageCache()
+{
+    starAtlases.clear();
+    for (auto &image : starImages)
+        image = QImage();
 }
 
 SkyQPainter::SkyQPainter(QPaintDevice *pd) : SkyPainter(), QPainter()
@@ -141,7 +353,10 @@ SkyQPainter::~SkyQPainter()
 void SkyQPainter::begin()
 {
     QPainter::begin(m_pd);
-    bool aa = !SkyMap::Instance()->isSlewing() && Options::useAntialias();
+    // While moving, anti-aliasing is kept as long as the frames are fast enough
+    const bool slewing = SkyMap::Instance()->isSlewing();
+    const bool adapt = Options::adaptiveQuality() && KStarsData::Instance()->skyComposite()->renderQuality().antialias();
+    bool aa = Options::useAntialias() && (!slewing || adapt);
     setRenderHint(QPainter::Antialiasing, aa);
     setRenderHint(QPainter::HighQualityAntialiasing, aa);
     m_proj = SkyMap::Instance()->projector();
@@ -210,7 +425,7 @@ void SkyQPainter::initStarImages()
 
     for (char &color : ColorMap.keys())
     {
-        QPixmap BigImage(15, 15);
+        QImage BigImage(15, 15, QImage::Format_ARGB32_Premultiplied);
         BigImage.fill(Qt::transparent);
 
         QPainter p;
@@ -253,17 +468,10 @@ void SkyQPainter::initStarImages()
         }
         p.end();
 
-        // Cache array slice
-        QPixmap **pmap = imageCache[harvardToIndex(color)];
-
-        for (int size = 1; size < nStarSizes; size++)
-        {
-            if (!pmap[size])
-                pmap[size] = new QPixmap();
-            *pmap[size] = BigImage.scaled(size, size, Qt::KeepAspectRatio,
-                                          Qt::SmoothTransformation);
-        }
+        starImages[harvardToIndex(color)] = BigImage;
     }
+    // The atlases are rebuilt from the new images when next drawn
+    starAtlases.clear();
     starColorMode = Options::starColorMode();
 
     if (!visibleSatPixmap.get())
@@ -298,26 +506,49 @@ void SkyQPainter::drawSkyLine(SkyPoint *a, SkyPoint *b)
     //    } //FIXME: what if both are offscreen but the line isn't?
 }
 
+void SkyQPainter::projectLineList(LineList *list) const
+{
+    SkyList *points = list->points();
+    const int count = points->size();
+
+    if (list->cacheScreenPoints && list->screenViewID == m_proj->viewID() &&
+            list->screenUpdateID == list->updateID && list->screenPoints.size() == count)
+        return;
+
+    QVarLengthArray<const SkyPoint *, 256> skyPoints(count);
+    for (int j = 0; j < count; j++)
+        skyPoints[j] = points->at(j).get();
+    list->screenPoints.resize(count);
+    list->screenVisible.resize(count);
+    m_proj->toScreen(skyPoints.constData(), count, list->screenPoints.data(), list->screenVisible.data());
+
+    list->screenViewID   = m_proj->viewID();
+    list->screenUpdateID = list->updateID;
+}
+
 void SkyQPainter::drawSkyPolyline(LineList *list, SkipHashList *skipList,
                                   LineListLabel *label)
 {
-    SkyList *points = list->points();
-    bool isVisible, isVisibleLast;
+    const int count = list->points()->size();
 
-    if (points->size() == 0)
+    if (count == 0)
         return;
-    QPointF oLast = m_proj->toScreen(points->first().get(), true, &isVisibleLast);
-    // & with the result of checkVisibility to clip away things below horizon
-    isVisibleLast &= m_proj->checkVisibility(points->first().get());
-    QPointF oThis, oThis2;
 
-    for (int j = 1; j < points->size(); j++)
-    {
-        SkyPoint *pThis = points->at(j).get();
+    // visible includes checkVisibility, to clip away things below horizon
+    projectLineList(list);
+    const QPointF *screen = list->screenPoints.constData();
+    const bool *visible   = list->screenVisible.constData();
 
-        oThis2 = oThis = m_proj->toScreen(pThis, true, &isVisible);
-        // & with the result of checkVisibility to clip away things below horizon
-        isVisible &= m_proj->checkVisibility(pThis);
+    //Temporary solution to avoid random lines in Gnomonic projection and draw lines up to horizon
+    const bool gnomonic = SkyMap::Instance()->projector()->type() == Projector::Gnomonic;
+
+    QPointF oLast = screen[0];
+    bool isVisibleLast = visible[0];
+
+    for (int j = 1; j < count; j++)
+    {
+        const QPointF oThis = screen[j];
+        const bool isVisible = visible[j];
         bool doSkip = false;
         if (skipList)
         {
@@ -325,8 +556,7 @@ void SkyQPainter::drawSkyPolyline(LineList *list, SkipHashList *skipList,
         }
 
         bool pointsVisible = false;
-        //Temporary solution to avoid random lines in Gnomonic projection and draw lines up to horizon
-        if (SkyMap::Instance()->projector()->type() == Projector::Gnomonic)
+        if (gnomonic)
         {
             if (isVisible && isVisibleLast)
                 pointsVisible = true;
@@ -347,7 +577,7 @@ void SkyQPainter::drawSkyPolyline(LineList *list, SkipHashList *skipList,
             }
         }
 
-        oLast         = oThis2;
+        oLast         = oThis;
         isVisibleLast = isVisible;
     }
 }
@@ -373,17 +603,22 @@ void SkyQPainter::drawSkyPolygon(LineList *list, bool forceClip)
         return;
     }
 
+    if (points->isEmpty())
+        return;
+
+    // visible includes checkVisibility, to clip away things below horizon
+    projectLineList(list);
+    const int count = points->size();
+
     SkyPoint *pLast = points->last().get();
-    QPointF oLast   = m_proj->toScreen(pLast, true, &isVisibleLast);
-    // & with the result of checkVisibility to clip away things below horizon
-    isVisibleLast &= m_proj->checkVisibility(pLast);
+    QPointF oLast   = list->screenPoints.at(count - 1);
+    isVisibleLast   = list->screenVisible.at(count - 1);
 
-    for (const auto &point : *points)
+    for (int j = 0; j < count; j++)
     {
-        SkyPoint *pThis = point.get();
-        QPointF oThis   = m_proj->toScreen(pThis, true, &isVisible);
-        // & with the result of checkVisibility to clip away things below horizon
-        isVisible &= m_proj->checkVisibility(pThis);
+        SkyPoint *pThis = points->at(j).get();
+        QPointF oThis   = list->screenPoints.at(j);
+        isVisible       = list->screenVisible.at(j);
 
         if (isVisible && isVisibleLast)
         {
@@ -617,15 +852,59 @@ bool SkyQPainter::drawPointSource(const SkyPoint *loc, float mag, char sp)
     }
 }
 
+void SkyQPainter::prepareStars(StarDrawList *list) const
+{
+    const int count = list->stars.size();
+    QVarLengthArray<const SkyPoint *, 256> points(count);
+    for (int i = 0; i < count; i++)
+        points[i] = list->stars.at(i);
+
+    list->screen.resize(count);
+    list->visible.resize(count);
+    m_proj->toScreen(points.constData(), count, list->screen.data(), list->visible.data());
+
+    // FIXME: onScreen here should use canvas size rather than SkyMap size, especially while printing in portrait mode!
+    for (int i = 0; i < count; i++)
+        list->visible[i] = list->visible.at(i) && m_proj->onScreen(list->screen.at(i));
+}
+
+int SkyQPainter::drawStars(StarDrawList *list)
+{
+    if (list->screen.size() != list->stars.size())
+        prepareStars(list);
+
+    const float sizeFactor = starSizeFactor();
+    const bool bitmaps = !m_vectorStars || starColorMode == 0;
+    const StarAtlas *atlas = bitmaps ? &starAtlas(m_pd->devicePixelRatioF()) : nullptr;
+    QVarLengthArray<QPainter::PixmapFragment, 256> fragments;
+    int drawn = 0;
+    for (int i = 0; i < list->stars.size(); i++)
+    {
+        if (!list->visible.at(i))
+            continue;
+        const StarObject *star = list->stars.at(i);
+        const float size = starWidth(star->mag(), sizeFactor);
+        const QPointF &pos = list->screen.at(i);
+        // Same as drawPointSource(), without its per star checks
+        if (bitmaps)
+            fragments.append(starFragment(*atlas, pos, size, star->spchar()));
+        else
+            drawPointSource(pos, size, star->spchar());
+        drawn++;
+    }
+    if (!fragments.isEmpty())
+        drawPixmapFragments(fragments.constData(), fragments.size(), atlas->pixmap);
+    return drawn;
+}
+
 void SkyQPainter::drawPointSource(const QPointF &pos, float size, char sp)
 {
-    int isize = qMin(static_cast<int>(size), 14);
     if (!m_vectorStars || starColorMode == 0)
     {
         // Draw stars as bitmaps, either because we were asked to, or because we're painting real colors
-        QPixmap *im  = imageCache[harvardToIndex(sp)][isize];
-        float offset = 0.5 * im->width();
-        drawPixmap(QPointF(pos.x() - offset, pos.y() - offset), *im);
+        const StarAtlas &atlas = starAtlas(m_pd->devicePixelRatioF());
+        const QPainter::PixmapFragment fragment = starFragment(atlas, pos, size, sp);
+        drawPixmapFragments(&fragment, 1, atlas.pixmap);
     }
     else
     {
@@ -673,6 +952,48 @@ bool SkyQPainter::drawConstellationArtImage(ConstellationsArt *obj)
     float w = obj->getWidth() * 60 * dms::PI * zoom / 10800;
     float h = obj->getHeight() * 60 * dms::PI * zoom / 10800;
 
+    const int angle = qRound(positionangle * artAngleSteps);
+    ArtPixmap *art  = artPixmaps.object(obj->getImageFileName());
+    if (art == nullptr || art->zoom != zoom || art->angle != angle)
+    {
+        QTransform transform;
+        transform.rotate(double(angle) / artAngleSteps);
+        const QRect bounds = transform.mapRect(QRectF(-0.5 * w, -0.5 * h, w, h)).toAlignedRect();
+
+        if (bounds.width() > artMaxPixmapSize || bounds.height() > artMaxPixmapSize)
+        {
+            artPixmaps.remove(obj->getImageFileName());
+            art = nullptr;
+        }
+        else
+        {
+            art = new ArtPixmap;
+            art->zoom   = zoom;
+            art->angle  = angle;
+            art->origin = -bounds.topLeft();
+            art->pixmap = QPixmap(bounds.size());
+            art->pixmap.fill(Qt::transparent);
+
+            QPainter p(&art->pixmap);
+            p.setRenderHint(QPainter::SmoothPixmapTransform);
+            p.translate(art->origin);
+            p.setTransform(transform, true);
+            p.setOpacity(0.7);
+            p.drawImage(QRectF(-0.5 * w, -0.5 * h, w, h), obj->image());
+            p.end();
+
+            const int cost = bounds.width() * bounds.height() * 4;
+            if (!artPixmaps.insert(obj->getImageFileName(), art, cost))
+                art = nullptr;
+        }
+    }
+
+    if (art)
+    {
+        drawPixmap(constellationmidpoint - art->origin, art->pixmap);
+        return true;
+    }
+
     save();
 
     setRenderHint(QPainter::SmoothPixmapTransform);
@@ -771,7 +1092,7 @@ bool SkyQPainter::drawImageOverlay(const QList<ImageOverlay> *imageOverlays, boo
     int numDrawn = 0;
     for (const ImageOverlay &o : *imageOverlays)
     {
-        if (o.m_Status != ImageOverlay::AVAILABLE || o.m_Img.get() == nullptr)
+        if (o.m_Status != ImageOverlay::AVAILABLE || o.m_Pyramid.get() == nullptr)
             continue;
 
         double orientation = o.m_Orientation,  ra = o.m_RA, dec = o.m_DEC, scale = o.m_ArcsecPerPixel;
@@ -811,7 +1132,7 @@ bool SkyQPainter::drawImageOverlay(const QList<ImageOverlay> *imageOverlays, boo
         save();
         translate(pos);
         rotate(finalPA);
-        drawImage(QRectF(-0.5 * w, -0.5 * h, w, h), *(o.m_Img.get()));
+        o.m_Pyramid->draw(*this, w, h);
         numDrawn++;
         restore();
     }
@@ -872,6 +1193,100 @@ bool SkyQPainter::drawCatalogObject(const CatalogObject &obj)
     return true;
 }
 
+void SkyQPainter::prepareCatalogObjects(CatalogDrawList *list) const
+{
+    const int count = list->objects.size();
+    QVarLengthArray<const SkyPoint *, 256> points(count);
+    for (int i = 0; i < count; i++)
+        points[i] = list->objects.at(i);
+
+    list->screen.resize(count);
+    list->visible.resize(count);
+    list->positionAngles.resize(count);
+    m_proj->toScreen(points.constData(), count, list->screen.data(), list->visible.data());
+
+    for (int i = 0; i < count; i++)
+    {
+        const QPointF &pos = list->screen.at(i);
+        list->visible[i] = list->visible.at(i) && m_proj->onScreen(pos);
+        if (list->visible.at(i))
+        {
+            const CatalogObject *obj = list->objects.at(i);
+            list->positionAngles[i] = m_proj->findNorthPA(obj, pos.x(), pos.y()) - obj->pa() + 90;
+        }
+    }
+}
+
+int SkyQPainter::drawCatalogObjects(CatalogDrawList *list)
+{
+    if (list->screen.size() != list->objects.size())
+        prepareCatalogObjects(list);
+
+    const float zoom = Options::zoomFactor();
+    const bool images = Options::showInlineImages() && zoom > 5. * MINZOOM && !Options::showHIPS();
+
+    // The symbols of the same type and colour are drawn as one path
+    QHash<QPair<QRgb, int>, QPainterPath> batches;
+    int drawn = 0;
+    for (int i = 0; i < list->objects.size(); i++)
+    {
+        if (!list->visible.at(i))
+            continue;
+
+        const CatalogObject &obj = *list->objects.at(i);
+        const QPointF &pos = list->screen.at(i);
+        const float positionAngle = list->positionAngles.at(i);
+
+        // Same as drawCatalogObject(), without its per object checks
+        const float majorAxis = obj.a() == 0.0 ? 1.0 : obj.a();
+        const float size = majorAxis * dms::PI * zoom / 10800.0;
+
+        if (images)
+            drawCatalogObjectImage(pos, obj, positionAngle);
+
+        const QPainterPath *symbol = deepSkySymbol(obj.type(), size, obj.e(), zoom);
+        if (symbol == nullptr)
+        {
+            setPen(list->colors.at(i));
+            drawDeepSkySymbol(pos, obj.type(), size, obj.e(), positionAngle);
+        }
+        else
+        {
+            QTransform transform = QTransform::fromTranslate(pos.x(), pos.y());
+            if (symbolRotates(obj.type()))
+                transform.rotate(positionAngle);
+            batches[qMakePair(list->colors.at(i).rgba(), obj.type())].addPath(transform.map(*symbol));
+        }
+        drawn++;
+    }
+
+    const QBrush brush = this->brush();
+    for (auto batch = batches.cbegin(); batch != batches.cend(); ++batch)
+    {
+        const QColor color = QColor::fromRgba(batch.key().first);
+        const int type = batch.key().second;
+        QPen pen(color);
+        if (type == SkyObject::GALAXY_CLUSTER)
+            pen.setStyle(Qt::DashLine);
+        setPen(pen);
+        switch (symbolFill(type))
+        {
+            case CurrentBrush:
+                setBrush(brush);
+                break;
+            case PenBrush:
+                setBrush(color);
+                break;
+            case NoFill:
+                setBrush(Qt::NoBrush);
+                break;
+        }
+        drawPath(batch.value());
+    }
+    setBrush(brush);
+    return drawn;
+}
+
 void SkyQPainter::drawDeepSkySymbol(const QPointF &pos, int type, float size, float e,
                                     float positionAngle)
 {
@@ -88,7 +88,11 @@ class SkyQPainter : public SkyPainter, public QPainter
                              LineListLabel *label = nullptr) override;
         void drawSkyPolygon(LineList *list, bool forceClip = true) override;
         bool drawPointSource(const SkyPoint *loc, float mag, char sp = 'A') override;
+        void prepareStars(StarDrawList *list) const override;
+        int drawStars(StarDrawList *list) override;
         bool drawCatalogObject(const CatalogObject &obj) override;
+        void prepareCatalogObjects(CatalogDrawList *list) const override;
+        int drawCatalogObjects(CatalogDrawList *list) override;
         void drawCatalogObjectImage(const QPointF &pos, const CatalogObject &obj,
                                     float positionAngle);
         bool drawPlanet(KSPlanetBase *planet) override;
@@ -114,6 +118,13 @@ class SkyQPainter : public SkyPainter, public QPainter
         bool drawImageOverlay(const QList<ImageOverlay> *imageOverlays, bool useCache = false) override;
 
     private:
+        /**
+         * @short Project the points of list into list->screenPoints and list->screenVisible,
+         * unless they are still valid from an earlier draw of the same view
+         * @note visible includes checkVisibility(), refraction is applied
+         */
+        void projectLineList(LineList *list) const;
+
         QPaintDevice *m_pd{ nullptr };
         const Projector *m_proj{ nullptr };
         bool m_vectorStars{ false };
@@ -16,6 +16,10 @@
 #include "kstars.h"
 
 #include <QStatusBar>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <vector>
 
 // This is the factory that builds the one-and-only TerrainRenderer.
 TerrainRenderer * TerrainRenderer::_terrainRenderer = nullptr;
@@ -40,7 +44,7 @@ class TerrainLookup
         {
             delete[] valPtr;
         }
-        inline float get(int w, int h)
+        inline float get(int w, int h) const
         {
             return valPtr[h * valWidth + w];
         }
@@ -88,7 +92,7 @@ class InterpArray
 
         // Get the azimuth and altitude values from the 2D arrays.
         // Inputs are a full-image position
-        inline void get(int x, int y, float *az, float *alt)
+        inline void get(int x, int y, float *az, float *alt) const
         {
             const bool rowSampled = y % sampling == 0;
             const bool colSampled = x % sampling == 0;
@@ -197,6 +201,8 @@ TerrainRenderer::TerrainRenderer()
 {
 }
 
+TerrainRenderer::~TerrainRenderer() = default;
+
 // Put degrees in the range of 0 -> 359.99999999
 double rationalizeAz(double degrees)
 {
@@ -331,7 +337,10 @@ bool TerrainRenderer::sameView(const Projector *proj, bool forceRefresh)
               view.fillGround == savedViewParams.fillGround;
     const double azDiff = fabs(savedAz - az);
     const double altDiff = fabs(savedAlt - alt);
-    if (!forceRefresh && ok && azDiff < .0001 && altDiff < .0001)
+    const bool same = ok && azDiff < .0001 && altDiff < .0001;
+    if (!same)
+        lookupValid = false;
+    if (!forceRefresh && same)
         return true;
 
     // Store the view
@@ -405,11 +414,19 @@ bool TerrainRenderer::render(uint16_t w, uint16_t h, QImage *terrainImage, const
     // Only compute the pixel's az and alt values for every Nth pixel.
     // Get the other pixel az and alt values by interpolation.
     // This saves a lot of time.
+    // These are only recomputed when the view changes.
     const int sampling = Options::terrainDownsampling();
-    InterpArray interp(w, h, sampling);
     QElapsedTimer setupTimer;
     setupTimer.start();
-    setupLookup(w, h, sampling, proj, interp.azimuthLookup(), interp.altitudeLookup());
+    if (!lookup || !lookupValid || lookupSampling != sampling || lookupProjection != proj->type())
+    {
+        lookup.reset(new InterpArray(w, h, sampling));
+        setupLookup(w, h, sampling, proj, lookup->azimuthLookup(), lookup->altitudeLookup());
+        lookupSampling = sampling;
+        lookupProjection = proj->type();
+        lookupValid = true;
+    }
+    const InterpArray &interp = *lookup;
 
     const double setupTime = setupTimer.elapsed() / 1000.0; ///////////////////
 
@@ -420,50 +437,68 @@ bool TerrainRenderer::render(uint16_t w, uint16_t h, QImage *terrainImage, const
     // Assign transparent pixels everywhere by default.
     terrainImage->fill(0);
 
+    const bool transparencySpeedup = Options::terrainTransparencySpeedup();
+    const bool equiRectangular = (proj->type() == Projector::Equirectangular);
+    const EquirectangularProjector *equiProj = equiRectangular ? dynamic_cast<const EquirectangularProjector*>(proj) : nullptr;
+
+    // The image is written directly, in bands of rows rendered in parallel.
+    // The bands are a multiple of increment high, so that the skipped rows are in the same band.
+    uchar *bits = terrainImage->bits();
+    const int bytesPerLine = terrainImage->bytesPerLine();
+    const int bands = std::max(1, QThread::idealThreadCount());
+    const int bandHeight = std::max(increment, ((h + bands - 1) / bands + increment - 1) / increment * increment);
+    std::vector<int> bandStarts;
+    for (int j = 0; j < h; j += bandHeight)
+        bandStarts.push_back(j);
+
     // Go through the image, and for each pixel, using the previously computed az and alt values
     // get the corresponding pixel from the terrain image.
-    bool lastTransparent = false;
-    for (int j = 0; j < h; j += increment)
+    QtConcurrent::blockingMap(bandStarts, [&](int first)
     {
-        bool notLastRow = j != h - 1;
-        for (int i = 0; i < w; i += increment)
+        const int last = std::min<int>(h, first + bandHeight);
+        bool lastTransparent = false;
+        for (int j = first; j < last; j += increment)
         {
-            if (lastTransparent && Options::terrainTransparencySpeedup())
-            {
-                // Speedup--if the last pixel was transparent, then this
-                // one is assumed transparent too (but next is calculated).
-                lastTransparent = false;
-                continue;
-            }
-
-            const QPointF imgPoint(i, j);
-            bool equiRectangular = (proj->type() == Projector::Equirectangular);
-            bool usable = equiRectangular ? !dynamic_cast<const EquirectangularProjector*>(proj)->unusablePoint(imgPoint)
-                          : !proj->unusablePoint(imgPoint);
-            if (usable)
+            bool notLastRow = j != h - 1;
+            QRgb *row = reinterpret_cast<QRgb *>(bits + j * bytesPerLine);
+            QRgb *nextRow = notLastRow ? reinterpret_cast<QRgb *>(bits + (j + 1) * bytesPerLine) : nullptr;
+            for (int i = 0; i < w; i += increment)
             {
-                float az, alt;
-                interp.get(i, j, &az, &alt);
-                const QRgb pixel = getPixel(az, alt);
-                terrainImage->setPixel(i, j, pixel);
-                lastTransparent = (pixel == 0);
+                if (lastTransparent && transparencySpeedup)
+                {
+                    // Speedup--if the last pixel was transparent, then this
+                    // one is assumed transparent too (but next is calculated).
+                    lastTransparent = false;
+                    continue;
+                }
 
-                if (skip)
+                const QPointF imgPoint(i, j);
+                bool usable = equiRectangular ? !equiProj->unusablePoint(imgPoint) : !proj->unusablePoint(imgPoint);
+                if (usable)
                 {
-                    // If we've skipped, fill in the missing pixels.
-                    bool notLastCol = i != w - 1;
-                    if (notLastCol)
-                        terrainImage->setPixel(i + 1, j, pixel);
-                    if (notLastRow)
-                        terrainImage->setPixel(i, j + 1, pixel);
-                    if (notLastRow && notLastCol)
-                        terrainImage->setPixel(i + 1, j + 1, pixel);
+                    float az, alt;
+                    interp.get(i, j, &az, &alt);
+                    const QRgb pixel = getPixel(az, alt);
+                    row[i] = pixel;
+                    lastTransparent = (pixel == 0);
+
+                    if (skip)
+                    {
+                        // If we've skipped, fill in the missing pixels.
+                        bool notLastCol = i != w - 1;
+                        if (notLastCol)
+                            row[i + 1] = pixel;
+                        if (notLastRow)
+                            nextRow[i] = pixel;
+                        if (notLastRow && notLastCol)
+                            nextRow[i + 1] = pixel;
+                    }
                 }
+                // Otherwise terrainImage was already filled with transparent pixels
+                // so i,j will be transparent.
             }
-            // Otherwise terrainImage was already filled with transparent pixels
-            // so i,j will be transparent.
         }
-    }
+    });
 
     savedImage = terrainImage->copy();
 
@@ -495,18 +530,24 @@ void TerrainRenderer::setupLookup(uint16_t w, uint16_t h, int sampling, const Pr
 {
     const auto &lst = KStarsData::Instance()->lst();
     const auto &lat = KStarsData::Instance()->geo()->lat();
-    for (int j = 0, js = 0; j < h; j += sampling, js++)
+    const bool equiRectangular = (proj->type() == Projector::Equirectangular);
+    const EquirectangularProjector *equiProj = equiRectangular ? dynamic_cast<const EquirectangularProjector*>(proj) : nullptr;
+
+    // The rows are independent, compute them in parallel.
+    std::vector<int> rows;
+    for (int j = 0; j < h; j += sampling)
+        rows.push_back(j);
+
+    QtConcurrent::blockingMap(rows, [&](int j)
     {
+        const int js = j / sampling;
         for (int i = 0, is = 0; i < w; i += sampling, is++)
         {
             const QPointF imgPoint(i, j);
-            bool equiRectangular = (proj->type() == Projector::Equirectangular);
-            bool usable = equiRectangular ? !dynamic_cast<const EquirectangularProjector*>(proj)->unusablePoint(imgPoint)
-                          : !proj->unusablePoint(imgPoint);
+            bool usable = equiRectangular ? !equiProj->unusablePoint(imgPoint) : !proj->unusablePoint(imgPoint);
             if (usable)
             {
-                SkyPoint point = equiRectangular ?
-                                 dynamic_cast<const EquirectangularProjector*>(proj)->fromScreen(imgPoint, lst, lat, true)
+                SkyPoint point = equiRectangular ? equiProj->fromScreen(imgPoint, lst, lat, true)
                                  : proj->fromScreen(imgPoint, lst, lat, true);
                 const double az = rationalizeAz(point.az().Degrees());
                 const double alt = rationalizeAlt(point.alt().Degrees());
@@ -514,6 +555,5 @@ void TerrainRenderer::setupLookup(uint16_t w, uint16_t h, int sampling, const Pr
                 altLookup->set(is, js, alt);
             }
         }
-    }
+    });
 }
-
@@ -12,6 +12,7 @@
 #include "projections/projector.h"
 
 class TerrainLookup;
+class InterpArray;
 
 class TerrainRenderer : public QObject
 {
@@ -29,6 +30,7 @@ class TerrainRenderer : public QObject
     private:
         // Constructor is private. Only make it with Instance().
         TerrainRenderer();
+        ~TerrainRenderer();
 
         // Speed-up the image calculations by downsampling azimuth and altitude
         // computations of the pixels in the input view.
@@ -40,6 +42,7 @@ class TerrainRenderer : public QObject
 
         // Checks to see if we can use the old rendering.
         // If not, copies the view for the next call.
+        // Invalidates the lookup below if the view changed.
         bool sameView(const Projector *proj, bool forceRefresh);
 
         // This is the only instance we'll make.
@@ -56,6 +59,14 @@ class TerrainRenderer : public QObject
         double savedAz, savedAlt;
         QImage savedImage;
 
+        // The azimuth and altitude of the (downsampled) pixels of the saved view.
+        // They only depend on the view, so are kept over changes of the terrain
+        // image or of the options.
+        std::unique_ptr<InterpArray> lookup;
+        int lookupSampling = 0;
+        Projector::Projection lookupProjection = Projector::Lambert;
+        bool lookupValid = false;
+
         // Keep the parameters used to display the last image
         // to see if something's changed and we need to redisplay.
         QString sourceFilename;
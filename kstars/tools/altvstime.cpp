@@ -28,11 +28,14 @@
 #include <QFrame>
 #include <QDialog>
 #include <QPainter>
+#include <QtConcurrent>
 #include <QtPrintSupport/QPrinter>
 #include <QtPrintSupport/QPrintDialog>
 
 #include "kstars_debug.h"
 
+#include <vector>
+
 AltVsTimeUI::AltVsTimeUI(QWidget *p) : QFrame(p)
 {
     setupUi(this);
@@ -377,7 +380,7 @@ void AltVsTime::processObject(SkyObject *o, bool forceAdd)
     o->updateCoordsNow(num);
 
     // vector used for computing the points needed for drawing the graph
-    QVector<double> y(100), t(100);
+    QVector<double> y, t(100);
 
     //If this point is not in list already, add it to list
     bool found(false);
@@ -414,9 +417,9 @@ void AltVsTime::processObject(SkyObject *o, bool forceAdd)
         // time range: 24h
 
         int offset = 3;
-        for (double h = -12.0, i = 0; h <= 12.0; h += 0.25, i++)
+        y = altitudeCurves({ o }).first();
+        for (int i = 0; i < y.size(); i++)
         {
-            y[i] = findAltitude(o, h);
             if (y[i] > maxAlt)
                 maxAlt = y[i];
             if (y[i] < minAlt)
@@ -475,6 +478,45 @@ double AltVsTime::findAltitude(SkyPoint *p, double hour)
     return p->alt().Degrees();
 }
 
+QVector<QVector<double>> AltVsTime::altitudeCurves(const QList<SkyObject *> &objects)
+{
+    //getDate converts the user-entered local time to UT
+    const KStarsDateTime date = getDate();
+    std::vector<CachingDms> samples;
+    for (double h = -12.0; h <= 12.0; h += 0.25)
+    {
+        KStarsDateTime ut = date.addSecs((h + 24.0 * DayOffset) * 3600.0);
+        samples.push_back(geo->GSTtoLST(ut.gst()));
+    }
+
+    struct Curve
+    {
+        SkyPoint point;
+        QVector<double> altitudes;
+    };
+    std::vector<Curve> curves;
+    curves.reserve(objects.size());
+    for (SkyObject *o : objects)
+        curves.push_back({ *o, QVector<double>() });
+
+    const CachingDms *lat = geo->lat();
+    QtConcurrent::blockingMap(curves, [&samples, lat](Curve & curve)
+    {
+        curve.altitudes.reserve(int(samples.size()));
+        for (const CachingDms &LST : samples)
+        {
+            curve.point.EquatorialToHorizontal(&LST, lat);
+            curve.altitudes.append(curve.point.alt().Degrees());
+        }
+    });
+
+    QVector<QVector<double>> result;
+    result.reserve(int(curves.size()));
+    for (const Curve &curve : curves)
+        result.append(curve.altitudes);
+    return result;
+}
+
 void AltVsTime::slotHighlight(int row)
 {
     if (row < 0)
@@ -980,8 +1022,8 @@ void AltVsTime::slotUpdateDateLoc()
 {
     KStarsData *data     = KStarsData::Instance();
     KStarsDateTime today = getDate();
-    KSNumbers *num       = new KSNumbers(today.djd());
-    KSNumbers *oldNum    = nullptr;
+    KSNumbers num(today.djd());
+    KSNumbers oldNum(data->ut().djd());
     CachingDms LST       = geo->GSTtoLST(today.gst());
 
     //First determine time of sunset and sunrise
@@ -989,115 +1031,65 @@ void AltVsTime::slotUpdateDateLoc()
     // Determine dawn/dusk time and min/max sun elevation
     setDawnDusk();
 
-    for (int i = 0; i < pList.count(); ++i)
+    // Bring every object to the new date, then compute all the curves in one batch
+    for (SkyObject *o : pList)
     {
-        SkyObject *o = pList.at(i);
-        if (o)
-        {
-            //If the object is in the solar system, recompute its position for the given date
-            if (o->isSolarSystem())
-            {
-                oldNum = new KSNumbers(data->ut().djd());
-                o->updateCoords(num, true, geo->lat(), &LST, true);
-            }
-
-            //precess coords to target epoch
-            o->updateCoordsNow(num);
-
-            //update pList entry
-            pList.replace(i, o);
-
-            // We are creating a new data set (time, altitude) for the new date:
-            QVector<double> time_dataSet, altitude_dataSet;
-            double point_altitudeValue, point_timeValue;
-            // compute the new graph values:
-            // time range: 24h
-            int offset = 3;
-            for (double h = -12.0, i = 0; h <= 12.0; h += 0.25, i++)
-            {
-                point_altitudeValue = findAltitude(o, h);
-                altitude_dataSet.push_back(point_altitudeValue);
-                if (point_altitudeValue > maxAlt)
-                    maxAlt = point_altitudeValue;
-                if (point_altitudeValue < minAlt)
-                    minAlt = point_altitudeValue;
-                point_timeValue = i * 900 + 43200;
-                time_dataSet.push_back(point_timeValue);
-            }
-
-            // Replace graph data set:
-            avtUI->View->graph(i)->setData(time_dataSet, altitude_dataSet);
+        //If the object is in the solar system, recompute its position for the given date
+        if (o->isSolarSystem())
+            o->updateCoords(&num, true, geo->lat(), &LST, true);
 
-            // Go into initial state: without Zoom/Pan
-            avtUI->View->xAxis->setRange(43200, 129600);
-            avtUI->View->xAxis2->setRange(61200, 147600);
-
-            // Center the altitude axis in 0 value:
-            if (abs(minAlt) > maxAlt)
-                maxAlt = abs(minAlt);
-            else
-                minAlt = -maxAlt;
-            avtUI->View->yAxis->setRange(minAlt - offset, maxAlt + offset);
+        //precess coords to target epoch
+        o->updateCoordsNow(&num);
+    }
 
-            // Update background coordinates:
-            background->topLeft->setCoords(avtUI->View->xAxis->range().lower, avtUI->View->yAxis->range().upper);
-            background->bottomRight->setCoords(avtUI->View->xAxis->range().upper, avtUI->View->yAxis->range().lower);
+    const QVector<QVector<double>> curves = altitudeCurves(pList);
 
-            // Redraw the plot:
-            avtUI->View->replot();
+    for (int i = 0; i < pList.count(); ++i)
+    {
+        SkyObject *o = pList.at(i);
 
-            //restore original position
-            if (o->isSolarSystem())
-            {
-                o->updateCoords(oldNum, true, data->geo()->lat(), data->lst());
-                delete oldNum;
-                oldNum = nullptr;
-            }
-            o->EquatorialToHorizontal(data->lst(), data->geo()->lat());
-        }
-        else //assume unfound object is a custom object
+        // We are creating a new data set (time, altitude) for the new date:
+        QVector<double> time_dataSet;
+        const QVector<double> &altitude_dataSet = curves.at(i);
+        for (int k = 0; k < altitude_dataSet.size(); ++k)
         {
-            pList.at(i)->updateCoordsNow(num); //precess to desired epoch
-
-            // We are creating a new data set (time, altitude) for the new date:
-            QVector<double> time_dataSet, altitude_dataSet;
-            double point_altitudeValue, point_timeValue;
-            // compute the new graph values:
-            // time range: 24h
-            int offset = 3;
-            for (double h = -12.0, i = 0; h <= 12.0; h += 0.25, i++)
-            {
-                point_altitudeValue = findAltitude(pList.at(i), h);
-                altitude_dataSet.push_back(point_altitudeValue);
-                if (point_altitudeValue > maxAlt)
-                    maxAlt = point_altitudeValue;
-                if (point_altitudeValue < minAlt)
-                    minAlt = point_altitudeValue;
-                point_timeValue = i * 900 + 43200;
-                time_dataSet.push_back(point_timeValue);
-            }
+            const double point_altitudeValue = altitude_dataSet.at(k);
+            if (point_altitudeValue > maxAlt)
+                maxAlt = point_altitudeValue;
+            if (point_altitudeValue < minAlt)
+                minAlt = point_altitudeValue;
+            time_dataSet.push_back(k * 900 + 43200);
+        }
 
-            // Replace graph data set:
-            avtUI->View->graph(i)->setData(time_dataSet, altitude_dataSet);
+        // Replace graph data set:
+        avtUI->View->graph(i)->setData(time_dataSet, altitude_dataSet);
 
-            // Go into initial state: without Zoom/Pan
-            avtUI->View->xAxis->setRange(43200, 129600);
-            avtUI->View->xAxis2->setRange(61200, 147600);
+        //restore original position
+        if (o->isSolarSystem())
+            o->updateCoords(&oldNum, true, data->geo()->lat(), data->lst());
+        o->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+    }
 
-            // Center the altitude axis in 0 value:
-            if (abs(minAlt) > maxAlt)
-                maxAlt = abs(minAlt);
-            else
-                minAlt = -maxAlt;
-            avtUI->View->yAxis->setRange(minAlt - offset, maxAlt + offset);
+    if (!pList.isEmpty())
+    {
+        // Go into initial state: without Zoom/Pan
+        int offset = 3;
+        avtUI->View->xAxis->setRange(43200, 129600);
+        avtUI->View->xAxis2->setRange(61200, 147600);
 
-            // Update background coordinates:
-            background->topLeft->setCoords(avtUI->View->xAxis->range().lower, avtUI->View->yAxis->range().upper);
-            background->bottomRight->setCoords(avtUI->View->xAxis->range().upper, avtUI->View->yAxis->range().lower);
+        // Center the altitude axis in 0 value:
+        if (abs(minAlt) > maxAlt)
+            maxAlt = abs(minAlt);
+        else
+            minAlt = -maxAlt;
+        avtUI->View->yAxis->setRange(minAlt - offset, maxAlt + offset);
 
-            // Redraw the plot:
-            avtUI->View->replot();
-        }
+        // Update background coordinates:
+        background->topLeft->setCoords(avtUI->View->xAxis->range().lower, avtUI->View->yAxis->range().upper);
+        background->bottomRight->setCoords(avtUI->View->xAxis->range().upper, avtUI->View->yAxis->range().lower);
+
+        // Redraw the plot once for all the curves:
+        avtUI->View->replot();
     }
 
     if (getDate().time().hour() > 12)
@@ -1108,8 +1100,6 @@ void AltVsTime::slotUpdateDateLoc()
     setLSTLimits();
     slotHighlight(avtUI->PlotList->currentRow());
     avtUI->View->update();
-
-    delete num;
 }
 
 void AltVsTime::slotChooseCity()
@@ -1160,22 +1150,38 @@ void AltVsTime::drawGradient()
     QDateTime midnight  = QDateTime(dtt.date(), QTime());
     KStarsDateTime const utt  = geoLoc->LTtoUT(KStarsDateTime(midnight));
 
+    // The almanac of the day the gradient was last drawn for. Searching the rise and set
+    // times of the sun and the moon takes a while, and the tool is opened time and again.
+    static struct
+    {
+        QDate date;
+        double latitude, longitude, timeZone;
+        double sunRise, sunSet, dawn, dusk, sunMinAlt, sunMaxAlt;
+        double moonRise, moonSet, moonIllum;
+    } almanac { QDate(), 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    if (almanac.date != dtt.date() || almanac.latitude != geoLoc->lat()->Degrees() ||
+            almanac.longitude != geoLoc->lng()->Degrees() || almanac.timeZone != geoLoc->TZ0())
+    {
+        KSAlmanac ksal(utt, geoLoc);
+
+        almanac = { dtt.date(), geoLoc->lat()->Degrees(), geoLoc->lng()->Degrees(), geoLoc->TZ0(),
+                    ksal.getSunRise(), ksal.getSunSet(), ksal.getDawnAstronomicalTwilight(),
+                    ksal.getDuskAstronomicalTwilight(), ksal.getSunMinAlt(), ksal.getSunMaxAlt(),
+                    ksal.getMoonRise(), ksal.getMoonSet(), ksal.getMoonIllum()
+                  };
+    }
+
     // Variables needed for Gradient:
-    double SunRise, SunSet, Dawn, Dusk, SunMinAlt, SunMaxAlt;
-    double MoonRise, MoonSet, MoonIllum;
-
-    KSAlmanac ksal(utt, geoLoc);
-
-    // Get the values:
-    SunRise   = ksal.getSunRise();
-    SunSet    = ksal.getSunSet();
-    SunMaxAlt = ksal.getSunMaxAlt();
-    SunMinAlt = ksal.getSunMinAlt();
-    MoonRise  = ksal.getMoonRise();
-    MoonSet   = ksal.getMoonSet();
-    MoonIllum = ksal.getMoonIllum();
-    Dawn      = ksal.getDawnAstronomicalTwilight();
-    Dusk      = ksal.getDuskAstronomicalTwilight();
+    const double SunRise   = almanac.sunRise;
+    const double SunSet    = almanac.sunSet;
+    const double SunMaxAlt = almanac.sunMaxAlt;
+    const double SunMinAlt = almanac.sunMinAlt;
+    const double MoonRise  = almanac.moonRise;
+    const double MoonSet   = almanac.moonSet;
+    const double MoonIllum = almanac.moonIllum;
+    const double Dawn      = almanac.dawn;
+    const double Dusk      = almanac.dusk;
 
     gradient = new QPixmap(avtUI->View->rect().width(), avtUI->View->rect().height());
 
@@ -106,6 +106,17 @@ class AltVsTime : public QDialog
      */
     double findAltitude(SkyPoint *p, double hour);
 
+    /**
+     * @short Compute the altitude curves of several objects for the displayed day.
+     *
+     * The sidereal times of the samples are computed once for all objects, which are then
+     * evaluated in parallel on copies of their coordinates. The curves hold the altitudes in
+     * degrees every 15 minutes of the displayed day, as findAltitude() would give them.
+     * @param objects the objects, whose coordinates must be those of the displayed date
+     * @return the curves, in the order of @p objects
+     */
+    QVector<QVector<double>> altitudeCurves(const QList<SkyObject *> &objects);
+
     /**
      * @short get object name. If star has no name, generate a name based on catalog number.
      * @param o sky object.
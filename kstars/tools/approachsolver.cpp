@@ -40,6 +40,8 @@ QMap<long double, dms> ApproachSolver::findClosestApproach(long double startJD,
     //  qCDebug(KSTARS) << m_object2->name() << ": RA = " << m_object2->ra() -> toHMSString() << "; Dec = " << m_object2->dec() -> toDMSString() << "\n";
     prevSign = 0;
 
+    prepare(startJD, stopJD);
+
     step0 = findInitialStep(startJD, stopJD);
     step = step0;
     //	qCDebug(KSTARS) << "Initial Separation between " << m_object1->name() << " and " << m_object2->name() << " = " << (prevDist.toDMSString());
@@ -82,6 +82,13 @@ protected:
      */
     virtual double getMaxSeparation() { return m_maxSeparation; }
 
+    /**
+     * @brief prepare
+     * @short Called by findClosestApproach() before searching from startJD to stopJD.
+     * Subclasses may get their positions ready for the range here. The default does nothing.
+     */
+    virtual void prepare(long double startJD, long double stopJD) { Q_UNUSED(startJD); Q_UNUSED(stopJD); }
+
     /**
      * @brief findSkyPointDistance
      * @param obj1
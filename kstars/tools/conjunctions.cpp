@@ -27,8 +27,17 @@
 #include <QFileDialog>
 #include <QProgressDialog>
 #include <QStandardItemModel>
+#include <QThread>
 #include <QtConcurrent>
 
+#include <algorithm>
+#include <functional>
+
+// A single pair is searched in pieces of at least this many days
+static const double g_minPiece = 30;
+// Pieces overlap by up to this many days, so that a search is well under way where its part begins
+static const double g_maxOverlap = 30;
+
 ConjunctionsTool::ConjunctionsTool(QWidget *parentSplit) : QFrame(parentSplit)
 {
     setupUi(this);
@@ -72,11 +81,7 @@ ConjunctionsTool::ConjunctionsTool(QWidget *parentSplit) : QFrame(parentSplit)
     // Mode Change
     connect(ModeSelector, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &ConjunctionsTool::setMode);
 
-    //connect(ComputeButton, SIGNAL(clicked()), this, SLOT(slotCompute()));
-    connect(ComputeButton, &QPushButton::clicked, [this]()
-    {
-        QtConcurrent::run(this, &ConjunctionsTool::slotCompute);
-    });
+    connect(ComputeButton, &QPushButton::clicked, this, &ConjunctionsTool::slotCompute);
     connect(FilterTypeComboBox, SIGNAL(currentIndexChanged(int)), SLOT(slotFilterType(int)));
     connect(ClearButton, SIGNAL(clicked()), this, SLOT(slotClear()));
     connect(ExportButton, SIGNAL(clicked()), this, SLOT(slotExport()));
@@ -84,6 +89,11 @@ ConjunctionsTool::ConjunctionsTool(QWidget *parentSplit) : QFrame(parentSplit)
     connect(ClearFilterButton, SIGNAL(clicked()), FilterEdit, SLOT(clear()));
     connect(FilterEdit, SIGNAL(textChanged(QString)), this, SLOT(slotFilterReg(QString)));
 
+    // The searches run on the thread pool and report here as each one is done
+    connect(&m_watcher, &QFutureWatcher<Found>::resultReadyAt, this, &ConjunctionsTool::showFound);
+    connect(&m_watcher, &QFutureWatcher<Found>::progressValueChanged, this, &ConjunctionsTool::showProgress);
+    connect(&m_watcher, &QFutureWatcher<Found>::finished, this, &ConjunctionsTool::computeFinished);
+
     m_Model = new QStandardItemModel(0, 5, this);
 
     setMode(ModeSelector->currentIndex());
@@ -128,6 +138,13 @@ ConjunctionsTool::ConjunctionsTool(QWidget *parentSplit) : QFrame(parentSplit)
     show();
 }
 
+ConjunctionsTool::~ConjunctionsTool()
+{
+    // The searches use the objects and the location held here
+    m_watcher.cancel();
+    m_watcher.waitForFinished();
+}
+
 void ConjunctionsTool::slotGoto()
 {
     int index      = m_SortModel->mapToSource(OutputList->currentIndex()).row(); // Get the number of the line
@@ -241,7 +258,6 @@ void ConjunctionsTool::slotCompute(void)
         opposition = true;
     QStringList objects; // List of sky object used as Object1
     KStarsData *data = KStarsData::Instance();
-    int progress     = 0;
 
     // Check if we have a valid angle in maxSeparationBox
     dms maxSeparation(0.0);
@@ -255,6 +271,12 @@ void ConjunctionsTool::slotCompute(void)
         return;
     }
 
+    if (stopJD <= startJD)
+    {
+        KSNotification::sorry(i18n("The stop date must be later than the start date."));
+        return;
+    }
+
     // Check if Object1 and Object2 are set
     if (FilterTypeComboBox->currentIndex() == 0 && Object1 == nullptr)
     {
@@ -269,11 +291,6 @@ void ConjunctionsTool::slotCompute(void)
         return;
     }
 
-    // Init KSConjunct object
-    KSConjunct ksc;
-    connect(&ksc, SIGNAL(madeProgress(int)), this, SLOT(showProgress(int)));
-    ksc.setGeoLocation(geoPlace);
-
     switch (FilterTypeComboBox->currentIndex())
     {
         case 1: // All object types
@@ -340,60 +357,129 @@ void ConjunctionsTool::slotCompute(void)
         objects.removeAll("Iapetus");
     }
 
-    ksc.setMaxSeparation(maxSeparation);
-    ksc.setObject2(Object2);
-    ksc.setOpposition(opposition);
+    m_searches.clear();
+    KSEphemeris ephemeris2;
 
     if (FilterTypeComboBox->currentIndex() != 0)
     {
-        // Show a progress dialog while processing
-        QProgressDialog progressDlg(i18n("Compute conjunction..."), i18n("Abort"), 0, objects.count(), this);
-        progressDlg.setWindowTitle(i18nc("@title:window", "Conjunction"));
-        progressDlg.setWindowModality(Qt::WindowModal);
-        progressDlg.setValue(0);
+        // Fit the positions of object 2 once for all searches, which then leave it untouched
+        KSConjunct ksc;
+        ksc.setObject2(Object2);
+        ksc.fitObject2(startJD, stopJD);
+        ephemeris2 = ksc.ephemeris2();
 
+        m_searches.reserve(objects.count());
         for (auto &object : objects)
         {
-            // If the user click on the 'cancel' button
-            if (progressDlg.wasCanceled())
-                break;
-
-            // Update progress dialog
-            ++progress;
-            progressDlg.setValue(progress);
-            progressDlg.setLabelText(i18n("Compute conjunction between %1 and %2", Object2->name(), object));
-
-            // Compute conjuction
-            Object1 = std::shared_ptr<SkyObject>(data->skyComposite()->findByName(object)->clone());
-            ksc.setObject1(Object1);
-            showConjunctions(ksc.findClosestApproach(startJD, stopJD),
-                             object, Object2->name());
+            Search search;
+            search.source = data->skyComposite()->findByName(object);
+            if (search.source == nullptr)
+                continue;
+            search.object2 = Object2;
+            search.startJD = startJD;
+            search.stopJD  = stopJD;
+            m_searches.push_back(search);
         }
 
-        progressDlg.setValue(objects.count());
+        // Show a progress dialog while processing
+        m_progressDialog = new QProgressDialog(i18n("Compute conjunction..."), i18n("Abort"), 0, int(m_searches.size()), this);
+        m_progressDialog->setWindowTitle(i18nc("@title:window", "Conjunction"));
+        m_progressDialog->setWindowModality(Qt::WindowModal);
+        m_progressDialog->setValue(0);
+        connect(m_progressDialog, &QProgressDialog::canceled, &m_watcher, &QFutureWatcher<Found>::cancel);
     }
     else
     {
-        // Change cursor while we search for conjunction
-        QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+        // Search pieces of the range at once. Each piece reports the approaches in its own part
+        // only, but starts and stops a little beyond it, as a search cannot tell an approach
+        // right at its start.
+        const double span   = double(stopJD - startJD);
+        const int pieces    = std::max(1, std::min(QThread::idealThreadCount(), int(span / g_minPiece)));
+        const double margin = std::min(span / pieces / 2.0, g_maxOverlap);
+
+        m_searches.resize(pieces);
+        for (int n = 0; n < pieces; ++n)
+        {
+            Search &search = m_searches[n];
+            search.object1.reset(Object1->clone());
+            search.object2.reset(static_cast<KSPlanetBase *>(Object2->clone()));
+            search.startJD = startJD;
+            search.stopJD  = stopJD;
+            if (n > 0)
+            {
+                search.keepFrom = startJD + span * n / pieces;
+                search.startJD  = search.keepFrom - margin;
+            }
+            if (n < pieces - 1)
+            {
+                search.keepUntil = startJD + span * (n + 1) / pieces;
+                search.stopJD    = search.keepUntil + margin;
+            }
+        }
 
+        progress->setRange(0, pieces);
+        progress->setValue(0);
         ComputeStack->setCurrentIndex(1);
+    }
+
+    // Each search runs its own KSConjunct, on copies of the objects it changes
+    GeoLocation *geo = geoPlace;
+    std::function<Found(const Search *)> run = [geo, maxSeparation, opposition, ephemeris2](const Search *search)
+    {
+        KSConjunct ksc;
+        ksc.setGeoLocation(geo);
+        ksc.setMaxSeparation(maxSeparation);
+        ksc.setOpposition(opposition);
+
+        SkyObject_s object1    = search->object1 ? search->object1 : SkyObject_s(search->source->clone());
+        KSPlanetBase_s object2 = search->object2;
+        ksc.setObject1(object1);
+        ksc.setObject2(object2);
+        ksc.setEphemeris2(ephemeris2);
+
+        Found found { object1->name(), object2->name(), {} };
+        const auto conjunctions = ksc.findClosestApproach(search->startJD, search->stopJD);
+        for (auto it = conjunctions.constBegin(); it != conjunctions.constEnd(); ++it)
+        {
+            if (it.key() >= search->keepFrom && it.key() < search->keepUntil)
+                found.conjunctions.insert(it.key(), it.value());
+        }
+        return found;
+    };
 
-        ksc.setObject1(Object1);
-        showConjunctions(ksc.findClosestApproach(startJD, stopJD),
-                         Object1->name(), Object2->name());
-        ComputeStack->setCurrentIndex(0);
+    QVector<const Search *> searches;
+    searches.reserve(int(m_searches.size()));
+    for (const Search &search : m_searches)
+        searches.append(&search);
 
-        // Restore cursor
-        QApplication::restoreOverrideCursor();
-    }
+    ComputeButton->setEnabled(false);
+    m_watcher.setFuture(QtConcurrent::mapped(searches, run));
+}
 
+void ConjunctionsTool::showFound(int index)
+{
+    const Found found = m_watcher.resultAt(index);
+    showConjunctions(found.conjunctions, found.object1, found.object2);
+}
+
+void ConjunctionsTool::computeFinished()
+{
+    delete m_progressDialog;
+    m_progressDialog = nullptr;
+
+    ComputeStack->setCurrentIndex(0);
+    ComputeButton->setEnabled(true);
+
+    m_searches.clear();
     Object2.reset();
 }
 
 void ConjunctionsTool::showProgress(int n)
 {
-    progress->setValue(n);
+    if (m_progressDialog)
+        m_progressDialog->setValue(n);
+    else
+        progress->setValue(n);
 }
 
 void ConjunctionsTool::showConjunctions(const QMap<long double, dms> &conjunctionlist, const QString &object1,
@@ -15,11 +15,15 @@
 #include "ui_conjunctions.h"
 
 #include <QFrame>
+#include <QFutureWatcher>
 #include <QMap>
 #include <QString>
 #include "skycomponents/typedef.h"
+#include <limits>
 #include <memory>
+#include <vector>
 
+class QProgressDialog;
 class QSortFilterProxyModel;
 class QStandardItemModel;
 
@@ -38,7 +42,7 @@ class ConjunctionsTool : public QFrame, public Ui::ConjunctionsDlg
 
   public:
     explicit ConjunctionsTool(QWidget *p);
-    virtual ~ConjunctionsTool() override = default;
+    virtual ~ConjunctionsTool() override;
 
   public slots:
 
@@ -54,6 +58,34 @@ class ConjunctionsTool : public QFrame, public Ui::ConjunctionsDlg
     void slotFilterReg(const QString &);
 
   private:
+    /// One search for approaches of two objects, run on a thread of the pool
+    struct Search
+    {
+        /// Object 1, or the object it is copied from by the search
+        SkyObject_s object1;
+        const SkyObject *source { nullptr };
+        KSPlanetBase_s object2;
+        /// The range searched and the part of it approaches are reported from
+        long double startJD { 0 };
+        long double stopJD { 0 };
+        long double keepFrom { std::numeric_limits<long double>::lowest() };
+        long double keepUntil { std::numeric_limits<long double>::max() };
+    };
+
+    /// The approaches found by a Search
+    struct Found
+    {
+        QString object1;
+        QString object2;
+        QMap<long double, dms> conjunctions;
+    };
+
+    /** @short Show the approaches found by search @p index as they come in */
+    void showFound(int index);
+
+    /** @short Clean up once all searches are done or cancelled */
+    void computeFinished();
+
     void showConjunctions(const QMap<long double, dms> &conjunctionlist, const QString &object1,
                           const QString &object2);
 
@@ -83,4 +115,9 @@ class ConjunctionsTool : public QFrame, public Ui::ConjunctionsDlg
     QStandardItemModel *m_Model { nullptr };
     QSortFilterProxyModel *m_SortModel { nullptr };
     int m_index { 0 };
+
+    /// The searches running, owned here so that their copies are made and destroyed on this thread
+    std::vector<Search> m_searches;
+    QFutureWatcher<Found> m_watcher;
+    QProgressDialog *m_progressDialog { nullptr };
 };
@@ -12,6 +12,12 @@
 #include "skyobjects/ksplanetbase.h"
 
 #include <cmath>
+#include <memory>
+
+// findPrecise() looks a few days back and the last steps may overshoot a little, so fits
+// reach this many days beyond the range searched
+static const double g_fitBefore = 6;
+static const double g_fitAfter  = 1;
 
 KSConjunct::KSConjunct() : ApproachSolver ()
 {
@@ -20,7 +26,7 @@ KSConjunct::KSConjunct() : ApproachSolver ()
 
 dms KSConjunct::findDistance()
 {
-    dms dist = findSkyPointDistance(m_object1.get(), m_object2.get());
+    dms dist = findSkyPointDistance(m_object1.get(), m_point2);
     if (m_opposition)
     {
         dist.setD(180 - dist.Degrees());
@@ -32,18 +38,65 @@ dms KSConjunct::findDistance()
 void KSConjunct::updatePositions(long double jd)
 {
     KStarsDateTime t(jd);
-    KSNumbers num(jd);
-
-    m_Earth.findPosition(&num);
     CachingDms LST(getGeoLocation()->GSTtoLST(t.gst()));
+    const CachingDms *lat = getGeoLocation()->lat();
 
-    KSPlanetBase *p = dynamic_cast<KSPlanetBase*>(m_object1.get());
-    if (p)
-        p->findPosition(&num, getGeoLocation()->lat(), &LST, &m_Earth);
+    KSPlanetBase *p     = dynamic_cast<KSPlanetBase*>(m_object1.get());
+    const bool fitted1 = p && m_ephemeris1.contains(jd);
+    const bool fitted2 = m_ephemeris2.contains(jd);
+
+    // The time-dependent values and the Earth are only needed for what is not fitted
+    std::unique_ptr<KSNumbers> num;
+    if (!fitted1 || !fitted2)
+    {
+        num.reset(new KSNumbers(jd));
+        if ((p && !fitted1) || !fitted2)
+            m_Earth.findPosition(num.get());
+    }
+
+    if (fitted1)
+        m_ephemeris1.position(jd, p, lat, &LST);
+    else if (p)
+        p->findPosition(num.get(), lat, &LST, &m_Earth);
+    else
+        m_object1->updateCoordsNow(num.get());
+
+    if (fitted2)
+    {
+        m_ephemeris2.position(jd, &m_position2, lat, &LST);
+        m_point2 = &m_position2;
+    }
     else
-        m_object1->updateCoordsNow(&num);
+    {
+        m_object2->findPosition(num.get(), lat, &LST, &m_Earth);
+        m_point2 = m_object2.get();
+    }
+}
+
+void KSConjunct::prepare(long double startJD, long double stopJD)
+{
+    const long double from  = startJD - g_fitBefore;
+    const long double until = stopJD + g_fitAfter;
+
+    // A fit takes KSEphemeris::nodes positions a segment. That only pays off if the search
+    // steps more densely, as for the Moon, or if the fit serves many searches.
+    const double step = findInitialStep(startJD, stopJD);
+
+    KSPlanetBase *p = dynamic_cast<KSPlanetBase*>(m_object1.get());
+    if (p && !m_ephemeris1.covers(from, until) && step * KSEphemeris::nodes < KSEphemeris::segmentLength(*p))
+        m_ephemeris1.fit(*p, from, until);
+
+    if (!m_ephemeris2.covers(from, until) && step * KSEphemeris::nodes < KSEphemeris::segmentLength(*m_object2))
+        m_ephemeris2.fit(*m_object2, from, until);
+}
+
+void KSConjunct::fitObject2(long double startJD, long double stopJD)
+{
+    const long double from  = startJD - g_fitBefore;
+    const long double until = stopJD + g_fitAfter;
 
-    m_object2->findPosition(&num, getGeoLocation()->lat(), &LST, &m_Earth);
+    if (!m_ephemeris2.covers(from, until))
+        m_ephemeris2.fit(*m_object2, from, until);
 }
 
 double KSConjunct::findInitialStep(long double startJD, long double stopJD)
@@ -6,6 +6,7 @@
 
 #pragma once
 #include "approachsolver.h"
+#include "skyobjects/ksephemeris.h"
 
 class GeoLocation;
 class KSPlanetBase;
@@ -28,16 +29,31 @@ public:
     /** Constructor. Instantiates a KSNumbers for internal computations. */
     KSConjunct();
 
-    void setObject1(SkyObject_s &obj) { m_object1 = obj; }
-    void setObject2(KSPlanetBase_s &obj) { m_object2 = obj; }
+    void setObject1(SkyObject_s &obj) { m_object1 = obj; m_ephemeris1.clear(); }
+    void setObject2(KSPlanetBase_s &obj) { m_object2 = obj; m_ephemeris2.clear(); }
     void setOpposition(bool opposition) { m_opposition = opposition; }
 
+    /**
+     * @short Fit the positions of object 2 for searches from @p startJD to @p stopJD
+     * This pays off when many searches are run against the same object 2, see KSEphemeris.
+     */
+    void fitObject2(long double startJD, long double stopJD);
+
+    /**
+     * @short Use the positions of object 2 fitted by another KSConjunct
+     * Object 2 itself is then left untouched by the searches, so that several of them may
+     * share it from different threads.
+     */
+    void setEphemeris2(const KSEphemeris &ephemeris) { m_ephemeris2 = ephemeris; }
+    const KSEphemeris &ephemeris2() const { return m_ephemeris2; }
+
 signals:
     void madeProgress(int);
 
 protected:
     double findInitialStep(long double startJD, long double stopJD) override;
     void updatePositions(long double jd) override;
+    void prepare(long double startJD, long double stopJD) override;
 
 private:
     dms findDistance() override;
@@ -46,5 +62,12 @@ private:
     SkyObject_s m_object1;
     KSPlanetBase_s m_object2;
     bool m_opposition { false };
+
+    /// Fitted positions, used where they cover the time of a step
+    KSEphemeris m_ephemeris1;
+    KSEphemeris m_ephemeris2;
+    /// Where the fitted positions of object 2 go
+    SkyPoint m_position2;
+    SkyPoint *m_point2 { nullptr };
 };
 
@@ -7,6 +7,7 @@
 /* Project Includes */
 #include "nameresolver.h"
 #include "catalogobject.h"
+#include "auxiliary/ksnetworkcache.h"
 
 /* KDE Includes */
 #ifndef KSTARS_LITE
@@ -24,6 +25,8 @@
 #include <QNetworkReply>
 #include <QNetworkAccessManager>
 #include <QEventLoop>
+#include <QCoreApplication>
+#include <QTimer>
 
 #include <kstars_debug.h>
 
@@ -44,11 +47,77 @@ std::pair<bool, CatalogObject> NameResolver::resolveName(const QString &name)
     return found_sesame;
 }
 
+namespace
+{
+// Days a resolved name is kept before Sesame is asked again
+constexpr int SESAME_CACHE_DAYS = 90;
+
+QNetworkAccessManager *asyncManager()
+{
+    // Shared by all asynchronous lookups, so that they queue on its connections to Sesame
+    static QNetworkAccessManager *manager = new QNetworkAccessManager(QCoreApplication::instance());
+    return manager;
+}
+}
+
+void NameResolver::resolveNameAsync(const QString &name, QObject *context,
+                                    const std::function<void(const std::pair<bool, CatalogObject> &)> &resolved)
+{
+    const QUrl url = NameResolverInternals::sesameUrl(name);
+    const QByteArray cached = KSNetworkCache::find(url.toString(), SESAME_CACHE_DAYS);
+    if (!cached.isEmpty())
+    {
+        const auto result = NameResolverInternals::parseSesame(name, cached);
+        // Answer later all the same, callers count on it
+        QTimer::singleShot(0, context, [resolved, result]()
+        {
+            resolved(result);
+        });
+        return;
+    }
+
+    qCDebug(KSTARS) << "Resolving" << name << "asynchronously using CDS Sesame.";
+    QNetworkReply *response = asyncManager()->get(QNetworkRequest(url));
+    QObject::connect(response, &QNetworkReply::finished, context, [name, url, response, resolved]()
+    {
+        response->deleteLater();
+        if (response->error() != QNetworkReply::NoError)
+        {
+            const QString msg = xi18n("Error trying to get XML response from CDS Sesame server: %1",
+                                      response->errorString());
+            qWarning() << msg;
+
+#ifdef KSTARS_LITE
+            KStarsLite::Instance()->notificationMessage(msg);
+#endif
+            resolved({ false, {} });
+            return;
+        }
+
+        const QByteArray xml = response->readAll();
+        const auto result = NameResolverInternals::parseSesame(name, xml);
+        if (result.first)
+            KSNetworkCache::insert(url.toString(), xml);
+        resolved(result);
+    });
+}
+
+QUrl NameResolver::NameResolverInternals::sesameUrl(const QString &name)
+{
+    return QUrl(QString("http://cdsweb.u-strasbg.fr/cgi-bin/nph-sesame/-oxpFI/SNV?%1").arg(name));
+}
+
 std::pair<bool, CatalogObject>
 NameResolver::NameResolverInternals::sesameResolver(const QString &name)
 {
-    QUrl resolverUrl = QUrl(
-        QString("http://cdsweb.u-strasbg.fr/cgi-bin/nph-sesame/-oxpFI/SNV?%1").arg(name));
+    const QUrl resolverUrl = sesameUrl(name);
+
+    const QByteArray cached = KSNetworkCache::find(resolverUrl.toString(), SESAME_CACHE_DAYS);
+    if (!cached.isEmpty())
+    {
+        qCDebug(KSTARS) << "Resolving" << name << "from the cached answer of CDS Sesame.";
+        return parseSesame(name, cached);
+    }
 
     QString msg = xi18n("Attempting to resolve object %1 using CDS Sesame.", name);
     qCDebug(KSTARS) << msg;
@@ -78,8 +147,20 @@ NameResolver::NameResolverInternals::sesameResolver(const QString &name)
         return { false, {} };
     }
 
-    QXmlStreamReader xml(response->readAll());
+    const QByteArray xml = response->readAll();
     response->deleteLater();
+
+    const auto result = parseSesame(name, xml);
+    if (result.first)
+        KSNetworkCache::insert(resolverUrl.toString(), xml);
+    return result;
+}
+
+std::pair<bool, CatalogObject>
+NameResolver::NameResolverInternals::parseSesame(const QString &name, const QByteArray &response)
+{
+    QString msg;
+    QXmlStreamReader xml(response);
     if (xml.atEnd())
     {
         // file is empty
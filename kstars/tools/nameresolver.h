@@ -9,7 +9,13 @@
 
 #include "skyobject.h"
 
+#include <QUrl>
+
+#include <functional>
+
 // Forward declarations
+class QByteArray;
+class QObject;
 class QString;
 class CatalogObject;
 
@@ -24,6 +30,9 @@ class CatalogObject;
  * coordinates, fluxes, alternate designations, and possibly other
  * data.
  *
+ * The answers of Sesame are kept in the network cache for some
+ * months, so a name is only sent over the network once.
+ *
  * @author Akarsh Simha <akarsh.simha@kdemail.net>
  */
 
@@ -35,6 +44,19 @@ namespace NameResolver
  */
 std::pair<bool, CatalogObject> resolveName(const QString &name);
 
+/**
+ * @short Resolve the name of the given DSO without waiting for the
+ * network
+ *
+ * Any number of names may be resolved at once, the requests are
+ * queued on a network access manager shared by all of them.
+ *
+ * @param resolved called on the event loop once @p name is resolved
+ * or failed to be, unless @p context was deleted in the meantime
+ */
+void resolveNameAsync(const QString &name, QObject *context,
+                      const std::function<void(const std::pair<bool, CatalogObject> &)> &resolved);
+
 namespace NameResolverInternals
 {
 /**
@@ -46,6 +68,18 @@ namespace NameResolverInternals
  */
 std::pair<bool, CatalogObject> sesameResolver(const QString &name);
 
+/** @return the URL to query CDS Sesame for @p name */
+QUrl sesameUrl(const QString &name);
+
+/**
+ * @short Extract the object from the XML response of CDS Sesame
+ *
+ * @param name the name (identifier) that was resolved
+ * @param response the XML returned by Sesame
+ * @return Success value and the object
+ */
+std::pair<bool, CatalogObject> parseSesame(const QString &name, const QByteArray &response);
+
 /*
  * @short Retrieve additional data from SIMBAD
  *
@@ -36,6 +36,7 @@
 #include "skyobjects/starobject.h"
 #include "tools/altvstime.h"
 #include "tools/eyepiecefield.h"
+#include "tools/nameresolver.h"
 #include "tools/wutdialog.h"
 
 #ifdef HAVE_INDI
@@ -235,6 +236,8 @@ void ObservingList::showEvent(QShowEvent *)
         connect(m_altitudeUpdater, SIGNAL(timeout()), this, SLOT(slotUpdateAltitudes()));
         m_altitudeUpdater->start(120000); // update altitudes every 2 minutes
     }
+    else if (m_altitudesStale)
+        slotUpdateAltitudes();
 }
 
 //SLOTS
@@ -350,9 +353,11 @@ void ObservingList::slotAddObject(const SkyObject *_obj, bool session, bool upda
 
         //Note addition in statusbar
         KStars::Instance()->statusBar()->showMessage(i18n("Added %1 to observing list.", finalObjectName), 0);
-        ui->WishListView->resizeColumnsToContents();
         if (!update)
+        {
+            ui->WishListView->resizeColumnsToContents();
             slotSaveList();
+        }
     }
     //Insert object in the Session List
     if (session)
@@ -385,7 +390,8 @@ void ObservingList::slotAddObject(const SkyObject *_obj, bool session, bool upda
         m_SessionModel->appendRow(itemList);
         //Adding an object should trigger the modified flag
         isModified = true;
-        ui->SessionView->resizeColumnsToContents();
+        if (!update)
+            ui->SessionView->resizeColumnsToContents();
         //Note addition in statusbar
         KStars::Instance()->statusBar()->showMessage(i18n("Added %1 to session list.", finalObjectName), 0);
         SkyMap::Instance()->forceUpdate();
@@ -778,45 +784,76 @@ void ObservingList::slotBatchAdd()
                     &accepted);
     bool resolve = Options::resolveNamesOnline();
 
-    if (accepted && !items.isEmpty())
+    if (!accepted || items.isEmpty())
+        return;
+
+    // The names KStars does not know are all sent to the resolver at once
+    struct Batch
+    {
+        QStringList names;
+        QVector<SkyObject *> objects;
+        int pending { 0 };
+    };
+    auto batch = QSharedPointer<Batch>::create();
+    const bool session = sessionView;
+
+    for (QString objectName : items.split("\n"))
     {
-        QStringList failedObjects;
-        QStringList objectNames = items.split("\n");
-        for (QString objectName : objectNames)
+        objectName = FindDialog::processSearchText(objectName);
+        batch->names.append(objectName);
+        batch->objects.append(KStarsData::Instance()->objectNamed(objectName));
+    }
+
+    for (int i = 0; i < batch->names.size(); i++)
+    {
+        if (batch->objects[i] || !resolve)
+            continue;
+
+        batch->pending++;
+        NameResolver::resolveNameAsync(batch->names[i], this,
+                                       [this, batch, i, session](const std::pair<bool, CatalogObject> &cedata)
         {
-            objectName = FindDialog::processSearchText(objectName);
-            SkyObject *object = KStarsData::Instance()->objectNamed(objectName);
-            if (!object && resolve)
-            {
-                object = FindDialog::resolveAndAdd(m_manager, objectName);
-            }
-            if (!object)
-            {
-                failedObjects.append(objectName);
-            }
-            else
-            {
-                slotAddObject(object, sessionView);
-            }
-        }
+            if (cedata.first)
+                batch->objects[i] = FindDialog::addResolved(m_manager, cedata.second);
+            if (--batch->pending == 0)
+                finishBatchAdd(batch->names, batch->objects, session);
+        });
+    }
 
-        if (!failedObjects.isEmpty())
+    if (batch->pending == 0)
+        finishBatchAdd(batch->names, batch->objects, session);
+}
+
+void ObservingList::finishBatchAdd(const QStringList &names, const QVector<SkyObject *> &objects, bool session)
+{
+    QStringList failedObjects;
+    for (int i = 0; i < names.size(); i++)
+    {
+        if (!objects[i])
         {
-            QMessageBox msgBox =
-            {
-                QMessageBox::Icon::Warning,
-                i18np("Batch add: %1 object not found", "Batch add: %1 objects not found", failedObjects.size()),
-                i18np("%1 object could not be found in the database or resolved, and hence could not be added. See the details for more.",
-                      "%1 objects could not be found in the database or resolved, and hence could not be added. See the details for more.",
-                      failedObjects.size()),
-                QMessageBox::Ok,
-                this
-            };
-            msgBox.setDetailedText(failedObjects.join("\n"));
-            msgBox.exec();
+            failedObjects.append(names[i]);
+        }
+        else
+        {
+            slotAddObject(objects[i], session);
         }
     }
-    Q_ASSERT(false); // Not implemented
+
+    if (!failedObjects.isEmpty())
+    {
+        QMessageBox msgBox =
+        {
+            QMessageBox::Icon::Warning,
+            i18np("Batch add: %1 object not found", "Batch add: %1 objects not found", failedObjects.size()),
+            i18np("%1 object could not be found in the database or resolved, and hence could not be added. See the details for more.",
+                  "%1 objects could not be found in the database or resolved, and hence could not be added. See the details for more.",
+                  failedObjects.size()),
+            QMessageBox::Ok,
+            this
+        };
+        msgBox.setDetailedText(failedObjects.join("\n"));
+        msgBox.exec();
+    }
 }
 
 void ObservingList::slotEyepieceView()
@@ -919,13 +956,9 @@ void ObservingList::slotOpenList()
         m_CurrentObject = nullptr;
         m_SessionModel->removeRows(0, m_SessionModel->rowCount());
         SkyMap::Instance()->forceUpdate();
-        //First line is the name of the list. The rest of the file is
-        //object names, one per line. With the TimeHash value if present
-        QTextStream istream(&f);
-        QString input;
-        input = istream.readAll();
+        // The OAL log is parsed as it is read from the file
         OAL::Log logObject;
-        logObject.readBegin(input);
+        logObject.readBegin(&f);
         //Set the New TimeHash
         TimeHash = logObject.timeHash();
         GeoLocation *geo_new = logObject.geoLocation();
@@ -1142,6 +1175,7 @@ void ObservingList::slotLoadWishList()
     }
     delete (addingObjectsProgress);
     f.close();
+    ui->WishListView->resizeColumnsToContents();
 
     if (!failedObjects.isEmpty())
     {
@@ -1181,9 +1215,12 @@ void ObservingList::slotSaveSession(bool nativeSave)
         }
         return;
     }
-    QTextStream ostream(&f);
     OAL::Log log;
-    ostream << log.writeLog(nativeSave);
+    if (!log.writeLog(&f, nativeSave))
+    {
+        KSNotification::error(i18n("Could not save the session to %1.", f.fileName()));
+        return;
+    }
     f.close();
     isModified = false; //We've saved the session, so reset the modified flag.
 }
@@ -1298,26 +1335,71 @@ void ObservingList::slotUpdate()
 {
     dt.setDate(ui->DateEdit->date());
     ui->avt->removeAllPlotObjects();
-    //Creating a copy of the lists, we can't use the original lists as they'll keep getting modified as the loop iterates
-    QList<QSharedPointer<SkyObject>> _obsList = m_WishList, _SessionList = m_SessionList;
+    updateTimeDependentColumns(false);
+    updateTimeDependentColumns(true);
+    SkyMap::Instance()->forceUpdate();
+}
 
-    for (QSharedPointer<SkyObject> &o : _obsList)
+void ObservingList::updateTimeDependentColumns(bool session)
+{
+    QStandardItemModel *model         = (session ? m_SessionModel.get() : m_WishListModel.get());
+    QSortFilterProxyModel *sortModel = (session ? m_SessionSortModel.get() : m_WishListSortModel.get());
+    KStarsDateTime now                = KStarsDateTime::currentDateTimeUtc();
+    QList<SkyObject *> moving;
+
+    sortModel->setDynamicSortFilter(false);
+    for (int irow = 0; irow < model->rowCount(); ++irow)
     {
-        if (o->name() != "star")
+        SkyObject *o = static_cast<SkyObject *>(model->item(irow, 0)->data(Qt::UserRole + 1).value<void *>());
+        Q_ASSERT(o);
+
+        if (!session)
         {
-            slotRemoveObject(o.data(), false, true);
-            slotAddObject(o.data(), false, true);
+            SkyPoint p                 = o->recomputeHorizontalCoords(now, geo);
+            QStandardItem *replacement = m_altCostHelper(p);
+            QStandardItem *altItem     = model->item(irow, model->columnCount() - 1);
+            altItem->setData(replacement->data(Qt::DisplayRole), Qt::DisplayRole);
+            altItem->setData(replacement->data(Qt::UserRole), Qt::UserRole);
+            delete replacement;
+            continue;
         }
-    }
-    for (QSharedPointer<SkyObject> &obj : _SessionList)
-    {
-        if (obj->name() != "star")
+
+        if (o->name() == "star")
+            continue;
+
+        if (o->type() == SkyObject::COMET || o->type() == SkyObject::ASTEROID || o->type() == SkyObject::MOON ||
+                o->type() == SkyObject::PLANET)
+        {
+            moving.append(o);
+            continue;
+        }
+
+        // Same as in slotAddObject()
+        const QString name = getObjectName(o);
+        SkyPoint p         = o->recomputeHorizontalCoords(dt, geo);
+        dt.setTime(TimeHash.value(name, o->transitTime(dt, geo)));
+        dms lst(geo->GSTtoLST(dt.gst()));
+        p.EquatorialToHorizontal(&lst, geo->lat());
+
+        model->item(irow, 7)->setData(TimeHash.value(name, o->transitTime(dt, geo)), Qt::DisplayRole);
+        for (int column : { 8, 9 })
         {
-            slotRemoveObject(obj.data(), true, true);
-            slotAddObject(obj.data(), true, true);
+            const QString text = (column == 8 ? p.alt() : p.az()).toDMSString();
+            model->item(irow, column)->setData(text, Qt::DisplayRole);
+            model->item(irow, column)->setData(text, Qt::UserRole);
         }
     }
-    SkyMap::Instance()->forceUpdate();
+
+    for (SkyObject *o : moving)
+    {
+        // Keep the object alive while it is out of the list
+        QSharedPointer<SkyObject> obj = findObject(o, true);
+        slotRemoveObject(obj.data(), true, true);
+        slotAddObject(obj.data(), true, true);
+    }
+    sortModel->setDynamicSortFilter(true);
+
+    (session ? ui->SessionView : ui->WishListView)->resizeColumnsToContents();
 }
 
 void ObservingList::slotSetTime()
@@ -1326,6 +1408,7 @@ void ObservingList::slotSetTime()
     slotRemoveObject(o, true);
     TimeHash[o->name()] = ui->TimeEdit->time();
     slotAddObject(o, true, true);
+    ui->SessionView->resizeColumnsToContents();
 }
 
 void ObservingList::slotCustomDSS()
@@ -1747,25 +1830,12 @@ QString ObservingList::getObjectName(const SkyObject *o, bool translated)
 
 void ObservingList::slotUpdateAltitudes()
 {
-    // FIXME: Update upon gaining visibility, do not update when not visible
-    KStarsDateTime now = KStarsDateTime::currentDateTimeUtc();
-    //    qCDebug(KSTARS) << "Updating altitudes in observation planner @ JD - J2000 = " << double( now.djd() - J2000 );
-    for (int irow = m_WishListModel->rowCount() - 1; irow >= 0; --irow)
-    {
-        QModelIndex idx = m_WishListSortModel->mapToSource(m_WishListSortModel->index(irow, 0));
-        SkyObject *o    = static_cast<SkyObject *>(idx.data(Qt::UserRole + 1).value<void *>());
-        Q_ASSERT(o);
-        SkyPoint p = o->recomputeHorizontalCoords(now, geo);
-        idx =
-            m_WishListSortModel->mapToSource(m_WishListSortModel->index(irow, m_WishListSortModel->columnCount() - 1));
-        QStandardItem *replacement = m_altCostHelper(p);
-        m_WishListModel->setData(idx, replacement->data(Qt::DisplayRole), Qt::DisplayRole);
-        m_WishListModel->setData(idx, replacement->data(Qt::UserRole), Qt::UserRole);
-        delete replacement;
-    }
-    emit m_WishListModel->dataChanged(
-        m_WishListModel->index(0, m_WishListModel->columnCount() - 1),
-        m_WishListModel->index(m_WishListModel->rowCount() - 1, m_WishListModel->columnCount() - 1));
+    // Nobody looks at the altitudes of a hidden planner, catch up when it is shown again
+    m_altitudesStale = !isVisible();
+    if (m_altitudesStale)
+        return;
+
+    updateTimeDependentColumns(false);
 }
 
 QSharedPointer<SkyObject> ObservingList::findObject(const SkyObject *o, bool session)
@@ -354,6 +354,14 @@ class ObservingList : public QDialog
     void showEvent(QShowEvent *) override;
 
   private:
+    /**
+         * @short Add the objects of a batch once all of its names are resolved
+         * @param names the names, in the order they were given
+         * @param objects the object of each name, nullptr if it was not found
+         * @param session whether the batch goes to the session list
+         */
+    void finishBatchAdd(const QStringList &names, const QVector<SkyObject *> &objects, bool session);
+
     /**
          * @short Return the active list
          * @return The session list or the wish list depending on which tab is currently being viewed.
@@ -387,6 +395,16 @@ class ObservingList : public QDialog
          */
     inline QModelIndexList getSelectedItems() const { return getActiveView()->selectionModel()->selectedRows(); }
 
+    /**
+         * @short Recompute the time dependent columns of the wish list or of the session plan in place
+         *
+         * The wish list gets the current altitudes, the session plan the times, altitudes and
+         * azimuths on the session date. Dynamic sorting is suspended meanwhile, so that the sort
+         * model sorts once rather than after every changed row. Solar system objects move, so
+         * @p session rows of these are replaced instead.
+         */
+    void updateTimeDependentColumns(bool session);
+
     std::unique_ptr<KSAlmanac> ksal;
     ObservingListUI *ui { nullptr };
     QList<QSharedPointer<SkyObject>> m_WishList, m_SessionList;
@@ -413,5 +431,6 @@ class ObservingList : public QDialog
     QTimer *m_altitudeUpdater { nullptr };
     std::function<QStandardItem *(const SkyPoint &)> m_altCostHelper;
     bool m_initialWishlistLoad { false };
+    bool m_altitudesStale { false };
     CatalogsDB::DBManager m_manager;
 };
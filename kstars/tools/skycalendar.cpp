@@ -7,7 +7,8 @@
 #include "skycalendar.h"
 
 #include "geolocation.h"
-#include "ksplanetbase.h"
+#include "ksnumbers.h"
+#include "ksplanet.h"
 #include "kstarsdata.h"
 #include "dialogs/locationdialog.h"
 #include "skycomponents/skymapcomposite.h"
@@ -22,6 +23,10 @@
 #include <QScreen>
 #include <QtConcurrent>
 
+#include <functional>
+#include <memory>
+#include <numeric>
+
 SkyCalendarUI::SkyCalendarUI(QWidget *parent) : QFrame(parent)
 {
     setupUi(this);
@@ -76,6 +81,19 @@ SkyCalendar::SkyCalendar(QWidget *parent) : QDialog(parent)
     });
 
     connect(scUI->LocationButton, SIGNAL(clicked()), this, SLOT(slotLocation()));
+
+    // Each planet is plotted as soon as all its days are computed
+    connect(&m_watcher, &QFutureWatcher<DayEvents>::resultReadyAt, this, &SkyCalendar::showEvents);
+    connect(&m_watcher, &QFutureWatcher<DayEvents>::finished, this, [this]()
+    {
+        scUI->CreateButton->setText(i18n("Plot Planetary Almanac"));
+        scUI->CreateButton->setEnabled(true);
+    });
+}
+
+SkyCalendar::~SkyCalendar()
+{
+    stopCalculation();
 }
 
 int SkyCalendar::year()
@@ -85,28 +103,94 @@ int SkyCalendar::year()
 
 void SkyCalendar::slotFillCalendar()
 {
+    stopCalculation();
+
     scUI->CreateButton->setEnabled(false);
 
     scUI->CalendarView->resetPlot();
     scUI->CalendarView->setHorizon();
 
+    m_planets.clear();
     if (scUI->checkBox_Mercury->isChecked())
-        QtConcurrent::run(this, &SkyCalendar::addPlanetEvents, KSPlanetBase::MERCURY);
+        m_planets.append(KSPlanetBase::MERCURY);
     if (scUI->checkBox_Venus->isChecked())
-        QtConcurrent::run(this, &SkyCalendar::addPlanetEvents, KSPlanetBase::VENUS);
+        m_planets.append(KSPlanetBase::VENUS);
     if (scUI->checkBox_Mars->isChecked())
-        QtConcurrent::run(this, &SkyCalendar::addPlanetEvents, KSPlanetBase::MARS);
+        m_planets.append(KSPlanetBase::MARS);
     if (scUI->checkBox_Jupiter->isChecked())
-        QtConcurrent::run(this, &SkyCalendar::addPlanetEvents, KSPlanetBase::JUPITER);
+        m_planets.append(KSPlanetBase::JUPITER);
     if (scUI->checkBox_Saturn->isChecked())
-        QtConcurrent::run(this, &SkyCalendar::addPlanetEvents, KSPlanetBase::SATURN);
+        m_planets.append(KSPlanetBase::SATURN);
     if (scUI->checkBox_Uranus->isChecked())
-        QtConcurrent::run(this, &SkyCalendar::addPlanetEvents, KSPlanetBase::URANUS);
+        m_planets.append(KSPlanetBase::URANUS);
     if (scUI->checkBox_Neptune->isChecked())
-        QtConcurrent::run(this, &SkyCalendar::addPlanetEvents, KSPlanetBase::NEPTUNE);
+        m_planets.append(KSPlanetBase::NEPTUNE);
+
+    // The time-dependent numbers of each day are computed once, for all planets
+    auto days    = std::make_shared<std::vector<KStarsDateTime>>();
+    auto numbers = std::make_shared<std::vector<KSNumbers>>();
+    for (KStarsDateTime kdt(QDate(year(), 1, 1), QTime(12, 0, 0)); kdt.date().year() == year();
+            kdt = kdt.addDays(scUI->spinBox_Interval->value()))
+    {
+        days->push_back(kdt);
+        numbers->emplace_back(kdt.djd());
+    }
+    m_days = int(days->size());
+    m_remaining.fill(m_days, m_planets.size());
+
+    // The planets are copied here, as those of the sky move on while the batch runs. The
+    // times are plotted to a few minutes at best, so the smallest terms of the theory are
+    // left out.
+    std::vector<std::shared_ptr<const KSPlanet>> planets;
+    for (int nPlanet : m_planets)
+    {
+        std::shared_ptr<KSPlanet> ksp(
+            static_cast<KSPlanet *>(KStarsData::Instance()->skyComposite()->planet(nPlanet)->clone()));
+        ksp->setPrecision(1e-6);
+        ksp->clearTrail();
+        planets.push_back(ksp);
+    }
+
+    // One job for each planet and day, numbered planet after planet
+    QVector<int> jobs(m_planets.size() * m_days);
+    std::iota(jobs.begin(), jobs.end(), 0);
 
-    scUI->CreateButton->setText(i18n("Plot Planetary Almanac"));
-    scUI->CreateButton->setEnabled(true);
+    const GeoLocation *where = geo;
+    const int count          = m_days;
+    std::function<DayEvents(int)> compute = [days, numbers, planets, where, count](int job)
+    {
+        const int day             = job % count;
+        const KStarsDateTime &kdt = (*days)[day];
+        std::unique_ptr<KSPlanet> ksp(planets[job / count]->clone());
+
+        // Start from the position at midday, which is where transitTime() begins
+        CachingDms LST = where->GSTtoLST(kdt.gst());
+        ksp->updateCoords(&(*numbers)[day], true, where->lat(), &LST);
+
+        return dayEvents(ksp.get(), kdt, where);
+    };
+
+    m_watcher.setFuture(QtConcurrent::mapped(jobs, compute));
+}
+
+void SkyCalendar::stopCalculation()
+{
+    m_watcher.cancel();
+    m_watcher.waitForFinished();
+}
+
+void SkyCalendar::showEvents(int index)
+{
+    const int slot = index / m_days;
+    if (--m_remaining[slot] > 0)
+        return;
+
+    std::vector<DayEvents> events;
+    events.reserve(m_days);
+    for (int day = 0; day < m_days; ++day)
+        events.push_back(m_watcher.resultAt(slot * m_days + day));
+
+    addPlanetEvents(m_planets[slot], events);
 }
 
 #if 0
@@ -157,71 +241,79 @@ void SkyCalendar::drawEventLabel( float x1, float y1, float x2, float y2, QStrin
 }
 */
 
-void SkyCalendar::addPlanetEvents(int nPlanet)
+SkyCalendar::DayEvents SkyCalendar::dayEvents(const KSPlanet *ksp, const KStarsDateTime &kdt, const GeoLocation *geo)
 {
-    KSPlanetBase *ksp = KStarsData::Instance()->skyComposite()->planet(nPlanet);
-    QColor pColor     = ksp->color();
-    //QVector<QPointF> vRise, vSet, vTransit;
-    std::vector<QPointF> vRise, vSet, vTransit;
-
-    for (KStarsDateTime kdt(QDate(year(), 1, 1), QTime(12, 0, 0)); kdt.date().year() == year();
-            kdt = kdt.addDays(scUI->spinBox_Interval->value()))
+    DayEvents events;
+    float rTime, sTime, tTime;
+
+    //Compute rise/set/transit times.  If they occur before noon,
+    //recompute for the following day
+    QTime tmp_rTime = ksp->riseSetTime(kdt, geo, true, true);  //rise time, exact
+    QTime tmp_sTime = ksp->riseSetTime(kdt, geo, false, true); //set time, exact
+    QTime tmp_tTime = ksp->transitTime(kdt, geo);
+    QTime midday(12, 0, 0);
+
+    // NOTE: riseSetTime should be fix now, this test is no longer necessary
+    if (tmp_rTime == tmp_sTime)
     {
-        float rTime, sTime, tTime;
+        tmp_rTime = QTime();
+        tmp_sTime = QTime();
+    }
 
-        //Compute rise/set/transit times.  If they occur before noon,
-        //recompute for the following day
-        QTime tmp_rTime = ksp->riseSetTime(kdt, geo, true, true);  //rise time, exact
-        QTime tmp_sTime = ksp->riseSetTime(kdt, geo, false, true); //set time, exact
-        QTime tmp_tTime = ksp->transitTime(kdt, geo);
-        QTime midday(12, 0, 0);
+    if (tmp_rTime.isValid() && tmp_sTime.isValid())
+    {
+        rTime = tmp_rTime.secsTo(midday) * 24.0 / 86400.0;
+        sTime = tmp_sTime.secsTo(midday) * 24.0 / 86400.0;
 
-        // NOTE: riseSetTime should be fix now, this test is no longer necessary
-        if (tmp_rTime == tmp_sTime)
-        {
-            tmp_rTime = QTime();
-            tmp_sTime = QTime();
-        }
+        if (tmp_rTime <= midday)
+            rTime = 12.0 - rTime;
+        else
+            rTime = -12.0 - rTime;
 
-        if (tmp_rTime.isValid() && tmp_sTime.isValid())
+        if (tmp_sTime <= midday)
+            sTime = 12.0 - sTime;
+        else
+            sTime = -12.0 - sTime;
+    }
+    else
+    {
+        if (ksp->transitAltitude(kdt, geo).degree() > 0)
         {
-            rTime = tmp_rTime.secsTo(midday) * 24.0 / 86400.0;
-            sTime = tmp_sTime.secsTo(midday) * 24.0 / 86400.0;
-
-            if (tmp_rTime <= midday)
-                rTime = 12.0 - rTime;
-            else
-                rTime = -12.0 - rTime;
-
-            if (tmp_sTime <= midday)
-                sTime = 12.0 - sTime;
-            else
-                sTime = -12.0 - sTime;
+            rTime = -24.0;
+            sTime = 24.0;
         }
         else
         {
-            if (ksp->transitAltitude(kdt, geo).degree() > 0)
-            {
-                rTime = -24.0;
-                sTime = 24.0;
-            }
-            else
-            {
-                rTime = 24.0;
-                sTime = -24.0;
-            }
+            rTime = 24.0;
+            sTime = -24.0;
         }
+    }
 
-        tTime = tmp_tTime.secsTo(midday) * 24.0 / 86400.0;
-        if (tmp_tTime <= midday)
-            tTime = 12.0 - tTime;
-        else
-            tTime = -12.0 - tTime;
+    tTime = tmp_tTime.secsTo(midday) * 24.0 / 86400.0;
+    if (tmp_tTime <= midday)
+        tTime = 12.0 - tTime;
+    else
+        tTime = -12.0 - tTime;
+
+    events.rise    = rTime;
+    events.set     = sTime;
+    events.transit = tTime;
+    events.dy      = kdt.date().daysInYear() - kdt.date().dayOfYear();
+    return events;
+}
 
-        float dy = kdt.date().daysInYear() - kdt.date().dayOfYear();
-        vRise.push_back(QPointF(rTime, dy));
-        vSet.push_back(QPointF(sTime, dy));
-        vTransit.push_back(QPointF(tTime, dy));
+void SkyCalendar::addPlanetEvents(int nPlanet, const std::vector<DayEvents> &events)
+{
+    KSPlanetBase *ksp = KStarsData::Instance()->skyComposite()->planet(nPlanet);
+    QColor pColor     = ksp->color();
+    //QVector<QPointF> vRise, vSet, vTransit;
+    std::vector<QPointF> vRise, vSet, vTransit;
+
+    for (const DayEvents &day : events)
+    {
+        vRise.push_back(QPointF(day.rise, day.dy));
+        vSet.push_back(QPointF(day.set, day.dy));
+        vTransit.push_back(QPointF(day.transit, day.dy));
     }
 
     //Now, find continuous segments in each QVector and add each segment
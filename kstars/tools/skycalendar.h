@@ -7,11 +7,17 @@
 #pragma once
 
 #include <QDialog>
+#include <QFutureWatcher>
 #include <QMutex>
+#include <QVector>
 
 #include "ui_skycalendar.h"
 
+#include <vector>
+
 class GeoLocation;
+class KSPlanet;
+class KStarsDateTime;
 
 class SkyCalendarUI : public QFrame, public Ui::SkyCalendar
 {
@@ -34,7 +40,7 @@ class SkyCalendar : public QDialog
 
   public:
     explicit SkyCalendar(QWidget *parent = nullptr);
-    ~SkyCalendar() = default;
+    ~SkyCalendar() override;
 
     int year();
     GeoLocation *get_geo();
@@ -46,7 +52,25 @@ class SkyCalendar : public QDialog
     //void slotCalculating();
 
   private:
-    void addPlanetEvents(int nPlanet);
+    /// The rise, set and transit times of a planet on one day, in hours from midday as plotted
+    struct DayEvents
+    {
+        float rise { 0 };
+        float set { 0 };
+        float transit { 0 };
+        float dy { 0 };
+    };
+
+    /** @short Count in result @p index of the batch, and plot its planet once all its days are in */
+    void showEvents(int index);
+
+    /** @short Cancel the batch being computed, if any, and wait for it */
+    void stopCalculation();
+
+    /** @short Compute the events of @p ksp on the day of @p kdt, as seen from @p geo */
+    static DayEvents dayEvents(const KSPlanet *ksp, const KStarsDateTime &kdt, const GeoLocation *geo);
+
+    void addPlanetEvents(int nPlanet, const std::vector<DayEvents> &events);
     void drawEventLabel(float x1, float y1, float x2, float y2, QString LabelText);
 
     SkyCalendarUI *scUI { nullptr };
@@ -54,4 +78,10 @@ class SkyCalendar : public QDialog
     QMutex calculationMutex;
     QString plotButtonText;
     bool calculating { false };
+
+    /// The planets of the batch, each computed for m_days days
+    QVector<int> m_planets;
+    QVector<int> m_remaining;
+    int m_days { 0 };
+    QFutureWatcher<DayEvents> m_watcher;
 };
@@ -11,6 +11,10 @@
 #include "starcomponent.h"
 #include "skyobjects/starobject.h"
 
+#include <QSet>
+
+#include <queue>
+
 #include <kstars_debug.h>
 
 QList<StarObject *> *StarHopper::computePath(const SkyPoint &src, const SkyPoint &dest, float fov__, float maglim__,
@@ -35,11 +39,26 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
 
     came_from.clear();
     result_path.clear();
+    starCosts.clear();
 
     // Implements the A* search algorithm
 
-    QList<SkyPoint const *> cSet;
-    QList<SkyPoint const *> oSet;
+    // The open set is a binary heap ordered by f_score. A node whose score improves is pushed
+    // again, and its stale entries are skipped when they come up. Ties go to the node found
+    // first, as the search always did.
+    struct OpenNode
+    {
+        double f_score;
+        int order;
+        SkyPoint const *node;
+        bool operator<(const OpenNode &other) const
+        {
+            return f_score > other.f_score || (f_score == other.f_score && order > other.order);
+        }
+    };
+    std::priority_queue<OpenNode> oSet;
+    QSet<SkyPoint const *> cSet;
+    QHash<SkyPoint const *, int> order;
     QHash<SkyPoint const *, double> g_score;
     QHash<SkyPoint const *, double> f_score;
     QHash<SkyPoint const *, double> h_score;
@@ -48,28 +67,32 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
              << src.dec().toDMSString() << " to destination: " << dest.ra().toHMSString() << dest.dec().toDMSString()
              << "; a starhop of " << src.angularDistanceTo(&dest).Degrees() << " degrees!";
 
-    oSet.append(&src);
     g_score[&src] = 0;
     h_score[&src] = src.angularDistanceTo(&dest).Degrees() / fov;
     f_score[&src] = h_score[&src];
+    order[&src] = 0;
+    oSet.push({f_score[&src], 0, &src});
 
-    while (!oSet.isEmpty())
-    {
-        qCDebug(KSTARS) << "Next step";
-        // Find the node with the lowest f_score value
-        SkyPoint const *curr_node = nullptr;
-        double lowfscore          = 1.0e8;
+    // Stars have their catalogue coordinates already, only the start needs them worked out. A
+    // copy keeps the coordinates of the caller as they are.
+    SkyPoint srcCatalogue = src;
+    srcCatalogue.catalogueCoord(KStarsData::Instance()->updateNum()->julianDay());
 
-        foreach (const SkyPoint *sp, oSet)
-        {
-            if (f_score[sp] < lowfscore)
-            {
-                lowfscore = f_score[sp];
-                curr_node = sp;
-            }
-        }
-        if (curr_node == nullptr)
+    // FIXME: Make sense. If current node ---> dest distance is
+    // larger than src --> dest distance by more than 20%, don't
+    // even bother considering it.
+    const double maxHScore = h_score[&src] * 1.2;
+
+    while (!oSet.empty())
+    {
+        const OpenNode top = oSet.top();
+        oSet.pop();
+        SkyPoint const *curr_node = top.node;
+        if (cSet.contains(curr_node) || top.f_score != f_score[curr_node])
             continue;
+        if (top.f_score >= 1.0e8)
+            break;
+        double lowfscore = top.f_score;
 
         qCDebug(KSTARS) << "Lowest fscore (vertex distance-plus-cost score) is " << lowfscore
                  << " with coords: " << curr_node->ra().toHMSString() << curr_node->dec().toDMSString()
@@ -121,14 +144,9 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
             return result_path;
         }
 
-        oSet.removeOne(curr_node);
-        cSet.append(curr_node);
+        cSet.insert(curr_node);
 
-        // FIXME: Make sense. If current node ---> dest distance is
-        // larger than src --> dest distance by more than 20%, don't
-        // even bother considering it.
-
-        if (h_score[curr_node] > h_score[&src] * 1.2)
+        if (h_score[curr_node] > maxHScore)
         {
             qCDebug(KSTARS) << "Node under consideration has larger distance to destination (h-score) than start node! "
                         "Ignoring it.";
@@ -137,16 +155,7 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
 
         // Get the list of stars that are neighbours of this node
         QList<StarObject *> neighbors;
-
-        // FIXME: Actually, this should be done in
-        // HorizontalToEquatorial, but we do it here because SkyPoint
-        // needs a lot of fixing to handle unprecessed and precessed,
-        // equatorial and horizontal coordinates nicely
-        SkyPoint *CurrentNode = const_cast<SkyPoint *>(curr_node);
-        //CurrentNode->deprecess(KStarsData::Instance()->updateNum());
-        CurrentNode->catalogueCoord(KStarsData::Instance()->updateNum()->julianDay());
-        //qCDebug(KSTARS) << "Calling starsInAperture";
-        StarComponent::Instance()->starsInAperture(neighbors, *curr_node, fov, maglim);
+        StarComponent::Instance()->starsInAperture(neighbors, curr_node == &src ? srcCatalogue : *curr_node, fov, maglim);
         qCDebug(KSTARS) << "Choosing next node from a set of " << neighbors.count();
         // Look for the potential next node
         double curr_g_score = g_score[curr_node];
@@ -158,23 +167,19 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
 
             // Compute the tentative g_score
             double tentative_g_score = curr_g_score + cost(curr_node, nhd_node);
-            bool tentative_better;
-            if (!oSet.contains(nhd_node))
-            {
-                oSet.append(nhd_node);
-                tentative_better = true;
-            }
-            else if (tentative_g_score < g_score[nhd_node])
-                tentative_better = true;
-            else
-                tentative_better = false;
-
-            if (tentative_better)
+            auto known = g_score.constFind(nhd_node);
+            if (known == g_score.constEnd() || tentative_g_score < known.value())
             {
+                if (!order.contains(nhd_node))
+                {
+                    const int discovered = order.size();
+                    order.insert(nhd_node, discovered);
+                }
                 came_from[nhd_node] = curr_node;
                 g_score[nhd_node]   = tentative_g_score;
                 h_score[nhd_node]   = nhd_node->angularDistanceTo(&dest).Degrees() / fov;
                 f_score[nhd_node]   = g_score[nhd_node] + h_score[nhd_node];
+                oSet.push({f_score[nhd_node], order[nhd_node], nhd_node});
             }
         }
     }
@@ -255,6 +260,24 @@ float StarHopper::cost(const SkyPoint *curr, const SkyPoint *next)
     // Test 5: How effective is the hop? [Might not be required with A*]
     //    double distredcost = -((src->angularDistanceTo( dest ).Degrees() - next->angularDistanceTo( dest ).Degrees()) * 60 / fov)*3; // 3 "magnitudes" for 1 FOV closer
 
+    // The rest only depends on the next hop, and is worked out once for each of them
+    auto cached = starCosts.constFind(next);
+    if (cached == starCosts.constEnd())
+        cached = starCosts.insert(next, starCost(next, isThisTheEnd));
+    const double stardensitycost = cached->first;
+    const double patterncost = cached->second;
+
+    netcost = magcost + speccost + distcost + stardensitycost + patterncost;
+    if (netcost < 0)
+        netcost = 0.1; // FIXME: Heuristics aren't supposed to be entirely random. This one is.
+    qCDebug(KSTARS) << "Mag cost: " << magcost << "; Spec Cost: " << speccost << "; Dist Cost: " << distcost
+             << "; Density cost: " << stardensitycost << "; Pattern cost: " << patterncost << "; Net cost: " << netcost
+             << "; Pattern: " << patternNames.value(next);
+    return netcost;
+}
+
+QPair<double, double> StarHopper::starCost(const SkyPoint *next, bool isThisTheEnd)
+{
     // Test 6: Is the destination an asterism? Are there bright stars clustered nearby?
     QList<StarObject *> localNeighbors;
     StarComponent::Instance()->starsInAperture(localNeighbors, *next, fov / 10, maglim + 1.0);
@@ -342,11 +365,5 @@ float StarHopper::cost(const SkyPoint *curr, const SkyPoint *next)
         }
     }
 
-    netcost = magcost + speccost + distcost + stardensitycost + patterncost;
-    if (netcost < 0)
-        netcost = 0.1; // FIXME: Heuristics aren't supposed to be entirely random. This one is.
-    qCDebug(KSTARS) << "Mag cost: " << magcost << "; Spec Cost: " << speccost << "; Dist Cost: " << distcost
-             << "; Density cost: " << stardensitycost << "; Pattern cost: " << patterncost << "; Net cost: " << netcost
-             << "; Pattern: " << patternName;
-    return netcost;
+    return qMakePair(stardensitycost, patterncost);
 }
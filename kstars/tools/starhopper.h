@@ -8,6 +8,7 @@
 
 #include <QHash>
 #include <QList>
+#include <QPair>
 
 class QStringList;
 
@@ -53,6 +54,13 @@ class StarHopper
      */
     float cost(const SkyPoint *curr, const SkyPoint *next);
 
+    /**
+     * @short The costs of a hop that only depend on where it lands: how crowded the
+     * neighbourhood of @p next is, and whether it stands out in a pattern of stars
+     * @return the star density cost and the pattern cost
+     */
+    QPair<double, double> starCost(const SkyPoint *next, bool isThisTheEnd);
+
     /**
      * @short For internal use by the A* Search Algorithm. Completes
      * the star-hop path. See https://en.wikipedia.org/wiki/A*_search_algorithm for details
@@ -68,4 +76,5 @@ class StarHopper
     QHash<const SkyPoint *, const SkyPoint *> came_from; // Used by the A* search algorithm
     QList<StarObject const *> result_path;
     QHash<SkyPoint const *, QString> patternNames; // if patterns were identified, they are added to this hash.
+    QHash<SkyPoint const *, QPair<double, double>> starCosts; // starCost() of the hops considered so far
 };
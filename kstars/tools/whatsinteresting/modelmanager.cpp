@@ -18,6 +18,12 @@
 
 #include <QtConcurrent>
 
+#include <algorithm>
+#include <vector>
+
+// Objects whose visibility is evaluated before their rows are added to a model
+static const int g_loadBatch = 500;
+
 ModelManager::ModelManager(ObsConditions *obs)
 {
     m_ObsConditions = obs;
@@ -42,6 +48,10 @@ ModelManager::ModelManager(ObsConditions *obs)
 
 ModelManager::~ModelManager()
 {
+    m_Stopping = true;
+    for (auto &load : m_Loading)
+        load.waitForFinished();
+
     qDeleteAll(m_ModelList);
     foreach (QList<SkyObjItem *> list, m_ObjectList)
         qDeleteAll(list);
@@ -169,8 +179,7 @@ void ModelManager::updateModel(ObsConditions *obs, QString modelName)
         else if (showOnlyFavorites && modelName == "clusters")
             loadObjectsIntoModel(*m_ModelList[modelNumber], favoriteClusters);
         else
-            loadObjectsIntoModel(*m_ModelList[modelNumber], m_ObjectList[modelNumber]);
-        emit modelUpdated();
+            loadObjectsIntoModel(*m_ModelList[modelNumber], m_ObjectList[modelNumber], true);
     }
 }
 
@@ -209,23 +218,98 @@ void ModelManager::loadObjectList(QList<SkyObjItem *> &skyObjectList, int type)
     }
 }
 
-void ModelManager::loadObjectsIntoModel(SkyObjListModel &model, QList<SkyObjItem *> &skyObjectList)
+void ModelManager::loadObjectsIntoModel(SkyObjListModel &model, QList<SkyObjItem *> &skyObjectList, bool notify)
 {
-    KStarsData *data = KStarsData::Instance();
+    SkyObjListModel *target = &model;
+    const int load          = ++m_Loads[target];
 
-    foreach (SkyObjItem *soitem, skyObjectList)
+    if (!showOnlyVisible || skyObjectList.isEmpty())
     {
-        bool isVisible =
-            (showOnlyVisible) ? (m_ObsConditions->isVisible(data->geo(), data->lst(), soitem->getSkyObject())) : true;
-        if (isVisible)
-            model.addSkyObject(soitem);
+        model.addSkyObjects(skyObjectList);
+        if (notify)
+        {
+            emit modelUpdated();
+            emit loadProgressUpdated(1);
+        }
+        return;
     }
+
+    KStarsData *data        = KStarsData::Instance();
+    GeoLocation *geo        = data->geo();
+    dms lst                 = *data->lst();
+    const KStarsDateTime ut = geo->LTtoUT(KStarsDateTime(QDateTime::currentDateTime().toLocalTime()));
+    ObsConditions *obs      = m_ObsConditions;
+
+    // Solar system bodies are few. Their clones keep count of their copies and their theories
+    // are loaded on first use, so they are evaluated here rather than along with the others.
+    const QList<SkyObjItem *> items = skyObjectList;
+    std::vector<int> visible(items.size(), -1);
+    for (int i = 0; i < items.size(); i++)
+    {
+        SkyObject *so = items[i]->getSkyObject();
+        if (so->isSolarSystem() || so->type() == SkyObject::SATELLITE)
+            visible[i] = obs->isVisible(geo, &lst, ut, so);
+    }
+
+    m_Loading.erase(std::remove_if(m_Loading.begin(), m_Loading.end(), [](const QFuture<void> &future)
+    {
+        return future.isFinished();
+    }), m_Loading.end());
+
+    m_Loading.append(QtConcurrent::run([this, target, load, notify, items, visible, geo, lst, ut, obs]() mutable
+    {
+        for (int start = 0; start < items.size(); start += g_loadBatch)
+        {
+            if (KStars::Closing || m_Stopping)
+                return;
+
+            const int end = std::min(start + g_loadBatch, items.size());
+            QVector<int> pending;
+            for (int i = start; i < end; i++)
+            {
+                if (visible[i] < 0)
+                    pending.append(i);
+            }
+
+            QtConcurrent::blockingMap(pending, [&](int &i)
+            {
+                visible[i] = obs->isVisible(geo, &lst, ut, items[i]->getSkyObject());
+            });
+
+            QList<SkyObjItem *> batch;
+            for (int i = start; i < end; i++)
+            {
+                if (visible[i])
+                    batch.append(items[i]);
+            }
+
+            const double progress = double(end) / items.size();
+            const bool first      = (start == 0);
+            QMetaObject::invokeMethod(this, [this, target, load, notify, batch, progress, first]()
+            {
+                if (m_Loads.value(target) != load)
+                    return;
+
+                target->addSkyObjects(batch);
+                if (notify)
+                {
+                    if (first)
+                        emit modelUpdated();
+                    emit loadProgressUpdated(progress);
+                }
+            }, Qt::QueuedConnection);
+        }
+    }));
 }
 
 void ModelManager::resetAllModels()
 {
     foreach (SkyObjListModel *model, m_ModelList)
+    {
+        // Drop the rows of loads still under way
+        ++m_Loads[model];
         model->resetModel();
+    }
 }
 
 int ModelManager::getModelNumber(QString modelName)
@@ -302,6 +386,9 @@ void ModelManager::loadCatalog(const QString &name)
     for (auto &obj : lst)
         p_lst.append(&obj);
 
-    updateModel(m_ObsConditions, name);
-    emit loadProgressUpdated(1);
+    // The models are only filled on the GUI thread, see loadObjectsIntoModel()
+    QMetaObject::invokeMethod(this, [this, name]()
+    {
+        updateModel(m_ObsConditions, name);
+    }, Qt::QueuedConnection);
 };
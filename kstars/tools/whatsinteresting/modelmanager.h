@@ -9,10 +9,13 @@
 #include "catalogobject.h"
 #include "skyobjitem.h"
 #include "catalogsdb.h"
+#include <QFuture>
+#include <QHash>
 #include <QList>
 #include <QObject>
 
 #include "polyfills/qstring_hash.h"
+#include <atomic>
 #include <unordered_map>
 
 class ObsConditions;
@@ -102,7 +105,15 @@ class ModelManager : public QObject
     void loadLists();
     void loadObjectList(QList<SkyObjItem *> &skyObjectList, int type);
     void loadNamedStarList();
-    void loadObjectsIntoModel(SkyObjListModel &model, QList<SkyObjItem *> &skyObjectList);
+    /**
+     * @brief Load the objects of @p skyObjectList that are visible into @p model.
+     *
+     * The visibility is evaluated in parallel batches off the GUI thread, and the rows are
+     * streamed into the model batch by batch. Rows of an earlier load still under way are
+     * dropped once the model has been reset. If @p notify is set, modelUpdated() is
+     * emitted with the first batch and loadProgressUpdated() after each of them.
+     */
+    void loadObjectsIntoModel(SkyObjListModel &model, QList<SkyObjItem *> &skyObjectList, bool notify = false);
 
     ObsConditions *m_ObsConditions{ nullptr };
     QList<QList<SkyObjItem *>> m_ObjectList;
@@ -115,4 +126,8 @@ class ModelManager : public QObject
     SkyObjListModel *tempModel{ nullptr };
     std::unordered_map<int, CatalogsDB::CatalogObjectList> m_CatalogMap;
     std::unordered_map<int, std::list<SkyObjItem>> m_CatalogSkyObjItems;
+    // Number of the latest load of each model, see loadObjectsIntoModel()
+    QHash<SkyObjListModel *, int> m_Loads;
+    QList<QFuture<void>> m_Loading;
+    std::atomic<bool> m_Stopping { false };
 };
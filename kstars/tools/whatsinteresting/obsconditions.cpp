@@ -89,8 +89,16 @@ bool ObsConditions::isVisible(GeoLocation *geo, dms *lst, SkyObject *so)
     {
         return so->alt().Degrees() > 6.0;
     }
-    KStarsDateTime ut = geo->LTtoUT(KStarsDateTime(QDateTime::currentDateTime().toLocalTime()));
-    SkyPoint sp       = so->recomputeCoords(ut, geo);
+    return isVisible(geo, lst, geo->LTtoUT(KStarsDateTime(QDateTime::currentDateTime().toLocalTime())), so);
+}
+
+bool ObsConditions::isVisible(GeoLocation *geo, dms *lst, const KStarsDateTime &ut, SkyObject *so)
+{
+    if (so->type() == SkyObject::SATELLITE)
+    {
+        return so->alt().Degrees() > 6.0;
+    }
+    SkyPoint sp = so->recomputeCoords(ut, geo);
 
     //check altitude of object at this time.
     sp.EquatorialToHorizontal(lst, geo->lat());
@@ -94,6 +94,15 @@ class ObsConditions
      */
     bool isVisible(GeoLocation *geo, dms *lst, SkyObject *so);
 
+    /**
+     * @brief Evaluate visibility of sky-object at the universal time @p ut.
+     *
+     * Unlike the overload above this takes the time from the caller, so that many objects may be
+     * evaluated at the same time. Objects outside of the solar system may be evaluated from
+     * several threads at once.
+     */
+    bool isVisible(GeoLocation *geo, dms *lst, const KStarsDateTime &ut, SkyObject *so);
+
     /**
      * @brief Create QMap<int, double> to be initialised to static member variable m_LMMap
      *
@@ -35,6 +35,16 @@ void SkyObjListModel::addSkyObject(SkyObjItem *soitem)
     endInsertRows();
 }
 
+void SkyObjListModel::addSkyObjects(const QList<SkyObjItem *> &soitems)
+{
+    if (soitems.isEmpty())
+        return;
+
+    beginInsertRows(QModelIndex(), rowCount(), rowCount() + soitems.size() - 1);
+    m_SoItemList.append(soitems);
+    endInsertRows();
+}
+
 int SkyObjListModel::rowCount(const QModelIndex &parent) const
 {
     Q_UNUSED(parent)
@@ -77,5 +87,7 @@ int SkyObjListModel::getSkyObjIndex(SkyObjItem *item)
 
 void SkyObjListModel::resetModel()
 {
+    beginResetModel();
     m_SoItemList.clear();
+    endResetModel();
 }
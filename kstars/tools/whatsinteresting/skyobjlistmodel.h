@@ -30,6 +30,13 @@ class SkyObjListModel : public QAbstractListModel
      */
     void addSkyObject(SkyObjItem *sobj);
 
+    /**
+     * @brief Add sky-objects to the model, as a single insertion.
+     * @param soitems
+     * Pointers to sky-objects to be added.
+     */
+    void addSkyObjects(const QList<SkyObjItem *> &soitems);
+
     /**
      * @brief Create and return a QHash<int, QByteArray> of rolenames for the SkyObjItem.
      * @return QHash<int, QByteArray> of rolenames for the SkyObjItem.